@@ -7,12 +7,18 @@
 
 #include <gsl/span>
 
+#include <cstddef>
 #include <optional>
+#include <vector>
 
 namespace Cesium3DTilesContent {
 struct B3dmToGltfConverter {
   static GltfConverterResult convert(
       const gsl::span<const std::byte>& b3dmBinary,
       const CesiumGltfReader::GltfReaderOptions& options);
+
+  static GltfConverterResult convert(
+      std::vector<std::byte>&& b3dmBinary,
+      const CesiumGltfReader::GltfReaderOptions& options);
 };
 } // namespace Cesium3DTilesContent
@@ -2,10 +2,12 @@
 
 #include <Cesium3DTilesContent/GltfConverterResult.h>
 #include <CesiumGltfReader/GltfReader.h>
+#include <CesiumGltfReader/GltfStreamReader.h>
 
 #include <gsl/span>
 
 #include <cstddef>
+#include <vector>
 
 namespace Cesium3DTilesContent {
 struct BinaryToGltfConverter {
@@ -14,6 +16,26 @@ public:
       const gsl::span<const std::byte>& gltfBinary,
       const CesiumGltfReader::GltfReaderOptions& options);
 
+  static GltfConverterResult convert(
+      std::vector<std::byte>&& gltfBinary,
+      const CesiumGltfReader::GltfReaderOptions& options);
+
+  /**
+   * @brief Creates a reader that reads a GLB in pieces, as it is downloaded.
+   *
+   * Once the reader is complete, pass it to the overload of `convert` that
+   * takes a {@link CesiumGltfReader::GltfStreamReader}.
+   */
+  static CesiumGltfReader::GltfStreamReader createStreamReader() noexcept;
+
+  /**
+   * @brief Finishes reading a GLB that was received by a reader from
+   * {@link createStreamReader}.
+   */
+  static GltfConverterResult convert(
+      CesiumGltfReader::GltfStreamReader& streamReader,
+      const CesiumGltfReader::GltfReaderOptions& options);
+
 private:
   static CesiumGltfReader::GltfReader _gltfReader;
 };
@@ -1,16 +1,34 @@
 #pragma once
 
 #include <Cesium3DTilesContent/GltfConverterResult.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/Future.h>
 #include <CesiumGltfReader/GltfReader.h>
 
 #include <gsl/span>
 
 #include <cstddef>
+#include <vector>
 
 namespace Cesium3DTilesContent {
 struct CmptToGltfConverter {
   static GltfConverterResult convert(
       const gsl::span<const std::byte>& cmptBinary,
       const CesiumGltfReader::GltfReaderOptions& options);
+
+  /**
+   * @brief Converts a composite tile, converting its inner tiles concurrently
+   * in worker threads.
+   *
+   * @param asyncSystem The async system used to convert the inner tiles.
+   * @param cmptBinary The composite tile, which is kept alive until all of its
+   * inner tiles are converted.
+   * @param options Options for how to read the glTFs of the inner tiles.
+   * @return A future that resolves to the merged glTF of the inner tiles.
+   */
+  static CesiumAsync::Future<GltfConverterResult> convert(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      std::vector<std::byte>&& cmptBinary,
+      const CesiumGltfReader::GltfReaderOptions& options);
 };
 } // namespace Cesium3DTilesContent
@@ -10,6 +10,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace Cesium3DTilesContent {
 /**
@@ -36,6 +37,16 @@ public:
       const gsl::span<const std::byte>& content,
       const CesiumGltfReader::GltfReaderOptions& options);
 
+  /**
+   * @brief A function pointer that can create a {@link GltfConverterResult}
+   * from tile binary content that it takes ownership of, so that large parts
+   * of the content, like the binary chunk of a GLB, can be moved into the glTF
+   * instead of copied.
+   */
+  using OwningConverterFunction = GltfConverterResult (*)(
+      std::vector<std::byte>&& content,
+      const CesiumGltfReader::GltfReaderOptions& options);
+
   /**
    * @brief Register the given function for the given magic header.
    *
@@ -51,6 +62,22 @@ public:
   static void
   registerMagic(const std::string& magic, ConverterFunction converter);
 
+  /**
+   * @brief Register the given function for content with the given magic
+   * header that the caller can give up ownership of.
+   *
+   * This is in addition to the {@link ConverterFunction} registered with
+   * {@link registerMagic}, which must be registered too, and must produce the
+   * same result.
+   *
+   * @param magic The string describing the magic header.
+   * @param converter The converter that will be used to create the tile gltf
+   * content.
+   */
+  static void registerOwningMagic(
+      const std::string& magic,
+      OwningConverterFunction converter);
+
   /**
    * @brief Register the given function for the given file extension.
    *
@@ -94,6 +121,18 @@ public:
   static ConverterFunction
   getConverterByMagic(const gsl::span<const std::byte>& content);
 
+  /**
+   * @brief Retrieve the converter function that is registered with
+   * {@link registerOwningMagic} for the magic header of the given content. If
+   * no such function is found, nullptr will be returned.
+   *
+   * @param content The binary tile content that contains the magic header.
+   * @return The {@link OwningConverterFunction} that is registered with the
+   * magic header.
+   */
+  static OwningConverterFunction
+  getOwningConverterByMagic(const gsl::span<const std::byte>& content);
+
   /**
    * @brief Creates the {@link GltfConverterResult} from the given
    * binary content.
@@ -163,6 +202,8 @@ private:
       std::string& magic);
 
   static std::unordered_map<std::string, ConverterFunction> _loadersByMagic;
+  static std::unordered_map<std::string, OwningConverterFunction>
+      _owningLoadersByMagic;
   static std::unordered_map<std::string, ConverterFunction>
       _loadersByFileExtension;
 };
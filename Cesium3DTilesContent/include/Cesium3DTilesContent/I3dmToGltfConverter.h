@@ -0,0 +1,32 @@
+#pragma once
+
+#include "GltfConverterResult.h"
+
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfReader/GltfReader.h>
+
+#include <gsl/span>
+
+#include <cstddef>
+
+namespace Cesium3DTilesContent {
+/**
+ * @brief Converts Instanced 3D Model (i3dm) tile content to glTF.
+ *
+ * The model is not copied for each instance. Instead, each node with a mesh
+ * gets an `EXT_mesh_gpu_instancing` extension with the translation, rotation,
+ * and scale of every instance, which are decoded from the quantized
+ * positions, oct-encoded orientations, and scales in the i3dm feature table.
+ * Batch IDs become a `_FEATURE_ID_0` instance attribute, and the batch table
+ * becomes `EXT_structural_metadata`, with `EXT_instance_features` on each
+ * instanced node.
+ *
+ * Only i3dms that embed a binary glTF are supported, not those that refer to
+ * one by URI.
+ */
+struct I3dmToGltfConverter {
+  static GltfConverterResult convert(
+      const gsl::span<const std::byte>& instancesBinary,
+      const CesiumGltfReader::GltfReaderOptions& options);
+};
+} // namespace Cesium3DTilesContent
@@ -16,6 +16,10 @@ namespace CesiumGeometry {
 class OrientedBoundingBox;
 }
 
+namespace CesiumUtility {
+class BaseUri;
+}
+
 namespace Cesium3DTilesContent {
 
 /**
@@ -130,6 +134,25 @@ public:
       const std::string& urlTemplate,
       const CesiumGeometry::QuadtreeTileID& quadtreeID);
 
+  /**
+   * @brief Resolves a templatized implicit tiling URL with a quadtree tile ID,
+   * relative to a base URL that was parsed in advance.
+   *
+   * This is faster than resolving the URL relative to a string when many URLs
+   * are resolved relative to the same base.
+   *
+   * @param baseUrl The parsed base URL that is used to resolve the urlTemplate
+   * if it is a relative path.
+   * @param urlTemplate The templatized URL.
+   * @param quadtreeID The quadtree ID to use in resolving the parameters in the
+   * URL template.
+   * @return The resolved URL.
+   */
+  static std::string resolveUrl(
+      const CesiumUtility::BaseUri& baseUrl,
+      const std::string& urlTemplate,
+      const CesiumGeometry::QuadtreeTileID& quadtreeID);
+
   /**
    * @brief Resolves a templatized implicit tiling URL with an octree tile ID.
    *
@@ -145,6 +168,25 @@ public:
       const std::string& urlTemplate,
       const CesiumGeometry::OctreeTileID& octreeID);
 
+  /**
+   * @brief Resolves a templatized implicit tiling URL with an octree tile ID,
+   * relative to a base URL that was parsed in advance.
+   *
+   * This is faster than resolving the URL relative to a string when many URLs
+   * are resolved relative to the same base.
+   *
+   * @param baseUrl The parsed base URL that is used to resolve the urlTemplate
+   * if it is a relative path.
+   * @param urlTemplate The templatized URL.
+   * @param octreeID The octree ID to use in resolving the parameters in the
+   * URL template.
+   * @return The resolved URL.
+   */
+  static std::string resolveUrl(
+      const CesiumUtility::BaseUri& baseUrl,
+      const std::string& urlTemplate,
+      const CesiumGeometry::OctreeTileID& octreeID);
+
   /**
    * @brief Computes the denominator for a given implicit tile level.
    *
@@ -201,6 +243,34 @@ public:
       const CesiumGeometry::OctreeTileID& subtreeRootID,
       const CesiumGeometry::OctreeTileID& tileID);
 
+  /**
+   * @brief Computes the index of a quadtree tile in the tile and content
+   * availability bitstreams of the subtree that contains it, which is the
+   * number of tiles in the levels of the subtree above the tile plus the
+   * tile's relative Morton index.
+   *
+   * @param subtreeID The ID of the subtree the contains the tile.
+   * @param tileID The ID of the tile.
+   * @return The index of the tile in the availability bitstreams.
+   */
+  static uint64_t computeAvailabilityIndex(
+      const CesiumGeometry::QuadtreeTileID& subtreeID,
+      const CesiumGeometry::QuadtreeTileID& tileID);
+
+  /**
+   * @brief Computes the index of an octree tile in the tile and content
+   * availability bitstreams of the subtree that contains it, which is the
+   * number of tiles in the levels of the subtree above the tile plus the
+   * tile's relative Morton index.
+   *
+   * @param subtreeID The ID of the subtree the contains the tile.
+   * @param tileID The ID of the tile.
+   * @return The index of the tile in the availability bitstreams.
+   */
+  static uint64_t computeAvailabilityIndex(
+      const CesiumGeometry::OctreeTileID& subtreeID,
+      const CesiumGeometry::OctreeTileID& tileID);
+
   /**
    * @brief Gets the ID of the root tile of the subtree that contains a given
    * tile.
@@ -346,6 +416,32 @@ public:
   static CesiumGeospatial::S2CellBoundingVolume computeBoundingVolume(
       const CesiumGeospatial::S2CellBoundingVolume& rootBoundingVolume,
       const CesiumGeometry::QuadtreeTileID& tileID) noexcept;
+
+  /**
+   * @brief Computes the bounding regions of all eight children of an implicit
+   * octree tile at once.
+   *
+   * @param parentBoundingVolume The bounding region of the parent tile.
+   * @return The bounding regions of the children, in the order of
+   * {@link OctreeChildren}.
+   */
+  static std::array<CesiumGeospatial::BoundingRegion, 8>
+  computeChildBoundingVolumes(
+      const CesiumGeospatial::BoundingRegion& parentBoundingVolume) noexcept;
+
+  /**
+   * @brief Computes the oriented bounding boxes of all eight children of an
+   * implicit octree tile at once.
+   *
+   * The children share the half axes, which are half of the parent's.
+   *
+   * @param parentBoundingVolume The oriented bounding box of the parent tile.
+   * @return The oriented bounding boxes of the children, in the order of
+   * {@link OctreeChildren}.
+   */
+  static std::array<CesiumGeometry::OrientedBoundingBox, 8>
+  computeChildBoundingVolumes(
+      const CesiumGeometry::OrientedBoundingBox& parentBoundingVolume) noexcept;
 };
 
 } // namespace Cesium3DTilesContent
@@ -4,7 +4,11 @@
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/IAssetAccessor.h>
 
+#include <gsl/span>
+
+#include <cstdint>
 #include <optional>
+#include <vector>
 
 namespace CesiumGeometry {
 struct QuadtreeTileID;
@@ -67,6 +71,38 @@ public:
       ImplicitTileSubdivisionScheme subdivisionScheme,
       uint32_t levelsInSubtree) noexcept;
 
+  /**
+   * @brief Creates an instance from the indices of the available tiles,
+   * content, and child subtrees.
+   *
+   * Each availability is built a 64-bit word at a time. Availability in which
+   * every element, or none, is available is stored as a constant rather than
+   * as a bitstream. The bitstreams are stored in the first buffer of the
+   * subtree, each aligned to 8 bytes, and their `availableCount` is set.
+   *
+   * The indices may be in any order and may repeat. Indices that are out of
+   * range are ignored.
+   *
+   * @param subdivisionScheme The subdivision scheme of the subtree (quadtree or
+   * octree).
+   * @param levelsInSubtree The number of levels in this subtree.
+   * @param availableTiles The indices of the available tiles in the tile
+   * availability bitstream, as computed by
+   * {@link ImplicitTilingUtilities::computeAvailabilityIndex}.
+   * @param availableContent The indices of the tiles with available content,
+   * for each content of the tiles. There must be at least one.
+   * @param availableChildSubtrees The relative Morton indices of the available
+   * child subtrees, within the level below this subtree.
+   * @return The subtree availability, or std::nullopt if there is no content
+   * availability.
+   */
+  static std::optional<SubtreeAvailability> fromAvailableIndices(
+      ImplicitTileSubdivisionScheme subdivisionScheme,
+      uint32_t levelsInSubtree,
+      const gsl::span<const uint64_t>& availableTiles,
+      const std::vector<std::vector<uint64_t>>& availableContent,
+      const gsl::span<const uint64_t>& availableChildSubtrees);
+
   /**
    * @brief Asynchronously loads a subtree from a URL. The resource downloaded
    * from the URL may be either a JSON or a binary subtree file.
@@ -182,6 +218,59 @@ public:
       uint32_t relativeTileLevel,
       uint64_t relativeTileMortonId) const noexcept;
 
+  /**
+   * @brief Gets the index of a given tile in the quadtree among the available
+   * tiles of the subtree.
+   *
+   * This is the number of available tiles that precede the tile in the tile
+   * availability bitstream, which is the row of the tile in the subtree's
+   * tile metadata property table.
+   *
+   * @param subtreeId The ID of the root tile of the subtree.
+   * @param tileId The ID of the tile to query.
+   * @return The index of the tile, or std::nullopt if the tile is not
+   * available.
+   */
+  std::optional<uint64_t> getAvailableTileIndex(
+      const CesiumGeometry::QuadtreeTileID& subtreeId,
+      const CesiumGeometry::QuadtreeTileID& tileId) const noexcept;
+
+  /**
+   * @brief Gets the index of a given tile in the octree among the available
+   * tiles of the subtree.
+   *
+   * This is the number of available tiles that precede the tile in the tile
+   * availability bitstream, which is the row of the tile in the subtree's
+   * tile metadata property table.
+   *
+   * @param subtreeId The ID of the root tile of the subtree.
+   * @param tileId The ID of the tile to query.
+   * @return The index of the tile, or std::nullopt if the tile is not
+   * available.
+   */
+  std::optional<uint64_t> getAvailableTileIndex(
+      const CesiumGeometry::OctreeTileID& subtreeId,
+      const CesiumGeometry::OctreeTileID& tileId) const noexcept;
+
+  /**
+   * @brief Gets the index of a given tile in the subtree among the available
+   * tiles of the subtree.
+   *
+   * This is the number of available tiles that precede the tile in the tile
+   * availability bitstream, which is the row of the tile in the subtree's
+   * tile metadata property table.
+   *
+   * @param relativeTileLevel The level of the tile to query, relative to the
+   * root of the subtree.
+   * @param relativeTileMortonId The Morton ID of the tile to query. See
+   * {@link ImplicitTilingUtilities::computeRelativeMortonIndex}.
+   * @return The index of the tile, or std::nullopt if the tile is not
+   * available.
+   */
+  std::optional<uint64_t> getAvailableTileIndex(
+      uint32_t relativeTileLevel,
+      uint64_t relativeTileMortonId) const noexcept;
+
   /**
    * @brief Sets the availability state of a given tile in the quadtree.
    *
@@ -262,6 +351,65 @@ public:
       uint64_t relativeTileMortonId,
       uint64_t contentId) const noexcept;
 
+  /**
+   * @brief Gets the index of the content of a given tile in the quadtree among
+   * the available content of the subtree.
+   *
+   * This is the number of tiles with available content that precede the tile
+   * in the content availability bitstream, which is the row of the content in
+   * the subtree's content metadata property table.
+   *
+   * @param subtreeId The ID of the root tile of the subtree.
+   * @param tileId The ID of the tile to query.
+   * @param contentId The ID of the content to query.
+   * @return The index of the content, or std::nullopt if the content is not
+   * available.
+   */
+  std::optional<uint64_t> getAvailableContentIndex(
+      const CesiumGeometry::QuadtreeTileID& subtreeId,
+      const CesiumGeometry::QuadtreeTileID& tileId,
+      uint64_t contentId) const noexcept;
+
+  /**
+   * @brief Gets the index of the content of a given tile in the octree among
+   * the available content of the subtree.
+   *
+   * This is the number of tiles with available content that precede the tile
+   * in the content availability bitstream, which is the row of the content in
+   * the subtree's content metadata property table.
+   *
+   * @param subtreeId The ID of the root tile of the subtree.
+   * @param tileId The ID of the tile to query.
+   * @param contentId The ID of the content to query.
+   * @return The index of the content, or std::nullopt if the content is not
+   * available.
+   */
+  std::optional<uint64_t> getAvailableContentIndex(
+      const CesiumGeometry::OctreeTileID& subtreeId,
+      const CesiumGeometry::OctreeTileID& tileId,
+      uint64_t contentId) const noexcept;
+
+  /**
+   * @brief Gets the index of the content of a given tile in the subtree among
+   * the available content of the subtree.
+   *
+   * This is the number of tiles with available content that precede the tile
+   * in the content availability bitstream, which is the row of the content in
+   * the subtree's content metadata property table.
+   *
+   * @param relativeTileLevel The level of the tile to query, relative to the
+   * root of the subtree.
+   * @param relativeTileMortonId The Morton ID of the tile to query. See
+   * {@link ImplicitTilingUtilities::computeRelativeMortonIndex}.
+   * @param contentId The ID of the content to query.
+   * @return The index of the content, or std::nullopt if the content is not
+   * available.
+   */
+  std::optional<uint64_t> getAvailableContentIndex(
+      uint32_t relativeTileLevel,
+      uint64_t relativeTileMortonId,
+      uint64_t contentId) const noexcept;
+
   /**
    * @brief Sets the availability state of the content for a given tile in the
    * quadtree.
@@ -414,10 +562,16 @@ private:
       uint32_t relativeTileLevel,
       uint64_t relativeTileMortonId,
       const AvailabilityView& availabilityView) const noexcept;
+  std::optional<uint64_t> getAvailableIndex(
+      uint32_t relativeTileLevel,
+      uint64_t relativeTileMortonId,
+      const AvailabilityView& availabilityView,
+      const std::vector<uint64_t>& rankIndex) const noexcept;
   void setAvailable(
       uint32_t relativeTileLevel,
       uint64_t relativeTileMortonId,
       AvailabilityView& availabilityView,
+      std::vector<uint64_t>& rankIndex,
       bool isAvailable) noexcept;
 
   bool isAvailableUsingBufferView(
@@ -437,5 +591,12 @@ private:
   AvailabilityView _tileAvailability;
   AvailabilityView _subtreeAvailability;
   std::vector<AvailabilityView> _contentAvailability;
+
+  // The number of available tiles before each 512-bit block of the tile and
+  // content availability bitstreams, so that the index of an available tile
+  // can be found without counting the bits before the block. These are empty
+  // for constant availability.
+  std::vector<uint64_t> _tileAvailabilityRankIndex;
+  std::vector<std::vector<uint64_t>> _contentAvailabilityRankIndices;
 };
 } // namespace Cesium3DTilesContent
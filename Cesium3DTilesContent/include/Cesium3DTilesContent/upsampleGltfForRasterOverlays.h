@@ -3,6 +3,9 @@
 #include <CesiumGeometry/QuadtreeTileID.h>
 #include <CesiumGltf/Model.h>
 
+#include <optional>
+#include <vector>
+
 namespace Cesium3DTilesContent {
 
 std::optional<CesiumGltf::Model> upsampleGltfForRasterOverlays(
@@ -10,4 +13,25 @@ std::optional<CesiumGltf::Model> upsampleGltfForRasterOverlays(
     CesiumGeometry::UpsampledQuadtreeNode childID,
     int32_t textureCoordinateIndex = 0);
 
-}
+/**
+ * @brief Upsamples several children of the same parent, usually all four, in
+ * a single pass over the parent's triangles.
+ *
+ * Each triangle is clipped against the East-West boundary once per side, and
+ * the parts are then clipped against the North-South boundary for each child
+ * on that side. The result for each child is the same as from the overload
+ * that upsamples one child.
+ *
+ * @param parentModel The model to upsample.
+ * @param childIDs The children to create.
+ * @param textureCoordinateIndex The index of the raster overlay texture
+ * coordinates used to divide the model.
+ * @return The upsampled model of each child, in the order of `childIDs`, or
+ * std::nullopt for a child that contains no part of the parent.
+ */
+std::vector<std::optional<CesiumGltf::Model>> upsampleGltfForRasterOverlays(
+    const CesiumGltf::Model& parentModel,
+    const std::vector<CesiumGeometry::UpsampledQuadtreeNode>& childIDs,
+    int32_t textureCoordinateIndex = 0);
+
+} // namespace Cesium3DTilesContent
@@ -113,16 +113,19 @@ void parseB3dmHeader(
   }
 }
 
+uint32_t getGlbStart(const B3dmHeader& header, uint32_t headerLength) {
+  return headerLength + header.featureTableJsonByteLength +
+         header.featureTableBinaryByteLength + header.batchTableJsonByteLength +
+         header.batchTableBinaryByteLength;
+}
+
 void convertB3dmContentToGltf(
     const gsl::span<const std::byte>& b3dmBinary,
     const B3dmHeader& header,
     uint32_t headerLength,
     const CesiumGltfReader::GltfReaderOptions& options,
     GltfConverterResult& result) {
-  const uint32_t glbStart = headerLength + header.featureTableJsonByteLength +
-                            header.featureTableBinaryByteLength +
-                            header.batchTableJsonByteLength +
-                            header.batchTableBinaryByteLength;
+  const uint32_t glbStart = getGlbStart(header, headerLength);
   const uint32_t glbEnd = header.byteLength;
 
   if (glbEnd <= glbStart) {
@@ -179,6 +182,7 @@ void convertB3dmMetadataToGltfStructuralMetadata(
     const gsl::span<const std::byte>& b3dmBinary,
     const B3dmHeader& header,
     uint32_t headerLength,
+    const CesiumGltfReader::GltfReaderOptions& options,
     GltfConverterResult& result) {
   if (result.model && header.featureTableJsonByteLength > 0) {
     CesiumGltf::Model& gltf = result.model.value();
@@ -194,7 +198,7 @@ void convertB3dmMetadataToGltfStructuralMetadata(
     const int64_t batchTableLength =
         header.batchTableBinaryByteLength + header.batchTableJsonByteLength;
 
-    if (batchTableLength > 0) {
+    if (batchTableLength > 0 && options.upgradeBatchTables) {
       const gsl::span<const std::byte> batchTableJsonData = b3dmBinary.subspan(
           static_cast<size_t>(batchTableStart),
           header.batchTableJsonByteLength);
@@ -249,6 +253,52 @@ GltfConverterResult B3dmToGltfConverter::convert(
       b3dmBinary,
       header,
       headerLength,
+      options,
+      result);
+
+  return result;
+}
+
+GltfConverterResult B3dmToGltfConverter::convert(
+    std::vector<std::byte>&& b3dmBinary,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  GltfConverterResult result;
+  B3dmHeader header;
+  uint32_t headerLength = 0;
+  parseB3dmHeader(b3dmBinary, header, headerLength, result);
+  if (result.errors) {
+    return result;
+  }
+
+  const uint32_t glbStart = getGlbStart(header, headerLength);
+  const uint32_t glbEnd = header.byteLength;
+  if (glbEnd <= glbStart) {
+    // Let the copying path report the error.
+    return convert(gsl::span<const std::byte>(b3dmBinary), options);
+  }
+
+  // Keep the header and tables, which are usually small, for the metadata,
+  // and pass the GLB at the front of the data on to the glTF reader, which
+  // moves its binary chunk into the model.
+  const std::vector<std::byte> b3dmTables(
+      b3dmBinary.begin(),
+      b3dmBinary.begin() + glbStart);
+  b3dmBinary.erase(b3dmBinary.begin(), b3dmBinary.begin() + glbStart);
+  b3dmBinary.resize(glbEnd - glbStart);
+
+  GltfConverterResult binToGltfResult =
+      BinaryToGltfConverter::convert(std::move(b3dmBinary), options);
+  result.model = std::move(binToGltfResult.model);
+  result.errors.merge(std::move(binToGltfResult.errors));
+  if (result.errors) {
+    return result;
+  }
+
+  convertB3dmMetadataToGltfStructuralMetadata(
+      b3dmTables,
+      header,
+      headerLength,
+      options,
       result);
 
   return result;
@@ -21,5 +21,11 @@ struct BatchTableToGltfStructuralMetadata {
       const rapidjson::Document& batchTableJson,
       const gsl::span<const std::byte>& batchTableBinaryData,
       CesiumGltf::Model& gltf);
+
+  static CesiumUtility::ErrorList convertFromI3dm(
+      const rapidjson::Document& featureTableJson,
+      const rapidjson::Document& batchTableJson,
+      const gsl::span<const std::byte>& batchTableBinaryData,
+      CesiumGltf::Model& gltf);
 };
 } // namespace Cesium3DTilesContent
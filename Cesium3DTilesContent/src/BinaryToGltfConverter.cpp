@@ -15,4 +15,34 @@ GltfConverterResult BinaryToGltfConverter::convert(
   result.errors.warnings = std::move(loadedGltf.warnings);
   return result;
 }
+
+GltfConverterResult BinaryToGltfConverter::convert(
+    std::vector<std::byte>&& gltfBinary,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  CesiumGltfReader::GltfReaderResult loadedGltf =
+      _gltfReader.readGltf(std::move(gltfBinary), options);
+
+  GltfConverterResult result;
+  result.model = std::move(loadedGltf.model);
+  result.errors.errors = std::move(loadedGltf.errors);
+  result.errors.warnings = std::move(loadedGltf.warnings);
+  return result;
+}
+
+CesiumGltfReader::GltfStreamReader
+BinaryToGltfConverter::createStreamReader() noexcept {
+  return CesiumGltfReader::GltfStreamReader(_gltfReader);
+}
+
+GltfConverterResult BinaryToGltfConverter::convert(
+    CesiumGltfReader::GltfStreamReader& streamReader,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  CesiumGltfReader::GltfReaderResult loadedGltf = streamReader.finish(options);
+
+  GltfConverterResult result;
+  result.model = std::move(loadedGltf.model);
+  result.errors.errors = std::move(loadedGltf.errors);
+  result.errors.warnings = std::move(loadedGltf.warnings);
+  return result;
+}
 } // namespace Cesium3DTilesContent
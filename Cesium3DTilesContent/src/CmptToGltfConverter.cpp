@@ -3,6 +3,8 @@
 
 #include <spdlog/fmt/fmt.h>
 
+#include <memory>
+
 namespace Cesium3DTilesContent {
 namespace {
 struct CmptHeader {
@@ -20,15 +22,16 @@ struct InnerHeader {
 
 static_assert(sizeof(CmptHeader) == 16);
 static_assert(sizeof(InnerHeader) == 12);
-} // namespace
 
-GltfConverterResult CmptToGltfConverter::convert(
+// Finds the inner tiles of a composite tile, reporting problems with the
+// composite tile in the result.
+std::vector<gsl::span<const std::byte>> findInnerTiles(
     const gsl::span<const std::byte>& cmptBinary,
-    const CesiumGltfReader::GltfReaderOptions& options) {
-  GltfConverterResult result;
+    GltfConverterResult& result) {
+  std::vector<gsl::span<const std::byte>> innerTiles;
   if (cmptBinary.size() < sizeof(CmptHeader)) {
     result.errors.emplaceWarning("Composite tile must be at least 16 bytes.");
-    return result;
+    return innerTiles;
   }
 
   const CmptHeader* pHeader =
@@ -36,14 +39,14 @@ GltfConverterResult CmptToGltfConverter::convert(
   if (std::string(pHeader->magic, 4) != "cmpt") {
     result.errors.emplaceWarning(
         "Composite tile does not have the expected magic vaue 'cmpt'.");
-    return result;
+    return innerTiles;
   }
 
   if (pHeader->version != 1) {
     result.errors.emplaceWarning(fmt::format(
         "Unsupported composite tile version {}.",
         pHeader->version));
-    return result;
+    return innerTiles;
   }
 
   if (pHeader->byteLength > cmptBinary.size()) {
@@ -51,10 +54,9 @@ GltfConverterResult CmptToGltfConverter::convert(
         "Composite tile byteLength is {} but only {} bytes are available.",
         pHeader->byteLength,
         cmptBinary.size()));
-    return result;
+    return innerTiles;
   }
 
-  std::vector<GltfConverterResult> innerTiles;
   uint32_t pos = sizeof(CmptHeader);
 
   for (uint32_t i = 0; i < pHeader->tilesLength && pos < pHeader->byteLength;
@@ -72,28 +74,83 @@ GltfConverterResult CmptToGltfConverter::convert(
       break;
     }
 
-    const gsl::span<const std::byte> innerData(
-        cmptBinary.data() + pos,
-        pInner->byteLength);
+    innerTiles.emplace_back(cmptBinary.data() + pos, pInner->byteLength);
 
     pos += pInner->byteLength;
+  }
 
-    innerTiles.emplace_back(GltfConverters::convert(innerData, options));
+  if (innerTiles.empty() && pHeader->tilesLength > 0) {
+    result.errors.emplaceWarning(
+        "Composite tile does not contain any loadable inner "
+        "tiles.");
   }
 
-  uint32_t tilesLength = pHeader->tilesLength;
-  if (innerTiles.empty()) {
-    if (tilesLength > 0) {
-      result.errors.emplaceWarning(
-          "Composite tile does not contain any loadable inner "
-          "tiles.");
+  return innerTiles;
+}
+
+// Reserves room for all of the elements of the inner tile models, so that
+// merging them one after another does not reallocate the merged model's
+// arrays each time.
+void reserveMergedModel(
+    CesiumGltf::Model& merged,
+    const std::vector<GltfConverterResult>& innerTiles) {
+  size_t accessorCount = 0;
+  size_t animationCount = 0;
+  size_t bufferCount = 0;
+  size_t bufferViewCount = 0;
+  size_t cameraCount = 0;
+  size_t imageCount = 0;
+  size_t materialCount = 0;
+  size_t meshCount = 0;
+  size_t nodeCount = 0;
+  size_t samplerCount = 0;
+  size_t sceneCount = 0;
+  size_t skinCount = 0;
+  size_t textureCount = 0;
+  for (const GltfConverterResult& innerTile : innerTiles) {
+    if (!innerTile.model) {
+      continue;
     }
 
-    return result;
+    const CesiumGltf::Model& model = *innerTile.model;
+    accessorCount += model.accessors.size();
+    animationCount += model.animations.size();
+    bufferCount += model.buffers.size();
+    bufferViewCount += model.bufferViews.size();
+    cameraCount += model.cameras.size();
+    imageCount += model.images.size();
+    materialCount += model.materials.size();
+    meshCount += model.meshes.size();
+    nodeCount += model.nodes.size();
+    samplerCount += model.samplers.size();
+    // Each merge may add a default scene that combines the two models.
+    sceneCount += model.scenes.size() + 1;
+    skinCount += model.skins.size();
+    textureCount += model.textures.size();
   }
 
+  merged.accessors.reserve(accessorCount);
+  merged.animations.reserve(animationCount);
+  merged.buffers.reserve(bufferCount);
+  merged.bufferViews.reserve(bufferViewCount);
+  merged.cameras.reserve(cameraCount);
+  merged.images.reserve(imageCount);
+  merged.materials.reserve(materialCount);
+  merged.meshes.reserve(meshCount);
+  merged.nodes.reserve(nodeCount);
+  merged.samplers.reserve(samplerCount);
+  merged.scenes.reserve(sceneCount);
+  merged.skins.reserve(skinCount);
+  merged.textures.reserve(textureCount);
+}
+
+void mergeInnerTiles(
+    std::vector<GltfConverterResult>&& innerTiles,
+    GltfConverterResult& result) {
   if (innerTiles.size() == 1) {
-    return std::move(innerTiles[0]);
+    innerTiles[0].errors.merge(std::move(result.errors));
+    result = std::move(innerTiles[0]);
+    return;
   }
 
   for (size_t i = 0; i < innerTiles.size(); ++i) {
@@ -102,12 +159,66 @@ GltfConverterResult CmptToGltfConverter::convert(
         result.model->merge(std::move(*innerTiles[i].model));
       } else {
         result.model = std::move(innerTiles[i].model);
+        reserveMergedModel(*result.model, innerTiles);
       }
     }
 
     result.errors.merge(innerTiles[i].errors);
   }
+}
+} // namespace
 
+GltfConverterResult CmptToGltfConverter::convert(
+    const gsl::span<const std::byte>& cmptBinary,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  GltfConverterResult result;
+  const std::vector<gsl::span<const std::byte>> innerData =
+      findInnerTiles(cmptBinary, result);
+  if (innerData.empty()) {
+    return result;
+  }
+
+  std::vector<GltfConverterResult> innerTiles;
+  innerTiles.reserve(innerData.size());
+  for (const gsl::span<const std::byte>& data : innerData) {
+    innerTiles.emplace_back(GltfConverters::convert(data, options));
+  }
+
+  mergeInnerTiles(std::move(innerTiles), result);
   return result;
 }
+
+CesiumAsync::Future<GltfConverterResult> CmptToGltfConverter::convert(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    std::vector<std::byte>&& cmptBinary,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  // The inner tiles refer to the composite tile's data, so it is kept alive
+  // until the last of them is converted.
+  auto pCmptBinary =
+      std::make_shared<std::vector<std::byte>>(std::move(cmptBinary));
+
+  GltfConverterResult result;
+  const std::vector<gsl::span<const std::byte>> innerData =
+      findInnerTiles(*pCmptBinary, result);
+  if (innerData.empty()) {
+    return asyncSystem.createResolvedFuture(std::move(result));
+  }
+
+  std::vector<CesiumAsync::Future<GltfConverterResult>> futures;
+  futures.reserve(innerData.size());
+  for (const gsl::span<const std::byte>& data : innerData) {
+    futures.emplace_back(
+        asyncSystem.runInWorkerThread([pCmptBinary, data, options]() {
+          return GltfConverters::convert(data, options);
+        }));
+  }
+
+  return asyncSystem.all(std::move(futures))
+      .thenImmediately(
+          [result = std::move(result)](
+              std::vector<GltfConverterResult>&& innerTiles) mutable {
+            mergeInnerTiles(std::move(innerTiles), result);
+            return std::move(result);
+          });
+}
 } // namespace Cesium3DTilesContent
@@ -8,6 +8,9 @@ namespace Cesium3DTilesContent {
 std::unordered_map<std::string, GltfConverters::ConverterFunction>
     GltfConverters::_loadersByMagic;
 
+std::unordered_map<std::string, GltfConverters::OwningConverterFunction>
+    GltfConverters::_owningLoadersByMagic;
+
 std::unordered_map<std::string, GltfConverters::ConverterFunction>
     GltfConverters::_loadersByFileExtension;
 
@@ -17,6 +20,12 @@ void GltfConverters::registerMagic(
   _loadersByMagic[magic] = converter;
 }
 
+void GltfConverters::registerOwningMagic(
+    const std::string& magic,
+    OwningConverterFunction converter) {
+  _owningLoadersByMagic[magic] = converter;
+}
+
 void GltfConverters::registerFileExtension(
     const std::string& fileExtension,
     ConverterFunction converter) {
@@ -37,6 +46,20 @@ GltfConverters::getConverterByMagic(const gsl::span<const std::byte>& content) {
   return getConverterByMagic(content, magic);
 }
 
+GltfConverters::OwningConverterFunction
+GltfConverters::getOwningConverterByMagic(
+    const gsl::span<const std::byte>& content) {
+  if (content.size() >= 4) {
+    const std::string magic(reinterpret_cast<const char*>(content.data()), 4);
+    auto converterIter = _owningLoadersByMagic.find(magic);
+    if (converterIter != _owningLoadersByMagic.end()) {
+      return converterIter->second;
+    }
+  }
+
+  return nullptr;
+}
+
 GltfConverterResult GltfConverters::convert(
     const std::string& filePath,
     const gsl::span<const std::byte>& content,
@@ -0,0 +1,719 @@
+#include "BatchTableToGltfStructuralMetadata.h"
+
+#include <Cesium3DTilesContent/BinaryToGltfConverter.h>
+#include <Cesium3DTilesContent/I3dmToGltfConverter.h>
+#include <CesiumGeometry/Transforms.h>
+#include <CesiumGeospatial/GlobeTransforms.h>
+#include <CesiumGltf/ExtensionCesiumRTC.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumUtility/AttributeCompression.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <rapidjson/document.h>
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace Cesium3DTilesContent {
+namespace {
+struct I3dmHeader {
+  unsigned char magic[4];
+  uint32_t version;
+  uint32_t byteLength;
+  uint32_t featureTableJsonByteLength;
+  uint32_t featureTableBinaryByteLength;
+  uint32_t batchTableJsonByteLength;
+  uint32_t batchTableBinaryByteLength;
+  uint32_t gltfFormat;
+};
+
+static_assert(sizeof(I3dmHeader) == 32);
+
+uint32_t getGlbStart(const I3dmHeader& header) {
+  return static_cast<uint32_t>(sizeof(I3dmHeader)) +
+         header.featureTableJsonByteLength +
+         header.featureTableBinaryByteLength + header.batchTableJsonByteLength +
+         header.batchTableBinaryByteLength;
+}
+
+void parseI3dmHeader(
+    const gsl::span<const std::byte>& instancesBinary,
+    I3dmHeader& header,
+    GltfConverterResult& result) {
+  if (instancesBinary.size() < sizeof(I3dmHeader)) {
+    result.errors.emplaceError("The I3DM is invalid because it is too small to "
+                               "include an I3DM header.");
+    return;
+  }
+
+  header = *reinterpret_cast<const I3dmHeader*>(instancesBinary.data());
+
+  if (header.version != 1) {
+    result.errors.emplaceError(fmt::format(
+        "The I3DM file is version {}, which is unsupported.",
+        header.version));
+    return;
+  }
+
+  if (instancesBinary.size() < header.byteLength) {
+    result.errors.emplaceError(
+        "The I3DM is invalid because the total data available is less than the "
+        "size specified in its header.");
+    return;
+  }
+
+  if (uint64_t(sizeof(I3dmHeader)) + header.featureTableJsonByteLength +
+          header.featureTableBinaryByteLength +
+          header.batchTableJsonByteLength + header.batchTableBinaryByteLength >=
+      header.byteLength) {
+    result.errors.emplaceError(
+        "The I3DM is invalid because the start of the "
+        "glTF model is after the end of the entire I3DM.");
+    return;
+  }
+
+  if (header.gltfFormat == 0) {
+    result.errors.emplaceError(
+        "The I3DM refers to its glTF model by URI, which is not supported. "
+        "Only I3DMs that embed a binary glTF model can be loaded.");
+  } else if (header.gltfFormat != 1) {
+    result.errors.emplaceError(fmt::format(
+        "The I3DM has an unknown gltfFormat {}.",
+        header.gltfFormat));
+  }
+}
+
+// The transforms and batch IDs of the instances in an i3dm, in the coordinate
+// system of the tile.
+struct I3dmInstances {
+  uint32_t instancesLength = 0;
+  glm::dvec3 rtcCenter{0.0};
+  std::vector<glm::dvec3> positions;
+
+  // Empty if the instances are not rotated.
+  std::vector<glm::dmat3> rotations;
+
+  // Empty if the instances are not scaled.
+  std::vector<glm::dvec3> scales;
+
+  // Empty if the feature table has no BATCH_ID.
+  std::vector<uint32_t> batchIds;
+};
+
+std::optional<glm::dvec3> getGlobalVec3(
+    const rapidjson::Document& featureTableJson,
+    const char* semantic) {
+  const auto it = featureTableJson.FindMember(semantic);
+  if (it == featureTableJson.MemberEnd() || !it->value.IsArray() ||
+      it->value.Size() != 3 || !it->value[0].IsNumber() ||
+      !it->value[1].IsNumber() || !it->value[2].IsNumber()) {
+    return std::nullopt;
+  }
+
+  const rapidjson::Value& value = it->value;
+  return glm::dvec3(
+      value[0].GetDouble(),
+      value[1].GetDouble(),
+      value[2].GetDouble());
+}
+
+// Copies the per-instance values of a semantic out of the feature table
+// binary. Returns false if the semantic is not defined, or if it is invalid,
+// in which case an error is added to the list.
+template <typename T>
+bool readBinaryProperty(
+    const rapidjson::Document& featureTableJson,
+    const gsl::span<const std::byte>& featureTableBinaryData,
+    const char* semantic,
+    uint32_t instancesLength,
+    std::vector<T>& values,
+    ErrorList& errors) {
+  const auto it = featureTableJson.FindMember(semantic);
+  if (it == featureTableJson.MemberEnd()) {
+    return false;
+  }
+
+  const rapidjson::Value& property = it->value;
+  if (!property.IsObject() || !property.HasMember("byteOffset") ||
+      !property["byteOffset"].IsUint()) {
+    errors.emplaceError(fmt::format(
+        "Error parsing I3DM feature table, {} does not have a valid "
+        "byteOffset.",
+        semantic));
+    return false;
+  }
+
+  const size_t byteOffset = property["byteOffset"].GetUint();
+  const size_t byteLength = size_t(instancesLength) * sizeof(T);
+  if (byteOffset + byteLength > featureTableBinaryData.size()) {
+    errors.emplaceError(fmt::format(
+        "Error parsing I3DM feature table, {} extends past the end of the "
+        "feature table binary.",
+        semantic));
+    return false;
+  }
+
+  values.resize(instancesLength);
+  std::memcpy(
+      values.data(),
+      featureTableBinaryData.data() + byteOffset,
+      byteLength);
+  return true;
+}
+
+bool readBatchIds(
+    const rapidjson::Document& featureTableJson,
+    const gsl::span<const std::byte>& featureTableBinaryData,
+    uint32_t instancesLength,
+    std::vector<uint32_t>& batchIds,
+    ErrorList& errors) {
+  const auto it = featureTableJson.FindMember("BATCH_ID");
+  if (it == featureTableJson.MemberEnd()) {
+    return false;
+  }
+
+  std::string componentType = "UNSIGNED_SHORT";
+  if (it->value.IsObject()) {
+    const auto componentTypeIt = it->value.FindMember("componentType");
+    if (componentTypeIt != it->value.MemberEnd() &&
+        componentTypeIt->value.IsString()) {
+      componentType = componentTypeIt->value.GetString();
+    }
+  }
+
+  auto readAs = [&](auto componentValue) {
+    std::vector<decltype(componentValue)> values;
+    if (!readBinaryProperty(
+            featureTableJson,
+            featureTableBinaryData,
+            "BATCH_ID",
+            instancesLength,
+            values,
+            errors)) {
+      return false;
+    }
+
+    batchIds.assign(values.begin(), values.end());
+    return true;
+  };
+
+  if (componentType == "UNSIGNED_BYTE") {
+    return readAs(uint8_t());
+  }
+  if (componentType == "UNSIGNED_SHORT") {
+    return readAs(uint16_t());
+  }
+  if (componentType == "UNSIGNED_INT") {
+    return readAs(uint32_t());
+  }
+
+  errors.emplaceError(fmt::format(
+      "Error parsing I3DM feature table, BATCH_ID has an invalid "
+      "componentType {}.",
+      componentType));
+  return false;
+}
+
+// The instance's x axis points right, its y axis up, and its z axis forward.
+glm::dmat3
+createRotationFromUpAndRight(const glm::dvec3& up, const glm::dvec3& right) {
+  return glm::dmat3(right, up, glm::cross(right, up));
+}
+
+I3dmInstances parseInstances(
+    const rapidjson::Document& featureTableJson,
+    const gsl::span<const std::byte>& featureTableBinaryData,
+    ErrorList& errors) {
+  I3dmInstances instances;
+
+  const auto instancesLengthIt =
+      featureTableJson.FindMember("INSTANCES_LENGTH");
+  if (instancesLengthIt == featureTableJson.MemberEnd() ||
+      !instancesLengthIt->value.IsUint()) {
+    errors.emplaceError("Error parsing I3DM feature table, there is no valid "
+                        "INSTANCES_LENGTH.");
+    return instances;
+  }
+
+  const uint32_t instancesLength = instancesLengthIt->value.GetUint();
+  instances.instancesLength = instancesLength;
+  instances.rtcCenter = getGlobalVec3(featureTableJson, "RTC_CENTER")
+                            .value_or(glm::dvec3(0.0));
+
+  auto readSemantic = [&](const char* semantic, auto& values) {
+    return readBinaryProperty(
+        featureTableJson,
+        featureTableBinaryData,
+        semantic,
+        instancesLength,
+        values,
+        errors);
+  };
+
+  std::vector<glm::vec3> positions;
+  std::vector<glm::u16vec3> quantizedPositions;
+  if (readSemantic("POSITION", positions)) {
+    instances.positions.reserve(instancesLength);
+    for (const glm::vec3& position : positions) {
+      instances.positions.emplace_back(position);
+    }
+  } else if (
+      !errors && readSemantic("POSITION_QUANTIZED", quantizedPositions)) {
+    const std::optional<glm::dvec3> quantizedVolumeOffset =
+        getGlobalVec3(featureTableJson, "QUANTIZED_VOLUME_OFFSET");
+    const std::optional<glm::dvec3> quantizedVolumeScale =
+        getGlobalVec3(featureTableJson, "QUANTIZED_VOLUME_SCALE");
+    if (!quantizedVolumeOffset || !quantizedVolumeScale) {
+      errors.emplaceError(
+          "Error parsing I3DM feature table, POSITION_QUANTIZED is used but "
+          "no valid QUANTIZED_VOLUME_OFFSET and QUANTIZED_VOLUME_SCALE were "
+          "found.");
+      return instances;
+    }
+
+    const glm::dvec3 quantizedPositionScalar = *quantizedVolumeScale / 65535.0;
+    instances.positions.reserve(instancesLength);
+    for (const glm::u16vec3& quantizedPosition : quantizedPositions) {
+      instances.positions.emplace_back(
+          glm::dvec3(quantizedPosition) * quantizedPositionScalar +
+          *quantizedVolumeOffset);
+    }
+  } else {
+    if (!errors) {
+      errors.emplaceError(
+          "Error parsing I3DM feature table, one of POSITION or "
+          "POSITION_QUANTIZED must be defined.");
+    }
+    return instances;
+  }
+
+  std::vector<glm::vec3> normalUp;
+  std::vector<glm::vec3> normalRight;
+  std::vector<glm::u16vec2> normalUpOct32p;
+  std::vector<glm::u16vec2> normalRightOct32p;
+  if (readSemantic("NORMAL_UP", normalUp)) {
+    if (!readSemantic("NORMAL_RIGHT", normalRight)) {
+      if (!errors) {
+        errors.emplaceError("Error parsing I3DM feature table, NORMAL_UP is "
+                            "defined but NORMAL_RIGHT is not.");
+      }
+      return instances;
+    }
+
+    instances.rotations.reserve(instancesLength);
+    for (uint32_t i = 0; i < instancesLength; ++i) {
+      instances.rotations.emplace_back(createRotationFromUpAndRight(
+          glm::dvec3(normalUp[i]),
+          glm::dvec3(normalRight[i])));
+    }
+  } else if (!errors && readSemantic("NORMAL_UP_OCT32P", normalUpOct32p)) {
+    if (!readSemantic("NORMAL_RIGHT_OCT32P", normalRightOct32p)) {
+      if (!errors) {
+        errors.emplaceError(
+            "Error parsing I3DM feature table, NORMAL_UP_OCT32P is defined "
+            "but NORMAL_RIGHT_OCT32P is not.");
+      }
+      return instances;
+    }
+
+    constexpr uint16_t rangeMax = 65535;
+    instances.rotations.reserve(instancesLength);
+    for (uint32_t i = 0; i < instancesLength; ++i) {
+      const glm::u16vec2 up = normalUpOct32p[i];
+      const glm::u16vec2 right = normalRightOct32p[i];
+      instances.rotations.emplace_back(createRotationFromUpAndRight(
+          AttributeCompression::octDecodeInRange(up.x, up.y, rangeMax),
+          AttributeCompression::octDecodeInRange(right.x, right.y, rangeMax)));
+    }
+  } else if (errors) {
+    return instances;
+  } else {
+    const auto eastNorthUpIt = featureTableJson.FindMember("EAST_NORTH_UP");
+    if (eastNorthUpIt != featureTableJson.MemberEnd() &&
+        eastNorthUpIt->value.IsBool() && eastNorthUpIt->value.GetBool()) {
+      instances.rotations.reserve(instancesLength);
+      for (const glm::dvec3& position : instances.positions) {
+        instances.rotations.emplace_back(
+            GlobeTransforms::eastNorthUpToFixedFrame(
+                instances.rtcCenter + position));
+      }
+    }
+  }
+
+  std::vector<float> scale;
+  std::vector<glm::vec3> scaleNonUniform;
+  const bool hasScale = readSemantic("SCALE", scale);
+  const bool hasScaleNonUniform =
+      readSemantic("SCALE_NON_UNIFORM", scaleNonUniform);
+  if (errors) {
+    return instances;
+  }
+
+  if (hasScale || hasScaleNonUniform) {
+    instances.scales.resize(instancesLength, glm::dvec3(1.0));
+    for (uint32_t i = 0; i < instancesLength; ++i) {
+      if (hasScale) {
+        instances.scales[i] *= static_cast<double>(scale[i]);
+      }
+      if (hasScaleNonUniform) {
+        instances.scales[i] *= glm::dvec3(scaleNonUniform[i]);
+      }
+    }
+  }
+
+  readBatchIds(
+      featureTableJson,
+      featureTableBinaryData,
+      instancesLength,
+      instances.batchIds,
+      errors);
+
+  return instances;
+}
+
+// Makes sure that the model has a valid default scene, adding a node for each
+// of its meshes if it has no nodes, and a scene for its first node if it has
+// no scenes, like Model::forEachPrimitiveInScene would traverse it.
+Scene& getDefaultScene(Model& gltf) {
+  if (gltf.nodes.empty()) {
+    Scene& scene = gltf.scenes.emplace_back();
+    for (size_t i = 0; i < gltf.meshes.size(); ++i) {
+      scene.nodes.emplace_back(static_cast<int32_t>(gltf.nodes.size()));
+      gltf.nodes.emplace_back().mesh = static_cast<int32_t>(i);
+    }
+    gltf.scene = static_cast<int32_t>(gltf.scenes.size() - 1);
+  } else if (gltf.scenes.empty()) {
+    gltf.scenes.emplace_back().nodes.emplace_back(0);
+    gltf.scene = 0;
+  } else if (
+      gltf.scene < 0 ||
+      gltf.scene >= static_cast<int32_t>(gltf.scenes.size())) {
+    gltf.scene = 0;
+  }
+
+  return gltf.scenes[static_cast<size_t>(gltf.scene)];
+}
+
+// Appends the values to the buffer, and adds an accessor for them.
+template <typename T>
+int32_t addInstanceAccessor(
+    Model& gltf,
+    int32_t bufferIndex,
+    const std::vector<T>& values,
+    int32_t componentType,
+    const std::string& type) {
+  Buffer& buffer = gltf.buffers[static_cast<size_t>(bufferIndex)];
+  const size_t byteOffset = buffer.cesium.data.size();
+  const size_t byteLength = values.size() * sizeof(T);
+  buffer.cesium.data.resize(byteOffset + byteLength);
+  std::memcpy(
+      buffer.cesium.data.data() + byteOffset,
+      values.data(),
+      byteLength);
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+
+  const int32_t bufferViewIndex = static_cast<int32_t>(gltf.bufferViews.size());
+  BufferView& bufferView = gltf.bufferViews.emplace_back();
+  bufferView.buffer = bufferIndex;
+  bufferView.byteOffset = static_cast<int64_t>(byteOffset);
+  bufferView.byteLength = static_cast<int64_t>(byteLength);
+
+  const int32_t accessorIndex = static_cast<int32_t>(gltf.accessors.size());
+  Accessor& accessor = gltf.accessors.emplace_back();
+  accessor.bufferView = bufferViewIndex;
+  accessor.componentType = componentType;
+  accessor.count = static_cast<int64_t>(values.size());
+  accessor.type = type;
+
+  return accessorIndex;
+}
+
+void addExtensionName(std::vector<std::string>& extensions) {
+  const std::string name = ExtensionExtMeshGpuInstancing::ExtensionName;
+  if (std::find(extensions.begin(), extensions.end(), name) ==
+      extensions.end()) {
+    extensions.emplace_back(name);
+  }
+}
+
+void addInstancesToGltf(
+    const I3dmInstances& instances,
+    Model& gltf,
+    ErrorList& errors) {
+  Scene& scene = getDefaultScene(gltf);
+  if (instances.instancesLength == 0) {
+    // Nothing is shown, rather than a single copy of the model.
+    scene.nodes.clear();
+    return;
+  }
+
+  // A CESIUM_RTC extension in the embedded glTF offsets the model within each
+  // instance. It is folded into the instance transforms.
+  glm::dvec3 modelRtcCenter(0.0);
+  const ExtensionCesiumRTC* pModelRtc = gltf.getExtension<ExtensionCesiumRTC>();
+  if (pModelRtc && pModelRtc->center.size() == 3) {
+    modelRtcCenter = glm::dvec3(
+        pModelRtc->center[0],
+        pModelRtc->center[1],
+        pModelRtc->center[2]);
+  }
+  gltf.extensions.erase(ExtensionCesiumRTC::ExtensionName);
+
+  // The instances are placed relative to the center of their bounds, so that
+  // the single-precision instance translations stay small. A new root node
+  // moves them to the center in double precision.
+  glm::dvec3 minimum(std::numeric_limits<double>::max());
+  glm::dvec3 maximum(std::numeric_limits<double>::lowest());
+  for (const glm::dvec3& position : instances.positions) {
+    minimum = glm::min(minimum, instances.rtcCenter + position);
+    maximum = glm::max(maximum, instances.rtcCenter + position);
+  }
+  const glm::dvec3 center = (minimum + maximum) * 0.5;
+
+  std::vector<glm::dmat4> instanceTransforms(instances.instancesLength);
+  for (size_t i = 0; i < instanceTransforms.size(); ++i) {
+    glm::dmat3 rotationScale =
+        instances.rotations.empty() ? glm::dmat3(1.0) : instances.rotations[i];
+    if (!instances.scales.empty()) {
+      rotationScale[0] *= instances.scales[i].x;
+      rotationScale[1] *= instances.scales[i].y;
+      rotationScale[2] *= instances.scales[i].z;
+    }
+
+    instanceTransforms[i] = glm::dmat4(
+        glm::dvec4(rotationScale[0], 0.0),
+        glm::dvec4(rotationScale[1], 0.0),
+        glm::dvec4(rotationScale[2], 0.0),
+        glm::dvec4(instances.rtcCenter + instances.positions[i] - center, 1.0));
+  }
+
+  std::vector<std::pair<int32_t, glm::dmat4>> meshNodes;
+  gltf.forEachPrimitiveInScene(
+      -1,
+      [&meshNodes](
+          Model& gltf_,
+          Node& node,
+          Mesh& /*mesh*/,
+          MeshPrimitive& /*primitive*/,
+          const glm::dmat4& transform) {
+        const int32_t nodeIndex =
+            static_cast<int32_t>(&node - gltf_.nodes.data());
+        if (meshNodes.empty() || meshNodes.back().first != nodeIndex) {
+          meshNodes.emplace_back(nodeIndex, transform);
+        }
+      });
+
+  const glm::dmat4 rootTransform =
+      Transforms::Z_UP_TO_Y_UP * glm::translate(glm::dmat4(1.0), center) *
+      Transforms::Y_UP_TO_Z_UP;
+  Node root;
+  root.matrix.assign(&rootTransform[0][0], &rootTransform[0][0] + 16);
+  root.children = std::move(scene.nodes);
+  scene.nodes = {static_cast<int32_t>(gltf.nodes.size())};
+  gltf.nodes.emplace_back(std::move(root));
+
+  const int32_t bufferIndex = static_cast<int32_t>(gltf.buffers.size());
+  gltf.buffers.emplace_back().cesium.data.reserve(
+      instanceTransforms.size() *
+      (meshNodes.size() *
+           (sizeof(glm::vec3) + sizeof(glm::vec4) + sizeof(glm::vec3)) +
+       sizeof(float)));
+
+  std::optional<int32_t> featureIdAccessor;
+  if (!instances.batchIds.empty()) {
+    std::vector<float> featureIds(instances.batchIds.size());
+    for (size_t i = 0; i < featureIds.size(); ++i) {
+      featureIds[i] = static_cast<float>(instances.batchIds[i]);
+    }
+    featureIdAccessor = addInstanceAccessor(
+        gltf,
+        bufferIndex,
+        featureIds,
+        Accessor::ComponentType::FLOAT,
+        Accessor::Type::SCALAR);
+  }
+
+  // A renderer transforms an instanced vertex by the instance transform, then
+  // by the node's, and then from y-up to z-up. Each instance transform is
+  // chosen so that this places the vertex where the i3dm's transform would,
+  // after transforming the model from y-up to z-up.
+  const glm::dmat4 modelRtcTransform =
+      glm::translate(glm::dmat4(1.0), modelRtcCenter);
+  std::vector<glm::vec3> translations(instanceTransforms.size());
+  std::vector<glm::vec4> rotations(instanceTransforms.size());
+  std::vector<glm::vec3> scales(instanceTransforms.size());
+  bool instanced = false;
+  for (const auto& [nodeIndex, nodeTransform] : meshNodes) {
+    Node& node = gltf.nodes[static_cast<size_t>(nodeIndex)];
+    if (node.hasExtension<ExtensionExtMeshGpuInstancing>()) {
+      errors.emplaceWarning(
+          "A node of the glTF model in the I3DM already has instances, so "
+          "the I3DM instances are not applied to it.");
+      continue;
+    }
+
+    const glm::dmat4 nodeToTile = Transforms::Y_UP_TO_Z_UP * nodeTransform;
+    const glm::dmat4 tileToNode = glm::inverse(nodeToTile);
+    const glm::dmat4 modelToTile = modelRtcTransform * nodeToTile;
+    for (size_t i = 0; i < instanceTransforms.size(); ++i) {
+      glm::dvec3 translation;
+      glm::dquat rotation;
+      glm::dvec3 scale;
+      Transforms::computeTranslationRotationScaleFromMatrix(
+          tileToNode * instanceTransforms[i] * modelToTile,
+          &translation,
+          &rotation,
+          &scale);
+      translations[i] = glm::vec3(translation);
+      rotations[i] = glm::vec4(
+          static_cast<float>(rotation.x),
+          static_cast<float>(rotation.y),
+          static_cast<float>(rotation.z),
+          static_cast<float>(rotation.w));
+      scales[i] = glm::vec3(scale);
+    }
+
+    ExtensionExtMeshGpuInstancing& instancing =
+        node.addExtension<ExtensionExtMeshGpuInstancing>();
+    instancing.attributes["TRANSLATION"] = addInstanceAccessor(
+        gltf,
+        bufferIndex,
+        translations,
+        Accessor::ComponentType::FLOAT,
+        Accessor::Type::VEC3);
+    instancing.attributes["ROTATION"] = addInstanceAccessor(
+        gltf,
+        bufferIndex,
+        rotations,
+        Accessor::ComponentType::FLOAT,
+        Accessor::Type::VEC4);
+    instancing.attributes["SCALE"] = addInstanceAccessor(
+        gltf,
+        bufferIndex,
+        scales,
+        Accessor::ComponentType::FLOAT,
+        Accessor::Type::VEC3);
+    if (featureIdAccessor) {
+      instancing.attributes["_FEATURE_ID_0"] = *featureIdAccessor;
+    }
+    instanced = true;
+  }
+
+  if (instanced) {
+    // Without the extension, the model would be shown once in the wrong
+    // place, so it is required.
+    addExtensionName(gltf.extensionsUsed);
+    addExtensionName(gltf.extensionsRequired);
+  }
+}
+
+rapidjson::Document parseJson(
+    const gsl::span<const std::byte>& jsonData,
+    const char* name,
+    ErrorList& errors) {
+  rapidjson::Document document;
+  document.Parse(
+      reinterpret_cast<const char*>(jsonData.data()),
+      jsonData.size());
+  if (document.HasParseError()) {
+    errors.emplaceError(fmt::format(
+        "Error when parsing {} JSON, error code {} at byte offset {}",
+        name,
+        document.GetParseError(),
+        document.GetErrorOffset()));
+  } else if (!document.IsObject()) {
+    errors.emplaceError(fmt::format("The {} JSON is not an object.", name));
+  }
+  return document;
+}
+} // namespace
+
+GltfConverterResult I3dmToGltfConverter::convert(
+    const gsl::span<const std::byte>& instancesBinary,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  GltfConverterResult result;
+  I3dmHeader header;
+  parseI3dmHeader(instancesBinary, header, result);
+  if (result.errors) {
+    return result;
+  }
+
+  const size_t featureTableJsonStart = sizeof(I3dmHeader);
+  const size_t featureTableBinaryStart =
+      featureTableJsonStart + header.featureTableJsonByteLength;
+  const size_t batchTableJsonStart =
+      featureTableBinaryStart + header.featureTableBinaryByteLength;
+  const size_t batchTableBinaryStart =
+      batchTableJsonStart + header.batchTableJsonByteLength;
+
+  const rapidjson::Document featureTableJson = parseJson(
+      instancesBinary.subspan(
+          featureTableJsonStart,
+          header.featureTableJsonByteLength),
+      "feature table",
+      result.errors);
+  if (result.errors) {
+    return result;
+  }
+
+  const I3dmInstances instances = parseInstances(
+      featureTableJson,
+      instancesBinary.subspan(
+          featureTableBinaryStart,
+          header.featureTableBinaryByteLength),
+      result.errors);
+  if (result.errors) {
+    return result;
+  }
+
+  const uint32_t glbStart = getGlbStart(header);
+  GltfConverterResult binToGltfResult = BinaryToGltfConverter::convert(
+      instancesBinary.subspan(glbStart, header.byteLength - glbStart),
+      options);
+  result.model = std::move(binToGltfResult.model);
+  result.errors.merge(std::move(binToGltfResult.errors));
+  if (result.errors) {
+    return result;
+  }
+
+  addInstancesToGltf(instances, *result.model, result.errors);
+
+  if (header.batchTableJsonByteLength > 0 && options.upgradeBatchTables) {
+    ErrorList batchTableErrors;
+    const rapidjson::Document batchTableJson = parseJson(
+        instancesBinary.subspan(
+            batchTableJsonStart,
+            header.batchTableJsonByteLength),
+        "batch table",
+        batchTableErrors);
+    if (batchTableErrors) {
+      result.errors.emplaceWarning(
+          "The I3DM batch table is being ignored because it is not valid "
+          "JSON.");
+      return result;
+    }
+
+    result.errors.merge(BatchTableToGltfStructuralMetadata::convertFromI3dm(
+        featureTableJson,
+        batchTableJson,
+        instancesBinary.subspan(
+            batchTableBinaryStart,
+            header.batchTableBinaryByteLength),
+        *result.model));
+  }
+
+  return result;
+}
+} // namespace Cesium3DTilesContent
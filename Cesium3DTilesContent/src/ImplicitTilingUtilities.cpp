@@ -12,11 +12,11 @@ using namespace CesiumGeometry;
 
 namespace Cesium3DTilesContent {
 
-std::string ImplicitTilingUtilities::resolveUrl(
-    const std::string& baseUrl,
+namespace {
+std::string substituteTileID(
     const std::string& urlTemplate,
     const QuadtreeTileID& quadtreeID) {
-  std::string url = CesiumUtility::Uri::substituteTemplateParameters(
+  return CesiumUtility::Uri::substituteTemplateParameters(
       urlTemplate,
       [&quadtreeID](const std::string& placeholder) {
         if (placeholder == "level") {
@@ -31,15 +31,12 @@ std::string ImplicitTilingUtilities::resolveUrl(
 
         return placeholder;
       });
-
-  return CesiumUtility::Uri::resolve(baseUrl, url);
 }
 
-std::string ImplicitTilingUtilities::resolveUrl(
-    const std::string& baseUrl,
+std::string substituteTileID(
     const std::string& urlTemplate,
     const OctreeTileID& octreeID) {
-  std::string url = CesiumUtility::Uri::substituteTemplateParameters(
+  return CesiumUtility::Uri::substituteTemplateParameters(
       urlTemplate,
       [&octreeID](const std::string& placeholder) {
         if (placeholder == "level") {
@@ -57,8 +54,39 @@ std::string ImplicitTilingUtilities::resolveUrl(
 
         return placeholder;
       });
+}
+} // namespace
+
+std::string ImplicitTilingUtilities::resolveUrl(
+    const std::string& baseUrl,
+    const std::string& urlTemplate,
+    const QuadtreeTileID& quadtreeID) {
+  return CesiumUtility::Uri::resolve(
+      baseUrl,
+      substituteTileID(urlTemplate, quadtreeID));
+}
+
+std::string ImplicitTilingUtilities::resolveUrl(
+    const CesiumUtility::BaseUri& baseUrl,
+    const std::string& urlTemplate,
+    const QuadtreeTileID& quadtreeID) {
+  return baseUrl.resolve(substituteTileID(urlTemplate, quadtreeID));
+}
+
+std::string ImplicitTilingUtilities::resolveUrl(
+    const std::string& baseUrl,
+    const std::string& urlTemplate,
+    const OctreeTileID& octreeID) {
+  return CesiumUtility::Uri::resolve(
+      baseUrl,
+      substituteTileID(urlTemplate, octreeID));
+}
 
-  return CesiumUtility::Uri::resolve(baseUrl, url);
+std::string ImplicitTilingUtilities::resolveUrl(
+    const CesiumUtility::BaseUri& baseUrl,
+    const std::string& urlTemplate,
+    const OctreeTileID& octreeID) {
+  return baseUrl.resolve(substituteTileID(urlTemplate, octreeID));
 }
 
 uint64_t ImplicitTilingUtilities::computeMortonIndex(
@@ -83,6 +111,22 @@ uint64_t ImplicitTilingUtilities::computeRelativeMortonIndex(
   return computeMortonIndex(absoluteTileIDToRelative(subtreeID, tileID));
 }
 
+uint64_t ImplicitTilingUtilities::computeAvailabilityIndex(
+    const QuadtreeTileID& subtreeID,
+    const QuadtreeTileID& tileID) {
+  const uint32_t relativeLevel = tileID.level - subtreeID.level;
+  const uint64_t tilesAbove = ((uint64_t(1) << (2 * relativeLevel)) - 1) / 3;
+  return tilesAbove + computeRelativeMortonIndex(subtreeID, tileID);
+}
+
+uint64_t ImplicitTilingUtilities::computeAvailabilityIndex(
+    const OctreeTileID& subtreeID,
+    const OctreeTileID& tileID) {
+  const uint32_t relativeLevel = tileID.level - subtreeID.level;
+  const uint64_t tilesAbove = ((uint64_t(1) << (3 * relativeLevel)) - 1) / 7;
+  return tilesAbove + computeRelativeMortonIndex(subtreeID, tileID);
+}
+
 CesiumGeometry::QuadtreeTileID ImplicitTilingUtilities::getSubtreeRootID(
     uint32_t subtreeLevels,
     const CesiumGeometry::QuadtreeTileID& tileID) noexcept {
@@ -245,6 +289,78 @@ ImplicitTilingUtilities::computeBoundingVolume(
       rootBoundingVolume.getMaximumHeight());
 }
 
+std::array<CesiumGeospatial::BoundingRegion, 8>
+ImplicitTilingUtilities::computeChildBoundingVolumes(
+    const CesiumGeospatial::BoundingRegion& parentBoundingVolume) noexcept {
+  const CesiumGeospatial::GlobeRectangle& rectangle =
+      parentBoundingVolume.getRectangle();
+  const double west = rectangle.getWest();
+  const double south = rectangle.getSouth();
+  const double east = rectangle.getEast();
+  const double north = rectangle.getNorth();
+  const double minimumHeight = parentBoundingVolume.getMinimumHeight();
+  const double maximumHeight = parentBoundingVolume.getMaximumHeight();
+
+  const double middleLongitude = (west + east) * 0.5;
+  const double middleLatitude = (south + north) * 0.5;
+  const double middleHeight = (minimumHeight + maximumHeight) * 0.5;
+
+  // Bits 0, 1, and 2 of the index are the x, y, and z of the child, like the
+  // order of OctreeChildren.
+  const auto child = [&](uint32_t index) {
+    const bool isEast = (index & 1) != 0;
+    const bool isNorth = (index & 2) != 0;
+    const bool isTop = (index & 4) != 0;
+    return CesiumGeospatial::BoundingRegion(
+        CesiumGeospatial::GlobeRectangle(
+            isEast ? middleLongitude : west,
+            isNorth ? middleLatitude : south,
+            isEast ? east : middleLongitude,
+            isNorth ? north : middleLatitude),
+        isTop ? middleHeight : minimumHeight,
+        isTop ? maximumHeight : middleHeight);
+  };
+
+  return {
+      child(0),
+      child(1),
+      child(2),
+      child(3),
+      child(4),
+      child(5),
+      child(6),
+      child(7)};
+}
+
+std::array<CesiumGeometry::OrientedBoundingBox, 8>
+ImplicitTilingUtilities::computeChildBoundingVolumes(
+    const CesiumGeometry::OrientedBoundingBox& parentBoundingVolume) noexcept {
+  const glm::dmat3 halfAxes = parentBoundingVolume.getHalfAxes() * 0.5;
+  const glm::dvec3& center = parentBoundingVolume.getCenter();
+
+  // Each child is offset from the center of the parent by its half axes,
+  // toward the side given by bits 0, 1, and 2 of the index.
+  const auto child = [&](uint32_t index) {
+    const glm::dvec3 signs(
+        (index & 1) != 0 ? 1.0 : -1.0,
+        (index & 2) != 0 ? 1.0 : -1.0,
+        (index & 4) != 0 ? 1.0 : -1.0);
+    return CesiumGeometry::OrientedBoundingBox(
+        center + halfAxes * signs,
+        halfAxes);
+  };
+
+  return {
+      child(0),
+      child(1),
+      child(2),
+      child(3),
+      child(4),
+      child(5),
+      child(6),
+      child(7)};
+}
+
 double
 ImplicitTilingUtilities::computeLevelDenominator(uint32_t level) noexcept {
   return static_cast<double>(1 << level);
@@ -24,6 +24,10 @@
 #include <rapidjson/document.h>
 #include <spdlog/fmt/fmt.h>
 
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <array>
+#include <cmath>
 #include <limits>
 
 using namespace CesiumGltf;
@@ -198,6 +202,33 @@ template <typename TColor> TColor srgbToLinear(const TColor srgb) {
   }
 }
 
+// Eight-bit sRGB colors only have 256 possible values per channel, so they are
+// converted with a table rather than a call to std::pow per channel.
+const std::array<float, 256>& getSrgbToLinearTable() {
+  static const std::array<float, 256> table = []() {
+    std::array<float, 256> result{};
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = std::pow(float(i) / 255.0f, 2.2f);
+    }
+    return result;
+  }();
+  return table;
+}
+
+glm::vec3 srgbToLinear(const glm::u8vec3& srgb) {
+  const std::array<float, 256>& table = getSrgbToLinearTable();
+  return glm::vec3(table[srgb.x], table[srgb.y], table[srgb.z]);
+}
+
+glm::vec4 srgbToLinear(const glm::u8vec4& srgb) {
+  const std::array<float, 256>& table = getSrgbToLinearTable();
+  return glm::vec4(
+      table[srgb.x],
+      table[srgb.y],
+      table[srgb.z],
+      float(srgb.w) / 255.0f);
+}
+
 struct PntsContent {
   uint32_t pointsLength = 0;
   std::optional<glm::dvec3> rtcCenter;
@@ -206,6 +237,10 @@ struct PntsContent {
   std::optional<glm::u8vec4> constantRgba;
   std::optional<uint32_t> batchLength;
 
+  // Whether quantized positions and oct-encoded normals are kept quantized in
+  // the glTF, according to the KHR_mesh_quantization extension.
+  bool keepQuantized = false;
+
   PntsSemantic position;
   bool positionQuantized = false;
   // required by glTF spec
@@ -953,14 +988,21 @@ void decodeDraco(
     int64_t decodedByteOffset = pPositionAttribute->byte_offset();
     int64_t decodedByteStride = pPositionAttribute->byte_stride();
 
+    glm::vec3 positionMin = parsedContent.positionMin;
+    glm::vec3 positionMax = parsedContent.positionMax;
     for (uint32_t i = 0; i < pointsLength; ++i) {
       const glm::vec3 position = *reinterpret_cast<const glm::vec3*>(
           decodedBuffer->data() + decodedByteOffset + decodedByteStride * i);
       outPositions[i] = position;
 
-      parsedContent.positionMin = glm::min(position, parsedContent.positionMin);
-      parsedContent.positionMax = glm::max(position, parsedContent.positionMax);
+      positionMin = glm::min(position, positionMin);
+      positionMax = glm::max(position, positionMax);
     }
+    parsedContent.positionMin = positionMin;
+    parsedContent.positionMax = positionMax;
+
+    // Draco has already dequantized the positions.
+    parsedContent.positionQuantized = false;
   }
 
   if (parsedContent.color) {
@@ -985,7 +1027,7 @@ void decodeDraco(
           const glm::u8vec4 rgbaColor = *reinterpret_cast<const glm::u8vec4*>(
               decodedBuffer->data() + decodedByteOffset +
               decodedByteStride * i);
-          outColors[i] = srgbToLinear(glm::vec4(rgbaColor) / 255.0f);
+          outColors[i] = srgbToLinear(rgbaColor);
         }
       } else if (
           parsedContent.colorType == PntsColorType::RGB &&
@@ -1004,7 +1046,7 @@ void decodeDraco(
           const glm::u8vec3 rgbColor = *reinterpret_cast<const glm::u8vec3*>(
               decodedBuffer->data() + decodedByteOffset +
               decodedByteStride * i);
-          outColors[i] = srgbToLinear(glm::vec3(rgbColor) / 255.0f);
+          outColors[i] = srgbToLinear(rgbColor);
         }
       } else {
         parsedContent.errors.emplaceWarning(
@@ -1023,6 +1065,7 @@ void decodeDraco(
           pPointCloud->attribute(normal.dracoId.value());
       if (validateDracoAttribute(pNormalAttribute, draco::DT_FLOAT32, 3)) {
         getDracoData<glm::vec3>(pNormalAttribute, normal.data, pointsLength);
+        parsedContent.normalOctEncoded = false;
       } else {
         parsedContent.errors.emplaceWarning("Error parsing decoded Draco point "
                                             "cloud, invalid normal attribute. "
@@ -1093,45 +1136,60 @@ void parsePositionsFromFeatureTableBinary(
   }
 
   const uint32_t pointsLength = parsedContent.pointsLength;
-  const size_t positionsByteStride = sizeof(glm::vec3);
-  const size_t positionsByteLength = pointsLength * positionsByteStride;
-  positionData.resize(positionsByteLength);
-
-  gsl::span<glm::vec3> outPositions(
-      reinterpret_cast<glm::vec3*>(positionData.data()),
-      pointsLength);
+  glm::vec3 positionMin = parsedContent.positionMin;
+  glm::vec3 positionMax = parsedContent.positionMax;
 
   if (parsedContent.positionQuantized) {
-    // PERFORMANCE_IDEA: In the future, it might be more performant to detect
-    // if the recipient engine can handle dequantization itself, and if so, use
-    // the KHR_mesh_quantization extension to avoid dequantizing here.
     const gsl::span<const glm::u16vec3> quantizedPositions(
         reinterpret_cast<const glm::u16vec3*>(
             featureTableBinaryData.data() + parsedContent.position.byteOffset),
         pointsLength);
 
-    const glm::vec3 quantizedVolumeScale(
-        parsedContent.quantizedVolumeScale.value());
-    const glm::vec3 quantizedVolumeOffset(
-        parsedContent.quantizedVolumeOffset.value());
-
-    const glm::vec3 quantizedPositionScalar = quantizedVolumeScale / 65535.0f;
-
-    for (size_t i = 0; i < pointsLength; i++) {
-      const glm::vec3 quantizedPosition(
-          quantizedPositions[i].x,
-          quantizedPositions[i].y,
-          quantizedPositions[i].z);
-
-      const glm::vec3 dequantizedPosition =
-          quantizedPosition * quantizedPositionScalar + quantizedVolumeOffset;
-      outPositions[i] = dequantizedPosition;
-      parsedContent.positionMin =
-          glm::min(parsedContent.positionMin, dequantizedPosition);
-      parsedContent.positionMax =
-          glm::max(parsedContent.positionMax, dequantizedPosition);
+    if (parsedContent.keepQuantized) {
+      // KHR_mesh_quantization requires each vertex attribute element to be
+      // aligned to four bytes, so the positions are padded to eight bytes.
+      positionData.resize(pointsLength * sizeof(glm::u16vec4));
+      gsl::span<glm::u16vec4> outPositions(
+          reinterpret_cast<glm::u16vec4*>(positionData.data()),
+          pointsLength);
+
+      for (size_t i = 0; i < pointsLength; i++) {
+        const glm::u16vec3 quantizedPosition = quantizedPositions[i];
+        outPositions[i] = glm::u16vec4(quantizedPosition, 0);
+
+        // The accessor min / max are in quantized units.
+        positionMin = glm::min(positionMin, glm::vec3(quantizedPosition));
+        positionMax = glm::max(positionMax, glm::vec3(quantizedPosition));
+      }
+    } else {
+      positionData.resize(pointsLength * sizeof(glm::vec3));
+      gsl::span<glm::vec3> outPositions(
+          reinterpret_cast<glm::vec3*>(positionData.data()),
+          pointsLength);
+
+      const glm::vec3 quantizedVolumeScale(
+          parsedContent.quantizedVolumeScale.value());
+      const glm::vec3 quantizedVolumeOffset(
+          parsedContent.quantizedVolumeOffset.value());
+
+      const glm::vec3 quantizedPositionScalar =
+          quantizedVolumeScale / 65535.0f;
+
+      for (size_t i = 0; i < pointsLength; i++) {
+        const glm::vec3 dequantizedPosition =
+            glm::vec3(quantizedPositions[i]) * quantizedPositionScalar +
+            quantizedVolumeOffset;
+        outPositions[i] = dequantizedPosition;
+        positionMin = glm::min(positionMin, dequantizedPosition);
+        positionMax = glm::max(positionMax, dequantizedPosition);
+      }
     }
   } else {
+    positionData.resize(pointsLength * sizeof(glm::vec3));
+    gsl::span<glm::vec3> outPositions(
+        reinterpret_cast<glm::vec3*>(positionData.data()),
+        pointsLength);
+
     // The position accessor min / max is required by the glTF spec, so
     // use a for loop instead of std::memcpy.
     const gsl::span<const glm::vec3> positions(
@@ -1141,10 +1199,13 @@ void parsePositionsFromFeatureTableBinary(
     for (size_t i = 0; i < pointsLength; i++) {
       const glm::vec3 position = positions[i];
       outPositions[i] = position;
-      parsedContent.positionMin = glm::min(parsedContent.positionMin, position);
-      parsedContent.positionMax = glm::max(parsedContent.positionMax, position);
+      positionMin = glm::min(positionMin, position);
+      positionMax = glm::max(positionMax, position);
     }
   }
+
+  parsedContent.positionMin = positionMin;
+  parsedContent.positionMax = positionMax;
 }
 
 void parseColorsFromFeatureTableBinary(
@@ -1174,8 +1235,7 @@ void parseColorsFromFeatureTableBinary(
         pointsLength);
 
     for (size_t i = 0; i < pointsLength; i++) {
-      glm::vec4 normalizedColor = glm::vec4(rgbaColors[i]) / 255.0f;
-      outColors[i] = srgbToLinear(normalizedColor);
+      outColors[i] = srgbToLinear(rgbaColors[i]);
     }
   } else if (parsedContent.colorType == PntsColorType::RGB) {
     const gsl::span<const glm::u8vec3> rgbColors(
@@ -1187,8 +1247,7 @@ void parseColorsFromFeatureTableBinary(
         pointsLength);
 
     for (size_t i = 0; i < pointsLength; i++) {
-      glm::vec3 normalizedColor = glm::vec3(rgbColors[i]) / 255.0f;
-      outColors[i] = srgbToLinear(normalizedColor);
+      outColors[i] = srgbToLinear(rgbColors[i]);
     }
   } else if (parsedContent.colorType == PntsColorType::RGB565) {
 
@@ -1220,9 +1279,6 @@ void parseNormalsFromFeatureTableBinary(
   }
 
   const uint32_t pointsLength = parsedContent.pointsLength;
-  const size_t normalsByteStride = sizeof(glm::vec3);
-  const size_t normalsByteLength = pointsLength * normalsByteStride;
-  normalData.resize(normalsByteLength);
 
   if (parsedContent.normalOctEncoded) {
     const gsl::span<const glm::u8vec2> encodedNormals(
@@ -1230,17 +1286,40 @@ void parseNormalsFromFeatureTableBinary(
             featureTableBinaryData.data() + normal.byteOffset),
         pointsLength);
 
-    gsl::span<glm::vec3> outNormals(
-        reinterpret_cast<glm::vec3*>(normalData.data()),
-        pointsLength);
-
-    for (size_t i = 0; i < pointsLength; i++) {
-      const glm::u8vec2 encodedNormal = encodedNormals[i];
-      outNormals[i] = glm::vec3(CesiumUtility::AttributeCompression::octDecode(
-          encodedNormal.x,
-          encodedNormal.y));
+    if (parsedContent.keepQuantized) {
+      // KHR_mesh_quantization has no oct-encoded normals, so they are decoded
+      // to normalized bytes instead, padded to four bytes for alignment.
+      normalData.resize(pointsLength * sizeof(glm::i8vec4));
+      gsl::span<glm::i8vec4> outNormals(
+          reinterpret_cast<glm::i8vec4*>(normalData.data()),
+          pointsLength);
+
+      for (size_t i = 0; i < pointsLength; i++) {
+        const glm::u8vec2 encodedNormal = encodedNormals[i];
+        const glm::dvec3 decodedNormal =
+            CesiumUtility::AttributeCompression::octDecode(
+                encodedNormal.x,
+                encodedNormal.y);
+        outNormals[i] =
+            glm::i8vec4(glm::i8vec3(glm::round(decodedNormal * 127.0)), 0);
+      }
+    } else {
+      normalData.resize(pointsLength * sizeof(glm::vec3));
+      gsl::span<glm::vec3> outNormals(
+          reinterpret_cast<glm::vec3*>(normalData.data()),
+          pointsLength);
+
+      for (size_t i = 0; i < pointsLength; i++) {
+        const glm::u8vec2 encodedNormal = encodedNormals[i];
+        outNormals[i] =
+            glm::vec3(CesiumUtility::AttributeCompression::octDecode(
+                encodedNormal.x,
+                encodedNormal.y));
+      }
     }
   } else {
+    const size_t normalsByteLength = pointsLength * sizeof(glm::vec3);
+    normalData.resize(normalsByteLength);
     std::memcpy(
         normalData.data(),
         featureTableBinaryData.data() + normal.byteOffset,
@@ -1343,8 +1422,12 @@ int32_t createAccessorInGltf(
 }
 
 void addPositionsToGltf(PntsContent& parsedContent, Model& gltf) {
+  const bool isQuantized =
+      parsedContent.keepQuantized && parsedContent.positionQuantized;
   const int64_t count = static_cast<int64_t>(parsedContent.pointsLength);
-  const int64_t byteStride = static_cast<int64_t>(sizeof(glm ::vec3));
+  const int64_t byteStride = isQuantized
+                                 ? static_cast<int64_t>(sizeof(glm::u16vec4))
+                                 : static_cast<int64_t>(sizeof(glm ::vec3));
   const int64_t byteLength = static_cast<int64_t>(byteStride * count);
   int32_t bufferId =
       createBufferInGltf(gltf, std::move(parsedContent.position.data));
@@ -1353,7 +1436,8 @@ void addPositionsToGltf(PntsContent& parsedContent, Model& gltf) {
   int32_t accessorId = createAccessorInGltf(
       gltf,
       bufferViewId,
-      Accessor::ComponentType::FLOAT,
+      isQuantized ? Accessor::ComponentType::UNSIGNED_SHORT
+                  : Accessor::ComponentType::FLOAT,
       count,
       Accessor::Type::VEC3);
 
@@ -1411,8 +1495,12 @@ void addColorsToGltf(PntsContent& parsedContent, Model& gltf) {
 void addNormalsToGltf(PntsContent& parsedContent, Model& gltf) {
   PntsSemantic& normal = parsedContent.normal.value();
 
+  const bool isQuantized =
+      parsedContent.keepQuantized && parsedContent.normalOctEncoded;
   const int64_t count = static_cast<int64_t>(parsedContent.pointsLength);
-  const int64_t byteStride = static_cast<int64_t>(sizeof(glm ::vec3));
+  const int64_t byteStride = isQuantized
+                                 ? static_cast<int64_t>(sizeof(glm::i8vec4))
+                                 : static_cast<int64_t>(sizeof(glm ::vec3));
   const int64_t byteLength = static_cast<int64_t>(byteStride * count);
 
   int32_t bufferId = createBufferInGltf(gltf, std::move(normal.data));
@@ -1421,9 +1509,11 @@ void addNormalsToGltf(PntsContent& parsedContent, Model& gltf) {
   int32_t accessorId = createAccessorInGltf(
       gltf,
       bufferViewId,
-      Accessor::ComponentType::FLOAT,
+      isQuantized ? Accessor::ComponentType::BYTE
+                  : Accessor::ComponentType::FLOAT,
       count,
       Accessor::Type::VEC3);
+  gltf.accessors[static_cast<uint32_t>(accessorId)].normalized = isQuantized;
 
   MeshPrimitive& primitive = gltf.meshes[0].primitives[0];
   primitive.attributes.emplace("NORMAL", accessorId);
@@ -1499,6 +1589,20 @@ void createGltfFromParsedContent(
 
   addPositionsToGltf(parsedContent, gltf);
 
+  if (parsedContent.keepQuantized && parsedContent.positionQuantized) {
+    // Dequantize the positions with the node transform instead.
+    const glm::dvec3 quantizedVolumeOffset =
+        parsedContent.quantizedVolumeOffset.value();
+    const glm::dvec3 quantizedVolumeScale =
+        parsedContent.quantizedVolumeScale.value();
+    const glm::dmat4 dequantization = glm::scale(
+        glm::translate(glm::dmat4(1.0), quantizedVolumeOffset),
+        quantizedVolumeScale / 65535.0);
+    const glm::dmat4 matrix =
+        CesiumGeometry::Transforms::Z_UP_TO_Y_UP * dequantization;
+    std::memcpy(node.matrix.data(), &matrix, sizeof(glm::dmat4));
+  }
+
   if (parsedContent.color) {
     addColorsToGltf(parsedContent, gltf);
   } else if (parsedContent.constantRgba) {
@@ -1522,6 +1626,13 @@ void createGltfFromParsedContent(
     addBatchIdsToGltf(parsedContent, gltf);
   }
 
+  if (parsedContent.keepQuantized && (parsedContent.positionQuantized ||
+                                      (parsedContent.normal &&
+                                       parsedContent.normalOctEncoded))) {
+    gltf.extensionsUsed.emplace_back("KHR_mesh_quantization");
+    gltf.extensionsRequired.emplace_back("KHR_mesh_quantization");
+  }
+
   if (parsedContent.rtcCenter) {
     // Add the RTC_CENTER value to the glTF as a CESIUM_RTC extension.
     // This matches what B3dmToGltfConverter does. In the future,
@@ -1538,10 +1649,12 @@ void convertPntsContentToGltf(
     const gsl::span<const std::byte>& pntsBinary,
     const PntsHeader& header,
     uint32_t headerLength,
+    const CesiumGltfReader::GltfReaderOptions& options,
     GltfConverterResult& result) {
   if (header.featureTableJsonByteLength > 0 &&
       header.featureTableBinaryByteLength > 0) {
     PntsContent parsedContent;
+    parsedContent.keepQuantized = !options.dequantizeMeshData;
 
     const gsl::span<const std::byte> featureTableJsonData =
         pntsBinary.subspan(headerLength, header.featureTableJsonByteLength);
@@ -1552,6 +1665,15 @@ void convertPntsContentToGltf(
       return;
     }
 
+    // Colors and normals that the renderer does not use are not decoded.
+    if (!options.isAttributeRequired("COLOR_0")) {
+      parsedContent.color.reset();
+      parsedContent.colorType = PntsColorType::CONSTANT;
+    }
+    if (!options.isAttributeRequired("NORMAL")) {
+      parsedContent.normal.reset();
+    }
+
     // If the batch table contains the 3DTILES_draco_point_compression
     // extension, the compressed metdata properties will be included in the
     // feature table binary. Parse both JSONs first in case the extension is
@@ -1594,7 +1716,8 @@ void convertPntsContentToGltf(
 
     createGltfFromParsedContent(parsedContent, result);
 
-    if (!batchTableJson.IsObject() || batchTableJson.HasParseError() ||
+    if (!options.upgradeBatchTables || !batchTableJson.IsObject() ||
+        batchTableJson.HasParseError() ||
         parsedContent.dracoMetadataHasErrors) {
       result.errors.merge(parsedContent.errors);
       return;
@@ -1619,7 +1742,7 @@ void convertPntsContentToGltf(
 
 GltfConverterResult PntsToGltfConverter::convert(
     const gsl::span<const std::byte>& pntsBinary,
-    const CesiumGltfReader::GltfReaderOptions& /*options*/) {
+    const CesiumGltfReader::GltfReaderOptions& options) {
   GltfConverterResult result;
   PntsHeader header;
   uint32_t headerLength = 0;
@@ -1628,7 +1751,7 @@ GltfConverterResult PntsToGltfConverter::convert(
     return result;
   }
 
-  convertPntsContentToGltf(pntsBinary, header, headerLength, result);
+  convertPntsContentToGltf(pntsBinary, header, headerLength, options, result);
   return result;
 }
 } // namespace Cesium3DTilesContent
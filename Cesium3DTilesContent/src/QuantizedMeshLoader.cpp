@@ -4,7 +4,6 @@
 #include <CesiumGeospatial/GlobeRectangle.h>
 #include <CesiumGeospatial/calcQuadtreeMaxGeometricError.h>
 #include <CesiumGltfContent/SkirtMeshMetadata.h>
-#include <CesiumUtility/AttributeCompression.h>
 #include <CesiumUtility/JsonHelpers.h>
 #include <CesiumUtility/Math.h>
 #include <CesiumUtility/Tracing.h>
@@ -15,8 +14,11 @@
 #include <glm/vec3.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <stdexcept>
+#include <vector>
 
 using namespace Cesium3DTilesContent;
 using namespace CesiumUtility;
@@ -127,14 +129,41 @@ void decodeIndices(
     throw std::runtime_error("decoded buffer is too small.");
   }
 
+  // The high-water mark is advanced without a branch, because whether a code
+  // is zero is unpredictable.
   E highest = 0;
   for (size_t i = 0; i < encoded.size(); ++i) {
-    E code = encoded[i];
-    E decodedIdx = static_cast<E>(highest - code);
-    decoded[i] = static_cast<D>(decodedIdx);
-    if (code == 0) {
-      ++highest;
-    }
+    const E code = encoded[i];
+    decoded[i] = static_cast<D>(static_cast<E>(highest - code));
+    highest = static_cast<E>(highest + static_cast<E>(code == 0));
+  }
+}
+
+// Decodes the zig-zag encoded deltas of one vertex attribute into the ratio of
+// each value to the largest quantized value. Only the running sum depends on
+// the previous vertex, so the decoding and the scaling are done in separate
+// passes that the compiler can vectorize.
+void decodeZigZagDeltas(
+    const gsl::span<const uint16_t>& encoded,
+    std::vector<int32_t>& scratch,
+    std::vector<double>& ratios) {
+  const size_t count = encoded.size();
+  scratch.resize(count);
+  ratios.resize(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    scratch[i] = zigZagDecode(encoded[i]);
+  }
+
+  int32_t value = 0;
+  for (size_t i = 0; i < count; ++i) {
+    value += scratch[i];
+    scratch[i] = value;
+  }
+
+  constexpr double oneOverMaximumValue = 1.0 / 32767.0;
+  for (size_t i = 0; i < count; ++i) {
+    ratios[i] = static_cast<double>(scratch[i]) * oneOverMaximumValue;
   }
 }
 
@@ -316,6 +345,10 @@ static std::optional<QuantizedMeshView> parseQuantizedMesh(
           gsl::span<const std::byte>(data.data() + readIndex, vertexCount * 2);
     } else if (enableWaterMask && extensionID == 2) {
       // Water Mask
+      if (readIndex + extensionLength > data.size()) {
+        break;
+      }
+
       if (extensionLength == 1) {
         // Either fully land or fully water
         meshView.onlyWater = static_cast<bool>(
@@ -324,10 +357,22 @@ static std::optional<QuantizedMeshView> parseQuantizedMesh(
       } else if (extensionLength == 65536) {
         // We have a 256*256 mask defining where the water is within the tile
         // 0 means land, 255 means water
-        meshView.onlyWater = false;
-        meshView.onlyLand = false;
-        meshView.waterMaskBuffer =
-            gsl::span<const std::byte>(data.data() + readIndex, 65536);
+        const std::byte* pMask = data.data() + readIndex;
+
+        // A mask that is all land or all water is flagged like a 1-byte mask,
+        // so that no image is created for it. Comparing the mask with itself
+        // shifted by one byte finds whether all of its bytes are the same.
+        const bool isUniform = std::memcmp(pMask, pMask + 1, 65535) == 0 &&
+                               (pMask[0] == std::byte(0) ||
+                                pMask[0] == std::byte(255));
+        if (isUniform) {
+          meshView.onlyWater = pMask[0] == std::byte(255);
+          meshView.onlyLand = !meshView.onlyWater;
+        } else {
+          meshView.onlyWater = false;
+          meshView.onlyLand = false;
+          meshView.waterMaskBuffer = gsl::span<const std::byte>(pMask, 65536);
+        }
       }
     } else if (extensionID == 4) {
       // Metadata
@@ -385,26 +430,32 @@ static void addSkirt(
   const double east = rectangle.getEast();
   const double north = rectangle.getNorth();
 
-  size_t newEdgeIndex = currentVertexCount;
+  // Convert the skirt vertices below the edge vertices to cartesian together.
+  const size_t edgeCount = edgeIndices.size();
+  std::vector<double> longitudes(edgeCount);
+  std::vector<double> latitudes(edgeCount);
+  std::vector<double> heights(edgeCount);
+  for (size_t i = 0; i < edgeCount; ++i) {
+    const glm::dvec3& uvAndHeight = uvsAndHeights[edgeIndices[i]];
+    longitudes[i] = Math::lerp(west, east, uvAndHeight.x) + longitudeOffset;
+    latitudes[i] = Math::lerp(south, north, uvAndHeight.y) + latitudeOffset;
+    heights[i] =
+        Math::lerp(minimumHeight, maximumHeight, uvAndHeight.z) - skirtHeight;
+  }
+
+  std::vector<double> xs(edgeCount);
+  std::vector<double> ys(edgeCount);
+  std::vector<double> zs(edgeCount);
+  ellipsoid.cartographicToCartesian(longitudes, latitudes, heights, xs, ys, zs);
+
+  const size_t newEdgeIndex = currentVertexCount;
   size_t positionIdx = currentVertexCount * 3;
-  size_t indexIdx = currentIndicesCount;
-  for (size_t i = 0; i < edgeIndices.size(); ++i) {
+  for (size_t i = 0; i < edgeCount; ++i) {
     E edgeIdx = edgeIndices[i];
 
-    const double uRatio = uvsAndHeights[edgeIdx].x;
-    const double vRatio = uvsAndHeights[edgeIdx].y;
-    const double heightRatio = uvsAndHeights[edgeIdx].z;
-    const double longitude = Math::lerp(west, east, uRatio) + longitudeOffset;
-    const double latitude = Math::lerp(south, north, vRatio) + latitudeOffset;
-    const double heightMeters =
-        Math::lerp(minimumHeight, maximumHeight, heightRatio) - skirtHeight;
-    glm::dvec3 position = ellipsoid.cartographicToCartesian(
-        Cartographic(longitude, latitude, heightMeters));
-    position -= center;
-
-    positions[positionIdx] = static_cast<float>(position.x);
-    positions[positionIdx + 1] = static_cast<float>(position.y);
-    positions[positionIdx + 2] = static_cast<float>(position.z);
+    positions[positionIdx] = static_cast<float>(xs[i] - center.x);
+    positions[positionIdx + 1] = static_cast<float>(ys[i] - center.y);
+    positions[positionIdx + 2] = static_cast<float>(zs[i] - center.z);
 
     if (!normals.empty()) {
       const size_t componentIndex = static_cast<size_t>(3 * edgeIdx);
@@ -413,20 +464,46 @@ static void addSkirt(
       normals[positionIdx + 2] = normals[componentIndex + 2];
     }
 
-    if (i < edgeIndices.size() - 1) {
-      E nextEdgeIdx = edgeIndices[i + 1];
-      indices[indexIdx++] = static_cast<I>(edgeIdx);
-      indices[indexIdx++] = static_cast<I>(nextEdgeIdx);
-      indices[indexIdx++] = static_cast<I>(newEdgeIndex);
+    positionIdx += 3;
+  }
 
-      indices[indexIdx++] = static_cast<I>(newEdgeIndex);
-      indices[indexIdx++] = static_cast<I>(nextEdgeIdx);
-      indices[indexIdx++] = static_cast<I>(newEdgeIndex + 1);
-    }
+  // Two triangles join each pair of adjacent edge vertices to the skirt
+  // vertices below them. This is a loop of its own, without a branch for the
+  // last edge vertex, so that it can be vectorized.
+  for (size_t i = 0; i + 1 < edgeCount; ++i) {
+    const I edgeIdx = static_cast<I>(edgeIndices[i]);
+    const I nextEdgeIdx = static_cast<I>(edgeIndices[i + 1]);
+    const I skirtIdx = static_cast<I>(newEdgeIndex + i);
+    const size_t indexIdx = currentIndicesCount + i * 6;
+    indices[indexIdx] = edgeIdx;
+    indices[indexIdx + 1] = nextEdgeIdx;
+    indices[indexIdx + 2] = skirtIdx;
+
+    indices[indexIdx + 3] = skirtIdx;
+    indices[indexIdx + 4] = nextEdgeIdx;
+    indices[indexIdx + 5] = static_cast<I>(skirtIdx + 1);
+  }
+}
 
-    ++newEdgeIndex;
-    positionIdx += 3;
+// Returns the given edge indices ordered by `isBefore`. Edges are usually
+// stored in order already, and then they are used as they are. Otherwise,
+// they are sorted into `sortedEdgeIndices`.
+template <class E, class Compare>
+static gsl::span<const E> orderEdgeIndices(
+    const gsl::span<const E>& edgeIndices,
+    std::vector<E>& sortedEdgeIndices,
+    Compare isBefore) {
+  if (std::is_sorted(edgeIndices.begin(), edgeIndices.end(), isBefore)) {
+    return edgeIndices;
   }
+
+  std::partial_sort_copy(
+      edgeIndices.begin(),
+      edgeIndices.end(),
+      sortedEdgeIndices.begin(),
+      sortedEdgeIndices.begin() + std::ptrdiff_t(edgeIndices.size()),
+      isBefore);
+  return gsl::span<const E>(sortedEdgeIndices.data(), edgeIndices.size());
 }
 
 template <class E, class I>
@@ -466,18 +543,14 @@ static void addSkirts(
   std::vector<E> sortEdgeIndices(maxEdgeVertexCount);
 
   // add skirt indices, vertices, and normals
-  gsl::span<const E> westEdgeIndices(
-      reinterpret_cast<const E*>(westEdgeIndicesBuffer.data()),
-      westVertexCount);
-  std::partial_sort_copy(
-      westEdgeIndices.begin(),
-      westEdgeIndices.end(),
-      sortEdgeIndices.begin(),
-      sortEdgeIndices.begin() + westVertexCount,
+  const gsl::span<const E> westEdgeIndices = orderEdgeIndices(
+      gsl::span<const E>(
+          reinterpret_cast<const E*>(westEdgeIndicesBuffer.data()),
+          westVertexCount),
+      sortEdgeIndices,
       [&uvsAndHeights](auto lhs, auto rhs) noexcept {
         return uvsAndHeights[lhs].y < uvsAndHeights[rhs].y;
       });
-  westEdgeIndices = gsl::span(sortEdgeIndices.data(), westVertexCount);
   addSkirt(
       ellipsoid,
       center,
@@ -497,18 +570,14 @@ static void addSkirts(
 
   currentVertexCount += westVertexCount;
   currentIndicesCount += (westVertexCount - 1) * 6;
-  gsl::span<const E> southEdgeIndices(
-      reinterpret_cast<const E*>(southEdgeIndicesBuffer.data()),
-      southVertexCount);
-  std::partial_sort_copy(
-      southEdgeIndices.begin(),
-      southEdgeIndices.end(),
-      sortEdgeIndices.begin(),
-      sortEdgeIndices.begin() + southVertexCount,
+  const gsl::span<const E> southEdgeIndices = orderEdgeIndices(
+      gsl::span<const E>(
+          reinterpret_cast<const E*>(southEdgeIndicesBuffer.data()),
+          southVertexCount),
+      sortEdgeIndices,
       [&uvsAndHeights](auto lhs, auto rhs) noexcept {
         return uvsAndHeights[lhs].x > uvsAndHeights[rhs].x;
       });
-  southEdgeIndices = gsl::span(sortEdgeIndices.data(), southVertexCount);
   addSkirt(
       ellipsoid,
       center,
@@ -528,18 +597,14 @@ static void addSkirts(
 
   currentVertexCount += southVertexCount;
   currentIndicesCount += (southVertexCount - 1) * 6;
-  gsl::span<const E> eastEdgeIndices(
-      reinterpret_cast<const E*>(eastEdgeIndicesBuffer.data()),
-      eastVertexCount);
-  std::partial_sort_copy(
-      eastEdgeIndices.begin(),
-      eastEdgeIndices.end(),
-      sortEdgeIndices.begin(),
-      sortEdgeIndices.begin() + eastVertexCount,
+  const gsl::span<const E> eastEdgeIndices = orderEdgeIndices(
+      gsl::span<const E>(
+          reinterpret_cast<const E*>(eastEdgeIndicesBuffer.data()),
+          eastVertexCount),
+      sortEdgeIndices,
       [&uvsAndHeights](auto lhs, auto rhs) noexcept {
         return uvsAndHeights[lhs].y > uvsAndHeights[rhs].y;
       });
-  eastEdgeIndices = gsl::span(sortEdgeIndices.data(), eastVertexCount);
   addSkirt(
       ellipsoid,
       center,
@@ -559,18 +624,14 @@ static void addSkirts(
 
   currentVertexCount += eastVertexCount;
   currentIndicesCount += (eastVertexCount - 1) * 6;
-  gsl::span<const E> northEdgeIndices(
-      reinterpret_cast<const E*>(northEdgeIndicesBuffer.data()),
-      northVertexCount);
-  std::partial_sort_copy(
-      northEdgeIndices.begin(),
-      northEdgeIndices.end(),
-      sortEdgeIndices.begin(),
-      sortEdgeIndices.begin() + northVertexCount,
+  const gsl::span<const E> northEdgeIndices = orderEdgeIndices(
+      gsl::span<const E>(
+          reinterpret_cast<const E*>(northEdgeIndicesBuffer.data()),
+          northVertexCount),
+      sortEdgeIndices,
       [&uvsAndHeights](auto lhs, auto rhs) noexcept {
         return uvsAndHeights[lhs].x < uvsAndHeights[rhs].x;
       });
-  northEdgeIndices = gsl::span(sortEdgeIndices.data(), northVertexCount);
   addSkirt(
       ellipsoid,
       center,
@@ -596,14 +657,31 @@ static void decodeNormals(
     throw std::runtime_error("decoded buffer is too small.");
   }
 
-  size_t normalOutputIndex = 0;
-  for (size_t i = 0; i < encoded.size(); i += 2) {
-    glm::dvec3 normal = AttributeCompression::octDecode(
-        static_cast<uint8_t>(encoded[i]),
-        static_cast<uint8_t>(encoded[i + 1]));
-    decoded[normalOutputIndex++] = static_cast<float>(normal.x);
-    decoded[normalOutputIndex++] = static_cast<float>(normal.y);
-    decoded[normalOutputIndex++] = static_cast<float>(normal.z);
+  // This is AttributeCompression::octDecode in single precision, with the
+  // fold of the lower hemisphere written as selects, so that the loop has no
+  // branches and can be vectorized.
+  const size_t normalCount = encoded.size() / 2;
+  for (size_t i = 0; i < normalCount; ++i) {
+    const float x =
+        static_cast<float>(static_cast<uint8_t>(encoded[2 * i])) *
+            (2.0f / 255.0f) -
+        1.0f;
+    const float y =
+        static_cast<float>(static_cast<uint8_t>(encoded[2 * i + 1])) *
+            (2.0f / 255.0f) -
+        1.0f;
+    const float z = 1.0f - (std::abs(x) + std::abs(y));
+
+    const float signX = x < 0.0f ? -1.0f : 1.0f;
+    const float signY = y < 0.0f ? -1.0f : 1.0f;
+    const float foldedX = z < 0.0f ? (1.0f - std::abs(y)) * signX : x;
+    const float foldedY = z < 0.0f ? (1.0f - std::abs(x)) * signY : y;
+
+    const float oneOverLength =
+        1.0f / std::sqrt(foldedX * foldedX + foldedY * foldedY + z * z);
+    decoded[3 * i] = foldedX * oneOverLength;
+    decoded[3 * i + 1] = foldedY * oneOverLength;
+    decoded[3 * i + 2] = z * oneOverLength;
   }
 }
 
@@ -692,7 +770,6 @@ static std::vector<std::byte> generateNormals(
   gsl::span<float> outputPositions(
       reinterpret_cast<float*>(outputPositionsBuffer.data()),
       (vertexCount + skirtVertexCount) * 3);
-  size_t positionOutputIndex = 0;
 
   const glm::dvec3 center(
       pHeader->BoundingSphereCenterX,
@@ -720,41 +797,51 @@ static std::vector<std::byte> generateNormals(
   const double east = rectangle.getEast();
   const double north = rectangle.getNorth();
 
-  int32_t u = 0;
-  int32_t v = 0;
-  int32_t height = 0;
-  std::vector<glm::dvec3> uvsAndHeights;
-  uvsAndHeights.reserve(vertexCount);
+  // Decode the vertices in passes over separate arrays, so that everything
+  // but the trigonometry can be vectorized.
+  std::vector<int32_t> scratch;
+  std::vector<double> uRatios;
+  std::vector<double> vRatios;
+  std::vector<double> heightRatios;
+  decodeZigZagDeltas(meshView->uBuffer, scratch, uRatios);
+  decodeZigZagDeltas(meshView->vBuffer, scratch, vRatios);
+  decodeZigZagDeltas(meshView->heightBuffer, scratch, heightRatios);
+
+  // Convert the vertices to cartesian with one batch conversion.
+  std::vector<double> longitudes(vertexCount);
+  std::vector<double> latitudes(vertexCount);
+  std::vector<double> heights(vertexCount);
+  for (size_t i = 0; i < vertexCount; ++i) {
+    longitudes[i] = Math::lerp(west, east, uRatios[i]);
+    latitudes[i] = Math::lerp(south, north, vRatios[i]);
+    heights[i] = Math::lerp(minimumHeight, maximumHeight, heightRatios[i]);
+  }
+
+  std::vector<double> xs(vertexCount);
+  std::vector<double> ys(vertexCount);
+  std::vector<double> zs(vertexCount);
+  ellipsoid.cartographicToCartesian(longitudes, latitudes, heights, xs, ys, zs);
+
+  for (size_t i = 0; i < vertexCount; ++i) {
+    const double x = xs[i] - center.x;
+    const double y = ys[i] - center.y;
+    const double z = zs[i] - center.z;
+    outputPositions[3 * i] = static_cast<float>(x);
+    outputPositions[3 * i + 1] = static_cast<float>(y);
+    outputPositions[3 * i + 2] = static_cast<float>(z);
+
+    minX = glm::min(minX, x);
+    minY = glm::min(minY, y);
+    minZ = glm::min(minZ, z);
+
+    maxX = glm::max(maxX, x);
+    maxY = glm::max(maxY, y);
+    maxZ = glm::max(maxZ, z);
+  }
+
+  std::vector<glm::dvec3> uvsAndHeights(vertexCount);
   for (size_t i = 0; i < vertexCount; ++i) {
-    u += zigZagDecode(meshView->uBuffer[i]);
-    v += zigZagDecode(meshView->vBuffer[i]);
-    height += zigZagDecode(meshView->heightBuffer[i]);
-
-    double uRatio = static_cast<double>(u) / 32767.0;
-    double vRatio = static_cast<double>(v) / 32767.0;
-    double heightRatio = static_cast<double>(height) / 32767.0;
-
-    const double longitude = Math::lerp(west, east, uRatio);
-    const double latitude = Math::lerp(south, north, vRatio);
-    const double heightMeters =
-        Math::lerp(minimumHeight, maximumHeight, heightRatio);
-
-    glm::dvec3 position = ellipsoid.cartographicToCartesian(
-        Cartographic(longitude, latitude, heightMeters));
-    position -= center;
-    outputPositions[positionOutputIndex++] = static_cast<float>(position.x);
-    outputPositions[positionOutputIndex++] = static_cast<float>(position.y);
-    outputPositions[positionOutputIndex++] = static_cast<float>(position.z);
-
-    minX = glm::min(minX, position.x);
-    minY = glm::min(minY, position.y);
-    minZ = glm::min(minZ, position.z);
-
-    maxX = glm::max(maxX, position.x);
-    maxY = glm::max(maxY, position.y);
-    maxZ = glm::max(maxZ, position.z);
-
-    uvsAndHeights.emplace_back(uRatio, vRatio, heightRatio);
+    uvsAndHeights[i] = glm::dvec3(uRatios[i], vRatios[i], heightRatios[i]);
   }
 
   // decode normal vertices of the tile as well as its metadata without skirt
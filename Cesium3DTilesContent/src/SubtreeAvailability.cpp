@@ -12,9 +12,12 @@
 #include <gsl/span>
 #include <rapidjson/document.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <vector>
 
 using namespace Cesium3DTiles;
 using namespace Cesium3DTilesReader;
@@ -72,6 +75,135 @@ std::optional<SubtreeAvailability::AvailabilityView> parseAvailabilityView(
   return std::nullopt;
 }
 
+// The number of bits in each block of a rank index.
+const uint64_t bitsPerRankBlock = 512;
+
+uint64_t countSetBits(uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<uint64_t>(__builtin_popcountll(word));
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) +
+         ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (word * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+// Reads the 64 bits starting at bit `wordIndex * 64`, where bit `i` is bit
+// `i % 8` of byte `i / 8`. Bits past the end of the bytes are zero.
+uint64_t
+readWord(const gsl::span<const std::byte>& bytes, uint64_t wordIndex) noexcept {
+  const uint64_t firstByte = wordIndex * 8;
+  const uint64_t endByte = std::min(firstByte + 8, uint64_t(bytes.size()));
+  uint64_t word = 0;
+  for (uint64_t i = firstByte; i < endByte; ++i) {
+    word |= uint64_t(bytes[i]) << ((i - firstByte) * 8);
+  }
+  return word;
+}
+
+// Counts the set bits from `firstBit`, which must be a multiple of 64, up to
+// but not including `endBit`.
+uint64_t countSetBits(
+    const gsl::span<const std::byte>& bytes,
+    uint64_t firstBit,
+    uint64_t endBit) noexcept {
+  uint64_t count = 0;
+  uint64_t wordIndex = firstBit / 64;
+  for (; wordIndex < endBit / 64; ++wordIndex) {
+    count += countSetBits(readWord(bytes, wordIndex));
+  }
+
+  const uint64_t remainingBits = endBit % 64;
+  if (remainingBits > 0) {
+    const uint64_t mask = (uint64_t(1) << remainingBits) - 1;
+    count += countSetBits(readWord(bytes, wordIndex) & mask);
+  }
+
+  return count;
+}
+
+std::vector<uint64_t> computeRankIndex(
+    const SubtreeAvailability::AvailabilityView& availabilityView) {
+  const SubtreeAvailability::SubtreeBufferViewAvailability*
+      pBufferViewAvailability =
+          std::get_if<SubtreeAvailability::SubtreeBufferViewAvailability>(
+              &availabilityView);
+  if (!pBufferViewAvailability) {
+    return {};
+  }
+
+  const gsl::span<const std::byte> bytes = pBufferViewAvailability->view;
+  const uint64_t bitCount = uint64_t(bytes.size()) * 8;
+
+  std::vector<uint64_t> rankIndex;
+  rankIndex.reserve(size_t(bitCount / bitsPerRankBlock + 1));
+
+  uint64_t count = 0;
+  for (uint64_t blockStart = 0; blockStart < bitCount;
+       blockStart += bitsPerRankBlock) {
+    rankIndex.emplace_back(count);
+    count += countSetBits(
+        bytes,
+        blockStart,
+        std::min(blockStart + bitsPerRankBlock, bitCount));
+  }
+
+  return rankIndex;
+}
+
+// Sets the availability of `elementCount` elements from the indices of the
+// available ones. The bits are set in 64-bit words, which are then counted
+// to find whether the availability is constant. Otherwise, the bitstream is
+// appended to the first buffer of the subtree, aligned to 8 bytes.
+void setAvailability(
+    Subtree& subtree,
+    uint64_t elementCount,
+    const gsl::span<const uint64_t>& availableIndices,
+    Cesium3DTiles::Availability& availability) {
+  std::vector<uint64_t> words(size_t((elementCount + 63) / 64), 0);
+  for (const uint64_t index : availableIndices) {
+    if (index < elementCount) {
+      words[size_t(index / 64)] |= uint64_t(1) << (index % 64);
+    }
+  }
+
+  uint64_t availableCount = 0;
+  for (const uint64_t word : words) {
+    availableCount += countSetBits(word);
+  }
+
+  if (availableCount == 0) {
+    availability.constant = Cesium3DTiles::Availability::Constant::UNAVAILABLE;
+    return;
+  }
+  if (availableCount == elementCount) {
+    availability.constant = Cesium3DTiles::Availability::Constant::AVAILABLE;
+    return;
+  }
+
+  Buffer& buffer = !subtree.buffers.empty() ? subtree.buffers[0]
+                                            : subtree.buffers.emplace_back();
+  const size_t byteOffset = (buffer.cesium.data.size() + 7) / 8 * 8;
+  const size_t byteLength = size_t((elementCount + 7) / 8);
+
+  // The bitstream is little-endian, so each word is written a byte at a time.
+  std::vector<std::byte>& data = buffer.cesium.data;
+  data.resize(byteOffset + byteLength);
+  for (size_t i = 0; i < byteLength; ++i) {
+    data[byteOffset + i] = std::byte(words[i / 8] >> (i % 8 * 8));
+  }
+  buffer.byteLength = int64_t(data.size());
+
+  availability.bitstream = int64_t(subtree.bufferViews.size());
+  availability.availableCount = int64_t(availableCount);
+  BufferView& bufferView = subtree.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteOffset = int64_t(byteOffset);
+  bufferView.byteLength = int64_t(byteLength);
+}
+
 } // namespace
 
 /*static*/ std::optional<SubtreeAvailability> SubtreeAvailability::fromSubtree(
@@ -137,6 +269,45 @@ std::optional<SubtreeAvailability::AvailabilityView> parseAvailabilityView(
       std::move(subtree));
 }
 
+/*static*/ std::optional<SubtreeAvailability>
+SubtreeAvailability::fromAvailableIndices(
+    ImplicitTileSubdivisionScheme subdivisionScheme,
+    uint32_t levelsInSubtree,
+    const gsl::span<const uint64_t>& availableTiles,
+    const std::vector<std::vector<uint64_t>>& availableContent,
+    const gsl::span<const uint64_t>& availableChildSubtrees) {
+  if (availableContent.empty()) {
+    return std::nullopt;
+  }
+
+  const uint32_t powerOf2 =
+      subdivisionScheme == ImplicitTileSubdivisionScheme::Quadtree ? 2U : 3U;
+  const uint64_t childCount = uint64_t(1) << powerOf2;
+  const uint64_t childSubtreeCount = uint64_t(1)
+                                     << (powerOf2 * levelsInSubtree);
+  const uint64_t tileCount = (childSubtreeCount - 1) / (childCount - 1);
+
+  Subtree subtree;
+  setAvailability(subtree, tileCount, availableTiles, subtree.tileAvailability);
+  for (const std::vector<uint64_t>& indices : availableContent) {
+    setAvailability(
+        subtree,
+        tileCount,
+        indices,
+        subtree.contentAvailability.emplace_back());
+  }
+  setAvailability(
+      subtree,
+      childSubtreeCount,
+      availableChildSubtrees,
+      subtree.childSubtreeAvailability);
+
+  return SubtreeAvailability::fromSubtree(
+      subdivisionScheme,
+      levelsInSubtree,
+      std::move(subtree));
+}
+
 /*static*/ CesiumAsync::Future<std::optional<SubtreeAvailability>>
 SubtreeAvailability::loadSubtree(
     ImplicitTileSubdivisionScheme subdivisionScheme,
@@ -192,10 +363,19 @@ SubtreeAvailability::SubtreeAvailability(
                                                                        : 8U},
       _tileAvailability{tileAvailability},
       _subtreeAvailability{subtreeAvailability},
-      _contentAvailability{std::move(contentAvailability)} {
+      _contentAvailability{std::move(contentAvailability)},
+      _tileAvailabilityRankIndex{computeRankIndex(this->_tileAvailability)},
+      _contentAvailabilityRankIndices{} {
   assert(
       (this->_childCount == 4 || this->_childCount == 8) &&
       "Only support quadtree and octree");
+
+  this->_contentAvailabilityRankIndices.reserve(
+      this->_contentAvailability.size());
+  for (const AvailabilityView& availabilityView : this->_contentAvailability) {
+    this->_contentAvailabilityRankIndices.emplace_back(
+        computeRankIndex(availabilityView));
+  }
 }
 
 bool SubtreeAvailability::isTileAvailable(
@@ -227,6 +407,36 @@ bool SubtreeAvailability::isTileAvailable(
       this->_tileAvailability);
 }
 
+std::optional<uint64_t> SubtreeAvailability::getAvailableTileIndex(
+    const CesiumGeometry::QuadtreeTileID& subtreeId,
+    const CesiumGeometry::QuadtreeTileID& tileId) const noexcept {
+  uint64_t relativeTileMortonIdx =
+      ImplicitTilingUtilities::computeRelativeMortonIndex(subtreeId, tileId);
+  return this->getAvailableTileIndex(
+      tileId.level - subtreeId.level,
+      relativeTileMortonIdx);
+}
+
+std::optional<uint64_t> SubtreeAvailability::getAvailableTileIndex(
+    const CesiumGeometry::OctreeTileID& subtreeId,
+    const CesiumGeometry::OctreeTileID& tileId) const noexcept {
+  uint64_t relativeTileMortonIdx =
+      ImplicitTilingUtilities::computeRelativeMortonIndex(subtreeId, tileId);
+  return this->getAvailableTileIndex(
+      tileId.level - subtreeId.level,
+      relativeTileMortonIdx);
+}
+
+std::optional<uint64_t> SubtreeAvailability::getAvailableTileIndex(
+    uint32_t relativeTileLevel,
+    uint64_t relativeTileMortonId) const noexcept {
+  return this->getAvailableIndex(
+      relativeTileLevel,
+      relativeTileMortonId,
+      this->_tileAvailability,
+      this->_tileAvailabilityRankIndex);
+}
+
 void SubtreeAvailability::setTileAvailable(
     const CesiumGeometry::QuadtreeTileID& subtreeId,
     const CesiumGeometry::QuadtreeTileID& tileId,
@@ -259,6 +469,7 @@ void SubtreeAvailability::setTileAvailable(
       relativeTileLevel,
       relativeTileMortonId,
       this->_tileAvailability,
+      this->_tileAvailabilityRankIndex,
       isAvailable);
 }
 
@@ -298,6 +509,43 @@ bool SubtreeAvailability::isContentAvailable(
       this->_contentAvailability[contentId]);
 }
 
+std::optional<uint64_t> SubtreeAvailability::getAvailableContentIndex(
+    const CesiumGeometry::QuadtreeTileID& subtreeId,
+    const CesiumGeometry::QuadtreeTileID& tileId,
+    uint64_t contentId) const noexcept {
+  uint64_t relativeTileMortonIdx =
+      ImplicitTilingUtilities::computeRelativeMortonIndex(subtreeId, tileId);
+  return this->getAvailableContentIndex(
+      tileId.level - subtreeId.level,
+      relativeTileMortonIdx,
+      contentId);
+}
+
+std::optional<uint64_t> SubtreeAvailability::getAvailableContentIndex(
+    const CesiumGeometry::OctreeTileID& subtreeId,
+    const CesiumGeometry::OctreeTileID& tileId,
+    uint64_t contentId) const noexcept {
+  uint64_t relativeTileMortonIdx =
+      ImplicitTilingUtilities::computeRelativeMortonIndex(subtreeId, tileId);
+  return this->getAvailableContentIndex(
+      tileId.level - subtreeId.level,
+      relativeTileMortonIdx,
+      contentId);
+}
+
+std::optional<uint64_t> SubtreeAvailability::getAvailableContentIndex(
+    uint32_t relativeTileLevel,
+    uint64_t relativeTileMortonId,
+    uint64_t contentId) const noexcept {
+  if (contentId >= this->_contentAvailability.size())
+    return std::nullopt;
+  return this->getAvailableIndex(
+      relativeTileLevel,
+      relativeTileMortonId,
+      this->_contentAvailability[contentId],
+      this->_contentAvailabilityRankIndices[contentId]);
+}
+
 void SubtreeAvailability::setContentAvailable(
     const CesiumGeometry::QuadtreeTileID& subtreeId,
     const CesiumGeometry::QuadtreeTileID& tileId,
@@ -336,6 +584,7 @@ void SubtreeAvailability::setContentAvailable(
         relativeTileLevel,
         relativeTileMortonId,
         this->_contentAvailability[contentId],
+        this->_contentAvailabilityRankIndices[contentId],
         isAvailable);
   }
 }
@@ -495,10 +744,49 @@ bool SubtreeAvailability::isAvailable(
       availabilityView);
 }
 
+std::optional<uint64_t> SubtreeAvailability::getAvailableIndex(
+    uint32_t relativeTileLevel,
+    uint64_t relativeTileMortonId,
+    const AvailabilityView& availabilityView,
+    const std::vector<uint64_t>& rankIndex) const noexcept {
+  if (!this->isAvailable(
+          relativeTileLevel,
+          relativeTileMortonId,
+          availabilityView)) {
+    return std::nullopt;
+  }
+
+  uint64_t numOfTilesInLevel = uint64_t(1)
+                               << (this->_powerOf2 * relativeTileLevel);
+  uint64_t availabilityBitIndex =
+      (numOfTilesInLevel - 1U) / (this->_childCount - 1U) +
+      relativeTileMortonId;
+
+  const SubtreeBufferViewAvailability* pBufferViewAvailability =
+      std::get_if<SubtreeBufferViewAvailability>(&availabilityView);
+  if (!pBufferViewAvailability) {
+    // All tiles are available, so every tile before this one is too.
+    return availabilityBitIndex;
+  }
+
+  const uint64_t block = availabilityBitIndex / bitsPerRankBlock;
+  if (block >= rankIndex.size()) {
+    assert(false);
+    return std::nullopt;
+  }
+
+  return rankIndex[size_t(block)] +
+         countSetBits(
+             pBufferViewAvailability->view,
+             block * bitsPerRankBlock,
+             availabilityBitIndex);
+}
+
 void SubtreeAvailability::setAvailable(
     uint32_t relativeTileLevel,
     uint64_t relativeTileMortonId,
     AvailabilityView& availabilityView,
+    std::vector<uint64_t>& rankIndex,
     bool isAvailable) noexcept {
   const SubtreeConstantAvailability* pConstantAvailability =
       std::get_if<SubtreeConstantAvailability>(&availabilityView);
@@ -516,6 +804,7 @@ void SubtreeAvailability::setAvailable(
           this->_subtree,
           numberOfTilesInSubtree,
           availabilityView);
+      rankIndex = computeRankIndex(availabilityView);
     }
   }
 
@@ -531,11 +820,31 @@ void SubtreeAvailability::setAvailable(
   uint64_t numOfTilesFromRootToParentLevel =
       (numOfTilesInLevel - 1U) / (this->_childCount - 1U);
 
-  return setAvailableUsingBufferView(
+  const bool wasAvailable = this->isAvailableUsingBufferView(
+      numOfTilesFromRootToParentLevel,
+      relativeTileMortonId,
+      availabilityView);
+
+  this->setAvailableUsingBufferView(
       numOfTilesFromRootToParentLevel,
       relativeTileMortonId,
       availabilityView,
       isAvailable);
+
+  if (wasAvailable != isAvailable) {
+    // Keep the counts of the blocks after this tile's block up to date.
+    const uint64_t availabilityBitIndex =
+        numOfTilesFromRootToParentLevel + relativeTileMortonId;
+    for (size_t i = size_t(availabilityBitIndex / bitsPerRankBlock) + 1;
+         i < rankIndex.size();
+         ++i) {
+      if (isAvailable) {
+        ++rankIndex[i];
+      } else {
+        --rankIndex[i];
+      }
+    }
+  }
 }
 
 bool SubtreeAvailability::isAvailableUsingBufferView(
@@ -4,13 +4,19 @@
 #include <CesiumGeospatial/Ellipsoid.h>
 #include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltfContent/GltfUtilities.h>
 #include <CesiumGltfContent/SkirtMeshMetadata.h>
 #include <CesiumUtility/Math.h>
 #include <CesiumUtility/Tracing.h>
+#include <gsl/span>
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
 #include <vector>
 
 using namespace CesiumGltf;
@@ -29,28 +35,54 @@ struct EdgeIndices {
   std::vector<EdgeVertex> north;
 };
 
-static bool upsamplePrimitiveForRasterOverlays(
-    const Model& parentModel,
-    Model& model,
-    Mesh& mesh,
-    MeshPrimitive& primitive,
-    CesiumGeometry::UpsampledQuadtreeNode childID,
-    int32_t textureCoordinateIndex);
-
 struct FloatVertexAttribute {
-  const std::vector<std::byte>& buffer;
+  gsl::span<const std::byte> buffer;
   int64_t offset;
   int64_t stride;
   int64_t numberOfFloatsPerVertex;
-  int32_t accessorIndex;
-  std::vector<double> minimums;
-  std::vector<double> maximums;
+  const std::string& name;
+  const std::string& type;
 };
 
+// A primitive of one of the children that are upsampled together from the
+// same parent primitive, and what is built for it while the parent's
+// triangles are clipped.
+struct UpsampledPrimitive {
+  CesiumGeometry::UpsampledQuadtreeNode childID{
+      CesiumGeometry::QuadtreeTileID(0, 0, 0)};
+  Model* pModel = nullptr;
+  MeshPrimitive* pPrimitive = nullptr;
+  bool keep = false;
+
+  bool keepAboveU = false;
+  bool keepAboveV = false;
+  size_t vertexBufferIndex = 0;
+  size_t indexBufferIndex = 0;
+  size_t vertexBufferViewIndex = 0;
+  size_t indexBufferViewIndex = 0;
+  std::vector<int32_t> accessorIndices;
+
+  // Maps old (parentModel) vertex indices to new (model) vertex indices.
+  std::vector<uint32_t> vertexMap;
+  std::vector<float> vertexFloats;
+  std::vector<uint32_t> indices;
+  EdgeIndices edgeIndices;
+};
+
+static void upsamplePrimitiveForRasterOverlays(
+    const Model& parentModel,
+    const MeshPrimitive& parentPrimitive,
+    std::vector<UpsampledPrimitive>& children,
+    int32_t textureCoordinateIndex);
+
+static std::vector<std::optional<Model>> upsampleModelForRasterOverlays(
+    const Model& parentModel,
+    const std::vector<CesiumGeometry::UpsampledQuadtreeNode>& childIDs,
+    int32_t textureCoordinateIndex);
 static void addClippedPolygon(
     std::vector<float>& output,
     std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
+    const std::vector<FloatVertexAttribute>& attributes,
     std::vector<uint32_t>& vertexMap,
     std::vector<uint32_t>& clipVertexToIndices,
     const std::vector<CesiumGeometry::TriangleClipVertex>& complements,
@@ -70,7 +102,7 @@ static void addEdge(
 static void addSkirt(
     std::vector<float>& output,
     std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
+    const std::vector<FloatVertexAttribute>& attributes,
     const std::vector<uint32_t>& edgeIndices,
     const glm::dvec3& center,
     double skirtHeight,
@@ -80,7 +112,7 @@ static void addSkirt(
 static void addSkirts(
     std::vector<float>& output,
     std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
+    const std::vector<FloatVertexAttribute>& attributes,
     CesiumGeometry::UpsampledQuadtreeNode childID,
     SkirtMeshMetadata& currentSkirt,
     const SkirtMeshMetadata& parentSkirt,
@@ -104,7 +136,42 @@ std::optional<Model> upsampleGltfForRasterOverlays(
     const Model& parentModel,
     CesiumGeometry::UpsampledQuadtreeNode childID,
     int32_t textureCoordinateIndex) {
+  std::vector<std::optional<Model>> results = upsampleGltfForRasterOverlays(
+      parentModel,
+      std::vector<CesiumGeometry::UpsampledQuadtreeNode>{childID},
+      textureCoordinateIndex);
+  return std::move(results[0]);
+}
+
+std::vector<std::optional<Model>> upsampleGltfForRasterOverlays(
+    const Model& parentModel,
+    const std::vector<CesiumGeometry::UpsampledQuadtreeNode>& childIDs,
+    int32_t textureCoordinateIndex) {
   CESIUM_TRACE("upsampleGltfForRasterOverlays");
+
+  // Only floating-point vertex attributes can be clipped, so upsample
+  // quantized meshes from a dequantized copy.
+  if (std::find(
+          parentModel.extensionsUsed.begin(),
+          parentModel.extensionsUsed.end(),
+          "KHR_mesh_quantization") != parentModel.extensionsUsed.end()) {
+    Model dequantizedModel = parentModel;
+    GltfUtilities::dequantizeMeshes(dequantizedModel);
+    return upsampleModelForRasterOverlays(
+        dequantizedModel,
+        childIDs,
+        textureCoordinateIndex);
+  }
+
+  return upsampleModelForRasterOverlays(
+      parentModel,
+      childIDs,
+      textureCoordinateIndex);
+}
+
+static Model createUpsampledModel(
+    const Model& parentModel,
+    CesiumGeometry::UpsampledQuadtreeNode childID) {
   Model result;
 
   // Copy the entire parent model except for the buffers, bufferViews, and
@@ -147,67 +214,98 @@ std::optional<Model> upsampleGltfForRasterOverlays(
     nameIt->second = name;
   }
 
-  bool containsPrimitives = false;
+  return result;
+}
+
+static std::vector<std::optional<Model>> upsampleModelForRasterOverlays(
+    const Model& parentModel,
+    const std::vector<CesiumGeometry::UpsampledQuadtreeNode>& childIDs,
+    int32_t textureCoordinateIndex) {
+  std::vector<Model> models;
+  models.reserve(childIDs.size());
+  for (CesiumGeometry::UpsampledQuadtreeNode childID : childIDs) {
+    models.emplace_back(createUpsampledModel(parentModel, childID));
+  }
 
-  for (Mesh& mesh : result.meshes) {
-    for (size_t i = 0; i < mesh.primitives.size(); ++i) {
-      MeshPrimitive& primitive = mesh.primitives[i];
+  // Each parent primitive is clipped once for all of the children. A child
+  // primitive that ends up empty is removed, so the index of the current
+  // primitive is tracked separately for each child.
+  std::vector<bool> containsPrimitives(childIDs.size(), false);
+  std::vector<UpsampledPrimitive> primitives;
+  std::vector<size_t> primitiveIndices;
+
+  for (size_t meshIndex = 0; meshIndex < parentModel.meshes.size();
+       ++meshIndex) {
+    primitiveIndices.assign(childIDs.size(), 0);
+
+    for (const MeshPrimitive& parentPrimitive :
+         parentModel.meshes[meshIndex].primitives) {
+      primitives.clear();
+      primitives.resize(childIDs.size());
+      for (size_t i = 0; i < childIDs.size(); ++i) {
+        Mesh& mesh = models[i].meshes[meshIndex];
+        primitives[i].childID = childIDs[i];
+        primitives[i].pModel = &models[i];
+        primitives[i].pPrimitive = &mesh.primitives[primitiveIndices[i]];
+      }
 
-      bool keep = upsamplePrimitiveForRasterOverlays(
+      upsamplePrimitiveForRasterOverlays(
           parentModel,
-          result,
-          mesh,
-          primitive,
-          childID,
+          parentPrimitive,
+          primitives,
           textureCoordinateIndex);
 
-      // We're assuming here that nothing references primitives by index, so we
-      // can remove them without any drama.
-      if (!keep) {
-        mesh.primitives.erase(mesh.primitives.begin() + int64_t(i));
-        --i;
+      for (size_t i = 0; i < childIDs.size(); ++i) {
+        Mesh& mesh = models[i].meshes[meshIndex];
+
+        // We're assuming here that nothing references primitives by index, so
+        // we can remove them without any drama.
+        if (primitives[i].keep) {
+          ++primitiveIndices[i];
+          containsPrimitives[i] = true;
+        } else {
+          mesh.primitives.erase(
+              mesh.primitives.begin() + int64_t(primitiveIndices[i]));
+        }
       }
-      containsPrimitives |= !mesh.primitives.empty();
     }
   }
 
-  return containsPrimitives ? std::make_optional<Model>(std::move(result))
-                            : std::nullopt;
+  std::vector<std::optional<Model>> results;
+  results.reserve(childIDs.size());
+  for (size_t i = 0; i < childIDs.size(); ++i) {
+    if (containsPrimitives[i]) {
+      results.emplace_back(std::move(models[i]));
+    } else {
+      results.emplace_back(std::nullopt);
+    }
+  }
+
+  return results;
 }
 
 static void copyVertexAttributes(
-    std::vector<FloatVertexAttribute>& vertexAttributes,
+    const std::vector<FloatVertexAttribute>& vertexAttributes,
     const CesiumGeometry::TriangleClipVertex& vertex,
-    std::vector<float>& output,
-    bool skipMinMaxUpdate = false) {
+    std::vector<float>& output) {
   struct Operation {
-    std::vector<FloatVertexAttribute>& vertexAttributes;
+    const std::vector<FloatVertexAttribute>& vertexAttributes;
     std::vector<float>& output;
-    bool skipMinMaxUpdate;
 
     void operator()(int vertexIndex) {
-      for (FloatVertexAttribute& attribute : vertexAttributes) {
+      for (const FloatVertexAttribute& attribute : vertexAttributes) {
         const float* pInput = reinterpret_cast<const float*>(
             attribute.buffer.data() + attribute.offset +
             attribute.stride * vertexIndex);
-        for (int32_t i = 0; i < attribute.numberOfFloatsPerVertex; ++i) {
-          const float value = *pInput;
-          output.push_back(value);
-          if (!skipMinMaxUpdate) {
-            attribute.minimums[static_cast<size_t>(i)] = glm::min(
-                attribute.minimums[static_cast<size_t>(i)],
-                static_cast<double>(value));
-            attribute.maximums[static_cast<size_t>(i)] = glm::max(
-                attribute.maximums[static_cast<size_t>(i)],
-                static_cast<double>(value));
-          }
-          ++pInput;
-        }
+        output.insert(
+            output.end(),
+            pInput,
+            pInput + attribute.numberOfFloatsPerVertex);
       }
     }
 
     void operator()(const CesiumGeometry::InterpolatedVertex& vertex) {
-      for (FloatVertexAttribute& attribute : vertexAttributes) {
+      for (const FloatVertexAttribute& attribute : vertexAttributes) {
         const float* pInput0 = reinterpret_cast<const float*>(
             attribute.buffer.data() + attribute.offset +
             attribute.stride * vertex.first);
@@ -215,16 +313,7 @@ static void copyVertexAttributes(
             attribute.buffer.data() + attribute.offset +
             attribute.stride * vertex.second);
         for (int32_t i = 0; i < attribute.numberOfFloatsPerVertex; ++i) {
-          const float value = glm::mix(*pInput0, *pInput1, vertex.t);
-          output.push_back(value);
-          if (!skipMinMaxUpdate) {
-            attribute.minimums[static_cast<size_t>(i)] = glm::min(
-                attribute.minimums[static_cast<size_t>(i)],
-                static_cast<double>(value));
-            attribute.maximums[static_cast<size_t>(i)] = glm::max(
-                attribute.maximums[static_cast<size_t>(i)],
-                static_cast<double>(value));
-          }
+          output.push_back(glm::mix(*pInput0, *pInput1, vertex.t));
           ++pInput0;
           ++pInput1;
         }
@@ -232,16 +321,16 @@ static void copyVertexAttributes(
     }
   };
 
-  std::visit(Operation{vertexAttributes, output, skipMinMaxUpdate}, vertex);
+  std::visit(Operation{vertexAttributes, output}, vertex);
 }
 
 static void copyVertexAttributes(
-    std::vector<FloatVertexAttribute>& vertexAttributes,
+    const std::vector<FloatVertexAttribute>& vertexAttributes,
     const std::vector<CesiumGeometry::TriangleClipVertex>& complements,
     const CesiumGeometry::TriangleClipVertex& vertex,
     std::vector<float>& output) {
   struct Operation {
-    std::vector<FloatVertexAttribute>& vertexAttributes;
+    const std::vector<FloatVertexAttribute>& vertexAttributes;
     const std::vector<CesiumGeometry::TriangleClipVertex>& complements;
     std::vector<float>& output;
 
@@ -264,10 +353,9 @@ static void copyVertexAttributes(
         copyVertexAttributes(
             vertexAttributes,
             complements[static_cast<size_t>(~vertex.first)],
-            output,
-            true);
+            output);
       } else {
-        copyVertexAttributes(vertexAttributes, vertex.first, output, true);
+        copyVertexAttributes(vertexAttributes, vertex.first, output);
       }
 
       size_t outputIndex1 = output.size();
@@ -276,28 +364,20 @@ static void copyVertexAttributes(
         copyVertexAttributes(
             vertexAttributes,
             complements[static_cast<size_t>(~vertex.second)],
-            output,
-            true);
+            output);
       } else {
-        copyVertexAttributes(vertexAttributes, vertex.second, output, true);
+        copyVertexAttributes(vertexAttributes, vertex.second, output);
       }
 
       // Interpolate between them and overwrite the first with the result.
-      for (FloatVertexAttribute& attribute : vertexAttributes) {
-        for (int32_t i = 0; i < attribute.numberOfFloatsPerVertex; ++i) {
-          float value =
-              glm::mix(output[outputIndex0], output[outputIndex1], vertex.t);
-          output[outputIndex0] = value;
-          attribute.minimums[static_cast<size_t>(i)] = glm::min(
-              attribute.minimums[static_cast<size_t>(i)],
-              static_cast<double>(value));
-          attribute.maximums[static_cast<size_t>(i)] = glm::max(
-              attribute.maximums[static_cast<size_t>(i)],
-              static_cast<double>(value));
-          ++outputIndex0;
-          ++outputIndex1;
-        }
+      const size_t vertexSizeFloats = outputIndex1 - outputIndex0;
+      for (size_t i = 0; i < vertexSizeFloats; ++i) {
+        output[outputIndex0 + i] = glm::mix(
+            output[outputIndex0 + i],
+            output[outputIndex1 + i],
+            vertex.t);
       }
+      outputIndex0 += vertexSizeFloats;
 
       // Remove the temporary second, which is now pointed to be outputIndex0.
       output.erase(
@@ -324,11 +404,11 @@ static T getVertexValue(
   struct Operation {
     const AccessorView<T>& accessor;
 
-    T operator()(int vertexIndex) { return accessor[vertexIndex]; }
+    T operator()(int vertexIndex) { return accessor.getUnchecked(vertexIndex); }
 
     T operator()(const CesiumGeometry::InterpolatedVertex& vertex) {
-      const T& v0 = accessor[vertex.first];
-      const T& v1 = accessor[vertex.second];
+      const T& v0 = accessor.getUnchecked(vertex.first);
+      const T& v1 = accessor.getUnchecked(vertex.second);
       return glm::mix(v0, v1, vertex.t);
     }
   };
@@ -353,7 +433,7 @@ static T getVertexValue(
             complements[static_cast<size_t>(~vertexIndex)]);
       }
 
-      return accessor[vertexIndex];
+      return accessor.getUnchecked(vertexIndex);
     }
 
     T operator()(const CesiumGeometry::InterpolatedVertex& vertex) {
@@ -364,7 +444,7 @@ static T getVertexValue(
             complements,
             complements[static_cast<size_t>(~vertex.first)]);
       } else {
-        v0 = accessor[vertex.first];
+        v0 = accessor.getUnchecked(vertex.first);
       }
 
       T v1{};
@@ -374,7 +454,7 @@ static T getVertexValue(
             complements,
             complements[static_cast<size_t>(~vertex.second)]);
       } else {
-        v1 = accessor[vertex.second];
+        v1 = accessor.getUnchecked(vertex.second);
       }
 
       return glm::mix(v0, v1, vertex.t);
@@ -384,40 +464,193 @@ static T getVertexValue(
   return std::visit(Operation{accessor, complements}, vertex);
 }
 
-template <class TIndex>
-static bool upsamplePrimitiveForRasterOverlays(
-    const Model& parentModel,
-    Model& model,
-    Mesh& /*mesh*/,
-    MeshPrimitive& primitive,
-    CesiumGeometry::UpsampledQuadtreeNode childID,
-    int32_t textureCoordinateIndex) {
-  CESIUM_TRACE("upsamplePrimitiveForRasterOverlays");
+// Adds the skirts, buffers, and accessors of a child primitive once all of the
+// parent's triangles have been clipped for it. Returns false if nothing of the
+// parent primitive is inside the child.
+static bool finishUpsampledPrimitive(
+    UpsampledPrimitive& child,
+    const std::vector<FloatVertexAttribute>& attributes,
+    int64_t vertexSizeFloats,
+    int32_t positionAttributeIndex,
+    const SkirtMeshMetadata* pParentSkirtMeshMetadata) {
+  Model& model = *child.pModel;
+  MeshPrimitive& primitive = *child.pPrimitive;
+  const CesiumGeometry::UpsampledQuadtreeNode childID = child.childID;
+  std::vector<float>& newVertexFloats = child.vertexFloats;
+  std::vector<uint32_t>& indices = child.indices;
+  const bool hasSkirt = pParentSkirtMeshMetadata != nullptr;
+
+  BufferView& vertexBufferView = model.bufferViews[child.vertexBufferViewIndex];
+  BufferView& indexBufferView = model.bufferViews[child.indexBufferViewIndex];
 
-  // Add up the per-vertex size of all attributes and create buffers,
-  // bufferViews, and accessors
-  std::vector<FloatVertexAttribute> attributes;
-  attributes.reserve(primitive.attributes.size());
+  // create mesh with skirt
+  std::optional<SkirtMeshMetadata> skirtMeshMetadata;
+  if (hasSkirt) {
+    skirtMeshMetadata = std::make_optional<SkirtMeshMetadata>();
+    skirtMeshMetadata->noSkirtIndicesBegin = 0;
+    skirtMeshMetadata->noSkirtIndicesCount =
+        static_cast<uint32_t>(indices.size());
+    skirtMeshMetadata->noSkirtVerticesBegin = 0;
+    skirtMeshMetadata->noSkirtVerticesCount =
+        uint32_t(newVertexFloats.size() / size_t(vertexSizeFloats));
+    skirtMeshMetadata->meshCenter = pParentSkirtMeshMetadata->meshCenter;
+    addSkirts(
+        newVertexFloats,
+        indices,
+        attributes,
+        childID,
+        *skirtMeshMetadata,
+        *pParentSkirtMeshMetadata,
+        child.edgeIndices,
+        vertexSizeFloats,
+        positionAttributeIndex);
+  }
+
+  if (newVertexFloats.empty() || indices.empty()) {
+    return false;
+  }
+
+  // Update the accessor vertex counts and min/max values. The min/max are
+  // found in one pass over the finished vertices, rather than updated for
+  // every value as the vertices are copied and interpolated.
+  const size_t numberOfVertices =
+      newVertexFloats.size() / size_t(vertexSizeFloats);
+  std::vector<float> minimums(
+      size_t(vertexSizeFloats),
+      std::numeric_limits<float>::max());
+  std::vector<float> maximums(
+      size_t(vertexSizeFloats),
+      std::numeric_limits<float>::lowest());
+  for (size_t i = 0; i < numberOfVertices; ++i) {
+    const float* pVertex =
+        newVertexFloats.data() + i * size_t(vertexSizeFloats);
+    for (size_t j = 0; j < size_t(vertexSizeFloats); ++j) {
+      minimums[j] = glm::min(minimums[j], pVertex[j]);
+      maximums[j] = glm::max(maximums[j], pVertex[j]);
+    }
+  }
+
+  size_t attributeOffset = 0;
+  for (size_t i = 0; i < attributes.size(); ++i) {
+    Accessor& accessor =
+        model.accessors[static_cast<size_t>(child.accessorIndices[i])];
+    accessor.count = int64_t(numberOfVertices);
+
+    const size_t attributeFloats =
+        size_t(attributes[i].numberOfFloatsPerVertex);
+    accessor.min.assign(
+        minimums.begin() + int64_t(attributeOffset),
+        minimums.begin() + int64_t(attributeOffset + attributeFloats));
+    accessor.max.assign(
+        maximums.begin() + int64_t(attributeOffset),
+        maximums.begin() + int64_t(attributeOffset + attributeFloats));
+    attributeOffset += attributeFloats;
+  }
+
+  // Add an accessor for the indices
+  const size_t indexAccessorIndex = model.accessors.size();
+  model.accessors.emplace_back();
+  Accessor& newIndicesAccessor = model.accessors.back();
+  newIndicesAccessor.bufferView = static_cast<int>(child.indexBufferViewIndex);
+  newIndicesAccessor.byteOffset = 0;
+  newIndicesAccessor.count = int64_t(indices.size());
+  newIndicesAccessor.componentType = Accessor::ComponentType::UNSIGNED_INT;
+  newIndicesAccessor.type = Accessor::Type::SCALAR;
+
+  // Populate the buffers
+  Buffer& vertexBuffer = model.buffers[child.vertexBufferIndex];
+  vertexBuffer.cesium.data.resize(newVertexFloats.size() * sizeof(float));
+  std::memcpy(
+      vertexBuffer.cesium.data.data(),
+      newVertexFloats.data(),
+      vertexBuffer.cesium.data.size());
+  vertexBufferView.byteLength = int64_t(vertexBuffer.cesium.data.size());
+  vertexBufferView.byteStride = vertexSizeFloats * int64_t(sizeof(float));
+
+  Buffer& indexBuffer = model.buffers[child.indexBufferIndex];
+  indexBuffer.cesium.data.resize(indices.size() * sizeof(uint32_t));
+  std::memcpy(
+      indexBuffer.cesium.data.data(),
+      indices.data(),
+      indexBuffer.cesium.data.size());
+  indexBufferView.byteLength = int64_t(indexBuffer.cesium.data.size());
+
+  bool onlyWater = false;
+  bool onlyLand = true;
+  int64_t waterMaskTextureId = -1;
+
+  auto onlyWaterIt = primitive.extras.find("OnlyWater");
+  auto onlyLandIt = primitive.extras.find("OnlyLand");
+
+  if (onlyWaterIt != primitive.extras.end() && onlyWaterIt->second.isBool() &&
+      onlyLandIt != primitive.extras.end() && onlyLandIt->second.isBool()) {
+
+    onlyWater = onlyWaterIt->second.getBoolOrDefault(false);
+    onlyLand = onlyLandIt->second.getBoolOrDefault(true);
+
+    if (!onlyWater && !onlyLand) {
+      // We have to use the parent's water mask
+      auto waterMaskTextureIdIt = primitive.extras.find("WaterMaskTex");
+      if (waterMaskTextureIdIt != primitive.extras.end() &&
+          waterMaskTextureIdIt->second.isInt64()) {
+        waterMaskTextureId = waterMaskTextureIdIt->second.getInt64OrDefault(-1);
+      }
+    }
+  }
+
+  double waterMaskTranslationX = 0.0;
+  double waterMaskTranslationY = 0.0;
+  double waterMaskScale = 0.0;
 
-  const size_t vertexBufferIndex = model.buffers.size();
-  model.buffers.emplace_back();
+  auto waterMaskTranslationXIt = primitive.extras.find("WaterMaskTranslationX");
+  auto waterMaskTranslationYIt = primitive.extras.find("WaterMaskTranslationY");
+  auto waterMaskScaleIt = primitive.extras.find("WaterMaskScale");
 
-  const size_t indexBufferIndex = model.buffers.size();
-  model.buffers.emplace_back();
+  if (waterMaskTranslationXIt != primitive.extras.end() &&
+      waterMaskTranslationXIt->second.isDouble() &&
+      waterMaskTranslationYIt != primitive.extras.end() &&
+      waterMaskTranslationYIt->second.isDouble() &&
+      waterMaskScaleIt != primitive.extras.end() &&
+      waterMaskScaleIt->second.isDouble()) {
+    waterMaskScale = 0.5 * waterMaskScaleIt->second.getDoubleOrDefault(0.0);
+    waterMaskTranslationX =
+        waterMaskTranslationXIt->second.getDoubleOrDefault(0.0) +
+        waterMaskScale * (childID.tileID.x % 2);
+    waterMaskTranslationY =
+        waterMaskTranslationYIt->second.getDoubleOrDefault(0.0) +
+        waterMaskScale * (childID.tileID.y % 2);
+  }
 
-  const size_t vertexBufferViewIndex = model.bufferViews.size();
-  model.bufferViews.emplace_back();
+  // add skirts to extras to be upsampled later if needed
+  if (hasSkirt) {
+    primitive.extras = SkirtMeshMetadata::createGltfExtras(*skirtMeshMetadata);
+  }
+
+  primitive.extras.emplace("OnlyWater", onlyWater);
+  primitive.extras.emplace("OnlyLand", onlyLand);
+
+  primitive.extras.emplace("WaterMaskTex", waterMaskTextureId);
+
+  primitive.extras.emplace("WaterMaskTranslationX", waterMaskTranslationX);
+  primitive.extras.emplace("WaterMaskTranslationY", waterMaskTranslationY);
+  primitive.extras.emplace("WaterMaskScale", waterMaskScale);
 
-  const size_t indexBufferViewIndex = model.bufferViews.size();
-  model.bufferViews.emplace_back();
+  primitive.indices = static_cast<int>(indexAccessorIndex);
+
+  return true;
+}
 
-  BufferView& vertexBufferView = model.bufferViews[vertexBufferViewIndex];
-  vertexBufferView.buffer = static_cast<int>(vertexBufferIndex);
-  vertexBufferView.target = BufferView::Target::ARRAY_BUFFER;
+template <class TIndex>
+static void upsamplePrimitiveForRasterOverlays(
+    const Model& parentModel,
+    const MeshPrimitive& parentPrimitive,
+    std::vector<UpsampledPrimitive>& children,
+    int32_t textureCoordinateIndex) {
+  CESIUM_TRACE("upsamplePrimitiveForRasterOverlays");
 
-  BufferView& indexBufferView = model.bufferViews[indexBufferViewIndex];
-  indexBufferView.buffer = static_cast<int>(indexBufferIndex);
-  indexBufferView.target = BufferView::Target::ARRAY_BUFFER;
+  // Add up the per-vertex size of all attributes that can be interpolated
+  std::vector<FloatVertexAttribute> attributes;
+  attributes.reserve(parentPrimitive.attributes.size());
 
   int64_t vertexSizeFloats = 0;
   int32_t uvAccessorIndex = -1;
@@ -428,7 +661,8 @@ static bool upsamplePrimitiveForRasterOverlays(
   std::string textureCoordinateName =
       "_CESIUMOVERLAY_" + std::to_string(textureCoordinateIndex);
 
-  for (std::pair<const std::string, int>& attribute : primitive.attributes) {
+  for (const std::pair<const std::string, int>& attribute :
+       parentPrimitive.attributes) {
     if (attribute.first.find("_CESIUMOVERLAY_") == 0) {
       if (uvAccessorIndex == -1) {
         if (attribute.first == textureCoordinateName) {
@@ -475,29 +709,15 @@ static bool upsamplePrimitiveForRasterOverlays(
       continue;
     }
 
-    attribute.second = static_cast<int>(model.accessors.size());
-    model.accessors.emplace_back();
-    Accessor& newAccessor = model.accessors.back();
-    newAccessor.bufferView = static_cast<int>(vertexBufferViewIndex);
-    newAccessor.byteOffset = vertexSizeFloats * int64_t(sizeof(float));
-    newAccessor.componentType = Accessor::ComponentType::FLOAT;
-    newAccessor.type = accessor.type;
-
     vertexSizeFloats += accessorComponentElements;
 
     attributes.push_back(FloatVertexAttribute{
-        buffer.cesium.data,
+        buffer.cesium.getData(),
         bufferView.byteOffset + accessor.byteOffset,
         accessorByteStride,
         accessorComponentElements,
-        attribute.second,
-        std::vector<double>(
-            static_cast<size_t>(accessorComponentElements),
-            std::numeric_limits<double>::max()),
-        std::vector<double>(
-            static_cast<size_t>(accessorComponentElements),
-            std::numeric_limits<double>::lowest()),
-    });
+        attribute.first,
+        accessor.type});
 
     // get position to be used to create for skirts later
     if (attribute.first == "POSITION") {
@@ -507,29 +727,22 @@ static bool upsamplePrimitiveForRasterOverlays(
 
   if (uvAccessorIndex == -1) {
     // We don't know how to divide this primitive, so just remove it.
-    return false;
-  }
-
-  for (const std::string& attribute : toRemove) {
-    primitive.attributes.erase(attribute);
+    return;
   }
 
-  const bool keepAboveU = !isWestChild(childID);
-  const bool keepAboveV = !isSouthChild(childID);
-
   const AccessorView<glm::vec2> uvView(parentModel, uvAccessorIndex);
-  const AccessorView<TIndex> indicesView(parentModel, primitive.indices);
+  const AccessorView<TIndex> indicesView(parentModel, parentPrimitive.indices);
 
   if (uvView.status() != AccessorViewStatus::Valid ||
       indicesView.status() != AccessorViewStatus::Valid) {
-    return false;
+    return;
   }
 
   // check if the primitive has skirts
   int64_t indicesBegin = 0;
   int64_t indicesCount = indicesView.size();
   std::optional<SkirtMeshMetadata> parentSkirtMeshMetadata =
-      SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
+      SkirtMeshMetadata::parseFromGltfExtras(parentPrimitive.extras);
   const bool hasSkirt = (parentSkirtMeshMetadata != std::nullopt) &&
                         (positionAttributeIndex != -1);
   if (hasSkirt) {
@@ -537,257 +750,196 @@ static bool upsamplePrimitiveForRasterOverlays(
     indicesCount = parentSkirtMeshMetadata->noSkirtIndicesCount;
   }
 
-  std::vector<uint32_t> clipVertexToIndices;
-  std::vector<CesiumGeometry::TriangleClipVertex> clippedA;
-  std::vector<CesiumGeometry::TriangleClipVertex> clippedB;
-
-  // Maps old (parentModel) vertex indices to new (model) vertex indices.
-  std::vector<uint32_t> vertexMap(
-      size_t(uvView.size()),
-      std::numeric_limits<uint32_t>::max());
-
-  // std::vector<unsigned char> newVertexBuffer(vertexSizeFloats *
-  // sizeof(float)); gsl::span<float>
-  // newVertexFloats(reinterpret_cast<float*>(newVertexBuffer.data()),
-  // newVertexBuffer.size() / sizeof(float));
-  std::vector<float> newVertexFloats;
-  std::vector<uint32_t> indices;
-  EdgeIndices edgeIndices;
-
-  for (int64_t i = indicesBegin; i < indicesBegin + indicesCount; i += 3) {
-    TIndex i0 = indicesView[i];
-    TIndex i1 = indicesView[i + 1];
-    TIndex i2 = indicesView[i + 2];
-
-    const glm::vec2 uv0 = uvView[i0];
-    const glm::vec2 uv1 = uvView[i1];
-    const glm::vec2 uv2 = uvView[i2];
-
-    // Clip this triangle against the East-West boundary
-    clippedA.clear();
-    clipTriangleAtAxisAlignedThreshold(
-        0.5,
-        keepAboveU,
-        static_cast<int>(i0),
-        static_cast<int>(i1),
-        static_cast<int>(i2),
-        uv0.x,
-        uv1.x,
-        uv2.x,
-        clippedA);
-
-    if (clippedA.size() < 3) {
-      // No part of this triangle is inside the target tile.
-      continue;
+  // Check the indices once, so that the triangles can be read and clipped
+  // without checking each access of the views. Only whole triangles are read.
+  indicesBegin = std::clamp(indicesBegin, int64_t(0), indicesView.size());
+  indicesCount =
+      std::clamp(indicesCount, int64_t(0), indicesView.size() - indicesBegin);
+  indicesCount -= indicesCount % 3;
+  for (int64_t i = indicesBegin; i < indicesBegin + indicesCount; ++i) {
+    if (int64_t(indicesView.getUnchecked(i)) >= uvView.size()) {
+      // An index refers to a vertex that doesn't exist.
+      return;
     }
+  }
 
-    // Clip the first clipped triange against the North-South boundary
-    clipVertexToIndices.clear();
-    clippedB.clear();
-    clipTriangleAtAxisAlignedThreshold(
-        0.5,
-        keepAboveV,
-        ~0,
-        ~1,
-        ~2,
-        getVertexValue(uvView, clippedA[0]).y,
-        getVertexValue(uvView, clippedA[1]).y,
-        getVertexValue(uvView, clippedA[2]).y,
-        clippedB);
-
-    // Add the clipped triangle or quad, if any
-    addClippedPolygon(
-        newVertexFloats,
-        indices,
-        attributes,
-        vertexMap,
-        clipVertexToIndices,
-        clippedA,
-        clippedB);
-    if (hasSkirt) {
-      addEdge(
-          edgeIndices,
-          0.5,
-          0.5,
-          keepAboveU,
-          keepAboveV,
-          uvView,
-          clipVertexToIndices,
-          clippedA,
-          clippedB);
+  // Create buffers, bufferViews, and accessors for each child, and note which
+  // sides of the East-West boundary any child is on.
+  std::array<bool, 2> isSideNeeded{false, false};
+  for (UpsampledPrimitive& child : children) {
+    Model& model = *child.pModel;
+    MeshPrimitive& primitive = *child.pPrimitive;
+
+    child.vertexBufferIndex = model.buffers.size();
+    model.buffers.emplace_back();
+
+    child.indexBufferIndex = model.buffers.size();
+    model.buffers.emplace_back();
+
+    child.vertexBufferViewIndex = model.bufferViews.size();
+    model.bufferViews.emplace_back();
+
+    child.indexBufferViewIndex = model.bufferViews.size();
+    model.bufferViews.emplace_back();
+
+    BufferView& vertexBufferView =
+        model.bufferViews[child.vertexBufferViewIndex];
+    vertexBufferView.buffer = static_cast<int>(child.vertexBufferIndex);
+    vertexBufferView.target = BufferView::Target::ARRAY_BUFFER;
+
+    BufferView& indexBufferView = model.bufferViews[child.indexBufferViewIndex];
+    indexBufferView.buffer = static_cast<int>(child.indexBufferIndex);
+    indexBufferView.target = BufferView::Target::ARRAY_BUFFER;
+
+    int64_t byteOffset = 0;
+    child.accessorIndices.reserve(attributes.size());
+    for (const FloatVertexAttribute& attribute : attributes) {
+      const int32_t accessorIndex =
+          static_cast<int32_t>(model.accessors.size());
+      model.accessors.emplace_back();
+      Accessor& newAccessor = model.accessors.back();
+      newAccessor.bufferView = static_cast<int>(child.vertexBufferViewIndex);
+      newAccessor.byteOffset = byteOffset;
+      newAccessor.componentType = Accessor::ComponentType::FLOAT;
+      newAccessor.type = attribute.type;
+
+      byteOffset += attribute.numberOfFloatsPerVertex * int64_t(sizeof(float));
+
+      primitive.attributes[attribute.name] = accessorIndex;
+      child.accessorIndices.push_back(accessorIndex);
     }
 
-    // If the East-West clip yielded a quad (rather than a triangle), clip the
-    // second triangle of the quad, too.
-    if (clippedA.size() > 3) {
-      clipVertexToIndices.clear();
-      clippedB.clear();
-      clipTriangleAtAxisAlignedThreshold(
-          0.5,
-          keepAboveV,
-          ~0,
-          ~2,
-          ~3,
-          getVertexValue(uvView, clippedA[0]).y,
-          getVertexValue(uvView, clippedA[2]).y,
-          getVertexValue(uvView, clippedA[3]).y,
-          clippedB);
-
-      // Add the clipped triangle or quad, if any
-      addClippedPolygon(
-          newVertexFloats,
-          indices,
-          attributes,
-          vertexMap,
-          clipVertexToIndices,
-          clippedA,
-          clippedB);
-      if (hasSkirt) {
-        addEdge(
-            edgeIndices,
-            0.5,
-            0.5,
-            keepAboveU,
-            keepAboveV,
-            uvView,
-            clipVertexToIndices,
-            clippedA,
-            clippedB);
-      }
+    for (const std::string& attribute : toRemove) {
+      primitive.attributes.erase(attribute);
     }
-  }
 
-  // create mesh with skirt
-  std::optional<SkirtMeshMetadata> skirtMeshMetadata;
-  if (hasSkirt) {
-    skirtMeshMetadata = std::make_optional<SkirtMeshMetadata>();
-    skirtMeshMetadata->noSkirtIndicesBegin = 0;
-    skirtMeshMetadata->noSkirtIndicesCount =
-        static_cast<uint32_t>(indices.size());
-    skirtMeshMetadata->noSkirtVerticesBegin = 0;
-    skirtMeshMetadata->noSkirtVerticesCount =
-        uint32_t(newVertexFloats.size() / size_t(vertexSizeFloats));
-    skirtMeshMetadata->meshCenter = parentSkirtMeshMetadata->meshCenter;
-    addSkirts(
-        newVertexFloats,
-        indices,
-        attributes,
-        childID,
-        *skirtMeshMetadata,
-        *parentSkirtMeshMetadata,
-        edgeIndices,
-        vertexSizeFloats,
-        positionAttributeIndex);
-  }
+    child.keepAboveU = !isWestChild(child.childID);
+    child.keepAboveV = !isSouthChild(child.childID);
+    isSideNeeded[child.keepAboveU ? 1 : 0] = true;
 
-  if (newVertexFloats.empty() || indices.empty()) {
-    return false;
+    child.vertexMap.assign(
+        size_t(uvView.size()),
+        std::numeric_limits<uint32_t>::max());
   }
 
-  // Update the accessor vertex counts and min/max values
-  const int64_t numberOfVertices =
-      int64_t(newVertexFloats.size()) / vertexSizeFloats;
-  for (const FloatVertexAttribute& attribute : attributes) {
-    Accessor& accessor =
-        model.accessors[static_cast<size_t>(attribute.accessorIndex)];
-    accessor.count = numberOfVertices;
-    accessor.min = std::move(attribute.minimums);
-    accessor.max = std::move(attribute.maximums);
-  }
+  std::vector<uint32_t> clipVertexToIndices;
+  std::vector<CesiumGeometry::TriangleClipVertex> clippedA;
+  std::vector<CesiumGeometry::TriangleClipVertex> clippedB;
 
-  // Add an accessor for the indices
-  const size_t indexAccessorIndex = model.accessors.size();
-  model.accessors.emplace_back();
-  Accessor& newIndicesAccessor = model.accessors.back();
-  newIndicesAccessor.bufferView = static_cast<int>(indexBufferViewIndex);
-  newIndicesAccessor.byteOffset = 0;
-  newIndicesAccessor.count = int64_t(indices.size());
-  newIndicesAccessor.componentType = Accessor::ComponentType::UNSIGNED_INT;
-  newIndicesAccessor.type = Accessor::Type::SCALAR;
+  // The v coordinates of the vertices of clippedA, which are shared by the
+  // children on the same side of the East-West boundary.
+  std::array<float, 4> clippedAV{};
+
+  // Clips a triangle of clippedA against the North-South boundary, and adds
+  // the clipped triangle or quad, if any, to a child.
+  const auto addClippedTriangle =
+      [&](UpsampledPrimitive& child, int first, int second, int third) {
+        clipVertexToIndices.clear();
+        clippedB.clear();
+        clipTriangleAtAxisAlignedThreshold(
+            0.5,
+            child.keepAboveV,
+            ~first,
+            ~second,
+            ~third,
+            clippedAV[size_t(first)],
+            clippedAV[size_t(second)],
+            clippedAV[size_t(third)],
+            clippedB);
 
-  // Populate the buffers
-  Buffer& vertexBuffer = model.buffers[vertexBufferIndex];
-  vertexBuffer.cesium.data.resize(newVertexFloats.size() * sizeof(float));
-  float* pAsFloats = reinterpret_cast<float*>(vertexBuffer.cesium.data.data());
-  std::copy(newVertexFloats.begin(), newVertexFloats.end(), pAsFloats);
-  vertexBufferView.byteLength = int64_t(vertexBuffer.cesium.data.size());
-  vertexBufferView.byteStride = vertexSizeFloats * int64_t(sizeof(float));
+        addClippedPolygon(
+            child.vertexFloats,
+            child.indices,
+            attributes,
+            child.vertexMap,
+            clipVertexToIndices,
+            clippedA,
+            clippedB);
+        if (hasSkirt) {
+          addEdge(
+              child.edgeIndices,
+              0.5,
+              0.5,
+              child.keepAboveU,
+              child.keepAboveV,
+              uvView,
+              clipVertexToIndices,
+              clippedA,
+              clippedB);
+        }
+      };
 
-  Buffer& indexBuffer = model.buffers[indexBufferIndex];
-  indexBuffer.cesium.data.resize(indices.size() * sizeof(uint32_t));
-  uint32_t* pAsUint32s =
-      reinterpret_cast<uint32_t*>(indexBuffer.cesium.data.data());
-  std::copy(indices.begin(), indices.end(), pAsUint32s);
-  indexBufferView.byteLength = int64_t(indexBuffer.cesium.data.size());
+  for (int64_t i = indicesBegin; i < indicesBegin + indicesCount; i += 3) {
+    TIndex i0 = indicesView.getUnchecked(i);
+    TIndex i1 = indicesView.getUnchecked(i + 1);
+    TIndex i2 = indicesView.getUnchecked(i + 2);
+
+    const glm::vec2 uv0 = uvView.getUnchecked(i0);
+    const glm::vec2 uv1 = uvView.getUnchecked(i1);
+    const glm::vec2 uv2 = uvView.getUnchecked(i2);
+
+    // Clip this triangle against the East-West boundary once for each side,
+    // and then clip the part on each side against the North-South boundary
+    // for each child on that side.
+    for (size_t side = 0; side < isSideNeeded.size(); ++side) {
+      if (!isSideNeeded[side]) {
+        continue;
+      }
 
-  bool onlyWater = false;
-  bool onlyLand = true;
-  int64_t waterMaskTextureId = -1;
+      const bool keepAboveU = side == 1;
+      clippedA.clear();
+      clipTriangleAtAxisAlignedThreshold(
+          0.5,
+          keepAboveU,
+          static_cast<int>(i0),
+          static_cast<int>(i1),
+          static_cast<int>(i2),
+          uv0.x,
+          uv1.x,
+          uv2.x,
+          clippedA);
+
+      if (clippedA.size() < 3) {
+        // No part of this triangle is on this side.
+        continue;
+      }
 
-  auto onlyWaterIt = primitive.extras.find("OnlyWater");
-  auto onlyLandIt = primitive.extras.find("OnlyLand");
+      for (size_t j = 0; j < clippedA.size(); ++j) {
+        clippedAV[j] = getVertexValue(uvView, clippedA[j]).y;
+      }
 
-  if (onlyWaterIt != primitive.extras.end() && onlyWaterIt->second.isBool() &&
-      onlyLandIt != primitive.extras.end() && onlyLandIt->second.isBool()) {
+      for (UpsampledPrimitive& child : children) {
+        if (child.keepAboveU != keepAboveU) {
+          continue;
+        }
 
-    onlyWater = onlyWaterIt->second.getBoolOrDefault(false);
-    onlyLand = onlyLandIt->second.getBoolOrDefault(true);
+        addClippedTriangle(child, 0, 1, 2);
 
-    if (!onlyWater && !onlyLand) {
-      // We have to use the parent's water mask
-      auto waterMaskTextureIdIt = primitive.extras.find("WaterMaskTex");
-      if (waterMaskTextureIdIt != primitive.extras.end() &&
-          waterMaskTextureIdIt->second.isInt64()) {
-        waterMaskTextureId = waterMaskTextureIdIt->second.getInt64OrDefault(-1);
+        // If the East-West clip yielded a quad (rather than a triangle), clip
+        // the second triangle of the quad, too.
+        if (clippedA.size() > 3) {
+          addClippedTriangle(child, 0, 2, 3);
+        }
       }
     }
   }
 
-  double waterMaskTranslationX = 0.0;
-  double waterMaskTranslationY = 0.0;
-  double waterMaskScale = 0.0;
-
-  auto waterMaskTranslationXIt = primitive.extras.find("WaterMaskTranslationX");
-  auto waterMaskTranslationYIt = primitive.extras.find("WaterMaskTranslationY");
-  auto waterMaskScaleIt = primitive.extras.find("WaterMaskScale");
-
-  if (waterMaskTranslationXIt != primitive.extras.end() &&
-      waterMaskTranslationXIt->second.isDouble() &&
-      waterMaskTranslationYIt != primitive.extras.end() &&
-      waterMaskTranslationYIt->second.isDouble() &&
-      waterMaskScaleIt != primitive.extras.end() &&
-      waterMaskScaleIt->second.isDouble()) {
-    waterMaskScale = 0.5 * waterMaskScaleIt->second.getDoubleOrDefault(0.0);
-    waterMaskTranslationX =
-        waterMaskTranslationXIt->second.getDoubleOrDefault(0.0) +
-        waterMaskScale * (childID.tileID.x % 2);
-    waterMaskTranslationY =
-        waterMaskTranslationYIt->second.getDoubleOrDefault(0.0) +
-        waterMaskScale * (childID.tileID.y % 2);
-  }
-
-  // add skirts to extras to be upsampled later if needed
-  if (hasSkirt) {
-    primitive.extras = SkirtMeshMetadata::createGltfExtras(*skirtMeshMetadata);
+  const SkirtMeshMetadata* pParentSkirtMeshMetadata =
+      hasSkirt ? &*parentSkirtMeshMetadata : nullptr;
+  for (UpsampledPrimitive& child : children) {
+    child.keep = finishUpsampledPrimitive(
+        child,
+        attributes,
+        vertexSizeFloats,
+        positionAttributeIndex,
+        pParentSkirtMeshMetadata);
   }
-
-  primitive.extras.emplace("OnlyWater", onlyWater);
-  primitive.extras.emplace("OnlyLand", onlyLand);
-
-  primitive.extras.emplace("WaterMaskTex", waterMaskTextureId);
-
-  primitive.extras.emplace("WaterMaskTranslationX", waterMaskTranslationX);
-  primitive.extras.emplace("WaterMaskTranslationY", waterMaskTranslationY);
-  primitive.extras.emplace("WaterMaskScale", waterMaskScale);
-
-  primitive.indices = static_cast<int>(indexAccessorIndex);
-
-  return true;
+}
 }
 
 static uint32_t getOrCreateVertex(
     std::vector<float>& output,
-    std::vector<FloatVertexAttribute>& attributes,
+    const std::vector<FloatVertexAttribute>& attributes,
     std::vector<uint32_t>& vertexMap,
     const std::vector<CesiumGeometry::TriangleClipVertex>& complements,
     const CesiumGeometry::TriangleClipVertex& clipVertex) {
@@ -823,7 +975,7 @@ static uint32_t getOrCreateVertex(
 static void addClippedPolygon(
     std::vector<float>& output,
     std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
+    const std::vector<FloatVertexAttribute>& attributes,
     std::vector<uint32_t>& vertexMap,
     std::vector<uint32_t>& clipVertexToIndices,
     const std::vector<CesiumGeometry::TriangleClipVertex>& complements,
@@ -943,7 +1095,7 @@ static void addEdge(
 static void addSkirt(
     std::vector<float>& output,
     std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
+    const std::vector<FloatVertexAttribute>& attributes,
     const std::vector<uint32_t>& edgeIndices,
     const glm::dvec3& center,
     double skirtHeight,
@@ -952,40 +1104,52 @@ static void addSkirt(
   const CesiumGeospatial::Ellipsoid& ellipsoid =
       CesiumGeospatial::Ellipsoid::WGS84;
 
+  // Compute the geodetic surface normals of the edge vertices together.
+  const size_t edgeCount = edgeIndices.size();
+  std::vector<double> xs(edgeCount), ys(edgeCount), zs(edgeCount);
+  std::vector<double> normalXs(edgeCount);
+  std::vector<double> normalYs(edgeCount);
+  std::vector<double> normalZs(edgeCount);
+  if (positionAttributeIndex >= 0) {
+    uint32_t positionOffset = 0;
+    for (int32_t j = 0; j < positionAttributeIndex; ++j) {
+      positionOffset += static_cast<uint32_t>(
+          attributes[size_t(j)].numberOfFloatsPerVertex);
+    }
+
+    for (size_t i = 0; i < edgeCount; ++i) {
+      const uint32_t valueIndex =
+          positionOffset + uint32_t(vertexSizeFloats) * edgeIndices[i];
+      xs[i] = output[valueIndex] + center.x;
+      ys[i] = output[valueIndex + 1] + center.y;
+      zs[i] = output[valueIndex + 2] + center.z;
+    }
+
+    ellipsoid.geodeticSurfaceNormal(xs, ys, zs, normalXs, normalYs, normalZs);
+  }
+
   uint32_t newEdgeIndex = uint32_t(output.size() / size_t(vertexSizeFloats));
   for (size_t i = 0; i < edgeIndices.size(); ++i) {
     const uint32_t edgeIdx = edgeIndices[i];
     uint32_t offset = 0;
     for (size_t j = 0; j < attributes.size(); ++j) {
-      FloatVertexAttribute& attribute = attributes[j];
+      const FloatVertexAttribute& attribute = attributes[j];
       const uint32_t valueIndex = offset + uint32_t(vertexSizeFloats) * edgeIdx;
 
       if (int32_t(j) == positionAttributeIndex) {
-        glm::dvec3 position{
-            output[valueIndex],
-            output[valueIndex + 1],
-            output[valueIndex + 2]};
-        position += center;
-
-        position -= skirtHeight * ellipsoid.geodeticSurfaceNormal(position);
+        glm::dvec3 position{xs[i], ys[i], zs[i]};
+        position -=
+            skirtHeight * glm::dvec3(normalXs[i], normalYs[i], normalZs[i]);
         position -= center;
 
         for (uint32_t c = 0; c < 3; ++c) {
           output.push_back(static_cast<float>(position[c]));
-          attribute.minimums[c] = glm::min(attribute.minimums[c], position[c]);
-          attribute.maximums[c] = glm::max(attribute.maximums[c], position[c]);
         }
       } else {
         for (uint32_t c = 0;
              c < static_cast<uint32_t>(attribute.numberOfFloatsPerVertex);
              ++c) {
           output.push_back(output[valueIndex + c]);
-          attribute.minimums[c] = glm::min(
-              attribute.minimums[c],
-              static_cast<double>(output.back()));
-          attribute.maximums[c] = glm::max(
-              attribute.maximums[c],
-              static_cast<double>(output.back()));
         }
       }
 
@@ -1010,7 +1174,7 @@ static void addSkirt(
 static void addSkirts(
     std::vector<float>& output,
     std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
+    const std::vector<FloatVertexAttribute>& attributes,
     CesiumGeometry::UpsampledQuadtreeNode childID,
     SkirtMeshMetadata& currentSkirt,
     const SkirtMeshMetadata& parentSkirt,
@@ -1144,55 +1308,46 @@ static void addSkirts(
       positionAttributeIndex);
 }
 
-static bool upsamplePrimitiveForRasterOverlays(
+static void upsamplePrimitiveForRasterOverlays(
     const Model& parentModel,
-    Model& model,
-    Mesh& mesh,
-    MeshPrimitive& primitive,
-    CesiumGeometry::UpsampledQuadtreeNode childID,
+    const MeshPrimitive& parentPrimitive,
+    std::vector<UpsampledPrimitive>& children,
     int32_t textureCoordinateIndex) {
-  if (primitive.mode != MeshPrimitive::Mode::TRIANGLES ||
-      primitive.indices < 0 ||
-      primitive.indices >= static_cast<int>(parentModel.accessors.size())) {
+  if (parentPrimitive.mode != MeshPrimitive::Mode::TRIANGLES ||
+      parentPrimitive.indices < 0 ||
+      parentPrimitive.indices >=
+          static_cast<int>(parentModel.accessors.size())) {
     // Not indexed triangles, so we don't know how to divide this primitive
     // (yet). So remove it.
-    return false;
+    return;
   }
 
   const Accessor& indicesAccessorGltf =
-      parentModel.accessors[static_cast<size_t>(primitive.indices)];
+      parentModel.accessors[static_cast<size_t>(parentPrimitive.indices)];
   if (indicesAccessorGltf.componentType ==
       Accessor::ComponentType::UNSIGNED_BYTE) {
-    return upsamplePrimitiveForRasterOverlays<uint8_t>(
+    upsamplePrimitiveForRasterOverlays<uint8_t>(
         parentModel,
-        model,
-        mesh,
-        primitive,
-        childID,
+        parentPrimitive,
+        children,
         textureCoordinateIndex);
   } else if (
       indicesAccessorGltf.componentType ==
       Accessor::ComponentType::UNSIGNED_SHORT) {
-    return upsamplePrimitiveForRasterOverlays<uint16_t>(
+    upsamplePrimitiveForRasterOverlays<uint16_t>(
         parentModel,
-        model,
-        mesh,
-        primitive,
-        childID,
+        parentPrimitive,
+        children,
         textureCoordinateIndex);
   } else if (
       indicesAccessorGltf.componentType ==
       Accessor::ComponentType::UNSIGNED_INT) {
-    return upsamplePrimitiveForRasterOverlays<uint32_t>(
+    upsamplePrimitiveForRasterOverlays<uint32_t>(
         parentModel,
-        model,
-        mesh,
-        primitive,
-        childID,
+        parentPrimitive,
+        children,
         textureCoordinateIndex);
   }
-
-  return false;
 }
 
 // Copy a buffer view from a parent to a child. Create a new buffer on the
@@ -1229,8 +1384,7 @@ static int32_t copyBufferView(
   buffer.cesium.data.resize(static_cast<size_t>(parentBufferView.byteLength));
   std::memcpy(
       buffer.cesium.data.data(),
-      &parentBuffer.cesium
-           .data[static_cast<size_t>(parentBufferView.byteOffset)],
+      parentBuffer.cesium.getData().data() + parentBufferView.byteOffset,
       static_cast<size_t>(parentBufferView.byteLength));
 
   size_t bufferViewId = result.bufferViews.size();
@@ -10,12 +10,16 @@ namespace Cesium3DTilesContent {
 
 class ConvertTileToGltf {
 public:
-  static GltfConverterResult fromB3dm(const std::filesystem::path& filePath) {
-    return B3dmToGltfConverter::convert(readFile(filePath), {});
+  static GltfConverterResult fromB3dm(
+      const std::filesystem::path& filePath,
+      const CesiumGltfReader::GltfReaderOptions& options = {}) {
+    return B3dmToGltfConverter::convert(readFile(filePath), options);
   }
 
-  static GltfConverterResult fromPnts(const std::filesystem::path& filePath) {
-    return PntsToGltfConverter::convert(readFile(filePath), {});
+  static GltfConverterResult fromPnts(
+      const std::filesystem::path& filePath,
+      const CesiumGltfReader::GltfReaderOptions& options = {}) {
+    return PntsToGltfConverter::convert(readFile(filePath), options);
   }
 };
 } // namespace Cesium3DTilesContent
@@ -0,0 +1,96 @@
+#include <Cesium3DTilesContent/CmptToGltfConverter.h>
+#include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+#include <CesiumNativeTests/waitForFuture.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+
+using namespace Cesium3DTilesContent;
+using namespace CesiumNativeTests;
+
+namespace {
+std::vector<std::byte>
+createComposite(const std::vector<std::vector<std::byte>>& innerTiles) {
+  uint32_t byteLength = 16;
+  for (const std::vector<std::byte>& innerTile : innerTiles) {
+    byteLength += static_cast<uint32_t>(innerTile.size());
+  }
+
+  std::vector<std::byte> result(16);
+  const uint32_t header[3] = {
+      1,
+      byteLength,
+      static_cast<uint32_t>(innerTiles.size())};
+  std::memcpy(result.data(), "cmpt", 4);
+  std::memcpy(result.data() + 4, header, sizeof(header));
+  for (const std::vector<std::byte>& innerTile : innerTiles) {
+    result.insert(result.end(), innerTile.begin(), innerTile.end());
+  }
+
+  return result;
+}
+} // namespace
+
+TEST_CASE("CmptToGltfConverter") {
+  registerAllTileContentTypes();
+
+  std::filesystem::path pointCloudPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  pointCloudPath = pointCloudPath / "PointCloud";
+  const std::vector<std::byte> composite = createComposite(
+      {readFile(pointCloudPath / "pointCloudPositionsOnly.pnts"),
+       readFile(pointCloudPath / "pointCloudRGB.pnts"),
+       readFile(pointCloudPath / "pointCloudNormals.pnts")});
+
+  SECTION("merges the inner tiles") {
+    GltfConverterResult result = CmptToGltfConverter::convert(composite, {});
+    CHECK(!result.errors);
+    REQUIRE(result.model);
+    CHECK(result.model->meshes.size() == 3);
+    CHECK(result.model->nodes.size() == 3);
+  }
+
+  SECTION("converts the inner tiles concurrently") {
+    CesiumAsync::AsyncSystem asyncSystem(
+        std::make_shared<SimpleTaskProcessor>());
+    GltfConverterResult result = waitForFuture(
+        asyncSystem,
+        CmptToGltfConverter::convert(
+            asyncSystem,
+            std::vector<std::byte>(composite),
+            {}));
+    CHECK(!result.errors);
+    REQUIRE(result.model);
+
+    GltfConverterResult sequentialResult =
+        CmptToGltfConverter::convert(composite, {});
+    REQUIRE(sequentialResult.model);
+    CHECK(result.model->meshes.size() == sequentialResult.model->meshes.size());
+    CHECK(result.model->nodes.size() == sequentialResult.model->nodes.size());
+    CHECK(
+        result.model->accessors.size() ==
+        sequentialResult.model->accessors.size());
+    CHECK(result.model->scene == sequentialResult.model->scene);
+  }
+
+  SECTION("warns about truncated composite tiles") {
+    std::vector<std::byte> truncated(composite);
+    truncated.resize(truncated.size() - 1);
+    const uint32_t byteLength = static_cast<uint32_t>(truncated.size());
+    std::memcpy(truncated.data() + 8, &byteLength, sizeof(byteLength));
+
+    CesiumAsync::AsyncSystem asyncSystem(
+        std::make_shared<SimpleTaskProcessor>());
+    GltfConverterResult result = waitForFuture(
+        asyncSystem,
+        CmptToGltfConverter::convert(asyncSystem, std::move(truncated), {}));
+    CHECK(!result.errors.warnings.empty());
+    REQUIRE(result.model);
+    CHECK(result.model->meshes.size() == 2);
+  }
+}
@@ -0,0 +1,276 @@
+#include <Cesium3DTilesContent/CmptToGltfConverter.h>
+#include <Cesium3DTilesContent/I3dmToGltfConverter.h>
+#include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesContent;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace {
+template <typename T>
+void append(std::vector<std::byte>& bytes, const std::vector<T>& values) {
+  const size_t offset = bytes.size();
+  bytes.resize(offset + values.size() * sizeof(T));
+  std::memcpy(bytes.data() + offset, values.data(), values.size() * sizeof(T));
+}
+
+void pad(std::vector<std::byte>& bytes, size_t multiple, std::byte value) {
+  bytes.resize((bytes.size() + multiple - 1) / multiple * multiple, value);
+}
+
+// A GLB with a single node and mesh.
+std::vector<std::byte> createGlb() {
+  const std::string json =
+      R"({"asset":{"version":"2.0"},)"
+      R"("meshes":[{"primitives":[{"attributes":{}}]}],)"
+      R"("nodes":[{"mesh":0}],"scenes":[{"nodes":[0]}],"scene":0})";
+  std::vector<std::byte> jsonChunk;
+  append(jsonChunk, std::vector<char>(json.begin(), json.end()));
+  pad(jsonChunk, 4, std::byte(' '));
+
+  const uint32_t jsonLength = static_cast<uint32_t>(jsonChunk.size());
+  std::vector<std::byte> glb;
+  append(
+      glb,
+      std::vector<uint32_t>{
+          0x46546C67,
+          2,
+          12 + 8 + jsonLength,
+          jsonLength,
+          0x4E4F534A});
+  glb.insert(glb.end(), jsonChunk.begin(), jsonChunk.end());
+  return glb;
+}
+
+std::vector<std::byte> createI3dm(
+    const std::string& featureTableJson,
+    std::vector<std::byte> featureTableBinary,
+    uint32_t gltfFormat = 1) {
+  std::vector<std::byte> featureTableJsonBytes;
+  append(
+      featureTableJsonBytes,
+      std::vector<char>(featureTableJson.begin(), featureTableJson.end()));
+  pad(featureTableJsonBytes, 8, std::byte(' '));
+  pad(featureTableBinary, 8, std::byte(0));
+
+  const std::vector<std::byte> glb = createGlb();
+  const uint32_t byteLength = static_cast<uint32_t>(
+      32 + featureTableJsonBytes.size() + featureTableBinary.size() +
+      glb.size());
+
+  std::vector<std::byte> i3dm;
+  append(i3dm, std::vector<char>{'i', '3', 'd', 'm'});
+  append(
+      i3dm,
+      std::vector<uint32_t>{
+          1,
+          byteLength,
+          static_cast<uint32_t>(featureTableJsonBytes.size()),
+          static_cast<uint32_t>(featureTableBinary.size()),
+          0,
+          0,
+          gltfFormat});
+  i3dm.insert(
+      i3dm.end(),
+      featureTableJsonBytes.begin(),
+      featureTableJsonBytes.end());
+  i3dm.insert(i3dm.end(), featureTableBinary.begin(), featureTableBinary.end());
+  i3dm.insert(i3dm.end(), glb.begin(), glb.end());
+  return i3dm;
+}
+
+// Two instances, 10 meters apart along the tile's y axis.
+std::vector<std::byte> createTwoInstanceI3dm() {
+  std::vector<std::byte> featureTableBinary;
+  append(featureTableBinary, std::vector<float>{0, 0, 0, 0, 10, 0});
+  return createI3dm(
+      R"({"INSTANCES_LENGTH":2,"POSITION":{"byteOffset":0}})",
+      featureTableBinary);
+}
+
+template <typename T>
+std::vector<T> getValues(const Model& model, int32_t accessor) {
+  const AccessorView<T> view(model, accessor);
+  REQUIRE(view.status() == AccessorViewStatus::Valid);
+  std::vector<T> values;
+  for (int64_t i = 0; i < view.size(); ++i) {
+    values.emplace_back(view[i]);
+  }
+  return values;
+}
+
+void checkTranslations(const Model& model, const Node& node) {
+  const ExtensionExtMeshGpuInstancing* pInstancing =
+      node.getExtension<ExtensionExtMeshGpuInstancing>();
+  REQUIRE(pInstancing);
+  REQUIRE(pInstancing->attributes.count("TRANSLATION") == 1);
+
+  // The instances are relative to their center, and converted to y-up.
+  const std::vector<glm::vec3> translations =
+      getValues<glm::vec3>(model, pInstancing->attributes.at("TRANSLATION"));
+  REQUIRE(translations.size() == 2);
+  CHECK(Math::equalsEpsilon(
+      glm::dvec3(translations[0]),
+      glm::dvec3(0.0, 0.0, 5.0),
+      Math::Epsilon6));
+  CHECK(Math::equalsEpsilon(
+      glm::dvec3(translations[1]),
+      glm::dvec3(0.0, 0.0, -5.0),
+      Math::Epsilon6));
+}
+} // namespace
+
+TEST_CASE("I3dmToGltfConverter") {
+  SECTION("instances the model with EXT_mesh_gpu_instancing") {
+    GltfConverterResult result =
+        I3dmToGltfConverter::convert(createTwoInstanceI3dm(), {});
+    CHECK(!result.errors);
+    REQUIRE(result.model);
+
+    const Model& model = *result.model;
+    CHECK(model.meshes.size() == 1);
+    CHECK(
+        std::find(
+            model.extensionsRequired.begin(),
+            model.extensionsRequired.end(),
+            ExtensionExtMeshGpuInstancing::ExtensionName) !=
+        model.extensionsRequired.end());
+
+    // A new root node moves the instances to their center.
+    REQUIRE(model.nodes.size() == 2);
+    REQUIRE(model.scenes[0].nodes == std::vector<int32_t>{1});
+    const Node& root = model.nodes[1];
+    CHECK(root.children == std::vector<int32_t>{0});
+    REQUIRE(root.matrix.size() == 16);
+    CHECK(root.matrix[12] == Approx(0.0));
+    CHECK(root.matrix[13] == Approx(0.0));
+    CHECK(root.matrix[14] == Approx(-5.0));
+
+    checkTranslations(model, model.nodes[0]);
+
+    const ExtensionExtMeshGpuInstancing& instancing =
+        *model.nodes[0].getExtension<ExtensionExtMeshGpuInstancing>();
+    const std::vector<glm::vec4> rotations =
+        getValues<glm::vec4>(model, instancing.attributes.at("ROTATION"));
+    const std::vector<glm::vec3> scales =
+        getValues<glm::vec3>(model, instancing.attributes.at("SCALE"));
+    REQUIRE(rotations.size() == 2);
+    REQUIRE(scales.size() == 2);
+    for (size_t i = 0; i < 2; ++i) {
+      CHECK(std::abs(rotations[i].w) == Approx(1.0));
+      CHECK(Math::equalsEpsilon(
+          glm::dvec3(scales[i]),
+          glm::dvec3(1.0),
+          Math::Epsilon6));
+    }
+  }
+
+  SECTION("dequantizes positions and reads scales and batch IDs") {
+    std::vector<std::byte> featureTableBinary;
+    append(featureTableBinary, std::vector<uint16_t>{0, 0, 0, 0, 10, 0});
+    append(featureTableBinary, std::vector<float>{2.0f, 3.0f});
+    append(featureTableBinary, std::vector<uint8_t>{4, 7});
+
+    GltfConverterResult result = I3dmToGltfConverter::convert(
+        createI3dm(
+            R"({"INSTANCES_LENGTH":2,)"
+            R"("POSITION_QUANTIZED":{"byteOffset":0},)"
+            R"("QUANTIZED_VOLUME_OFFSET":[0,0,0],)"
+            R"("QUANTIZED_VOLUME_SCALE":[65535,65535,65535],)"
+            R"("SCALE":{"byteOffset":12},)"
+            R"("BATCH_ID":{"byteOffset":20,"componentType":"UNSIGNED_BYTE"}})",
+            featureTableBinary),
+        {});
+    CHECK(!result.errors);
+    REQUIRE(result.model);
+
+    const Model& model = *result.model;
+    checkTranslations(model, model.nodes[0]);
+
+    const ExtensionExtMeshGpuInstancing& instancing =
+        *model.nodes[0].getExtension<ExtensionExtMeshGpuInstancing>();
+    const std::vector<glm::vec3> scales =
+        getValues<glm::vec3>(model, instancing.attributes.at("SCALE"));
+    REQUIRE(scales.size() == 2);
+    CHECK(Math::equalsEpsilon(
+        glm::dvec3(scales[0]),
+        glm::dvec3(2.0),
+        Math::Epsilon6));
+    CHECK(Math::equalsEpsilon(
+        glm::dvec3(scales[1]),
+        glm::dvec3(3.0),
+        Math::Epsilon6));
+
+    REQUIRE(instancing.attributes.count("_FEATURE_ID_0") == 1);
+    CHECK(
+        getValues<float>(model, instancing.attributes.at("_FEATURE_ID_0")) ==
+        std::vector<float>{4.0f, 7.0f});
+  }
+
+  SECTION("reports an error for a glTF referenced by URI") {
+    std::vector<std::byte> featureTableBinary;
+    append(featureTableBinary, std::vector<float>{0, 0, 0});
+    GltfConverterResult result = I3dmToGltfConverter::convert(
+        createI3dm(
+            R"({"INSTANCES_LENGTH":1,"POSITION":{"byteOffset":0}})",
+            featureTableBinary,
+            0),
+        {});
+    CHECK(result.errors.hasErrors());
+    CHECK(!result.model);
+  }
+
+  SECTION("reports an error for missing positions") {
+    GltfConverterResult result = I3dmToGltfConverter::convert(
+        createI3dm(R"({"INSTANCES_LENGTH":1})", {}),
+        {});
+    CHECK(result.errors.hasErrors());
+    CHECK(!result.model);
+  }
+
+  SECTION("keeps the instances of i3dms inside composite tiles") {
+    registerAllTileContentTypes();
+
+    const std::vector<std::byte> i3dm = createTwoInstanceI3dm();
+    std::vector<std::byte> composite;
+    append(composite, std::vector<char>{'c', 'm', 'p', 't'});
+    append(
+        composite,
+        std::vector<uint32_t>{
+            1,
+            static_cast<uint32_t>(16 + 2 * i3dm.size()),
+            2});
+    composite.insert(composite.end(), i3dm.begin(), i3dm.end());
+    composite.insert(composite.end(), i3dm.begin(), i3dm.end());
+
+    GltfConverterResult result = CmptToGltfConverter::convert(composite, {});
+    CHECK(!result.errors);
+    REQUIRE(result.model);
+
+    // The second model's instance accessors are renumbered as it is merged.
+    const Model& model = *result.model;
+    REQUIRE(model.nodes.size() == 4);
+    checkTranslations(model, model.nodes[0]);
+    checkTranslations(model, model.nodes[2]);
+    CHECK(
+        model.nodes[0]
+            .getExtension<ExtensionExtMeshGpuInstancing>()
+            ->attributes.at("TRANSLATION") !=
+        model.nodes[2]
+            .getExtension<ExtensionExtMeshGpuInstancing>()
+            ->attributes.at("TRANSLATION"));
+  }
+}
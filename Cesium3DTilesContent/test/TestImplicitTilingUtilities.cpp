@@ -2,6 +2,7 @@
 #include <CesiumGeometry/OrientedBoundingBox.h>
 #include <CesiumGeospatial/BoundingRegion.h>
 #include <CesiumGeospatial/S2CellBoundingVolume.h>
+#include <CesiumUtility/Uri.h>
 
 #include <catch2/catch.hpp>
 #include <libmorton/morton.h>
@@ -11,6 +12,7 @@
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 using namespace Cesium3DTilesContent;
+using namespace CesiumUtility;
 
 TEST_CASE("ImplicitTilingUtilities child tile iteration") {
   SECTION("QuadtreeTileID") {
@@ -99,6 +101,21 @@ TEST_CASE("ImplicitTilingUtilities::resolveUrl") {
         tileID);
     CHECK(url == "https://example.com/tiles/11/2/3/4");
   }
+
+  SECTION("parsed base URL") {
+    BaseUri baseUrl("https://example.com/tileset.json");
+    CHECK(
+        ImplicitTilingUtilities::resolveUrl(
+            baseUrl,
+            "tiles/{level}/{x}/{y}",
+            QuadtreeTileID(11, 2, 3)) == "https://example.com/tiles/11/2/3");
+    CHECK(
+        ImplicitTilingUtilities::resolveUrl(
+            baseUrl,
+            "tiles/{level}/{x}/{y}/{z}",
+            OctreeTileID(11, 2, 3, 4)) ==
+        "https://example.com/tiles/11/2/3/4");
+  }
 }
 
 TEST_CASE("ImplicitTilingUtilities::computeMortonIndex") {
@@ -135,6 +152,34 @@ TEST_CASE("ImplicitTilingUtilities::computeRelativeMortonIndex") {
   }
 }
 
+TEST_CASE("ImplicitTilingUtilities::computeAvailabilityIndex") {
+  SECTION("quadtree") {
+    QuadtreeTileID rootID(11, 2, 3);
+    CHECK(
+        ImplicitTilingUtilities::computeAvailabilityIndex(rootID, rootID) == 0);
+    CHECK(
+        ImplicitTilingUtilities::computeAvailabilityIndex(
+            rootID,
+            QuadtreeTileID(12, 5, 6)) == 2);
+    CHECK(
+        ImplicitTilingUtilities::computeAvailabilityIndex(
+            rootID,
+            QuadtreeTileID(13, 8, 12)) == 5);
+  }
+
+  SECTION("octree") {
+    OctreeTileID rootID(11, 2, 3, 4);
+    CHECK(
+        ImplicitTilingUtilities::computeAvailabilityIndex(
+            rootID,
+            OctreeTileID(12, 5, 6, 8)) == 2);
+    CHECK(
+        ImplicitTilingUtilities::computeAvailabilityIndex(
+            rootID,
+            OctreeTileID(13, 8, 12, 16)) == 9);
+  }
+}
+
 TEST_CASE("ImplicitTilingUtilities::getSubtreeRootID") {
   SECTION("quadtree") {
     QuadtreeTileID tileID(10, 2, 3);
@@ -377,3 +422,48 @@ TEST_CASE("ImplicitTilingUtilities::computeBoundingVolume") {
     }
   }
 }
+
+TEST_CASE("ImplicitTilingUtilities::computeChildBoundingVolumes") {
+  const OctreeTileID parentID(1, 1, 0, 1);
+  const OctreeChildren childIDs =
+      ImplicitTilingUtilities::getChildren(parentID);
+
+  SECTION("OrientedBoundingBox") {
+    OrientedBoundingBox root(glm::dvec3(1.0, 2.0, 3.0), glm::dmat3(10.0));
+    const std::array<OrientedBoundingBox, 8> children =
+        ImplicitTilingUtilities::computeChildBoundingVolumes(
+            ImplicitTilingUtilities::computeBoundingVolume(root, parentID));
+
+    size_t i = 0;
+    for (const OctreeTileID& childID : childIDs) {
+      const OrientedBoundingBox expected =
+          ImplicitTilingUtilities::computeBoundingVolume(root, childID);
+      CHECK(children[i].getCenter() == expected.getCenter());
+      CHECK(children[i].getHalfAxes() == expected.getHalfAxes());
+      ++i;
+    }
+    CHECK(i == 8);
+  }
+
+  SECTION("BoundingRegion") {
+    BoundingRegion root(GlobeRectangle(1.0, 2.0, 3.0, 4.0), 10.0, 20.0);
+    const std::array<BoundingRegion, 8> children =
+        ImplicitTilingUtilities::computeChildBoundingVolumes(
+            ImplicitTilingUtilities::computeBoundingVolume(root, parentID));
+
+    size_t i = 0;
+    for (const OctreeTileID& childID : childIDs) {
+      const BoundingRegion expected =
+          ImplicitTilingUtilities::computeBoundingVolume(root, childID);
+      const GlobeRectangle& rectangle = children[i].getRectangle();
+      CHECK(rectangle.getWest() == expected.getRectangle().getWest());
+      CHECK(rectangle.getSouth() == expected.getRectangle().getSouth());
+      CHECK(rectangle.getEast() == expected.getRectangle().getEast());
+      CHECK(rectangle.getNorth() == expected.getRectangle().getNorth());
+      CHECK(children[i].getMinimumHeight() == expected.getMinimumHeight());
+      CHECK(children[i].getMaximumHeight() == expected.getMaximumHeight());
+      ++i;
+    }
+    CHECK(i == 8);
+  }
+}
@@ -2,6 +2,7 @@
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/HttpHeaders.h>
+#include <CesiumGeometry/Transforms.h>
 #include <CesiumGltf/ExtensionCesiumRTC.h>
 #include <CesiumGltf/ExtensionExtMeshFeatures.h>
 #include <CesiumGltf/ExtensionKhrMaterialsUnlit.h>
@@ -13,6 +14,8 @@
 #include <spdlog/sinks/ringbuffer_sink.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <set>
 
@@ -521,6 +524,73 @@ TEST_CASE("Converts point cloud with quantized positions to glTF") {
   checkBufferContents<glm::vec3>(positionBuffer.cesium.data, expectedPositions);
 }
 
+TEST_CASE("Keeps quantized point cloud positions when not dequantizing") {
+  std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testFilePath = testFilePath / "PointCloud" / "pointCloudQuantized.pnts";
+  const int64_t pointsLength = 8;
+
+  CesiumGltfReader::GltfReaderOptions options;
+  options.dequantizeMeshData = false;
+  GltfConverterResult result =
+      ConvertTileToGltf::fromPnts(testFilePath, options);
+
+  REQUIRE(result.model);
+  Model& gltf = *result.model;
+  CHECK(
+      std::find(
+          gltf.extensionsUsed.begin(),
+          gltf.extensionsUsed.end(),
+          "KHR_mesh_quantization") != gltf.extensionsUsed.end());
+  CHECK(
+      std::find(
+          gltf.extensionsRequired.begin(),
+          gltf.extensionsRequired.end(),
+          "KHR_mesh_quantization") != gltf.extensionsRequired.end());
+
+  REQUIRE(gltf.nodes.size() == 1);
+  const Node& node = gltf.nodes[0];
+  glm::dmat4 nodeMatrix;
+  std::memcpy(&nodeMatrix, node.matrix.data(), sizeof(glm::dmat4));
+
+  const MeshPrimitive& primitive = gltf.meshes[0].primitives[0];
+  const Accessor& positionAccessor =
+      gltf.accessors[static_cast<size_t>(primitive.attributes.at("POSITION"))];
+  CHECK(
+      positionAccessor.componentType ==
+      Accessor::ComponentType::UNSIGNED_SHORT);
+  CHECK(positionAccessor.type == Accessor::Type::VEC3);
+  CHECK(positionAccessor.count == pointsLength);
+  CHECK(!positionAccessor.normalized);
+
+  const BufferView& positionBufferView =
+      gltf.bufferViews[static_cast<size_t>(positionAccessor.bufferView)];
+  CHECK(positionBufferView.byteStride == 8);
+  const Buffer& positionBuffer =
+      gltf.buffers[static_cast<size_t>(positionBufferView.buffer)];
+  REQUIRE(
+      positionBuffer.cesium.data.size() ==
+      size_t(pointsLength) * sizeof(glm::u16vec4));
+
+  // The node transform dequantizes the positions, and also converts them
+  // from z-up to y-up.
+  const glm::dmat4& yUpToZUp = CesiumGeometry::Transforms::Y_UP_TO_Z_UP;
+  const glm::u16vec4* pPositions =
+      reinterpret_cast<const glm::u16vec4*>(positionBuffer.cesium.data.data());
+  const glm::dvec3 expectedFirst(1215010.39, -4736313.38, 4081601.7);
+  const glm::dvec3 firstPosition = glm::dvec3(
+      yUpToZUp * nodeMatrix * glm::dvec4(glm::dvec3(pPositions[0]), 1.0));
+  CHECK(Math::equalsEpsilon(firstPosition, expectedFirst, 0.0, 0.01));
+
+  const glm::dvec3 expectedMax(1215016.18, -4736309.02, 4081608.74);
+  const glm::dvec3 quantizedMax(
+      positionAccessor.max[0],
+      positionAccessor.max[1],
+      positionAccessor.max[2]);
+  const glm::dvec3 max =
+      glm::dvec3(yUpToZUp * nodeMatrix * glm::dvec4(quantizedMax, 1.0));
+  CHECK(Math::equalsEpsilon(max, expectedMax, 0.0, 0.01));
+}
+
 TEST_CASE("Converts point cloud with normals to glTF") {
   std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
   testFilePath = testFilePath / "PointCloud" / "pointCloudNormals.pnts";
@@ -643,6 +713,48 @@ TEST_CASE("Converts point cloud with oct-encoded normals to glTF") {
   checkBufferContents<glm::vec3>(normalBuffer.cesium.data, expectedNormals);
 }
 
+TEST_CASE("Keeps oct-encoded point cloud normals as normalized bytes") {
+  std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testFilePath =
+      testFilePath / "PointCloud" / "pointCloudNormalsOctEncoded.pnts";
+
+  CesiumGltfReader::GltfReaderOptions options;
+  options.dequantizeMeshData = false;
+  GltfConverterResult result =
+      ConvertTileToGltf::fromPnts(testFilePath, options);
+
+  REQUIRE(result.model);
+  Model& gltf = *result.model;
+  CHECK(
+      std::find(
+          gltf.extensionsRequired.begin(),
+          gltf.extensionsRequired.end(),
+          "KHR_mesh_quantization") != gltf.extensionsRequired.end());
+
+  const MeshPrimitive& primitive = gltf.meshes[0].primitives[0];
+  const Accessor& normalAccessor =
+      gltf.accessors[static_cast<size_t>(primitive.attributes.at("NORMAL"))];
+  CHECK(normalAccessor.componentType == Accessor::ComponentType::BYTE);
+  CHECK(normalAccessor.type == Accessor::Type::VEC3);
+  CHECK(normalAccessor.normalized);
+
+  const BufferView& normalBufferView =
+      gltf.bufferViews[static_cast<size_t>(normalAccessor.bufferView)];
+  CHECK(normalBufferView.byteStride == 4);
+  const Buffer& normalBuffer =
+      gltf.buffers[static_cast<size_t>(normalBufferView.buffer)];
+  REQUIRE(normalBuffer.cesium.data.size() == 8 * sizeof(glm::i8vec4));
+
+  const glm::i8vec4* pNormals =
+      reinterpret_cast<const glm::i8vec4*>(normalBuffer.cesium.data.data());
+  const glm::dvec3 firstNormal = glm::dvec3(glm::i8vec3(pNormals[0])) / 127.0;
+  CHECK(Math::equalsEpsilon(
+      firstNormal,
+      glm::dvec3(-0.9856477, 0.1634960, 0.0420418),
+      0.0,
+      0.01));
+}
+
 std::set<int32_t>
 getUniqueBufferIds(const std::vector<BufferView>& bufferViews) {
   std::set<int32_t> result;
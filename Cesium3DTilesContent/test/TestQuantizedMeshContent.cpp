@@ -1549,3 +1549,80 @@ TEST_CASE("Test converting ill-formed quantized mesh") {
     REQUIRE(loadResult.model == std::nullopt);
   }
 }
+
+TEST_CASE("Test converting quantized mesh with a water mask") {
+  CesiumGeometry::Rectangle rectangle(
+      glm::radians(-180.0),
+      glm::radians(-90.0),
+      glm::radians(180.0),
+      glm::radians(90.0));
+  QuadtreeTilingScheme tilingScheme(rectangle, 2, 1);
+
+  QuadtreeTileID tileID(10, 0, 0);
+  CesiumGeometry::Rectangle tileRectangle =
+      tilingScheme.tileToRectangle(tileID);
+  BoundingRegion boundingVolume = BoundingRegion(
+      GlobeRectangle(
+          tileRectangle.minimumX,
+          tileRectangle.minimumY,
+          tileRectangle.maximumX,
+          tileRectangle.maximumY),
+      0.0,
+      0.0);
+
+  const auto load = [&](std::vector<std::byte>&& waterMask) {
+    QuantizedMesh<uint16_t> quantizedMesh =
+        createGridQuantizedMesh<uint16_t>(boundingVolume, 3, 3);
+    Extension waterMaskExtension;
+    waterMaskExtension.extensionID = 2;
+    waterMaskExtension.extensionData = std::move(waterMask);
+    quantizedMesh.extensions.emplace_back(std::move(waterMaskExtension));
+
+    std::vector<std::byte> quantizedMeshBin =
+        convertQuantizedMeshToBinary(quantizedMesh);
+    auto loadResult = QuantizedMeshLoader::load(
+        tileID,
+        boundingVolume,
+        "url",
+        quantizedMeshBin,
+        true);
+    REQUIRE(!loadResult.errors.hasErrors());
+    REQUIRE(loadResult.model != std::nullopt);
+    return std::move(*loadResult.model);
+  };
+
+  SECTION("A full mask that is all water is flagged without an image") {
+    const CesiumGltf::Model model =
+        load(std::vector<std::byte>(65536, std::byte(255)));
+    const CesiumGltf::MeshPrimitive& primitive =
+        model.meshes.front().primitives.front();
+    CHECK(primitive.extras.at("OnlyWater").getBoolOrDefault(false));
+    CHECK(!primitive.extras.at("OnlyLand").getBoolOrDefault(true));
+    CHECK(primitive.extras.at("WaterMaskTex").getInt64OrDefault(0) == -1);
+    CHECK(model.images.empty());
+  }
+
+  SECTION("A full mask that is all land is flagged without an image") {
+    const CesiumGltf::Model model =
+        load(std::vector<std::byte>(65536, std::byte(0)));
+    const CesiumGltf::MeshPrimitive& primitive =
+        model.meshes.front().primitives.front();
+    CHECK(!primitive.extras.at("OnlyWater").getBoolOrDefault(true));
+    CHECK(primitive.extras.at("OnlyLand").getBoolOrDefault(false));
+    CHECK(model.images.empty());
+  }
+
+  SECTION("A mixed mask becomes an image") {
+    std::vector<std::byte> waterMask(65536, std::byte(0));
+    waterMask[65535] = std::byte(255);
+    const CesiumGltf::Model model = load(std::move(waterMask));
+    const CesiumGltf::MeshPrimitive& primitive =
+        model.meshes.front().primitives.front();
+    CHECK(!primitive.extras.at("OnlyWater").getBoolOrDefault(true));
+    CHECK(!primitive.extras.at("OnlyLand").getBoolOrDefault(true));
+    CHECK(primitive.extras.at("WaterMaskTex").getInt64OrDefault(-1) == 0);
+    REQUIRE(model.images.size() == 1);
+    CHECK(model.images[0].cesium.getPixelData().size() == 65536);
+    CHECK(model.images[0].cesium.getPixelData()[65535] == std::byte(255));
+  }
+}
@@ -1,5 +1,6 @@
 #include <Cesium3DTiles/Subtree.h>
 #include <Cesium3DTilesContent/SubtreeAvailability.h>
+#include <Cesium3DTilesReader/SubtreeFileReader.h>
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumGeometry/QuadtreeTileID.h>
 #include <CesiumNativeTests/SimpleAssetAccessor.h>
@@ -472,6 +473,34 @@ TEST_CASE("Test SubtreeAvailability methods") {
             libmorton::morton2D_64_encode(subtreeID.x, subtreeID.y)));
       }
     }
+
+    SECTION("getAvailableTileIndex()") {
+      // The available tiles in the order of their availability bits.
+      std::vector<uint64_t> expectedIndices{0, 1, 3, 2};
+      for (size_t i = 0; i < availableTileIDs.size(); ++i) {
+        const CesiumGeometry::QuadtreeTileID& tileID = availableTileIDs[i];
+        CHECK(
+            quadtreeAvailability.getAvailableTileIndex(
+                tileID.level,
+                libmorton::morton2D_64_encode(tileID.x, tileID.y)) ==
+            expectedIndices[i]);
+        CHECK(
+            quadtreeAvailability.getAvailableContentIndex(
+                tileID.level,
+                libmorton::morton2D_64_encode(tileID.x, tileID.y),
+                0) == expectedIndices[i]);
+      }
+
+      for (const auto& tileID : unavailableTileIDs) {
+        CHECK(!quadtreeAvailability.getAvailableTileIndex(
+            tileID.level,
+            libmorton::morton2D_64_encode(tileID.x, tileID.y)));
+        CHECK(!quadtreeAvailability.getAvailableContentIndex(
+            tileID.level,
+            libmorton::morton2D_64_encode(tileID.x, tileID.y),
+            0));
+      }
+    }
   }
 }
 
@@ -601,6 +630,76 @@ TEST_CASE("Test parsing subtree format") {
     }
   }
 
+  SECTION("Parse binary subtree without copying its binary chunk") {
+    auto subtreeJson = createSubtreeJson(subtreeBuffers, "");
+
+    rapidjson::StringBuffer subtreeJsonBuffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(subtreeJsonBuffer);
+    subtreeJson.Accept(writer);
+
+    SubtreeHeader subtreeHeader;
+    subtreeHeader.magic[0] = 's';
+    subtreeHeader.magic[1] = 'u';
+    subtreeHeader.magic[2] = 'b';
+    subtreeHeader.magic[3] = 't';
+    subtreeHeader.version = 1U;
+    subtreeHeader.jsonByteLength = subtreeJsonBuffer.GetSize();
+    subtreeHeader.binaryByteLength = subtreeBuffers.buffers.size();
+
+    std::vector<std::byte> buffer(
+        sizeof(subtreeHeader) + subtreeHeader.jsonByteLength +
+        subtreeHeader.binaryByteLength);
+    std::memcpy(buffer.data(), &subtreeHeader, sizeof(subtreeHeader));
+    std::memcpy(
+        buffer.data() + sizeof(subtreeHeader),
+        subtreeJsonBuffer.GetString(),
+        subtreeHeader.jsonByteLength);
+    std::memcpy(
+        buffer.data() + sizeof(subtreeHeader) + subtreeHeader.jsonByteLength,
+        subtreeBuffers.buffers.data(),
+        subtreeHeader.binaryByteLength);
+    const std::byte* pBufferData = buffer.data();
+
+    auto pMockAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+        std::map<std::string, std::shared_ptr<SimpleAssetRequest>>{});
+    auto pMockTaskProcessor = std::make_shared<SimpleTaskProcessor>();
+    CesiumAsync::AsyncSystem asyncSystem{pMockTaskProcessor};
+
+    Cesium3DTilesReader::SubtreeFileReader reader;
+    auto subtreeFuture = reader.load(
+        asyncSystem,
+        pMockAssetAccessor,
+        "test",
+        {},
+        std::move(buffer));
+    asyncSystem.dispatchMainThreadTasks();
+    auto result = subtreeFuture.wait();
+    REQUIRE(result.value);
+    REQUIRE(result.value->buffers.size() == 1);
+
+    // The first buffer is the data that was passed in.
+    const std::vector<std::byte>& bufferData =
+        result.value->buffers[0].cesium.data;
+    CHECK(bufferData.data() == pBufferData);
+    CHECK(bufferData == subtreeBuffers.buffers);
+
+    auto parsedSubtree = SubtreeAvailability::fromSubtree(
+        ImplicitTileSubdivisionScheme::Quadtree,
+        maxSubtreeLevels,
+        std::move(*result.value));
+    REQUIRE(parsedSubtree != std::nullopt);
+
+    for (const auto& tileID : availableTileIDs) {
+      uint64_t mortonID = libmorton::morton2D_64_encode(tileID.x, tileID.y);
+      CHECK(parsedSubtree->isTileAvailable(tileID.level, mortonID));
+    }
+
+    for (const auto& subtreeID : availableSubtreeIDs) {
+      CHECK(parsedSubtree->isSubtreeAvailable(
+          libmorton::morton2D_64_encode(subtreeID.x, subtreeID.y)));
+    }
+  }
+
   SECTION("Parse json subtree") {
     auto subtreeJson = createSubtreeJson(subtreeBuffers, "buffer");
 
@@ -785,3 +884,154 @@ TEST_CASE("SubtreeAvailability modifications") {
         QuadtreeTileID(5, 31, 31)));
   }
 }
+
+TEST_CASE("SubtreeAvailability indices of available tiles and content") {
+  // With 6 levels, the 1365 availability bits span several 512-bit blocks.
+  std::optional<SubtreeAvailability> maybeAvailability =
+      SubtreeAvailability::createEmpty(
+          ImplicitTileSubdivisionScheme::Quadtree,
+          6);
+  REQUIRE(maybeAvailability);
+
+  SubtreeAvailability& availability = *maybeAvailability;
+  const QuadtreeTileID root(0, 0, 0);
+
+  SECTION("all tiles are available, so a tile's index is its bit index") {
+    CHECK(availability.getAvailableTileIndex(root, root) == 0U);
+    CHECK(
+        availability.getAvailableTileIndex(root, QuadtreeTileID(5, 31, 31)) ==
+        1364U);
+    CHECK(!availability.getAvailableContentIndex(root, root, 0));
+    CHECK(!availability.getAvailableContentIndex(root, root, 1));
+  }
+
+  SECTION("indices are kept up to date as availability changes") {
+    // Bits 0, 341, 597 and 1364 of the content availability.
+    availability.setContentAvailable(root, root, 0, true);
+    availability.setContentAvailable(root, QuadtreeTileID(5, 0, 0), 0, true);
+    availability.setContentAvailable(root, QuadtreeTileID(5, 16, 0), 0, true);
+    availability.setContentAvailable(root, QuadtreeTileID(5, 31, 31), 0, true);
+
+    CHECK(availability.getAvailableContentIndex(root, root, 0) == 0U);
+    CHECK(
+        availability.getAvailableContentIndex(
+            root,
+            QuadtreeTileID(5, 0, 0),
+            0) == 1U);
+    CHECK(
+        availability.getAvailableContentIndex(
+            root,
+            QuadtreeTileID(5, 16, 0),
+            0) == 2U);
+    CHECK(
+        availability.getAvailableContentIndex(
+            root,
+            QuadtreeTileID(5, 31, 31),
+            0) == 3U);
+    CHECK(!availability.getAvailableContentIndex(
+        root,
+        QuadtreeTileID(5, 1, 0),
+        0));
+
+    availability.setContentAvailable(root, root, 0, false);
+    CHECK(!availability.getAvailableContentIndex(root, root, 0));
+    CHECK(
+        availability.getAvailableContentIndex(
+            root,
+            QuadtreeTileID(5, 31, 31),
+            0) == 2U);
+
+    availability.setTileAvailable(root, QuadtreeTileID(1, 0, 0), false);
+    CHECK(!availability.getAvailableTileIndex(root, QuadtreeTileID(1, 0, 0)));
+    CHECK(
+        availability.getAvailableTileIndex(root, QuadtreeTileID(5, 31, 31)) ==
+        1363U);
+  }
+}
+
+TEST_CASE("SubtreeAvailability from the indices of available tiles") {
+  const QuadtreeTileID root(0, 0, 0);
+
+  SECTION("builds bitstreams from the indices") {
+    // With 4 levels there are 85 tiles, so the bitstreams span two words.
+    const std::vector<uint64_t> tiles{0, 1, 5, 84, 70, 5, 1000};
+    std::optional<SubtreeAvailability> maybeAvailability =
+        SubtreeAvailability::fromAvailableIndices(
+            ImplicitTileSubdivisionScheme::Quadtree,
+            4,
+            tiles,
+            {{84}},
+            std::vector<uint64_t>{3});
+    REQUIRE(maybeAvailability);
+    const SubtreeAvailability& availability = *maybeAvailability;
+
+    CHECK(availability.isTileAvailable(root, root));
+    CHECK(availability.isTileAvailable(root, QuadtreeTileID(1, 0, 0)));
+    CHECK(!availability.isTileAvailable(root, QuadtreeTileID(1, 1, 0)));
+    CHECK(availability.isTileAvailable(root, QuadtreeTileID(2, 0, 0)));
+    CHECK(availability.isTileAvailable(root, QuadtreeTileID(3, 7, 7)));
+    CHECK(availability.getAvailableTileIndex(root, QuadtreeTileID(3, 7, 7)) ==
+          4U);
+
+    CHECK(!availability.isContentAvailable(root, root, 0));
+    CHECK(availability.isContentAvailable(root, QuadtreeTileID(3, 7, 7), 0));
+    CHECK(availability.isSubtreeAvailable(3));
+    CHECK(!availability.isSubtreeAvailable(2));
+
+    // Each bitstream is in the first buffer, aligned to 8 bytes.
+    const Subtree& subtree = availability.getSubtree();
+    REQUIRE(subtree.buffers.size() == 1);
+    REQUIRE(subtree.bufferViews.size() == 3);
+    for (const BufferView& bufferView : subtree.bufferViews) {
+      CHECK(bufferView.buffer == 0);
+      CHECK(bufferView.byteOffset % 8 == 0);
+    }
+    CHECK(subtree.bufferViews[0].byteLength == 11);
+    CHECK(subtree.bufferViews[2].byteLength == 32);
+    CHECK(subtree.tileAvailability.availableCount == 5);
+    CHECK(
+        subtree.buffers[0].byteLength ==
+        int64_t(subtree.buffers[0].cesium.data.size()));
+  }
+
+  SECTION("stores constant availability as a constant") {
+    std::vector<uint64_t> tiles;
+    for (uint64_t i = 0; i < 21; ++i) {
+      tiles.emplace_back(i);
+    }
+    std::optional<SubtreeAvailability> maybeAvailability =
+        SubtreeAvailability::fromAvailableIndices(
+            ImplicitTileSubdivisionScheme::Quadtree,
+            3,
+            tiles,
+            {{}, tiles},
+            {});
+    REQUIRE(maybeAvailability);
+
+    const Subtree& subtree = maybeAvailability->getSubtree();
+    CHECK(subtree.buffers.empty());
+    CHECK(
+        subtree.tileAvailability.constant ==
+        Availability::Constant::AVAILABLE);
+    REQUIRE(subtree.contentAvailability.size() == 2);
+    CHECK(
+        subtree.contentAvailability[0].constant ==
+        Availability::Constant::UNAVAILABLE);
+    CHECK(
+        subtree.contentAvailability[1].constant ==
+        Availability::Constant::AVAILABLE);
+    CHECK(
+        subtree.childSubtreeAvailability.constant ==
+        Availability::Constant::UNAVAILABLE);
+    CHECK(maybeAvailability->isContentAvailable(root, root, 1));
+  }
+
+  SECTION("requires content availability") {
+    CHECK(!SubtreeAvailability::fromAvailableIndices(
+        ImplicitTileSubdivisionScheme::Octree,
+        2,
+        {},
+        {},
+        {}));
+  }
+}
@@ -1781,6 +1781,42 @@ TEST_CASE("Upgrade JSON values") {
         expected.size());
   }
 
+  SECTION("Int16") {
+    std::vector<int32_t> expected{-200, 5, 300, 0, -32768};
+    createTestForNonArrayJson<int32_t, int16_t>(
+        expected,
+        ClassProperty::Type::SCALAR,
+        ClassProperty::ComponentType::INT16,
+        expected.size());
+  }
+
+  SECTION("Uint16") {
+    std::vector<int32_t> expected{200, 5, 60000, 0};
+    createTestForNonArrayJson<int32_t, uint16_t>(
+        expected,
+        ClassProperty::Type::SCALAR,
+        ClassProperty::ComponentType::UINT16,
+        expected.size());
+  }
+
+  SECTION("Float32") {
+    std::vector<float> expected{1.5f, -2.25f, 3.0f, 0.125f};
+    createTestForNonArrayJson<float>(
+        expected,
+        ClassProperty::Type::SCALAR,
+        ClassProperty::ComponentType::FLOAT32,
+        expected.size());
+  }
+
+  SECTION("Float64") {
+    std::vector<double> expected{0.1, 2.5, -7.0, 1e300};
+    createTestForNonArrayJson<double>(
+        expected,
+        ClassProperty::Type::SCALAR,
+        ClassProperty::ComponentType::FLOAT64,
+        expected.size());
+  }
+
   SECTION("Boolean") {
     std::vector<bool> expected{true, false, true, false, true, true, false};
     createTestForNonArrayJson(
@@ -2694,3 +2730,28 @@ TEST_CASE("3DTILES_batch_table_hierarchy with parentCounts values != 1 is "
   CHECK(propertyTable.classProperty == "default");
   REQUIRE(propertyTable.properties.size() == 0);
 }
+
+TEST_CASE("Does not upgrade batch tables if not requested") {
+  std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  CesiumGltfReader::GltfReaderOptions options;
+  options.upgradeBatchTables = false;
+
+  SECTION("B3DM") {
+    GltfConverterResult result = ConvertTileToGltf::fromB3dm(
+        testFilePath / "BatchTables" / "batchedWithJson.b3dm",
+        options);
+    REQUIRE(result.model);
+    CHECK(!result.errors);
+    CHECK(!result.model->getExtension<ExtensionModelExtStructuralMetadata>());
+    CHECK(!result.model->getExtension<ExtensionExtMeshFeatures>());
+  }
+
+  SECTION("PNTS") {
+    GltfConverterResult result = ConvertTileToGltf::fromPnts(
+        testFilePath / "PointCloud" / "pointCloudWithPerPointProperties.pnts",
+        options);
+    REQUIRE(result.model);
+    CHECK(!result.errors);
+    CHECK(!result.model->getExtension<ExtensionModelExtStructuralMetadata>());
+  }
+}
@@ -6,9 +6,12 @@
 #include <CesiumUtility/Math.h>
 
 #include <catch2/catch.hpp>
+#include <glm/common.hpp>
 #include <glm/trigonometric.hpp>
 
 #include <cstring>
+#include <limits>
+#include <optional>
 #include <vector>
 
 using namespace Cesium3DTilesContent;
@@ -260,6 +263,24 @@ TEST_CASE("Test upsample tile") {
             p6,
             (upsampledPosition[4] + positions[1]) * 0.5f,
             glm::vec3(static_cast<float>(Math::Epsilon7))) == glm::bvec3(true));
+
+    // The accessor bounds are exactly those of the upsampled positions.
+    glm::vec3 expectedMin(std::numeric_limits<float>::max());
+    glm::vec3 expectedMax(std::numeric_limits<float>::lowest());
+    for (int64_t i = 0; i < upsampledPosition.size(); ++i) {
+      expectedMin = glm::min(expectedMin, upsampledPosition[i]);
+      expectedMax = glm::max(expectedMax, upsampledPosition[i]);
+    }
+
+    const Accessor& positionAccessor =
+        upsampledModel.accessors[static_cast<size_t>(
+            upsampledPrimitive.attributes.at("POSITION"))];
+    REQUIRE(positionAccessor.min.size() == 3);
+    REQUIRE(positionAccessor.max.size() == 3);
+    for (glm::length_t c = 0; c < 3; ++c) {
+      CHECK(positionAccessor.min[size_t(c)] == double(expectedMin[c]));
+      CHECK(positionAccessor.max[size_t(c)] == double(expectedMax[c]));
+    }
   }
 
   SECTION("Upsample upper left child") {
@@ -938,6 +959,45 @@ TEST_CASE("Test upsample tile") {
           center,
           skirtHeight * 0.5);
     }
+
+    SECTION("Upsample all children together") {
+      const std::vector<CesiumGeometry::UpsampledQuadtreeNode> childIDs{
+          lowerLeft,
+          lowerRight,
+          upperLeft,
+          upperRight};
+      std::vector<std::optional<Model>> upsampledModels =
+          upsampleGltfForRasterOverlays(model, childIDs);
+      REQUIRE(upsampledModels.size() == childIDs.size());
+
+      // Each child is the same as when it is upsampled on its own.
+      for (size_t i = 0; i < childIDs.size(); ++i) {
+        REQUIRE(upsampledModels[i]);
+        const Model& together = *upsampledModels[i];
+        const Model alone = *upsampleGltfForRasterOverlays(model, childIDs[i]);
+
+        REQUIRE(together.buffers.size() == alone.buffers.size());
+        for (size_t j = 0; j < alone.buffers.size(); ++j) {
+          CHECK(
+              together.buffers[j].cesium.data ==
+              alone.buffers[j].cesium.data);
+        }
+
+        REQUIRE(together.accessors.size() == alone.accessors.size());
+        for (size_t j = 0; j < alone.accessors.size(); ++j) {
+          CHECK(together.accessors[j].count == alone.accessors[j].count);
+          CHECK(together.accessors[j].min == alone.accessors[j].min);
+          CHECK(together.accessors[j].max == alone.accessors[j].max);
+        }
+
+        const MeshPrimitive& togetherPrimitive =
+            together.meshes.back().primitives.back();
+        const MeshPrimitive& alonePrimitive =
+            alone.meshes.back().primitives.back();
+        CHECK(togetherPrimitive.attributes == alonePrimitive.attributes);
+        CHECK(togetherPrimitive.indices == alonePrimitive.indices);
+      }
+    }
   }
 }
 
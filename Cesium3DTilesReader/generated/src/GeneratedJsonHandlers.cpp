@@ -57,14 +57,20 @@ CesiumJsonReader::IJsonHandler* Extension3dTilesBoundingVolumeS2JsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         Cesium3DTiles::Extension3dTilesBoundingVolumeS2& o) {
-  using namespace std::string_literals;
-
-  if ("token"s == str)
-    return property("token", this->_token, o.token);
-  if ("minimumHeight"s == str)
-    return property("minimumHeight", this->_minimumHeight, o.minimumHeight);
-  if ("maximumHeight"s == str)
-    return property("maximumHeight", this->_maximumHeight, o.maximumHeight);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("token"sv == str)
+      return property("token", this->_token, o.token);
+    break;
+  case 13:
+    if ("minimumHeight"sv == str)
+      return property("minimumHeight", this->_minimumHeight, o.minimumHeight);
+    if ("maximumHeight"sv == str)
+      return property("maximumHeight", this->_maximumHeight, o.maximumHeight);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -152,10 +158,14 @@ CesiumJsonReader::IJsonHandler* StatisticsJsonHandler::readObjectKeyStatistics(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Statistics& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("classes"s == str)
-    return property("classes", this->_classes, o.classes);
+  switch (str.size()) {
+  case 7:
+    if ("classes"sv == str)
+      return property("classes", this->_classes, o.classes);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -234,12 +244,18 @@ ClassStatisticsJsonHandler::readObjectKeyClassStatistics(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::ClassStatistics& o) {
-  using namespace std::string_literals;
-
-  if ("count"s == str)
-    return property("count", this->_count, o.count);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("count"sv == str)
+      return property("count", this->_count, o.count);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -328,27 +344,41 @@ PropertyStatisticsJsonHandler::readObjectKeyPropertyStatistics(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::PropertyStatistics& o) {
-  using namespace std::string_literals;
-
-  if ("min"s == str)
-    return property("min", this->_min, o.min);
-  if ("max"s == str)
-    return property("max", this->_max, o.max);
-  if ("mean"s == str)
-    return property("mean", this->_mean, o.mean);
-  if ("median"s == str)
-    return property("median", this->_median, o.median);
-  if ("standardDeviation"s == str)
-    return property(
-        "standardDeviation",
-        this->_standardDeviation,
-        o.standardDeviation);
-  if ("variance"s == str)
-    return property("variance", this->_variance, o.variance);
-  if ("sum"s == str)
-    return property("sum", this->_sum, o.sum);
-  if ("occurrences"s == str)
-    return property("occurrences", this->_occurrences, o.occurrences);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("min"sv == str)
+      return property("min", this->_min, o.min);
+    if ("max"sv == str)
+      return property("max", this->_max, o.max);
+    if ("sum"sv == str)
+      return property("sum", this->_sum, o.sum);
+    break;
+  case 4:
+    if ("mean"sv == str)
+      return property("mean", this->_mean, o.mean);
+    break;
+  case 6:
+    if ("median"sv == str)
+      return property("median", this->_median, o.median);
+    break;
+  case 8:
+    if ("variance"sv == str)
+      return property("variance", this->_variance, o.variance);
+    break;
+  case 11:
+    if ("occurrences"sv == str)
+      return property("occurrences", this->_occurrences, o.occurrences);
+    break;
+  case 17:
+    if ("standardDeviation"sv == str)
+      return property(
+          "standardDeviation",
+          this->_standardDeviation,
+          o.standardDeviation);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -435,20 +465,32 @@ CesiumJsonReader::IJsonHandler* SchemaJsonHandler::readObjectKeySchema(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Schema& o) {
-  using namespace std::string_literals;
-
-  if ("id"s == str)
-    return property("id", this->_id, o.id);
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("version"s == str)
-    return property("version", this->_version, o.version);
-  if ("classes"s == str)
-    return property("classes", this->_classes, o.classes);
-  if ("enums"s == str)
-    return property("enums", this->_enums, o.enums);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 2:
+    if ("id"sv == str)
+      return property("id", this->_id, o.id);
+    break;
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 5:
+    if ("enums"sv == str)
+      return property("enums", this->_enums, o.enums);
+    break;
+  case 7:
+    if ("version"sv == str)
+      return property("version", this->_version, o.version);
+    if ("classes"sv == str)
+      return property("classes", this->_classes, o.classes);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -526,16 +568,26 @@ CesiumJsonReader::IJsonHandler* EnumJsonHandler::readObjectKeyEnum(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Enum& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("valueType"s == str)
-    return property("valueType", this->_valueType, o.valueType);
-  if ("values"s == str)
-    return property("values", this->_values, o.values);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 6:
+    if ("values"sv == str)
+      return property("values", this->_values, o.values);
+    break;
+  case 9:
+    if ("valueType"sv == str)
+      return property("valueType", this->_valueType, o.valueType);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -612,14 +664,22 @@ CesiumJsonReader::IJsonHandler* EnumValueJsonHandler::readObjectKeyEnumValue(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::EnumValue& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("value"s == str)
-    return property("value", this->_value, o.value);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 5:
+    if ("value"sv == str)
+      return property("value", this->_value, o.value);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -697,14 +757,22 @@ CesiumJsonReader::IJsonHandler* ClassJsonHandler::readObjectKeyClass(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Class& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -795,40 +863,60 @@ ClassPropertyJsonHandler::readObjectKeyClassProperty(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::ClassProperty& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("type"s == str)
-    return property("type", this->_type, o.type);
-  if ("componentType"s == str)
-    return property("componentType", this->_componentType, o.componentType);
-  if ("enumType"s == str)
-    return property("enumType", this->_enumType, o.enumType);
-  if ("array"s == str)
-    return property("array", this->_array, o.array);
-  if ("count"s == str)
-    return property("count", this->_count, o.count);
-  if ("normalized"s == str)
-    return property("normalized", this->_normalized, o.normalized);
-  if ("offset"s == str)
-    return property("offset", this->_offset, o.offset);
-  if ("scale"s == str)
-    return property("scale", this->_scale, o.scale);
-  if ("max"s == str)
-    return property("max", this->_max, o.max);
-  if ("min"s == str)
-    return property("min", this->_min, o.min);
-  if ("required"s == str)
-    return property("required", this->_required, o.required);
-  if ("noData"s == str)
-    return property("noData", this->_noData, o.noData);
-  if ("default"s == str)
-    return property("default", this->_defaultProperty, o.defaultProperty);
-  if ("semantic"s == str)
-    return property("semantic", this->_semantic, o.semantic);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("max"sv == str)
+      return property("max", this->_max, o.max);
+    if ("min"sv == str)
+      return property("min", this->_min, o.min);
+    break;
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    if ("type"sv == str)
+      return property("type", this->_type, o.type);
+    break;
+  case 5:
+    if ("array"sv == str)
+      return property("array", this->_array, o.array);
+    if ("count"sv == str)
+      return property("count", this->_count, o.count);
+    if ("scale"sv == str)
+      return property("scale", this->_scale, o.scale);
+    break;
+  case 6:
+    if ("offset"sv == str)
+      return property("offset", this->_offset, o.offset);
+    if ("noData"sv == str)
+      return property("noData", this->_noData, o.noData);
+    break;
+  case 7:
+    if ("default"sv == str)
+      return property("default", this->_defaultProperty, o.defaultProperty);
+    break;
+  case 8:
+    if ("enumType"sv == str)
+      return property("enumType", this->_enumType, o.enumType);
+    if ("required"sv == str)
+      return property("required", this->_required, o.required);
+    if ("semantic"sv == str)
+      return property("semantic", this->_semantic, o.semantic);
+    break;
+  case 10:
+    if ("normalized"sv == str)
+      return property("normalized", this->_normalized, o.normalized);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  case 13:
+    if ("componentType"sv == str)
+      return property("componentType", this->_componentType, o.componentType);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -916,41 +1004,62 @@ CesiumJsonReader::IJsonHandler* SubtreeJsonHandler::readObjectKeySubtree(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Subtree& o) {
-  using namespace std::string_literals;
-
-  if ("buffers"s == str)
-    return property("buffers", this->_buffers, o.buffers);
-  if ("bufferViews"s == str)
-    return property("bufferViews", this->_bufferViews, o.bufferViews);
-  if ("propertyTables"s == str)
-    return property("propertyTables", this->_propertyTables, o.propertyTables);
-  if ("tileAvailability"s == str)
-    return property(
-        "tileAvailability",
-        this->_tileAvailability,
-        o.tileAvailability);
-  if ("contentAvailability"s == str)
-    return property(
-        "contentAvailability",
-        this->_contentAvailability,
-        o.contentAvailability);
-  if ("childSubtreeAvailability"s == str)
-    return property(
-        "childSubtreeAvailability",
-        this->_childSubtreeAvailability,
-        o.childSubtreeAvailability);
-  if ("tileMetadata"s == str)
-    return property("tileMetadata", this->_tileMetadata, o.tileMetadata);
-  if ("contentMetadata"s == str)
-    return property(
-        "contentMetadata",
-        this->_contentMetadata,
-        o.contentMetadata);
-  if ("subtreeMetadata"s == str)
-    return property(
-        "subtreeMetadata",
-        this->_subtreeMetadata,
-        o.subtreeMetadata);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 7:
+    if ("buffers"sv == str)
+      return property("buffers", this->_buffers, o.buffers);
+    break;
+  case 11:
+    if ("bufferViews"sv == str)
+      return property("bufferViews", this->_bufferViews, o.bufferViews);
+    break;
+  case 12:
+    if ("tileMetadata"sv == str)
+      return property("tileMetadata", this->_tileMetadata, o.tileMetadata);
+    break;
+  case 14:
+    if ("propertyTables"sv == str)
+      return property(
+          "propertyTables",
+          this->_propertyTables,
+          o.propertyTables);
+    break;
+  case 15:
+    if ("contentMetadata"sv == str)
+      return property(
+          "contentMetadata",
+          this->_contentMetadata,
+          o.contentMetadata);
+    if ("subtreeMetadata"sv == str)
+      return property(
+          "subtreeMetadata",
+          this->_subtreeMetadata,
+          o.subtreeMetadata);
+    break;
+  case 16:
+    if ("tileAvailability"sv == str)
+      return property(
+          "tileAvailability",
+          this->_tileAvailability,
+          o.tileAvailability);
+    break;
+  case 19:
+    if ("contentAvailability"sv == str)
+      return property(
+          "contentAvailability",
+          this->_contentAvailability,
+          o.contentAvailability);
+    break;
+  case 24:
+    if ("childSubtreeAvailability"sv == str)
+      return property(
+          "childSubtreeAvailability",
+          this->_childSubtreeAvailability,
+          o.childSubtreeAvailability);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1027,12 +1136,18 @@ MetadataEntityJsonHandler::readObjectKeyMetadataEntity(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::MetadataEntity& o) {
-  using namespace std::string_literals;
-
-  if ("class"s == str)
-    return property("class", this->_classProperty, o.classProperty);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("class"sv == str)
+      return property("class", this->_classProperty, o.classProperty);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1115,14 +1230,25 @@ AvailabilityJsonHandler::readObjectKeyAvailability(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Availability& o) {
-  using namespace std::string_literals;
-
-  if ("bitstream"s == str)
-    return property("bitstream", this->_bitstream, o.bitstream);
-  if ("availableCount"s == str)
-    return property("availableCount", this->_availableCount, o.availableCount);
-  if ("constant"s == str)
-    return property("constant", this->_constant, o.constant);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 8:
+    if ("constant"sv == str)
+      return property("constant", this->_constant, o.constant);
+    break;
+  case 9:
+    if ("bitstream"sv == str)
+      return property("bitstream", this->_bitstream, o.bitstream);
+    break;
+  case 14:
+    if ("availableCount"sv == str)
+      return property(
+          "availableCount",
+          this->_availableCount,
+          o.availableCount);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1203,16 +1329,24 @@ PropertyTableJsonHandler::readObjectKeyPropertyTable(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::PropertyTable& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("class"s == str)
-    return property("class", this->_classProperty, o.classProperty);
-  if ("count"s == str)
-    return property("count", this->_count, o.count);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 5:
+    if ("class"sv == str)
+      return property("class", this->_classProperty, o.classProperty);
+    if ("count"sv == str)
+      return property("count", this->_count, o.count);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1301,32 +1435,48 @@ PropertyTablePropertyJsonHandler::readObjectKeyPropertyTableProperty(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::PropertyTableProperty& o) {
-  using namespace std::string_literals;
-
-  if ("values"s == str)
-    return property("values", this->_values, o.values);
-  if ("arrayOffsets"s == str)
-    return property("arrayOffsets", this->_arrayOffsets, o.arrayOffsets);
-  if ("stringOffsets"s == str)
-    return property("stringOffsets", this->_stringOffsets, o.stringOffsets);
-  if ("arrayOffsetType"s == str)
-    return property(
-        "arrayOffsetType",
-        this->_arrayOffsetType,
-        o.arrayOffsetType);
-  if ("stringOffsetType"s == str)
-    return property(
-        "stringOffsetType",
-        this->_stringOffsetType,
-        o.stringOffsetType);
-  if ("offset"s == str)
-    return property("offset", this->_offset, o.offset);
-  if ("scale"s == str)
-    return property("scale", this->_scale, o.scale);
-  if ("max"s == str)
-    return property("max", this->_max, o.max);
-  if ("min"s == str)
-    return property("min", this->_min, o.min);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("max"sv == str)
+      return property("max", this->_max, o.max);
+    if ("min"sv == str)
+      return property("min", this->_min, o.min);
+    break;
+  case 5:
+    if ("scale"sv == str)
+      return property("scale", this->_scale, o.scale);
+    break;
+  case 6:
+    if ("values"sv == str)
+      return property("values", this->_values, o.values);
+    if ("offset"sv == str)
+      return property("offset", this->_offset, o.offset);
+    break;
+  case 12:
+    if ("arrayOffsets"sv == str)
+      return property("arrayOffsets", this->_arrayOffsets, o.arrayOffsets);
+    break;
+  case 13:
+    if ("stringOffsets"sv == str)
+      return property("stringOffsets", this->_stringOffsets, o.stringOffsets);
+    break;
+  case 15:
+    if ("arrayOffsetType"sv == str)
+      return property(
+          "arrayOffsetType",
+          this->_arrayOffsetType,
+          o.arrayOffsetType);
+    break;
+  case 16:
+    if ("stringOffsetType"sv == str)
+      return property(
+          "stringOffsetType",
+          this->_stringOffsetType,
+          o.stringOffsetType);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1412,16 +1562,24 @@ CesiumJsonReader::IJsonHandler* BufferViewJsonHandler::readObjectKeyBufferView(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::BufferView& o) {
-  using namespace std::string_literals;
-
-  if ("buffer"s == str)
-    return property("buffer", this->_buffer, o.buffer);
-  if ("byteOffset"s == str)
-    return property("byteOffset", this->_byteOffset, o.byteOffset);
-  if ("byteLength"s == str)
-    return property("byteLength", this->_byteLength, o.byteLength);
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 6:
+    if ("buffer"sv == str)
+      return property("buffer", this->_buffer, o.buffer);
+    break;
+  case 10:
+    if ("byteOffset"sv == str)
+      return property("byteOffset", this->_byteOffset, o.byteOffset);
+    if ("byteLength"sv == str)
+      return property("byteLength", this->_byteLength, o.byteLength);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1500,14 +1658,22 @@ CesiumJsonReader::IJsonHandler* BufferJsonHandler::readObjectKeyBuffer(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Buffer& o) {
-  using namespace std::string_literals;
-
-  if ("uri"s == str)
-    return property("uri", this->_uri, o.uri);
-  if ("byteLength"s == str)
-    return property("byteLength", this->_byteLength, o.byteLength);
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("uri"sv == str)
+      return property("uri", this->_uri, o.uri);
+    break;
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 10:
+    if ("byteLength"sv == str)
+      return property("byteLength", this->_byteLength, o.byteLength);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1592,33 +1758,57 @@ CesiumJsonReader::IJsonHandler* TilesetJsonHandler::readObjectKeyTileset(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Tileset& o) {
-  using namespace std::string_literals;
-
-  if ("asset"s == str)
-    return property("asset", this->_asset, o.asset);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
-  if ("schema"s == str)
-    return property("schema", this->_schema, o.schema);
-  if ("schemaUri"s == str)
-    return property("schemaUri", this->_schemaUri, o.schemaUri);
-  if ("statistics"s == str)
-    return property("statistics", this->_statistics, o.statistics);
-  if ("groups"s == str)
-    return property("groups", this->_groups, o.groups);
-  if ("metadata"s == str)
-    return property("metadata", this->_metadata, o.metadata);
-  if ("geometricError"s == str)
-    return property("geometricError", this->_geometricError, o.geometricError);
-  if ("root"s == str)
-    return property("root", this->_root, o.root);
-  if ("extensionsUsed"s == str)
-    return property("extensionsUsed", this->_extensionsUsed, o.extensionsUsed);
-  if ("extensionsRequired"s == str)
-    return property(
-        "extensionsRequired",
-        this->_extensionsRequired,
-        o.extensionsRequired);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("root"sv == str)
+      return property("root", this->_root, o.root);
+    break;
+  case 5:
+    if ("asset"sv == str)
+      return property("asset", this->_asset, o.asset);
+    break;
+  case 6:
+    if ("schema"sv == str)
+      return property("schema", this->_schema, o.schema);
+    if ("groups"sv == str)
+      return property("groups", this->_groups, o.groups);
+    break;
+  case 8:
+    if ("metadata"sv == str)
+      return property("metadata", this->_metadata, o.metadata);
+    break;
+  case 9:
+    if ("schemaUri"sv == str)
+      return property("schemaUri", this->_schemaUri, o.schemaUri);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    if ("statistics"sv == str)
+      return property("statistics", this->_statistics, o.statistics);
+    break;
+  case 14:
+    if ("geometricError"sv == str)
+      return property(
+          "geometricError",
+          this->_geometricError,
+          o.geometricError);
+    if ("extensionsUsed"sv == str)
+      return property(
+          "extensionsUsed",
+          this->_extensionsUsed,
+          o.extensionsUsed);
+    break;
+  case 18:
+    if ("extensionsRequired"sv == str)
+      return property(
+          "extensionsRequired",
+          this->_extensionsRequired,
+          o.extensionsRequired);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1702,31 +1892,54 @@ CesiumJsonReader::IJsonHandler* TileJsonHandler::readObjectKeyTile(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Tile& o) {
-  using namespace std::string_literals;
-
-  if ("boundingVolume"s == str)
-    return property("boundingVolume", this->_boundingVolume, o.boundingVolume);
-  if ("viewerRequestVolume"s == str)
-    return property(
-        "viewerRequestVolume",
-        this->_viewerRequestVolume,
-        o.viewerRequestVolume);
-  if ("geometricError"s == str)
-    return property("geometricError", this->_geometricError, o.geometricError);
-  if ("refine"s == str)
-    return property("refine", this->_refine, o.refine);
-  if ("transform"s == str)
-    return property("transform", this->_transform, o.transform);
-  if ("content"s == str)
-    return property("content", this->_content, o.content);
-  if ("contents"s == str)
-    return property("contents", this->_contents, o.contents);
-  if ("metadata"s == str)
-    return property("metadata", this->_metadata, o.metadata);
-  if ("implicitTiling"s == str)
-    return property("implicitTiling", this->_implicitTiling, o.implicitTiling);
-  if ("children"s == str)
-    return property("children", this->_children, o.children);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 6:
+    if ("refine"sv == str)
+      return property("refine", this->_refine, o.refine);
+    break;
+  case 7:
+    if ("content"sv == str)
+      return property("content", this->_content, o.content);
+    break;
+  case 8:
+    if ("contents"sv == str)
+      return property("contents", this->_contents, o.contents);
+    if ("metadata"sv == str)
+      return property("metadata", this->_metadata, o.metadata);
+    if ("children"sv == str)
+      return property("children", this->_children, o.children);
+    break;
+  case 9:
+    if ("transform"sv == str)
+      return property("transform", this->_transform, o.transform);
+    break;
+  case 14:
+    if ("boundingVolume"sv == str)
+      return property(
+          "boundingVolume",
+          this->_boundingVolume,
+          o.boundingVolume);
+    if ("geometricError"sv == str)
+      return property(
+          "geometricError",
+          this->_geometricError,
+          o.geometricError);
+    if ("implicitTiling"sv == str)
+      return property(
+          "implicitTiling",
+          this->_implicitTiling,
+          o.implicitTiling);
+    break;
+  case 19:
+    if ("viewerRequestVolume"sv == str)
+      return property(
+          "viewerRequestVolume",
+          this->_viewerRequestVolume,
+          o.viewerRequestVolume);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1805,22 +2018,32 @@ ImplicitTilingJsonHandler::readObjectKeyImplicitTiling(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::ImplicitTiling& o) {
-  using namespace std::string_literals;
-
-  if ("subdivisionScheme"s == str)
-    return property(
-        "subdivisionScheme",
-        this->_subdivisionScheme,
-        o.subdivisionScheme);
-  if ("subtreeLevels"s == str)
-    return property("subtreeLevels", this->_subtreeLevels, o.subtreeLevels);
-  if ("availableLevels"s == str)
-    return property(
-        "availableLevels",
-        this->_availableLevels,
-        o.availableLevels);
-  if ("subtrees"s == str)
-    return property("subtrees", this->_subtrees, o.subtrees);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 8:
+    if ("subtrees"sv == str)
+      return property("subtrees", this->_subtrees, o.subtrees);
+    break;
+  case 13:
+    if ("subtreeLevels"sv == str)
+      return property("subtreeLevels", this->_subtreeLevels, o.subtreeLevels);
+    break;
+  case 15:
+    if ("availableLevels"sv == str)
+      return property(
+          "availableLevels",
+          this->_availableLevels,
+          o.availableLevels);
+    break;
+  case 17:
+    if ("subdivisionScheme"sv == str)
+      return property(
+          "subdivisionScheme",
+          this->_subdivisionScheme,
+          o.subdivisionScheme);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1899,10 +2122,14 @@ CesiumJsonReader::IJsonHandler* SubtreesJsonHandler::readObjectKeySubtrees(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Subtrees& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("uri"s == str)
-    return property("uri", this->_uri, o.uri);
+  switch (str.size()) {
+  case 3:
+    if ("uri"sv == str)
+      return property("uri", this->_uri, o.uri);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1981,16 +2208,29 @@ CesiumJsonReader::IJsonHandler* ContentJsonHandler::readObjectKeyContent(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Content& o) {
-  using namespace std::string_literals;
-
-  if ("boundingVolume"s == str)
-    return property("boundingVolume", this->_boundingVolume, o.boundingVolume);
-  if ("uri"s == str)
-    return property("uri", this->_uri, o.uri);
-  if ("metadata"s == str)
-    return property("metadata", this->_metadata, o.metadata);
-  if ("group"s == str)
-    return property("group", this->_group, o.group);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("uri"sv == str)
+      return property("uri", this->_uri, o.uri);
+    break;
+  case 5:
+    if ("group"sv == str)
+      return property("group", this->_group, o.group);
+    break;
+  case 8:
+    if ("metadata"sv == str)
+      return property("metadata", this->_metadata, o.metadata);
+    break;
+  case 14:
+    if ("boundingVolume"sv == str)
+      return property(
+          "boundingVolume",
+          this->_boundingVolume,
+          o.boundingVolume);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -2068,14 +2308,20 @@ BoundingVolumeJsonHandler::readObjectKeyBoundingVolume(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::BoundingVolume& o) {
-  using namespace std::string_literals;
-
-  if ("box"s == str)
-    return property("box", this->_box, o.box);
-  if ("region"s == str)
-    return property("region", this->_region, o.region);
-  if ("sphere"s == str)
-    return property("sphere", this->_sphere, o.sphere);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("box"sv == str)
+      return property("box", this->_box, o.box);
+    break;
+  case 6:
+    if ("region"sv == str)
+      return property("region", this->_region, o.region);
+    if ("sphere"sv == str)
+      return property("sphere", this->_sphere, o.sphere);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -2155,7 +2401,7 @@ GroupMetadataJsonHandler::readObjectKeyGroupMetadata(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::GroupMetadata& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
   (void)o;
 
@@ -2238,12 +2484,16 @@ CesiumJsonReader::IJsonHandler* PropertiesJsonHandler::readObjectKeyProperties(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Properties& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("maximum"s == str)
-    return property("maximum", this->_maximum, o.maximum);
-  if ("minimum"s == str)
-    return property("minimum", this->_minimum, o.minimum);
+  switch (str.size()) {
+  case 7:
+    if ("maximum"sv == str)
+      return property("maximum", this->_maximum, o.maximum);
+    if ("minimum"sv == str)
+      return property("minimum", this->_minimum, o.minimum);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -2321,12 +2571,21 @@ CesiumJsonReader::IJsonHandler* AssetJsonHandler::readObjectKeyAsset(
     const std::string& objectType,
     const std::string_view& str,
     Cesium3DTiles::Asset& o) {
-  using namespace std::string_literals;
-
-  if ("version"s == str)
-    return property("version", this->_version, o.version);
-  if ("tilesetVersion"s == str)
-    return property("tilesetVersion", this->_tilesetVersion, o.tilesetVersion);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 7:
+    if ("version"sv == str)
+      return property("version", this->_version, o.version);
+    break;
+  case 14:
+    if ("tilesetVersion"sv == str)
+      return property(
+          "tilesetVersion",
+          this->_tilesetVersion,
+          o.tilesetVersion);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
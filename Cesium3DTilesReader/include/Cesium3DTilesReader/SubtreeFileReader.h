@@ -71,14 +71,51 @@ public:
       const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
       const gsl::span<const std::byte>& data) const noexcept;
 
+  /**
+   * @brief Asynchronously loads a subtree from data that has already been
+   * retrieved, taking ownership of it.
+   *
+   * If the data is a binary subtree file, its binary chunk is moved to the
+   * start of the given vector, which then becomes the data of the first
+   * buffer of the subtree, so the binary chunk is not copied. A
+   * `SubtreeAvailability` created from the subtree refers to the bitstreams
+   * in that buffer in place.
+   *
+   * @param asyncSystem The AsyncSystem used to do asynchronous work.
+   * @param pAssetAccessor The accessor used to retrieve any other required
+   * resources.
+   * @param url The URL from which the subtree file was retrieved, against
+   * which the URIs of external buffers are resolved.
+   * @param requestHeaders Headers to include in the requests for any
+   * additional resources that are required.
+   * @param data The content of the subtree file.
+   * @return A future that resolves to the result of loading the subtree.
+   */
+  CesiumAsync::Future<CesiumJsonReader::ReadJsonResult<Cesium3DTiles::Subtree>>
+  load(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+      std::vector<std::byte>&& data) const noexcept;
+
 private:
   CesiumAsync::Future<CesiumJsonReader::ReadJsonResult<Cesium3DTiles::Subtree>>
+  loadFromData(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+      const gsl::span<const std::byte>& data,
+      std::vector<std::byte>* pOwnedData) const noexcept;
+  CesiumAsync::Future<CesiumJsonReader::ReadJsonResult<Cesium3DTiles::Subtree>>
   loadBinary(
       const CesiumAsync::AsyncSystem& asyncSystem,
       const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
       const std::string& url,
       const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
-      const gsl::span<const std::byte>& data) const noexcept;
+      const gsl::span<const std::byte>& data,
+      std::vector<std::byte>* pOwnedData) const noexcept;
   CesiumAsync::Future<CesiumJsonReader::ReadJsonResult<Cesium3DTiles::Subtree>>
   loadJson(
       const CesiumAsync::AsyncSystem& asyncSystem,
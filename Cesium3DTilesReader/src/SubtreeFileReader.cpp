@@ -71,6 +71,38 @@ Future<ReadJsonResult<Subtree>> SubtreeFileReader::load(
     const std::string& url,
     const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
     const gsl::span<const std::byte>& data) const noexcept {
+  return this->loadFromData(
+      asyncSystem,
+      pAssetAccessor,
+      url,
+      requestHeaders,
+      data,
+      nullptr);
+}
+
+Future<ReadJsonResult<Subtree>> SubtreeFileReader::load(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+    std::vector<std::byte>&& data) const noexcept {
+  const gsl::span<const std::byte> dataSpan(data.data(), data.size());
+  return this->loadFromData(
+      asyncSystem,
+      pAssetAccessor,
+      url,
+      requestHeaders,
+      dataSpan,
+      &data);
+}
+
+Future<ReadJsonResult<Subtree>> SubtreeFileReader::loadFromData(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>* pOwnedData) const noexcept {
   if (data.size() < 4) {
     CesiumJsonReader::ReadJsonResult<Subtree> result;
     result.errors.emplace_back(fmt::format(
@@ -89,8 +121,13 @@ Future<ReadJsonResult<Subtree>> SubtreeFileReader::load(
   }
 
   if (isBinarySubtree) {
-    return this
-        ->loadBinary(asyncSystem, pAssetAccessor, url, requestHeaders, data);
+    return this->loadBinary(
+        asyncSystem,
+        pAssetAccessor,
+        url,
+        requestHeaders,
+        data,
+        pOwnedData);
   } else {
     return this
         ->loadJson(asyncSystem, pAssetAccessor, url, requestHeaders, data);
@@ -113,7 +150,8 @@ Future<ReadJsonResult<Subtree>> SubtreeFileReader::loadBinary(
     const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
     const std::string& url,
     const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
-    const gsl::span<const std::byte>& data) const noexcept {
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>* pOwnedData) const noexcept {
   if (data.size() < sizeof(SubtreeHeader)) {
     CesiumJsonReader::ReadJsonResult<Subtree> result;
     result.errors.emplace_back(fmt::format(
@@ -168,15 +206,27 @@ Future<ReadJsonResult<Subtree>> SubtreeFileReader::loadBinary(
 
     const int64_t binaryChunkSize = static_cast<int64_t>(binaryChunk.size());
     if (buffer.byteLength > binaryChunkSize ||
-        buffer.byteLength + 3 < binaryChunkSize) {
+        buffer.byteLength + 7 < binaryChunkSize) {
       result.errors.emplace_back("Subtree binary chunk size does not match the "
                                  "size of the first buffer in the JSON chunk.");
       return asyncSystem.createResolvedFuture(std::move(result));
     }
 
-    buffer.cesium.data = std::vector<std::byte>(
-        binaryChunk.begin(),
-        binaryChunk.begin() + buffer.byteLength);
+    if (pOwnedData) {
+      // Move the binary chunk to the start of the data we own and use that
+      // as the buffer, rather than copying the chunk into a new allocation.
+      const size_t binaryChunkOffset =
+          size_t(binaryChunk.data() - pOwnedData->data());
+      pOwnedData->erase(
+          pOwnedData->begin(),
+          pOwnedData->begin() + int64_t(binaryChunkOffset));
+      pOwnedData->resize(size_t(buffer.byteLength));
+      buffer.cesium.data = std::move(*pOwnedData);
+    } else {
+      buffer.cesium.data = std::vector<std::byte>(
+          binaryChunk.begin(),
+          binaryChunk.begin() + buffer.byteLength);
+    }
   }
 
   return postprocess(
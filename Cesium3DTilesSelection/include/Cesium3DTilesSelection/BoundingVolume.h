@@ -4,6 +4,7 @@
 
 #include <CesiumGeometry/BoundingSphere.h>
 #include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeometry/Ray.h>
 #include <CesiumGeospatial/BoundingRegion.h>
 #include <CesiumGeospatial/BoundingRegionWithLooseFittingHeights.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
@@ -57,6 +58,20 @@ CESIUM3DTILESSELECTION_API BoundingVolume transformBoundingVolume(
 CESIUM3DTILESSELECTION_API glm::dvec3
 getBoundingVolumeCenter(const BoundingVolume& boundingVolume);
 
+/**
+ * @brief Computes a {@link CesiumGeometry::BoundingSphere} that encloses the
+ * given {@link BoundingVolume}.
+ *
+ * The sphere is centered at {@link getBoundingVolumeCenter}. It is cheaper to
+ * test than most bounding volumes, so it can be used as a conservative test
+ * before the exact one.
+ *
+ * @param boundingVolume The bounding volume.
+ * @return The enclosing sphere.
+ */
+CESIUM3DTILESSELECTION_API CesiumGeometry::BoundingSphere
+computeEnclosingSphere(const BoundingVolume& boundingVolume);
+
 /**
  * @brief Estimates the bounding {@link CesiumGeospatial::GlobeRectangle} of the
  * given {@link BoundingVolume}.
@@ -87,4 +102,22 @@ getBoundingRegionFromBoundingVolume(const BoundingVolume& boundingVolume);
 CESIUM3DTILESSELECTION_API CesiumGeometry::OrientedBoundingBox
 getOrientedBoundingBoxFromBoundingVolume(const BoundingVolume& boundingVolume);
 
+/**
+ * @brief Computes the intersection of a ray and a {@link BoundingVolume}, as
+ * the distance along the ray to the point where it enters the volume.
+ *
+ * Bounding regions and S2 cells are tested with the oriented bounding box that
+ * contains them, so a ray that passes close to them may be found to intersect
+ * them.
+ *
+ * @param ray The ray.
+ * @param boundingVolume The bounding volume.
+ * @return The distance along the ray to the point where it enters the volume,
+ * which is 0.0 if the origin of the ray is in the volume, or `std::nullopt` if
+ * there is no intersection.
+ */
+CESIUM3DTILESSELECTION_API std::optional<double> intersectRayWithBoundingVolume(
+    const CesiumGeometry::Ray& ray,
+    const BoundingVolume& boundingVolume);
+
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ITileEvictionPolicy.h"
+#include "Library.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief A {@link ITileEvictionPolicy} that keeps the tiles that are the most
+ * expensive to load again, relative to the memory they use.
+ *
+ * The retention score of a tile is its load time, times the number of
+ * separate times it has come back into view, divided by its size in bytes,
+ * and halved for every {@link getRecencyHalfLife} frames since it was last
+ * used. So large tiles that loaded quickly and were only seen once, such as
+ * those passed over by a single flyover, are evicted before small, slow tiles
+ * that are seen again and again.
+ */
+class CESIUM3DTILESSELECTION_API CostAwareTileEvictionPolicy
+    : public ITileEvictionPolicy {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param recencyHalfLife The number of frames after which the retention
+   * score of an unused tile is halved.
+   */
+  explicit CostAwareTileEvictionPolicy(double recencyHalfLife = 600.0) noexcept;
+
+  /**
+   * @brief Gets the number of frames after which the retention score of an
+   * unused tile is halved.
+   */
+  double getRecencyHalfLife() const noexcept { return this->_recencyHalfLife; }
+
+  virtual void startNewFrame() noexcept override;
+
+  virtual void notifyTileVisited(const Tile& tile) noexcept override;
+
+  virtual void
+  notifyTileLoaded(const Tile& tile, double loadTime) noexcept override;
+
+  virtual double computeRetentionScore(const Tile& tile) const noexcept override;
+
+private:
+  struct TileStatistics {
+    double loadTime = -1.0;
+    uint32_t visits = 0;
+    int64_t lastVisitFrame = -1;
+  };
+
+  double _recencyHalfLife;
+  int64_t _frameNumber;
+  double _totalLoadTime;
+  uint32_t _loadCount;
+  std::unordered_map<const Tile*, TileStatistics> _statistics;
+};
+
+} // namespace Cesium3DTilesSelection
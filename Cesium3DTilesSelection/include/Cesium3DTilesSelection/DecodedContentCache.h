@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Library.h"
+
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/ContentHash.h>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief A cache of the glTFs decoded from tile content, keyed by a hash of
+ * the content itself rather than by its URL.
+ *
+ * Tilesets often reference identical content more than once, such as the same
+ * model at several URLs that only differ in their query strings. When a
+ * {@link TilesetContentOptions::pDecodedContentCache} is set, a loader that
+ * receives content that it has already decoded copies the glTF from here
+ * instead of decoding it again, which skips the parsing, mesh decompression,
+ * and image decoding. The same cache can be shared by several tilesets.
+ *
+ * Each tile still gets its own copy of the glTF, and its own renderer
+ * resources.
+ *
+ * When the cached glTFs take more than {@link getMaximumBytes}, the least
+ * recently used are evicted. The cache may be used from any thread.
+ */
+class CESIUM3DTILESSELECTION_API DecodedContentCache {
+public:
+  /**
+   * @brief Identifies tile content by its length and by two independent
+   * 64-bit hashes of its bytes.
+   *
+   * The hashes are not cryptographic, so the cache must not be shared between
+   * tilesets whose content may be crafted to collide.
+   */
+  using Key = CesiumUtility::ContentHash;
+
+  /**
+   * @brief Creates an empty cache.
+   *
+   * @param maximumBytes The number of bytes that the cached glTFs may take
+   * before the least recently used are evicted.
+   */
+  explicit DecodedContentCache(
+      int64_t maximumBytes = 64 * 1024 * 1024) noexcept;
+
+  /**
+   * @brief Computes the key of tile content.
+   *
+   * @param content The content, as it was received.
+   * @return The key.
+   */
+  static Key computeKey(const gsl::span<const std::byte>& content) noexcept;
+
+  /**
+   * @brief Finds the glTF decoded from content, and marks it as recently
+   * used.
+   *
+   * @param key The key of the content.
+   * @return A copy of the glTF, or std::nullopt if it is not cached.
+   */
+  std::optional<CesiumGltf::Model> find(const Key& key);
+
+  /**
+   * @brief Adds the glTF decoded from content, replacing any that has the
+   * same key, and evicts the least recently used glTFs while over
+   * {@link getMaximumBytes}.
+   *
+   * A glTF that is larger than {@link getMaximumBytes} is not added.
+   *
+   * @param key The key of the content.
+   * @param model The glTF decoded from the content, before it is processed
+   * for a particular tile.
+   */
+  void insert(const Key& key, const CesiumGltf::Model& model);
+
+  /**
+   * @brief Gets the number of bytes that the cached glTFs may take before the
+   * least recently used are evicted.
+   */
+  int64_t getMaximumBytes() const noexcept { return this->_maximumBytes; }
+
+  /**
+   * @brief Gets the number of cached glTFs.
+   */
+  size_t getCount() const;
+
+  /**
+   * @brief Gets the approximate number of bytes that the cached glTFs take.
+   */
+  int64_t getByteSize() const;
+
+  /**
+   * @brief Removes all of the cached glTFs.
+   *
+   * @return The number of bytes that they took.
+   */
+  int64_t clear();
+
+private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const noexcept {
+      return static_cast<size_t>(key.hash1);
+    }
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<const CesiumGltf::Model> pModel;
+    int64_t byteSize;
+  };
+
+  mutable std::mutex _mutex;
+  // The most recently used entry is at the front.
+  std::list<Entry> _entries;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> _entriesByKey;
+  int64_t _byteSize;
+  int64_t _maximumBytes;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -11,6 +11,9 @@
 #include <gsl/span>
 
 #include <any>
+#include <cstdint>
+#include <limits>
+#include <vector>
 
 namespace CesiumAsync {
 class AsyncSystem;
@@ -33,11 +36,115 @@ namespace Cesium3DTilesSelection {
 
 class Tile;
 
+/**
+ * @brief A raster overlay tile in an atlas passed to
+ * {@link IPrepareRendererResources::attachRasterAtlasInMainThread}.
+ */
+struct RasterOverlayAtlasEntry {
+  /**
+   * @brief The ID of the overlay texture coordinate set to use.
+   */
+  int32_t overlayTextureCoordinateID;
+
+  /**
+   * @brief The raster overlay tile whose image is in the atlas.
+   */
+  const CesiumRasterOverlays::RasterOverlayTile* pRasterTile;
+
+  /**
+   * @brief The translation to apply to the texture coordinates identified by
+   * {@link overlayTextureCoordinateID} to sample this tile's region of the
+   * atlas, as in {@link IPrepareRendererResources::attachRasterInMainThread}.
+   */
+  glm::dvec2 translation;
+
+  /**
+   * @brief The scale to apply to the texture coordinates identified by
+   * {@link overlayTextureCoordinateID} to sample this tile's region of the
+   * atlas, as in {@link IPrepareRendererResources::attachRasterInMainThread}.
+   */
+  glm::dvec2 scale;
+};
+
 struct TileLoadResultAndRenderResources {
   TileLoadResult result;
   void* pRenderResources{nullptr};
 };
 
+/**
+ * @brief How much main-thread work
+ * {@link IPrepareRendererResources::prepareInMainThreadIncrementally} may do
+ * in one call.
+ *
+ * @see TilesetOptions::mainThreadLoadingTimeLimit
+ * @see TilesetOptions::mainThreadLoadingByteLimit
+ */
+struct CESIUM3DTILESSELECTION_API MainThreadLoadBudget {
+  /**
+   * @brief The time left for main-thread loading in this frame, in
+   * milliseconds.
+   */
+  double milliseconds = std::numeric_limits<double>::infinity();
+
+  /**
+   * @brief The number of bytes that may still be uploaded to the GPU, or
+   * otherwise processed, in this frame.
+   */
+  int64_t bytes = std::numeric_limits<int64_t>::max();
+};
+
+/**
+ * @brief The result of
+ * {@link IPrepareRendererResources::prepareInMainThreadIncrementally}.
+ */
+struct CESIUM3DTILESSELECTION_API MainThreadPrepareResult {
+  /**
+   * @brief Whether the main-thread work for the tile is complete.
+   *
+   * If false, the method is called again with the same `pLoadThreadResult`
+   * in a later frame, and {@link pMainThreadResult} is ignored.
+   */
+  bool complete = true;
+
+  /**
+   * @brief The result of the load process once it is complete, as it would
+   * be returned by {@link IPrepareRendererResources::prepareInMainThread}.
+   */
+  void* pMainThreadResult = nullptr;
+
+  /**
+   * @brief The number of bytes processed by this call, which are counted
+   * against {@link MainThreadLoadBudget::bytes}.
+   */
+  int64_t bytesProcessed = 0;
+};
+
+/**
+ * @brief The renderer resources of a tile, as passed to
+ * {@link IPrepareRendererResources::prepareInMainThreadBatch} and
+ * {@link IPrepareRendererResources::freeBatch}.
+ */
+struct CESIUM3DTILESSELECTION_API TileRendererResources {
+  /**
+   * @brief The tile that the resources belong to.
+   */
+  Tile* pTile = nullptr;
+
+  /**
+   * @brief The result of
+   * {@link IPrepareRendererResources::prepareInLoadThread}, or `nullptr` if
+   * the main-thread part of the preparation has completed.
+   */
+  void* pLoadThreadResult = nullptr;
+
+  /**
+   * @brief The result of
+   * {@link IPrepareRendererResources::prepareInMainThread}, or `nullptr` if
+   * it has not been called yet.
+   */
+  void* pMainThreadResult = nullptr;
+};
+
 /**
  * @brief When implemented for a rendering engine, allows renderer resources to
  * be created and destroyed under the control of a {@link Tileset}.
@@ -95,6 +202,62 @@ public:
    */
   virtual void* prepareInMainThread(Tile& tile, void* pLoadThreadResult) = 0;
 
+  /**
+   * @brief Further prepares renderer resources, doing no more work than a
+   * budget allows.
+   *
+   * This is called instead of {@link prepareInMainThread}, from the same
+   * thread that called {@link Tileset::updateView}. An implementation that
+   * has more work to do than the budget allows, for example to upload large
+   * textures, can do part of it, keep its progress in the object passed as
+   * `pLoadThreadResult`, and return an incomplete result. It is then called
+   * again with the same `pLoadThreadResult` in a later frame. Until it returns
+   * a complete result, {@link free} receives the `pLoadThreadResult`.
+   *
+   * An implementation must make progress in every call, so that the tile
+   * eventually finishes loading even with a small budget. The default
+   * implementation does all of the work at once with
+   * {@link prepareInMainThread}.
+   *
+   * @param tile The tile to prepare.
+   * @param pLoadThreadResult The value returned from
+   * {@link prepareInLoadThread}.
+   * @param budget The work that this call may do.
+   * @returns Whether the work is complete, the main-thread result if it is,
+   * and the number of bytes processed.
+   */
+  virtual MainThreadPrepareResult prepareInMainThreadIncrementally(
+      Tile& tile,
+      void* pLoadThreadResult,
+      const MainThreadLoadBudget& budget) {
+    (void)budget;
+    return {true, this->prepareInMainThread(tile, pLoadThreadResult), 0};
+  }
+
+  /**
+   * @brief Further prepares renderer resources for several tiles at once.
+   *
+   * This is called instead of {@link prepareInMainThread} when
+   * {@link TilesetOptions::batchRendererResourceCalls} is true, from the
+   * same thread that called {@link Tileset::updateView}, with all of the tiles
+   * that finished loading in the load thread this frame. This allows a
+   * renderer to combine its uploads and other per-call work. The
+   * implementation sets the `pMainThreadResult` of each element to what
+   * {@link prepareInMainThread} would have returned for it. The default
+   * implementation calls {@link prepareInMainThread} for each tile.
+   *
+   * @param tiles The tiles to prepare, with the values returned from
+   * {@link prepareInLoadThread}.
+   */
+  virtual void
+  prepareInMainThreadBatch(gsl::span<TileRendererResources> tiles) {
+    for (TileRendererResources& resources : tiles) {
+      resources.pMainThreadResult = this->prepareInMainThread(
+          *resources.pTile,
+          resources.pLoadThreadResult);
+    }
+  }
+
   /**
    * @brief Frees previously-prepared renderer resources.
    *
@@ -114,6 +277,51 @@ public:
       void* pLoadThreadResult,
       void* pMainThreadResult) noexcept = 0;
 
+  /**
+   * @brief Frees previously-prepared renderer resources of several tiles at
+   * once.
+   *
+   * This is called instead of {@link free} when
+   * {@link TilesetOptions::batchRendererResourceCalls} is true and a
+   * {@link Tileset} unloads tiles to stay within its cache limits, from the
+   * thread that called {@link Tileset::updateView}. The tiles' raster overlay
+   * tiles have already been detached, and their content has already been
+   * unloaded. The default implementation calls {@link free} for each tile.
+   *
+   * @param tiles The tiles for which to free renderer resources.
+   */
+  virtual void
+  freeBatch(gsl::span<const TileRendererResources> tiles) noexcept {
+    for (const TileRendererResources& resources : tiles) {
+      this->free(
+          *resources.pTile,
+          resources.pLoadThreadResult,
+          resources.pMainThreadResult);
+    }
+  }
+
+  /**
+   * @brief Gets the number of bytes of GPU memory used by previously-prepared
+   * renderer resources for a tile.
+   *
+   * This method is called from the thread that called
+   * {@link Tileset::updateView}, right after {@link prepareInMainThread}
+   * returns. The bytes are counted against
+   * {@link TilesetOptions::maximumGpuBytes}. The default implementation
+   * reports no GPU memory.
+   *
+   * @param tile The tile that was prepared.
+   * @param pMainThreadResult The result returned by
+   * {@link prepareInMainThread}.
+   * @return The number of bytes of GPU memory.
+   */
+  virtual int64_t
+  getGpuByteSize(const Tile& tile, void* pMainThreadResult) const noexcept {
+    (void)tile;
+    (void)pMainThreadResult;
+    return 0;
+  }
+
   /**
    * @brief Attaches a raster overlay tile to a geometry tile.
    *
@@ -157,6 +365,48 @@ public:
       int32_t overlayTextureCoordinateID,
       const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
       void* pMainThreadRendererResources) noexcept = 0;
+
+  /**
+   * @brief Attaches an atlas of all the raster overlay tiles attached to a
+   * geometry tile.
+   *
+   * This is only called when
+   * {@link TilesetOptions::packRasterOverlaysIntoAtlas} is set, after each of
+   * the raster overlay tiles has been attached with
+   * {@link attachRasterInMainThread}. The renderer can draw the tile with the
+   * atlas instead of the individual raster overlay tiles until
+   * {@link detachRasterAtlasInMainThread} is called. The raster overlay tiles
+   * stay attached as well, and are detached individually as before. The
+   * default implementation does nothing.
+   *
+   * @param tile The geometry tile.
+   * @param atlasImage The image containing the images of all the raster
+   * overlay tiles. It has no mipmaps.
+   * @param entries The raster overlay tiles in the atlas, with the texture
+   * coordinate transform to sample each of them in the atlas.
+   */
+  virtual void attachRasterAtlasInMainThread(
+      const Tile& tile,
+      const CesiumGltf::ImageCesium& atlasImage,
+      const std::vector<RasterOverlayAtlasEntry>& entries) {
+    (void)tile;
+    (void)atlasImage;
+    (void)entries;
+  }
+
+  /**
+   * @brief Detaches the atlas previously attached to a geometry tile with
+   * {@link attachRasterAtlasInMainThread}.
+   *
+   * This is called once the raster overlay tiles mapped to the geometry tile
+   * have changed, and before the tile is unloaded. The default implementation
+   * does nothing.
+   *
+   * @param tile The geometry tile.
+   */
+  virtual void detachRasterAtlasInMainThread(const Tile& tile) noexcept {
+    (void)tile;
+  }
 };
 
 } // namespace Cesium3DTilesSelection
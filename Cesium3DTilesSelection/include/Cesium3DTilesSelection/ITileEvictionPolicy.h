@@ -0,0 +1,63 @@
+#pragma once
+
+namespace Cesium3DTilesSelection {
+
+class Tile;
+
+/**
+ * @brief An interface that decides which tiles are unloaded first when the
+ * tile cache is over {@link TilesetOptions::maximumCachedBytes}, when provided
+ * in {@link TilesetOptions::evictionPolicy}.
+ *
+ * Only tiles that were not used by the last frame are candidates for
+ * eviction. Without a policy, they are unloaded in least-recently-used order.
+ * With a policy, they are unloaded in increasing order of
+ * {@link computeRetentionScore}, with ties broken by least-recent use.
+ *
+ * All functions are called from the main thread.
+ */
+class ITileEvictionPolicy {
+public:
+  virtual ~ITileEvictionPolicy() = default;
+
+  /**
+   * @brief Indicates the start of a new frame, initiated with a call to {@link Tileset::updateView}.
+   */
+  virtual void startNewFrame() noexcept {}
+
+  /**
+   * @brief Notifies the policy that a tile was used by the current frame.
+   *
+   * @param tile The tile.
+   */
+  virtual void notifyTileVisited(const Tile& tile) noexcept { (void)tile; }
+
+  /**
+   * @brief Notifies the policy that a tile finished loading its content.
+   *
+   * @param tile The tile.
+   * @param loadTime The time, in seconds, from the start of the load until its
+   * result arrived in the main thread.
+   */
+  virtual void notifyTileLoaded(const Tile& tile, double loadTime) noexcept {
+    (void)tile;
+    (void)loadTime;
+  }
+
+  /**
+   * @brief Notifies the policy that a tile was evicted from the cache.
+   *
+   * @param tile The tile.
+   */
+  virtual void notifyTileUnloaded(const Tile& tile) noexcept { (void)tile; }
+
+  /**
+   * @brief Computes how valuable it is to keep a tile loaded.
+   *
+   * @param tile The tile, which is a candidate for eviction.
+   * @return The retention score. Tiles with lower scores are evicted first.
+   */
+  virtual double computeRetentionScore(const Tile& tile) const noexcept = 0;
+};
+
+} // namespace Cesium3DTilesSelection
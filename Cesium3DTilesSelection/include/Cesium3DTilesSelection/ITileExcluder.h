@@ -1,14 +1,48 @@
 #pragma once
 
+#include "Library.h"
+
+#include <CesiumGeometry/BoundingSphere.h>
+
+#include <gsl/span>
+
 namespace Cesium3DTilesSelection {
 
 class Tile;
 
+/**
+ * @brief The outcome of testing a tile with an {@link ITileExcluder}.
+ */
+enum class TileExclusion {
+  /**
+   * @brief The tile is included, but its descendants may still be excluded.
+   */
+  Included,
+
+  /**
+   * @brief The tile and all of its descendants in the bounding volume
+   * hierarchy are excluded from loading and rendering.
+   */
+  Excluded,
+
+  /**
+   * @brief The tile and all of its descendants are included, so the excluder
+   * is not asked about the descendants for the rest of the traversal.
+   */
+  SubtreeIncluded
+};
+
 /**
  * @brief An interface that allows tiles to be excluded from loading and
  * rendering when provided in {@link TilesetOptions::excluders}.
+ *
+ * During tile selection, the children of a tile are tested together with
+ * {@link classifyChildren}, which by default calls {@link classify} for each
+ * of them, which in turn calls {@link shouldExclude}. An excluder only needs
+ * to implement {@link shouldExclude}, but can override the other two to test
+ * the children in one pass, or to report that a whole subtree is included.
  */
-class ITileExcluder {
+class CESIUM3DTILESSELECTION_API ITileExcluder {
 public:
   virtual ~ITileExcluder() = default;
 
@@ -26,6 +60,36 @@ public:
    * @return false if this tile should be included.
    */
   virtual bool shouldExclude(const Tile& tile) const noexcept = 0;
+
+  /**
+   * @brief Determines whether a given tile should be excluded, and whether
+   * its descendants need to be tested at all.
+   *
+   * The default implementation returns {@link TileExclusion::Excluded} or
+   * {@link TileExclusion::Included} according to {@link shouldExclude}.
+   *
+   * @param tile The tile to test.
+   * @return The exclusion of the tile.
+   */
+  virtual TileExclusion classify(const Tile& tile) const noexcept;
+
+  /**
+   * @brief Determines the exclusion of each of the children of a tile.
+   *
+   * The default implementation calls {@link classify} for each child.
+   *
+   * @param parent The tile whose children to test.
+   * @param childBoundingSpheres The spheres that enclose the bounding volumes
+   * of the children, as computed by {@link computeEnclosingSphere}, in the
+   * order of {@link Tile::getChildren}. They are packed together so that they
+   * can be tested in one pass without reading the children themselves.
+   * @param results Receives the exclusion of each child, in the same order.
+   * It has as many elements as there are children.
+   */
+  virtual void classifyChildren(
+      const Tile& parent,
+      gsl::span<const CesiumGeometry::BoundingSphere> childBoundingSpheres,
+      gsl::span<TileExclusion> results) const noexcept;
 };
 
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Library.h"
+#include "TileLoadResult.h"
+
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumUtility/SharedBytes.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+struct TilesetContentOptions;
+
+/**
+ * @brief A cache of the glTFs of tiles after they have been decoded and
+ * processed, which lets the content of a tile that is loaded again skip the
+ * decoding and processing.
+ *
+ * When a {@link TilesetContentOptions::pProcessedContentCache} is set, the
+ * glTF of each loaded tile is stored in an
+ * {@link CesiumAsync::ICacheDatabase}, such as a
+ * {@link CesiumAsync::SqliteCache}, once its buffers are decoded, its images
+ * are transcoded, and it has been processed for the tile, along with the
+ * bounding volumes computed for it. When the tile is loaded again, for
+ * example after its content was unloaded to make room for other tiles, it is
+ * read back from the database rather than downloaded, gunzipped, parsed,
+ * decompressed, and processed again. Reading it back only parses the small
+ * JSON of the glTF and copies its buffers and images.
+ *
+ * Entries are keyed by the URL of the content and a hash of the options that
+ * change how it is processed, so tilesets with different options may share a
+ * database. The content of tiles with raster overlays, which is processed for
+ * the overlays, and of tiles whose loaders do not know the URL of their
+ * content up front, is not cached. The cache may be used from any thread.
+ */
+class CESIUM3DTILESSELECTION_API ProcessedContentCache {
+public:
+  /**
+   * @brief Creates a cache that stores processed content in a database.
+   *
+   * @param pDatabase The database, which may also be used by a
+   * {@link CesiumAsync::CachingAssetAccessor}, since the keys of processed
+   * content cannot be confused with URLs.
+   * @param maximumAge The number of seconds for which processed content is
+   * kept.
+   */
+  explicit ProcessedContentCache(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase,
+      std::time_t maximumAge = 60 * 60 * 24 * 7) noexcept;
+
+  /**
+   * @brief Computes the key of the processed content of a tile.
+   *
+   * @param url The URL of the content.
+   * @param options The options with which the content is processed.
+   * @param tileTransform The transform of the tile, which the bounding volumes
+   * computed for the content depend on.
+   * @return The key, or `std::nullopt` if content processed with these
+   * options cannot be cached.
+   */
+  static std::optional<std::string> computeKey(
+      const std::string& url,
+      const TilesetContentOptions& options,
+      const glm::dmat4& tileTransform);
+
+  /**
+   * @brief Finds the processed content with a key.
+   *
+   * @param key The key of the content.
+   * @return The content, in a successful {@link TileLoadResult} without a
+   * completed request, or `std::nullopt` if it is not cached, has expired, or
+   * cannot be read.
+   */
+  std::optional<TileLoadResult> find(const std::string& key) const;
+
+  /**
+   * @brief Stores processed content, replacing any that has the same key.
+   *
+   * Content that is not a glTF, or that has raster overlay details, is not
+   * stored.
+   *
+   * @param key The key of the content.
+   * @param url The URL of the content.
+   * @param result The content, after it has been processed.
+   * @return True if the content was stored.
+   */
+  bool insert(
+      const std::string& key,
+      const std::string& url,
+      const TileLoadResult& result) const;
+
+  /**
+   * @brief Writes processed content in the binary format of the cache.
+   *
+   * @return The bytes, or `std::nullopt` if the content cannot be stored.
+   */
+  static std::optional<std::vector<std::byte>>
+  serialize(const TileLoadResult& result);
+
+  /**
+   * @brief Reads processed content written by {@link serialize}.
+   *
+   * @return The content, or `std::nullopt` if it cannot be read.
+   */
+  static std::optional<TileLoadResult>
+  deserialize(const gsl::span<const std::byte>& data);
+
+  /**
+   * @brief Reads processed content written by {@link serialize} without
+   * copying its buffers and images.
+   *
+   * The {@link CesiumGltf::BufferCesium::sharedData} of each buffer and the
+   * {@link CesiumGltf::ImageCesium::sharedPixelData} of each image refer to
+   * regions of the data, and keep it alive. The data may, for example, be a
+   * region of a {@link CesiumUtility::MemoryMappedFile}.
+   *
+   * @return The content, or `std::nullopt` if it cannot be read.
+   */
+  static std::optional<TileLoadResult>
+  deserialize(const CesiumUtility::SharedBytes& data);
+
+private:
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pDatabase;
+  std::time_t _maximumAge;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -185,8 +185,12 @@ public:
    * many loads are already in progress, this method does nothing and returns
    * false. Otherwise, it begins the asynchronous process to load the tile and
    * returns true.
+   *
+   * @param priority The priority of the load, usually the priority of the
+   * geometry tile. See
+   * {@link CesiumRasterOverlays::RasterOverlayTileProvider::loadTileThrottled}.
    */
-  bool loadThrottled() noexcept;
+  bool loadThrottled(const CesiumAsync::TaskPriority& priority = {}) noexcept;
 
   /**
    * @brief Creates a maping between a {@link RasterOverlay} and a {@link Tile}.
@@ -40,6 +40,19 @@ public:
    */
   virtual bool shouldExclude(const Tile& tile) const noexcept override;
 
+  /**
+   * @brief Determines whether a given tile is entirely inside a polygon and
+   * therefore should be excluded, or entirely outside of the polygons so that
+   * none of its descendants, which are inside of its bounding volume, can be
+   * excluded either.
+   *
+   * With an inverted selection, the roles of inside and outside are swapped.
+   *
+   * @param tile The tile to check.
+   * @return The exclusion of the tile.
+   */
+  virtual TileExclusion classify(const Tile& tile) const noexcept override;
+
   /**
    * @brief Gets the overlay defining the polygons.
    */
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The progress of a call to {@link Tileset::precacheRegion}.
+ */
+struct CESIUM3DTILESSELECTION_API RegionPrecacheProgress {
+  /**
+   * @brief The number of tiles in the region that have been visited so far.
+   */
+  uint32_t tilesVisited = 0;
+
+  /**
+   * @brief The number of tiles that have been found but not visited yet.
+   *
+   * More tiles are found as the region is walked, so this can grow.
+   */
+  uint32_t tilesRemaining = 0;
+
+  /**
+   * @brief The number of tiles whose content is being loaded.
+   */
+  uint32_t tilesLoading = 0;
+
+  /**
+   * @brief The number of tiles whose content has been loaded into the cache.
+   *
+   * Tiles that were already loaded by the tileset when they were visited are
+   * not counted.
+   */
+  uint32_t tilesFetched = 0;
+
+  /**
+   * @brief The number of tiles whose content failed to load.
+   */
+  uint32_t tilesFailed = 0;
+
+  /**
+   * @brief The number of raster overlay tiles that are being loaded.
+   */
+  uint32_t rasterOverlayTilesLoading = 0;
+
+  /**
+   * @brief The number of raster overlay tiles that have been loaded into the
+   * cache.
+   */
+  uint32_t rasterOverlayTilesFetched = 0;
+
+  /**
+   * @brief The number of raster overlay tiles that failed to load.
+   */
+  uint32_t rasterOverlayTilesFailed = 0;
+
+  /**
+   * @brief The number of bytes of tile content that have been loaded.
+   */
+  int64_t bytesFetched = 0;
+};
+
+/**
+ * @brief Options for {@link Tileset::precacheRegion}.
+ *
+ * A tile in the region is refined to its children while its screen-space error
+ * is greater than {@link maximumScreenSpaceError}, as seen from
+ * {@link viewingDistance} in a viewport of {@link viewportHeight} pixels with
+ * a {@link verticalFieldOfView}, and its depth is less than
+ * {@link maximumLevel}.
+ */
+struct CESIUM3DTILESSELECTION_API RegionPrecacheOptions {
+  /**
+   * @brief The screen-space error, in pixels, that the cached tiles must meet.
+   */
+  double maximumScreenSpaceError = 16.0;
+
+  /**
+   * @brief The distance, in meters, from which the tiles are expected to be
+   * viewed.
+   *
+   * This is usually the lowest height above the region that the camera will
+   * be at.
+   */
+  double viewingDistance = 100.0;
+
+  /**
+   * @brief The height of the viewport, in pixels.
+   */
+  double viewportHeight = 1080.0;
+
+  /**
+   * @brief The vertical field of view, in radians.
+   */
+  double verticalFieldOfView = 1.0471975511965976;
+
+  /**
+   * @brief The deepest level of the tile hierarchy to cache, where the root
+   * tile is at level 0, or `std::nullopt` to only stop at the screen-space
+   * error.
+   */
+  std::optional<uint32_t> maximumLevel;
+
+  /**
+   * @brief The maximum number of tile content loads in flight at once.
+   *
+   * These are in addition to the loads of
+   * {@link TilesetOptions::maximumSimultaneousTileLoads}.
+   */
+  uint32_t maximumSimultaneousLoads = 32;
+
+  /**
+   * @brief A function that is called in the main thread, from
+   * {@link Tileset::updateView}, whenever the progress changes.
+   */
+  std::function<void(const RegionPrecacheProgress&)> progressCallback;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Library.h"
+
+#include <CesiumGeospatial/Cartographic.h>
+
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The result of a call to {@link Tileset::sampleHeights}.
+ */
+struct CESIUM3DTILESSELECTION_API SampleHeightResult {
+  /**
+   * @brief The positions that were sampled, in the order they were given.
+   *
+   * The height of each position whose sample succeeded is that of the
+   * most detailed content of the tileset at its longitude and latitude. The
+   * height of the other positions is the one that was given.
+   */
+  std::vector<CesiumGeospatial::Cartographic> positions;
+
+  /**
+   * @brief Whether the height of each position was sampled.
+   *
+   * A sample fails when the vertical line through its position does not
+   * intersect the content of any tile.
+   */
+  std::vector<bool> sampleSuccess;
+
+  /**
+   * @brief Warnings about tiles that could not be loaded or intersected
+   * while the heights were sampled, which may make the heights less accurate.
+   */
+  std::vector<std::string> warnings;
+};
+
+} // namespace Cesium3DTilesSelection
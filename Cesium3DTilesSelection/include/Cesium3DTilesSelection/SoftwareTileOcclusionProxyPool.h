@@ -0,0 +1,99 @@
+#pragma once
+
+#include "BoundingVolume.h"
+#include "Library.h"
+#include "TileOcclusionRendererProxy.h"
+#include "ViewState.h"
+
+#include <CesiumGeospatial/Ellipsoid.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class SoftwareOcclusionDepthBuffer;
+
+/**
+ * @brief A {@link TileOcclusionRendererProxyPool} that determines occlusion on
+ * the CPU, for renderers that cannot provide occlusion query results.
+ *
+ * The client supplies the occluders, typically the terrain tiles rendered in
+ * the previous frame, by calling {@link updateOccluders}. The bottom surface of
+ * each occluder's {@link CesiumGeospatial::BoundingRegion} is rasterized into
+ * a coarse depth buffer for each view, and tile bounding volumes are then
+ * tested against these buffers.
+ *
+ * Because only the bottom of each region is used, a tile is only known to be
+ * occluded when it lies entirely below the occluding terrain, as seen from a
+ * camera above it.
+ *
+ * Occlusion results are available immediately, so the proxies never report
+ * {@link TileOcclusionState::OcclusionUnavailable}.
+ */
+class CESIUM3DTILESSELECTION_API SoftwareTileOcclusionProxyPool
+    : public TileOcclusionRendererProxyPool {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param maximumPoolSize The maximum number of
+   * {@link TileOcclusionRendererProxy} instances that may exist in this pool.
+   * @param width The width of the depth buffer for each view, in pixels.
+   * @param height The height of the depth buffer for each view, in pixels.
+   * @param ellipsoid The ellipsoid on which the occluders' bounding regions
+   * are defined.
+   */
+  SoftwareTileOcclusionProxyPool(
+      int32_t maximumPoolSize,
+      uint32_t width = 256,
+      uint32_t height = 128,
+      const CesiumGeospatial::Ellipsoid& ellipsoid =
+          CesiumGeospatial::Ellipsoid::WGS84);
+
+  /**
+   * @brief Destroys this pool.
+   */
+  ~SoftwareTileOcclusionProxyPool() noexcept;
+
+  /**
+   * @brief Rebuilds the depth buffers from a new set of occluders.
+   *
+   * This must not be called while {@link Tileset::updateView} is running.
+   * Occluders that are not bounded by a
+   * {@link CesiumGeospatial::BoundingRegion} with tight heights are ignored,
+   * as are occluders that the camera is underneath.
+   *
+   * @param frustums The views, in the same order they are passed to
+   * {@link Tileset::updateView}.
+   * @param occluders The opaque tiles that may hide other tiles.
+   */
+  void updateOccluders(
+      const std::vector<ViewState>& frustums,
+      const std::vector<const Tile*>& occluders);
+
+  /**
+   * @brief Computes whether a bounding volume is hidden by the occluders in
+   * every view.
+   *
+   * @param boundingVolume The bounding volume.
+   * @return {@link TileOcclusionState::Occluded} if the bounding volume is
+   * occluded in every view, or {@link TileOcclusionState::NotOccluded}
+   * otherwise, including when there are no occluders.
+   */
+  TileOcclusionState
+  computeOcclusionState(const BoundingVolume& boundingVolume) const;
+
+protected:
+  virtual TileOcclusionRendererProxy* createProxy() override;
+
+  virtual void destroyProxy(TileOcclusionRendererProxy* pProxy) override;
+
+private:
+  uint32_t _width;
+  uint32_t _height;
+  CesiumGeospatial::Ellipsoid _ellipsoid;
+  std::vector<std::unique_ptr<SoftwareOcclusionDepthBuffer>> _depthBuffers;
+};
+
+} // namespace Cesium3DTilesSelection
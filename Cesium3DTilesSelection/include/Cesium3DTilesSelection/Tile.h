@@ -5,6 +5,7 @@
 #include "RasterMappedTo3DTile.h"
 #include "TileContent.h"
 #include "TileID.h"
+#include "TileLoadTimeline.h"
 #include "TileRefine.h"
 #include "TileSelectionState.h"
 
@@ -15,6 +16,7 @@
 #include <gsl/span>
 
 #include <atomic>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -485,6 +487,15 @@ public:
    */
   TileLoadState getState() const noexcept;
 
+  /**
+   * @brief Gets the times at which the latest load of this tile passed
+   * through each stage, or `nullptr` if this tile was not loaded while
+   * {@link TilesetOptions::enableTileLoadTimelines} was true.
+   */
+  const TileLoadTimeline* getLoadTimeline() const noexcept {
+    return this->_pLoadTimeline.get();
+  }
+
 private:
   struct TileConstructorImpl {};
   template <
@@ -524,17 +535,43 @@ private:
   // Selection state
   TileSelectionState _lastSelectionState;
 
+  // Index of this tile in the TileSelectionDataTable of its tileset.
+  static constexpr uint32_t InvalidSelectionDataIndex =
+      std::numeric_limits<uint32_t>::max();
+  uint32_t _selectionDataIndex;
+
+  // Index of the proxy mapped to this tile in the
+  // TileOcclusionRendererProxyPool that last mapped one. The pool checks that
+  // the proxy is still mapped to this tile before using it.
+  static constexpr uint32_t InvalidOcclusionProxyHandle =
+      std::numeric_limits<uint32_t>::max();
+  mutable uint32_t _occlusionProxyHandle;
+
   // tile content
   CesiumUtility::DoublyLinkedListPointers<Tile> _loadedTilesLinks;
   TileContent _content;
   TilesetContentLoader* _pLoader;
   TileLoadState _loadState;
   bool _shouldContentContinueUpdating;
+  std::unique_ptr<TileLoadTimeline> _pLoadTimeline;
+
+  // Index of the JSON of the children of this tile that are not yet created
+  // in the TilesetJsonLoader that created this tile.
+  static constexpr uint32_t InvalidDeferredChildrenIndex =
+      std::numeric_limits<uint32_t>::max();
+  uint32_t _deferredChildrenIndex;
 
   // mapped raster overlay
   std::vector<RasterMappedTo3DTile> _rasterTiles;
 
+  // The number of raster overlay tiles in the atlas attached to this tile, or
+  // zero if no atlas is attached.
+  size_t _rasterOverlayAtlasSize;
+
   friend class TilesetContentManager;
+  friend class TileSelectionDataTable;
+  friend class TileOcclusionRendererProxyPool;
+  friend class TilesetJsonLoader;
   friend class MockTilesetContentManagerTestFixture;
 
 public:
@@ -1,13 +1,17 @@
 #pragma once
 
 #include "Library.h"
+#include "TileFeatureIndex.h"
+#include "TileGeometryIndex.h"
 #include "TilesetMetadata.h"
 
 #include <CesiumGeospatial/Projection.h>
 #include <CesiumGltf/Model.h>
+#include <CesiumGltf/PackedPropertyTable.h>
 #include <CesiumRasterOverlays/RasterOverlayDetails.h>
 #include <CesiumUtility/CreditSystem.h>
 
+#include <cstdint>
 #include <memory>
 #include <variant>
 #include <vector>
@@ -172,6 +176,23 @@ public:
    */
   void setRenderResources(void* pRenderResources) noexcept;
 
+  /**
+   * @brief Get the number of bytes of GPU memory used by the render resources
+   * of the content, as reported by
+   * {@link IPrepareRendererResources::getGpuByteSize}.
+   *
+   * @return The number of bytes of GPU memory.
+   */
+  int64_t getGpuByteSize() const noexcept;
+
+  /**
+   * @brief Set the number of bytes of GPU memory used by the render resources
+   * of the content. Not to be used by clients.
+   *
+   * @param gpuByteSize The number of bytes of GPU memory.
+   */
+  void setGpuByteSize(int64_t gpuByteSize) noexcept;
+
   /**
    * @brief Get the fade percentage that this tile during an LOD transition.
    *
@@ -192,12 +213,99 @@ public:
    */
   void setLodTransitionFadePercentage(float percentage) noexcept;
 
+  /**
+   * @brief Determines if the buffer or image data of the glTF model was
+   * released once the render resources were prepared.
+   *
+   * The rest of the model, such as its accessors, materials, and image sizes,
+   * is kept.
+   *
+   * @see TilesetContentOptions::releaseBufferDataAfterPrepare
+   * @see TilesetContentOptions::releaseImageDataAfterPrepare
+   */
+  bool isModelDataReleased() const noexcept;
+
+  /**
+   * @brief Set whether the buffer or image data of the glTF model was
+   * released. Not to be used by clients.
+   *
+   * @param modelDataReleased Whether the data was released.
+   */
+  void setModelDataReleased(bool modelDataReleased) noexcept;
+
+  /**
+   * @brief Get the index of the feature properties of the glTF model, or
+   * nullptr if no properties are indexed.
+   *
+   * The index outlives the release of the model's buffer data.
+   *
+   * @see TilesetContentOptions::featureIndexProperties
+   */
+  const TileFeatureIndex* getFeatureIndex() const noexcept;
+
+  /**
+   * @brief Set the index of the feature properties of the glTF model. Not to
+   * be used by clients.
+   *
+   * @param pFeatureIndex The index, or nullptr to remove it.
+   */
+  void setFeatureIndex(
+      std::shared_ptr<const TileFeatureIndex> pFeatureIndex) noexcept;
+
+  /**
+   * @brief Get the packed properties of the property tables of the glTF
+   * model, one for each property table, or an empty span if no properties
+   * are packed.
+   *
+   * The packed properties outlive the release of the model's buffer data.
+   *
+   * @see TilesetContentOptions::packedProperties
+   */
+  gsl::span<const CesiumGltf::PackedPropertyTable>
+  getPackedPropertyTables() const noexcept;
+
+  /**
+   * @brief Set the packed properties of the property tables of the glTF
+   * model. Not to be used by clients.
+   *
+   * @param pPackedPropertyTables The packed properties, or nullptr to remove
+   * them.
+   */
+  void setPackedPropertyTables(
+      std::shared_ptr<const std::vector<CesiumGltf::PackedPropertyTable>>
+          pPackedPropertyTables) noexcept;
+
+  /**
+   * @brief Get the index of the triangles of the glTF model, or nullptr if
+   * they are not indexed.
+   *
+   * The index outlives the release of the model's buffer data.
+   *
+   * @see TilesetContentOptions::buildGeometryIndex
+   */
+  const TileGeometryIndex* getGeometryIndex() const noexcept;
+
+  /**
+   * @brief Set the index of the triangles of the glTF model. Not to be used
+   * by clients.
+   *
+   * @param pGeometryIndex The index, or nullptr to remove it.
+   */
+  void setGeometryIndex(
+      std::shared_ptr<const TileGeometryIndex> pGeometryIndex) noexcept;
+
 private:
   CesiumGltf::Model _model;
   void* _pRenderResources;
+  int64_t _gpuByteSize;
   CesiumRasterOverlays::RasterOverlayDetails _rasterOverlayDetails;
   std::vector<CesiumUtility::Credit> _credits;
   float _lodTransitionFadePercentage;
+  bool _modelDataReleased;
+  std::shared_ptr<const TileFeatureIndex> _pFeatureIndex;
+  std::shared_ptr<const std::vector<CesiumGltf::PackedPropertyTable>>
+      _pPackedPropertyTables;
+  std::shared_ptr<const TileGeometryIndex> _pGeometryIndex;
 };
 
 /**
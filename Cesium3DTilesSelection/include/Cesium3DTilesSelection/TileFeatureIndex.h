@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Library.h"
+
+#include <gsl/span>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace Cesium3DTilesSelection {
+
+class Tile;
+
+/**
+ * @brief A feature of the content of a tile: a row of one of the property
+ * tables of its `EXT_structural_metadata` extension.
+ */
+struct CESIUM3DTILESSELECTION_API TileFeature {
+  /**
+   * @brief The index of the property table in the `EXT_structural_metadata`
+   * extension of the model.
+   */
+  int64_t propertyTableIndex = -1;
+
+  /**
+   * @brief The ID of the feature, which is its row in the property table.
+   */
+  int64_t featureId = -1;
+
+  /**
+   * @brief Compares two features for equality.
+   */
+  bool operator==(const TileFeature& other) const noexcept {
+    return this->propertyTableIndex == other.propertyTableIndex &&
+           this->featureId == other.featureId;
+  }
+};
+
+/**
+ * @brief A feature of the content of a loaded tile, as found by
+ * {@link Tileset::findLoadedFeatures}.
+ */
+struct CESIUM3DTILESSELECTION_API LoadedTileFeature {
+  /**
+   * @brief The tile whose content has the feature.
+   */
+  Tile* pTile = nullptr;
+
+  /**
+   * @brief The feature of the tile's content.
+   */
+  TileFeature feature;
+};
+
+/**
+ * @brief An index from the values of chosen properties of the features of a
+ * tile's content to the features that have them.
+ *
+ * The index is built from the property tables of the `EXT_structural_metadata`
+ * extension of a model, for the properties named in
+ * {@link TilesetContentOptions::featureIndexProperties}. String properties are
+ * indexed by their value, and integer scalar properties by their value as an
+ * `int64_t`. Features whose value is the property's "no data" value are not
+ * indexed, unless the property has a default value. Properties of other types
+ * are not indexed.
+ */
+class CESIUM3DTILESSELECTION_API TileFeatureIndex {
+public:
+  /**
+   * @brief Constructs an empty index.
+   */
+  TileFeatureIndex() noexcept = default;
+
+  /**
+   * @brief Builds the index of the chosen properties of a model.
+   *
+   * @param model The model whose property tables are indexed.
+   * @param propertyIds The IDs of the properties to index, in any class.
+   */
+  TileFeatureIndex(
+      const CesiumGltf::Model& model,
+      const std::vector<std::string>& propertyIds);
+
+  /**
+   * @brief Finds the features whose string property has a value.
+   *
+   * @param propertyId The ID of the property.
+   * @param value The value of the property.
+   * @return The features, or an empty span if the property is not indexed or
+   * no feature has the value.
+   */
+  gsl::span<const TileFeature>
+  find(const std::string& propertyId, const std::string& value) const;
+
+  /**
+   * @brief Finds the features whose integer property has a value.
+   *
+   * @param propertyId The ID of the property.
+   * @param value The value of the property.
+   * @return The features, or an empty span if the property is not indexed or
+   * no feature has the value.
+   */
+  gsl::span<const TileFeature>
+  find(const std::string& propertyId, int64_t value) const;
+
+  /**
+   * @brief Gets whether a property is indexed.
+   */
+  bool isIndexed(const std::string& propertyId) const noexcept;
+
+  /**
+   * @brief Gets an estimate of the number of bytes of memory used by the
+   * index.
+   */
+  int64_t getSizeBytes() const noexcept;
+
+private:
+  struct PropertyIndex {
+    std::unordered_map<std::string, std::vector<TileFeature>> strings;
+    std::unordered_map<int64_t, std::vector<TileFeature>> integers;
+  };
+
+  std::unordered_map<std::string, PropertyIndex> _properties;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Library.h"
+
+#include <CesiumGeometry/TriangleBvh.h>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace CesiumGeometry {
+class Ray;
+}
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace Cesium3DTilesSelection {
+
+class Tile;
+
+/**
+ * @brief The intersection of a ray with the triangles of a tile's content.
+ */
+struct CESIUM3DTILESSELECTION_API TileGeometryIntersection {
+  /**
+   * @brief The distance along the ray to the point of intersection.
+   */
+  double distance = 0.0;
+
+  /**
+   * @brief The point of intersection, in the coordinates of the ray.
+   */
+  glm::dvec3 position{0.0};
+
+  /**
+   * @brief The index of the mesh in the glTF model.
+   */
+  int32_t meshId = -1;
+
+  /**
+   * @brief The index of the primitive in the mesh.
+   */
+  int32_t primitiveId = -1;
+
+  /**
+   * @brief The index of the triangle in the primitive, in the order of its
+   * indices.
+   */
+  int64_t triangleIndex = -1;
+};
+
+/**
+ * @brief The intersection of a ray with the content of a loaded tile, as found
+ * by {@link Tileset::intersectLoadedTiles}.
+ */
+struct CESIUM3DTILESSELECTION_API LoadedTileIntersection {
+  /**
+   * @brief The tile whose content the ray intersects.
+   */
+  Tile* pTile = nullptr;
+
+  /**
+   * @brief The intersection with the tile's content.
+   */
+  TileGeometryIntersection intersection;
+};
+
+/**
+ * @brief An index of the triangles of a tile's content, for finding the
+ * intersections of rays with them.
+ *
+ * The index has a {@link CesiumGeometry::TriangleBvh} for each triangle
+ * primitive of the scene of a glTF model, in the coordinates of the model.
+ * It keeps copies of the vertex positions, so it outlives the release of
+ * the model's buffer data.
+ */
+class CESIUM3DTILESSELECTION_API TileGeometryIndex {
+public:
+  /**
+   * @brief Constructs an empty index, which no ray intersects.
+   */
+  TileGeometryIndex() noexcept = default;
+
+  /**
+   * @brief Builds the index of the triangles of a model.
+   *
+   * Primitives with the `TRIANGLES`, `TRIANGLE_STRIP`, and `TRIANGLE_FAN`
+   * modes are indexed, and other primitives are ignored.
+   *
+   * @param model The model whose triangles are indexed.
+   */
+  explicit TileGeometryIndex(const CesiumGltf::Model& model);
+
+  /**
+   * @brief Finds the closest intersection of a ray with the triangles.
+   *
+   * @param ray The ray.
+   * @param tileTransform The transformation of the glTF model to the
+   * coordinates of the ray, which is usually {@link Tile::getTransform}. The
+   * `CESIUM_RTC` center and up axis of the model are applied by the index.
+   * @param cullBackFaces Whether to ignore triangles hit from the back.
+   * @return The closest intersection, or `std::nullopt` if the ray does not
+   * intersect any triangle.
+   */
+  std::optional<TileGeometryIntersection> intersectRay(
+      const CesiumGeometry::Ray& ray,
+      const glm::dmat4& tileTransform,
+      bool cullBackFaces = false) const;
+
+  /**
+   * @brief Gets an estimate of the number of bytes of memory used by the
+   * index.
+   */
+  int64_t getSizeBytes() const noexcept;
+
+private:
+  struct Primitive {
+    int32_t meshId;
+    int32_t primitiveId;
+    glm::dmat4 transform;
+    glm::dmat4 inverseTransform;
+    CesiumGeometry::TriangleBvh bvh;
+  };
+
+  std::vector<Primitive> _primitives;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -31,6 +31,10 @@ namespace Cesium3DTilesSelection {
  * * A {@link CesiumGeometry::UpsampledQuadtreeNode}: This tile doesn't
  *   have any content, but content for it can be created by subdividing
  *   the parent tile's content.
+ *
+ * Tile IDs can be compared and used as keys of unordered containers. The
+ * hash of an implicit or upsampled ID is computed in constant time from its
+ * packed coordinates.
  */
 typedef std::variant<
     std::string,
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The priority group in which a tile is loaded.
+ *
+ * All tiles in a higher priority group are given a chance to load before any
+ * tiles in a lower priority group.
+ */
+enum class TileLoadPriorityGroup {
+  /**
+   * @brief Low priority tiles that aren't needed right now, but
+   * are being preloaded for the future.
+   */
+  Preload = 0,
+
+  /**
+   * @brief Medium priority tiles that are needed to render the current view
+   * the appropriate level-of-detail.
+   */
+  Normal = 1,
+
+  /**
+   * @brief High priority tiles that are causing extra detail to be rendered
+   * in the scene, potentially creating a performance problem and aliasing
+   * artifacts.
+   */
+  Urgent = 2
+};
+
+/**
+ * @brief The priority of a tile load, which orders the loads of all of the
+ * tilesets that share a {@link TileLoadScheduler}.
+ */
+struct CESIUM3DTILESSELECTION_API TileLoadPriority {
+  /**
+   * @brief The priority group of the load.
+   */
+  TileLoadPriorityGroup group;
+
+  /**
+   * @brief The priority of the load within its priority group.
+   *
+   * Loads with a _lower_ value for this property load sooner! Tilesets
+   * compute it from the distance of the tile to the camera and its angle away
+   * from the view direction, so it can be compared between tilesets that are
+   * viewed from the same camera.
+   */
+  double priority;
+
+  /**
+   * @brief Returns true if this load should start before the other one.
+   */
+  bool operator<(const TileLoadPriority& rhs) const noexcept {
+    if (this->group == rhs.group)
+      return this->priority < rhs.priority;
+    else
+      return this->group > rhs.group;
+  }
+};
+
+/**
+ * @brief Shares one tile load concurrency and memory budget between several
+ * {@link Tileset} instances, and starts the most important loads of all of
+ * them first.
+ *
+ * Share one instance through the {@link TilesetExternals} of the tilesets in a
+ * scene. Each time a tileset updates its view, it reports the priorities of
+ * the tiles it wants to load, and is allowed to start those that rank among
+ * the highest priority loads of all the tilesets that fit in the free load
+ * slots. Each tileset's own
+ * {@link TilesetOptions::maximumSimultaneousTileLoads} and
+ * {@link TilesetOptions::maximumCachedBytes} still apply, too.
+ *
+ * While the tilesets together use more than {@link getMaximumCachedBytes},
+ * only {@link TileLoadPriorityGroup::Urgent} loads are started, because they
+ * let detail that is rendered in their place be unloaded.
+ *
+ * This class is not thread safe. It must only be used from the thread that
+ * calls {@link Tileset::updateView}.
+ */
+class CESIUM3DTILESSELECTION_API TileLoadScheduler final {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param maximumSimultaneousTileLoads The maximum number of tile loads of
+   * all the tilesets together that may be in flight at once.
+   * @param maximumCachedBytes The number of bytes of tile data that all the
+   * tilesets together may use before only urgent loads are started.
+   */
+  explicit TileLoadScheduler(
+      uint32_t maximumSimultaneousTileLoads = 20,
+      int64_t maximumCachedBytes = 512 * 1024 * 1024) noexcept;
+
+  /**
+   * @brief Gets the maximum number of tile loads of all the tilesets together
+   * that may be in flight at once.
+   */
+  uint32_t getMaximumSimultaneousTileLoads() const noexcept {
+    return this->_maximumSimultaneousTileLoads;
+  }
+
+  /**
+   * @brief Sets the maximum number of tile loads of all the tilesets together
+   * that may be in flight at once.
+   */
+  void setMaximumSimultaneousTileLoads(uint32_t value) noexcept {
+    this->_maximumSimultaneousTileLoads = value;
+  }
+
+  /**
+   * @brief Gets the number of bytes of tile data that all the tilesets
+   * together may use before only urgent loads are started.
+   */
+  int64_t getMaximumCachedBytes() const noexcept {
+    return this->_maximumCachedBytes;
+  }
+
+  /**
+   * @brief Sets the number of bytes of tile data that all the tilesets
+   * together may use before only urgent loads are started.
+   */
+  void setMaximumCachedBytes(int64_t value) noexcept {
+    this->_maximumCachedBytes = value;
+  }
+
+  /**
+   * @brief Gets the number of tile loads that the tilesets last reported to be
+   * in flight.
+   */
+  uint32_t getNumberOfTilesLoading() const noexcept;
+
+  /**
+   * @brief Gets the number of bytes of tile data that the tilesets last
+   * reported to use.
+   */
+  int64_t getTotalDataBytes() const noexcept;
+
+  /**
+   * @brief Returns true if a low priority load, such as a prefetch, may start
+   * now: there is a free load slot, and the tilesets are within the memory
+   * budget.
+   */
+  bool canStartLowPriorityLoad() const noexcept;
+
+  /**
+   * @brief Adds a tileset to the scheduler.
+   *
+   * This is called by the {@link Tileset} constructor.
+   *
+   * @return The ID with which the tileset identifies itself to the other
+   * methods.
+   */
+  uint64_t addTileset();
+
+  /**
+   * @brief Removes a tileset from the scheduler.
+   *
+   * This is called by the {@link Tileset} destructor.
+   */
+  void removeTileset(uint64_t tilesetID) noexcept;
+
+  /**
+   * @brief Reports the loads that a tileset wants to start, and returns how
+   * many of them it may start now.
+   *
+   * The tileset must start its loads in priority order, and report the
+   * number of loads it has in flight with {@link notifyTilesLoading} once it
+   * has started them.
+   *
+   * @param tilesetID The ID returned by {@link addTileset}.
+   * @param priorities The priorities of the loads the tileset wants to start,
+   * in any order.
+   * @param tilesLoading The number of loads the tileset has in flight.
+   * @param dataBytes The number of bytes of tile data the tileset uses.
+   * @return The number of loads the tileset may start, beginning with the one
+   * with the highest priority.
+   */
+  size_t requestLoadSlots(
+      uint64_t tilesetID,
+      const std::vector<TileLoadPriority>& priorities,
+      uint32_t tilesLoading,
+      int64_t dataBytes);
+
+  /**
+   * @brief Reports the number of loads that a tileset has in flight.
+   *
+   * The loads it started since {@link requestLoadSlots} are taken to be its
+   * highest priority ones, and no longer compete with the loads of the other
+   * tilesets.
+   */
+  void notifyTilesLoading(uint64_t tilesetID, uint32_t tilesLoading) noexcept;
+
+private:
+  struct TilesetState {
+    uint64_t id;
+    uint32_t tilesLoading;
+    int64_t dataBytes;
+    uint64_t lastRequest;
+    std::vector<TileLoadPriority> priorities;
+  };
+
+  TilesetState* findTileset(uint64_t tilesetID) noexcept;
+
+  uint32_t _maximumSimultaneousTileLoads;
+  int64_t _maximumCachedBytes;
+  uint64_t _nextTilesetID;
+  uint64_t _requestCount;
+  std::vector<TilesetState> _tilesets;
+
+  // Holds the priorities of all the tilesets while ranking them, to avoid
+  // allocating them on the heap for every request.
+  std::vector<TileLoadPriority> _rankedPriorities;
+};
+
+} // namespace Cesium3DTilesSelection
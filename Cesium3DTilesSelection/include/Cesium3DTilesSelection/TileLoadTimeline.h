@@ -0,0 +1,302 @@
+#pragma once
+
+#include "Library.h"
+
+#include <CesiumAsync/TelemetryAssetAccessor.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief An event in the loading of a tile, recorded in a
+ * {@link TileLoadTimeline}.
+ */
+enum class TileLoadEvent : uint8_t {
+  /**
+   * @brief The tile was first added to the worker thread load queue of its
+   * tileset.
+   */
+  Queued,
+
+  /**
+   * @brief The tile entered {@link TileLoadState::ContentLoading}, which is
+   * when its load started.
+   */
+  ContentLoading,
+
+  /**
+   * @brief The loader of the tile started its first request for the content.
+   */
+  RequestStarted,
+
+  /**
+   * @brief The last request of the loader for the content completed.
+   *
+   * The requests may have been answered by a cache of the asset accessor.
+   */
+  RequestFinished,
+
+  /**
+   * @brief The processed content of the tile was found in the
+   * {@link ProcessedContentCache}, so it was neither requested nor processed.
+   */
+  ProcessedContentCacheHit,
+
+  /**
+   * @brief The loader of the tile finished parsing the content.
+   */
+  ContentParsed,
+
+  /**
+   * @brief Processing the glTF of the tile started in a decode thread. This
+   * resolves the external buffers and images of the glTF and runs the
+   * processing selected by the {@link TilesetContentOptions}.
+   */
+  DecodeStarted,
+
+  /**
+   * @brief {@link IPrepareRendererResources::prepareInLoadThread} was called.
+   */
+  PrepareInLoadThreadStarted,
+
+  /**
+   * @brief {@link IPrepareRendererResources::prepareInLoadThread} completed.
+   */
+  PrepareInLoadThreadFinished,
+
+  /**
+   * @brief The tile entered {@link TileLoadState::ContentLoaded}, back in the
+   * main thread.
+   */
+  ContentLoaded,
+
+  /**
+   * @brief The main thread started preparing the renderer resources of the
+   * tile, with {@link IPrepareRendererResources::prepareInMainThread} or one
+   * of its variants.
+   */
+  PrepareInMainThreadStarted,
+
+  /**
+   * @brief The tile entered {@link TileLoadState::Done}.
+   */
+  Done,
+
+  /**
+   * @brief The tile entered {@link TileLoadState::Failed} or
+   * {@link TileLoadState::FailedTemporarily}.
+   */
+  Failed,
+
+  /**
+   * @brief The tile entered {@link TileLoadState::Unloading}.
+   */
+  Unloading,
+
+  /**
+   * @brief The tile entered {@link TileLoadState::Unloaded} after it was
+   * loaded.
+   */
+  Unloaded
+};
+
+/**
+ * @brief A part of the loading of a tile, between two
+ * {@link TileLoadEvent}s.
+ */
+enum class TileLoadPhase : uint8_t {
+  /**
+   * @brief From {@link TileLoadEvent::Queued} to
+   * {@link TileLoadEvent::ContentLoading}: waiting in the worker thread load
+   * queue.
+   */
+  WorkerThreadQueue,
+
+  /**
+   * @brief From {@link TileLoadEvent::RequestStarted} to
+   * {@link TileLoadEvent::RequestFinished}: waiting for the network or the
+   * cache of the asset accessor.
+   */
+  Request,
+
+  /**
+   * @brief From {@link TileLoadEvent::ContentLoading} to
+   * {@link TileLoadEvent::ProcessedContentCacheHit}: reading the content back
+   * from the processed content cache.
+   */
+  ProcessedContentCacheRead,
+
+  /**
+   * @brief From {@link TileLoadEvent::RequestFinished} to
+   * {@link TileLoadEvent::ContentParsed}: parsing the content in the loader.
+   */
+  Parse,
+
+  /**
+   * @brief From {@link TileLoadEvent::ContentParsed} to
+   * {@link TileLoadEvent::DecodeStarted}: waiting for a decode thread.
+   */
+  DecodeQueue,
+
+  /**
+   * @brief From {@link TileLoadEvent::DecodeStarted} to
+   * {@link TileLoadEvent::PrepareInLoadThreadStarted}: processing the glTF.
+   */
+  Decode,
+
+  /**
+   * @brief From {@link TileLoadEvent::PrepareInLoadThreadStarted} to
+   * {@link TileLoadEvent::PrepareInLoadThreadFinished}.
+   */
+  PrepareInLoadThread,
+
+  /**
+   * @brief From {@link TileLoadEvent::ContentLoaded} to
+   * {@link TileLoadEvent::PrepareInMainThreadStarted}: waiting in the main
+   * thread load queue.
+   */
+  MainThreadQueue,
+
+  /**
+   * @brief From {@link TileLoadEvent::PrepareInMainThreadStarted} to
+   * {@link TileLoadEvent::Done}, including the frames in which the renderer
+   * prepared the tile incrementally.
+   */
+  PrepareInMainThread,
+
+  /**
+   * @brief From {@link TileLoadEvent::Queued} to {@link TileLoadEvent::Done}.
+   */
+  Total
+};
+
+/**
+ * @brief The times at which the events in the latest load of a tile happened.
+ *
+ * A tile only has a timeline when
+ * {@link TilesetOptions::enableTileLoadTimelines} is true; see
+ * {@link Tile::getLoadTimeline}. The timeline is cleared when the tile is
+ * queued for loading again after it was unloaded or failed temporarily.
+ */
+class CESIUM3DTILESSELECTION_API TileLoadTimeline {
+public:
+  /**
+   * @brief The clock of the times.
+   */
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief The number of {@link TileLoadEvent}s.
+   */
+  static constexpr size_t EventCount = size_t(TileLoadEvent::Unloaded) + 1;
+
+  /**
+   * @brief The number of {@link TileLoadPhase}s.
+   */
+  static constexpr size_t PhaseCount = size_t(TileLoadPhase::Total) + 1;
+
+  /**
+   * @brief Gets the time at which an event happened, or `std::nullopt` if it
+   * did not happen in this load.
+   *
+   * If an event happened more than once, this is its latest time, except for
+   * {@link TileLoadEvent::Queued} and {@link TileLoadEvent::RequestStarted},
+   * which keep their first time.
+   */
+  std::optional<Clock::time_point>
+  getTime(TileLoadEvent event) const noexcept;
+
+  /**
+   * @brief Gets the duration of a phase, in seconds, or `std::nullopt` if
+   * either of its events did not happen in this load.
+   */
+  std::optional<double> getDuration(TileLoadPhase phase) const noexcept;
+
+  /**
+   * @brief Records that an event happened.
+   *
+   * @param event The event.
+   * @param time The time at which it happened.
+   */
+  void record(
+      TileLoadEvent event,
+      Clock::time_point time = Clock::now()) noexcept;
+
+  /**
+   * @brief Records that an event happened, unless it already has.
+   *
+   * @param event The event.
+   * @param time The time at which it happened.
+   */
+  void recordFirst(
+      TileLoadEvent event,
+      Clock::time_point time = Clock::now()) noexcept;
+
+  /**
+   * @brief Records the events of another timeline that happened in it.
+   *
+   * Events that happened in both timelines take their time from the other
+   * timeline.
+   */
+  void merge(const TileLoadTimeline& other) noexcept;
+
+  /**
+   * @brief Forgets all events.
+   */
+  void clear() noexcept;
+
+private:
+  // A default-constructed time point means that the event did not happen.
+  std::array<Clock::time_point, EventCount> _times{};
+};
+
+/**
+ * @brief Histograms of the duration of each {@link TileLoadPhase} of the tile
+ * loads of a tileset.
+ *
+ * See {@link Tileset::getTileLoadHistograms}.
+ */
+struct CESIUM3DTILESSELECTION_API TileLoadHistograms {
+  /**
+   * @brief The histogram of each phase, indexed by {@link TileLoadPhase}.
+   *
+   * Each load is only added to the histograms of the phases that it went
+   * through. For example, content read back from the processed content cache
+   * has no {@link TileLoadPhase::Request}.
+   */
+  std::array<CesiumAsync::LatencyHistogram, TileLoadTimeline::PhaseCount>
+      phases{};
+
+  /**
+   * @brief The number of loads that reached {@link TileLoadState::Done}.
+   */
+  int64_t doneCount = 0;
+
+  /**
+   * @brief The number of loads that reached {@link TileLoadState::Failed} or
+   * {@link TileLoadState::FailedTemporarily}.
+   */
+  int64_t failedCount = 0;
+
+  /**
+   * @brief Gets the histogram of a phase.
+   */
+  const CesiumAsync::LatencyHistogram&
+  getHistogram(TileLoadPhase phase) const noexcept {
+    return this->phases[size_t(phase)];
+  }
+
+  /**
+   * @brief Adds the phases of a load that is done or failed.
+   *
+   * @param timeline The timeline of the load.
+   */
+  void add(const TileLoadTimeline& timeline) noexcept;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -4,7 +4,7 @@
 #include "Tile.h"
 
 #include <cstdint>
-#include <unordered_map>
+#include <limits>
 #include <vector>
 
 /**
@@ -66,16 +66,17 @@ protected:
    * is back in the pool.
    */
   virtual void reset(const Tile* pTile) = 0;
-
-private:
-  bool _usedLastFrame = false;
-  TileOcclusionRendererProxy* _pNext = nullptr;
 };
 
 /**
  * @brief A pool of {@link TileOcclusionRendererProxy} objects. Allows quick
  * remapping of tiles to occlusion renderer proxies so new proxies do not have
  * to be created for each new tile requesting occlusion results.
+ *
+ * Each tile keeps the handle of the proxy mapped to it, so fetching the proxy
+ * of a tile does not need a lookup. The mapped proxies are kept in the order
+ * in which they were last used, so pruning only visits the proxies that are
+ * returned to the free list.
  */
 class CESIUM3DTILESSELECTION_API TileOcclusionRendererProxyPool {
 public:
@@ -112,9 +113,9 @@ public:
 
   /**
    * @brief Prunes the occlusion proxy mappings and removes any mappings that
-   * were unused the last frame. Any mapping corresponding to a tile that was
-   * not visited will have been unused. Occlusion proxies from removed mappings
-   * will be returned to the free list.
+   * were unused since the last prune. Any mapping corresponding to a tile
+   * that was not visited will have been unused. Occlusion proxies from removed
+   * mappings will be returned to the free list.
    */
   void pruneOcclusionProxyMappings();
 
@@ -134,13 +135,30 @@ protected:
   virtual void destroyProxy(TileOcclusionRendererProxy* pProxy) = 0;
 
 private:
-  // Singly linked list representing the free proxies in the pool
-  TileOcclusionRendererProxy* _pFreeProxiesHead;
-  int32_t _currentSize;
+  // A proxy of the pool and the tile it is mapped to, if any. The mapped
+  // slots form a doubly linked list from the least to the most recently used,
+  // and the free slots form a singly linked list through next.
+  struct Slot {
+    TileOcclusionRendererProxy* pProxy;
+    const Tile* pTile;
+    uint32_t lastUsedPrune;
+    uint32_t previous;
+    uint32_t next;
+  };
+
+  static constexpr uint32_t InvalidSlot = std::numeric_limits<uint32_t>::max();
+
+  void unlinkUsedSlot(uint32_t index) noexcept;
+  void linkUsedSlot(uint32_t index) noexcept;
+
+  std::vector<Slot> _slots;
+  uint32_t _freeSlotsHead;
+  uint32_t _usedSlotsHead;
+  uint32_t _usedSlotsTail;
+  // The number of times the mappings were pruned. A slot that was used since
+  // the last prune has this as its lastUsedPrune.
+  uint32_t _pruneCount;
   int32_t _maxSize;
-  // The currently used proxies in the pool
-  std::unordered_map<const Tile*, TileOcclusionRendererProxy*>
-      _tileToOcclusionProxyMappings;
 };
 
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Library.h"
+#include "TileID.h"
+
+#include <CesiumGeospatial/GlobeRectangle.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Options for {@link Tileset::querySelection}.
+ *
+ * A visible tile is refined to its children while its screen-space error, as
+ * seen from any of the frustums, is greater than
+ * {@link maximumScreenSpaceError}, and its depth is less than
+ * {@link maximumLevel}.
+ */
+struct CESIUM3DTILESSELECTION_API TileSelectionQueryOptions {
+  /**
+   * @brief The screen-space error, in pixels, that the selected tiles must
+   * meet.
+   */
+  double maximumScreenSpaceError = 16.0;
+
+  /**
+   * @brief A rectangle that the selected tiles must overlap, or
+   * `std::nullopt` to select the tiles anywhere in the frustums.
+   */
+  std::optional<CesiumGeospatial::GlobeRectangle> region;
+
+  /**
+   * @brief The deepest level of the tile hierarchy to select, where the root
+   * tile is at level 0, or `std::nullopt` to only stop at the screen-space
+   * error.
+   */
+  std::optional<uint32_t> maximumLevel;
+
+  /**
+   * @brief The maximum number of subtree and external tileset loads in flight
+   * at once.
+   *
+   * These are in addition to the loads of
+   * {@link TilesetOptions::maximumSimultaneousTileLoads}.
+   */
+  uint32_t maximumSimultaneousLoads = 32;
+};
+
+/**
+ * @brief A tile selected by {@link Tileset::querySelection}.
+ */
+struct CESIUM3DTILESSELECTION_API TileSelectionQueryTile {
+  /**
+   * @brief The ID of the tile.
+   */
+  TileID tileID;
+
+  /**
+   * @brief The URL of the content of the tile, or `std::nullopt` if the tile
+   * has no content, or if its loader can't tell the URL without loading it.
+   */
+  std::optional<std::string> contentUrl;
+
+  /**
+   * @brief The geometric error of the tile.
+   */
+  double geometricError = 0.0;
+
+  /**
+   * @brief The depth of the tile in the tile hierarchy, where the root tile is
+   * at level 0.
+   */
+  uint32_t level = 0;
+};
+
+/**
+ * @brief The result of {@link Tileset::querySelection}.
+ */
+struct CESIUM3DTILESSELECTION_API TileSelectionQueryResult {
+  /**
+   * @brief The tiles that would be rendered to meet the screen-space error.
+   *
+   * For tiles that are refined by adding their children, the parent tiles are
+   * included too. Tiles that are known to have no content are not included.
+   */
+  std::vector<TileSelectionQueryTile> tiles;
+
+  /**
+   * @brief The number of tiles that were visited.
+   */
+  uint32_t tilesVisited = 0;
+};
+
+} // namespace Cesium3DTilesSelection
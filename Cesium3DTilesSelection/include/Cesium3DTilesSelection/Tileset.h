@@ -1,28 +1,46 @@
 #pragma once
 
+#include "ITileExcluder.h"
 #include "Library.h"
 #include "RasterOverlayCollection.h"
+#include "RegionPrecache.h"
+#include "SampleHeightResult.h"
 #include "Tile.h"
+#include "TileFeatureIndex.h"
+#include "TileGeometryIndex.h"
+#include "TileSelectionQuery.h"
 #include "TilesetContentLoader.h"
 #include "TilesetExternals.h"
 #include "TilesetLoadFailureDetails.h"
+#include "TilesetMemoryUsage.h"
 #include "TilesetOptions.h"
 #include "ViewState.h"
 #include "ViewUpdateResult.h"
 
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumGeometry/Ray.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
 #include <CesiumUtility/IntrusivePointer.h>
 
+#include <gsl/span>
 #include <rapidjson/fwd.h>
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
+class HeightSamplingJob;
+class RegionPrecacheJob;
+class TileSelectionQueryJob;
 class TilesetContentManager;
 class TilesetMetadata;
+class TileSelectionDataTable;
 
 /**
  * @brief A <a
@@ -184,12 +202,69 @@ public:
    * @param frustums The {@link ViewState}s that the view should be updated for
    * @param deltaTime The amount of time that has passed since the last call to
    * updateView, in seconds.
+   * @param predictedFrustums The {@link ViewState}s that are expected to be
+   * needed in the near future, for example because the camera follows a known
+   * path. Tiles that these views need are loaded with a lower priority than
+   * those needed by `frustums`, within the budget of
+   * {@link TilesetOptions::maximumSimultaneousPrefetchLoads}. They do not
+   * affect which tiles are rendered.
    * @returns The set of tiles to render in the updated view. This value is only
    * valid until the next call to `updateView` or until the tileset is
    * destroyed, whichever comes first.
    */
-  const ViewUpdateResult&
-  updateView(const std::vector<ViewState>& frustums, float deltaTime = 0.0f);
+  const ViewUpdateResult& updateView(
+      const std::vector<ViewState>& frustums,
+      float deltaTime = 0.0f,
+      const std::vector<ViewState>& predictedFrustums = {});
+
+  /**
+   * @brief Adds a view session, which selects tiles for its views
+   * independently of {@link updateView} and of the other view sessions.
+   *
+   * All of the sessions select from the same tiles, so content that several of
+   * them need is only loaded once, and stays loaded until none of them may be
+   * showing it anymore. Each session has its own tile selection states, load
+   * queues and priorities, and {@link ViewUpdateResult}. The fade percentages
+   * of {@link TilesetOptions::enableLodTransitionPeriod} are stored with the
+   * tile content, so the sessions share them.
+   *
+   * @return The ID of the session, to pass to {@link updateViewSession} and
+   * {@link removeViewSession}.
+   */
+  uint64_t addViewSession();
+
+  /**
+   * @brief Removes a view session added with {@link addViewSession}, so that
+   * the tiles only it needed may be unloaded.
+   *
+   * @param sessionID The ID returned by {@link addViewSession}.
+   */
+  void removeViewSession(uint64_t sessionID) noexcept;
+
+  /**
+   * @brief Updates the views of a view session, returning the set of tiles to
+   * render in them.
+   *
+   * This is the equivalent of {@link updateView} for a session added with
+   * {@link addViewSession}. It loads and unloads tiles as well, so all of the
+   * tileset's sessions must be updated regularly.
+   *
+   * @param sessionID The ID returned by {@link addViewSession}.
+   * @param frustums The {@link ViewState}s that the session's views should be
+   * updated for.
+   * @param deltaTime The amount of time that has passed since the last update
+   * of this session, in seconds.
+   * @param predictedFrustums The {@link ViewState}s that the session is
+   * expected to need in the near future. See {@link updateView}.
+   * @returns The set of tiles to render in the session's views. This value is
+   * only valid until the next update of this session, until the session is
+   * removed, or until the tileset is destroyed, whichever comes first.
+   */
+  const ViewUpdateResult& updateViewSession(
+      uint64_t sessionID,
+      const std::vector<ViewState>& frustums,
+      float deltaTime = 0.0f,
+      const std::vector<ViewState>& predictedFrustums = {});
 
   /**
    * @brief Gets the total number of tiles that are currently loaded.
@@ -209,12 +284,221 @@ public:
    */
   void forEachLoadedTile(const std::function<void(Tile& tile)>& callback);
 
+  /**
+   * @brief Invokes a function for each tile that is currently loaded, without
+   * wrapping it in a `std::function`.
+   *
+   * The function may unload the tile it is given, but no other tiles.
+   *
+   * @param callback The function to invoke, which takes a `Tile&`.
+   */
+  template <typename Callback> void forEachLoadedTile(Callback&& callback) {
+    Tile* pCurrent = this->_loadedTiles.head();
+    while (pCurrent) {
+      Tile* pNext = this->_loadedTiles.next(pCurrent);
+      callback(*pCurrent);
+      pCurrent = pNext;
+    }
+  }
+
+  /**
+   * @brief Invokes a function for each tile that is currently loaded, without
+   * wrapping it in a `std::function`.
+   *
+   * @param callback The function to invoke, which takes a `const Tile&`.
+   */
+  template <typename Callback>
+  void forEachLoadedTile(Callback&& callback) const {
+    for (const Tile* pTile = this->_loadedTiles.head(); pTile;
+         pTile = this->_loadedTiles.next(*pTile)) {
+      callback(*pTile);
+    }
+  }
+
+  /**
+   * @brief Invokes a function for each tile that is currently loaded, with
+   * the tiles split into tasks that run in worker threads and in the calling
+   * thread at once.
+   *
+   * This returns once the function has been invoked for every tile. Since the
+   * tiles are visited concurrently, the function must only read the tiles, or
+   * modify them in ways that are thread-safe, such as updating renderer
+   * resources that are owned by a single tile. It must not load or unload
+   * tiles, or otherwise change the tileset. If the function throws, the
+   * exception is rethrown here once all of the tasks are done.
+   *
+   * @param callback The function to invoke, which takes a `Tile&`.
+   * @param minimumTilesPerTask The smallest number of tiles that one task
+   * visits, so that the cost of starting the task is spread over enough
+   * tiles. If there are no more tiles than this, they are all visited in the
+   * calling thread.
+   */
+  template <typename Callback>
+  void forEachLoadedTileInParallel(
+      Callback&& callback,
+      size_t minimumTilesPerTask = 256) {
+    this->_forEachLoadedTileRangeInParallel(
+        [&callback](gsl::span<Tile* const> tiles) {
+          for (Tile* pTile : tiles) {
+            callback(*pTile);
+          }
+        },
+        minimumTilesPerTask);
+  }
+
+  /**
+   * @brief Finds the features of the loaded tiles whose string property has a
+   * value.
+   *
+   * Only the tiles whose {@link TileFeatureIndex} indexes the property are
+   * searched, so the property must be one of the
+   * {@link TilesetContentOptions::featureIndexProperties}. The tiles are valid
+   * until the next call to `updateView`.
+   *
+   * @param propertyId The ID of the property.
+   * @param value The value of the property.
+   * @return The features, in no particular order.
+   */
+  std::vector<LoadedTileFeature>
+  findLoadedFeatures(const std::string& propertyId, const std::string& value);
+
+  /**
+   * @brief Finds the features of the loaded tiles whose integer property has a
+   * value.
+   *
+   * @copydetails findLoadedFeatures(const std::string&, const std::string&)
+   */
+  std::vector<LoadedTileFeature>
+  findLoadedFeatures(const std::string& propertyId, int64_t value);
+
+  /**
+   * @brief Finds the closest intersection of a ray with the content of the
+   * loaded tiles.
+   *
+   * The tiles are traversed from the root, skipping those whose bounding
+   * volume the ray misses, and the triangles of the content of each tile are
+   * tested with its {@link TileGeometryIndex}, so
+   * {@link TilesetContentOptions::buildGeometryIndex} must be set. Where the
+   * ray intersects the loaded content of the children of a tile that they
+   * replace, the tile's own content is not used, so the intersection is with
+   * the most detailed content that is loaded. The tile is valid until the next
+   * call to `updateView`.
+   *
+   * @param ray The ray, in the coordinates of the tileset, which are usually
+   * ECEF.
+   * @param cullBackFaces Whether to ignore triangles hit from the back.
+   * @return The closest intersection, or `std::nullopt` if the ray does not
+   * intersect the content of any loaded tile.
+   */
+  std::optional<LoadedTileIntersection> intersectLoadedTiles(
+      const CesiumGeometry::Ray& ray,
+      bool cullBackFaces = false);
+
+  /**
+   * @brief Finds the closest intersections of many rays with the content of
+   * the loaded tiles.
+   *
+   * This finds the same intersections as calling
+   * {@link intersectLoadedTiles(const CesiumGeometry::Ray&, bool)} for each
+   * ray, but traverses the tiles only once for all of them.
+   *
+   * @param rays The rays, in the coordinates of the tileset.
+   * @param cullBackFaces Whether to ignore triangles hit from the back.
+   * @return The closest intersection of each ray, in the order of the rays.
+   */
+  std::vector<std::optional<LoadedTileIntersection>> intersectLoadedTiles(
+      const gsl::span<const CesiumGeometry::Ray>& rays,
+      bool cullBackFaces = false);
+
+  /**
+   * @brief Samples the heights of the most detailed content of the tileset at
+   * the longitudes and latitudes of many positions.
+   *
+   * A vertical ray is cast down through each position, and the tiles that it
+   * intersects are loaded with a high priority through the load queues of
+   * {@link updateView}, down to the leaves of the tileset. The height of each
+   * position is then that of the closest intersection of its ray with the
+   * content of the loaded tiles, found in the same way as
+   * {@link intersectLoadedTiles}.
+   * Tiles whose {@link TileGeometryIndex} was not built as they were loaded,
+   * because {@link TilesetContentOptions::buildGeometryIndex} is not set, are
+   * indexed when they are sampled.
+   *
+   * The work is done in {@link updateView}, so it must keep being called
+   * until the returned future resolves. An application that is not rendering
+   * the tileset can call it with no frustums. The tiles are kept from being
+   * unloaded until the heights are sampled.
+   *
+   * @param positions The positions to sample. Their heights are ignored.
+   * @return A future that resolves to the sampled heights once all of the
+   * tiles have loaded, or rejects if the tileset is destroyed first.
+   */
+  CesiumAsync::Future<SampleHeightResult> sampleHeights(
+      const gsl::span<const CesiumGeospatial::Cartographic>& positions);
+
   /**
    * @brief Gets the total number of bytes of tile and raster overlay data that
    * are currently loaded.
    */
   int64_t getTotalDataBytes() const noexcept;
 
+  /**
+   * @brief Gets the total number of bytes of GPU memory used by the renderer
+   * resources of the tiles and raster overlay tiles that are currently loaded,
+   * as reported by the {@link IPrepareRendererResources}.
+   */
+  int64_t getTotalGpuBytes() const noexcept;
+
+  /**
+   * @brief Gets histograms of the time that the tile loads of this tileset
+   * spent in each stage, for the loads that were done or failed since the
+   * last call to {@link resetTileLoadHistograms}.
+   *
+   * Loads are only recorded while
+   * {@link TilesetOptions::enableTileLoadTimelines} is true. The timeline of
+   * a single tile is available from {@link Tile::getLoadTimeline}.
+   */
+  const TileLoadHistograms& getTileLoadHistograms() const noexcept;
+
+  /**
+   * @brief Forgets the loads in {@link getTileLoadHistograms}.
+   */
+  void resetTileLoadHistograms() noexcept;
+
+  /**
+   * @brief Computes the bytes of CPU memory used by this tileset, by what
+   * they are used for.
+   *
+   * Unlike {@link getTotalDataBytes}, this includes the memory that the
+   * loaders use to know which tiles exist, and the raster overlay source
+   * images cached by the raster overlay tile providers. It walks the glTFs
+   * of all of the loaded tiles, so it is meant to be called occasionally,
+   * such as to check memory budgets or to find leaks, rather than every
+   * frame.
+   */
+  TilesetMemoryUsage getMemoryUsage() const;
+
+  /**
+   * @brief Frees as much CPU memory as possible right away, such as in
+   * response to a memory warning from the operating system.
+   *
+   * The tiles that are not rendered or fading out are unloaded, without a
+   * time limit, until {@link getTotalDataBytes} is at most `targetBytes`.
+   * Then everything else that can be loaded again when it is needed is
+   * released: the subtrees of implicit tilesets that no loaded tile depends
+   * on, the raster overlay source images cached by the raster overlay tile
+   * providers, and the glTFs in the
+   * {@link TilesetContentOptions::pDecodedContentCache}, which may be shared
+   * with other tilesets.
+   *
+   * This does not change {@link TilesetOptions::maximumCachedBytes}, so the
+   * cache may grow again in later calls to {@link updateView}.
+   *
+   * @param targetBytes The number of bytes of tile content to keep at most.
+   * @return The number of bytes freed.
+   */
+  int64_t trimMemory(int64_t targetBytes);
+
   /**
    * @brief Gets the {@link TilesetMetadata} associated with the main or
    * external tileset.json that contains a given tile. If the metadata is not
@@ -258,7 +542,94 @@ public:
    */
   CesiumAsync::Future<const TilesetMetadata*> loadMetadata();
 
+  /**
+   * @brief Loads the tiles that cover a rectangle at a given level of detail
+   * into the cache of the asset accessor, for example a
+   * {@link CesiumAsync::CachingAssetAccessor}, so that they are available
+   * later without a network connection.
+   *
+   * Starting at the root tile, every tile that overlaps the rectangle is
+   * loaded, and refined to its children as described in
+   * {@link RegionPrecacheOptions}. This includes the tiles of external
+   * tilesets and implicit tilesets, and the raster overlay tiles that are
+   * mapped to the loaded tiles. No renderer resources are created for the
+   * tiles, which are unloaded again as soon as their content has been
+   * fetched.
+   *
+   * The work is done in {@link updateView}, so it must keep being called
+   * until the returned future resolves. An application that is not rendering
+   * the tileset can call it with no frustums.
+   *
+   * Raster overlays whose tile provider is still being created when the tiles
+   * are loaded are not cached.
+   *
+   * @param rectangle The rectangle to cache.
+   * @param options The level of detail to cache, and how to report progress.
+   * @return A future that resolves to the final progress once every tile has
+   * been visited, or rejects if the tileset is destroyed first.
+   */
+  CesiumAsync::Future<RegionPrecacheProgress> precacheRegion(
+      const CesiumGeospatial::GlobeRectangle& rectangle,
+      const RegionPrecacheOptions& options = {});
+
+  /**
+   * @brief Finds the tiles that would be selected to meet a screen-space
+   * error from a set of views, without loading their content.
+   *
+   * Starting at the root tile, every tile that is visible in any of the
+   * frustums is refined to its children as described in
+   * {@link TileSelectionQueryOptions}, using only the tiles' bounding volumes
+   * and geometric errors. To create the children, only external tilesets and
+   * the subtrees of implicit tilesets are loaded, so that the availability of
+   * implicit tiles is known. No tile content is loaded and no renderer
+   * resources are created, which makes this useful to plan what to download,
+   * for example. Unlike {@link updateView}, tiles are not culled by fog or
+   * occlusion, and the result doesn't depend on which tiles are loaded.
+   *
+   * The work is done in {@link updateView}, so it must keep being called
+   * until the returned future resolves. An application that is not rendering
+   * the tileset can call it with no frustums.
+   *
+   * @param frustums The views to select the tiles for.
+   * @param options The level of detail to select, and where.
+   * @return A future that resolves to the selected tiles once every visible
+   * tile has been visited, or rejects if the tileset is destroyed first.
+   */
+  CesiumAsync::Future<TileSelectionQueryResult> querySelection(
+      const std::vector<ViewState>& frustums,
+      const TileSelectionQueryOptions& options = {});
+
 private:
+  struct TileLoadTask {
+    /**
+     * @brief The tile to be loaded.
+     */
+    Tile* pTile;
+
+    /**
+     * @brief The priority group (low / medium / high) in which to load this
+     * tile.
+     *
+     * All tiles in a higher priority group are given a chance to load before
+     * any tiles in a lower priority group.
+     */
+    TileLoadPriorityGroup group;
+
+    /**
+     * @brief The priority of this tile within its priority group.
+     *
+     * Tiles with a _lower_ value for this property load sooner!
+     */
+    double priority;
+
+    bool operator<(const TileLoadTask& rhs) const noexcept {
+      if (this->group == rhs.group)
+        return this->priority < rhs.priority;
+      else
+        return this->group > rhs.group;
+    }
+  };
+
   /**
    * @brief The result of traversing one branch of the tile hierarchy.
    *
@@ -319,31 +690,128 @@ private:
   struct FrameState {
     const std::vector<ViewState>& frustums;
     std::vector<double> fogDensities;
+    std::vector<double> dynamicScreenSpaceErrorDensities;
     int32_t lastFrameNumber;
     int32_t currentFrameNumber;
+    TileSelectionDataTable* pSelectionData;
+    double maximumScreenSpaceError;
+  };
+
+  /**
+   * @brief Mutable information that is accumulated while traversing (a part
+   * of) the tile hierarchy.
+   *
+   * The top-level traversal uses an instance that refers to the tileset's own
+   * result, load queues, and scratch buffers. When the traversal is split into
+   * parallel work units (see {@link TilesetOptions::enableParallelTraversal}),
+   * each unit gets its own instance, which is merged into the parent one once
+   * all units have completed.
+   */
+  struct PlaceholderAncestor {
+    double screenSpaceError;
+    uint32_t depth;
+  };
+
+  /**
+   * @brief The exclusion of a tile by the {@link TilesetOptions::excluders},
+   * which is determined along with its siblings before it is visited.
+   */
+  struct PendingExclusion {
+    /**
+     * @brief Whether any of the excluders excluded the tile.
+     */
+    bool excluded;
+
+    /**
+     * @brief The excluders that are no longer asked about the tile's subtree,
+     * because they reported it or the subtree of an ancestor as included.
+     *
+     * Bit `i` stands for the excluder at index `i`. Excluders after the 64th
+     * are always asked.
+     */
+    uint64_t settledExcluders;
+
+    bool isSettled(size_t excluderIndex) const noexcept;
+    void apply(size_t excluderIndex, TileExclusion exclusion) noexcept;
+  };
+
+  /**
+   * @brief Scratch buffers for testing the children of tiles with the
+   * excluders, so that they only allocate when growing bigger.
+   */
+  struct ExclusionBuffers {
+    std::vector<CesiumGeometry::BoundingSphere> childBoundingSpheres;
+    std::vector<TileExclusion> childResults;
+
+    /**
+     * @brief The exclusions of the children of the tiles being visited, from
+     * the root down. The children of a tile are pushed before they are
+     * visited and popped after.
+     */
+    std::vector<PendingExclusion> childExclusions;
+  };
+
+  struct TraversalState {
+    ViewUpdateResult& result;
+    std::vector<TileLoadTask>& workerThreadLoadQueue;
+    std::vector<TileLoadTask>& mainThreadLoadQueue;
+    std::vector<double>& distances;
+    std::vector<const TileOcclusionRendererProxy*>& childOcclusionProxies;
+    ExclusionBuffers& exclusionBuffers;
+
+    /**
+     * @brief The tiles visited by a parallel work unit, in traversal order.
+     *
+     * Updating tile content and the list of loaded tiles is not thread-safe,
+     * so work units record the tiles they visit here, and the main thread
+     * processes them after the units are merged. This is `nullptr` for the
+     * main-thread traversal, which processes visited tiles immediately.
+     */
+    std::vector<Tile*>* pVisitedTiles;
+
+    /**
+     * @brief The nearest ancestor of the tiles being visited that was loaded
+     * as a placeholder, when skipping levels of detail (see
+     * {@link TilesetOptions::enableSkipLevelOfDetail}).
+     */
+    std::optional<PlaceholderAncestor> placeholderAncestor;
+
+    /**
+     * @brief The exclusion of the tile that is visited next, and, while its
+     * descendants are visited, of that tile.
+     */
+    PendingExclusion exclusion;
   };
 
+  struct ParallelTraversalUnit;
+
   TraversalDetails _renderLeaf(
       const FrameState& frameState,
       Tile& tile,
+      uint32_t selectionIndex,
       double tilePriority,
-      ViewUpdateResult& result);
+      TraversalState& state);
   TraversalDetails _renderInnerTile(
       const FrameState& frameState,
       Tile& tile,
-      ViewUpdateResult& result);
+      uint32_t selectionIndex,
+      TraversalState& state);
   bool _kickDescendantsAndRenderTile(
       const FrameState& frameState,
       Tile& tile,
-      ViewUpdateResult& result,
+      uint32_t selectionIndex,
+      TraversalState& state,
       TraversalDetails& traversalDetails,
       size_t firstRenderedDescendantIndex,
       size_t workerThreadLoadQueueIndex,
       size_t mainThreadLoadQueueIndex,
       bool queuedForLoad,
+      bool isPlaceholder,
       double tilePriority);
-  TileOcclusionState
-  _checkOcclusion(const Tile& tile, const FrameState& frameState);
+  TileOcclusionState _checkOcclusion(
+      const Tile& tile,
+      const FrameState& frameState,
+      TraversalState& state);
 
   TraversalDetails _visitTile(
       const FrameState& frameState,
@@ -351,8 +819,17 @@ private:
       bool meetsSse,
       bool ancestorMeetsSse,
       Tile& tile,
+      uint32_t selectionIndex,
       double tilePriority,
-      ViewUpdateResult& result);
+      double screenSpaceError,
+      TraversalState& state);
+  bool _isLevelOfDetailPlaceholder(
+      const FrameState& frameState,
+      const Tile& tile,
+      uint32_t selectionIndex,
+      uint32_t depth,
+      double screenSpaceError,
+      const TraversalState& state) const noexcept;
 
   struct CullResult {
     // whether we should visit this tile
@@ -364,6 +841,7 @@ private:
   // TODO: abstract these into a composable culling interface.
   void _frustumCull(
       const Tile& tile,
+      uint32_t selectionIndex,
       const FrameState& frameState,
       bool cullWithChildrenBounds,
       CullResult& cullResult);
@@ -371,10 +849,13 @@ private:
       const FrameState& frameState,
       const std::vector<double>& distances,
       CullResult& cullResult);
+  double _computeScreenSpaceError(
+      const FrameState& frameState,
+      double geometricError,
+      const std::vector<double>& distances) const noexcept;
   bool _meetsSse(
-      const std::vector<ViewState>& frustums,
-      const Tile& tile,
-      const std::vector<double>& distances,
+      const FrameState& frameState,
+      double screenSpaceError,
       bool culled) const noexcept;
 
   TraversalDetails _visitTileIfNeeded(
@@ -382,13 +863,33 @@ private:
       uint32_t depth,
       bool ancestorMeetsSse,
       Tile& tile,
-      ViewUpdateResult& result);
+      uint32_t selectionIndex,
+      TraversalState& state);
   TraversalDetails _visitVisibleChildrenNearToFar(
       const FrameState& frameState,
       uint32_t depth,
       bool ancestorMeetsSse,
       Tile& tile,
-      ViewUpdateResult& result);
+      uint32_t selectionIndex,
+      TraversalState& state);
+  TraversalDetails _visitChildrenInParallel(
+      const FrameState& frameState,
+      uint32_t depth,
+      bool ancestorMeetsSse,
+      Tile& tile,
+      uint32_t selectionIndex,
+      TraversalState& state);
+
+  PendingExclusion _classifyTileForExclusion(const Tile& tile) const noexcept;
+
+  void _forEachLoadedTileRangeInParallel(
+      const std::function<void(gsl::span<Tile* const>)>& callback,
+      size_t minimumTilesPerTask);
+  void _classifyChildrenForExclusion(
+      const FrameState& frameState,
+      const Tile& tile,
+      uint32_t selectionIndex,
+      TraversalState& state) const;
 
   /**
    * @brief When called on an additive-refined tile, queues it for load and adds
@@ -397,7 +898,8 @@ private:
    * For replacement-refined tiles, this method does nothing and returns false.
    *
    * @param tile The tile to potentially load and render.
-   * @param result The current view update result.
+   * @param refine The refinement of the tile.
+   * @param state The current traversal state.
    * @param tilePriority The load priority of this tile.
    * priority.
    * @param queuedForLoad True if this tile has already been queued for loading.
@@ -407,14 +909,37 @@ private:
    */
   bool _loadAndRenderAdditiveRefinedTile(
       Tile& tile,
-      ViewUpdateResult& result,
+      TileRefine refine,
+      TraversalState& state,
       double tilePriority,
       bool queuedForLoad);
 
+  void _visitPredictedTile(
+      const std::vector<ViewState>& predictedFrustums,
+      Tile& tile);
   void _processWorkerThreadLoadQueue();
+  size_t _requestLoadSlots(bool atLoadLimit);
+  void _notifyTilesLoading() noexcept;
   void _processMainThreadLoadQueue();
+  void _processPrefetchLoadQueue();
+  void _fetchChildrenAhead(const FrameState& frameState);
+  void _trackTileLoad(Tile& tile);
+  void _cancelUnneededTileLoads();
+
+  const ViewUpdateResult& _updateView(
+      const std::vector<ViewState>& frustums,
+      float deltaTime,
+      const std::vector<ViewState>& predictedFrustums);
+  void _startViewSessionUpdate() noexcept;
+  void _finishViewSessionUpdate(int32_t previousFrameNumber);
+  bool _isHeldByViewSession(const Tile* pTile) const noexcept;
 
+  void _finishViewUpdateTimings(ViewUpdateTimings* pTimings) noexcept;
+  bool _isOverCacheBudget() const noexcept;
+  bool _isOverGpuBudget() const noexcept;
   void _unloadCachedTiles(double timeBudget) noexcept;
+  void _unloadLeastRecentlyUsedTiles(double timeBudget) noexcept;
+  void _unloadCachedTilesByPolicy(double timeBudget) noexcept;
   void _markTileVisited(Tile& tile) noexcept;
 
   void _updateLodTransitions(
@@ -422,6 +947,28 @@ private:
       float deltaTime,
       ViewUpdateResult& result) const noexcept;
 
+  void _updateRenderListChanges(ViewUpdateResult& result);
+  void _sortTilesToRenderFrontToBack(
+      const FrameState& frameState,
+      ViewUpdateResult& result);
+
+  void _updateMaximumScreenSpaceError(float deltaTime) noexcept;
+  bool
+  _canReuseLastTraversal(const std::vector<ViewState>& frustums) const noexcept;
+  void _recordTraversalInputs(const std::vector<ViewState>& frustums);
+  void _updateLastTraversalCredits(const ViewUpdateResult& result);
+  void _addCreditsToFrame();
+  void _updateRegionPrecacheJobs();
+  void _updateSelectionQueryJobs();
+  void _updateHeightSamplingJobs();
+  void _addHeightSamplingLoads(TraversalState& traversalState);
+
+  struct RasterOverlayLoadState {
+    const CesiumRasterOverlays::RasterOverlayTileProvider* pTileProvider;
+    uint32_t tilesLoading;
+    int64_t tileDataBytes;
+  };
+
   TilesetExternals _externals;
   CesiumAsync::AsyncSystem _asyncSystem;
 
@@ -430,60 +977,61 @@ private:
   int32_t _previousFrameNumber;
   ViewUpdateResult _updateResult;
 
-  enum class TileLoadPriorityGroup {
-    /**
-     * @brief Low priority tiles that aren't needed right now, but
-     * are being preloaded for the future.
-     */
-    Preload = 0,
+  // The frame number of the latest traversal of any view session. Each
+  // traversal takes the next one, so that a session never mistakes the
+  // selection states that another left in the tiles for its own.
+  int32_t _latestFrameNumber;
 
-    /**
-     * @brief Medium priority tiles that are needed to render the current view
-     * the appropriate level-of-detail.
-     */
-    Normal = 1,
+  // The render list of the last view update, sorted by address, if
+  // TilesetOptions::computeRenderListChanges is enabled.
+  std::vector<Tile*> _lastTilesToRender;
 
-    /**
-     * @brief High priority tiles that are causing extra detail to be rendered
-     * in the scene, potentially creating a performance problem and aliasing
-     * artifacts.
-     */
-    Urgent = 2
-  };
+  // The credits of the tiles selected by the last traversal, and how many
+  // times each is used. A frame that reuses that traversal adds them without
+  // gathering them from the tiles again.
+  std::vector<std::pair<CesiumUtility::Credit, int32_t>> _lastTraversalCredits;
 
-  struct TileLoadTask {
-    /**
-     * @brief The tile to be loaded.
-     */
-    Tile* pTile;
+  // The maximum screen-space error used by the current frame. See
+  // TilesetOptions::adaptiveScreenSpaceError.
+  double _maximumScreenSpaceError;
 
-    /**
-     * @brief The priority group (low / medium / high) in which to load this
-     * tile.
-     *
-     * All tiles in a higher priority group are given a chance to load before
-     * any tiles in a lower priority group.
-     */
-    TileLoadPriorityGroup group;
+  // The total tile content loaded as of the previous call to updateView. See
+  // ViewUpdateTimings::bytesLoaded.
+  int64_t _previousTotalDataLoaded;
 
-    /**
-     * @brief The priority of this tile within its priority group.
-     *
-     * Tiles with a _lower_ value for this property load sooner!
-     */
-    double priority;
+  // The ID of this tileset in TilesetExternals::pTileLoadScheduler, if any.
+  uint64_t _tileLoadSchedulerID;
 
-    bool operator<(const TileLoadTask& rhs) const noexcept {
-      if (this->group == rhs.group)
-        return this->priority < rhs.priority;
-      else
-        return this->group > rhs.group;
-    }
-  };
+  // Whether TilesetExternals::pBandwidthLimiter was exhausted, and has not
+  // refilled its bucket since. See
+  // TilesetOptions::preferLowerDetailWhenBandwidthLimited.
+  bool _bandwidthRecovering;
+
+  // Holds the priorities of the worker thread load queue that are reported to
+  // the tile load scheduler.
+  std::vector<TileLoadPriority> _loadPriorities;
 
   std::vector<TileLoadTask> _mainThreadLoadQueue;
   std::vector<TileLoadTask> _workerThreadLoadQueue;
 
+  // Tiles needed by the predicted views passed to updateView.
+  std::vector<TileLoadTask> _prefetchLoadQueue;
+
+  // Rendered tiles whose children's external tilesets and subtrees may be
+  // fetched. See TilesetOptions::enableSpeculativeFetch.
+  std::vector<TileLoadTask> _childrenFetchQueue;
+
+  struct TileLoadInProgress {
+    Tile* pTile;
+    int32_t lastFrameNeeded;
+  };
+
+  // The loads started by this tileset that may be canceled, and the loading
+  // tiles that the predicted views or height samples needed this frame. See
+  // TilesetOptions::enableTileLoadCancellation.
+  std::vector<TileLoadInProgress> _tileLoadsInProgress;
+  std::vector<const Tile*> _predictedTilesLoading;
+
   Tile::LoadedLinkedList _loadedTiles;
 
   // Holds computed distances, to avoid allocating them on the heap during tile
@@ -494,10 +1042,83 @@ private:
   // scratch variable so that it can allocate only when growing bigger.
   std::vector<const TileOcclusionRendererProxy*> _childOcclusionProxies;
 
+  // Holds the bounding spheres and exclusions of the children of tiles while
+  // they are tested with the excluders.
+  ExclusionBuffers _exclusionBuffers;
+
+  // Holds the loaded tiles while they are visited in parallel, so that they
+  // can be split into tasks.
+  std::vector<Tile*> _loadedTilesForParallelVisit;
+
+  // Guards the occlusion proxy pool while the traversal runs in parallel work
+  // units.
+  std::mutex _occlusionPoolMutex;
+
+  // The inputs of the last full traversal, used to detect when its result can
+  // be reused. See TilesetOptions::enableViewCoherence.
+  std::vector<ViewState> _lastTraversalFrustums;
+  uint64_t _lastTraversalTileStateVersion;
+  double _lastTraversalMaximumScreenSpaceError;
+  std::vector<RasterOverlayLoadState> _lastTraversalOverlayStates;
+
+  // While there are view sessions, the selection states that the last
+  // traversal of the session being updated left in the tiles, sorted by tile.
+  // They are restored before it is updated again, because the other sessions
+  // overwrite them.
+  std::vector<std::pair<Tile*, TileSelectionState>> _viewSessionSelectionStates;
+
+  // The tiles that the session being updated held after its last update,
+  // sorted by address. See _viewSessionTileReferences.
+  std::vector<Tile*> _viewSessionHeldTiles;
+
+  // The state of a view session, which is swapped with the members above
+  // while the session is updated. The state of updateView stays in those
+  // members the rest of the time.
+  struct ViewSession {
+    uint64_t id;
+    int32_t previousFrameNumber;
+    ViewUpdateResult updateResult;
+    std::vector<Tile*> lastTilesToRender;
+    std::vector<std::pair<CesiumUtility::Credit, int32_t>> lastTraversalCredits;
+    double maximumScreenSpaceError;
+    std::vector<TileLoadTask> mainThreadLoadQueue;
+    std::vector<TileLoadTask> workerThreadLoadQueue;
+    std::vector<TileLoadTask> prefetchLoadQueue;
+    std::vector<ViewState> lastTraversalFrustums;
+    uint64_t lastTraversalTileStateVersion;
+    double lastTraversalMaximumScreenSpaceError;
+    std::vector<RasterOverlayLoadState> lastTraversalOverlayStates;
+    std::vector<std::pair<Tile*, TileSelectionState>> selectionStates;
+    std::vector<Tile*> heldTiles;
+
+    void swap(Tileset& tileset) noexcept;
+  };
+
+  std::vector<std::unique_ptr<ViewSession>> _viewSessions;
+  uint64_t _nextViewSessionID;
+
+  // The number of view sessions that hold each tile, because they visited it
+  // in their last traversal or may still be showing it. A held tile is not
+  // unloaded. Empty without view sessions.
+  std::unordered_map<const Tile*, int32_t> _viewSessionTileReferences;
+
+  // The tiles visited by the current traversal while there are view sessions.
+  std::vector<Tile*> _viewSessionVisitedTiles;
+
+  // The calls to precacheRegion that have not completed yet.
+  std::vector<std::shared_ptr<RegionPrecacheJob>> _regionPrecacheJobs;
+
+  // The calls to querySelection that have not completed yet.
+  std::vector<std::shared_ptr<TileSelectionQueryJob>> _selectionQueryJobs;
+
+  // The calls to sampleHeights that have not completed yet.
+  std::vector<std::unique_ptr<HeightSamplingJob>> _heightSamplingJobs;
+
   CesiumUtility::IntrusivePointer<TilesetContentManager>
       _pTilesetContentManager;
 
   void addTileToLoadQueue(
+      TraversalState& state,
       Tile& tile,
       TileLoadPriorityGroup priorityGroup,
       double priority);
@@ -505,6 +1126,7 @@ private:
   static TraversalDetails createTraversalDetailsForSingleTile(
       const FrameState& frameState,
       const Tile& tile,
+      uint32_t selectionIndex,
       const TileSelectionState& lastFrameSelectionState);
 
   Tileset(const Tileset& rhs) = delete;
@@ -4,20 +4,25 @@
 #include "Library.h"
 #include "TileContent.h"
 #include "TileLoadResult.h"
+#include "TilesetMemoryUsage.h"
 #include "TilesetOptions.h"
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/ITaskProcessor.h>
+#include <CesiumAsync/ThreadPool.h>
 #include <CesiumGeometry/Axis.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumRasterOverlays/RasterOverlayDetails.h>
 
 #include <spdlog/logger.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
@@ -37,6 +42,11 @@ struct CESIUM3DTILESSELECTION_API TileLoadInput {
    * @param pLogger The logger that will be used
    * @param requestHeaders The request headers that will be attached to the
    * request.
+   * @param pLoadCanceled A flag that is set once the load is no longer needed,
+   * or nullptr if the load cannot be canceled.
+   * @param decodeThreadPool The thread pool for CPU-heavy decoding, or
+   * `std::nullopt` to decode in worker threads.
+   * @param priority The priority of the load, relative to other tasks.
    */
   TileLoadInput(
       const Tile& tile,
@@ -44,7 +54,10 @@ struct CESIUM3DTILESSELECTION_API TileLoadInput {
       const CesiumAsync::AsyncSystem& asyncSystem,
       const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
       const std::shared_ptr<spdlog::logger>& pLogger,
-      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders);
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+      std::shared_ptr<const std::atomic<bool>> pLoadCanceled = nullptr,
+      std::optional<CesiumAsync::ThreadPool> decodeThreadPool = std::nullopt,
+      CesiumAsync::TaskPriority priority = {});
 
   /**
    * @brief The tile that the {@link TilesetContentLoader} will request the server for the content.
@@ -76,6 +89,35 @@ struct CESIUM3DTILESSELECTION_API TileLoadInput {
    * @brief The request headers that will be attached to the request.
    */
   const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders;
+
+  /**
+   * @brief A flag that is set once the tile is no longer needed, or nullptr if
+   * the load cannot be canceled.
+   *
+   * The flag is set in the main thread, but may be read in any thread. Loaders
+   * should check it before doing expensive work, such as decoding a response,
+   * and return {@link TileLoadResult::createRetryLaterResult} when it is set,
+   * so that the tile can be loaded again once it is needed.
+   */
+  std::shared_ptr<const std::atomic<bool>> pLoadCanceled;
+
+  /**
+   * @brief The thread pool in which loaders should do CPU-heavy work, such as
+   * decoding a response into a glTF, or `std::nullopt` to use worker threads.
+   *
+   * @see TilesetExternals::decodeThreadPool
+   */
+  std::optional<CesiumAsync::ThreadPool> decodeThreadPool;
+
+  /**
+   * @brief The priority of the load, relative to other tasks, derived from the
+   * {@link TileLoadPriorityGroup} and priority of the tile.
+   *
+   * Loaders should pass it along when they start CPU-heavy work in worker
+   * threads, so that the task processor can do the most important work first.
+   * It has no effect on the {@link decodeThreadPool}.
+   */
+  CesiumAsync::TaskPriority priority;
 };
 
 /**
@@ -135,5 +177,76 @@ public:
    * @return The {@link TileChildrenResult} that stores the tile's children
    */
   virtual TileChildrenResult createTileChildren(const Tile& tile) = 0;
+
+  /**
+   * @brief Loads what is needed to create the tile's children, without
+   * loading the tile's content.
+   *
+   * This is called in the main thread for a tile whose children can't be
+   * created yet, when the tile is traversed without loading content, such as
+   * by {@link Tileset::querySelection}. A loader that stores the tile's
+   * children apart from its content, like the subtrees of implicit tilesets,
+   * loads them here, so that {@link createTileChildren} succeeds once the
+   * returned future resolves. The default implementation loads nothing.
+   *
+   * @param input The {@link TileLoadInput} that has the tile info and loading
+   * systems.
+   * @return A future that resolves when the tile's children can be created,
+   * or when it is known that they can't.
+   */
+  virtual CesiumAsync::Future<void>
+  loadTileChildren(const TileLoadInput& input);
+
+  /**
+   * @brief Notifies the loader that the content it loaded for a tile is no
+   * longer loaded, because it has been unloaded, or because the load did not
+   * produce any content.
+   *
+   * This is called in the main thread, and lets a loader release what it
+   * keeps for the tiles with loaded content. The default implementation does
+   * nothing.
+   *
+   * @param tile The tile whose content is no longer loaded.
+   */
+  virtual void notifyTileContentUnloaded(const Tile& tile);
+
+  /**
+   * @brief Adds the bytes that this loader uses apart from the tile content,
+   * such as to know which tiles exist, to a {@link TilesetMemoryUsage}.
+   *
+   * This is called in the main thread. A loader that delegates to other
+   * loaders should add their usage too. The default implementation adds
+   * nothing.
+   *
+   * @param usage The memory usage to add to.
+   */
+  virtual void addMemoryUsage(TilesetMemoryUsage& usage) const;
+
+  /**
+   * @brief Releases the memory that this loader uses apart from the tile
+   * content, as far as it can be recreated when it is needed again.
+   *
+   * This is called in the main thread by {@link Tileset::trimMemory}. A loader
+   * that delegates to other loaders should trim them too. The default
+   * implementation releases nothing.
+   *
+   * @return The number of bytes released.
+   */
+  virtual int64_t trimMemory();
+
+  /**
+   * @brief Gets the URL from which the content of a tile will be loaded, if
+   * it is known before the content is requested.
+   *
+   * The URL identifies the content of the tile in a
+   * {@link ProcessedContentCache}. The default implementation returns
+   * `std::nullopt`, so the content of the tiles of loaders that do not
+   * override it is not cached.
+   *
+   * @param tile The tile.
+   * @return The URL of its content, or `std::nullopt` if it is not known.
+   */
+  virtual std::optional<std::string>
+  getTileContentUrl(const Tile& tile) const;
 };
 } // namespace Cesium3DTilesSelection
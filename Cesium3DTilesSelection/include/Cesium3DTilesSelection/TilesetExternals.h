@@ -1,15 +1,20 @@
 #pragma once
 
 #include "Library.h"
+#include "TileLoadScheduler.h"
 #include "TileOcclusionRendererProxy.h"
 #include "spdlog-cesium.h"
 
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/ThreadPool.h>
 
 #include <memory>
+#include <optional>
 
 namespace CesiumAsync {
+class BandwidthLimiter;
 class IAssetAccessor;
+class ICacheDatabase;
 class ITaskProcessor;
 } // namespace CesiumAsync
 
@@ -69,6 +74,61 @@ public:
    */
   std::shared_ptr<TileOcclusionRendererProxyPool> pTileOcclusionProxyPool =
       nullptr;
+
+  /**
+   * @brief A scheduler that shares one tile load budget between all of the
+   * tilesets that use it, and starts their most important loads first.
+   *
+   * If not specified, each tileset only limits its own loads.
+   */
+  std::shared_ptr<TileLoadScheduler> pTileLoadScheduler = nullptr;
+
+  /**
+   * @brief A limiter that caps the rate at which tiles are downloaded.
+   *
+   * While the limiter is exhausted, the tileset starts no new tile loads, and
+   * it starts no loads for predicted views until the limiter has refilled.
+   * The limiter only learns about the downloaded bytes from a
+   * {@link CesiumAsync::BandwidthLimitingAssetAccessor} that uses it, so
+   * {@link pAssetAccessor} should be, or be a decorator of, such an
+   * accessor; then tiles, implicit tiling subtrees and raster overlay images
+   * are all accounted for. The same limiter may be shared between tilesets,
+   * and given to raster overlays with
+   * {@link CesiumRasterOverlays::RasterOverlayOptions::pBandwidthLimiter}.
+   *
+   * If not specified, the downloads are not limited.
+   */
+  std::shared_ptr<CesiumAsync::BandwidthLimiter> pBandwidthLimiter = nullptr;
+
+  /**
+   * @brief A thread pool for the CPU-heavy stages of tile loading, such as
+   * glTF parsing, Draco and meshopt decompression, KTX2 transcoding, normal
+   * generation, and {@link IPrepareRendererResources::prepareInLoadThread}.
+   *
+   * Its number of threads bounds how many tiles are decoded at once, so that
+   * a burst of heavy tiles does not hold up small, latency-sensitive tasks in
+   * the {@link asyncSystem}'s worker threads, like parsing subtrees or
+   * `layer.json`. Create one with
+   * {@link CesiumAsync::AsyncSystem::createThreadPool}; it may be shared
+   * between tilesets.
+   *
+   * If not specified, these stages run in worker threads.
+   */
+  std::optional<CesiumAsync::ThreadPool> decodeThreadPool = std::nullopt;
+
+  /**
+   * @brief A database in which the Cesium ion asset endpoints of tilesets are
+   * kept until their access tokens expire.
+   *
+   * A tileset whose endpoint is in the database starts loading its root
+   * tileset or layer.json right away, instead of waiting for the endpoint
+   * request. If the cached access token is rejected, the endpoint is
+   * requested again. This may be the same database as that of a
+   * {@link CesiumAsync::CachingAssetAccessor}.
+   *
+   * If not specified, endpoints are only kept in memory.
+   */
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase = nullptr;
 };
 
 } // namespace Cesium3DTilesSelection
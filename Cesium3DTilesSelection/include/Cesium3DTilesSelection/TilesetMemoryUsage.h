@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstdint>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The bytes of CPU memory used by a {@link Tileset}, by what they are
+ * used for.
+ *
+ * This is computed by {@link Tileset::getMemoryUsage}.
+ */
+struct CESIUM3DTILESSELECTION_API TilesetMemoryUsage {
+  /**
+   * @brief The bytes of the glTF buffers of the loaded tile content, other
+   * than those of images and metadata, and of their {@link TileGeometryIndex}.
+   */
+  int64_t geometryBytes = 0;
+
+  /**
+   * @brief The bytes of the decoded images of the loaded tile content.
+   */
+  int64_t textureBytes = 0;
+
+  /**
+   * @brief The bytes of the property tables of the loaded tile content, from
+   * `EXT_structural_metadata`, and of their {@link TileFeatureIndex}.
+   */
+  int64_t metadataBytes = 0;
+
+  /**
+   * @brief The bytes used by the loaders to know which tiles exist, such as
+   * the loaded subtrees of implicit tilesets and the availability of terrain
+   * layers.
+   */
+  int64_t availabilityBytes = 0;
+
+  /**
+   * @brief The bytes of the images of the raster overlay tiles that are
+   * loaded for the tiles of this tileset.
+   */
+  int64_t overlayImageBytes = 0;
+
+  /**
+   * @brief The bytes of the raster overlay source images that are kept in
+   * caches by the raster overlay tile providers, to be combined into overlay
+   * tiles.
+   */
+  int64_t overlayCacheBytes = 0;
+
+  /**
+   * @brief The bytes of the freed image buffers that are kept in
+   * {@link CesiumUtility::PixelBufferPool::getDefault} to be reused.
+   *
+   * The pool is shared by all tilesets, so this is the same for each of them,
+   * and it is not included in {@link getTotalBytes}.
+   */
+  int64_t pooledImageBytes = 0;
+
+  /**
+   * @brief Gets the sum of all of the categories other than
+   * {@link pooledImageBytes}.
+   */
+  int64_t getTotalBytes() const noexcept {
+    return this->geometryBytes + this->textureBytes + this->metadataBytes +
+           this->availabilityBytes + this->overlayImageBytes +
+           this->overlayCacheBytes;
+  }
+};
+
+} // namespace Cesium3DTilesSelection
@@ -4,15 +4,24 @@
 
 #include <CesiumGltf/Ktx2TranscodeTargets.h>
 
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
+namespace CesiumAsync {
+class AdaptiveConcurrencyLimiter;
+}
+
 namespace Cesium3DTilesSelection {
 
+class DecodedContentCache;
 class ITileExcluder;
+class ITileEvictionPolicy;
+class ProcessedContentCache;
 class TilesetLoadFailureDetails;
 
 /**
@@ -45,6 +54,229 @@ struct CESIUM3DTILESSELECTION_API TilesetContentOptions {
    * the ideal target gpu-compressed pixel format to transcode to.
    */
   CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets;
+
+  /**
+   * @brief The names of the vertex attributes that the renderer uses, or
+   * `std::nullopt` to keep all of the attributes of loaded content.
+   *
+   * Other attributes are not decoded, and the data that only they used is
+   * dropped, as described for
+   * {@link CesiumGltfReader::GltfReaderOptions::requiredAttributes}. Point
+   * clouds do not decode their colors or normals unless `COLOR_0` or `NORMAL`
+   * is listed, and quantized-mesh terrain does not request its normals unless
+   * `NORMAL` is listed. `POSITION` is always kept.
+   */
+  std::optional<std::vector<std::string>> requiredAttributes;
+
+  /**
+   * @brief Whether the triangle meshes of loaded content are reordered for
+   * the GPU's vertex cache and vertex fetch, and their 32-bit indices
+   * narrowed to 16 bits where possible, in the worker threads.
+   *
+   * See {@link CesiumGltfReader::GltfReaderOptions::optimizeMeshes}.
+   */
+  bool optimizeMeshes = false;
+
+  /**
+   * @brief Whether the primitives of each mesh of loaded content that share a
+   * material and a vertex layout are merged into one, so that the renderer
+   * issues fewer draw calls.
+   *
+   * Feature ID attributes are renamed as needed so that the features still
+   * resolve to the same metadata. This is done in the worker threads before
+   * raster overlay texture coordinates are computed.
+   *
+   * @see CesiumGltfContent::GltfUtilities::mergePrimitives
+   */
+  bool mergePrimitives = false;
+
+  /**
+   * @brief The maximum number of bytes of implicit tiling subtrees that may be
+   * cached by each implicit tileset.
+   *
+   * When the subtrees take more than this, the least recently used subtrees
+   * are evicted, except those that tiles with loaded content were loaded
+   * from. An evicted subtree is loaded again when it is needed.
+   */
+  int64_t maximumCachedSubtreeBytes = 32 * 1024 * 1024;
+
+  /**
+   * @brief The number of levels of the tiles of a tileset.json that are
+   * created at once, or 0 to create all of them when the tileset.json is
+   * loaded.
+   *
+   * When this is set, the children of the tiles of the deepest level that is
+   * created are kept as their JSON text, which takes much less memory than
+   * the tiles, and are created, with this many levels of their descendants,
+   * when the tile is first visited, as are the tiles of implicit tilesets.
+   * This saves the time and memory of creating the tiles of the parts of a
+   * large tileset that are never visited.
+   */
+  uint32_t tilesetJsonTileLevels = 0;
+
+  /**
+   * @brief Whether to store the positions and normals of loaded glTFs as
+   * integers, with the `KHR_mesh_quantization` extension.
+   *
+   * This roughly halves the vertex memory of quantized-mesh terrain, which is
+   * otherwise expanded to floats, both while the tile is loaded and once it is
+   * uploaded to the GPU. The renderer must support `KHR_mesh_quantization`.
+   * Meshes are quantized after raster overlay texture coordinates and
+   * bounding volumes have been computed from the original positions.
+   *
+   * @see CesiumGltfContent::GltfUtilities::quantizeMeshes
+   */
+  bool quantizeMeshes = false;
+
+  /**
+   * @brief Whether to release the data of the glTF buffers of a tile once
+   * its renderer resources are prepared.
+   *
+   * Set this when the renderer copies the vertex and index data it needs into
+   * its own resources, so that it is not kept twice. Raster overlay
+   * upsampling still needs the data, so it is fetched again, usually from the
+   * cache, when an upsampled child of the tile is loaded. The content of
+   * upsampled tiles cannot be fetched again, so it is never released.
+   *
+   * @see TileRenderContent::isModelDataReleased
+   */
+  bool releaseBufferDataAfterPrepare = false;
+
+  /**
+   * @brief Whether to release the pixel data of the glTF images of a tile once
+   * its renderer resources are prepared.
+   *
+   * Set this when the renderer uploads the images to textures. Like
+   * {@link releaseBufferDataAfterPrepare}, the data is fetched again when an
+   * upsampled child of the tile is loaded.
+   */
+  bool releaseImageDataAfterPrepare = false;
+
+  /**
+   * @brief A cache of the glTFs decoded from tile content, which lets
+   * identical content be decoded only once, even when it is loaded from
+   * different URLs or by different tilesets.
+   *
+   * No cache is used if this is nullptr.
+   */
+  std::shared_ptr<DecodedContentCache> pDecodedContentCache;
+
+  /**
+   * @brief A cache of the glTFs of tiles after they have been decoded and
+   * processed, usually kept in the same database as the responses, which lets
+   * a tile whose content is needed again read it back rather than load and
+   * process it again.
+   *
+   * No cache is used if this is nullptr.
+   */
+  std::shared_ptr<ProcessedContentCache> pProcessedContentCache;
+
+  /**
+   * @brief The IDs of the properties of the `EXT_structural_metadata` property
+   * tables of loaded glTFs to index by their values.
+   *
+   * The index of each tile is built in a worker thread when the tile is
+   * loaded, and lets {@link Tileset::findLoadedFeatures} look up the features
+   * with a value without scanning the property tables. Only string and
+   * integer scalar properties are indexed. No index is built if this is empty.
+   *
+   * @see TileRenderContent::getFeatureIndex
+   */
+  std::vector<std::string> featureIndexProperties;
+
+  /**
+   * @brief The IDs of the properties of the `EXT_structural_metadata` property
+   * tables of loaded glTFs to pack into textures indexed by feature ID, for
+   * styling features on the GPU.
+   *
+   * The values of each property table of a tile are packed in a worker thread
+   * when the tile is loaded, with their offset, scale, and "no data" values
+   * applied, and are available to the renderer when its main thread resources
+   * are prepared. Only scalar, vector, and boolean properties are packed.
+   * Nothing is packed if this is empty.
+   *
+   * @see TileRenderContent::getPackedPropertyTables
+   * @see CesiumGltf::PackedPropertyTable
+   */
+  std::vector<std::string> packedProperties;
+
+  /**
+   * @brief The largest width in texels of the textures of
+   * {@link packedProperties}.
+   */
+  int64_t maximumPackedPropertyTextureWidth = 4096;
+
+  /**
+   * @brief Whether to build an index of the triangles of loaded glTFs, for
+   * finding the intersections of rays with them.
+   *
+   * The index of each tile is built in a worker thread when the tile is
+   * loaded, and lets {@link Tileset::intersectLoadedTiles} test only the
+   * triangles near a ray. It keeps a copy of the vertex positions, so it
+   * takes about as much memory as the positions and indices themselves.
+   *
+   * @see TileRenderContent::getGeometryIndex
+   */
+  bool buildGeometryIndex = false;
+
+  /**
+   * @brief Whether to compute a tight content bounding volume for loaded
+   * glTFs whose tiles do not specify one.
+   *
+   * The volume is an oriented bounding box fitted to the vertex positions
+   * in a worker thread when the tile is loaded. With
+   * {@link TilesetOptions::enableContentBoundingVolumeCulling}, leaf tiles
+   * are then culled against it.
+   *
+   * @see CesiumGeometry::OrientedBoundingBox::fromPositions
+   */
+  bool computeContentBoundingVolumes = false;
+
+  /**
+   * @brief The largest number of instances in each of the clusters into which
+   * the instances of loaded glTFs with `EXT_mesh_gpu_instancing` are
+   * grouped, or zero to not cluster them.
+   *
+   * The clusters are built in a worker thread when the tile is loaded and
+   * stored in the extras of each instanced node, where the renderer can find
+   * them with
+   * {@link CesiumGltfContent::InstanceClusterMetadata::parseFromGltfExtras}
+   * and draw only the instances of the clusters that are visible, rather than
+   * all of the instances of a tile or none of them.
+   *
+   * @see CesiumGltfContent::GltfUtilities::clusterInstances
+   */
+  uint32_t instanceClusterSize = 0;
+
+  /**
+   * @brief Whether to pack the raster overlay images attached to each tile
+   * into a single atlas image.
+   *
+   * When all the raster overlay tiles mapped to a tile with more than one of
+   * them are attached, their images are copied into an atlas with
+   * {@link CesiumRasterOverlays::RasterOverlayUtilities::createAtlas} in the
+   * main thread, and the atlas is passed to
+   * {@link IPrepareRendererResources::attachRasterAtlasInMainThread}, so that
+   * the renderer can draw the tile with one overlay texture. Tiles whose
+   * overlay images are GPU compressed or have different formats are not
+   * packed. This keeps a copy of the overlay images of the packed tiles.
+   */
+  bool packRasterOverlaysIntoAtlas = false;
+
+  /**
+   * @brief Whether only the geometry of loaded content is needed, as for a
+   * tileset that is used for collision or height queries and never rendered.
+   *
+   * When this is set, the images of loaded glTFs are neither fetched nor
+   * decoded, so no textures are transcoded and no mipmaps are generated, as
+   * described for {@link CesiumGltfReader::GltfReaderOptions::loadImages}.
+   * Raster overlays are not mapped to the tiles, so no overlay texture
+   * coordinates are generated, the batch tables of 3D Tiles 1.0 content are
+   * not upgraded to `EXT_structural_metadata`, and quantized-mesh terrain
+   * does not request its water mask. Set {@link requiredAttributes} to an
+   * empty list as well to keep only the positions and indices.
+   */
+  bool geometryOnly = false;
 };
 
 /**
@@ -61,6 +293,63 @@ struct CESIUM3DTILESSELECTION_API FogDensityAtHeight {
   double fogDensity;
 };
 
+/**
+ * @brief Options for adjusting a {@link Tileset}'s screen-space error from
+ * frame to frame so that it stays within a frame time, tile loading, and
+ * memory budget.
+ *
+ * Each frame, the tileset is considered overloaded if the frame took longer
+ * than {@link targetFrameTime}, more than {@link maximumLoadQueueLength} tiles
+ * were waiting to load, or more than {@link TilesetOptions::maximumCachedBytes}
+ * were resident. While overloaded, the screen-space error is multiplied by
+ * {@link adjustmentFactor}, up to {@link maximumScreenSpaceError}. Once all
+ * three measures are below their limit by at least the {@link hysteresis}
+ * fraction, it is divided by the same factor, down to
+ * {@link TilesetOptions::maximumScreenSpaceError}. In between, it is left
+ * unchanged, so that the level of detail does not oscillate.
+ *
+ * @see TilesetOptions::adaptiveScreenSpaceError
+ */
+struct CESIUM3DTILESSELECTION_API AdaptiveScreenSpaceErrorOptions {
+  /**
+   * @brief Whether to adjust the screen-space error. When false,
+   * {@link TilesetOptions::maximumScreenSpaceError} is always used.
+   */
+  bool enabled = false;
+
+  /**
+   * @brief The target frame time, in seconds.
+   *
+   * This is compared with the `deltaTime` passed to
+   * {@link Tileset::updateView}. When `deltaTime` is zero, the frame time is
+   * ignored.
+   */
+  double targetFrameTime = 1.0 / 30.0;
+
+  /**
+   * @brief The number of tiles in the worker thread load queue above which
+   * the tileset is considered overloaded.
+   */
+  int32_t maximumLoadQueueLength = 200;
+
+  /**
+   * @brief The largest screen-space error that the controller may choose.
+   */
+  double maximumScreenSpaceError = 64.0;
+
+  /**
+   * @brief The factor by which the screen-space error is multiplied or
+   * divided in a single frame. Must be greater than 1.0.
+   */
+  double adjustmentFactor = 1.05;
+
+  /**
+   * @brief The fraction by which every measure must be below its limit before
+   * the screen-space error is reduced again.
+   */
+  double hysteresis = 0.2;
+};
+
 /**
  * @brief Additional options for configuring a {@link Tileset}.
  */
@@ -95,9 +384,85 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
   /**
    * @brief The maximum number of subtrees that may simultaneously be in the
    * process of loading.
+   *
+   * This limits the external tilesets and implicit tiling subtrees that are
+   * fetched ahead of time when {@link enableSpeculativeFetch} is true.
    */
   uint32_t maximumSimultaneousSubtreeLoads = 20;
 
+  /**
+   * @brief A limiter that adjusts the number of tiles that may simultaneously
+   * be in the process of loading, in place of
+   * {@link maximumSimultaneousTileLoads}.
+   *
+   * Every tile load that is not canceled tells the limiter how long it took,
+   * from starting the request to the content being ready for the main thread,
+   * how many bytes it loaded, and whether it failed. The limit in effect is
+   * reported in {@link ViewUpdateResult::maximumSimultaneousTileLoads}.
+   *
+   * If not specified, the fixed limit is used.
+   */
+  std::shared_ptr<CesiumAsync::AdaptiveConcurrencyLimiter>
+      pTileLoadConcurrencyLimiter;
+
+  /**
+   * @brief A limiter that adjusts the number of subtrees that may
+   * simultaneously be in the process of loading, in place of
+   * {@link maximumSimultaneousSubtreeLoads}.
+   *
+   * Every fetch of an external tileset or implicit tiling subtree tells the
+   * limiter how long it took. The limit in effect is reported in
+   * {@link ViewUpdateResult::maximumSimultaneousSubtreeLoads}.
+   *
+   * If not specified, the fixed limit is used.
+   */
+  std::shared_ptr<CesiumAsync::AdaptiveConcurrencyLimiter>
+      pSubtreeLoadConcurrencyLimiter;
+
+  /**
+   * @brief Whether to fetch the external tilesets and implicit tiling subtrees
+   * that the children of rendered tiles would need, before those tiles are
+   * refined.
+   *
+   * The children of an external tileset or of the root tile of a subtree can
+   * only be created once the tileset JSON or subtree file has been fetched, so
+   * without this each such level adds a round trip before more detail can
+   * load. When true, after the tile loads of each frame have started, the
+   * children of the rendered tiles whose screen-space error is at least
+   * {@link speculativeFetchScreenSpaceErrorRatio} of the maximum have what
+   * their own children are created from fetched, starting with the tiles
+   * that are closest to being refined, while fewer than
+   * {@link maximumSimultaneousSubtreeLoads} of these fetches are in flight.
+   * Only the tileset JSON or subtree is fetched, not the render content.
+   */
+  bool enableSpeculativeFetch = false;
+
+  /**
+   * @brief The fraction of the maximum screen-space error that a rendered
+   * tile must reach for its children's external tilesets and subtrees to be
+   * fetched. See {@link enableSpeculativeFetch}.
+   *
+   * A value of 0.0 fetches them for the children of all rendered tiles, which
+   * is one level ahead of the current selection.
+   */
+  double speculativeFetchScreenSpaceErrorRatio = 0.5;
+
+  /**
+   * @brief Whether a tileset that is created from a URL is restored from the
+   * root document that an earlier session kept in
+   * {@link TilesetExternals::pCacheDatabase}.
+   *
+   * When true, the tileset.json or layer.json at the URL is kept in the cache
+   * database with the headers of its response. A later tileset with the same
+   * URL is then created from the kept document as soon as it is read from
+   * the database, without waiting for a request, and the document is
+   * requested again in the background with its `ETag` and `Last-Modified`
+   * validators, so that the next tileset is created from the current
+   * document. A document that has not been validated for 30 days is
+   * requested instead. This has no effect without a cache database.
+   */
+  bool restoreTilesetFromCache = false;
+
   /**
    * @brief Indicates whether the ancestors of rendered tiles should be
    * preloaded. Setting this to true optimizes the zoom-out experience and
@@ -114,6 +479,49 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   bool preloadSiblings = true;
 
+  /**
+   * @brief The maximum number of tile loads that may be in flight for a new
+   * tile load to be started for the predicted views passed to
+   * {@link Tileset::updateView}.
+   *
+   * Tiles for the predicted views are only loaded after all tiles needed by
+   * the current views have started loading, and only while fewer than this
+   * many loads of any kind are in flight and the cache is not over
+   * {@link maximumCachedBytes}. So they can occupy at most this many of the
+   * {@link maximumSimultaneousTileLoads} load slots.
+   */
+  uint32_t maximumSimultaneousPrefetchLoads = 4;
+
+  /**
+   * @brief Whether to load less detailed tiles first after the
+   * {@link TilesetExternals::pBandwidthLimiter} was exhausted, until it has
+   * refilled.
+   *
+   * When true, the tiles with the largest geometric error in each priority
+   * group are loaded first while the bandwidth is short, so that the whole
+   * view gets coarse detail before any part of it gets fine detail. When
+   * false, the tiles are always loaded in priority order.
+   */
+  bool preferLowerDetailWhenBandwidthLimited = false;
+
+  /**
+   * @brief Whether to cancel the loads of tiles that are no longer needed.
+   *
+   * When true, a tile that started loading but has not been visited by the
+   * tile selection, nor needed by a predicted view, for
+   * {@link tileLoadCancellationFrameCount} consecutive frames has its load
+   * canceled. The network request itself still completes, but the content is
+   * not decoded or prepared for rendering, and the tile can be loaded again
+   * later.
+   */
+  bool enableTileLoadCancellation = false;
+
+  /**
+   * @brief The number of frames a loading tile may go unneeded before its load
+   * is canceled. See {@link enableTileLoadCancellation}.
+   */
+  uint32_t tileLoadCancellationFrameCount = 10;
+
   /**
    * @brief The number of loading descendant tiles that is considered "too
    * many". If a tile has too many loading descendants, that tile will be loaded
@@ -126,6 +534,62 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   uint32_t loadingDescendantLimit = 20;
 
+  /**
+   * @brief Whether to skip levels of detail when refining.
+   *
+   * When true, a refined tile is only loaded as a placeholder for its
+   * descendants if its screen-space error is greater than
+   * {@link baseScreenSpaceError}, or if it is at least
+   * {@link skipScreenSpaceErrorFactor} times more detailed and more than
+   * {@link skipLevels} levels deeper than the nearest ancestor that was loaded
+   * as a placeholder. Other intermediate levels are skipped, which reduces the
+   * time and bytes needed to reach the desired detail. Until the desired tiles
+   * are ready to render, the nearest renderable placeholder is rendered in
+   * their place, so {@link forbidHoles} is still honored.
+   */
+  bool enableSkipLevelOfDetail = false;
+
+  /**
+   * @brief The screen-space error above which no levels of detail are skipped.
+   * See {@link enableSkipLevelOfDetail}.
+   */
+  double baseScreenSpaceError = 1024.0;
+
+  /**
+   * @brief The factor by which the screen-space error of a tile must be smaller
+   * than that of the nearest placeholder ancestor for the tile to be loaded as
+   * a placeholder too. See {@link enableSkipLevelOfDetail}.
+   */
+  double skipScreenSpaceErrorFactor = 16.0;
+
+  /**
+   * @brief The minimum number of levels to skip between placeholders. See
+   * {@link enableSkipLevelOfDetail}.
+   */
+  uint32_t skipLevels = 1;
+
+  /**
+   * @brief Whether to measure the time spent in each part of
+   * {@link Tileset::updateView} and report it in
+   * {@link ViewUpdateResult::timings}.
+   *
+   * Unlike `CESIUM_TRACE`, this only samples a clock a few times per frame,
+   * so it is cheap enough to leave on in production.
+   */
+  bool enableViewUpdateTimings = false;
+
+  /**
+   * @brief Whether to record when each tile passes through each stage of
+   * loading, from the load queue to the renderer, in its
+   * {@link Tile::getLoadTimeline}, and to add the durations of the stages to
+   * {@link Tileset::getTileLoadHistograms}.
+   *
+   * This is meant for finding out why tiles are slow to appear. It allocates
+   * a timeline for each tile that is loaded, and samples a clock about a
+   * dozen times per tile load.
+   */
+  bool enableTileLoadTimelines = false;
+
   /**
    * @brief Never render a tileset with missing tiles.
    *
@@ -144,6 +608,19 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   bool enableFrustumCulling = true;
 
+  /**
+   * @brief Whether to frustum cull leaf tiles against their content bounding
+   * volume rather than their own bounding volume.
+   *
+   * A leaf tile is only visible if its content is, so a tighter content
+   * bounding volume, such as one computed with
+   * {@link TilesetContentOptions::computeContentBoundingVolumes}, lets more
+   * of them be culled. This only applies to tiles with render content that
+   * can never get children, so the subtrees of external tilesets and implicit
+   * tiles are never culled by a volume that does not enclose them.
+   */
+  bool enableContentBoundingVolumeCulling = false;
+
   /**
    * @brief Enable culling of occluded tiles, as reported by the renderer.
    */
@@ -197,6 +674,20 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   int64_t maximumCachedBytes = 512 * 1024 * 1024;
 
+  /**
+   * @brief The maximum number of bytes of GPU memory that may be used by the
+   * renderer resources of cached tiles and raster overlay tiles.
+   *
+   * GPU memory is reported by
+   * {@link IPrepareRendererResources::getGpuByteSize} and
+   * {@link CesiumRasterOverlays::IPrepareRasterOverlayRendererResources::getRasterGpuByteSize},
+   * and is counted separately from {@link maximumCachedBytes}. While over
+   * this budget, tiles are unloaded just as when over
+   * {@link maximumCachedBytes}, and only urgent tile loads are started. Tiles
+   * that are needed for rendering are never unloaded.
+   */
+  int64_t maximumGpuBytes = std::numeric_limits<int64_t>::max();
+
   /**
    * @brief A table that maps the camera height above the ellipsoid to a fog
    * density. Tiles that are in full fog are culled. The density of the fog
@@ -218,6 +709,44 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
       {203849.3112, 4.2e-6}, {274866.9803, 4.0e-6}, {319916.3149, 3.4e-6},
       {493552.0528, 2.6e-6}, {628733.5874, 2.2e-6}, {1000000.0, 0.0}};
 
+  /**
+   * @brief Whether to reduce the screen-space error of tiles that are far away
+   * from a camera that looks toward the horizon.
+   *
+   * This works like {@link fogDensityTable}, but instead of culling tiles in
+   * the fog, it lowers their screen-space error so that they are refined less.
+   * When the camera is low and looking toward the horizon, this avoids loading
+   * many distant tiles that cover only a few pixels each, at the cost of some
+   * detail in the distance. The screen-space error of a tile is reduced by
+   * `dynamicScreenSpaceErrorFactor * (1.0 - glm::exp(-(distance * distance *
+   * density * density)))`, where the density is
+   * {@link dynamicScreenSpaceErrorDensity} scaled down as the camera looks
+   * more directly down at the ellipsoid and as it rises above the tileset.
+   */
+  bool enableDynamicScreenSpaceError = false;
+
+  /**
+   * @brief The density of the "fog" used by
+   * {@link enableDynamicScreenSpaceError}. Increasing this value reduces the
+   * screen-space error of tiles closer to the camera.
+   */
+  double dynamicScreenSpaceErrorDensity = 2.0e-4;
+
+  /**
+   * @brief The largest amount, in pixels, by which
+   * {@link enableDynamicScreenSpaceError} reduces the screen-space error of a
+   * tile.
+   */
+  double dynamicScreenSpaceErrorFactor = 24.0;
+
+  /**
+   * @brief The fraction of the root tile's height range, measured from its
+   * bottom, above which the effect of {@link enableDynamicScreenSpaceError}
+   * starts to fade out. It fades out completely once the camera is above the
+   * top of the root tile.
+   */
+  double dynamicScreenSpaceErrorHeightFalloff = 0.25;
+
   /**
    * @brief Whether to render tiles directly under the camera, even if they're
    * not in the view frustum.
@@ -236,6 +765,14 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   std::vector<std::shared_ptr<ITileExcluder>> excluders;
 
+  /**
+   * @brief The policy that decides which tiles are unloaded first when the
+   * total size of loaded tiles exceeds {@link maximumCachedBytes}.
+   *
+   * If this is nullptr, the least-recently-used tiles are unloaded first.
+   */
+  std::shared_ptr<ITileEvictionPolicy> evictionPolicy;
+
   /**
    * @brief A callback function that is invoked when a tileset resource fails to
    * load.
@@ -279,6 +816,31 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   bool kickDescendantsWhileFadingIn = true;
 
+  /**
+   * @brief Whether to report the tiles that were added to and removed from the
+   * render list in each view update.
+   *
+   * When this is true, {@link ViewUpdateResult::tilesAddedThisFrame} and
+   * {@link ViewUpdateResult::tilesRemovedThisFrame} are filled in, so that a
+   * renderer can show and hide only the tiles that changed rather than
+   * comparing the complete render lists of consecutive frames.
+   */
+  bool computeRenderListChanges = false;
+
+  /**
+   * @brief Whether to sort the tiles to render from the nearest to the
+   * farthest.
+   *
+   * When this is true, {@link ViewUpdateResult::tilesToRenderThisFrame} is
+   * ordered by the distance from the nearest view to each tile's bounding
+   * volume, and {@link ViewUpdateResult::tilesToRenderThisFrameDistances} and
+   * {@link ViewUpdateResult::tilesToRenderThisFrameScreenSpaceErrors} are
+   * filled in, so that opaque tiles can be drawn front to back without
+   * sorting them again. The traversal already visits children from near to
+   * far, so the list is mostly in order before it is sorted.
+   */
+  bool sortTilesToRenderFrontToBack = false;
+
   /**
    * @brief A soft limit on how long (in milliseconds) to spend on the
    * main-thread part of tile loading each frame (each call to
@@ -287,9 +849,43 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    *
    * Setting this to too low of a value will impede overall tile load progress,
    * creating a discernable load latency.
+   *
+   * The limit is checked between tiles, and passed to
+   * {@link IPrepareRendererResources::prepareInMainThreadIncrementally} so
+   * that a renderer can split the work of a single heavy tile across frames.
    */
   double mainThreadLoadingTimeLimit = 0.0;
 
+  /**
+   * @brief A soft limit on how many bytes the main-thread part of tile loading
+   * may process, for example upload to the GPU, each frame. A value of 0
+   * indicates no limit.
+   *
+   * The bytes are those reported by
+   * {@link IPrepareRendererResources::prepareInMainThreadIncrementally}. As
+   * with {@link mainThreadLoadingTimeLimit}, a renderer can split the work of
+   * a single heavy tile across frames to stay within the limit.
+   */
+  int64_t mainThreadLoadingByteLimit = 0;
+
+  /**
+   * @brief Whether to prepare and free the renderer resources of several
+   * tiles with one call to the {@link IPrepareRendererResources}.
+   *
+   * When this is true, the tiles that finished loading in the load thread are
+   * prepared together, with one call to
+   * {@link IPrepareRendererResources::prepareInMainThreadBatch} per frame,
+   * after the traversal rather than as they are visited. They are then first
+   * rendered in the next frame. The tiles that are unloaded to stay within the
+   * cache limits are freed together with one call to
+   * {@link IPrepareRendererResources::freeBatch}.
+   *
+   * Batched preparation has no effect if {@link mainThreadLoadingTimeLimit} or
+   * {@link mainThreadLoadingByteLimit} is set, because the main-thread work is
+   * then divided between frames one tile at a time.
+   */
+  bool batchRendererResourceCalls = false;
+
   /**
    * @brief A soft limit on how long (in milliseconds) to spend unloading
    * cached tiles each frame (each call to Tileset::updateView). A value of 0.0
@@ -297,6 +893,117 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   double tileCacheUnloadTimeLimit = 0.0;
 
+  /**
+   * @brief A limit on how many tiles get the real raster tiles of an overlay
+   * in place of its placeholders each frame (each call to
+   * Tileset::updateView), or 0 for no limit.
+   *
+   * When an overlay is added, the loaded tiles get placeholders for it, which
+   * are replaced with real raster tiles once its tile provider is created.
+   * With a limit, the tiles that are rendered are mapped first and the rest
+   * in later frames, which spreads out the work of adding an overlay to a
+   * large tileset. In either case, a tile that lacks texture coordinates for
+   * the overlay's projection gets them in a worker thread, and its renderer
+   * resources are then prepared again, without loading it again, unless its
+   * buffers were released after they were prepared.
+   */
+  uint32_t rasterOverlayMappingTileLimit = 0;
+
+  /**
+   * @brief Whether to split the tile selection traversal into work units that
+   * are evaluated in parallel on worker threads.
+   *
+   * When true, the subtrees rooted at depth
+   * {@link TilesetOptions::parallelTraversalDepth} are traversed as separate
+   * work units using the {@link TilesetExternals::asyncSystem}'s worker
+   * threads, and the results are merged on the main thread in traversal order.
+   * This is most beneficial when updating the view for several
+   * {@link ViewState}s at once.
+   *
+   * The content of tiles visited by a work unit is updated, and the tiles are
+   * marked as visited in the list of loaded tiles, on the main thread after
+   * the traversal completes, rather than when each tile is visited. The work
+   * units therefore select tiles from content state that is one frame behind
+   * that of a sequential traversal: newly-loaded tiles deep in the hierarchy
+   * may become renderable one frame later than they would otherwise. All
+   * {@link TilesetOptions::excluders} must be safe to call from multiple
+   * threads at once when this is enabled.
+   */
+  bool enableParallelTraversal = false;
+
+  /**
+   * @brief The depth of the tile hierarchy at which the traversal is split into
+   * parallel work units.
+   *
+   * Only applicable when {@link TilesetOptions::enableParallelTraversal} is
+   * true. Each tile at this depth becomes the root of one work unit. Tiles
+   * closer to the root are always traversed on the main thread.
+   */
+  uint32_t parallelTraversalDepth = 3;
+
+  /**
+   * @brief Whether to maintain a packed side table of the tile properties that
+   * are read during tile selection.
+   *
+   * When true, the bounding volume, geometric error, refinement, selection
+   * state and renderability of each tile are stored contiguously, with the
+   * entries of siblings next to each other, and tile selection reads these
+   * instead of the tiles. This reduces cache misses when traversing tilesets
+   * with very many resident tiles, at the cost of a copy of the bounding volume
+   * and 64 more bytes per tile. This option must be set before the
+   * {@link Tileset} is constructed; changing it afterward has no effect.
+   *
+   * The selection state of a tile that is set with
+   * {@link Tile::setLastSelectionState} outside of tile selection is not seen
+   * by the table.
+   */
+  bool enablePackedSelectionData = false;
+
+  /**
+   * @brief Whether to skip the tile selection traversal on idle frames, in
+   * which the views and the loaded tiles stay the same.
+   *
+   * When true, {@link Tileset::updateView} skips the traversal and returns the
+   * previous render list if every view is within
+   * {@link viewCoherencePositionTolerance} and
+   * {@link viewCoherenceAngleTolerance} of the view used by the last
+   * traversal, its viewport and field of view are unchanged, and no tile or
+   * raster overlay tile has started or finished loading, been unloaded, or
+   * changed its load state since. A reused result reports zero visited tiles
+   * and keeps the frame number of the traversal that produced it.
+   *
+   * This only helps frames in which nothing happens. Any load state change
+   * anywhere in the tileset, even of a tile that is not in view, brings back a
+   * full traversal, rather than revisiting only the subtrees that changed. The
+   * traversal is never skipped while tiles are queued for loading, or
+   * when LOD transitions, tile excluders, or occlusion culling are in use.
+   * Changes to the screen-space error, including those made by
+   * {@link adaptiveScreenSpaceError}, are detected; changes to other options
+   * take effect at the next full traversal.
+   */
+  bool enableViewCoherence = false;
+
+  /**
+   * @brief The distance, in meters, that a view may move from the view of the
+   * last traversal before {@link enableViewCoherence} traverses again.
+   */
+  double viewCoherencePositionTolerance = 0.001;
+
+  /**
+   * @brief The angle, in radians, that a view's direction or up vector may
+   * rotate from the view of the last traversal before
+   * {@link enableViewCoherence} traverses again.
+   */
+  double viewCoherenceAngleTolerance = 1e-6;
+
+  /**
+   * @brief Options for adjusting the screen-space error each frame to stay
+   * within a frame time, tile loading, and memory budget. The screen-space
+   * error that was used is reported in
+   * {@link ViewUpdateResult::maximumScreenSpaceError}.
+   */
+  AdaptiveScreenSpaceErrorOptions adaptiveScreenSpaceError;
+
   /**
    * @brief Options for configuring the parsing of a {@link Tileset}'s content
    * and construction of Gltf models.
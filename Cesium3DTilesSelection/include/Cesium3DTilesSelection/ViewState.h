@@ -10,6 +10,7 @@
 #include <glm/mat3x3.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 #include <vector>
 
@@ -113,6 +114,43 @@ public:
   bool
   isBoundingVolumeVisible(const BoundingVolume& boundingVolume) const noexcept;
 
+  /**
+   * @brief Returns whether the given {@link BoundingVolume} is visible for this
+   * camera, using a sphere that encloses it to skip the exact test where
+   * possible.
+   *
+   * The result is the same as {@link isBoundingVolumeVisible}. The sphere is
+   * tested first, and the bounding volume is only tested when the sphere
+   * crosses a plane of the frustum.
+   *
+   * @param boundingVolume The bounding volume.
+   * @param enclosingSphere A sphere that encloses the bounding volume, such
+   * as one from {@link computeEnclosingSphere}.
+   * @return Whether the bounding volume is visible
+   */
+  bool isBoundingVolumeVisible(
+      const BoundingVolume& boundingVolume,
+      const CesiumGeometry::BoundingSphere& enclosingSphere) const noexcept;
+
+  /**
+   * @brief Determines whether each of a batch of {@link BoundingVolume}s is
+   * visible for this camera.
+   *
+   * This is equivalent to calling {@link isBoundingVolumeVisible} for each
+   * bounding volume. However, spheres, oriented bounding boxes, and bounding
+   * regions are tested against each plane of the frustum together, in a
+   * structure-of-arrays layout that the compiler can vectorize. This is
+   * intended for the children of a tile, which usually have the same type of
+   * bounding volume.
+   *
+   * @param boundingVolumes The bounding volumes to test.
+   * @param visible Receives whether each bounding volume is visible. It must
+   * be the same size as `boundingVolumes`.
+   */
+  void areBoundingVolumesVisible(
+      gsl::span<const BoundingVolume* const> boundingVolumes,
+      gsl::span<bool> visible) const noexcept;
+
   /**
    * @brief Computes the squared distance to the given {@link BoundingVolume}.
    *
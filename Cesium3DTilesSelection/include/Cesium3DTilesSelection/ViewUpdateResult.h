@@ -3,12 +3,66 @@
 #include "Library.h"
 
 #include <cstdint>
-#include <unordered_set>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
 class Tile;
 
+/**
+ * @brief The time spent in each part of a call to {@link Tileset::updateView},
+ * in seconds.
+ *
+ * These are only measured when {@link TilesetOptions::enableViewUpdateTimings}
+ * is true, and are zero otherwise.
+ */
+struct CESIUM3DTILESSELECTION_API ViewUpdateTimings {
+  /**
+   * @brief The total time spent in {@link Tileset::updateView}.
+   */
+  double totalTime = 0.0;
+
+  /**
+   * @brief The time spent traversing the tile hierarchy to select tiles,
+   * including updating the content of the visited tiles.
+   */
+  double traversalTime = 0.0;
+
+  /**
+   * @brief The time spent starting tile loads from the worker thread and
+   * prefetch load queues.
+   */
+  double workerThreadLoadQueueTime = 0.0;
+
+  /**
+   * @brief The time spent finishing tile loads from the main thread load
+   * queue.
+   */
+  double mainThreadLoadQueueTime = 0.0;
+
+  /**
+   * @brief The time spent unloading cached tiles.
+   */
+  double unloadCachedTilesTime = 0.0;
+
+  /**
+   * @brief The time spent updating level-of-detail transitions.
+   */
+  double lodTransitionTime = 0.0;
+
+  /**
+   * @brief The time spent mapping raster overlay tiles to geometry tiles.
+   *
+   * This is part of the traversal and load queue times.
+   */
+  double rasterOverlayMappingTime = 0.0;
+
+  /**
+   * @brief The number of bytes of tile content that finished loading since the
+   * previous call to {@link Tileset::updateView}.
+   */
+  int64_t bytesLoaded = 0;
+};
+
 /**
  * @brief Reports the results of {@link Tileset::updateView}.
  *
@@ -30,14 +84,65 @@ public:
    */
   std::vector<Tile*> tilesToRenderThisFrame;
 
+  /**
+   * @brief The distance from the nearest view to the bounding volume of each
+   * tile in {@link tilesToRenderThisFrame}, at the same index.
+   *
+   * This is only filled in when
+   * {@link TilesetOptions::sortTilesToRenderFrontToBack} is true, in which case
+   * it is in ascending order.
+   */
+  std::vector<double> tilesToRenderThisFrameDistances;
+
+  /**
+   * @brief The largest screen-space error of each tile in
+   * {@link tilesToRenderThisFrame} in any of the views, at the same index.
+   *
+   * This is only filled in when
+   * {@link TilesetOptions::sortTilesToRenderFrontToBack} is true.
+   */
+  std::vector<double> tilesToRenderThisFrameScreenSpaceErrors;
+
+  /**
+   * @brief The tiles on {@link tilesToRenderThisFrame} that were not on it in
+   * the previous view update, sorted by address.
+   *
+   * This is only filled in when
+   * {@link TilesetOptions::computeRenderListChanges} is true.
+   */
+  std::vector<Tile*> tilesAddedThisFrame;
+
+  /**
+   * @brief The tiles that were on {@link tilesToRenderThisFrame} in the
+   * previous view update, but are not on it anymore, sorted by address.
+   *
+   * They may still be fading out, see {@link tilesFadingOut}. This is only
+   * filled in when {@link TilesetOptions::computeRenderListChanges} is true.
+   */
+  std::vector<Tile*> tilesRemovedThisFrame;
+
   /**
    * @brief Tiles on this list are no longer selected for rendering.
    *
    * If {@link TilesetOptions::enableLodTransitionPeriod} is true they may be
    * fading out. If a tile's {TileRenderContent::lodTransitionPercentage} is 0
    * or lod transitions are disabled, the tile should be hidden right away.
+   *
+   * Each tile is on this list once, and the list is sorted by address so that
+   * the tileset can find a tile in it without hashing.
+   */
+  std::vector<Tile*> tilesFadingOut;
+
+  /**
+   * @brief The tiles whose LOD transition fade percentage was changed by this
+   * update.
+   *
+   * A client that keeps the fade of each tile in its own renderer state only
+   * needs to update these tiles, rather than every tile on
+   * {@link tilesToRenderThisFrame} and {@link tilesFadingOut}. A tile that
+   * stops fading out and starts to fade in again may be listed twice.
    */
-  std::unordered_set<Tile*> tilesFadingOut;
+  std::vector<Tile*> tilesWithChangedLodTransition;
 
   /**
    * @brief The number of tiles in the worker thread load queue.
@@ -49,6 +154,57 @@ public:
    */
   int32_t mainThreadTileLoadQueueLength = 0;
 
+  /**
+   * @brief The number of tiles in the worker thread load queue that were not
+   * loaded because the {@link TilesetExternals::pBandwidthLimiter} was
+   * exhausted.
+   */
+  int32_t tileLoadsThrottledByBandwidth = 0;
+
+  /**
+   * @brief The number of bytes that were downloaded beyond the
+   * {@link TilesetExternals::pBandwidthLimiter}'s budget, which must be
+   * repaid before new tile loads start, or zero when it was not exhausted.
+   */
+  int64_t bandwidthThrottledBytes = 0;
+
+  /**
+   * @brief The number of external tilesets and implicit tiling subtrees that
+   * are being fetched ahead of time. See
+   * {@link TilesetOptions::enableSpeculativeFetch}.
+   */
+  int32_t speculativeFetchesInProgress = 0;
+
+  /**
+   * @brief The number of tiles that were allowed to be in the process of
+   * loading at once. This is
+   * {@link TilesetOptions::maximumSimultaneousTileLoads} unless a
+   * {@link TilesetOptions::pTileLoadConcurrencyLimiter} adjusts it.
+   */
+  int32_t maximumSimultaneousTileLoads = 0;
+
+  /**
+   * @brief The number of subtrees that were allowed to be in the process of
+   * loading at once. This is
+   * {@link TilesetOptions::maximumSimultaneousSubtreeLoads} unless a
+   * {@link TilesetOptions::pSubtreeLoadConcurrencyLimiter} adjusts it.
+   */
+  int32_t maximumSimultaneousSubtreeLoads = 0;
+
+  /**
+   * @brief The maximum screen-space error that was used to select tiles.
+   *
+   * This is {@link TilesetOptions::maximumScreenSpaceError} unless
+   * {@link TilesetOptions::adaptiveScreenSpaceError} is enabled.
+   */
+  double maximumScreenSpaceError = 0.0;
+
+  /**
+   * @brief A breakdown of the time spent in {@link Tileset::updateView}, if
+   * {@link TilesetOptions::enableViewUpdateTimings} is true.
+   */
+  ViewUpdateTimings timings;
+
   //! @cond Doxygen_Suppress
   uint32_t tilesVisited = 0;
   uint32_t culledTilesVisited = 0;
@@ -3,6 +3,11 @@
 #include "CesiumGeospatial/Cartographic.h"
 #include "CesiumGeospatial/GlobeTransforms.h"
 
+#include <CesiumGeometry/IntersectionTests.h>
+
+#include <glm/common.hpp>
+#include <glm/exponential.hpp>
+#include <glm/geometric.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 
 using namespace CesiumGeometry;
@@ -72,6 +77,59 @@ glm::dvec3 getBoundingVolumeCenter(const BoundingVolume& boundingVolume) {
   return std::visit(Operation{}, boundingVolume);
 }
 
+namespace {
+BoundingSphere
+computeBoxEnclosingSphere(const OrientedBoundingBox& boundingBox) {
+  // The half axes aren't necessarily orthogonal, so the farthest corner may be
+  // any of them. Each of these has its opposite corner at the same distance.
+  const glm::dmat3& halfAxes = boundingBox.getHalfAxes();
+  const double radius = glm::max(
+      glm::max(
+          glm::length(halfAxes[0] + halfAxes[1] + halfAxes[2]),
+          glm::length(halfAxes[0] + halfAxes[1] - halfAxes[2])),
+      glm::max(
+          glm::length(halfAxes[0] - halfAxes[1] + halfAxes[2]),
+          glm::length(-halfAxes[0] + halfAxes[1] + halfAxes[2])));
+  return BoundingSphere(boundingBox.getCenter(), radius);
+}
+} // namespace
+
+BoundingSphere computeEnclosingSphere(const BoundingVolume& boundingVolume) {
+  struct Operation {
+    BoundingSphere operator()(const OrientedBoundingBox& boundingBox) {
+      return computeBoxEnclosingSphere(boundingBox);
+    }
+
+    BoundingSphere operator()(const BoundingRegion& boundingRegion) {
+      return computeBoxEnclosingSphere(boundingRegion.getBoundingBox());
+    }
+
+    BoundingSphere operator()(const BoundingSphere& boundingSphere) noexcept {
+      return boundingSphere;
+    }
+
+    BoundingSphere operator()(
+        const BoundingRegionWithLooseFittingHeights& boundingRegion) {
+      return computeBoxEnclosingSphere(
+          boundingRegion.getBoundingRegion().getBoundingBox());
+    }
+
+    BoundingSphere operator()(const S2CellBoundingVolume& s2Cell) {
+      // The cell is tested against planes by its vertices, so a sphere that
+      // encloses them is conservative.
+      const glm::dvec3 center = s2Cell.getCenter();
+      double radiusSquared = 0.0;
+      for (const glm::dvec3& vertex : s2Cell.getVertices()) {
+        const glm::dvec3 offset = vertex - center;
+        radiusSquared = glm::max(radiusSquared, glm::dot(offset, offset));
+      }
+      return BoundingSphere(center, glm::sqrt(radiusSquared));
+    }
+  };
+
+  return std::visit(Operation{}, boundingVolume);
+}
+
 std::optional<GlobeRectangle>
 estimateGlobeRectangle(const BoundingVolume& boundingVolume) {
   struct Operation {
@@ -229,4 +287,43 @@ getOrientedBoundingBoxFromBoundingVolume(const BoundingVolume& boundingVolume) {
   return std::visit(Operation(), boundingVolume);
 }
 
+std::optional<double> intersectRayWithBoundingVolume(
+    const Ray& ray,
+    const BoundingVolume& boundingVolume) {
+  struct Operation {
+    const Ray& ray;
+
+    std::optional<double> operator()(const BoundingSphere& sphere) const {
+      return IntersectionTests::raySphereParametric(ray, sphere);
+    }
+
+    std::optional<double>
+    operator()(const CesiumGeometry::OrientedBoundingBox& box) const {
+      return IntersectionTests::rayOBBParametric(ray, box);
+    }
+
+    std::optional<double>
+    operator()(const CesiumGeospatial::BoundingRegion& region) const {
+      return IntersectionTests::rayOBBParametric(ray, region.getBoundingBox());
+    }
+
+    std::optional<double> operator()(
+        const CesiumGeospatial::BoundingRegionWithLooseFittingHeights& region)
+        const {
+      return IntersectionTests::rayOBBParametric(
+          ray,
+          region.getBoundingRegion().getBoundingBox());
+    }
+
+    std::optional<double>
+    operator()(const CesiumGeospatial::S2CellBoundingVolume& s2) const {
+      return IntersectionTests::rayOBBParametric(
+          ray,
+          s2.computeBoundingRegion().getBoundingBox());
+    }
+  };
+
+  return std::visit(Operation{ray}, boundingVolume);
+}
+
 } // namespace Cesium3DTilesSelection
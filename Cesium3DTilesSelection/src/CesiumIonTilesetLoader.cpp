@@ -3,13 +3,18 @@
 #include "LayerJsonTerrainLoader.h"
 #include "TilesetJsonLoader.h"
 
+#include <CesiumAsync/CacheItem.h>
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/ICacheDatabase.h>
 #include <CesiumUtility/JsonHelpers.h>
+#include <CesiumUtility/JsonWebToken.h>
 #include <CesiumUtility/Uri.h>
 
 #include <rapidjson/document.h>
 
+#include <algorithm>
+#include <ctime>
 #include <unordered_map>
 
 namespace Cesium3DTilesSelection {
@@ -28,6 +33,79 @@ struct AssetEndpoint {
 
 std::unordered_map<std::string, AssetEndpoint> endpointCache;
 
+// How long before its expiry an endpoint access token is refreshed, at most.
+// Tokens that expire sooner are refreshed halfway through their lifetime.
+constexpr std::chrono::system_clock::duration TOKEN_REFRESH_MARGIN =
+    std::chrono::minutes(5);
+
+// How long to wait before trying again after a token refresh failed while
+// the current token was still valid.
+constexpr std::chrono::system_clock::duration TOKEN_REFRESH_RETRY_DELAY =
+    std::chrono::seconds(30);
+
+// Gets the key of an endpoint response in the cache database. It is distinct
+// from the key that a CachingAssetAccessor would use for the same URL.
+std::string getEndpointCacheKey(const std::string& endpointUrl) {
+  return "cesium-ion-endpoint:" + endpointUrl;
+}
+
+// Keeps an endpoint response in the cache database until its access token
+// expires. Responses whose tokens have no known expiry are not kept.
+void storeEndpointResponse(
+    const TilesetExternals& externals,
+    const std::string& endpointUrl,
+    const std::string& accessToken,
+    const gsl::span<const std::byte>& data) {
+  if (!externals.pCacheDatabase) {
+    return;
+  }
+
+  const std::optional<std::chrono::system_clock::time_point> expiry =
+      CesiumUtility::JsonWebToken::getExpiry(accessToken);
+  if (!expiry) {
+    return;
+  }
+
+  externals.asyncSystem.runInWorkerThread(
+      [pCacheDatabase = externals.pCacheDatabase,
+       endpointUrl,
+       expiryTime = std::chrono::system_clock::to_time_t(*expiry),
+       responseData = std::vector<std::byte>(data.begin(), data.end())]() {
+        pCacheDatabase->storeEntry(
+            getEndpointCacheKey(endpointUrl),
+            expiryTime,
+            endpointUrl,
+            "GET",
+            CesiumAsync::HttpHeaders{},
+            200,
+            CesiumAsync::HttpHeaders{},
+            responseData);
+      });
+}
+
+// Marks the endpoint response in the cache database as expired. The database
+// has no way to remove an entry, but an expired one is never used.
+void invalidateEndpointResponse(
+    const TilesetExternals& externals,
+    const std::string& endpointUrl) {
+  if (!externals.pCacheDatabase) {
+    return;
+  }
+
+  externals.asyncSystem.runInWorkerThread(
+      [pCacheDatabase = externals.pCacheDatabase, endpointUrl]() {
+        pCacheDatabase->storeEntry(
+            getEndpointCacheKey(endpointUrl),
+            0,
+            endpointUrl,
+            "GET",
+            CesiumAsync::HttpHeaders{},
+            200,
+            CesiumAsync::HttpHeaders{},
+            {});
+      });
+}
+
 std::string createEndpointResource(
     int64_t ionAssetID,
     const std::string& ionAccessToken,
@@ -103,6 +181,7 @@ mainThreadLoadTilesetJsonFromAssetEndpoint(
                         ionAssetID,
                         ionAccessToken = std::move(ionAccessToken),
                         ionAssetEndpointUrl = std::move(ionAssetEndpointUrl),
+                        endpointAccessToken = endpoint.accessToken,
                         headerChangeListener = std::move(headerChangeListener)](
                            TilesetContentLoaderResult<TilesetJsonLoader>&&
                                tilesetJsonResult) mutable {
@@ -121,6 +200,7 @@ mainThreadLoadTilesetJsonFromAssetEndpoint(
               ionAssetID,
               std::move(ionAccessToken),
               std::move(ionAssetEndpointUrl),
+              std::move(endpointAccessToken),
               std::move(tilesetJsonResult.pLoader),
               std::move(headerChangeListener));
           result.pRootTile = std::move(tilesetJsonResult.pRootTile);
@@ -173,6 +253,7 @@ mainThreadLoadLayerJsonFromAssetEndpoint(
                         ionAssetID,
                         ionAccessToken = std::move(ionAccessToken),
                         ionAssetEndpointUrl = std::move(ionAssetEndpointUrl),
+                        endpointAccessToken = endpoint.accessToken,
                         headerChangeListener = std::move(headerChangeListener)](
                            TilesetContentLoaderResult<LayerJsonTerrainLoader>&&
                                tilesetJsonResult) mutable {
@@ -191,6 +272,7 @@ mainThreadLoadLayerJsonFromAssetEndpoint(
               ionAssetID,
               std::move(ionAccessToken),
               std::move(ionAssetEndpointUrl),
+              std::move(endpointAccessToken),
               std::move(tilesetJsonResult.pLoader),
               std::move(headerChangeListener));
           result.pRootTile = std::move(tilesetJsonResult.pRootTile);
@@ -203,10 +285,18 @@ mainThreadLoadLayerJsonFromAssetEndpoint(
       });
 }
 
+/**
+ * @brief Loads the tileset from the given asset endpoint response data.
+ *
+ * @param storeInCacheDatabase Whether to keep the response in the cache
+ * database of the externals, because it was just received.
+ */
 CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
-mainThreadHandleEndpointResponse(
+mainThreadLoadFromEndpointResponseData(
     const TilesetExternals& externals,
-    std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest,
+    const std::string& requestUrl,
+    const gsl::span<const std::byte>& data,
+    bool storeInCacheDatabase,
     int64_t ionAssetID,
     std::string&& ionAccessToken,
     std::string&& ionAssetEndpointUrl,
@@ -214,28 +304,6 @@ mainThreadHandleEndpointResponse(
     CesiumIonTilesetLoader::AuthorizationHeaderChangeListener&&
         headerChangeListener,
     bool showCreditsOnScreen) {
-  const CesiumAsync::IAssetResponse* pResponse = pRequest->response();
-  const std::string& requestUrl = pRequest->url();
-  if (!pResponse) {
-    TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
-    result.errors.emplaceError(
-        fmt::format("No response received for asset request {}", requestUrl));
-    return externals.asyncSystem.createResolvedFuture(std::move(result));
-  }
-
-  uint16_t statusCode = pResponse->statusCode();
-  if (statusCode < 200 || statusCode >= 300) {
-    TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
-    result.errors.emplaceError(fmt::format(
-        "Received status code {} for asset response {}",
-        statusCode,
-        requestUrl));
-    result.statusCode = statusCode;
-    return externals.asyncSystem.createResolvedFuture(std::move(result));
-  }
-
-  const gsl::span<const std::byte> data = pResponse->data();
-
   rapidjson::Document ionResponse;
   ionResponse.Parse(reinterpret_cast<const char*>(data.data()), data.size());
 
@@ -296,6 +364,10 @@ mainThreadHandleEndpointResponse(
     }
   }
 
+  if (storeInCacheDatabase && (type == "TERRAIN" || type == "3DTILES")) {
+    storeEndpointResponse(externals, requestUrl, accessToken, data);
+  }
+
   if (type == "TERRAIN") {
     // For terrain resources, we need to append `/layer.json` to the end of
     // the URL.
@@ -333,12 +405,90 @@ mainThreadHandleEndpointResponse(
       fmt::format("Received unsupported asset response type: {}", type));
   return externals.asyncSystem.createResolvedFuture(std::move(result));
 }
+
+CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
+mainThreadHandleEndpointResponse(
+    const TilesetExternals& externals,
+    std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest,
+    int64_t ionAssetID,
+    std::string&& ionAccessToken,
+    std::string&& ionAssetEndpointUrl,
+    const TilesetContentOptions& contentOptions,
+    CesiumIonTilesetLoader::AuthorizationHeaderChangeListener&&
+        headerChangeListener,
+    bool showCreditsOnScreen) {
+  const CesiumAsync::IAssetResponse* pResponse = pRequest->response();
+  const std::string& requestUrl = pRequest->url();
+  if (!pResponse) {
+    TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
+    result.errors.emplaceError(
+        fmt::format("No response received for asset request {}", requestUrl));
+    return externals.asyncSystem.createResolvedFuture(std::move(result));
+  }
+
+  uint16_t statusCode = pResponse->statusCode();
+  if (statusCode < 200 || statusCode >= 300) {
+    TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
+    result.errors.emplaceError(fmt::format(
+        "Received status code {} for asset response {}",
+        statusCode,
+        requestUrl));
+    result.statusCode = statusCode;
+    return externals.asyncSystem.createResolvedFuture(std::move(result));
+  }
+
+  return mainThreadLoadFromEndpointResponseData(
+      externals,
+      requestUrl,
+      pResponse->data(),
+      true,
+      ionAssetID,
+      std::move(ionAccessToken),
+      std::move(ionAssetEndpointUrl),
+      contentOptions,
+      std::move(headerChangeListener),
+      showCreditsOnScreen);
+}
+
+CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
+mainThreadRequestEndpoint(
+    const TilesetExternals& externals,
+    const TilesetContentOptions& contentOptions,
+    const std::string& ionUrl,
+    int64_t ionAssetID,
+    const std::string& ionAccessToken,
+    const std::string& ionAssetEndpointUrl,
+    const CesiumIonTilesetLoader::AuthorizationHeaderChangeListener&
+        headerChangeListener,
+    bool showCreditsOnScreen) {
+  return externals.pAssetAccessor->get(externals.asyncSystem, ionUrl)
+      .thenInMainThread(
+          [externals,
+           ionAssetID,
+           ionAccessToken = ionAccessToken,
+           ionAssetEndpointUrl = ionAssetEndpointUrl,
+           headerChangeListener = headerChangeListener,
+           showCreditsOnScreen,
+           contentOptions](
+              std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) mutable {
+            return mainThreadHandleEndpointResponse(
+                externals,
+                std::move(pRequest),
+                ionAssetID,
+                std::move(ionAccessToken),
+                std::move(ionAssetEndpointUrl),
+                contentOptions,
+                std::move(headerChangeListener),
+                showCreditsOnScreen);
+          });
+}
 } // namespace
 
 CesiumIonTilesetLoader::CesiumIonTilesetLoader(
     int64_t ionAssetID,
     std::string&& ionAccessToken,
     std::string&& ionAssetEndpointUrl,
+    std::string&& endpointAccessToken,
     std::unique_ptr<TilesetContentLoader>&& pAggregatedLoader,
     std::function<
         void(const std::string& header, const std::string& headerValue)>&&
@@ -347,12 +497,32 @@ CesiumIonTilesetLoader::CesiumIonTilesetLoader(
       _ionAssetID{ionAssetID},
       _ionAccessToken{std::move(ionAccessToken)},
       _ionAssetEndpointUrl{std::move(ionAssetEndpointUrl)},
+      _endpointAccessToken{},
+      _tokenExpiry{},
+      _tokenRefreshTime{},
       _pAggregatedLoader{std::move(pAggregatedLoader)},
-      _headerChangeListener{std::move(headerChangeListener)} {}
+      _headerChangeListener{std::move(headerChangeListener)} {
+  this->setEndpointAccessToken(std::move(endpointAccessToken));
+}
 
 CesiumAsync::Future<TileLoadResult>
 CesiumIonTilesetLoader::loadTileContent(const TileLoadInput& loadInput) {
-  if (this->_refreshTokenState == TokenRefreshState::Loading) {
+  const auto& asyncSystem = loadInput.asyncSystem;
+  const auto& pAssetAccessor = loadInput.pAssetAccessor;
+  const auto& pLogger = loadInput.pLogger;
+
+  // Refresh the token before it expires. Tiles keep loading with the current
+  // token until the new one replaces it.
+  const std::chrono::system_clock::time_point now =
+      std::chrono::system_clock::now();
+  if (this->_refreshTokenState != TokenRefreshState::Loading &&
+      this->_refreshTokenState != TokenRefreshState::Failed &&
+      this->_tokenRefreshTime && now >= *this->_tokenRefreshTime) {
+    this->refreshTokenInMainThread(pLogger, pAssetAccessor, asyncSystem);
+  }
+
+  if (this->_refreshTokenState == TokenRefreshState::Loading &&
+      !(this->_tokenExpiry && now < *this->_tokenExpiry)) {
     return loadInput.asyncSystem.createResolvedFuture(
         TileLoadResult::createRetryLaterResult(nullptr));
   } else if (this->_refreshTokenState == TokenRefreshState::Failed) {
@@ -360,16 +530,21 @@ CesiumIonTilesetLoader::loadTileContent(const TileLoadInput& loadInput) {
         TileLoadResult::createFailedResult(nullptr));
   }
 
-  const auto& asyncSystem = loadInput.asyncSystem;
-  const auto& pAssetAccessor = loadInput.pAssetAccessor;
-  const auto& pLogger = loadInput.pLogger;
-
-  // TODO: the way this is structured, requests already in progress
-  // with the old key might complete after the key has been updated,
-  // and there's nothing here clever enough to avoid refreshing the
-  // key _again_ in that instance.
+  // A request that was made with an older token may be rejected after the
+  // token has been refreshed. It is retried with the new token, without
+  // refreshing it again.
   auto refreshTokenInMainThread =
-      [this, pLogger, pAssetAccessor, asyncSystem]() {
+      [this,
+       pLogger,
+       pAssetAccessor,
+       asyncSystem,
+       requestToken = this->_endpointAccessToken]() {
+        if (requestToken != this->_endpointAccessToken) {
+          return;
+        }
+
+        // The token was rejected, so it should no longer be used.
+        this->_tokenExpiry.reset();
         this->refreshTokenInMainThread(pLogger, pAssetAccessor, asyncSystem);
       };
 
@@ -397,6 +572,38 @@ CesiumIonTilesetLoader::createTileChildren(const Tile& tile) {
   return pLoader->createTileChildren(tile);
 }
 
+void CesiumIonTilesetLoader::addMemoryUsage(TilesetMemoryUsage& usage) const {
+  this->_pAggregatedLoader->addMemoryUsage(usage);
+}
+
+int64_t CesiumIonTilesetLoader::trimMemory() {
+  return this->_pAggregatedLoader->trimMemory();
+}
+
+CesiumAsync::Future<void>
+CesiumIonTilesetLoader::loadTileChildren(const TileLoadInput& loadInput) {
+  return this->_pAggregatedLoader->loadTileChildren(loadInput);
+}
+
+void CesiumIonTilesetLoader::setEndpointAccessToken(
+    std::string&& endpointAccessToken) {
+  this->_endpointAccessToken = std::move(endpointAccessToken);
+  this->_tokenExpiry =
+      CesiumUtility::JsonWebToken::getExpiry(this->_endpointAccessToken);
+  if (!this->_tokenExpiry) {
+    this->_tokenRefreshTime.reset();
+    return;
+  }
+
+  const std::chrono::system_clock::time_point now =
+      std::chrono::system_clock::now();
+  const std::chrono::system_clock::duration lifetime = std::max(
+      *this->_tokenExpiry - now,
+      std::chrono::system_clock::duration::zero());
+  this->_tokenRefreshTime =
+      *this->_tokenExpiry - std::min(TOKEN_REFRESH_MARGIN, lifetime / 2);
+}
+
 void CesiumIonTilesetLoader::refreshTokenInMainThread(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
@@ -418,8 +625,23 @@ void CesiumIonTilesetLoader::refreshTokenInMainThread(
             const CesiumAsync::IAssetResponse* pIonResponse =
                 pIonRequest->response();
 
+            // If the current token is still valid, keep using it and try
+            // again later. Otherwise, the tiles can no longer be loaded.
+            auto fail = [this]() {
+              const std::chrono::system_clock::time_point now =
+                  std::chrono::system_clock::now();
+              if (this->_tokenExpiry && now < *this->_tokenExpiry) {
+                this->_refreshTokenState = TokenRefreshState::None;
+                this->_tokenRefreshTime = std::min(
+                    now + TOKEN_REFRESH_RETRY_DELAY,
+                    *this->_tokenExpiry);
+              } else {
+                this->_refreshTokenState = TokenRefreshState::Failed;
+              }
+            };
+
             if (!pIonResponse) {
-              this->_refreshTokenState = TokenRefreshState::Failed;
+              fail();
               return;
             }
 
@@ -427,6 +649,9 @@ void CesiumIonTilesetLoader::refreshTokenInMainThread(
             if (statusCode >= 200 && statusCode < 300) {
               auto accessToken = getNewAccessToken(pIonResponse, pLogger);
               if (accessToken) {
+                // The header is swapped in the main thread, where tile
+                // requests are started, so each request uses either the old
+                // token or the new one.
                 this->_headerChangeListener(
                     "Authorization",
                     "Bearer " + *accessToken);
@@ -437,12 +662,13 @@ void CesiumIonTilesetLoader::refreshTokenInMainThread(
                   cacheIt->second.accessToken = accessToken.value();
                 }
 
+                this->setEndpointAccessToken(std::move(*accessToken));
                 this->_refreshTokenState = TokenRefreshState::Done;
                 return;
               }
             }
 
-            this->_refreshTokenState = TokenRefreshState::Failed;
+            fail();
           });
 }
 
@@ -524,28 +750,85 @@ CesiumIonTilesetLoader::createLoader(
         "Received unsupported asset response type: {}",
         endpoint.type));
     return externals.asyncSystem.createResolvedFuture(std::move(result));
-  } else {
-    return externals.pAssetAccessor->get(externals.asyncSystem, ionUrl)
-        .thenInMainThread(
-            [externals,
-             ionAssetID,
-             ionAccessToken = ionAccessToken,
-             ionAssetEndpointUrl = ionAssetEndpointUrl,
-             headerChangeListener = headerChangeListener,
-             showCreditsOnScreen,
-             contentOptions](std::shared_ptr<CesiumAsync::IAssetRequest>&&
-                                 pRequest) mutable {
-              return mainThreadHandleEndpointResponse(
+  } else if (!externals.pCacheDatabase) {
+    return mainThreadRequestEndpoint(
+        externals,
+        contentOptions,
+        ionUrl,
+        ionAssetID,
+        ionAccessToken,
+        ionAssetEndpointUrl,
+        headerChangeListener,
+        showCreditsOnScreen);
+  }
+
+  // Start loading from an endpoint response that was kept from an earlier
+  // session, if its token is still valid for a while. If the token is
+  // rejected anyway, the endpoint is requested again by
+  // refreshTokenIfNeeded.
+  return externals.asyncSystem
+      .runInWorkerThread(
+          [pCacheDatabase = externals.pCacheDatabase, ionUrl]() {
+            return pCacheDatabase->getEntry(getEndpointCacheKey(ionUrl));
+          })
+      .thenInMainThread(
+          [externals,
+           contentOptions,
+           ionUrl,
+           ionAssetID,
+           ionAccessToken,
+           ionAssetEndpointUrl,
+           headerChangeListener,
+           showCreditsOnScreen](
+              std::optional<CesiumAsync::CacheItem>&& maybeCacheItem) {
+            const std::time_t validUntil = std::chrono::system_clock::to_time_t(
+                std::chrono::system_clock::now() + TOKEN_REFRESH_MARGIN);
+            if (!maybeCacheItem || maybeCacheItem->expiryTime <= validUntil) {
+              return mainThreadRequestEndpoint(
                   externals,
-                  std::move(pRequest),
-                  ionAssetID,
-                  std::move(ionAccessToken),
-                  std::move(ionAssetEndpointUrl),
                   contentOptions,
-                  std::move(headerChangeListener),
+                  ionUrl,
+                  ionAssetID,
+                  ionAccessToken,
+                  ionAssetEndpointUrl,
+                  headerChangeListener,
                   showCreditsOnScreen);
-            });
-  }
+            }
+
+            CesiumIonTilesetLoader::AuthorizationHeaderChangeListener
+                listener = headerChangeListener;
+            return mainThreadLoadFromEndpointResponseData(
+                       externals,
+                       ionUrl,
+                       maybeCacheItem->cacheResponse.data,
+                       false,
+                       ionAssetID,
+                       std::string(ionAccessToken),
+                       std::string(ionAssetEndpointUrl),
+                       contentOptions,
+                       std::move(listener),
+                       showCreditsOnScreen)
+                .thenInMainThread(
+                    [externals,
+                     contentOptions,
+                     ionAssetID,
+                     ionAccessToken,
+                     ionAssetEndpointUrl,
+                     headerChangeListener,
+                     showCreditsOnScreen](
+                        TilesetContentLoaderResult<CesiumIonTilesetLoader>&&
+                            result) {
+                      return refreshTokenIfNeeded(
+                          externals,
+                          contentOptions,
+                          ionAssetID,
+                          ionAccessToken,
+                          ionAssetEndpointUrl,
+                          headerChangeListener,
+                          showCreditsOnScreen,
+                          std::move(result));
+                    });
+          });
 }
 CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
 CesiumIonTilesetLoader::refreshTokenIfNeeded(
@@ -559,13 +842,16 @@ CesiumIonTilesetLoader::refreshTokenIfNeeded(
     TilesetContentLoaderResult<CesiumIonTilesetLoader>&& result) {
   if (result.errors.hasErrors()) {
     if (result.statusCode == 401) {
-      endpointCache.erase(createEndpointResource(
+      const std::string ionUrl = createEndpointResource(
           ionAssetID,
           ionAccessToken,
-          ionAssetEndpointUrl));
-      return CesiumIonTilesetLoader::createLoader(
+          ionAssetEndpointUrl);
+      endpointCache.erase(ionUrl);
+      invalidateEndpointResponse(externals, ionUrl);
+      return mainThreadRequestEndpoint(
           externals,
           contentOptions,
+          ionUrl,
           ionAssetID,
           ionAccessToken,
           ionAssetEndpointUrl,
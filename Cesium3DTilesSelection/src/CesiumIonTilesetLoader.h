@@ -5,7 +5,9 @@
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 #include <Cesium3DTilesSelection/TilesetExternals.h>
 
+#include <chrono>
 #include <functional>
+#include <optional>
 #include <string>
 
 namespace Cesium3DTilesSelection {
@@ -20,6 +22,7 @@ public:
       int64_t ionAssetID,
       std::string&& ionAccessToken,
       std::string&& ionAssetEndpointUrl,
+      std::string&& endpointAccessToken,
       std::unique_ptr<TilesetContentLoader>&& pAggregatedLoader,
       AuthorizationHeaderChangeListener&& headerChangeListener);
 
@@ -28,6 +31,13 @@ public:
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
 
+  void addMemoryUsage(TilesetMemoryUsage& usage) const override;
+
+  int64_t trimMemory() override;
+
+  CesiumAsync::Future<void>
+  loadTileChildren(const TileLoadInput& loadInput) override;
+
   static CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
   createLoader(
       const TilesetExternals& externals,
@@ -50,6 +60,8 @@ public:
       TilesetContentLoaderResult<CesiumIonTilesetLoader>&& result);
 
 private:
+  void setEndpointAccessToken(std::string&& endpointAccessToken);
+
   void refreshTokenInMainThread(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
@@ -59,6 +71,15 @@ private:
   int64_t _ionAssetID;
   std::string _ionAccessToken;
   std::string _ionAssetEndpointUrl;
+
+  // The token from the asset endpoint, which authorizes the tile requests.
+  // It is refreshed at _tokenRefreshTime, while it is still valid, so that
+  // tile requests do not have to wait for the refresh. Without a known
+  // expiry, it is only refreshed after a request is rejected.
+  std::string _endpointAccessToken;
+  std::optional<std::chrono::system_clock::time_point> _tokenExpiry;
+  std::optional<std::chrono::system_clock::time_point> _tokenRefreshTime;
+
   std::unique_ptr<TilesetContentLoader> _pAggregatedLoader;
   AuthorizationHeaderChangeListener _headerChangeListener;
 };
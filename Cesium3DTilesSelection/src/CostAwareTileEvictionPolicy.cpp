@@ -0,0 +1,78 @@
+#include "Cesium3DTilesSelection/CostAwareTileEvictionPolicy.h"
+
+#include "Cesium3DTilesSelection/Tile.h"
+
+#include <glm/common.hpp>
+#include <glm/exponential.hpp>
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+// The load time assumed for tiles whose load was not observed, before any
+// load has been observed.
+const double defaultLoadTime = 0.1;
+} // namespace
+
+CostAwareTileEvictionPolicy::CostAwareTileEvictionPolicy(
+    double recencyHalfLife) noexcept
+    : _recencyHalfLife(recencyHalfLife),
+      _frameNumber(0),
+      _totalLoadTime(0.0),
+      _loadCount(0),
+      _statistics() {}
+
+void CostAwareTileEvictionPolicy::startNewFrame() noexcept {
+  ++this->_frameNumber;
+}
+
+void CostAwareTileEvictionPolicy::notifyTileVisited(const Tile& tile) noexcept {
+  TileStatistics& statistics = this->_statistics[&tile];
+
+  // Only count a visit when the tile comes back into view, so that a tile
+  // that stays in view for many frames doesn't look frequently used.
+  if (statistics.lastVisitFrame + 1 < this->_frameNumber) {
+    ++statistics.visits;
+  }
+
+  statistics.lastVisitFrame = this->_frameNumber;
+}
+
+void CostAwareTileEvictionPolicy::notifyTileLoaded(
+    const Tile& tile,
+    double loadTime) noexcept {
+  this->_statistics[&tile].loadTime = loadTime;
+  this->_totalLoadTime += loadTime;
+  ++this->_loadCount;
+}
+
+double CostAwareTileEvictionPolicy::computeRetentionScore(
+    const Tile& tile) const noexcept {
+  const double averageLoadTime =
+      this->_loadCount > 0
+          ? this->_totalLoadTime / static_cast<double>(this->_loadCount)
+          : defaultLoadTime;
+
+  double loadTime = averageLoadTime;
+  double visits = 1.0;
+  double age = 0.0;
+
+  auto it = this->_statistics.find(&tile);
+  if (it != this->_statistics.end()) {
+    const TileStatistics& statistics = it->second;
+    if (statistics.loadTime >= 0.0) {
+      loadTime = statistics.loadTime;
+    }
+    visits = glm::max(static_cast<double>(statistics.visits), 1.0);
+    if (statistics.lastVisitFrame >= 0) {
+      age = static_cast<double>(this->_frameNumber - statistics.lastVisitFrame);
+    }
+  }
+
+  const double bytes =
+      glm::max(static_cast<double>(tile.computeByteSize()), 1.0);
+  const double recency = this->_recencyHalfLife > 0.0
+                             ? glm::exp2(-age / this->_recencyHalfLife)
+                             : 1.0;
+
+  return loadTime * visits * recency / bytes;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/Future.h>
+#include <CesiumAsync/ITaskProcessor.h>
+#include <CesiumAsync/ThreadPool.h>
+
+#include <optional>
+#include <utility>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Runs a CPU-heavy tile decoding step, such as glTF parsing, Draco
+ * decompression, or upsampling, in the decode thread pool, or in a worker
+ * thread if there is no decode thread pool.
+ *
+ * In a worker thread, the step is started with the priority of the tile load,
+ * so that the task processor can do the most important work first. A decode
+ * thread pool runs its tasks in the order they are started.
+ *
+ * @see TilesetExternals::decodeThreadPool
+ */
+template <typename Func>
+auto runInDecodeThread(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool,
+    const CesiumAsync::TaskPriority& priority,
+    Func&& f) {
+  if (decodeThreadPool) {
+    return asyncSystem.runInThreadPool(
+        *decodeThreadPool,
+        std::forward<Func>(f));
+  }
+
+  return asyncSystem.runInWorkerThread(std::forward<Func>(f), priority);
+}
+
+/**
+ * @brief Continues a future with a CPU-heavy tile decoding step, in the decode
+ * thread pool, or in a worker thread if there is no decode thread pool.
+ *
+ * @see runInDecodeThread
+ */
+template <typename T, typename Func>
+auto thenInDecodeThread(
+    CesiumAsync::Future<T>&& future,
+    const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool,
+    const CesiumAsync::TaskPriority& priority,
+    Func&& f) {
+  if (decodeThreadPool) {
+    return std::move(future).thenInThreadPool(
+        *decodeThreadPool,
+        std::forward<Func>(f));
+  }
+
+  return std::move(future).thenInWorkerThread(
+      std::forward<Func>(f),
+      priority);
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,105 @@
+#include <Cesium3DTilesSelection/DecodedContentCache.h>
+
+#include <utility>
+
+namespace Cesium3DTilesSelection {
+namespace {
+int64_t computeByteSize(const CesiumGltf::Model& model) noexcept {
+  int64_t byteSize = static_cast<int64_t>(sizeof(CesiumGltf::Model));
+  for (const CesiumGltf::Buffer& buffer : model.buffers) {
+    byteSize += static_cast<int64_t>(buffer.cesium.getData().size());
+  }
+  for (const CesiumGltf::Image& image : model.images) {
+    byteSize += static_cast<int64_t>(image.cesium.getPixelData().size());
+  }
+  return byteSize;
+}
+} // namespace
+
+DecodedContentCache::DecodedContentCache(int64_t maximumBytes) noexcept
+    : _mutex(),
+      _entries(),
+      _entriesByKey(),
+      _byteSize(0),
+      _maximumBytes(maximumBytes) {}
+
+DecodedContentCache::Key DecodedContentCache::computeKey(
+    const gsl::span<const std::byte>& content) noexcept {
+  return CesiumUtility::ContentHash::compute(content);
+}
+
+std::optional<CesiumGltf::Model>
+DecodedContentCache::find(const Key& key) {
+  std::shared_ptr<const CesiumGltf::Model> pModel;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entriesByKey.find(key);
+    if (it == this->_entriesByKey.end()) {
+      return std::nullopt;
+    }
+
+    this->_entries.splice(this->_entries.begin(), this->_entries, it->second);
+    pModel = it->second->pModel;
+  }
+
+  // Copy outside the lock, which may take a while for a large glTF.
+  return *pModel;
+}
+
+void DecodedContentCache::insert(
+    const Key& key,
+    const CesiumGltf::Model& model) {
+  const int64_t byteSize = computeByteSize(model);
+  if (byteSize > this->_maximumBytes) {
+    return;
+  }
+
+  auto pModel = std::make_shared<const CesiumGltf::Model>(model);
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  auto it = this->_entriesByKey.find(key);
+  if (it != this->_entriesByKey.end()) {
+    this->_byteSize -= it->second->byteSize;
+    this->_entries.erase(it->second);
+    this->_entriesByKey.erase(it);
+  }
+
+  this->_entries.push_front(Entry{key, std::move(pModel), byteSize});
+  this->_entriesByKey.emplace(key, this->_entries.begin());
+  this->_byteSize += byteSize;
+
+  while (this->_byteSize > this->_maximumBytes) {
+    const Entry& leastRecentlyUsed = this->_entries.back();
+    this->_byteSize -= leastRecentlyUsed.byteSize;
+    this->_entriesByKey.erase(leastRecentlyUsed.key);
+    this->_entries.pop_back();
+  }
+}
+
+size_t DecodedContentCache::getCount() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_entries.size();
+}
+
+int64_t DecodedContentCache::getByteSize() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_byteSize;
+}
+
+int64_t DecodedContentCache::clear() {
+  std::list<Entry> entries;
+  int64_t byteSize;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    entries.swap(this->_entries);
+    this->_entriesByKey.clear();
+    byteSize = this->_byteSize;
+    this->_byteSize = 0;
+  }
+
+  // Free the glTFs outside the lock.
+  entries.clear();
+  return byteSize;
+}
+
+} // namespace Cesium3DTilesSelection
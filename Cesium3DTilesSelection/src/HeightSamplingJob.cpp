@@ -0,0 +1,187 @@
+#include "HeightSamplingJob.h"
+
+#include "TilesetContentManager.h"
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/TileID.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <variant>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+
+// The height above the ellipsoid at which the rays start, which is well above
+// the highest terrain.
+constexpr double rayOriginHeight = 100000.0;
+
+} // namespace
+
+HeightSamplingJob::HeightSamplingJob(
+    std::vector<Cartographic>&& positions,
+    const CesiumAsync::Promise<SampleHeightResult>& promise)
+    : _positions(std::move(positions)),
+      _rays(),
+      _promise(promise),
+      _started(false),
+      _pendingTiles(),
+      _visitedTiles(),
+      _warnings() {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  this->_rays.reserve(this->_positions.size());
+  for (const Cartographic& position : this->_positions) {
+    const Cartographic origin(
+        position.longitude,
+        position.latitude,
+        rayOriginHeight);
+    this->_rays.emplace_back(
+        ellipsoid.cartographicToCartesian(origin),
+        -ellipsoid.geodeticSurfaceNormal(origin));
+  }
+}
+
+bool HeightSamplingJob::update(TilesetContentManager& contentManager) {
+  if (!this->_started) {
+    Tile* pRootTile = contentManager.getRootTile();
+    if (!pRootTile) {
+      return false;
+    }
+
+    std::vector<size_t> rayIndices(this->_rays.size());
+    for (size_t i = 0; i < rayIndices.size(); ++i) {
+      rayIndices[i] = i;
+    }
+
+    this->_pendingTiles.push_back({pRootTile, std::move(rayIndices), false});
+    this->_started = true;
+  }
+
+  std::vector<PendingTile> toVisit = std::move(this->_pendingTiles);
+  this->_pendingTiles.clear();
+  while (!toVisit.empty()) {
+    PendingTile pending = std::move(toVisit.back());
+    toVisit.pop_back();
+    this->_visitTile(std::move(pending), toVisit);
+  }
+
+  return this->_pendingTiles.empty();
+}
+
+void HeightSamplingJob::getTilesToLoad(std::vector<Tile*>& tiles) const {
+  for (const PendingTile& pending : this->_pendingTiles) {
+    tiles.emplace_back(pending.pTile);
+  }
+}
+
+void HeightSamplingJob::getTilesInUse(std::vector<Tile*>& tiles) const {
+  this->getTilesToLoad(tiles);
+  tiles.insert(
+      tiles.end(),
+      this->_visitedTiles.begin(),
+      this->_visitedTiles.end());
+}
+
+void HeightSamplingJob::resolve(
+    const std::vector<std::optional<LoadedTileIntersection>>& intersections) {
+  SampleHeightResult result;
+  result.positions = std::move(this->_positions);
+  result.sampleSuccess.resize(result.positions.size(), false);
+  result.warnings = std::move(this->_warnings);
+
+  for (size_t i = 0; i < result.positions.size() && i < intersections.size();
+       ++i) {
+    if (intersections[i]) {
+      result.positions[i].height =
+          rayOriginHeight - intersections[i]->intersection.distance;
+      result.sampleSuccess[i] = true;
+    }
+  }
+
+  this->_promise.resolve(std::move(result));
+}
+
+void HeightSamplingJob::abandon() {
+  this->_promise.reject(std::runtime_error(
+      "The tileset was destroyed before the heights were sampled."));
+}
+
+void HeightSamplingJob::_visitTile(
+    PendingTile&& pending,
+    std::vector<PendingTile>& toVisit) {
+  Tile& tile = *pending.pTile;
+
+  auto it = std::remove_if(
+      pending.rayIndices.begin(),
+      pending.rayIndices.end(),
+      [this, &tile](size_t i) {
+        return !intersectRayWithBoundingVolume(
+            this->_rays[i],
+            tile.getBoundingVolume());
+      });
+  pending.rayIndices.erase(it, pending.rayIndices.end());
+  if (pending.rayIndices.empty()) {
+    return;
+  }
+
+  switch (tile.getState()) {
+  case TileLoadState::Unloaded:
+  case TileLoadState::Unloading:
+    this->_pendingTiles.emplace_back(std::move(pending));
+    return;
+
+  case TileLoadState::ContentLoading:
+  case TileLoadState::ContentLoaded:
+    pending.loadStarted = true;
+    this->_pendingTiles.emplace_back(std::move(pending));
+    return;
+
+  case TileLoadState::FailedTemporarily:
+    if (!pending.loadStarted) {
+      this->_pendingTiles.emplace_back(std::move(pending));
+      return;
+    }
+    [[fallthrough]];
+
+  case TileLoadState::Failed:
+    this->_warnings.emplace_back(
+        "Tile " + TileIdUtilities::createTileIdString(tile.getTileID()) +
+        " failed to load, so the heights beneath it may be less detailed.");
+    return;
+
+  case TileLoadState::Done:
+    break;
+  }
+
+  // The geometry index is only built as the tile is loaded when
+  // TilesetContentOptions::buildGeometryIndex is set, so build it now
+  // otherwise.
+  TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+  if (pRenderContent && !pRenderContent->getGeometryIndex()) {
+    pRenderContent->setGeometryIndex(
+        std::make_shared<const TileGeometryIndex>(pRenderContent->getModel()));
+  }
+
+  this->_visitedTiles.emplace_back(&tile);
+
+  for (Tile& child : tile.getChildren()) {
+    // Upsampled tiles have the same geometry as their parent, only less of
+    // it, so they are not more detailed.
+    if (std::holds_alternative<CesiumGeometry::UpsampledQuadtreeNode>(
+            child.getTileID())) {
+      continue;
+    }
+
+    toVisit.push_back({&child, pending.rayIndices, false});
+  }
+}
+
+} // namespace Cesium3DTilesSelection
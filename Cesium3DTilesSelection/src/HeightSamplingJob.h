@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/SampleHeightResult.h>
+#include <Cesium3DTilesSelection/TileGeometryIndex.h>
+#include <CesiumAsync/Promise.h>
+#include <CesiumGeometry/Ray.h>
+#include <CesiumGeospatial/Cartographic.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+class Tile;
+class TilesetContentManager;
+
+/**
+ * @brief Walks the tiles of a tileset that vertical rays through a set of
+ * positions intersect, down to the most detailed ones, so that the heights
+ * of the positions can be sampled from their content.
+ *
+ * @see Tileset::sampleHeights
+ */
+class HeightSamplingJob {
+public:
+  HeightSamplingJob(
+      std::vector<CesiumGeospatial::Cartographic>&& positions,
+      const CesiumAsync::Promise<SampleHeightResult>& promise);
+
+  /**
+   * @brief Visits the tiles that have finished loading since the last update,
+   * and finds the tiles that must be loaded next.
+   *
+   * @return true if every tile that the rays intersect has been visited, so
+   * that the job can be resolved.
+   */
+  bool update(TilesetContentManager& contentManager);
+
+  /**
+   * @brief Gets the downward rays through the positions, which start high
+   * above the ellipsoid.
+   */
+  const std::vector<CesiumGeometry::Ray>& getRays() const noexcept {
+    return this->_rays;
+  }
+
+  /**
+   * @brief Appends the tiles that must be loaded before the job can continue
+   * to a vector.
+   */
+  void getTilesToLoad(std::vector<Tile*>& tiles) const;
+
+  /**
+   * @brief Appends the tiles that the job has visited or is waiting for to a
+   * vector, so that they can be kept from being unloaded.
+   */
+  void getTilesInUse(std::vector<Tile*>& tiles) const;
+
+  /**
+   * @brief Resolves the promise with the heights of the closest intersection
+   * of each ray.
+   *
+   * @param intersections The intersections, in the order of the rays.
+   */
+  void resolve(
+      const std::vector<std::optional<LoadedTileIntersection>>& intersections);
+
+  /**
+   * @brief Rejects the promise, because the tileset is being destroyed.
+   */
+  void abandon();
+
+private:
+  struct PendingTile {
+    Tile* pTile;
+
+    // The indices of the rays that intersect the bounding volume of the tile.
+    std::vector<size_t> rayIndices;
+
+    // Whether the tile was seen loading, so that a temporary failure after
+    // that ends the wait for it.
+    bool loadStarted;
+  };
+
+  void _visitTile(PendingTile&& pending, std::vector<PendingTile>& toVisit);
+
+  std::vector<CesiumGeospatial::Cartographic> _positions;
+  std::vector<CesiumGeometry::Ray> _rays;
+  CesiumAsync::Promise<SampleHeightResult> _promise;
+  bool _started;
+
+  // The tiles whose loads the job is waiting for.
+  std::vector<PendingTile> _pendingTiles;
+
+  // The loaded tiles whose content the rays may intersect.
+  std::vector<Tile*> _visitedTiles;
+
+  std::vector<std::string> _warnings;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,22 @@
+#include "Cesium3DTilesSelection/ITileExcluder.h"
+
+#include "Cesium3DTilesSelection/Tile.h"
+
+namespace Cesium3DTilesSelection {
+
+TileExclusion ITileExcluder::classify(const Tile& tile) const noexcept {
+  return this->shouldExclude(tile) ? TileExclusion::Excluded
+                                   : TileExclusion::Included;
+}
+
+void ITileExcluder::classifyChildren(
+    const Tile& parent,
+    gsl::span<const CesiumGeometry::BoundingSphere> /*childBoundingSpheres*/,
+    gsl::span<TileExclusion> results) const noexcept {
+  gsl::span<const Tile> children = parent.getChildren();
+  for (size_t i = 0; i < children.size(); ++i) {
+    results[i] = this->classify(children[i]);
+  }
+}
+
+} // namespace Cesium3DTilesSelection
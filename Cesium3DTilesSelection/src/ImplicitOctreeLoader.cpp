@@ -1,37 +1,54 @@
 #include "ImplicitOctreeLoader.h"
 
+#include "DecodeThread.h"
 #include "logTileLoadResult.h"
 
 #include <Cesium3DTilesContent/GltfConverters.h>
 #include <Cesium3DTilesContent/ImplicitTilingUtilities.h>
+#include <Cesium3DTilesSelection/DecodedContentCache.h>
 #include <Cesium3DTilesSelection/Tile.h>
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumUtility/Uri.h>
 
 #include <spdlog/logger.h>
 
+#include <array>
+#include <atomic>
+#include <optional>
 #include <variant>
 
 using namespace Cesium3DTilesContent;
 
 namespace Cesium3DTilesSelection {
 namespace {
-struct BoundingVolumeSubdivision {
-  BoundingVolume operator()(const CesiumGeospatial::BoundingRegion& region) {
-    return ImplicitTilingUtilities::computeBoundingVolume(region, this->tileID);
-  }
-
-  BoundingVolume operator()(const CesiumGeometry::OrientedBoundingBox& obb) {
-    return ImplicitTilingUtilities::computeBoundingVolume(obb, this->tileID);
+struct ChildBoundingVolumeSubdivision {
+  template <typename ImplicitBoundingVolumeType>
+  std::array<BoundingVolume, 8>
+  operator()(const ImplicitBoundingVolumeType& rootBoundingVolume) {
+    const auto children = ImplicitTilingUtilities::computeChildBoundingVolumes(
+        ImplicitTilingUtilities::computeBoundingVolume(
+            rootBoundingVolume,
+            this->tileID));
+    return {
+        children[0],
+        children[1],
+        children[2],
+        children[3],
+        children[4],
+        children[5],
+        children[6],
+        children[7]};
   }
 
   const CesiumGeometry::OctreeTileID& tileID;
 };
 
-BoundingVolume subdivideBoundingVolume(
+// Computes the bounding volumes of all eight children of a tile together,
+// in the order of OctreeChildren, rather than each from the root.
+std::array<BoundingVolume, 8> subdivideChildBoundingVolumes(
     const CesiumGeometry::OctreeTileID& tileID,
     const ImplicitOctreeBoundingVolume& rootBoundingVolume) {
-  return std::visit(BoundingVolumeSubdivision{tileID}, rootBoundingVolume);
+  return std::visit(ChildBoundingVolumeSubdivision{tileID}, rootBoundingVolume);
 }
 
 std::vector<Tile> populateSubtree(
@@ -50,22 +67,50 @@ std::vector<Tile> populateSubtree(
 
   OctreeChildren childIDs = ImplicitTilingUtilities::getChildren(octreeID);
 
+  // The children are kept for the lifetime of the tileset, so count the
+  // available ones first and allocate exactly that many. Most tiles in a
+  // sparse tileset are leaves, which then don't allocate at all.
+  const uint32_t relativeChildLevel = relativeTileLevel + 1;
+  size_t availableChildren = 0;
+  for (const CesiumGeometry::OctreeTileID& childID : childIDs) {
+    uint64_t relativeChildMortonID =
+        ImplicitTilingUtilities::computeRelativeMortonIndex(
+            subtreeRootID,
+            childID);
+    const bool isAvailable =
+        relativeChildLevel == subtreeLevels
+            ? subtreeAvailability.isSubtreeAvailable(relativeChildMortonID)
+            : subtreeAvailability.isTileAvailable(
+                  relativeChildLevel,
+                  relativeChildMortonID);
+    if (isAvailable) {
+      ++availableChildren;
+    }
+  }
+
+  if (availableChildren == 0) {
+    return {};
+  }
+
   std::vector<Tile> children;
-  children.reserve(childIDs.size());
+  children.reserve(availableChildren);
 
+  const std::array<BoundingVolume, 8> childBoundingVolumes =
+      subdivideChildBoundingVolumes(octreeID, loader.getBoundingVolume());
+  size_t childIndex = 0;
   for (const CesiumGeometry::OctreeTileID& childID : childIDs) {
+    const BoundingVolume& childBoundingVolume =
+        childBoundingVolumes[childIndex++];
     uint64_t relativeChildMortonID =
         ImplicitTilingUtilities::computeRelativeMortonIndex(
             subtreeRootID,
             childID);
 
-    uint32_t relativeChildLevel = relativeTileLevel + 1;
     if (relativeChildLevel == subtreeLevels) {
       if (subtreeAvailability.isSubtreeAvailable(relativeChildMortonID)) {
         Tile& child = children.emplace_back(&loader);
         child.setTransform(tile.getTransform());
-        child.setBoundingVolume(
-            subdivideBoundingVolume(childID, loader.getBoundingVolume()));
+        child.setBoundingVolume(childBoundingVolume);
         child.setGeometricError(tile.getGeometricError() * 0.5);
         child.setRefine(tile.getRefine());
         child.setTileID(childID);
@@ -85,8 +130,7 @@ std::vector<Tile> populateSubtree(
 
         Tile& child = children.back();
         child.setTransform(tile.getTransform());
-        child.setBoundingVolume(
-            subdivideBoundingVolume(childID, loader.getBoundingVolume()));
+        child.setBoundingVolume(childBoundingVolume);
         child.setGeometricError(tile.getGeometricError() * 0.5);
         child.setRefine(tile.getRefine());
         child.setTileID(childID);
@@ -103,11 +147,34 @@ CesiumAsync::Future<TileLoadResult> requestTileContent(
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
     const std::string& tileUrl,
     const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
-    CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets) {
-  return pAssetAccessor->get(asyncSystem, tileUrl, requestHeaders)
-      .thenInWorkerThread([pLogger, ktx2TranscodeTargets](
-                              std::shared_ptr<CesiumAsync::IAssetRequest>&&
-                                  pCompletedRequest) mutable {
+    CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets,
+    const std::optional<std::vector<std::string>>& requiredAttributes,
+    bool optimizeMeshes,
+    bool geometryOnly,
+    const std::shared_ptr<DecodedContentCache>& pDecodedContentCache,
+    const std::shared_ptr<const std::atomic<bool>>& pLoadCanceled,
+    const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool,
+    const CesiumAsync::TaskPriority& priority) {
+  return thenInDecodeThread(
+      pAssetAccessor->get(asyncSystem, tileUrl, requestHeaders),
+      decodeThreadPool,
+      priority,
+      [asyncSystem,
+       pLogger,
+       ktx2TranscodeTargets,
+       requiredAttributes,
+       optimizeMeshes,
+       geometryOnly,
+       pDecodedContentCache,
+       pLoadCanceled](
+          std::shared_ptr<CesiumAsync::IAssetRequest>&&
+              pCompletedRequest) mutable {
+        // Don't decode the content of a tile that is no longer needed.
+        if (pLoadCanceled && *pLoadCanceled) {
+          return TileLoadResult::createRetryLaterResult(
+              std::move(pCompletedRequest));
+        }
+
         const CesiumAsync::IAssetResponse* pResponse =
             pCompletedRequest->response();
         const std::string& tileUrl = pCompletedRequest->url();
@@ -143,7 +210,37 @@ CesiumAsync::Future<TileLoadResult> requestTileContent(
           // Convert to gltf
           CesiumGltfReader::GltfReaderOptions gltfOptions;
           gltfOptions.ktx2TranscodeTargets = ktx2TranscodeTargets;
-          GltfConverterResult result = converter(responseData, gltfOptions);
+          gltfOptions.requiredAttributes = requiredAttributes;
+          gltfOptions.optimizeMeshes = optimizeMeshes;
+          gltfOptions.loadImages = !geometryOnly;
+          gltfOptions.upgradeBatchTables = !geometryOnly;
+          gltfOptions.decodeAsyncSystem = asyncSystem;
+
+          // Identical content may already have been decoded for another tile.
+          std::optional<DecodedContentCache::Key> contentKey;
+          std::optional<CesiumGltf::Model> cachedModel;
+          if (pDecodedContentCache) {
+            contentKey = DecodedContentCache::computeKey(responseData);
+            cachedModel = pDecodedContentCache->find(*contentKey);
+          }
+
+          GltfConverterResult result;
+          if (cachedModel) {
+            result.model = std::move(cachedModel);
+          } else {
+            // Move the response data into the glTF instead of copying it, if
+            // the converter can take ownership of it.
+            GltfConverters::OwningConverterFunction owningConverter =
+                GltfConverters::getOwningConverterByMagic(responseData);
+            result = owningConverter
+                         ? owningConverter(
+                               pCompletedRequest->takeResponseData(),
+                               gltfOptions)
+                         : converter(responseData, gltfOptions);
+            if (contentKey && result.model && !result.errors) {
+              pDecodedContentCache->insert(*contentKey, *result.model);
+            }
+          }
 
           // Report any errors if there are any
           logTileLoadResult(pLogger, tileUrl, result.errors);
@@ -191,46 +288,47 @@ ImplicitOctreeLoader::loadTileContent(const TileLoadInput& loadInput) {
       ImplicitTilingUtilities::getSubtreeRootID(
           this->_subtreeLevels,
           *pOctreeID);
-  uint32_t subtreeLevelIdx = subtreeID.level / this->_subtreeLevels;
-  if (subtreeLevelIdx >= _loadedSubtrees.size()) {
+  if (subtreeID.level >= this->_availableLevels) {
     return asyncSystem.createResolvedFuture<TileLoadResult>(
         TileLoadResult::createFailedResult(nullptr));
   }
 
+  this->_subtreeRequest = ImplicitSubtreeRequest{
+      asyncSystem,
+      pAssetAccessor,
+      pLogger,
+      requestHeaders};
+  this->_pLoadedSubtrees->setMaximumBytes(
+      contentOptions.maximumCachedSubtreeBytes);
+
   uint64_t subtreeMortonIdx =
       ImplicitTilingUtilities::computeMortonIndex(subtreeID);
-  auto subtreeIt =
-      this->_loadedSubtrees[subtreeLevelIdx].find(subtreeMortonIdx);
-  if (subtreeIt == this->_loadedSubtrees[subtreeLevelIdx].end()) {
-    // subtree is not loaded, so load it now.
-    std::string subtreeUrl = ImplicitTilingUtilities::resolveUrl(
-        this->_baseUrl,
-        this->_subtreeUrlTemplate,
-        subtreeID);
-    return SubtreeAvailability::loadSubtree(
-               ImplicitTileSubdivisionScheme::Octree,
-               this->_subtreeLevels,
-               asyncSystem,
-               pAssetAccessor,
-               pLogger,
-               subtreeUrl,
-               requestHeaders)
-        .thenInMainThread([this, subtreeID](std::optional<SubtreeAvailability>&&
-                                                subtreeAvailability) mutable {
-          if (subtreeAvailability) {
-            this->addSubtreeAvailability(
-                subtreeID,
-                std::move(*subtreeAvailability));
-          }
+  // Only a load that the tileset will pair with an unload takes a reference.
+  // Fetching the model data of a tile again, after it was released, does not.
+  const bool isContentLoad = tile.getState() == TileLoadState::ContentLoading;
+
+  const SubtreeAvailability* pSubtreeAvailability =
+      this->_pLoadedSubtrees->find(subtreeID.level, subtreeMortonIdx);
+  if (!pSubtreeAvailability) {
+    // subtree is not loaded, so load it now, and tell client to retry later.
+    // This load holds no reference to release when it finishes.
+    if (isContentLoad) {
+      this->_tilesWaitingForSubtrees.insert(&tile);
+    }
+    return this->loadSubtree(subtreeID, *this->_subtreeRequest)
+        .thenImmediately(
+            []() { return TileLoadResult::createRetryLaterResult(nullptr); });
+  }
 
-          // tell client to retry later
-          return TileLoadResult::createRetryLaterResult(nullptr);
-        });
+  // Keep the subtree until the content is unloaded, even if it is empty, so
+  // that each load that finds the subtree releases exactly one reference.
+  if (isContentLoad) {
+    this->_pLoadedSubtrees->addReference(subtreeID.level, subtreeMortonIdx);
   }
 
   // subtree is available, so check if tile has content or not. If it has, then
   // request it
-  if (!subtreeIt->second.isContentAvailable(subtreeID, *pOctreeID, 0)) {
+  if (!pSubtreeAvailability->isContentAvailable(subtreeID, *pOctreeID, 0)) {
     // check if tile has empty content
     return asyncSystem.createResolvedFuture(TileLoadResult{
         TileEmptyContent{},
@@ -253,7 +351,14 @@ ImplicitOctreeLoader::loadTileContent(const TileLoadInput& loadInput) {
       pAssetAccessor,
       tileUrl,
       requestHeaders,
-      contentOptions.ktx2TranscodeTargets);
+      contentOptions.ktx2TranscodeTargets,
+      contentOptions.requiredAttributes,
+      contentOptions.optimizeMeshes,
+      contentOptions.geometryOnly,
+      contentOptions.pDecodedContentCache,
+      loadInput.pLoadCanceled,
+      loadInput.decodeThreadPool,
+      loadInput.priority);
 }
 
 TileChildrenResult ImplicitOctreeLoader::createTileChildren(const Tile& tile) {
@@ -267,19 +372,18 @@ TileChildrenResult ImplicitOctreeLoader::createTileChildren(const Tile& tile) {
           this->_subtreeLevels,
           *pOctreeID);
 
-  uint32_t subtreeLevelIdx = subtreeID.level / this->_subtreeLevels;
-  if (subtreeLevelIdx >= this->_loadedSubtrees.size()) {
+  if (subtreeID.level >= this->_availableLevels) {
     return {{}, TileLoadResultState::Failed};
   }
 
   uint64_t subtreeMortonIdx =
       ImplicitTilingUtilities::computeMortonIndex(subtreeID);
 
-  auto subtreeIt =
-      this->_loadedSubtrees[subtreeLevelIdx].find(subtreeMortonIdx);
-  if (subtreeIt != this->_loadedSubtrees[subtreeLevelIdx].end()) {
+  const SubtreeAvailability* pSubtreeAvailability =
+      this->_pLoadedSubtrees->find(subtreeID.level, subtreeMortonIdx);
+  if (pSubtreeAvailability) {
     auto children = populateSubtree(
-        subtreeIt->second,
+        *pSubtreeAvailability,
         this->_subtreeLevels,
         subtreeID,
         tile,
@@ -288,9 +392,101 @@ TileChildrenResult ImplicitOctreeLoader::createTileChildren(const Tile& tile) {
     return {std::move(children), TileLoadResultState::Success};
   }
 
+  // A tile that is not going to be loaded won't load the subtree, which may
+  // have been evicted since the tile was loaded. So load it here.
+  const TileLoadState state = tile.getState();
+  if (state != TileLoadState::Unloaded &&
+      state != TileLoadState::FailedTemporarily && this->_subtreeRequest) {
+    this->loadSubtree(subtreeID, *this->_subtreeRequest);
+  }
+
   return {{}, TileLoadResultState::RetryLater};
 }
 
+void ImplicitOctreeLoader::notifyTileContentUnloaded(const Tile& tile) {
+  if (this->_tilesWaitingForSubtrees.erase(&tile) > 0) {
+    return;
+  }
+
+  const CesiumGeometry::OctreeTileID* pOctreeID =
+      std::get_if<CesiumGeometry::OctreeTileID>(&tile.getTileID());
+  if (!pOctreeID) {
+    return;
+  }
+
+  CesiumGeometry::OctreeTileID subtreeID =
+      ImplicitTilingUtilities::getSubtreeRootID(
+          this->_subtreeLevels,
+          *pOctreeID);
+  this->_pLoadedSubtrees->removeReference(
+      subtreeID.level,
+      ImplicitTilingUtilities::computeMortonIndex(subtreeID));
+}
+
+void ImplicitOctreeLoader::addMemoryUsage(TilesetMemoryUsage& usage) const {
+  usage.availabilityBytes += this->_pLoadedSubtrees->getByteSize();
+}
+
+int64_t ImplicitOctreeLoader::trimMemory() {
+  return this->_pLoadedSubtrees->evictUnreferenced();
+}
+
+CesiumAsync::Future<void>
+ImplicitOctreeLoader::loadTileChildren(const TileLoadInput& loadInput) {
+  const CesiumGeometry::OctreeTileID* pOctreeID =
+      std::get_if<CesiumGeometry::OctreeTileID>(&loadInput.tile.getTileID());
+  if (!pOctreeID) {
+    return loadInput.asyncSystem.createResolvedFuture();
+  }
+
+  // The children are created from the subtree the tile is in.
+  CesiumGeometry::OctreeTileID subtreeID =
+      ImplicitTilingUtilities::getSubtreeRootID(
+          this->_subtreeLevels,
+          *pOctreeID);
+  if (subtreeID.level >= this->_availableLevels) {
+    return loadInput.asyncSystem.createResolvedFuture();
+  }
+
+  this->_subtreeRequest = ImplicitSubtreeRequest{
+      loadInput.asyncSystem,
+      loadInput.pAssetAccessor,
+      loadInput.pLogger,
+      loadInput.requestHeaders};
+  this->_pLoadedSubtrees->setMaximumBytes(
+      loadInput.contentOptions.maximumCachedSubtreeBytes);
+  return this->loadSubtree(subtreeID, *this->_subtreeRequest);
+}
+
+std::optional<std::string>
+ImplicitOctreeLoader::getTileContentUrl(const Tile& tile) const {
+  const CesiumGeometry::OctreeTileID* pOctreeID =
+      std::get_if<CesiumGeometry::OctreeTileID>(&tile.getTileID());
+  if (!pOctreeID) {
+    return std::nullopt;
+  }
+
+  // A tile that the loaded subtree says has no content has no URL either. If
+  // the subtree isn't loaded, the URL is known but might not exist.
+  CesiumGeometry::OctreeTileID subtreeID =
+      ImplicitTilingUtilities::getSubtreeRootID(
+          this->_subtreeLevels,
+          *pOctreeID);
+  const SubtreeAvailability* pSubtreeAvailability =
+      this->_pLoadedSubtrees->find(
+          subtreeID.level,
+          ImplicitTilingUtilities::computeMortonIndex(subtreeID));
+  if (pSubtreeAvailability &&
+      !pSubtreeAvailability->isContentAvailable(subtreeID, *pOctreeID, 0)) {
+    return std::nullopt;
+  }
+
+  return ImplicitTilingUtilities::resolveUrl(
+      this->_baseUrl,
+      this->_contentUrlTemplate,
+      *pOctreeID);
+}
+
 uint32_t ImplicitOctreeLoader::getSubtreeLevels() const noexcept {
   return this->_subtreeLevels;
 }
@@ -307,16 +503,58 @@ ImplicitOctreeLoader::getBoundingVolume() const noexcept {
 void ImplicitOctreeLoader::addSubtreeAvailability(
     const CesiumGeometry::OctreeTileID& subtreeID,
     SubtreeAvailability&& subtreeAvailability) {
-  uint32_t levelIndex = subtreeID.level / this->_subtreeLevels;
-  if (levelIndex >= this->_loadedSubtrees.size()) {
+  if (subtreeID.level >= this->_availableLevels) {
     return;
   }
 
-  uint64_t subtreeMortonID =
+  this->_pLoadedSubtrees->insert(
+      subtreeID.level,
+      ImplicitTilingUtilities::computeMortonIndex(subtreeID),
+      std::move(subtreeAvailability));
+}
+
+const ImplicitSubtreeStore&
+ImplicitOctreeLoader::getLoadedSubtrees() const noexcept {
+  return *this->_pLoadedSubtrees;
+}
+
+CesiumAsync::Future<void> ImplicitOctreeLoader::loadSubtree(
+    const CesiumGeometry::OctreeTileID& subtreeID,
+    const ImplicitSubtreeRequest& request) {
+  const uint64_t subtreeMortonIdx =
       ImplicitTilingUtilities::computeMortonIndex(subtreeID);
+  if (!this->_pLoadedSubtrees->startLoading(
+          subtreeID.level,
+          subtreeMortonIdx)) {
+    // The subtree is already loaded or being loaded.
+    return request.asyncSystem.createResolvedFuture();
+  }
 
-  this->_loadedSubtrees[levelIndex].insert_or_assign(
-      subtreeMortonID,
-      std::move(subtreeAvailability));
+  std::string subtreeUrl = ImplicitTilingUtilities::resolveUrl(
+      this->_baseUrl,
+      this->_subtreeUrlTemplate,
+      subtreeID);
+  return SubtreeAvailability::loadSubtree(
+             ImplicitTileSubdivisionScheme::Octree,
+             this->_subtreeLevels,
+             request.asyncSystem,
+             request.pAssetAccessor,
+             request.pLogger,
+             subtreeUrl,
+             request.requestHeaders)
+      .thenInMainThread(
+          [pLoadedSubtrees = this->_pLoadedSubtrees,
+           level = subtreeID.level,
+           subtreeMortonIdx](
+              std::optional<SubtreeAvailability>&& subtreeAvailability) {
+            if (subtreeAvailability) {
+              pLoadedSubtrees->insert(
+                  level,
+                  subtreeMortonIdx,
+                  std::move(*subtreeAvailability));
+            } else {
+              pLoadedSubtrees->cancelLoading(level, subtreeMortonIdx);
+            }
+          });
 }
 } // namespace Cesium3DTilesSelection
@@ -1,14 +1,18 @@
 #pragma once
 
+#include "ImplicitSubtreeStore.h"
+
 #include <Cesium3DTilesContent/SubtreeAvailability.h>
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 #include <CesiumGeometry/OctreeTileID.h>
 #include <CesiumGeometry/OrientedBoundingBox.h>
 #include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumUtility/Uri.h>
 
-#include <cmath>
+#include <memory>
+#include <optional>
 #include <string>
-#include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
@@ -33,15 +37,27 @@ public:
         _subtreeLevels{subtreeLevels},
         _availableLevels{availableLevels},
         _boundingVolume{std::forward<ImplicitBoundingVolumeType>(volume)},
-        _loadedSubtrees(static_cast<size_t>(std::ceil(
-            static_cast<float>(availableLevels) /
-            static_cast<float>(subtreeLevels)))) {}
+        _pLoadedSubtrees{std::make_shared<ImplicitSubtreeStore>()},
+        _subtreeRequest{},
+        _tilesWaitingForSubtrees{} {}
 
   CesiumAsync::Future<TileLoadResult>
   loadTileContent(const TileLoadInput& loadInput) override;
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
 
+  void notifyTileContentUnloaded(const Tile& tile) override;
+
+  void addMemoryUsage(TilesetMemoryUsage& usage) const override;
+
+  int64_t trimMemory() override;
+
+  CesiumAsync::Future<void>
+  loadTileChildren(const TileLoadInput& loadInput) override;
+
+  std::optional<std::string>
+  getTileContentUrl(const Tile& tile) const override;
+
   uint32_t getSubtreeLevels() const noexcept;
 
   uint32_t getAvailableLevels() const noexcept;
@@ -52,15 +68,30 @@ public:
       const CesiumGeometry::OctreeTileID& subtreeID,
       Cesium3DTilesContent::SubtreeAvailability&& subtreeAvailability);
 
+  const ImplicitSubtreeStore& getLoadedSubtrees() const noexcept;
+
 private:
-  std::string _baseUrl;
+  CesiumAsync::Future<void> loadSubtree(
+      const CesiumGeometry::OctreeTileID& subtreeID,
+      const ImplicitSubtreeRequest& request);
+
+  CesiumUtility::BaseUri _baseUrl;
   std::string _contentUrlTemplate;
   std::string _subtreeUrlTemplate;
   uint32_t _subtreeLevels;
   uint32_t _availableLevels;
   ImplicitOctreeBoundingVolume _boundingVolume;
-  std::vector<
-      std::unordered_map<uint64_t, Cesium3DTilesContent::SubtreeAvailability>>
-      _loadedSubtrees;
+
+  // Shared with the continuations of subtree loads, which may outlive the
+  // loader.
+  std::shared_ptr<ImplicitSubtreeStore> _pLoadedSubtrees;
+
+  // From the last call to loadTileContent, so that createTileChildren can
+  // load a subtree again after it has been evicted.
+  std::optional<ImplicitSubtreeRequest> _subtreeRequest;
+
+  // The tiles whose loads are waiting for their subtree to load, and so did
+  // not add a reference to it.
+  std::unordered_set<const Tile*> _tilesWaitingForSubtrees;
 };
 } // namespace Cesium3DTilesSelection
@@ -1,9 +1,11 @@
 #include "ImplicitQuadtreeLoader.h"
 
+#include "DecodeThread.h"
 #include "logTileLoadResult.h"
 
 #include <Cesium3DTilesContent/GltfConverters.h>
 #include <Cesium3DTilesContent/ImplicitTilingUtilities.h>
+#include <Cesium3DTilesSelection/DecodedContentCache.h>
 #include <Cesium3DTilesSelection/Tile.h>
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumGeometry/QuadtreeTileID.h>
@@ -11,6 +13,8 @@
 
 #include <spdlog/logger.h>
 
+#include <atomic>
+#include <optional>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -60,8 +64,33 @@ std::vector<Tile> populateSubtree(
 
   QuadtreeChildren childIDs = ImplicitTilingUtilities::getChildren(quadtreeID);
 
+  // The children are kept for the lifetime of the tileset, so count the
+  // available ones first and allocate exactly that many. Most tiles in a
+  // sparse tileset are leaves, which then don't allocate at all.
+  const uint32_t relativeChildLevel = relativeTileLevel + 1;
+  size_t availableChildren = 0;
+  for (const CesiumGeometry::QuadtreeTileID& childID : childIDs) {
+    uint64_t relativeChildMortonID =
+        ImplicitTilingUtilities::computeRelativeMortonIndex(
+            subtreeRootID,
+            childID);
+    const bool isAvailable =
+        relativeChildLevel == subtreeLevels
+            ? subtreeAvailability.isSubtreeAvailable(relativeChildMortonID)
+            : subtreeAvailability.isTileAvailable(
+                  relativeChildLevel,
+                  relativeChildMortonID);
+    if (isAvailable) {
+      ++availableChildren;
+    }
+  }
+
+  if (availableChildren == 0) {
+    return {};
+  }
+
   std::vector<Tile> children;
-  children.reserve(childIDs.size());
+  children.reserve(availableChildren);
 
   for (const CesiumGeometry::QuadtreeTileID& childID : childIDs) {
     uint64_t relativeChildMortonID =
@@ -69,7 +98,6 @@ std::vector<Tile> populateSubtree(
             subtreeRootID,
             childID);
 
-    uint32_t relativeChildLevel = relativeTileLevel + 1;
     if (relativeChildLevel == subtreeLevels) {
       if (subtreeAvailability.isSubtreeAvailable(relativeChildMortonID)) {
         Tile& child = children.emplace_back(&loader);
@@ -113,11 +141,34 @@ CesiumAsync::Future<TileLoadResult> requestTileContent(
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
     const std::string& tileUrl,
     const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
-    CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets) {
-  return pAssetAccessor->get(asyncSystem, tileUrl, requestHeaders)
-      .thenInWorkerThread([pLogger, ktx2TranscodeTargets](
-                              std::shared_ptr<CesiumAsync::IAssetRequest>&&
-                                  pCompletedRequest) mutable {
+    CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets,
+    const std::optional<std::vector<std::string>>& requiredAttributes,
+    bool optimizeMeshes,
+    bool geometryOnly,
+    const std::shared_ptr<DecodedContentCache>& pDecodedContentCache,
+    const std::shared_ptr<const std::atomic<bool>>& pLoadCanceled,
+    const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool,
+    const CesiumAsync::TaskPriority& priority) {
+  return thenInDecodeThread(
+      pAssetAccessor->get(asyncSystem, tileUrl, requestHeaders),
+      decodeThreadPool,
+      priority,
+      [asyncSystem,
+       pLogger,
+       ktx2TranscodeTargets,
+       requiredAttributes,
+       optimizeMeshes,
+       geometryOnly,
+       pDecodedContentCache,
+       pLoadCanceled](
+          std::shared_ptr<CesiumAsync::IAssetRequest>&&
+              pCompletedRequest) mutable {
+        // Don't decode the content of a tile that is no longer needed.
+        if (pLoadCanceled && *pLoadCanceled) {
+          return TileLoadResult::createRetryLaterResult(
+              std::move(pCompletedRequest));
+        }
+
         const CesiumAsync::IAssetResponse* pResponse =
             pCompletedRequest->response();
         const std::string& tileUrl = pCompletedRequest->url();
@@ -153,7 +204,37 @@ CesiumAsync::Future<TileLoadResult> requestTileContent(
           // Convert to gltf
           CesiumGltfReader::GltfReaderOptions gltfOptions;
           gltfOptions.ktx2TranscodeTargets = ktx2TranscodeTargets;
-          GltfConverterResult result = converter(responseData, gltfOptions);
+          gltfOptions.requiredAttributes = requiredAttributes;
+          gltfOptions.optimizeMeshes = optimizeMeshes;
+          gltfOptions.loadImages = !geometryOnly;
+          gltfOptions.upgradeBatchTables = !geometryOnly;
+          gltfOptions.decodeAsyncSystem = asyncSystem;
+
+          // Identical content may already have been decoded for another tile.
+          std::optional<DecodedContentCache::Key> contentKey;
+          std::optional<CesiumGltf::Model> cachedModel;
+          if (pDecodedContentCache) {
+            contentKey = DecodedContentCache::computeKey(responseData);
+            cachedModel = pDecodedContentCache->find(*contentKey);
+          }
+
+          GltfConverterResult result;
+          if (cachedModel) {
+            result.model = std::move(cachedModel);
+          } else {
+            // Move the response data into the glTF instead of copying it, if
+            // the converter can take ownership of it.
+            GltfConverters::OwningConverterFunction owningConverter =
+                GltfConverters::getOwningConverterByMagic(responseData);
+            result = owningConverter
+                         ? owningConverter(
+                               pCompletedRequest->takeResponseData(),
+                               gltfOptions)
+                         : converter(responseData, gltfOptions);
+            if (contentKey && result.model && !result.errors) {
+              pDecodedContentCache->insert(*contentKey, *result.model);
+            }
+          }
 
           // Report any errors if there are any
           logTileLoadResult(pLogger, tileUrl, result.errors);
@@ -219,12 +300,19 @@ ImplicitQuadtreeLoader::loadTileContent(const TileLoadInput& loadInput) {
       ImplicitTilingUtilities::getSubtreeRootID(
           this->_subtreeLevels,
           *pQuadtreeID);
-  uint32_t subtreeLevelIdx = subtreeID.level / this->_subtreeLevels;
-  if (subtreeLevelIdx >= _loadedSubtrees.size()) {
+  if (subtreeID.level >= this->_availableLevels) {
     return asyncSystem.createResolvedFuture<TileLoadResult>(
         TileLoadResult::createFailedResult(nullptr));
   }
 
+  this->_subtreeRequest = ImplicitSubtreeRequest{
+      asyncSystem,
+      pAssetAccessor,
+      pLogger,
+      requestHeaders};
+  this->_pLoadedSubtrees->setMaximumBytes(
+      contentOptions.maximumCachedSubtreeBytes);
+
   // the below morton index hash to the subtree assumes that tileID's components
   // x and y never exceed 32-bit. In other words, the max levels this loader can
   // support is 33 which will have 4^32 tiles in the level 32th. The 64-bit
@@ -238,38 +326,32 @@ ImplicitQuadtreeLoader::loadTileContent(const TileLoadInput& loadInput) {
   // tilesets that exceeds 33 levels are expected to be very rare
   uint64_t subtreeMortonIdx =
       ImplicitTilingUtilities::computeMortonIndex(subtreeID);
-  auto subtreeIt =
-      this->_loadedSubtrees[subtreeLevelIdx].find(subtreeMortonIdx);
-  if (subtreeIt == this->_loadedSubtrees[subtreeLevelIdx].end()) {
-    // subtree is not loaded, so load it now.
-    std::string subtreeUrl = ImplicitTilingUtilities::resolveUrl(
-        this->_baseUrl,
-        this->_subtreeUrlTemplate,
-        subtreeID);
-    return SubtreeAvailability::loadSubtree(
-               ImplicitTileSubdivisionScheme::Quadtree,
-               this->_subtreeLevels,
-               asyncSystem,
-               pAssetAccessor,
-               pLogger,
-               subtreeUrl,
-               requestHeaders)
-        .thenInMainThread([this, subtreeID](std::optional<SubtreeAvailability>&&
-                                                subtreeAvailability) mutable {
-          if (subtreeAvailability) {
-            this->addSubtreeAvailability(
-                subtreeID,
-                std::move(*subtreeAvailability));
-          }
+  // Only a load that the tileset will pair with an unload takes a reference.
+  // Fetching the model data of a tile again, after it was released, does not.
+  const bool isContentLoad = tile.getState() == TileLoadState::ContentLoading;
+
+  const SubtreeAvailability* pSubtreeAvailability =
+      this->_pLoadedSubtrees->find(subtreeID.level, subtreeMortonIdx);
+  if (!pSubtreeAvailability) {
+    // subtree is not loaded, so load it now, and tell client to retry later.
+    // This load holds no reference to release when it finishes.
+    if (isContentLoad) {
+      this->_tilesWaitingForSubtrees.insert(&tile);
+    }
+    return this->loadSubtree(subtreeID, *this->_subtreeRequest)
+        .thenImmediately(
+            []() { return TileLoadResult::createRetryLaterResult(nullptr); });
+  }
 
-          // tell client to retry later
-          return TileLoadResult::createRetryLaterResult(nullptr);
-        });
+  // Keep the subtree until the content is unloaded, even if it is empty, so
+  // that each load that finds the subtree releases exactly one reference.
+  if (isContentLoad) {
+    this->_pLoadedSubtrees->addReference(subtreeID.level, subtreeMortonIdx);
   }
 
   // subtree is available, so check if tile has content or not. If it has, then
   // request it
-  if (!subtreeIt->second.isContentAvailable(subtreeID, *pQuadtreeID, 0)) {
+  if (!pSubtreeAvailability->isContentAvailable(subtreeID, *pQuadtreeID, 0)) {
     // check if tile has empty content
     return asyncSystem.createResolvedFuture(TileLoadResult{
         TileEmptyContent{},
@@ -292,7 +374,14 @@ ImplicitQuadtreeLoader::loadTileContent(const TileLoadInput& loadInput) {
       pAssetAccessor,
       tileUrl,
       requestHeaders,
-      contentOptions.ktx2TranscodeTargets);
+      contentOptions.ktx2TranscodeTargets,
+      contentOptions.requiredAttributes,
+      contentOptions.optimizeMeshes,
+      contentOptions.geometryOnly,
+      contentOptions.pDecodedContentCache,
+      loadInput.pLoadCanceled,
+      loadInput.decodeThreadPool,
+      loadInput.priority);
 }
 
 TileChildrenResult
@@ -307,19 +396,18 @@ ImplicitQuadtreeLoader::createTileChildren(const Tile& tile) {
           this->_subtreeLevels,
           *pQuadtreeID);
 
-  uint32_t subtreeLevelIdx = subtreeID.level / this->_subtreeLevels;
-  if (subtreeLevelIdx >= this->_loadedSubtrees.size()) {
+  if (subtreeID.level >= this->_availableLevels) {
     return {{}, TileLoadResultState::Failed};
   }
 
   uint64_t subtreeMortonIdx =
       ImplicitTilingUtilities::computeMortonIndex(subtreeID);
 
-  auto subtreeIt =
-      this->_loadedSubtrees[subtreeLevelIdx].find(subtreeMortonIdx);
-  if (subtreeIt != this->_loadedSubtrees[subtreeLevelIdx].end()) {
+  const SubtreeAvailability* pSubtreeAvailability =
+      this->_pLoadedSubtrees->find(subtreeID.level, subtreeMortonIdx);
+  if (pSubtreeAvailability) {
     auto children = populateSubtree(
-        subtreeIt->second,
+        *pSubtreeAvailability,
         this->_subtreeLevels,
         subtreeID,
         tile,
@@ -328,9 +416,101 @@ ImplicitQuadtreeLoader::createTileChildren(const Tile& tile) {
     return {std::move(children), TileLoadResultState::Success};
   }
 
+  // A tile that is not going to be loaded won't load the subtree, which may
+  // have been evicted since the tile was loaded. So load it here.
+  const TileLoadState state = tile.getState();
+  if (state != TileLoadState::Unloaded &&
+      state != TileLoadState::FailedTemporarily && this->_subtreeRequest) {
+    this->loadSubtree(subtreeID, *this->_subtreeRequest);
+  }
+
   return {{}, TileLoadResultState::RetryLater};
 }
 
+void ImplicitQuadtreeLoader::notifyTileContentUnloaded(const Tile& tile) {
+  if (this->_tilesWaitingForSubtrees.erase(&tile) > 0) {
+    return;
+  }
+
+  const CesiumGeometry::QuadtreeTileID* pQuadtreeID =
+      std::get_if<CesiumGeometry::QuadtreeTileID>(&tile.getTileID());
+  if (!pQuadtreeID) {
+    return;
+  }
+
+  CesiumGeometry::QuadtreeTileID subtreeID =
+      ImplicitTilingUtilities::getSubtreeRootID(
+          this->_subtreeLevels,
+          *pQuadtreeID);
+  this->_pLoadedSubtrees->removeReference(
+      subtreeID.level,
+      ImplicitTilingUtilities::computeMortonIndex(subtreeID));
+}
+
+void ImplicitQuadtreeLoader::addMemoryUsage(TilesetMemoryUsage& usage) const {
+  usage.availabilityBytes += this->_pLoadedSubtrees->getByteSize();
+}
+
+int64_t ImplicitQuadtreeLoader::trimMemory() {
+  return this->_pLoadedSubtrees->evictUnreferenced();
+}
+
+CesiumAsync::Future<void>
+ImplicitQuadtreeLoader::loadTileChildren(const TileLoadInput& loadInput) {
+  const CesiumGeometry::QuadtreeTileID* pQuadtreeID =
+      std::get_if<CesiumGeometry::QuadtreeTileID>(&loadInput.tile.getTileID());
+  if (!pQuadtreeID) {
+    return loadInput.asyncSystem.createResolvedFuture();
+  }
+
+  // The children are created from the subtree the tile is in.
+  CesiumGeometry::QuadtreeTileID subtreeID =
+      ImplicitTilingUtilities::getSubtreeRootID(
+          this->_subtreeLevels,
+          *pQuadtreeID);
+  if (subtreeID.level >= this->_availableLevels) {
+    return loadInput.asyncSystem.createResolvedFuture();
+  }
+
+  this->_subtreeRequest = ImplicitSubtreeRequest{
+      loadInput.asyncSystem,
+      loadInput.pAssetAccessor,
+      loadInput.pLogger,
+      loadInput.requestHeaders};
+  this->_pLoadedSubtrees->setMaximumBytes(
+      loadInput.contentOptions.maximumCachedSubtreeBytes);
+  return this->loadSubtree(subtreeID, *this->_subtreeRequest);
+}
+
+std::optional<std::string>
+ImplicitQuadtreeLoader::getTileContentUrl(const Tile& tile) const {
+  const CesiumGeometry::QuadtreeTileID* pQuadtreeID =
+      std::get_if<CesiumGeometry::QuadtreeTileID>(&tile.getTileID());
+  if (!pQuadtreeID) {
+    return std::nullopt;
+  }
+
+  // A tile that the loaded subtree says has no content has no URL either. If
+  // the subtree isn't loaded, the URL is known but might not exist.
+  CesiumGeometry::QuadtreeTileID subtreeID =
+      ImplicitTilingUtilities::getSubtreeRootID(
+          this->_subtreeLevels,
+          *pQuadtreeID);
+  const SubtreeAvailability* pSubtreeAvailability =
+      this->_pLoadedSubtrees->find(
+          subtreeID.level,
+          ImplicitTilingUtilities::computeMortonIndex(subtreeID));
+  if (pSubtreeAvailability &&
+      !pSubtreeAvailability->isContentAvailable(subtreeID, *pQuadtreeID, 0)) {
+    return std::nullopt;
+  }
+
+  return ImplicitTilingUtilities::resolveUrl(
+      this->_baseUrl,
+      this->_contentUrlTemplate,
+      *pQuadtreeID);
+}
+
 uint32_t ImplicitQuadtreeLoader::getSubtreeLevels() const noexcept {
   return this->_subtreeLevels;
 }
@@ -347,16 +527,58 @@ ImplicitQuadtreeLoader::getBoundingVolume() const noexcept {
 void ImplicitQuadtreeLoader::addSubtreeAvailability(
     const CesiumGeometry::QuadtreeTileID& subtreeID,
     SubtreeAvailability&& subtreeAvailability) {
-  uint32_t levelIndex = subtreeID.level / this->_subtreeLevels;
-  if (levelIndex >= this->_loadedSubtrees.size()) {
+  if (subtreeID.level >= this->_availableLevels) {
     return;
   }
 
-  uint64_t subtreeMortonID =
+  this->_pLoadedSubtrees->insert(
+      subtreeID.level,
+      ImplicitTilingUtilities::computeMortonIndex(subtreeID),
+      std::move(subtreeAvailability));
+}
+
+const ImplicitSubtreeStore&
+ImplicitQuadtreeLoader::getLoadedSubtrees() const noexcept {
+  return *this->_pLoadedSubtrees;
+}
+
+CesiumAsync::Future<void> ImplicitQuadtreeLoader::loadSubtree(
+    const CesiumGeometry::QuadtreeTileID& subtreeID,
+    const ImplicitSubtreeRequest& request) {
+  const uint64_t subtreeMortonIdx =
       ImplicitTilingUtilities::computeMortonIndex(subtreeID);
+  if (!this->_pLoadedSubtrees->startLoading(
+          subtreeID.level,
+          subtreeMortonIdx)) {
+    // The subtree is already loaded or being loaded.
+    return request.asyncSystem.createResolvedFuture();
+  }
 
-  this->_loadedSubtrees[levelIndex].insert_or_assign(
-      subtreeMortonID,
-      std::move(subtreeAvailability));
+  std::string subtreeUrl = ImplicitTilingUtilities::resolveUrl(
+      this->_baseUrl,
+      this->_subtreeUrlTemplate,
+      subtreeID);
+  return SubtreeAvailability::loadSubtree(
+             ImplicitTileSubdivisionScheme::Quadtree,
+             this->_subtreeLevels,
+             request.asyncSystem,
+             request.pAssetAccessor,
+             request.pLogger,
+             subtreeUrl,
+             request.requestHeaders)
+      .thenInMainThread(
+          [pLoadedSubtrees = this->_pLoadedSubtrees,
+           level = subtreeID.level,
+           subtreeMortonIdx](
+              std::optional<SubtreeAvailability>&& subtreeAvailability) {
+            if (subtreeAvailability) {
+              pLoadedSubtrees->insert(
+                  level,
+                  subtreeMortonIdx,
+                  std::move(*subtreeAvailability));
+            } else {
+              pLoadedSubtrees->cancelLoading(level, subtreeMortonIdx);
+            }
+          });
 }
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,269 @@
+#include "ImplicitSubtreeStore.h"
+
+#include <Cesium3DTiles/Subtree.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+
+using namespace Cesium3DTilesContent;
+
+namespace Cesium3DTilesSelection {
+namespace {
+// The table grows to keep at least a quarter of its slots free, so that
+// probe sequences stay short.
+bool isTooFull(size_t occupiedCount, size_t capacity) noexcept {
+  return (occupiedCount + 1) * 4 > capacity * 3;
+}
+
+int64_t computeByteSize(const SubtreeAvailability& subtreeAvailability) {
+  int64_t byteSize = static_cast<int64_t>(sizeof(SubtreeAvailability));
+  for (const Cesium3DTiles::Buffer& buffer :
+       subtreeAvailability.getSubtree().buffers) {
+    byteSize += static_cast<int64_t>(buffer.cesium.data.size());
+  }
+  return byteSize;
+}
+} // namespace
+
+ImplicitSubtreeStore::ImplicitSubtreeStore() noexcept
+    : _entries(),
+      _evictionCandidates(),
+      _occupiedCount(0),
+      _loadedCount(0),
+      _byteSize(0),
+      _maximumBytes(std::numeric_limits<int64_t>::max()),
+      _useCounter(0) {}
+
+const SubtreeAvailability*
+ImplicitSubtreeStore::find(uint32_t level, uint64_t mortonIndex) noexcept {
+  const size_t slot = this->findSlot(level, mortonIndex);
+  if (slot >= this->_entries.size()) {
+    return nullptr;
+  }
+
+  Entry& entry = this->_entries[slot];
+  if (!entry.isOccupied || !entry.availability) {
+    return nullptr;
+  }
+
+  entry.lastUsed = ++this->_useCounter;
+  return &*entry.availability;
+}
+
+bool ImplicitSubtreeStore::startLoading(uint32_t level, uint64_t mortonIndex) {
+  const size_t slot = this->findSlot(level, mortonIndex);
+  if (slot < this->_entries.size() && this->_entries[slot].isOccupied) {
+    return false;
+  }
+
+  this->occupy(level, mortonIndex);
+  return true;
+}
+
+void ImplicitSubtreeStore::cancelLoading(
+    uint32_t level,
+    uint64_t mortonIndex) noexcept {
+  const size_t slot = this->findSlot(level, mortonIndex);
+  if (slot < this->_entries.size() && this->_entries[slot].isOccupied &&
+      !this->_entries[slot].availability) {
+    this->erase(slot);
+  }
+}
+
+void ImplicitSubtreeStore::insert(
+    uint32_t level,
+    uint64_t mortonIndex,
+    SubtreeAvailability&& subtreeAvailability) {
+  Entry& entry = this->occupy(level, mortonIndex);
+  if (entry.availability) {
+    this->_byteSize -= entry.byteSize;
+  } else {
+    ++this->_loadedCount;
+  }
+
+  entry.byteSize = computeByteSize(subtreeAvailability);
+  entry.availability = std::move(subtreeAvailability);
+  entry.lastUsed = ++this->_useCounter;
+  this->_byteSize += entry.byteSize;
+
+  this->evict(level, mortonIndex);
+}
+
+void ImplicitSubtreeStore::addReference(
+    uint32_t level,
+    uint64_t mortonIndex) noexcept {
+  const size_t slot = this->findSlot(level, mortonIndex);
+  if (slot >= this->_entries.size() || !this->_entries[slot].availability) {
+    return;
+  }
+
+  ++this->_entries[slot].referenceCount;
+}
+
+void ImplicitSubtreeStore::removeReference(
+    uint32_t level,
+    uint64_t mortonIndex) noexcept {
+  const size_t slot = this->findSlot(level, mortonIndex);
+  if (slot >= this->_entries.size() || !this->_entries[slot].availability) {
+    return;
+  }
+
+  // A referenced subtree is never evicted, so every reference that is
+  // released was added to this same entry.
+  Entry& entry = this->_entries[slot];
+  assert(entry.referenceCount > 0 && "Subtree references are unbalanced");
+  if (entry.referenceCount > 0) {
+    --entry.referenceCount;
+  }
+}
+
+// Returns the slot that holds the subtree, or else the free slot where it
+// would go, or the size of the table if the table has no slots.
+size_t ImplicitSubtreeStore::findSlot(uint32_t level, uint64_t mortonIndex)
+    const noexcept {
+  if (this->_entries.empty()) {
+    return 0;
+  }
+
+  const size_t mask = this->_entries.size() - 1;
+  size_t slot = this->getHomeSlot(level, mortonIndex);
+  while (this->_entries[slot].isOccupied) {
+    const Entry& entry = this->_entries[slot];
+    if (entry.level == level && entry.mortonIndex == mortonIndex) {
+      return slot;
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  return slot;
+}
+
+size_t ImplicitSubtreeStore::getHomeSlot(uint32_t level, uint64_t mortonIndex)
+    const noexcept {
+  // The splitmix64 finalizer spreads the nearby Morton indices of neighboring
+  // subtrees over the whole table.
+  uint64_t hash = mortonIndex + (uint64_t(level) << 58) + level;
+  hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+  hash ^= hash >> 31;
+  return static_cast<size_t>(hash) & (this->_entries.size() - 1);
+}
+
+ImplicitSubtreeStore::Entry&
+ImplicitSubtreeStore::occupy(uint32_t level, uint64_t mortonIndex) {
+  size_t slot = this->findSlot(level, mortonIndex);
+  if (slot < this->_entries.size() && this->_entries[slot].isOccupied) {
+    return this->_entries[slot];
+  }
+
+  if (isTooFull(this->_occupiedCount, this->_entries.size())) {
+    std::vector<Entry> oldEntries = std::move(this->_entries);
+    this->_entries =
+        std::vector<Entry>(std::max(oldEntries.size() * 2, size_t(16)));
+    for (Entry& oldEntry : oldEntries) {
+      if (oldEntry.isOccupied) {
+        const size_t newSlot =
+            this->findSlot(oldEntry.level, oldEntry.mortonIndex);
+        this->_entries[newSlot] = std::move(oldEntry);
+      }
+    }
+
+    slot = this->findSlot(level, mortonIndex);
+  }
+
+  Entry& entry = this->_entries[slot];
+  entry.level = level;
+  entry.mortonIndex = mortonIndex;
+  entry.isOccupied = true;
+  ++this->_occupiedCount;
+  return entry;
+}
+
+// Frees a slot, then moves later entries of the same probe sequence back into
+// the gap, so that lookups never need to skip over removed entries.
+void ImplicitSubtreeStore::erase(size_t slot) noexcept {
+  Entry& erased = this->_entries[slot];
+  if (erased.availability) {
+    this->_byteSize -= erased.byteSize;
+    --this->_loadedCount;
+  }
+  erased = Entry();
+  --this->_occupiedCount;
+
+  const size_t mask = this->_entries.size() - 1;
+  size_t hole = slot;
+  size_t next = (slot + 1) & mask;
+  while (this->_entries[next].isOccupied) {
+    Entry& entry = this->_entries[next];
+    const size_t home = this->getHomeSlot(entry.level, entry.mortonIndex);
+
+    // The entry can stay if its home slot is after the hole, up to and
+    // including where it is now.
+    const bool canStay = hole <= next ? hole < home && home <= next
+                                      : hole < home || home <= next;
+    if (!canStay) {
+      this->_entries[hole] = std::move(entry);
+      entry = Entry();
+      hole = next;
+    }
+
+    next = (next + 1) & mask;
+  }
+}
+
+int64_t ImplicitSubtreeStore::evictUnreferenced() {
+  const int64_t byteSize = this->_byteSize;
+  const int64_t maximumBytes = this->_maximumBytes;
+
+  // No subtree has a root at the maximum level, so none is kept.
+  this->_maximumBytes = 0;
+  this->evict(
+      std::numeric_limits<uint32_t>::max(),
+      std::numeric_limits<uint64_t>::max());
+  this->_maximumBytes = maximumBytes;
+
+  return byteSize - this->_byteSize;
+}
+
+void ImplicitSubtreeStore::evict(
+    uint32_t keepLevel,
+    uint64_t keepMortonIndex) {
+  if (this->_byteSize <= this->_maximumBytes) {
+    return;
+  }
+
+  // The table is scanned once for the subtrees that may be evicted, which are
+  // then evicted from the least recently used until the store is within
+  // budget, or until only referenced subtrees are left.
+  std::vector<EvictionCandidate>& candidates = this->_evictionCandidates;
+  candidates.clear();
+  for (const Entry& entry : this->_entries) {
+    if (!entry.availability || entry.referenceCount > 0 ||
+        (entry.level == keepLevel && entry.mortonIndex == keepMortonIndex)) {
+      continue;
+    }
+
+    candidates.push_back({entry.lastUsed, entry.level, entry.mortonIndex});
+  }
+
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const EvictionCandidate& a, const EvictionCandidate& b) {
+        return a.lastUsed < b.lastUsed;
+      });
+
+  // Erasing moves entries to other slots, so each candidate is looked up
+  // again by its key.
+  for (const EvictionCandidate& candidate : candidates) {
+    if (this->_byteSize <= this->_maximumBytes) {
+      break;
+    }
+
+    this->erase(this->findSlot(candidate.level, candidate.mortonIndex));
+  }
+}
+
+} // namespace Cesium3DTilesSelection
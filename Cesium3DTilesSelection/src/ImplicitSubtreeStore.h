@@ -0,0 +1,191 @@
+#pragma once
+
+#include <Cesium3DTilesContent/SubtreeAvailability.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+
+#include <spdlog/fwd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief What an implicit loader needs to request a subtree.
+ *
+ * A loader keeps the one from its last tile load, so that it can load a
+ * subtree that has been evicted again when it needs it to create children.
+ */
+struct ImplicitSubtreeRequest {
+  CesiumAsync::AsyncSystem asyncSystem;
+  std::shared_ptr<CesiumAsync::IAssetAccessor> pAssetAccessor;
+  std::shared_ptr<spdlog::logger> pLogger;
+  std::vector<CesiumAsync::IAssetAccessor::THeader> requestHeaders;
+};
+
+/**
+ * @brief The subtrees of an implicit tileset, keyed by the level and Morton
+ * index of their root tiles.
+ *
+ * The subtrees are kept in a single open-addressing hash table. A tile whose
+ * content was loaded according to a subtree holds a reference to it until
+ * that content is unloaded. When the subtrees take more than
+ * {@link getMaximumBytes}, the least recently used subtrees that no tile
+ * references are evicted. An evicted subtree is simply loaded again when it
+ * is needed.
+ *
+ * The store must only be used from the main thread.
+ */
+class ImplicitSubtreeStore {
+public:
+  /**
+   * @brief Creates an empty store.
+   */
+  ImplicitSubtreeStore() noexcept;
+
+  /**
+   * @brief Finds a loaded subtree, and marks it as recently used.
+   *
+   * The returned pointer is only valid until the next call to
+   * {@link startLoading}, {@link cancelLoading}, {@link insert} or
+   * {@link evictUnreferenced}. These add or remove entries of the hash table,
+   * which moves other entries to new slots when the table grows, and when a
+   * removed entry leaves a gap in a probe sequence.
+   *
+   * @param level The level of the root tile of the subtree.
+   * @param mortonIndex The Morton index of the root tile of the subtree.
+   * @return The subtree, or nullptr if it is not loaded.
+   */
+  const Cesium3DTilesContent::SubtreeAvailability*
+  find(uint32_t level, uint64_t mortonIndex) noexcept;
+
+  /**
+   * @brief Records that a subtree is being loaded.
+   *
+   * @param level The level of the root tile of the subtree.
+   * @param mortonIndex The Morton index of the root tile of the subtree.
+   * @return False if the subtree is already loaded or being loaded, in which
+   * case it should not be loaded again.
+   */
+  bool startLoading(uint32_t level, uint64_t mortonIndex);
+
+  /**
+   * @brief Forgets about a subtree that failed to load, so that it can be
+   * loaded again.
+   *
+   * Does nothing if the subtree is loaded.
+   *
+   * @param level The level of the root tile of the subtree.
+   * @param mortonIndex The Morton index of the root tile of the subtree.
+   */
+  void cancelLoading(uint32_t level, uint64_t mortonIndex) noexcept;
+
+  /**
+   * @brief Adds a loaded subtree, replacing any that has the same root, and
+   * evicts unreferenced subtrees while over {@link getMaximumBytes}.
+   *
+   * The added subtree itself is never evicted here.
+   *
+   * @param level The level of the root tile of the subtree.
+   * @param mortonIndex The Morton index of the root tile of the subtree.
+   * @param subtreeAvailability The subtree.
+   */
+  void insert(
+      uint32_t level,
+      uint64_t mortonIndex,
+      Cesium3DTilesContent::SubtreeAvailability&& subtreeAvailability);
+
+  /**
+   * @brief Records that the content of a tile is loaded according to a
+   * subtree, which keeps the subtree from being evicted.
+   *
+   * The subtrees only count their references, so each call must be paired
+   * with one call to {@link removeReference} when the content is unloaded.
+   * Does nothing if the subtree is not loaded.
+   *
+   * @param level The level of the root tile of the subtree.
+   * @param mortonIndex The Morton index of the root tile of the subtree.
+   */
+  void addReference(uint32_t level, uint64_t mortonIndex) noexcept;
+
+  /**
+   * @brief Releases a reference added with {@link addReference}.
+   *
+   * Does nothing if the subtree is not loaded.
+   *
+   * @param level The level of the root tile of the subtree.
+   * @param mortonIndex The Morton index of the root tile of the subtree.
+   */
+  void removeReference(uint32_t level, uint64_t mortonIndex) noexcept;
+
+  /**
+   * @brief Evicts all of the subtrees that are not referenced by a tile with
+   * loaded content.
+   *
+   * @return The number of bytes freed.
+   */
+  int64_t evictUnreferenced();
+
+  /**
+   * @brief Gets the number of bytes that loaded subtrees may take before
+   * unreferenced subtrees are evicted.
+   */
+  int64_t getMaximumBytes() const noexcept { return this->_maximumBytes; }
+
+  /**
+   * @brief Sets the number of bytes that loaded subtrees may take before
+   * unreferenced subtrees are evicted.
+   *
+   * This takes effect the next time a subtree is added.
+   */
+  void setMaximumBytes(int64_t maximumBytes) noexcept {
+    this->_maximumBytes = maximumBytes;
+  }
+
+  /**
+   * @brief Gets the number of subtrees that are loaded.
+   */
+  size_t getLoadedCount() const noexcept { return this->_loadedCount; }
+
+  /**
+   * @brief Gets the approximate number of bytes that loaded subtrees take.
+   */
+  int64_t getByteSize() const noexcept { return this->_byteSize; }
+
+private:
+  struct Entry {
+    uint32_t level = 0;
+    uint64_t mortonIndex = 0;
+    bool isOccupied = false;
+    std::optional<Cesium3DTilesContent::SubtreeAvailability> availability;
+    int64_t byteSize = 0;
+    uint64_t lastUsed = 0;
+    int64_t referenceCount = 0;
+  };
+
+  struct EvictionCandidate {
+    uint64_t lastUsed;
+    uint32_t level;
+    uint64_t mortonIndex;
+  };
+
+  size_t findSlot(uint32_t level, uint64_t mortonIndex) const noexcept;
+  size_t getHomeSlot(uint32_t level, uint64_t mortonIndex) const noexcept;
+  Entry& occupy(uint32_t level, uint64_t mortonIndex);
+  void erase(size_t slot) noexcept;
+  void evict(uint32_t keepLevel, uint64_t keepMortonIndex);
+
+  std::vector<Entry> _entries;
+  std::vector<EvictionCandidate> _evictionCandidates;
+  size_t _occupiedCount;
+  size_t _loadedCount;
+  int64_t _byteSize;
+  int64_t _maximumBytes;
+  uint64_t _useCounter;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -1,5 +1,7 @@
 #include "LayerJsonTerrainLoader.h"
 
+#include "DecodeThread.h"
+
 #include <Cesium3DTilesContent/QuantizedMeshLoader.h>
 #include <Cesium3DTilesContent/upsampleGltfForRasterOverlays.h>
 #include <CesiumAsync/IAssetResponse.h>
@@ -12,6 +14,8 @@
 #include <libmorton/morton.h>
 #include <rapidjson/document.h>
 
+#include <algorithm>
+
 using namespace CesiumAsync;
 using namespace Cesium3DTilesContent;
 using namespace Cesium3DTilesSelection;
@@ -161,12 +165,11 @@ bool isSubtreeLoadedInLayer(
 
   // it doesn't have the subtree exceeds max zooms, so just treat it
   // as loaded
-  if (subtreeLevelIdx >= layer.loadedSubtrees.size()) {
+  if (subtreeLevelIdx >= layer.loadedSubtrees.getLevelCount()) {
     return true;
   }
 
-  return layer.loadedSubtrees[subtreeLevelIdx].find(subtreeMortonIdx) !=
-         layer.loadedSubtrees[subtreeLevelIdx].end();
+  return layer.loadedSubtrees.contains(subtreeLevelIdx, subtreeMortonIdx);
 }
 
 void addRectangleAvailabilityToLayer(
@@ -184,11 +187,11 @@ void addRectangleAvailabilityToLayer(
 
   // it doesn't have the subtree exceeds max zooms, so just treat it
   // as loaded
-  if (subtreeLevelIdx >= layer.loadedSubtrees.size()) {
+  if (subtreeLevelIdx >= layer.loadedSubtrees.getLevelCount()) {
     return;
   }
 
-  layer.loadedSubtrees[subtreeLevelIdx].insert(subtreeMortonIdx);
+  layer.loadedSubtrees.insert(subtreeLevelIdx, subtreeMortonIdx);
 }
 
 void generateRasterOverlayUVs(
@@ -253,6 +256,15 @@ std::string createExtensionsQueryParameter(
   return extensionsToRequest;
 }
 
+// Terrain normals are only requested if the renderer uses them.
+bool isNormalRequired(const TilesetContentOptions& contentOptions) {
+  return !contentOptions.requiredAttributes ||
+         std::find(
+             contentOptions.requiredAttributes->begin(),
+             contentOptions.requiredAttributes->end(),
+             "NORMAL") != contentOptions.requiredAttributes->end();
+}
+
 Future<LoadLayersResult> loadLayersRecursive(
     const AsyncSystem& asyncSystem,
     const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
@@ -261,6 +273,7 @@ Future<LoadLayersResult> loadLayersRecursive(
     const rapidjson::Document& layerJson,
     const QuadtreeTilingScheme& tilingScheme,
     bool useWaterMask,
+    bool useNormals,
     LoadLayersResult&& loadLayersResult) {
   std::string version;
   const auto tilesetVersionIt = layerJson.FindMember("version");
@@ -282,7 +295,11 @@ Future<LoadLayersResult> loadLayersRecursive(
       JsonHelpers::getStrings(layerJson, "extensions");
 
   // Request normals, watermask, and metadata if they're available
-  std::vector<std::string> knownExtensions = {"octvertexnormals", "metadata"};
+  std::vector<std::string> knownExtensions = {"metadata"};
+
+  if (useNormals) {
+    knownExtensions.emplace_back("octvertexnormals");
+  }
 
   if (useWaterMask) {
     knownExtensions.emplace_back("watermask");
@@ -353,6 +370,7 @@ Future<LoadLayersResult> loadLayersRecursive(
              pAssetAccessor,
              tilingScheme,
              useWaterMask,
+             useNormals,
              loadLayersResult = std::move(loadLayersResult)](
                 std::shared_ptr<IAssetRequest>&& pCompletedRequest) mutable {
               const CesiumAsync::IAssetResponse* pResponse =
@@ -405,6 +423,7 @@ Future<LoadLayersResult> loadLayersRecursive(
                   layerJson,
                   tilingScheme,
                   useWaterMask,
+                  useNormals,
                   std::move(loadLayersResult));
             });
   }
@@ -418,7 +437,8 @@ Future<LoadLayersResult> loadLayerJson(
     const std::string& baseUrl,
     const std::vector<IAssetAccessor::THeader>& requestHeaders,
     const rapidjson::Document& layerJson,
-    bool useWaterMask) {
+    bool useWaterMask,
+    bool useNormals) {
   // Use the projection and tiling scheme of the main layer.
   // Any underlying layers must use the same.
   std::string projectionString =
@@ -472,6 +492,7 @@ Future<LoadLayersResult> loadLayerJson(
       layerJson,
       tilingScheme,
       useWaterMask,
+      useNormals,
       std::move(loadLayersResult));
 }
 
@@ -481,7 +502,8 @@ Future<LoadLayersResult> loadLayerJson(
     const std::string& baseUrl,
     const std::vector<IAssetAccessor::THeader>& requestHeaders,
     const gsl::span<const std::byte>& layerJsonBinary,
-    bool useWaterMask) {
+    bool useWaterMask,
+    bool useNormals) {
   rapidjson::Document layerJson;
   layerJson.Parse(
       reinterpret_cast<const char*>(layerJsonBinary.data()),
@@ -501,7 +523,8 @@ Future<LoadLayersResult> loadLayerJson(
       baseUrl,
       requestHeaders,
       layerJson,
-      useWaterMask);
+      useWaterMask,
+      useNormals);
 }
 } // namespace
 
@@ -512,14 +535,17 @@ LayerJsonTerrainLoader::createLoader(
     const TilesetContentOptions& contentOptions,
     const std::string& layerJsonUrl,
     const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders) {
-  bool useWaterMask = contentOptions.enableWaterMask;
+  bool useWaterMask =
+      contentOptions.enableWaterMask && !contentOptions.geometryOnly;
+  bool useNormals = isNormalRequired(contentOptions);
 
   return externals.pAssetAccessor
       ->get(externals.asyncSystem, layerJsonUrl, requestHeaders)
       .thenInWorkerThread(
           [asyncSystem = externals.asyncSystem,
            pAssetAccessor = externals.pAssetAccessor,
-           useWaterMask](
+           useWaterMask,
+           useNormals](
               std::shared_ptr<CesiumAsync::IAssetRequest>&& pCompletedRequest) {
             const CesiumAsync::IAssetResponse* pResponse =
                 pCompletedRequest->response();
@@ -555,7 +581,8 @@ LayerJsonTerrainLoader::createLoader(
                 pCompletedRequest->url(),
                 flatHeaders,
                 pResponse->data(),
-                useWaterMask);
+                useWaterMask,
+                useNormals);
           })
       .thenInMainThread([](LoadLayersResult&& loadLayersResult) {
         return convertToTilesetContentLoaderResult(std::move(loadLayersResult));
@@ -576,7 +603,8 @@ Cesium3DTilesSelection::LayerJsonTerrainLoader::createLoader(
              layerJsonUrl,
              requestHeaders,
              layerJson,
-             contentOptions.enableWaterMask)
+             contentOptions.enableWaterMask && !contentOptions.geometryOnly,
+             isNormalRequired(contentOptions))
       .thenInMainThread([](LoadLayersResult&& loadLayersResult) {
         return convertToTilesetContentLoaderResult(std::move(loadLayersResult));
       });
@@ -643,41 +671,45 @@ Future<QuantizedMeshLoadResult> requestTileContent(
     const BoundingRegion& boundingRegion,
     const LayerJsonTerrainLoader::Layer& layer,
     const std::vector<IAssetAccessor::THeader>& requestHeaders,
-    bool enableWaterMask) {
+    bool enableWaterMask,
+    const std::optional<ThreadPool>& decodeThreadPool,
+    const TaskPriority& priority) {
   std::string url = resolveTileUrl(tileID, layer);
-  return pAssetAccessor->get(asyncSystem, url, requestHeaders)
-      .thenInWorkerThread(
-          [asyncSystem, pLogger, tileID, boundingRegion, enableWaterMask](
-              std::shared_ptr<IAssetRequest>&& pRequest) {
-            const IAssetResponse* pResponse = pRequest->response();
-            if (!pResponse) {
-              QuantizedMeshLoadResult result;
-              result.errors.emplaceError(fmt::format(
-                  "Did not receive a valid response for tile content {}",
-                  pRequest->url()));
-              result.pRequest = std::move(pRequest);
-              return result;
-            }
+  return thenInDecodeThread(
+      pAssetAccessor->get(asyncSystem, url, requestHeaders),
+      decodeThreadPool,
+      priority,
+      [asyncSystem, pLogger, tileID, boundingRegion, enableWaterMask](
+          std::shared_ptr<IAssetRequest>&& pRequest) {
+        const IAssetResponse* pResponse = pRequest->response();
+        if (!pResponse) {
+          QuantizedMeshLoadResult result;
+          result.errors.emplaceError(fmt::format(
+              "Did not receive a valid response for tile content {}",
+              pRequest->url()));
+          result.pRequest = std::move(pRequest);
+          return result;
+        }
 
-            if (pResponse->statusCode() != 0 &&
-                (pResponse->statusCode() < 200 ||
-                 pResponse->statusCode() >= 300)) {
-              QuantizedMeshLoadResult result;
-              result.errors.emplaceError(fmt::format(
-                  "Receive status code {} for tile content {}",
-                  pResponse->statusCode(),
-                  pRequest->url()));
-              result.pRequest = std::move(pRequest);
-              return result;
-            }
+        if (pResponse->statusCode() != 0 &&
+            (pResponse->statusCode() < 200 ||
+             pResponse->statusCode() >= 300)) {
+          QuantizedMeshLoadResult result;
+          result.errors.emplaceError(fmt::format(
+              "Receive status code {} for tile content {}",
+              pResponse->statusCode(),
+              pRequest->url()));
+          result.pRequest = std::move(pRequest);
+          return result;
+        }
 
-            return QuantizedMeshLoader::load(
-                tileID,
-                boundingRegion,
-                pRequest->url(),
-                pResponse->data(),
-                enableWaterMask);
-          });
+        return QuantizedMeshLoader::load(
+            tileID,
+            boundingRegion,
+            pRequest->url(),
+            pResponse->data(),
+            enableWaterMask);
+      });
 }
 
 Future<int> loadTileAvailability(
@@ -739,7 +771,11 @@ LayerJsonTerrainLoader::loadTileContent(const TileLoadInput& loadInput) {
     }
 
     // now do upsampling
-    return upsampleParentTile(tile, asyncSystem);
+    return upsampleParentTile(
+        tile,
+        asyncSystem,
+        loadInput.decodeThreadPool,
+        loadInput.priority);
   }
 
   // Always request the tile from the first layer in which this tile ID is
@@ -802,7 +838,9 @@ LayerJsonTerrainLoader::loadTileContent(const TileLoadInput& loadInput) {
       *pRegion,
       currentLayer,
       requestHeaders,
-      contentOptions.enableWaterMask);
+      contentOptions.enableWaterMask && !contentOptions.geometryOnly,
+      loadInput.decodeThreadPool,
+      loadInput.priority);
 
   // determine if this tile is at the availability level of the current layer
   // and if we need to add the availability rectangles to the current layer. We
@@ -970,6 +1008,13 @@ bool LayerJsonTerrainLoader::tileHasUpsampledChild(const Tile& tile) const {
   }
 }
 
+void LayerJsonTerrainLoader::addMemoryUsage(TilesetMemoryUsage& usage) const {
+  for (const Layer& layer : this->_layers) {
+    usage.availabilityBytes += layer.contentAvailability.computeByteSize() +
+                               layer.loadedSubtrees.computeByteSize();
+  }
+}
+
 std::vector<Tile>
 LayerJsonTerrainLoader::createTileChildrenImpl(const Tile& tile) {
   const QuadtreeTileID* pQuadtreeTileID =
@@ -1031,14 +1076,6 @@ LayerJsonTerrainLoader::tileIsAvailableInLayer(
       return AvailableState::NotAvailable;
     }
 
-    // this tile ID is also a subtree ID. So no need to calc
-    // subtree ID
-    if (int32_t(tileID.level) % layer.availabilityLevels == 0) {
-      if (isSubtreeLoadedInLayer(tileID, layer)) {
-        return AvailableState::NotAvailable;
-      }
-    }
-
     // calc the subtree ID this tile belongs to and determine it's loaded
     uint32_t subtreeLevelIdx =
         tileID.level / uint32_t(layer.availabilityLevels);
@@ -1098,7 +1135,9 @@ void LayerJsonTerrainLoader::createChildTile(
 
 CesiumAsync::Future<TileLoadResult> LayerJsonTerrainLoader::upsampleParentTile(
     const Tile& tile,
-    const CesiumAsync::AsyncSystem& asyncSystem) {
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool,
+    const CesiumAsync::TaskPriority& priority) {
   const Tile* pParent = tile.getParent();
   const TileContent& parentContent = pParent->getContent();
   const TileRenderContent* pParentRenderContent =
@@ -1132,7 +1171,10 @@ CesiumAsync::Future<TileLoadResult> LayerJsonTerrainLoader::upsampleParentTile(
   // thread. The tileset content manager will guarantee that the parent tile
   // will not be unloaded when upsampled tile is on the fly.
   const CesiumGltf::Model& parentModel = pParentRenderContent->getModel();
-  return asyncSystem.runInWorkerThread(
+  return runInDecodeThread(
+      asyncSystem,
+      decodeThreadPool,
+      priority,
       [&parentModel,
        boundingVolume = tile.getBoundingVolume(),
        textureCoordinateIndex = index,
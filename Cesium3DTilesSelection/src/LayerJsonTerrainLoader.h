@@ -1,11 +1,13 @@
 #pragma once
 
+#include "QuadtreeTileBitmap.h"
 #include "TilesetContentLoaderResult.h"
 
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 #include <Cesium3DTilesSelection/TilesetExternals.h>
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/ITaskProcessor.h>
 #include <CesiumGeometry/QuadtreeRectangleAvailability.h>
 #include <CesiumGeometry/QuadtreeTilingScheme.h>
 #include <CesiumGeospatial/Projection.h>
@@ -15,7 +17,6 @@
 #include <memory>
 #include <optional>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
@@ -57,7 +58,7 @@ public:
     std::string version;
     std::vector<std::string> tileTemplateUrls;
     CesiumGeometry::QuadtreeRectangleAvailability contentAvailability;
-    std::vector<std::unordered_set<uint64_t>> loadedSubtrees;
+    QuadtreeTileBitmap loadedSubtrees;
     int32_t availabilityLevels;
   };
 
@@ -71,6 +72,8 @@ public:
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
 
+  void addMemoryUsage(TilesetMemoryUsage& usage) const override;
+
   const CesiumGeometry::QuadtreeTilingScheme& getTilingScheme() const noexcept;
 
   const CesiumGeospatial::Projection& getProjection() const noexcept;
@@ -97,7 +100,9 @@ private:
 
   CesiumAsync::Future<TileLoadResult> upsampleParentTile(
       const Tile& tile,
-      const CesiumAsync::AsyncSystem& asyncSystem);
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool,
+      const CesiumAsync::TaskPriority& priority);
 
   CesiumGeometry::QuadtreeTilingScheme _tilingScheme;
   CesiumGeospatial::Projection _projection;
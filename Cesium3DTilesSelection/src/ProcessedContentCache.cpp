@@ -0,0 +1,443 @@
+#include <Cesium3DTilesSelection/ProcessedContentCache.h>
+#include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <CesiumGltfReader/GltfReader.h>
+#include <CesiumGltfWriter/GltfWriter.h>
+#include <CesiumUtility/ContentHash.h>
+
+#include <glm/mat3x3.hpp>
+#include <glm/vec3.hpp>
+#include <gsl/span>
+
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace Cesium3DTilesSelection {
+namespace {
+// Identifies the binary format. The version changes whenever the layout
+// does, so that content written by an older version is not misread.
+constexpr uint32_t magic = 0x4D435043; // "CPCM"
+constexpr uint32_t version = 1;
+
+enum class VolumeKind : uint8_t { None, Sphere, Box, Region };
+
+class BinaryWriter {
+public:
+  explicit BinaryWriter(std::vector<std::byte>& bytes) noexcept
+      : _bytes(bytes) {}
+
+  template <typename T> void write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const size_t offset = this->_bytes.size();
+    this->_bytes.resize(offset + sizeof(T));
+    std::memcpy(this->_bytes.data() + offset, &value, sizeof(T));
+  }
+
+  void writeBlock(const gsl::span<const std::byte>& block) {
+    this->write(uint64_t(block.size()));
+    this->_bytes.insert(this->_bytes.end(), block.begin(), block.end());
+  }
+
+private:
+  std::vector<std::byte>& _bytes;
+};
+
+class BinaryReader {
+public:
+  explicit BinaryReader(const gsl::span<const std::byte>& bytes) noexcept
+      : _bytes(bytes) {}
+
+  template <typename T> bool read(T& value) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (this->_bytes.size() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, this->_bytes.data(), sizeof(T));
+    this->_bytes = this->_bytes.subspan(sizeof(T));
+    return true;
+  }
+
+  bool readBlock(gsl::span<const std::byte>& block) noexcept {
+    uint64_t size;
+    if (!this->read(size) || size > this->_bytes.size()) {
+      return false;
+    }
+    block = this->_bytes.first(size_t(size));
+    this->_bytes = this->_bytes.subspan(size_t(size));
+    return true;
+  }
+
+private:
+  gsl::span<const std::byte> _bytes;
+};
+
+bool writeVolume(
+    BinaryWriter& writer,
+    const std::optional<BoundingVolume>& maybeVolume) {
+  if (!maybeVolume) {
+    writer.write(VolumeKind::None);
+    return true;
+  }
+
+  if (const auto* pSphere =
+          std::get_if<CesiumGeometry::BoundingSphere>(&*maybeVolume)) {
+    writer.write(VolumeKind::Sphere);
+    writer.write(pSphere->getCenter());
+    writer.write(pSphere->getRadius());
+    return true;
+  }
+
+  if (const auto* pBox =
+          std::get_if<CesiumGeometry::OrientedBoundingBox>(&*maybeVolume)) {
+    writer.write(VolumeKind::Box);
+    writer.write(pBox->getCenter());
+    writer.write(pBox->getHalfAxes());
+    return true;
+  }
+
+  if (const auto* pRegion =
+          std::get_if<CesiumGeospatial::BoundingRegion>(&*maybeVolume)) {
+    const CesiumGeospatial::GlobeRectangle& rectangle =
+        pRegion->getRectangle();
+    writer.write(VolumeKind::Region);
+    writer.write(rectangle.getWest());
+    writer.write(rectangle.getSouth());
+    writer.write(rectangle.getEast());
+    writer.write(rectangle.getNorth());
+    writer.write(pRegion->getMinimumHeight());
+    writer.write(pRegion->getMaximumHeight());
+    return true;
+  }
+
+  // Other volumes are not computed for content, so they are not stored.
+  return false;
+}
+
+bool readVolume(
+    BinaryReader& reader,
+    std::optional<BoundingVolume>& maybeVolume) {
+  VolumeKind kind;
+  if (!reader.read(kind)) {
+    return false;
+  }
+
+  switch (kind) {
+  case VolumeKind::None:
+    maybeVolume.reset();
+    return true;
+  case VolumeKind::Sphere: {
+    glm::dvec3 center;
+    double radius;
+    if (!reader.read(center) || !reader.read(radius)) {
+      return false;
+    }
+    maybeVolume = CesiumGeometry::BoundingSphere(center, radius);
+    return true;
+  }
+  case VolumeKind::Box: {
+    glm::dvec3 center;
+    glm::dmat3 halfAxes;
+    if (!reader.read(center) || !reader.read(halfAxes)) {
+      return false;
+    }
+    maybeVolume = CesiumGeometry::OrientedBoundingBox(center, halfAxes);
+    return true;
+  }
+  case VolumeKind::Region: {
+    double values[6];
+    if (!reader.read(values)) {
+      return false;
+    }
+    maybeVolume = CesiumGeospatial::BoundingRegion(
+        CesiumGeospatial::GlobeRectangle(
+            values[0],
+            values[1],
+            values[2],
+            values[3]),
+        values[4],
+        values[5]);
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+const CesiumGltfWriter::GltfWriter& getWriter() {
+  static const CesiumGltfWriter::GltfWriter writer;
+  return writer;
+}
+
+const CesiumGltfReader::GltfReader& getReader() {
+  static const CesiumGltfReader::GltfReader reader;
+  return reader;
+}
+
+std::string toHex(uint64_t value) {
+  std::ostringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << value;
+  return stream.str();
+}
+
+// Reads content, with its buffers and images either copied from the data or
+// sharing it.
+std::optional<TileLoadResult>
+readContent(const CesiumUtility::SharedBytes& data, bool share) {
+  // Gets a block of the data, as shared bytes or in a vector.
+  const auto setBlock = [&data, share](
+                            const gsl::span<const std::byte>& block,
+                            std::vector<std::byte>& copy,
+                            CesiumUtility::SharedBytes& shared) {
+    if (share) {
+      shared = data.subrange(
+          size_t(block.data() - data.getBytes().data()),
+          block.size());
+    } else {
+      copy.assign(block.begin(), block.end());
+    }
+  };
+
+  BinaryReader reader(data.getBytes());
+  uint32_t readMagic;
+  uint32_t readVersion;
+  uint8_t upAxis;
+  std::optional<BoundingVolume> updatedBoundingVolume;
+  std::optional<BoundingVolume> updatedContentBoundingVolume;
+  gsl::span<const std::byte> json;
+  if (!reader.read(readMagic) || readMagic != magic ||
+      !reader.read(readVersion) || readVersion != version ||
+      !reader.read(upAxis) || upAxis > uint8_t(CesiumGeometry::Axis::Z) ||
+      !readVolume(reader, updatedBoundingVolume) ||
+      !readVolume(reader, updatedContentBoundingVolume) ||
+      !reader.readBlock(json)) {
+    return std::nullopt;
+  }
+
+  // Everything was decoded before the glTF was stored, so it only needs to
+  // be parsed.
+  CesiumGltfReader::GltfReaderOptions options;
+  options.decodeDataUrls = false;
+  options.decodeEmbeddedImages = false;
+  options.decodeDraco = false;
+  options.decodeMeshOptData = false;
+  options.dequantizeMeshData = false;
+  options.applyTextureTransform = false;
+  CesiumGltfReader::GltfReaderResult gltf =
+      getReader().readGltf(json, options);
+  if (!gltf.model || !gltf.errors.empty()) {
+    return std::nullopt;
+  }
+
+  Model& model = *gltf.model;
+  uint64_t bufferCount;
+  if (!reader.read(bufferCount) || bufferCount != model.buffers.size()) {
+    return std::nullopt;
+  }
+  for (Buffer& buffer : model.buffers) {
+    gsl::span<const std::byte> block;
+    if (!reader.readBlock(block)) {
+      return std::nullopt;
+    }
+    setBlock(block, buffer.cesium.data, buffer.cesium.sharedData);
+  }
+
+  uint64_t imageCount;
+  if (!reader.read(imageCount) || imageCount != model.images.size()) {
+    return std::nullopt;
+  }
+  for (Image& image : model.images) {
+    ImageCesium& cesium = image.cesium;
+    uint64_t mipCount;
+    if (!reader.read(cesium.width) || !reader.read(cesium.height) ||
+        !reader.read(cesium.channels) || !reader.read(cesium.bytesPerChannel) ||
+        !reader.read(cesium.compressedPixelFormat) || !reader.read(mipCount)) {
+      return std::nullopt;
+    }
+
+    cesium.mipPositions.clear();
+    for (uint64_t i = 0; i < mipCount; ++i) {
+      uint64_t byteOffset;
+      uint64_t byteSize;
+      if (!reader.read(byteOffset) || !reader.read(byteSize)) {
+        return std::nullopt;
+      }
+      cesium.mipPositions.push_back(
+          ImageCesiumMipPosition{size_t(byteOffset), size_t(byteSize)});
+    }
+
+    gsl::span<const std::byte> block;
+    if (!reader.readBlock(block)) {
+      return std::nullopt;
+    }
+    setBlock(block, cesium.pixelData, cesium.sharedPixelData);
+  }
+
+  return TileLoadResult{
+      std::move(model),
+      CesiumGeometry::Axis(upAxis),
+      std::move(updatedBoundingVolume),
+      std::move(updatedContentBoundingVolume),
+      std::nullopt,
+      nullptr,
+      {},
+      TileLoadResultState::Success};
+}
+
+} // namespace
+
+ProcessedContentCache::ProcessedContentCache(
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase,
+    std::time_t maximumAge) noexcept
+    : _pDatabase(pDatabase), _maximumAge(maximumAge) {}
+
+/*static*/ std::optional<std::string> ProcessedContentCache::computeKey(
+    const std::string& url,
+    const TilesetContentOptions& options,
+    const glm::dmat4& tileTransform) {
+  // The geometry index is built from the float positions, which are not
+  // stored once the meshes are quantized.
+  if (options.buildGeometryIndex && options.quantizeMeshes) {
+    return std::nullopt;
+  }
+
+  std::vector<std::byte> bytes;
+  BinaryWriter writer(bytes);
+  writer.write(version);
+  writer.write(options.enableWaterMask);
+  writer.write(options.generateMissingNormalsSmooth);
+  writer.write(options.ktx2TranscodeTargets);
+  writer.write(options.requiredAttributes.has_value());
+  if (options.requiredAttributes) {
+    writer.write(uint64_t(options.requiredAttributes->size()));
+    for (const std::string& attribute : *options.requiredAttributes) {
+      writer.writeBlock(gsl::span<const std::byte>(
+          reinterpret_cast<const std::byte*>(attribute.data()),
+          attribute.size()));
+    }
+  }
+  writer.write(options.optimizeMeshes);
+  writer.write(options.mergePrimitives);
+  writer.write(options.quantizeMeshes);
+  writer.write(options.computeContentBoundingVolumes);
+  writer.write(options.instanceClusterSize);
+  writer.write(options.geometryOnly);
+  writer.write(tileTransform);
+
+  const CesiumUtility::ContentHash hash =
+      CesiumUtility::ContentHash::compute(bytes);
+  return "processed-content:" + toHex(hash.hash1) + toHex(hash.hash2) + ":" +
+         url;
+}
+
+std::optional<TileLoadResult>
+ProcessedContentCache::find(const std::string& key) const {
+  std::optional<CesiumAsync::CacheItem> maybeItem =
+      this->_pDatabase->getEntry(key);
+  if (!maybeItem || maybeItem->expiryTime < std::time(nullptr)) {
+    return std::nullopt;
+  }
+
+  // The content refers to the bytes of the entry rather than copying them.
+  return deserialize(CesiumUtility::SharedBytes::fromVector(
+      std::move(maybeItem->cacheResponse.data)));
+}
+
+bool ProcessedContentCache::insert(
+    const std::string& key,
+    const std::string& url,
+    const TileLoadResult& result) const {
+  std::optional<std::vector<std::byte>> maybeBytes = serialize(result);
+  if (!maybeBytes) {
+    return false;
+  }
+
+  return this->_pDatabase->storeEntry(
+      key,
+      std::time(nullptr) + this->_maximumAge,
+      url,
+      "GET",
+      {},
+      200,
+      {},
+      *maybeBytes);
+}
+
+/*static*/ std::optional<std::vector<std::byte>>
+ProcessedContentCache::serialize(const TileLoadResult& result) {
+  const Model* pModel = std::get_if<Model>(&result.contentKind);
+  if (result.state != TileLoadResultState::Success || !pModel ||
+      result.rasterOverlayDetails) {
+    return std::nullopt;
+  }
+
+  // The JSON of the glTF is written as it is, without the buffer and image
+  // data, which follow it.
+  CesiumGltfWriter::GltfWriterResult json = getWriter().writeGltf(*pModel);
+  if (!json.errors.empty()) {
+    return std::nullopt;
+  }
+
+  // Reserve room for the data up front, since it is most of the bytes.
+  size_t dataSize = json.gltfBytes.size();
+  for (const Buffer& buffer : pModel->buffers) {
+    dataSize += buffer.cesium.getData().size();
+  }
+  for (const Image& image : pModel->images) {
+    dataSize += image.cesium.getPixelData().size();
+  }
+
+  std::vector<std::byte> bytes;
+  bytes.reserve(dataSize + 1024);
+  BinaryWriter writer(bytes);
+  writer.write(magic);
+  writer.write(version);
+  writer.write(uint8_t(result.glTFUpAxis));
+  if (!writeVolume(writer, result.updatedBoundingVolume) ||
+      !writeVolume(writer, result.updatedContentBoundingVolume)) {
+    return std::nullopt;
+  }
+
+  writer.writeBlock(json.gltfBytes);
+
+  writer.write(uint64_t(pModel->buffers.size()));
+  for (const Buffer& buffer : pModel->buffers) {
+    writer.writeBlock(buffer.cesium.getData());
+  }
+
+  writer.write(uint64_t(pModel->images.size()));
+  for (const Image& image : pModel->images) {
+    const ImageCesium& cesium = image.cesium;
+    writer.write(cesium.width);
+    writer.write(cesium.height);
+    writer.write(cesium.channels);
+    writer.write(cesium.bytesPerChannel);
+    writer.write(cesium.compressedPixelFormat);
+    writer.write(uint64_t(cesium.mipPositions.size()));
+    for (const ImageCesiumMipPosition& mip : cesium.mipPositions) {
+      writer.write(uint64_t(mip.byteOffset));
+      writer.write(uint64_t(mip.byteSize));
+    }
+    writer.writeBlock(cesium.getPixelData());
+  }
+
+  return bytes;
+}
+
+/*static*/ std::optional<TileLoadResult>
+ProcessedContentCache::deserialize(const gsl::span<const std::byte>& data) {
+  return readContent(CesiumUtility::SharedBytes(nullptr, data), false);
+}
+
+/*static*/ std::optional<TileLoadResult>
+ProcessedContentCache::deserialize(const CesiumUtility::SharedBytes& data) {
+  return readContent(data, true);
+}
+
+} // namespace Cesium3DTilesSelection
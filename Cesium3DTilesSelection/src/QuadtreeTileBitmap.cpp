@@ -0,0 +1,81 @@
+#include "QuadtreeTileBitmap.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Cesium3DTilesSelection {
+namespace {
+// The first 4096 tiles of each level are stored densely, which takes at most
+// 512 bytes per level.
+constexpr uint64_t denseBlockCount = 64;
+
+uint64_t getBit(uint64_t mortonIndex) noexcept {
+  return uint64_t(1) << (mortonIndex & 63);
+}
+} // namespace
+
+QuadtreeTileBitmap::QuadtreeTileBitmap(size_t levelCount)
+    : _levels(levelCount) {}
+
+bool QuadtreeTileBitmap::contains(size_t level, uint64_t mortonIndex)
+    const noexcept {
+  assert(level < this->_levels.size() && "Level is out of range");
+
+  const Level& bitmapLevel = this->_levels[level];
+  const uint64_t blockIndex = mortonIndex >> 6;
+  if (blockIndex < denseBlockCount) {
+    const size_t denseIndex = static_cast<size_t>(blockIndex);
+    return denseIndex < bitmapLevel.denseBits.size() &&
+           (bitmapLevel.denseBits[denseIndex] & getBit(mortonIndex)) != 0;
+  }
+
+  auto it = std::lower_bound(
+      bitmapLevel.sparseBlocks.begin(),
+      bitmapLevel.sparseBlocks.end(),
+      blockIndex,
+      [](const Block& block, uint64_t index) {
+        return block.blockIndex < index;
+      });
+  return it != bitmapLevel.sparseBlocks.end() &&
+         it->blockIndex == blockIndex && (it->bits & getBit(mortonIndex)) != 0;
+}
+
+void QuadtreeTileBitmap::insert(size_t level, uint64_t mortonIndex) {
+  assert(level < this->_levels.size() && "Level is out of range");
+
+  Level& bitmapLevel = this->_levels[level];
+  const uint64_t blockIndex = mortonIndex >> 6;
+  if (blockIndex < denseBlockCount) {
+    const size_t denseIndex = static_cast<size_t>(blockIndex);
+    if (denseIndex >= bitmapLevel.denseBits.size()) {
+      bitmapLevel.denseBits.resize(denseIndex + 1, 0);
+    }
+
+    bitmapLevel.denseBits[denseIndex] |= getBit(mortonIndex);
+    return;
+  }
+
+  auto it = std::lower_bound(
+      bitmapLevel.sparseBlocks.begin(),
+      bitmapLevel.sparseBlocks.end(),
+      blockIndex,
+      [](const Block& block, uint64_t index) {
+        return block.blockIndex < index;
+      });
+  if (it == bitmapLevel.sparseBlocks.end() || it->blockIndex != blockIndex) {
+    it = bitmapLevel.sparseBlocks.insert(it, Block{blockIndex, 0});
+  }
+
+  it->bits |= getBit(mortonIndex);
+}
+
+int64_t QuadtreeTileBitmap::computeByteSize() const noexcept {
+  size_t bytes = this->_levels.capacity() * sizeof(Level);
+  for (const Level& level : this->_levels) {
+    bytes += level.denseBits.capacity() * sizeof(uint64_t) +
+             level.sparseBlocks.capacity() * sizeof(Block);
+  }
+  return int64_t(bytes);
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief A compact set of quadtree tiles, keyed by a level index and the
+ * Morton index of each tile within its level.
+ *
+ * Each level keeps one bit per tile. The bits of the first tiles of a level,
+ * which include every tile of the shallow levels, are stored densely. The
+ * bits of the remaining tiles are stored in sparse blocks of 64 tiles, sorted
+ * by the Morton index of the block, so that the deep levels of a global
+ * tileset take space only where tiles were added. Because a block of 64
+ * consecutive Morton indices is an 8x8 square of tiles, neighboring tiles
+ * usually share a block.
+ */
+class QuadtreeTileBitmap {
+public:
+  /**
+   * @brief Creates an empty bitmap.
+   *
+   * @param levelCount The number of levels. Tiles in deeper levels can't be
+   * added.
+   */
+  explicit QuadtreeTileBitmap(size_t levelCount = 0);
+
+  /**
+   * @brief Gets the number of levels.
+   */
+  size_t getLevelCount() const noexcept { return this->_levels.size(); }
+
+  /**
+   * @brief Determines if the bitmap has no levels.
+   */
+  bool empty() const noexcept { return this->_levels.empty(); }
+
+  /**
+   * @brief Determines if a tile has been added.
+   *
+   * @param level The level index of the tile, which must be less than
+   * {@link getLevelCount}.
+   * @param mortonIndex The Morton index of the tile within its level.
+   */
+  bool contains(size_t level, uint64_t mortonIndex) const noexcept;
+
+  /**
+   * @brief Adds a tile.
+   *
+   * @param level The level index of the tile, which must be less than
+   * {@link getLevelCount}.
+   * @param mortonIndex The Morton index of the tile within its level.
+   */
+  void insert(size_t level, uint64_t mortonIndex);
+
+  /**
+   * @brief Computes the number of bytes allocated for the bitmap.
+   */
+  int64_t computeByteSize() const noexcept;
+
+private:
+  struct Block {
+    uint64_t blockIndex;
+    uint64_t bits;
+  };
+
+  struct Level {
+    std::vector<uint64_t> denseBits;
+    std::vector<Block> sparseBlocks;
+  };
+
+  std::vector<Level> _levels;
+};
+
+} // namespace Cesium3DTilesSelection
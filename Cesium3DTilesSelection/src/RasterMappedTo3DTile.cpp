@@ -211,7 +211,8 @@ void RasterMappedTo3DTile::detachFromTile(
   this->_state = AttachmentState::Unattached;
 }
 
-bool RasterMappedTo3DTile::loadThrottled() noexcept {
+bool RasterMappedTo3DTile::loadThrottled(
+    const CesiumAsync::TaskPriority& priority) noexcept {
   CESIUM_TRACE("RasterMappedTo3DTile::loadThrottled");
   RasterOverlayTile* pLoading = this->getLoadingTile();
   if (!pLoading) {
@@ -219,7 +220,7 @@ bool RasterMappedTo3DTile::loadThrottled() noexcept {
   }
 
   RasterOverlayTileProvider& provider = pLoading->getTileProvider();
-  return provider.loadTileThrottled(*pLoading);
+  return provider.loadTileThrottled(*pLoading, priority);
 }
 
 namespace {
@@ -66,14 +66,15 @@ void RasterOverlayCollection::add(
 
   // CESIUM_TRACE_BEGIN_IN_TRACK("createTileProvider");
 
-  CesiumAsync::Future<RasterOverlay::CreateTileProviderResult> future =
-      pOverlay->createTileProvider(
+  // Tilesets with the same externals that add the same overlay share its tile
+  // provider, and the tiles that it has loaded.
+  CesiumAsync::SharedFuture<RasterOverlay::CreateTileProviderResult> future =
+      pOverlay->acquireSharedTileProvider(
           this->_externals.asyncSystem,
           this->_externals.pAssetAccessor,
           this->_externals.pCreditSystem,
           this->_externals.pPrepareRendererResources,
-          this->_externals.pLogger,
-          nullptr);
+          this->_externals.pLogger);
 
   // Add a placeholder for this overlay to existing geometry tiles.
   forEachTile(*this->_pLoadedTiles, [&](Tile& tile) {
@@ -96,19 +97,11 @@ void RasterOverlayCollection::add(
 
   // This continuation, by capturing pList, keeps the OverlayList from being
   // destroyed. But it does not keep the RasterOverlayCollection itself alive.
-  std::move(future)
-      .catchInMainThread(
-          [](const std::exception& e)
-              -> RasterOverlay::CreateTileProviderResult {
-            return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
-                RasterOverlayLoadType::Unknown,
-                nullptr,
-                fmt::format(
-                    "Error while creating tile provider: {0}",
-                    e.what())});
-          })
-      .thenInMainThread([pOverlay, pList, pLogger = this->_externals.pLogger](
-                            RasterOverlay::CreateTileProviderResult&& result) {
+  // Errors creating the tile provider have already been reported by the
+  // overlay.
+  future.thenInMainThread(
+      [pOverlay,
+       pList](const RasterOverlay::CreateTileProviderResult& result) {
         if (result) {
           // Find the overlay's current location in the list.
           // It's possible it has been removed completely.
@@ -120,14 +113,6 @@ void RasterOverlayCollection::add(
             std::int64_t index = it - pList->overlays.begin();
             pList->tileProviders[size_t(index)] = *result;
           }
-        } else {
-          // Report error creating the tile provider.
-          const RasterOverlayLoadFailureDetails& failureDetails =
-              result.error();
-          SPDLOG_LOGGER_ERROR(pLogger, failureDetails.message);
-          if (pOverlay->getOptions().loadErrorCallback) {
-            pOverlay->getOptions().loadErrorCallback(failureDetails);
-          }
         }
         // CESIUM_TRACE_END_IN_TRACK("createTileProvider");
       });
@@ -181,6 +166,15 @@ void RasterOverlayCollection::remove(
     return;
   }
 
+  // Release the tile provider while the list still holds the overlay, because
+  // pOverlay may refer to the list entry.
+  (*it)->releaseSharedTileProvider(
+      this->_externals.asyncSystem,
+      this->_externals.pAssetAccessor,
+      this->_externals.pCreditSystem,
+      this->_externals.pPrepareRendererResources,
+      this->_externals.pLogger);
+
   int64_t index = it - list.overlays.begin();
   list.overlays.erase(list.overlays.begin() + index);
   list.tileProviders.erase(list.tileProviders.begin() + index);
@@ -1,5 +1,7 @@
 #include "RasterOverlayUpsampler.h"
 
+#include "DecodeThread.h"
+
 #include <Cesium3DTilesContent/upsampleGltfForRasterOverlays.h>
 #include <Cesium3DTilesSelection/RasterMappedTo3DTile.h>
 #include <Cesium3DTilesSelection/Tile.h>
@@ -8,13 +10,37 @@
 #include <CesiumRasterOverlays/RasterOverlay.h>
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
 
+#include <gsl/span>
+
+#include <algorithm>
 #include <cassert>
+#include <memory>
+#include <optional>
 #include <variant>
+#include <vector>
 
 using namespace Cesium3DTilesContent;
 using namespace CesiumRasterOverlays;
 
 namespace Cesium3DTilesSelection {
+namespace {
+TileLoadResult createTileLoadResult(std::optional<CesiumGltf::Model>&& model) {
+  if (!model) {
+    return TileLoadResult::createFailedResult(nullptr);
+  }
+
+  return TileLoadResult{
+      std::move(*model),
+      CesiumGeometry::Axis::Y,
+      std::nullopt,
+      std::nullopt,
+      std::nullopt,
+      nullptr,
+      {},
+      TileLoadResultState::Success};
+}
+} // namespace
+
 CesiumAsync::Future<TileLoadResult>
 RasterOverlayUpsampler::loadTileContent(const TileLoadInput& loadInput) {
   const Tile* pParent = loadInput.tile.getParent();
@@ -64,31 +90,96 @@ RasterOverlayUpsampler::loadTileContent(const TileLoadInput& loadInput) {
   }
 
   const CesiumGltf::Model& parentModel = pParentRenderContent->getModel();
-  return loadInput.asyncSystem.runInWorkerThread(
-      [&parentModel,
-       transform = loadInput.tile.getTransform(),
-       textureCoordinateIndex = index,
-       TileID = *pTileID]() mutable {
-        auto model = upsampleGltfForRasterOverlays(
-            parentModel,
-            TileID,
-            textureCoordinateIndex);
-        if (!model) {
-          return TileLoadResult::createFailedResult(nullptr);
-        }
-
-        return TileLoadResult{
-            std::move(*model),
-            CesiumGeometry::Axis::Y,
-            std::nullopt,
-            std::nullopt,
-            std::nullopt,
-            nullptr,
-            {},
-            TileLoadResultState::Success};
+  const gsl::span<const Tile> siblings = pParent->getChildren();
+  const size_t childIndex = size_t(&loadInput.tile - siblings.data());
+
+  std::vector<CesiumGeometry::UpsampledQuadtreeNode> childIDs;
+  childIDs.reserve(siblings.size());
+  for (const Tile& sibling : siblings) {
+    const CesiumGeometry::UpsampledQuadtreeNode* pSiblingID =
+        std::get_if<CesiumGeometry::UpsampledQuadtreeNode>(
+            &sibling.getTileID());
+    if (pSiblingID == nullptr) {
+      break;
+    }
+    childIDs.emplace_back(*pSiblingID);
+  }
+
+  if (childIDs.size() != siblings.size()) {
+    // Only siblings that are all upsampled are upsampled together.
+    return runInDecodeThread(
+        loadInput.asyncSystem,
+        loadInput.decodeThreadPool,
+        loadInput.priority,
+        [&parentModel, textureCoordinateIndex = index, TileID = *pTileID]() {
+          return createTileLoadResult(upsampleGltfForRasterOverlays(
+              parentModel,
+              TileID,
+              textureCoordinateIndex));
+        });
+  }
+
+  auto it = this->_upsampledChildren.find(pParent);
+  if (it != this->_upsampledChildren.end() &&
+      (it->second.pParentModel != &parentModel ||
+       it->second.textureCoordinateIndex != index ||
+       it->second.isLoaded[childIndex])) {
+    // The children were upsampled from other content or texture coordinates,
+    // or this child is loaded again after it was unloaded, so upsample them
+    // all again.
+    this->_upsampledChildren.erase(it);
+    it = this->_upsampledChildren.end();
+  }
+
+  if (it == this->_upsampledChildren.end()) {
+    CesiumAsync::SharedFuture<std::shared_ptr<UpsampledModels>> models =
+        runInDecodeThread(
+            loadInput.asyncSystem,
+            loadInput.decodeThreadPool,
+            loadInput.priority,
+            [&parentModel,
+             childIDs = std::move(childIDs),
+             textureCoordinateIndex = index]() {
+              return std::make_shared<UpsampledModels>(
+                  upsampleGltfForRasterOverlays(
+                      parentModel,
+                      childIDs,
+                      textureCoordinateIndex));
+            })
+            .share();
+    it = this->_upsampledChildren
+             .emplace(
+                 pParent,
+                 UpsampledChildren{
+                     &parentModel,
+                     index,
+                     std::vector<bool>(siblings.size(), false),
+                     std::move(models)})
+             .first;
+  }
+
+  // Each child takes its own model, so the children never touch the same
+  // model, even if they finish loading in different threads.
+  it->second.isLoaded[childIndex] = true;
+  CesiumAsync::SharedFuture<std::shared_ptr<UpsampledModels>> models =
+      it->second.models;
+  if (std::all_of(
+          it->second.isLoaded.begin(),
+          it->second.isLoaded.end(),
+          [](bool isLoaded) { return isLoaded; })) {
+    this->_upsampledChildren.erase(it);
+  }
+
+  return models.thenImmediately(
+      [childIndex](const std::shared_ptr<UpsampledModels>& pModels) {
+        return createTileLoadResult(std::move((*pModels)[childIndex]));
       });
 }
 
+void RasterOverlayUpsampler::notifyParentContentUnloaded(const Tile& parent) {
+  this->_upsampledChildren.erase(&parent);
+}
+
 TileChildrenResult
 RasterOverlayUpsampler::createTileChildren([[maybe_unused]] const Tile& tile) {
   return {{}, TileLoadResultState::Failed};
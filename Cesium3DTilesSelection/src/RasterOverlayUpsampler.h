@@ -1,6 +1,13 @@
 #pragma once
 
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
+#include <CesiumAsync/SharedFuture.h>
+#include <CesiumGltf/Model.h>
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace Cesium3DTilesSelection {
 class RasterOverlayUpsampler : public TilesetContentLoader {
@@ -9,5 +16,27 @@ public:
   loadTileContent(const TileLoadInput& loadInput) override;
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
+
+  /**
+   * @brief Releases the upsampled children of a tile that have not been
+   * loaded yet, because the content they were upsampled from is unloaded.
+   *
+   * @param parent The tile whose content is unloaded.
+   */
+  void notifyParentContentUnloaded(const Tile& parent);
+
+private:
+  using UpsampledModels = std::vector<std::optional<CesiumGltf::Model>>;
+
+  // All children of a parent are upsampled together when the first of them
+  // is loaded, and the others are kept here until they are loaded, too.
+  struct UpsampledChildren {
+    const CesiumGltf::Model* pParentModel;
+    int32_t textureCoordinateIndex;
+    std::vector<bool> isLoaded;
+    CesiumAsync::SharedFuture<std::shared_ptr<UpsampledModels>> models;
+  };
+
+  std::unordered_map<const Tile*, UpsampledChildren> _upsampledChildren;
 };
 } // namespace Cesium3DTilesSelection
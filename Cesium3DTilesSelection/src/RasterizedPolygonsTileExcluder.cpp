@@ -17,10 +17,30 @@ bool RasterizedPolygonsTileExcluder::shouldExclude(
   if (this->_pOverlay->getInvertSelection()) {
     return Cesium3DTilesSelection::CesiumImpl::outsidePolygons(
         tile.getBoundingVolume(),
-        this->_pOverlay->getPolygons());
+        this->_pOverlay->getPolygonIndex());
   } else {
     return Cesium3DTilesSelection::CesiumImpl::withinPolygons(
         tile.getBoundingVolume(),
-        this->_pOverlay->getPolygons());
+        this->_pOverlay->getPolygonIndex());
   }
 }
+
+TileExclusion
+RasterizedPolygonsTileExcluder::classify(const Tile& tile) const noexcept {
+  const std::optional<CesiumGeospatial::GlobeRectangle> maybeRectangle =
+      estimateGlobeRectangle(tile.getBoundingVolume());
+  if (!maybeRectangle) {
+    return TileExclusion::Included;
+  }
+
+  const CesiumGeospatial::CartographicPolygonIndex& polygonIndex =
+      this->_pOverlay->getPolygonIndex();
+  const bool invert = this->_pOverlay->getInvertSelection();
+  if (polygonIndex.rectangleIsWithinPolygons(*maybeRectangle)) {
+    return invert ? TileExclusion::SubtreeIncluded : TileExclusion::Excluded;
+  }
+  if (polygonIndex.rectangleIsOutsidePolygons(*maybeRectangle)) {
+    return invert ? TileExclusion::Excluded : TileExclusion::SubtreeIncluded;
+  }
+  return TileExclusion::Included;
+}
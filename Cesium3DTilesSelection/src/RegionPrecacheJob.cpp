@@ -0,0 +1,232 @@
+#include "RegionPrecacheJob.h"
+
+#include "TilesetContentManager.h"
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <variant>
+
+using namespace CesiumGeospatial;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace Cesium3DTilesSelection {
+
+RegionPrecacheJob::RegionPrecacheJob(
+    const GlobeRectangle& rectangle,
+    const RegionPrecacheOptions& options,
+    const CesiumAsync::Promise<RegionPrecacheProgress>& promise)
+    : _rectangle(rectangle),
+      _options(options),
+      _promise(promise),
+      _started(false),
+      _progressChanged(false),
+      _progress(),
+      _pendingTiles(),
+      _deferredTiles(),
+      _rasterOverlayTiles() {}
+
+bool RegionPrecacheJob::update(
+    TilesetContentManager& contentManager,
+    const TilesetOptions& tilesetOptions) {
+  if (!this->_started) {
+    Tile* pRootTile = contentManager.getRootTile();
+    if (!pRootTile) {
+      return false;
+    }
+
+    this->_pendingTiles.push_back({pRootTile, 0, false, false});
+    this->_started = true;
+    this->_progressChanged = true;
+  }
+
+  for (const PendingTile& deferred : this->_deferredTiles) {
+    this->_pendingTiles.push_back(deferred);
+  }
+  this->_deferredTiles.clear();
+
+  const uint32_t maximumLoads = this->_options.maximumSimultaneousLoads;
+  while (!this->_pendingTiles.empty() &&
+         this->_progress.tilesLoading < maximumLoads) {
+    const PendingTile pending = this->_pendingTiles.back();
+    this->_pendingTiles.pop_back();
+    this->_visitTile(contentManager, tilesetOptions, pending);
+  }
+
+  this->_updateRasterOverlayTiles();
+
+  const uint32_t tilesRemaining = static_cast<uint32_t>(
+      this->_pendingTiles.size() + this->_deferredTiles.size());
+  if (tilesRemaining != this->_progress.tilesRemaining) {
+    this->_progress.tilesRemaining = tilesRemaining;
+    this->_progressChanged = true;
+  }
+
+  if (this->_progressChanged && this->_options.progressCallback) {
+    this->_options.progressCallback(this->_progress);
+  }
+  this->_progressChanged = false;
+
+  const bool done = tilesRemaining == 0 && this->_progress.tilesLoading == 0 &&
+                    this->_rasterOverlayTiles.empty();
+  if (done) {
+    this->_promise.resolve(this->_progress);
+  }
+
+  return done;
+}
+
+void RegionPrecacheJob::abandon() {
+  this->_promise.reject(std::runtime_error(
+      "The tileset was destroyed before the region was precached."));
+}
+
+void RegionPrecacheJob::_visitTile(
+    TilesetContentManager& contentManager,
+    const TilesetOptions& tilesetOptions,
+    PendingTile pending) {
+  Tile& tile = *pending.pTile;
+
+  if (!pending.visited) {
+    const std::optional<GlobeRectangle> maybeRectangle =
+        estimateGlobeRectangle(tile.getBoundingVolume());
+    if (maybeRectangle &&
+        !maybeRectangle->computeIntersection(this->_rectangle)) {
+      return;
+    }
+
+    pending.visited = true;
+    ++this->_progress.tilesVisited;
+    this->_progressChanged = true;
+  }
+
+  const TileLoadState state = tile.getState();
+  if (state == TileLoadState::ContentLoading) {
+    this->_deferredTiles.push_back(pending);
+    return;
+  }
+
+  if (!pending.fetched && (state == TileLoadState::Unloaded ||
+                           state == TileLoadState::FailedTemporarily)) {
+    ++this->_progress.tilesLoading;
+    this->_progressChanged = true;
+
+    contentManager.precacheTileContent(tile, tilesetOptions)
+        .thenImmediately(
+            [pThis = this->shared_from_this(),
+             pending](TilePrecacheResult&& result) {
+              pThis->_onTileFetched(pending, std::move(result));
+            });
+    return;
+  }
+
+  // The content is in the cache now, or was already loaded by the tileset.
+  if (!this->_shouldRefine(tile, pending.depth)) {
+    return;
+  }
+
+  for (Tile& child : tile.getChildren()) {
+    // Upsampled tiles are created from their parent, so there is nothing to
+    // fetch for them.
+    if (std::holds_alternative<CesiumGeometry::UpsampledQuadtreeNode>(
+            child.getTileID())) {
+      continue;
+    }
+
+    this->_pendingTiles.push_back({&child, pending.depth + 1, false, false});
+  }
+}
+
+void RegionPrecacheJob::_onTileFetched(
+    const PendingTile& pending,
+    TilePrecacheResult&& result) {
+  --this->_progress.tilesLoading;
+  this->_progressChanged = true;
+
+  const TileLoadState state = pending.pTile->getState();
+  if (state == TileLoadState::Failed ||
+      state == TileLoadState::FailedTemporarily) {
+    ++this->_progress.tilesFailed;
+  } else {
+    ++this->_progress.tilesFetched;
+    this->_progress.bytesFetched += result.bytesLoaded;
+  }
+
+  // The same raster overlay tile is often mapped to several geometry tiles.
+  for (IntrusivePointer<RasterOverlayTile>& pRasterTile :
+       result.rasterOverlayTiles) {
+    if (std::find(
+            this->_rasterOverlayTiles.begin(),
+            this->_rasterOverlayTiles.end(),
+            pRasterTile) == this->_rasterOverlayTiles.end()) {
+      this->_rasterOverlayTiles.emplace_back(std::move(pRasterTile));
+    }
+  }
+
+  // Visit the tile again to refine to the children its content added.
+  this->_pendingTiles.push_back({pending.pTile, pending.depth, true, true});
+}
+
+bool RegionPrecacheJob::_shouldRefine(const Tile& tile, uint32_t depth)
+    const noexcept {
+  if (this->_options.maximumLevel && depth >= *this->_options.maximumLevel) {
+    return false;
+  }
+
+  if (tile.getUnconditionallyRefine()) {
+    return true;
+  }
+
+  const double sseDenominator =
+      2.0 * std::tan(0.5 * this->_options.verticalFieldOfView);
+  const double distance = std::max(this->_options.viewingDistance, 1e-7);
+  const double screenSpaceError = tile.getGeometricError() *
+                                  this->_options.viewportHeight /
+                                  (distance * sseDenominator);
+  return screenSpaceError > this->_options.maximumScreenSpaceError;
+}
+
+void RegionPrecacheJob::_updateRasterOverlayTiles() {
+  uint32_t loading = 0;
+
+  auto it = std::remove_if(
+      this->_rasterOverlayTiles.begin(),
+      this->_rasterOverlayTiles.end(),
+      [this, &loading](const IntrusivePointer<RasterOverlayTile>& pRasterTile) {
+        switch (pRasterTile->getState()) {
+        case RasterOverlayTile::LoadState::Unloaded:
+          // This may be throttled by the tile provider, in which case it is
+          // tried again on the next update.
+          pRasterTile->getTileProvider().loadTileThrottled(*pRasterTile);
+          ++loading;
+          return false;
+        case RasterOverlayTile::LoadState::Loading:
+          ++loading;
+          return false;
+        case RasterOverlayTile::LoadState::Failed:
+          ++this->_progress.rasterOverlayTilesFailed;
+          this->_progressChanged = true;
+          return true;
+        default:
+          ++this->_progress.rasterOverlayTilesFetched;
+          this->_progressChanged = true;
+          return true;
+        }
+      });
+  this->_rasterOverlayTiles.erase(it, this->_rasterOverlayTiles.end());
+
+  if (loading != this->_progress.rasterOverlayTilesLoading) {
+    this->_progress.rasterOverlayTilesLoading = loading;
+    this->_progressChanged = true;
+  }
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/RegionPrecache.h>
+#include <CesiumAsync/Promise.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumRasterOverlays/RasterOverlayTile.h>
+#include <CesiumUtility/IntrusivePointer.h>
+
+#include <memory>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+class Tile;
+class TilesetContentManager;
+struct TilePrecacheResult;
+struct TilesetOptions;
+
+/**
+ * @brief Walks the tiles of a tileset that overlap a rectangle and loads them
+ * into the cache of the asset accessor.
+ *
+ * @see Tileset::precacheRegion
+ */
+class RegionPrecacheJob
+    : public std::enable_shared_from_this<RegionPrecacheJob> {
+public:
+  RegionPrecacheJob(
+      const CesiumGeospatial::GlobeRectangle& rectangle,
+      const RegionPrecacheOptions& options,
+      const CesiumAsync::Promise<RegionPrecacheProgress>& promise);
+
+  /**
+   * @brief Visits the tiles that are ready to be visited, starting as many
+   * loads as the options allow, and resolves the promise once every tile in
+   * the region has been cached.
+   *
+   * @return true if the job is complete.
+   */
+  bool update(
+      TilesetContentManager& contentManager,
+      const TilesetOptions& tilesetOptions);
+
+  /**
+   * @brief Rejects the promise, because the tileset is being destroyed.
+   */
+  void abandon();
+
+private:
+  struct PendingTile {
+    Tile* pTile;
+    uint32_t depth;
+    bool visited;
+    bool fetched;
+  };
+
+  void _visitTile(
+      TilesetContentManager& contentManager,
+      const TilesetOptions& tilesetOptions,
+      PendingTile pending);
+  void _onTileFetched(const PendingTile& pending, TilePrecacheResult&& result);
+  bool _shouldRefine(const Tile& tile, uint32_t depth) const noexcept;
+  void _updateRasterOverlayTiles();
+
+  CesiumGeospatial::GlobeRectangle _rectangle;
+  RegionPrecacheOptions _options;
+  CesiumAsync::Promise<RegionPrecacheProgress> _promise;
+  bool _started;
+  bool _progressChanged;
+  RegionPrecacheProgress _progress;
+
+  std::vector<PendingTile> _pendingTiles;
+
+  // Tiles that the tileset itself was loading when they were visited. They are
+  // visited again on the next update.
+  std::vector<PendingTile> _deferredTiles;
+
+  std::vector<CesiumUtility::IntrusivePointer<
+      CesiumRasterOverlays::RasterOverlayTile>>
+      _rasterOverlayTiles;
+};
+
+} // namespace Cesium3DTilesSelection
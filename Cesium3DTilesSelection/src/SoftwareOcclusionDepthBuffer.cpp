@@ -0,0 +1,268 @@
+#include "SoftwareOcclusionDepthBuffer.h"
+
+#include <Cesium3DTilesSelection/ViewState.h>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <limits>
+#include <utility>
+
+using namespace CesiumGeometry;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+// Points closer than this to the camera along the view direction, in meters,
+// are treated as being behind it.
+const double nearDistance = 1.0;
+
+const double infinity = std::numeric_limits<double>::infinity();
+
+uint32_t getLevelSize(uint32_t size, size_t level) noexcept {
+  const uint32_t divisor = uint32_t(1) << level;
+  return glm::max((size + divisor - 1) / divisor, uint32_t(1));
+}
+
+double edgeFunction(
+    double ax,
+    double ay,
+    double bx,
+    double by,
+    double px,
+    double py) noexcept {
+  return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+} // namespace
+
+SoftwareOcclusionDepthBuffer::SoftwareOcclusionDepthBuffer(
+    const ViewState& viewState,
+    uint32_t width,
+    uint32_t height)
+    : _position(viewState.getPosition()),
+      _forward(glm::normalize(viewState.getDirection())),
+      _right(glm::normalize(glm::cross(_forward, viewState.getUp()))),
+      _up(glm::cross(_right, _forward)),
+      _horizontalScale(
+          0.5 * double(width) /
+          glm::tan(0.5 * viewState.getHorizontalFieldOfView())),
+      _verticalScale(
+          0.5 * double(height) /
+          glm::tan(0.5 * viewState.getVerticalFieldOfView())),
+      _width(glm::max(width, uint32_t(1))),
+      _height(glm::max(height, uint32_t(1))),
+      _levels() {
+  this->_levels.emplace_back(size_t(this->_width) * this->_height, infinity);
+}
+
+void SoftwareOcclusionDepthBuffer::rasterizeTriangle(
+    const glm::dvec3& a,
+    const glm::dvec3& b,
+    const glm::dvec3& c) noexcept {
+  const std::optional<ProjectedPoint> maybeA = this->project(a);
+  const std::optional<ProjectedPoint> maybeB = this->project(b);
+  const std::optional<ProjectedPoint> maybeC = this->project(c);
+  if (!maybeA || !maybeB || !maybeC) {
+    return;
+  }
+
+  const ProjectedPoint& pa = *maybeA;
+  const ProjectedPoint& pb = *maybeB;
+  const ProjectedPoint& pc = *maybeC;
+
+  const double area = edgeFunction(pa.x, pa.y, pb.x, pb.y, pc.x, pc.y);
+  if (area == 0.0) {
+    return;
+  }
+
+  const double minX = glm::max(glm::min(glm::min(pa.x, pb.x), pc.x), 0.0);
+  const double maxX = glm::min(
+      glm::max(glm::max(pa.x, pb.x), pc.x),
+      double(this->_width) - 1.0);
+  const double minY = glm::max(glm::min(glm::min(pa.y, pb.y), pc.y), 0.0);
+  const double maxY = glm::min(
+      glm::max(glm::max(pa.y, pb.y), pc.y),
+      double(this->_height) - 1.0);
+  if (minX > maxX || minY > maxY) {
+    return;
+  }
+
+  // The reciprocal of the depth is linear in screen space. Take the smallest
+  // value within each pixel, so that each pixel holds the farthest depth of
+  // the triangle over its area, but no farther than its farthest vertex.
+  const double inverseA = 1.0 / pa.depth;
+  const double inverseB = 1.0 / pb.depth;
+  const double inverseC = 1.0 / pc.depth;
+  const double inverseDx = ((inverseB - inverseA) * (pc.y - pa.y) -
+                            (inverseC - inverseA) * (pb.y - pa.y)) /
+                           area;
+  const double inverseDy = ((inverseC - inverseA) * (pb.x - pa.x) -
+                            (inverseB - inverseA) * (pc.x - pa.x)) /
+                           area;
+  const double inverseSlack =
+      0.5 * (glm::abs(inverseDx) + glm::abs(inverseDy));
+  const double minimumInverse =
+      glm::min(glm::min(inverseA, inverseB), inverseC);
+
+  std::vector<double>& pixels = this->_levels[0];
+  const uint32_t x0 = uint32_t(minX);
+  const uint32_t x1 = uint32_t(maxX);
+  const uint32_t y0 = uint32_t(minY);
+  const uint32_t y1 = uint32_t(maxY);
+
+  for (uint32_t y = y0; y <= y1; ++y) {
+    const double py = double(y) + 0.5;
+    for (uint32_t x = x0; x <= x1; ++x) {
+      const double px = double(x) + 0.5;
+
+      const double w0 = edgeFunction(pb.x, pb.y, pc.x, pc.y, px, py);
+      const double w1 = edgeFunction(pc.x, pc.y, pa.x, pa.y, px, py);
+      const double w2 = edgeFunction(pa.x, pa.y, pb.x, pb.y, px, py);
+      const bool inside = area > 0.0 ? (w0 >= 0.0 && w1 >= 0.0 && w2 >= 0.0)
+                                     : (w0 <= 0.0 && w1 <= 0.0 && w2 <= 0.0);
+      if (!inside) {
+        continue;
+      }
+
+      const double inverse = glm::max(
+          inverseA + (px - pa.x) * inverseDx + (py - pa.y) * inverseDy -
+              inverseSlack,
+          minimumInverse);
+      double& pixel = pixels[size_t(y) * this->_width + x];
+      pixel = glm::min(pixel, 1.0 / inverse);
+    }
+  }
+}
+
+void SoftwareOcclusionDepthBuffer::finish() {
+  // Pixels whose centers are covered may still be partially uncovered at the
+  // edges of the occluders. So only keep pixels whose neighbors are covered
+  // too, and give them the farthest depth of their neighborhood.
+  const std::vector<double>& covered = this->_levels[0];
+  std::vector<double> eroded(covered.size(), infinity);
+  for (uint32_t y = 0; y < this->_height; ++y) {
+    const uint32_t yStart = y > 0 ? y - 1 : y;
+    const uint32_t yEnd = glm::min(y + 1, this->_height - 1);
+    for (uint32_t x = 0; x < this->_width; ++x) {
+      const uint32_t xStart = x > 0 ? x - 1 : x;
+      const uint32_t xEnd = glm::min(x + 1, this->_width - 1);
+
+      double farthest = 0.0;
+      for (uint32_t ny = yStart; ny <= yEnd; ++ny) {
+        for (uint32_t nx = xStart; nx <= xEnd; ++nx) {
+          farthest =
+              glm::max(farthest, covered[size_t(ny) * this->_width + nx]);
+        }
+      }
+
+      eroded[size_t(y) * this->_width + x] = farthest;
+    }
+  }
+
+  this->_levels[0] = std::move(eroded);
+
+  // Each texel of a less detailed level holds the farthest depth of the 2x2
+  // texels it covers.
+  uint32_t width = this->_width;
+  uint32_t height = this->_height;
+  while (width > 1 || height > 1) {
+    const uint32_t nextWidth = (width + 1) / 2;
+    const uint32_t nextHeight = (height + 1) / 2;
+    const std::vector<double>& level = this->_levels.back();
+    std::vector<double> nextLevel(size_t(nextWidth) * nextHeight, 0.0);
+
+    for (uint32_t y = 0; y < height; ++y) {
+      for (uint32_t x = 0; x < width; ++x) {
+        double& texel = nextLevel[size_t(y / 2) * nextWidth + x / 2];
+        texel = glm::max(texel, level[size_t(y) * width + x]);
+      }
+    }
+
+    this->_levels.emplace_back(std::move(nextLevel));
+    width = nextWidth;
+    height = nextHeight;
+  }
+}
+
+bool SoftwareOcclusionDepthBuffer::isOccluded(
+    const OrientedBoundingBox& box) const noexcept {
+  const glm::dvec3& center = box.getCenter();
+  const glm::dmat3& halfAxes = box.getHalfAxes();
+
+  double minX = infinity;
+  double maxX = -infinity;
+  double minY = infinity;
+  double maxY = -infinity;
+  double nearest = infinity;
+
+  for (int corner = 0; corner < 8; ++corner) {
+    const glm::dvec3 position =
+        center + ((corner & 1) ? halfAxes[0] : -halfAxes[0]) +
+        ((corner & 2) ? halfAxes[1] : -halfAxes[1]) +
+        ((corner & 4) ? halfAxes[2] : -halfAxes[2]);
+    const std::optional<ProjectedPoint> maybeProjected =
+        this->project(position);
+    if (!maybeProjected) {
+      return false;
+    }
+
+    minX = glm::min(minX, maybeProjected->x);
+    maxX = glm::max(maxX, maybeProjected->x);
+    minY = glm::min(minY, maybeProjected->y);
+    maxY = glm::max(maxY, maybeProjected->y);
+    nearest = glm::min(nearest, maybeProjected->depth);
+  }
+
+  // Off-screen boxes are left to frustum culling.
+  if (maxX < 0.0 || maxY < 0.0 || minX >= double(this->_width) ||
+      minY >= double(this->_height)) {
+    return false;
+  }
+
+  uint32_t x0 = uint32_t(glm::max(minX, 0.0));
+  uint32_t x1 = uint32_t(glm::min(maxX, double(this->_width) - 1.0));
+  uint32_t y0 = uint32_t(glm::max(minY, 0.0));
+  uint32_t y1 = uint32_t(glm::min(maxY, double(this->_height) - 1.0));
+
+  // Test a level at which the footprint spans only a few texels.
+  size_t level = 0;
+  while (level + 1 < this->_levels.size() && (x1 - x0 > 3 || y1 - y0 > 3)) {
+    ++level;
+    x0 /= 2;
+    x1 /= 2;
+    y0 /= 2;
+    y1 /= 2;
+  }
+
+  const std::vector<double>& texels = this->_levels[level];
+  const uint32_t levelWidth = getLevelSize(this->_width, level);
+  for (uint32_t y = y0; y <= y1; ++y) {
+    for (uint32_t x = x0; x <= x1; ++x) {
+      if (texels[size_t(y) * levelWidth + x] >= nearest) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+std::optional<SoftwareOcclusionDepthBuffer::ProjectedPoint>
+SoftwareOcclusionDepthBuffer::project(
+    const glm::dvec3& position) const noexcept {
+  const glm::dvec3 offset = position - this->_position;
+  const double depth = glm::dot(offset, this->_forward);
+  if (depth < nearDistance) {
+    return std::nullopt;
+  }
+
+  return ProjectedPoint{
+      0.5 * double(this->_width) +
+          glm::dot(offset, this->_right) / depth * this->_horizontalScale,
+      0.5 * double(this->_height) -
+          glm::dot(offset, this->_up) / depth * this->_verticalScale,
+      depth};
+}
+
+} // namespace Cesium3DTilesSelection
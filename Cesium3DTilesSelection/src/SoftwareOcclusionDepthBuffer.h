@@ -0,0 +1,91 @@
+#pragma once
+
+#include <CesiumGeometry/OrientedBoundingBox.h>
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class ViewState;
+
+/**
+ * @brief A coarse, hierarchical depth buffer for one view, into which occluder
+ * triangles are rasterized on the CPU and against which bounding boxes are
+ * tested for occlusion.
+ *
+ * Each pixel holds the farthest depth of the nearest occluder that covers it,
+ * so that a box is only reported as occluded when it lies behind occluders
+ * across its whole screen-space footprint. Less detailed levels hold the
+ * farthest depth of the pixels they cover.
+ *
+ * Depths are distances along the view direction.
+ */
+class SoftwareOcclusionDepthBuffer {
+public:
+  /**
+   * @brief Creates an empty depth buffer for a view.
+   *
+   * @param viewState The view.
+   * @param width The width of the most detailed level, in pixels.
+   * @param height The height of the most detailed level, in pixels.
+   */
+  SoftwareOcclusionDepthBuffer(
+      const ViewState& viewState,
+      uint32_t width,
+      uint32_t height);
+
+  /**
+   * @brief Rasterizes an opaque triangle, given in Earth-centered,
+   * Earth-fixed coordinates.
+   *
+   * Triangles that are partially behind the near plane are ignored.
+   */
+  void rasterizeTriangle(
+      const glm::dvec3& a,
+      const glm::dvec3& b,
+      const glm::dvec3& c) noexcept;
+
+  /**
+   * @brief Finishes rasterization by shrinking the covered area to account for
+   * partially-covered pixels, and by building the less detailed levels.
+   *
+   * No more triangles may be rasterized afterward.
+   */
+  void finish();
+
+  /**
+   * @brief Determines whether a box is entirely behind the rasterized
+   * occluders.
+   *
+   * Boxes that cross the near plane are never occluded.
+   */
+  bool isOccluded(
+      const CesiumGeometry::OrientedBoundingBox& box) const noexcept;
+
+private:
+  struct ProjectedPoint {
+    double x;
+    double y;
+    double depth;
+  };
+
+  std::optional<ProjectedPoint>
+  project(const glm::dvec3& position) const noexcept;
+
+  glm::dvec3 _position;
+  glm::dvec3 _forward;
+  glm::dvec3 _right;
+  glm::dvec3 _up;
+  double _horizontalScale;
+  double _verticalScale;
+  uint32_t _width;
+  uint32_t _height;
+
+  // Level 0 is the most detailed. Uncovered pixels hold infinity.
+  std::vector<std::vector<double>> _levels;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,172 @@
+#include "Cesium3DTilesSelection/SoftwareTileOcclusionProxyPool.h"
+
+#include "SoftwareOcclusionDepthBuffer.h"
+
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/Cartographic.h>
+
+#include <array>
+#include <optional>
+#include <variant>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+// The bottom surface of each occluder is tessellated into a grid of this many
+// cells along each side, so that it follows the curvature of the ellipsoid.
+const size_t occluderGridSize = 4;
+
+class SoftwareTileOcclusionProxy final : public TileOcclusionRendererProxy {
+public:
+  explicit SoftwareTileOcclusionProxy(
+      const SoftwareTileOcclusionProxyPool& pool) noexcept
+      : _pool(pool), _pTile(nullptr) {}
+
+  virtual TileOcclusionState getOcclusionState() const override {
+    if (!this->_pTile) {
+      return TileOcclusionState::NotOccluded;
+    }
+
+    return this->_pool.computeOcclusionState(
+        this->_pTile->getBoundingVolume());
+  }
+
+protected:
+  virtual void reset(const Tile* pTile) override { this->_pTile = pTile; }
+
+private:
+  const SoftwareTileOcclusionProxyPool& _pool;
+  const Tile* _pTile;
+};
+
+void rasterizeRegionBottom(
+    SoftwareOcclusionDepthBuffer& depthBuffer,
+    const BoundingRegion& region,
+    const Ellipsoid& ellipsoid) {
+  const GlobeRectangle& rectangle = region.getRectangle();
+  const double west = rectangle.getWest();
+  const double south = rectangle.getSouth();
+  const double width = rectangle.computeWidth();
+  const double height = rectangle.computeHeight();
+
+  std::array<glm::dvec3, (occluderGridSize + 1) * (occluderGridSize + 1)>
+      vertices;
+  for (size_t row = 0; row <= occluderGridSize; ++row) {
+    const double latitude =
+        south + height * double(row) / double(occluderGridSize);
+    for (size_t column = 0; column <= occluderGridSize; ++column) {
+      const double longitude =
+          west + width * double(column) / double(occluderGridSize);
+      vertices[row * (occluderGridSize + 1) + column] =
+          ellipsoid.cartographicToCartesian(
+              Cartographic(longitude, latitude, region.getMinimumHeight()));
+    }
+  }
+
+  for (size_t row = 0; row < occluderGridSize; ++row) {
+    for (size_t column = 0; column < occluderGridSize; ++column) {
+      const size_t southwest = row * (occluderGridSize + 1) + column;
+      const size_t southeast = southwest + 1;
+      const size_t northwest = southwest + occluderGridSize + 1;
+      const size_t northeast = northwest + 1;
+      depthBuffer.rasterizeTriangle(
+          vertices[southwest],
+          vertices[southeast],
+          vertices[northeast]);
+      depthBuffer.rasterizeTriangle(
+          vertices[southwest],
+          vertices[northeast],
+          vertices[northwest]);
+    }
+  }
+}
+} // namespace
+
+SoftwareTileOcclusionProxyPool::SoftwareTileOcclusionProxyPool(
+    int32_t maximumPoolSize,
+    uint32_t width,
+    uint32_t height,
+    const Ellipsoid& ellipsoid)
+    : TileOcclusionRendererProxyPool(maximumPoolSize),
+      _width(width),
+      _height(height),
+      _ellipsoid(ellipsoid),
+      _depthBuffers() {}
+
+SoftwareTileOcclusionProxyPool::~SoftwareTileOcclusionProxyPool() noexcept {
+  // The base class destructor can no longer reach our destroyProxy.
+  this->destroyPool();
+}
+
+void SoftwareTileOcclusionProxyPool::updateOccluders(
+    const std::vector<ViewState>& frustums,
+    const std::vector<const Tile*>& occluders) {
+  this->_depthBuffers.clear();
+  this->_depthBuffers.reserve(frustums.size());
+
+  for (const ViewState& frustum : frustums) {
+    auto pDepthBuffer = std::make_unique<SoftwareOcclusionDepthBuffer>(
+        frustum,
+        this->_width,
+        this->_height);
+
+    const std::optional<Cartographic> maybeCameraPosition =
+        this->_ellipsoid.cartesianToCartographic(frustum.getPosition());
+
+    for (const Tile* pOccluder : occluders) {
+      if (!pOccluder) {
+        continue;
+      }
+
+      const BoundingRegion* pRegion =
+          std::get_if<BoundingRegion>(&pOccluder->getBoundingVolume());
+      if (!pRegion) {
+        continue;
+      }
+
+      // A camera underneath the occluder sees its bottom from below, and the
+      // occluder does not hide what is beneath it.
+      if (maybeCameraPosition &&
+          maybeCameraPosition->height < pRegion->getMinimumHeight() &&
+          pRegion->getRectangle().contains(*maybeCameraPosition)) {
+        continue;
+      }
+
+      rasterizeRegionBottom(*pDepthBuffer, *pRegion, this->_ellipsoid);
+    }
+
+    pDepthBuffer->finish();
+    this->_depthBuffers.emplace_back(std::move(pDepthBuffer));
+  }
+}
+
+TileOcclusionState SoftwareTileOcclusionProxyPool::computeOcclusionState(
+    const BoundingVolume& boundingVolume) const {
+  if (this->_depthBuffers.empty()) {
+    return TileOcclusionState::NotOccluded;
+  }
+
+  const OrientedBoundingBox box =
+      getOrientedBoundingBoxFromBoundingVolume(boundingVolume);
+  for (const auto& pDepthBuffer : this->_depthBuffers) {
+    if (!pDepthBuffer->isOccluded(box)) {
+      return TileOcclusionState::NotOccluded;
+    }
+  }
+
+  return TileOcclusionState::Occluded;
+}
+
+TileOcclusionRendererProxy* SoftwareTileOcclusionProxyPool::createProxy() {
+  return new SoftwareTileOcclusionProxy(*this);
+}
+
+void SoftwareTileOcclusionProxyPool::destroyProxy(
+    TileOcclusionRendererProxy* pProxy) {
+  delete static_cast<SoftwareTileOcclusionProxy*>(pProxy);
+}
+
+} // namespace Cesium3DTilesSelection
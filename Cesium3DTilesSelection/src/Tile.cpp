@@ -16,6 +16,28 @@ using namespace CesiumUtility;
 using namespace std::string_literals;
 
 namespace Cesium3DTilesSelection {
+namespace {
+TileLoadEvent getLoadEvent(TileLoadState state) noexcept {
+  switch (state) {
+  case TileLoadState::Unloading:
+    return TileLoadEvent::Unloading;
+  case TileLoadState::FailedTemporarily:
+  case TileLoadState::Failed:
+    return TileLoadEvent::Failed;
+  case TileLoadState::Unloaded:
+    return TileLoadEvent::Unloaded;
+  case TileLoadState::ContentLoading:
+    return TileLoadEvent::ContentLoading;
+  case TileLoadState::ContentLoaded:
+    return TileLoadEvent::ContentLoaded;
+  case TileLoadState::Done:
+    break;
+  }
+
+  return TileLoadEvent::Done;
+}
+} // namespace
+
 Tile::Tile(TilesetContentLoader* pLoader) noexcept
     : Tile(TileConstructorImpl{}, TileLoadState::Unloaded, pLoader) {}
 
@@ -53,11 +75,16 @@ Tile::Tile(
       _refine(TileRefine::Replace),
       _transform(1.0),
       _lastSelectionState(),
+      _selectionDataIndex(InvalidSelectionDataIndex),
+      _occlusionProxyHandle(InvalidOcclusionProxyHandle),
       _loadedTilesLinks(),
       _content{std::forward<TileContentArgs>(args)...},
       _pLoader{pLoader},
       _loadState{loadState},
-      _shouldContentContinueUpdating{true} {}
+      _shouldContentContinueUpdating{true},
+      _pLoadTimeline(),
+      _deferredChildrenIndex(InvalidDeferredChildrenIndex),
+      _rasterOverlayAtlasSize(0) {}
 
 Tile::Tile(Tile&& rhs) noexcept
     : _pParent(rhs._pParent),
@@ -70,11 +97,19 @@ Tile::Tile(Tile&& rhs) noexcept
       _refine(rhs._refine),
       _transform(rhs._transform),
       _lastSelectionState(rhs._lastSelectionState),
+      _selectionDataIndex(rhs._selectionDataIndex),
+      _occlusionProxyHandle(rhs._occlusionProxyHandle),
       _loadedTilesLinks(),
       _content(std::move(rhs._content)),
       _pLoader{rhs._pLoader},
       _loadState{rhs._loadState},
-      _shouldContentContinueUpdating{rhs._shouldContentContinueUpdating} {
+      _shouldContentContinueUpdating{rhs._shouldContentContinueUpdating},
+      _pLoadTimeline(std::move(rhs._pLoadTimeline)),
+      _deferredChildrenIndex(rhs._deferredChildrenIndex),
+      _rasterOverlayAtlasSize(rhs._rasterOverlayAtlasSize) {
+  // The entry in the selection data table now belongs to this tile.
+  rhs._selectionDataIndex = InvalidSelectionDataIndex;
+
   // since children of rhs will have the parent pointed to rhs,
   // we will reparent them to this tile as rhs will be destroyed after this
   for (Tile& tile : this->_children) {
@@ -102,10 +137,16 @@ Tile& Tile::operator=(Tile&& rhs) noexcept {
     this->_refine = rhs._refine;
     this->_transform = rhs._transform;
     this->_lastSelectionState = rhs._lastSelectionState;
+    this->_selectionDataIndex = rhs._selectionDataIndex;
+    rhs._selectionDataIndex = InvalidSelectionDataIndex;
+    this->_occlusionProxyHandle = rhs._occlusionProxyHandle;
     this->_content = std::move(rhs._content);
     this->_pLoader = rhs._pLoader;
     this->_loadState = rhs._loadState;
     this->_shouldContentContinueUpdating = rhs._shouldContentContinueUpdating;
+    this->_pLoadTimeline = std::move(rhs._pLoadTimeline);
+    this->_deferredChildrenIndex = rhs._deferredChildrenIndex;
+    this->_rasterOverlayAtlasSize = rhs._rasterOverlayAtlasSize;
   }
 
   return *this;
@@ -160,20 +201,25 @@ int64_t Tile::computeByteSize() const noexcept {
 
     // Add up the glTF buffers
     for (const CesiumGltf::Buffer& buffer : model.buffers) {
-      bytes += int64_t(buffer.cesium.data.size());
+      bytes += int64_t(buffer.cesium.getData().size());
     }
 
     const std::vector<CesiumGltf::BufferView>& bufferViews = model.bufferViews;
     for (const CesiumGltf::Image& image : model.images) {
       const int32_t bufferView = image.bufferView;
       // For images loaded from buffers, subtract the buffer size before adding
-      // the decoded image size.
+      // the decoded image size, unless the buffer data was released.
       if (bufferView >= 0 &&
           bufferView < static_cast<int32_t>(bufferViews.size())) {
-        bytes -= bufferViews[size_t(bufferView)].byteLength;
+        const CesiumGltf::BufferView& view = bufferViews[size_t(bufferView)];
+        if (view.buffer >= 0 &&
+            view.buffer < static_cast<int32_t>(model.buffers.size()) &&
+            !model.buffers[size_t(view.buffer)].cesium.getData().empty()) {
+          bytes -= view.byteLength;
+        }
       }
 
-      bytes += int64_t(image.cesium.pixelData.size());
+      bytes += int64_t(image.cesium.getPixelData().size());
     }
   }
 
@@ -223,7 +269,12 @@ TileLoadState Tile::getState() const noexcept { return this->_loadState; }
 
 void Tile::setParent(Tile* pParent) noexcept { this->_pParent = pParent; }
 
-void Tile::setState(TileLoadState state) noexcept { this->_loadState = state; }
+void Tile::setState(TileLoadState state) noexcept {
+  this->_loadState = state;
+  if (this->_pLoadTimeline) {
+    this->_pLoadTimeline->record(getLoadEvent(state));
+  }
+}
 
 bool Tile::shouldContentContinueUpdating() const noexcept {
   return this->_shouldContentContinueUpdating;
@@ -7,9 +7,14 @@ namespace Cesium3DTilesSelection {
 TileRenderContent::TileRenderContent(CesiumGltf::Model&& model)
     : _model{std::move(model)},
       _pRenderResources{nullptr},
+      _gpuByteSize{0},
       _rasterOverlayDetails{},
       _credits{},
-      _lodTransitionFadePercentage{0.0f} {}
+      _lodTransitionFadePercentage{0.0f},
+      _modelDataReleased{false},
+      _pFeatureIndex{},
+      _pPackedPropertyTables{},
+      _pGeometryIndex{} {}
 
 const CesiumGltf::Model& TileRenderContent::getModel() const noexcept {
   return _model;
@@ -68,6 +73,14 @@ void TileRenderContent::setRenderResources(void* pRenderResources) noexcept {
   this->_pRenderResources = pRenderResources;
 }
 
+int64_t TileRenderContent::getGpuByteSize() const noexcept {
+  return this->_gpuByteSize;
+}
+
+void TileRenderContent::setGpuByteSize(int64_t gpuByteSize) noexcept {
+  this->_gpuByteSize = gpuByteSize;
+}
+
 float TileRenderContent::getLodTransitionFadePercentage() const noexcept {
   return _lodTransitionFadePercentage;
 }
@@ -77,6 +90,46 @@ void TileRenderContent::setLodTransitionFadePercentage(
   this->_lodTransitionFadePercentage = percentage;
 }
 
+bool TileRenderContent::isModelDataReleased() const noexcept {
+  return this->_modelDataReleased;
+}
+
+void TileRenderContent::setModelDataReleased(bool modelDataReleased) noexcept {
+  this->_modelDataReleased = modelDataReleased;
+}
+
+const TileFeatureIndex* TileRenderContent::getFeatureIndex() const noexcept {
+  return this->_pFeatureIndex.get();
+}
+
+void TileRenderContent::setFeatureIndex(
+    std::shared_ptr<const TileFeatureIndex> pFeatureIndex) noexcept {
+  this->_pFeatureIndex = std::move(pFeatureIndex);
+}
+
+gsl::span<const CesiumGltf::PackedPropertyTable>
+TileRenderContent::getPackedPropertyTables() const noexcept {
+  if (!this->_pPackedPropertyTables) {
+    return {};
+  }
+  return *this->_pPackedPropertyTables;
+}
+
+void TileRenderContent::setPackedPropertyTables(
+    std::shared_ptr<const std::vector<CesiumGltf::PackedPropertyTable>>
+        pPackedPropertyTables) noexcept {
+  this->_pPackedPropertyTables = std::move(pPackedPropertyTables);
+}
+
+const TileGeometryIndex* TileRenderContent::getGeometryIndex() const noexcept {
+  return this->_pGeometryIndex.get();
+}
+
+void TileRenderContent::setGeometryIndex(
+    std::shared_ptr<const TileGeometryIndex> pGeometryIndex) noexcept {
+  this->_pGeometryIndex = std::move(pGeometryIndex);
+}
+
 TileContent::TileContent() : _contentKind{TileUnknownContent{}} {}
 
 TileContent::TileContent(TileEmptyContent content) : _contentKind{content} {}
@@ -10,7 +10,9 @@ TileContentLoadInfo::TileContentLoadInfo(
         pPrepareRendererResources_,
     const std::shared_ptr<spdlog::logger>& pLogger_,
     const TilesetContentOptions& contentOptions_,
-    const Tile& tile)
+    const Tile& tile,
+    const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool_,
+    const CesiumAsync::TaskPriority& priority_)
     : asyncSystem(asyncSystem_),
       pAssetAccessor(pAssetAccessor_),
       pLogger(pLogger_),
@@ -21,5 +23,9 @@ TileContentLoadInfo::TileContentLoadInfo(
       tileRefine(tile.getRefine()),
       tileGeometricError(tile.getGeometricError()),
       tileTransform(tile.getTransform()),
-      contentOptions(contentOptions_) {}
+      contentOptions(contentOptions_),
+      decodeThreadPool(decodeThreadPool_),
+      priority(priority_),
+      processedContentKey(),
+      processedContentUrl() {}
 } // namespace Cesium3DTilesSelection
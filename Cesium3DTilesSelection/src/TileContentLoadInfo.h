@@ -1,5 +1,7 @@
 #pragma once
 
+#include "TileLoadTimelineRecorder.h"
+
 #include <Cesium3DTilesSelection/BoundingVolume.h>
 #include <Cesium3DTilesSelection/IPrepareRendererResources.h>
 #include <Cesium3DTilesSelection/Tile.h>
@@ -8,6 +10,8 @@
 #include <Cesium3DTilesSelection/TilesetOptions.h>
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/ITaskProcessor.h>
+#include <CesiumAsync/ThreadPool.h>
 #include <CesiumGeometry/Axis.h>
 
 #include <gsl/span>
@@ -15,6 +19,8 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
+#include <string>
 
 namespace Cesium3DTilesSelection {
 struct TileContentLoadInfo {
@@ -25,7 +31,9 @@ struct TileContentLoadInfo {
           pPrepareRendererResources,
       const std::shared_ptr<spdlog::logger>& pLogger,
       const TilesetContentOptions& contentOptions,
-      const Tile& tile);
+      const Tile& tile,
+      const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool,
+      const CesiumAsync::TaskPriority& priority);
 
   CesiumAsync::AsyncSystem asyncSystem;
 
@@ -48,5 +56,15 @@ struct TileContentLoadInfo {
   glm::dmat4 tileTransform;
 
   TilesetContentOptions contentOptions;
+
+  std::optional<CesiumAsync::ThreadPool> decodeThreadPool;
+
+  CesiumAsync::TaskPriority priority;
+
+  std::optional<std::string> processedContentKey;
+
+  std::string processedContentUrl;
+
+  std::shared_ptr<TileLoadTimelineRecorder> pTimelineRecorder;
 };
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,142 @@
+#include <Cesium3DTilesSelection/TileFeatureIndex.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltf/PropertyTableView.h>
+#include <CesiumGltf/PropertyTypeTraits.h>
+
+#include <string_view>
+#include <type_traits>
+
+using namespace CesiumGltf;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+
+template <typename Map>
+int64_t getMapSizeBytes(const Map& map) noexcept {
+  using Key = typename Map::key_type;
+  int64_t bytes = static_cast<int64_t>(
+      map.bucket_count() * sizeof(void*) +
+      map.size() * (sizeof(Key) + sizeof(typename Map::mapped_type)));
+  for (const auto& [key, features] : map) {
+    if constexpr (std::is_same_v<Key, std::string>) {
+      bytes += static_cast<int64_t>(key.capacity());
+    }
+    bytes += static_cast<int64_t>(features.capacity() * sizeof(TileFeature));
+  }
+  return bytes;
+}
+
+} // namespace
+
+TileFeatureIndex::TileFeatureIndex(
+    const Model& model,
+    const std::vector<std::string>& propertyIds) {
+  const ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  if (!pMetadata || propertyIds.empty()) {
+    return;
+  }
+
+  for (size_t i = 0; i < pMetadata->propertyTables.size(); ++i) {
+    const PropertyTableView propertyTable(
+        model,
+        pMetadata->propertyTables[i]);
+    if (propertyTable.status() != PropertyTableViewStatus::Valid) {
+      continue;
+    }
+
+    const int64_t propertyTableIndex = static_cast<int64_t>(i);
+    for (const std::string& propertyId : propertyIds) {
+      propertyTable.getPropertyView(
+          propertyId,
+          [this, propertyTableIndex](
+              const std::string& id,
+              const auto& propertyView) {
+            // Normalized integers are viewed as doubles, so they are not
+            // indexed.
+            using ValueType =
+                typename decltype(propertyView.get(0))::value_type;
+            constexpr bool isString = IsMetadataString<ValueType>::value;
+            constexpr bool isInteger = IsMetadataInteger<ValueType>::value;
+
+            if constexpr (isString || isInteger) {
+              if (propertyView.status() !=
+                      PropertyTablePropertyViewStatus::Valid &&
+                  propertyView.status() !=
+                      PropertyTablePropertyViewStatus::
+                          EmptyPropertyWithDefault) {
+                return;
+              }
+
+              PropertyIndex& index = this->_properties[id];
+              for (int64_t row = 0; row < propertyView.size(); ++row) {
+                const std::optional<ValueType> maybeValue =
+                    propertyView.get(row);
+                if (!maybeValue) {
+                  continue;
+                }
+
+                const TileFeature feature{propertyTableIndex, row};
+                if constexpr (isString) {
+                  index.strings[std::string(*maybeValue)].emplace_back(
+                      feature);
+                } else {
+                  index.integers[static_cast<int64_t>(*maybeValue)]
+                      .emplace_back(feature);
+                }
+              }
+            }
+          });
+    }
+  }
+}
+
+gsl::span<const TileFeature> TileFeatureIndex::find(
+    const std::string& propertyId,
+    const std::string& value) const {
+  auto propertyIt = this->_properties.find(propertyId);
+  if (propertyIt == this->_properties.end()) {
+    return {};
+  }
+
+  auto valueIt = propertyIt->second.strings.find(value);
+  if (valueIt == propertyIt->second.strings.end()) {
+    return {};
+  }
+
+  return valueIt->second;
+}
+
+gsl::span<const TileFeature>
+TileFeatureIndex::find(const std::string& propertyId, int64_t value) const {
+  auto propertyIt = this->_properties.find(propertyId);
+  if (propertyIt == this->_properties.end()) {
+    return {};
+  }
+
+  auto valueIt = propertyIt->second.integers.find(value);
+  if (valueIt == propertyIt->second.integers.end()) {
+    return {};
+  }
+
+  return valueIt->second;
+}
+
+bool TileFeatureIndex::isIndexed(const std::string& propertyId) const noexcept {
+  return this->_properties.find(propertyId) != this->_properties.end();
+}
+
+int64_t TileFeatureIndex::getSizeBytes() const noexcept {
+  int64_t bytes = static_cast<int64_t>(sizeof(TileFeatureIndex));
+  for (const auto& [propertyId, index] : this->_properties) {
+    bytes += static_cast<int64_t>(
+        propertyId.capacity() + sizeof(std::string) + sizeof(PropertyIndex));
+    bytes += getMapSizeBytes(index.strings);
+    bytes += getMapSizeBytes(index.integers);
+  }
+  return bytes;
+}
+
+} // namespace Cesium3DTilesSelection
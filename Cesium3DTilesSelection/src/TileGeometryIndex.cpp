@@ -0,0 +1,203 @@
+#include <Cesium3DTilesSelection/TileGeometryIndex.h>
+#include <CesiumGeometry/Ray.h>
+#include <CesiumGltf/AccessorUtility.h>
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+
+#include <algorithm>
+#include <variant>
+
+using namespace CesiumGeometry;
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+
+// Collects the vertex indices of the triangles of a primitive, three for each
+// triangle, keeping the order of the triangles in the primitive.
+template <typename GetIndex>
+void collectTriangles(
+    int32_t mode,
+    int64_t indexCount,
+    GetIndex getIndex,
+    std::vector<uint32_t>& triangles) {
+  switch (mode) {
+  case MeshPrimitive::Mode::TRIANGLES:
+    triangles.reserve(size_t(std::max(indexCount, int64_t(0))));
+    for (int64_t i = 2; i < indexCount; i += 3) {
+      triangles.insert(
+          triangles.end(),
+          {getIndex(i - 2), getIndex(i - 1), getIndex(i)});
+    }
+    break;
+
+  case MeshPrimitive::Mode::TRIANGLE_STRIP:
+    for (int64_t i = 0; i < indexCount - 2; ++i) {
+      if (i % 2) {
+        triangles.insert(
+            triangles.end(),
+            {getIndex(i), getIndex(i + 2), getIndex(i + 1)});
+      } else {
+        triangles.insert(
+            triangles.end(),
+            {getIndex(i), getIndex(i + 1), getIndex(i + 2)});
+      }
+    }
+    break;
+
+  case MeshPrimitive::Mode::TRIANGLE_FAN:
+    for (int64_t i = 2; i < indexCount; ++i) {
+      triangles.insert(
+          triangles.end(),
+          {getIndex(0), getIndex(i - 1), getIndex(i)});
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+struct CollectTrianglesFromAccessor {
+  int32_t mode;
+  int64_t vertexCount;
+  std::vector<uint32_t>& triangles;
+
+  void operator()(std::monostate) {
+    collectTriangles(
+        mode,
+        vertexCount,
+        [](int64_t i) { return static_cast<uint32_t>(i); },
+        triangles);
+  }
+
+  template <typename T> void operator()(const AccessorView<T>& indexView) {
+    if (indexView.status() != AccessorViewStatus::Valid) {
+      return;
+    }
+
+    collectTriangles(
+        mode,
+        indexView.size(),
+        [&indexView](int64_t i) {
+          return static_cast<uint32_t>(indexView.getUnchecked(i));
+        },
+        triangles);
+  }
+};
+
+} // namespace
+
+TileGeometryIndex::TileGeometryIndex(const Model& model) {
+  glm::dmat4 rootTransform(1.0);
+  rootTransform = GltfUtilities::applyRtcCenter(model, rootTransform);
+  rootTransform = GltfUtilities::applyGltfUpAxisTransform(model, rootTransform);
+
+  model.forEachPrimitiveInScene(
+      -1,
+      [this, &rootTransform](
+          const Model& gltf,
+          const Node& /*node*/,
+          const Mesh& mesh,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& nodeTransform) {
+        auto positionIt = primitive.attributes.find("POSITION");
+        if (positionIt == primitive.attributes.end()) {
+          return;
+        }
+
+        const AccessorView<glm::vec3> positionView(gltf, positionIt->second);
+        if (positionView.status() != AccessorViewStatus::Valid) {
+          return;
+        }
+
+        std::vector<uint32_t> triangles;
+        std::visit(
+            CollectTrianglesFromAccessor{
+                primitive.mode,
+                positionView.size(),
+                triangles},
+            getIndexAccessorView(gltf, primitive));
+        if (triangles.empty()) {
+          return;
+        }
+
+        std::vector<glm::vec3> positions(size_t(positionView.size()));
+        positionView.copyTo(positions);
+
+        const glm::dmat4 transform = rootTransform * nodeTransform;
+        this->_primitives.emplace_back(Primitive{
+            static_cast<int32_t>(&mesh - gltf.meshes.data()),
+            static_cast<int32_t>(&primitive - mesh.primitives.data()),
+            transform,
+            glm::affineInverse(transform),
+            TriangleBvh(std::move(positions), triangles)});
+      });
+}
+
+std::optional<TileGeometryIntersection> TileGeometryIndex::intersectRay(
+    const Ray& ray,
+    const glm::dmat4& tileTransform,
+    bool cullBackFaces) const {
+  if (this->_primitives.empty()) {
+    return std::nullopt;
+  }
+
+  const glm::dmat4 inverseTileTransform = glm::affineInverse(tileTransform);
+
+  std::optional<TileGeometryIntersection> result;
+  for (const Primitive& primitive : this->_primitives) {
+    // Find the intersection in the coordinates of the primitive, where the
+    // direction of the ray may be scaled.
+    const glm::dmat4 toPrimitive =
+        primitive.inverseTransform * inverseTileTransform;
+    const glm::dvec3 origin(toPrimitive * glm::dvec4(ray.getOrigin(), 1.0));
+    const glm::dvec3 direction(
+        toPrimitive * glm::dvec4(ray.getDirection(), 0.0));
+    const double scale = glm::length(direction);
+    if (scale == 0.0) {
+      continue;
+    }
+
+    const std::optional<TriangleBvhIntersection> maybeIntersection =
+        primitive.bvh.intersectRay(
+            Ray(origin, direction / scale),
+            cullBackFaces);
+    if (!maybeIntersection) {
+      continue;
+    }
+
+    const double distance = maybeIntersection->t / scale;
+    if (result && result->distance <= distance) {
+      continue;
+    }
+
+    result = TileGeometryIntersection{
+        distance,
+        ray.getOrigin() + ray.getDirection() * distance,
+        primitive.meshId,
+        primitive.primitiveId,
+        int64_t(maybeIntersection->triangleIndex)};
+  }
+
+  return result;
+}
+
+int64_t TileGeometryIndex::getSizeBytes() const noexcept {
+  int64_t bytes = static_cast<int64_t>(
+      sizeof(TileGeometryIndex) +
+      this->_primitives.capacity() * sizeof(Primitive));
+  for (const Primitive& primitive : this->_primitives) {
+    bytes += primitive.bvh.getSizeBytes() -
+             static_cast<int64_t>(sizeof(TriangleBvh));
+  }
+  return bytes;
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,171 @@
+#include "Cesium3DTilesSelection/TileLoadScheduler.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Cesium3DTilesSelection {
+
+TileLoadScheduler::TileLoadScheduler(
+    uint32_t maximumSimultaneousTileLoads,
+    int64_t maximumCachedBytes) noexcept
+    : _maximumSimultaneousTileLoads(maximumSimultaneousTileLoads),
+      _maximumCachedBytes(maximumCachedBytes),
+      _nextTilesetID(1),
+      _requestCount(0),
+      _tilesets(),
+      _rankedPriorities() {}
+
+uint32_t TileLoadScheduler::getNumberOfTilesLoading() const noexcept {
+  uint32_t tilesLoading = 0;
+  for (const TilesetState& tileset : this->_tilesets) {
+    tilesLoading += tileset.tilesLoading;
+  }
+  return tilesLoading;
+}
+
+int64_t TileLoadScheduler::getTotalDataBytes() const noexcept {
+  int64_t dataBytes = 0;
+  for (const TilesetState& tileset : this->_tilesets) {
+    dataBytes += tileset.dataBytes;
+  }
+  return dataBytes;
+}
+
+bool TileLoadScheduler::canStartLowPriorityLoad() const noexcept {
+  return this->getNumberOfTilesLoading() <
+             this->_maximumSimultaneousTileLoads &&
+         this->getTotalDataBytes() < this->_maximumCachedBytes;
+}
+
+uint64_t TileLoadScheduler::addTileset() {
+  const uint64_t tilesetID = this->_nextTilesetID++;
+  this->_tilesets.push_back({tilesetID, 0, 0, this->_requestCount, {}});
+  return tilesetID;
+}
+
+void TileLoadScheduler::removeTileset(uint64_t tilesetID) noexcept {
+  auto it = std::find_if(
+      this->_tilesets.begin(),
+      this->_tilesets.end(),
+      [tilesetID](const TilesetState& tileset) {
+        return tileset.id == tilesetID;
+      });
+  if (it != this->_tilesets.end()) {
+    this->_tilesets.erase(it);
+  }
+}
+
+size_t TileLoadScheduler::requestLoadSlots(
+    uint64_t tilesetID,
+    const std::vector<TileLoadPriority>& priorities,
+    uint32_t tilesLoading,
+    int64_t dataBytes) {
+  ++this->_requestCount;
+
+  TilesetState* pTileset = this->findTileset(tilesetID);
+  assert(pTileset && "The tileset must be added to the scheduler first");
+  if (!pTileset) {
+    return 0;
+  }
+
+  pTileset->tilesLoading = tilesLoading;
+  pTileset->dataBytes = dataBytes;
+  pTileset->lastRequest = this->_requestCount;
+  pTileset->priorities = priorities;
+
+  const uint32_t totalTilesLoading = this->getNumberOfTilesLoading();
+  if (totalTilesLoading >= this->_maximumSimultaneousTileLoads) {
+    return 0;
+  }
+
+  const size_t freeSlots =
+      size_t(this->_maximumSimultaneousTileLoads - totalTilesLoading);
+  const bool overBudget =
+      this->getTotalDataBytes() >= this->_maximumCachedBytes;
+  auto canStart = [overBudget](const TileLoadPriority& priority) {
+    return !overBudget || priority.group == TileLoadPriorityGroup::Urgent;
+  };
+
+  // Rank the loads against those the other tilesets requested recently. Each
+  // tileset requests once per frame, so one that has not requested in two
+  // rounds is no longer updated, and must not hold up the others.
+  const uint64_t staleAfter = 2 * uint64_t(this->_tilesets.size());
+  std::vector<TileLoadPriority>& ranked = this->_rankedPriorities;
+  ranked.clear();
+  for (const TilesetState& tileset : this->_tilesets) {
+    if (&tileset == pTileset ||
+        this->_requestCount - tileset.lastRequest > staleAfter) {
+      continue;
+    }
+
+    for (const TileLoadPriority& priority : tileset.priorities) {
+      if (canStart(priority)) {
+        ranked.push_back(priority);
+      }
+    }
+  }
+
+  size_t candidates = 0;
+  for (const TileLoadPriority& priority : priorities) {
+    if (canStart(priority)) {
+      ranked.push_back(priority);
+      ++candidates;
+    }
+  }
+
+  if (candidates == 0 || ranked.size() <= freeSlots) {
+    return std::min(candidates, freeSlots);
+  }
+
+  // Find the lowest priority load that still gets a slot, and allow this
+  // tileset's loads that are at least as important.
+  auto last = ranked.begin() + static_cast<std::ptrdiff_t>(freeSlots - 1);
+  std::nth_element(ranked.begin(), last, ranked.end());
+  const TileLoadPriority threshold = *last;
+
+  size_t allowed = 0;
+  for (const TileLoadPriority& priority : priorities) {
+    if (canStart(priority) && !(threshold < priority)) {
+      ++allowed;
+    }
+  }
+
+  return std::min(allowed, freeSlots);
+}
+
+void TileLoadScheduler::notifyTilesLoading(
+    uint64_t tilesetID,
+    uint32_t tilesLoading) noexcept {
+  TilesetState* pTileset = this->findTileset(tilesetID);
+  if (!pTileset) {
+    return;
+  }
+
+  // The loads that were started since the request were the tileset's highest
+  // priority ones, so they no longer compete with other loads.
+  if (tilesLoading > pTileset->tilesLoading) {
+    std::vector<TileLoadPriority>& priorities = pTileset->priorities;
+    const size_t started = std::min(
+        size_t(tilesLoading - pTileset->tilesLoading),
+        priorities.size());
+    auto firstWaiting =
+        priorities.begin() + static_cast<std::ptrdiff_t>(started);
+    std::nth_element(priorities.begin(), firstWaiting, priorities.end());
+    priorities.erase(priorities.begin(), firstWaiting);
+  }
+
+  pTileset->tilesLoading = tilesLoading;
+}
+
+TileLoadScheduler::TilesetState*
+TileLoadScheduler::findTileset(uint64_t tilesetID) noexcept {
+  auto it = std::find_if(
+      this->_tilesets.begin(),
+      this->_tilesets.end(),
+      [tilesetID](const TilesetState& tileset) {
+        return tileset.id == tilesetID;
+      });
+  return it == this->_tilesets.end() ? nullptr : &*it;
+}
+
+} // namespace Cesium3DTilesSelection
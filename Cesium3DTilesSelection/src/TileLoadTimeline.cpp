@@ -0,0 +1,91 @@
+#include "Cesium3DTilesSelection/TileLoadTimeline.h"
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+
+struct PhaseEvents {
+  TileLoadEvent start;
+  TileLoadEvent end;
+};
+
+// The events that start and end each phase, indexed by TileLoadPhase.
+constexpr std::array<PhaseEvents, TileLoadTimeline::PhaseCount> phaseEvents{
+    {{TileLoadEvent::Queued, TileLoadEvent::ContentLoading},
+     {TileLoadEvent::RequestStarted, TileLoadEvent::RequestFinished},
+     {TileLoadEvent::ContentLoading, TileLoadEvent::ProcessedContentCacheHit},
+     {TileLoadEvent::RequestFinished, TileLoadEvent::ContentParsed},
+     {TileLoadEvent::ContentParsed, TileLoadEvent::DecodeStarted},
+     {TileLoadEvent::DecodeStarted, TileLoadEvent::PrepareInLoadThreadStarted},
+     {TileLoadEvent::PrepareInLoadThreadStarted,
+      TileLoadEvent::PrepareInLoadThreadFinished},
+     {TileLoadEvent::ContentLoaded, TileLoadEvent::PrepareInMainThreadStarted},
+     {TileLoadEvent::PrepareInMainThreadStarted, TileLoadEvent::Done},
+     {TileLoadEvent::Queued, TileLoadEvent::Done}}};
+
+} // namespace
+
+std::optional<TileLoadTimeline::Clock::time_point>
+TileLoadTimeline::getTime(TileLoadEvent event) const noexcept {
+  const Clock::time_point time = this->_times[size_t(event)];
+  if (time == Clock::time_point()) {
+    return std::nullopt;
+  }
+
+  return time;
+}
+
+std::optional<double>
+TileLoadTimeline::getDuration(TileLoadPhase phase) const noexcept {
+  const PhaseEvents& events = phaseEvents[size_t(phase)];
+  const std::optional<Clock::time_point> start = this->getTime(events.start);
+  const std::optional<Clock::time_point> end = this->getTime(events.end);
+  if (!start || !end || *end < *start) {
+    return std::nullopt;
+  }
+
+  return std::chrono::duration<double>(*end - *start).count();
+}
+
+void TileLoadTimeline::record(
+    TileLoadEvent event,
+    Clock::time_point time) noexcept {
+  this->_times[size_t(event)] = time;
+}
+
+void TileLoadTimeline::recordFirst(
+    TileLoadEvent event,
+    Clock::time_point time) noexcept {
+  Clock::time_point& recorded = this->_times[size_t(event)];
+  if (recorded == Clock::time_point()) {
+    recorded = time;
+  }
+}
+
+void TileLoadTimeline::merge(const TileLoadTimeline& other) noexcept {
+  for (size_t i = 0; i < EventCount; ++i) {
+    if (other._times[i] != Clock::time_point()) {
+      this->_times[i] = other._times[i];
+    }
+  }
+}
+
+void TileLoadTimeline::clear() noexcept { this->_times.fill({}); }
+
+void TileLoadHistograms::add(const TileLoadTimeline& timeline) noexcept {
+  if (timeline.getTime(TileLoadEvent::Done)) {
+    ++this->doneCount;
+  } else if (timeline.getTime(TileLoadEvent::Failed)) {
+    ++this->failedCount;
+  }
+
+  for (size_t i = 0; i < TileLoadTimeline::PhaseCount; ++i) {
+    const std::optional<double> duration =
+        timeline.getDuration(TileLoadPhase(i));
+    if (duration) {
+      this->phases[i].add(*duration * 1000.0);
+    }
+  }
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,117 @@
+#include "TileLoadTimelineRecorder.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetRequest.h>
+
+using namespace CesiumAsync;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+
+// Records when the first request starts and the last request finishes. It
+// only keeps a weak pointer to the recorder, since loaders may keep the
+// accessor of a load for later requests.
+class RecordingAssetAccessor : public IAssetAccessor {
+public:
+  RecordingAssetAccessor(
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+      const std::weak_ptr<TileLoadTimelineRecorder>& pRecorder)
+      : _pAssetAccessor(pAssetAccessor), _pRecorder(pRecorder) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    this->recordStart();
+    return this->recordFinish(
+        this->_pAssetAccessor->get(asyncSystem, url, headers));
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> getStreaming(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const DataReceivedCallback& onDataReceived) override {
+    this->recordStart();
+    return this->recordFinish(this->_pAssetAccessor->getStreaming(
+        asyncSystem,
+        url,
+        headers,
+        onDataReceived));
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override {
+    this->recordStart();
+    return this->recordFinish(this->_pAssetAccessor->request(
+        asyncSystem,
+        verb,
+        url,
+        headers,
+        contentPayload));
+  }
+
+  virtual void tick() noexcept override { this->_pAssetAccessor->tick(); }
+
+private:
+  void recordStart() const noexcept {
+    std::shared_ptr<TileLoadTimelineRecorder> pRecorder =
+        this->_pRecorder.lock();
+    if (pRecorder) {
+      pRecorder->recordFirst(TileLoadEvent::RequestStarted);
+    }
+  }
+
+  Future<std::shared_ptr<IAssetRequest>>
+  recordFinish(Future<std::shared_ptr<IAssetRequest>>&& future) const {
+    return std::move(future).thenImmediately(
+        [pRecorder = this->_pRecorder](
+            std::shared_ptr<IAssetRequest>&& pRequest) {
+          std::shared_ptr<TileLoadTimelineRecorder> pLocked = pRecorder.lock();
+          if (pLocked) {
+            pLocked->record(TileLoadEvent::RequestFinished);
+          }
+          return std::move(pRequest);
+        });
+  }
+
+  std::shared_ptr<IAssetAccessor> _pAssetAccessor;
+  std::weak_ptr<TileLoadTimelineRecorder> _pRecorder;
+};
+
+} // namespace
+
+std::shared_ptr<TileLoadTimelineRecorder> TileLoadTimelineRecorder::create(
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor) {
+  std::shared_ptr<TileLoadTimelineRecorder> pRecorder(
+      new TileLoadTimelineRecorder());
+  pRecorder->_pAssetAccessor =
+      std::make_shared<RecordingAssetAccessor>(pAssetAccessor, pRecorder);
+  return pRecorder;
+}
+
+void TileLoadTimelineRecorder::record(
+    TileLoadEvent event,
+    TileLoadTimeline::Clock::time_point time) noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_timeline.record(event, time);
+}
+
+void TileLoadTimelineRecorder::recordFirst(
+    TileLoadEvent event,
+    TileLoadTimeline::Clock::time_point time) noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_timeline.recordFirst(event, time);
+}
+
+TileLoadTimeline TileLoadTimelineRecorder::getTimeline() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_timeline;
+}
+
+} // namespace Cesium3DTilesSelection
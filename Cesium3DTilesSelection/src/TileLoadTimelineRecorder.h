@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/TileLoadTimeline.h>
+#include <CesiumAsync/IAssetAccessor.h>
+
+#include <memory>
+#include <mutex>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Records the events of a tile load that happen outside of the main
+ * thread, until the load is back in the main thread and they can be merged
+ * into the {@link TileLoadTimeline} of the tile.
+ *
+ * The recorder also provides the asset accessor for the loader of the tile,
+ * which records when the requests of the loader start and finish. Its
+ * methods may be called from any thread.
+ */
+class TileLoadTimelineRecorder {
+public:
+  /**
+   * @brief Creates a recorder for a load.
+   *
+   * @param pAssetAccessor The asset accessor that makes the requests.
+   */
+  static std::shared_ptr<TileLoadTimelineRecorder>
+  create(const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor);
+
+  /**
+   * @brief Gets the asset accessor that records the requests made with it.
+   *
+   * Requests that are made with it after the recorder is destroyed, by a
+   * loader that keeps it, are not recorded.
+   */
+  const std::shared_ptr<CesiumAsync::IAssetAccessor>&
+  getAssetAccessor() const noexcept {
+    return this->_pAssetAccessor;
+  }
+
+  /** @copydoc TileLoadTimeline::record */
+  void record(
+      TileLoadEvent event,
+      TileLoadTimeline::Clock::time_point time =
+          TileLoadTimeline::Clock::now()) noexcept;
+
+  /** @copydoc TileLoadTimeline::recordFirst */
+  void recordFirst(
+      TileLoadEvent event,
+      TileLoadTimeline::Clock::time_point time =
+          TileLoadTimeline::Clock::now()) noexcept;
+
+  /**
+   * @brief Gets a copy of the events recorded so far.
+   */
+  TileLoadTimeline getTimeline() const noexcept;
+
+private:
+  TileLoadTimelineRecorder() noexcept = default;
+
+  mutable std::mutex _mutex;
+  TileLoadTimeline _timeline;
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -4,82 +4,126 @@ namespace Cesium3DTilesSelection {
 
 TileOcclusionRendererProxyPool::TileOcclusionRendererProxyPool(
     int32_t maximumPoolSize)
-    : _pFreeProxiesHead(nullptr),
-      _currentSize(0),
-      _maxSize(maximumPoolSize < 0 ? 0 : maximumPoolSize),
-      _tileToOcclusionProxyMappings(size_t(this->_maxSize)) {}
+    : _slots(),
+      _freeSlotsHead(InvalidSlot),
+      _usedSlotsHead(InvalidSlot),
+      _usedSlotsTail(InvalidSlot),
+      _pruneCount(0),
+      _maxSize(maximumPoolSize < 0 ? 0 : maximumPoolSize) {
+  this->_slots.reserve(size_t(this->_maxSize));
+}
 
 TileOcclusionRendererProxyPool::~TileOcclusionRendererProxyPool() {
   this->destroyPool();
 }
 
 void TileOcclusionRendererProxyPool::destroyPool() {
-  for (auto& pair : this->_tileToOcclusionProxyMappings) {
-    this->destroyProxy(pair.second);
+  for (const Slot& slot : this->_slots) {
+    this->destroyProxy(slot.pProxy);
   }
 
-  this->_tileToOcclusionProxyMappings.clear();
-
-  while (this->_pFreeProxiesHead) {
-    TileOcclusionRendererProxy* pNext = this->_pFreeProxiesHead->_pNext;
-    this->destroyProxy(this->_pFreeProxiesHead);
-    this->_pFreeProxiesHead = pNext;
-  }
-
-  this->_currentSize = 0;
+  this->_slots.clear();
+  this->_freeSlotsHead = InvalidSlot;
+  this->_usedSlotsHead = InvalidSlot;
+  this->_usedSlotsTail = InvalidSlot;
 }
 
 const TileOcclusionRendererProxy*
 TileOcclusionRendererProxyPool::fetchOcclusionProxyForTile(
     const Tile& tile,
     int32_t /*currentFrame*/) {
-  auto mappingIt = this->_tileToOcclusionProxyMappings.find(&tile);
-  if (mappingIt != this->_tileToOcclusionProxyMappings.end()) {
-    TileOcclusionRendererProxy* pProxy = mappingIt->second;
-    pProxy->_usedLastFrame = true;
+  // The handle on the tile may be stale, or from another pool, so it is only
+  // used if the slot is still mapped to this tile.
+  const uint32_t handle = tile._occlusionProxyHandle;
+  if (handle < this->_slots.size() && this->_slots[handle].pTile == &tile) {
+    Slot& slot = this->_slots[handle];
+    if (slot.lastUsedPrune != this->_pruneCount) {
+      slot.lastUsedPrune = this->_pruneCount;
+      this->unlinkUsedSlot(handle);
+      this->linkUsedSlot(handle);
+    }
 
-    return pProxy;
+    return slot.pProxy;
   }
 
-  if (!this->_pFreeProxiesHead && this->_currentSize < this->_maxSize) {
-    this->_pFreeProxiesHead = this->createProxy();
-    if (this->_pFreeProxiesHead) {
-      ++this->_currentSize;
+  if (this->_freeSlotsHead == InvalidSlot &&
+      this->_slots.size() < size_t(this->_maxSize)) {
+    TileOcclusionRendererProxy* pProxy = this->createProxy();
+    if (pProxy) {
+      this->_slots.push_back(
+          Slot{pProxy, nullptr, 0, InvalidSlot, InvalidSlot});
+      this->_freeSlotsHead = uint32_t(this->_slots.size() - 1);
     }
   }
 
-  if (!this->_pFreeProxiesHead) {
+  if (this->_freeSlotsHead == InvalidSlot) {
     // Pool is full or createProxy returned nullptr
     return nullptr;
   }
 
-  TileOcclusionRendererProxy* pAssignedProxy = this->_pFreeProxiesHead;
-  this->_pFreeProxiesHead = this->_pFreeProxiesHead->_pNext;
-  pAssignedProxy->_pNext = nullptr;
-  pAssignedProxy->_usedLastFrame = true;
+  const uint32_t index = this->_freeSlotsHead;
+  Slot& slot = this->_slots[index];
+  this->_freeSlotsHead = slot.next;
+  slot.pTile = &tile;
+  slot.lastUsedPrune = this->_pruneCount;
+  this->linkUsedSlot(index);
 
-  this->_tileToOcclusionProxyMappings.emplace(&tile, pAssignedProxy);
-  pAssignedProxy->reset(&tile);
+  tile._occlusionProxyHandle = index;
+  slot.pProxy->reset(&tile);
 
-  return pAssignedProxy;
+  return slot.pProxy;
 }
 
 void TileOcclusionRendererProxyPool::pruneOcclusionProxyMappings() {
-  for (auto iter = this->_tileToOcclusionProxyMappings.begin();
-       iter != this->_tileToOcclusionProxyMappings.end();) {
-    if (!iter->second->_usedLastFrame) {
-      // This tile was not traversed last frame, unmap the proxy and re-add it
-      // to the free list.
-      iter->second->reset(nullptr);
-      iter->second->_pNext = this->_pFreeProxiesHead;
-      this->_pFreeProxiesHead = iter->second;
-      iter = this->_tileToOcclusionProxyMappings.erase(iter);
-    } else {
-      // Reset the flag.
-      iter->second->_usedLastFrame = false;
-      ++iter;
-    }
+  // The least recently used slots are at the head of the list, so the slots
+  // that were not used since the last prune are all before the first one
+  // that was.
+  while (this->_usedSlotsHead != InvalidSlot &&
+         this->_slots[this->_usedSlotsHead].lastUsedPrune !=
+             this->_pruneCount) {
+    // This tile was not traversed last frame, unmap the proxy and re-add it
+    // to the free list.
+    const uint32_t index = this->_usedSlotsHead;
+    Slot& slot = this->_slots[index];
+    this->unlinkUsedSlot(index);
+    slot.pProxy->reset(nullptr);
+    slot.pTile = nullptr;
+    slot.next = this->_freeSlotsHead;
+    this->_freeSlotsHead = index;
   }
+
+  ++this->_pruneCount;
+}
+
+void TileOcclusionRendererProxyPool::unlinkUsedSlot(uint32_t index) noexcept {
+  Slot& slot = this->_slots[index];
+  if (slot.previous != InvalidSlot) {
+    this->_slots[slot.previous].next = slot.next;
+  } else {
+    this->_usedSlotsHead = slot.next;
+  }
+
+  if (slot.next != InvalidSlot) {
+    this->_slots[slot.next].previous = slot.previous;
+  } else {
+    this->_usedSlotsTail = slot.previous;
+  }
+
+  slot.previous = InvalidSlot;
+  slot.next = InvalidSlot;
+}
+
+void TileOcclusionRendererProxyPool::linkUsedSlot(uint32_t index) noexcept {
+  Slot& slot = this->_slots[index];
+  slot.previous = this->_usedSlotsTail;
+  slot.next = InvalidSlot;
+  if (this->_usedSlotsTail != InvalidSlot) {
+    this->_slots[this->_usedSlotsTail].next = index;
+  } else {
+    this->_usedSlotsHead = index;
+  }
+
+  this->_usedSlotsTail = index;
 }
 
 } // namespace Cesium3DTilesSelection
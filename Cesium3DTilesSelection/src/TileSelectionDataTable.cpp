@@ -0,0 +1,126 @@
+#include "TileSelectionDataTable.h"
+
+#include <Cesium3DTilesSelection/Tile.h>
+
+#include <gsl/span>
+
+namespace Cesium3DTilesSelection {
+
+void TileSelectionDataTable::registerSubtree(Tile& tile) {
+  const uint32_t index = this->indexOf(tile);
+  if (index != InvalidIndex) {
+    this->assign(index, tile);
+  } else if (this->_data.size() < InvalidIndex) {
+    // Only the root tile is registered without its siblings.
+    this->add(tile);
+  }
+
+  this->registerChildren(tile);
+}
+
+void TileSelectionDataTable::update(const Tile& tile) noexcept {
+  const uint32_t index = this->indexOf(tile);
+  if (index != InvalidIndex) {
+    this->assign(index, tile);
+  }
+}
+
+void TileSelectionDataTable::updateRenderable(const Tile& tile) noexcept {
+  const uint32_t index = this->indexOf(tile);
+  if (index != InvalidIndex) {
+    this->_data[index].renderable = tile.isRenderable();
+  }
+}
+
+void TileSelectionDataTable::setLastSelectionState(
+    Tile& tile,
+    uint32_t index,
+    const TileSelectionState& selectionState) noexcept {
+  tile.setLastSelectionState(selectionState);
+  if (index < this->_data.size()) {
+    this->_data[index].lastSelectionState = selectionState;
+  }
+}
+
+void TileSelectionDataTable::clear() noexcept {
+  this->_data.clear();
+  this->_boundingVolumes.clear();
+  this->_enclosingSpheres.clear();
+}
+
+uint32_t TileSelectionDataTable::indexOf(const Tile& tile) const noexcept {
+  const uint32_t index = tile._selectionDataIndex;
+  return index < this->_data.size() ? index : InvalidIndex;
+}
+
+uint32_t TileSelectionDataTable::getChildIndex(
+    uint32_t parentIndex,
+    size_t childIndex) const noexcept {
+  const TileSelectionData* pParent = this->get(parentIndex);
+  if (!pParent || pParent->firstChild == InvalidIndex ||
+      childIndex >= pParent->childCount) {
+    return InvalidIndex;
+  }
+
+  return pParent->firstChild + static_cast<uint32_t>(childIndex);
+}
+
+void TileSelectionDataTable::registerChildren(Tile& tile) {
+  const uint32_t parentIndex = this->indexOf(tile);
+  gsl::span<Tile> children = tile.getChildren();
+
+  // Children are created and registered all at once, so children that are
+  // already registered were registered along with their whole subtree.
+  if (parentIndex == InvalidIndex || children.empty() ||
+      this->indexOf(children[0]) != InvalidIndex ||
+      children.size() >= InvalidIndex - this->_data.size()) {
+    // If out of indices, these children will be read directly instead.
+    return;
+  }
+
+  const uint32_t firstChild = static_cast<uint32_t>(this->_data.size());
+  for (Tile& child : children) {
+    this->add(child);
+  }
+
+  this->_data[parentIndex].firstChild = firstChild;
+
+  for (Tile& child : children) {
+    this->registerChildren(child);
+  }
+}
+
+void TileSelectionDataTable::add(Tile& tile) {
+  const BoundingVolume& boundingVolume = tile.getBoundingVolume();
+
+  tile._selectionDataIndex = static_cast<uint32_t>(this->_data.size());
+  this->_data.emplace_back(TileSelectionData{
+      getBoundingVolumeCenter(boundingVolume),
+      tile.getGeometricError(),
+      InvalidIndex,
+      static_cast<uint32_t>(tile.getChildren().size()),
+      tile.getLastSelectionState(),
+      tile.getRefine(),
+      tile.getUnconditionallyRefine(),
+      tile.isRenderable()});
+  this->_boundingVolumes.emplace_back(boundingVolume);
+  this->_enclosingSpheres.emplace_back(computeEnclosingSphere(boundingVolume));
+}
+
+void TileSelectionDataTable::assign(uint32_t index, const Tile& tile) noexcept {
+  const BoundingVolume& boundingVolume = tile.getBoundingVolume();
+
+  TileSelectionData& data = this->_data[index];
+  data.boundingVolumeCenter = getBoundingVolumeCenter(boundingVolume);
+  data.geometricError = tile.getGeometricError();
+  data.childCount = static_cast<uint32_t>(tile.getChildren().size());
+  data.lastSelectionState = tile.getLastSelectionState();
+  data.refine = tile.getRefine();
+  data.unconditionallyRefine = tile.getUnconditionallyRefine();
+  data.renderable = tile.isRenderable();
+
+  this->_boundingVolumes[index] = boundingVolume;
+  this->_enclosingSpheres[index] = computeEnclosingSphere(boundingVolume);
+}
+
+} // namespace Cesium3DTilesSelection
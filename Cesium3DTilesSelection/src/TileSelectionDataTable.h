@@ -0,0 +1,228 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/TileRefine.h>
+#include <Cesium3DTilesSelection/TileSelectionState.h>
+#include <CesiumGeometry/BoundingSphere.h>
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+
+/**
+ * @brief The subset of a {@link Tile}'s properties that is read for every
+ * visited tile during tile selection.
+ *
+ * The entries of the children of a tile are contiguous, so the traversal
+ * steps from a tile's entry to those of its children without reading the
+ * tiles. Each instance fills one 64-byte cache line.
+ */
+struct alignas(64) TileSelectionData {
+  /**
+   * @brief The center of the tile's bounding volume.
+   */
+  glm::dvec3 boundingVolumeCenter;
+
+  /**
+   * @brief The tile's geometric error. This is infinity for tiles that are
+   * unconditionally refined.
+   */
+  double geometricError;
+
+  /**
+   * @brief The index of the entry of the tile's first child, or
+   * {@link TileSelectionDataTable::InvalidIndex} if its children are not
+   * registered.
+   */
+  uint32_t firstChild;
+
+  /**
+   * @brief The number of the tile's children.
+   */
+  uint32_t childCount;
+
+  /**
+   * @brief The tile's last selection state, as given by
+   * {@link Tile::getLastSelectionState}.
+   */
+  TileSelectionState lastSelectionState;
+
+  /**
+   * @brief The tile's refinement.
+   */
+  TileRefine refine;
+
+  /**
+   * @brief Whether the tile is unconditionally refined.
+   */
+  bool unconditionallyRefine;
+
+  /**
+   * @brief Whether the tile is renderable, as given by
+   * {@link Tile::isRenderable}.
+   */
+  bool renderable;
+};
+
+static_assert(sizeof(TileSelectionData) == 64);
+
+/**
+ * @brief A packed side table of {@link TileSelectionData}, indexed by tile.
+ *
+ * The tile selection traversal reads the geometry and the hierarchy of the
+ * tiles from this table instead of from the larger, mostly-cold {@link Tile}
+ * objects: the entry of the root tile is looked up once, and the traversal
+ * then steps from each entry to those of its children. The bounding volumes
+ * are mirrored in a separate array, because they are only read while
+ * culling and computing distances.
+ *
+ * The children of a tile are never removed once they are created, so tiles
+ * are only destroyed along with the whole hierarchy, and entries are only
+ * ever added. The table holds at most one entry for each tile of the current
+ * hierarchy: it is cleared when the root tile is replaced, and a tile that is
+ * moved from gives up its entry. The table must be told whenever tiles are
+ * added to the hierarchy, or a tile's bounding volume, geometric error,
+ * refinement, selection state or renderability changes. Entries of distinct
+ * tiles may be modified concurrently, but it is not thread-safe to add
+ * entries while the table is being read.
+ */
+class TileSelectionDataTable {
+public:
+  /**
+   * @brief The index of a tile that is not registered.
+   */
+  static constexpr uint32_t InvalidIndex =
+      std::numeric_limits<uint32_t>::max();
+
+  /**
+   * @brief Adds entries for a tile and all of its descendants that do not
+   * have one yet, and refreshes the entry of the tile itself.
+   *
+   * The children of each tile are added together, so that their entries are
+   * contiguous.
+   *
+   * @param tile The root of the subtree to register.
+   */
+  void registerSubtree(Tile& tile);
+
+  /**
+   * @brief Refreshes the entry of a tile from its current properties.
+   *
+   * Does nothing if the tile has not been registered.
+   *
+   * @param tile The tile to refresh.
+   */
+  void update(const Tile& tile) noexcept;
+
+  /**
+   * @brief Refreshes whether the entry of a tile is renderable.
+   *
+   * This is cheaper than {@link update}, and is used when the tile's load
+   * state or raster overlays change. Does nothing if the tile has not been
+   * registered.
+   *
+   * @param tile The tile to refresh.
+   */
+  void updateRenderable(const Tile& tile) noexcept;
+
+  /**
+   * @brief Sets the selection state of a tile and of its entry.
+   *
+   * @param tile The tile.
+   * @param index The index of the tile's entry, or {@link InvalidIndex} to
+   * only set the state of the tile.
+   * @param selectionState The new selection state.
+   */
+  void setLastSelectionState(
+      Tile& tile,
+      uint32_t index,
+      const TileSelectionState& selectionState) noexcept;
+
+  /**
+   * @brief Removes all entries, such as when the root tile is replaced.
+   *
+   * The tiles that were registered must not be registered again.
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Gets the index of the entry of a tile.
+   *
+   * @param tile The tile.
+   * @return The index, or {@link InvalidIndex} if the tile has not been
+   * registered.
+   */
+  uint32_t indexOf(const Tile& tile) const noexcept;
+
+  /**
+   * @brief Gets the index of the entry of a child of a tile.
+   *
+   * @param parentIndex The index of the entry of the tile.
+   * @param childIndex The index of the child in {@link Tile::getChildren}.
+   * @return The index, or {@link InvalidIndex} if the tile or its children
+   * have not been registered.
+   */
+  uint32_t
+  getChildIndex(uint32_t parentIndex, size_t childIndex) const noexcept;
+
+  /**
+   * @brief Gets an entry.
+   *
+   * @param index The index of the entry.
+   * @return The entry, or nullptr if the index is {@link InvalidIndex}.
+   */
+  const TileSelectionData* get(uint32_t index) const noexcept {
+    return index < this->_data.size() ? &this->_data[index] : nullptr;
+  }
+
+  /**
+   * @brief Finds the entry for a tile.
+   *
+   * @param tile The tile.
+   * @return The entry, or nullptr if the tile has not been registered.
+   */
+  const TileSelectionData* find(const Tile& tile) const noexcept {
+    return this->get(this->indexOf(tile));
+  }
+
+  /**
+   * @brief Gets the bounding volume of the tile of an entry.
+   *
+   * @param index The index of an entry that exists.
+   */
+  const BoundingVolume& getBoundingVolume(uint32_t index) const noexcept {
+    return this->_boundingVolumes[index];
+  }
+
+  /**
+   * @brief Gets the sphere that encloses the bounding volume of the tile of an
+   * entry, as computed by {@link computeEnclosingSphere}.
+   *
+   * @param index The index of an entry that exists.
+   */
+  const CesiumGeometry::BoundingSphere&
+  getEnclosingSphere(uint32_t index) const noexcept {
+    return this->_enclosingSpheres[index];
+  }
+
+  /**
+   * @brief Gets the number of registered tiles.
+   */
+  size_t size() const noexcept { return this->_data.size(); }
+
+private:
+  void add(Tile& tile);
+  void registerChildren(Tile& tile);
+  void assign(uint32_t index, const Tile& tile) noexcept;
+
+  std::vector<TileSelectionData> _data;
+  std::vector<BoundingVolume> _boundingVolumes;
+  std::vector<CesiumGeometry::BoundingSphere> _enclosingSpheres;
+};
+
+} // namespace Cesium3DTilesSelection
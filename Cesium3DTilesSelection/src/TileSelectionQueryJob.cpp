@@ -0,0 +1,204 @@
+#include "TileSelectionQueryJob.h"
+
+#include "TilesetContentManager.h"
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/TilesetContentLoader.h>
+#include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <variant>
+
+using namespace CesiumGeospatial;
+
+namespace Cesium3DTilesSelection {
+
+TileSelectionQueryJob::TileSelectionQueryJob(
+    const std::vector<ViewState>& frustums,
+    const TileSelectionQueryOptions& options,
+    const CesiumAsync::Promise<TileSelectionQueryResult>& promise)
+    : _frustums(frustums),
+      _options(options),
+      _promise(promise),
+      _started(false),
+      _childrenLoading(0),
+      _result(),
+      _pendingTiles(),
+      _deferredTiles() {}
+
+bool TileSelectionQueryJob::update(
+    TilesetContentManager& contentManager,
+    const TilesetOptions& tilesetOptions) {
+  if (!this->_started) {
+    Tile* pRootTile = contentManager.getRootTile();
+    if (!pRootTile) {
+      return false;
+    }
+
+    this->_pendingTiles.push_back({pRootTile, 0, false, false});
+    this->_started = true;
+  }
+
+  for (const PendingTile& deferred : this->_deferredTiles) {
+    this->_pendingTiles.push_back(deferred);
+  }
+  this->_deferredTiles.clear();
+
+  const uint32_t maximumLoads = this->_options.maximumSimultaneousLoads;
+  while (!this->_pendingTiles.empty() &&
+         this->_childrenLoading < maximumLoads) {
+    const PendingTile pending = this->_pendingTiles.back();
+    this->_pendingTiles.pop_back();
+    this->_visitTile(contentManager, tilesetOptions, pending);
+  }
+
+  const bool done = this->_pendingTiles.empty() &&
+                    this->_deferredTiles.empty() &&
+                    this->_childrenLoading == 0;
+  if (done) {
+    this->_promise.resolve(std::move(this->_result));
+  }
+
+  return done;
+}
+
+void TileSelectionQueryJob::abandon() {
+  this->_promise.reject(std::runtime_error(
+      "The tileset was destroyed before the selection query completed."));
+}
+
+void TileSelectionQueryJob::_visitTile(
+    TilesetContentManager& contentManager,
+    const TilesetOptions& tilesetOptions,
+    PendingTile pending) {
+  Tile& tile = *pending.pTile;
+
+  if (!pending.visited) {
+    if (!this->_isVisible(tile)) {
+      return;
+    }
+
+    pending.visited = true;
+    ++this->_result.tilesVisited;
+  }
+
+  if (!this->_shouldRefine(tile, pending.level)) {
+    this->_selectTile(tile, pending.level);
+    return;
+  }
+
+  if (tile.getChildren().empty() && !pending.childrenLoaded) {
+    // The children of a tile whose content the tileset is loading are created
+    // once the content is loaded.
+    if (tile.getState() == TileLoadState::ContentLoading) {
+      this->_deferredTiles.push_back(pending);
+      return;
+    }
+
+    ++this->_childrenLoading;
+    contentManager.loadTileChildren(tile, tilesetOptions)
+        .thenImmediately([pThis = this->shared_from_this(), pending]() {
+          pThis->_onChildrenLoaded(pending);
+        });
+    return;
+  }
+
+  if (tile.getChildren().empty()) {
+    // A leaf is selected in place of the children it doesn't have, unless it
+    // is only there to point to children, like an external tileset that failed
+    // to load.
+    if (!tile.getUnconditionallyRefine()) {
+      this->_selectTile(tile, pending.level);
+    }
+    return;
+  }
+
+  if (tile.getRefine() == TileRefine::Add && !tile.getUnconditionallyRefine()) {
+    this->_selectTile(tile, pending.level);
+  }
+
+  for (Tile& child : tile.getChildren()) {
+    // Upsampled tiles are created from their parent for raster overlays, and
+    // have no content of their own.
+    if (std::holds_alternative<CesiumGeometry::UpsampledQuadtreeNode>(
+            child.getTileID())) {
+      continue;
+    }
+
+    this->_pendingTiles.push_back({&child, pending.level + 1, false, false});
+  }
+}
+
+void TileSelectionQueryJob::_onChildrenLoaded(const PendingTile& pending) {
+  --this->_childrenLoading;
+
+  // Visit the tile again to refine to the children that were created.
+  this->_pendingTiles.push_back(
+      {pending.pTile, pending.level, pending.visited, true});
+}
+
+bool TileSelectionQueryJob::_isVisible(const Tile& tile) const {
+  const BoundingVolume& boundingVolume = tile.getBoundingVolume();
+
+  if (this->_options.region) {
+    const std::optional<GlobeRectangle> maybeRectangle =
+        estimateGlobeRectangle(boundingVolume);
+    if (maybeRectangle &&
+        !maybeRectangle->computeIntersection(*this->_options.region)) {
+      return false;
+    }
+  }
+
+  return std::any_of(
+      this->_frustums.begin(),
+      this->_frustums.end(),
+      [&boundingVolume](const ViewState& frustum) {
+        return frustum.isBoundingVolumeVisible(boundingVolume);
+      });
+}
+
+bool TileSelectionQueryJob::_shouldRefine(const Tile& tile, uint32_t level)
+    const noexcept {
+  if (this->_options.maximumLevel && level >= *this->_options.maximumLevel) {
+    return false;
+  }
+
+  if (tile.getUnconditionallyRefine()) {
+    return true;
+  }
+
+  const BoundingVolume& boundingVolume = tile.getBoundingVolume();
+  double largestScreenSpaceError = 0.0;
+  for (const ViewState& frustum : this->_frustums) {
+    const double distanceSquared =
+        frustum.computeDistanceSquaredToBoundingVolume(boundingVolume);
+    const double screenSpaceError = frustum.computeScreenSpaceError(
+        tile.getGeometricError(),
+        std::sqrt(std::max(distanceSquared, 0.0)));
+    largestScreenSpaceError =
+        std::max(largestScreenSpaceError, screenSpaceError);
+  }
+
+  return largestScreenSpaceError > this->_options.maximumScreenSpaceError;
+}
+
+void TileSelectionQueryJob::_selectTile(const Tile& tile, uint32_t level) {
+  // There is nothing to load for tiles without content.
+  if (tile.isEmptyContent()) {
+    return;
+  }
+
+  const TilesetContentLoader* pLoader = tile.getLoader();
+  this->_result.tiles.push_back(TileSelectionQueryTile{
+      tile.getTileID(),
+      pLoader ? pLoader->getTileContentUrl(tile) : std::nullopt,
+      tile.getGeometricError(),
+      level});
+}
+
+} // namespace Cesium3DTilesSelection
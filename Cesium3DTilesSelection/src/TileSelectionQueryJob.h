@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/TileSelectionQuery.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumAsync/Promise.h>
+
+#include <memory>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+class Tile;
+class TilesetContentManager;
+struct TilesetOptions;
+
+/**
+ * @brief Walks the tiles of a tileset that are visible in a set of frustums
+ * and finds the ones that would be selected, without loading their content.
+ *
+ * @see Tileset::querySelection
+ */
+class TileSelectionQueryJob
+    : public std::enable_shared_from_this<TileSelectionQueryJob> {
+public:
+  TileSelectionQueryJob(
+      const std::vector<ViewState>& frustums,
+      const TileSelectionQueryOptions& options,
+      const CesiumAsync::Promise<TileSelectionQueryResult>& promise);
+
+  /**
+   * @brief Visits the tiles that are ready to be visited, starting as many
+   * loads of their children as the options allow, and resolves the promise
+   * once every visible tile has been visited.
+   *
+   * @return true if the job is complete.
+   */
+  bool update(
+      TilesetContentManager& contentManager,
+      const TilesetOptions& tilesetOptions);
+
+  /**
+   * @brief Rejects the promise, because the tileset is being destroyed.
+   */
+  void abandon();
+
+private:
+  struct PendingTile {
+    Tile* pTile;
+    uint32_t level;
+    bool visited;
+    bool childrenLoaded;
+  };
+
+  void _visitTile(
+      TilesetContentManager& contentManager,
+      const TilesetOptions& tilesetOptions,
+      PendingTile pending);
+  void _onChildrenLoaded(const PendingTile& pending);
+  bool _isVisible(const Tile& tile) const;
+  bool _shouldRefine(const Tile& tile, uint32_t level) const noexcept;
+  void _selectTile(const Tile& tile, uint32_t level);
+
+  std::vector<ViewState> _frustums;
+  TileSelectionQueryOptions _options;
+  CesiumAsync::Promise<TileSelectionQueryResult> _promise;
+  bool _started;
+  uint32_t _childrenLoading;
+  TileSelectionQueryResult _result;
+
+  std::vector<PendingTile> _pendingTiles;
+
+  // Tiles that the tileset itself was loading when their children were
+  // needed. They are visited again on the next update.
+  std::vector<PendingTile> _deferredTiles;
+};
+
+} // namespace Cesium3DTilesSelection
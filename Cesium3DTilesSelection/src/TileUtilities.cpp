@@ -13,7 +13,7 @@ namespace CesiumImpl {
 
 bool withinPolygons(
     const BoundingVolume& boundingVolume,
-    const std::vector<CartographicPolygon>& cartographicPolygons) noexcept {
+    const CartographicPolygonIndex& polygonIndex) {
 
   std::optional<GlobeRectangle> maybeRectangle =
       estimateGlobeRectangle(boundingVolume);
@@ -21,15 +21,12 @@ bool withinPolygons(
     return false;
   }
 
-  return CartographicPolygon::rectangleIsWithinPolygons(
-      *maybeRectangle,
-      cartographicPolygons);
+  return polygonIndex.rectangleIsWithinPolygons(*maybeRectangle);
 }
 
 bool outsidePolygons(
     const BoundingVolume& boundingVolume,
-    const std::vector<CesiumGeospatial::CartographicPolygon>&
-        cartographicPolygons) noexcept {
+    const CartographicPolygonIndex& polygonIndex) {
 
   std::optional<GlobeRectangle> maybeRectangle =
       estimateGlobeRectangle(boundingVolume);
@@ -37,9 +34,7 @@ bool outsidePolygons(
     return false;
   }
 
-  return CartographicPolygon::rectangleIsOutsidePolygons(
-      *maybeRectangle,
-      cartographicPolygons);
+  return polygonIndex.rectangleIsOutsidePolygons(*maybeRectangle);
 }
 
 } // namespace CesiumImpl
@@ -1,6 +1,11 @@
+#include "HeightSamplingJob.h"
+#include "RegionPrecacheJob.h"
+#include "TileSelectionQueryJob.h"
 #include "TileUtilities.h"
 #include "TilesetContentManager.h"
+#include "TimingScope.h"
 
+#include <Cesium3DTilesSelection/ITileEvictionPolicy.h>
 #include <Cesium3DTilesSelection/ITileExcluder.h>
 #include <Cesium3DTilesSelection/TileID.h>
 #include <Cesium3DTilesSelection/TileOcclusionRendererProxy.h>
@@ -8,21 +13,34 @@
 #include <Cesium3DTilesSelection/TilesetMetadata.h>
 #include <Cesium3DTilesSelection/spdlog-cesium.h>
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/AdaptiveConcurrencyLimiter.h>
+#include <CesiumAsync/BandwidthLimiter.h>
 #include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
 #include <CesiumUtility/CreditSystem.h>
 #include <CesiumUtility/Math.h>
+#include <CesiumUtility/PixelBufferPool.h>
 #include <CesiumUtility/ScopeGuard.h>
 #include <CesiumUtility/Tracing.h>
 #include <CesiumUtility/joinToString.h>
 
 #include <glm/common.hpp>
+#include <glm/geometric.hpp>
 #include <rapidjson/document.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
 #include <cstddef>
+#include <exception>
+#include <iterator>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <unordered_set>
 
 using namespace CesiumAsync;
@@ -42,8 +60,23 @@ Tileset::Tileset(
       _asyncSystem(externals.asyncSystem),
       _options(options),
       _previousFrameNumber(0),
+      _latestFrameNumber(0),
+      _maximumScreenSpaceError(options.maximumScreenSpaceError),
+      _previousTotalDataLoaded(0),
+      _tileLoadSchedulerID(
+          externals.pTileLoadScheduler
+              ? externals.pTileLoadScheduler->addTileset()
+              : 0),
+      _bandwidthRecovering(false),
       _distances(),
       _childOcclusionProxies(),
+      _exclusionBuffers(),
+      _loadedTilesForParallelVisit(),
+      _lastTraversalFrustums(),
+      _lastTraversalTileStateVersion(0),
+      _lastTraversalMaximumScreenSpaceError(0.0),
+      _lastTraversalOverlayStates(),
+      _nextViewSessionID(1),
       _pTilesetContentManager{new TilesetContentManager(
           _externals,
           _options,
@@ -60,8 +93,23 @@ Tileset::Tileset(
       _asyncSystem(externals.asyncSystem),
       _options(options),
       _previousFrameNumber(0),
+      _latestFrameNumber(0),
+      _maximumScreenSpaceError(options.maximumScreenSpaceError),
+      _previousTotalDataLoaded(0),
+      _tileLoadSchedulerID(
+          externals.pTileLoadScheduler
+              ? externals.pTileLoadScheduler->addTileset()
+              : 0),
+      _bandwidthRecovering(false),
       _distances(),
       _childOcclusionProxies(),
+      _exclusionBuffers(),
+      _loadedTilesForParallelVisit(),
+      _lastTraversalFrustums(),
+      _lastTraversalTileStateVersion(0),
+      _lastTraversalMaximumScreenSpaceError(0.0),
+      _lastTraversalOverlayStates(),
+      _nextViewSessionID(1),
       _pTilesetContentManager{new TilesetContentManager(
           _externals,
           _options,
@@ -78,8 +126,23 @@ Tileset::Tileset(
       _asyncSystem(externals.asyncSystem),
       _options(options),
       _previousFrameNumber(0),
+      _latestFrameNumber(0),
+      _maximumScreenSpaceError(options.maximumScreenSpaceError),
+      _previousTotalDataLoaded(0),
+      _tileLoadSchedulerID(
+          externals.pTileLoadScheduler
+              ? externals.pTileLoadScheduler->addTileset()
+              : 0),
+      _bandwidthRecovering(false),
       _distances(),
       _childOcclusionProxies(),
+      _exclusionBuffers(),
+      _loadedTilesForParallelVisit(),
+      _lastTraversalFrustums(),
+      _lastTraversalTileStateVersion(0),
+      _lastTraversalMaximumScreenSpaceError(0.0),
+      _lastTraversalOverlayStates(),
+      _nextViewSessionID(1),
       _pTilesetContentManager{new TilesetContentManager(
           _externals,
           _options,
@@ -89,7 +152,25 @@ Tileset::Tileset(
           ionAssetEndpointUrl)} {}
 
 Tileset::~Tileset() noexcept {
-  this->_pTilesetContentManager->unloadAll();
+  for (const std::shared_ptr<RegionPrecacheJob>& pJob :
+       this->_regionPrecacheJobs) {
+    pJob->abandon();
+  }
+  for (const std::shared_ptr<TileSelectionQueryJob>& pJob :
+       this->_selectionQueryJobs) {
+    pJob->abandon();
+  }
+  for (const std::unique_ptr<HeightSamplingJob>& pJob :
+       this->_heightSamplingJobs) {
+    pJob->abandon();
+  }
+
+  this->_pTilesetContentManager->releaseAll(
+      this->_options.batchRendererResourceCalls);
+  if (this->_externals.pTileLoadScheduler) {
+    this->_externals.pTileLoadScheduler->removeTileset(
+        this->_tileLoadSchedulerID);
+  }
   if (this->_externals.pTileOcclusionProxyPool) {
     this->_externals.pTileOcclusionProxyPool->destroyPool();
   }
@@ -182,10 +263,106 @@ static double computeFogDensity(
   return density;
 }
 
+static void computeHeightRange(
+    const BoundingVolume& boundingVolume,
+    double& minimumHeight,
+    double& maximumHeight) {
+  const BoundingRegion* pRegion =
+      getBoundingRegionFromBoundingVolume(boundingVolume);
+  if (pRegion) {
+    minimumHeight = pRegion->getMinimumHeight();
+    maximumHeight = pRegion->getMaximumHeight();
+    return;
+  }
+
+  // Approximate the height range with the sphere around the bounding box.
+  const OrientedBoundingBox box =
+      getOrientedBoundingBoxFromBoundingVolume(boundingVolume);
+  const double radius = glm::length(box.getLengths()) * 0.5;
+  const double centerHeight =
+      Ellipsoid::WGS84.cartesianToCartographic(box.getCenter())
+          .value_or(Cartographic(0.0, 0.0, 0.0))
+          .height;
+  minimumHeight = centerHeight - radius;
+  maximumHeight = centerHeight + radius;
+}
+
+static double computeDynamicScreenSpaceErrorDensity(
+    const TilesetOptions& options,
+    const ViewState& viewState,
+    double minimumHeight,
+    double maximumHeight) {
+  const std::optional<Cartographic>& position =
+      viewState.getPositionCartographic();
+  if (!position) {
+    return 0.0;
+  }
+
+  // Increase the density as the camera tilts toward the horizon.
+  const glm::dvec3 up =
+      Ellipsoid::WGS84.geodeticSurfaceNormal(viewState.getPosition());
+  double horizonFactor =
+      1.0 - glm::abs(glm::dot(viewState.getDirection(), up));
+
+  // Weaken it as the camera rises above the tileset.
+  const double heightClose = glm::mix(
+      minimumHeight,
+      maximumHeight,
+      options.dynamicScreenSpaceErrorHeightFalloff);
+  const double heightFar = maximumHeight;
+  const double t =
+      heightFar > heightClose
+          ? glm::clamp(
+                (position->height - heightClose) / (heightFar - heightClose),
+                0.0,
+                1.0)
+          : (position->height > heightFar ? 1.0 : 0.0);
+  horizonFactor *= 1.0 - t;
+
+  return options.dynamicScreenSpaceErrorDensity * horizonFactor;
+}
+
+static void setLodTransitionFadePercentage(
+    Tile& tile,
+    TileRenderContent& renderContent,
+    float percentage,
+    ViewUpdateResult& result) {
+  if (renderContent.getLodTransitionFadePercentage() != percentage) {
+    renderContent.setLodTransitionFadePercentage(percentage);
+    result.tilesWithChangedLodTransition.emplace_back(&tile);
+  }
+}
+
+// Sorts the tiles that were added to the end of the fading out list since it
+// was last sorted into the rest of it, and removes any duplicates.
+static void
+sortTilesFadingOut(std::vector<Tile*>& tilesFadingOut, size_t sortedCount) {
+  const auto middle = tilesFadingOut.begin() + std::ptrdiff_t(sortedCount);
+  std::sort(middle, tilesFadingOut.end());
+  std::inplace_merge(tilesFadingOut.begin(), middle, tilesFadingOut.end());
+  tilesFadingOut.erase(
+      std::unique(tilesFadingOut.begin(), tilesFadingOut.end()),
+      tilesFadingOut.end());
+}
+
+// Whether the client may still be showing the tile, because it is fading out
+// or has only just been removed from the render list.
+static bool mayBeShown(const ViewUpdateResult& result, Tile* pTile) {
+  return std::binary_search(
+             result.tilesFadingOut.begin(),
+             result.tilesFadingOut.end(),
+             pTile) ||
+         std::binary_search(
+             result.tilesRemovedThisFrame.begin(),
+             result.tilesRemovedThisFrame.end(),
+             pTile);
+}
+
 void Tileset::_updateLodTransitions(
     const FrameState& frameState,
     float deltaTime,
     ViewUpdateResult& result) const noexcept {
+  result.tilesWithChangedLodTransition.clear();
   if (_options.enableLodTransitionPeriod) {
     // We always fade tiles from 0.0 --> 1.0. Whether the tile is fading in or
     // out is determined by whether the tile is in the tilesToRenderThisFrame
@@ -193,27 +370,27 @@ void Tileset::_updateLodTransitions(
     float deltaTransitionPercentage =
         deltaTime / this->_options.lodTransitionLength;
 
-    // Update fade out
-    for (auto tileIt = result.tilesFadingOut.begin();
-         tileIt != result.tilesFadingOut.end();) {
+    // Update fade out. The tiles that are still fading out are moved toward
+    // the front of the list, which keeps it sorted.
+    std::vector<Tile*>& tilesFadingOut = result.tilesFadingOut;
+    size_t fadingOutCount = 0;
+    for (Tile* pTile : tilesFadingOut) {
       TileRenderContent* pRenderContent =
-          (*tileIt)->getContent().getRenderContent();
+          pTile->getContent().getRenderContent();
 
       if (!pRenderContent) {
         // This tile is done fading out and was immediately kicked from the
         // cache.
-        tileIt = result.tilesFadingOut.erase(tileIt);
         continue;
       }
 
       // Remove tile from fade-out list if it is back on the render list.
       TileSelectionState::Result selectionResult =
-          (*tileIt)->getLastSelectionState().getResult(
+          pTile->getLastSelectionState().getResult(
               frameState.currentFrameNumber);
       if (selectionResult == TileSelectionState::Result::Rendered) {
         // This tile will already be on the render list.
-        pRenderContent->setLodTransitionFadePercentage(0.0f);
-        tileIt = result.tilesFadingOut.erase(tileIt);
+        setLodTransitionFadePercentage(*pTile, *pRenderContent, 0.0f, result);
         continue;
       }
 
@@ -223,16 +400,20 @@ void Tileset::_updateLodTransitions(
         // Remove this tile from the fading out list if it is already done.
         // The client will already have had a chance to stop rendering the tile
         // last frame.
-        pRenderContent->setLodTransitionFadePercentage(0.0f);
-        tileIt = result.tilesFadingOut.erase(tileIt);
+        setLodTransitionFadePercentage(*pTile, *pRenderContent, 0.0f, result);
         continue;
       }
 
       float newPercentage =
           glm::min(currentPercentage + deltaTransitionPercentage, 1.0f);
-      pRenderContent->setLodTransitionFadePercentage(newPercentage);
-      ++tileIt;
+      setLodTransitionFadePercentage(
+          *pTile,
+          *pRenderContent,
+          newPercentage,
+          result);
+      tilesFadingOut[fadingOutCount++] = pTile;
     }
+    tilesFadingOut.resize(fadingOutCount);
 
     // Update fade in
     for (Tile* pTile : result.tilesToRenderThisFrame) {
@@ -243,7 +424,11 @@ void Tileset::_updateLodTransitions(
             pRenderContent->getLodTransitionFadePercentage();
         float newTransitionPercentage =
             glm::min(transitionPercentage + deltaTransitionPercentage, 1.0f);
-        pRenderContent->setLodTransitionFadePercentage(newTransitionPercentage);
+        setLodTransitionFadePercentage(
+            *pTile,
+            *pRenderContent,
+            newTransitionPercentage,
+            result);
       }
     }
   } else {
@@ -253,16 +438,49 @@ void Tileset::_updateLodTransitions(
       TileRenderContent* pRenderContent =
           pTile->getContent().getRenderContent();
       if (pRenderContent) {
-        pRenderContent->setLodTransitionFadePercentage(1.0f);
+        setLodTransitionFadePercentage(*pTile, *pRenderContent, 1.0f, result);
       }
     }
   }
 }
 
+void Tileset::_updateRenderListChanges(ViewUpdateResult& result) {
+  result.tilesAddedThisFrame.clear();
+  result.tilesRemovedThisFrame.clear();
+  if (!this->_options.computeRenderListChanges) {
+    this->_lastTilesToRender.clear();
+    return;
+  }
+
+  // With both render lists sorted, the changes are found in a single pass
+  // over each, without hashing.
+  std::vector<Tile*> tilesToRender = result.tilesToRenderThisFrame;
+  std::sort(tilesToRender.begin(), tilesToRender.end());
+  tilesToRender.erase(
+      std::unique(tilesToRender.begin(), tilesToRender.end()),
+      tilesToRender.end());
+
+  std::set_difference(
+      tilesToRender.begin(),
+      tilesToRender.end(),
+      this->_lastTilesToRender.begin(),
+      this->_lastTilesToRender.end(),
+      std::back_inserter(result.tilesAddedThisFrame));
+  std::set_difference(
+      this->_lastTilesToRender.begin(),
+      this->_lastTilesToRender.end(),
+      tilesToRender.begin(),
+      tilesToRender.end(),
+      std::back_inserter(result.tilesRemovedThisFrame));
+
+  this->_lastTilesToRender = std::move(tilesToRender);
+}
+
 const ViewUpdateResult&
 Tileset::updateViewOffline(const std::vector<ViewState>& frustums) {
   std::vector<Tile*> tilesSelectedPrevFrame =
       this->_updateResult.tilesToRenderThisFrame;
+  std::vector<Tile*> lastTilesToRender = this->_lastTilesToRender;
 
   // TODO: fix the fading for offline case
   // (https://github.com/CesiumGS/cesium-native/issues/549)
@@ -285,16 +503,233 @@ Tileset::updateViewOffline(const std::vector<ViewState>& frustums) {
       TileRenderContent* pRenderContent = tile->getContent().getRenderContent();
       if (pRenderContent) {
         pRenderContent->setLodTransitionFadePercentage(1.0f);
-        this->_updateResult.tilesFadingOut.insert(tile);
+        this->_updateResult.tilesFadingOut.emplace_back(tile);
       }
     }
   }
+  sortTilesFadingOut(this->_updateResult.tilesFadingOut, 0);
+
+  // Report the changes since before the offline update, not just those of its
+  // last view update.
+  this->_lastTilesToRender = std::move(lastTilesToRender);
+  this->_updateRenderListChanges(this->_updateResult);
 
   return this->_updateResult;
 }
 
-const ViewUpdateResult&
-Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
+static double* getTiming(
+    ViewUpdateTimings* pTimings,
+    double ViewUpdateTimings::*pDuration) noexcept {
+  return pTimings ? &(pTimings->*pDuration) : nullptr;
+}
+
+const ViewUpdateResult& Tileset::updateView(
+    const std::vector<ViewState>& frustums,
+    float deltaTime,
+    const std::vector<ViewState>& predictedFrustums) {
+  if (this->_viewSessions.empty()) {
+    return this->_updateView(frustums, deltaTime, predictedFrustums);
+  }
+
+  this->_startViewSessionUpdate();
+  const int32_t previousFrameNumber = this->_previousFrameNumber;
+  const ViewUpdateResult& result =
+      this->_updateView(frustums, deltaTime, predictedFrustums);
+  this->_finishViewSessionUpdate(previousFrameNumber);
+  return result;
+}
+
+uint64_t Tileset::addViewSession() {
+  if (this->_viewSessions.empty()) {
+    // Until now, only updateView has left selection states in the tiles, so
+    // record those of its last traversal before another session overwrites
+    // them. The visited tiles are all in the loaded tiles list.
+    const int32_t frameNumber = this->_previousFrameNumber;
+    if (frameNumber > 0) {
+      for (Tile* pTile = this->_loadedTiles.head(); pTile != nullptr;
+           pTile = this->_loadedTiles.next(*pTile)) {
+        this->_viewSessionVisitedTiles.emplace_back(pTile);
+      }
+    }
+    this->_finishViewSessionUpdate(frameNumber - 1);
+  }
+
+  std::unique_ptr<ViewSession>& pSession =
+      this->_viewSessions.emplace_back(std::make_unique<ViewSession>());
+  pSession->id = this->_nextViewSessionID++;
+  pSession->previousFrameNumber = 0;
+  pSession->maximumScreenSpaceError = this->_options.maximumScreenSpaceError;
+  pSession->lastTraversalTileStateVersion = 0;
+  pSession->lastTraversalMaximumScreenSpaceError = 0.0;
+  return pSession->id;
+}
+
+void Tileset::removeViewSession(uint64_t sessionID) noexcept {
+  auto it = std::find_if(
+      this->_viewSessions.begin(),
+      this->_viewSessions.end(),
+      [sessionID](const std::unique_ptr<ViewSession>& pSession) {
+        return pSession->id == sessionID;
+      });
+  if (it == this->_viewSessions.end()) {
+    return;
+  }
+
+  for (Tile* pTile : (*it)->heldTiles) {
+    auto referenceIt = this->_viewSessionTileReferences.find(pTile);
+    if (--referenceIt->second == 0) {
+      this->_viewSessionTileReferences.erase(referenceIt);
+    }
+  }
+  this->_viewSessions.erase(it);
+
+  if (this->_viewSessions.empty()) {
+    // Only updateView is left, so its selection states can stay in the tiles
+    // from now on.
+    this->_startViewSessionUpdate();
+    this->_viewSessionSelectionStates.clear();
+    this->_viewSessionHeldTiles.clear();
+    this->_viewSessionTileReferences.clear();
+  }
+}
+
+const ViewUpdateResult& Tileset::updateViewSession(
+    uint64_t sessionID,
+    const std::vector<ViewState>& frustums,
+    float deltaTime,
+    const std::vector<ViewState>& predictedFrustums) {
+  auto it = std::find_if(
+      this->_viewSessions.begin(),
+      this->_viewSessions.end(),
+      [sessionID](const std::unique_ptr<ViewSession>& pSession) {
+        return pSession->id == sessionID;
+      });
+  assert(
+      it != this->_viewSessions.end() &&
+      "The view session must be added first");
+  if (it == this->_viewSessions.end()) {
+    static const ViewUpdateResult noResult;
+    return noResult;
+  }
+
+  // Update the session with the members that otherwise hold the state of
+  // updateView.
+  ViewSession& session = **it;
+  session.swap(*this);
+  this->updateView(frustums, deltaTime, predictedFrustums);
+  session.swap(*this);
+  return session.updateResult;
+}
+
+void Tileset::ViewSession::swap(Tileset& tileset) noexcept {
+  std::swap(this->previousFrameNumber, tileset._previousFrameNumber);
+  std::swap(this->updateResult, tileset._updateResult);
+  std::swap(this->lastTilesToRender, tileset._lastTilesToRender);
+  std::swap(this->lastTraversalCredits, tileset._lastTraversalCredits);
+  std::swap(this->maximumScreenSpaceError, tileset._maximumScreenSpaceError);
+  std::swap(this->mainThreadLoadQueue, tileset._mainThreadLoadQueue);
+  std::swap(this->workerThreadLoadQueue, tileset._workerThreadLoadQueue);
+  std::swap(this->prefetchLoadQueue, tileset._prefetchLoadQueue);
+  std::swap(this->lastTraversalFrustums, tileset._lastTraversalFrustums);
+  std::swap(
+      this->lastTraversalTileStateVersion,
+      tileset._lastTraversalTileStateVersion);
+  std::swap(
+      this->lastTraversalMaximumScreenSpaceError,
+      tileset._lastTraversalMaximumScreenSpaceError);
+  std::swap(
+      this->lastTraversalOverlayStates,
+      tileset._lastTraversalOverlayStates);
+  std::swap(this->selectionStates, tileset._viewSessionSelectionStates);
+  std::swap(this->heldTiles, tileset._viewSessionHeldTiles);
+}
+
+void Tileset::_startViewSessionUpdate() noexcept {
+  // The other sessions may have overwritten the selection states of this
+  // session's tiles since it was last updated.
+  TileSelectionDataTable* pTable =
+      this->_pTilesetContentManager->getSelectionDataTable();
+  for (const auto& [pTile, selectionState] :
+       this->_viewSessionSelectionStates) {
+    if (pTable) {
+      pTable->setLastSelectionState(
+          *pTile,
+          pTable->indexOf(*pTile),
+          selectionState);
+    } else {
+      pTile->setLastSelectionState(selectionState);
+    }
+  }
+  this->_viewSessionVisitedTiles.clear();
+}
+
+void Tileset::_finishViewSessionUpdate(int32_t previousFrameNumber) {
+  const int32_t frameNumber = this->_previousFrameNumber;
+  std::vector<Tile*>& visitedTiles = this->_viewSessionVisitedTiles;
+  if (frameNumber != previousFrameNumber) {
+    // A traversal took place, so it replaces the recorded selection states.
+    std::sort(visitedTiles.begin(), visitedTiles.end());
+    visitedTiles.erase(
+        std::unique(visitedTiles.begin(), visitedTiles.end()),
+        visitedTiles.end());
+
+    this->_viewSessionSelectionStates.clear();
+    for (Tile* pTile : visitedTiles) {
+      const TileSelectionState& selectionState = pTile->getLastSelectionState();
+      if (selectionState.getFrameNumber() == frameNumber) {
+        this->_viewSessionSelectionStates.emplace_back(pTile, selectionState);
+      }
+    }
+  }
+  visitedTiles.clear();
+
+  // The session holds the tiles it visited, and those that the client may
+  // still be showing for it. The tiles it held before are released only now,
+  // so that its own unloading didn't evict the ones it still needs.
+  std::vector<Tile*> heldTiles;
+  heldTiles.reserve(
+      this->_viewSessionSelectionStates.size() +
+      this->_updateResult.tilesFadingOut.size() +
+      this->_updateResult.tilesRemovedThisFrame.size());
+  for (const auto& [pTile, selectionState] :
+       this->_viewSessionSelectionStates) {
+    heldTiles.emplace_back(pTile);
+  }
+  heldTiles.insert(
+      heldTiles.end(),
+      this->_updateResult.tilesFadingOut.begin(),
+      this->_updateResult.tilesFadingOut.end());
+  heldTiles.insert(
+      heldTiles.end(),
+      this->_updateResult.tilesRemovedThisFrame.begin(),
+      this->_updateResult.tilesRemovedThisFrame.end());
+  std::sort(heldTiles.begin(), heldTiles.end());
+  heldTiles.erase(
+      std::unique(heldTiles.begin(), heldTiles.end()),
+      heldTiles.end());
+
+  for (Tile* pTile : heldTiles) {
+    ++this->_viewSessionTileReferences[pTile];
+  }
+  for (Tile* pTile : this->_viewSessionHeldTiles) {
+    auto it = this->_viewSessionTileReferences.find(pTile);
+    if (--it->second == 0) {
+      this->_viewSessionTileReferences.erase(it);
+    }
+  }
+  this->_viewSessionHeldTiles = std::move(heldTiles);
+}
+
+bool Tileset::_isHeldByViewSession(const Tile* pTile) const noexcept {
+  return !this->_viewSessionTileReferences.empty() &&
+         this->_viewSessionTileReferences.find(pTile) !=
+             this->_viewSessionTileReferences.end();
+}
+
+const ViewUpdateResult& Tileset::_updateView(
+    const std::vector<ViewState>& frustums,
+    float deltaTime,
+    const std::vector<ViewState>& predictedFrustums) {
   CESIUM_TRACE("Tileset::updateView");
   // Fixup TilesetOptions to ensure lod transitions works correctly.
   _options.enableFrustumCulling =
@@ -303,13 +738,52 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
       _options.enableFogCulling && !_options.enableLodTransitionPeriod;
 
   this->_asyncSystem.dispatchMainThreadTasks();
+  this->_updateRegionPrecacheJobs();
+  this->_updateSelectionQueryJobs();
+  this->_updateHeightSamplingJobs();
+
+  ViewUpdateResult& result = this->_updateResult;
+
+  ViewUpdateTimings* pTimings =
+      this->_options.enableViewUpdateTimings ? &result.timings : nullptr;
+  result.timings = ViewUpdateTimings();
+  TimingScope updateTimer(getTiming(pTimings, &ViewUpdateTimings::totalTime));
+
+  this->_updateMaximumScreenSpaceError(deltaTime);
+
+  if (predictedFrustums.empty() && this->_heightSamplingJobs.empty() &&
+      this->_canReuseLastTraversal(frustums)) {
+    // Nothing that affects tile selection has changed since the last
+    // traversal, so its render list and tile selection states are still
+    // valid. Keep its frame number so that the next traversal compares against
+    // those selection states.
+    result.tilesVisited = 0;
+    result.culledTilesVisited = 0;
+    result.tilesCulled = 0;
+    result.tilesOccluded = 0;
+    result.tilesWaitingForOcclusionResults = 0;
+    result.maxDepthVisited = 0;
+    result.maximumScreenSpaceError = this->_maximumScreenSpaceError;
+    result.tilesWithChangedLodTransition.clear();
+    this->_updateRenderListChanges(result);
+
+    {
+      TimingScope timer(
+          getTiming(pTimings, &ViewUpdateTimings::unloadCachedTilesTime));
+      this->_unloadCachedTiles(this->_options.tileCacheUnloadTimeLimit);
+    }
+    this->_addCreditsToFrame();
+    this->_finishViewUpdateTimings(pTimings);
+    return result;
+  }
 
   const int32_t previousFrameNumber = this->_previousFrameNumber;
-  const int32_t currentFrameNumber = previousFrameNumber + 1;
+  const int32_t currentFrameNumber = this->_latestFrameNumber + 1;
 
-  ViewUpdateResult& result = this->_updateResult;
   result.frameNumber = currentFrameNumber;
   result.tilesToRenderThisFrame.clear();
+  result.tilesToRenderThisFrameDistances.clear();
+  result.tilesToRenderThisFrameScreenSpaceErrors.clear();
   result.tilesVisited = 0;
   result.culledTilesVisited = 0;
   result.tilesCulled = 0;
@@ -321,9 +795,12 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
   if (!_options.enableLodTransitionPeriod) {
     result.tilesFadingOut.clear();
   }
+  const size_t sortedFadingOutCount = result.tilesFadingOut.size();
 
   Tile* pRootTile = this->getRootTile();
   if (!pRootTile) {
+    this->_lastTraversalFrustums.clear();
+    this->_updateRenderListChanges(result);
     return result;
   }
 
@@ -332,8 +809,13 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
     pExcluder->startNewFrame();
   }
 
+  if (this->_options.evictionPolicy) {
+    this->_options.evictionPolicy->startNewFrame();
+  }
+
   this->_workerThreadLoadQueue.clear();
   this->_mainThreadLoadQueue.clear();
+  this->_prefetchLoadQueue.clear();
 
   std::vector<double> fogDensities(frustums.size());
   std::transform(
@@ -345,22 +827,96 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
         return computeFogDensity(fogDensityTable, frustum);
       });
 
+  std::vector<double> dynamicScreenSpaceErrorDensities;
+  if (this->_options.enableDynamicScreenSpaceError) {
+    double minimumHeight;
+    double maximumHeight;
+    computeHeightRange(
+        pRootTile->getBoundingVolume(),
+        minimumHeight,
+        maximumHeight);
+
+    dynamicScreenSpaceErrorDensities.resize(frustums.size());
+    std::transform(
+        frustums.begin(),
+        frustums.end(),
+        dynamicScreenSpaceErrorDensities.begin(),
+        [&options = this->_options, minimumHeight, maximumHeight](
+            const ViewState& frustum) -> double {
+          return computeDynamicScreenSpaceErrorDensity(
+              options,
+              frustum,
+              minimumHeight,
+              maximumHeight);
+        });
+  }
+
   FrameState frameState{
       frustums,
       std::move(fogDensities),
+      std::move(dynamicScreenSpaceErrorDensities),
       previousFrameNumber,
-      currentFrameNumber};
+      currentFrameNumber,
+      this->_pTilesetContentManager->getSelectionDataTable(),
+      this->_maximumScreenSpaceError};
+
+  TraversalState traversalState{
+      result,
+      this->_workerThreadLoadQueue,
+      this->_mainThreadLoadQueue,
+      this->_distances,
+      this->_childOcclusionProxies,
+      this->_exclusionBuffers,
+      nullptr,
+      std::nullopt,
+      PendingExclusion{false, 0}};
+
+  {
+    TimingScope timer(getTiming(pTimings, &ViewUpdateTimings::traversalTime));
+    if (!frustums.empty()) {
+      traversalState.exclusion = this->_classifyTileForExclusion(*pRootTile);
+      this->_visitTileIfNeeded(
+          frameState,
+          0,
+          false,
+          *pRootTile,
+          frameState.pSelectionData
+              ? frameState.pSelectionData->indexOf(*pRootTile)
+              : TileSelectionDataTable::InvalidIndex,
+          traversalState);
+    } else {
+      result = ViewUpdateResult();
+    }
+  }
 
-  if (!frustums.empty()) {
-    this->_visitTileIfNeeded(frameState, 0, false, *pRootTile, result);
-  } else {
-    result = ViewUpdateResult();
+  // Map the overlays to the tiles that were visited, now that it is known
+  // which of them are rendered.
+  this->_pTilesetContentManager->processRasterOverlayMappings(
+      this->_options,
+      currentFrameNumber);
+
+  if (this->_options.sortTilesToRenderFrontToBack) {
+    this->_sortTilesToRenderFrontToBack(frameState, result);
+  }
+
+  sortTilesFadingOut(
+      result.tilesFadingOut,
+      std::min(sortedFadingOutCount, result.tilesFadingOut.size()));
+  this->_updateRenderListChanges(result);
+
+  this->_predictedTilesLoading.clear();
+  if (!predictedFrustums.empty()) {
+    this->_visitPredictedTile(predictedFrustums, *pRootTile);
   }
 
+  this->_addHeightSamplingLoads(traversalState);
+  this->_cancelUnneededTileLoads();
+
   result.workerThreadTileLoadQueueLength =
       static_cast<int32_t>(this->_workerThreadLoadQueue.size());
   result.mainThreadTileLoadQueueLength =
       static_cast<int32_t>(this->_mainThreadLoadQueue.size());
+  result.maximumScreenSpaceError = this->_maximumScreenSpaceError;
 
   const std::shared_ptr<TileOcclusionRendererProxyPool>& pOcclusionPool =
       this->getExternals().pTileOcclusionProxyPool;
@@ -368,24 +924,241 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
     pOcclusionPool->pruneOcclusionProxyMappings();
   }
 
-  this->_unloadCachedTiles(this->_options.tileCacheUnloadTimeLimit);
-  this->_processWorkerThreadLoadQueue();
-  this->_processMainThreadLoadQueue();
-  this->_updateLodTransitions(frameState, deltaTime, result);
+  {
+    TimingScope timer(
+        getTiming(pTimings, &ViewUpdateTimings::unloadCachedTilesTime));
+    this->_unloadCachedTiles(this->_options.tileCacheUnloadTimeLimit);
+  }
+  {
+    TimingScope timer(
+        getTiming(pTimings, &ViewUpdateTimings::workerThreadLoadQueueTime));
+    this->_processWorkerThreadLoadQueue();
+    this->_processPrefetchLoadQueue();
+    this->_fetchChildrenAhead(frameState);
+  }
+  {
+    TimingScope timer(
+        getTiming(pTimings, &ViewUpdateTimings::mainThreadLoadQueueTime));
+    this->_processMainThreadLoadQueue();
+  }
+  {
+    TimingScope timer(
+        getTiming(pTimings, &ViewUpdateTimings::lodTransitionTime));
+    this->_updateLodTransitions(frameState, deltaTime, result);
+  }
+  this->_updateLastTraversalCredits(result);
+  this->_addCreditsToFrame();
+  this->_finishViewUpdateTimings(pTimings);
+
+  this->_previousFrameNumber = currentFrameNumber;
+  this->_latestFrameNumber = currentFrameNumber;
+  this->_recordTraversalInputs(frustums);
 
-  // aggregate all the credits needed from this tileset for the current frame
-  const std::shared_ptr<CreditSystem>& pCreditSystem =
-      this->_externals.pCreditSystem;
-  if (pCreditSystem && !result.tilesToRenderThisFrame.empty()) {
+  return result;
+}
+
+void Tileset::_finishViewUpdateTimings(ViewUpdateTimings* pTimings) noexcept {
+  const int64_t totalDataLoaded =
+      this->_pTilesetContentManager->getTotalDataLoaded();
+  const double rasterOverlayMappingTime =
+      this->_pTilesetContentManager->takeRasterOverlayMappingTime();
+  if (pTimings) {
+    pTimings->bytesLoaded = totalDataLoaded - this->_previousTotalDataLoaded;
+    pTimings->rasterOverlayMappingTime = rasterOverlayMappingTime;
+  }
+
+  this->_previousTotalDataLoaded = totalDataLoaded;
+}
+
+void Tileset::_updateMaximumScreenSpaceError(float deltaTime) noexcept {
+  const double baseSse = this->_options.maximumScreenSpaceError;
+  const AdaptiveScreenSpaceErrorOptions& adaptive =
+      this->_options.adaptiveScreenSpaceError;
+  if (!adaptive.enabled) {
+    this->_maximumScreenSpaceError = baseSse;
+    return;
+  }
+
+  const double maximumSse = glm::max(adaptive.maximumScreenSpaceError, baseSse);
+  const double relaxed = 1.0 - adaptive.hysteresis;
+
+  // The load queue length is that of the previous frame, because this frame's
+  // traversal hasn't happened yet.
+  const double frameTime = static_cast<double>(deltaTime);
+  const double queueLength =
+      static_cast<double>(this->_updateResult.workerThreadTileLoadQueueLength);
+  const double dataBytes = static_cast<double>(this->getTotalDataBytes());
+  const double maximumQueueLength =
+      static_cast<double>(adaptive.maximumLoadQueueLength);
+  const double maximumBytes =
+      static_cast<double>(this->_options.maximumCachedBytes);
+
+  const bool hasFrameTime = frameTime > 0.0;
+  const bool overloaded =
+      (hasFrameTime && frameTime > adaptive.targetFrameTime) ||
+      queueLength > maximumQueueLength || dataBytes > maximumBytes;
+  const bool underloaded =
+      (!hasFrameTime || frameTime < adaptive.targetFrameTime * relaxed) &&
+      queueLength <= maximumQueueLength * relaxed &&
+      dataBytes <= maximumBytes * relaxed;
+
+  double sse = this->_maximumScreenSpaceError;
+  if (overloaded) {
+    sse *= adaptive.adjustmentFactor;
+  } else if (underloaded) {
+    sse /= adaptive.adjustmentFactor;
+  }
+
+  this->_maximumScreenSpaceError = glm::clamp(sse, baseSse, maximumSse);
+}
+
+// Determines whether this is an idle frame, in which the result of the last
+// traversal is still valid. This is all or nothing: a change anywhere in the
+// tileset means a full traversal, since revisiting only the changed subtrees
+// would also have to redo the kicks and refinement decisions of each of their
+// ancestors.
+bool Tileset::_canReuseLastTraversal(
+    const std::vector<ViewState>& frustums) const noexcept {
+  const TilesetOptions& options = this->_options;
+  if (!options.enableViewCoherence || options.enableLodTransitionPeriod ||
+      !options.excluders.empty()) {
+    return false;
+  }
+
+  if (options.enableOcclusionCulling &&
+      this->_externals.pTileOcclusionProxyPool) {
+    return false;
+  }
+
+  // The last traversal must have left nothing to do: a later traversal would
+  // select different tiles once that work completes.
+  const ViewUpdateResult& result = this->_updateResult;
+  if (result.workerThreadTileLoadQueueLength > 0 ||
+      result.mainThreadTileLoadQueueLength > 0 || result.tilesKicked > 0 ||
+      this->_pTilesetContentManager->getNumberOfTilesLoading() > 0) {
+    return false;
+  }
+
+  if (this->_pTilesetContentManager->getTileStateVersion() !=
+          this->_lastTraversalTileStateVersion ||
+      this->_maximumScreenSpaceError !=
+          this->_lastTraversalMaximumScreenSpaceError) {
+    return false;
+  }
+
+  const auto& tileProviders =
+      this->_pTilesetContentManager->getRasterOverlayCollection()
+          .getTileProviders();
+  if (tileProviders.size() != this->_lastTraversalOverlayStates.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < tileProviders.size(); ++i) {
+    const RasterOverlayTileProvider& tileProvider = *tileProviders[i];
+    const RasterOverlayLoadState& lastState =
+        this->_lastTraversalOverlayStates[i];
+    if (&tileProvider != lastState.pTileProvider ||
+        tileProvider.getNumberOfTilesLoading() > 0 ||
+        lastState.tilesLoading > 0 ||
+        tileProvider.getTileDataBytes() != lastState.tileDataBytes) {
+      return false;
+    }
+  }
+
+  if (frustums.empty() ||
+      frustums.size() != this->_lastTraversalFrustums.size()) {
+    return false;
+  }
+
+  const double positionToleranceSquared =
+      options.viewCoherencePositionTolerance *
+      options.viewCoherencePositionTolerance;
+  const double minimumCosine = std::cos(options.viewCoherenceAngleTolerance);
+
+  for (size_t i = 0; i < frustums.size(); ++i) {
+    const ViewState& frustum = frustums[i];
+    const ViewState& lastFrustum = this->_lastTraversalFrustums[i];
+
+    if (frustum.getViewportSize() != lastFrustum.getViewportSize() ||
+        frustum.getHorizontalFieldOfView() !=
+            lastFrustum.getHorizontalFieldOfView() ||
+        frustum.getVerticalFieldOfView() !=
+            lastFrustum.getVerticalFieldOfView()) {
+      return false;
+    }
+
+    const glm::dvec3 offset = frustum.getPosition() - lastFrustum.getPosition();
+    if (glm::dot(offset, offset) > positionToleranceSquared ||
+        glm::dot(frustum.getDirection(), lastFrustum.getDirection()) <
+            minimumCosine ||
+        glm::dot(frustum.getUp(), lastFrustum.getUp()) < minimumCosine) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Tileset::_recordTraversalInputs(const std::vector<ViewState>& frustums) {
+  if (!this->_options.enableViewCoherence) {
+    return;
+  }
+
+  // These are only recorded by full traversals rather than every frame, so
+  // that slow camera drift accumulates until it exceeds the tolerance.
+  this->_lastTraversalFrustums.clear();
+  this->_lastTraversalFrustums.reserve(frustums.size());
+  for (const ViewState& frustum : frustums) {
+    this->_lastTraversalFrustums.push_back(frustum);
+  }
+
+  this->_lastTraversalTileStateVersion =
+      this->_pTilesetContentManager->getTileStateVersion();
+  this->_lastTraversalMaximumScreenSpaceError = this->_maximumScreenSpaceError;
+
+  this->_lastTraversalOverlayStates.clear();
+  for (const auto& pTileProvider : this->_pTilesetContentManager
+                                       ->getRasterOverlayCollection()
+                                       .getTileProviders()) {
+    this->_lastTraversalOverlayStates.push_back(RasterOverlayLoadState{
+        pTileProvider.get(),
+        pTileProvider->getNumberOfTilesLoading(),
+        pTileProvider->getTileDataBytes()});
+  }
+}
+
+void Tileset::_updateLastTraversalCredits(const ViewUpdateResult& result) {
+  // aggregate all the credits needed from this tileset for the selected tiles,
+  // counting how often each is used. A tileset uses few distinct credits, so
+  // a linear search is fine.
+  std::vector<std::pair<Credit, int32_t>>& credits =
+      this->_lastTraversalCredits;
+  credits.clear();
+  auto addCredit = [&credits](const Credit& credit) {
+    auto it = std::find_if(
+        credits.begin(),
+        credits.end(),
+        [&credit](const std::pair<Credit, int32_t>& entry) {
+          return entry.first == credit;
+        });
+    if (it == credits.end()) {
+      credits.emplace_back(credit, 1);
+    } else {
+      ++it->second;
+    }
+  };
+
+  if (this->_externals.pCreditSystem &&
+      !result.tilesToRenderThisFrame.empty()) {
     // per-tileset user-specified credit
     const Credit* pUserCredit = this->_pTilesetContentManager->getUserCredit();
     if (pUserCredit) {
-      pCreditSystem->addCreditToFrame(*pUserCredit);
+      addCredit(*pUserCredit);
     }
 
     // tileset credit
     for (const Credit& credit : this->getTilesetCredits()) {
-      pCreditSystem->addCreditToFrame(credit);
+      addCredit(credit);
     }
 
     // per-raster overlay credit
@@ -394,7 +1167,7 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
     for (auto& pTileProvider : overlayCollection.getTileProviders()) {
       const std::optional<Credit>& overlayCredit = pTileProvider->getCredit();
       if (overlayCredit) {
-        pCreditSystem->addCreditToFrame(overlayCredit.value());
+        addCredit(overlayCredit.value());
       }
     }
 
@@ -408,7 +1181,7 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
             mappedRasterTile.getReadyTile();
         if (pRasterOverlayTile != nullptr) {
           for (const Credit& credit : pRasterOverlayTile->getCredits()) {
-            pCreditSystem->addCreditToFrame(credit);
+            addCredit(credit);
           }
         }
       }
@@ -418,16 +1191,25 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
           pTile->getContent().getRenderContent();
       if (pRenderContent) {
         for (const Credit& credit : pRenderContent->getCredits()) {
-          pCreditSystem->addCreditToFrame(credit);
+          addCredit(credit);
         }
       }
     }
   }
+}
 
-  this->_previousFrameNumber = currentFrameNumber;
+void Tileset::_addCreditsToFrame() {
+  const std::shared_ptr<CreditSystem>& pCreditSystem =
+      this->_externals.pCreditSystem;
+  if (!pCreditSystem) {
+    return;
+  }
 
-  return result;
+  for (const auto& [credit, count] : this->_lastTraversalCredits) {
+    pCreditSystem->addCreditToFrame(credit, count);
+  }
 }
+
 int32_t Tileset::getNumberOfTilesLoaded() const {
   return this->_pTilesetContentManager->getNumberOfTilesLoaded();
 }
@@ -464,10 +1246,199 @@ void Tileset::forEachLoadedTile(
   }
 }
 
+namespace {
+
+template <typename T>
+std::vector<LoadedTileFeature> findLoadedFeaturesImpl(
+    Tile::LoadedLinkedList& loadedTiles,
+    const std::string& propertyId,
+    const T& value) {
+  std::vector<LoadedTileFeature> result;
+  for (Tile* pTile = loadedTiles.head(); pTile;
+       pTile = loadedTiles.next(pTile)) {
+    const TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    if (!pRenderContent || !pRenderContent->getFeatureIndex()) {
+      continue;
+    }
+
+    for (const TileFeature& feature :
+         pRenderContent->getFeatureIndex()->find(propertyId, value)) {
+      result.emplace_back(LoadedTileFeature{pTile, feature});
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+std::vector<LoadedTileFeature> Tileset::findLoadedFeatures(
+    const std::string& propertyId,
+    const std::string& value) {
+  return findLoadedFeaturesImpl(this->_loadedTiles, propertyId, value);
+}
+
+std::vector<LoadedTileFeature>
+Tileset::findLoadedFeatures(const std::string& propertyId, int64_t value) {
+  return findLoadedFeaturesImpl(this->_loadedTiles, propertyId, value);
+}
+
+namespace {
+
+void keepCloserIntersection(
+    std::optional<LoadedTileIntersection>& intersection,
+    const std::optional<LoadedTileIntersection>& candidate) {
+  if (candidate && (!intersection || candidate->intersection.distance <
+                                         intersection->intersection.distance)) {
+    intersection = candidate;
+  }
+}
+
+// Finds the intersections of the rays with the indices `rayIndices` with the
+// content of a tile and its descendants, in the order of the indices. The
+// content of the children of a tile that they replace is preferred to the
+// tile's own.
+void intersectLoadedSubtree(
+    Tile& tile,
+    const gsl::span<const Ray>& rays,
+    const std::vector<size_t>& rayIndices,
+    bool cullBackFaces,
+    std::vector<std::optional<LoadedTileIntersection>>& intersections) {
+  // The positions in `rayIndices` of the rays that intersect the tile.
+  std::vector<size_t> hits;
+  for (size_t i = 0; i < rayIndices.size(); ++i) {
+    if (intersectRayWithBoundingVolume(
+            rays[rayIndices[i]],
+            tile.getBoundingVolume())) {
+      hits.emplace_back(i);
+    }
+  }
+
+  if (hits.empty()) {
+    return;
+  }
+
+  std::vector<size_t> hitRayIndices(hits.size());
+  for (size_t i = 0; i < hits.size(); ++i) {
+    hitRayIndices[i] = rayIndices[hits[i]];
+  }
+
+  std::vector<std::optional<LoadedTileIntersection>> childIntersections(
+      hits.size());
+  std::vector<std::optional<LoadedTileIntersection>> subtreeIntersections;
+  for (Tile& child : tile.getChildren()) {
+    subtreeIntersections.assign(hits.size(), std::nullopt);
+    intersectLoadedSubtree(
+        child,
+        rays,
+        hitRayIndices,
+        cullBackFaces,
+        subtreeIntersections);
+    for (size_t i = 0; i < hits.size(); ++i) {
+      keepCloserIntersection(childIntersections[i], subtreeIntersections[i]);
+    }
+  }
+
+  const TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  const TileGeometryIndex* pGeometryIndex =
+      pRenderContent ? pRenderContent->getGeometryIndex() : nullptr;
+  const bool additive = tile.getRefine() == TileRefine::Add;
+
+  for (size_t i = 0; i < hits.size(); ++i) {
+    std::optional<LoadedTileIntersection>& intersection =
+        intersections[hits[i]];
+    intersection = std::move(childIntersections[i]);
+    if (!pGeometryIndex || (intersection && !additive)) {
+      continue;
+    }
+
+    std::optional<TileGeometryIntersection> maybeIntersection =
+        pGeometryIndex->intersectRay(
+            rays[hitRayIndices[i]],
+            tile.getTransform(),
+            cullBackFaces);
+    if (maybeIntersection) {
+      keepCloserIntersection(
+          intersection,
+          LoadedTileIntersection{&tile, *maybeIntersection});
+    }
+  }
+}
+
+} // namespace
+
+std::optional<LoadedTileIntersection>
+Tileset::intersectLoadedTiles(const Ray& ray, bool cullBackFaces) {
+  return this->intersectLoadedTiles(
+      gsl::span<const Ray>(&ray, 1),
+      cullBackFaces)[0];
+}
+
+std::vector<std::optional<LoadedTileIntersection>>
+Tileset::intersectLoadedTiles(
+    const gsl::span<const Ray>& rays,
+    bool cullBackFaces) {
+  std::vector<std::optional<LoadedTileIntersection>> intersections(
+      rays.size());
+
+  Tile* pRootTile = this->getRootTile();
+  if (!pRootTile || rays.empty()) {
+    return intersections;
+  }
+
+  std::vector<size_t> rayIndices(rays.size());
+  for (size_t i = 0; i < rayIndices.size(); ++i) {
+    rayIndices[i] = i;
+  }
+
+  intersectLoadedSubtree(
+      *pRootTile,
+      rays,
+      rayIndices,
+      cullBackFaces,
+      intersections);
+  return intersections;
+}
+
 int64_t Tileset::getTotalDataBytes() const noexcept {
   return this->_pTilesetContentManager->getTotalDataUsed();
 }
 
+int64_t Tileset::getTotalGpuBytes() const noexcept {
+  return this->_pTilesetContentManager->getTotalGpuDataUsed();
+}
+
+const TileLoadHistograms& Tileset::getTileLoadHistograms() const noexcept {
+  return this->_pTilesetContentManager->getTileLoadHistograms();
+}
+
+void Tileset::resetTileLoadHistograms() noexcept {
+  this->_pTilesetContentManager->resetTileLoadHistograms();
+}
+
+TilesetMemoryUsage Tileset::getMemoryUsage() const {
+  TilesetMemoryUsage usage;
+  this->_pTilesetContentManager->addMemoryUsage(this->_loadedTiles, usage);
+  usage.pooledImageBytes =
+      CesiumUtility::PixelBufferPool::getDefault().getPooledBytes();
+  return usage;
+}
+
+int64_t Tileset::trimMemory(int64_t targetBytes) {
+  const int64_t dataBytes = this->getTotalDataBytes();
+
+  // Unload tiles as the cache does, but down to the target and without a time
+  // limit.
+  const int64_t maximumCachedBytes = this->_options.maximumCachedBytes;
+  this->_options.maximumCachedBytes = std::min(maximumCachedBytes, targetBytes);
+  this->_unloadCachedTiles(0.0);
+  this->_options.maximumCachedBytes = maximumCachedBytes;
+
+  return dataBytes - this->getTotalDataBytes() +
+         this->_pTilesetContentManager->trimMemory(this->_options);
+}
+
 const TilesetMetadata* Tileset::getMetadata(const Tile* pTile) const {
   if (pTile == nullptr) {
     pTile = this->getRootTile();
@@ -523,62 +1494,288 @@ CesiumAsync::Future<const TilesetMetadata*> Tileset::loadMetadata() {
       });
 }
 
-static void markTileNonRendered(
-    TileSelectionState::Result lastResult,
-    Tile& tile,
-    ViewUpdateResult& result) {
-  if (lastResult == TileSelectionState::Result::Rendered ||
-      (lastResult == TileSelectionState::Result::Refined &&
-       tile.getRefine() == TileRefine::Add)) {
-    result.tilesFadingOut.insert(&tile);
-    TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
-    if (pRenderContent) {
-      pRenderContent->setLodTransitionFadePercentage(0.0f);
-    }
-  }
+CesiumAsync::Future<RegionPrecacheProgress> Tileset::precacheRegion(
+    const GlobeRectangle& rectangle,
+    const RegionPrecacheOptions& options) {
+  Promise<RegionPrecacheProgress> promise =
+      this->_asyncSystem.createPromise<RegionPrecacheProgress>();
+  this->_regionPrecacheJobs.emplace_back(
+      std::make_shared<RegionPrecacheJob>(rectangle, options, promise));
+  return promise.getFuture();
 }
 
-static void markTileNonRendered(
+CesiumAsync::Future<TileSelectionQueryResult> Tileset::querySelection(
+    const std::vector<ViewState>& frustums,
+    const TileSelectionQueryOptions& options) {
+  Promise<TileSelectionQueryResult> promise =
+      this->_asyncSystem.createPromise<TileSelectionQueryResult>();
+  this->_selectionQueryJobs.emplace_back(
+      std::make_shared<TileSelectionQueryJob>(frustums, options, promise));
+  return promise.getFuture();
+}
+
+CesiumAsync::Future<SampleHeightResult>
+Tileset::sampleHeights(const gsl::span<const Cartographic>& positions) {
+  Promise<SampleHeightResult> promise =
+      this->_asyncSystem.createPromise<SampleHeightResult>();
+  this->_heightSamplingJobs.emplace_back(std::make_unique<HeightSamplingJob>(
+      std::vector<Cartographic>(positions.begin(), positions.end()),
+      promise));
+  return promise.getFuture();
+}
+
+void Tileset::_updateRegionPrecacheJobs() {
+  CESIUM_TRACE("Tileset::_updateRegionPrecacheJobs");
+
+  auto it = std::remove_if(
+      this->_regionPrecacheJobs.begin(),
+      this->_regionPrecacheJobs.end(),
+      [this](const std::shared_ptr<RegionPrecacheJob>& pJob) {
+        return pJob->update(*this->_pTilesetContentManager, this->_options);
+      });
+  this->_regionPrecacheJobs.erase(it, this->_regionPrecacheJobs.end());
+}
+
+void Tileset::_updateSelectionQueryJobs() {
+  CESIUM_TRACE("Tileset::_updateSelectionQueryJobs");
+
+  auto it = std::remove_if(
+      this->_selectionQueryJobs.begin(),
+      this->_selectionQueryJobs.end(),
+      [this](const std::shared_ptr<TileSelectionQueryJob>& pJob) {
+        return pJob->update(*this->_pTilesetContentManager, this->_options);
+      });
+  this->_selectionQueryJobs.erase(it, this->_selectionQueryJobs.end());
+}
+
+void Tileset::_updateHeightSamplingJobs() {
+  CESIUM_TRACE("Tileset::_updateHeightSamplingJobs");
+
+  auto it = std::remove_if(
+      this->_heightSamplingJobs.begin(),
+      this->_heightSamplingJobs.end(),
+      [this](const std::unique_ptr<HeightSamplingJob>& pJob) {
+        if (!pJob->update(*this->_pTilesetContentManager)) {
+          return false;
+        }
+
+        pJob->resolve(this->intersectLoadedTiles(pJob->getRays()));
+        return true;
+      });
+  this->_heightSamplingJobs.erase(it, this->_heightSamplingJobs.end());
+}
+
+void Tileset::_addHeightSamplingLoads(TraversalState& traversalState) {
+  if (this->_heightSamplingJobs.empty()) {
+    return;
+  }
+
+  std::vector<Tile*> tilesToLoad;
+  std::vector<Tile*> tilesInUse;
+  for (const std::unique_ptr<HeightSamplingJob>& pJob :
+       this->_heightSamplingJobs) {
+    pJob->getTilesToLoad(tilesToLoad);
+    pJob->getTilesInUse(tilesInUse);
+  }
+
+  auto isQueued = [](const std::vector<TileLoadTask>& queue, Tile* pTile) {
+    return std::find_if(
+               queue.begin(),
+               queue.end(),
+               [pTile](const TileLoadTask& task) {
+                 return task.pTile == pTile;
+               }) != queue.end();
+  };
+
+  for (Tile* pTile : tilesToLoad) {
+    if (pTile->getState() == TileLoadState::ContentLoading) {
+      // Keep the load from being canceled, like those of the predicted views.
+      this->_predictedTilesLoading.push_back(pTile);
+    } else if (
+        !isQueued(traversalState.workerThreadLoadQueue, pTile) &&
+        !isQueued(traversalState.mainThreadLoadQueue, pTile)) {
+      this->addTileToLoadQueue(
+          traversalState,
+          *pTile,
+          TileLoadPriorityGroup::Urgent,
+          0.0);
+    }
+  }
+
+  // The root tile must stay where the traversal put it, because it marks the
+  // beginning of the tiles used this frame.
+  for (Tile* pTile : tilesInUse) {
+    if (pTile != this->getRootTile()) {
+      this->_markTileVisited(*pTile);
+    }
+  }
+}
+
+// Gets the index of the entry of a child in the selection data table, given
+// the index of the entry of its parent.
+static uint32_t getChildSelectionIndex(
+    const TileSelectionDataTable* pTable,
+    uint32_t selectionIndex,
+    size_t childIndex) noexcept {
+  return pTable ? pTable->getChildIndex(selectionIndex, childIndex)
+                : TileSelectionDataTable::InvalidIndex;
+}
+
+// Gets the entry of a tile in the selection data table, if it has one. The
+// entry is moved when entries are added, such as when a visited tile gets
+// children, so it must be looked up again after visiting the children.
+static const TileSelectionData* getSelectionData(
+    const TileSelectionDataTable* pTable,
+    uint32_t selectionIndex) noexcept {
+  return pTable ? pTable->get(selectionIndex) : nullptr;
+}
+
+// Gets the selection state of a tile from its entry in the selection data
+// table, or from the tile if it doesn't have one.
+static TileSelectionState getLastSelectionState(
+    const TileSelectionDataTable* pTable,
+    const Tile& tile,
+    uint32_t selectionIndex) noexcept {
+  const TileSelectionData* pSelectionData =
+      getSelectionData(pTable, selectionIndex);
+  return pSelectionData ? pSelectionData->lastSelectionState
+                        : tile.getLastSelectionState();
+}
+
+// Sets the selection state of a tile, and of its entry in the selection data
+// table if it has one.
+static void setLastSelectionState(
+    TileSelectionDataTable* pTable,
+    Tile& tile,
+    uint32_t selectionIndex,
+    const TileSelectionState& selectionState) noexcept {
+  if (pTable) {
+    pTable->setLastSelectionState(tile, selectionIndex, selectionState);
+  } else {
+    tile.setLastSelectionState(selectionState);
+  }
+}
+
+static void markTileNonRendered(
+    TileSelectionState::Result lastResult,
+    TileRefine refine,
+    Tile& tile,
+    ViewUpdateResult& result) {
+  if (lastResult == TileSelectionState::Result::Rendered ||
+      (lastResult == TileSelectionState::Result::Refined &&
+       refine == TileRefine::Add)) {
+    result.tilesFadingOut.emplace_back(&tile);
+    TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+    if (pRenderContent) {
+      pRenderContent->setLodTransitionFadePercentage(0.0f);
+    }
+  }
+}
+
+static void markTileNonRendered(
     int32_t lastFrameNumber,
+    const TileSelectionDataTable* pTable,
     Tile& tile,
+    uint32_t selectionIndex,
     ViewUpdateResult& result) {
+  const TileSelectionData* pSelectionData =
+      getSelectionData(pTable, selectionIndex);
   const TileSelectionState::Result lastResult =
-      tile.getLastSelectionState().getResult(lastFrameNumber);
-  markTileNonRendered(lastResult, tile, result);
+      getLastSelectionState(pTable, tile, selectionIndex)
+          .getResult(lastFrameNumber);
+  markTileNonRendered(
+      lastResult,
+      pSelectionData ? pSelectionData->refine : tile.getRefine(),
+      tile,
+      result);
 }
 
 static void markChildrenNonRendered(
     int32_t lastFrameNumber,
     TileSelectionState::Result lastResult,
+    const TileSelectionDataTable* pTable,
     Tile& tile,
+    uint32_t selectionIndex,
     ViewUpdateResult& result) {
   if (lastResult == TileSelectionState::Result::Refined) {
-    for (Tile& child : tile.getChildren()) {
+    gsl::span<Tile> children = tile.getChildren();
+    for (size_t i = 0; i < children.size(); ++i) {
+      Tile& child = children[i];
+      const uint32_t childIndex =
+          getChildSelectionIndex(pTable, selectionIndex, i);
+      const TileSelectionData* pChildData =
+          getSelectionData(pTable, childIndex);
       const TileSelectionState::Result childLastResult =
-          child.getLastSelectionState().getResult(lastFrameNumber);
-      markTileNonRendered(childLastResult, child, result);
-      markChildrenNonRendered(lastFrameNumber, childLastResult, child, result);
+          getLastSelectionState(pTable, child, childIndex)
+              .getResult(lastFrameNumber);
+      markTileNonRendered(
+          childLastResult,
+          pChildData ? pChildData->refine : child.getRefine(),
+          child,
+          result);
+      markChildrenNonRendered(
+          lastFrameNumber,
+          childLastResult,
+          pTable,
+          child,
+          childIndex,
+          result);
     }
   }
 }
 
 static void markChildrenNonRendered(
     int32_t lastFrameNumber,
+    const TileSelectionDataTable* pTable,
     Tile& tile,
+    uint32_t selectionIndex,
     ViewUpdateResult& result) {
   const TileSelectionState::Result lastResult =
-      tile.getLastSelectionState().getResult(lastFrameNumber);
-  markChildrenNonRendered(lastFrameNumber, lastResult, tile, result);
+      getLastSelectionState(pTable, tile, selectionIndex)
+          .getResult(lastFrameNumber);
+  markChildrenNonRendered(
+      lastFrameNumber,
+      lastResult,
+      pTable,
+      tile,
+      selectionIndex,
+      result);
 }
 
 static void markTileAndChildrenNonRendered(
     int32_t lastFrameNumber,
+    const TileSelectionDataTable* pTable,
     Tile& tile,
+    uint32_t selectionIndex,
     ViewUpdateResult& result) {
-  const TileSelectionState::Result lastResult =
-      tile.getLastSelectionState().getResult(lastFrameNumber);
-  markTileNonRendered(lastResult, tile, result);
-  markChildrenNonRendered(lastFrameNumber, lastResult, tile, result);
+  markTileNonRendered(lastFrameNumber, pTable, tile, selectionIndex, result);
+  markChildrenNonRendered(
+      lastFrameNumber,
+      pTable,
+      tile,
+      selectionIndex,
+      result);
+}
+
+/**
+ * @brief Returns whether the camera is above or below the given bounding
+ * volume.
+ */
+static bool isUnderCamera(
+    const ViewState& viewState,
+    const BoundingVolume& boundingVolume) {
+  const std::optional<CesiumGeospatial::Cartographic>& position =
+      viewState.getPositionCartographic();
+
+  // TODO: it would be better to test a line pointing down (and up?) from the
+  // camera against the bounding volume itself, rather than transforming the
+  // bounding volume to a region.
+  std::optional<GlobeRectangle> maybeRectangle =
+      estimateGlobeRectangle(boundingVolume);
+  if (position && maybeRectangle) {
+    return maybeRectangle->contains(position.value());
+  }
+  return false;
 }
 
 /**
@@ -587,6 +1784,8 @@ static void markTileAndChildrenNonRendered(
  *
  * @param viewState The {@link ViewState}
  * @param boundingVolume The bounding volume of the tile
+ * @param pEnclosingSphere A precomputed sphere enclosing the bounding volume,
+ * or nullptr
  * @param forceRenderTilesUnderCamera Whether tiles under the camera should
  * always be considered visible and rendered (see
  * {@link Cesium3DTilesSelection::TilesetOptions}).
@@ -596,25 +1795,61 @@ static void markTileAndChildrenNonRendered(
 static bool isVisibleFromCamera(
     const ViewState& viewState,
     const BoundingVolume& boundingVolume,
+    const BoundingSphere* pEnclosingSphere,
     bool forceRenderTilesUnderCamera) {
-  if (viewState.isBoundingVolumeVisible(boundingVolume)) {
+  const bool isVisible =
+      pEnclosingSphere
+          ? viewState.isBoundingVolumeVisible(boundingVolume, *pEnclosingSphere)
+          : viewState.isBoundingVolumeVisible(boundingVolume);
+  if (isVisible) {
     return true;
   }
   if (!forceRenderTilesUnderCamera) {
     return false;
   }
 
-  const std::optional<CesiumGeospatial::Cartographic>& position =
-      viewState.getPositionCartographic();
+  return isUnderCamera(viewState, boundingVolume);
+}
 
-  // TODO: it would be better to test a line pointing down (and up?) from the
-  // camera against the bounding volume itself, rather than transforming the
-  // bounding volume to a region.
-  std::optional<GlobeRectangle> maybeRectangle =
-      estimateGlobeRectangle(boundingVolume);
-  if (position && maybeRectangle) {
-    return maybeRectangle->contains(position.value());
+/**
+ * @brief Returns whether any of the given bounding volumes is visible in the
+ * view frustum, or is under the camera if `forceRenderTilesUnderCamera` is
+ * true.
+ *
+ * The bounding volumes are tested in batches with
+ * {@link ViewState::areBoundingVolumesVisible}.
+ *
+ * @param getBoundingVolume A function that returns the bounding volume with a
+ * given index, which must stay valid during the call.
+ */
+template <typename GetBoundingVolume>
+static bool isAnyVisibleFromCamera(
+    const ViewState& viewState,
+    size_t boundingVolumeCount,
+    GetBoundingVolume&& getBoundingVolume,
+    bool forceRenderTilesUnderCamera) {
+  constexpr size_t batchSize = 8;
+  std::array<const BoundingVolume*, batchSize> boundingVolumes{};
+  std::array<bool, batchSize> visible{};
+
+  for (size_t start = 0; start < boundingVolumeCount; start += batchSize) {
+    const size_t count = std::min(batchSize, boundingVolumeCount - start);
+    for (size_t i = 0; i < count; ++i) {
+      boundingVolumes[i] = &getBoundingVolume(start + i);
+    }
+
+    viewState.areBoundingVolumesVisible(
+        gsl::span<const BoundingVolume* const>(boundingVolumes.data(), count),
+        gsl::span<bool>(visible.data(), count));
+
+    for (size_t i = 0; i < count; ++i) {
+      if (visible[i] || (forceRenderTilesUnderCamera &&
+                         isUnderCamera(viewState, *boundingVolumes[i]))) {
+        return true;
+      }
+    }
   }
+
   return false;
 }
 
@@ -636,6 +1871,7 @@ static bool isVisibleInFog(double distance, double fogDensity) noexcept {
 
 void Tileset::_frustumCull(
     const Tile& tile,
+    uint32_t selectionIndex,
     const FrameState& frameState,
     bool cullWithChildrenBounds,
     CullResult& cullResult) {
@@ -644,44 +1880,74 @@ void Tileset::_frustumCull(
     return;
   }
 
+  const TileSelectionDataTable* pTable = frameState.pSelectionData;
+  const TileSelectionData* pSelectionData =
+      pTable ? pTable->get(selectionIndex) : nullptr;
+
   const std::vector<ViewState>& frustums = frameState.frustums;
   // Frustum cull using the children's bounds.
   if (cullWithChildrenBounds) {
+    gsl::span<const Tile> children = tile.getChildren();
+    const bool childrenAreRegistered =
+        pSelectionData && pSelectionData->childCount == children.size();
+    const size_t childCount =
+        childrenAreRegistered ? pSelectionData->childCount : children.size();
+    auto getChildBoundingVolume =
+        [pTable, pSelectionData, childrenAreRegistered, children](
+            size_t i) -> const BoundingVolume& {
+      return childrenAreRegistered
+                 ? pTable->getBoundingVolume(
+                       pSelectionData->firstChild + static_cast<uint32_t>(i))
+                 : children[i].getBoundingVolume();
+    };
     if (std::any_of(
             frustums.begin(),
             frustums.end(),
-            [children = tile.getChildren(),
+            [childCount,
+             &getChildBoundingVolume,
              renderTilesUnderCamera = this->_options.renderTilesUnderCamera](
                 const ViewState& frustum) {
-              for (const Tile& child : children) {
-                if (isVisibleFromCamera(
-                        frustum,
-                        child.getBoundingVolume(),
-                        renderTilesUnderCamera)) {
-                  return true;
-                }
-              }
-
-              return false;
+              return isAnyVisibleFromCamera(
+                  frustum,
+                  childCount,
+                  getChildBoundingVolume,
+                  renderTilesUnderCamera);
             })) {
       // At least one child is visible in at least one frustum, so don't cull.
       return;
     }
-    // Frustum cull based on the actual tile's bounds.
-  } else if (std::any_of(
-                 frustums.begin(),
-                 frustums.end(),
-                 [&boundingVolume = tile.getBoundingVolume(),
-                  renderTilesUnderCamera =
-                      this->_options.renderTilesUnderCamera](
-                     const ViewState& frustum) {
-                   return isVisibleFromCamera(
-                       frustum,
-                       boundingVolume,
-                       renderTilesUnderCamera);
-                 })) {
-    // The tile is visible in at least one frustum, so don't cull.
-    return;
+  } else {
+    // Frustum cull based on the actual tile's bounds. A leaf tile is only
+    // visible if its content is, so its content bounding volume, which may be
+    // tighter, may be used instead.
+    const bool useContentBounds =
+        this->_options.enableContentBoundingVolumeCulling &&
+        tile.getContentBoundingVolume().has_value() &&
+        TilesetContentManager::isFinalLeafTile(tile);
+    const BoundingVolume& boundingVolume =
+        useContentBounds ? *tile.getContentBoundingVolume()
+        : pSelectionData ? pTable->getBoundingVolume(selectionIndex)
+                         : tile.getBoundingVolume();
+    const BoundingSphere* pEnclosingSphere =
+        !useContentBounds && pSelectionData
+            ? &pTable->getEnclosingSphere(selectionIndex)
+            : nullptr;
+    if (std::any_of(
+            frustums.begin(),
+            frustums.end(),
+            [&boundingVolume,
+             pEnclosingSphere,
+             renderTilesUnderCamera = this->_options.renderTilesUnderCamera](
+                const ViewState& frustum) {
+              return isVisibleFromCamera(
+                  frustum,
+                  boundingVolume,
+                  pEnclosingSphere,
+                  renderTilesUnderCamera);
+            })) {
+      // The tile is visible in at least one frustum, so don't cull.
+      return;
+    }
   }
 
   // If we haven't returned yet, this tile is frustum culled.
@@ -728,12 +1994,10 @@ void Tileset::_fogCull(
 }
 
 static double computeTilePriority(
-    const Tile& tile,
+    const glm::dvec3& boundingVolumeCenter,
     const std::vector<ViewState>& frustums,
     const std::vector<double>& distances) {
   double highestLoadPriority = std::numeric_limits<double>::max();
-  const glm::dvec3 boundingVolumeCenter =
-      getBoundingVolumeCenter(tile.getBoundingVolume());
 
   for (size_t i = 0; i < frustums.size() && i < distances.size(); ++i) {
     const ViewState& frustum = frustums[i];
@@ -756,11 +2020,9 @@ static double computeTilePriority(
 }
 
 void computeDistances(
-    const Tile& tile,
+    const BoundingVolume& boundingVolume,
     const std::vector<ViewState>& frustums,
     std::vector<double>& distances) {
-  const BoundingVolume& boundingVolume = tile.getBoundingVolume();
-
   distances.clear();
   distances.resize(frustums.size());
 
@@ -775,11 +2037,11 @@ void computeDistances(
       });
 }
 
-bool Tileset::_meetsSse(
-    const std::vector<ViewState>& frustums,
-    const Tile& tile,
-    const std::vector<double>& distances,
-    bool culled) const noexcept {
+double Tileset::_computeScreenSpaceError(
+    const FrameState& frameState,
+    double geometricError,
+    const std::vector<double>& distances) const noexcept {
+  const std::vector<ViewState>& frustums = frameState.frustums;
 
   double largestSse = 0.0;
 
@@ -788,16 +2050,82 @@ bool Tileset::_meetsSse(
     const double distance = distances[i];
 
     // Does this tile meet the screen-space error?
-    const double sse =
-        frustum.computeScreenSpaceError(tile.getGeometricError(), distance);
+    double sse = frustum.computeScreenSpaceError(geometricError, distance);
+    if (i < frameState.dynamicScreenSpaceErrorDensities.size()) {
+      const double scalar =
+          distance * frameState.dynamicScreenSpaceErrorDensities[i];
+      const double fog = 1.0 - glm::exp(-(scalar * scalar));
+      sse -= fog * this->_options.dynamicScreenSpaceErrorFactor;
+    }
+
     if (sse > largestSse) {
       largestSse = sse;
     }
   }
 
+  return largestSse;
+}
+
+bool Tileset::_meetsSse(
+    const FrameState& frameState,
+    double screenSpaceError,
+    bool culled) const noexcept {
   return culled ? !this->_options.enforceCulledScreenSpaceError ||
-                      largestSse < this->_options.culledScreenSpaceError
-                : largestSse < this->_options.maximumScreenSpaceError;
+                      screenSpaceError < this->_options.culledScreenSpaceError
+                : screenSpaceError < frameState.maximumScreenSpaceError;
+}
+
+void Tileset::_sortTilesToRenderFrontToBack(
+    const FrameState& frameState,
+    ViewUpdateResult& result) {
+  struct RenderedTile {
+    Tile* pTile;
+    double distance;
+    double screenSpaceError;
+  };
+
+  std::vector<Tile*>& tiles = result.tilesToRenderThisFrame;
+  std::vector<RenderedTile> renderedTiles;
+  renderedTiles.reserve(tiles.size());
+
+  std::vector<double>& distances = this->_distances;
+  for (Tile* pTile : tiles) {
+    const TileSelectionData* pSelectionData =
+        frameState.pSelectionData ? frameState.pSelectionData->find(*pTile)
+                                  : nullptr;
+    computeDistances(
+        pTile->getBoundingVolume(),
+        frameState.frustums,
+        distances);
+    const double distance =
+        distances.empty()
+            ? std::numeric_limits<double>::max()
+            : *std::min_element(distances.begin(), distances.end());
+    const double screenSpaceError = this->_computeScreenSpaceError(
+        frameState,
+        pSelectionData ? pSelectionData->geometricError
+                       : pTile->getGeometricError(),
+        distances);
+    renderedTiles.push_back({pTile, distance, screenSpaceError});
+  }
+
+  // A stable sort keeps the traversal order of tiles at the same distance,
+  // such as an additive-refined tile and the children that the view is in.
+  std::stable_sort(
+      renderedTiles.begin(),
+      renderedTiles.end(),
+      [](const RenderedTile& lhs, const RenderedTile& rhs) {
+        return lhs.distance < rhs.distance;
+      });
+
+  result.tilesToRenderThisFrameDistances.resize(renderedTiles.size());
+  result.tilesToRenderThisFrameScreenSpaceErrors.resize(renderedTiles.size());
+  for (size_t i = 0; i < renderedTiles.size(); ++i) {
+    tiles[i] = renderedTiles[i].pTile;
+    result.tilesToRenderThisFrameDistances[i] = renderedTiles[i].distance;
+    result.tilesToRenderThisFrameScreenSpaceErrors[i] =
+        renderedTiles[i].screenSpaceError;
+  }
 }
 
 // Visits a tile for possible rendering. When we call this function with a tile:
@@ -811,50 +2139,83 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
     uint32_t depth,
     bool ancestorMeetsSse,
     Tile& tile,
-    ViewUpdateResult& result) {
-
-  std::vector<double>& distances = this->_distances;
-  computeDistances(tile, frameState.frustums, distances);
-  double tilePriority =
-      computeTilePriority(tile, frameState.frustums, distances);
+    uint32_t selectionIndex,
+    TraversalState& state) {
+  ViewUpdateResult& result = state.result;
+
+  if (state.pVisitedTiles) {
+    // Running in a parallel work unit, so let the main thread update the
+    // content once the traversal is complete.
+    state.pVisitedTiles->push_back(&tile);
+  } else {
+    this->_pTilesetContentManager->updateTileContent(tile, _options);
+    this->_markTileVisited(tile);
+  }
 
-  this->_pTilesetContentManager->updateTileContent(tile, _options);
-  this->_markTileVisited(tile);
+  // Updating the content may add entries to the table, which moves the
+  // existing ones, so the entry is only looked up afterward.
+  const TileSelectionDataTable* pTable = frameState.pSelectionData;
+  const TileSelectionData* pSelectionData =
+      pTable ? pTable->get(selectionIndex) : nullptr;
+
+  std::vector<double>& distances = state.distances;
+  computeDistances(
+      pSelectionData ? pTable->getBoundingVolume(selectionIndex)
+                     : tile.getBoundingVolume(),
+      frameState.frustums,
+      distances);
+  double tilePriority = computeTilePriority(
+      pSelectionData ? pSelectionData->boundingVolumeCenter
+                     : getBoundingVolumeCenter(tile.getBoundingVolume()),
+      frameState.frustums,
+      distances);
+
+  const TileRefine refine =
+      pSelectionData ? pSelectionData->refine : tile.getRefine();
+  const bool unconditionallyRefine =
+      pSelectionData ? pSelectionData->unconditionallyRefine
+                     : tile.getUnconditionallyRefine();
 
   CullResult cullResult{};
 
   // Culling with children bounds will give us incorrect results with Add
   // refinement, but is a useful optimization for Replace refinement.
+  const size_t childCount =
+      pSelectionData ? pSelectionData->childCount : tile.getChildren().size();
   bool cullWithChildrenBounds =
-      tile.getRefine() == TileRefine::Replace && !tile.getChildren().empty();
-  for (Tile& child : tile.getChildren()) {
-    if (child.getUnconditionallyRefine()) {
+      refine == TileRefine::Replace && childCount != 0;
+  for (size_t i = 0; i < childCount && cullWithChildrenBounds; ++i) {
+    const TileSelectionData* pChildData =
+        pTable ? pTable->get(pTable->getChildIndex(selectionIndex, i))
+               : nullptr;
+    if (pChildData ? pChildData->unconditionallyRefine
+                   : tile.getChildren()[i].getUnconditionallyRefine()) {
       cullWithChildrenBounds = false;
-      break;
     }
   }
 
   // TODO: add cullWithChildrenBounds to the tile excluder interface?
-  for (const std::shared_ptr<ITileExcluder>& pExcluder :
-       this->_options.excluders) {
-    if (pExcluder->shouldExclude(tile)) {
-      cullResult.culled = true;
-      cullResult.shouldVisit = false;
-      break;
-    }
+  // The excluders were asked about this tile along with its siblings.
+  if (state.exclusion.excluded) {
+    cullResult.culled = true;
+    cullResult.shouldVisit = false;
   }
 
   // TODO: abstract culling stages into composable interface?
-  this->_frustumCull(tile, frameState, cullWithChildrenBounds, cullResult);
+  this->_frustumCull(
+      tile,
+      selectionIndex,
+      frameState,
+      cullWithChildrenBounds,
+      cullResult);
   this->_fogCull(frameState, distances, cullResult);
 
-  if (!cullResult.shouldVisit && tile.getUnconditionallyRefine()) {
+  if (!cullResult.shouldVisit && unconditionallyRefine) {
     // Unconditionally refined tiles must always be visited in forbidHoles
     // mode, because we need to load this tile's descendants before we can
     // render any of its siblings. An unconditionally refined root tile must be
     // visited as well, otherwise we won't load anything at all.
-    if ((this->_options.forbidHoles &&
-         tile.getRefine() == TileRefine::Replace) ||
+    if ((this->_options.forbidHoles && refine == TileRefine::Replace) ||
         tile.getParent() == nullptr) {
       cullResult.shouldVisit = true;
     }
@@ -862,30 +2223,48 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
 
   if (!cullResult.shouldVisit) {
     const TileSelectionState lastFrameSelectionState =
-        tile.getLastSelectionState();
+        getLastSelectionState(pTable, tile, selectionIndex);
 
-    markTileAndChildrenNonRendered(frameState.lastFrameNumber, tile, result);
-    tile.setLastSelectionState(TileSelectionState(
-        frameState.currentFrameNumber,
-        TileSelectionState::Result::Culled));
+    markTileAndChildrenNonRendered(
+        frameState.lastFrameNumber,
+        pTable,
+        tile,
+        selectionIndex,
+        result);
+    setLastSelectionState(
+        frameState.pSelectionData,
+        tile,
+        selectionIndex,
+        TileSelectionState(
+            frameState.currentFrameNumber,
+            TileSelectionState::Result::Culled));
 
     ++result.tilesCulled;
 
     TraversalDetails traversalDetails{};
 
-    if (this->_options.forbidHoles && tile.getRefine() == TileRefine::Replace) {
+    if (this->_options.forbidHoles && refine == TileRefine::Replace) {
       // In order to prevent holes, we need to load this tile and also not
       // render any siblings until it is ready. We don't actually need to
       // render it, though.
-      addTileToLoadQueue(tile, TileLoadPriorityGroup::Normal, tilePriority);
+      addTileToLoadQueue(
+          state,
+          tile,
+          TileLoadPriorityGroup::Normal,
+          tilePriority);
 
       traversalDetails = Tileset::createTraversalDetailsForSingleTile(
           frameState,
           tile,
+          selectionIndex,
           lastFrameSelectionState);
     } else if (this->_options.preloadSiblings) {
       // Preload this culled sibling as requested.
-      addTileToLoadQueue(tile, TileLoadPriorityGroup::Preload, tilePriority);
+      addTileToLoadQueue(
+          state,
+          tile,
+          TileLoadPriorityGroup::Preload,
+          tilePriority);
     }
 
     return traversalDetails;
@@ -895,8 +2274,13 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
     ++result.culledTilesVisited;
   }
 
+  const double screenSpaceError = this->_computeScreenSpaceError(
+      frameState,
+      pSelectionData ? pSelectionData->geometricError
+                     : tile.getGeometricError(),
+      distances);
   bool meetsSse =
-      this->_meetsSse(frameState.frustums, tile, distances, cullResult.culled);
+      this->_meetsSse(frameState, screenSpaceError, cullResult.culled);
 
   return this->_visitTile(
       frameState,
@@ -904,33 +2288,41 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
       meetsSse,
       ancestorMeetsSse,
       tile,
+      selectionIndex,
       tilePriority,
-      result);
-}
-
-static bool isLeaf(const Tile& tile) noexcept {
-  return tile.getChildren().empty();
+      screenSpaceError,
+      state);
 }
 
 Tileset::TraversalDetails Tileset::_renderLeaf(
     const FrameState& frameState,
     Tile& tile,
+    uint32_t selectionIndex,
     double tilePriority,
-    ViewUpdateResult& result) {
+    TraversalState& state) {
 
   const TileSelectionState lastFrameSelectionState =
-      tile.getLastSelectionState();
-
-  tile.setLastSelectionState(TileSelectionState(
-      frameState.currentFrameNumber,
-      TileSelectionState::Result::Rendered));
-  result.tilesToRenderThisFrame.push_back(&tile);
+      getLastSelectionState(frameState.pSelectionData, tile, selectionIndex);
 
-  addTileToLoadQueue(tile, TileLoadPriorityGroup::Normal, tilePriority);
+  setLastSelectionState(
+      frameState.pSelectionData,
+      tile,
+      selectionIndex,
+      TileSelectionState(
+          frameState.currentFrameNumber,
+          TileSelectionState::Result::Rendered));
+  state.result.tilesToRenderThisFrame.push_back(&tile);
+
+  addTileToLoadQueue(
+      state,
+      tile,
+      TileLoadPriorityGroup::Normal,
+      tilePriority);
 
   return Tileset::createTraversalDetailsForSingleTile(
       frameState,
       tile,
+      selectionIndex,
       lastFrameSelectionState);
 }
 
@@ -945,6 +2337,7 @@ Tileset::TraversalDetails Tileset::_renderLeaf(
  */
 static bool shouldRenderThisTile(
     const Tile& tile,
+    const TileSelectionData* pSelectionData,
     const TileSelectionState& lastFrameSelectionState,
     int32_t lastFrameNumber) noexcept {
   const TileSelectionState::Result originalResult =
@@ -958,8 +2351,8 @@ static bool shouldRenderThisTile(
   }
 
   // Tile::isRenderable is actually a pretty complex operation, so only do
-  // it when absolutely necessary
-  if (tile.isRenderable()) {
+  // it when absolutely necessary. The selection data has it at hand.
+  if (pSelectionData ? pSelectionData->renderable : tile.isRenderable()) {
     return true;
   }
   return false;
@@ -968,34 +2361,50 @@ static bool shouldRenderThisTile(
 Tileset::TraversalDetails Tileset::_renderInnerTile(
     const FrameState& frameState,
     Tile& tile,
-    ViewUpdateResult& result) {
+    uint32_t selectionIndex,
+    TraversalState& state) {
 
   const TileSelectionState lastFrameSelectionState =
-      tile.getLastSelectionState();
+      getLastSelectionState(frameState.pSelectionData, tile, selectionIndex);
 
-  markChildrenNonRendered(frameState.lastFrameNumber, tile, result);
-  tile.setLastSelectionState(TileSelectionState(
-      frameState.currentFrameNumber,
-      TileSelectionState::Result::Rendered));
-  result.tilesToRenderThisFrame.push_back(&tile);
+  markChildrenNonRendered(
+      frameState.lastFrameNumber,
+      frameState.pSelectionData,
+      tile,
+      selectionIndex,
+      state.result);
+  setLastSelectionState(
+      frameState.pSelectionData,
+      tile,
+      selectionIndex,
+      TileSelectionState(
+          frameState.currentFrameNumber,
+          TileSelectionState::Result::Rendered));
+  state.result.tilesToRenderThisFrame.push_back(&tile);
 
   return Tileset::createTraversalDetailsForSingleTile(
       frameState,
       tile,
+      selectionIndex,
       lastFrameSelectionState);
 }
 
 bool Tileset::_loadAndRenderAdditiveRefinedTile(
     Tile& tile,
-    ViewUpdateResult& result,
+    TileRefine refine,
+    TraversalState& state,
     double tilePriority,
     bool queuedForLoad) {
   // If this tile uses additive refinement, we need to render this tile in
   // addition to its children.
-  if (tile.getRefine() == TileRefine::Add) {
-    result.tilesToRenderThisFrame.push_back(&tile);
+  if (refine == TileRefine::Add) {
+    state.result.tilesToRenderThisFrame.push_back(&tile);
     if (!queuedForLoad)
-      addTileToLoadQueue(tile, TileLoadPriorityGroup::Normal, tilePriority);
+      addTileToLoadQueue(
+          state,
+          tile,
+          TileLoadPriorityGroup::Normal,
+          tilePriority);
     return true;
   }
 
@@ -1007,27 +2416,39 @@ bool Tileset::_loadAndRenderAdditiveRefinedTile(
 bool Tileset::_kickDescendantsAndRenderTile(
     const FrameState& frameState,
     Tile& tile,
-    ViewUpdateResult& result,
+    uint32_t selectionIndex,
+    TraversalState& state,
     TraversalDetails& traversalDetails,
     size_t firstRenderedDescendantIndex,
     size_t workerThreadLoadQueueIndex,
     size_t mainThreadLoadQueueIndex,
     bool queuedForLoad,
+    bool isPlaceholder,
     double tilePriority) {
+  ViewUpdateResult& result = state.result;
+  TileSelectionDataTable* pTable = frameState.pSelectionData;
   const TileSelectionState lastFrameSelectionState =
-      tile.getLastSelectionState();
+      getLastSelectionState(pTable, tile, selectionIndex);
 
   std::vector<Tile*>& renderList = result.tilesToRenderThisFrame;
 
   // Mark the rendered descendants and their ancestors - up to this tile - as
-  // kicked.
+  // kicked. The tiles are followed up to their parents, which they are kicked
+  // along with, but whether they were already kicked is read from their
+  // entries.
   for (size_t i = firstRenderedDescendantIndex; i < renderList.size(); ++i) {
     Tile* pWorkTile = renderList[i];
-    while (pWorkTile != nullptr &&
-           !pWorkTile->getLastSelectionState().wasKicked(
-               frameState.currentFrameNumber) &&
-           pWorkTile != &tile) {
-      pWorkTile->getLastSelectionState().kick();
+    while (pWorkTile != nullptr && pWorkTile != &tile) {
+      const uint32_t workIndex =
+          pTable ? pTable->indexOf(*pWorkTile)
+                 : TileSelectionDataTable::InvalidIndex;
+      TileSelectionState workState =
+          getLastSelectionState(pTable, *pWorkTile, workIndex);
+      if (workState.wasKicked(frameState.currentFrameNumber)) {
+        break;
+      }
+      workState.kick();
+      setLastSelectionState(pTable, *pWorkTile, workIndex, workState);
       pWorkTile = pWorkTile->getParent();
     }
   }
@@ -1039,58 +2460,76 @@ bool Tileset::_kickDescendantsAndRenderTile(
               firstRenderedDescendantIndex),
       renderList.end());
 
-  if (tile.getRefine() != Cesium3DTilesSelection::TileRefine::Add) {
+  // The children were visited, so the entry is looked up only now.
+  const TileSelectionData* pSelectionData =
+      getSelectionData(pTable, selectionIndex);
+  const TileRefine refine =
+      pSelectionData ? pSelectionData->refine : tile.getRefine();
+  const bool isRenderable =
+      pSelectionData ? pSelectionData->renderable : tile.isRenderable();
+  const bool unconditionallyRefine =
+      pSelectionData ? pSelectionData->unconditionallyRefine
+                     : tile.getUnconditionallyRefine();
+
+  if (refine != Cesium3DTilesSelection::TileRefine::Add) {
     renderList.push_back(&tile);
   }
 
-  tile.setLastSelectionState(TileSelectionState(
-      frameState.currentFrameNumber,
-      TileSelectionState::Result::Rendered));
+  setLastSelectionState(
+      pTable,
+      tile,
+      selectionIndex,
+      TileSelectionState(
+          frameState.currentFrameNumber,
+          TileSelectionState::Result::Rendered));
 
   // If we're waiting on heaps of descendants, the above will take too long. So
   // in that case, load this tile INSTEAD of loading any of the descendants, and
   // tell the up-level we're only waiting on this tile. Keep doing this until we
-  // actually manage to render this tile.
+  // actually manage to render this tile. Tiles that are skipped when skipping
+  // levels of detail are never loaded this way.
   // Make sure we don't end up waiting on a tile that will _never_ be
   // renderable.
   const bool wasRenderedLastFrame =
       lastFrameSelectionState.getResult(frameState.lastFrameNumber) ==
       TileSelectionState::Result::Rendered;
-  const bool wasReallyRenderedLastFrame =
-      wasRenderedLastFrame && tile.isRenderable();
+  const bool wasReallyRenderedLastFrame = wasRenderedLastFrame && isRenderable;
 
-  if (!wasReallyRenderedLastFrame &&
+  if (isPlaceholder && !wasReallyRenderedLastFrame &&
       traversalDetails.notYetRenderableCount >
           this->_options.loadingDescendantLimit &&
-      !tile.isExternalContent() && !tile.getUnconditionallyRefine()) {
+      !unconditionallyRefine && !tile.isExternalContent()) {
 
     // Remove all descendants from the load queues.
     size_t allQueueStartSize =
-        _workerThreadLoadQueue.size() + _mainThreadLoadQueue.size();
-    this->_workerThreadLoadQueue.erase(
-        this->_workerThreadLoadQueue.begin() +
+        state.workerThreadLoadQueue.size() + state.mainThreadLoadQueue.size();
+    state.workerThreadLoadQueue.erase(
+        state.workerThreadLoadQueue.begin() +
             static_cast<std::vector<TileLoadTask>::iterator::difference_type>(
                 workerThreadLoadQueueIndex),
-        this->_workerThreadLoadQueue.end());
-    this->_mainThreadLoadQueue.erase(
-        this->_mainThreadLoadQueue.begin() +
+        state.workerThreadLoadQueue.end());
+    state.mainThreadLoadQueue.erase(
+        state.mainThreadLoadQueue.begin() +
             static_cast<std::vector<TileLoadTask>::iterator::difference_type>(
                 mainThreadLoadQueueIndex),
-        this->_mainThreadLoadQueue.end());
+        state.mainThreadLoadQueue.end());
     size_t allQueueEndSize =
-        _workerThreadLoadQueue.size() + _mainThreadLoadQueue.size();
+        state.workerThreadLoadQueue.size() + state.mainThreadLoadQueue.size();
     result.tilesKicked +=
         static_cast<uint32_t>(allQueueStartSize - allQueueEndSize);
 
     if (!queuedForLoad) {
-      addTileToLoadQueue(tile, TileLoadPriorityGroup::Normal, tilePriority);
+      addTileToLoadQueue(
+          state,
+          tile,
+          TileLoadPriorityGroup::Normal,
+          tilePriority);
     }
 
-    traversalDetails.notYetRenderableCount = tile.isRenderable() ? 0 : 1;
+    traversalDetails.notYetRenderableCount = isRenderable ? 0 : 1;
     queuedForLoad = true;
   }
 
-  bool isRenderable = tile.isRenderable();
   traversalDetails.allAreRenderable = isRenderable;
   traversalDetails.anyWereRenderedLastFrame =
       isRenderable && wasRenderedLastFrame;
@@ -1098,11 +2537,21 @@ bool Tileset::_kickDescendantsAndRenderTile(
   return queuedForLoad;
 }
 
-TileOcclusionState
-Tileset::_checkOcclusion(const Tile& tile, const FrameState& frameState) {
+TileOcclusionState Tileset::_checkOcclusion(
+    const Tile& tile,
+    const FrameState& frameState,
+    TraversalState& state) {
   const std::shared_ptr<TileOcclusionRendererProxyPool>& pOcclusionPool =
       this->getExternals().pTileOcclusionProxyPool;
   if (pOcclusionPool) {
+    // The pool is shared by all parallel work units.
+    std::unique_lock<std::mutex> lock(
+        this->_occlusionPoolMutex,
+        std::defer_lock);
+    if (state.pVisitedTiles) {
+      lock.lock();
+    }
+
     // First check if this tile's bounding volume has occlusion info and is
     // known to be occluded.
     const TileOcclusionRendererProxy* pOcclusion =
@@ -1144,8 +2593,8 @@ Tileset::_checkOcclusion(const Tile& tile, const FrameState& frameState) {
       }
     }
 
-    this->_childOcclusionProxies.clear();
-    this->_childOcclusionProxies.reserve(tile.getChildren().size());
+    state.childOcclusionProxies.clear();
+    state.childOcclusionProxies.reserve(tile.getChildren().size());
     for (const Tile& child : tile.getChildren()) {
       const TileOcclusionRendererProxy* pChildProxy =
           pOcclusionPool->fetchOcclusionProxyForTile(
@@ -1158,12 +2607,12 @@ Tileset::_checkOcclusion(const Tile& tile, const FrameState& frameState) {
         return TileOcclusionState::NotOccluded;
       }
 
-      this->_childOcclusionProxies.push_back(pChildProxy);
+      state.childOcclusionProxies.push_back(pChildProxy);
     }
 
     // Check if any of the proxies are known to be unoccluded
     for (const TileOcclusionRendererProxy* pChildProxy :
-         this->_childOcclusionProxies) {
+         state.childOcclusionProxies) {
       if (pChildProxy->getOcclusionState() == TileOcclusionState::NotOccluded) {
         return TileOcclusionState::NotOccluded;
       }
@@ -1171,7 +2620,7 @@ Tileset::_checkOcclusion(const Tile& tile, const FrameState& frameState) {
 
     // Check if any of the proxies are waiting for valid occlusion info.
     for (const TileOcclusionRendererProxy* pChildProxy :
-         this->_childOcclusionProxies) {
+         state.childOcclusionProxies) {
       if (pChildProxy->getOcclusionState() ==
           TileOcclusionState::OcclusionUnavailable) {
         // We have an occlusion proxy, but it does not have valid occlusion
@@ -1203,22 +2652,37 @@ Tileset::TraversalDetails Tileset::_visitTile(
     bool ancestorMeetsSse, // Careful: May be modified before being passed to
                            // children!
     Tile& tile,
+    uint32_t selectionIndex,
     double tilePriority,
-    ViewUpdateResult& result) {
+    double screenSpaceError,
+    TraversalState& state) {
+  ViewUpdateResult& result = state.result;
   ++result.tilesVisited;
   result.maxDepthVisited = glm::max(result.maxDepthVisited, depth);
 
+  // The properties of the tile and of its children are read from their
+  // entries in the selection data table, if they have them.
+  const TileSelectionDataTable* pTable = frameState.pSelectionData;
+  const TileSelectionData* pSelectionData =
+      getSelectionData(pTable, selectionIndex);
+  const size_t childCount =
+      pSelectionData ? pSelectionData->childCount : tile.getChildren().size();
+
   // If this is a leaf tile, just render it (it's already been deemed visible).
-  if (isLeaf(tile)) {
-    return _renderLeaf(frameState, tile, tilePriority, result);
+  if (childCount == 0) {
+    return _renderLeaf(frameState, tile, selectionIndex, tilePriority, state);
   }
 
-  const bool unconditionallyRefine = tile.getUnconditionallyRefine();
+  const TileRefine refine =
+      pSelectionData ? pSelectionData->refine : tile.getRefine();
+  const bool unconditionallyRefine =
+      pSelectionData ? pSelectionData->unconditionallyRefine
+                     : tile.getUnconditionallyRefine();
 
   bool wantToRefine = unconditionallyRefine || (!meetsSse && !ancestorMeetsSse);
 
   const TileSelectionState lastFrameSelectionState =
-      tile.getLastSelectionState();
+      getLastSelectionState(pTable, tile, selectionIndex);
   const TileSelectionState::Result lastFrameSelectionResult =
       lastFrameSelectionState.getResult(frameState.lastFrameNumber);
 
@@ -1233,8 +2697,14 @@ Tileset::TraversalDetails Tileset::_visitTile(
   bool tileLastRefined =
       lastFrameSelectionResult == TileSelectionState::Result::Refined;
   bool childLastRefined = false;
-  for (const Tile& child : tile.getChildren()) {
-    if (child.getLastSelectionState().getResult(frameState.lastFrameNumber) ==
+  for (size_t i = 0; i < childCount; ++i) {
+    const TileSelectionData* pChildData = getSelectionData(
+        pTable,
+        getChildSelectionIndex(pTable, selectionIndex, i));
+    const TileSelectionState childLastSelectionState =
+        pChildData ? pChildData->lastSelectionState
+                   : tile.getChildren()[i].getLastSelectionState();
+    if (childLastSelectionState.getResult(frameState.lastFrameNumber) ==
         TileSelectionState::Result::Refined) {
       childLastRefined = true;
       break;
@@ -1248,7 +2718,8 @@ Tileset::TraversalDetails Tileset::_visitTile(
                               (!tileLastRefined || !childLastRefined);
 
   if (shouldCheckOcclusion) {
-    TileOcclusionState occlusion = this->_checkOcclusion(tile, frameState);
+    TileOcclusionState occlusion =
+        this->_checkOcclusion(tile, frameState, state);
     if (occlusion == TileOcclusionState::Occluded) {
       ++result.tilesOccluded;
       wantToRefine = false;
@@ -1256,7 +2727,7 @@ Tileset::TraversalDetails Tileset::_visitTile(
     } else if (
         occlusion == TileOcclusionState::OcclusionUnavailable &&
         this->_options.delayRefinementForOcclusion &&
-        tile.getLastSelectionState().getOriginalResult(
+        lastFrameSelectionState.getOriginalResult(
             frameState.lastFrameNumber) !=
             TileSelectionState::Result::Refined) {
       ++result.tilesWaitingForOcclusionResults;
@@ -1282,14 +2753,19 @@ Tileset::TraversalDetails Tileset::_visitTile(
     // "kicked" in favor of an ancestor.
     const bool renderThisTile = shouldRenderThisTile(
         tile,
+        pSelectionData,
         lastFrameSelectionState,
         frameState.lastFrameNumber);
     if (renderThisTile) {
       // Only load this tile if it (not just an ancestor) meets the SSE.
       if (meetsSse && !ancestorMeetsSse) {
-        addTileToLoadQueue(tile, TileLoadPriorityGroup::Normal, tilePriority);
+        addTileToLoadQueue(
+            state,
+            tile,
+            TileLoadPriorityGroup::Normal,
+            tilePriority);
       }
-      return _renderInnerTile(frameState, tile, result);
+      return _renderInnerTile(frameState, tile, selectionIndex, state);
     }
 
     // Otherwise, we can't render this tile (or blank space where it would be)
@@ -1306,31 +2782,54 @@ Tileset::TraversalDetails Tileset::_visitTile(
     // Load this blocker tile with high priority, but only if this tile (not
     // just an ancestor) meets the SSE.
     if (meetsSse) {
-      addTileToLoadQueue(tile, TileLoadPriorityGroup::Urgent, tilePriority);
+      addTileToLoadQueue(
+          state,
+          tile,
+          TileLoadPriorityGroup::Urgent,
+          tilePriority);
       queuedForLoad = true;
     }
   }
 
   // Refine!
 
+  // When skipping levels of detail, only some of the refined tiles are loaded
+  // to stand in for their descendants, and the others are skipped.
+  const bool isPlaceholder = this->_isLevelOfDetailPlaceholder(
+      frameState,
+      tile,
+      selectionIndex,
+      depth,
+      screenSpaceError,
+      state);
+  const std::optional<PlaceholderAncestor> placeholderAncestor =
+      state.placeholderAncestor;
+  if (this->_options.enableSkipLevelOfDetail && isPlaceholder) {
+    state.placeholderAncestor = PlaceholderAncestor{screenSpaceError, depth};
+  }
+
   queuedForLoad = _loadAndRenderAdditiveRefinedTile(
                       tile,
-                      result,
+                      refine,
+                      state,
                       tilePriority,
                       queuedForLoad) ||
                   queuedForLoad;
 
   const size_t firstRenderedDescendantIndex =
       result.tilesToRenderThisFrame.size();
-  const size_t workerThreadLoadQueueIndex = this->_workerThreadLoadQueue.size();
-  const size_t mainThreadLoadQueueIndex = this->_mainThreadLoadQueue.size();
+  const size_t workerThreadLoadQueueIndex = state.workerThreadLoadQueue.size();
+  const size_t mainThreadLoadQueueIndex = state.mainThreadLoadQueue.size();
 
   TraversalDetails traversalDetails = this->_visitVisibleChildrenNearToFar(
       frameState,
       depth,
       ancestorMeetsSse,
       tile,
-      result);
+      selectionIndex,
+      state);
+
+  state.placeholderAncestor = placeholderAncestor;
 
   // Zero or more descendant tiles were added to the render list.
   // The traversalDetails tell us what happened while visiting the children.
@@ -1341,14 +2840,17 @@ Tileset::TraversalDetails Tileset::_visitTile(
                                      !traversalDetails.anyWereRenderedLastFrame;
 
   // Descendants may also be kicked if this tile was rendered last frame and
-  // has not finished fading in yet.
-  const TileRenderContent* pRenderContent =
-      tile.getContent().getRenderContent();
-  bool kickDueToTileFadingIn =
-      _options.enableLodTransitionPeriod &&
+  // has not finished fading in yet. Only then is its content needed.
+  bool kickDueToTileFadingIn = false;
+  if (_options.enableLodTransitionPeriod &&
       _options.kickDescendantsWhileFadingIn &&
-      lastFrameSelectionResult == TileSelectionState::Result::Rendered &&
-      pRenderContent && pRenderContent->getLodTransitionFadePercentage() < 1.0f;
+      lastFrameSelectionResult == TileSelectionState::Result::Rendered) {
+    const TileRenderContent* pRenderContent =
+        tile.getContent().getRenderContent();
+    kickDueToTileFadingIn =
+        pRenderContent &&
+        pRenderContent->getLodTransitionFadePercentage() < 1.0f;
+  }
 
   if (kickDueToNonReadyDescendant || kickDueToTileFadingIn) {
     // Kick all descendants out of the render list and render this tile instead
@@ -1356,112 +2858,932 @@ Tileset::TraversalDetails Tileset::_visitTile(
     queuedForLoad = _kickDescendantsAndRenderTile(
         frameState,
         tile,
-        result,
+        selectionIndex,
+        state,
         traversalDetails,
         firstRenderedDescendantIndex,
         workerThreadLoadQueueIndex,
         mainThreadLoadQueueIndex,
         queuedForLoad,
+        isPlaceholder,
         tilePriority);
   } else {
-    if (tile.getRefine() != TileRefine::Add) {
-      markTileNonRendered(frameState.lastFrameNumber, tile, result);
+    // The children were visited, which may have moved the entries, but the
+    // refinement doesn't change while visiting them.
+    if (refine != TileRefine::Add) {
+      markTileNonRendered(
+          frameState.lastFrameNumber,
+          frameState.pSelectionData,
+          tile,
+          selectionIndex,
+          result);
     }
-    tile.setLastSelectionState(TileSelectionState(
-        frameState.currentFrameNumber,
-        TileSelectionState::Result::Refined));
+    setLastSelectionState(
+        frameState.pSelectionData,
+        tile,
+        selectionIndex,
+        TileSelectionState(
+            frameState.currentFrameNumber,
+            TileSelectionState::Result::Refined));
   }
 
-  if (this->_options.preloadAncestors && !queuedForLoad) {
-    addTileToLoadQueue(tile, TileLoadPriorityGroup::Preload, tilePriority);
+  if (this->_options.preloadAncestors && isPlaceholder && !queuedForLoad) {
+    addTileToLoadQueue(
+        state,
+        tile,
+        TileLoadPriorityGroup::Preload,
+        tilePriority);
   }
 
   return traversalDetails;
 }
 
+bool Tileset::_isLevelOfDetailPlaceholder(
+    const FrameState& frameState,
+    const Tile& tile,
+    uint32_t selectionIndex,
+    uint32_t depth,
+    double screenSpaceError,
+    const TraversalState& state) const noexcept {
+  if (!this->_options.enableSkipLevelOfDetail) {
+    return true;
+  }
+
+  const TileSelectionData* pSelectionData =
+      getSelectionData(frameState.pSelectionData, selectionIndex);
+
+  // Unconditionally-refined tiles have nothing to show for their descendants.
+  if (pSelectionData ? pSelectionData->unconditionallyRefine
+                     : tile.getUnconditionallyRefine()) {
+    return false;
+  }
+
+  if (!state.placeholderAncestor ||
+      screenSpaceError > this->_options.baseScreenSpaceError) {
+    return true;
+  }
+
+  const PlaceholderAncestor& ancestor = *state.placeholderAncestor;
+  if (depth > ancestor.depth + this->_options.skipLevels &&
+      screenSpaceError * this->_options.skipScreenSpaceErrorFactor <=
+          ancestor.screenSpaceError) {
+    return true;
+  }
+
+  // A tile that is already loaded can stand in for its descendants for free.
+  return pSelectionData ? pSelectionData->renderable : tile.isRenderable();
+}
+
 Tileset::TraversalDetails Tileset::_visitVisibleChildrenNearToFar(
     const FrameState& frameState,
     uint32_t depth,
     bool ancestorMeetsSse,
     Tile& tile,
-    ViewUpdateResult& result) {
-  TraversalDetails traversalDetails;
-
+    uint32_t selectionIndex,
+    TraversalState& state) {
   // TODO: actually visit near-to-far, rather than in order of occurrence.
   gsl::span<Tile> children = tile.getChildren();
-  for (Tile& child : children) {
+
+  if (this->_options.enableParallelTraversal && !state.pVisitedTiles &&
+      depth + 1 >= this->_options.parallelTraversalDepth &&
+      children.size() > 1) {
+    return this->_visitChildrenInParallel(
+        frameState,
+        depth,
+        ancestorMeetsSse,
+        tile,
+        selectionIndex,
+        state);
+  }
+
+  TraversalDetails traversalDetails;
+
+  const TileSelectionDataTable* pTable = frameState.pSelectionData;
+  const PendingExclusion exclusion = state.exclusion;
+  std::vector<PendingExclusion>& childExclusions =
+      state.exclusionBuffers.childExclusions;
+  const size_t firstChildExclusion = childExclusions.size();
+  this->_classifyChildrenForExclusion(frameState, tile, selectionIndex, state);
+
+  for (size_t i = 0; i < children.size(); ++i) {
+    state.exclusion = childExclusions[firstChildExclusion + i];
+
     const TraversalDetails childTraversal = this->_visitTileIfNeeded(
         frameState,
         depth + 1,
         ancestorMeetsSse,
-        child,
-        result);
+        children[i],
+        getChildSelectionIndex(pTable, selectionIndex, i),
+        state);
+
+    traversalDetails.allAreRenderable &= childTraversal.allAreRenderable;
+    traversalDetails.anyWereRenderedLastFrame |=
+        childTraversal.anyWereRenderedLastFrame;
+    traversalDetails.notYetRenderableCount +=
+        childTraversal.notYetRenderableCount;
+  }
+
+  childExclusions.resize(firstChildExclusion);
+  state.exclusion = exclusion;
+
+  return traversalDetails;
+}
+
+bool Tileset::PendingExclusion::isSettled(
+    size_t excluderIndex) const noexcept {
+  return excluderIndex < 64 &&
+         (this->settledExcluders & (uint64_t(1) << excluderIndex)) != 0;
+}
+
+void Tileset::PendingExclusion::apply(
+    size_t excluderIndex,
+    TileExclusion exclusion) noexcept {
+  if (exclusion == TileExclusion::Excluded) {
+    this->excluded = true;
+  } else if (
+      exclusion == TileExclusion::SubtreeIncluded && excluderIndex < 64) {
+    this->settledExcluders |= uint64_t(1) << excluderIndex;
+  }
+}
+
+Tileset::PendingExclusion
+Tileset::_classifyTileForExclusion(const Tile& tile) const noexcept {
+  PendingExclusion exclusion{false, 0};
+  const std::vector<std::shared_ptr<ITileExcluder>>& excluders =
+      this->_options.excluders;
+  for (size_t i = 0; i < excluders.size(); ++i) {
+    exclusion.apply(i, excluders[i]->classify(tile));
+  }
+  return exclusion;
+}
+
+void Tileset::_classifyChildrenForExclusion(
+    const FrameState& frameState,
+    const Tile& tile,
+    uint32_t selectionIndex,
+    TraversalState& state) const {
+  ExclusionBuffers& buffers = state.exclusionBuffers;
+  const TileSelectionDataTable* pTable = frameState.pSelectionData;
+  gsl::span<const Tile> children = tile.getChildren();
+  const PendingExclusion& parentExclusion = state.exclusion;
+
+  // The children start out with the excluders that are settled for their
+  // parent, which are not asked about them.
+  const size_t first = buffers.childExclusions.size();
+  buffers.childExclusions.resize(
+      first + children.size(),
+      PendingExclusion{false, parentExclusion.settledExcluders});
+
+  const std::vector<std::shared_ptr<ITileExcluder>>& excluders =
+      this->_options.excluders;
+  bool haveBoundingSpheres = false;
+  for (size_t i = 0; i < excluders.size() && !children.empty(); ++i) {
+    if (parentExclusion.isSettled(i)) {
+      continue;
+    }
+
+    // The bounding spheres are only gathered once an excluder needs them.
+    if (!haveBoundingSpheres) {
+      buffers.childBoundingSpheres.clear();
+      for (size_t j = 0; j < children.size(); ++j) {
+        const uint32_t childIndex =
+            getChildSelectionIndex(pTable, selectionIndex, j);
+        buffers.childBoundingSpheres.emplace_back(
+            childIndex != TileSelectionDataTable::InvalidIndex
+                ? pTable->getEnclosingSphere(childIndex)
+                : computeEnclosingSphere(children[j].getBoundingVolume()));
+      }
+      haveBoundingSpheres = true;
+    }
+
+    buffers.childResults.assign(children.size(), TileExclusion::Included);
+    excluders[i]->classifyChildren(
+        tile,
+        buffers.childBoundingSpheres,
+        buffers.childResults);
+
+    for (size_t j = 0; j < children.size(); ++j) {
+      buffers.childExclusions[first + j].apply(i, buffers.childResults[j]);
+    }
+  }
+}
 
+/**
+ * @brief The traversal of a single subtree, run as a parallel work unit.
+ *
+ * The {@link TraversalState} refers to the unit's own members, so instances
+ * must not be moved after construction.
+ */
+struct Tileset::ParallelTraversalUnit {
+  ParallelTraversalUnit(Tile& tile, uint32_t selectionIndex_)
+      : pTile(&tile),
+        selectionIndex(selectionIndex_),
+        result(),
+        workerThreadLoadQueue(),
+        mainThreadLoadQueue(),
+        distances(),
+        childOcclusionProxies(),
+        exclusionBuffers(),
+        visitedTiles(),
+        state{
+            result,
+            workerThreadLoadQueue,
+            mainThreadLoadQueue,
+            distances,
+            childOcclusionProxies,
+            exclusionBuffers,
+            &visitedTiles,
+            std::nullopt,
+            PendingExclusion{false, 0}},
+        details(),
+        pException() {}
+
+  Tile* pTile;
+  uint32_t selectionIndex;
+  ViewUpdateResult result;
+  std::vector<TileLoadTask> workerThreadLoadQueue;
+  std::vector<TileLoadTask> mainThreadLoadQueue;
+  std::vector<double> distances;
+  std::vector<const TileOcclusionRendererProxy*> childOcclusionProxies;
+  ExclusionBuffers exclusionBuffers;
+  std::vector<Tile*> visitedTiles;
+  TraversalState state;
+  TraversalDetails details;
+  std::exception_ptr pException;
+};
+
+namespace {
+template <typename TUnit> struct ParallelTraversalWork {
+  std::vector<std::unique_ptr<TUnit>> units;
+  std::atomic<size_t> nextUnit{0};
+
+  void completeUnit() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (++this->completedUnits == this->units.size()) {
+      this->allCompleted.notify_all();
+    }
+  }
+
+  // The calling thread must have claimed units until none were left, so that
+  // the wait never depends on a worker task that the task processor has not
+  // started, or has dropped.
+  void waitForAllUnits() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->allCompleted.wait(lock, [this]() {
+      return this->completedUnits == this->units.size();
+    });
+  }
+
+private:
+  std::mutex mutex;
+  std::condition_variable allCompleted;
+  size_t completedUnits = 0;
+};
+} // namespace
+
+Tileset::TraversalDetails Tileset::_visitChildrenInParallel(
+    const FrameState& frameState,
+    uint32_t depth,
+    bool ancestorMeetsSse,
+    Tile& tile,
+    uint32_t selectionIndex,
+    TraversalState& state) {
+  CESIUM_TRACE("Tileset::_visitChildrenInParallel");
+
+  using Work = ParallelTraversalWork<ParallelTraversalUnit>;
+  auto pWork = std::make_shared<Work>();
+
+  gsl::span<Tile> children = tile.getChildren();
+
+  // The children are tested with the excluders here, so that each unit
+  // starts with the exclusion of its child.
+  std::vector<PendingExclusion>& childExclusions =
+      state.exclusionBuffers.childExclusions;
+  const size_t firstChildExclusion = childExclusions.size();
+  this->_classifyChildrenForExclusion(frameState, tile, selectionIndex, state);
+
+  const TileSelectionDataTable* pTable = frameState.pSelectionData;
+  pWork->units.reserve(children.size());
+  for (size_t i = 0; i < children.size(); ++i) {
+    pWork->units.emplace_back(std::make_unique<ParallelTraversalUnit>(
+        children[i],
+        getChildSelectionIndex(pTable, selectionIndex, i)));
+    TraversalState& unitState = pWork->units.back()->state;
+    unitState.placeholderAncestor = state.placeholderAncestor;
+    unitState.exclusion = childExclusions[firstChildExclusion + i];
+  }
+  childExclusions.resize(firstChildExclusion);
+
+  // Units are claimed by whichever thread gets to them first, including this
+  // one. So if the worker threads are busy, the main thread simply ends up
+  // doing all the work itself rather than waiting for them.
+  auto runUnits = [this, pWork, &frameState, depth, ancestorMeetsSse]() {
+    size_t index;
+    while ((index = pWork->nextUnit++) < pWork->units.size()) {
+      ParallelTraversalUnit& unit = *pWork->units[index];
+      try {
+        unit.details = this->_visitTileIfNeeded(
+            frameState,
+            depth + 1,
+            ancestorMeetsSse,
+            *unit.pTile,
+            unit.selectionIndex,
+            unit.state);
+      } catch (...) {
+        unit.pException = std::current_exception();
+      }
+      pWork->completeUnit();
+    }
+  };
+
+  for (size_t i = 1; i < pWork->units.size(); ++i) {
+    this->_asyncSystem.runInWorkerThread([runUnits]() { runUnits(); });
+  }
+
+  runUnits();
+
+  // Block until the units claimed by worker threads finish.
+  pWork->waitForAllUnits();
+
+  // Merge the results in traversal order, so that the outcome is the same as
+  // that of a sequential traversal.
+  ViewUpdateResult& result = state.result;
+  TraversalDetails traversalDetails;
+
+  for (const std::unique_ptr<ParallelTraversalUnit>& pUnit : pWork->units) {
+    if (pUnit->pException) {
+      std::rethrow_exception(pUnit->pException);
+    }
+
+    const TraversalDetails& childTraversal = pUnit->details;
     traversalDetails.allAreRenderable &= childTraversal.allAreRenderable;
     traversalDetails.anyWereRenderedLastFrame |=
         childTraversal.anyWereRenderedLastFrame;
     traversalDetails.notYetRenderableCount +=
         childTraversal.notYetRenderableCount;
+
+    const ViewUpdateResult& unitResult = pUnit->result;
+    result.tilesToRenderThisFrame.insert(
+        result.tilesToRenderThisFrame.end(),
+        unitResult.tilesToRenderThisFrame.begin(),
+        unitResult.tilesToRenderThisFrame.end());
+    result.tilesFadingOut.insert(
+        result.tilesFadingOut.end(),
+        unitResult.tilesFadingOut.begin(),
+        unitResult.tilesFadingOut.end());
+    result.tilesVisited += unitResult.tilesVisited;
+    result.culledTilesVisited += unitResult.culledTilesVisited;
+    result.tilesCulled += unitResult.tilesCulled;
+    result.tilesOccluded += unitResult.tilesOccluded;
+    result.tilesWaitingForOcclusionResults +=
+        unitResult.tilesWaitingForOcclusionResults;
+    result.tilesKicked += unitResult.tilesKicked;
+    result.maxDepthVisited =
+        glm::max(result.maxDepthVisited, unitResult.maxDepthVisited);
+
+    state.workerThreadLoadQueue.insert(
+        state.workerThreadLoadQueue.end(),
+        pUnit->workerThreadLoadQueue.begin(),
+        pUnit->workerThreadLoadQueue.end());
+    state.mainThreadLoadQueue.insert(
+        state.mainThreadLoadQueue.end(),
+        pUnit->mainThreadLoadQueue.begin(),
+        pUnit->mainThreadLoadQueue.end());
+
+    // The units selected these tiles from the content state they had before
+    // this update, and they were marked visited only now, so both lag one
+    // frame behind a sequential traversal. They are caught up here, in
+    // traversal order, for the next frame.
+    for (Tile* pVisited : pUnit->visitedTiles) {
+      this->_pTilesetContentManager->updateTileContent(*pVisited, _options);
+      this->_markTileVisited(*pVisited);
+    }
   }
 
   return traversalDetails;
 }
 
+namespace {
+struct LoadedTilesTask {
+  gsl::span<Tile* const> tiles;
+  std::exception_ptr pException;
+};
+} // namespace
+
+void Tileset::_forEachLoadedTileRangeInParallel(
+    const std::function<void(gsl::span<Tile* const>)>& callback,
+    size_t minimumTilesPerTask) {
+  CESIUM_TRACE("Tileset::forEachLoadedTileInParallel");
+
+  std::vector<Tile*>& tiles = this->_loadedTilesForParallelVisit;
+  tiles.clear();
+  for (Tile* pTile = this->_loadedTiles.head(); pTile;
+       pTile = this->_loadedTiles.next(*pTile)) {
+    tiles.emplace_back(pTile);
+  }
+
+  // Split the tiles into about as many tasks as there are threads, unless
+  // that would make the tasks smaller than the minimum.
+  const size_t threadCount =
+      std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+  const size_t tilesPerTask = std::max(
+      std::max(minimumTilesPerTask, size_t(1)),
+      (tiles.size() + threadCount - 1) / threadCount);
+  if (tiles.size() <= tilesPerTask) {
+    callback(tiles);
+    return;
+  }
+
+  using Work = ParallelTraversalWork<LoadedTilesTask>;
+  auto pWork = std::make_shared<Work>();
+
+  const gsl::span<Tile* const> allTiles(tiles);
+  for (size_t first = 0; first < allTiles.size(); first += tilesPerTask) {
+    pWork->units.emplace_back(std::make_unique<LoadedTilesTask>());
+    pWork->units.back()->tiles = allTiles.subspan(
+        first,
+        std::min(tilesPerTask, allTiles.size() - first));
+  }
+
+  // As in the parallel traversal, the tasks are claimed by whichever thread
+  // gets to them first, including this one.
+  auto runTasks = [pWork, &callback]() {
+    size_t index;
+    while ((index = pWork->nextUnit++) < pWork->units.size()) {
+      LoadedTilesTask& task = *pWork->units[index];
+      try {
+        callback(task.tiles);
+      } catch (...) {
+        task.pException = std::current_exception();
+      }
+      pWork->completeUnit();
+    }
+  };
+
+  for (size_t i = 1; i < pWork->units.size(); ++i) {
+    this->_asyncSystem.runInWorkerThread([runTasks]() { runTasks(); });
+  }
+
+  runTasks();
+
+  pWork->waitForAllUnits();
+
+  for (const std::unique_ptr<LoadedTilesTask>& pTask : pWork->units) {
+    if (pTask->pException) {
+      std::rethrow_exception(pTask->pException);
+    }
+  }
+}
+
+void Tileset::_visitPredictedTile(
+    const std::vector<ViewState>& predictedFrustums,
+    Tile& tile) {
+  const BoundingVolume& boundingVolume = tile.getBoundingVolume();
+  if (std::none_of(
+          predictedFrustums.begin(),
+          predictedFrustums.end(),
+          [&boundingVolume](const ViewState& frustum) {
+            return frustum.isBoundingVolumeVisible(boundingVolume);
+          })) {
+    return;
+  }
+
+  for (const std::shared_ptr<ITileExcluder>& pExcluder :
+       this->_options.excluders) {
+    if (pExcluder->shouldExclude(tile)) {
+      return;
+    }
+  }
+
+  double largestSse = 0.0;
+  double nearestDistance = std::numeric_limits<double>::max();
+  for (const ViewState& frustum : predictedFrustums) {
+    const double distance = glm::sqrt(glm::max(
+        frustum.computeDistanceSquaredToBoundingVolume(boundingVolume),
+        0.0));
+    largestSse = glm::max(
+        largestSse,
+        frustum.computeScreenSpaceError(tile.getGeometricError(), distance));
+    nearestDistance = glm::min(nearestDistance, distance);
+  }
+
+  const bool meetsSse = largestSse < this->_maximumScreenSpaceError;
+  const bool isLeaf = meetsSse || tile.getChildren().empty();
+
+  if (tile.getState() == TileLoadState::ContentLoading) {
+    this->_predictedTilesLoading.push_back(&tile);
+  }
+
+  // Replace-refined tiles are only rendered at the leaves of the predicted
+  // selection, but additive-refined ones are rendered all the way down.
+  if ((isLeaf || tile.getRefine() == TileRefine::Add) &&
+      this->_pTilesetContentManager->tileNeedsWorkerThreadLoading(tile)) {
+    this->_prefetchLoadQueue.push_back(
+        {&tile, TileLoadPriorityGroup::Preload, nearestDistance});
+  }
+
+  // Keep the tiles needed by the predicted views from being unloaded this
+  // frame. The root tile must stay where the traversal put it, because it
+  // marks the beginning of the tiles used this frame.
+  if (&tile != this->getRootTile()) {
+    this->_markTileVisited(tile);
+  }
+
+  if (!isLeaf) {
+    for (Tile& child : tile.getChildren()) {
+      this->_visitPredictedTile(predictedFrustums, child);
+    }
+  }
+}
+
+namespace {
+// The limit of a concurrency limiter, if there is one, or else the fixed
+// limit.
+int32_t getConcurrencyLimit(
+    const std::shared_ptr<AdaptiveConcurrencyLimiter>& pLimiter,
+    uint32_t fixedLimit) noexcept {
+  return pLimiter ? pLimiter->getLimit() : static_cast<int32_t>(fixedLimit);
+}
+} // namespace
+
 void Tileset::_processWorkerThreadLoadQueue() {
   CESIUM_TRACE("Tileset::_processWorkerThreadLoadQueue");
 
-  int32_t maximumSimultaneousTileLoads =
-      static_cast<int32_t>(this->_options.maximumSimultaneousTileLoads);
+  ViewUpdateResult& result = this->_updateResult;
+  int32_t maximumSimultaneousTileLoads = getConcurrencyLimit(
+      this->_options.pTileLoadConcurrencyLimiter,
+      this->_options.maximumSimultaneousTileLoads);
+  result.maximumSimultaneousTileLoads = maximumSimultaneousTileLoads;
+
+  // The bytes of a response are only known once it has been downloaded, so
+  // the limiter goes into debt, and no loads start until it is repaid.
+  result.tileLoadsThrottledByBandwidth = 0;
+  result.bandwidthThrottledBytes = 0;
+  bool bandwidthExhausted = false;
+  const BandwidthLimiter* pLimiter = this->_externals.pBandwidthLimiter.get();
+  if (pLimiter) {
+    const int64_t availableBytes = pLimiter->getAvailableBytes();
+    bandwidthExhausted = availableBytes <= 0;
+    if (bandwidthExhausted) {
+      this->_bandwidthRecovering = true;
+      result.bandwidthThrottledBytes = -availableBytes;
+    } else if (availableBytes >= pLimiter->getBurstBytes()) {
+      this->_bandwidthRecovering = false;
+    }
+  } else {
+    this->_bandwidthRecovering = false;
+  }
 
-  if (this->_pTilesetContentManager->getNumberOfTilesLoading() >=
-      maximumSimultaneousTileLoads) {
+  const bool atLoadLimit =
+      this->_pTilesetContentManager->getNumberOfTilesLoading() >=
+      maximumSimultaneousTileLoads;
+  size_t allowedLoads =
+      this->_requestLoadSlots(atLoadLimit || bandwidthExhausted);
+  if (!atLoadLimit && bandwidthExhausted) {
+    result.tileLoadsThrottledByBandwidth =
+        static_cast<int32_t>(this->_workerThreadLoadQueue.size());
+  }
+  if (atLoadLimit || bandwidthExhausted || allowedLoads == 0) {
     return;
   }
 
+  // Usually only a few of the queued tiles can start loading, so instead of
+  // sorting the whole queue, arrange it into a heap and pop tasks from it in
+  // priority order until enough loads are in flight. Each tile is visited at
+  // most once per frame, even with multiple frustums, so the queue holds no
+  // duplicates.
   std::vector<TileLoadTask>& queue = this->_workerThreadLoadQueue;
-  std::sort(queue.begin(), queue.end());
+  const bool preferLowerDetail =
+      this->_bandwidthRecovering &&
+      this->_options.preferLowerDetailWhenBandwidthLimited;
+  auto loadsLater = [preferLowerDetail](
+                        const TileLoadTask& lhs,
+                        const TileLoadTask& rhs) {
+    if (preferLowerDetail && lhs.group == rhs.group) {
+      const double lhsError = lhs.pTile->getGeometricError();
+      const double rhsError = rhs.pTile->getGeometricError();
+      if (lhsError != rhsError) {
+        return lhsError < rhsError;
+      }
+    }
+    return rhs < lhs;
+  };
+  std::make_heap(queue.begin(), queue.end(), loadsLater);
+
+  // While over the GPU budget, only start the urgent loads, which replace
+  // detail that is being rendered in their place and let it be unloaded.
+  const bool overGpuBudget = this->_isOverGpuBudget();
+
+  auto heapEnd = queue.end();
+  while (heapEnd != queue.begin()) {
+    std::pop_heap(queue.begin(), heapEnd, loadsLater);
+    --heapEnd;
+
+    if (overGpuBudget && heapEnd->group != TileLoadPriorityGroup::Urgent) {
+      break;
+    }
 
-  for (TileLoadTask& task : queue) {
-    this->_pTilesetContentManager->loadTileContent(*task.pTile, _options);
+    this->_pTilesetContentManager->loadTileContent(
+        *heapEnd->pTile,
+        _options,
+        {static_cast<int32_t>(heapEnd->group), heapEnd->priority});
+    this->_trackTileLoad(*heapEnd->pTile);
     if (this->_pTilesetContentManager->getNumberOfTilesLoading() >=
-        maximumSimultaneousTileLoads) {
+            maximumSimultaneousTileLoads ||
+        --allowedLoads == 0) {
       break;
     }
   }
+
+  this->_notifyTilesLoading();
+}
+
+size_t Tileset::_requestLoadSlots(bool atLoadLimit) {
+  const std::vector<TileLoadTask>& queue = this->_workerThreadLoadQueue;
+  TileLoadScheduler* pScheduler = this->_externals.pTileLoadScheduler.get();
+  if (!pScheduler) {
+    return queue.size();
+  }
+
+  // A tileset at its own load limit can't start any loads, so it reports none
+  // and does not hold up the other tilesets.
+  this->_loadPriorities.clear();
+  if (!atLoadLimit) {
+    for (const TileLoadTask& task : queue) {
+      this->_loadPriorities.push_back({task.group, task.priority});
+    }
+  }
+
+  return pScheduler->requestLoadSlots(
+      this->_tileLoadSchedulerID,
+      this->_loadPriorities,
+      static_cast<uint32_t>(
+          this->_pTilesetContentManager->getNumberOfTilesLoading()),
+      this->getTotalDataBytes());
 }
+
+void Tileset::_notifyTilesLoading() noexcept {
+  TileLoadScheduler* pScheduler = this->_externals.pTileLoadScheduler.get();
+  if (pScheduler) {
+    pScheduler->notifyTilesLoading(
+        this->_tileLoadSchedulerID,
+        static_cast<uint32_t>(
+            this->_pTilesetContentManager->getNumberOfTilesLoading()));
+  }
+}
+
+void Tileset::_processPrefetchLoadQueue() {
+  CESIUM_TRACE("Tileset::_processPrefetchLoadQueue");
+
+  int32_t maximumSimultaneousPrefetchLoads = glm::min(
+      static_cast<int32_t>(this->_options.maximumSimultaneousPrefetchLoads),
+      getConcurrencyLimit(
+          this->_options.pTileLoadConcurrencyLimiter,
+          this->_options.maximumSimultaneousTileLoads));
+
+  std::vector<TileLoadTask>& queue = this->_prefetchLoadQueue;
+  auto loadsLater = [](const TileLoadTask& lhs, const TileLoadTask& rhs) {
+    return rhs < lhs;
+  };
+  std::make_heap(queue.begin(), queue.end(), loadsLater);
+
+  const TileLoadScheduler* pScheduler =
+      this->_externals.pTileLoadScheduler.get();
+
+  auto heapEnd = queue.end();
+  while (heapEnd != queue.begin()) {
+    if (this->_pTilesetContentManager->getNumberOfTilesLoading() >=
+            maximumSimultaneousPrefetchLoads ||
+        this->getTotalDataBytes() >= this->_options.maximumCachedBytes ||
+        this->_isOverGpuBudget() || this->_bandwidthRecovering ||
+        (pScheduler && !pScheduler->canStartLowPriorityLoad())) {
+      break;
+    }
+
+    std::pop_heap(queue.begin(), heapEnd, loadsLater);
+    --heapEnd;
+
+    // The tile may have started loading for the current views already.
+    Tile& tile = *heapEnd->pTile;
+    if (this->_pTilesetContentManager->tileNeedsWorkerThreadLoading(tile)) {
+      this->_pTilesetContentManager->loadTileContent(
+          tile,
+          _options,
+          {static_cast<int32_t>(heapEnd->group), heapEnd->priority});
+      this->_trackTileLoad(tile);
+    }
+  }
+
+  this->_notifyTilesLoading();
+}
+
+void Tileset::_fetchChildrenAhead(const FrameState& frameState) {
+  CESIUM_TRACE("Tileset::_fetchChildrenAhead");
+
+  ViewUpdateResult& result = this->_updateResult;
+  const int32_t maximumFetches = getConcurrencyLimit(
+      this->_options.pSubtreeLoadConcurrencyLimiter,
+      this->_options.maximumSimultaneousSubtreeLoads);
+  result.maximumSimultaneousSubtreeLoads = maximumFetches;
+  if (!this->_options.enableSpeculativeFetch || this->_bandwidthRecovering) {
+    result.speculativeFetchesInProgress =
+        this->_pTilesetContentManager->getNumberOfTileChildrenFetches();
+    return;
+  }
+
+  // The rendered tiles that are closest to being refined go first. Their
+  // children are known, but those children's own children may be in an
+  // external tileset or a subtree that has to be fetched before anything
+  // below them can load.
+  std::vector<TileLoadTask>& queue = this->_childrenFetchQueue;
+  queue.clear();
+  const double minimumScreenSpaceError =
+      frameState.maximumScreenSpaceError *
+      this->_options.speculativeFetchScreenSpaceErrorRatio;
+  std::vector<double>& distances = this->_distances;
+  for (Tile* pTile : result.tilesToRenderThisFrame) {
+    if (pTile->getChildren().empty()) {
+      continue;
+    }
+
+    const TileSelectionData* pSelectionData =
+        frameState.pSelectionData ? frameState.pSelectionData->find(*pTile)
+                                  : nullptr;
+    computeDistances(
+        pTile->getBoundingVolume(),
+        frameState.frustums,
+        distances);
+    const double screenSpaceError = this->_computeScreenSpaceError(
+        frameState,
+        pSelectionData ? pSelectionData->geometricError
+                       : pTile->getGeometricError(),
+        distances);
+    if (screenSpaceError >= minimumScreenSpaceError) {
+      queue.push_back(
+          {pTile, TileLoadPriorityGroup::Preload, -screenSpaceError});
+    }
+  }
+
+  std::sort(queue.begin(), queue.end());
+
+  TilesetContentManager& contentManager = *this->_pTilesetContentManager;
+  for (const TileLoadTask& task : queue) {
+    for (Tile& child : task.pTile->getChildren()) {
+      if (contentManager.getNumberOfTileChildrenFetches() >= maximumFetches) {
+        break;
+      }
+      contentManager.fetchTileChildrenAhead(child, this->_options);
+    }
+  }
+
+  result.speculativeFetchesInProgress =
+      contentManager.getNumberOfTileChildrenFetches();
+}
+
+void Tileset::_trackTileLoad(Tile& tile) {
+  if (this->_options.enableTileLoadCancellation &&
+      tile.getState() == TileLoadState::ContentLoading) {
+    this->_tileLoadsInProgress.push_back(
+        {&tile, this->_updateResult.frameNumber});
+  }
+}
+
+void Tileset::_cancelUnneededTileLoads() {
+  CESIUM_TRACE("Tileset::_cancelUnneededTileLoads");
+
+  const int32_t currentFrameNumber = this->_updateResult.frameNumber;
+  // Every view session's traversal takes a frame number, so a load is
+  // canceled once no session has needed it for that many of its own frames.
+  const int32_t frameCount =
+      static_cast<int32_t>(this->_options.tileLoadCancellationFrameCount) *
+      static_cast<int32_t>(this->_viewSessions.size() + 1);
+
+  std::vector<TileLoadInProgress>& loads = this->_tileLoadsInProgress;
+  auto it = loads.begin();
+  while (it != loads.end()) {
+    Tile& tile = *it->pTile;
+
+    // Tiles that are visited by the traversal, even if culled, are tagged
+    // with the current frame number.
+    const bool needed =
+        tile.getLastSelectionState().getFrameNumber() == currentFrameNumber ||
+        std::find(
+            this->_predictedTilesLoading.begin(),
+            this->_predictedTilesLoading.end(),
+            &tile) != this->_predictedTilesLoading.end();
+    if (needed) {
+      it->lastFrameNeeded = currentFrameNumber;
+    }
+
+    if (tile.getState() != TileLoadState::ContentLoading ||
+        !this->_options.enableTileLoadCancellation) {
+      it = loads.erase(it);
+    } else if (currentFrameNumber - it->lastFrameNeeded >= frameCount) {
+      this->_pTilesetContentManager->cancelTileContentLoad(tile);
+      it = loads.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void Tileset::_processMainThreadLoadQueue() {
   CESIUM_TRACE("Tileset::_processMainThreadLoadQueue");
-  // Process deferred main-thread load tasks with a time budget.
+  // Process deferred main-thread load tasks with a time budget. As with the
+  // worker thread queue, pop tasks from a heap rather than sorting them all,
+  // because the budget usually runs out before the queue does.
+
+  std::vector<TileLoadTask>& queue = this->_mainThreadLoadQueue;
+  const double timeBudget = this->_options.mainThreadLoadingTimeLimit;
+  const int64_t byteBudget = this->_options.mainThreadLoadingByteLimit;
+
+  // Without a budget, the order doesn't matter, so the renderer can prepare
+  // all of the tiles at once.
+  if (this->_options.batchRendererResourceCalls && timeBudget <= 0.0 &&
+      byteBudget <= 0) {
+    std::vector<Tile*> tiles;
+    tiles.reserve(queue.size());
+    for (const TileLoadTask& task : queue) {
+      tiles.emplace_back(task.pTile);
+    }
+    std::sort(tiles.begin(), tiles.end());
+    tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
 
-  std::sort(
-      this->_mainThreadLoadQueue.begin(),
-      this->_mainThreadLoadQueue.end());
+    this->_pTilesetContentManager->finishLoading(tiles, this->_options);
+    queue.clear();
+    return;
+  }
 
-  double timeBudget = this->_options.mainThreadLoadingTimeLimit;
+  auto loadsLater = [](const TileLoadTask& lhs, const TileLoadTask& rhs) {
+    return rhs < lhs;
+  };
+  std::make_heap(queue.begin(), queue.end(), loadsLater);
+
+  // The budget is also handed to the renderer, which may stop partway
+  // through a heavy tile and resume it in a later frame.
+  MainThreadLoadBudget budget;
+  if (timeBudget > 0.0) {
+    budget.milliseconds = timeBudget;
+  }
+  if (byteBudget > 0) {
+    budget.bytes = byteBudget;
+  }
+
+  auto heapEnd = queue.end();
+  while (heapEnd != queue.begin()) {
+    std::pop_heap(queue.begin(), heapEnd, loadsLater);
+    --heapEnd;
+
+    TileLoadTask& task = *heapEnd;
 
-  auto start = std::chrono::system_clock::now();
-  auto end =
-      start + std::chrono::milliseconds(static_cast<long long>(timeBudget));
-  for (TileLoadTask& task : this->_mainThreadLoadQueue) {
     // We double-check that the tile is still in the ContentLoaded state here,
     // in case something (such as a child that needs to upsample from this
     // parent) already pushed the tile into the Done state. Because in that
     // case, calling finishLoading here would assert or crash.
     if (task.pTile->getState() == TileLoadState::ContentLoaded &&
         task.pTile->isRenderContent()) {
-      this->_pTilesetContentManager->finishLoading(*task.pTile, this->_options);
+      this->_pTilesetContentManager->finishLoading(
+          *task.pTile,
+          this->_options,
+          budget);
     }
-    auto time = std::chrono::system_clock::now();
-    if (timeBudget > 0.0 && time >= end) {
+
+    if (budget.milliseconds <= 0.0 || budget.bytes <= 0) {
       break;
     }
   }
 
-  this->_mainThreadLoadQueue.clear();
+  queue.clear();
+}
+
+bool Tileset::_isOverCacheBudget() const noexcept {
+  return this->getTotalDataBytes() > this->_options.maximumCachedBytes ||
+         this->_isOverGpuBudget();
+}
+
+bool Tileset::_isOverGpuBudget() const noexcept {
+  return this->getTotalGpuBytes() > this->_options.maximumGpuBytes;
 }
 
 void Tileset::_unloadCachedTiles(double timeBudget) noexcept {
-  const int64_t maxBytes = this->getOptions().maximumCachedBytes;
+  // The renderer may free the resources of all the unloaded tiles at once.
+  const bool batchFrees = this->_options.batchRendererResourceCalls;
+  if (batchFrees) {
+    this->_pTilesetContentManager->beginBatchingFrees();
+  }
+
+  if (this->_options.evictionPolicy) {
+    this->_unloadCachedTilesByPolicy(timeBudget);
+  } else {
+    this->_unloadLeastRecentlyUsedTiles(timeBudget);
+  }
+
+  if (batchFrees) {
+    this->_pTilesetContentManager->endBatchingFrees();
+  }
+}
+
+void Tileset::_unloadLeastRecentlyUsedTiles(double timeBudget) noexcept {
 
   const Tile* pRootTile = this->_pTilesetContentManager->getRootTile();
   Tile* pTile = this->_loadedTiles.head();
@@ -1474,7 +3796,7 @@ void Tileset::_unloadCachedTiles(double timeBudget) noexcept {
                  : (start + std::chrono::milliseconds(
                                 static_cast<long long>(timeBudget)));
 
-  while (this->getTotalDataBytes() > maxBytes) {
+  while (this->_isOverCacheBudget()) {
     if (pTile == nullptr || pTile == pRootTile) {
       // We've either removed all tiles or the next tile is the root.
       // The root tile marks the beginning of the tiles that were used
@@ -1482,9 +3804,9 @@ void Tileset::_unloadCachedTiles(double timeBudget) noexcept {
       break;
     }
 
-    // Don't unload this tile if it is still fading out.
-    if (_updateResult.tilesFadingOut.find(pTile) !=
-        _updateResult.tilesFadingOut.end()) {
+    // Don't unload this tile if it may still be shown.
+    if (mayBeShown(this->_updateResult, pTile) ||
+        this->_isHeldByViewSession(pTile)) {
       pTile = this->_loadedTiles.next(*pTile);
       continue;
     }
@@ -1506,45 +3828,123 @@ void Tileset::_unloadCachedTiles(double timeBudget) noexcept {
   }
 }
 
+void Tileset::_unloadCachedTilesByPolicy(double timeBudget) noexcept {
+  if (!this->_isOverCacheBudget()) {
+    return;
+  }
+
+  ITileEvictionPolicy& policy = *this->_options.evictionPolicy;
+
+  auto start = std::chrono::system_clock::now();
+  auto end = (timeBudget <= 0.0)
+                 ? std::chrono::time_point<std::chrono::system_clock>::max()
+                 : (start + std::chrono::milliseconds(
+                                static_cast<long long>(timeBudget)));
+
+  // The candidates are the tiles that were not used last frame, in
+  // least-recently-used order, which breaks ties between equal scores.
+  struct EvictionCandidate {
+    Tile* pTile;
+    double score;
+  };
+
+  std::vector<EvictionCandidate> candidates;
+  const Tile* pRootTile = this->_pTilesetContentManager->getRootTile();
+  for (Tile* pTile = this->_loadedTiles.head();
+       pTile != nullptr && pTile != pRootTile;
+       pTile = this->_loadedTiles.next(*pTile)) {
+    // Don't unload this tile if it may still be shown.
+    if (mayBeShown(this->_updateResult, pTile) ||
+        this->_isHeldByViewSession(pTile)) {
+      continue;
+    }
+
+    candidates.push_back({pTile, policy.computeRetentionScore(*pTile)});
+  }
+
+  std::stable_sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const EvictionCandidate& lhs, const EvictionCandidate& rhs) {
+        return lhs.score < rhs.score;
+      });
+
+  for (const EvictionCandidate& candidate : candidates) {
+    if (!this->_isOverCacheBudget()) {
+      break;
+    }
+
+    const bool removed =
+        this->_pTilesetContentManager->unloadTileContent(*candidate.pTile);
+    if (removed) {
+      this->_loadedTiles.remove(*candidate.pTile);
+      policy.notifyTileUnloaded(*candidate.pTile);
+    }
+
+    auto time = std::chrono::system_clock::now();
+    if (time >= end) {
+      break;
+    }
+  }
+}
+
 void Tileset::_markTileVisited(Tile& tile) noexcept {
   this->_loadedTiles.insertAtTail(tile);
+
+  if (!this->_viewSessions.empty()) {
+    this->_viewSessionVisitedTiles.emplace_back(&tile);
+  }
+
+  if (this->_options.evictionPolicy) {
+    this->_options.evictionPolicy->notifyTileVisited(tile);
+  }
 }
 
 void Tileset::addTileToLoadQueue(
+    TraversalState& state,
     Tile& tile,
     TileLoadPriorityGroup priorityGroup,
     double priority) {
   // Assert that this tile hasn't been added to a queue already.
   assert(
       std::find_if(
-          this->_workerThreadLoadQueue.begin(),
-          this->_workerThreadLoadQueue.end(),
+          state.workerThreadLoadQueue.begin(),
+          state.workerThreadLoadQueue.end(),
           [&](const TileLoadTask& task) { return task.pTile == &tile; }) ==
-      this->_workerThreadLoadQueue.end());
+      state.workerThreadLoadQueue.end());
   assert(
       std::find_if(
-          this->_mainThreadLoadQueue.begin(),
-          this->_mainThreadLoadQueue.end(),
+          state.mainThreadLoadQueue.begin(),
+          state.mainThreadLoadQueue.end(),
           [&](const TileLoadTask& task) { return task.pTile == &tile; }) ==
-      this->_mainThreadLoadQueue.end());
+      state.mainThreadLoadQueue.end());
 
   if (this->_pTilesetContentManager->tileNeedsWorkerThreadLoading(tile)) {
-    this->_workerThreadLoadQueue.push_back({&tile, priorityGroup, priority});
+    state.workerThreadLoadQueue.push_back({&tile, priorityGroup, priority});
+    if (this->_options.enableTileLoadTimelines) {
+      this->_pTilesetContentManager->recordTileQueuedForLoad(tile);
+    }
   } else if (this->_pTilesetContentManager->tileNeedsMainThreadLoading(tile)) {
-    this->_mainThreadLoadQueue.push_back({&tile, priorityGroup, priority});
+    state.mainThreadLoadQueue.push_back({&tile, priorityGroup, priority});
   }
 }
 
 Tileset::TraversalDetails Tileset::createTraversalDetailsForSingleTile(
     const FrameState& frameState,
     const Tile& tile,
+    uint32_t selectionIndex,
     const TileSelectionState& lastFrameSelectionState) {
+  const TileSelectionData* pSelectionData =
+      getSelectionData(frameState.pSelectionData, selectionIndex);
   TileSelectionState::Result lastFrameResult =
       lastFrameSelectionState.getResult(frameState.lastFrameNumber);
-  bool isRenderable = tile.isRenderable();
+  bool isRenderable =
+      pSelectionData ? pSelectionData->renderable : tile.isRenderable();
+  TileRefine refine =
+      pSelectionData ? pSelectionData->refine : tile.getRefine();
   bool wasRenderedLastFrame =
       lastFrameResult == TileSelectionState::Result::Rendered ||
-      (tile.getRefine() == TileRefine::Add &&
+      (refine == TileRefine::Add &&
        lastFrameResult == TileSelectionState::Result::Refined);
 
   TraversalDetails traversalDetails;
@@ -7,13 +7,19 @@ TileLoadInput::TileLoadInput(
     const CesiumAsync::AsyncSystem& asyncSystem_,
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor_,
     const std::shared_ptr<spdlog::logger>& pLogger_,
-    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders_)
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders_,
+    std::shared_ptr<const std::atomic<bool>> pLoadCanceled_,
+    std::optional<CesiumAsync::ThreadPool> decodeThreadPool_,
+    CesiumAsync::TaskPriority priority_)
     : tile{tile_},
       contentOptions{contentOptions_},
       asyncSystem{asyncSystem_},
       pAssetAccessor{pAssetAccessor_},
       pLogger{pLogger_},
-      requestHeaders{requestHeaders_} {}
+      requestHeaders{requestHeaders_},
+      pLoadCanceled{std::move(pLoadCanceled_)},
+      decodeThreadPool{std::move(decodeThreadPool_)},
+      priority{priority_} {}
 
 TileLoadResult TileLoadResult::createFailedResult(
     std::shared_ptr<CesiumAsync::IAssetRequest> pCompletedRequest) {
@@ -40,4 +46,21 @@ TileLoadResult TileLoadResult::createRetryLaterResult(
       {},
       TileLoadResultState::RetryLater};
 }
+
+CesiumAsync::Future<void>
+TilesetContentLoader::loadTileChildren(const TileLoadInput& input) {
+  return input.asyncSystem.createResolvedFuture();
+}
+
+void TilesetContentLoader::notifyTileContentUnloaded(const Tile& /*tile*/) {}
+
+void TilesetContentLoader::addMemoryUsage(
+    TilesetMemoryUsage& /*usage*/) const {}
+
+int64_t TilesetContentLoader::trimMemory() { return 0; }
+
+std::optional<std::string>
+TilesetContentLoader::getTileContentUrl(const Tile& /*tile*/) const {
+  return std::nullopt;
+}
 } // namespace Cesium3DTilesSelection
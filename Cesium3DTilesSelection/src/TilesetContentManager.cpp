@@ -1,13 +1,24 @@
 #include "TilesetContentManager.h"
 
 #include "CesiumIonTilesetLoader.h"
+#include "DecodeThread.h"
 #include "LayerJsonTerrainLoader.h"
 #include "TileContentLoadInfo.h"
+#include "TimingScope.h"
 #include "TilesetJsonLoader.h"
 
+#include <Cesium3DTilesSelection/DecodedContentCache.h>
 #include <Cesium3DTilesSelection/IPrepareRendererResources.h>
+#include <Cesium3DTilesSelection/ITileEvictionPolicy.h>
+#include <Cesium3DTilesSelection/ProcessedContentCache.h>
+#include <CesiumAsync/AdaptiveConcurrencyLimiter.h>
+#include <CesiumAsync/CacheItem.h>
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/PackedPropertyTable.h>
+#include <CesiumGltf/PropertyTableView.h>
 #include <CesiumGltfContent/GltfUtilities.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumRasterOverlays/RasterOverlay.h>
@@ -15,12 +26,18 @@
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
 #include <CesiumRasterOverlays/RasterOverlayUtilities.h>
 #include <CesiumUtility/IntrusivePointer.h>
+#include <CesiumUtility/Metrics.h>
+#include <CesiumUtility/PixelBufferPool.h>
 #include <CesiumUtility/joinToString.h>
 
+#include <glm/vec4.hpp>
 #include <rapidjson/document.h>
 #include <spdlog/logger.h>
 
+#include <algorithm>
 #include <chrono>
+#include <ctime>
+#include <string>
 
 using namespace CesiumGltfContent;
 using namespace CesiumRasterOverlays;
@@ -71,6 +88,28 @@ void unloadTileRecursively(
   }
 }
 
+// Tiles that could not be unloaded, like external tilesets, may still refer to
+// raster overlay tiles, which must be released in the main thread.
+void clearMappedRasterTilesRecursively(Tile& tile) noexcept {
+  tile.getMappedRasterTiles().clear();
+  for (Tile& child : tile.getChildren()) {
+    clearMappedRasterTilesRecursively(child);
+  }
+}
+
+// Whether a child is being upsampled from the tile, in which case the child
+// may be using the tile's content from another thread via lambda capture.
+bool isAnyChildUpsampling(const Tile& tile) noexcept {
+  for (const Tile& child : tile.getChildren()) {
+    if (child.getState() == TileLoadState::ContentLoading &&
+        std::holds_alternative<CesiumGeometry::UpsampledQuadtreeNode>(
+            child.getTileID())) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool anyRasterOverlaysNeedLoading(const Tile& tile) noexcept {
   for (const RasterMappedTo3DTile& mapped : tile.getMappedRasterTiles()) {
     const RasterOverlayTile* pLoading = mapped.getLoadingTile();
@@ -264,7 +303,8 @@ void createQuadtreeSubdividedChildren(
 std::vector<CesiumGeospatial::Projection> mapOverlaysToTile(
     Tile& tile,
     RasterOverlayCollection& overlays,
-    const TilesetOptions& tilesetOptions) {
+    const TilesetOptions& tilesetOptions,
+    const CesiumAsync::TaskPriority& priority) {
   // when tile fails temporarily, it may still have mapped raster tiles, so
   // clear it here
   tile.getMappedRasterTiles().clear();
@@ -289,7 +329,7 @@ std::vector<CesiumGeospatial::Projection> mapOverlaysToTile(
     if (pMapped) {
       // Try to load now, but if the mapped raster tile is a placeholder this
       // won't do anything.
-      pMapped->loadThrottled();
+      pMapped->loadThrottled(priority);
     }
   }
 
@@ -452,8 +492,86 @@ void calcFittestBoundingRegionForLooseTile(
       // We need to compute an accurate bounding region
       result.updatedBoundingVolume = GltfUtilities::computeBoundingRegion(
           model,
-          tileLoadInfo.tileTransform);
+          tileLoadInfo.tileTransform,
+          tileLoadInfo.asyncSystem);
+    }
+  }
+}
+
+// Lets the tile initializer hand the indices and packed properties of the
+// content of a tile to its render content.
+void addIndexInitializer(
+    TileLoadResult& result,
+    const TileContentLoadInfo& tileLoadInfo,
+    std::shared_ptr<const TileGeometryIndex>&& pGeometryIndex) {
+  const CesiumGltf::Model& model =
+      std::get<CesiumGltf::Model>(result.contentKind);
+
+  // Index the feature properties here, since the property tables may be
+  // released once the renderer resources are prepared. The index is handed
+  // to the render content by the tile initializer, which runs after the
+  // content is set.
+  if (!tileLoadInfo.contentOptions.featureIndexProperties.empty()) {
+    auto pFeatureIndex = std::make_shared<const TileFeatureIndex>(
+        model,
+        tileLoadInfo.contentOptions.featureIndexProperties);
+    result.tileInitializer =
+        [pFeatureIndex = std::move(pFeatureIndex),
+         tileInitializer = std::move(result.tileInitializer)](Tile& tile) {
+          if (tileInitializer) {
+            tileInitializer(tile);
+          }
+          TileRenderContent* pRenderContent =
+              tile.getContent().getRenderContent();
+          if (pRenderContent) {
+            pRenderContent->setFeatureIndex(pFeatureIndex);
+          }
+        };
+  }
+
+  // Pack the properties for the renderer here too, for the same reason.
+  const CesiumGltf::ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<CesiumGltf::ExtensionModelExtStructuralMetadata>();
+  if (!tileLoadInfo.contentOptions.packedProperties.empty() && pMetadata) {
+    std::vector<CesiumGltf::PackedPropertyTable> packedPropertyTables;
+    for (const CesiumGltf::PropertyTable& propertyTable :
+         pMetadata->propertyTables) {
+      packedPropertyTables.emplace_back(CesiumGltf::packPropertyTable(
+          CesiumGltf::PropertyTableView(model, propertyTable),
+          tileLoadInfo.contentOptions.packedProperties,
+          tileLoadInfo.contentOptions.maximumPackedPropertyTextureWidth));
     }
+
+    auto pPackedPropertyTables =
+        std::make_shared<const std::vector<CesiumGltf::PackedPropertyTable>>(
+            std::move(packedPropertyTables));
+    result.tileInitializer =
+        [pPackedPropertyTables = std::move(pPackedPropertyTables),
+         tileInitializer = std::move(result.tileInitializer)](Tile& tile) {
+          if (tileInitializer) {
+            tileInitializer(tile);
+          }
+          TileRenderContent* pRenderContent =
+              tile.getContent().getRenderContent();
+          if (pRenderContent) {
+            pRenderContent->setPackedPropertyTables(pPackedPropertyTables);
+          }
+        };
+  }
+
+  if (pGeometryIndex) {
+    result.tileInitializer =
+        [pGeometryIndex = std::move(pGeometryIndex),
+         tileInitializer = std::move(result.tileInitializer)](Tile& tile) {
+          if (tileInitializer) {
+            tileInitializer(tile);
+          }
+          TileRenderContent* pRenderContent =
+              tile.getContent().getRenderContent();
+          if (pRenderContent) {
+            pRenderContent->setGeometryIndex(pGeometryIndex);
+          }
+        };
   }
 }
 
@@ -472,6 +590,11 @@ void postProcessGltfInWorkerThread(
       static_cast<std::underlying_type_t<CesiumGeometry::Axis>>(
           result.glTFUpAxis);
 
+  // Merge primitives first, so that everything below handles fewer of them.
+  if (tileLoadInfo.contentOptions.mergePrimitives) {
+    GltfUtilities::mergePrimitives(model);
+  }
+
   // calculate raster overlay details
   calcRasterOverlayDetailsInWorkerThread(
       result,
@@ -485,6 +608,70 @@ void postProcessGltfInWorkerThread(
   if (tileLoadInfo.contentOptions.generateMissingNormalsSmooth) {
     model.generateMissingNormalsSmooth();
   }
+
+  // Index the triangles while the positions are still floats.
+  std::shared_ptr<const TileGeometryIndex> pGeometryIndex;
+  if (tileLoadInfo.contentOptions.buildGeometryIndex) {
+    pGeometryIndex = std::make_shared<const TileGeometryIndex>(model);
+  }
+
+  // Fit a content bounding volume to the positions if the tile has none.
+  if (tileLoadInfo.contentOptions.computeContentBoundingVolumes &&
+      !tileLoadInfo.tileContentBoundingVolume &&
+      !result.updatedContentBoundingVolume) {
+    std::optional<CesiumGeometry::OrientedBoundingBox> maybeBox =
+        GltfUtilities::computeOrientedBoundingBox(
+            model,
+            tileLoadInfo.tileTransform);
+    if (maybeBox) {
+      result.updatedContentBoundingVolume = *maybeBox;
+    }
+  }
+
+  // Group dense instances into clusters the renderer can cull separately.
+  if (tileLoadInfo.contentOptions.instanceClusterSize > 0) {
+    GltfUtilities::clusterInstances(
+        model,
+        tileLoadInfo.contentOptions.instanceClusterSize);
+  }
+
+  // Quantize last, since everything above reads float positions.
+  if (tileLoadInfo.contentOptions.quantizeMeshes) {
+    GltfUtilities::quantizeMeshes(model);
+  }
+
+  addIndexInitializer(result, tileLoadInfo, std::move(pGeometryIndex));
+}
+
+// Creates the render resources of a tile in the load thread, and records when
+// that starts and finishes if the load has a timeline.
+CesiumAsync::Future<TileLoadResultAndRenderResources>
+prepareRendererResourcesInLoadThread(
+    TileLoadResult&& result,
+    const TileContentLoadInfo& tileLoadInfo,
+    const std::any& rendererOptions) {
+  const std::shared_ptr<TileLoadTimelineRecorder>& pRecorder =
+      tileLoadInfo.pTimelineRecorder;
+  if (!pRecorder) {
+    return tileLoadInfo.pPrepareRendererResources->prepareInLoadThread(
+        tileLoadInfo.asyncSystem,
+        std::move(result),
+        tileLoadInfo.tileTransform,
+        rendererOptions);
+  }
+
+  pRecorder->record(TileLoadEvent::PrepareInLoadThreadStarted);
+  return tileLoadInfo.pPrepareRendererResources
+      ->prepareInLoadThread(
+          tileLoadInfo.asyncSystem,
+          std::move(result),
+          tileLoadInfo.tileTransform,
+          rendererOptions)
+      .thenImmediately(
+          [pRecorder](TileLoadResultAndRenderResources&& pair) {
+            pRecorder->record(TileLoadEvent::PrepareInLoadThreadFinished);
+            return std::move(pair);
+          });
 }
 
 CesiumAsync::Future<TileLoadResultAndRenderResources>
@@ -512,75 +699,696 @@ postProcessContentInWorkerThread(
   CesiumGltfReader::GltfReaderOptions gltfOptions;
   gltfOptions.ktx2TranscodeTargets =
       tileLoadInfo.contentOptions.ktx2TranscodeTargets;
+  gltfOptions.loadImages = !tileLoadInfo.contentOptions.geometryOnly;
 
   auto asyncSystem = tileLoadInfo.asyncSystem;
   auto pAssetAccessor = tileLoadInfo.pAssetAccessor;
-  return CesiumGltfReader::GltfReader::resolveExternalData(
+  auto decodeThreadPool = tileLoadInfo.decodeThreadPool;
+  auto priority = tileLoadInfo.priority;
+  return thenInDecodeThread(
+      CesiumGltfReader::GltfReader::resolveExternalData(
+          asyncSystem,
+          baseUrl,
+          requestHeaders,
+          pAssetAccessor,
+          gltfOptions,
+          std::move(gltfResult)),
+      decodeThreadPool,
+      priority,
+      [result = std::move(result),
+       projections = std::move(projections),
+       tileLoadInfo = std::move(tileLoadInfo),
+       rendererOptions](
+          CesiumGltfReader::GltfReaderResult&& gltfResult) mutable {
+        if (!gltfResult.errors.empty()) {
+          if (result.pCompletedRequest) {
+            SPDLOG_LOGGER_ERROR(
+                tileLoadInfo.pLogger,
+                "Failed resolving external glTF buffers from {}:\n- {}",
+                result.pCompletedRequest->url(),
+                CesiumUtility::joinToString(gltfResult.errors, "\n- "));
+          } else {
+            SPDLOG_LOGGER_ERROR(
+                tileLoadInfo.pLogger,
+                "Failed resolving external glTF buffers:\n- {}",
+                CesiumUtility::joinToString(gltfResult.errors, "\n- "));
+          }
+        }
+
+        if (!gltfResult.warnings.empty()) {
+          if (result.pCompletedRequest) {
+            SPDLOG_LOGGER_WARN(
+                tileLoadInfo.pLogger,
+                "Warning when resolving external gltf buffers from "
+                "{}:\n- {}",
+                result.pCompletedRequest->url(),
+                CesiumUtility::joinToString(gltfResult.errors, "\n- "));
+          } else {
+            SPDLOG_LOGGER_ERROR(
+                tileLoadInfo.pLogger,
+                "Warning resolving external glTF buffers:\n- {}",
+                CesiumUtility::joinToString(gltfResult.errors, "\n- "));
+          }
+        }
+
+        if (!gltfResult.model) {
+          return tileLoadInfo.asyncSystem.createResolvedFuture(
+              TileLoadResultAndRenderResources{
+                  TileLoadResult::createFailedResult(nullptr),
+                  nullptr});
+        }
+
+        result.contentKind = std::move(*gltfResult.model);
+
+        postProcessGltfInWorkerThread(
+            result,
+            std::move(projections),
+            tileLoadInfo);
+
+        // Store the processed content so that it need not be processed again
+        // when it is next loaded.
+        if (tileLoadInfo.processedContentKey) {
+          tileLoadInfo.contentOptions.pProcessedContentCache->insert(
+              *tileLoadInfo.processedContentKey,
+              tileLoadInfo.processedContentUrl,
+              result);
+        }
+
+        // Tiles loaded only to fill the cache don't get render resources.
+        if (!tileLoadInfo.pPrepareRendererResources) {
+          return tileLoadInfo.asyncSystem.createResolvedFuture(
+              TileLoadResultAndRenderResources{std::move(result), nullptr});
+        }
+
+        // create render resources
+        return prepareRendererResourcesInLoadThread(
+            std::move(result),
+            tileLoadInfo,
+            rendererOptions);
+      });
+}
+
+// Loads the content of a tile with its loader, and processes it if it is a
+// glTF.
+CesiumAsync::Future<TileLoadResultAndRenderResources>
+loadAndProcessTileContent(
+    TilesetContentLoader& loader,
+    const TileLoadInput& loadInput,
+    TileContentLoadInfo&& tileLoadInfo,
+    std::vector<CesiumGeospatial::Projection>&& projections,
+    const std::any& rendererOptions,
+    const std::shared_ptr<std::atomic<bool>>& pLoadCanceled) {
+  return loader.loadTileContent(loadInput).thenImmediately(
+      [tileLoadInfo = std::move(tileLoadInfo),
+       projections = std::move(projections),
+       rendererOptions,
+       pLoadCanceled](TileLoadResult&& result) mutable {
+        // the reason we run immediate continuation, instead of in the
+        // worker thread, is that the loader may run the task in the main
+        // thread. And most often than not, those main thread task is very
+        // light weight. So when those tasks return, there is no need to
+        // spawn another worker thread if the result of the task isn't
+        // related to render content. We only ever spawn a new task in the
+        // worker thread if the content is a render content
+        if (tileLoadInfo.pTimelineRecorder) {
+          tileLoadInfo.pTimelineRecorder->record(TileLoadEvent::ContentParsed);
+        }
+
+        if (result.state == TileLoadResultState::Success) {
+          if (std::holds_alternative<CesiumGltf::Model>(result.contentKind)) {
+            auto asyncSystem = tileLoadInfo.asyncSystem;
+            auto decodeThreadPool = tileLoadInfo.decodeThreadPool;
+            auto priority = tileLoadInfo.priority;
+            return runInDecodeThread(
+                asyncSystem,
+                decodeThreadPool,
+                priority,
+                [result = std::move(result),
+                 projections = std::move(projections),
+                 tileLoadInfo = std::move(tileLoadInfo),
+                 rendererOptions,
+                 pLoadCanceled]() mutable {
+                  // Skip preparing the renderer resources of a tile that is
+                  // no longer needed.
+                  if (*pLoadCanceled) {
+                    return tileLoadInfo.asyncSystem
+                        .createResolvedFuture<TileLoadResultAndRenderResources>(
+                            {TileLoadResult::createRetryLaterResult(
+                                 std::move(result.pCompletedRequest)),
+                             nullptr});
+                  }
+
+                  if (tileLoadInfo.pTimelineRecorder) {
+                    tileLoadInfo.pTimelineRecorder->record(
+                        TileLoadEvent::DecodeStarted);
+                  }
+
+                  return postProcessContentInWorkerThread(
+                      std::move(result),
+                      std::move(projections),
+                      std::move(tileLoadInfo),
+                      rendererOptions);
+                });
+          }
+        }
+
+        return tileLoadInfo.asyncSystem
+            .createResolvedFuture<TileLoadResultAndRenderResources>(
+                {std::move(result), nullptr});
+      });
+}
+
+// Prepares the renderer resources of content read back from the processed
+// content cache. Only the indices, which are not stored, are built again.
+CesiumAsync::Future<TileLoadResultAndRenderResources>
+prepareProcessedContentInWorkerThread(
+    TileLoadResult&& result,
+    const TileContentLoadInfo& tileLoadInfo,
+    const std::any& rendererOptions) {
+  std::shared_ptr<const TileGeometryIndex> pGeometryIndex;
+  if (tileLoadInfo.contentOptions.buildGeometryIndex) {
+    pGeometryIndex = std::make_shared<const TileGeometryIndex>(
+        std::get<CesiumGltf::Model>(result.contentKind));
+  }
+  addIndexInitializer(result, tileLoadInfo, std::move(pGeometryIndex));
+
+  if (!tileLoadInfo.pPrepareRendererResources) {
+    return tileLoadInfo.asyncSystem.createResolvedFuture(
+        TileLoadResultAndRenderResources{std::move(result), nullptr});
+  }
+
+  return prepareRendererResourcesInLoadThread(
+      std::move(result),
+      tileLoadInfo,
+      rendererOptions);
+}
+
+// Reads the processed content of a tile back from the processed content
+// cache, or loads and processes it with its loader if it is not there. The
+// loader is only used in the main thread.
+CesiumAsync::Future<TileLoadResultAndRenderResources>
+loadProcessedTileContent(
+    TilesetContentLoader& loader,
+    const TileLoadInput& loadInput,
+    TileContentLoadInfo&& tileLoadInfo,
+    std::vector<CesiumGeospatial::Projection>&& projections,
+    const std::any& rendererOptions,
+    const std::shared_ptr<std::atomic<bool>>& pLoadCanceled) {
+  auto asyncSystem = tileLoadInfo.asyncSystem;
+  auto decodeThreadPool = tileLoadInfo.decodeThreadPool;
+  auto priority = tileLoadInfo.priority;
+  return runInDecodeThread(
              asyncSystem,
-             baseUrl,
-             requestHeaders,
-             pAssetAccessor,
-             gltfOptions,
-             std::move(gltfResult))
-      .thenInWorkerThread(
-          [result = std::move(result),
-           projections = std::move(projections),
+             decodeThreadPool,
+             priority,
+             [pCache = tileLoadInfo.contentOptions.pProcessedContentCache,
+              key = *tileLoadInfo.processedContentKey]() {
+               return pCache->find(key);
+             })
+      .thenInMainThread(
+          [&loader,
+           loadInput,
            tileLoadInfo = std::move(tileLoadInfo),
-           rendererOptions](
-              CesiumGltfReader::GltfReaderResult&& gltfResult) mutable {
-            if (!gltfResult.errors.empty()) {
-              if (result.pCompletedRequest) {
-                SPDLOG_LOGGER_ERROR(
-                    tileLoadInfo.pLogger,
-                    "Failed resolving external glTF buffers from {}:\n- {}",
-                    result.pCompletedRequest->url(),
-                    CesiumUtility::joinToString(gltfResult.errors, "\n- "));
-              } else {
-                SPDLOG_LOGGER_ERROR(
-                    tileLoadInfo.pLogger,
-                    "Failed resolving external glTF buffers:\n- {}",
-                    CesiumUtility::joinToString(gltfResult.errors, "\n- "));
-              }
+           projections = std::move(projections),
+           rendererOptions,
+           pLoadCanceled](std::optional<TileLoadResult>&& maybeResult) mutable
+          -> CesiumAsync::Future<TileLoadResultAndRenderResources> {
+            if (!maybeResult) {
+              return loadAndProcessTileContent(
+                  loader,
+                  loadInput,
+                  std::move(tileLoadInfo),
+                  std::move(projections),
+                  rendererOptions,
+                  pLoadCanceled);
+            }
+
+            if (tileLoadInfo.pTimelineRecorder) {
+              tileLoadInfo.pTimelineRecorder->record(
+                  TileLoadEvent::ProcessedContentCacheHit);
+            }
+
+            if (*pLoadCanceled) {
+              return tileLoadInfo.asyncSystem
+                  .createResolvedFuture<TileLoadResultAndRenderResources>(
+                      {TileLoadResult::createRetryLaterResult(nullptr),
+                       nullptr});
+            }
+
+            auto asyncSystem = tileLoadInfo.asyncSystem;
+            auto decodeThreadPool = tileLoadInfo.decodeThreadPool;
+            auto priority = tileLoadInfo.priority;
+            return runInDecodeThread(
+                asyncSystem,
+                decodeThreadPool,
+                priority,
+                [result = std::move(*maybeResult),
+                 tileLoadInfo = std::move(tileLoadInfo),
+                 rendererOptions]() mutable {
+                  return prepareProcessedContentInWorkerThread(
+                      std::move(result),
+                      tileLoadInfo,
+                      rendererOptions);
+                });
+          });
+}
+
+// Releases the glTF data that the renderer no longer needs once it has
+// prepared its resources for a tile.
+void releaseModelData(
+    CesiumGltf::Model& model,
+    const TilesetContentOptions& contentOptions) {
+  if (contentOptions.releaseBufferDataAfterPrepare) {
+    for (CesiumGltf::Buffer& buffer : model.buffers) {
+      buffer.cesium.data.clear();
+      buffer.cesium.data.shrink_to_fit();
+      buffer.cesium.sharedData = CesiumUtility::SharedBytes();
+    }
+  }
+
+  if (contentOptions.releaseImageDataAfterPrepare) {
+    for (CesiumGltf::Image& image : model.images) {
+      CesiumUtility::PixelBufferPool::getDefault().release(
+          image.cesium.pixelData);
+      image.cesium.sharedPixelData = CesiumUtility::SharedBytes();
+      image.cesium.mipPositions.clear();
+    }
+  }
+}
+
+// Tells the tile's loader when a load has finished without content, which it
+// would otherwise only hear about when the content is unloaded.
+void notifyLoaderIfNoContent(Tile& tile) {
+  const TileLoadState state = tile.getState();
+  if (state != TileLoadState::ContentLoaded && state != TileLoadState::Done &&
+      tile.getLoader()) {
+    tile.getLoader()->notifyTileContentUnloaded(tile);
+  }
+}
+
+void addModelMemoryUsage(
+    const CesiumGltf::Model& model,
+    TilesetMemoryUsage& usage) {
+  const std::vector<CesiumGltf::BufferView>& bufferViews = model.bufferViews;
+
+  // Finds the bytes of a buffer view, unless its buffer data was released,
+  // as it is once images are decoded.
+  const auto getBufferViewBytes = [&model, &bufferViews](int32_t bufferView) {
+    if (bufferView < 0 ||
+        bufferView >= static_cast<int32_t>(bufferViews.size())) {
+      return int64_t(0);
+    }
+    const CesiumGltf::BufferView& view = bufferViews[size_t(bufferView)];
+    if (view.buffer < 0 ||
+        view.buffer >= static_cast<int32_t>(model.buffers.size()) ||
+        model.buffers[size_t(view.buffer)].cesium.getData().empty()) {
+      return int64_t(0);
+    }
+    return view.byteLength;
+  };
+
+  int64_t bufferBytes = 0;
+  for (const CesiumGltf::Buffer& buffer : model.buffers) {
+    bufferBytes += int64_t(buffer.cesium.getData().size());
+  }
+
+  // The encoded images are replaced by the decoded ones.
+  for (const CesiumGltf::Image& image : model.images) {
+    bufferBytes -= getBufferViewBytes(image.bufferView);
+    usage.textureBytes += int64_t(image.cesium.getPixelData().size());
+  }
+
+  const CesiumGltf::ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<CesiumGltf::ExtensionModelExtStructuralMetadata>();
+  if (pMetadata) {
+    int64_t metadataBytes = 0;
+    for (const CesiumGltf::PropertyTable& propertyTable :
+         pMetadata->propertyTables) {
+      for (const auto& propertyPair : propertyTable.properties) {
+        const CesiumGltf::PropertyTableProperty& property = propertyPair.second;
+        metadataBytes += getBufferViewBytes(property.values);
+        metadataBytes += getBufferViewBytes(property.arrayOffsets);
+        metadataBytes += getBufferViewBytes(property.stringOffsets);
+      }
+    }
+    bufferBytes -= metadataBytes;
+    usage.metadataBytes += metadataBytes;
+  }
+
+  usage.geometryBytes += std::max(bufferBytes, int64_t(0));
+}
+
+MetricGauge& getTileLoadsInProgressGauge() {
+  static MetricGauge& gauge = MetricsRegistry::getDefault().gauge(
+      "cesium_tile_loads_in_progress",
+      "The number of tiles and tileset roots that are loading.");
+  return gauge;
+}
+
+MetricCounter& getTileContentLoadsCounter(TileLoadResultState state) {
+  static const char* help = "The number of tile content loads, by result.";
+  static MetricCounter& succeeded = MetricsRegistry::getDefault().counter(
+      "cesium_tile_content_loads_total",
+      help,
+      {{"result", "success"}});
+  static MetricCounter& failed = MetricsRegistry::getDefault().counter(
+      "cesium_tile_content_loads_total",
+      help,
+      {{"result", "failed"}});
+  static MetricCounter& retryLater = MetricsRegistry::getDefault().counter(
+      "cesium_tile_content_loads_total",
+      help,
+      {{"result", "retry_later"}});
+
+  switch (state) {
+  case TileLoadResultState::Failed:
+    return failed;
+  case TileLoadResultState::RetryLater:
+    return retryLater;
+  default:
+    return succeeded;
+  }
+}
+
+// Whether the content of a tile with the given URL is likely an external
+// tileset, which is recognized by its content only once it's loaded.
+bool isExternalTilesetUrl(const std::string& url) {
+  const std::string path = url.substr(0, url.find_first_of("?#"));
+  const std::string extension = ".json";
+  return path.size() >= extension.size() &&
+         path.compare(
+             path.size() - extension.size(),
+             extension.size(),
+             extension) == 0;
+}
+
+// Creates the loader of a tileset from its root document, which is either a
+// tileset.json or a layer.json.
+CesiumAsync::Future<TilesetContentLoaderResult<TilesetContentLoader>>
+createRootLoader(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const TilesetContentOptions& contentOptions,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+    const gsl::span<const std::byte>& data) {
+  // Most tilesets are a tileset.json, whose tiles can be created as the JSON
+  // is read.
+  std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+      maybeTilesetJsonResult = TilesetJsonLoader::createLoader(
+          pLogger,
+          url,
+          data,
+          contentOptions.tilesetJsonTileLevels);
+  if (maybeTilesetJsonResult) {
+    TilesetContentLoaderResult<TilesetContentLoader> result =
+        std::move(*maybeTilesetJsonResult);
+    return asyncSystem.createResolvedFuture(std::move(result));
+  }
+
+  // Parse Json response
+  rapidjson::Document tilesetJson;
+  tilesetJson.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  if (tilesetJson.HasParseError()) {
+    TilesetContentLoaderResult<TilesetContentLoader> result;
+    result.errors.emplaceError(fmt::format(
+        "Error when parsing tileset JSON, error code {} at byte offset {}",
+        tilesetJson.GetParseError(),
+        tilesetJson.GetErrorOffset()));
+    return asyncSystem.createResolvedFuture(std::move(result));
+  }
+
+  // Check if the json is a tileset.json format or layer.json format and
+  // create corresponding loader
+  const auto rootIt = tilesetJson.FindMember("root");
+  if (rootIt != tilesetJson.MemberEnd()) {
+    TilesetContentLoaderResult<TilesetContentLoader> result =
+        TilesetJsonLoader::createLoader(pLogger, url, tilesetJson);
+    return asyncSystem.createResolvedFuture(std::move(result));
+  } else {
+    const auto formatIt = tilesetJson.FindMember("format");
+    bool isLayerJsonFormat = formatIt != tilesetJson.MemberEnd() &&
+                             formatIt->value.IsString();
+    isLayerJsonFormat =
+        isLayerJsonFormat &&
+        std::string(formatIt->value.GetString()) == "quantized-mesh-1.0";
+    if (isLayerJsonFormat) {
+      return LayerJsonTerrainLoader::createLoader(
+                 asyncSystem,
+                 pAssetAccessor,
+                 contentOptions,
+                 url,
+                 requestHeaders,
+                 tilesetJson)
+          .thenImmediately(
+              [](TilesetContentLoaderResult<TilesetContentLoader>&& result) {
+                return std::move(result);
+              });
+    }
+
+    TilesetContentLoaderResult<TilesetContentLoader> result;
+    result.errors.emplaceError("tileset json has unsupport format");
+    return asyncSystem.createResolvedFuture(std::move(result));
+  }
+}
+
+// How long the root document of a tileset is kept in the cache database
+// after it was last requested or validated.
+constexpr std::time_t TILESET_ROOT_CACHE_MAXIMUM_AGE = 60 * 60 * 24 * 30;
+
+// Gets the key of the root document of a tileset in the cache database. It is
+// distinct from the key that a CachingAssetAccessor would use for the same
+// URL.
+std::string getTilesetRootCacheKey(const std::string& url) {
+  return "tileset-root:" + url;
+}
+
+// Keeps the root document of a tileset in the cache database, with the
+// headers of the response that it came from, so that a later session can
+// create the tileset from it without waiting for a request.
+void storeTilesetRoot(
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pCacheDatabase,
+    const std::string& url,
+    const CesiumAsync::HttpHeaders& requestHeaders,
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& data) {
+  pCacheDatabase->storeEntry(
+      getTilesetRootCacheKey(url),
+      std::time(nullptr) + TILESET_ROOT_CACHE_MAXIMUM_AGE,
+      url,
+      "GET",
+      requestHeaders,
+      200,
+      responseHeaders,
+      data);
+}
+
+bool isSuccessfulStatusCode(uint16_t statusCode) {
+  return statusCode == 0 || (statusCode >= 200 && statusCode < 300);
+}
+
+// Requests the root document of a tileset and creates the loader of the
+// tileset from it. If storeInCache is true, a document that a loader could be
+// created from is kept in the cache database.
+CesiumAsync::Future<TilesetContentLoaderResult<TilesetContentLoader>>
+requestRootLoader(
+    const TilesetExternals& externals,
+    const TilesetContentOptions& contentOptions,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+    bool storeInCache) {
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase;
+  if (storeInCache) {
+    pCacheDatabase = externals.pCacheDatabase;
+  }
+
+  return externals.pAssetAccessor
+      ->get(externals.asyncSystem, url, requestHeaders)
+      .thenInWorkerThread(
+          [pLogger = externals.pLogger,
+           asyncSystem = externals.asyncSystem,
+           pAssetAccessor = externals.pAssetAccessor,
+           pCacheDatabase,
+           contentOptions,
+           tilesetUrl = url](const std::shared_ptr<CesiumAsync::IAssetRequest>&
+                                 pCompletedRequest) {
+            // Check if request is successful
+            const CesiumAsync::IAssetResponse* pResponse =
+                pCompletedRequest->response();
+            const std::string& url = pCompletedRequest->url();
+            if (!pResponse) {
+              TilesetContentLoaderResult<TilesetContentLoader> result;
+              result.errors.emplaceError(fmt::format(
+                  "Did not receive a valid response for tileset {}",
+                  url));
+              return asyncSystem.createResolvedFuture(std::move(result));
+            }
+
+            uint16_t statusCode = pResponse->statusCode();
+            if (!isSuccessfulStatusCode(statusCode)) {
+              TilesetContentLoaderResult<TilesetContentLoader> result;
+              result.errors.emplaceError(fmt::format(
+                  "Received status code {} for tileset {}",
+                  statusCode,
+                  url));
+              return asyncSystem.createResolvedFuture(std::move(result));
             }
 
-            if (!gltfResult.warnings.empty()) {
-              if (result.pCompletedRequest) {
-                SPDLOG_LOGGER_WARN(
-                    tileLoadInfo.pLogger,
-                    "Warning when resolving external gltf buffers from "
-                    "{}:\n- {}",
-                    result.pCompletedRequest->url(),
-                    CesiumUtility::joinToString(gltfResult.errors, "\n- "));
-              } else {
-                SPDLOG_LOGGER_ERROR(
-                    tileLoadInfo.pLogger,
-                    "Warning resolving external glTF buffers:\n- {}",
-                    CesiumUtility::joinToString(gltfResult.errors, "\n- "));
-              }
+            const CesiumAsync::HttpHeaders& completedRequestHeaders =
+                pCompletedRequest->headers();
+            std::vector<CesiumAsync::IAssetAccessor::THeader> flatHeaders(
+                completedRequestHeaders.begin(),
+                completedRequestHeaders.end());
+            return createRootLoader(
+                       asyncSystem,
+                       pAssetAccessor,
+                       pLogger,
+                       contentOptions,
+                       url,
+                       flatHeaders,
+                       pResponse->data())
+                .thenInWorkerThread(
+                    [pCacheDatabase, tilesetUrl, pCompletedRequest](
+                        TilesetContentLoaderResult<TilesetContentLoader>&&
+                            result) {
+                      if (pCacheDatabase && !result.errors.hasErrors()) {
+                        storeTilesetRoot(
+                            pCacheDatabase,
+                            tilesetUrl,
+                            pCompletedRequest->headers(),
+                            pCompletedRequest->response()->headers(),
+                            pCompletedRequest->response()->data());
+                      }
+                      return std::move(result);
+                    });
+          });
+}
+
+// Requests the root document of a tileset that was created from the cache
+// database, with the validators of the cached response, so that the next
+// session creates the tileset from the current document. The tileset that
+// was created from the cached document is not changed.
+void revalidateTilesetRoot(
+    const TilesetExternals& externals,
+    const std::string& url,
+    CesiumAsync::CacheItem&& cacheItem) {
+  const CesiumAsync::HttpHeaders& cachedRequestHeaders =
+      cacheItem.cacheRequest.headers;
+  const CesiumAsync::HttpHeaders& cachedResponseHeaders =
+      cacheItem.cacheResponse.headers;
+  std::vector<CesiumAsync::IAssetAccessor::THeader> headers(
+      cachedRequestHeaders.begin(),
+      cachedRequestHeaders.end());
+  auto etagIt = cachedResponseHeaders.find("ETag");
+  if (etagIt != cachedResponseHeaders.end()) {
+    headers.emplace_back("If-None-Match", etagIt->second);
+  }
+  auto lastModifiedIt = cachedResponseHeaders.find("Last-Modified");
+  if (lastModifiedIt != cachedResponseHeaders.end()) {
+    headers.emplace_back("If-Modified-Since", lastModifiedIt->second);
+  }
+
+  externals.pAssetAccessor->get(externals.asyncSystem, url, headers)
+      .thenInWorkerThread(
+          [pCacheDatabase = externals.pCacheDatabase,
+           url,
+           cacheItem = std::move(cacheItem)](
+              const std::shared_ptr<CesiumAsync::IAssetRequest>&
+                  pCompletedRequest) {
+            const CesiumAsync::IAssetResponse* pResponse =
+                pCompletedRequest->response();
+            if (!pResponse) {
+              return;
             }
 
-            if (!gltfResult.model) {
-              return tileLoadInfo.asyncSystem.createResolvedFuture(
-                  TileLoadResultAndRenderResources{
-                      TileLoadResult::createFailedResult(nullptr),
-                      nullptr});
+            if (pResponse->statusCode() == 304) {
+              // The cached document is still current, so it is kept for
+              // longer.
+              storeTilesetRoot(
+                  pCacheDatabase,
+                  url,
+                  cacheItem.cacheRequest.headers,
+                  cacheItem.cacheResponse.headers,
+                  cacheItem.cacheResponse.data);
+            } else if (isSuccessfulStatusCode(pResponse->statusCode())) {
+              storeTilesetRoot(
+                  pCacheDatabase,
+                  url,
+                  cacheItem.cacheRequest.headers,
+                  pResponse->headers(),
+                  pResponse->data());
             }
+          });
+}
 
-            result.contentKind = std::move(*gltfResult.model);
+// Creates the loader of a tileset from the root document that an earlier
+// session kept in the cache database, and revalidates that document in the
+// background. If there is no such document, or no loader can be created from
+// it, the document is requested instead.
+CesiumAsync::Future<TilesetContentLoaderResult<TilesetContentLoader>>
+restoreRootLoader(
+    const TilesetExternals& externals,
+    const TilesetContentOptions& contentOptions,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders) {
+  return externals.asyncSystem
+      .runInWorkerThread([pCacheDatabase = externals.pCacheDatabase, url]() {
+        return pCacheDatabase->getEntry(getTilesetRootCacheKey(url));
+      })
+      .thenInWorkerThread(
+          [externals, contentOptions, url, requestHeaders](
+              std::optional<CesiumAsync::CacheItem>&& maybeCacheItem) {
+            if (!maybeCacheItem ||
+                maybeCacheItem->expiryTime < std::time(nullptr) ||
+                maybeCacheItem->cacheResponse.data.empty()) {
+              return requestRootLoader(
+                  externals,
+                  contentOptions,
+                  url,
+                  requestHeaders,
+                  true);
+            }
 
-            postProcessGltfInWorkerThread(
-                result,
-                std::move(projections),
-                tileLoadInfo);
-
-            // create render resources
-            return tileLoadInfo.pPrepareRendererResources->prepareInLoadThread(
-                tileLoadInfo.asyncSystem,
-                std::move(result),
-                tileLoadInfo.tileTransform,
-                rendererOptions);
+            const CesiumAsync::HttpHeaders& cachedRequestHeaders =
+                maybeCacheItem->cacheRequest.headers;
+            std::vector<CesiumAsync::IAssetAccessor::THeader> flatHeaders(
+                cachedRequestHeaders.begin(),
+                cachedRequestHeaders.end());
+            CesiumAsync::Future<
+                TilesetContentLoaderResult<TilesetContentLoader>>
+                future = createRootLoader(
+                    externals.asyncSystem,
+                    externals.pAssetAccessor,
+                    externals.pLogger,
+                    contentOptions,
+                    url,
+                    flatHeaders,
+                    maybeCacheItem->cacheResponse.data);
+            return std::move(future).thenInWorkerThread(
+                [externals,
+                 contentOptions,
+                 url,
+                 requestHeaders,
+                 cacheItem = std::move(*maybeCacheItem)](
+                    TilesetContentLoaderResult<TilesetContentLoader>&&
+                        result) mutable {
+                  if (result.errors.hasErrors()) {
+                    return requestRootLoader(
+                        externals,
+                        contentOptions,
+                        url,
+                        requestHeaders,
+                        true);
+                  }
+
+                  revalidateTilesetRoot(externals, url, std::move(cacheItem));
+                  return externals.asyncSystem.createResolvedFuture(
+                      std::move(result));
+                });
           });
 }
+
 } // namespace
 
 TilesetContentManager::TilesetContentManager(
@@ -605,12 +1413,28 @@ TilesetContentManager::TilesetContentManager(
       _tileLoadsInProgress{0},
       _loadedTilesCount{0},
       _tilesDataUsed{0},
+      _tilesGpuDataUsed{0},
+      _tilesDataLoaded{0},
+      _rasterOverlayMappingTime{0.0},
+      _tileStateVersion{0},
+      _selectionData{},
+      _maintainSelectionData{tilesetOptions.enablePackedSelectionData},
+      _batchingFrees{false},
+      _pendingFrees{},
+      _keepUnloadedContent{false},
+      _unloadedContents{},
+      _unloadedContentsReleasedFuture{
+          externals.asyncSystem.createResolvedFuture().share()},
       _destructionCompletePromise{externals.asyncSystem.createPromise<void>()},
       _destructionCompleteFuture{
           this->_destructionCompletePromise.getFuture().share()},
       _rootTileAvailablePromise{externals.asyncSystem.createPromise<void>()},
       _rootTileAvailableFuture{
           this->_rootTileAvailablePromise.getFuture().share()} {
+  if (this->_maintainSelectionData && this->_pRootTile) {
+    this->_selectionData.registerSubtree(*this->_pRootTile);
+  }
+
   this->_rootTileAvailablePromise.resolve();
 }
 
@@ -634,6 +1458,18 @@ TilesetContentManager::TilesetContentManager(
       _tileLoadsInProgress{0},
       _loadedTilesCount{0},
       _tilesDataUsed{0},
+      _tilesGpuDataUsed{0},
+      _tilesDataLoaded{0},
+      _rasterOverlayMappingTime{0.0},
+      _tileStateVersion{0},
+      _selectionData{},
+      _maintainSelectionData{tilesetOptions.enablePackedSelectionData},
+      _batchingFrees{false},
+      _pendingFrees{},
+      _keepUnloadedContent{false},
+      _unloadedContents{},
+      _unloadedContentsReleasedFuture{
+          externals.asyncSystem.createResolvedFuture().share()},
       _destructionCompletePromise{externals.asyncSystem.createPromise<void>()},
       _destructionCompleteFuture{
           this->_destructionCompletePromise.getFuture().share()},
@@ -645,90 +1481,22 @@ TilesetContentManager::TilesetContentManager(
 
     CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
 
-    externals.pAssetAccessor
-        ->get(externals.asyncSystem, url, this->_requestHeaders)
-        .thenInWorkerThread(
-            [pLogger = externals.pLogger,
-             asyncSystem = externals.asyncSystem,
-             pAssetAccessor = externals.pAssetAccessor,
-             contentOptions = tilesetOptions.contentOptions](
-                const std::shared_ptr<CesiumAsync::IAssetRequest>&
-                    pCompletedRequest) {
-              // Check if request is successful
-              const CesiumAsync::IAssetResponse* pResponse =
-                  pCompletedRequest->response();
-              const std::string& url = pCompletedRequest->url();
-              if (!pResponse) {
-                TilesetContentLoaderResult<TilesetContentLoader> result;
-                result.errors.emplaceError(fmt::format(
-                    "Did not receive a valid response for tileset {}",
-                    url));
-                return asyncSystem.createResolvedFuture(std::move(result));
-              }
-
-              uint16_t statusCode = pResponse->statusCode();
-              if (statusCode != 0 && (statusCode < 200 || statusCode >= 300)) {
-                TilesetContentLoaderResult<TilesetContentLoader> result;
-                result.errors.emplaceError(fmt::format(
-                    "Received status code {} for tileset {}",
-                    statusCode,
-                    url));
-                return asyncSystem.createResolvedFuture(std::move(result));
-              }
-
-              // Parse Json response
-              gsl::span<const std::byte> tilesetJsonBinary = pResponse->data();
-              rapidjson::Document tilesetJson;
-              tilesetJson.Parse(
-                  reinterpret_cast<const char*>(tilesetJsonBinary.data()),
-                  tilesetJsonBinary.size());
-              if (tilesetJson.HasParseError()) {
-                TilesetContentLoaderResult<TilesetContentLoader> result;
-                result.errors.emplaceError(fmt::format(
-                    "Error when parsing tileset JSON, error code {} at byte "
-                    "offset {}",
-                    tilesetJson.GetParseError(),
-                    tilesetJson.GetErrorOffset()));
-                return asyncSystem.createResolvedFuture(std::move(result));
-              }
-
-              // Check if the json is a tileset.json format or layer.json format
-              // and create corresponding loader
-              const auto rootIt = tilesetJson.FindMember("root");
-              if (rootIt != tilesetJson.MemberEnd()) {
-                TilesetContentLoaderResult<TilesetContentLoader> result =
-                    TilesetJsonLoader::createLoader(pLogger, url, tilesetJson);
-                return asyncSystem.createResolvedFuture(std::move(result));
-              } else {
-                const auto formatIt = tilesetJson.FindMember("format");
-                bool isLayerJsonFormat = formatIt != tilesetJson.MemberEnd() &&
-                                         formatIt->value.IsString();
-                isLayerJsonFormat = isLayerJsonFormat &&
-                                    std::string(formatIt->value.GetString()) ==
-                                        "quantized-mesh-1.0";
-                if (isLayerJsonFormat) {
-                  const CesiumAsync::HttpHeaders& completedRequestHeaders =
-                      pCompletedRequest->headers();
-                  std::vector<CesiumAsync::IAssetAccessor::THeader> flatHeaders(
-                      completedRequestHeaders.begin(),
-                      completedRequestHeaders.end());
-                  return LayerJsonTerrainLoader::createLoader(
-                             asyncSystem,
-                             pAssetAccessor,
-                             contentOptions,
-                             url,
-                             flatHeaders,
-                             tilesetJson)
-                      .thenImmediately(
-                          [](TilesetContentLoaderResult<TilesetContentLoader>&&
-                                 result) { return std::move(result); });
-                }
-
-                TilesetContentLoaderResult<TilesetContentLoader> result;
-                result.errors.emplaceError("tileset json has unsupport format");
-                return asyncSystem.createResolvedFuture(std::move(result));
-              }
-            })
+    CesiumAsync::Future<TilesetContentLoaderResult<TilesetContentLoader>>
+        futureLoader =
+            tilesetOptions.restoreTilesetFromCache && externals.pCacheDatabase
+                ? restoreRootLoader(
+                      externals,
+                      tilesetOptions.contentOptions,
+                      url,
+                      this->_requestHeaders)
+                : requestRootLoader(
+                      externals,
+                      tilesetOptions.contentOptions,
+                      url,
+                      this->_requestHeaders,
+                      false);
+
+    std::move(futureLoader)
         .thenInMainThread(
             [thiz, errorCallback = tilesetOptions.loadErrorCallback](
                 TilesetContentLoaderResult<TilesetContentLoader>&& result) {
@@ -773,6 +1541,18 @@ TilesetContentManager::TilesetContentManager(
       _tileLoadsInProgress{0},
       _loadedTilesCount{0},
       _tilesDataUsed{0},
+      _tilesGpuDataUsed{0},
+      _tilesDataLoaded{0},
+      _rasterOverlayMappingTime{0.0},
+      _tileStateVersion{0},
+      _selectionData{},
+      _maintainSelectionData{tilesetOptions.enablePackedSelectionData},
+      _batchingFrees{false},
+      _pendingFrees{},
+      _keepUnloadedContent{false},
+      _unloadedContents{},
+      _unloadedContentsReleasedFuture{
+          externals.asyncSystem.createResolvedFuture().share()},
       _destructionCompletePromise{externals.asyncSystem.createPromise<void>()},
       _destructionCompleteFuture{
           this->_destructionCompletePromise.getFuture().share()},
@@ -843,12 +1623,25 @@ TilesetContentManager::~TilesetContentManager() noexcept {
   assert(this->_tileLoadsInProgress == 0);
   this->unloadAll();
 
-  this->_destructionCompletePromise.resolve();
+  // Destroying a large tile tree takes a while, so do it in a worker thread,
+  // and only report that destruction is complete once that and the release of
+  // the unloaded content are done.
+  if (this->_pRootTile) {
+    clearMappedRasterTilesRecursively(*this->_pRootTile);
+  }
+  std::shared_ptr<Tile> pRootTile = std::move(this->_pRootTile);
+  this->_unloadedContentsReleasedFuture.thenInWorkerThread(
+      [pRootTile = std::move(pRootTile),
+       promise = this->_destructionCompletePromise]() mutable {
+        pRootTile.reset();
+        promise.resolve();
+      });
 }
 
 void TilesetContentManager::loadTileContent(
     Tile& tile,
-    const TilesetOptions& tilesetOptions) {
+    const TilesetOptions& tilesetOptions,
+    const CesiumAsync::TaskPriority& priority) {
   CESIUM_TRACE("TilesetContentManager::loadTileContent");
 
   if (tile.getState() == TileLoadState::Unloading) {
@@ -861,7 +1654,7 @@ void TilesetContentManager::loadTileContent(
     // No need to load geometry, but give previously-throttled
     // raster overlay tiles a chance to load.
     for (RasterMappedTo3DTile& rasterTile : tile.getMappedRasterTiles()) {
-      rasterTile.loadThrottled();
+      rasterTile.loadThrottled(priority);
     }
 
     return;
@@ -885,7 +1678,7 @@ void TilesetContentManager::loadTileContent(
     Tile* pParentTile = tile.getParent();
     if (pParentTile) {
       if (pParentTile->getState() != TileLoadState::Done) {
-        loadTileContent(*pParentTile, tilesetOptions);
+        loadTileContent(*pParentTile, tilesetOptions, priority);
 
         // Finalize the parent if necessary, otherwise it may never reach the
         // Done state. Also double check that we have render content in ensure
@@ -898,33 +1691,98 @@ void TilesetContentManager::loadTileContent(
         }
         return;
       }
+
+      // The parent's buffers or images may have been released once its
+      // renderer resources were prepared, in which case they are fetched again
+      // before upsampling from them.
+      const TileRenderContent* pParentRenderContent =
+          pParentTile->getContent().getRenderContent();
+      if (pParentRenderContent &&
+          pParentRenderContent->isModelDataReleased()) {
+        this->fetchReleasedModelData(*pParentTile, tilesetOptions, priority);
+        return;
+      }
     } else {
       // we cannot upsample this tile if it doesn't have parent
       return;
     }
   }
 
-  // map raster overlay to tile
-  std::vector<CesiumGeospatial::Projection> projections =
-      mapOverlaysToTile(tile, this->_overlayCollection, tilesetOptions);
+  this->startTileContentLoad(tile, tilesetOptions, true, priority);
+}
 
-  // begin loading tile
-  notifyTileStartLoading(&tile);
-  tile.setState(TileLoadState::ContentLoading);
+CesiumAsync::Future<TilePrecacheResult>
+TilesetContentManager::precacheTileContent(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions) {
+  assert(
+      (tile.getState() == TileLoadState::Unloaded ||
+       tile.getState() == TileLoadState::FailedTemporarily) &&
+      "The tile must not be loaded already");
+  assert(
+      !std::holds_alternative<CesiumGeometry::UpsampledQuadtreeNode>(
+          tile.getTileID()) &&
+      "Upsampled tiles have no content to fetch");
 
-  TileContentLoadInfo tileLoadInfo{
-      this->_externals.asyncSystem,
-      this->_externals.pAssetAccessor,
-      this->_externals.pPrepareRendererResources,
-      this->_externals.pLogger,
-      tilesetOptions.contentOptions,
-      tile};
+  CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
+  const CesiumAsync::TaskPriority priority;
+  return this->startTileContentLoad(tile, tilesetOptions, false, priority)
+      .thenImmediately([&tile, thiz, tilesetOptions]() {
+        TilePrecacheResult result{0, {}};
+        if (tile.getState() != TileLoadState::ContentLoaded) {
+          return result;
+        }
 
-  TilesetContentLoader* pLoader;
-  if (tile.getLoader() == &this->_upsampler) {
-    pLoader = &this->_upsampler;
-  } else {
-    pLoader = this->_pLoader.get();
+        result.bytesLoaded = tile.computeByteSize();
+
+        if (!tile.isRenderContent()) {
+          // Moves external tilesets and empty tiles to the Done state, and
+          // creates the children of implicit tiles.
+          thiz->updateTileContent(tile, tilesetOptions);
+          return result;
+        }
+
+        for (RasterMappedTo3DTile& mapped : tile.getMappedRasterTiles()) {
+          CesiumRasterOverlays::RasterOverlayTile* pLoading =
+              mapped.getLoadingTile();
+          if (pLoading && pLoading->getState() !=
+                              CesiumRasterOverlays::RasterOverlayTile::
+                                  LoadState::Placeholder) {
+            result.rasterOverlayTiles.emplace_back(pLoading);
+          }
+        }
+
+        // The content is in the cache now, and without render resources the
+        // tile can't be rendered, so unload it right away. The children it
+        // added are kept.
+        thiz->unloadTileContent(tile);
+        thiz->updateTileContent(tile, tilesetOptions);
+        return result;
+      });
+}
+
+CesiumAsync::Future<void> TilesetContentManager::loadTileChildren(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions) {
+  this->createLatentChildrenIfNecessary(tile);
+  if (!tile.getChildren().empty()) {
+    return this->_externals.asyncSystem.createResolvedFuture();
+  }
+
+  // The children of an external tileset are in its content, which is JSON
+  // and doesn't need renderer resources.
+  const TileLoadState state = tile.getState();
+  const std::string* pUrl = std::get_if<std::string>(&tile.getTileID());
+  if (pUrl && isExternalTilesetUrl(*pUrl) &&
+      (state == TileLoadState::Unloaded ||
+       state == TileLoadState::FailedTemporarily)) {
+    return this->precacheTileContent(tile, tilesetOptions)
+        .thenImmediately([](TilePrecacheResult&&) {});
+  }
+
+  // The loader already said that the tile has no children.
+  if (!tile.shouldContentContinueUpdating()) {
+    return this->_externals.asyncSystem.createResolvedFuture();
   }
 
   TileLoadInput loadInput{
@@ -935,50 +1793,235 @@ void TilesetContentManager::loadTileContent(
       this->_externals.pLogger,
       this->_requestHeaders};
 
+  // Keep the manager alive while the children are loaded.
+  CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
+  return this->_pLoader->loadTileChildren(loadInput).thenInMainThread(
+      [thiz, &tile]() { thiz->createLatentChildrenIfNecessary(tile); });
+}
+
+bool TilesetContentManager::fetchTileChildrenAhead(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions) {
+  // A tile that is loading creates its children itself.
+  const TileLoadState state = tile.getState();
+  if ((state != TileLoadState::Unloaded &&
+       state != TileLoadState::FailedTemporarily) ||
+      !tile.getChildren().empty() ||
+      std::holds_alternative<CesiumGeometry::UpsampledQuadtreeNode>(
+          tile.getTileID()) ||
+      this->_tilesFetchingChildren.count(&tile) > 0) {
+    return false;
+  }
+
+  // Other tiles only have children to fetch if the loader can't create them
+  // yet, like the roots of implicit tiling subtrees that aren't loaded.
+  const std::string* pUrl = std::get_if<std::string>(&tile.getTileID());
+  if (!pUrl || !isExternalTilesetUrl(*pUrl)) {
+    this->createLatentChildrenIfNecessary(tile);
+    if (!tile.getChildren().empty() || !tile.shouldContentContinueUpdating()) {
+      return false;
+    }
+  }
+
+  this->_tilesFetchingChildren.insert(&tile);
+
+  CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
+  const Tile* pTile = &tile;
+  std::shared_ptr<CesiumAsync::AdaptiveConcurrencyLimiter>
+      pConcurrencyLimiter = tilesetOptions.pSubtreeLoadConcurrencyLimiter;
+  const auto fetchStart = std::chrono::steady_clock::now();
+  this->loadTileChildren(tile, tilesetOptions)
+      .thenInMainThread([thiz, pTile, pConcurrencyLimiter, fetchStart]() {
+        thiz->_tilesFetchingChildren.erase(pTile);
+        if (pConcurrencyLimiter) {
+          const std::chrono::duration<double> fetchTime =
+              std::chrono::steady_clock::now() - fetchStart;
+          pConcurrencyLimiter->recordCompletion(fetchTime.count(), 0, true);
+        }
+      });
+  return true;
+}
+
+int32_t TilesetContentManager::getNumberOfTileChildrenFetches() const noexcept {
+  return static_cast<int32_t>(this->_tilesFetchingChildren.size());
+}
+
+CesiumAsync::Future<void> TilesetContentManager::startTileContentLoad(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions,
+    bool prepareRendererResources,
+    const CesiumAsync::TaskPriority& priority) {
+  // map raster overlay to tile, unless only the geometry is needed
+  std::vector<CesiumGeospatial::Projection> projections;
+  if (!tilesetOptions.contentOptions.geometryOnly) {
+    TimingScope timer(
+        tilesetOptions.enableViewUpdateTimings
+            ? &this->_rasterOverlayMappingTime
+            : nullptr);
+    projections = mapOverlaysToTile(
+        tile,
+        this->_overlayCollection,
+        tilesetOptions,
+        priority);
+  }
+
+  // Record when the load passes through each stage, if asked to. The
+  // requests of the loader are recorded by the asset accessor of the
+  // recorder.
+  std::shared_ptr<TileLoadTimelineRecorder> pTimelineRecorder;
+  if (tilesetOptions.enableTileLoadTimelines) {
+    startTileLoadTimeline(tile);
+    pTimelineRecorder =
+        TileLoadTimelineRecorder::create(this->_externals.pAssetAccessor);
+  }
+
+  // begin loading tile
+  notifyTileStartLoading(&tile);
+  this->setTileState(tile, TileLoadState::ContentLoading);
+
+  TileContentLoadInfo tileLoadInfo{
+      this->_externals.asyncSystem,
+      this->_externals.pAssetAccessor,
+      prepareRendererResources ? this->_externals.pPrepareRendererResources
+                               : nullptr,
+      this->_externals.pLogger,
+      tilesetOptions.contentOptions,
+      tile,
+      this->_externals.decodeThreadPool,
+      priority};
+  tileLoadInfo.pTimelineRecorder = pTimelineRecorder;
+
+  TilesetContentLoader* pLoader;
+  if (tile.getLoader() == &this->_upsampler) {
+    pLoader = &this->_upsampler;
+  } else {
+    pLoader = this->_pLoader.get();
+  }
+
+  // Content that was processed before with the same options is read back
+  // from the processed content cache, if there is one. Content processed for
+  // raster overlays is not cached.
+  if (tilesetOptions.contentOptions.pProcessedContentCache &&
+      projections.empty()) {
+    std::optional<std::string> maybeUrl = pLoader->getTileContentUrl(tile);
+    if (maybeUrl) {
+      tileLoadInfo.processedContentKey = ProcessedContentCache::computeKey(
+          *maybeUrl,
+          tilesetOptions.contentOptions,
+          tile.getTransform());
+      tileLoadInfo.processedContentUrl = std::move(*maybeUrl);
+    }
+  }
+
+  std::shared_ptr<std::atomic<bool>> pLoadCanceled =
+      std::make_shared<std::atomic<bool>>(false);
+  this->_tileLoadCancellations[&tile] = pLoadCanceled;
+
+  TileLoadInput loadInput{
+      tile,
+      tilesetOptions.contentOptions,
+      this->_externals.asyncSystem,
+      pTimelineRecorder ? pTimelineRecorder->getAssetAccessor()
+                        : this->_externals.pAssetAccessor,
+      this->_externals.pLogger,
+      this->_requestHeaders,
+      pLoadCanceled,
+      this->_externals.decodeThreadPool,
+      priority};
+
   // Keep the manager alive while the load is in progress.
   CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
 
-  pLoader->loadTileContent(loadInput)
-      .thenImmediately([tileLoadInfo = std::move(tileLoadInfo),
-                        projections = std::move(projections),
-                        rendererOptions = tilesetOptions.rendererOptions](
-                           TileLoadResult&& result) mutable {
-        // the reason we run immediate continuation, instead of in the
-        // worker thread, is that the loader may run the task in the main
-        // thread. And most often than not, those main thread task is very
-        // light weight. So when those tasks return, there is no need to
-        // spawn another worker thread if the result of the task isn't
-        // related to render content. We only ever spawn a new task in the
-        // worker thread if the content is a render content
-        if (result.state == TileLoadResultState::Success) {
-          if (std::holds_alternative<CesiumGltf::Model>(result.contentKind)) {
-            auto asyncSystem = tileLoadInfo.asyncSystem;
-            return asyncSystem.runInWorkerThread(
-                [result = std::move(result),
-                 projections = std::move(projections),
-                 tileLoadInfo = std::move(tileLoadInfo),
-                 rendererOptions]() mutable {
-                  return postProcessContentInWorkerThread(
-                      std::move(result),
-                      std::move(projections),
-                      std::move(tileLoadInfo),
-                      rendererOptions);
-                });
-          }
+  // Tell the eviction policy how long the tile took to load, so it can weigh
+  // the cost of loading the tile again.
+  std::shared_ptr<ITileEvictionPolicy> pEvictionPolicy =
+      tilesetOptions.evictionPolicy;
+  const auto loadStart = std::chrono::steady_clock::now();
+
+  // And tell the concurrency limiter, if there is one, how long it took and
+  // whether it succeeded, unless it was canceled.
+  std::shared_ptr<CesiumAsync::AdaptiveConcurrencyLimiter>
+      pConcurrencyLimiter = tilesetOptions.pTileLoadConcurrencyLimiter;
+
+  CesiumAsync::Future<TileLoadResultAndRenderResources> futureContent =
+      tileLoadInfo.processedContentKey
+          ? loadProcessedTileContent(
+                *pLoader,
+                loadInput,
+                std::move(tileLoadInfo),
+                std::move(projections),
+                tilesetOptions.rendererOptions,
+                pLoadCanceled)
+          : loadAndProcessTileContent(
+                *pLoader,
+                loadInput,
+                std::move(tileLoadInfo),
+                std::move(projections),
+                tilesetOptions.rendererOptions,
+                pLoadCanceled);
+
+  return std::move(futureContent)
+      .thenInMainThread([&tile,
+                         thiz,
+                         pEvictionPolicy,
+                         pConcurrencyLimiter,
+                         pLoadCanceled,
+                         pTimelineRecorder,
+                         loadStart](TileLoadResultAndRenderResources&& pair) {
+        thiz->_tileLoadCancellations.erase(&tile);
+        if (pTimelineRecorder && tile._pLoadTimeline) {
+          tile._pLoadTimeline->merge(pTimelineRecorder->getTimeline());
         }
 
-        return tileLoadInfo.asyncSystem
-            .createResolvedFuture<TileLoadResultAndRenderResources>(
-                {std::move(result), nullptr});
-      })
-      .thenInMainThread([&tile, thiz](TileLoadResultAndRenderResources&& pair) {
         setTileContent(tile, std::move(pair.result), pair.pRenderResources);
+        notifyLoaderIfNoContent(tile);
+
+        // Loads that succeed are added once the tile is done.
+        if (!*pLoadCanceled &&
+            (tile.getState() == TileLoadState::Failed ||
+             tile.getState() == TileLoadState::FailedTemporarily)) {
+          thiz->addToTileLoadHistograms(tile);
+        }
+
+        const std::chrono::duration<double> loadTime =
+            std::chrono::steady_clock::now() - loadStart;
+        if (pEvictionPolicy &&
+            tile.getState() == TileLoadState::ContentLoaded) {
+          pEvictionPolicy->notifyTileLoaded(tile, loadTime.count());
+        }
+
+        if (pConcurrencyLimiter && !*pLoadCanceled) {
+          const bool succeeded = tile.getState() != TileLoadState::Failed &&
+                                 tile.getState() !=
+                                     TileLoadState::FailedTemporarily;
+          pConcurrencyLimiter->recordCompletion(
+              loadTime.count(),
+              succeeded ? tile.computeByteSize() : 0,
+              succeeded);
+        }
+
+        // The content may have updated the bounding volume or added children.
+        if (thiz->_maintainSelectionData) {
+          thiz->_selectionData.registerSubtree(tile);
+        }
 
         thiz->notifyTileDoneLoading(&tile);
       })
-      .catchInMainThread([pLogger = this->_externals.pLogger, &tile, thiz](
-                             std::exception&& e) {
+      .catchInMainThread([pLogger = this->_externals.pLogger,
+                          &tile,
+                          thiz,
+                          pConcurrencyLimiter,
+                          loadStart](std::exception&& e) {
+        thiz->_tileLoadCancellations.erase(&tile);
+        notifyLoaderIfNoContent(tile);
         thiz->notifyTileDoneLoading(&tile);
+
+        if (pConcurrencyLimiter) {
+          const std::chrono::duration<double> loadTime =
+              std::chrono::steady_clock::now() - loadStart;
+          pConcurrencyLimiter->recordCompletion(loadTime.count(), 0, false);
+        }
+
         SPDLOG_LOGGER_ERROR(
             pLogger,
             "An unexpected error occurs when loading tile: {}",
@@ -986,9 +2029,130 @@ void TilesetContentManager::loadTileContent(
       });
 }
 
+void TilesetContentManager::fetchReleasedModelData(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions,
+    const CesiumAsync::TaskPriority& priority) {
+  if (!this->_tilesFetchingModelData.insert(&tile).second) {
+    // The data is already being fetched.
+    return;
+  }
+
+  // The timeline of the original load is over.
+  if (tile._pLoadTimeline) {
+    tile._pLoadTimeline->clear();
+  }
+
+  // Generate the same raster overlay texture coordinates as before.
+  std::vector<CesiumGeospatial::Projection> projections =
+      tile.getContent()
+          .getRenderContent()
+          ->getRasterOverlayDetails()
+          .rasterOverlayProjections;
+
+  // Only the model is needed, so no renderer resources are prepared.
+  TileContentLoadInfo tileLoadInfo{
+      this->_externals.asyncSystem,
+      this->_externals.pAssetAccessor,
+      nullptr,
+      this->_externals.pLogger,
+      tilesetOptions.contentOptions,
+      tile,
+      this->_externals.decodeThreadPool,
+      priority};
+
+  TileLoadInput loadInput{
+      tile,
+      tilesetOptions.contentOptions,
+      this->_externals.asyncSystem,
+      this->_externals.pAssetAccessor,
+      this->_externals.pLogger,
+      this->_requestHeaders,
+      nullptr,
+      this->_externals.decodeThreadPool,
+      priority};
+
+  // Count the fetch as a load in progress, so that waiting until the tileset
+  // is idle also waits for it.
+  ++this->_tileLoadsInProgress;
+  CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
+
+  this->_pLoader->loadTileContent(loadInput)
+      .thenImmediately([tileLoadInfo = std::move(tileLoadInfo),
+                        projections = std::move(projections)](
+                           TileLoadResult&& result) mutable {
+        if (result.state != TileLoadResultState::Success ||
+            !std::holds_alternative<CesiumGltf::Model>(result.contentKind)) {
+          return tileLoadInfo.asyncSystem
+              .createResolvedFuture<TileLoadResultAndRenderResources>(
+                  {std::move(result), nullptr});
+        }
+
+        auto asyncSystem = tileLoadInfo.asyncSystem;
+        auto decodeThreadPool = tileLoadInfo.decodeThreadPool;
+        auto priority = tileLoadInfo.priority;
+        return runInDecodeThread(
+            asyncSystem,
+            decodeThreadPool,
+            priority,
+            [result = std::move(result),
+             projections = std::move(projections),
+             tileLoadInfo = std::move(tileLoadInfo)]() mutable {
+              return postProcessContentInWorkerThread(
+                  std::move(result),
+                  std::move(projections),
+                  std::move(tileLoadInfo),
+                  std::any());
+            });
+      })
+      .thenInMainThread(
+          [&tile, thiz](TileLoadResultAndRenderResources&& pair) {
+            thiz->_tilesFetchingModelData.erase(&tile);
+            --thiz->_tileLoadsInProgress;
+
+            TileRenderContent* pRenderContent =
+                tile.getContent().getRenderContent();
+            if (tile.getState() != TileLoadState::Done || !pRenderContent ||
+                !pRenderContent->isModelDataReleased()) {
+              return;
+            }
+
+            CesiumGltf::Model* pModel =
+                std::get_if<CesiumGltf::Model>(&pair.result.contentKind);
+            if (pair.result.state == TileLoadResultState::Success && pModel) {
+              thiz->_tilesDataUsed -= tile.computeByteSize();
+              pRenderContent->setModel(std::move(*pModel));
+              thiz->_tilesDataUsed += tile.computeByteSize();
+            }
+
+            // If the fetch failed, upsampling goes ahead without the data and
+            // fails, rather than fetching it again and again.
+            pRenderContent->setModelDataReleased(false);
+            ++thiz->_tileStateVersion;
+          })
+      .catchInMainThread([pLogger = this->_externals.pLogger, &tile, thiz](
+                             std::exception&& e) {
+        thiz->_tilesFetchingModelData.erase(&tile);
+        --thiz->_tileLoadsInProgress;
+
+        TileRenderContent* pRenderContent =
+            tile.getContent().getRenderContent();
+        if (pRenderContent) {
+          pRenderContent->setModelDataReleased(false);
+        }
+
+        SPDLOG_LOGGER_ERROR(
+            pLogger,
+            "An unexpected error occurs when fetching tile data again: {}",
+            e.what());
+      });
+}
+
 void TilesetContentManager::updateTileContent(
     Tile& tile,
     const TilesetOptions& tilesetOptions) {
+  const TileLoadState previousState = tile.getState();
+
   if (tile.getState() == TileLoadState::Unloading) {
     unloadTileContent(tile);
   }
@@ -1001,19 +2165,37 @@ void TilesetContentManager::updateTileContent(
     updateDoneState(tile, tilesetOptions);
   }
 
-  if (tile.shouldContentContinueUpdating()) {
-    TileChildrenResult childrenResult =
-        this->_pLoader->createTileChildren(tile);
-    if (childrenResult.state == TileLoadResultState::Success) {
-      tile.createChildTiles(std::move(childrenResult.children));
-    }
+  this->createLatentChildrenIfNecessary(tile);
+
+  // Updating the raster overlays may have made the tile renderable.
+  if (this->_maintainSelectionData) {
+    this->_selectionData.updateRenderable(tile);
+  }
 
-    bool shouldTileContinueUpdated =
-        childrenResult.state == TileLoadResultState::RetryLater;
-    tile.setContentShouldContinueUpdating(shouldTileContinueUpdated);
+  if (tile.getState() != previousState) {
+    ++this->_tileStateVersion;
   }
 }
 
+void TilesetContentManager::createLatentChildrenIfNecessary(Tile& tile) {
+  if (!tile.shouldContentContinueUpdating()) {
+    return;
+  }
+
+  TileChildrenResult childrenResult = this->_pLoader->createTileChildren(tile);
+  if (childrenResult.state == TileLoadResultState::Success) {
+    tile.createChildTiles(std::move(childrenResult.children));
+    if (this->_maintainSelectionData) {
+      this->_selectionData.registerSubtree(tile);
+    }
+    ++this->_tileStateVersion;
+  }
+
+  bool shouldTileContinueUpdated =
+      childrenResult.state == TileLoadResultState::RetryLater;
+  tile.setContentShouldContinueUpdating(shouldTileContinueUpdated);
+}
+
 bool TilesetContentManager::unloadTileContent(Tile& tile) {
   TileLoadState state = tile.getState();
   if (state == TileLoadState::Unloaded) {
@@ -1031,8 +2213,11 @@ bool TilesetContentManager::unloadTileContent(Tile& tile) {
     return false;
   }
 
+  ++this->_tileStateVersion;
+
   // Detach raster tiles first so that the renderer's tile free
   // process doesn't need to worry about them.
+  this->detachRasterOverlayAtlas(tile);
   for (RasterMappedTo3DTile& mapped : tile.getMappedRasterTiles()) {
     mapped.detachFromTile(*this->_externals.pPrepareRendererResources, tile);
   }
@@ -1052,24 +2237,43 @@ bool TilesetContentManager::unloadTileContent(Tile& tile) {
     break;
   }
 
-  // Are any children currently being upsampled from this tile?
-  for (const Tile& child : tile.getChildren()) {
-    if (child.getState() == TileLoadState::ContentLoading &&
-        std::holds_alternative<CesiumGeometry::UpsampledQuadtreeNode>(
-            child.getTileID())) {
-      // Yes, a child is upsampling from this tile, so it may be using the
-      // tile's content from another thread via lambda capture. We can't unload
-      // it right now. So mark the tile as in the process of unloading and stop
-      // here.
-      tile.setState(TileLoadState::Unloading);
-      return false;
-    }
+  // Is the released model data of this tile being fetched again, or are
+  // raster overlay texture coordinates being added to it? Both continue with
+  // the tile when they complete, so finish unloading after that.
+  if (this->_tilesFetchingModelData.count(&tile) > 0 ||
+      this->_tilesAddingOverlayTextureCoordinates.count(&tile) > 0) {
+    this->setTileState(tile, TileLoadState::Unloading);
+    return false;
+  }
+
+  // Are any children currently being upsampled from this tile? If so, we
+  // can't unload it right now. So mark the tile as in the process of unloading
+  // and stop here.
+  if (isAnyChildUpsampling(tile)) {
+    this->setTileState(tile, TileLoadState::Unloading);
+    return false;
   }
 
   // If we make it this far, the tile's content will be fully unloaded.
   notifyTileUnloading(&tile);
+  if (this->_keepUnloadedContent) {
+    this->_unloadedContents.emplace_back(std::move(content));
+  } else if (TileRenderContent* pRenderContent = content.getRenderContent()) {
+    for (CesiumGltf::Image& image : pRenderContent->getModel().images) {
+      CesiumUtility::PixelBufferPool::getDefault().release(
+          image.cesium.pixelData);
+    }
+  }
   content.setContentKind(TileUnknownContent{});
-  tile.setState(TileLoadState::Unloaded);
+  this->setTileState(tile, TileLoadState::Unloaded);
+  this->_upsampler.notifyParentContentUnloaded(tile);
+
+  // The loader was already told when a failed load finished.
+  if (state != TileLoadState::Failed &&
+      state != TileLoadState::FailedTemporarily && tile.getLoader()) {
+    tile.getLoader()->notifyTileContentUnloaded(tile);
+  }
+
   return true;
 }
 
@@ -1081,6 +2285,36 @@ void TilesetContentManager::unloadAll() {
   }
 }
 
+void TilesetContentManager::releaseAll(bool batchRendererFrees) {
+  if (batchRendererFrees) {
+    this->beginBatchingFrees();
+  }
+
+  this->_keepUnloadedContent = true;
+  this->unloadAll();
+  this->_keepUnloadedContent = false;
+
+  if (batchRendererFrees) {
+    this->endBatchingFrees();
+  }
+
+  if (this->_unloadedContents.empty()) {
+    return;
+  }
+
+  // Release the models in a worker thread, so that the main thread doesn't
+  // wait for that.
+  std::shared_ptr<std::vector<TileContent>> pContents =
+      std::make_shared<std::vector<TileContent>>(
+          std::move(this->_unloadedContents));
+  this->_unloadedContents.clear();
+
+  this->_unloadedContentsReleasedFuture =
+      this->_unloadedContentsReleasedFuture
+          .thenInWorkerThread([pContents]() { pContents->clear(); })
+          .share();
+}
+
 void TilesetContentManager::waitUntilIdle() {
   // Wait for all asynchronous loading to terminate.
   // If you're hanging here, it's most likely caused by _tileLoadsInProgress not
@@ -1163,6 +2397,149 @@ int64_t TilesetContentManager::getTotalDataUsed() const noexcept {
   return bytes;
 }
 
+int64_t
+TilesetContentManager::trimMemory(const TilesetOptions& tilesetOptions) {
+  int64_t bytesReleased = 0;
+  if (this->_pLoader) {
+    bytesReleased += this->_pLoader->trimMemory();
+  }
+
+  for (const CesiumUtility::IntrusivePointer<RasterOverlayTileProvider>&
+           pProvider : this->_overlayCollection.getTileProviders()) {
+    bytesReleased += pProvider->trimCachedData();
+  }
+
+  const std::shared_ptr<DecodedContentCache>& pDecodedContentCache =
+      tilesetOptions.contentOptions.pDecodedContentCache;
+  if (pDecodedContentCache) {
+    bytesReleased += pDecodedContentCache->clear();
+  }
+
+  bytesReleased += CesiumUtility::PixelBufferPool::getDefault().clear();
+
+  return bytesReleased;
+}
+
+void TilesetContentManager::addMemoryUsage(
+    const Tile::LoadedLinkedList& loadedTiles,
+    TilesetMemoryUsage& usage) const {
+  for (const Tile* pTile = loadedTiles.head(); pTile != nullptr;
+       pTile = loadedTiles.next(*pTile)) {
+    const TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    if (pRenderContent) {
+      addModelMemoryUsage(pRenderContent->getModel(), usage);
+      const TileFeatureIndex* pFeatureIndex =
+          pRenderContent->getFeatureIndex();
+      if (pFeatureIndex) {
+        usage.metadataBytes += pFeatureIndex->getSizeBytes();
+      }
+      for (const CesiumGltf::PackedPropertyTable& packedPropertyTable :
+           pRenderContent->getPackedPropertyTables()) {
+        usage.metadataBytes += packedPropertyTable.getSizeBytes();
+      }
+      const TileGeometryIndex* pGeometryIndex =
+          pRenderContent->getGeometryIndex();
+      if (pGeometryIndex) {
+        usage.geometryBytes += pGeometryIndex->getSizeBytes();
+      }
+    }
+  }
+
+  if (this->_pLoader) {
+    this->_pLoader->addMemoryUsage(usage);
+  }
+
+  for (const auto& pTileProvider :
+       this->_overlayCollection.getTileProviders()) {
+    usage.overlayImageBytes += pTileProvider->getTileDataBytes();
+    usage.overlayCacheBytes += pTileProvider->getCachedDataBytes();
+  }
+}
+
+int64_t TilesetContentManager::getTotalGpuDataUsed() const noexcept {
+  int64_t bytes = this->_tilesGpuDataUsed;
+  for (const auto& pTileProvider :
+       this->_overlayCollection.getTileProviders()) {
+    bytes += pTileProvider->getTileGpuBytes();
+  }
+
+  return bytes;
+}
+
+int64_t TilesetContentManager::getTotalDataLoaded() const noexcept {
+  return this->_tilesDataLoaded;
+}
+
+double TilesetContentManager::takeRasterOverlayMappingTime() noexcept {
+  const double time = this->_rasterOverlayMappingTime;
+  this->_rasterOverlayMappingTime = 0.0;
+  return time;
+}
+
+void TilesetContentManager::recordTileQueuedForLoad(Tile& tile) const {
+  const TileLoadState state = tile.getState();
+  if (state != TileLoadState::Unloaded &&
+      state != TileLoadState::FailedTemporarily) {
+    return;
+  }
+
+  // A tile is usually queued again in each frame until its load starts, so
+  // the timeline keeps the first time.
+  startTileLoadTimeline(tile).recordFirst(TileLoadEvent::Queued);
+}
+
+const TileLoadHistograms&
+TilesetContentManager::getTileLoadHistograms() const noexcept {
+  return this->_tileLoadHistograms;
+}
+
+void TilesetContentManager::resetTileLoadHistograms() noexcept {
+  this->_tileLoadHistograms = TileLoadHistograms();
+}
+
+bool TilesetContentManager::isFinalLeafTile(const Tile& tile) noexcept {
+  // Only tiles from a tileset.json have string IDs. Implicit, terrain and
+  // upsampled tiles may get children at any time.
+  return tile.getChildren().empty() && tile.getContent().isRenderContent() &&
+         !tile.shouldContentContinueUpdating() &&
+         std::holds_alternative<std::string>(tile.getTileID());
+}
+
+bool TilesetContentManager::cancelTileContentLoad(const Tile& tile) noexcept {
+  auto it = this->_tileLoadCancellations.find(&tile);
+  if (it == this->_tileLoadCancellations.end()) {
+    return false;
+  }
+
+  *it->second = true;
+  this->_tileLoadCancellations.erase(it);
+  return true;
+}
+
+uint64_t TilesetContentManager::getTileStateVersion() const noexcept {
+  return this->_tileStateVersion;
+}
+
+const TileSelectionDataTable*
+TilesetContentManager::getSelectionDataTable() const noexcept {
+  return this->_maintainSelectionData ? &this->_selectionData : nullptr;
+}
+
+TileSelectionDataTable*
+TilesetContentManager::getSelectionDataTable() noexcept {
+  return this->_maintainSelectionData ? &this->_selectionData : nullptr;
+}
+
+void TilesetContentManager::setTileState(
+    Tile& tile,
+    TileLoadState state) noexcept {
+  tile.setState(state);
+  if (this->_maintainSelectionData) {
+    this->_selectionData.updateRenderable(tile);
+  }
+}
+
 bool TilesetContentManager::tileNeedsWorkerThreadLoading(
     const Tile& tile) const noexcept {
   auto state = tile.getState();
@@ -1180,6 +2557,15 @@ bool TilesetContentManager::tileNeedsMainThreadLoading(
 void TilesetContentManager::finishLoading(
     Tile& tile,
     const TilesetOptions& tilesetOptions) {
+  MainThreadLoadBudget unlimited;
+  while (!this->finishLoading(tile, tilesetOptions, unlimited)) {
+  }
+}
+
+bool TilesetContentManager::finishLoading(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions,
+    MainThreadLoadBudget& budget) {
   assert(tile.getState() == TileLoadState::ContentLoaded);
 
   // Run the main thread part of loading.
@@ -1188,6 +2574,82 @@ void TilesetContentManager::finishLoading(
 
   assert(pRenderContent != nullptr);
 
+  void* pWorkerRenderResources = pRenderContent->getRenderResources();
+  const auto start = std::chrono::steady_clock::now();
+  if (tile._pLoadTimeline) {
+    tile._pLoadTimeline->recordFirst(
+        TileLoadEvent::PrepareInMainThreadStarted,
+        start);
+  }
+
+  const MainThreadPrepareResult prepared =
+      this->_externals.pPrepareRendererResources
+          ->prepareInMainThreadIncrementally(
+              tile,
+              pWorkerRenderResources,
+              budget);
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  budget.milliseconds -= elapsed.count();
+  budget.bytes -= prepared.bytesProcessed;
+
+  if (!prepared.complete) {
+    // The renderer continues from its load thread result in a later frame.
+    return false;
+  }
+
+  this->completeLoading(tile, tilesetOptions, prepared.pMainThreadResult);
+  return true;
+}
+
+void TilesetContentManager::finishLoading(
+    gsl::span<Tile* const> tiles,
+    const TilesetOptions& tilesetOptions) {
+  std::vector<TileRendererResources> batch;
+  batch.reserve(tiles.size());
+  for (Tile* pTile : tiles) {
+    if (pTile->getState() != TileLoadState::ContentLoaded) {
+      continue;
+    }
+
+    TileRenderContent* pRenderContent = pTile->getContent().getRenderContent();
+    if (pRenderContent) {
+      batch.push_back({pTile, pRenderContent->getRenderResources(), nullptr});
+    }
+  }
+
+  if (batch.empty()) {
+    return;
+  }
+
+  const TileLoadTimeline::Clock::time_point start =
+      TileLoadTimeline::Clock::now();
+  for (const TileRendererResources& resources : batch) {
+    if (resources.pTile->_pLoadTimeline) {
+      resources.pTile->_pLoadTimeline->recordFirst(
+          TileLoadEvent::PrepareInMainThreadStarted,
+          start);
+    }
+  }
+
+  this->_externals.pPrepareRendererResources->prepareInMainThreadBatch(batch);
+
+  for (const TileRendererResources& resources : batch) {
+    this->completeLoading(
+        *resources.pTile,
+        tilesetOptions,
+        resources.pMainThreadResult);
+  }
+}
+
+void TilesetContentManager::completeLoading(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions,
+    void* pMainThreadRenderResources) {
+  assert(tile.getState() == TileLoadState::ContentLoaded);
+  TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+  assert(pRenderContent != nullptr);
+
   // add copyright
   CreditSystem* pCreditSystem = this->_externals.pCreditSystem.get();
   if (pCreditSystem) {
@@ -1206,24 +2668,71 @@ void TilesetContentManager::finishLoading(
     pRenderContent->setCredits(credits);
   }
 
-  void* pWorkerRenderResources = pRenderContent->getRenderResources();
-  void* pMainThreadRenderResources =
-      this->_externals.pPrepareRendererResources->prepareInMainThread(
+  pRenderContent->setRenderResources(pMainThreadRenderResources);
+
+  const int64_t gpuBytes =
+      this->_externals.pPrepareRendererResources->getGpuByteSize(
           tile,
-          pWorkerRenderResources);
+          pMainThreadRenderResources);
+  pRenderContent->setGpuByteSize(gpuBytes);
+  this->_tilesGpuDataUsed += gpuBytes;
+
+  // Upsampled content can't be fetched again, so it is always kept.
+  const TilesetContentOptions& contentOptions = tilesetOptions.contentOptions;
+  if ((contentOptions.releaseBufferDataAfterPrepare ||
+       contentOptions.releaseImageDataAfterPrepare) &&
+      !std::holds_alternative<CesiumGeometry::UpsampledQuadtreeNode>(
+          tile.getTileID())) {
+    const int64_t bytesBefore = tile.computeByteSize();
+    releaseModelData(pRenderContent->getModel(), contentOptions);
+    pRenderContent->setModelDataReleased(true);
+    this->_tilesDataUsed -= bytesBefore - tile.computeByteSize();
+  }
 
-  pRenderContent->setRenderResources(pMainThreadRenderResources);
-  tile.setState(TileLoadState::Done);
+  this->setTileState(tile, TileLoadState::Done);
+  ++this->_tileStateVersion;
+  this->addToTileLoadHistograms(tile);
 
   // This allows the raster tile to be updated and children to be created, if
   // necessary.
   updateTileContent(tile, tilesetOptions);
 }
 
+void TilesetContentManager::beginBatchingFrees() noexcept {
+  this->_batchingFrees = true;
+}
+
+void TilesetContentManager::endBatchingFrees() noexcept {
+  this->_batchingFrees = false;
+  if (this->_pendingFrees.empty()) {
+    return;
+  }
+
+  this->_externals.pPrepareRendererResources->freeBatch(this->_pendingFrees);
+  this->_pendingFrees.clear();
+}
+
+void TilesetContentManager::freeRenderResources(
+    Tile& tile,
+    void* pLoadThreadResult,
+    void* pMainThreadResult) noexcept {
+  if (this->_batchingFrees) {
+    this->_pendingFrees.push_back(
+        {&tile, pLoadThreadResult, pMainThreadResult});
+  } else {
+    this->_externals.pPrepareRendererResources->free(
+        tile,
+        pLoadThreadResult,
+        pMainThreadResult);
+  }
+}
+
 void TilesetContentManager::setTileContent(
     Tile& tile,
     TileLoadResult&& result,
     void* pWorkerRenderResources) {
+  getTileContentLoadsCounter(result.state).increment();
+
   if (result.state == TileLoadResultState::Failed) {
     tile.getMappedRasterTiles().clear();
     tile.setState(TileLoadState::Failed);
@@ -1264,12 +2773,18 @@ void TilesetContentManager::updateContentLoadedState(
   if (content.isExternalContent()) {
     // if tile is external tileset, then it will be refined no matter what
     tile.setUnconditionallyRefine();
-    tile.setState(TileLoadState::Done);
+    this->setTileState(tile, TileLoadState::Done);
+    this->addToTileLoadHistograms(tile);
+    if (this->_maintainSelectionData) {
+      this->_selectionData.update(tile);
+    }
   } else if (content.isRenderContent()) {
     // If the main thread part of render content loading is not throttled,
     // do it right away. Otherwise we'll do it later in
     // Tileset::_processMainThreadLoadQueue with prioritization and throttling.
-    if (tilesetOptions.mainThreadLoadingTimeLimit <= 0.0) {
+    if (tilesetOptions.mainThreadLoadingTimeLimit <= 0.0 &&
+        tilesetOptions.mainThreadLoadingByteLimit <= 0 &&
+        !tilesetOptions.batchRendererResourceCalls) {
       finishLoading(tile, tilesetOptions);
     }
   } else if (content.isEmptyContent()) {
@@ -1301,9 +2816,13 @@ void TilesetContentManager::updateContentLoadedState(
                                       : myGeometricError * 2.0;
     if (myGeometricError >= parentGeometricError) {
       tile.setUnconditionallyRefine();
+      if (this->_maintainSelectionData) {
+        this->_selectionData.update(tile);
+      }
     }
 
-    tile.setState(TileLoadState::Done);
+    this->setTileState(tile, TileLoadState::Done);
+    this->addToTileLoadHistograms(tile);
   }
 }
 
@@ -1330,52 +2849,30 @@ void TilesetContentManager::updateDoneState(
   TileContent& content = tile.getContent();
   const TileRenderContent* pRenderContent = content.getRenderContent();
   if (pRenderContent) {
+    TimingScope timer(
+        tilesetOptions.enableViewUpdateTimings
+            ? &this->_rasterOverlayMappingTime
+            : nullptr);
+
+    // Replace the placeholders of the overlays whose tile providers have been
+    // created with real raster tiles. If the number of tiles that are mapped
+    // each frame is limited, the tile waits for
+    // processRasterOverlayMappings instead.
+    if (this->hasRasterOverlayPlaceholdersToMap(tile)) {
+      if (tilesetOptions.rasterOverlayMappingTileLimit > 0) {
+        this->_tilesWaitingForOverlayMapping.emplace_back(&tile);
+      } else if (!this->mapRasterOverlayPlaceholders(tile, tilesetOptions)) {
+        return;
+      }
+    }
+
     bool moreRasterDetailAvailable = false;
     bool skippedUnknown = false;
-    std::vector<RasterMappedTo3DTile>& rasterTiles =
-        tile.getMappedRasterTiles();
-    for (size_t i = 0; i < rasterTiles.size(); ++i) {
-      RasterMappedTo3DTile& mappedRasterTile = rasterTiles[i];
-
+    for (RasterMappedTo3DTile& mappedRasterTile :
+         tile.getMappedRasterTiles()) {
       RasterOverlayTile* pLoadingTile = mappedRasterTile.getLoadingTile();
       if (pLoadingTile && pLoadingTile->getState() ==
                               RasterOverlayTile::LoadState::Placeholder) {
-        RasterOverlayTileProvider* pProvider =
-            this->_overlayCollection.findTileProviderForOverlay(
-                pLoadingTile->getOverlay());
-        RasterOverlayTileProvider* pPlaceholder =
-            this->_overlayCollection.findPlaceholderTileProviderForOverlay(
-                pLoadingTile->getOverlay());
-
-        // Try to replace this placeholder with real tiles.
-        if (pProvider && pPlaceholder && !pProvider->isPlaceholder()) {
-          // Remove the existing placeholder mapping
-          rasterTiles.erase(
-              rasterTiles.begin() +
-              static_cast<std::vector<RasterMappedTo3DTile>::difference_type>(
-                  i));
-          --i;
-
-          // Add a new mapping.
-          std::vector<CesiumGeospatial::Projection> missingProjections;
-          RasterMappedTo3DTile::mapOverlayToTile(
-              tilesetOptions.maximumScreenSpaceError,
-              *pProvider,
-              *pPlaceholder,
-              tile,
-              missingProjections);
-
-          if (!missingProjections.empty()) {
-            // The mesh doesn't have the right texture coordinates for this
-            // overlay's projection, so we need to kick it back to the unloaded
-            // state to fix that.
-            // In the future, we could add the ability to add the required
-            // texture coordinates without starting over from scratch.
-            unloadTileContent(tile);
-            return;
-          }
-        }
-
         continue;
       }
 
@@ -1394,12 +2891,19 @@ void TilesetContentManager::updateDoneState(
           moreDetailAvailable == RasterOverlayTile::MoreDetailAvailable::Yes;
     }
 
+    if (tilesetOptions.packRasterOverlaysIntoAtlas) {
+      this->updateRasterOverlayAtlas(tile);
+    }
+
     // If this tile still has no children after it's done loading, but it does
     // have raster tiles that are not the most detailed available, create fake
     // children to hang more detailed rasters on by subdividing this tile.
     if (!skippedUnknown && moreRasterDetailAvailable &&
         tile.getChildren().empty()) {
       createQuadtreeSubdividedChildren(tile, this->_upsampler);
+      if (this->_maintainSelectionData) {
+        this->_selectionData.registerSubtree(tile);
+      }
     }
   } else {
     // We can't hang raster images on a tile without geometry, and their
@@ -1409,16 +2913,345 @@ void TilesetContentManager::updateDoneState(
   }
 }
 
+bool TilesetContentManager::hasRasterOverlayPlaceholdersToMap(
+    const Tile& tile) const noexcept {
+  // The placeholders of a tile whose texture coordinates are being added are
+  // mapped once the coordinates are there.
+  if (this->_tilesAddingOverlayTextureCoordinates.count(&tile) > 0) {
+    return false;
+  }
+
+  for (const RasterMappedTo3DTile& mapped : tile.getMappedRasterTiles()) {
+    const RasterOverlayTile* pLoadingTile = mapped.getLoadingTile();
+    if (pLoadingTile && pLoadingTile->getState() ==
+                            RasterOverlayTile::LoadState::Placeholder) {
+      const RasterOverlayTileProvider* pProvider =
+          this->_overlayCollection.findTileProviderForOverlay(
+              pLoadingTile->getOverlay());
+      if (pProvider && !pProvider->isPlaceholder()) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+bool TilesetContentManager::mapRasterOverlayPlaceholders(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions) {
+  std::vector<RasterMappedTo3DTile>& rasterTiles = tile.getMappedRasterTiles();
+  std::vector<CesiumGeospatial::Projection> missingProjections;
+
+  // New mappings are added to the end, so only the existing ones are visited.
+  size_t existingCount = rasterTiles.size();
+  for (size_t i = 0; i < existingCount; ++i) {
+    RasterOverlayTile* pLoadingTile = rasterTiles[i].getLoadingTile();
+    if (!pLoadingTile || pLoadingTile->getState() !=
+                             RasterOverlayTile::LoadState::Placeholder) {
+      continue;
+    }
+
+    RasterOverlayTileProvider* pProvider =
+        this->_overlayCollection.findTileProviderForOverlay(
+            pLoadingTile->getOverlay());
+    RasterOverlayTileProvider* pPlaceholder =
+        this->_overlayCollection.findPlaceholderTileProviderForOverlay(
+            pLoadingTile->getOverlay());
+    if (!pProvider || !pPlaceholder || pProvider->isPlaceholder()) {
+      continue;
+    }
+
+    // Remove the existing placeholder mapping
+    rasterTiles.erase(
+        rasterTiles.begin() +
+        static_cast<std::vector<RasterMappedTo3DTile>::difference_type>(i));
+    --i;
+    --existingCount;
+
+    // Add a new mapping.
+    RasterMappedTo3DTile::mapOverlayToTile(
+        tilesetOptions.maximumScreenSpaceError,
+        *pProvider,
+        *pPlaceholder,
+        tile,
+        missingProjections);
+  }
+
+  if (missingProjections.empty()) {
+    return true;
+  }
+
+  // The mesh doesn't have the right texture coordinates for the projections
+  // of some overlays. They are added to a copy of the model in a worker
+  // thread, unless its buffers were released, in which case we need to kick
+  // the tile back to the unloaded state to fix that.
+  const TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  if (pRenderContent && !pRenderContent->isModelDataReleased()) {
+    this->addRasterOverlayTextureCoordinates(
+        tile,
+        std::move(missingProjections),
+        tilesetOptions);
+    return true;
+  }
+
+  unloadTileContent(tile);
+  return false;
+}
+
+void TilesetContentManager::addRasterOverlayTextureCoordinates(
+    Tile& tile,
+    std::vector<CesiumGeospatial::Projection>&& projections,
+    const TilesetOptions& tilesetOptions) {
+  const TileRenderContent& renderContent =
+      *tile.getContent().getRenderContent();
+  const size_t existingProjectionCount =
+      renderContent.getRasterOverlayDetails().rasterOverlayProjections.size();
+
+  // Use the same rectangle as when the tile was loaded.
+  const CesiumGeospatial::BoundingRegion* pRegion =
+      getBoundingRegionFromBoundingVolume(getEffectiveContentBoundingVolume(
+          tile.getBoundingVolume(),
+          tile.getContentBoundingVolume(),
+          std::nullopt,
+          std::nullopt));
+  std::optional<CesiumGeospatial::GlobeRectangle> maybeRectangle;
+  if (pRegion) {
+    maybeRectangle = pRegion->getRectangle();
+  }
+
+  this->_tilesAddingOverlayTextureCoordinates.insert(&tile);
+
+  // Count the work as a load in progress, so that waiting until the tileset
+  // is idle also waits for it.
+  ++this->_tileLoadsInProgress;
+  CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
+
+  const CesiumAsync::AsyncSystem& asyncSystem = this->_externals.asyncSystem;
+  runInDecodeThread(
+      asyncSystem,
+      this->_externals.decodeThreadPool,
+      CesiumAsync::TaskPriority(),
+      [asyncSystem,
+       pPrepareRendererResources = this->_externals.pPrepareRendererResources,
+       model = renderContent.getModel(),
+       tileTransform = tile.getTransform(),
+       maybeRectangle,
+       projections = std::move(projections),
+       existingProjectionCount,
+       rendererOptions = tilesetOptions.rendererOptions]() mutable {
+        std::optional<RasterOverlayDetails> overlayDetails =
+            RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
+                model,
+                tileTransform,
+                maybeRectangle,
+                std::move(projections),
+                false,
+                "_CESIUMOVERLAY_",
+                int32_t(existingProjectionCount));
+        if (!overlayDetails) {
+          return asyncSystem
+              .createResolvedFuture<TileLoadResultAndRenderResources>(
+                  {TileLoadResult::createFailedResult(nullptr), nullptr});
+        }
+
+        TileLoadResult result{
+            std::move(model),
+            CesiumGeometry::Axis::Y,
+            std::nullopt,
+            std::nullopt,
+            std::move(overlayDetails),
+            nullptr,
+            {},
+            TileLoadResultState::Success};
+        return pPrepareRendererResources->prepareInLoadThread(
+            asyncSystem,
+            std::move(result),
+            tileTransform,
+            rendererOptions);
+      })
+      .thenInMainThread([&tile, thiz, existingProjectionCount](
+                            TileLoadResultAndRenderResources&& pair) {
+        thiz->_tilesAddingOverlayTextureCoordinates.erase(&tile);
+        --thiz->_tileLoadsInProgress;
+
+        // The tile may have been unloaded or loaded again in the meantime, and
+        // its model may not be replaced while a child is upsampled from it.
+        TileRenderContent* pRenderContent =
+            tile.getContent().getRenderContent();
+        CesiumGltf::Model* pModel =
+            std::get_if<CesiumGltf::Model>(&pair.result.contentKind);
+        if (tile.getState() != TileLoadState::Done || !pRenderContent ||
+            pRenderContent->getRasterOverlayDetails()
+                    .rasterOverlayProjections.size() !=
+                existingProjectionCount ||
+            isAnyChildUpsampling(tile) ||
+            pair.result.state != TileLoadResultState::Success || !pModel) {
+          if (pair.pRenderResources) {
+            thiz->freeRenderResources(tile, pair.pRenderResources, nullptr);
+          }
+
+          // If no texture coordinates could be generated, load the tile again
+          // as the last resort.
+          if (tile.getState() == TileLoadState::Done &&
+              pair.result.state != TileLoadResultState::Success) {
+            thiz->unloadTileContent(tile);
+          }
+          return;
+        }
+
+        // Detach the raster tiles from the renderer resources that are
+        // replaced. They are attached to the new ones, with the texture
+        // coordinates of their projections, once the tile is done loading
+        // again.
+        thiz->detachRasterOverlayAtlas(tile);
+        for (RasterMappedTo3DTile& mapped : tile.getMappedRasterTiles()) {
+          mapped.detachFromTile(
+              *thiz->_externals.pPrepareRendererResources,
+              tile);
+        }
+        thiz->unloadDoneState(tile);
+
+        RasterOverlayDetails overlayDetails =
+            pRenderContent->getRasterOverlayDetails();
+        overlayDetails.merge(*pair.result.rasterOverlayDetails);
+
+        thiz->_tilesDataUsed -= tile.computeByteSize();
+        pRenderContent->setModel(std::move(*pModel));
+        pRenderContent->setRasterOverlayDetails(std::move(overlayDetails));
+        thiz->_tilesDataUsed += tile.computeByteSize();
+
+        // The main-thread part of preparing the tile is done like for any
+        // other loaded tile.
+        pRenderContent->setRenderResources(pair.pRenderResources);
+        thiz->setTileState(tile, TileLoadState::ContentLoaded);
+        ++thiz->_tileStateVersion;
+      })
+      .catchInMainThread([pLogger = this->_externals.pLogger, &tile, thiz](
+                             std::exception&& e) {
+        thiz->_tilesAddingOverlayTextureCoordinates.erase(&tile);
+        --thiz->_tileLoadsInProgress;
+
+        SPDLOG_LOGGER_ERROR(
+            pLogger,
+            "An unexpected error occurs when adding raster overlay texture "
+            "coordinates to a tile: {}",
+            e.what());
+      });
+}
+
+void TilesetContentManager::processRasterOverlayMappings(
+    const TilesetOptions& tilesetOptions,
+    int32_t frameNumber) {
+  std::vector<Tile*>& tiles = this->_tilesWaitingForOverlayMapping;
+
+  // The tiles rendered this frame are mapped first, so that the overlays
+  // appear where the user is looking before anywhere else.
+  std::stable_partition(
+      tiles.begin(),
+      tiles.end(),
+      [frameNumber](const Tile* pTile) noexcept {
+        return pTile->getLastSelectionState().getResult(frameNumber) ==
+               TileSelectionState::Result::Rendered;
+      });
+
+  const size_t limit = tilesetOptions.rasterOverlayMappingTileLimit > 0
+                           ? tilesetOptions.rasterOverlayMappingTileLimit
+                           : tiles.size();
+  TimingScope timer(
+      tilesetOptions.enableViewUpdateTimings ? &this->_rasterOverlayMappingTime
+                                             : nullptr);
+  for (size_t i = 0; i < tiles.size() && i < limit; ++i) {
+    // A tile that was visited twice may already be mapped.
+    Tile& tile = *tiles[i];
+    if (tile.getState() == TileLoadState::Done &&
+        tile.getContent().isRenderContent() &&
+        this->hasRasterOverlayPlaceholdersToMap(tile)) {
+      this->mapRasterOverlayPlaceholders(tile, tilesetOptions);
+    }
+  }
+
+  // The tiles that were not mapped are added again when they are next
+  // visited.
+  tiles.clear();
+}
+
+void TilesetContentManager::updateRasterOverlayAtlas(Tile& tile) {
+  // Mapped raster tiles don't change once they are attached, so the atlas is
+  // up to date as long as the same number of them are all attached.
+  const std::vector<RasterMappedTo3DTile>& rasterTiles =
+      tile.getMappedRasterTiles();
+  const bool allAttached =
+      rasterTiles.size() > 1 &&
+      std::all_of(
+          rasterTiles.begin(),
+          rasterTiles.end(),
+          [](const RasterMappedTo3DTile& mapped) noexcept {
+            return mapped.getState() ==
+                       RasterMappedTo3DTile::AttachmentState::Attached &&
+                   mapped.getReadyTile() != nullptr;
+          });
+  if (allAttached && tile._rasterOverlayAtlasSize == rasterTiles.size()) {
+    return;
+  }
+
+  this->detachRasterOverlayAtlas(tile);
+  if (!allAttached) {
+    return;
+  }
+
+  std::vector<const CesiumGltf::ImageCesium*> images;
+  images.reserve(rasterTiles.size());
+  for (const RasterMappedTo3DTile& mapped : rasterTiles) {
+    images.emplace_back(&mapped.getReadyTile()->getImage());
+  }
+
+  std::optional<RasterOverlayAtlas> maybeAtlas =
+      RasterOverlayUtilities::createAtlas(images);
+  if (!maybeAtlas) {
+    return;
+  }
+
+  std::vector<RasterOverlayAtlasEntry> entries;
+  entries.reserve(rasterTiles.size());
+  for (size_t i = 0; i < rasterTiles.size(); ++i) {
+    const RasterMappedTo3DTile& mapped = rasterTiles[i];
+    const glm::dvec4 translationAndScale =
+        RasterOverlayUtilities::computeAtlasTranslationAndScale(
+            glm::dvec4(mapped.getTranslation(), mapped.getScale()),
+            maybeAtlas->regions[i]);
+    entries.push_back(RasterOverlayAtlasEntry{
+        mapped.getTextureCoordinateID(),
+        mapped.getReadyTile(),
+        glm::dvec2(translationAndScale.x, translationAndScale.y),
+        glm::dvec2(translationAndScale.z, translationAndScale.w)});
+  }
+
+  this->_externals.pPrepareRendererResources->attachRasterAtlasInMainThread(
+      tile,
+      maybeAtlas->image,
+      entries);
+  tile._rasterOverlayAtlasSize = rasterTiles.size();
+}
+
+void TilesetContentManager::detachRasterOverlayAtlas(Tile& tile) noexcept {
+  if (tile._rasterOverlayAtlasSize == 0) {
+    return;
+  }
+
+  this->_externals.pPrepareRendererResources->detachRasterAtlasInMainThread(
+      tile);
+  tile._rasterOverlayAtlasSize = 0;
+}
+
 void TilesetContentManager::unloadContentLoadedState(Tile& tile) {
   TileContent& content = tile.getContent();
   TileRenderContent* pRenderContent = content.getRenderContent();
   assert(pRenderContent && "Tile must have render content to be unloaded");
 
   void* pWorkerRenderResources = pRenderContent->getRenderResources();
-  this->_externals.pPrepareRendererResources->free(
-      tile,
-      pWorkerRenderResources,
-      nullptr);
+  this->freeRenderResources(tile, pWorkerRenderResources, nullptr);
   pRenderContent->setRenderResources(nullptr);
 }
 
@@ -1428,16 +3261,34 @@ void TilesetContentManager::unloadDoneState(Tile& tile) {
   assert(pRenderContent && "Tile must have render content to be unloaded");
 
   void* pMainThreadRenderResources = pRenderContent->getRenderResources();
-  this->_externals.pPrepareRendererResources->free(
-      tile,
-      nullptr,
-      pMainThreadRenderResources);
+  this->freeRenderResources(tile, nullptr, pMainThreadRenderResources);
   pRenderContent->setRenderResources(nullptr);
+
+  this->_tilesGpuDataUsed -= pRenderContent->getGpuByteSize();
+  pRenderContent->setGpuByteSize(0);
 }
 
 void TilesetContentManager::notifyTileStartLoading(
     [[maybe_unused]] const Tile* pTile) noexcept {
   ++this->_tileLoadsInProgress;
+  ++this->_tileStateVersion;
+  getTileLoadsInProgressGauge().add(1);
+}
+
+TileLoadTimeline& TilesetContentManager::startTileLoadTimeline(Tile& tile) {
+  if (!tile._pLoadTimeline) {
+    tile._pLoadTimeline = std::make_unique<TileLoadTimeline>();
+  } else if (tile._pLoadTimeline->getTime(TileLoadEvent::ContentLoading)) {
+    tile._pLoadTimeline->clear();
+  }
+
+  return *tile._pLoadTimeline;
+}
+
+void TilesetContentManager::addToTileLoadHistograms(const Tile& tile) noexcept {
+  if (tile._pLoadTimeline) {
+    this->_tileLoadHistograms.add(*tile._pLoadTimeline);
+  }
 }
 
 void TilesetContentManager::notifyTileDoneLoading(const Tile* pTile) noexcept {
@@ -1446,9 +3297,13 @@ void TilesetContentManager::notifyTileDoneLoading(const Tile* pTile) noexcept {
       "There are no tile loads currently in flight");
   --this->_tileLoadsInProgress;
   ++this->_loadedTilesCount;
+  ++this->_tileStateVersion;
+  getTileLoadsInProgressGauge().add(-1);
 
   if (pTile) {
-    this->_tilesDataUsed += pTile->computeByteSize();
+    const int64_t bytes = pTile->computeByteSize();
+    this->_tilesDataUsed += bytes;
+    this->_tilesDataLoaded += bytes;
   }
 }
 
@@ -1497,6 +3352,14 @@ void TilesetContentManager::propagateTilesetContentLoaderResult(
     this->_requestHeaders = std::move(result.requestHeaders);
     this->_pLoader = std::move(result.pLoader);
     this->_pRootTile = std::move(result.pRootTile);
+
+    // The entries of the tiles of any previous root are gone with them.
+    if (this->_maintainSelectionData) {
+      this->_selectionData.clear();
+      if (this->_pRootTile) {
+        this->_selectionData.registerSubtree(*this->_pRootTile);
+      }
+    }
   }
 }
 } // namespace Cesium3DTilesSelection
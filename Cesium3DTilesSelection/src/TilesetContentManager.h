@@ -1,8 +1,10 @@
 #pragma once
 
 #include "RasterOverlayUpsampler.h"
+#include "TileSelectionDataTable.h"
 #include "TilesetContentLoaderResult.h"
 
+#include <Cesium3DTilesSelection/IPrepareRendererResources.h>
 #include <Cesium3DTilesSelection/RasterOverlayCollection.h>
 #include <Cesium3DTilesSelection/Tile.h>
 #include <Cesium3DTilesSelection/TileContent.h>
@@ -11,13 +13,41 @@
 #include <Cesium3DTilesSelection/TilesetLoadFailureDetails.h>
 #include <Cesium3DTilesSelection/TilesetOptions.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/ITaskProcessor.h>
+#include <CesiumGeospatial/Projection.h>
+#include <CesiumRasterOverlays/RasterOverlayTile.h>
 #include <CesiumUtility/CreditSystem.h>
+#include <CesiumUtility/IntrusivePointer.h>
 #include <CesiumUtility/ReferenceCountedNonThreadSafe.h>
 
+#include <gsl/span>
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
 
+/**
+ * @brief The result of {@link TilesetContentManager::precacheTileContent}.
+ */
+struct TilePrecacheResult {
+  /**
+   * @brief The number of bytes of content that were loaded.
+   */
+  int64_t bytesLoaded;
+
+  /**
+   * @brief The raster overlay tiles that were mapped to the tile. They still
+   * need to be loaded to be cached, too.
+   */
+  std::vector<CesiumUtility::IntrusivePointer<
+      CesiumRasterOverlays::RasterOverlayTile>>
+      rasterOverlayTiles;
+};
+
 class TilesetContentManager
     : public CesiumUtility::ReferenceCountedNonThreadSafe<
           TilesetContentManager> {
@@ -60,10 +90,79 @@ public:
 
   ~TilesetContentManager() noexcept;
 
-  void loadTileContent(Tile& tile, const TilesetOptions& tilesetOptions);
+  /**
+   * @brief Starts loading the content of a tile.
+   *
+   * @param tile The tile.
+   * @param tilesetOptions The options of the tileset.
+   * @param priority The priority with which the CPU-heavy steps of the load
+   * are started in worker threads.
+   */
+  void loadTileContent(
+      Tile& tile,
+      const TilesetOptions& tilesetOptions,
+      const CesiumAsync::TaskPriority& priority = {});
+
+  /**
+   * @brief Loads the content of a tile only so that the asset accessor caches
+   * it, without creating renderer resources.
+   *
+   * The tile must be {@link TileLoadState::Unloaded} or
+   * {@link TileLoadState::FailedTemporarily}, and must not be upsampled from
+   * its parent. When the returned future resolves, in the main thread, the
+   * children of external tilesets and implicit tiles have been created, and
+   * render content has been unloaded again.
+   */
+  CesiumAsync::Future<TilePrecacheResult>
+  precacheTileContent(Tile& tile, const TilesetOptions& tilesetOptions);
+
+  /**
+   * @brief Creates the children of a tile without loading its render content.
+   *
+   * Only what the children are created from is loaded, such as the subtree
+   * of an implicit tile or the external tileset the tile refers to. When the
+   * returned future resolves, in the main thread, the tile has its children
+   * if it has any that can be created.
+   */
+  CesiumAsync::Future<void>
+  loadTileChildren(Tile& tile, const TilesetOptions& tilesetOptions);
+
+  /**
+   * @brief Starts loading what the children of a tile are created from, like
+   * {@link loadTileChildren}, before the tile itself is needed.
+   *
+   * This only fetches the external tileset the tile refers to, or the
+   * implicit tiling subtree its children are in, and only if the tile isn't
+   * loading and isn't being fetched already.
+   *
+   * @return Whether a fetch was started.
+   */
+  bool fetchTileChildrenAhead(Tile& tile, const TilesetOptions& tilesetOptions);
+
+  /**
+   * @brief Gets the number of fetches started by
+   * {@link fetchTileChildrenAhead} that have not completed.
+   */
+  int32_t getNumberOfTileChildrenFetches() const noexcept;
 
   void updateTileContent(Tile& tile, const TilesetOptions& tilesetOptions);
 
+  /**
+   * @brief Maps the raster overlays whose tile providers have been created to
+   * the tiles that only have placeholders for them, when
+   * {@link TilesetOptions::rasterOverlayMappingTileLimit} is set.
+   *
+   * This is called once per frame, after the traversal. Up to the limit of
+   * the tiles that were visited with such placeholders are mapped, those
+   * rendered in the frame first. The others are mapped in later frames.
+   *
+   * @param tilesetOptions The options of the tileset.
+   * @param frameNumber The number of the frame.
+   */
+  void processRasterOverlayMappings(
+      const TilesetOptions& tilesetOptions,
+      int32_t frameNumber);
+
   bool unloadTileContent(Tile& tile);
 
   void waitUntilIdle();
@@ -76,6 +175,17 @@ public:
    */
   void unloadAll();
 
+  /**
+   * @brief Unload every tile that is safe to unload, like {@link unloadAll},
+   * and release the tiles' content in a worker thread.
+   *
+   * The renderer resources are still freed in the main thread, with one call
+   * to {@link IPrepareRendererResources::freeBatch} if `batchRendererFrees` is
+   * true. The asynchronous destruction of the content manager is not complete
+   * until the content has been released.
+   */
+  void releaseAll(bool batchRendererFrees);
+
   const Tile* getRootTile() const noexcept;
 
   Tile* getRootTile() noexcept;
@@ -100,13 +210,159 @@ public:
 
   int64_t getTotalDataUsed() const noexcept;
 
+  int64_t getTotalGpuDataUsed() const noexcept;
+
+  /**
+   * @brief Adds the memory used by this tileset to the given usage.
+   *
+   * @param loadedTiles The tiles of this tileset that may have content, as
+   * maintained by the {@link Tileset}. Only their content is counted, so that
+   * the rest of the tile hierarchy is not walked.
+   * @param usage The usage to add to.
+   */
+  void addMemoryUsage(
+      const Tile::LoadedLinkedList& loadedTiles,
+      TilesetMemoryUsage& usage) const;
+
+  /**
+   * @brief Releases the memory used apart from the tile content that can be
+   * recreated: the loaders' unreferenced subtrees, the raster overlay source
+   * image caches, and the glTFs in the
+   * {@link TilesetContentOptions::pDecodedContentCache}.
+   *
+   * @return The number of bytes released.
+   */
+  int64_t trimMemory(const TilesetOptions& tilesetOptions);
+
+  /**
+   * @brief Gets the total number of bytes of tile content that have finished
+   * loading over the lifetime of this manager, including tiles that have since
+   * been unloaded.
+   */
+  int64_t getTotalDataLoaded() const noexcept;
+
+  /**
+   * @brief Gets the time spent mapping raster overlay tiles to geometry tiles
+   * since the last call, in seconds, and resets it to zero.
+   *
+   * This is only measured when
+   * {@link TilesetOptions::enableViewUpdateTimings} is true.
+   */
+  double takeRasterOverlayMappingTime() noexcept;
+
+  /**
+   * @brief Records in the {@link TileLoadTimeline} of a tile that it was
+   * added to the worker thread load queue, starting a new timeline if its
+   * last load is over.
+   *
+   * This only changes the tile, so it may be called from the parallel
+   * traversal.
+   */
+  void recordTileQueuedForLoad(Tile& tile) const;
+
+  /**
+   * @brief Gets the histograms of the timelines of the tile loads that were
+   * done or failed since the last call to {@link resetTileLoadHistograms}.
+   */
+  const TileLoadHistograms& getTileLoadHistograms() const noexcept;
+
+  void resetTileLoadHistograms() noexcept;
+
+  /**
+   * @brief Asks the loader to abandon the in-flight content load of a tile.
+   *
+   * The tile stays in the {@link TileLoadState::ContentLoading} state until
+   * the loader notices the request. Its load then completes with a
+   * {@link TileLoadResultState::RetryLater} result, so the tile can be loaded
+   * again later.
+   *
+   * @return true if the tile had a load in flight that was not already
+   * canceled.
+   */
+  bool cancelTileContentLoad(const Tile& tile) noexcept;
+
+  /**
+   * @brief Gets a counter that changes whenever any tile starts or finishes
+   * loading, changes its load state, gets children, or is unloaded.
+   */
+  uint64_t getTileStateVersion() const noexcept;
+
+  /**
+   * @brief Gets the packed selection data of the tiles in this tileset, or
+   * nullptr if {@link TilesetOptions::enablePackedSelectionData} was not
+   * enabled when the tileset was created.
+   */
+  const TileSelectionDataTable* getSelectionDataTable() const noexcept;
+
+  /** @copydoc getSelectionDataTable */
+  TileSelectionDataTable* getSelectionDataTable() noexcept;
+
+  /**
+   * @brief Determines whether a tile is a leaf with render content that can
+   * never get children.
+   *
+   * This is false for tiles with external or empty content, for the implicit
+   * and upsampled tiles that loaders create children for on demand, and for
+   * tiles whose loader has not yet been asked for children or asked to be
+   * asked again later.
+   */
+  static bool isFinalLeafTile(const Tile& tile) noexcept;
+
   bool tileNeedsWorkerThreadLoading(const Tile& tile) const noexcept;
   bool tileNeedsMainThreadLoading(const Tile& tile) const noexcept;
 
   // Transition the tile from the ContentLoaded to the Done state.
   void finishLoading(Tile& tile, const TilesetOptions& tilesetOptions);
 
+  /**
+   * @brief Does as much of the main-thread part of loading a tile as a budget
+   * allows, and transitions the tile to the Done state if it completes.
+   *
+   * The time and bytes spent are subtracted from the budget. If the renderer
+   * could not complete its work, the tile stays in the ContentLoaded state,
+   * and this can be called again in a later frame to resume.
+   *
+   * @return true if the tile is done loading.
+   */
+  bool finishLoading(
+      Tile& tile,
+      const TilesetOptions& tilesetOptions,
+      MainThreadLoadBudget& budget);
+
+  /**
+   * @brief Transitions the tiles that are in the ContentLoaded state from that
+   * to the Done state, with one call to
+   * {@link IPrepareRendererResources::prepareInMainThreadBatch}.
+   */
+  void finishLoading(
+      gsl::span<Tile* const> tiles,
+      const TilesetOptions& tilesetOptions);
+
+  /**
+   * @brief Collects the renderer resources freed by
+   * {@link unloadTileContent} from now on, instead of freeing them right away.
+   *
+   * They are freed with one call to
+   * {@link IPrepareRendererResources::freeBatch} by {@link endBatchingFrees}.
+   */
+  void beginBatchingFrees() noexcept;
+
+  void endBatchingFrees() noexcept;
+
 private:
+  CesiumAsync::Future<void> startTileContentLoad(
+      Tile& tile,
+      const TilesetOptions& tilesetOptions,
+      bool prepareRendererResources,
+      const CesiumAsync::TaskPriority& priority);
+
+  // Fetches the content of a tile again, and puts back the buffer and image
+  // data that was released once its renderer resources were prepared.
+  void fetchReleasedModelData(
+      Tile& tile,
+      const TilesetOptions& tilesetOptions,
+      const CesiumAsync::TaskPriority& priority);
+
   static void setTileContent(
       Tile& tile,
       TileLoadResult&& result,
@@ -117,14 +373,62 @@ private:
 
   void updateDoneState(Tile& tile, const TilesetOptions& tilesetOptions);
 
+  // Whether the tile has placeholders for overlays whose tile providers have
+  // been created.
+  bool hasRasterOverlayPlaceholdersToMap(const Tile& tile) const noexcept;
+
+  // Replaces the placeholders of overlays whose tile providers have been
+  // created with real raster tiles. Returns false if the tile had to be
+  // unloaded to generate the texture coordinates of the overlays.
+  bool mapRasterOverlayPlaceholders(
+      Tile& tile,
+      const TilesetOptions& tilesetOptions);
+
+  // Adds the texture coordinates of projections to a copy of the model of a
+  // tile in a worker thread, and then returns the tile to the ContentLoaded
+  // state with the copy, so that its renderer resources are prepared again
+  // without loading the tile again.
+  void addRasterOverlayTextureCoordinates(
+      Tile& tile,
+      std::vector<CesiumGeospatial::Projection>&& projections,
+      const TilesetOptions& tilesetOptions);
+
+  void createLatentChildrenIfNecessary(Tile& tile);
+
+  void updateRasterOverlayAtlas(Tile& tile);
+
+  void detachRasterOverlayAtlas(Tile& tile) noexcept;
+
   void unloadContentLoadedState(Tile& tile);
 
   void unloadDoneState(Tile& tile);
 
+  // Completes the main-thread part of loading once the renderer has prepared
+  // the tile.
+  void completeLoading(
+      Tile& tile,
+      const TilesetOptions& tilesetOptions,
+      void* pMainThreadRenderResources);
+
+  void freeRenderResources(
+      Tile& tile,
+      void* pLoadThreadResult,
+      void* pMainThreadResult) noexcept;
+
   void notifyTileStartLoading(const Tile* pTile) noexcept;
 
+  // Gets the timeline of a tile for a new load, clearing the timeline of its
+  // last load if there is one.
+  static TileLoadTimeline& startTileLoadTimeline(Tile& tile);
+
+  void addToTileLoadHistograms(const Tile& tile) noexcept;
+
   void notifyTileDoneLoading(const Tile* pTile) noexcept;
 
+  // Sets the load state of a tile, and refreshes whether its entry in the
+  // selection data table is renderable.
+  void setTileState(Tile& tile, TileLoadState state) noexcept;
+
   void notifyTileUnloading(const Tile* pTile) noexcept;
 
   template <class TilesetContentLoaderType>
@@ -145,6 +449,24 @@ private:
   int32_t _tileLoadsInProgress;
   int32_t _loadedTilesCount;
   int64_t _tilesDataUsed;
+  int64_t _tilesGpuDataUsed;
+  int64_t _tilesDataLoaded;
+  double _rasterOverlayMappingTime;
+  uint64_t _tileStateVersion;
+  std::unordered_map<const Tile*, std::shared_ptr<std::atomic<bool>>>
+      _tileLoadCancellations;
+  TileLoadHistograms _tileLoadHistograms;
+  std::unordered_set<const Tile*> _tilesFetchingModelData;
+  std::unordered_set<const Tile*> _tilesAddingOverlayTextureCoordinates;
+  std::vector<Tile*> _tilesWaitingForOverlayMapping;
+  std::unordered_set<const Tile*> _tilesFetchingChildren;
+  TileSelectionDataTable _selectionData;
+  bool _maintainSelectionData;
+  bool _batchingFrees;
+  std::vector<TileRendererResources> _pendingFrees;
+  bool _keepUnloadedContent;
+  std::vector<TileContent> _unloadedContents;
+  CesiumAsync::SharedFuture<void> _unloadedContentsReleasedFuture;
 
   CesiumAsync::Promise<void> _destructionCompletePromise;
   CesiumAsync::SharedFuture<void> _destructionCompleteFuture;
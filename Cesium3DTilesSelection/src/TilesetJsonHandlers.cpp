@@ -0,0 +1,461 @@
+#include "TilesetJsonHandlers.h"
+
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/S2CellBoundingVolume.h>
+
+using namespace CesiumJsonReader;
+
+namespace Cesium3DTilesSelection {
+
+void NumberArrayJsonHandler::reset(
+    IJsonHandler* pParent,
+    std::optional<NumberArray>* pArray) {
+  JsonHandler::reset(pParent);
+  this->_pArray = pArray;
+  this->_isInArray = false;
+}
+
+IJsonHandler* NumberArrayJsonHandler::readNull() {
+  return this->_isInArray ? this->readOther() : JsonHandler::readNull();
+}
+
+IJsonHandler* NumberArrayJsonHandler::readBool(bool b) {
+  return this->_isInArray ? this->readOther() : JsonHandler::readBool(b);
+}
+
+IJsonHandler* NumberArrayJsonHandler::readInt32(int32_t i) {
+  return this->readNumber(static_cast<double>(i));
+}
+
+IJsonHandler* NumberArrayJsonHandler::readUint32(uint32_t i) {
+  return this->readNumber(static_cast<double>(i));
+}
+
+IJsonHandler* NumberArrayJsonHandler::readInt64(int64_t i) {
+  return this->readNumber(static_cast<double>(i));
+}
+
+IJsonHandler* NumberArrayJsonHandler::readUint64(uint64_t i) {
+  return this->readNumber(static_cast<double>(i));
+}
+
+IJsonHandler* NumberArrayJsonHandler::readDouble(double d) {
+  return this->readNumber(d);
+}
+
+IJsonHandler*
+NumberArrayJsonHandler::readString(const std::string_view& str) {
+  return this->_isInArray ? this->readOther() : JsonHandler::readString(str);
+}
+
+IJsonHandler* NumberArrayJsonHandler::readObjectStart() {
+  if (!this->_isInArray) {
+    return JsonHandler::readObjectStart();
+  }
+  this->readOther();
+  return this->ignoreAndContinue()->readObjectStart();
+}
+
+IJsonHandler* NumberArrayJsonHandler::readArrayStart() {
+  if (!this->_isInArray) {
+    this->_isInArray = true;
+    this->_pArray->emplace();
+    return this;
+  }
+  this->readOther();
+  return this->ignoreAndContinue()->readArrayStart();
+}
+
+IJsonHandler* NumberArrayJsonHandler::readArrayEnd() { return this->parent(); }
+
+IJsonHandler* NumberArrayJsonHandler::readNumber(double d) {
+  if (!this->_isInArray) {
+    return JsonHandler::readDouble(d);
+  }
+
+  NumberArray& array = **this->_pArray;
+  if (array.numberCount == array.size) {
+    if (array.numberCount < array.values.size()) {
+      array.values[array.numberCount] = d;
+    }
+    ++array.numberCount;
+  }
+  ++array.size;
+  return this;
+}
+
+IJsonHandler* NumberArrayJsonHandler::readOther() {
+  ++(*this->_pArray)->size;
+  return this;
+}
+
+void OptionalDoubleJsonHandler::reset(
+    IJsonHandler* pParent,
+    std::optional<double>* pValue) {
+  JsonHandler::reset(pParent);
+  this->_pValue = pValue;
+}
+
+IJsonHandler* OptionalDoubleJsonHandler::readInt32(int32_t i) {
+  return this->readDouble(static_cast<double>(i));
+}
+
+IJsonHandler* OptionalDoubleJsonHandler::readUint32(uint32_t i) {
+  return this->readDouble(static_cast<double>(i));
+}
+
+IJsonHandler* OptionalDoubleJsonHandler::readInt64(int64_t i) {
+  return this->readDouble(static_cast<double>(i));
+}
+
+IJsonHandler* OptionalDoubleJsonHandler::readUint64(uint64_t i) {
+  return this->readDouble(static_cast<double>(i));
+}
+
+IJsonHandler* OptionalDoubleJsonHandler::readDouble(double d) {
+  *this->_pValue = d;
+  return this->parent();
+}
+
+void OptionalStringJsonHandler::reset(
+    IJsonHandler* pParent,
+    std::optional<std::string>* pValue) {
+  JsonHandler::reset(pParent);
+  this->_pValue = pValue;
+}
+
+IJsonHandler*
+OptionalStringJsonHandler::readString(const std::string_view& str) {
+  *this->_pValue = std::string(str);
+  return this->parent();
+}
+
+void JsonCopyHandler::reset(IJsonHandler* pParent, Writer* pWriter) {
+  JsonHandler::reset(pParent);
+  this->_pWriter = pWriter;
+  this->_depth = 0;
+}
+
+IJsonHandler* JsonCopyHandler::readNull() {
+  this->_pWriter->Null();
+  return this->doneValue();
+}
+
+IJsonHandler* JsonCopyHandler::readBool(bool b) {
+  this->_pWriter->Bool(b);
+  return this->doneValue();
+}
+
+IJsonHandler* JsonCopyHandler::readInt32(int32_t i) {
+  this->_pWriter->Int(i);
+  return this->doneValue();
+}
+
+IJsonHandler* JsonCopyHandler::readUint32(uint32_t i) {
+  this->_pWriter->Uint(i);
+  return this->doneValue();
+}
+
+IJsonHandler* JsonCopyHandler::readInt64(int64_t i) {
+  this->_pWriter->Int64(i);
+  return this->doneValue();
+}
+
+IJsonHandler* JsonCopyHandler::readUint64(uint64_t i) {
+  this->_pWriter->Uint64(i);
+  return this->doneValue();
+}
+
+IJsonHandler* JsonCopyHandler::readDouble(double d) {
+  this->_pWriter->Double(d);
+  return this->doneValue();
+}
+
+IJsonHandler* JsonCopyHandler::readString(const std::string_view& str) {
+  this->_pWriter->String(
+      str.data(),
+      static_cast<rapidjson::SizeType>(str.size()));
+  return this->doneValue();
+}
+
+IJsonHandler* JsonCopyHandler::readObjectStart() {
+  this->_pWriter->StartObject();
+  ++this->_depth;
+  return this;
+}
+
+IJsonHandler* JsonCopyHandler::readObjectKey(const std::string_view& str) {
+  this->_pWriter->Key(str.data(), static_cast<rapidjson::SizeType>(str.size()));
+  return this;
+}
+
+IJsonHandler* JsonCopyHandler::readObjectEnd() {
+  this->_pWriter->EndObject();
+  --this->_depth;
+  return this->doneValue();
+}
+
+IJsonHandler* JsonCopyHandler::readArrayStart() {
+  this->_pWriter->StartArray();
+  ++this->_depth;
+  return this;
+}
+
+IJsonHandler* JsonCopyHandler::readArrayEnd() {
+  this->_pWriter->EndArray();
+  --this->_depth;
+  return this->doneValue();
+}
+
+IJsonHandler* JsonCopyHandler::doneValue() {
+  return this->_depth == 0 ? this->parent() : this;
+}
+
+void ArrayTextJsonHandler::reset(
+    IJsonHandler* pParent,
+    std::string_view* pText) {
+  JsonHandler::reset(pParent);
+  this->_pText = pText;
+  this->_pStart = nullptr;
+  this->_depth = 0;
+  *pText = std::string_view();
+}
+
+IJsonHandler* ArrayTextJsonHandler::readNull() {
+  return this->_depth == 0 ? JsonHandler::readNull() : this;
+}
+
+IJsonHandler* ArrayTextJsonHandler::readBool(bool b) {
+  return this->_depth == 0 ? JsonHandler::readBool(b) : this;
+}
+
+IJsonHandler* ArrayTextJsonHandler::readInt32(int32_t i) {
+  return this->_depth == 0 ? JsonHandler::readInt32(i) : this;
+}
+
+IJsonHandler* ArrayTextJsonHandler::readUint32(uint32_t i) {
+  return this->_depth == 0 ? JsonHandler::readUint32(i) : this;
+}
+
+IJsonHandler* ArrayTextJsonHandler::readInt64(int64_t i) {
+  return this->_depth == 0 ? JsonHandler::readInt64(i) : this;
+}
+
+IJsonHandler* ArrayTextJsonHandler::readUint64(uint64_t i) {
+  return this->_depth == 0 ? JsonHandler::readUint64(i) : this;
+}
+
+IJsonHandler* ArrayTextJsonHandler::readDouble(double d) {
+  return this->_depth == 0 ? JsonHandler::readDouble(d) : this;
+}
+
+IJsonHandler* ArrayTextJsonHandler::readString(const std::string_view& str) {
+  return this->_depth == 0 ? JsonHandler::readString(str) : this;
+}
+
+IJsonHandler* ArrayTextJsonHandler::readObjectStart() {
+  if (this->_depth == 0) {
+    return JsonHandler::readObjectStart();
+  }
+  ++this->_depth;
+  return this;
+}
+
+IJsonHandler*
+ArrayTextJsonHandler::readObjectKey(const std::string_view& /* str */) {
+  return this;
+}
+
+IJsonHandler* ArrayTextJsonHandler::readObjectEnd() {
+  --this->_depth;
+  return this;
+}
+
+IJsonHandler* ArrayTextJsonHandler::readArrayStart() {
+  if (this->_depth == 0) {
+    // The reader reports the start of the array either before or after it
+    // consumes the opening bracket. Because the array is the value of a
+    // property, the character before it is never a bracket.
+    const char* pPosition = this->getReadPosition();
+    if (pPosition) {
+      this->_pStart = pPosition[-1] == '[' ? pPosition - 1 : pPosition;
+    }
+  }
+  ++this->_depth;
+  return this;
+}
+
+IJsonHandler* ArrayTextJsonHandler::readArrayEnd() {
+  --this->_depth;
+  if (this->_depth > 0) {
+    return this;
+  }
+
+  // Likewise, the character after the array is never a bracket.
+  const char* pEnd = this->getReadPosition();
+  if (this->_pStart && pEnd) {
+    if (*pEnd == ']') {
+      ++pEnd;
+    }
+    *this->_pText = std::string_view(
+        this->_pStart,
+        static_cast<size_t>(pEnd - this->_pStart));
+  }
+  return this->parent();
+}
+
+void S2BoundingVolumeJsonHandler::reset(
+    IJsonHandler* pParent,
+    BoundingVolumeJson* pBoundingVolume) {
+  JsonHandler::reset(pParent);
+  this->_pBoundingVolume = pBoundingVolume;
+}
+
+IJsonHandler* S2BoundingVolumeJsonHandler::readObjectStart() {
+  this->_pBoundingVolume->hasS2 = true;
+  return ObjectJsonHandler::readObjectStart();
+}
+
+IJsonHandler*
+S2BoundingVolumeJsonHandler::readObjectKey(const std::string_view& str) {
+  if (str == "token") {
+    this->_token.reset(this, &this->_pBoundingVolume->s2Token);
+    return &this->_token;
+  }
+  if (str == "minimumHeight") {
+    this->_height.reset(this, &this->_pBoundingVolume->s2MinimumHeight);
+    return &this->_height;
+  }
+  if (str == "maximumHeight") {
+    this->_height.reset(this, &this->_pBoundingVolume->s2MaximumHeight);
+    return &this->_height;
+  }
+  return this->ignoreAndContinue();
+}
+
+void BoundingVolumeExtensionsJsonHandler::reset(
+    IJsonHandler* pParent,
+    BoundingVolumeJson* pBoundingVolume) {
+  JsonHandler::reset(pParent);
+  this->_pBoundingVolume = pBoundingVolume;
+}
+
+IJsonHandler* BoundingVolumeExtensionsJsonHandler::readObjectKey(
+    const std::string_view& str) {
+  if (str == "3DTILES_bounding_volume_S2") {
+    this->_s2.reset(this, this->_pBoundingVolume);
+    return &this->_s2;
+  }
+  return this->ignoreAndContinue();
+}
+
+void BoundingVolumeJsonHandler::reset(
+    IJsonHandler* pParent,
+    std::optional<BoundingVolumeJson>* pBoundingVolume) {
+  JsonHandler::reset(pParent);
+  this->_pBoundingVolume = pBoundingVolume;
+}
+
+IJsonHandler* BoundingVolumeJsonHandler::readObjectStart() {
+  this->_pBoundingVolume->emplace();
+  return ObjectJsonHandler::readObjectStart();
+}
+
+IJsonHandler*
+BoundingVolumeJsonHandler::readObjectKey(const std::string_view& str) {
+  BoundingVolumeJson& boundingVolume = **this->_pBoundingVolume;
+  if (str == "box") {
+    this->_numbers.reset(this, &boundingVolume.box);
+    return &this->_numbers;
+  }
+  if (str == "region") {
+    this->_numbers.reset(this, &boundingVolume.region);
+    return &this->_numbers;
+  }
+  if (str == "sphere") {
+    this->_numbers.reset(this, &boundingVolume.sphere);
+    return &this->_numbers;
+  }
+  if (str == "extensions") {
+    this->_extensions.reset(this, &boundingVolume);
+    return &this->_extensions;
+  }
+  return this->ignoreAndContinue();
+}
+
+std::optional<BoundingVolume>
+createBoundingVolume(const BoundingVolumeJson& boundingVolume) {
+  if (boundingVolume.hasS2) {
+    return CesiumGeospatial::S2CellBoundingVolume(
+        CesiumGeospatial::S2CellID::fromToken(boundingVolume.s2Token),
+        boundingVolume.s2MinimumHeight,
+        boundingVolume.s2MaximumHeight);
+  }
+
+  const std::optional<NumberArray>& box = boundingVolume.box;
+  if (box && box->size >= 12) {
+    if (box->numberCount < 12) {
+      return std::nullopt;
+    }
+    const std::array<double, 16>& a = box->values;
+    return CesiumGeometry::OrientedBoundingBox(
+        glm::dvec3(a[0], a[1], a[2]),
+        glm::dmat3(a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11]));
+  }
+
+  const std::optional<NumberArray>& region = boundingVolume.region;
+  if (region && region->size >= 6) {
+    if (region->numberCount < 6) {
+      return std::nullopt;
+    }
+    const std::array<double, 16>& a = region->values;
+    return CesiumGeospatial::BoundingRegion(
+        CesiumGeospatial::GlobeRectangle(a[0], a[1], a[2], a[3]),
+        a[4],
+        a[5]);
+  }
+
+  const std::optional<NumberArray>& sphere = boundingVolume.sphere;
+  if (sphere && sphere->size >= 4) {
+    if (sphere->numberCount < 4) {
+      return std::nullopt;
+    }
+    const std::array<double, 16>& a = sphere->values;
+    return CesiumGeometry::BoundingSphere(glm::dvec3(a[0], a[1], a[2]), a[3]);
+  }
+
+  return std::nullopt;
+}
+
+void ContentJsonHandler::reset(
+    IJsonHandler* pParent,
+    std::optional<ContentJson>* pContent) {
+  JsonHandler::reset(pParent);
+  this->_pContent = pContent;
+}
+
+IJsonHandler* ContentJsonHandler::readObjectStart() {
+  this->_pContent->emplace();
+  return ObjectJsonHandler::readObjectStart();
+}
+
+IJsonHandler* ContentJsonHandler::readObjectKey(const std::string_view& str) {
+  ContentJson& content = **this->_pContent;
+  if (str == "uri") {
+    this->_uri.reset(this, &content.uri);
+    return &this->_uri;
+  }
+  if (str == "url") {
+    this->_uri.reset(this, &content.url);
+    return &this->_uri;
+  }
+  if (str == "boundingVolume") {
+    this->_boundingVolume.reset(this, &content.boundingVolume);
+    return &this->_boundingVolume;
+  }
+  return this->ignoreAndContinue();
+}
+
+} // namespace Cesium3DTilesSelection
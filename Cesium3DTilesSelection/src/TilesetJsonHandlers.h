@@ -0,0 +1,269 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <CesiumJsonReader/DoubleJsonHandler.h>
+#include <CesiumJsonReader/JsonHandler.h>
+#include <CesiumJsonReader/ObjectJsonHandler.h>
+#include <CesiumJsonReader/StringJsonHandler.h>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The leading numbers of a JSON array, as read by a
+ * {@link NumberArrayJsonHandler}.
+ */
+struct NumberArray {
+  /**
+   * @brief The first numbers of the array, up to the 16 of a transform.
+   */
+  std::array<double, 16> values{};
+
+  /**
+   * @brief The number of elements in the array.
+   */
+  size_t size = 0;
+
+  /**
+   * @brief The number of elements before the first one that is not a number.
+   */
+  size_t numberCount = 0;
+};
+
+/**
+ * @brief Reads an array of numbers, such as a transform or the box of a
+ * bounding volume, without allocating.
+ */
+class NumberArrayJsonHandler : public CesiumJsonReader::JsonHandler {
+public:
+  void reset(IJsonHandler* pParent, std::optional<NumberArray>* pArray);
+
+  IJsonHandler* readNull() override;
+  IJsonHandler* readBool(bool b) override;
+  IJsonHandler* readInt32(int32_t i) override;
+  IJsonHandler* readUint32(uint32_t i) override;
+  IJsonHandler* readInt64(int64_t i) override;
+  IJsonHandler* readUint64(uint64_t i) override;
+  IJsonHandler* readDouble(double d) override;
+  IJsonHandler* readString(const std::string_view& str) override;
+  IJsonHandler* readObjectStart() override;
+  IJsonHandler* readArrayStart() override;
+  IJsonHandler* readArrayEnd() override;
+
+private:
+  IJsonHandler* readNumber(double d);
+  IJsonHandler* readOther();
+
+  std::optional<NumberArray>* _pArray = nullptr;
+  bool _isInArray = false;
+};
+
+/**
+ * @brief Reads a number into an optional, which is left empty if the value is
+ * not a number.
+ */
+class OptionalDoubleJsonHandler : public CesiumJsonReader::JsonHandler {
+public:
+  void reset(IJsonHandler* pParent, std::optional<double>* pValue);
+
+  IJsonHandler* readInt32(int32_t i) override;
+  IJsonHandler* readUint32(uint32_t i) override;
+  IJsonHandler* readInt64(int64_t i) override;
+  IJsonHandler* readUint64(uint64_t i) override;
+  IJsonHandler* readDouble(double d) override;
+
+private:
+  std::optional<double>* _pValue = nullptr;
+};
+
+/**
+ * @brief Reads a string into an optional, which is left empty if the value is
+ * not a string.
+ */
+class OptionalStringJsonHandler : public CesiumJsonReader::JsonHandler {
+public:
+  void reset(IJsonHandler* pParent, std::optional<std::string>* pValue);
+
+  IJsonHandler* readString(const std::string_view& str) override;
+
+private:
+  std::optional<std::string>* _pValue = nullptr;
+};
+
+/**
+ * @brief Writes a single JSON value, as it is read, with a
+ * `rapidjson::Writer`, so that the few parts of a tileset.json that are not
+ * read into tiles can be parsed into a small document afterward.
+ */
+class JsonCopyHandler : public CesiumJsonReader::JsonHandler {
+public:
+  /**
+   * @brief The type of the writer to which the value is written.
+   */
+  using Writer = rapidjson::Writer<rapidjson::StringBuffer>;
+
+  void reset(IJsonHandler* pParent, Writer* pWriter);
+
+  IJsonHandler* readNull() override;
+  IJsonHandler* readBool(bool b) override;
+  IJsonHandler* readInt32(int32_t i) override;
+  IJsonHandler* readUint32(uint32_t i) override;
+  IJsonHandler* readInt64(int64_t i) override;
+  IJsonHandler* readUint64(uint64_t i) override;
+  IJsonHandler* readDouble(double d) override;
+  IJsonHandler* readString(const std::string_view& str) override;
+  IJsonHandler* readObjectStart() override;
+  IJsonHandler* readObjectKey(const std::string_view& str) override;
+  IJsonHandler* readObjectEnd() override;
+  IJsonHandler* readArrayStart() override;
+  IJsonHandler* readArrayEnd() override;
+
+private:
+  IJsonHandler* doneValue();
+
+  Writer* _pWriter = nullptr;
+  int32_t _depth = 0;
+};
+
+/**
+ * @brief Skips an array that is the value of a property of an object,
+ * recording its JSON text so that it can be read later.
+ *
+ * The text is only recorded when the JSON is read from text, which
+ * {@link CesiumJsonReader::IJsonHandler::getReadPosition} tells, and the
+ * value is an array. Otherwise, the text is left empty.
+ */
+class ArrayTextJsonHandler : public CesiumJsonReader::JsonHandler {
+public:
+  void reset(IJsonHandler* pParent, std::string_view* pText);
+
+  IJsonHandler* readNull() override;
+  IJsonHandler* readBool(bool b) override;
+  IJsonHandler* readInt32(int32_t i) override;
+  IJsonHandler* readUint32(uint32_t i) override;
+  IJsonHandler* readInt64(int64_t i) override;
+  IJsonHandler* readUint64(uint64_t i) override;
+  IJsonHandler* readDouble(double d) override;
+  IJsonHandler* readString(const std::string_view& str) override;
+  IJsonHandler* readObjectStart() override;
+  IJsonHandler* readObjectKey(const std::string_view& str) override;
+  IJsonHandler* readObjectEnd() override;
+  IJsonHandler* readArrayStart() override;
+  IJsonHandler* readArrayEnd() override;
+
+private:
+  std::string_view* _pText = nullptr;
+  const char* _pStart = nullptr;
+  int32_t _depth = 0;
+};
+
+/**
+ * @brief The properties of a bounding volume, as read by a
+ * {@link BoundingVolumeJsonHandler}.
+ */
+struct BoundingVolumeJson {
+  std::optional<NumberArray> box;
+  std::optional<NumberArray> region;
+  std::optional<NumberArray> sphere;
+  bool hasS2 = false;
+  std::string s2Token = "1";
+  double s2MinimumHeight = 0.0;
+  double s2MaximumHeight = 0.0;
+};
+
+/**
+ * @brief Reads the `3DTILES_bounding_volume_S2` extension of a bounding
+ * volume.
+ */
+class S2BoundingVolumeJsonHandler : public CesiumJsonReader::ObjectJsonHandler {
+public:
+  void reset(IJsonHandler* pParent, BoundingVolumeJson* pBoundingVolume);
+
+  IJsonHandler* readObjectStart() override;
+  IJsonHandler* readObjectKey(const std::string_view& str) override;
+
+private:
+  BoundingVolumeJson* _pBoundingVolume = nullptr;
+  CesiumJsonReader::StringJsonHandler _token;
+  CesiumJsonReader::DoubleJsonHandler _height;
+};
+
+/**
+ * @brief Reads the extensions of a bounding volume.
+ */
+class BoundingVolumeExtensionsJsonHandler
+    : public CesiumJsonReader::ObjectJsonHandler {
+public:
+  void reset(IJsonHandler* pParent, BoundingVolumeJson* pBoundingVolume);
+
+  IJsonHandler* readObjectKey(const std::string_view& str) override;
+
+private:
+  BoundingVolumeJson* _pBoundingVolume = nullptr;
+  S2BoundingVolumeJsonHandler _s2;
+};
+
+/**
+ * @brief Reads a bounding volume of a tile or its content.
+ */
+class BoundingVolumeJsonHandler : public CesiumJsonReader::ObjectJsonHandler {
+public:
+  void reset(
+      IJsonHandler* pParent,
+      std::optional<BoundingVolumeJson>* pBoundingVolume);
+
+  IJsonHandler* readObjectStart() override;
+  IJsonHandler* readObjectKey(const std::string_view& str) override;
+
+private:
+  std::optional<BoundingVolumeJson>* _pBoundingVolume = nullptr;
+  NumberArrayJsonHandler _numbers;
+  BoundingVolumeExtensionsJsonHandler _extensions;
+};
+
+/**
+ * @brief Creates a bounding volume from its properties, preferring the S2
+ * extension, then a box, a region, and a sphere.
+ *
+ * @return The bounding volume, or std::nullopt if the properties do not
+ * describe a valid one.
+ */
+std::optional<BoundingVolume>
+createBoundingVolume(const BoundingVolumeJson& boundingVolume);
+
+/**
+ * @brief The properties of the content of a tile, as read by a
+ * {@link ContentJsonHandler}.
+ */
+struct ContentJson {
+  std::optional<std::string> uri;
+  std::optional<std::string> url;
+  std::optional<BoundingVolumeJson> boundingVolume;
+};
+
+/**
+ * @brief Reads the content of a tile.
+ */
+class ContentJsonHandler : public CesiumJsonReader::ObjectJsonHandler {
+public:
+  void reset(IJsonHandler* pParent, std::optional<ContentJson>* pContent);
+
+  IJsonHandler* readObjectStart() override;
+  IJsonHandler* readObjectKey(const std::string_view& str) override;
+
+private:
+  std::optional<ContentJson>* _pContent = nullptr;
+  OptionalStringJsonHandler _uri;
+  BoundingVolumeJsonHandler _boundingVolume;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -1,13 +1,18 @@
 #include "TilesetJsonLoader.h"
 
+#include "DecodeThread.h"
 #include "ImplicitOctreeLoader.h"
 #include "ImplicitQuadtreeLoader.h"
+#include "TilesetJsonHandlers.h"
 #include "logTileLoadResult.h"
 
+#include <Cesium3DTilesContent/BinaryToGltfConverter.h>
+#include <Cesium3DTilesContent/CmptToGltfConverter.h>
 #include <Cesium3DTilesContent/GltfConverters.h>
 #include <Cesium3DTilesReader/GroupMetadataReader.h>
 #include <Cesium3DTilesReader/MetadataEntityReader.h>
 #include <Cesium3DTilesReader/SchemaReader.h>
+#include <Cesium3DTilesSelection/DecodedContentCache.h>
 #include <Cesium3DTilesSelection/TileID.h>
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetResponse.h>
@@ -15,14 +20,23 @@
 #include <CesiumGeometry/OrientedBoundingBox.h>
 #include <CesiumGeospatial/BoundingRegion.h>
 #include <CesiumGeospatial/S2CellBoundingVolume.h>
+#include <CesiumJsonReader/JsonReader.h>
+#include <CesiumJsonReader/ObjectJsonHandler.h>
 #include <CesiumUtility/JsonHelpers.h>
 #include <CesiumUtility/Uri.h>
 #include <CesiumUtility/joinToString.h>
 
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 #include <spdlog/logger.h>
 
+#include <array>
 #include <cctype>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
 
 using namespace CesiumUtility;
 using namespace Cesium3DTilesContent;
@@ -390,6 +404,52 @@ void parseImplicitTileset(
   }
 }
 
+double
+scaleGeometricError(const glm::dmat4& tileTransform, double geometricError) {
+  const glm::dvec3 scale = glm::dvec3(
+      glm::length(tileTransform[0]),
+      glm::length(tileTransform[1]),
+      glm::length(tileTransform[2]));
+  const double maxScaleComponent =
+      glm::max(scale.x, glm::max(scale.y, scale.z));
+  return geometricError * maxScaleComponent;
+}
+
+TileRefine parseRefine(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& refine,
+    TileRefine parentRefine) {
+  if (refine == "REPLACE") {
+    return TileRefine::Replace;
+  }
+  if (refine == "ADD") {
+    return TileRefine::Add;
+  }
+
+  std::string refineUpper = refine;
+  std::transform(
+      refineUpper.begin(),
+      refineUpper.end(),
+      refineUpper.begin(),
+      [](unsigned char c) -> unsigned char {
+        return static_cast<unsigned char>(std::toupper(c));
+      });
+  if (refineUpper == "REPLACE" || refineUpper == "ADD") {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "Tile refine value '{}' should be uppercase: '{}'",
+        refine,
+        refineUpper);
+    return refineUpper == "REPLACE" ? TileRefine::Replace : TileRefine::Add;
+  }
+
+  SPDLOG_LOGGER_WARN(
+      pLogger,
+      "Tile contained an unknown refine value: {}",
+      refine);
+  return parentRefine;
+}
+
 std::optional<Tile> parseTileJsonRecursively(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const rapidjson::Value& tileJson,
@@ -437,48 +497,15 @@ std::optional<Tile> parseTileJsonRecursively(
         "Using half of the parent tile's geometric error.");
   }
 
-  const glm::dvec3 scale = glm::dvec3(
-      glm::length(tileTransform[0]),
-      glm::length(tileTransform[1]),
-      glm::length(tileTransform[2]));
-  const double maxScaleComponent =
-      glm::max(scale.x, glm::max(scale.y, scale.z));
-  double tileGeometricError = geometricError.value() * maxScaleComponent;
+  double tileGeometricError =
+      scaleGeometricError(tileTransform, geometricError.value());
 
   // parse refinement
   TileRefine tileRefine = parentRefine;
   const auto refineIt = tileJson.FindMember("refine");
   if (refineIt != tileJson.MemberEnd() && refineIt->value.IsString()) {
-    std::string refine = refineIt->value.GetString();
-    if (refine == "REPLACE") {
-      tileRefine = TileRefine::Replace;
-    } else if (refine == "ADD") {
-      tileRefine = TileRefine::Add;
-    } else {
-      std::string refineUpper = refine;
-      std::transform(
-          refineUpper.begin(),
-          refineUpper.end(),
-          refineUpper.begin(),
-          [](unsigned char c) -> unsigned char {
-            return static_cast<unsigned char>(std::toupper(c));
-          });
-      if (refineUpper == "REPLACE" || refineUpper == "ADD") {
-        SPDLOG_LOGGER_WARN(
-            pLogger,
-            "Tile refine value '{}' should be uppercase: '{}'",
-            refine,
-            refineUpper);
-        tileRefine =
-            refineUpper == "REPLACE" ? TileRefine::Replace : TileRefine::Add;
-      } else {
-        SPDLOG_LOGGER_WARN(
-            pLogger,
-            "Tile contained an unknown refine value: {}",
-            refine);
-      }
-    }
-  } else {
+    tileRefine =
+        parseRefine(pLogger, refineIt->value.GetString(), parentRefine);
   }
 
   // Parse content member to determine tile content Url.
@@ -665,11 +692,739 @@ void parseTilesetMetadata(
   }
 }
 
+/**
+ * @brief The state shared by the handlers of all of the tiles of a
+ * tileset.json.
+ */
+struct TileJsonContext {
+  std::shared_ptr<spdlog::logger> pLogger;
+  TilesetJsonLoader* pLoader = nullptr;
+
+  /**
+   * @brief The number of levels of tiles to create, below which the children
+   * of tiles are deferred, or 0 to create all of them.
+   */
+  uint32_t tileLevels = 0;
+};
+
+class TileJsonHandler;
+
+class TileChildrenJsonHandler : public CesiumJsonReader::JsonHandler {
+public:
+  void reset(IJsonHandler* pParent, TileJsonHandler* pTile) {
+    JsonHandler::reset(pParent);
+    this->_pTile = pTile;
+    this->_isInArray = false;
+  }
+
+  // Children that are not objects are skipped, as by
+  // parseTileJsonRecursively.
+  IJsonHandler* readNull() override {
+    return this->_isInArray ? this : JsonHandler::readNull();
+  }
+
+  IJsonHandler* readBool(bool b) override {
+    return this->_isInArray ? this : JsonHandler::readBool(b);
+  }
+
+  IJsonHandler* readInt32(int32_t i) override {
+    return this->_isInArray ? this : JsonHandler::readInt32(i);
+  }
+
+  IJsonHandler* readUint32(uint32_t i) override {
+    return this->_isInArray ? this : JsonHandler::readUint32(i);
+  }
+
+  IJsonHandler* readInt64(int64_t i) override {
+    return this->_isInArray ? this : JsonHandler::readInt64(i);
+  }
+
+  IJsonHandler* readUint64(uint64_t i) override {
+    return this->_isInArray ? this : JsonHandler::readUint64(i);
+  }
+
+  IJsonHandler* readDouble(double d) override {
+    return this->_isInArray ? this : JsonHandler::readDouble(d);
+  }
+
+  IJsonHandler* readString(const std::string_view& str) override {
+    return this->_isInArray ? this : JsonHandler::readString(str);
+  }
+
+  IJsonHandler* readObjectStart() override;
+
+  IJsonHandler* readArrayStart() override {
+    if (!this->_isInArray) {
+      this->_isInArray = true;
+      return this;
+    }
+    return this->ignoreAndContinue()->readArrayStart();
+  }
+
+  IJsonHandler* readArrayEnd() override { return this->parent(); }
+
+private:
+  TileJsonHandler* _pTile = nullptr;
+  bool _isInArray = false;
+};
+
+class TileExtensionsJsonHandler : public CesiumJsonReader::ObjectJsonHandler {
+public:
+  void reset(IJsonHandler* pParent, TileJsonHandler* pTile) {
+    JsonHandler::reset(pParent);
+    this->_pTile = pTile;
+  }
+
+  IJsonHandler* readObjectKey(const std::string_view& str) override;
+
+private:
+  TileJsonHandler* _pTile = nullptr;
+};
+
+/**
+ * @brief Reads a tile of a tileset.json and creates a {@link Tile} from it,
+ * in the same way as {@link parseTileJsonRecursively}.
+ *
+ * The properties that the children of a tile depend on, which are its
+ * transform, refinement, and geometric error, must come before its children.
+ * Otherwise, reading stops so that the tileset.json can be parsed into a
+ * document instead.
+ *
+ * Each handler reads the children of its tiles with a single handler of its
+ * own, so there is one handler for each level of the tree.
+ *
+ * The children of the tiles of the last level of
+ * {@link TileJsonContext::tileLevels} are not read, but their JSON text is
+ * kept by the loader to create them later, which it does from the
+ * properties of the created tile. Their order does not matter then.
+ */
+class TileJsonHandler : public CesiumJsonReader::ObjectJsonHandler {
+public:
+  explicit TileJsonHandler(const TileJsonContext& context)
+      : ObjectJsonHandler(),
+        _context(context),
+        _implicitTilingJson(),
+        _implicitTilingWriter(_implicitTilingJson) {}
+
+  void reset(
+      IJsonHandler* pParent,
+      const glm::dmat4& parentTransform,
+      TileRefine parentRefine,
+      double parentGeometricError,
+      std::vector<Tile>* pTiles,
+      uint32_t depth) {
+    JsonHandler::reset(pParent);
+    this->_parentTransform = parentTransform;
+    this->_parentRefine = parentRefine;
+    this->_parentGeometricError = parentGeometricError;
+    this->_pTiles = pTiles;
+    this->_childDepth = depth + 1;
+
+    this->_transform.reset();
+    this->_boundingVolume.reset();
+    this->_viewerRequestVolume.reset();
+    this->_geometricError.reset();
+    this->_refine.reset();
+    this->_content.reset();
+    this->_implicitTilingJson.Clear();
+    this->_implicitTilingWriter.Reset(this->_implicitTilingJson);
+    this->_hasImplicitTiling = false;
+    this->_isResolved = false;
+    this->_childTiles.clear();
+    this->_pChildTiles = &this->_childTiles;
+    this->_childrenJson = std::string_view();
+  }
+
+  IJsonHandler* readObjectKey(const std::string_view& str) override {
+    if (str == "transform" || str == "refine" || str == "geometricError") {
+      if (this->_isResolved) {
+        // The children have already been created with the values these
+        // properties had before them.
+        return nullptr;
+      }
+    }
+
+    if (str == "transform") {
+      this->_numbers.reset(this, &this->_transform);
+      return &this->_numbers;
+    }
+    if (str == "boundingVolume") {
+      this->_boundingVolumeHandler.reset(this, &this->_boundingVolume);
+      return &this->_boundingVolumeHandler;
+    }
+    if (str == "viewerRequestVolume") {
+      this->_boundingVolumeHandler.reset(this, &this->_viewerRequestVolume);
+      return &this->_boundingVolumeHandler;
+    }
+    if (str == "geometricError") {
+      this->_geometricErrorHandler.reset(this, &this->_geometricError);
+      return &this->_geometricErrorHandler;
+    }
+    if (str == "refine") {
+      this->_refineHandler.reset(this, &this->_refine);
+      return &this->_refineHandler;
+    }
+    if (str == "content") {
+      this->_contentHandler.reset(this, &this->_content);
+      return &this->_contentHandler;
+    }
+    if (str == "implicitTiling") {
+      return this->readImplicitTiling(this, str);
+    }
+    if (str == "extensions") {
+      this->_extensionsHandler.reset(this, this);
+      return &this->_extensionsHandler;
+    }
+    if (str == "children") {
+      const uint32_t tileLevels = this->_context.tileLevels;
+      if (tileLevels > 0 && this->_childDepth >= tileLevels &&
+          this->getReadPosition()) {
+        this->_childrenTextHandler.reset(this, &this->_childrenJson);
+        return &this->_childrenTextHandler;
+      }
+
+      this->resolve();
+      this->_childrenHandler.reset(this, this);
+      return &this->_childrenHandler;
+    }
+    return this->ignoreAndContinue();
+  }
+
+  IJsonHandler* readObjectEnd() override {
+    if (!this->_isResolved) {
+      this->resolve();
+    }
+
+    std::optional<Tile> maybeTile = this->createTile();
+    if (maybeTile) {
+      this->_pTiles->emplace_back(std::move(*maybeTile));
+    }
+
+    return ObjectJsonHandler::readObjectEnd();
+  }
+
+  /**
+   * @brief Starts reading a child of the tile, returning the handler for it.
+   */
+  IJsonHandler* readChild(IJsonHandler* pParent) {
+    if (!this->_pChildHandler) {
+      this->_pChildHandler = std::make_unique<TileJsonHandler>(this->_context);
+    }
+    this->_pChildHandler->reset(
+        pParent,
+        this->_tileTransform,
+        this->_tileRefine,
+        this->_tileGeometricError,
+        this->_pChildTiles,
+        this->_childDepth);
+    return this->_pChildHandler->readObjectStart();
+  }
+
+  /**
+   * @brief Starts reading the deferred children of the given tile, adding
+   * them to the given vector, returning the handler for them.
+   */
+  IJsonHandler* readDeferredChildren(
+      IJsonHandler* pParent,
+      const Tile& tile,
+      std::vector<Tile>* pChildren) {
+    this->_tileTransform = tile.getTransform();
+    this->_tileRefine = tile.getRefine();
+    this->_tileGeometricError = tile.getGeometricError();
+    this->_pChildTiles = pChildren;
+    this->_childDepth = 0;
+    this->_childrenHandler.reset(pParent, this);
+    return &this->_childrenHandler;
+  }
+
+  /**
+   * @brief Starts reading an implicit tiling object of the tile with the
+   * given key, returning the handler for it.
+   */
+  IJsonHandler*
+  readImplicitTiling(IJsonHandler* pParent, const std::string_view& key) {
+    if (!this->_hasImplicitTiling) {
+      this->_implicitTilingWriter.StartObject();
+      this->_hasImplicitTiling = true;
+    }
+    this->_implicitTilingWriter.Key(
+        key.data(),
+        static_cast<rapidjson::SizeType>(key.size()));
+    this->_copyHandler.reset(pParent, &this->_implicitTilingWriter);
+    return &this->_copyHandler;
+  }
+
+private:
+  void resolve() {
+    const std::optional<NumberArray>& transform = this->_transform;
+    glm::dmat4 localTransform(1.0);
+    if (transform && transform->numberCount >= 16) {
+      const std::array<double, 16>& a = transform->values;
+      localTransform = glm::dmat4(
+          glm::dvec4(a[0], a[1], a[2], a[3]),
+          glm::dvec4(a[4], a[5], a[6], a[7]),
+          glm::dvec4(a[8], a[9], a[10], a[11]),
+          glm::dvec4(a[12], a[13], a[14], a[15]));
+    }
+    this->_tileTransform = this->_parentTransform * localTransform;
+
+    double geometricError;
+    if (this->_geometricError) {
+      geometricError = *this->_geometricError;
+    } else {
+      geometricError = this->_parentGeometricError * 0.5;
+      SPDLOG_LOGGER_WARN(
+          this->_context.pLogger,
+          "Tile did not contain a geometricError. "
+          "Using half of the parent tile's geometric error.");
+    }
+    this->_tileGeometricError =
+        scaleGeometricError(this->_tileTransform, geometricError);
+
+    this->_tileRefine = this->_refine ? parseRefine(
+                                            this->_context.pLogger,
+                                            *this->_refine,
+                                            this->_parentRefine)
+                                      : this->_parentRefine;
+
+    this->_isResolved = true;
+  }
+
+  std::optional<Tile> createTile() {
+    std::optional<BoundingVolume> boundingVolume;
+    if (this->_boundingVolume) {
+      boundingVolume = createBoundingVolume(*this->_boundingVolume);
+    }
+    if (!boundingVolume) {
+      SPDLOG_LOGGER_ERROR(
+          this->_context.pLogger,
+          "Tile did not contain a boundingVolume");
+      return std::nullopt;
+    }
+
+    const BoundingVolume tileBoundingVolume =
+        transformBoundingVolume(this->_tileTransform, *boundingVolume);
+
+    std::optional<BoundingVolume> tileViewerRequestVolume;
+    if (this->_viewerRequestVolume) {
+      tileViewerRequestVolume =
+          createBoundingVolume(*this->_viewerRequestVolume);
+      if (tileViewerRequestVolume) {
+        tileViewerRequestVolume = transformBoundingVolume(
+            this->_tileTransform,
+            *tileViewerRequestVolume);
+      }
+    }
+
+    const std::string* pContentUri = nullptr;
+    if (this->_content) {
+      if (this->_content->uri) {
+        pContentUri = &*this->_content->uri;
+      } else if (this->_content->url) {
+        pContentUri = &*this->_content->url;
+      }
+    }
+
+    TilesetJsonLoader& currentLoader = *this->_context.pLoader;
+
+    if (this->_hasImplicitTiling) {
+      this->_implicitTilingWriter.EndObject();
+      rapidjson::Document implicitTilingJson;
+      implicitTilingJson.Parse(
+          this->_implicitTilingJson.GetString(),
+          this->_implicitTilingJson.GetSize());
+
+      const rapidjson::Value* pImplicitTiling = nullptr;
+      const auto implicitTilingIt =
+          implicitTilingJson.FindMember("implicitTiling");
+      const auto implicitExtensionIt =
+          implicitTilingJson.FindMember("3DTILES_implicit_tiling");
+      if (implicitTilingIt != implicitTilingJson.MemberEnd() &&
+          implicitTilingIt->value.IsObject()) {
+        pImplicitTiling = &implicitTilingIt->value;
+      } else if (
+          implicitExtensionIt != implicitTilingJson.MemberEnd() &&
+          implicitExtensionIt->value.IsObject()) {
+        pImplicitTiling = &implicitExtensionIt->value;
+      }
+
+      if (pImplicitTiling) {
+        // mark this tile as external
+        Tile tile{&currentLoader, std::make_unique<TileExternalContent>()};
+        tile.setTileID("");
+        tile.setTransform(this->_tileTransform);
+        tile.setBoundingVolume(tileBoundingVolume);
+        tile.setViewerRequestVolume(tileViewerRequestVolume);
+        tile.setGeometricError(this->_tileGeometricError);
+        tile.setRefine(this->_tileRefine);
+
+        parseImplicitTileset(
+            *pImplicitTiling,
+            pContentUri ? pContentUri->c_str() : nullptr,
+            tile,
+            currentLoader);
+
+        this->_childTiles.clear();
+        return tile;
+      }
+    }
+
+    std::optional<BoundingVolume> tileContentBoundingVolume;
+    if (this->_content && this->_content->boundingVolume) {
+      tileContentBoundingVolume =
+          createBoundingVolume(*this->_content->boundingVolume);
+      if (tileContentBoundingVolume) {
+        tileContentBoundingVolume = transformBoundingVolume(
+            this->_tileTransform,
+            *tileContentBoundingVolume);
+      }
+    }
+
+    // Move the children into a vector of exactly their number, so that the
+    // vector they were read into keeps its capacity for the next tile.
+    std::vector<Tile> childTiles(
+        std::make_move_iterator(this->_childTiles.begin()),
+        std::make_move_iterator(this->_childTiles.end()));
+    this->_childTiles.clear();
+
+    Tile tile = pContentUri ? Tile(&currentLoader)
+                            : Tile(&currentLoader, TileEmptyContent{});
+    tile.setTileID(pContentUri ? *pContentUri : std::string());
+    tile.setTransform(this->_tileTransform);
+    tile.setBoundingVolume(tileBoundingVolume);
+    tile.setViewerRequestVolume(tileViewerRequestVolume);
+    tile.setGeometricError(this->_tileGeometricError);
+    tile.setRefine(this->_tileRefine);
+    tile.setContentBoundingVolume(tileContentBoundingVolume);
+    tile.createChildTiles(std::move(childTiles));
+    if (!this->_childrenJson.empty()) {
+      currentLoader.deferTileChildren(tile, this->_childrenJson);
+    }
+
+    return tile;
+  }
+
+  const TileJsonContext& _context;
+
+  glm::dmat4 _parentTransform{1.0};
+  TileRefine _parentRefine = TileRefine::Replace;
+  double _parentGeometricError = 0.0;
+  std::vector<Tile>* _pTiles = nullptr;
+
+  std::optional<NumberArray> _transform;
+  std::optional<BoundingVolumeJson> _boundingVolume;
+  std::optional<BoundingVolumeJson> _viewerRequestVolume;
+  std::optional<double> _geometricError;
+  std::optional<std::string> _refine;
+  std::optional<ContentJson> _content;
+  rapidjson::StringBuffer _implicitTilingJson;
+  JsonCopyHandler::Writer _implicitTilingWriter;
+  bool _hasImplicitTiling = false;
+
+  bool _isResolved = false;
+  glm::dmat4 _tileTransform{1.0};
+  TileRefine _tileRefine = TileRefine::Replace;
+  double _tileGeometricError = 0.0;
+  uint32_t _childDepth = 0;
+  std::vector<Tile> _childTiles;
+  std::vector<Tile>* _pChildTiles = nullptr;
+  std::string_view _childrenJson;
+
+  NumberArrayJsonHandler _numbers;
+  BoundingVolumeJsonHandler _boundingVolumeHandler;
+  OptionalDoubleJsonHandler _geometricErrorHandler;
+  OptionalStringJsonHandler _refineHandler;
+  ContentJsonHandler _contentHandler;
+  TileExtensionsJsonHandler _extensionsHandler;
+  TileChildrenJsonHandler _childrenHandler;
+  ArrayTextJsonHandler _childrenTextHandler;
+  JsonCopyHandler _copyHandler;
+  std::unique_ptr<TileJsonHandler> _pChildHandler;
+};
+
+/**
+ * @brief Reads the children of a tile whose JSON text was kept by
+ * {@link TilesetJsonLoader::deferTileChildren}.
+ */
+class DeferredTileChildrenJsonHandler : public CesiumJsonReader::JsonHandler {
+public:
+  using ValueType = std::vector<Tile>;
+
+  DeferredTileChildrenJsonHandler(
+      const TileJsonContext& context,
+      const Tile& tile)
+      : JsonHandler(), _tile(tile), _tileHandler(context) {}
+
+  void reset(IJsonHandler* pParent, std::vector<Tile>* pChildren) {
+    JsonHandler::reset(pParent);
+    this->_pChildren = pChildren;
+  }
+
+  IJsonHandler* readArrayStart() override {
+    return this->_tileHandler
+        .readDeferredChildren(this->parent(), this->_tile, this->_pChildren)
+        ->readArrayStart();
+  }
+
+private:
+  const Tile& _tile;
+  TileJsonHandler _tileHandler;
+  std::vector<Tile>* _pChildren = nullptr;
+};
+
+CesiumJsonReader::IJsonHandler* TileChildrenJsonHandler::readObjectStart() {
+  if (!this->_isInArray) {
+    return JsonHandler::readObjectStart();
+  }
+  return this->_pTile->readChild(this);
+}
+
+CesiumJsonReader::IJsonHandler*
+TileExtensionsJsonHandler::readObjectKey(const std::string_view& str) {
+  if (str == "3DTILES_implicit_tiling") {
+    return this->_pTile->readImplicitTiling(this, str);
+  }
+  return this->ignoreAndContinue();
+}
+
+/**
+ * @brief The tiles of a tileset.json, as read by a
+ * {@link TilesetJsonHandler}.
+ */
+struct StreamedTilesetJson {
+  std::unique_ptr<TilesetJsonLoader> pLoader;
+  std::vector<Tile> rootTiles;
+};
+
+/**
+ * @brief Reads a tileset.json, creating its tiles as they are read.
+ *
+ * The properties of the tileset.json other than its tiles that are used by
+ * {@link obtainGltfUpAxis} and {@link parseTilesetMetadata} are copied so
+ * that they can be parsed into a small document.
+ */
+class TilesetJsonHandler : public CesiumJsonReader::ObjectJsonHandler {
+public:
+  using ValueType = StreamedTilesetJson;
+
+  TilesetJsonHandler(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& baseUrl,
+      const glm::dmat4& parentTransform,
+      TileRefine parentRefine,
+      uint32_t tileLevels)
+      : ObjectJsonHandler(),
+        _context{pLogger, nullptr, tileLevels},
+        _baseUrl(baseUrl),
+        _parentTransform(parentTransform),
+        _parentRefine(parentRefine),
+        _pTileset(nullptr),
+        _assetJson(),
+        _assetWriter(_assetJson),
+        _propertiesJson(),
+        _propertiesWriter(_propertiesJson),
+        _copyHandler(),
+        _rootHandler(_context) {}
+
+  void reset(IJsonHandler* pParent, StreamedTilesetJson* pTileset) {
+    JsonHandler::reset(pParent);
+    this->_pTileset = pTileset;
+    this->_context.pLoader = nullptr;
+    this->_assetJson.Clear();
+    this->_assetWriter.Reset(this->_assetJson);
+    this->_assetWriter.StartObject();
+    this->_propertiesJson.Clear();
+    this->_propertiesWriter.Reset(this->_propertiesJson);
+    this->_propertiesWriter.StartObject();
+  }
+
+  IJsonHandler* readObjectKey(const std::string_view& str) override {
+    if (str == "root") {
+      if (this->_pTileset->pLoader) {
+        return this->ignoreAndContinue();
+      }
+
+      this->_assetWriter.EndObject();
+      rapidjson::Document assetJson;
+      assetJson.Parse(this->_assetJson.GetString(), this->_assetJson.GetSize());
+      CesiumGeometry::Axis gltfUpAxis =
+          obtainGltfUpAxis(assetJson, this->_context.pLogger);
+
+      this->_pTileset->pLoader =
+          std::make_unique<TilesetJsonLoader>(this->_baseUrl, gltfUpAxis);
+      this->_context.pLoader = this->_pTileset->pLoader.get();
+      if (this->_context.tileLevels > 0) {
+        this->_context.pLoader->createDeferredTileChildren(
+            this->_context.pLogger,
+            this->_context.tileLevels);
+      }
+      this->_rootHandler.reset(
+          this,
+          this->_parentTransform,
+          this->_parentRefine,
+          10000000.0,
+          &this->_pTileset->rootTiles,
+          0);
+      return &this->_rootHandler;
+    }
+
+    if (str == "asset") {
+      if (this->_pTileset->pLoader) {
+        // The tiles have already been created with the loader, which needs
+        // the up axis from the asset.
+        return nullptr;
+      }
+      return this->copyProperty(this->_assetWriter, str);
+    }
+
+    if (str == "schema" || str == "schemaUri" || str == "metadata" ||
+        str == "groups") {
+      return this->copyProperty(this->_propertiesWriter, str);
+    }
+
+    return this->ignoreAndContinue();
+  }
+
+  /**
+   * @brief Parses the copied properties of the tileset.json into a document,
+   * after it has been read.
+   */
+  void parseProperties(rapidjson::Document& tilesetJson) {
+    this->_propertiesWriter.EndObject();
+    tilesetJson.Parse(
+        this->_propertiesJson.GetString(),
+        this->_propertiesJson.GetSize());
+  }
+
+private:
+  IJsonHandler*
+  copyProperty(JsonCopyHandler::Writer& writer, const std::string_view& key) {
+    writer.Key(key.data(), static_cast<rapidjson::SizeType>(key.size()));
+    this->_copyHandler.reset(this, &writer);
+    return &this->_copyHandler;
+  }
+
+  TileJsonContext _context;
+  std::string _baseUrl;
+  glm::dmat4 _parentTransform;
+  TileRefine _parentRefine;
+  StreamedTilesetJson* _pTileset;
+  rapidjson::StringBuffer _assetJson;
+  JsonCopyHandler::Writer _assetWriter;
+  rapidjson::StringBuffer _propertiesJson;
+  JsonCopyHandler::Writer _propertiesWriter;
+  JsonCopyHandler _copyHandler;
+  TileJsonHandler _rootHandler;
+};
+
+/**
+ * @brief Creates the tiles of a tileset.json as its JSON is read, in the same
+ * way as {@link parseTilesetJson} but without parsing the whole tileset.json
+ * into a document first.
+ *
+ * @param tileLevels The number of levels of tiles to create, below which the
+ * children of tiles are deferred, or 0 to create all of them.
+ * @param tilesetJson The document into which the properties of the
+ * tileset.json other than its tiles are parsed, for
+ * {@link parseTilesetMetadata}.
+ * @return The result, or std::nullopt if the tileset.json cannot be read this
+ * way, because it is not valid JSON, has no valid root tile, or has a tile
+ * whose children come before the properties they depend on. It must then be
+ * parsed into a document and read with {@link parseTilesetJson}.
+ */
+std::optional<TilesetContentLoaderResult<TilesetJsonLoader>> streamTilesetJson(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& baseUrl,
+    const gsl::span<const std::byte>& data,
+    const glm::dmat4& parentTransform,
+    TileRefine parentRefine,
+    uint32_t tileLevels,
+    rapidjson::Document& tilesetJson) {
+  TilesetJsonHandler handler(
+      pLogger,
+      baseUrl,
+      parentTransform,
+      parentRefine,
+      tileLevels);
+  CesiumJsonReader::ReadJsonResult<StreamedTilesetJson> result =
+      CesiumJsonReader::JsonReader::readJson(data, handler);
+  if (!result.value || result.value->rootTiles.empty()) {
+    return std::nullopt;
+  }
+
+  handler.parseProperties(tilesetJson);
+
+  return TilesetContentLoaderResult<TilesetJsonLoader>{
+      std::move(result.value->pLoader),
+      std::make_unique<Tile>(std::move(result.value->rootTiles[0])),
+      std::vector<LoaderCreditResult>{},
+      std::vector<CesiumAsync::IAssetAccessor::THeader>{},
+      ErrorList{}};
+}
+
+/**
+ * @brief Creates a root tile to represent the tileset.json itself, with the
+ * root tile of the tileset.json as its only child.
+ *
+ * @return The external content of the new root tile, to be populated with
+ * the metadata of the tileset.json.
+ */
+TileExternalContent* addTilesetJsonRootTile(
+    TilesetContentLoaderResult<TilesetJsonLoader>& result) {
+  std::vector<Tile> children;
+  children.emplace_back(std::move(*result.pRootTile));
+
+  result.pRootTile = std::make_unique<Tile>(
+      children[0].getLoader(),
+      std::make_unique<TileExternalContent>());
+
+  result.pRootTile->setTileID("");
+  result.pRootTile->setTransform(children[0].getTransform());
+  result.pRootTile->setBoundingVolume(children[0].getBoundingVolume());
+  result.pRootTile->setUnconditionallyRefine();
+  result.pRootTile->setRefine(children[0].getRefine());
+  result.pRootTile->createChildTiles(std::move(children));
+
+  return result.pRootTile->getContent().getExternalContent();
+}
+
+void addToDecodedContentCache(
+    const std::shared_ptr<DecodedContentCache>& pDecodedContentCache,
+    const std::optional<DecodedContentCache::Key>& contentKey,
+    const GltfConverterResult& result) {
+  if (pDecodedContentCache && contentKey && result.model && !result.errors) {
+    pDecodedContentCache->insert(*contentKey, *result.model);
+  }
+}
+
+TileLoadResult createTileLoadResultFromConversion(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    CesiumGeometry::Axis upAxis,
+    GltfConverterResult&& result,
+    std::shared_ptr<CesiumAsync::IAssetRequest>&& pCompletedRequest) {
+  // Report any errors if there are any
+  logTileLoadResult(pLogger, pCompletedRequest->url(), result.errors);
+  if (result.errors || !result.model) {
+    return TileLoadResult::createFailedResult(std::move(pCompletedRequest));
+  }
+
+  return TileLoadResult{
+      std::move(*result.model),
+      upAxis,
+      std::nullopt,
+      std::nullopt,
+      std::nullopt,
+      std::move(pCompletedRequest),
+      {},
+      TileLoadResultState::Success};
+}
+
 TileLoadResult parseExternalTilesetInWorkerThread(
     const glm::dmat4& tileTransform,
     CesiumGeometry::Axis upAxis,
     TileRefine tileRefine,
     const std::shared_ptr<spdlog::logger>& pLogger,
+    uint32_t tileLevels,
     std::shared_ptr<CesiumAsync::IAssetRequest>&& pCompletedRequest,
     ExternalContentInitializer&& externalContentInitializer) {
   // create external tileset
@@ -677,29 +1432,42 @@ TileLoadResult parseExternalTilesetInWorkerThread(
   const auto& responseData = pResponse->data();
   const auto& tileUrl = pCompletedRequest->url();
 
-  rapidjson::Document tilesetJson;
-  tilesetJson.Parse(
-      reinterpret_cast<const char*>(responseData.data()),
-      responseData.size());
-  if (tilesetJson.HasParseError()) {
-    SPDLOG_LOGGER_ERROR(
-        pLogger,
-        "Error when parsing tileset JSON, error code {} at byte offset {}",
-        tilesetJson.GetParseError(),
-        tilesetJson.GetErrorOffset());
-    return TileLoadResult::createFailedResult(std::move(pCompletedRequest));
-  }
-
   // Save the parsed external tileset into custom data.
   // We will propagate it back to tile later in the main
   // thread
-  TilesetContentLoaderResult<TilesetJsonLoader> externalTilesetLoader =
-      parseTilesetJson(
+  rapidjson::Document tilesetJson;
+  std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+      maybeExternalTilesetLoader = streamTilesetJson(
           pLogger,
           tileUrl,
-          tilesetJson,
+          responseData,
           tileTransform,
-          tileRefine);
+          tileRefine,
+          tileLevels,
+          tilesetJson);
+  if (!maybeExternalTilesetLoader) {
+    tilesetJson.Parse(
+        reinterpret_cast<const char*>(responseData.data()),
+        responseData.size());
+    if (tilesetJson.HasParseError()) {
+      SPDLOG_LOGGER_ERROR(
+          pLogger,
+          "Error when parsing tileset JSON, error code {} at byte offset {}",
+          tilesetJson.GetParseError(),
+          tilesetJson.GetErrorOffset());
+      return TileLoadResult::createFailedResult(std::move(pCompletedRequest));
+    }
+
+    maybeExternalTilesetLoader = parseTilesetJson(
+        pLogger,
+        tileUrl,
+        tilesetJson,
+        tileTransform,
+        tileRefine);
+  }
+
+  TilesetContentLoaderResult<TilesetJsonLoader>& externalTilesetLoader =
+      *maybeExternalTilesetLoader;
 
   // Populate the root tile with metadata
   parseTilesetMetadata(
@@ -773,6 +1541,15 @@ TilesetJsonLoader::createLoader(
 
         gsl::span<const std::byte> data = pResponse->data();
 
+        std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+            maybeResult = TilesetJsonLoader::createLoader(
+                pLogger,
+                pCompletedRequest->url(),
+                data);
+        if (maybeResult) {
+          return std::move(*maybeResult);
+        }
+
         rapidjson::Document tilesetJson;
         tilesetJson.Parse(
             reinterpret_cast<const char*>(data.data()),
@@ -805,30 +1582,42 @@ TilesetContentLoaderResult<TilesetJsonLoader> TilesetJsonLoader::createLoader(
       glm::dmat4(1.0),
       TileRefine::Replace);
 
-  // Create a root tile to represent the tileset.json itself.
-  std::vector<Tile> children;
-  children.emplace_back(std::move(*result.pRootTile));
+  TileExternalContent* pExternal = addTilesetJsonRootTile(result);
+  assert(pExternal);
+  if (pExternal) {
+    parseTilesetMetadata(tilesetJsonUrl, tilesetJson, *pExternal);
+  }
 
-  result.pRootTile = std::make_unique<Tile>(
-      children[0].getLoader(),
-      std::make_unique<TileExternalContent>());
+  return result;
+}
 
-  result.pRootTile->setTileID("");
-  result.pRootTile->setTransform(children[0].getTransform());
-  result.pRootTile->setBoundingVolume(children[0].getBoundingVolume());
-  result.pRootTile->setUnconditionallyRefine();
-  result.pRootTile->setRefine(children[0].getRefine());
-  result.pRootTile->createChildTiles(std::move(children));
+std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+TilesetJsonLoader::createLoader(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& tilesetJsonUrl,
+    const gsl::span<const std::byte>& tilesetJson,
+    uint32_t tileLevels) {
+  rapidjson::Document tilesetJsonProperties;
+  std::optional<TilesetContentLoaderResult<TilesetJsonLoader>> maybeResult =
+      streamTilesetJson(
+          pLogger,
+          tilesetJsonUrl,
+          tilesetJson,
+          glm::dmat4(1.0),
+          TileRefine::Replace,
+          tileLevels,
+          tilesetJsonProperties);
+  if (!maybeResult) {
+    return std::nullopt;
+  }
 
-  // Populate the root tile with metadata
-  TileExternalContent* pExternal =
-      result.pRootTile->getContent().getExternalContent();
+  TileExternalContent* pExternal = addTilesetJsonRootTile(*maybeResult);
   assert(pExternal);
   if (pExternal) {
-    parseTilesetMetadata(tilesetJsonUrl, tilesetJson, *pExternal);
+    parseTilesetMetadata(tilesetJsonUrl, tilesetJsonProperties, *pExternal);
   }
 
-  return result;
+  return maybeResult;
 }
 
 CesiumAsync::Future<TileLoadResult>
@@ -857,81 +1646,171 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
   const auto& pLogger = loadInput.pLogger;
   const auto& requestHeaders = loadInput.requestHeaders;
   const auto& contentOptions = loadInput.contentOptions;
-  std::string resolvedUrl =
-      CesiumUtility::Uri::resolve(this->_baseUrl, *url, true);
-  return pAssetAccessor->get(asyncSystem, resolvedUrl, requestHeaders)
-      .thenInWorkerThread(
-          [pLogger,
-           contentOptions,
-           tileTransform,
-           tileRefine,
-           upAxis = _upAxis,
-           externalContentInitializer = std::move(externalContentInitializer)](
-              std::shared_ptr<CesiumAsync::IAssetRequest>&&
-                  pCompletedRequest) mutable {
-            auto pResponse = pCompletedRequest->response();
-            const std::string& tileUrl = pCompletedRequest->url();
-            if (!pResponse) {
-              SPDLOG_LOGGER_ERROR(
-                  pLogger,
-                  "Did not receive a valid response for tile content {}",
-                  tileUrl);
-              return TileLoadResult::createFailedResult(
-                  std::move(pCompletedRequest));
-            }
+  std::string resolvedUrl = this->_baseUrl.resolve(*url, true);
+
+  // Read a GLB while it downloads, if the asset accessor streams responses.
+  auto pStreamReader = std::make_shared<CesiumGltfReader::GltfStreamReader>(
+      BinaryToGltfConverter::createStreamReader());
+  auto onDataReceived =
+      [pStreamReader](const gsl::span<const std::byte>& data) {
+        pStreamReader->append(data);
+      };
+
+  return thenInDecodeThread(
+      pAssetAccessor->getStreaming(
+          asyncSystem,
+          resolvedUrl,
+          requestHeaders,
+          onDataReceived),
+      loadInput.decodeThreadPool,
+      loadInput.priority,
+      [asyncSystem,
+       pLogger,
+       pStreamReader,
+       contentOptions,
+       tileTransform,
+       tileRefine,
+       upAxis = _upAxis,
+       externalContentInitializer = std::move(externalContentInitializer),
+       pLoadCanceled = loadInput.pLoadCanceled](
+          std::shared_ptr<CesiumAsync::IAssetRequest>&&
+              pCompletedRequest) mutable {
+        // Don't decode the content of a tile that is no longer needed.
+        if (pLoadCanceled && *pLoadCanceled) {
+          return asyncSystem.createResolvedFuture(
+              TileLoadResult::createRetryLaterResult(
+                  std::move(pCompletedRequest)));
+        }
 
-            uint16_t statusCode = pResponse->statusCode();
-            if (statusCode != 0 && (statusCode < 200 || statusCode >= 300)) {
-              SPDLOG_LOGGER_ERROR(
-                  pLogger,
-                  "Received status code {} for tile content {}",
-                  statusCode,
-                  tileUrl);
-              return TileLoadResult::createFailedResult(
-                  std::move(pCompletedRequest));
-            }
+        auto pResponse = pCompletedRequest->response();
+        const std::string& tileUrl = pCompletedRequest->url();
+        if (!pResponse) {
+          SPDLOG_LOGGER_ERROR(
+              pLogger,
+              "Did not receive a valid response for tile content {}",
+              tileUrl);
+          return asyncSystem.createResolvedFuture(
+              TileLoadResult::createFailedResult(
+                  std::move(pCompletedRequest)));
+        }
 
-            // find gltf converter
-            const auto& responseData = pResponse->data();
-            auto converter = GltfConverters::getConverterByMagic(responseData);
-            if (!converter) {
-              converter = GltfConverters::getConverterByFileExtension(tileUrl);
-            }
+        uint16_t statusCode = pResponse->statusCode();
+        if (statusCode != 0 && (statusCode < 200 || statusCode >= 300)) {
+          SPDLOG_LOGGER_ERROR(
+              pLogger,
+              "Received status code {} for tile content {}",
+              statusCode,
+              tileUrl);
+          return asyncSystem.createResolvedFuture(
+              TileLoadResult::createFailedResult(
+                  std::move(pCompletedRequest)));
+        }
+
+        // find gltf converter
+        const auto& responseData = pResponse->data();
+        auto converter = GltfConverters::getConverterByMagic(responseData);
+        if (!converter) {
+          converter = GltfConverters::getConverterByFileExtension(tileUrl);
+        }
 
-            if (converter) {
-              // Convert to gltf
-              CesiumGltfReader::GltfReaderOptions gltfOptions;
-              gltfOptions.ktx2TranscodeTargets =
-                  contentOptions.ktx2TranscodeTargets;
-              GltfConverterResult result = converter(responseData, gltfOptions);
-
-              // Report any errors if there are any
-              logTileLoadResult(pLogger, tileUrl, result.errors);
-              if (result.errors) {
-                return TileLoadResult::createFailedResult(
-                    std::move(pCompletedRequest));
-              }
-
-              return TileLoadResult{
-                  std::move(*result.model),
+        // A GLB that was read while it downloaded only needs finishing.
+        const bool isStreamed = pStreamReader->isComplete();
+        if (isStreamed || converter) {
+          // Identical content may already have been decoded for another tile.
+          const std::shared_ptr<DecodedContentCache>& pDecodedContentCache =
+              contentOptions.pDecodedContentCache;
+          std::optional<DecodedContentCache::Key> contentKey;
+          if (pDecodedContentCache) {
+            contentKey = DecodedContentCache::computeKey(responseData);
+            std::optional<CesiumGltf::Model> cachedModel =
+                pDecodedContentCache->find(*contentKey);
+            if (cachedModel) {
+              GltfConverterResult result;
+              result.model = std::move(cachedModel);
+              return asyncSystem.createResolvedFuture(
+                  createTileLoadResultFromConversion(
+                      pLogger,
+                      upAxis,
+                      std::move(result),
+                      std::move(pCompletedRequest)));
+            }
+          }
+
+          // Convert to gltf
+          CesiumGltfReader::GltfReaderOptions gltfOptions;
+          gltfOptions.ktx2TranscodeTargets =
+              contentOptions.ktx2TranscodeTargets;
+          gltfOptions.requiredAttributes = contentOptions.requiredAttributes;
+          gltfOptions.optimizeMeshes = contentOptions.optimizeMeshes;
+          gltfOptions.loadImages = !contentOptions.geometryOnly;
+          gltfOptions.upgradeBatchTables = !contentOptions.geometryOnly;
+          gltfOptions.decodeAsyncSystem = asyncSystem;
+
+          // The inner tiles of a composite tile are converted concurrently.
+          const GltfConverters::ConverterFunction cmptConverter =
+              CmptToGltfConverter::convert;
+          if (!isStreamed && converter == cmptConverter) {
+            CesiumAsync::Future<GltfConverterResult> futureResult =
+                CmptToGltfConverter::convert(
+                    asyncSystem,
+                    pCompletedRequest->takeResponseData(),
+                    gltfOptions);
+            return std::move(futureResult)
+                .thenImmediately(
+                    [pLogger,
+                     upAxis,
+                     pDecodedContentCache,
+                     contentKey,
+                     pCompletedRequest = std::move(pCompletedRequest)](
+                        GltfConverterResult&& result) mutable {
+                      addToDecodedContentCache(
+                          pDecodedContentCache,
+                          contentKey,
+                          result);
+                      return createTileLoadResultFromConversion(
+                          pLogger,
+                          upAxis,
+                          std::move(result),
+                          std::move(pCompletedRequest));
+                    });
+          }
+
+          GltfConverterResult result;
+          if (isStreamed) {
+            result =
+                BinaryToGltfConverter::convert(*pStreamReader, gltfOptions);
+          } else {
+            // Move the response data into the glTF instead of copying it, if
+            // the converter can take ownership of it.
+            GltfConverters::OwningConverterFunction owningConverter =
+                GltfConverters::getOwningConverterByMagic(responseData);
+            result = owningConverter
+                         ? owningConverter(
+                               pCompletedRequest->takeResponseData(),
+                               gltfOptions)
+                         : converter(responseData, gltfOptions);
+          }
+
+          addToDecodedContentCache(pDecodedContentCache, contentKey, result);
+          return asyncSystem.createResolvedFuture(
+              createTileLoadResultFromConversion(
+                  pLogger,
                   upAxis,
-                  std::nullopt,
-                  std::nullopt,
-                  std::nullopt,
-                  std::move(pCompletedRequest),
-                  {},
-                  TileLoadResultState::Success};
-            } else {
-              // not a renderable content, then it must be external tileset
-              return parseExternalTilesetInWorkerThread(
+                  std::move(result),
+                  std::move(pCompletedRequest)));
+        } else {
+          // not a renderable content, then it must be external tileset
+          return asyncSystem.createResolvedFuture(
+              parseExternalTilesetInWorkerThread(
                   tileTransform,
                   upAxis,
                   tileRefine,
                   pLogger,
+                  contentOptions.tilesetJsonTileLevels,
                   std::move(pCompletedRequest),
-                  std::move(externalContentInitializer));
-            }
-          });
+                  std::move(externalContentInitializer)));
+        }
+      });
 }
 
 TileChildrenResult TilesetJsonLoader::createTileChildren(const Tile& tile) {
@@ -940,17 +1819,114 @@ TileChildrenResult TilesetJsonLoader::createTileChildren(const Tile& tile) {
     return pLoader->createTileChildren(tile);
   }
 
-  return {{}, TileLoadResultState::Failed};
+  if (tile._deferredChildrenIndex == Tile::InvalidDeferredChildrenIndex) {
+    return {{}, TileLoadResultState::Failed};
+  }
+
+  const DeferredChildren& deferredChildren =
+      this->_deferredChildren[tile._deferredChildrenIndex];
+  const gsl::span<const std::byte> childrenJson(
+      reinterpret_cast<const std::byte*>(
+          this->_deferredChildrenJson.data() + deferredChildren.offset),
+      deferredChildren.size);
+
+  TileJsonContext context{
+      this->_pDeferredChildrenLogger,
+      this,
+      this->_deferredTileLevels};
+  DeferredTileChildrenJsonHandler handler(context, tile);
+  CesiumJsonReader::ReadJsonResult<std::vector<Tile>> result =
+      CesiumJsonReader::JsonReader::readJson(childrenJson, handler);
+  if (!result.value) {
+    return {{}, TileLoadResultState::Failed};
+  }
+
+  return {std::move(*result.value), TileLoadResultState::Success};
+}
+
+void TilesetJsonLoader::addMemoryUsage(TilesetMemoryUsage& usage) const {
+  usage.availabilityBytes += static_cast<int64_t>(
+      this->_deferredChildrenJson.capacity() +
+      this->_deferredChildren.capacity() * sizeof(DeferredChildren));
+  for (const std::unique_ptr<TilesetContentLoader>& pChild : this->_children) {
+    pChild->addMemoryUsage(usage);
+  }
+}
+
+int64_t TilesetJsonLoader::trimMemory() {
+  int64_t bytesReleased = 0;
+  for (const std::unique_ptr<TilesetContentLoader>& pChild : this->_children) {
+    bytesReleased += pChild->trimMemory();
+  }
+  return bytesReleased;
+}
+
+CesiumAsync::Future<void>
+TilesetJsonLoader::loadTileChildren(const TileLoadInput& loadInput) {
+  TilesetContentLoader* pLoader = loadInput.tile.getLoader();
+  if (pLoader && pLoader != this) {
+    return pLoader->loadTileChildren(loadInput);
+  }
+
+  // The children of the tiles in the tileset JSON are created with them, and
+  // those of external tilesets are loaded with the tile's content.
+  return loadInput.asyncSystem.createResolvedFuture();
+}
+
+std::optional<std::string>
+TilesetJsonLoader::getTileContentUrl(const Tile& tile) const {
+  const TilesetContentLoader* pLoader = tile.getLoader();
+  if (pLoader != this) {
+    return pLoader ? pLoader->getTileContentUrl(tile) : std::nullopt;
+  }
+
+  const std::string* url = std::get_if<std::string>(&tile.getTileID());
+  if (!url || url->empty()) {
+    return std::nullopt;
+  }
+
+  return this->_baseUrl.resolve(*url, true);
 }
 
 const std::string& TilesetJsonLoader::getBaseUrl() const noexcept {
-  return this->_baseUrl;
+  return this->_baseUrl.getUri();
 }
 
 CesiumGeometry::Axis TilesetJsonLoader::getUpAxis() const noexcept {
   return _upAxis;
 }
 
+void TilesetJsonLoader::createDeferredTileChildren(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    uint32_t tileLevels) {
+  this->_pDeferredChildrenLogger = pLogger;
+  this->_deferredTileLevels = tileLevels;
+}
+
+void TilesetJsonLoader::deferTileChildren(
+    Tile& tile,
+    const std::string_view& childrenJson) {
+  // The children of deferred children are read from the text that is already
+  // kept, so only the text of the tileset.json itself is copied.
+  const char* pBegin = this->_deferredChildrenJson.data();
+  const char* pEnd = pBegin + this->_deferredChildrenJson.size();
+  size_t offset;
+  if (std::less_equal<const char*>()(pBegin, childrenJson.data()) &&
+      std::less<const char*>()(childrenJson.data(), pEnd)) {
+    offset = static_cast<size_t>(childrenJson.data() - pBegin);
+  } else {
+    offset = this->_deferredChildrenJson.size();
+    this->_deferredChildrenJson.insert(
+        this->_deferredChildrenJson.end(),
+        childrenJson.begin(),
+        childrenJson.end());
+  }
+
+  tile._deferredChildrenIndex =
+      static_cast<uint32_t>(this->_deferredChildren.size());
+  this->_deferredChildren.push_back({offset, childrenJson.size()});
+}
+
 void TilesetJsonLoader::addChildLoader(
     std::unique_ptr<TilesetContentLoader> pLoader) {
   this->_children.emplace_back(std::move(pLoader));
@@ -6,11 +6,17 @@
 #include <Cesium3DTilesSelection/TilesetExternals.h>
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumUtility/Uri.h>
 
+#include <gsl/span>
 #include <rapidjson/fwd.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
@@ -23,12 +29,41 @@ public:
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
 
+  void addMemoryUsage(TilesetMemoryUsage& usage) const override;
+
+  int64_t trimMemory() override;
+
+  CesiumAsync::Future<void>
+  loadTileChildren(const TileLoadInput& loadInput) override;
+
+  std::optional<std::string>
+  getTileContentUrl(const Tile& tile) const override;
+
   const std::string& getBaseUrl() const noexcept;
 
   CesiumGeometry::Axis getUpAxis() const noexcept;
 
   void addChildLoader(std::unique_ptr<TilesetContentLoader> pLoader);
 
+  /**
+   * @brief Makes {@link createTileChildren} create the children of the tiles
+   * passed to {@link deferTileChildren}, with the given number of levels of
+   * their descendants.
+   */
+  void createDeferredTileChildren(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      uint32_t tileLevels);
+
+  /**
+   * @brief Keeps the JSON text of the children of a tile created by this
+   * loader, so that they are created by {@link createTileChildren} when the
+   * tile is first visited rather than with the tile.
+   *
+   * @param tile The tile, which must not have children.
+   * @param childrenJson The JSON array of the children of the tile.
+   */
+  void deferTileChildren(Tile& tile, const std::string_view& childrenJson);
+
   static CesiumAsync::Future<TilesetContentLoaderResult<TilesetJsonLoader>>
   createLoader(
       const TilesetExternals& externals,
@@ -40,8 +75,29 @@ public:
       const std::string& tilesetJsonUrl,
       const rapidjson::Document& tilesetJson);
 
+  /**
+   * @brief Creates a loader from the content of a tileset.json, creating its
+   * tiles as the JSON is read rather than from a parsed document, which is
+   * faster and uses less memory for large tilesets.
+   *
+   * @param pLogger The logger.
+   * @param tilesetJsonUrl The URL of the tileset.json.
+   * @param tilesetJson The content of the tileset.json.
+   * @param tileLevels The number of levels of tiles to create at once, as
+   * {@link TilesetContentOptions::tilesetJsonTileLevels}.
+   * @return The result, or std::nullopt if the content cannot be read this
+   * way, such as when it is not a tileset.json. It must then be parsed into a
+   * document and passed to the other overload.
+   */
+  static std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+  createLoader(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& tilesetJsonUrl,
+      const gsl::span<const std::byte>& tilesetJson,
+      uint32_t tileLevels = 0);
+
 private:
-  std::string _baseUrl;
+  CesiumUtility::BaseUri _baseUrl;
 
   /**
    * @brief The axis that was declared as the "up-axis" for glTF content.
@@ -56,5 +112,17 @@ private:
   CesiumGeometry::Axis _upAxis;
 
   std::vector<std::unique_ptr<TilesetContentLoader>> _children;
+
+  struct DeferredChildren {
+    size_t offset;
+    size_t size;
+  };
+
+  // The JSON text of the children of the tiles passed to deferTileChildren,
+  // and where the children of each tile are in it.
+  std::vector<char> _deferredChildrenJson;
+  std::vector<DeferredChildren> _deferredChildren;
+  std::shared_ptr<spdlog::logger> _pDeferredChildrenLogger;
+  uint32_t _deferredTileLevels = 0;
 };
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Adds the time spent in its scope, in seconds, to a duration.
+ *
+ * When constructed with `nullptr`, nothing is measured, so timings that are
+ * turned off only cost a branch.
+ */
+class TimingScope {
+public:
+  /**
+   * @brief Starts measuring.
+   *
+   * @param pSeconds The duration to add to, or `nullptr`.
+   */
+  explicit TimingScope(double* pSeconds) noexcept
+      : _pSeconds(pSeconds),
+        _start(
+            pSeconds ? std::chrono::steady_clock::now()
+                     : std::chrono::steady_clock::time_point()) {}
+
+  ~TimingScope() noexcept {
+    if (this->_pSeconds) {
+      *this->_pSeconds += std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - this->_start)
+                              .count();
+    }
+  }
+
+  TimingScope(const TimingScope&) = delete;
+  TimingScope& operator=(const TimingScope&) = delete;
+
+private:
+  double* _pSeconds;
+  std::chrono::steady_clock::time_point _start;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -2,8 +2,14 @@
 
 #include <CesiumGeometry/CullingVolume.h>
 
+#include <glm/common.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 
@@ -122,6 +128,162 @@ bool ViewState::isBoundingVolumeVisible(
   return std::visit(Operation{*this}, boundingVolume);
 }
 
+namespace {
+// The number of bounding volumes that are tested together against each plane.
+constexpr size_t visibilityBatchSize = 8;
+
+const OrientedBoundingBox*
+getOrientedBoundingBox(const BoundingVolume& boundingVolume) noexcept {
+  struct Operation {
+    const OrientedBoundingBox*
+    operator()(const OrientedBoundingBox& boundingBox) noexcept {
+      return &boundingBox;
+    }
+
+    const OrientedBoundingBox*
+    operator()(const BoundingRegion& boundingRegion) noexcept {
+      return &boundingRegion.getBoundingBox();
+    }
+
+    const OrientedBoundingBox* operator()(
+        const BoundingRegionWithLooseFittingHeights& boundingRegion) noexcept {
+      return &boundingRegion.getBoundingRegion().getBoundingBox();
+    }
+
+    const OrientedBoundingBox* operator()(const BoundingSphere&) noexcept {
+      return nullptr;
+    }
+
+    const OrientedBoundingBox*
+    operator()(const S2CellBoundingVolume&) noexcept {
+      return nullptr;
+    }
+  };
+
+  return std::visit(Operation{}, boundingVolume);
+}
+} // namespace
+
+void ViewState::areBoundingVolumesVisible(
+    gsl::span<const BoundingVolume* const> boundingVolumes,
+    gsl::span<bool> visible) const noexcept {
+  assert(boundingVolumes.size() == visible.size());
+
+  const std::array<const Plane*, 4> planes{
+      &this->_cullingVolume.leftPlane,
+      &this->_cullingVolume.rightPlane,
+      &this->_cullingVolume.topPlane,
+      &this->_cullingVolume.bottomPlane};
+
+  for (size_t start = 0; start < boundingVolumes.size();
+       start += visibilityBatchSize) {
+    const size_t count =
+        std::min(visibilityBatchSize, boundingVolumes.size() - start);
+
+    // Spheres are stored with zero half axes and boxes with a zero radius, so
+    // that both take the same path through the plane test below. Unused lanes
+    // are zero spheres, whose results are ignored.
+    std::array<double, visibilityBatchSize> centerX{};
+    std::array<double, visibilityBatchSize> centerY{};
+    std::array<double, visibilityBatchSize> centerZ{};
+    std::array<double, visibilityBatchSize> radius{};
+    std::array<std::array<double, 9>, visibilityBatchSize> halfAxes{};
+    std::array<uint8_t, visibilityBatchSize> isBox{};
+    std::array<uint8_t, visibilityBatchSize> outside{};
+
+    for (size_t i = 0; i < count; ++i) {
+      const BoundingVolume& boundingVolume = *boundingVolumes[start + i];
+      const OrientedBoundingBox* pBox = getOrientedBoundingBox(boundingVolume);
+      if (pBox) {
+        const glm::dvec3& center = pBox->getCenter();
+        const glm::dmat3& axes = pBox->getHalfAxes();
+        centerX[i] = center.x;
+        centerY[i] = center.y;
+        centerZ[i] = center.z;
+        for (glm::length_t axis = 0; axis < 3; ++axis) {
+          for (glm::length_t component = 0; component < 3; ++component) {
+            halfAxes[i][size_t(axis * 3 + component)] = axes[axis][component];
+          }
+        }
+        isBox[i] = 1;
+      } else if (
+          const BoundingSphere* pSphere =
+              std::get_if<BoundingSphere>(&boundingVolume)) {
+        const glm::dvec3& center = pSphere->getCenter();
+        centerX[i] = center.x;
+        centerY[i] = center.y;
+        centerZ[i] = center.z;
+        radius[i] = pSphere->getRadius();
+      }
+    }
+
+    for (const Plane* pPlane : planes) {
+      const glm::dvec3& normal = pPlane->getNormal();
+      const double planeDistance = pPlane->getDistance();
+
+      for (size_t i = 0; i < visibilityBatchSize; ++i) {
+        const std::array<double, 9>& axes = halfAxes[i];
+        const double effectiveRadius =
+            glm::abs(
+                normal.x * axes[0] + normal.y * axes[1] + normal.z * axes[2]) +
+            glm::abs(
+                normal.x * axes[3] + normal.y * axes[4] + normal.z * axes[5]) +
+            glm::abs(
+                normal.x * axes[6] + normal.y * axes[7] + normal.z * axes[8]) +
+            radius[i];
+        const double distance = normal.x * centerX[i] + normal.y * centerY[i] +
+                                normal.z * centerZ[i] + planeDistance;
+
+        // A box touching the plane from outside is outside, like in
+        // OrientedBoundingBox::intersectPlane, but a sphere is not.
+        outside[i] = uint8_t(
+            outside[i] | (distance < -effectiveRadius) |
+            (isBox[i] & (distance == -effectiveRadius)));
+      }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      const BoundingVolume& boundingVolume = *boundingVolumes[start + i];
+      if (std::holds_alternative<S2CellBoundingVolume>(boundingVolume)) {
+        visible[start + i] = this->isBoundingVolumeVisible(boundingVolume);
+      } else {
+        visible[start + i] = !outside[i];
+      }
+    }
+  }
+}
+
+bool ViewState::isBoundingVolumeVisible(
+    const BoundingVolume& boundingVolume,
+    const BoundingSphere& enclosingSphere) const noexcept {
+  if (std::holds_alternative<BoundingSphere>(boundingVolume)) {
+    return this->isBoundingVolumeVisible(boundingVolume);
+  }
+
+  const std::array<const Plane*, 4> planes{
+      &this->_cullingVolume.leftPlane,
+      &this->_cullingVolume.rightPlane,
+      &this->_cullingVolume.topPlane,
+      &this->_cullingVolume.bottomPlane};
+
+  bool crossesPlane = false;
+  for (const Plane* pPlane : planes) {
+    const CullingResult result = enclosingSphere.intersectPlane(*pPlane);
+    if (result == CullingResult::Outside) {
+      // The bounding volume is on the same side of the plane.
+      return false;
+    }
+    crossesPlane |= result == CullingResult::Intersecting;
+  }
+
+  if (!crossesPlane) {
+    // The sphere, and so the bounding volume, is entirely inside the frustum.
+    return true;
+  }
+
+  return this->isBoundingVolumeVisible(boundingVolume);
+}
+
 double ViewState::computeDistanceSquaredToBoundingVolume(
     const BoundingVolume& boundingVolume) const noexcept {
   struct Operation {
@@ -13,6 +13,7 @@ class SimplePrepareRendererResource
     : public Cesium3DTilesSelection::IPrepareRendererResources {
 public:
   std::atomic<size_t> totalAllocation{};
+  int64_t gpuBytesPerTile{0};
 
   struct AllocationResult {
     AllocationResult(std::atomic<size_t>& allocCount_)
@@ -67,6 +68,12 @@ public:
     }
   }
 
+  virtual int64_t getGpuByteSize(
+      const Cesium3DTilesSelection::Tile& /*tile*/,
+      void* /*pMainThreadResult*/) const noexcept override {
+    return gpuBytesPerTile;
+  }
+
   virtual void* prepareRasterInLoadThread(
       CesiumGltf::ImageCesium& /*image*/,
       const std::any& /*rendererOptions*/) override {
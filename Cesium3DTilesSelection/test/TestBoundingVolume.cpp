@@ -1,7 +1,10 @@
 #include <Cesium3DTilesSelection/BoundingVolume.h>
 #include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeospatial/S2CellID.h>
 
 #include <catch2/catch.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
 
 using namespace Cesium3DTilesSelection;
 using namespace CesiumGeometry;
@@ -56,3 +59,50 @@ TEST_CASE("getOrientedBoundingBoxFromBoundingVolume") {
         newObb.getHalfAxes());
   }
 }
+
+TEST_CASE("computeEnclosingSphere") {
+  SECTION("for BoundingSphere, the sphere is returned directly") {
+    BoundingSphere bs(glm::dvec3(1.0, 2.0, 3.0), 10.0);
+    BoundingSphere sphere = computeEnclosingSphere(bs);
+    CHECK(sphere.getCenter() == bs.getCenter());
+    CHECK(sphere.getRadius() == bs.getRadius());
+  }
+
+  SECTION("for OrientedBoundingBox, every corner is enclosed") {
+    OrientedBoundingBox obb(
+        glm::dvec3(1.0, 2.0, 3.0),
+        glm::dmat3(
+            glm::dvec3(1.0, 0.0, 0.0),
+            glm::dvec3(1.0, 1.0, 0.0),
+            glm::dvec3(0.0, 0.0, 2.0)));
+    BoundingSphere sphere = computeEnclosingSphere(obb);
+    CHECK(sphere.getCenter() == obb.getCenter());
+
+    const glm::dmat3& halfAxes = obb.getHalfAxes();
+    double farthest = 0.0;
+    for (double x : {-1.0, 1.0}) {
+      for (double y : {-1.0, 1.0}) {
+        for (double z : {-1.0, 1.0}) {
+          const glm::dvec3 corner =
+              x * halfAxes[0] + y * halfAxes[1] + z * halfAxes[2];
+          farthest = glm::max(farthest, glm::length(corner));
+        }
+      }
+    }
+    CHECK(sphere.getRadius() == Approx(farthest));
+  }
+
+  SECTION("for S2CellBoundingVolume, every vertex is enclosed") {
+    S2CellBoundingVolume s2(
+        S2CellID::fromToken("89c25"),
+        0.0,
+        1000.0,
+        Ellipsoid::WGS84);
+    BoundingSphere sphere = computeEnclosingSphere(s2);
+    for (const glm::dvec3& vertex : s2.getVertices()) {
+      CHECK(
+          glm::distance(vertex, sphere.getCenter()) <=
+          sphere.getRadius() * (1.0 + 1e-12));
+    }
+  }
+}
@@ -0,0 +1,60 @@
+#include <Cesium3DTilesSelection/CostAwareTileEvictionPolicy.h>
+#include <Cesium3DTilesSelection/Tile.h>
+
+#include <catch2/catch.hpp>
+
+using namespace Cesium3DTilesSelection;
+
+TEST_CASE("CostAwareTileEvictionPolicy") {
+  CostAwareTileEvictionPolicy policy(10.0);
+  Tile a(nullptr);
+  Tile b(nullptr);
+
+  policy.startNewFrame();
+  policy.notifyTileVisited(a);
+  policy.notifyTileVisited(b);
+
+  SECTION("keeps tiles that were slower to load") {
+    policy.notifyTileLoaded(a, 0.5);
+    policy.notifyTileLoaded(b, 0.1);
+    CHECK(policy.computeRetentionScore(a) > policy.computeRetentionScore(b));
+  }
+
+  SECTION("keeps tiles that come back into view") {
+    policy.notifyTileLoaded(a, 0.1);
+    policy.notifyTileLoaded(b, 0.1);
+
+    // Tile b stays in view, while tile a leaves the view and comes back.
+    policy.startNewFrame();
+    policy.notifyTileVisited(b);
+    policy.startNewFrame();
+    policy.notifyTileVisited(b);
+    policy.startNewFrame();
+    policy.notifyTileVisited(a);
+    policy.notifyTileVisited(b);
+
+    CHECK(policy.computeRetentionScore(a) > policy.computeRetentionScore(b));
+  }
+
+  SECTION("scores decay with the time since the last visit") {
+    policy.notifyTileLoaded(a, 0.1);
+    policy.notifyTileLoaded(b, 0.1);
+
+    for (int i = 0; i < 10; ++i) {
+      policy.startNewFrame();
+      policy.notifyTileVisited(b);
+    }
+
+    CHECK(
+        policy.computeRetentionScore(a) ==
+        Approx(policy.computeRetentionScore(b) * 0.5));
+  }
+
+  SECTION("tiles with unobserved loads use the average load time") {
+    Tile c(nullptr);
+    policy.notifyTileVisited(c);
+    policy.notifyTileLoaded(a, 0.2);
+    policy.notifyTileLoaded(b, 0.4);
+    CHECK(policy.computeRetentionScore(c) == Approx(0.3));
+  }
+}
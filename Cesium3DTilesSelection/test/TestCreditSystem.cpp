@@ -146,3 +146,90 @@ TEST_CASE("Test setting showOnScreen on credits") {
   CHECK(creditSystem.shouldBeShownOnScreen(credit1) == true);
   CHECK(creditSystem.shouldBeShownOnScreen(credit2) == true);
 }
+
+TEST_CASE("Test referenced credits") {
+
+  CreditSystem creditSystem;
+
+  Credit credit0 = creditSystem.createCredit("<html>Credit0</html>");
+  Credit credit1 = creditSystem.createCredit("<html>Credit1</html>");
+
+  // Frame 0: a referenced credit is shown without being added to the frame
+  creditSystem.addCreditReference(credit0);
+  creditSystem.addCreditToFrame(credit1);
+
+  std::vector<Credit> expectedShow0{credit0, credit1};
+  REQUIRE(creditSystem.getCreditsToShowThisFrame() == expectedShow0);
+
+  // Frame 1: it is still shown, while the credit that was only added to the
+  // last frame is not
+  creditSystem.startNextFrame();
+
+  std::vector<Credit> expectedShow1{credit0};
+  REQUIRE(creditSystem.getCreditsToShowThisFrame() == expectedShow1);
+
+  std::vector<Credit> expectedHide1{credit1};
+  REQUIRE(creditSystem.getCreditsToNoLongerShowThisFrame() == expectedHide1);
+
+  // Frame 2: each reference counts as a use when sorting
+  creditSystem.startNextFrame();
+  creditSystem.addCreditReference(credit1);
+  creditSystem.addCreditReference(credit1);
+
+  std::vector<Credit> expectedShow2{credit1, credit0};
+  REQUIRE(creditSystem.getCreditsToShowThisFrame() == expectedShow2);
+  REQUIRE(creditSystem.getCreditsToNoLongerShowThisFrame().empty());
+
+  // Frame 3: a credit is shown until its last reference is removed, and for
+  // the rest of that frame
+  creditSystem.startNextFrame();
+  creditSystem.removeCreditReference(credit0);
+  creditSystem.removeCreditReference(credit1);
+
+  std::vector<Credit> expectedShow3{credit1, credit0};
+  REQUIRE(creditSystem.getCreditsToShowThisFrame() == expectedShow3);
+
+  // Frame 4
+  creditSystem.startNextFrame();
+
+  std::vector<Credit> expectedShow4{credit1};
+  REQUIRE(creditSystem.getCreditsToShowThisFrame() == expectedShow4);
+
+  std::vector<Credit> expectedHide4{credit0};
+  REQUIRE(creditSystem.getCreditsToNoLongerShowThisFrame() == expectedHide4);
+}
+
+TEST_CASE("Test detecting changed credits") {
+
+  CreditSystem creditSystem;
+
+  Credit credit0 = creditSystem.createCredit("<html>Credit0</html>");
+  Credit credit1 = creditSystem.createCredit("<html>Credit1</html>");
+
+  creditSystem.addCreditReference(credit0);
+  CHECK(creditSystem.haveCreditsChangedThisFrame());
+
+  creditSystem.startNextFrame();
+  CHECK(!creditSystem.haveCreditsChangedThisFrame());
+
+  creditSystem.startNextFrame();
+  creditSystem.addCreditToFrame(credit1, 2);
+  CHECK(creditSystem.haveCreditsChangedThisFrame());
+
+  // the same credits in a different order
+  creditSystem.startNextFrame();
+  creditSystem.addCreditToFrame(credit0, 2);
+  creditSystem.addCreditToFrame(credit1);
+  CHECK(creditSystem.haveCreditsChangedThisFrame());
+
+  creditSystem.startNextFrame();
+  creditSystem.addCreditToFrame(credit0, 2);
+  creditSystem.addCreditToFrame(credit1);
+  CHECK(!creditSystem.haveCreditsChangedThisFrame());
+
+  creditSystem.startNextFrame();
+  creditSystem.addCreditToFrame(credit0, 2);
+  creditSystem.addCreditToFrame(credit1);
+  creditSystem.setShowOnScreen(credit1, true);
+  CHECK(creditSystem.haveCreditsChangedThisFrame());
+}
@@ -0,0 +1,145 @@
+#include <Cesium3DTilesSelection/DecodedContentCache.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+std::vector<std::byte> createContent(size_t byteLength, uint8_t seed) {
+  std::vector<std::byte> content(byteLength);
+  for (size_t i = 0; i < byteLength; ++i) {
+    content[i] = std::byte(uint8_t(seed + i * 7));
+  }
+  return content;
+}
+
+CesiumGltf::Model createModel(size_t byteLength) {
+  CesiumGltf::Model model;
+  model.buffers.emplace_back().cesium.data = createContent(byteLength, 3);
+  return model;
+}
+} // namespace
+
+TEST_CASE("DecodedContentCache") {
+  SECTION("computes equal keys only for equal content") {
+    const std::vector<std::byte> content = createContent(1001, 0);
+    const DecodedContentCache::Key key =
+        DecodedContentCache::computeKey(content);
+    CHECK(key.byteLength == content.size());
+    CHECK(DecodedContentCache::computeKey(createContent(1001, 0)) == key);
+
+    // A change to a single byte, including one of the last bytes that are
+    // hashed separately, gives a different key.
+    for (size_t i : {size_t(0), size_t(500), size_t(1000)}) {
+      std::vector<std::byte> changed = content;
+      changed[i] ^= std::byte(1);
+      CHECK(!(DecodedContentCache::computeKey(changed) == key));
+    }
+
+    std::vector<std::byte> longer = content;
+    longer.emplace_back(std::byte(0));
+    CHECK(!(DecodedContentCache::computeKey(longer) == key));
+
+    CHECK(
+        DecodedContentCache::computeKey(std::vector<std::byte>()).byteLength ==
+        0);
+  }
+
+  SECTION("finds a copy of the glTFs that were added") {
+    DecodedContentCache cache;
+    const DecodedContentCache::Key key =
+        DecodedContentCache::computeKey(createContent(100, 0));
+    CHECK(!cache.find(key));
+
+    const CesiumGltf::Model model = createModel(1000);
+    cache.insert(key, model);
+    CHECK(cache.getCount() == 1);
+    CHECK(cache.getByteSize() >= 1000);
+
+    std::optional<CesiumGltf::Model> cachedModel = cache.find(key);
+    REQUIRE(cachedModel);
+    REQUIRE(cachedModel->buffers.size() == 1);
+    CHECK(cachedModel->buffers[0].cesium.data == model.buffers[0].cesium.data);
+
+    // Changing the copy does not change the cached glTF.
+    cachedModel->buffers.clear();
+    cachedModel = cache.find(key);
+    REQUIRE(cachedModel);
+    CHECK(cachedModel->buffers.size() == 1);
+
+    CHECK(!cache.find(DecodedContentCache::computeKey(createContent(100, 1))));
+  }
+
+  SECTION("evicts the least recently used glTFs when over budget") {
+    const DecodedContentCache::Key key0 =
+        DecodedContentCache::computeKey(createContent(10, 0));
+    const DecodedContentCache::Key key1 =
+        DecodedContentCache::computeKey(createContent(10, 1));
+    const DecodedContentCache::Key key2 =
+        DecodedContentCache::computeKey(createContent(10, 2));
+
+    DecodedContentCache measure;
+    measure.insert(key0, createModel(1000));
+    DecodedContentCache cache(2 * measure.getByteSize());
+
+    cache.insert(key0, createModel(1000));
+    cache.insert(key1, createModel(1000));
+    CHECK(cache.getCount() == 2);
+
+    // Use the first glTF, so that the second is the least recently used.
+    CHECK(cache.find(key0));
+
+    cache.insert(key2, createModel(1000));
+    CHECK(cache.getCount() == 2);
+    CHECK(cache.getByteSize() == 2 * measure.getByteSize());
+    CHECK(cache.find(key0));
+    CHECK(!cache.find(key1));
+    CHECK(cache.find(key2));
+  }
+
+  SECTION("does not add a glTF that is larger than the budget") {
+    DecodedContentCache cache(100);
+    cache.insert(
+        DecodedContentCache::computeKey(createContent(10, 0)),
+        createModel(1000));
+    CHECK(cache.getCount() == 0);
+    CHECK(cache.getByteSize() == 0);
+  }
+
+  SECTION("removes all glTFs when cleared") {
+    DecodedContentCache cache;
+    const DecodedContentCache::Key key =
+        DecodedContentCache::computeKey(createContent(10, 0));
+    cache.insert(key, createModel(1000));
+    cache.insert(
+        DecodedContentCache::computeKey(createContent(10, 1)),
+        createModel(1000));
+    const int64_t byteSize = cache.getByteSize();
+
+    CHECK(cache.clear() == byteSize);
+    CHECK(cache.getCount() == 0);
+    CHECK(cache.getByteSize() == 0);
+    CHECK(!cache.find(key));
+
+    cache.insert(key, createModel(10));
+    CHECK(cache.find(key));
+  }
+
+  SECTION("replaces a glTF with the same key") {
+    DecodedContentCache cache;
+    const DecodedContentCache::Key key =
+        DecodedContentCache::computeKey(createContent(10, 0));
+    cache.insert(key, createModel(1000));
+    cache.insert(key, createModel(10));
+    CHECK(cache.getCount() == 1);
+
+    std::optional<CesiumGltf::Model> cachedModel = cache.find(key);
+    REQUIRE(cachedModel);
+    CHECK(cachedModel->buffers[0].cesium.data.size() == 10);
+  }
+}
@@ -14,6 +14,7 @@
 
 #include <catch2/catch.hpp>
 
+#include <atomic>
 #include <filesystem>
 
 using namespace Cesium3DTilesContent;
@@ -152,6 +153,56 @@ TEST_CASE("Test implicit quadtree loader") {
     CHECK(tileLoadResult.state == TileLoadResultState::Success);
   }
 
+  SECTION("Canceled load is not decoded") {
+    // add subtree with all available tiles
+    loader.addSubtreeAvailability(
+        QuadtreeTileID{0, 0, 0},
+        SubtreeAvailability{
+            ImplicitTileSubdivisionScheme::Quadtree,
+            5,
+            SubtreeAvailability::SubtreeConstantAvailability{true},
+            SubtreeAvailability::SubtreeConstantAvailability{false},
+            {SubtreeAvailability::SubtreeConstantAvailability{true}},
+            {}});
+
+    // mock tile content b3dm
+    auto pMockCompletedResponse = std::make_unique<SimpleAssetResponse>(
+        static_cast<uint16_t>(200),
+        "doesn't matter",
+        CesiumAsync::HttpHeaders{},
+        readFile(testDataPath / "BatchTables" / "batchedWithJson.b3dm"));
+
+    auto pMockCompletedRequest = std::make_shared<SimpleAssetRequest>(
+        "GET",
+        "doesn't matter",
+        CesiumAsync::HttpHeaders{},
+        std::move(pMockCompletedResponse));
+
+    pMockedAssetAccessor->mockCompletedRequests.insert(
+        {"content/2.1.1.b3dm", std::move(pMockCompletedRequest)});
+
+    Tile tile(&loader);
+    tile.setTileID(QuadtreeTileID{2, 1, 1});
+
+    TileLoadInput loadInput{
+        tile,
+        {},
+        asyncSystem,
+        pMockedAssetAccessor,
+        spdlog::default_logger(),
+        {},
+        std::make_shared<std::atomic<bool>>(true)};
+
+    auto tileLoadResultFuture = loader.loadTileContent(loadInput);
+
+    asyncSystem.dispatchMainThreadTasks();
+
+    auto tileLoadResult = tileLoadResultFuture.wait();
+    CHECK(std::holds_alternative<TileUnknownContent>(
+        tileLoadResult.contentKind));
+    CHECK(tileLoadResult.state == TileLoadResultState::RetryLater);
+  }
+
   SECTION("load unknown content") {
     // add subtree with all available tiles
     loader.addSubtreeAvailability(
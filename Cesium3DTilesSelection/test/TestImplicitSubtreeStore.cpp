@@ -0,0 +1,168 @@
+#include "ImplicitSubtreeStore.h"
+
+#include <Cesium3DTiles/Subtree.h>
+#include <Cesium3DTilesContent/SubtreeAvailability.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace Cesium3DTilesContent;
+using namespace Cesium3DTilesSelection;
+
+namespace {
+SubtreeAvailability createSubtree(size_t byteLength) {
+  Cesium3DTiles::Subtree subtree;
+  subtree.buffers.emplace_back().cesium.data.resize(byteLength);
+  return SubtreeAvailability(
+      ImplicitTileSubdivisionScheme::Quadtree,
+      5,
+      SubtreeAvailability::SubtreeConstantAvailability{true},
+      SubtreeAvailability::SubtreeConstantAvailability{false},
+      {SubtreeAvailability::SubtreeConstantAvailability{false}},
+      std::move(subtree));
+}
+} // namespace
+
+TEST_CASE("ImplicitSubtreeStore") {
+  ImplicitSubtreeStore store;
+
+  SECTION("finds the subtrees that were added") {
+    for (uint32_t level = 0; level < 20; level += 5) {
+      for (uint64_t mortonIndex = 0; mortonIndex < 100; ++mortonIndex) {
+        store.insert(level, mortonIndex, createSubtree(10));
+      }
+    }
+
+    CHECK(store.getLoadedCount() == 400);
+    for (uint32_t level = 0; level < 20; level += 5) {
+      for (uint64_t mortonIndex = 0; mortonIndex < 100; ++mortonIndex) {
+        CHECK(store.find(level, mortonIndex) != nullptr);
+      }
+    }
+
+    CHECK(store.find(1, 0) == nullptr);
+    CHECK(store.find(0, 100) == nullptr);
+  }
+
+  SECTION("loads each subtree once") {
+    CHECK(store.startLoading(0, 0));
+    CHECK(!store.startLoading(0, 0));
+    CHECK(store.find(0, 0) == nullptr);
+
+    store.cancelLoading(0, 0);
+    CHECK(store.startLoading(0, 0));
+
+    store.insert(0, 0, createSubtree(10));
+    CHECK(store.find(0, 0) != nullptr);
+    CHECK(!store.startLoading(0, 0));
+
+    // A loaded subtree is not affected by canceling.
+    store.cancelLoading(0, 0);
+    CHECK(store.find(0, 0) != nullptr);
+  }
+
+  SECTION("evicts the least recently used subtrees when over budget") {
+    store.insert(5, 0, createSubtree(1000));
+    const int64_t subtreeBytes = store.getByteSize();
+    store.setMaximumBytes(2 * subtreeBytes);
+
+    store.insert(5, 1, createSubtree(1000));
+    CHECK(store.getLoadedCount() == 2);
+
+    // Use the first subtree, so that the second is the least recently used.
+    CHECK(store.find(5, 0) != nullptr);
+
+    store.insert(5, 2, createSubtree(1000));
+    CHECK(store.getLoadedCount() == 2);
+    CHECK(store.getByteSize() == 2 * subtreeBytes);
+    CHECK(store.find(5, 0) != nullptr);
+    CHECK(store.find(5, 1) == nullptr);
+    CHECK(store.find(5, 2) != nullptr);
+  }
+
+  SECTION("keeps the subtrees of tiles with loaded content") {
+    store.insert(5, 0, createSubtree(1000));
+    store.setMaximumBytes(store.getByteSize());
+    store.addReference(5, 0);
+    store.addReference(5, 0);
+
+    store.insert(5, 1, createSubtree(1000));
+    CHECK(store.find(5, 0) != nullptr);
+    CHECK(store.find(5, 1) != nullptr);
+
+    // The subtree is kept until its last reference is released.
+    store.removeReference(5, 0);
+    store.insert(5, 2, createSubtree(1000));
+    CHECK(store.find(5, 0) != nullptr);
+    CHECK(store.find(5, 2) != nullptr);
+
+    store.removeReference(5, 0);
+    store.insert(5, 3, createSubtree(1000));
+    CHECK(store.getLoadedCount() == 1);
+    CHECK(store.find(5, 3) != nullptr);
+  }
+
+  SECTION("evicts all unreferenced subtrees on request") {
+    store.insert(5, 0, createSubtree(1000));
+    const int64_t subtreeBytes = store.getByteSize();
+    store.insert(5, 1, createSubtree(1000));
+    store.insert(5, 2, createSubtree(1000));
+    store.addReference(5, 1);
+    const int64_t maximumBytes = store.getMaximumBytes();
+
+    CHECK(store.evictUnreferenced() == 2 * subtreeBytes);
+    CHECK(store.getLoadedCount() == 1);
+    CHECK(store.find(5, 1) != nullptr);
+    CHECK(store.getMaximumBytes() == maximumBytes);
+    CHECK(store.evictUnreferenced() == 0);
+
+    store.removeReference(5, 1);
+    CHECK(store.evictUnreferenced() == subtreeBytes);
+    CHECK(store.getLoadedCount() == 0);
+  }
+
+  SECTION("evicts several subtrees at once in least recently used order") {
+    for (uint64_t mortonIndex = 0; mortonIndex < 10; ++mortonIndex) {
+      store.insert(5, mortonIndex, createSubtree(1000));
+    }
+    const int64_t subtreeBytes = store.getByteSize() / 10;
+
+    // Use the even subtrees, from the last to the first, so that the odd
+    // subtrees are the least recently used, and then the even ones from the
+    // last.
+    for (uint64_t mortonIndex = 10; mortonIndex > 0; mortonIndex -= 2) {
+      CHECK(store.find(5, mortonIndex - 2) != nullptr);
+    }
+
+    // Adding another subtree must evict seven of the others.
+    store.setMaximumBytes(4 * subtreeBytes);
+    store.insert(5, 10, createSubtree(1000));
+    CHECK(store.getLoadedCount() == 4);
+    CHECK(store.getByteSize() == 4 * subtreeBytes);
+    CHECK(store.find(5, 10) != nullptr);
+    CHECK(store.find(5, 0) != nullptr);
+    CHECK(store.find(5, 2) != nullptr);
+    CHECK(store.find(5, 4) != nullptr);
+    for (uint64_t mortonIndex = 1; mortonIndex < 10; mortonIndex += 2) {
+      CHECK(store.find(5, mortonIndex) == nullptr);
+    }
+    CHECK(store.find(5, 6) == nullptr);
+    CHECK(store.find(5, 8) == nullptr);
+  }
+
+  SECTION("finds the remaining subtrees after evicting many") {
+    store.insert(0, 0, createSubtree(100));
+    store.setMaximumBytes(50 * store.getByteSize());
+
+    for (uint64_t mortonIndex = 1; mortonIndex < 500; ++mortonIndex) {
+      store.insert(0, mortonIndex, createSubtree(100));
+    }
+
+    CHECK(store.getLoadedCount() == 50);
+    for (uint64_t mortonIndex = 450; mortonIndex < 500; ++mortonIndex) {
+      CHECK(store.find(0, mortonIndex) != nullptr);
+    }
+  }
+}
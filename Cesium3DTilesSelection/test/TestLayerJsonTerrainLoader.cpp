@@ -239,7 +239,7 @@ TEST_CASE("Test create layer json terrain loader") {
     CHECK(
         layers[0].tileTemplateUrls.front() ==
         "{z}/{x}/{y}.terrain?v={version}&extensions=octvertexnormals-metadata");
-    CHECK(layers[0].loadedSubtrees.size() == 2);
+    CHECK(layers[0].loadedSubtrees.getLevelCount() == 2);
     CHECK(layers[0].availabilityLevels == 10);
   }
 
@@ -652,13 +652,9 @@ TEST_CASE("Test load layer json tile content") {
 
       // make sure that layers has all the availabilities it needs
       const auto& loaderLayers = loader.getLayers();
-      CHECK(
-          loaderLayers[0].loadedSubtrees[0].find(0) !=
-          loaderLayers[0].loadedSubtrees[0].end());
+      CHECK(loaderLayers[0].loadedSubtrees.contains(0, 0));
 
-      CHECK(
-          loaderLayers[1].loadedSubtrees[0].find(0) !=
-          loaderLayers[1].loadedSubtrees[0].end());
+      CHECK(loaderLayers[1].loadedSubtrees.contains(0, 0));
     }
 
     // remove the second layer request to make sure that
@@ -716,7 +712,7 @@ TEST_CASE("Test creating tile children for layer json") {
       std::move(layer0ContentAvailability),
       maxZoom,
       10);
-  layers.back().loadedSubtrees[0].insert(0);
+  layers.back().loadedSubtrees.insert(0, 0);
 
   CesiumGeometry::QuadtreeRectangleAvailability layer1ContentAvailability{
       tilingScheme,
@@ -731,7 +727,7 @@ TEST_CASE("Test creating tile children for layer json") {
       std::move(layer1ContentAvailability),
       maxZoom,
       10);
-  layers.back().loadedSubtrees[0].insert(0);
+  layers.back().loadedSubtrees.insert(0, 0);
 
   LayerJsonTerrainLoader loader{tilingScheme, projection, std::move(layers)};
 
@@ -0,0 +1,194 @@
+#include <Cesium3DTilesSelection/ProcessedContentCache.h>
+#include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumGltf/Model.h>
+
+#include <catch2/catch.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+
+namespace {
+// Keeps the entries in a map, as a database would.
+class MapCacheDatabase : public ICacheDatabase {
+public:
+  std::optional<CacheItem> getEntry(const std::string& key) const override {
+    auto it = this->entries.find(key);
+    if (it == this->entries.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    this->entries.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(
+                HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  bool prune() override { return true; }
+
+  bool clearAll() override {
+    this->entries.clear();
+    return true;
+  }
+
+  std::map<std::string, CacheItem> entries;
+};
+
+TileLoadResult createResult() {
+  CesiumGltf::Model model;
+  model.asset.version = "2.0";
+  model.extras["gltfUpAxis"] = 2;
+  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data = {std::byte(1), std::byte(2), std::byte(3)};
+  buffer.byteLength = 3;
+
+  CesiumGltf::ImageCesium& image = model.images.emplace_back().cesium;
+  image.width = 2;
+  image.height = 1;
+  image.channels = 2;
+  image.mipPositions = {{0, 4}};
+  image.pixelData = {std::byte(9), std::byte(8), std::byte(7), std::byte(6)};
+
+  return TileLoadResult{
+      std::move(model),
+      CesiumGeometry::Axis::Z,
+      std::nullopt,
+      CesiumGeometry::BoundingSphere(glm::dvec3(1.0, 2.0, 3.0), 4.0),
+      std::nullopt,
+      nullptr,
+      {},
+      TileLoadResultState::Success};
+}
+} // namespace
+
+TEST_CASE("ProcessedContentCache") {
+  SECTION("reads back the content it writes") {
+    const std::optional<std::vector<std::byte>> bytes =
+        ProcessedContentCache::serialize(createResult());
+    REQUIRE(bytes);
+
+    std::optional<TileLoadResult> result =
+        ProcessedContentCache::deserialize(*bytes);
+    REQUIRE(result);
+    CHECK(result->state == TileLoadResultState::Success);
+    CHECK(result->glTFUpAxis == CesiumGeometry::Axis::Z);
+    CHECK(!result->updatedBoundingVolume);
+    REQUIRE(result->updatedContentBoundingVolume);
+    const auto* pSphere = std::get_if<CesiumGeometry::BoundingSphere>(
+        &*result->updatedContentBoundingVolume);
+    REQUIRE(pSphere);
+    CHECK(pSphere->getCenter() == glm::dvec3(1.0, 2.0, 3.0));
+    CHECK(pSphere->getRadius() == 4.0);
+
+    const CesiumGltf::Model& model =
+        std::get<CesiumGltf::Model>(result->contentKind);
+    CHECK(model.extras.at("gltfUpAxis").getSafeNumberOrDefault(0) == 2);
+    REQUIRE(model.buffers.size() == 1);
+    CHECK(
+        model.buffers[0].cesium.data ==
+        std::vector<std::byte>{std::byte(1), std::byte(2), std::byte(3)});
+    REQUIRE(model.images.size() == 1);
+    const CesiumGltf::ImageCesium& image = model.images[0].cesium;
+    CHECK(image.width == 2);
+    CHECK(image.height == 1);
+    CHECK(image.channels == 2);
+    REQUIRE(image.mipPositions.size() == 1);
+    CHECK(image.mipPositions[0].byteSize == 4);
+    CHECK(image.pixelData.size() == 4);
+  }
+
+  SECTION("does not read truncated content") {
+    std::optional<std::vector<std::byte>> bytes =
+        ProcessedContentCache::serialize(createResult());
+    REQUIRE(bytes);
+    bytes->resize(bytes->size() - 1);
+    CHECK(!ProcessedContentCache::deserialize(*bytes));
+  }
+
+  SECTION("keys content by its URL and options") {
+    TilesetContentOptions options;
+    const glm::dmat4 transform(1.0);
+    const std::optional<std::string> key =
+        ProcessedContentCache::computeKey("a.glb", options, transform);
+    REQUIRE(key);
+    CHECK(ProcessedContentCache::computeKey("a.glb", options, transform) ==
+          key);
+    CHECK(ProcessedContentCache::computeKey("b.glb", options, transform) !=
+          key);
+    CHECK(
+        ProcessedContentCache::computeKey("a.glb", options, glm::dmat4(2.0)) !=
+        key);
+
+    options.quantizeMeshes = true;
+    CHECK(ProcessedContentCache::computeKey("a.glb", options, transform) !=
+          key);
+
+    // Quantized positions can't be indexed.
+    options.buildGeometryIndex = true;
+    CHECK(!ProcessedContentCache::computeKey("a.glb", options, transform));
+  }
+
+  SECTION("stores content in the database") {
+    auto pDatabase = std::make_shared<MapCacheDatabase>();
+    const ProcessedContentCache cache(pDatabase);
+    CHECK(!cache.find("key"));
+
+    REQUIRE(cache.insert("key", "a.glb", createResult()));
+    CHECK(pDatabase->entries.size() == 1);
+    std::optional<TileLoadResult> result = cache.find("key");
+    REQUIRE(result);
+
+    // The buffers and images refer to the bytes of the entry.
+    const CesiumGltf::Model& model =
+        std::get<CesiumGltf::Model>(result->contentKind);
+    REQUIRE(model.buffers.size() == 1);
+    CHECK(model.buffers[0].cesium.data.empty());
+    CHECK(model.buffers[0].cesium.getData().size() == 3);
+    REQUIRE(model.images.size() == 1);
+    CHECK(model.images[0].cesium.pixelData.empty());
+    CHECK(model.images[0].cesium.getPixelData().size() == 4);
+
+    // Content processed for raster overlays isn't stored.
+    TileLoadResult withOverlays = createResult();
+    withOverlays.rasterOverlayDetails.emplace();
+    CHECK(!cache.insert("other", "b.glb", withOverlays));
+  }
+
+  SECTION("does not find expired content") {
+    auto pDatabase = std::make_shared<MapCacheDatabase>();
+    const ProcessedContentCache cache(pDatabase, -1);
+    REQUIRE(cache.insert("key", "a.glb", createResult()));
+    CHECK(!cache.find("key"));
+  }
+}
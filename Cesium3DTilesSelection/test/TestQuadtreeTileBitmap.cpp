@@ -0,0 +1,61 @@
+#include "QuadtreeTileBitmap.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+
+using namespace Cesium3DTilesSelection;
+
+TEST_CASE("QuadtreeTileBitmap") {
+  QuadtreeTileBitmap bitmap(3);
+  CHECK(bitmap.getLevelCount() == 3);
+  CHECK(!bitmap.empty());
+
+  SECTION("finds the tiles that were added") {
+    bitmap.insert(0, 0);
+    bitmap.insert(1, 5);
+    bitmap.insert(1, 4095);
+
+    CHECK(bitmap.contains(0, 0));
+    CHECK(bitmap.contains(1, 5));
+    CHECK(bitmap.contains(1, 4095));
+
+    CHECK(!bitmap.contains(0, 1));
+    CHECK(!bitmap.contains(1, 0));
+    CHECK(!bitmap.contains(1, 4094));
+    CHECK(!bitmap.contains(2, 0));
+  }
+
+  SECTION("finds deep tiles that were added sparsely") {
+    const uint64_t deepMortonIndex = uint64_t(1) << 40;
+    for (uint64_t i = 0; i < 1000; ++i) {
+      bitmap.insert(2, deepMortonIndex + i * 100);
+    }
+    bitmap.insert(2, 4096);
+
+    for (uint64_t i = 0; i < 1000; ++i) {
+      CHECK(bitmap.contains(2, deepMortonIndex + i * 100));
+      CHECK(!bitmap.contains(2, deepMortonIndex + i * 100 + 1));
+    }
+    CHECK(bitmap.contains(2, 4096));
+    CHECK(!bitmap.contains(2, 4097));
+    CHECK(!bitmap.contains(1, deepMortonIndex));
+  }
+
+  SECTION("grows only for the blocks of sparse tiles") {
+    const int64_t initialByteSize = bitmap.computeByteSize();
+    const uint64_t deepMortonIndex = uint64_t(1) << 40;
+    bitmap.insert(2, deepMortonIndex);
+    const int64_t oneBlockByteSize = bitmap.computeByteSize();
+    CHECK(oneBlockByteSize > initialByteSize);
+
+    bitmap.insert(2, deepMortonIndex + 1);
+    CHECK(bitmap.computeByteSize() == oneBlockByteSize);
+  }
+
+  SECTION("an empty bitmap has no levels") {
+    QuadtreeTileBitmap emptyBitmap;
+    CHECK(emptyBitmap.empty());
+    CHECK(emptyBitmap.getLevelCount() == 0);
+  }
+}
@@ -0,0 +1,123 @@
+#include "SimplePrepareRendererResource.h"
+
+#include <Cesium3DTilesSelection/RasterOverlayCollection.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/TilesetExternals.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumRasterOverlays/DebugColorizeTilesRasterOverlay.h>
+#include <CesiumUtility/CreditSystem.h>
+#include <CesiumUtility/IntrusivePointer.h>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumNativeTests;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace {
+class CountingRasterOverlay : public DebugColorizeTilesRasterOverlay {
+public:
+  CountingRasterOverlay() : DebugColorizeTilesRasterOverlay("Counting") {}
+
+  virtual CesiumAsync::Future<CreateTileProviderResult> createTileProvider(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+      const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      CesiumUtility::IntrusivePointer<const RasterOverlay> pOwner)
+      const override {
+    ++this->createdTileProviders;
+    return DebugColorizeTilesRasterOverlay::createTileProvider(
+        asyncSystem,
+        pAssetAccessor,
+        pCreditSystem,
+        pPrepareRendererResources,
+        pLogger,
+        pOwner);
+  }
+
+  mutable int32_t createdTileProviders = 0;
+};
+} // namespace
+
+TEST_CASE("RasterOverlayCollection shares tile providers") {
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>{});
+  auto pPrepareRendererResources =
+      std::make_shared<SimplePrepareRendererResource>();
+  AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+  auto pCreditSystem = std::make_shared<CreditSystem>();
+
+  TilesetExternals externals{
+      pAssetAccessor,
+      pPrepareRendererResources,
+      asyncSystem,
+      pCreditSystem};
+
+  IntrusivePointer<CountingRasterOverlay> pOverlay =
+      new CountingRasterOverlay();
+  const int32_t referenceCount = pOverlay->getReferenceCount();
+
+  Tile::LoadedLinkedList firstTiles;
+  Tile::LoadedLinkedList secondTiles;
+
+  SECTION("between collections with the same externals") {
+    {
+      RasterOverlayCollection first{firstTiles, externals};
+      RasterOverlayCollection second{secondTiles, externals};
+      first.add(pOverlay);
+      second.add(pOverlay);
+      asyncSystem.dispatchMainThreadTasks();
+
+      CHECK(pOverlay->createdTileProviders == 1);
+      const RasterOverlayTileProvider* pProvider =
+          first.findTileProviderForOverlay(*pOverlay);
+      REQUIRE(pProvider);
+      CHECK(!pProvider->isPlaceholder());
+      CHECK(second.findTileProviderForOverlay(*pOverlay) == pProvider);
+
+      // The remaining collection keeps using the provider.
+      first.remove(pOverlay);
+      CHECK(first.findTileProviderForOverlay(*pOverlay) == nullptr);
+      CHECK(second.findTileProviderForOverlay(*pOverlay) == pProvider);
+
+      // Adding the overlay again reuses the provider.
+      first.add(pOverlay);
+      asyncSystem.dispatchMainThreadTasks();
+      CHECK(pOverlay->createdTileProviders == 1);
+      CHECK(first.findTileProviderForOverlay(*pOverlay) == pProvider);
+    }
+
+    // Destroying the collections releases the provider, and with it the
+    // provider's reference to the overlay.
+    CHECK(pOverlay->getReferenceCount() == referenceCount);
+  }
+
+  SECTION("but not between collections with different externals") {
+    TilesetExternals otherExternals = externals;
+    otherExternals.pCreditSystem = std::make_shared<CreditSystem>();
+
+    {
+      RasterOverlayCollection first{firstTiles, externals};
+      RasterOverlayCollection second{secondTiles, otherExternals};
+      first.add(pOverlay);
+      second.add(pOverlay);
+      asyncSystem.dispatchMainThreadTasks();
+
+      CHECK(pOverlay->createdTileProviders == 2);
+      const RasterOverlayTileProvider* pProvider =
+          first.findTileProviderForOverlay(*pOverlay);
+      REQUIRE(pProvider);
+      CHECK(second.findTileProviderForOverlay(*pOverlay) != pProvider);
+    }
+
+    CHECK(pOverlay->getReferenceCount() == referenceCount);
+  }
+}
@@ -0,0 +1,118 @@
+#include <Cesium3DTilesSelection/SoftwareTileOcclusionProxyPool.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+
+#include <catch2/catch.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+namespace {
+OrientedBoundingBox createBoxAtHeight(double height) {
+  const glm::dvec3 center = Ellipsoid::WGS84.cartographicToCartesian(
+      Cartographic(0.0, 0.0, height));
+  return OrientedBoundingBox(center, glm::dmat3(50.0));
+}
+} // namespace
+
+TEST_CASE("SoftwareTileOcclusionProxyPool") {
+  // A camera 1000 meters above the ellipsoid, looking straight down.
+  const glm::dvec3 position =
+      Ellipsoid::WGS84.cartographicToCartesian(Cartographic(0.0, 0.0, 1000.0));
+  const glm::dvec3 normal = Ellipsoid::WGS84.geodeticSurfaceNormal(position);
+  std::vector<ViewState> frustums{ViewState::create(
+      position,
+      -normal,
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(800.0, 600.0),
+      glm::radians(60.0),
+      glm::radians(45.0))};
+
+  Tile occluder(nullptr);
+  occluder.setBoundingVolume(
+      BoundingRegion(GlobeRectangle(-0.01, -0.01, 0.01, 0.01), 0.0, 10.0));
+  std::vector<const Tile*> occluders{&occluder};
+
+  SoftwareTileOcclusionProxyPool pool(10);
+
+  SECTION("nothing is occluded without occluders") {
+    CHECK(
+        pool.computeOcclusionState(createBoxAtHeight(-500.0)) ==
+        TileOcclusionState::NotOccluded);
+  }
+
+  SECTION("tiles below the occluders are occluded") {
+    pool.updateOccluders(frustums, occluders);
+    CHECK(
+        pool.computeOcclusionState(createBoxAtHeight(-500.0)) ==
+        TileOcclusionState::Occluded);
+    CHECK(
+        pool.computeOcclusionState(createBoxAtHeight(500.0)) ==
+        TileOcclusionState::NotOccluded);
+  }
+
+  SECTION("occluders above the camera are ignored") {
+    occluder.setBoundingVolume(BoundingRegion(
+        GlobeRectangle(-0.01, -0.01, 0.01, 0.01),
+        2000.0,
+        2010.0));
+    pool.updateOccluders(frustums, occluders);
+    CHECK(
+        pool.computeOcclusionState(createBoxAtHeight(-500.0)) ==
+        TileOcclusionState::NotOccluded);
+  }
+
+  SECTION("proxies report the occlusion of their tile") {
+    pool.updateOccluders(frustums, occluders);
+
+    Tile hidden(nullptr);
+    hidden.setBoundingVolume(createBoxAtHeight(-500.0));
+    Tile visible(nullptr);
+    visible.setBoundingVolume(createBoxAtHeight(500.0));
+
+    const TileOcclusionRendererProxy* pHidden =
+        pool.fetchOcclusionProxyForTile(hidden, 0);
+    const TileOcclusionRendererProxy* pVisible =
+        pool.fetchOcclusionProxyForTile(visible, 0);
+    REQUIRE(pHidden);
+    REQUIRE(pVisible);
+    CHECK(pHidden->getOcclusionState() == TileOcclusionState::Occluded);
+    CHECK(pVisible->getOcclusionState() == TileOcclusionState::NotOccluded);
+  }
+
+  SECTION("proxies of unused tiles are recycled") {
+    SoftwareTileOcclusionProxyPool smallPool(2);
+    Tile first(nullptr);
+    Tile second(nullptr);
+    Tile third(nullptr);
+
+    const TileOcclusionRendererProxy* pFirst =
+        smallPool.fetchOcclusionProxyForTile(first, 0);
+    const TileOcclusionRendererProxy* pSecond =
+        smallPool.fetchOcclusionProxyForTile(second, 0);
+    REQUIRE(pFirst);
+    REQUIRE(pSecond);
+    CHECK(pFirst != pSecond);
+    CHECK(smallPool.fetchOcclusionProxyForTile(first, 0) == pFirst);
+    CHECK(!smallPool.fetchOcclusionProxyForTile(third, 0));
+
+    // Both tiles were used before the first prune.
+    smallPool.pruneOcclusionProxyMappings();
+    CHECK(smallPool.fetchOcclusionProxyForTile(first, 1) == pFirst);
+    CHECK(!smallPool.fetchOcclusionProxyForTile(third, 1));
+
+    // Only the second tile was unused since then.
+    smallPool.pruneOcclusionProxyMappings();
+    CHECK(smallPool.fetchOcclusionProxyForTile(third, 2) == pSecond);
+    CHECK(smallPool.fetchOcclusionProxyForTile(first, 2) == pFirst);
+    CHECK(!smallPool.fetchOcclusionProxyForTile(second, 2));
+  }
+}
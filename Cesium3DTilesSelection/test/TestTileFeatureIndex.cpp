@@ -0,0 +1,122 @@
+#include <Cesium3DTilesSelection/TileFeatureIndex.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/Model.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGltf;
+
+namespace {
+template <typename T>
+int32_t addBufferToModel(Model& model, const std::vector<T>& values) {
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(values.size() * sizeof(T));
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+  std::memcpy(
+      buffer.cesium.data.data(),
+      values.data(),
+      buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  bufferView.byteOffset = 0;
+  bufferView.byteLength = buffer.byteLength;
+  return static_cast<int32_t>(model.bufferViews.size() - 1);
+}
+
+void addPropertyTable(
+    Model& model,
+    ExtensionModelExtStructuralMetadata& metadata,
+    const std::string& names,
+    const std::vector<uint32_t>& nameOffsets,
+    const std::vector<int32_t>& levels) {
+  PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+  propertyTable.classProperty = "Building";
+  propertyTable.count = static_cast<int64_t>(levels.size());
+
+  PropertyTableProperty& name = propertyTable.properties["name"];
+  name.values =
+      addBufferToModel(model, std::vector<char>(names.begin(), names.end()));
+  name.stringOffsets = addBufferToModel(model, nameOffsets);
+
+  propertyTable.properties["levels"].values = addBufferToModel(model, levels);
+  propertyTable.properties["height"].values =
+      addBufferToModel(model, std::vector<uint8_t>(levels.size(), 255));
+}
+
+Model createModel() {
+  Model model;
+  ExtensionModelExtStructuralMetadata& metadata =
+      model.addExtension<ExtensionModelExtStructuralMetadata>();
+  Class& buildingClass = metadata.schema.emplace().classes["Building"];
+
+  ClassProperty& name = buildingClass.properties["name"];
+  name.type = ClassProperty::Type::STRING;
+
+  ClassProperty& levels = buildingClass.properties["levels"];
+  levels.type = ClassProperty::Type::SCALAR;
+  levels.componentType = ClassProperty::ComponentType::INT32;
+  levels.noData = -1;
+
+  ClassProperty& height = buildingClass.properties["height"];
+  height.type = ClassProperty::Type::SCALAR;
+  height.componentType = ClassProperty::ComponentType::UINT8;
+  height.normalized = true;
+
+  addPropertyTable(model, metadata, "abcab", {0, 1, 3, 5}, {2, -1, 2});
+  addPropertyTable(model, metadata, "ab", {0, 2}, {7});
+  return model;
+}
+} // namespace
+
+TEST_CASE("TileFeatureIndex") {
+  const Model model = createModel();
+
+  SECTION("looks up string properties") {
+    const TileFeatureIndex index(model, {"name"});
+    CHECK(index.isIndexed("name"));
+
+    const gsl::span<const TileFeature> features =
+        index.find("name", std::string("ab"));
+    REQUIRE(features.size() == 2);
+    CHECK(features[0] == TileFeature{0, 2});
+    CHECK(features[1] == TileFeature{1, 0});
+
+    CHECK(index.find("name", std::string("a")).size() == 1);
+    CHECK(index.find("name", std::string("x")).empty());
+    CHECK(index.find("name", int64_t(2)).empty());
+  }
+
+  SECTION("looks up integer properties and skips no data values") {
+    const TileFeatureIndex index(model, {"levels"});
+
+    const gsl::span<const TileFeature> features =
+        index.find("levels", int64_t(2));
+    REQUIRE(features.size() == 2);
+    CHECK(features[0] == TileFeature{0, 0});
+    CHECK(features[1] == TileFeature{0, 2});
+
+    CHECK(index.find("levels", int64_t(7)).size() == 1);
+    CHECK(index.find("levels", int64_t(-1)).empty());
+  }
+
+  SECTION("does not index other properties") {
+    const TileFeatureIndex index(model, {"height", "nonexistent"});
+    CHECK(!index.isIndexed("height"));
+    CHECK(!index.isIndexed("nonexistent"));
+    CHECK(!index.isIndexed("name"));
+    CHECK(index.find("name", std::string("ab")).empty());
+  }
+
+  SECTION("estimates its size") {
+    const TileFeatureIndex empty;
+    const TileFeatureIndex index(model, {"name", "levels"});
+    CHECK(index.getSizeBytes() > empty.getSizeBytes());
+  }
+}
@@ -0,0 +1,130 @@
+#include <Cesium3DTilesSelection/TileGeometryIndex.h>
+#include <CesiumGeometry/Axis.h>
+#include <CesiumGeometry/Ray.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace {
+template <typename T>
+int32_t addAccessorToModel(
+    Model& model,
+    const std::vector<T>& values,
+    const std::string& type,
+    int32_t componentType,
+    int64_t count) {
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(values.size() * sizeof(T));
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+  std::memcpy(
+      buffer.cesium.data.data(),
+      values.data(),
+      buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  bufferView.byteLength = buffer.byteLength;
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = static_cast<int32_t>(model.bufferViews.size() - 1);
+  accessor.type = type;
+  accessor.componentType = componentType;
+  accessor.count = count;
+  return static_cast<int32_t>(model.accessors.size() - 1);
+}
+
+// A model with two unit squares in a node translated along X: an indexed one
+// at a height of 0, and a triangle strip at a height of 1.
+Model createModel() {
+  Model model;
+  model.extras["gltfUpAxis"] =
+      static_cast<std::underlying_type_t<Axis>>(Axis::Z);
+
+  Mesh& mesh = model.meshes.emplace_back();
+
+  MeshPrimitive& square = mesh.primitives.emplace_back();
+  square.attributes["POSITION"] = addAccessorToModel(
+      model,
+      std::vector<float>{0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0},
+      Accessor::Type::VEC3,
+      Accessor::ComponentType::FLOAT,
+      4);
+  square.indices = addAccessorToModel(
+      model,
+      std::vector<uint16_t>{0, 1, 2, 1, 3, 2},
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::UNSIGNED_SHORT,
+      6);
+
+  MeshPrimitive& strip = mesh.primitives.emplace_back();
+  strip.mode = MeshPrimitive::Mode::TRIANGLE_STRIP;
+  strip.attributes["POSITION"] = addAccessorToModel(
+      model,
+      std::vector<float>{0, 0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1},
+      Accessor::Type::VEC3,
+      Accessor::ComponentType::FLOAT,
+      4);
+
+  Node& node = model.nodes.emplace_back();
+  node.mesh = 0;
+  node.translation = {10.0, 0.0, 0.0};
+  return model;
+}
+} // namespace
+
+TEST_CASE("TileGeometryIndex") {
+  const TileGeometryIndex index(createModel());
+  const glm::dmat4 tileTransform =
+      glm::translate(glm::dmat4(1.0), glm::dvec3(0.0, 0.0, 100.0));
+
+  SECTION("finds the closest intersection") {
+    const std::optional<TileGeometryIntersection> intersection =
+        index.intersectRay(
+            Ray(glm::dvec3(10.25, 0.25, 200.0), glm::dvec3(0.0, 0.0, -1.0)),
+            tileTransform);
+    REQUIRE(intersection);
+    CHECK(Math::equalsEpsilon(intersection->distance, 99.0, Math::Epsilon12));
+    CHECK(Math::equalsEpsilon(
+        intersection->position,
+        glm::dvec3(10.25, 0.25, 101.0),
+        Math::Epsilon12));
+    CHECK(intersection->meshId == 0);
+    CHECK(intersection->primitiveId == 1);
+    CHECK(intersection->triangleIndex == 0);
+  }
+
+  SECTION("finds intersections with the back of triangles") {
+    const Ray ray(glm::dvec3(10.75, 0.75, 0.0), glm::dvec3(0.0, 0.0, 1.0));
+    const std::optional<TileGeometryIntersection> intersection =
+        index.intersectRay(ray, tileTransform);
+    REQUIRE(intersection);
+    CHECK(Math::equalsEpsilon(intersection->distance, 100.0, Math::Epsilon12));
+    CHECK(intersection->primitiveId == 0);
+    CHECK(intersection->triangleIndex == 1);
+
+    CHECK(!index.intersectRay(ray, tileTransform, true));
+  }
+
+  SECTION("misses rays that pass by the triangles") {
+    CHECK(!index.intersectRay(
+        Ray(glm::dvec3(0.5, 0.5, 200.0), glm::dvec3(0.0, 0.0, -1.0)),
+        tileTransform));
+  }
+
+  SECTION("estimates its size") {
+    const TileGeometryIndex empty;
+    CHECK(index.getSizeBytes() > empty.getSizeBytes());
+  }
+}
@@ -0,0 +1,43 @@
+#include <Cesium3DTilesSelection/TileID.h>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <unordered_set>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+
+TEST_CASE("TileID") {
+  SECTION("can be used as the key of an unordered set") {
+    std::unordered_set<TileID> ids;
+    ids.emplace(std::string("content/0.glb"));
+    ids.emplace(QuadtreeTileID(1, 0, 1));
+    ids.emplace(OctreeTileID(1, 0, 1, 1));
+    ids.emplace(UpsampledQuadtreeNode{QuadtreeTileID(1, 0, 1)});
+
+    CHECK(ids.size() == 4);
+    CHECK(ids.count(std::string("content/0.glb")) == 1);
+    CHECK(ids.count(QuadtreeTileID(1, 0, 1)) == 1);
+    CHECK(ids.count(QuadtreeTileID(1, 1, 0)) == 0);
+    CHECK(ids.count(OctreeTileID(1, 0, 1, 1)) == 1);
+    CHECK(ids.count(UpsampledQuadtreeNode{QuadtreeTileID(1, 0, 1)}) == 1);
+  }
+
+  SECTION("neighboring implicit tiles have different hashes") {
+    std::unordered_set<size_t> quadtreeHashes;
+    std::unordered_set<size_t> octreeHashes;
+    for (uint32_t x = 0; x < 16; ++x) {
+      for (uint32_t y = 0; y < 16; ++y) {
+        quadtreeHashes.emplace(std::hash<QuadtreeTileID>{}({4, x, y}));
+        quadtreeHashes.emplace(std::hash<QuadtreeTileID>{}({5, x, y}));
+        for (uint32_t z = 0; z < 16; ++z) {
+          octreeHashes.emplace(std::hash<OctreeTileID>{}({4, x, y, z}));
+        }
+      }
+    }
+
+    CHECK(quadtreeHashes.size() == 2 * 16 * 16);
+    CHECK(octreeHashes.size() == 16 * 16 * 16);
+  }
+}
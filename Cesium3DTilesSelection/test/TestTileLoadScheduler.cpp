@@ -0,0 +1,76 @@
+#include <Cesium3DTilesSelection/TileLoadScheduler.h>
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+
+TEST_CASE("TileLoadScheduler") {
+  TileLoadScheduler scheduler(4, 1000);
+  const uint64_t first = scheduler.addTileset();
+  const uint64_t second = scheduler.addTileset();
+  CHECK(first != second);
+
+  const std::vector<TileLoadPriority> near{
+      {TileLoadPriorityGroup::Normal, 1.0},
+      {TileLoadPriorityGroup::Normal, 2.0},
+      {TileLoadPriorityGroup::Normal, 3.0}};
+  const std::vector<TileLoadPriority> far{
+      {TileLoadPriorityGroup::Normal, 10.0},
+      {TileLoadPriorityGroup::Normal, 20.0},
+      {TileLoadPriorityGroup::Normal, 30.0}};
+
+  SECTION("a single tileset may use every free slot") {
+    CHECK(scheduler.requestLoadSlots(first, near, 0, 0) == 3);
+    CHECK(scheduler.requestLoadSlots(first, near, 2, 0) == 2);
+    CHECK(scheduler.requestLoadSlots(first, near, 4, 0) == 0);
+  }
+
+  SECTION("slots go to the highest priority loads of all tilesets") {
+    CHECK(scheduler.requestLoadSlots(first, far, 0, 0) == 3);
+    scheduler.notifyTilesLoading(first, 0);
+
+    // The near loads of the second tileset outrank all but one far load.
+    CHECK(scheduler.requestLoadSlots(second, near, 0, 0) == 3);
+    scheduler.notifyTilesLoading(second, 3);
+
+    CHECK(scheduler.requestLoadSlots(first, far, 0, 0) == 1);
+    CHECK(scheduler.getNumberOfTilesLoading() == 3);
+  }
+
+  SECTION("urgent loads outrank normal loads of other tilesets") {
+    const std::vector<TileLoadPriority> urgent{
+        {TileLoadPriorityGroup::Urgent, 100.0}};
+    CHECK(scheduler.requestLoadSlots(first, near, 3, 0) == 1);
+    CHECK(scheduler.requestLoadSlots(second, urgent, 0, 0) == 1);
+    CHECK(scheduler.requestLoadSlots(second, far, 0, 0) == 0);
+  }
+
+  SECTION("only urgent loads start while over the memory budget") {
+    const std::vector<TileLoadPriority> mixed{
+        {TileLoadPriorityGroup::Urgent, 5.0},
+        {TileLoadPriorityGroup::Normal, 1.0}};
+    CHECK(scheduler.requestLoadSlots(first, mixed, 0, 600) == 2);
+    CHECK(scheduler.canStartLowPriorityLoad());
+
+    CHECK(scheduler.requestLoadSlots(second, mixed, 0, 600) == 1);
+    CHECK(scheduler.getTotalDataBytes() == 1200);
+    CHECK(!scheduler.canStartLowPriorityLoad());
+  }
+
+  SECTION("tilesets that stop updating don't hold up the others") {
+    CHECK(scheduler.requestLoadSlots(second, near, 0, 0) == 3);
+    for (int i = 0; i < 4; ++i) {
+      scheduler.requestLoadSlots(first, far, 0, 0);
+    }
+    CHECK(scheduler.requestLoadSlots(first, far, 0, 0) == 3);
+  }
+
+  SECTION("removed tilesets no longer count") {
+    scheduler.requestLoadSlots(second, near, 4, 2000);
+    CHECK(scheduler.requestLoadSlots(first, near, 0, 0) == 0);
+    scheduler.removeTileset(second);
+    CHECK(scheduler.requestLoadSlots(first, near, 0, 0) == 3);
+  }
+}
@@ -0,0 +1,99 @@
+#include <Cesium3DTilesSelection/TileLoadTimeline.h>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+TileLoadTimeline::Clock::time_point
+at(TileLoadTimeline::Clock::time_point start, int milliseconds) {
+  return start + std::chrono::milliseconds(milliseconds);
+}
+} // namespace
+
+TEST_CASE("TileLoadTimeline") {
+  const TileLoadTimeline::Clock::time_point start =
+      TileLoadTimeline::Clock::now();
+
+  TileLoadTimeline loaded;
+  loaded.record(TileLoadEvent::Queued, at(start, 0));
+  loaded.record(TileLoadEvent::ContentLoading, at(start, 10));
+  loaded.record(TileLoadEvent::RequestStarted, at(start, 12));
+  loaded.record(TileLoadEvent::RequestFinished, at(start, 112));
+  loaded.record(TileLoadEvent::ContentParsed, at(start, 120));
+  loaded.record(TileLoadEvent::DecodeStarted, at(start, 130));
+  loaded.record(TileLoadEvent::PrepareInLoadThreadStarted, at(start, 150));
+  loaded.record(TileLoadEvent::PrepareInLoadThreadFinished, at(start, 160));
+  loaded.record(TileLoadEvent::ContentLoaded, at(start, 170));
+  loaded.record(TileLoadEvent::PrepareInMainThreadStarted, at(start, 200));
+  loaded.record(TileLoadEvent::Done, at(start, 205));
+
+  SECTION("phases are measured between their events") {
+    CHECK(
+        *loaded.getDuration(TileLoadPhase::WorkerThreadQueue) ==
+        Approx(0.01));
+    CHECK(*loaded.getDuration(TileLoadPhase::Request) == Approx(0.1));
+    CHECK(*loaded.getDuration(TileLoadPhase::Parse) == Approx(0.008));
+    CHECK(*loaded.getDuration(TileLoadPhase::DecodeQueue) == Approx(0.01));
+    CHECK(*loaded.getDuration(TileLoadPhase::Decode) == Approx(0.02));
+    CHECK(
+        *loaded.getDuration(TileLoadPhase::PrepareInLoadThread) ==
+        Approx(0.01));
+    CHECK(
+        *loaded.getDuration(TileLoadPhase::MainThreadQueue) == Approx(0.03));
+    CHECK(
+        *loaded.getDuration(TileLoadPhase::PrepareInMainThread) ==
+        Approx(0.005));
+    CHECK(*loaded.getDuration(TileLoadPhase::Total) == Approx(0.205));
+    CHECK(!loaded.getDuration(TileLoadPhase::ProcessedContentCacheRead));
+  }
+
+  SECTION("events recorded first keep their first time") {
+    loaded.recordFirst(TileLoadEvent::Queued, at(start, 5));
+    CHECK(loaded.getTime(TileLoadEvent::Queued) == at(start, 0));
+
+    loaded.record(TileLoadEvent::Queued, at(start, 5));
+    CHECK(loaded.getTime(TileLoadEvent::Queued) == at(start, 5));
+  }
+
+  SECTION("timelines are merged and cleared") {
+    TileLoadTimeline other;
+    other.record(TileLoadEvent::ProcessedContentCacheHit, at(start, 30));
+    other.record(TileLoadEvent::ContentParsed, at(start, 40));
+    loaded.merge(other);
+    CHECK(loaded.getTime(TileLoadEvent::Queued) == at(start, 0));
+    CHECK(loaded.getTime(TileLoadEvent::ContentParsed) == at(start, 40));
+    CHECK(
+        *loaded.getDuration(TileLoadPhase::ProcessedContentCacheRead) ==
+        Approx(0.02));
+
+    loaded.clear();
+    CHECK(!loaded.getTime(TileLoadEvent::Queued));
+    CHECK(!loaded.getDuration(TileLoadPhase::Total));
+  }
+
+  SECTION("loads are added to the histograms of their phases") {
+    TileLoadTimeline failed;
+    failed.record(TileLoadEvent::Queued, at(start, 0));
+    failed.record(TileLoadEvent::ContentLoading, at(start, 50));
+    failed.record(TileLoadEvent::Failed, at(start, 60));
+
+    TileLoadHistograms histograms;
+    histograms.add(loaded);
+    histograms.add(failed);
+    CHECK(histograms.doneCount == 1);
+    CHECK(histograms.failedCount == 1);
+
+    const CesiumAsync::LatencyHistogram& queue =
+        histograms.getHistogram(TileLoadPhase::WorkerThreadQueue);
+    CHECK(queue.sampleCount == 2);
+    CHECK(queue.totalMilliseconds == Approx(60.0));
+    CHECK(queue.maximumMilliseconds == Approx(50.0));
+    CHECK(histograms.getHistogram(TileLoadPhase::Total).sampleCount == 1);
+    CHECK(
+        histograms.getHistogram(TileLoadPhase::ProcessedContentCacheRead)
+            .sampleCount == 0);
+  }
+}
@@ -0,0 +1,143 @@
+#include "TileSelectionDataTable.h"
+
+#include <Cesium3DTilesSelection/Tile.h>
+#include <CesiumGeometry/BoundingSphere.h>
+
+#include <catch2/catch.hpp>
+#include <glm/vec3.hpp>
+
+#include <limits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+
+TEST_CASE("TileSelectionDataTable") {
+  Tile root(nullptr);
+  root.setBoundingVolume(BoundingSphere(glm::dvec3(1.0, 2.0, 3.0), 10.0));
+  root.setGeometricError(100.0);
+
+  std::vector<Tile> children;
+  children.emplace_back(nullptr);
+  children.emplace_back(nullptr);
+  children[0].setBoundingVolume(
+      BoundingSphere(glm::dvec3(-1.0, 0.0, 0.0), 5.0));
+  children[0].setGeometricError(50.0);
+  children[1].setBoundingVolume(BoundingSphere(glm::dvec3(1.0, 0.0, 0.0), 5.0));
+  children[1].setGeometricError(25.0);
+  root.createChildTiles(std::move(children));
+
+  TileSelectionDataTable table;
+  CHECK(table.find(root) == nullptr);
+
+  table.registerSubtree(root);
+  CHECK(table.size() == 3);
+
+  SECTION("registers the whole subtree") {
+    const TileSelectionData* pRoot = table.find(root);
+    REQUIRE(pRoot);
+    CHECK(pRoot->boundingVolumeCenter == glm::dvec3(1.0, 2.0, 3.0));
+    CHECK(pRoot->geometricError == 100.0);
+
+    const TileSelectionData* pChild = table.find(root.getChildren()[1]);
+    REQUIRE(pChild);
+    CHECK(pChild->boundingVolumeCenter == glm::dvec3(1.0, 0.0, 0.0));
+    CHECK(pChild->geometricError == 25.0);
+  }
+
+  SECTION("the entries of siblings are contiguous") {
+    const uint32_t rootIndex = table.indexOf(root);
+    const TileSelectionData* pRoot = table.get(rootIndex);
+    REQUIRE(pRoot);
+    CHECK(pRoot->childCount == 2);
+
+    for (size_t i = 0; i < root.getChildren().size(); ++i) {
+      const uint32_t childIndex = table.getChildIndex(rootIndex, i);
+      CHECK(childIndex == pRoot->firstChild + i);
+      CHECK(childIndex == table.indexOf(root.getChildren()[i]));
+    }
+    CHECK(
+        table.getChildIndex(rootIndex, 2) ==
+        TileSelectionDataTable::InvalidIndex);
+
+    const uint32_t childIndex = table.getChildIndex(rootIndex, 0);
+    const BoundingSphere* pSphere =
+        std::get_if<BoundingSphere>(&table.getBoundingVolume(childIndex));
+    REQUIRE(pSphere);
+    CHECK(pSphere->getCenter() == glm::dvec3(-1.0, 0.0, 0.0));
+    CHECK(table.getEnclosingSphere(childIndex).getRadius() == 5.0);
+  }
+
+  SECTION("update refreshes an entry") {
+    root.setUnconditionallyRefine();
+    table.update(root);
+
+    const TileSelectionData* pRoot = table.find(root);
+    REQUIRE(pRoot);
+    CHECK(pRoot->geometricError == std::numeric_limits<double>::infinity());
+    CHECK(pRoot->unconditionallyRefine);
+    CHECK(pRoot->childCount == 2);
+  }
+
+  SECTION("mirrors the selection state and whether the tile is renderable") {
+    Tile& child = root.getChildren()[0];
+    const uint32_t childIndex = table.indexOf(child);
+    CHECK(table.get(childIndex)->renderable == child.isRenderable());
+
+    const TileSelectionState selectionState(
+        7,
+        TileSelectionState::Result::Rendered);
+    table.setLastSelectionState(child, childIndex, selectionState);
+    CHECK(
+        child.getLastSelectionState().getResult(7) ==
+        TileSelectionState::Result::Rendered);
+    CHECK(
+        table.get(childIndex)->lastSelectionState.getResult(7) ==
+        TileSelectionState::Result::Rendered);
+
+    // The state of a tile without an entry is set all the same.
+    Tile unregistered(nullptr);
+    table.setLastSelectionState(
+        unregistered,
+        TileSelectionDataTable::InvalidIndex,
+        selectionState);
+    CHECK(
+        unregistered.getLastSelectionState().getResult(7) ==
+        TileSelectionState::Result::Rendered);
+    CHECK(table.size() == 3);
+  }
+
+  SECTION("a tile that is moved from gives up its entry") {
+    const uint32_t rootIndex = table.indexOf(root);
+    Tile moved(std::move(root));
+    CHECK(table.indexOf(moved) == rootIndex);
+    CHECK(table.find(root) == nullptr);
+  }
+
+  SECTION("clear removes all entries") {
+    table.clear();
+    CHECK(table.size() == 0);
+    CHECK(table.find(root) == nullptr);
+    CHECK(table.find(root.getChildren()[0]) == nullptr);
+  }
+
+  SECTION("registering again only adds new tiles") {
+    std::vector<Tile> grandchildren;
+    grandchildren.emplace_back(nullptr);
+    grandchildren[0].setGeometricError(12.5);
+    root.getChildren()[0].createChildTiles(std::move(grandchildren));
+
+    table.registerSubtree(root.getChildren()[0]);
+    CHECK(table.size() == 4);
+
+    const TileSelectionData* pGrandchild =
+        table.find(root.getChildren()[0].getChildren()[0]);
+    REQUIRE(pGrandchild);
+    CHECK(pGrandchild->geometricError == 12.5);
+    CHECK(
+        table.getChildIndex(table.indexOf(root.getChildren()[0]), 0) ==
+        table.indexOf(root.getChildren()[0].getChildren()[0]));
+  }
+}
@@ -8,6 +8,8 @@
 #include <CesiumGeometry/QuadtreeTileID.h>
 #include <CesiumGeospatial/Cartographic.h>
 #include <CesiumGltf/AccessorView.h>
+#include <CesiumAsync/CacheItem.h>
+#include <CesiumAsync/ICacheDatabase.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumNativeTests/SimpleAssetAccessor.h>
 #include <CesiumNativeTests/SimpleAssetRequest.h>
@@ -22,6 +24,8 @@
 #include <glm/glm.hpp>
 
 #include <filesystem>
+#include <map>
+#include <optional>
 #include <vector>
 
 using namespace Cesium3DTilesSelection;
@@ -68,6 +72,54 @@ createMockRequest(const std::filesystem::path& path) {
   return pMockCompletedRequest;
 }
 
+// Keeps the entries in a map, as a database would.
+class MapCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override {
+    auto it = this->entries.find(key);
+    if (it == this->entries.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    this->entries.insert_or_assign(
+        key,
+        CesiumAsync::CacheItem(
+            expiryTime,
+            CesiumAsync::CacheRequest(
+                CesiumAsync::HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CesiumAsync::CacheResponse(
+                statusCode,
+                CesiumAsync::HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  bool prune() override { return true; }
+
+  bool clearAll() override {
+    this->entries.clear();
+    return true;
+  }
+
+  std::map<std::string, CesiumAsync::CacheItem> entries;
+};
+
 CesiumGltf::Model createGlobeGrid(
     const Cartographic& beginPoint,
     uint32_t width,
@@ -267,6 +319,78 @@ TEST_CASE("Test the manager can be initialized with correct loaders") {
         QuadtreeTileID(0, 1, 0));
   }
 
+  SECTION("Restore manager with tileset.json url from the cache database") {
+    auto pCacheDatabase = std::make_shared<MapCacheDatabase>();
+    externals.pCacheDatabase = pCacheDatabase;
+
+    TilesetOptions options;
+    options.restoreTilesetFromCache = true;
+
+    std::shared_ptr<SimpleAssetRequest> pRequest =
+        createMockRequest(testDataPath / "Tileset" / "tileset.json");
+    auto pResponse = std::make_unique<SimpleAssetResponse>(
+        static_cast<uint16_t>(200),
+        "doesn't matter",
+        CesiumAsync::HttpHeaders{{"ETag", "\"1\""}},
+        std::vector<std::byte>(
+            pRequest->response()->data().begin(),
+            pRequest->response()->data().end()));
+    pMockedAssetAccessor->mockCompletedRequests.insert(
+        {"tileset.json",
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             "tileset.json",
+             CesiumAsync::HttpHeaders{},
+             std::move(pResponse))});
+
+    Tile::LoadedLinkedList loadedTiles;
+    IntrusivePointer<TilesetContentManager> pManager =
+        new TilesetContentManager(
+            externals,
+            options,
+            RasterOverlayCollection{loadedTiles, externals},
+            "tileset.json");
+    pManager->waitUntilIdle();
+    REQUIRE(pManager->getRootTile());
+
+    auto entryIt = pCacheDatabase->entries.find("tileset-root:tileset.json");
+    REQUIRE(entryIt != pCacheDatabase->entries.end());
+    CHECK(entryIt->second.cacheResponse.headers.at("ETag") == "\"1\"");
+
+    // The document is not modified, so a new manager can only be created
+    // from the cached document.
+    pMockedAssetAccessor->mockCompletedRequests["tileset.json"] =
+        std::make_shared<SimpleAssetRequest>(
+            "GET",
+            "tileset.json",
+            CesiumAsync::HttpHeaders{},
+            std::make_unique<SimpleAssetResponse>(
+                static_cast<uint16_t>(304),
+                "doesn't matter",
+                CesiumAsync::HttpHeaders{},
+                std::vector<std::byte>{}));
+
+    IntrusivePointer<TilesetContentManager> pRestoredManager =
+        new TilesetContentManager(
+            externals,
+            options,
+            RasterOverlayCollection{loadedTiles, externals},
+            "tileset.json");
+    pRestoredManager->waitUntilIdle();
+
+    const Tile* pTilesetJson = pRestoredManager->getRootTile();
+    REQUIRE(pTilesetJson);
+    REQUIRE(pTilesetJson->getChildren().size() == 1);
+    const Tile* pRootTile = &pTilesetJson->getChildren()[0];
+    CHECK(std::get<std::string>(pRootTile->getTileID()) == "parent.b3dm");
+    CHECK(pRootTile->getGeometricError() == 70.0);
+
+    // The revalidated document is kept.
+    entryIt = pCacheDatabase->entries.find("tileset-root:tileset.json");
+    REQUIRE(entryIt != pCacheDatabase->entries.end());
+    CHECK(!entryIt->second.cacheResponse.data.empty());
+  }
+
   SECTION("Initialize manager with wrong format") {
     pMockedAssetAccessor->mockCompletedRequests.insert(
         {"layer.json",
@@ -707,6 +831,95 @@ TEST_CASE("Test tile state machine") {
     CHECK(!upsampledTile.isRenderContent());
     CHECK(!upsampledTile.getContent().getRenderContent());
   }
+
+  SECTION("Fetch released buffer data again before upsampling a child") {
+    Cartographic beginCarto{glm::radians(32.0), glm::radians(48.0), 100.0};
+    const CesiumGltf::Model model = createGlobeGrid(beginCarto, 10, 10, 0.01);
+
+    auto pMockedLoader = std::make_unique<SimpleTilesetContentLoader>();
+    auto pMockedLoaderRaw = pMockedLoader.get();
+    pMockedLoader->mockLoadTileContent = {
+        model,
+        CesiumGeometry::Axis::Y,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        nullptr,
+        {},
+        TileLoadResultState::Success};
+    pMockedLoader->mockCreateTileChildren = {{}, TileLoadResultState::Failed};
+
+    auto pRootTile = std::make_unique<Tile>(pMockedLoaderRaw);
+    pRootTile->setTileID(QuadtreeTileID(0, 0, 0));
+    {
+      std::vector<Tile> children;
+      children.emplace_back(pMockedLoaderRaw);
+      Tile& upsampledTile = children.back();
+      upsampledTile.setTileID(UpsampledQuadtreeNode{QuadtreeTileID(1, 1, 1)});
+      pRootTile->createChildTiles(std::move(children));
+    }
+
+    TilesetOptions options{};
+    options.contentOptions.releaseBufferDataAfterPrepare = true;
+
+    Tile::LoadedLinkedList loadedTiles;
+    IntrusivePointer<TilesetContentManager> pManager =
+        new TilesetContentManager{
+            externals,
+            options,
+            RasterOverlayCollection{loadedTiles, externals},
+            {},
+            std::move(pMockedLoader),
+            std::move(pRootTile)};
+
+    Tile& tile = *pManager->getRootTile();
+    Tile& upsampledTile = tile.getChildren().back();
+
+    // The buffer data is released once the parent is done loading, but the
+    // rest of the model is kept.
+    pManager->loadTileContent(tile, options);
+    pManager->waitUntilIdle();
+    pManager->updateTileContent(tile, options);
+    REQUIRE(tile.getState() == TileLoadState::Done);
+
+    const TileRenderContent* pRenderContent =
+        tile.getContent().getRenderContent();
+    REQUIRE(pRenderContent);
+    const CesiumGltf::Model& parentModel = pRenderContent->getModel();
+    CHECK(pRenderContent->isModelDataReleased());
+    CHECK(parentModel.accessors.size() == model.accessors.size());
+    for (const CesiumGltf::Buffer& buffer : parentModel.buffers) {
+      CHECK(buffer.cesium.data.empty());
+    }
+    CHECK(pManager->getTotalDataUsed() == 0);
+
+    // Loading the upsampled child fetches the parent's content again first.
+    pMockedLoaderRaw->mockLoadTileContent = {
+        model,
+        CesiumGeometry::Axis::Y,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        nullptr,
+        {},
+        TileLoadResultState::Success};
+    pManager->loadTileContent(upsampledTile, options);
+    CHECK(upsampledTile.getState() == TileLoadState::Unloaded);
+    CHECK(pManager->getNumberOfTilesLoading() == 1);
+
+    pManager->waitUntilIdle();
+    CHECK(pManager->getNumberOfTilesLoading() == 0);
+    CHECK(!pRenderContent->isModelDataReleased());
+    for (const CesiumGltf::Buffer& buffer : parentModel.buffers) {
+      CHECK(!buffer.cesium.data.empty());
+    }
+    CHECK(pManager->getTotalDataUsed() == tile.computeByteSize());
+
+    // Now the child can be upsampled.
+    pManager->loadTileContent(upsampledTile, options);
+    CHECK(upsampledTile.getState() == TileLoadState::ContentLoading);
+    pManager->waitUntilIdle();
+  }
 }
 
 TEST_CASE("Test the tileset content manager's post processing for gltf") {
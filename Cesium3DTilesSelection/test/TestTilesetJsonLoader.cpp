@@ -3,17 +3,22 @@
 #include "TilesetJsonLoader.h"
 
 #include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <Cesium3DTilesSelection/TileID.h>
 #include <CesiumNativeTests/SimpleAssetAccessor.h>
 #include <CesiumNativeTests/SimpleAssetRequest.h>
 #include <CesiumNativeTests/SimpleAssetResponse.h>
 #include <CesiumNativeTests/SimpleTaskProcessor.h>
 #include <CesiumNativeTests/readFile.h>
 
+#include <rapidjson/document.h>
+
 #include <catch2/catch.hpp>
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 using namespace CesiumAsync;
 using namespace Cesium3DTilesSelection;
@@ -72,7 +77,8 @@ createLoader(const std::filesystem::path& tilesetPath) {
 TileLoadResult loadTileContent(
     const std::filesystem::path& tilePath,
     TilesetContentLoader& loader,
-    Tile& tile) {
+    Tile& tile,
+    const std::optional<ThreadPool>& decodeThreadPool = std::nullopt) {
   auto pMockCompletedResponse = std::make_unique<SimpleAssetResponse>(
       static_cast<uint16_t>(200),
       "doesn't matter",
@@ -100,7 +106,9 @@ TileLoadResult loadTileContent(
       asyncSystem,
       pMockAssetAccessor,
       spdlog::default_logger(),
-      {}};
+      {},
+      nullptr,
+      decodeThreadPool};
 
   auto tileLoadResultFuture = loader.loadTileContent(loadInput);
 
@@ -108,6 +116,65 @@ TileLoadResult loadTileContent(
 
   return tileLoadResultFuture.wait();
 }
+
+void checkSameTiles(const Tile& expected, const Tile& actual) {
+  CHECK(
+      TileIdUtilities::createTileIdString(actual.getTileID()) ==
+      TileIdUtilities::createTileIdString(expected.getTileID()));
+  CHECK(actual.getGeometricError() == expected.getGeometricError());
+  CHECK(actual.getRefine() == expected.getRefine());
+  CHECK(actual.getTransform() == expected.getTransform());
+  CHECK(
+      actual.getBoundingVolume().index() ==
+      expected.getBoundingVolume().index());
+  CHECK(
+      actual.getContentBoundingVolume().has_value() ==
+      expected.getContentBoundingVolume().has_value());
+  CHECK(actual.isExternalContent() == expected.isExternalContent());
+  CHECK(actual.isEmptyContent() == expected.isEmptyContent());
+  CHECK((actual.getLoader() != nullptr) == (expected.getLoader() != nullptr));
+
+  REQUIRE(actual.getChildren().size() == expected.getChildren().size());
+  for (size_t i = 0; i < actual.getChildren().size(); ++i) {
+    CHECK(actual.getChildren()[i].getParent() == &actual);
+    checkSameTiles(expected.getChildren()[i], actual.getChildren()[i]);
+  }
+}
+
+TilesetContentLoaderResult<TilesetJsonLoader>
+createLoaderFromDocument(const std::filesystem::path& tilesetPath) {
+  std::vector<std::byte> data = readFile(tilesetPath);
+  rapidjson::Document tilesetJson;
+  tilesetJson.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  return TilesetJsonLoader::createLoader(
+      spdlog::default_logger(),
+      tilesetPath.string(),
+      tilesetJson);
+}
+
+std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+createLoaderFromData(const std::string& tilesetJson, uint32_t tileLevels = 0) {
+  return TilesetJsonLoader::createLoader(
+      spdlog::default_logger(),
+      "tileset.json",
+      gsl::span<const std::byte>(
+          reinterpret_cast<const std::byte*>(tilesetJson.data()),
+          tilesetJson.size()),
+      tileLevels);
+}
+
+void createAllTileChildren(TilesetContentLoader& loader, Tile& tile) {
+  if (tile.getChildren().empty()) {
+    TileChildrenResult childrenResult = loader.createTileChildren(tile);
+    if (childrenResult.state == TileLoadResultState::Success) {
+      tile.createChildTiles(std::move(childrenResult.children));
+    }
+  }
+
+  for (Tile& child : tile.getChildren()) {
+    createAllTileChildren(loader, child);
+  }
+}
 } // namespace
 
 TEST_CASE("Test creating tileset json loader") {
@@ -421,6 +488,159 @@ TEST_CASE("Test creating tileset json loader") {
   }
 }
 
+TEST_CASE("Test creating tiles while reading tileset json") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  SECTION("Tiles are the same as those created from a document") {
+    const std::filesystem::path tilesetPaths[] = {
+        testDataPath / "ReplaceTileset" / "tileset.json",
+        testDataPath / "AddTileset" / "tileset2.json",
+        testDataPath / "ImplicitTileset" / "tileset_1.1.json",
+        testDataPath / "MultipleKindsOfTilesets" /
+            "BoxBoundingVolumeTileset.json",
+        testDataPath / "MultipleKindsOfTilesets" /
+            "NoBoundingVolumeTileset.json",
+        testDataPath / "MultipleKindsOfTilesets" /
+            "ScaleGeometricErrorTileset.json",
+        testDataPath / "MultipleKindsOfTilesets" / "EmptyTileTileset.json",
+        testDataPath / "MultipleKindsOfTilesets" /
+            "OctreeImplicitTileset.json",
+        testDataPath / "WithMetadata" / "tileset.json"};
+
+    for (const std::filesystem::path& tilesetPath : tilesetPaths) {
+      INFO(tilesetPath.string());
+      TilesetContentLoaderResult<TilesetJsonLoader> expected =
+          createLoaderFromDocument(tilesetPath);
+
+      std::vector<std::byte> data = readFile(tilesetPath);
+      std::optional<TilesetContentLoaderResult<TilesetJsonLoader>> actual =
+          TilesetJsonLoader::createLoader(
+              spdlog::default_logger(),
+              tilesetPath.string(),
+              data);
+      REQUIRE(actual);
+      CHECK(actual->errors.hasErrors() == expected.errors.hasErrors());
+      REQUIRE(actual->pLoader);
+      REQUIRE(actual->pRootTile);
+      CHECK(actual->pLoader->getUpAxis() == expected.pLoader->getUpAxis());
+      checkSameTiles(*expected.pRootTile, *actual->pRootTile);
+
+      const TileExternalContent* pExpectedExternal =
+          expected.pRootTile->getContent().getExternalContent();
+      const TileExternalContent* pActualExternal =
+          actual->pRootTile->getContent().getExternalContent();
+      REQUIRE(pExpectedExternal);
+      REQUIRE(pActualExternal);
+      CHECK(
+          pActualExternal->metadata.schema.has_value() ==
+          pExpectedExternal->metadata.schema.has_value());
+      CHECK(
+          pActualExternal->metadata.groups.size() ==
+          pExpectedExternal->metadata.groups.size());
+    }
+  }
+
+  SECTION("Tile properties after the children are left to the document") {
+    std::optional<TilesetContentLoaderResult<TilesetJsonLoader>> result =
+        createLoaderFromData(R"(
+          {
+            "asset": { "version": "1.1" },
+            "geometricError": 100,
+            "root": {
+              "boundingVolume": { "sphere": [0, 0, 0, 100] },
+              "geometricError": 50,
+              "children": [
+                {
+                  "boundingVolume": { "sphere": [0, 0, 0, 10] },
+                  "geometricError": 5
+                }
+              ],
+              "transform": [2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 1]
+            }
+          }
+        )");
+    CHECK(!result);
+  }
+
+  SECTION("Invalid JSON is left to the document") {
+    CHECK(!createLoaderFromData("{ \"root\": "));
+  }
+
+  SECTION("Tiles below the created levels are created when visited") {
+    const std::filesystem::path tilesetPath =
+        testDataPath / "ReplaceTileset" / "tileset.json";
+    TilesetContentLoaderResult<TilesetJsonLoader> expected =
+        createLoaderFromDocument(tilesetPath);
+
+    std::vector<std::byte> data = readFile(tilesetPath);
+    std::optional<TilesetContentLoaderResult<TilesetJsonLoader>> actual =
+        TilesetJsonLoader::createLoader(
+            spdlog::default_logger(),
+            tilesetPath.string(),
+            data,
+            1);
+    REQUIRE(actual);
+    REQUIRE(actual->pLoader);
+    REQUIRE(actual->pRootTile);
+    REQUIRE(actual->pRootTile->getChildren().size() == 1);
+
+    Tile& root = actual->pRootTile->getChildren()[0];
+    CHECK(root.getChildren().empty());
+
+    TilesetMemoryUsage usage;
+    actual->pLoader->addMemoryUsage(usage);
+    CHECK(usage.availabilityBytes > 0);
+
+    TileChildrenResult childrenResult =
+        actual->pLoader->createTileChildren(root);
+    REQUIRE(childrenResult.state == TileLoadResultState::Success);
+    REQUIRE(childrenResult.children.size() == 4);
+    CHECK(childrenResult.children[0].getChildren().empty());
+    root.createChildTiles(std::move(childrenResult.children));
+
+    createAllTileChildren(*actual->pLoader, *actual->pRootTile);
+    checkSameTiles(*expected.pRootTile, *actual->pRootTile);
+  }
+
+  SECTION("Tile properties after deferred children are used") {
+    std::optional<TilesetContentLoaderResult<TilesetJsonLoader>> result =
+        createLoaderFromData(
+            R"(
+              {
+                "asset": { "version": "1.1" },
+                "geometricError": 100,
+                "root": {
+                  "boundingVolume": { "sphere": [0, 0, 0, 100] },
+                  "geometricError": 50,
+                  "children": [
+                    {
+                      "boundingVolume": { "sphere": [0, 0, 0, 10] }
+                    }
+                  ],
+                  "transform":
+                      [2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 1]
+                }
+              }
+            )",
+            1);
+    REQUIRE(result);
+    REQUIRE(result->pRootTile);
+    REQUIRE(result->pRootTile->getChildren().size() == 1);
+
+    Tile& root = result->pRootTile->getChildren()[0];
+    CHECK(root.getTransform()[0][0] == 2.0);
+
+    TileChildrenResult childrenResult =
+        result->pLoader->createTileChildren(root);
+    REQUIRE(childrenResult.state == TileLoadResultState::Success);
+    REQUIRE(childrenResult.children.size() == 1);
+
+    const Tile& child = childrenResult.children[0];
+    CHECK(child.getTransform()[0][0] == 2.0);
+    CHECK(child.getRefine() == root.getRefine());
+  }
+}
+
 TEST_CASE("Test loading individual tile of tileset json") {
   Cesium3DTilesContent::registerAllTileContentTypes();
 
@@ -448,6 +668,26 @@ TEST_CASE("Test loading individual tile of tileset json") {
     CHECK(!tileLoadResult.tileInitializer);
   }
 
+  SECTION("Load tile that has render content in a decode thread pool") {
+    auto loaderResult =
+        createLoader(testDataPath / "ReplaceTileset" / "tileset.json");
+    REQUIRE(loaderResult.pRootTile);
+    REQUIRE(loaderResult.pRootTile->getChildren().size() == 1);
+
+    auto pRootTile = &loaderResult.pRootTile->getChildren()[0];
+    const auto& tileID = std::get<std::string>(pRootTile->getTileID());
+
+    ThreadPool decodeThreadPool(1);
+    auto tileLoadResult = loadTileContent(
+        testDataPath / "ReplaceTileset" / tileID,
+        *loaderResult.pLoader,
+        *pRootTile,
+        decodeThreadPool);
+    CHECK(
+        std::holds_alternative<CesiumGltf::Model>(tileLoadResult.contentKind));
+    CHECK(tileLoadResult.state == TileLoadResultState::Success);
+  }
+
   SECTION("Load tile that has external content") {
     auto loaderResult =
         createLoader(testDataPath / "AddTileset" / "tileset.json");
@@ -1,10 +1,14 @@
 #include "Cesium3DTilesContent/registerAllTileContentTypes.h"
+#include "Cesium3DTilesSelection/ITileExcluder.h"
 #include "Cesium3DTilesSelection/Tileset.h"
 #include "Cesium3DTilesSelection/ViewState.h"
 #include "SimplePrepareRendererResource.h"
 
 #include <Cesium3DTiles/MetadataQuery.h>
+#include <CesiumAsync/BandwidthLimiter.h>
+#include <CesiumAsync/WorkStealingTaskProcessor.h>
 #include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
 #include <CesiumNativeTests/SimpleAssetAccessor.h>
 #include <CesiumNativeTests/SimpleAssetRequest.h>
 #include <CesiumNativeTests/SimpleAssetResponse.h>
@@ -15,9 +19,15 @@
 #include <glm/mat4x4.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <filesystem>
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 
 using namespace CesiumAsync;
 using namespace Cesium3DTilesSelection;
@@ -1678,3 +1688,2426 @@ TEST_CASE("Additive-refined tiles are added to the tilesFadingOut array") {
   CHECK(updateResult.tilesToRenderThisFrame.size() == 2);
   CHECK(updateResult.tilesFadingOut.size() == 2);
 }
+
+TEST_CASE("Tiles fade out over the LOD transition period") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "AdditiveThreeLevels";
+  std::vector<std::string> files{"tileset.json", "content.b3dm"};
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.enableLodTransitionPeriod = true;
+  options.lodTransitionLength = 1.0f;
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  // Load until complete, and let the tiles fade in.
+  ViewUpdateResult updateResult;
+  ViewState viewState = zoomToTileset(tileset);
+  while (tileset.getNumberOfTilesLoaded() == 0 ||
+         tileset.computeLoadProgress() < 100.0f) {
+    updateResult = tileset.updateView({viewState}, 0.25f);
+  }
+  for (int i = 0; i < 5; ++i) {
+    updateResult = tileset.updateView({viewState}, 0.25f);
+  }
+  CHECK(updateResult.tilesFadingOut.empty());
+  CHECK(updateResult.tilesWithChangedLodTransition.empty());
+
+  // Zoom way out
+  std::optional<Cartographic> position = viewState.getPositionCartographic();
+  REQUIRE(position);
+  position->height += 100000;
+
+  ViewState zoomedOut = ViewState::create(
+      Ellipsoid::WGS84.cartographicToCartesian(*position),
+      viewState.getDirection(),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+  updateResult = tileset.updateView({zoomedOut}, 0.25f);
+
+  // The two children start to fade out, and only they have changed.
+  REQUIRE(updateResult.tilesFadingOut.size() == 2);
+  CHECK(std::is_sorted(
+      updateResult.tilesFadingOut.begin(),
+      updateResult.tilesFadingOut.end()));
+  CHECK(updateResult.tilesWithChangedLodTransition.size() == 2);
+  for (Tile* pTile : updateResult.tilesFadingOut) {
+    const TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    REQUIRE(pRenderContent);
+    CHECK(pRenderContent->getLodTransitionFadePercentage() == Approx(0.25f));
+    CHECK(
+        std::count(
+            updateResult.tilesWithChangedLodTransition.begin(),
+            updateResult.tilesWithChangedLodTransition.end(),
+            pTile) == 1);
+  }
+
+  // Once they have faded out, they are removed from the list.
+  for (int i = 0; i < 3; ++i) {
+    updateResult = tileset.updateView({zoomedOut}, 0.25f);
+    CHECK(updateResult.tilesFadingOut.size() == 2);
+  }
+  updateResult = tileset.updateView({zoomedOut}, 0.25f);
+  CHECK(updateResult.tilesFadingOut.empty());
+}
+
+TEST_CASE("Render list changes are reported when requested") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "AdditiveThreeLevels";
+  std::vector<std::string> files{"tileset.json", "content.b3dm"};
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.computeRenderListChanges = true;
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  // Every tile that is rendered is reported as added once.
+  ViewUpdateResult updateResult;
+  ViewState viewState = zoomToTileset(tileset);
+  std::vector<Tile*> added;
+  while (tileset.getNumberOfTilesLoaded() == 0 ||
+         tileset.computeLoadProgress() < 100.0f) {
+    updateResult = tileset.updateView({viewState});
+    CHECK(updateResult.tilesRemovedThisFrame.empty());
+    added.insert(
+        added.end(),
+        updateResult.tilesAddedThisFrame.begin(),
+        updateResult.tilesAddedThisFrame.end());
+  }
+  updateResult = tileset.updateView({viewState});
+  CHECK(updateResult.tilesAddedThisFrame.empty());
+  CHECK(updateResult.tilesRemovedThisFrame.empty());
+
+  std::vector<Tile*> rendered = updateResult.tilesToRenderThisFrame;
+  std::sort(added.begin(), added.end());
+  std::sort(rendered.begin(), rendered.end());
+  CHECK(added == rendered);
+
+  // Zoom way out
+  std::optional<Cartographic> position = viewState.getPositionCartographic();
+  REQUIRE(position);
+  position->height += 100000;
+
+  ViewState zoomedOut = ViewState::create(
+      Ellipsoid::WGS84.cartographicToCartesian(*position),
+      viewState.getDirection(),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+  updateResult = tileset.updateView({zoomedOut});
+
+  // The two children are removed, and nothing is added.
+  CHECK(updateResult.tilesAddedThisFrame.empty());
+  REQUIRE(updateResult.tilesRemovedThisFrame.size() == 2);
+  CHECK(std::is_sorted(
+      updateResult.tilesRemovedThisFrame.begin(),
+      updateResult.tilesRemovedThisFrame.end()));
+  for (Tile* pTile : updateResult.tilesRemovedThisFrame) {
+    CHECK(std::binary_search(rendered.begin(), rendered.end(), pTile));
+    CHECK(
+        std::find(
+            updateResult.tilesToRenderThisFrame.begin(),
+            updateResult.tilesToRenderThisFrame.end(),
+            pTile) == updateResult.tilesToRenderThisFrame.end());
+  }
+
+  updateResult = tileset.updateView({zoomedOut});
+  CHECK(updateResult.tilesAddedThisFrame.empty());
+  CHECK(updateResult.tilesRemovedThisFrame.empty());
+}
+
+TEST_CASE("Tiles to render can be sorted from front to back") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "AdditiveThreeLevels";
+  std::vector<std::string> files{"tileset.json", "content.b3dm"};
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.sortTilesToRenderFrontToBack = true;
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  ViewUpdateResult updateResult;
+  ViewState viewState = zoomToTileset(tileset);
+  while (tileset.getNumberOfTilesLoaded() == 0 ||
+         tileset.computeLoadProgress() < 100.0f) {
+    updateResult = tileset.updateView({viewState});
+  }
+  updateResult = tileset.updateView({viewState});
+
+  const std::vector<Tile*>& tiles = updateResult.tilesToRenderThisFrame;
+  const std::vector<double>& distances =
+      updateResult.tilesToRenderThisFrameDistances;
+  REQUIRE(tiles.size() > 1);
+  REQUIRE(distances.size() == tiles.size());
+  REQUIRE(
+      updateResult.tilesToRenderThisFrameScreenSpaceErrors.size() ==
+      tiles.size());
+  CHECK(std::is_sorted(distances.begin(), distances.end()));
+
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    const double distance = glm::sqrt(glm::max(
+        viewState.computeDistanceSquaredToBoundingVolume(
+            tiles[i]->getBoundingVolume()),
+        0.0));
+    CHECK(distances[i] == Approx(distance));
+    CHECK(
+        updateResult.tilesToRenderThisFrameScreenSpaceErrors[i] ==
+        Approx(viewState.computeScreenSpaceError(
+            tiles[i]->getGeometricError(),
+            distance)));
+  }
+}
+
+TEST_CASE("Parallel traversal selects the same tiles as sequential traversal") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  // The work units run inline with the simple task processor, and race the
+  // main thread for the units with the threaded one.
+  std::shared_ptr<ITaskProcessor> pTaskProcessor;
+  SECTION("with tasks that run inline") {
+    pTaskProcessor = std::make_shared<SimpleTaskProcessor>();
+  }
+  SECTION("with tasks that run in worker threads") {
+    pTaskProcessor = std::make_shared<WorkStealingTaskProcessor>(4);
+  }
+
+  auto createExternals = [&]() {
+    std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+        mockCompletedRequests;
+    for (const auto& file : files) {
+      std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+          std::make_unique<SimpleAssetResponse>(
+              static_cast<uint16_t>(200),
+              "doesn't matter",
+              CesiumAsync::HttpHeaders{},
+              readFile(testDataPath / file));
+      mockCompletedRequests.insert(
+          {file,
+           std::make_shared<SimpleAssetRequest>(
+               "GET",
+               file,
+               CesiumAsync::HttpHeaders{},
+               std::move(mockCompletedResponse))});
+    }
+
+    return TilesetExternals{
+        std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+        std::make_shared<SimplePrepareRendererResource>(),
+        AsyncSystem(pTaskProcessor),
+        nullptr};
+  };
+
+  TilesetOptions parallelOptions{};
+  parallelOptions.enableParallelTraversal = true;
+  parallelOptions.parallelTraversalDepth = 2;
+
+  Tileset sequentialTileset(createExternals(), "tileset.json");
+  Tileset parallelTileset(createExternals(), "tileset.json", parallelOptions);
+  for (Tileset* pTileset : {&sequentialTileset, &parallelTileset}) {
+    while (!pTileset->getRootTile()) {
+      pTileset->getAsyncSystem().dispatchMainThreadTasks();
+    }
+    initializeTileset(*pTileset);
+  }
+
+  ViewState viewState = zoomToTileset(sequentialTileset);
+
+  auto loadFully = [&viewState](Tileset& tileset) {
+    const ViewUpdateResult* pResult = &tileset.updateView({viewState});
+    while (tileset.getNumberOfTilesLoaded() == 0 ||
+           tileset.computeLoadProgress() < 100.0f) {
+      pResult = &tileset.updateView({viewState});
+    }
+
+    // Tiles visited by parallel work units have their content updated after
+    // the traversal, so give them one more frame to be selected.
+    pResult = &tileset.updateView({viewState});
+
+    std::vector<std::string> ids;
+    for (const Tile* pTile : pResult->tilesToRenderThisFrame) {
+      ids.emplace_back(TileIdUtilities::createTileIdString(pTile->getTileID()));
+    }
+    return ids;
+  };
+
+  std::vector<std::string> sequentialIds = loadFully(sequentialTileset);
+  std::vector<std::string> parallelIds = loadFully(parallelTileset);
+
+  REQUIRE(!sequentialIds.empty());
+  CHECK(sequentialIds == parallelIds);
+}
+
+TEST_CASE("Packed selection data selects the same tiles as the tiles do") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  auto createExternals = [&]() {
+    std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+        mockCompletedRequests;
+    for (const auto& file : files) {
+      std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+          std::make_unique<SimpleAssetResponse>(
+              static_cast<uint16_t>(200),
+              "doesn't matter",
+              CesiumAsync::HttpHeaders{},
+              readFile(testDataPath / file));
+      mockCompletedRequests.insert(
+          {file,
+           std::make_shared<SimpleAssetRequest>(
+               "GET",
+               file,
+               CesiumAsync::HttpHeaders{},
+               std::move(mockCompletedResponse))});
+    }
+
+    return TilesetExternals{
+        std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+        std::make_shared<SimplePrepareRendererResource>(),
+        AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+        nullptr};
+  };
+
+  TilesetOptions packedOptions{};
+  packedOptions.enablePackedSelectionData = true;
+
+  Tileset plainTileset(createExternals(), "tileset.json");
+  Tileset packedTileset(createExternals(), "tileset.json", packedOptions);
+  initializeTileset(plainTileset);
+  initializeTileset(packedTileset);
+
+  ViewState viewState = zoomToTileset(plainTileset);
+
+  auto loadFully = [&viewState](Tileset& tileset) {
+    const ViewUpdateResult* pResult = &tileset.updateView({viewState});
+    while (tileset.getNumberOfTilesLoaded() == 0 ||
+           tileset.computeLoadProgress() < 100.0f) {
+      pResult = &tileset.updateView({viewState});
+    }
+
+    std::vector<std::string> ids;
+    for (const Tile* pTile : pResult->tilesToRenderThisFrame) {
+      ids.emplace_back(TileIdUtilities::createTileIdString(pTile->getTileID()));
+    }
+    return std::make_pair(ids, pResult->tilesVisited);
+  };
+
+  const auto [ids, tilesVisited] = loadFully(plainTileset);
+  const auto [packedIds, packedTilesVisited] = loadFully(packedTileset);
+
+  REQUIRE(!ids.empty());
+  CHECK(ids == packedIds);
+  CHECK(tilesVisited == packedTilesVisited);
+}
+
+namespace {
+class CountingTileExcluder : public ITileExcluder {
+public:
+  explicit CountingTileExcluder(bool includeSubtrees)
+      : _includeSubtrees(includeSubtrees) {}
+
+  bool shouldExclude(const Tile&) const noexcept override {
+    ++this->shouldExcludeCalls;
+    return false;
+  }
+
+  TileExclusion classify(const Tile& tile) const noexcept override {
+    ++this->classifyCalls;
+    return this->_includeSubtrees ? TileExclusion::SubtreeIncluded
+                                  : ITileExcluder::classify(tile);
+  }
+
+  void classifyChildren(
+      const Tile& parent,
+      gsl::span<const CesiumGeometry::BoundingSphere> childBoundingSpheres,
+      gsl::span<TileExclusion> results) const noexcept override {
+    ++this->classifyChildrenCalls;
+    CHECK(childBoundingSpheres.size() == parent.getChildren().size());
+    CHECK(results.size() == parent.getChildren().size());
+    ITileExcluder::classifyChildren(parent, childBoundingSpheres, results);
+  }
+
+  mutable size_t shouldExcludeCalls = 0;
+  mutable size_t classifyCalls = 0;
+  mutable size_t classifyChildrenCalls = 0;
+
+private:
+  bool _includeSubtrees;
+};
+} // namespace
+
+TEST_CASE("Excluders test the children of a tile together") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  auto pTestingExcluder = std::make_shared<CountingTileExcluder>(false);
+  auto pIncludingExcluder = std::make_shared<CountingTileExcluder>(true);
+
+  TilesetOptions options{};
+  options.excluders = {pTestingExcluder, pIncludingExcluder};
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+  tileset.updateView({viewState});
+  while (tileset.computeLoadProgress() < 100.0f) {
+    tileset.updateView({viewState});
+  }
+
+  pTestingExcluder->shouldExcludeCalls = 0;
+  pTestingExcluder->classifyCalls = 0;
+  pTestingExcluder->classifyChildrenCalls = 0;
+  pIncludingExcluder->classifyCalls = 0;
+  pIncludingExcluder->classifyChildrenCalls = 0;
+
+  const ViewUpdateResult& result = tileset.updateView({viewState});
+  REQUIRE(result.tilesVisited > 1);
+
+  // Every visited tile but the root was tested along with its siblings.
+  CHECK(pTestingExcluder->classifyCalls >= result.tilesVisited);
+  CHECK(
+      pTestingExcluder->shouldExcludeCalls == pTestingExcluder->classifyCalls);
+  CHECK(pTestingExcluder->classifyChildrenCalls > 0);
+
+  // The excluder that included the whole tileset was only asked about the
+  // root.
+  CHECK(pIncludingExcluder->classifyCalls == 1);
+  CHECK(pIncludingExcluder->classifyChildrenCalls == 0);
+}
+
+TEST_CASE("Loaded tiles can be visited in parallel") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+  tileset.updateView({viewState});
+  while (tileset.computeLoadProgress() < 100.0f) {
+    tileset.updateView({viewState});
+  }
+
+  std::vector<const Tile*> loadedTiles;
+  const Tileset& constTileset = tileset;
+  constTileset.forEachLoadedTile(
+      [&loadedTiles](const Tile& tile) { loadedTiles.emplace_back(&tile); });
+  REQUIRE(loadedTiles.size() > 1);
+
+  // Even with tasks as small as a single tile, every tile is visited once.
+  std::mutex mutex;
+  std::vector<const Tile*> visitedTiles;
+  tileset.forEachLoadedTileInParallel(
+      [&mutex, &visitedTiles](Tile& tile) {
+        std::lock_guard<std::mutex> lock(mutex);
+        visitedTiles.emplace_back(&tile);
+      },
+      1);
+
+  std::sort(loadedTiles.begin(), loadedTiles.end());
+  std::sort(visitedTiles.begin(), visitedTiles.end());
+  CHECK(visitedTiles == loadedTiles);
+
+  CHECK_THROWS_AS(
+      tileset.forEachLoadedTileInParallel(
+          [](Tile&) { throw std::runtime_error("failed"); },
+          1),
+      std::runtime_error);
+}
+
+TEST_CASE("View coherence reuses the last traversal for an unchanged view") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options{};
+  options.enableViewCoherence = true;
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+  while (tileset.getNumberOfTilesLoaded() == 0 ||
+         tileset.computeLoadProgress() < 100.0f) {
+    tileset.updateView({viewState});
+  }
+
+  const ViewUpdateResult& traversed = tileset.updateView({viewState});
+  const std::vector<Tile*> tilesToRender = traversed.tilesToRenderThisFrame;
+  const int32_t frameNumber = traversed.frameNumber;
+  REQUIRE(!tilesToRender.empty());
+
+  SECTION("an unchanged view reuses the last result") {
+    const ViewUpdateResult& result = tileset.updateView({viewState});
+    CHECK(result.tilesVisited == 0);
+    CHECK(result.frameNumber == frameNumber);
+    CHECK(result.tilesToRenderThisFrame == tilesToRender);
+  }
+
+  SECTION("a moved view traverses again") {
+    ViewState movedViewState = ViewState::create(
+        viewState.getPosition() + viewState.getDirection() * 10.0,
+        viewState.getDirection(),
+        viewState.getUp(),
+        viewState.getViewportSize(),
+        viewState.getHorizontalFieldOfView(),
+        viewState.getVerticalFieldOfView());
+
+    const ViewUpdateResult& result = tileset.updateView({movedViewState});
+    CHECK(result.tilesVisited > 0);
+    CHECK(result.frameNumber == frameNumber + 1);
+  }
+
+  SECTION("a changed screen-space error traverses again") {
+    tileset.getOptions().maximumScreenSpaceError *= 2.0;
+
+    const ViewUpdateResult& result = tileset.updateView({viewState});
+    CHECK(result.tilesVisited > 0);
+  }
+}
+
+TEST_CASE("Adaptive screen-space error follows the frame time") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options{};
+  options.maximumScreenSpaceError = 16.0;
+  options.adaptiveScreenSpaceError.enabled = true;
+  options.adaptiveScreenSpaceError.targetFrameTime = 0.1;
+  options.adaptiveScreenSpaceError.maximumScreenSpaceError = 32.0;
+  options.adaptiveScreenSpaceError.adjustmentFactor = 2.0;
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+
+  // Within the hysteresis band, the screen-space error stays where it is.
+  const ViewUpdateResult* pResult = &tileset.updateView({viewState}, 0.09f);
+  CHECK(pResult->maximumScreenSpaceError == 16.0);
+
+  // Slow frames raise it, up to the configured maximum.
+  pResult = &tileset.updateView({viewState}, 0.5f);
+  CHECK(pResult->maximumScreenSpaceError == 32.0);
+  pResult = &tileset.updateView({viewState}, 0.5f);
+  CHECK(pResult->maximumScreenSpaceError == 32.0);
+
+  pResult = &tileset.updateView({viewState}, 0.09f);
+  CHECK(pResult->maximumScreenSpaceError == 32.0);
+
+  // Fast frames lower it again, down to the base screen-space error.
+  pResult = &tileset.updateView({viewState}, 0.01f);
+  CHECK(pResult->maximumScreenSpaceError == 16.0);
+  pResult = &tileset.updateView({viewState}, 0.01f);
+  CHECK(pResult->maximumScreenSpaceError == 16.0);
+}
+
+TEST_CASE("Dynamic screen-space error refines less toward the horizon") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  auto createExternals = [&]() {
+    std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+        mockCompletedRequests;
+    for (const auto& file : files) {
+      std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+          std::make_unique<SimpleAssetResponse>(
+              static_cast<uint16_t>(200),
+              "doesn't matter",
+              CesiumAsync::HttpHeaders{},
+              readFile(testDataPath / file));
+      mockCompletedRequests.insert(
+          {file,
+           std::make_shared<SimpleAssetRequest>(
+               "GET",
+               file,
+               CesiumAsync::HttpHeaders{},
+               std::move(mockCompletedResponse))});
+    }
+
+    return TilesetExternals{
+        std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+        std::make_shared<SimplePrepareRendererResource>(),
+        AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+        nullptr};
+  };
+
+  TilesetOptions dynamicOptions{};
+  dynamicOptions.enableDynamicScreenSpaceError = true;
+  dynamicOptions.dynamicScreenSpaceErrorDensity = 1.0;
+  dynamicOptions.dynamicScreenSpaceErrorFactor = 1.0e6;
+  dynamicOptions.dynamicScreenSpaceErrorHeightFalloff = 1.0;
+
+  Tileset staticTileset(createExternals(), "tileset.json");
+  Tileset dynamicTileset(createExternals(), "tileset.json", dynamicOptions);
+  initializeTileset(staticTileset);
+  initializeTileset(dynamicTileset);
+
+  // Look across the tileset from the middle of its height range, so that the
+  // camera is below the top of the root tile.
+  const Tile* pRoot = staticTileset.getRootTile();
+  REQUIRE(pRoot);
+  const BoundingRegion* pRegion =
+      std::get_if<BoundingRegion>(&pRoot->getBoundingVolume());
+  REQUIRE(pRegion);
+
+  const GlobeRectangle& rectangle = pRegion->getRectangle();
+  Cartographic corner = rectangle.getNorthwest();
+  corner.height =
+      (pRegion->getMinimumHeight() + pRegion->getMaximumHeight()) * 0.5;
+  Cartographic center = rectangle.computeCenter();
+  center.height = corner.height;
+
+  // Step back a little from the corner so that the camera is outside of the
+  // tiles, which gives them a non-zero distance.
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  glm::dvec3 cornerPosition = ellipsoid.cartographicToCartesian(corner);
+  glm::dvec3 viewFocus = ellipsoid.cartographicToCartesian(center);
+  glm::dvec3 viewDirection = glm::normalize(viewFocus - cornerPosition);
+  glm::dvec3 viewPosition = cornerPosition - viewDirection * 100.0;
+  glm::dvec2 viewPortSize{500.0, 500.0};
+  double horizontalFieldOfView = Math::degreesToRadians(60.0);
+  ViewState viewState = ViewState::create(
+      viewPosition,
+      viewDirection,
+      ellipsoid.geodeticSurfaceNormal(viewPosition),
+      viewPortSize,
+      horizontalFieldOfView,
+      horizontalFieldOfView);
+
+  auto loadFully = [&viewState](Tileset& tileset) {
+    tileset.updateView({viewState});
+    while (tileset.getNumberOfTilesLoaded() == 0 ||
+           tileset.computeLoadProgress() < 100.0f) {
+      tileset.updateView({viewState});
+    }
+    return tileset.updateView({viewState}).tilesToRenderThisFrame;
+  };
+
+  std::vector<Tile*> staticTiles = loadFully(staticTileset);
+  std::vector<Tile*> dynamicTiles = loadFully(dynamicTileset);
+
+  // With an extreme density and factor, every tile meets the screen-space
+  // error, so only the first tile with content is rendered.
+  REQUIRE(dynamicTiles.size() == 1);
+  CHECK(dynamicTiles[0] == &dynamicTileset.getRootTile()->getChildren()[0]);
+  CHECK(staticTiles.size() > dynamicTiles.size());
+}
+
+TEST_CASE("Tiles needed by predicted views are prefetched") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+
+  // Nothing is in view this frame, but the camera is about to zoom to the
+  // tileset, where the root does not meet the screen-space error.
+  for (int i = 0; i < 10; ++i) {
+    const ViewUpdateResult& result = tileset.updateView({}, 0.0f, {viewState});
+    CHECK(result.tilesToRenderThisFrame.empty());
+  }
+
+  const Tile* pRoot = tileset.getRootTile();
+  REQUIRE(pRoot);
+  REQUIRE(pRoot->getChildren().size() == 1);
+
+  gsl::span<const Tile> children = pRoot->getChildren()[0].getChildren();
+  CHECK(std::any_of(children.begin(), children.end(), [](const Tile& child) {
+    return child.getState() == TileLoadState::ContentLoaded;
+  }));
+}
+
+TEST_CASE("Tile loads wait while the bandwidth limiter is exhausted") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<BandwidthLimiter> pLimiter =
+      std::make_shared<BandwidthLimiter>(0.0, 1024 * 1024);
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+  tilesetExternals.pBandwidthLimiter = pLimiter;
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  const Tile* pRoot = tileset.getRootTile();
+  REQUIRE(pRoot);
+  REQUIRE(pRoot->getChildren().size() == 1);
+  gsl::span<const Tile> children = pRoot->getChildren()[0].getChildren();
+  REQUIRE(!children.empty());
+
+  // Empty the bucket and go into debt.
+  pLimiter->setBurstBytes(0);
+  pLimiter->consume(500);
+
+  ViewState viewState = zoomToTileset(tileset);
+  {
+    const ViewUpdateResult& result = tileset.updateView({viewState});
+    CHECK(result.workerThreadTileLoadQueueLength > 0);
+    CHECK(
+        result.tileLoadsThrottledByBandwidth ==
+        result.workerThreadTileLoadQueueLength);
+    CHECK(result.bandwidthThrottledBytes == 500);
+    for (const Tile& child : children) {
+      CHECK(child.getState() == TileLoadState::Unloaded);
+    }
+  }
+
+  // Refill the bucket.
+  pLimiter->setBurstBytes(1024 * 1024);
+  pLimiter->setBytesPerSecond(1.0e12);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  {
+    const ViewUpdateResult& result = tileset.updateView({viewState});
+    CHECK(result.tileLoadsThrottledByBandwidth == 0);
+    CHECK(result.bandwidthThrottledBytes == 0);
+    for (const Tile& child : children) {
+      CHECK(child.getState() != TileLoadState::Unloaded);
+    }
+  }
+}
+
+TEST_CASE("External tilesets of rendered tiles' children are fetched ahead") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "AddTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "tileset2.json",
+      "parent.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "tileset3/tileset3.json",
+      "tileset3/ll.b3dm"};
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  // Every tile meets the screen-space error, so parent.b3dm is rendered and
+  // its children are never visited.
+  TilesetOptions options;
+  options.maximumScreenSpaceError = 1.0e9;
+  options.speculativeFetchScreenSpaceErrorRatio = 0.0;
+
+  SECTION("when enabled") { options.enableSpeculativeFetch = true; }
+
+  SECTION("when disabled") { options.enableSpeculativeFetch = false; }
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+  for (int i = 0; i < 5; ++i) {
+    tileset.updateView({viewState});
+  }
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  REQUIRE(root.getChildren().size() == 1);
+  const Tile& parentB3DM = root.getChildren()[0];
+  REQUIRE(parentB3DM.getChildren().size() == 4);
+
+  const Tile* pTileset3 = nullptr;
+  for (const Tile& child : parentB3DM.getChildren()) {
+    // Only the external tileset is fetched, not the render content.
+    if (*std::get_if<std::string>(&child.getTileID()) ==
+        "tileset3/tileset3.json") {
+      pTileset3 = &child;
+    } else {
+      CHECK(child.getState() == TileLoadState::Unloaded);
+    }
+  }
+  REQUIRE(pTileset3);
+
+  const ViewUpdateResult& result = tileset.updateView({viewState});
+  CHECK(result.speculativeFetchesInProgress == 0);
+  CHECK(
+      std::find(
+          result.tilesToRenderThisFrame.begin(),
+          result.tilesToRenderThisFrame.end(),
+          pTileset3) == result.tilesToRenderThisFrame.end());
+
+  if (tileset.getOptions().enableSpeculativeFetch) {
+    CHECK(pTileset3->getState() == TileLoadState::Done);
+    REQUIRE(pTileset3->getChildren().size() == 1);
+    CHECK(
+        pTileset3->getChildren()[0].getState() == TileLoadState::Unloaded);
+  } else {
+    CHECK(pTileset3->getState() == TileLoadState::Unloaded);
+    CHECK(pTileset3->getChildren().empty());
+  }
+}
+
+TEST_CASE("Tiles are unloaded to stay within the GPU budget") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimplePrepareRendererResource> pPrepareRendererResources =
+      std::make_shared<SimplePrepareRendererResource>();
+  pPrepareRendererResources->gpuBytesPerTile = 1000;
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      pPrepareRendererResources,
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  auto countGpuBytes = [&tileset]() {
+    int64_t bytes = 0;
+    tileset.forEachLoadedTile([&bytes](Tile& tile) {
+      const TileRenderContent* pRenderContent =
+          tile.getContent().getRenderContent();
+      if (tile.getState() == TileLoadState::Done && pRenderContent) {
+        bytes += pRenderContent->getGpuByteSize();
+      }
+    });
+    return bytes;
+  };
+
+  ViewState viewState = zoomToTileset(tileset);
+  for (int i = 0; i < 10; ++i) {
+    tileset.updateView({viewState});
+  }
+
+  const int64_t gpuBytes = tileset.getTotalGpuBytes();
+  CHECK(gpuBytes > 0);
+  CHECK(gpuBytes == countGpuBytes());
+
+  // Once nothing is in view, the unused tiles are unloaded to get under the
+  // GPU budget, even though the CPU cache has plenty of room.
+  tileset.getOptions().maximumGpuBytes = 0;
+  tileset.updateView({});
+
+  CHECK(tileset.getTotalGpuBytes() < gpuBytes);
+  CHECK(tileset.getTotalGpuBytes() == countGpuBytes());
+  CHECK(tileset.getTotalDataBytes() < tileset.getOptions().maximumCachedBytes);
+}
+
+TEST_CASE("Skipping levels of detail does not load intermediate tiles") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.enableSkipLevelOfDetail = true;
+  options.forbidHoles = true;
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  // Zoom in far enough that ll.b3dm must be refined to ll_ll.b3dm.
+  ViewState viewState = zoomToTileset(tileset);
+  ViewState zoomInViewState = ViewState::create(
+      viewState.getPosition() + viewState.getDirection() * 200.0,
+      viewState.getDirection(),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  const Tile& ll = root.getChildren()[0];
+  const Tile& ll_ll = ll.getChildren()[0];
+
+  // 1st frame. Nothing below the root is ready, so the root stands in for
+  // all of its descendants.
+  {
+    ViewUpdateResult result = tileset.updateView({zoomInViewState});
+    REQUIRE(!doesTileMeetSSE(zoomInViewState, ll, tileset));
+    REQUIRE(doesTileMeetSSE(zoomInViewState, ll_ll, tileset));
+
+    REQUIRE(result.tilesToRenderThisFrame.size() == 1);
+    CHECK(result.tilesToRenderThisFrame.front() == &root);
+  }
+
+  // 2nd frame. The desired tiles are loaded and rendered, but ll.b3dm was
+  // skipped.
+  {
+    ViewUpdateResult result = tileset.updateView({zoomInViewState});
+    CHECK(ll.getState() == TileLoadState::Unloaded);
+    CHECK(ll_ll.getState() == TileLoadState::Done);
+
+    REQUIRE(result.tilesToRenderThisFrame.size() == 4);
+    CHECK(result.tilesToRenderThisFrame[0] == &ll_ll);
+    CHECK(result.tilesToRenderThisFrame[1] == &root.getChildren()[1]);
+    CHECK(result.tilesToRenderThisFrame[2] == &root.getChildren()[2]);
+    CHECK(result.tilesToRenderThisFrame[3] == &root.getChildren()[3]);
+  }
+}
+
+TEST_CASE("View update timings are reported when enabled") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+  ViewState viewState = zoomToTileset(tileset);
+
+  SECTION("timings are zero by default") {
+    const ViewUpdateResult& result = tileset.updateView({viewState});
+    CHECK(result.timings.totalTime == 0.0);
+    CHECK(result.timings.traversalTime == 0.0);
+    CHECK(result.timings.bytesLoaded == 0);
+  }
+
+  SECTION("timings are measured when enabled") {
+    tileset.getOptions().enableViewUpdateTimings = true;
+
+    int64_t bytesLoaded = 0;
+    for (int i = 0; i < 3; ++i) {
+      const ViewUpdateResult& result = tileset.updateView({viewState});
+      const ViewUpdateTimings& timings = result.timings;
+      CHECK(timings.totalTime > 0.0);
+      CHECK(timings.traversalTime > 0.0);
+      CHECK(
+          timings.totalTime >=
+          timings.traversalTime + timings.workerThreadLoadQueueTime +
+              timings.mainThreadLoadQueueTime +
+              timings.unloadCachedTilesTime + timings.lodTransitionTime);
+      bytesLoaded += timings.bytesLoaded;
+    }
+
+    // The children of the root finished loading along the way.
+    CHECK(bytesLoaded > 0);
+  }
+}
+
+TEST_CASE("Tile load timelines are recorded when enabled") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+  ViewState viewState = zoomToTileset(tileset);
+
+  SECTION("no timelines are recorded by default") {
+    for (int i = 0; i < 3; ++i) {
+      tileset.updateView({viewState});
+    }
+
+    tileset.forEachLoadedTile(
+        [](const Tile& tile) { CHECK(!tile.getLoadTimeline()); });
+    CHECK(tileset.getTileLoadHistograms().doneCount == 0);
+  }
+
+  SECTION("timelines are recorded when enabled") {
+    tileset.getOptions().enableTileLoadTimelines = true;
+    for (int i = 0; i < 3; ++i) {
+      tileset.updateView({viewState});
+    }
+
+    // The root was loaded before the timelines were enabled.
+    int64_t doneTiles = 0;
+    tileset.forEachLoadedTile([&doneTiles](const Tile& tile) {
+      const TileLoadTimeline* pTimeline = tile.getLoadTimeline();
+      if (!pTimeline || tile.getState() != TileLoadState::Done) {
+        return;
+      }
+
+      ++doneTiles;
+      CHECK(pTimeline->getTime(TileLoadEvent::Queued));
+      CHECK(pTimeline->getTime(TileLoadEvent::RequestStarted));
+      CHECK(pTimeline->getTime(TileLoadEvent::ContentParsed));
+      CHECK(pTimeline->getTime(TileLoadEvent::PrepareInMainThreadStarted));
+      CHECK(pTimeline->getDuration(TileLoadPhase::Request));
+      CHECK(pTimeline->getDuration(TileLoadPhase::Total));
+      CHECK(!pTimeline->getTime(TileLoadEvent::ProcessedContentCacheHit));
+    });
+    CHECK(doneTiles > 0);
+
+    const TileLoadHistograms& histograms = tileset.getTileLoadHistograms();
+    CHECK(histograms.doneCount == doneTiles);
+    CHECK(histograms.failedCount == 0);
+    CHECK(
+        histograms.getHistogram(TileLoadPhase::Total).sampleCount ==
+        doneTiles);
+
+    tileset.resetTileLoadHistograms();
+    CHECK(tileset.getTileLoadHistograms().doneCount == 0);
+  }
+}
+
+TEST_CASE("Regions are precached without renderer resources") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  auto pPrepareRendererResources =
+      std::make_shared<SimplePrepareRendererResource>();
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      pPrepareRendererResources,
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  auto precache = [](Tileset& tileset,
+                     const GlobeRectangle& rectangle,
+                     const RegionPrecacheOptions& options) {
+    Future<RegionPrecacheProgress> future =
+        tileset.precacheRegion(rectangle, options);
+    for (int i = 0; i < 100 && !future.isReady(); ++i) {
+      tileset.updateView({});
+    }
+    REQUIRE(future.isReady());
+    return future.wait();
+  };
+
+  const GlobeRectangle wholeTileset(
+      -1.3197209591796106,
+      0.6988424218,
+      -1.3196390408203893,
+      0.6989055782);
+
+  RegionPrecacheOptions options;
+  options.maximumScreenSpaceError = 0.0;
+  uint32_t progressReports = 0;
+  options.progressCallback = [&progressReports](const RegionPrecacheProgress&) {
+    ++progressReports;
+  };
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  const RegionPrecacheProgress all = precache(tileset, wholeTileset, options);
+  CHECK(all.tilesFailed == 0);
+  CHECK(all.tilesLoading == 0);
+  CHECK(all.tilesRemaining == 0);
+  CHECK(all.tilesFetched >= 6);
+  CHECK(all.bytesFetched > 0);
+  CHECK(progressReports > 0);
+
+  // The content was fetched, and unloaded again without being prepared for
+  // rendering.
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  CHECK(root.getState() == TileLoadState::Unloaded);
+  for (const Tile& child : root.getChildren()) {
+    CHECK(child.getState() == TileLoadState::Unloaded);
+  }
+  CHECK(pPrepareRendererResources->totalAllocation == 0);
+
+  SECTION("the maximum level stops refinement") {
+    Tileset limitedTileset(tilesetExternals, "tileset.json");
+    options.maximumLevel = 2;
+    const RegionPrecacheProgress limited =
+        precache(limitedTileset, wholeTileset, options);
+
+    // Only ll_ll.b3dm, at level 3, is skipped.
+    CHECK(limited.tilesFailed == 0);
+    CHECK(limited.tilesFetched + 1 == all.tilesFetched);
+  }
+
+  SECTION("tiles outside the rectangle are not fetched") {
+    Tileset partialTileset(tilesetExternals, "tileset.json");
+    const GlobeRectangle insideLowerLeft(-1.31971, 0.69885, -1.31969, 0.69886);
+    const RegionPrecacheProgress partial =
+        precache(partialTileset, insideLowerLeft, options);
+
+    CHECK(partial.tilesFailed == 0);
+    CHECK(partial.tilesFetched > 0);
+    CHECK(partial.tilesFetched + 3 == all.tilesFetched);
+  }
+
+  SECTION("the tileset renders normally afterwards") {
+    initializeTileset(tileset);
+    ViewState viewState = zoomToTileset(tileset);
+    tileset.updateView({viewState});
+    const ViewUpdateResult& result = tileset.updateView({viewState});
+    CHECK(!result.tilesToRenderThisFrame.empty());
+  }
+}
+
+namespace {
+// Needs three calls, each processing 100 bytes, to prepare a tile.
+class IncrementalPrepareRendererResource
+    : public SimplePrepareRendererResource {
+public:
+  std::map<const Tile*, int> callsPerTile;
+
+  virtual MainThreadPrepareResult prepareInMainThreadIncrementally(
+      Tile& tile,
+      void* pLoadThreadResult,
+      const MainThreadLoadBudget& /*budget*/) override {
+    const int calls = ++this->callsPerTile[&tile];
+    if (calls < 3) {
+      return {false, nullptr, 100};
+    }
+
+    return {true, this->prepareInMainThread(tile, pLoadThreadResult), 100};
+  }
+};
+} // namespace
+
+TEST_CASE("Main-thread loading resumes across frames within a byte limit") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<IncrementalPrepareRendererResource>
+      pPrepareRendererResources =
+          std::make_shared<IncrementalPrepareRendererResource>();
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      pPrepareRendererResources,
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.mainThreadLoadingByteLimit = 100;
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile* pRoot = &pTilesetJson->getChildren()[0];
+
+  // Each frame only has the budget for one step of one tile, so the root
+  // stays partially prepared for a while before it is done.
+  ViewState viewState = zoomToTileset(tileset);
+  bool sawPartiallyPrepared = false;
+  for (int i = 0; i < 10 && pRoot->getState() != TileLoadState::Done; ++i) {
+    tileset.updateView({viewState});
+    const auto it = pPrepareRendererResources->callsPerTile.find(pRoot);
+    if (it != pPrepareRendererResources->callsPerTile.end() &&
+        it->second < 3) {
+      sawPartiallyPrepared = true;
+      CHECK(pRoot->getState() == TileLoadState::ContentLoaded);
+    }
+  }
+
+  CHECK(sawPartiallyPrepared);
+  CHECK(pRoot->getState() == TileLoadState::Done);
+  CHECK(pPrepareRendererResources->callsPerTile[pRoot] == 3);
+}
+
+namespace {
+// Records the tiles of each batch.
+class BatchingPrepareRendererResource : public SimplePrepareRendererResource {
+public:
+  std::vector<size_t> preparedBatchSizes;
+  std::vector<size_t> freedBatchSizes;
+  size_t freedIndividually = 0;
+
+  virtual void prepareInMainThreadBatch(
+      gsl::span<TileRendererResources> tiles) override {
+    this->preparedBatchSizes.emplace_back(tiles.size());
+    SimplePrepareRendererResource::prepareInMainThreadBatch(tiles);
+  }
+
+  virtual void free(
+      Tile& tile,
+      void* pLoadThreadResult,
+      void* pMainThreadResult) noexcept override {
+    ++this->freedIndividually;
+    SimplePrepareRendererResource::free(
+        tile,
+        pLoadThreadResult,
+        pMainThreadResult);
+  }
+
+  virtual void
+  freeBatch(gsl::span<const TileRendererResources> tiles) noexcept override {
+    this->freedBatchSizes.emplace_back(tiles.size());
+    for (const TileRendererResources& resources : tiles) {
+      SimplePrepareRendererResource::free(
+          *resources.pTile,
+          resources.pLoadThreadResult,
+          resources.pMainThreadResult);
+    }
+  }
+};
+} // namespace
+
+TEST_CASE("Renderer resources can be prepared and freed in batches") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<BatchingPrepareRendererResource> pPrepareRendererResources =
+      std::make_shared<BatchingPrepareRendererResource>();
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      pPrepareRendererResources,
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.batchRendererResourceCalls = true;
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+  while (tileset.getNumberOfTilesLoaded() == 0 ||
+         tileset.computeLoadProgress() < 100.0f) {
+    tileset.updateView({viewState});
+  }
+  const ViewUpdateResult& result = tileset.updateView({viewState});
+  CHECK(!result.tilesToRenderThisFrame.empty());
+
+  // The root's children finish loading in the same frame.
+  REQUIRE(!pPrepareRendererResources->preparedBatchSizes.empty());
+  CHECK(
+      *std::max_element(
+          pPrepareRendererResources->preparedBatchSizes.begin(),
+          pPrepareRendererResources->preparedBatchSizes.end()) > 1);
+
+  // Zoom way out, so that the children can be unloaded.
+  std::optional<Cartographic> position = viewState.getPositionCartographic();
+  REQUIRE(position);
+  position->height += 100000;
+
+  ViewState zoomedOut = ViewState::create(
+      Ellipsoid::WGS84.cartographicToCartesian(*position),
+      viewState.getDirection(),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+  tileset.getOptions().maximumCachedBytes = 0;
+  tileset.updateView({zoomedOut});
+  tileset.updateView({zoomedOut});
+
+  REQUIRE(!pPrepareRendererResources->freedBatchSizes.empty());
+  CHECK(pPrepareRendererResources->freedIndividually == 0);
+}
+
+TEST_CASE("Destroying a tileset frees its renderer resources in one batch") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<BatchingPrepareRendererResource> pPrepareRendererResources =
+      std::make_shared<BatchingPrepareRendererResource>();
+
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      pPrepareRendererResources,
+      asyncSystem,
+      nullptr};
+
+  TilesetOptions options;
+  options.batchRendererResourceCalls = true;
+  std::unique_ptr<Tileset> pTileset =
+      std::make_unique<Tileset>(tilesetExternals, "tileset.json", options);
+  initializeTileset(*pTileset);
+
+  ViewState viewState = zoomToTileset(*pTileset);
+  while (pTileset->getNumberOfTilesLoaded() == 0 ||
+         pTileset->computeLoadProgress() < 100.0f) {
+    pTileset->updateView({viewState});
+  }
+  REQUIRE(pTileset->getNumberOfTilesLoaded() > 1);
+
+  SharedFuture<void> destroyed = pTileset->getAsyncDestructionCompleteEvent();
+  pTileset.reset();
+
+  for (int i = 0; i < 100 && !destroyed.isReady(); ++i) {
+    asyncSystem.dispatchMainThreadTasks();
+  }
+  CHECK(destroyed.isReady());
+
+  REQUIRE(pPrepareRendererResources->freedBatchSizes.size() == 1);
+  CHECK(pPrepareRendererResources->freedBatchSizes[0] > 1);
+  CHECK(pPrepareRendererResources->freedIndividually == 0);
+  CHECK(pPrepareRendererResources->totalAllocation == 0);
+}
+
+TEST_CASE("Trimming memory unloads the tiles that are not rendered") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+  while (tileset.getNumberOfTilesLoaded() == 0 ||
+         tileset.computeLoadProgress() < 100.0f) {
+    tileset.updateView({viewState});
+  }
+
+  // Zoom way out, so that only the root is rendered.
+  std::optional<Cartographic> position = viewState.getPositionCartographic();
+  REQUIRE(position);
+  position->height += 100000;
+
+  ViewState zoomedOut = ViewState::create(
+      Ellipsoid::WGS84.cartographicToCartesian(*position),
+      viewState.getDirection(),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+  tileset.updateView({zoomedOut});
+  const ViewUpdateResult& result = tileset.updateView({zoomedOut});
+  REQUIRE(result.tilesToRenderThisFrame.size() == 1);
+
+  const int64_t dataBytes = tileset.getTotalDataBytes();
+  const int32_t tilesLoaded = tileset.getNumberOfTilesLoaded();
+  const int64_t maximumCachedBytes = tileset.getOptions().maximumCachedBytes;
+
+  const int64_t bytesFreed = tileset.trimMemory(0);
+  CHECK(bytesFreed > 0);
+  CHECK(tileset.getTotalDataBytes() == dataBytes - bytesFreed);
+  CHECK(tileset.getNumberOfTilesLoaded() < tilesLoaded);
+  CHECK(tileset.getOptions().maximumCachedBytes == maximumCachedBytes);
+
+  // The rendered tile stays loaded.
+  const Tile* pRendered = result.tilesToRenderThisFrame[0];
+  CHECK(pRendered->getState() == TileLoadState::Done);
+}
+
+TEST_CASE("View sessions select tiles independently from shared content") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  ViewState zoomedIn = zoomToTileset(tileset);
+  while (tileset.getNumberOfTilesLoaded() == 0 ||
+         tileset.computeLoadProgress() < 100.0f) {
+    tileset.updateView({zoomedIn});
+  }
+
+  const std::vector<Tile*> tilesToRender =
+      tileset.updateView({zoomedIn}).tilesToRenderThisFrame;
+  REQUIRE(tilesToRender.size() > 1);
+  const int32_t tilesLoaded = tileset.getNumberOfTilesLoaded();
+
+  std::optional<Cartographic> position = zoomedIn.getPositionCartographic();
+  REQUIRE(position);
+  position->height += 100000;
+
+  ViewState zoomedOut = ViewState::create(
+      Ellipsoid::WGS84.cartographicToCartesian(*position),
+      zoomedIn.getDirection(),
+      zoomedIn.getUp(),
+      zoomedIn.getViewportSize(),
+      zoomedIn.getHorizontalFieldOfView(),
+      zoomedIn.getVerticalFieldOfView());
+
+  const uint64_t sessionID = tileset.addViewSession();
+
+  // The session renders the content that was loaded for updateView, without
+  // loading it again.
+  const ViewUpdateResult& sessionResult =
+      tileset.updateViewSession(sessionID, {zoomedIn});
+  CHECK(sessionResult.tilesToRenderThisFrame == tilesToRender);
+  CHECK(sessionResult.workerThreadTileLoadQueueLength == 0);
+  CHECK(tileset.getNumberOfTilesLoaded() == tilesLoaded);
+
+  // Each session keeps its own selection.
+  tileset.updateViewSession(sessionID, {zoomedOut});
+  const ViewUpdateResult& result = tileset.updateView({zoomedIn});
+  CHECK(result.tilesToRenderThisFrame == tilesToRender);
+  CHECK(result.tilesKicked == 0);
+  const std::vector<Tile*> sessionTilesToRender =
+      tileset.updateViewSession(sessionID, {zoomedOut}).tilesToRenderThisFrame;
+  const Tile* pRoot = &tileset.getRootTile()->getChildren()[0];
+  REQUIRE(sessionTilesToRender.size() == 1);
+  CHECK(sessionTilesToRender[0] == pRoot);
+
+  // The tiles that updateView renders stay loaded while the session unloads
+  // everything it can.
+  tileset.getOptions().maximumCachedBytes = 0;
+  tileset.updateViewSession(sessionID, {zoomedOut});
+  for (const Tile* pTile : tilesToRender) {
+    CHECK(pTile->getState() == TileLoadState::Done);
+  }
+
+  // Once no session needs them, they are unloaded.
+  tileset.updateView({zoomedOut});
+  tileset.updateViewSession(sessionID, {zoomedOut});
+  for (const Tile* pTile : tilesToRender) {
+    CHECK(pTile->getState() == TileLoadState::Unloaded);
+  }
+  CHECK(pRoot->getState() == TileLoadState::Done);
+
+  tileset.removeViewSession(sessionID);
+  CHECK(
+      tileset.updateView({zoomedOut}).tilesToRenderThisFrame ==
+      sessionTilesToRender);
+}
+
+TEST_CASE("Selection queries find tiles without loading their content") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  // The asset accessor fails the test if any tile content is requested.
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  auto createExternals = [](const std::filesystem::path& directory,
+                            const std::vector<std::string>& files) {
+    std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+        mockCompletedRequests;
+    for (const auto& file : files) {
+      std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+          std::make_unique<SimpleAssetResponse>(
+              static_cast<uint16_t>(200),
+              "doesn't matter",
+              CesiumAsync::HttpHeaders{},
+              readFile(directory / file));
+      mockCompletedRequests.insert(
+          {file,
+           std::make_shared<SimpleAssetRequest>(
+               "GET",
+               file,
+               CesiumAsync::HttpHeaders{},
+               std::move(mockCompletedResponse))});
+    }
+
+    return TilesetExternals{
+        std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+        std::make_shared<SimplePrepareRendererResource>(),
+        AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+        nullptr};
+  };
+
+  auto query = [](Tileset& tileset,
+                  const std::vector<ViewState>& frustums,
+                  const TileSelectionQueryOptions& options) {
+    Future<TileSelectionQueryResult> future =
+        tileset.querySelection(frustums, options);
+    for (int i = 0; i < 100 && !future.isReady(); ++i) {
+      tileset.updateView({});
+    }
+    REQUIRE(future.isReady());
+    return future.wait();
+  };
+
+  SECTION("explicit tiles are selected by their geometric error") {
+    TilesetExternals tilesetExternals =
+        createExternals(testDataPath / "ReplaceTileset", {"tileset.json"});
+    Tileset tileset(tilesetExternals, "tileset.json");
+    for (int i = 0; i < 100 && !tileset.getRootTile(); ++i) {
+      tileset.updateView({});
+    }
+    REQUIRE(tileset.getRootTile());
+
+    ViewState viewState = zoomToTileset(tileset);
+    TileSelectionQueryOptions options;
+    options.maximumScreenSpaceError = 0.0;
+    const TileSelectionQueryResult all = query(tileset, {viewState}, options);
+
+    std::vector<std::string> contentUrls;
+    for (const TileSelectionQueryTile& tile : all.tiles) {
+      REQUIRE(tile.contentUrl);
+      CHECK(std::get<std::string>(tile.tileID) == *tile.contentUrl);
+      contentUrls.emplace_back(*tile.contentUrl);
+    }
+    std::sort(contentUrls.begin(), contentUrls.end());
+    CHECK(
+        contentUrls == std::vector<std::string>{
+                           "ll_ll.b3dm",
+                           "lr.b3dm",
+                           "ul.b3dm",
+                           "ur.b3dm"});
+    CHECK(all.tilesVisited == 7);
+
+    // Zoomed out, the root meets the screen-space error.
+    ViewState zoomedOut = ViewState::create(
+        viewState.getPosition() - viewState.getDirection() * 2500.0,
+        viewState.getDirection(),
+        viewState.getUp(),
+        viewState.getViewportSize(),
+        viewState.getHorizontalFieldOfView(),
+        viewState.getVerticalFieldOfView());
+    const TileSelectionQueryResult root =
+        query(tileset, {zoomedOut}, TileSelectionQueryOptions());
+    REQUIRE(root.tiles.size() == 1);
+    CHECK(root.tiles[0].contentUrl == "parent.b3dm");
+    CHECK(root.tiles[0].level == 1);
+    CHECK(root.tiles[0].geometricError == 70.0);
+
+    const Tile& parent = tileset.getRootTile()->getChildren()[0];
+    CHECK(parent.getState() == TileLoadState::Unloaded);
+    for (const Tile& child : parent.getChildren()) {
+      CHECK(child.getState() == TileLoadState::Unloaded);
+    }
+  }
+
+  SECTION("implicit tiles are selected from the subtree availability") {
+    TilesetExternals tilesetExternals = createExternals(
+        testDataPath / "ImplicitTileset",
+        {"tileset_1.1.json", "subtrees/0.0.0.json"});
+    Tileset tileset(tilesetExternals, "tileset_1.1.json");
+    for (int i = 0; i < 100 && !tileset.getRootTile(); ++i) {
+      tileset.updateView({});
+    }
+    REQUIRE(tileset.getRootTile());
+
+    ViewState viewState = zoomToTileset(tileset);
+    TileSelectionQueryOptions options;
+    options.maximumScreenSpaceError = 0.0;
+    const TileSelectionQueryResult result =
+        query(tileset, {viewState}, options);
+
+    // The root is refined by adding its children, so it is selected with
+    // them.
+    REQUIRE(result.tiles.size() == 5);
+    CHECK(
+        std::get<CesiumGeometry::QuadtreeTileID>(result.tiles[0].tileID) ==
+        CesiumGeometry::QuadtreeTileID(0, 0, 0));
+    CHECK(result.tiles[0].contentUrl == "content/0/0/0.b3dm");
+    for (size_t i = 1; i < result.tiles.size(); ++i) {
+      const CesiumGeometry::QuadtreeTileID& tileID =
+          std::get<CesiumGeometry::QuadtreeTileID>(result.tiles[i].tileID);
+      CHECK(tileID.level == 1);
+      CHECK(
+          result.tiles[i].contentUrl ==
+          "content/1/" + std::to_string(tileID.x) + "/" +
+              std::to_string(tileID.y) + ".b3dm");
+    }
+
+    SECTION("the maximum level stops refinement") {
+      options.maximumLevel = 2;
+      const TileSelectionQueryResult limited =
+          query(tileset, {viewState}, options);
+      REQUIRE(limited.tiles.size() == 1);
+      CHECK(limited.tiles[0].contentUrl == "content/0/0/0.b3dm");
+    }
+
+    SECTION("tiles outside the region are not selected") {
+      options.region = GlobeRectangle(-1.31971, 0.69885, -1.31969, 0.69886);
+      const TileSelectionQueryResult partial =
+          query(tileset, {viewState}, options);
+      CHECK(partial.tiles.size() == 2);
+    }
+  }
+}
+
+TEST_CASE("Only final leaf tiles are culled by their content bounding volume") {
+  class LeafContentLoader : public TilesetContentLoader {
+  public:
+    std::unique_ptr<Tile> createRootTile() {
+      const Cartographic center = Cartographic::fromDegrees(118.0, 32.0, 0.0);
+      const BoundingRegion region(
+          GlobeRectangle(
+              center.longitude - 0.001,
+              center.latitude - 0.001,
+              center.longitude + 0.001,
+              center.latitude + 0.001),
+          0.0,
+          10.0);
+
+      // The content of every child is on the other side of the globe, so it
+      // is never visible.
+      const Cartographic farAway = Cartographic::fromDegrees(-62.0, -32.0);
+      const BoundingRegion farAwayRegion(
+          GlobeRectangle(
+              farAway.longitude - 0.001,
+              farAway.latitude - 0.001,
+              farAway.longitude + 0.001,
+              farAway.latitude + 0.001),
+          0.0,
+          10.0);
+
+      auto pRootTile = std::make_unique<Tile>(this);
+      pRootTile->setTileID("root");
+      pRootTile->setBoundingVolume(region);
+      pRootTile->setGeometricError(100000000000.0);
+
+      std::vector<Tile> children;
+      for (const TileID& id :
+           {TileID("leaf"),
+            TileID("retryLater"),
+            TileID("external"),
+            TileID(CesiumGeometry::QuadtreeTileID(1, 0, 0))}) {
+        Tile& child = children.emplace_back(this);
+        child.setTileID(id);
+        child.setBoundingVolume(region);
+        child.setContentBoundingVolume(farAwayRegion);
+        child.setGeometricError(0.0);
+      }
+      pRootTile->createChildTiles(std::move(children));
+
+      return pRootTile;
+    }
+
+    virtual CesiumAsync::Future<TileLoadResult>
+    loadTileContent(const TileLoadInput& input) override {
+      TileLoadResult result{};
+      if (input.tile.getTileID() == TileID("external")) {
+        result.contentKind = TileExternalContent();
+      } else {
+        result.contentKind = CesiumGltf::Model();
+      }
+      return input.asyncSystem.createResolvedFuture(std::move(result));
+    }
+
+    virtual TileChildrenResult createTileChildren(const Tile& tile) override {
+      if (tile.getTileID() == TileID("retryLater")) {
+        return TileChildrenResult{{}, TileLoadResultState::RetryLater};
+      }
+      return TileChildrenResult{{}, TileLoadResultState::Failed};
+    }
+  };
+
+  TilesetExternals tilesetExternals{
+      nullptr,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  auto getResult = [](const Tileset& tileset, const TileID& id) {
+    for (const Tile& child : tileset.getRootTile()->getChildren()) {
+      if (child.getTileID() == id) {
+        return child.getLastSelectionState().getResult(
+            child.getLastSelectionState().getFrameNumber());
+      }
+    }
+    FAIL("No child with the ID");
+    return TileSelectionState::Result::None;
+  };
+
+  auto createTileset = [&tilesetExternals](bool enableCulling) {
+    TilesetOptions options;
+    options.enableContentBoundingVolumeCulling = enableCulling;
+    auto pLoader = std::make_unique<LeafContentLoader>();
+    std::unique_ptr<Tile> pRootTile = pLoader->createRootTile();
+    auto pTileset = std::make_unique<Tileset>(
+        tilesetExternals,
+        std::move(pLoader),
+        std::move(pRootTile),
+        options);
+
+    // Load the children, then let the loader say whether they get children.
+    for (int i = 0; i < 4; ++i) {
+      pTileset->updateView({zoomToTileset(*pTileset)});
+    }
+    return pTileset;
+  };
+
+  SECTION("A leaf is culled by its content bounding volume when enabled") {
+    std::unique_ptr<Tileset> pTileset = createTileset(true);
+    CHECK(
+        getResult(*pTileset, TileID("leaf")) ==
+        TileSelectionState::Result::Culled);
+
+    // Tiles that may still get children are culled by their own bounding
+    // volume, which is visible.
+    CHECK(
+        getResult(*pTileset, TileID("retryLater")) !=
+        TileSelectionState::Result::Culled);
+    CHECK(
+        getResult(*pTileset, TileID("external")) !=
+        TileSelectionState::Result::Culled);
+    CHECK(
+        getResult(
+            *pTileset,
+            TileID(CesiumGeometry::QuadtreeTileID(1, 0, 0))) !=
+        TileSelectionState::Result::Culled);
+  }
+
+  SECTION("Content bounding volumes are not used for culling by default") {
+    std::unique_ptr<Tileset> pTileset = createTileset(false);
+    CHECK(
+        getResult(*pTileset, TileID("leaf")) !=
+        TileSelectionState::Result::Culled);
+  }
+}
+
+TEST_CASE("Memory usage counts the content of the loaded tiles") {
+  // A glTF with 900 bytes of geometry, 100 bytes of property table values,
+  // and a decoded image of 64 bytes.
+  class MemoryContentLoader : public TilesetContentLoader {
+  public:
+    std::unique_ptr<Tile> createRootTile() {
+      const Cartographic center = Cartographic::fromDegrees(118.0, 32.0, 0.0);
+      const BoundingRegion region(
+          GlobeRectangle(
+              center.longitude - 0.001,
+              center.latitude - 0.001,
+              center.longitude + 0.001,
+              center.latitude + 0.001),
+          0.0,
+          10.0);
+
+      auto pRootTile = std::make_unique<Tile>(this, TileEmptyContent());
+      pRootTile->setTileID("root");
+      pRootTile->setBoundingVolume(region);
+      pRootTile->setGeometricError(100000000000.0);
+
+      std::vector<Tile> children;
+      Tile& child = children.emplace_back(this);
+      child.setTileID("child");
+      child.setBoundingVolume(region);
+      child.setGeometricError(0.0);
+      pRootTile->createChildTiles(std::move(children));
+
+      return pRootTile;
+    }
+
+    virtual CesiumAsync::Future<TileLoadResult>
+    loadTileContent(const TileLoadInput& input) override {
+      CesiumGltf::Model model;
+
+      CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+      buffer.cesium.data.resize(1000);
+      buffer.byteLength = 1000;
+
+      CesiumGltf::BufferView& geometryView = model.bufferViews.emplace_back();
+      geometryView.buffer = 0;
+      geometryView.byteLength = 900;
+
+      CesiumGltf::BufferView& valuesView = model.bufferViews.emplace_back();
+      valuesView.buffer = 0;
+      valuesView.byteOffset = 900;
+      valuesView.byteLength = 100;
+
+      CesiumGltf::Image& image = model.images.emplace_back();
+      image.cesium.width = 4;
+      image.cesium.height = 4;
+      image.cesium.channels = 4;
+      image.cesium.pixelData.resize(64);
+
+      CesiumGltf::ExtensionModelExtStructuralMetadata& metadata =
+          model.addExtension<CesiumGltf::ExtensionModelExtStructuralMetadata>();
+      CesiumGltf::PropertyTable& propertyTable =
+          metadata.propertyTables.emplace_back();
+      propertyTable.count = 25;
+      propertyTable.properties["value"].values = 1;
+
+      TileLoadResult result{};
+      result.contentKind = std::move(model);
+      return input.asyncSystem.createResolvedFuture(std::move(result));
+    }
+
+    virtual TileChildrenResult createTileChildren(const Tile&) override {
+      return TileChildrenResult{{}, TileLoadResultState::Failed};
+    }
+  };
+
+  TilesetExternals tilesetExternals{
+      nullptr,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.renderTilesUnderCamera = false;
+  auto pLoader = std::make_unique<MemoryContentLoader>();
+  std::unique_ptr<Tile> pRootTile = pLoader->createRootTile();
+  Tileset tileset(
+      tilesetExternals,
+      std::move(pLoader),
+      std::move(pRootTile),
+      options);
+
+  TilesetMemoryUsage usage = tileset.getMemoryUsage();
+  CHECK(usage.geometryBytes == 0);
+  CHECK(usage.textureBytes == 0);
+  CHECK(usage.metadataBytes == 0);
+
+  const ViewState viewState = zoomToTileset(tileset);
+  const Tile& child = tileset.getRootTile()->getChildren()[0];
+  for (int i = 0; i < 10 && child.getState() != TileLoadState::Done; ++i) {
+    tileset.updateView({viewState});
+  }
+  REQUIRE(child.getState() == TileLoadState::Done);
+
+  usage = tileset.getMemoryUsage();
+  CHECK(usage.geometryBytes == 900);
+  CHECK(usage.textureBytes == 64);
+  CHECK(usage.metadataBytes == 100);
+  CHECK(usage.availabilityBytes == 0);
+  CHECK(usage.getTotalBytes() == 1064);
+
+  // Look away from the tileset, so that nothing is rendered, and unload it.
+  const glm::dvec3 position = viewState.getPosition();
+  ViewState lookingAway = ViewState::create(
+      position,
+      glm::normalize(position),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+  const ViewUpdateResult& result = tileset.updateView({lookingAway});
+  REQUIRE(result.tilesToRenderThisFrame.empty());
+
+  tileset.trimMemory(0);
+  REQUIRE(child.getState() == TileLoadState::Unloaded);
+
+  usage = tileset.getMemoryUsage();
+  CHECK(usage.geometryBytes == 0);
+  CHECK(usage.textureBytes == 0);
+  CHECK(usage.metadataBytes == 0);
+}
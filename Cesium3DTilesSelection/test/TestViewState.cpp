@@ -0,0 +1,82 @@
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+
+#include <catch2/catch.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+
+TEST_CASE("ViewState::areBoundingVolumesVisible") {
+  ViewState viewState = ViewState::create(
+      glm::dvec3(0.0, 0.0, 0.0),
+      glm::dvec3(1.0, 0.0, 0.0),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(800.0, 600.0),
+      glm::radians(60.0),
+      glm::radians(45.0));
+
+  // A mix of bounding volumes in front of, beside, and behind the camera, more
+  // than fit in one batch.
+  std::vector<BoundingVolume> boundingVolumes;
+  for (int i = -5; i <= 5; ++i) {
+    const double offset = static_cast<double>(i) * 4.0;
+    boundingVolumes.emplace_back(
+        BoundingSphere(glm::dvec3(10.0, offset, 0.0), 1.0));
+    boundingVolumes.emplace_back(OrientedBoundingBox(
+        glm::dvec3(offset, 10.0, offset),
+        glm::dmat3(2.0)));
+  }
+
+  std::vector<const BoundingVolume*> pointers;
+  for (const BoundingVolume& boundingVolume : boundingVolumes) {
+    pointers.push_back(&boundingVolume);
+  }
+
+  std::vector<bool> expected;
+  for (const BoundingVolume& boundingVolume : boundingVolumes) {
+    expected.push_back(viewState.isBoundingVolumeVisible(boundingVolume));
+  }
+
+  // Make sure the test covers both outcomes.
+  CHECK(std::count(expected.begin(), expected.end(), true) > 0);
+  CHECK(std::count(expected.begin(), expected.end(), false) > 0);
+
+  std::unique_ptr<bool[]> visible(new bool[pointers.size()]);
+  viewState.areBoundingVolumesVisible(
+      pointers,
+      gsl::span<bool>(visible.get(), pointers.size()));
+
+  for (size_t i = 0; i < pointers.size(); ++i) {
+    CHECK(visible[i] == expected[i]);
+  }
+}
+
+TEST_CASE("ViewState::isBoundingVolumeVisible with an enclosing sphere") {
+  ViewState viewState = ViewState::create(
+      glm::dvec3(0.0, 0.0, 0.0),
+      glm::dvec3(1.0, 0.0, 0.0),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(800.0, 600.0),
+      glm::radians(60.0),
+      glm::radians(45.0));
+
+  // Boxes entirely inside, crossing, and entirely outside the frustum.
+  for (int i = -10; i <= 10; ++i) {
+    const double offset = static_cast<double>(i) * 2.0;
+    const BoundingVolume box = OrientedBoundingBox(
+        glm::dvec3(10.0, offset, 0.0),
+        glm::dmat3(
+            glm::dvec3(1.0, 0.0, 0.0),
+            glm::dvec3(1.0, 1.0, 0.0),
+            glm::dvec3(0.0, 0.0, 2.0)));
+    CHECK(
+        viewState.isBoundingVolumeVisible(box, computeEnclosingSphere(box)) ==
+        viewState.isBoundingVolumeVisible(box));
+  }
+}
@@ -2,12 +2,15 @@
 
 #include "Cesium3DTilesWriter/Library.h"
 
+#include <Cesium3DTiles/Subtree.h>
 #include <CesiumJsonWriter/ExtensionWriterContext.h>
 
-// forward declarations
-namespace Cesium3DTiles {
-struct Subtree;
-}
+#include <gsl/span>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
 
 namespace Cesium3DTilesWriter {
 
@@ -40,8 +43,32 @@ struct CESIUM3DTILESWRITER_API SubtreeWriterOptions {
    * @brief If the subtree JSON should be pretty printed.
    */
   bool prettyPrint = false;
+
+  /**
+   * @brief If a binary subtree file should be written rather than only the
+   * subtree JSON.
+   *
+   * The data of the first buffer of the subtree, if it has no URI, is written
+   * to the binary chunk of the file. For a subtree built by a
+   * `SubtreeAvailability`, this holds the availability bitstreams, which are
+   * written directly where they are stored.
+   */
+  bool binary = false;
 };
 
+/**
+ * @brief Receives the bytes of a subtree written by
+ * {@link SubtreeWriter::writeSubtrees}.
+ *
+ * The bytes of the file are the concatenation of the chunks, which are only
+ * valid during the call, because the memory they are in is reused for the
+ * next subtree. The sink is called concurrently from several threads, once
+ * for each subtree, with the index of the subtree.
+ */
+using SubtreeSink = std::function<void(
+    size_t index,
+    const gsl::span<const gsl::span<const std::byte>>& chunks)>;
+
 /**
  * @brief Writes subtrees.
  */
@@ -74,6 +101,29 @@ public:
       const Cesium3DTiles::Subtree& subtree,
       const SubtreeWriterOptions& options = SubtreeWriterOptions()) const;
 
+  /**
+   * @brief Serializes many subtrees concurrently, passing each to a sink
+   * rather than returning it.
+   *
+   * Each thread reuses the memory it writes a subtree into for the next one,
+   * so writing many subtrees does not allocate memory for each of them.
+   *
+   * @param subtrees The subtrees.
+   * @param sink The sink that receives the bytes of each subtree. Subtrees
+   * that cannot be written are not passed to it. If it throws, the remaining
+   * subtrees are not written, and the exception is rethrown.
+   * @param options Options for how to write the subtrees.
+   * @param threadCount The number of threads to write on, including the
+   * calling thread, or zero for one per hardware thread.
+   * @return The errors that occurred, each starting with the index of the
+   * subtree it is about.
+   */
+  std::vector<std::string> writeSubtrees(
+      const gsl::span<const Cesium3DTiles::Subtree>& subtrees,
+      const SubtreeSink& sink,
+      const SubtreeWriterOptions& options = SubtreeWriterOptions(),
+      size_t threadCount = 0) const;
+
 private:
   CesiumJsonWriter::ExtensionWriterContext _context;
 };
@@ -2,12 +2,13 @@
 
 #include "Cesium3DTilesWriter/Library.h"
 
+#include <Cesium3DTiles/Tileset.h>
 #include <CesiumJsonWriter/ExtensionWriterContext.h>
 
-// forward declarations
-namespace Cesium3DTiles {
-struct Tileset;
-}
+#include <gsl/span>
+
+#include <cstddef>
+#include <functional>
 
 namespace Cesium3DTilesWriter {
 
@@ -42,6 +43,17 @@ struct CESIUM3DTILESWRITER_API TilesetWriterOptions {
   bool prettyPrint = false;
 };
 
+/**
+ * @brief Receives the JSON of a tileset written by
+ * {@link TilesetWriter::writeTilesets}.
+ *
+ * The bytes are only valid during the call, because the memory they are in is
+ * reused for the next tileset. The sink is called concurrently from several
+ * threads, once for each tileset, with the index of the tileset.
+ */
+using TilesetSink = std::function<
+    void(size_t index, const gsl::span<const std::byte>& tilesetBytes)>;
+
 /**
  * @brief Writes tilesets.
  */
@@ -74,6 +86,26 @@ public:
       const Cesium3DTiles::Tileset& tileset,
       const TilesetWriterOptions& options = TilesetWriterOptions()) const;
 
+  /**
+   * @brief Serializes many tilesets concurrently, passing each to a sink
+   * rather than returning it.
+   *
+   * Each thread reuses the memory it writes a tileset into for the next one,
+   * so writing many tilesets does not allocate memory for each of them.
+   *
+   * @param tilesets The tilesets.
+   * @param sink The sink that receives the JSON of each tileset. If it throws,
+   * the remaining tilesets are not written, and the exception is rethrown.
+   * @param options Options for how to write the tilesets.
+   * @param threadCount The number of threads to write on, including the
+   * calling thread, or zero for one per hardware thread.
+   */
+  void writeTilesets(
+      const gsl::span<const Cesium3DTiles::Tileset>& tilesets,
+      const TilesetSink& sink,
+      const TilesetWriterOptions& options = TilesetWriterOptions(),
+      size_t threadCount = 0) const;
+
 private:
   CesiumJsonWriter::ExtensionWriterContext _context;
 };
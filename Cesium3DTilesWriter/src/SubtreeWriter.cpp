@@ -2,13 +2,98 @@
 
 #include "TilesetJsonWriter.h"
 #include "registerExtensions.h"
+#include "writeInParallel.h"
 
 #include <CesiumJsonWriter/JsonWriter.h>
 #include <CesiumJsonWriter/PrettyJsonWriter.h>
 #include <CesiumUtility/Tracing.h>
 
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+
 namespace Cesium3DTilesWriter {
 
+namespace {
+struct SubtreeHeader {
+  unsigned char magic[4];
+  uint32_t version;
+  uint64_t jsonByteLength;
+  uint64_t binaryByteLength;
+};
+
+// The chunks of a binary subtree are padded to 8 bytes, the JSON with
+// spaces and the binary data with zeros.
+const std::array<std::byte, 8> jsonPadding{
+    std::byte(' '),
+    std::byte(' '),
+    std::byte(' '),
+    std::byte(' '),
+    std::byte(' '),
+    std::byte(' '),
+    std::byte(' '),
+    std::byte(' ')};
+const std::array<std::byte, 8> binaryPadding{};
+
+size_t getPadding(size_t byteLength) noexcept {
+  return (8 - byteLength % 8) % 8;
+}
+
+// Finds the chunks that make up a subtree file with the given JSON, pointing
+// them at the header, the JSON, and the data of the subtree's buffer, so that
+// none of them are copied.
+bool getChunks(
+    const Cesium3DTiles::Subtree& subtree,
+    const std::string_view& json,
+    bool binary,
+    SubtreeHeader& header,
+    std::vector<gsl::span<const std::byte>>& chunks,
+    std::string& error) {
+  chunks.clear();
+  const gsl::span<const std::byte> jsonBytes(
+      reinterpret_cast<const std::byte*>(json.data()),
+      json.size());
+  if (!binary) {
+    chunks.emplace_back(jsonBytes);
+    return true;
+  }
+
+  gsl::span<const std::byte> binaryBytes;
+  if (!subtree.buffers.empty() && !subtree.buffers[0].uri) {
+    const Cesium3DTiles::Buffer& buffer = subtree.buffers[0];
+    if (buffer.byteLength < 0 ||
+        size_t(buffer.byteLength) > buffer.cesium.data.size()) {
+      error = "The first buffer of the subtree has no uri, but has " +
+              std::to_string(buffer.cesium.data.size()) + " of its " +
+              std::to_string(buffer.byteLength) + " bytes.";
+      return false;
+    }
+    binaryBytes = gsl::span<const std::byte>(buffer.cesium.data)
+                      .first(size_t(buffer.byteLength));
+  }
+
+  const size_t jsonPaddingLength = getPadding(jsonBytes.size());
+  const size_t binaryPaddingLength = getPadding(binaryBytes.size());
+  header = SubtreeHeader{
+      {'s', 'u', 'b', 't'},
+      1,
+      uint64_t(jsonBytes.size() + jsonPaddingLength),
+      uint64_t(binaryBytes.size() + binaryPaddingLength)};
+
+  chunks.emplace_back(
+      reinterpret_cast<const std::byte*>(&header),
+      sizeof(SubtreeHeader));
+  chunks.emplace_back(jsonBytes);
+  chunks.emplace_back(jsonPadding.data(), jsonPaddingLength);
+  if (!binaryBytes.empty()) {
+    chunks.emplace_back(binaryBytes);
+    chunks.emplace_back(binaryPadding.data(), binaryPaddingLength);
+  }
+  return true;
+}
+} // namespace
+
 SubtreeWriter::SubtreeWriter() { registerExtensions(this->_context); }
 
 CesiumJsonWriter::ExtensionWriterContext& SubtreeWriter::getExtensions() {
@@ -38,8 +123,79 @@ SubtreeWriterResult SubtreeWriter::writeSubtree(
   }
 
   SubtreeJsonWriter::write(subtree, *writer, context);
-  result.subtreeBytes = writer->toBytes();
+  if (!options.binary) {
+    result.subtreeBytes = writer->toBytes();
+    return result;
+  }
+
+  SubtreeHeader header;
+  std::vector<gsl::span<const std::byte>> chunks;
+  std::string error;
+  if (!getChunks(
+          subtree,
+          writer->toStringView(),
+          true,
+          header,
+          chunks,
+          error)) {
+    result.errors.emplace_back(std::move(error));
+    return result;
+  }
+
+  for (const gsl::span<const std::byte>& chunk : chunks) {
+    result.subtreeBytes.insert(
+        result.subtreeBytes.end(),
+        chunk.begin(),
+        chunk.end());
+  }
 
   return result;
 }
+
+std::vector<std::string> SubtreeWriter::writeSubtrees(
+    const gsl::span<const Cesium3DTiles::Subtree>& subtrees,
+    const SubtreeSink& sink,
+    const SubtreeWriterOptions& options,
+    size_t threadCount) const {
+  CESIUM_TRACE("SubtreeWriter::writeSubtrees");
+
+  const CesiumJsonWriter::ExtensionWriterContext& context =
+      this->getExtensions();
+
+  std::mutex mutex;
+  std::vector<std::string> errors;
+
+  writeInParallel(
+      subtrees.size(),
+      options.prettyPrint,
+      threadCount,
+      [&subtrees, &sink, &options, &context, &mutex, &errors](
+          size_t index,
+          CesiumJsonWriter::JsonWriter& writer) {
+        // Each thread reuses its chunks from one subtree to the next.
+        thread_local std::vector<gsl::span<const std::byte>> chunks;
+
+        const Cesium3DTiles::Subtree& subtree = subtrees[index];
+        SubtreeJsonWriter::write(subtree, writer, context);
+
+        SubtreeHeader header;
+        std::string error;
+        if (!getChunks(
+                subtree,
+                writer.toStringView(),
+                options.binary,
+                header,
+                chunks,
+                error)) {
+          std::lock_guard<std::mutex> lock(mutex);
+          errors.emplace_back(
+              "Subtree " + std::to_string(index) + ": " + error);
+          return;
+        }
+
+        sink(index, chunks);
+      });
+
+  return errors;
+}
 } // namespace Cesium3DTilesWriter
@@ -2,6 +2,7 @@
 
 #include "TilesetJsonWriter.h"
 #include "registerExtensions.h"
+#include "writeInParallel.h"
 
 #include <CesiumJsonWriter/JsonWriter.h>
 #include <CesiumJsonWriter/PrettyJsonWriter.h>
@@ -42,4 +43,31 @@ TilesetWriterResult TilesetWriter::writeTileset(
 
   return result;
 }
+
+void TilesetWriter::writeTilesets(
+    const gsl::span<const Cesium3DTiles::Tileset>& tilesets,
+    const TilesetSink& sink,
+    const TilesetWriterOptions& options,
+    size_t threadCount) const {
+  CESIUM_TRACE("TilesetWriter::writeTilesets");
+
+  const CesiumJsonWriter::ExtensionWriterContext& context =
+      this->getExtensions();
+
+  writeInParallel(
+      tilesets.size(),
+      options.prettyPrint,
+      threadCount,
+      [&tilesets, &sink, &context](
+          size_t index,
+          CesiumJsonWriter::JsonWriter& writer) {
+        TilesetJsonWriter::write(tilesets[index], writer, context);
+        const std::string_view json = writer.toStringView();
+        sink(
+            index,
+            gsl::span<const std::byte>(
+                reinterpret_cast<const std::byte*>(json.data()),
+                json.size()));
+      });
+}
 } // namespace Cesium3DTilesWriter
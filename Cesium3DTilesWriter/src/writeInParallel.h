@@ -0,0 +1,83 @@
+#pragma once
+
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Cesium3DTilesWriter {
+
+/**
+ * @brief Calls `write(index, writer)` for each of `count` items, on up to
+ * `threadCount` threads including the calling one, or on one thread per
+ * hardware thread if `threadCount` is zero.
+ *
+ * Each thread writes all of its items with one JSON writer, which is cleared
+ * before each item, so that its memory is reused. If `write` throws, no
+ * more items are started, and the exception is rethrown once every thread
+ * has finished.
+ */
+template <typename Write>
+void writeInParallel(
+    size_t count,
+    bool prettyPrint,
+    size_t threadCount,
+    Write&& write) {
+  if (count == 0) {
+    return;
+  }
+  if (threadCount == 0) {
+    threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  threadCount = std::min(threadCount, count);
+
+  std::atomic<size_t> next(0);
+  std::atomic<bool> failed(false);
+  std::mutex mutex;
+  std::exception_ptr pException;
+
+  const auto run = [&]() {
+    std::unique_ptr<CesiumJsonWriter::JsonWriter> pWriter;
+    if (prettyPrint) {
+      pWriter = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
+    } else {
+      pWriter = std::make_unique<CesiumJsonWriter::JsonWriter>();
+    }
+
+    try {
+      for (size_t i = next++; i < count && !failed; i = next++) {
+        pWriter->clear();
+        write(i, *pWriter);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!pException) {
+        pException = std::current_exception();
+      }
+      failed = true;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount - 1);
+  for (size_t i = 1; i < threadCount; ++i) {
+    threads.emplace_back(run);
+  }
+  run();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  if (pException) {
+    std::rethrow_exception(pException);
+  }
+}
+
+} // namespace Cesium3DTilesWriter
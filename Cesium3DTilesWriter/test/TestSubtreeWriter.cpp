@@ -0,0 +1,136 @@
+#include "Cesium3DTilesWriter/SubtreeWriter.h"
+
+#include <Cesium3DTiles/Subtree.h>
+#include <Cesium3DTilesReader/SubtreeReader.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTiles;
+using namespace Cesium3DTilesWriter;
+
+namespace {
+// A subtree whose tile availability is a bitstream in its binary chunk.
+Subtree createSubtree(size_t byteLength) {
+  Subtree subtree;
+  Buffer& buffer = subtree.buffers.emplace_back();
+  buffer.byteLength = int64_t(byteLength);
+  for (size_t i = 0; i < byteLength; ++i) {
+    buffer.cesium.data.emplace_back(std::byte(i + 1));
+  }
+
+  BufferView& bufferView = subtree.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteLength = int64_t(byteLength);
+
+  subtree.tileAvailability.bitstream = 0;
+  subtree.childSubtreeAvailability.constant = 0;
+  return subtree;
+}
+
+template <typename T>
+T readValue(const std::vector<std::byte>& bytes, size_t offset) {
+  T value;
+  std::memcpy(&value, bytes.data() + offset, sizeof(T));
+  return value;
+}
+} // namespace
+
+TEST_CASE("SubtreeWriter") {
+  SubtreeWriter writer;
+
+  SECTION("writes binary subtrees with padded chunks") {
+    SubtreeWriterOptions options;
+    options.binary = true;
+    SubtreeWriterResult result = writer.writeSubtree(createSubtree(5), options);
+    REQUIRE(result.errors.empty());
+
+    const std::vector<std::byte>& bytes = result.subtreeBytes;
+    REQUIRE(bytes.size() >= 24);
+    CHECK(std::memcmp(bytes.data(), "subt", 4) == 0);
+    CHECK(readValue<uint32_t>(bytes, 4) == 1);
+    const uint64_t jsonByteLength = readValue<uint64_t>(bytes, 8);
+    const uint64_t binaryByteLength = readValue<uint64_t>(bytes, 16);
+    CHECK(jsonByteLength % 8 == 0);
+    CHECK(binaryByteLength == 8);
+    REQUIRE(bytes.size() == 24 + jsonByteLength + binaryByteLength);
+
+    Cesium3DTilesReader::SubtreeReader reader;
+    auto readResult = reader.readFromJson(
+        gsl::span(bytes).subspan(24, size_t(jsonByteLength)));
+    REQUIRE(readResult.value);
+    CHECK(readResult.value->buffers.size() == 1);
+    CHECK(readResult.value->tileAvailability.bitstream == 0);
+
+    const size_t binaryOffset = size_t(24 + jsonByteLength);
+    for (size_t i = 0; i < 8; ++i) {
+      CHECK(bytes[binaryOffset + i] == std::byte(i < 5 ? i + 1 : 0));
+    }
+  }
+
+  SECTION("reports a binary chunk without its data") {
+    SubtreeWriterOptions options;
+    options.binary = true;
+    Subtree subtree = createSubtree(5);
+    subtree.buffers[0].cesium.data.resize(2);
+    SubtreeWriterResult result = writer.writeSubtree(subtree, options);
+    CHECK(!result.errors.empty());
+    CHECK(result.subtreeBytes.empty());
+  }
+
+  SECTION("writes many subtrees concurrently") {
+    std::vector<Subtree> subtrees;
+    for (size_t i = 0; i < 50; ++i) {
+      subtrees.emplace_back(createSubtree(i % 9));
+    }
+
+    SubtreeWriterOptions options;
+    options.binary = true;
+    std::mutex mutex;
+    std::vector<std::vector<std::byte>> written(subtrees.size());
+    std::vector<std::string> errors = writer.writeSubtrees(
+        subtrees,
+        [&mutex, &written](
+            size_t index,
+            const gsl::span<const gsl::span<const std::byte>>& chunks) {
+          std::lock_guard<std::mutex> lock(mutex);
+          for (const gsl::span<const std::byte>& chunk : chunks) {
+            written[index].insert(
+                written[index].end(),
+                chunk.begin(),
+                chunk.end());
+          }
+        },
+        options,
+        4);
+    CHECK(errors.empty());
+
+    for (size_t i = 0; i < subtrees.size(); ++i) {
+      CHECK(
+          written[i] == writer.writeSubtree(subtrees[i], options).subtreeBytes);
+    }
+  }
+
+  SECTION("reports the subtrees that cannot be written") {
+    std::vector<Subtree> subtrees{createSubtree(1), createSubtree(1)};
+    subtrees[1].buffers[0].cesium.data.clear();
+
+    SubtreeWriterOptions options;
+    options.binary = true;
+    std::vector<size_t> written;
+    std::vector<std::string> errors = writer.writeSubtrees(
+        subtrees,
+        [&written](size_t index, const auto&) { written.push_back(index); },
+        options,
+        1);
+    CHECK(written == std::vector<size_t>{0});
+    REQUIRE(errors.size() == 1);
+    CHECK(errors[0].rfind("Subtree 1: ", 0) == 0);
+  }
+}
@@ -7,6 +7,8 @@
 #include <rapidjson/document.h>
 
 #include <cctype>
+#include <mutex>
+#include <vector>
 
 namespace {
 void check(const std::string& input, const std::string& expectedOutput) {
@@ -266,3 +268,33 @@ TEST_CASE("Writes tileset with prettyPrint") {
 
   REQUIRE(hasSpaces(tilesetStringPretty));
 }
+
+TEST_CASE("Writes many tilesets concurrently") {
+  std::vector<Cesium3DTiles::Tileset> tilesets(20);
+  for (size_t i = 0; i < tilesets.size(); ++i) {
+    tilesets[i].asset.version = "1.1";
+    tilesets[i].geometricError = double(i);
+  }
+
+  Cesium3DTilesWriter::TilesetWriter writer;
+  Cesium3DTilesWriter::TilesetWriterOptions options;
+  options.prettyPrint = true;
+
+  std::mutex mutex;
+  std::vector<std::vector<std::byte>> written(tilesets.size());
+  writer.writeTilesets(
+      tilesets,
+      [&mutex, &written](
+          size_t index,
+          const gsl::span<const std::byte>& tilesetBytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        written[index].assign(tilesetBytes.begin(), tilesetBytes.end());
+      },
+      options,
+      3);
+
+  for (size_t i = 0; i < tilesets.size(); ++i) {
+    CHECK(
+        written[i] == writer.writeTileset(tilesets[i], options).tilesetBytes);
+  }
+}
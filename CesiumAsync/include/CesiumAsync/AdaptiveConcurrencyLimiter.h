@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Library.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace CesiumAsync {
+
+/**
+ * @brief Options for an {@link AdaptiveConcurrencyLimiter}.
+ */
+struct CESIUMASYNC_API AdaptiveConcurrencyLimiterOptions {
+  /**
+   * @brief The limit before any requests have completed.
+   */
+  int32_t initialLimit = 20;
+
+  /**
+   * @brief The smallest limit.
+   */
+  int32_t minimumLimit = 4;
+
+  /**
+   * @brief The largest limit.
+   */
+  int32_t maximumLimit = 128;
+
+  /**
+   * @brief The factor by which the limit is multiplied when requests fail or
+   * their latency is inflated.
+   */
+  double decreaseFactor = 0.7;
+
+  /**
+   * @brief How many times the baseline latency the smoothed latency of the
+   * requests may be before it counts as inflated.
+   *
+   * The baseline is the shortest latency seen recently. Once more requests
+   * are in flight than the network or server can serve at once, the extra
+   * requests wait in a queue, so their latency grows without any gain in
+   * throughput.
+   */
+  double latencyInflationThreshold = 2.0;
+
+  /**
+   * @brief The weight of each new latency in the smoothed latency, between 0
+   * and 1.
+   */
+  double latencySmoothing = 0.1;
+};
+
+/**
+ * @brief Adjusts the number of requests that may be in flight at once from
+ * their observed latency, throughput, and failures.
+ *
+ * The limit follows additive increase, multiplicative decrease (AIMD), like
+ * TCP congestion control: every {@link getLimit} requests that complete
+ * without inflated latency raise it by one, while a failed request or
+ * inflated latency multiplies it by
+ * {@link AdaptiveConcurrencyLimiterOptions::decreaseFactor}. After a
+ * decrease, the limit is not decreased again until as many requests as the
+ * new limit have completed, since the requests that were already in flight
+ * still reflect the old limit.
+ *
+ * The code that starts the requests asks for {@link getLimit} instead of
+ * using a fixed limit, and tells the limiter about each request with
+ * {@link recordCompletion} when it completes. A limiter may be shared by
+ * requests to the same servers, such as those of several tilesets. All of its
+ * methods may be called from any thread.
+ */
+class CESIUMASYNC_API AdaptiveConcurrencyLimiter {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param options The options.
+   */
+  explicit AdaptiveConcurrencyLimiter(
+      const AdaptiveConcurrencyLimiterOptions& options = {}) noexcept;
+
+  /**
+   * @brief Gets the options.
+   */
+  const AdaptiveConcurrencyLimiterOptions& getOptions() const noexcept {
+    return this->_options;
+  }
+
+  /**
+   * @brief Gets the number of requests that may currently be in flight.
+   */
+  int32_t getLimit() const noexcept;
+
+  /**
+   * @brief Tells the limiter that a request completed.
+   *
+   * Requests that were canceled should not be recorded, since their latency
+   * says nothing about the network.
+   *
+   * @param latencySeconds The time from starting the request to its
+   * completion, in seconds.
+   * @param bytes The number of bytes that were received.
+   * @param succeeded Whether the request succeeded. A failure, such as a
+   * network error or a server that is overloaded, decreases the limit.
+   */
+  void recordCompletion(
+      double latencySeconds,
+      int64_t bytes,
+      bool succeeded) noexcept;
+
+  /**
+   * @brief Gets the smoothed latency of the requests that succeeded, in
+   * seconds, or zero if none have.
+   */
+  double getSmoothedLatency() const noexcept;
+
+  /**
+   * @brief Gets the shortest latency of the requests that succeeded recently,
+   * in seconds, or zero if none have.
+   */
+  double getBaselineLatency() const noexcept;
+
+  /**
+   * @brief Gets the rate at which bytes were received by the requests that
+   * completed over about the last second, in bytes per second.
+   */
+  double getBytesPerSecond() const noexcept;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  void decrease() noexcept;
+  void updateThroughput(int64_t bytes) noexcept;
+
+  AdaptiveConcurrencyLimiterOptions _options;
+  mutable std::mutex _mutex;
+  double _limit;
+  double _smoothedLatency;
+  double _baselineLatency;
+  int32_t _completionsSinceDecrease;
+  int64_t _throughputBytes;
+  Clock::time_point _throughputStart;
+  double _bytesPerSecond;
+};
+
+} // namespace CesiumAsync
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "IAssetAccessor.h"
+#include "IAssetRequest.h"
+#include "Library.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class AsyncSystem;
+
+/**
+ * @brief A decorator for an {@link IAssetAccessor} that reads the files of a
+ * tileset that is packed into a single zip archive, such as a `.3tz` file, so
+ * that the tileset can be hosted as one object.
+ *
+ * A file in an archive is addressed by appending its path in the archive to
+ * the URL of the archive, as in `https://example.com/city.3tz/tileset.json`,
+ * so that the relative URLs in the tileset resolve to other files in the same
+ * archive. The query parameters of the URL are sent with the requests for the
+ * archive.
+ *
+ * The central directory of an archive is read once, with HTTP range requests
+ * for the end of the archive and for the directory itself, and then each file
+ * is read with a range request for just its bytes. Archives with a `file://`
+ * URL are mapped into memory instead, so their files are read without being
+ * copied unless they are compressed. When a server ignores range requests and
+ * sends the whole archive, the archive is kept in memory and its files are
+ * read from there. Files that are stored or compressed with deflate can be
+ * read.
+ *
+ * Requests for files that are not in an archive, and requests with verbs
+ * other than `GET`, are passed to the underlying accessor unchanged. The
+ * response for a file that is not in its archive has the status code 404,
+ * and the response for a file whose archive could not be read has the status
+ * code of the failed request for the archive.
+ */
+class CESIUMASYNC_API ArchiveAssetAccessor : public IAssetAccessor {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pAssetAccessor The underlying {@link IAssetAccessor} that requests
+   * the archives, and the assets that are not in an archive.
+   * @param archiveExtensions The extensions of the files that are archives,
+   * which are matched against a URL's path case-insensitively.
+   */
+  ArchiveAssetAccessor(
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+      const std::vector<std::string>& archiveExtensions = {".3tz"});
+
+  virtual ~ArchiveAssetAccessor() noexcept override;
+
+  /** @copydoc IAssetAccessor::get */
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  /** @copydoc IAssetAccessor::request */
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /** @copydoc IAssetAccessor::tick */
+  virtual void tick() noexcept override;
+
+private:
+  struct Archives;
+
+  std::shared_ptr<IAssetAccessor> _pAssetAccessor;
+  std::vector<std::string> _archiveExtensions;
+  std::shared_ptr<Archives> _pArchives;
+};
+} // namespace CesiumAsync
@@ -11,13 +11,40 @@
 
 #include <CesiumUtility/Tracing.h>
 
+#include <cstddef>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 
 namespace CesiumAsync {
 class ITaskProcessor;
 
 class AsyncSystem;
 
+/**
+ * @brief The result of {@link AsyncSystem::dispatchMainThreadTasks} with a
+ * time budget.
+ */
+struct MainThreadDispatchResult {
+  /**
+   * @brief The number of tasks that were run.
+   */
+  size_t tasksDispatched = 0;
+
+  /**
+   * @brief The number of tasks that are still queued for the main thread,
+   * including the ones that were queued by the tasks that were run.
+   */
+  size_t tasksRemaining = 0;
+
+  /**
+   * @brief The time spent running the tasks, in milliseconds.
+   */
+  double elapsedMilliseconds = 0.0;
+};
+
 /**
  * @brief A system for managing asynchronous requests and tasks.
  *
@@ -126,6 +153,45 @@ public:
                 std::forward<Func>(f))));
   }
 
+  /**
+   * @brief Runs a function in a worker thread, returning a Future that
+   * resolves when the function completes, with a hint of how soon the
+   * function should run relative to other tasks.
+   *
+   * Unlike the overload without a priority, the function is always started
+   * with {@link ITaskProcessor::startTaskWithPriority}, even if this method
+   * is called from a worker thread, so that more important tasks can run
+   * first.
+   *
+   * If the function itself returns a `Future`, the function will not be
+   * considered complete until that returned `Future` also resolves.
+   *
+   * @tparam Func The type of the function.
+   * @param f The function.
+   * @param priority How soon the function should run, relative to other
+   * tasks.
+   * @return A future that resolves after the supplied function completes.
+   */
+  template <typename Func>
+  CesiumImpl::ContinuationFutureType_t<Func, void>
+  runInWorkerThread(Func&& f, const TaskPriority& priority) const {
+    static const char* tracingName = "waiting for worker thread";
+
+    CESIUM_TRACE_BEGIN_IN_TRACK(tracingName);
+
+    // The task is scheduled right away, while this scheduler still exists.
+    CesiumImpl::PrioritizedTaskScheduler scheduler(
+        this->_pSchedulers->workerThread,
+        priority);
+    return CesiumImpl::ContinuationFutureType_t<Func, void>(
+        this->_pSchedulers,
+        async::spawn(
+            scheduler,
+            CesiumImpl::WithTracing<void>::end(
+                tracingName,
+                std::forward<Func>(f))));
+  }
+
   /**
    * @brief Runs a function in the main thread, returning a Future that
    * resolves when the function completes.
@@ -227,6 +293,97 @@ public:
         std::forward<std::vector<SharedFuture<T>>>(futures));
   }
 
+  /**
+   * @brief Invokes a function with the value of each Future in a vector as
+   * soon as that Future resolves, in the order in which they resolve.
+   *
+   * Unlike {@link all}, which makes no value available until the slowest
+   * Future resolves, this lets work on each value start as soon as it is
+   * ready. Each value is moved into the function rather than copied.
+   *
+   * The function is invoked in whichever thread resolves each Future, as by
+   * {@link Future::thenImmediately}, so it should be quick and thread-safe.
+   * It is never invoked by two threads at the same time, though.
+   *
+   * The function is not invoked for Futures that reject. Once every Future
+   * has resolved or rejected, the returned Future resolves, or rejects with
+   * the first exception from a Future in the vector or from the function.
+   *
+   * @tparam T The type that each Future resolves to.
+   * @tparam Func The type of the function, which is invoked as
+   * `f(index, std::move(value))`, where `index` is the position in the vector
+   * of the Future that resolved to `value`, or as `f(index)` if `T` is
+   * `void`.
+   * @param futures The list of futures.
+   * @param f The function to invoke with each value.
+   * @return A Future that resolves when the function has been invoked for
+   * every Future in the vector, and rejects when any of them rejects.
+   */
+  template <typename T, typename Func>
+  Future<void>
+  forEachAsCompleted(std::vector<Future<T>>&& futures, Func&& f) const {
+    Promise<void> promise = this->createPromise<void>();
+    Future<void> result = promise.getFuture();
+    if (futures.empty()) {
+      promise.resolve();
+      return result;
+    }
+
+    struct State {
+      State(Func&& f_, size_t remaining_, const Promise<void>& promise_)
+          : f(std::forward<Func>(f_)),
+            remaining(remaining_),
+            promise(promise_) {}
+
+      std::mutex mutex;
+      std::decay_t<Func> f;
+      size_t remaining;
+      std::exception_ptr pException;
+      Promise<void> promise;
+    };
+
+    auto pState = std::make_shared<State>(
+        std::forward<Func>(f),
+        futures.size(),
+        promise);
+
+    for (size_t i = 0; i < futures.size(); ++i) {
+      // The continuation is kept alive by the task it is attached to.
+      std::move(futures[i]._task)
+          .then(async::inline_scheduler(), [pState, i](async::task<T>&& task) {
+            std::unique_lock lock(pState->mutex);
+            try {
+              if constexpr (std::is_void_v<T>) {
+                task.get();
+                pState->f(i);
+              } else {
+                pState->f(i, task.get());
+              }
+            } catch (...) {
+              if (!pState->pException) {
+                pState->pException = std::current_exception();
+              }
+            }
+
+            if (--pState->remaining > 0) {
+              return;
+            }
+
+            // Settle the promise outside the lock, because that runs the
+            // continuations attached to the returned Future.
+            lock.unlock();
+            if (pState->pException) {
+              pState->promise.reject(pState->pException);
+            } else {
+              pState->promise.resolve();
+            }
+          });
+    }
+
+    futures.clear();
+    return result;
+  }
+
   /**
    * @brief Creates a future that is already resolved.
    *
@@ -268,13 +425,40 @@ public:
    */
   bool dispatchOneMainThreadTask();
 
+  /**
+   * @brief Runs the tasks that are queued for the main thread, in the order in
+   * which they were queued, until the time budget is used up or there are no
+   * more tasks.
+   *
+   * At least one task is run if any are queued, however small the budget.
+   * A task that is running when the budget is used up is not interrupted, so
+   * the time spent can exceed the budget by the length of the last task.
+   * Tasks that are not run stay queued for the next dispatch.
+   *
+   * The tasks are run in the calling thread.
+   *
+   * @param budgetMilliseconds The time budget, in milliseconds.
+   * @return The number of tasks run and still queued, and the time spent.
+   */
+  MainThreadDispatchResult dispatchMainThreadTasks(double budgetMilliseconds);
+
+  /**
+   * @brief Gets the number of tasks that are currently queued for the main
+   * thread.
+   */
+  size_t getMainThreadTaskCount() const noexcept;
+
   /**
    * @brief Creates a new thread pool that can be used to run continuations.
    *
    * @param numberOfThreads The number of threads in the pool.
+   * @param options The options for the threads of the pool, like their name
+   * and how the operating system should schedule them.
    * @return The thread pool.
    */
-  ThreadPool createThreadPool(int32_t numberOfThreads) const;
+  ThreadPool createThreadPool(
+      int32_t numberOfThreads,
+      const ThreadPoolOptions& options = {}) const;
 
   /**
    * Returns true if this instance and the right-hand side can be used
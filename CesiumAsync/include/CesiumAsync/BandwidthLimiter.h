@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Library.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace CesiumAsync {
+
+/**
+ * @brief A token bucket that limits the rate at which bytes are downloaded.
+ *
+ * The bucket holds up to {@link getBurstBytes} bytes, and is refilled at
+ * {@link getBytesPerSecond}. Downloaded bytes are taken from it with
+ * {@link consume}. Because the size of a response is not known until it has
+ * been received, the bytes are taken after the fact, and the bucket may go
+ * into debt, which is repaid by the refill before the bucket has bytes to
+ * spend again. So a limiter does not delay requests itself; the code that
+ * starts the requests asks {@link isExhausted} and holds back new requests
+ * while it is.
+ *
+ * A single limiter can be shared by several tilesets and raster overlays, and
+ * by a {@link BandwidthLimitingAssetAccessor}, to cap their combined rate. All
+ * of its methods may be called from any thread.
+ */
+class CESIUMASYNC_API BandwidthLimiter {
+public:
+  /**
+   * @brief Constructs a new instance, with a full bucket.
+   *
+   * @param bytesPerSecond The rate at which the bucket is refilled, in bytes
+   * per second.
+   * @param burstBytes The size of the bucket, which is the number of bytes
+   * that may be downloaded at once after the downloads have been idle.
+   */
+  BandwidthLimiter(double bytesPerSecond, int64_t burstBytes) noexcept;
+
+  /**
+   * @brief Gets the rate at which the bucket is refilled, in bytes per
+   * second.
+   */
+  double getBytesPerSecond() const noexcept;
+
+  /**
+   * @brief Sets the rate at which the bucket is refilled, in bytes per
+   * second.
+   *
+   * The bytes that were refilled at the previous rate are kept.
+   */
+  void setBytesPerSecond(double bytesPerSecond) noexcept;
+
+  /**
+   * @brief Gets the size of the bucket, in bytes.
+   */
+  int64_t getBurstBytes() const noexcept;
+
+  /**
+   * @brief Sets the size of the bucket, in bytes.
+   *
+   * If the bucket holds more bytes than the new size, the excess is dropped.
+   */
+  void setBurstBytes(int64_t burstBytes) noexcept;
+
+  /**
+   * @brief Takes bytes that were downloaded from the bucket.
+   *
+   * The bucket goes into debt if it holds fewer bytes than this.
+   *
+   * @param bytes The number of bytes.
+   */
+  void consume(int64_t bytes) noexcept;
+
+  /**
+   * @brief Gets the number of bytes in the bucket.
+   *
+   * This is negative while the bucket is in debt.
+   */
+  int64_t getAvailableBytes() const noexcept;
+
+  /**
+   * @brief Determines whether the bucket is empty or in debt, so that no new
+   * downloads should be started.
+   */
+  bool isExhausted() const noexcept;
+
+  /**
+   * @brief Determines whether the bucket is full.
+   */
+  bool isFull() const noexcept;
+
+  /**
+   * @brief Gets the total number of bytes that were taken from the bucket.
+   */
+  int64_t getTotalConsumedBytes() const noexcept;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  void refill() const noexcept;
+
+  mutable std::mutex _mutex;
+  double _bytesPerSecond;
+  int64_t _burstBytes;
+  mutable double _availableBytes;
+  mutable Clock::time_point _lastRefill;
+  int64_t _totalConsumedBytes;
+};
+
+} // namespace CesiumAsync
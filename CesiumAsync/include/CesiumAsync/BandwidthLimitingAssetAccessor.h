@@ -0,0 +1,81 @@
+#pragma once
+
+#include "IAssetAccessor.h"
+#include "IAssetRequest.h"
+#include "Library.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class AsyncSystem;
+class BandwidthLimiter;
+
+/**
+ * @brief A decorator for an {@link IAssetAccessor} that takes the bytes of
+ * every response from a {@link BandwidthLimiter}.
+ *
+ * This accessor does not delay requests. It only accounts for the bytes that
+ * were downloaded, so that whoever starts the requests, such as a tileset or a
+ * raster overlay that shares the same limiter, can hold back new requests
+ * while the limiter is exhausted.
+ * Because tiles, subtrees and raster overlay images are all requested through
+ * the tileset's accessor, decorating it accounts for all of them.
+ *
+ * The data of a streamed response is taken from the limiter as it arrives,
+ * and the data of any other response when the response is complete. To only
+ * account for the bytes that came over the network, use this accessor as the
+ * underlying accessor of a {@link CachingAssetAccessor}.
+ */
+class CESIUMASYNC_API BandwidthLimitingAssetAccessor : public IAssetAccessor {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pAssetAccessor The underlying {@link IAssetAccessor} that makes the
+   * requests.
+   * @param pLimiter The limiter that the downloaded bytes are taken from.
+   */
+  BandwidthLimitingAssetAccessor(
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<BandwidthLimiter>& pLimiter);
+
+  virtual ~BandwidthLimitingAssetAccessor() noexcept override;
+
+  /** @copydoc IAssetAccessor::get */
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  /** @copydoc IAssetAccessor::getStreaming */
+  virtual Future<std::shared_ptr<IAssetRequest>> getStreaming(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const DataReceivedCallback& onDataReceived) override;
+
+  /** @copydoc IAssetAccessor::request */
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /** @copydoc IAssetAccessor::tick */
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Gets the limiter that the downloaded bytes are taken from.
+   */
+  const std::shared_ptr<BandwidthLimiter>& getLimiter() const noexcept {
+    return this->_pLimiter;
+  }
+
+private:
+  std::shared_ptr<IAssetAccessor> _pAssetAccessor;
+  std::shared_ptr<BandwidthLimiter> _pLimiter;
+};
+} // namespace CesiumAsync
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "ICacheDatabase.h"
+#include "Library.h"
+
+#include <spdlog/fwd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+namespace CesiumAsync {
+
+/**
+ * @brief A read-only {@link ICacheDatabase} that finds entries in a bundle
+ * written by a {@link CacheBundleWriter}, ahead of another database.
+ *
+ * The bundle is memory-mapped, and its entries are found through its sorted
+ * index without copying anything but the entry that is found, and without a
+ * database query. This makes it suitable for shipping the tiles of a region
+ * with an application that has no network access.
+ *
+ * Entries that are not in the bundle are looked up in the underlying
+ * database, such as a {@link SqliteCache}, in which entries are also stored,
+ * pruned and cleared. An entry of the bundle that is stored again, for
+ * example after it was revalidated, is found in the underlying database from
+ * then on, until {@link clearAll} is called. The database may be used from any
+ * thread.
+ */
+class CESIUMASYNC_API CacheBundleDatabase : public ICacheDatabase {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * If the bundle cannot be opened or is not valid, an error is logged, and
+   * all entries are looked up in the underlying database.
+   *
+   * @param pLogger The logger that receives error messages.
+   * @param bundlePath The path of the bundle.
+   * @param pDatabase The underlying database.
+   */
+  CacheBundleDatabase(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& bundlePath,
+      const std::shared_ptr<ICacheDatabase>& pDatabase);
+
+  virtual ~CacheBundleDatabase() noexcept override;
+
+  CacheBundleDatabase(const CacheBundleDatabase&) = delete;
+  CacheBundleDatabase& operator=(const CacheBundleDatabase&) = delete;
+
+  /** @copydoc ICacheDatabase::getEntry*/
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override;
+
+  /** @copydoc ICacheDatabase::storeEntry*/
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  /**
+   * @copydoc ICacheDatabase::prune
+   *
+   * The entries of the bundle are not pruned.
+   */
+  virtual bool prune() override;
+
+  /**
+   * @copydoc ICacheDatabase::clearAll
+   *
+   * The entries of the bundle are not cleared, and are found again afterwards.
+   */
+  virtual bool clearAll() override;
+
+  /**
+   * @brief Gets the number of entries in the bundle, which is zero if it could
+   * not be opened.
+   */
+  uint64_t getBundleEntryCount() const noexcept;
+
+private:
+  struct MappedFile;
+
+  std::optional<CacheItem> findInBundle(const std::string& key) const;
+
+  std::shared_ptr<spdlog::logger> _pLogger;
+  std::unique_ptr<MappedFile> _pFile;
+  std::shared_ptr<ICacheDatabase> _pDatabase;
+
+  // The keys of the entries of the bundle that were stored again.
+  mutable std::mutex _mutex;
+  std::unordered_set<std::string> _replacedKeys;
+};
+
+} // namespace CesiumAsync
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CacheItem.h"
+#include "Library.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class SqliteCache;
+
+/**
+ * @brief Writes a bundle of cache entries that can be read by a
+ * {@link CacheBundleDatabase}.
+ *
+ * This is used to ship the entries of a region that was loaded before, for
+ * example to an application that has no network access. The entries are
+ * written to the file as they are added, and the index that finds them is
+ * written by {@link finish}, which makes the bundle available under its path.
+ */
+class CESIUMASYNC_API CacheBundleWriter {
+public:
+  /**
+   * @brief Starts writing a bundle.
+   *
+   * @param bundlePath The path of the bundle. It is written to a temporary
+   * file next to it until {@link finish} is called.
+   */
+  CacheBundleWriter(const std::string& bundlePath);
+
+  /**
+   * @brief Deletes the temporary file if {@link finish} was not called.
+   */
+  ~CacheBundleWriter() noexcept;
+
+  CacheBundleWriter(const CacheBundleWriter&) = delete;
+  CacheBundleWriter& operator=(const CacheBundleWriter&) = delete;
+
+  /**
+   * @brief Adds an entry to the bundle.
+   *
+   * If the same key is added more than once, the entry that was added first
+   * is found.
+   *
+   * @param key The key of the entry, as used by the {@link ICacheDatabase}.
+   * @param item The entry.
+   * @return `true` if the entry was written, or `false` if an error occurred.
+   */
+  bool addEntry(const std::string& key, const CacheItem& item);
+
+  /**
+   * @brief Adds all of the entries of a {@link SqliteCache} to the bundle.
+   *
+   * @param cache The cache.
+   * @return `true` if all of the entries were written, or `false` if an error
+   * occurred.
+   */
+  bool addEntries(const SqliteCache& cache);
+
+  /**
+   * @brief Writes the index of the entries, and moves the bundle to its path.
+   *
+   * No more entries can be added afterwards.
+   *
+   * @return `true` if the bundle was written, or `false` if an error occurred
+   * while writing it or any of its entries.
+   */
+  bool finish();
+
+  /**
+   * @brief Gets the number of entries that were added.
+   */
+  size_t getEntryCount() const noexcept { return this->_index.size(); }
+
+private:
+  struct IndexRecord {
+    uint64_t keyHash;
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  void write(const void* pData, size_t size);
+  void pad();
+
+  std::string _bundlePath;
+  std::string _temporaryPath;
+  std::ofstream _file;
+  uint64_t _offset;
+  std::vector<IndexRecord> _index;
+  bool _failed;
+  bool _finished;
+};
+
+} // namespace CesiumAsync
@@ -9,21 +9,81 @@
 
 #include <atomic>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace CesiumAsync {
 class AsyncSystem;
 
+/**
+ * @brief The numbers of requests that a {@link CachingAssetAccessor} looked up
+ * in its cache, by how they were answered.
+ *
+ * Requests that share the result of one that is in flight are not counted.
+ */
+struct CachingAssetAccessorStatistics {
+  /**
+   * @brief The number of requests answered with a fresh cached response.
+   */
+  int64_t hitCount = 0;
+
+  /**
+   * @brief The number of requests with no cached response, which were sent to
+   * the underlying {@link IAssetAccessor}.
+   */
+  int64_t missCount = 0;
+
+  /**
+   * @brief The number of requests whose stale cached response was revalidated
+   * before it was returned.
+   */
+  int64_t revalidationCount = 0;
+
+  /**
+   * @brief The number of requests answered with a stale cached response while
+   * it was revalidated in the background.
+   */
+  int64_t staleHitCount = 0;
+};
+
 /**
  * @brief A decorator for an {@link IAssetAccessor} that caches requests and
  * responses in an {@link ICacheDatabase}.
  *
  * This can be used to improve asset loading performance by caching assets
  * across runs.
+ *
+ * Requests for the same URL with the same headers that are made while an
+ * earlier one is still in progress share its result, instead of each looking
+ * up the cache and making a request of its own.
  */
 class CachingAssetAccessor : public IAssetAccessor {
 public:
+  /**
+   * @brief A function that calculates the key of the cache entry for a request
+   * of a URL with the given headers.
+   *
+   * Requests with the same key share a cache entry.
+   */
+  using CacheKeyFunction = std::function<std::string(
+      const std::string& url,
+      const std::vector<THeader>& headers)>;
+
+  /**
+   * @brief Creates a {@link CacheKeyFunction} that uses the URL without the
+   * given query parameters as the key.
+   *
+   * This lets requests share a cache entry when they only differ in a
+   * parameter that changes from one session to the next, such as the
+   * `access_token` of Cesium ion.
+   *
+   * @param parameterNames The names of the query parameters to remove.
+   */
+  static CacheKeyFunction
+  ignoreQueryParameters(const std::vector<std::string>& parameterNames);
+
   /**
    * @brief Constructs a new instance.
    *
@@ -35,12 +95,21 @@ public:
    * responses.
    * @param requestsPerCachePrune The number of requests to handle before each
    * {@link ICacheDatabase::prune} of old cached results from the database.
+   * @param staleWhileRevalidate Whether a stale cached result is returned
+   * right away while it is revalidated in the background, instead of after it
+   * is revalidated. Results with a `no-cache` or `must-revalidate` directive
+   * are always revalidated first, and those with a `stale-while-revalidate`
+   * directive are only returned this way for as long as it allows.
+   * @param cacheKeyFunction The function that calculates the key of the cache
+   * entry for each request. If it is empty, the URL is used as the key.
    */
   CachingAssetAccessor(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
       const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
-      int32_t requestsPerCachePrune = 10000);
+      int32_t requestsPerCachePrune = 10000,
+      bool staleWhileRevalidate = false,
+      const CacheKeyFunction& cacheKeyFunction = {});
 
   virtual ~CachingAssetAccessor() noexcept override;
 
@@ -60,13 +129,31 @@ public:
   /** @copydoc IAssetAccessor::tick */
   virtual void tick() noexcept override;
 
+  /**
+   * @brief Gets the numbers of requests that were looked up in the cache so
+   * far, by how they were answered.
+   */
+  CachingAssetAccessorStatistics getStatistics() const noexcept;
+
 private:
+  struct InFlightRequests;
+  struct StatisticsCounters;
+
+  Future<std::shared_ptr<IAssetRequest>> getFromCacheOrAccessor(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers);
+
   int32_t _requestsPerCachePrune;
   std::atomic<int32_t> _requestSinceLastPrune;
   std::shared_ptr<spdlog::logger> _pLogger;
   std::shared_ptr<IAssetAccessor> _pAssetAccessor;
   std::shared_ptr<ICacheDatabase> _pCacheDatabase;
   ThreadPool _cacheThreadPool;
+  std::shared_ptr<InFlightRequests> _pInFlightRequests;
+  bool _staleWhileRevalidate;
+  CacheKeyFunction _cacheKeyFunction;
+  std::shared_ptr<StatisticsCounters> _pStatisticsCounters;
   CESIUM_TRACE_DECLARE_TRACK_SET(_pruneSlots, "Prune cache database");
 };
 } // namespace CesiumAsync
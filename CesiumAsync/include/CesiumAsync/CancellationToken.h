@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Library.h"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace CesiumAsync {
+
+/**
+ * @brief The exception with which a {@link Future} is rejected when the
+ * operation it belongs to is canceled.
+ *
+ * @see Future::withCancellation
+ */
+class CESIUMASYNC_API OperationCanceledException : public std::runtime_error {
+public:
+  /**
+   * @brief Creates a new instance.
+   */
+  OperationCanceledException();
+};
+
+class CancellationSource;
+
+/**
+ * @brief Tells whether the operation that a {@link CancellationSource} belongs
+ * to has been canceled.
+ *
+ * Tokens are cheap to copy, and may be checked from any thread. A token that
+ * is default-constructed is never canceled.
+ */
+class CESIUMASYNC_API CancellationToken {
+public:
+  /**
+   * @brief Creates a token that is never canceled.
+   */
+  CancellationToken() noexcept = default;
+
+  /**
+   * @brief Returns whether the operation has been canceled.
+   */
+  bool isCanceled() const noexcept {
+    return this->_pCanceled && this->_pCanceled->load();
+  }
+
+  /**
+   * @brief Throws an {@link OperationCanceledException} if the operation has
+   * been canceled.
+   *
+   * Long-running continuations can call this between steps to stop early.
+   */
+  void throwIfCanceled() const;
+
+private:
+  explicit CancellationToken(
+      std::shared_ptr<const std::atomic<bool>> pCanceled) noexcept
+      : _pCanceled(std::move(pCanceled)) {}
+
+  std::shared_ptr<const std::atomic<bool>> _pCanceled;
+
+  friend class CancellationSource;
+};
+
+/**
+ * @brief Cancels an operation, such as a chain of {@link Future}
+ * continuations, that holds one of its {@link CancellationToken}s.
+ *
+ * Copies of a source cancel the same operation.
+ */
+class CESIUMASYNC_API CancellationSource {
+public:
+  /**
+   * @brief Creates a source whose operation is not canceled yet.
+   */
+  CancellationSource();
+
+  /**
+   * @brief Gets a token that tells whether the operation has been canceled.
+   */
+  CancellationToken getToken() const noexcept {
+    return CancellationToken(this->_pCanceled);
+  }
+
+  /**
+   * @brief Cancels the operation. This cannot be undone.
+   */
+  void cancel() noexcept { this->_pCanceled->store(true); }
+
+  /**
+   * @brief Returns whether the operation has been canceled.
+   */
+  bool isCanceled() const noexcept { return this->_pCanceled->load(); }
+
+private:
+  std::shared_ptr<std::atomic<bool>> _pCanceled;
+};
+
+} // namespace CesiumAsync
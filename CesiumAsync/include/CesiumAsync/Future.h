@@ -1,14 +1,17 @@
 #pragma once
 
+#include "CancellationToken.h"
 #include "Impl/AsyncSystemSchedulers.h"
 #include "Impl/CatchFunction.h"
 #include "Impl/ContinuationFutureType.h"
+#include "Impl/PrioritizedFunction.h"
 #include "Impl/WithTracing.h"
 #include "SharedFuture.h"
 #include "ThreadPool.h"
 
 #include <CesiumUtility/Tracing.h>
 
+#include <type_traits>
 #include <variant>
 
 namespace CesiumAsync {
@@ -71,6 +74,38 @@ public:
         std::forward<Func>(f));
   }
 
+  /**
+   * @brief Registers a continuation function to be invoked in a worker thread
+   * when this Future resolves, and invalidates this Future, with a hint of how
+   * soon the continuation should run relative to other tasks.
+   *
+   * Unlike the overload without a priority, the continuation is always
+   * started with {@link ITaskProcessor::startTaskWithPriority}, even if this
+   * Future is resolved from a worker thread, so that more important tasks can
+   * run first.
+   *
+   * If the function itself returns a `Future`, the function will not be
+   * considered complete until that returned `Future` also resolves.
+   *
+   * @tparam Func The type of the function.
+   * @param f The function.
+   * @param priority How soon the function should run, relative to other
+   * tasks.
+   * @return A future that resolves after the supplied function completes.
+   */
+  template <typename Func>
+  CesiumImpl::ContinuationFutureType_t<Func, T>
+  thenInWorkerThread(Func&& f, const TaskPriority& priority) && {
+    return CesiumImpl::ContinuationFutureType_t<Func, T>(
+        this->_pSchedulers,
+        this->_task.then(
+            async::inline_scheduler(),
+            CesiumImpl::PrioritizedFunction<std::decay_t<Func>, T>{
+                this->_pSchedulers,
+                priority,
+                std::forward<Func>(f)}));
+  }
+
   /**
    * @brief Registers a continuation function to be invoked in the main thread
    * when this Future resolves, and invalidates this Future.
@@ -201,6 +236,35 @@ public:
         std::forward<Func>(f));
   }
 
+  /**
+   * @brief Stops the continuations chained after this one from running once
+   * an operation is canceled, and invalidates this Future.
+   *
+   * When this Future resolves, if the token is canceled, the returned Future
+   * is rejected with an {@link OperationCanceledException} instead. The
+   * `then` continuations chained after it are then skipped without being
+   * scheduled, and the first `catch` continuation receives the exception.
+   * Otherwise the returned Future resolves or rejects like this one.
+   *
+   * Continuations that are already scheduled when the operation is canceled
+   * still run, so put this before each step that should be skipped, or call
+   * {@link CancellationToken::throwIfCanceled} inside long steps.
+   *
+   * @param token The token of the operation.
+   * @return A future that resolves like this one, unless the operation is
+   * canceled.
+   */
+  Future<T> withCancellation(const CancellationToken& token) && {
+    return Future<T>(
+        this->_pSchedulers,
+        this->_task.then(
+            async::inline_scheduler(),
+            [token](async::task<T>&& task) {
+              token.throwIfCanceled();
+              return task.get();
+            }));
+  }
+
   /**
    * @brief Passes through one or more additional values to the next
    * continuation.
@@ -28,6 +28,18 @@ public:
       const std::string& url,
       const std::vector<THeader>& headers) override;
 
+  /**
+   * @copydoc IAssetAccessor::getStreaming
+   *
+   * Gzipped pieces of the response are gunzipped as they are received, and
+   * only the gunzipped data is passed to `onDataReceived`.
+   */
+  virtual Future<std::shared_ptr<IAssetRequest>> getStreaming(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const DataReceivedCallback& onDataReceived) override;
+
   virtual Future<std::shared_ptr<IAssetRequest>> request(
       const AsyncSystem& asyncSystem,
       const std::string& verb,
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "IAssetAccessor.h"
+#include "IAssetRequest.h"
+#include "Library.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class AsyncSystem;
+
+/**
+ * @brief Options for a {@link HttpAssetAccessor}.
+ */
+struct CESIUMASYNC_API HttpAssetAccessorOptions {
+  /**
+   * @brief The maximum number of connections that are open to each host at
+   * the same time.
+   *
+   * Requests to a host that has no free connection wait in a queue, and are
+   * sent on the first connection that becomes free.
+   */
+  int32_t maximumConnectionsPerHost = 6;
+
+  /**
+   * @brief The maximum number of requests that are in progress at the same
+   * time, to all hosts.
+   *
+   * This is the number of threads that send requests and wait for their
+   * responses.
+   */
+  int32_t maximumSimultaneousRequests = 16;
+
+  /**
+   * @brief The number of seconds to wait for a connection to be established.
+   */
+  int64_t connectionTimeoutSeconds = 10;
+
+  /**
+   * @brief The number of seconds to wait for data from the server before a
+   * request fails.
+   */
+  int64_t readTimeoutSeconds = 30;
+
+  /**
+   * @brief Whether to ask servers for gzipped responses, and unzip them.
+   *
+   * This only adds an `Accept-Encoding` header to requests that do not have
+   * one.
+   */
+  bool requestGzip = true;
+};
+
+/**
+ * @brief An {@link IAssetAccessor} that requests assets from HTTP servers.
+ *
+ * The connections to each host are kept alive and reused by later requests,
+ * so that most requests do not have to establish a new connection. Requests
+ * are sent from a thread pool owned by this instance, and do not need the
+ * main thread, so {@link tick} does nothing.
+ *
+ * HTTPS is only supported if cpp-httplib is built with OpenSSL. Requests that
+ * fail to connect or to receive a response reject the returned future.
+ */
+class CESIUMASYNC_API HttpAssetAccessor : public IAssetAccessor {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param options The options for the connections and requests.
+   */
+  HttpAssetAccessor(const HttpAssetAccessorOptions& options = {});
+
+  virtual ~HttpAssetAccessor() noexcept override;
+
+  /** @copydoc IAssetAccessor::get */
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  /** @copydoc IAssetAccessor::request */
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /** @copydoc IAssetAccessor::tick */
+  virtual void tick() noexcept override;
+
+private:
+  struct Connections;
+
+  std::shared_ptr<Connections> _pConnections;
+};
+} // namespace CesiumAsync
@@ -7,6 +7,7 @@
 #include <gsl/span>
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,6 +26,13 @@ public:
    */
   typedef std::pair<std::string, std::string> THeader;
 
+  /**
+   * @brief A function that receives the body of a response in pieces, as it
+   * is downloaded.
+   */
+  using DataReceivedCallback =
+      std::function<void(const gsl::span<const std::byte>& data)>;
+
   virtual ~IAssetAccessor() = default;
 
   /**
@@ -41,6 +49,33 @@ public:
       const std::string& url,
       const std::vector<THeader>& headers = {}) = 0;
 
+  /**
+   * @brief Starts a new request for the asset with the given URL, like
+   * {@link get}, and passes the body of the response to a callback in pieces
+   * as it is downloaded, so that the caller can start processing it before
+   * the request completes.
+   *
+   * An implementation that streams must pass all of the body, in order, one
+   * piece at a time, before the returned future resolves. The pieces may be
+   * passed from any thread. The completed request must still provide all of
+   * the data in its {@link IAssetRequest::response}.
+   *
+   * The default implementation does not stream and never calls
+   * `onDataReceived`, so callers must be prepared to use the data of the
+   * completed request instead.
+   *
+   * @param asyncSystem The async system used to do work in threads.
+   * @param url The URL of the asset.
+   * @param headers The headers to include in the request.
+   * @param onDataReceived The function that receives the pieces of the body.
+   * @return The in-progress asset request.
+   */
+  virtual CesiumAsync::Future<std::shared_ptr<IAssetRequest>> getStreaming(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const DataReceivedCallback& onDataReceived);
+
   /**
    * @brief Starts a new request to the given URL, using the provided HTTP verb
    * and the provided content payload.
@@ -3,8 +3,10 @@
 #include "HttpHeaders.h"
 #include "Library.h"
 
+#include <cstddef>
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace CesiumAsync {
 
@@ -40,6 +42,21 @@ public:
    * This method may be called from any thread.
    */
   virtual const IAssetResponse* response() const = 0;
+
+  /**
+   * @brief Moves the data of the response out of this request, so that it
+   * can be used without a copy, for example as the binary buffer of a glTF.
+   *
+   * Afterwards, the data of the {@link response} may be empty, so this should
+   * only be called by the last user of the data. The default implementation
+   * copies the data and leaves the response unchanged, which is also what an
+   * implementation that shares its response data with other requests should
+   * do.
+   *
+   * @returns The data of the response, or an empty vector if the request is
+   * still in progress.
+   */
+  virtual std::vector<std::byte> takeResponseData();
 };
 
 } // namespace CesiumAsync
@@ -2,9 +2,42 @@
 
 #include "Library.h"
 
+#include <cstdint>
 #include <functional>
+#include <utility>
 
 namespace CesiumAsync {
+/**
+ * @brief A hint of how soon a task should run, relative to other tasks.
+ *
+ * @see ITaskProcessor::startTaskWithPriority
+ */
+struct TaskPriority {
+  /**
+   * @brief The priority group of the task.
+   *
+   * All tasks in a higher group should run before any task in a lower group.
+   */
+  int32_t group = 0;
+
+  /**
+   * @brief The priority of the task within its group.
+   *
+   * Tasks with a _lower_ value should run sooner.
+   */
+  double value = 0.0;
+
+  /**
+   * @brief Returns true if this task should run before the other one.
+   */
+  bool operator<(const TaskPriority& rhs) const noexcept {
+    if (this->group == rhs.group)
+      return this->value < rhs.value;
+    else
+      return this->group > rhs.group;
+  }
+};
+
 /**
  * @brief When implemented by a rendering engine, allows tasks to be
  * asynchronously executed in background threads.
@@ -25,5 +58,23 @@ public:
    * @param f The function to execute
    */
   virtual void startTask(std::function<void()> f) = 0;
+
+  /**
+   * @brief Starts a task that executes the given function in a background
+   * thread, with a hint of how soon it should run.
+   *
+   * Implementations that can run more important tasks first should override
+   * this. By default, the priority is ignored and the task is started with
+   * {@link startTask}.
+   *
+   * @param f The function to execute
+   * @param priority How soon the function should run, relative to other
+   * tasks.
+   */
+  virtual void
+  startTaskWithPriority(std::function<void()> f, const TaskPriority& priority) {
+    (void)priority;
+    this->startTask(std::move(f));
+  }
 };
 } // namespace CesiumAsync
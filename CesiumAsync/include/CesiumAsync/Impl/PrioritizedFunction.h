@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../ITaskProcessor.h"
+#include "AsyncSystemSchedulers.h"
+#include "TaskScheduler.h"
+#include "WithTracing.h"
+#include "cesium-async++.h"
+
+#include <memory>
+#include <utility>
+
+namespace CesiumAsync {
+namespace CesiumImpl {
+// Begin omitting doxgen warnings for Impl namespace
+//! @cond Doxygen_Suppress
+
+// A continuation that runs immediately, and then schedules the function in a
+// worker thread at a particular priority.
+template <typename Func, typename T> struct PrioritizedFunction {
+  std::shared_ptr<AsyncSystemSchedulers> pSchedulers;
+  TaskPriority priority;
+  Func f;
+
+  auto operator()(async::task<T>&& t) {
+    // The task is resolved already, so the function is scheduled right away,
+    // while this scheduler still exists.
+    PrioritizedTaskScheduler scheduler(
+        this->pSchedulers->workerThread,
+        this->priority);
+    return t.then(scheduler, WithTracing<T>::end(nullptr, std::move(this->f)));
+  }
+};
+
+//! @endcond
+// End omitting doxgen warnings for Impl namespace
+} // namespace CesiumImpl
+} // namespace CesiumAsync
@@ -3,6 +3,10 @@
 #include "ImmediateScheduler.h"
 #include "cesium-async++.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
 namespace CesiumAsync {
 namespace CesiumImpl {
 
@@ -11,11 +15,14 @@ public:
   void schedule(async::task_run_handle t);
   void dispatchQueuedContinuations();
   bool dispatchZeroOrOneContinuation();
+  size_t dispatchContinuationsUntil(std::chrono::steady_clock::time_point end);
+  size_t getQueuedCount() const noexcept { return this->_queuedCount; }
 
   ImmediateScheduler<QueuedScheduler> immediate{this};
 
 private:
   async::fifo_scheduler _scheduler;
+  std::atomic<size_t> _queuedCount{0};
 };
 
 } // namespace CesiumImpl
@@ -4,6 +4,7 @@
 #include "ImmediateScheduler.h"
 
 #include <memory>
+#include <utility>
 
 namespace CesiumAsync {
 namespace CesiumImpl {
@@ -12,6 +13,7 @@ class TaskScheduler {
 public:
   TaskScheduler(const std::shared_ptr<ITaskProcessor>& pTaskProcessor);
   void schedule(async::task_run_handle t);
+  void schedule(async::task_run_handle t, const TaskPriority& priority);
 
   ImmediateScheduler<TaskScheduler> immediate{this};
 
@@ -19,5 +21,24 @@ private:
   std::shared_ptr<ITaskProcessor> _pTaskProcessor;
 };
 
+// Schedules tasks with a TaskScheduler at a particular priority. Since async++
+// only keeps a reference to the scheduler of a continuation, this must only be
+// used to spawn tasks, which are scheduled right away.
+class PrioritizedTaskScheduler {
+public:
+  PrioritizedTaskScheduler(
+      TaskScheduler& scheduler,
+      const TaskPriority& priority) noexcept
+      : _scheduler(scheduler), _priority(priority) {}
+
+  void schedule(async::task_run_handle t) {
+    this->_scheduler.schedule(std::move(t), this->_priority);
+  }
+
+private:
+  TaskScheduler& _scheduler;
+  TaskPriority _priority;
+};
+
 } // namespace CesiumImpl
 } // namespace CesiumAsync
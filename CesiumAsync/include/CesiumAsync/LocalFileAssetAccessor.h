@@ -0,0 +1,93 @@
+#pragma once
+
+#include "IAssetAccessor.h"
+#include "IAssetRequest.h"
+#include "Library.h"
+#include "ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class AsyncSystem;
+
+/**
+ * @brief Options for a {@link LocalFileAssetAccessor}.
+ */
+struct CESIUMASYNC_API LocalFileAssetAccessorOptions {
+  /**
+   * @brief The size in bytes of the smallest file that is mapped into memory.
+   *
+   * Smaller files are read into memory instead, because mapping a file costs
+   * more than copying a few pages of it.
+   */
+  size_t minimumMappedFileSize = 16 * 1024;
+
+  /**
+   * @brief Whether to ask the operating system to start reading a mapped file
+   * in the background as soon as it is requested, so that its pages are in
+   * memory by the time its content is parsed.
+   */
+  bool prefetchMappedFiles = true;
+
+  /**
+   * @brief The number of threads that open and map the files.
+   */
+  int32_t threadCount = 2;
+};
+
+/**
+ * @brief An {@link IAssetAccessor} that serves `file://` URLs from the local
+ * file system, for tilesets that are stored on a local disk.
+ *
+ * Files are mapped into memory, and the data of a response refers to the
+ * mapped pages rather than to a copy of them, so the file is read by the
+ * operating system as its pages are touched. The mapping is closed when the
+ * last reference to the response is released.
+ *
+ * The files are opened by threads owned by this instance, so that a request
+ * does not wait behind the work in the worker threads, and a mapped file is
+ * read ahead in the background while the request is passed on to whoever
+ * parses its content.
+ *
+ * A request for a file that does not exist, or for a URL that is not a
+ * `file://` URL, has a response with the status code 404. A `HEAD` request
+ * has a response without data, and a request with a verb other than `GET` or
+ * `HEAD` has a response with the status code 405.
+ */
+class CESIUMASYNC_API LocalFileAssetAccessor : public IAssetAccessor {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param options When to map the files, and how many threads open them.
+   */
+  LocalFileAssetAccessor(const LocalFileAssetAccessorOptions& options = {});
+
+  virtual ~LocalFileAssetAccessor() noexcept override;
+
+  /** @copydoc IAssetAccessor::get */
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  /** @copydoc IAssetAccessor::request */
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /** @copydoc IAssetAccessor::tick */
+  virtual void tick() noexcept override;
+
+private:
+  LocalFileAssetAccessorOptions _options;
+  ThreadPool _threadPool;
+};
+} // namespace CesiumAsync
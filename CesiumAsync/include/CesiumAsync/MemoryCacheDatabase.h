@@ -0,0 +1,106 @@
+#pragma once
+
+#include "ICacheDatabase.h"
+#include "Library.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace CesiumAsync {
+
+/**
+ * @brief A decorator for an {@link ICacheDatabase} that keeps the most
+ * recently used entries in memory.
+ *
+ * Entries that were stored or found recently, like those of tiles that are
+ * loaded again soon after they were unloaded, are found in memory instead of
+ * in the underlying database, such as a {@link SqliteCache}. Entries are
+ * stored in the underlying database as well, and cleared from both.
+ *
+ * When the entries in memory take more than {@link getMaximumBytes}, the
+ * least recently used are evicted from memory. The database may be used from
+ * any thread.
+ */
+class CESIUMASYNC_API MemoryCacheDatabase : public ICacheDatabase {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pDatabase The underlying database.
+   * @param maximumBytes The number of bytes that the entries in memory may
+   * take before the least recently used are evicted.
+   */
+  MemoryCacheDatabase(
+      const std::shared_ptr<ICacheDatabase>& pDatabase,
+      int64_t maximumBytes = 16 * 1024 * 1024);
+
+  /** @copydoc ICacheDatabase::getEntry*/
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override;
+
+  /** @copydoc ICacheDatabase::storeEntry*/
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  /**
+   * @copydoc ICacheDatabase::prune
+   *
+   * Expired entries are also evicted from memory.
+   */
+  virtual bool prune() override;
+
+  /** @copydoc ICacheDatabase::clearAll*/
+  virtual bool clearAll() override;
+
+  /**
+   * @brief Gets the number of bytes that the entries in memory may take
+   * before the least recently used are evicted.
+   */
+  int64_t getMaximumBytes() const noexcept { return this->_maximumBytes; }
+
+  /**
+   * @brief Gets the number of entries in memory.
+   */
+  size_t getCount() const;
+
+  /**
+   * @brief Gets the approximate number of bytes that the entries in memory
+   * take.
+   */
+  int64_t getByteSize() const;
+
+private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const CacheItem> pItem;
+    int64_t byteSize;
+  };
+
+  void
+  insert(const std::string& key, CacheItem&& item, bool replace) const;
+
+  std::shared_ptr<ICacheDatabase> _pDatabase;
+
+  mutable std::mutex _mutex;
+  // The most recently used entry is at the front.
+  mutable std::list<Entry> _entries;
+  mutable std::unordered_map<std::string, std::list<Entry>::iterator>
+      _entriesByKey;
+  mutable int64_t _byteSize;
+  int64_t _maximumBytes;
+};
+
+} // namespace CesiumAsync
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "IAssetAccessor.h"
+#include "IAssetRequest.h"
+#include "Library.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace CesiumAsync {
+class AsyncSystem;
+
+/**
+ * @brief Options for a {@link RetryingAssetAccessor}.
+ */
+struct CESIUMASYNC_API RetryingAssetAccessorOptions {
+  /**
+   * @brief The number of times to retry a request that failed with a
+   * transient error, after the first attempt.
+   *
+   * A request fails with a transient error if it has no response, or if the
+   * status code of its response is one of {@link retryStatusCodes}.
+   */
+  uint32_t maximumRetries = 3;
+
+  /**
+   * @brief The status codes of the responses that are retried.
+   */
+  std::vector<uint16_t> retryStatusCodes{408, 429, 500, 502, 503, 504};
+
+  /**
+   * @brief The time to wait before the first retry, in milliseconds.
+   */
+  double initialRetryDelayMilliseconds = 250.0;
+
+  /**
+   * @brief The factor by which the time to wait grows with each retry.
+   */
+  double retryBackoffMultiplier = 2.0;
+
+  /**
+   * @brief The longest time to wait before a retry, in milliseconds.
+   *
+   * This also limits how long a `Retry-After` header in seconds can make a
+   * retry wait.
+   */
+  double maximumRetryDelayMilliseconds = 10000.0;
+
+  /**
+   * @brief Whether to send a duplicate of a request that takes longer than
+   * most requests to the same host, and use whichever response arrives
+   * first.
+   */
+  bool enableHedging = false;
+
+  /**
+   * @brief The percentile of the latency of the requests to a host after
+   * which a hedged duplicate is sent, between 0 and 100.
+   */
+  double hedgingPercentile = 95.0;
+
+  /**
+   * @brief The shortest time to wait before a hedged duplicate is sent, in
+   * milliseconds.
+   */
+  double minimumHedgingDelayMilliseconds = 50.0;
+
+  /**
+   * @brief The number of requests to a host that must have completed before
+   * requests to it are hedged, so that the percentile is meaningful.
+   */
+  int64_t minimumHedgingSamples = 20;
+
+  /**
+   * @brief The maximum number of requests to each host that are sent to the
+   * underlying accessor at the same time, or 0 for no limit.
+   *
+   * This includes the retries and the hedged duplicates. Requests beyond the
+   * limit wait in a queue, except hedged duplicates, which are not sent at
+   * all while a host is at its limit.
+   */
+  int32_t maximumRequestsPerHost = 0;
+};
+
+/**
+ * @brief The requests that a {@link RetryingAssetAccessor} retried and
+ * hedged.
+ */
+struct CESIUMASYNC_API RetryingAssetAccessorStatistics {
+  /**
+   * @brief The number of retries that were sent.
+   */
+  int64_t retryCount = 0;
+
+  /**
+   * @brief The number of requests that failed with a transient error on their
+   * last attempt.
+   */
+  int64_t exhaustedCount = 0;
+
+  /**
+   * @brief The number of hedged duplicates that were sent.
+   */
+  int64_t hedgedRequestCount = 0;
+
+  /**
+   * @brief The number of hedged duplicates whose response was used, because
+   * it arrived before the response to the original request.
+   */
+  int64_t hedgeWinCount = 0;
+};
+
+/**
+ * @brief A decorator for an {@link IAssetAccessor} that retries requests that
+ * fail with a transient error, and optionally hedges slow requests, to cut
+ * the tail latency of tile loads.
+ *
+ * Failed requests are retried after a delay that grows exponentially with
+ * each retry, or after the delay in the response's `Retry-After` header if
+ * that is longer. When hedging is enabled, a request that has not completed
+ * after the latency of {@link RetryingAssetAccessorOptions::hedgingPercentile}
+ * of the earlier requests to its host is sent again, and whichever response
+ * arrives first is used. The other one is ignored when it arrives.
+ *
+ * Only `GET` and `HEAD` requests are retried and hedged, because other
+ * requests may not be safe to send twice. The response data is not streamed,
+ * since a retry could deliver it twice.
+ *
+ * When this is the underlying accessor of a {@link CachingAssetAccessor},
+ * only the requests that miss the cache are retried and hedged, and only the
+ * final response is cached. The delays are timed by a thread owned by this
+ * instance, so {@link tick} does not need to be called. Retries that are
+ * waiting when this instance is destroyed are sent right away.
+ */
+class CESIUMASYNC_API RetryingAssetAccessor : public IAssetAccessor {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pAssetAccessor The underlying {@link IAssetAccessor} that makes the
+   * requests.
+   * @param options When to retry and hedge the requests, and how many to send
+   * to each host.
+   */
+  RetryingAssetAccessor(
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+      const RetryingAssetAccessorOptions& options = {});
+
+  virtual ~RetryingAssetAccessor() noexcept override;
+
+  /** @copydoc IAssetAccessor::get */
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  /** @copydoc IAssetAccessor::request */
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /** @copydoc IAssetAccessor::tick */
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Gets the number of requests that were retried and hedged so far.
+   *
+   * This may be called from any thread.
+   */
+  RetryingAssetAccessorStatistics getStatistics() const;
+
+private:
+  struct Requests;
+
+  std::shared_ptr<Requests> _pRequests;
+  std::thread _timerThread;
+};
+} // namespace CesiumAsync
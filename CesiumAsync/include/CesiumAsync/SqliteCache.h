@@ -5,6 +5,7 @@
 #include <spdlog/fwd.h>
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -13,6 +14,11 @@ namespace CesiumAsync {
 
 /**
  * @brief Cache storage using SQLITE to store completed response.
+ *
+ * Stored entries are queued, and written together with the last accessed
+ * times of the entries that were read, in a single transaction once enough of
+ * them are queued, before pruning, and when the cache is destroyed. Queued
+ * entries are found by {@link getEntry} as well.
  */
 class CESIUMASYNC_API SqliteCache : public ICacheDatabase {
 public:
@@ -27,11 +33,35 @@ public:
    * @param databaseName the database path.
    * @param maxItems the maximum number of items should be kept in the database
    * after prunning.
+   * @param maxReaderConnections the maximum number of additional read-only
+   * connections, which let up to this many {@link getEntry} calls read the
+   * database at the same time, without waiting for the calls that write to it.
+   * If this is zero, or the database is in memory, all calls use one
+   * connection, one at a time.
+   * @param responseDataFileThreshold the size in bytes from which response data
+   * is stored in a separate file, in a directory named after the database with
+   * `.files` appended, instead of in the database. This keeps the database
+   * small, and saves SQLite from splitting large responses over many pages.
+   * Each entry has its own file. The file of a replaced entry is deleted once
+   * its replacement is written, and those of deleted entries when the cache
+   * is pruned or cleared. If this is zero, or the database is in memory, all
+   * response data is stored in the database.
+   * @param maxBytes the maximum total size in bytes of the response data that
+   * should be kept in the database after prunning, in addition to the limit of
+   * `maxItems`. If this is zero, only the number of items is limited.
+   * @param compressResponseData whether response data is compressed with gzip
+   * before it is stored, and decompressed when it is read, when that makes it
+   * smaller. Response data that is gzipped already, as when the server sent it
+   * that way, is stored as it is.
    */
   SqliteCache(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::string& databaseName,
-      uint64_t maxItems = 4096);
+      uint64_t maxItems = 4096,
+      size_t maxReaderConnections = 4,
+      size_t responseDataFileThreshold = 0,
+      uint64_t maxBytes = 0,
+      bool compressResponseData = false);
   ~SqliteCache();
 
   /** @copydoc ICacheDatabase::getEntry*/
@@ -55,6 +85,23 @@ public:
   /** @copydoc ICacheDatabase::clearAll*/
   virtual bool clearAll() override;
 
+  /**
+   * @brief Calls a function with each entry in the database, in the order in
+   * which they were first stored.
+   *
+   * This is meant for exporting the entries, for example with a
+   * {@link CacheBundleWriter}. Other calls that write to the database wait
+   * until it returns. Entries that cannot be read are skipped.
+   *
+   * @param callback The function that receives the key and item of each
+   * entry.
+   * @return `true` if all of the entries were read, or `false` if an error
+   * stopped the reading.
+   */
+  bool forEachEntry(
+      const std::function<void(const std::string& key, CacheItem&& item)>&
+          callback) const;
+
 private:
   struct Impl;
   std::unique_ptr<Impl> _pImpl;
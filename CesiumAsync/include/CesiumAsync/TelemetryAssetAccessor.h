@@ -0,0 +1,196 @@
+#pragma once
+
+#include "IAssetAccessor.h"
+#include "IAssetRequest.h"
+#include "Library.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class AsyncSystem;
+
+/**
+ * @brief A histogram of durations, in milliseconds.
+ */
+struct CESIUMASYNC_API LatencyHistogram {
+  /**
+   * @brief The upper bounds of the buckets, in milliseconds.
+   *
+   * The last bucket of {@link counts} has no upper bound, and counts the
+   * durations that are longer than all of these.
+   */
+  static constexpr std::array<double, 11> bucketUpperBounds =
+      {5.0, 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0, 2500.0, 5000.0,
+       10000.0};
+
+  /**
+   * @brief The number of durations in each bucket.
+   */
+  std::array<int64_t, bucketUpperBounds.size() + 1> counts{};
+
+  /**
+   * @brief The number of durations.
+   */
+  int64_t sampleCount = 0;
+
+  /**
+   * @brief The sum of the durations, in milliseconds.
+   */
+  double totalMilliseconds = 0.0;
+
+  /**
+   * @brief The longest duration, in milliseconds.
+   */
+  double maximumMilliseconds = 0.0;
+
+  /**
+   * @brief Adds a duration.
+   *
+   * @param milliseconds The duration, in milliseconds.
+   */
+  void add(double milliseconds) noexcept;
+
+  /**
+   * @brief Gets the mean of the durations, in milliseconds, or zero if there
+   * are none.
+   */
+  double getMeanMilliseconds() const noexcept;
+
+  /**
+   * @brief Estimates a percentile of the durations, in milliseconds.
+   *
+   * This is the upper bound of the bucket that contains the percentile, or
+   * the longest duration if that is shorter or the bucket has no upper bound.
+   *
+   * @param percentile The percentile, between 0 and 100.
+   * @return The estimate, or zero if there are no durations.
+   */
+  double getPercentileMilliseconds(double percentile) const noexcept;
+};
+
+/**
+ * @brief The requests that a {@link TelemetryAssetAccessor} made to a host.
+ */
+struct CESIUMASYNC_API HostTelemetry {
+  /**
+   * @brief The number of requests, including those still in progress.
+   */
+  int64_t requestCount = 0;
+
+  /**
+   * @brief The number of requests that failed without a response.
+   */
+  int64_t failedRequestCount = 0;
+
+  /**
+   * @brief The number of responses with a status code of 400 or more.
+   */
+  int64_t errorResponseCount = 0;
+
+  /**
+   * @brief The number of requests that revalidated a cached response, with an
+   * `If-None-Match` or `If-Modified-Since` header.
+   */
+  int64_t revalidationCount = 0;
+
+  /**
+   * @brief The number of responses with the status code 304 (Not Modified).
+   */
+  int64_t notModifiedCount = 0;
+
+  /**
+   * @brief The number of bytes of response data that were received.
+   */
+  uint64_t receivedBytes = 0;
+
+  /**
+   * @brief The time from the start of each request until the first piece of
+   * its response data was received.
+   *
+   * This is only recorded for requests whose data is streamed by the
+   * underlying {@link IAssetAccessor}, see
+   * {@link IAssetAccessor::getStreaming}.
+   */
+  LatencyHistogram timeToFirstByte;
+
+  /**
+   * @brief The time from the start of each request until it completed.
+   */
+  LatencyHistogram latency;
+};
+
+/**
+ * @brief A decorator for an {@link IAssetAccessor} that records the number,
+ * size and latency of the requests to each host.
+ *
+ * When it is used as the underlying accessor of a
+ * {@link CachingAssetAccessor}, it only sees the requests that were not
+ * answered from the cache, and the revalidations of cached responses; see
+ * {@link CachingAssetAccessor::getStatistics} for the cache hits. The
+ * telemetry may be read from any thread.
+ */
+class CESIUMASYNC_API TelemetryAssetAccessor : public IAssetAccessor {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pAssetAccessor The underlying {@link IAssetAccessor} that makes the
+   * requests.
+   */
+  TelemetryAssetAccessor(const std::shared_ptr<IAssetAccessor>& pAssetAccessor);
+
+  virtual ~TelemetryAssetAccessor() noexcept override;
+
+  /** @copydoc IAssetAccessor::get */
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  /** @copydoc IAssetAccessor::getStreaming */
+  virtual Future<std::shared_ptr<IAssetRequest>> getStreaming(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const DataReceivedCallback& onDataReceived) override;
+
+  /** @copydoc IAssetAccessor::request */
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /** @copydoc IAssetAccessor::tick */
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Gets a copy of the telemetry of each host, by the host name and
+   * port of its URLs.
+   *
+   * URLs without a host, such as `file` URLs, are recorded under an empty
+   * host name.
+   */
+  std::map<std::string, HostTelemetry> getSnapshot() const;
+
+  /**
+   * @brief Forgets the telemetry of all hosts.
+   *
+   * Requests that are in progress are still recorded when they complete.
+   */
+  void reset();
+
+private:
+  struct Records;
+
+  std::shared_ptr<IAssetAccessor> _pAssetAccessor;
+  std::shared_ptr<Records> _pRecords;
+};
+} // namespace CesiumAsync
@@ -3,7 +3,10 @@
 #include "Impl/ImmediateScheduler.h"
 #include "Impl/cesium-async++.h"
 #include "Library.h"
+#include "ThreadPoolOptions.h"
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
 
 namespace CesiumAsync {
@@ -17,12 +20,23 @@ namespace CesiumAsync {
  */
 class CESIUMASYNC_API ThreadPool {
 public:
-  ThreadPool(int32_t numberOfThreads);
+  /**
+   * @brief Creates a new thread pool.
+   *
+   * @param numberOfThreads The number of threads in the pool. If this is zero
+   * or less, the pool has one thread.
+   * @param options The options for the threads of the pool.
+   */
+  ThreadPool(int32_t numberOfThreads, const ThreadPoolOptions& options = {});
 
 private:
   struct Scheduler {
-    Scheduler(int32_t numberOfThreads);
+    Scheduler(int32_t numberOfThreads, const ThreadPoolOptions& options);
     void schedule(async::task_run_handle t);
+    void configureThread() noexcept;
+
+    ThreadPoolOptions options;
+    std::atomic<size_t> nextThreadIndex{0};
 
     CesiumImpl::ImmediateScheduler<Scheduler> immediate{this};
 
@@ -30,8 +44,10 @@ private:
   };
 
   static auto createPreRun(ThreadPool::Scheduler* pScheduler) {
-    return
-        [pScheduler]() { ThreadPool::_scope = pScheduler->immediate.scope(); };
+    return [pScheduler]() {
+      pScheduler->configureThread();
+      ThreadPool::_scope = pScheduler->immediate.scope();
+    };
   }
 
   static auto createPostRun() noexcept {
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+
+/**
+ * @brief How the operating system should schedule the threads of a pool
+ * relative to the other threads of the process.
+ *
+ * On Apple platforms these are the quality-of-service classes of the same
+ * names. Elsewhere they are mapped to thread priorities: on Windows,
+ * `Background` and `Utility` are the lowest and below-normal priorities, and
+ * on Linux and Android they raise the nice value of the threads.
+ */
+enum class ThreadQualityOfService {
+  /**
+   * @brief The threads are scheduled like any other thread of the process.
+   */
+  Default,
+
+  /**
+   * @brief Work that the user does not wait for, like prefetching or writing
+   * to a cache, which should not compete with the render thread.
+   */
+  Background,
+
+  /**
+   * @brief Long-running work whose results the user waits for, like
+   * downloading and decoding tiles.
+   */
+  Utility,
+
+  /**
+   * @brief Work that the user is waiting for right now. This is the same as
+   * `Default` outside of Apple platforms, since raising the priority of a
+   * thread above normal usually requires privileges.
+   */
+  UserInitiated
+};
+
+/**
+ * @brief Options for the threads of a {@link ThreadPool} or
+ * {@link WorkStealingTaskProcessor}.
+ *
+ * The options are applied by each thread when it starts. An option that the
+ * platform does not support, or that the operating system refuses, is
+ * ignored.
+ */
+struct ThreadPoolOptions {
+  /**
+   * @brief The name of the threads, which is shown by debuggers and
+   * profilers.
+   *
+   * Each thread is named with this name followed by its index in the pool,
+   * like "Decode 3". Linux and Android truncate names to 15 characters. If
+   * the name is empty, the threads are not named.
+   */
+  std::string threadName;
+
+  /**
+   * @brief How the operating system should schedule the threads.
+   */
+  ThreadQualityOfService qualityOfService = ThreadQualityOfService::Default;
+
+  /**
+   * @brief The indices of the logical CPUs that the threads may run on.
+   *
+   * If this is empty, the threads may run on any CPU, or on the CPUs of
+   * {@link numaNode}. Thread affinity is supported on Windows, for the
+   * CPUs of the first processor group, and on Linux and Android, but not on
+   * Apple platforms.
+   */
+  std::vector<uint32_t> cpuAffinity;
+
+  /**
+   * @brief The NUMA node whose CPUs the threads may run on, or -1 for any
+   * node.
+   *
+   * This is only used if {@link cpuAffinity} is empty, and only on Windows
+   * and Linux.
+   */
+  int32_t numaNode = -1;
+};
+
+} // namespace CesiumAsync
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "ITaskProcessor.h"
+#include "Library.h"
+#include "ThreadPoolOptions.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CesiumAsync {
+
+/**
+ * @brief An {@link ITaskProcessor} that runs tasks on a fixed number of
+ * threads, each with its own queue of tasks.
+ *
+ * A task started by one of the threads, like a continuation of a task that
+ * it is running, goes into that thread's own queue, and the thread runs the
+ * newest task in its queue first, while its data is likely still in the
+ * cache. Tasks started by other threads are spread over the queues in turn.
+ * A thread whose queue is empty takes the oldest task from another queue.
+ * Since each queue has its own lock, threads rarely wait for each other to
+ * start and finish tasks, even with many short tasks on many cores.
+ *
+ * Tasks started with {@link startTaskWithPriority} are kept in a separate,
+ * shared queue instead, and run before any of the others, most important
+ * first.
+ *
+ * This can be used as the task processor of an {@link AsyncSystem} by
+ * applications that do not have a task system of their own.
+ */
+class CESIUMASYNC_API WorkStealingTaskProcessor : public ITaskProcessor {
+public:
+  /**
+   * @brief Starts the threads.
+   *
+   * @param threadCount The number of threads. If this is zero, one thread is
+   * started.
+   * @param options The options for the threads, like their name and how the
+   * operating system should schedule them.
+   */
+  explicit WorkStealingTaskProcessor(
+      size_t threadCount = std::thread::hardware_concurrency(),
+      const ThreadPoolOptions& options = {});
+
+  /**
+   * @brief Finishes the tasks that were already started, and stops the
+   * threads.
+   *
+   * This must not be called from one of the tasks.
+   */
+  virtual ~WorkStealingTaskProcessor() noexcept override;
+
+  WorkStealingTaskProcessor(const WorkStealingTaskProcessor&) = delete;
+  WorkStealingTaskProcessor&
+  operator=(const WorkStealingTaskProcessor&) = delete;
+
+  virtual void startTask(std::function<void()> f) override;
+
+  virtual void startTaskWithPriority(
+      std::function<void()> f,
+      const TaskPriority& priority) override;
+
+  /**
+   * @brief Gets the number of threads that run tasks.
+   */
+  size_t getThreadCount() const noexcept { return this->_threads.size(); }
+
+private:
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  struct PrioritizedTask {
+    TaskPriority priority;
+    uint64_t sequenceNumber;
+    std::function<void()> f;
+  };
+
+  void notifyTaskQueued();
+  bool takeTask(size_t queueIndex, std::function<void()>& task);
+  void runTasks(size_t queueIndex);
+
+  std::vector<std::unique_ptr<TaskQueue>> _queues;
+  std::atomic<size_t> _nextQueue;
+
+  // A heap with the most important task at the front. Tasks of the same
+  // priority run in the order in which they were started.
+  std::mutex _prioritizedMutex;
+  std::vector<PrioritizedTask> _prioritizedTasks;
+  std::atomic<size_t> _prioritizedCount;
+  uint64_t _nextSequenceNumber;
+
+  // The number of tasks in all the queues. Threads only sleep when it is
+  // zero, and they are only woken when some are sleeping.
+  std::atomic<size_t> _queuedCount;
+  std::atomic<size_t> _sleepingCount;
+  std::mutex _sleepMutex;
+  std::condition_variable _tasksAvailable;
+  bool _stopping;
+
+  std::vector<std::thread> _threads;
+};
+
+} // namespace CesiumAsync
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "AsyncSystem.h"
+#include "Library.h"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+namespace CesiumAsync {
+
+/**
+ * @brief Calls a function for each index from 0 to `count - 1`, in parallel
+ * on the worker threads of the given async system, if there is one.
+ *
+ * Indices are claimed by whichever thread gets to them first, including the
+ * calling one. So if the worker threads are busy, the calling thread simply
+ * ends up doing all of the work itself rather than waiting for them. This
+ * returns once the function has returned for every index.
+ *
+ * The function must be safe to call concurrently for different indices. If it
+ * throws, the first exception is rethrown here after all of the calls finish.
+ */
+CESIUMASYNC_API void forEachInParallel(
+    const std::optional<AsyncSystem>& asyncSystem,
+    size_t count,
+    const std::function<void(size_t)>& function);
+
+} // namespace CesiumAsync
@@ -0,0 +1,134 @@
+#include "CesiumAsync/AdaptiveConcurrencyLimiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace CesiumAsync {
+
+namespace {
+
+AdaptiveConcurrencyLimiterOptions
+sanitize(AdaptiveConcurrencyLimiterOptions options) noexcept {
+  options.minimumLimit = std::max(options.minimumLimit, int32_t(1));
+  options.maximumLimit = std::max(options.maximumLimit, options.minimumLimit);
+  options.initialLimit = std::clamp(
+      options.initialLimit,
+      options.minimumLimit,
+      options.maximumLimit);
+  options.decreaseFactor = std::clamp(options.decreaseFactor, 0.0, 1.0);
+  options.latencyInflationThreshold =
+      std::max(options.latencyInflationThreshold, 1.0);
+  options.latencySmoothing = std::clamp(options.latencySmoothing, 0.0, 1.0);
+  return options;
+}
+
+// The baseline latency rises toward longer latencies this many times slower
+// than the smoothed latency follows them, so that it forgets the shortest
+// latency once the network changes, but not while latency is inflated for a
+// moment.
+const double baselineRecoverySlowdown = 100.0;
+
+} // namespace
+
+AdaptiveConcurrencyLimiter::AdaptiveConcurrencyLimiter(
+    const AdaptiveConcurrencyLimiterOptions& options) noexcept
+    : _options(sanitize(options)),
+      _mutex(),
+      _limit(double(this->_options.initialLimit)),
+      _smoothedLatency(0.0),
+      _baselineLatency(0.0),
+      _completionsSinceDecrease(std::numeric_limits<int32_t>::max()),
+      _throughputBytes(0),
+      _throughputStart(Clock::now()),
+      _bytesPerSecond(0.0) {}
+
+int32_t AdaptiveConcurrencyLimiter::getLimit() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return int32_t(this->_limit);
+}
+
+void AdaptiveConcurrencyLimiter::recordCompletion(
+    double latencySeconds,
+    int64_t bytes,
+    bool succeeded) noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->updateThroughput(bytes);
+  if (this->_completionsSinceDecrease < std::numeric_limits<int32_t>::max()) {
+    ++this->_completionsSinceDecrease;
+  }
+
+  if (!succeeded) {
+    this->decrease();
+    return;
+  }
+
+  const double latency = std::max(latencySeconds, 0.0);
+  const double smoothing = this->_options.latencySmoothing;
+  if (this->_smoothedLatency <= 0.0) {
+    this->_smoothedLatency = latency;
+    this->_baselineLatency = latency;
+  } else {
+    this->_smoothedLatency += (latency - this->_smoothedLatency) * smoothing;
+    if (latency < this->_baselineLatency) {
+      this->_baselineLatency = latency;
+    } else {
+      this->_baselineLatency += (latency - this->_baselineLatency) *
+                                smoothing / baselineRecoverySlowdown;
+    }
+  }
+
+  if (this->_baselineLatency > 0.0 &&
+      this->_smoothedLatency >
+          this->_baselineLatency * this->_options.latencyInflationThreshold) {
+    this->decrease();
+    return;
+  }
+
+  // Raise the limit by one for every limit's worth of completed requests.
+  this->_limit = std::min(
+      this->_limit + 1.0 / this->_limit,
+      double(this->_options.maximumLimit));
+}
+
+double AdaptiveConcurrencyLimiter::getSmoothedLatency() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_smoothedLatency;
+}
+
+double AdaptiveConcurrencyLimiter::getBaselineLatency() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_baselineLatency;
+}
+
+double AdaptiveConcurrencyLimiter::getBytesPerSecond() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_bytesPerSecond;
+}
+
+void AdaptiveConcurrencyLimiter::decrease() noexcept {
+  // The requests that were in flight during the last decrease still reflect
+  // the limit from before it.
+  if (double(this->_completionsSinceDecrease) < std::ceil(this->_limit)) {
+    return;
+  }
+
+  this->_limit = std::max(
+      this->_limit * this->_options.decreaseFactor,
+      double(this->_options.minimumLimit));
+  this->_completionsSinceDecrease = 0;
+}
+
+void AdaptiveConcurrencyLimiter::updateThroughput(int64_t bytes) noexcept {
+  this->_throughputBytes += std::max(bytes, int64_t(0));
+
+  const Clock::time_point now = Clock::now();
+  const std::chrono::duration<double> elapsed = now - this->_throughputStart;
+  if (elapsed.count() >= 1.0) {
+    this->_bytesPerSecond = double(this->_throughputBytes) / elapsed.count();
+    this->_throughputBytes = 0;
+    this->_throughputStart = now;
+  }
+}
+
+} // namespace CesiumAsync
@@ -0,0 +1,889 @@
+#include "CesiumAsync/ArchiveAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumUtility/Gunzip.h"
+#include "CesiumUtility/MemoryMappedFile.h"
+#include "CesiumUtility/SharedBytes.h"
+#include "FileUrl.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+using namespace CesiumUtility;
+
+namespace CesiumAsync {
+
+namespace {
+
+// The end of central directory record is 22 bytes, followed by a comment of
+// up to 65535 bytes, and may be preceded by the 20-byte Zip64 locator. The
+// tail of an archive that is read first is large enough for all of them.
+const size_t END_RECORD_SIZE = 22;
+const size_t ZIP64_LOCATOR_SIZE = 20;
+const size_t ZIP64_END_RECORD_SIZE = 56;
+const size_t TAIL_SIZE = ZIP64_LOCATOR_SIZE + END_RECORD_SIZE + 65535;
+const size_t CENTRAL_HEADER_SIZE = 46;
+const size_t LOCAL_HEADER_SIZE = 30;
+
+const uint32_t END_RECORD_SIGNATURE = 0x06054b50;
+const uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+const uint32_t ZIP64_END_RECORD_SIGNATURE = 0x06064b50;
+const uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+const uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+
+const uint16_t ZIP64_EXTRA_FIELD_ID = 0x0001;
+const uint16_t ENCRYPTED_FLAG = 0x0001;
+const uint16_t METHOD_STORED = 0;
+const uint16_t METHOD_DEFLATE = 8;
+
+// The values of the fields that are too small for their value, which is in
+// the Zip64 fields instead.
+const uint64_t SATURATED_16 = 0xFFFF;
+const uint64_t SATURATED_32 = 0xFFFFFFFF;
+
+uint64_t
+readUint(const gsl::span<const std::byte>& data, size_t offset, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; ++i) {
+    value |= std::to_integer<uint64_t>(data[offset + i]) << (8 * i);
+  }
+  return value;
+}
+
+uint16_t readUint16(const gsl::span<const std::byte>& data, size_t offset) {
+  return static_cast<uint16_t>(readUint(data, offset, 2));
+}
+
+uint32_t readUint32(const gsl::span<const std::byte>& data, size_t offset) {
+  return static_cast<uint32_t>(readUint(data, offset, 4));
+}
+
+uint64_t readUint64(const gsl::span<const std::byte>& data, size_t offset) {
+  return readUint(data, offset, 8);
+}
+
+std::runtime_error invalidArchive(const std::string& url) {
+  return std::runtime_error("The archive " + url + " is not a valid zip file.");
+}
+
+struct ArchiveEntry {
+  uint64_t localHeaderOffset;
+  uint64_t compressedSize;
+  uint64_t uncompressedSize;
+  uint16_t compressionMethod;
+  uint16_t extraFieldLength;
+  bool isEncrypted;
+};
+
+// An archive whose central directory was read, or the status code of the
+// request that failed to read it.
+struct Archive {
+  std::string url;
+  std::vector<IAssetAccessor::THeader> requestHeaders;
+  uint16_t statusCode = 200;
+
+  // The whole archive, when it is mapped into memory or the server sent all
+  // of it.
+  SharedBytes contents;
+
+  // The headers that are passed on to the responses for the files.
+  HttpHeaders headers;
+
+  std::unordered_map<std::string, ArchiveEntry> entries;
+};
+
+// Bytes that were read from an archive, or the status code of the request
+// that failed to read them.
+struct ArchiveRead {
+  uint16_t statusCode = 200;
+  SharedBytes bytes;
+
+  // The offset of the bytes in the archive.
+  uint64_t offset = 0;
+
+  // Whether the bytes are the whole archive, so there is nothing more to
+  // read.
+  bool isWholeArchive = false;
+
+  HttpHeaders headers;
+
+  bool contains(uint64_t start, uint64_t size) const noexcept {
+    const uint64_t available = this->bytes.getBytes().size();
+    return start >= this->offset && size <= available &&
+           start - this->offset <= available - size;
+  }
+};
+
+SharedBytes sliceRead(
+    const ArchiveRead& read,
+    uint64_t start,
+    uint64_t size,
+    const std::string& url) {
+  if (!read.contains(start, size)) {
+    throw invalidArchive(url);
+  }
+  return read.bytes.subrange(
+      static_cast<size_t>(start - read.offset),
+      static_cast<size_t>(size));
+}
+
+ArchiveRead readContents(const Archive& archive) {
+  ArchiveRead read;
+  read.bytes = archive.contents;
+  read.isWholeArchive = !archive.contents.getBytes().empty();
+  return read;
+}
+
+// Parses the first byte of a `Content-Range: bytes first-last/size` header.
+bool parseContentRangeStart(const std::string& value, uint64_t& start) {
+  const std::string unit = "bytes ";
+  if (value.compare(0, unit.size(), unit) != 0) {
+    return false;
+  }
+
+  const char* pFirst = value.c_str() + unit.size();
+  char* pEnd = nullptr;
+  start = std::strtoull(pFirst, &pEnd, 10);
+  return pEnd != pFirst && *pEnd == '-';
+}
+
+Future<ArchiveRead> requestRange(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const Archive& archive,
+    const std::string& range) {
+  std::vector<IAssetAccessor::THeader> headers = archive.requestHeaders;
+  headers.emplace_back("Range", "bytes=" + range);
+  return pAssetAccessor->get(asyncSystem, archive.url, headers)
+      .thenImmediately(
+          [url = archive.url](std::shared_ptr<IAssetRequest>&& pRequest) {
+            const IAssetResponse* pResponse = pRequest->response();
+            if (!pResponse) {
+              throw std::runtime_error(
+                  "The request for the archive " + url + " has no response.");
+            }
+
+            ArchiveRead read;
+            read.statusCode = pResponse->statusCode();
+            read.headers = pResponse->headers();
+            if (read.statusCode == 200) {
+              read.isWholeArchive = true;
+            } else if (read.statusCode == 206) {
+              auto it = read.headers.find("Content-Range");
+              if (it == read.headers.end() ||
+                  !parseContentRangeStart(it->second, read.offset)) {
+                throw std::runtime_error(
+                    "The response for the archive " + url +
+                    " has no valid Content-Range header.");
+              }
+              read.statusCode = 200;
+            } else {
+              return read;
+            }
+
+            const gsl::span<const std::byte> data = pResponse->data();
+            read.bytes = SharedBytes(std::move(pRequest), data);
+            return read;
+          });
+}
+
+// Reads a range of an archive, unless it is in the bytes that were already
+// read. The range must not be empty.
+Future<ArchiveRead> readRange(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const Archive& archive,
+    const ArchiveRead& known,
+    uint64_t start,
+    uint64_t size) {
+  if (known.isWholeArchive || known.contains(start, size)) {
+    return asyncSystem.createResolvedFuture(ArchiveRead(known));
+  }
+  return requestRange(
+      asyncSystem,
+      pAssetAccessor,
+      archive,
+      std::to_string(start) + "-" + std::to_string(start + size - 1));
+}
+
+struct DirectoryLocation {
+  uint64_t offset;
+  uint64_t size;
+  uint64_t entryCount;
+};
+
+std::optional<size_t> findEndRecord(const gsl::span<const std::byte>& tail) {
+  if (tail.size() < END_RECORD_SIZE) {
+    return std::nullopt;
+  }
+
+  // The record is found from the end, because its comment may contain
+  // anything, and the comment must reach the end of the archive.
+  for (size_t position = tail.size() - END_RECORD_SIZE;; --position) {
+    if (readUint32(tail, position) == END_RECORD_SIGNATURE &&
+        position + END_RECORD_SIZE + readUint16(tail, position + 20) ==
+            tail.size()) {
+      return position;
+    }
+    if (position == 0) {
+      return std::nullopt;
+    }
+  }
+}
+
+void readZip64ExtraField(
+    const gsl::span<const std::byte>& extra,
+    ArchiveEntry& entry) {
+  size_t position = 0;
+  while (extra.size() - position >= 4) {
+    const uint16_t id = readUint16(extra, position);
+    const size_t size = readUint16(extra, position + 2);
+    position += 4;
+    if (size > extra.size() - position) {
+      return;
+    }
+
+    if (id == ZIP64_EXTRA_FIELD_ID) {
+      // The field holds only the values that are saturated in the header, in
+      // this order.
+      const size_t end = position + size;
+      const auto readIfSaturated = [&extra, &position, end](uint64_t& value) {
+        if (value == SATURATED_32 && end - position >= 8) {
+          value = readUint64(extra, position);
+          position += 8;
+        }
+      };
+      readIfSaturated(entry.uncompressedSize);
+      readIfSaturated(entry.compressedSize);
+      readIfSaturated(entry.localHeaderOffset);
+      return;
+    }
+
+    position += size;
+  }
+}
+
+void readEntries(
+    Archive& archive,
+    const gsl::span<const std::byte>& directory,
+    uint64_t entryCount) {
+  archive.entries.reserve(static_cast<size_t>(
+      std::min(entryCount, uint64_t(directory.size()) / CENTRAL_HEADER_SIZE)));
+
+  size_t position = 0;
+  for (uint64_t i = 0; i < entryCount; ++i) {
+    if (directory.size() - position < CENTRAL_HEADER_SIZE ||
+        readUint32(directory, position) != CENTRAL_HEADER_SIGNATURE) {
+      throw invalidArchive(archive.url);
+    }
+
+    ArchiveEntry entry;
+    entry.isEncrypted =
+        (readUint16(directory, position + 8) & ENCRYPTED_FLAG) != 0;
+    entry.compressionMethod = readUint16(directory, position + 10);
+    entry.compressedSize = readUint32(directory, position + 20);
+    entry.uncompressedSize = readUint32(directory, position + 24);
+    entry.extraFieldLength = readUint16(directory, position + 30);
+    entry.localHeaderOffset = readUint32(directory, position + 42);
+
+    const size_t nameLength = readUint16(directory, position + 28);
+    const size_t commentLength = readUint16(directory, position + 32);
+    const size_t nameStart = position + CENTRAL_HEADER_SIZE;
+    if (directory.size() - nameStart <
+        nameLength + entry.extraFieldLength + commentLength) {
+      throw invalidArchive(archive.url);
+    }
+
+    readZip64ExtraField(
+        directory.subspan(nameStart + nameLength, entry.extraFieldLength),
+        entry);
+
+    std::string name(
+        reinterpret_cast<const char*>(directory.data() + nameStart),
+        nameLength);
+    if (!name.empty() && name.back() != '/') {
+      archive.entries.emplace(std::move(name), entry);
+    }
+
+    position = nameStart + nameLength + entry.extraFieldLength + commentLength;
+  }
+}
+
+Future<std::shared_ptr<Archive>> readDirectory(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    std::shared_ptr<Archive>&& pArchive,
+    const ArchiveRead& known,
+    const DirectoryLocation& location) {
+  if (location.entryCount == 0) {
+    return asyncSystem.createResolvedFuture(std::move(pArchive));
+  }
+
+  return readRange(
+             asyncSystem,
+             pAssetAccessor,
+             *pArchive,
+             known,
+             location.offset,
+             location.size)
+      .thenInWorkerThread(
+          [pArchive = std::move(pArchive), location](ArchiveRead&& read) {
+            if (read.statusCode != 200) {
+              pArchive->statusCode = read.statusCode;
+              return pArchive;
+            }
+
+            const SharedBytes directory =
+                sliceRead(read, location.offset, location.size, pArchive->url);
+            readEntries(*pArchive, directory.getBytes(), location.entryCount);
+            return pArchive;
+          });
+}
+
+// Finds the central directory from the tail of an archive, and reads it.
+Future<std::shared_ptr<Archive>> readTail(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    std::shared_ptr<Archive>&& pArchive,
+    ArchiveRead&& tail) {
+  if (tail.statusCode != 200) {
+    pArchive->statusCode = tail.statusCode;
+    return asyncSystem.createResolvedFuture(std::move(pArchive));
+  }
+
+  // A tail that starts at the start of the archive is the whole archive.
+  if (tail.offset == 0) {
+    tail.isWholeArchive = true;
+    pArchive->contents = tail.bytes;
+  }
+  for (const char* name : {"Cache-Control", "Expires", "Last-Modified"}) {
+    auto it = tail.headers.find(name);
+    if (it != tail.headers.end()) {
+      pArchive->headers.emplace(*it);
+    }
+  }
+
+  // The end record is only searched for in the tail, even when the whole
+  // archive was read.
+  const gsl::span<const std::byte> bytes = tail.bytes.getBytes();
+  const size_t searchStart =
+      bytes.size() > TAIL_SIZE ? bytes.size() - TAIL_SIZE : 0;
+  const std::optional<size_t> maybeEndRecord =
+      findEndRecord(bytes.subspan(searchStart));
+  if (!maybeEndRecord) {
+    throw invalidArchive(pArchive->url);
+  }
+
+  const size_t endRecord = searchStart + *maybeEndRecord;
+  const DirectoryLocation location{
+      readUint32(bytes, endRecord + 16),
+      readUint32(bytes, endRecord + 12),
+      readUint16(bytes, endRecord + 10)};
+  if (location.entryCount != SATURATED_16 && location.size != SATURATED_32 &&
+      location.offset != SATURATED_32) {
+    return readDirectory(
+        asyncSystem,
+        pAssetAccessor,
+        std::move(pArchive),
+        tail,
+        location);
+  }
+
+  // The location is in the Zip64 end record instead, which the Zip64 locator
+  // in front of the end record points to.
+  if (endRecord < ZIP64_LOCATOR_SIZE ||
+      readUint32(bytes, endRecord - ZIP64_LOCATOR_SIZE) !=
+          ZIP64_LOCATOR_SIGNATURE) {
+    throw invalidArchive(pArchive->url);
+  }
+
+  const uint64_t zip64Offset =
+      readUint64(bytes, endRecord - ZIP64_LOCATOR_SIZE + 8);
+  const Archive& archive = *pArchive;
+  return readRange(
+             asyncSystem,
+             pAssetAccessor,
+             archive,
+             tail,
+             zip64Offset,
+             ZIP64_END_RECORD_SIZE)
+      .thenImmediately([asyncSystem,
+                        pAssetAccessor,
+                        pArchive = std::move(pArchive),
+                        tail = std::move(tail),
+                        zip64Offset](ArchiveRead&& read) mutable {
+        if (read.statusCode != 200) {
+          pArchive->statusCode = read.statusCode;
+          return asyncSystem.createResolvedFuture(std::move(pArchive));
+        }
+
+        const SharedBytes recordBytes =
+            sliceRead(read, zip64Offset, ZIP64_END_RECORD_SIZE, pArchive->url);
+        const gsl::span<const std::byte> record = recordBytes.getBytes();
+        if (readUint32(record, 0) != ZIP64_END_RECORD_SIGNATURE) {
+          throw invalidArchive(pArchive->url);
+        }
+
+        const DirectoryLocation location{
+            readUint64(record, 48),
+            readUint64(record, 40),
+            readUint64(record, 32)};
+        return readDirectory(
+            asyncSystem,
+            pAssetAccessor,
+            std::move(pArchive),
+            tail,
+            location);
+      });
+}
+
+Future<std::shared_ptr<Archive>> loadArchive(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers) {
+  std::shared_ptr<Archive> pArchive = std::make_shared<Archive>();
+  pArchive->url = url;
+  pArchive->requestHeaders = headers;
+
+  if (isFileUrl(url)) {
+    return asyncSystem.runInWorkerThread(
+        [asyncSystem,
+         pAssetAccessor,
+         pArchive = std::move(pArchive)]() mutable {
+          std::shared_ptr<const MemoryMappedFile> pFile =
+              MemoryMappedFile::open(fileUrlToPath(pArchive->url));
+
+          ArchiveRead whole;
+          if (pFile) {
+            const gsl::span<const std::byte> data = pFile->getData();
+            whole.bytes = SharedBytes(std::move(pFile), data);
+            whole.isWholeArchive = true;
+          } else {
+            whole.statusCode = 404;
+          }
+
+          return readTail(
+              asyncSystem,
+              pAssetAccessor,
+              std::move(pArchive),
+              std::move(whole));
+        });
+  }
+
+  const Archive& archive = *pArchive;
+  return requestRange(
+             asyncSystem,
+             pAssetAccessor,
+             archive,
+             "-" + std::to_string(TAIL_SIZE))
+      .thenImmediately([asyncSystem,
+                        pAssetAccessor,
+                        pArchive = std::move(pArchive)](
+                           ArchiveRead&& tail) mutable {
+        return readTail(
+            asyncSystem,
+            pAssetAccessor,
+            std::move(pArchive),
+            std::move(tail));
+      });
+}
+
+// Reads the compressed data of a file, which follows its local header.
+Future<ArchiveRead> readCompressedData(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<const Archive>& pArchive,
+    const std::string& path,
+    const ArchiveEntry& entry) {
+  // The extra field of the local header is usually the same length as the
+  // one in the central directory, so the header and the data are read
+  // together. They are read again if the header turns out to be longer.
+  const uint64_t headerOffset = entry.localHeaderOffset;
+  const uint64_t expectedSize = LOCAL_HEADER_SIZE + path.size() +
+                                entry.extraFieldLength + entry.compressedSize;
+  return readRange(
+             asyncSystem,
+             pAssetAccessor,
+             *pArchive,
+             readContents(*pArchive),
+             headerOffset,
+             expectedSize)
+      .thenImmediately([asyncSystem, pAssetAccessor, pArchive, entry](
+                           ArchiveRead&& read) {
+        if (read.statusCode != 200) {
+          return asyncSystem.createResolvedFuture(std::move(read));
+        }
+
+        const SharedBytes headerBytes = sliceRead(
+            read,
+            entry.localHeaderOffset,
+            LOCAL_HEADER_SIZE,
+            pArchive->url);
+        const gsl::span<const std::byte> header = headerBytes.getBytes();
+        if (readUint32(header, 0) != LOCAL_HEADER_SIGNATURE) {
+          throw invalidArchive(pArchive->url);
+        }
+
+        const uint64_t dataOffset = entry.localHeaderOffset +
+                                    LOCAL_HEADER_SIZE + readUint16(header, 26) +
+                                    readUint16(header, 28);
+        if (entry.compressedSize == 0) {
+          return asyncSystem.createResolvedFuture(ArchiveRead());
+        }
+
+        return readRange(
+                   asyncSystem,
+                   pAssetAccessor,
+                   *pArchive,
+                   read,
+                   dataOffset,
+                   entry.compressedSize)
+            .thenImmediately(
+                [pArchive, entry, dataOffset](ArchiveRead&& dataRead) {
+                  if (dataRead.statusCode == 200) {
+                    dataRead.bytes = sliceRead(
+                        dataRead,
+                        dataOffset,
+                        entry.compressedSize,
+                        pArchive->url);
+                    dataRead.offset = dataOffset;
+                  }
+                  return std::move(dataRead);
+                });
+      });
+}
+
+class ArchiveFileResponse : public IAssetResponse {
+public:
+  ArchiveFileResponse(
+      uint16_t statusCode,
+      std::string&& contentType,
+      const HttpHeaders& headers,
+      SharedBytes&& data)
+      : _statusCode(statusCode),
+        _contentType(std::move(contentType)),
+        _headers(headers),
+        _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const noexcept override {
+    return this->_statusCode;
+  }
+
+  virtual std::string contentType() const override {
+    return this->_contentType;
+  }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const noexcept override {
+    return this->_data.getBytes();
+  }
+
+private:
+  uint16_t _statusCode;
+  std::string _contentType;
+  HttpHeaders _headers;
+  SharedBytes _data;
+};
+
+class ArchiveFileRequest : public IAssetRequest {
+public:
+  ArchiveFileRequest(
+      const std::string& url,
+      const std::vector<IAssetAccessor::THeader>& headers,
+      ArchiveFileResponse&& response)
+      : _method("GET"),
+        _url(url),
+        _headers(headers.begin(), headers.end()),
+        _response(std::move(response)) {}
+
+  virtual const std::string& method() const noexcept override {
+    return this->_method;
+  }
+
+  virtual const std::string& url() const noexcept override {
+    return this->_url;
+  }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const noexcept override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  ArchiveFileResponse _response;
+};
+
+std::string getContentType(const std::string& path) {
+  const std::string extension = ".json";
+  if (path.size() >= extension.size() &&
+      path.compare(
+          path.size() - extension.size(),
+          extension.size(),
+          extension) == 0) {
+    return "application/json";
+  }
+  return "application/octet-stream";
+}
+
+std::shared_ptr<IAssetRequest> createFileRequest(
+    const Archive& archive,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const std::string& path,
+    uint16_t statusCode,
+    SharedBytes&& data) {
+  return std::make_shared<ArchiveFileRequest>(
+      url,
+      headers,
+      ArchiveFileResponse(
+          statusCode,
+          getContentType(path),
+          statusCode == 200 ? archive.headers : HttpHeaders(),
+          std::move(data)));
+}
+
+Future<std::shared_ptr<IAssetRequest>> readFile(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<const Archive>& pArchive,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const std::string& path) {
+  if (pArchive->statusCode != 200) {
+    return asyncSystem.createResolvedFuture(createFileRequest(
+        *pArchive,
+        url,
+        headers,
+        path,
+        pArchive->statusCode,
+        SharedBytes()));
+  }
+
+  auto it = pArchive->entries.find(path);
+  if (it == pArchive->entries.end()) {
+    return asyncSystem.createResolvedFuture(
+        createFileRequest(*pArchive, url, headers, path, 404, SharedBytes()));
+  }
+
+  const ArchiveEntry entry = it->second;
+  if (entry.isEncrypted || (entry.compressionMethod != METHOD_STORED &&
+                            entry.compressionMethod != METHOD_DEFLATE)) {
+    throw std::runtime_error(
+        "The file " + path + " in the archive " + pArchive->url +
+        " is encrypted or compressed with an unsupported method.");
+  }
+
+  return readCompressedData(asyncSystem, pAssetAccessor, pArchive, path, entry)
+      .thenImmediately([asyncSystem, pArchive, url, headers, path, entry](
+                           ArchiveRead&& read) {
+        if (read.statusCode != 200) {
+          return asyncSystem.createResolvedFuture(createFileRequest(
+              *pArchive,
+              url,
+              headers,
+              path,
+              read.statusCode,
+              SharedBytes()));
+        }
+
+        if (entry.compressionMethod == METHOD_STORED) {
+          return asyncSystem.createResolvedFuture(createFileRequest(
+              *pArchive,
+              url,
+              headers,
+              path,
+              200,
+              std::move(read.bytes)));
+        }
+
+        return asyncSystem.runInWorkerThread(
+            [pArchive,
+             url,
+             headers,
+             path,
+             entry,
+             bytes = std::move(read.bytes)]() {
+              std::vector<std::byte> inflated;
+              if (!inflateRaw(
+                      bytes.getBytes(),
+                      static_cast<size_t>(entry.uncompressedSize),
+                      inflated)) {
+                throw std::runtime_error(
+                    "The file " + path + " in the archive " + pArchive->url +
+                    " could not be inflated.");
+              }
+
+              return createFileRequest(
+                  *pArchive,
+                  url,
+                  headers,
+                  path,
+                  200,
+                  SharedBytes::fromVector(std::move(inflated)));
+            });
+      });
+}
+
+struct ArchiveFileUrl {
+  std::string archiveUrl;
+  std::string path;
+};
+
+// Splits a URL at the first archive extension in its path that is followed
+// by a slash, into the URL of the archive, with the URL's query, and the path
+// of the file in the archive.
+std::optional<ArchiveFileUrl> splitArchiveFileUrl(
+    const std::string& url,
+    const std::vector<std::string>& archiveExtensions) {
+  const size_t pathEnd = std::min(url.find_first_of("?#"), url.size());
+
+  std::string lowerPath = url.substr(0, pathEnd);
+  for (char& c : lowerPath) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+
+  size_t archiveEnd = std::string::npos;
+  for (const std::string& extension : archiveExtensions) {
+    std::string lowerExtension = extension + "/";
+    for (char& c : lowerExtension) {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    // The extension must end the name of a file, rather than be the name.
+    size_t position = lowerPath.find(lowerExtension);
+    while (position != std::string::npos &&
+           (position == 0 || lowerPath[position - 1] == '/')) {
+      position = lowerPath.find(lowerExtension, position + 1);
+    }
+    if (position != std::string::npos) {
+      archiveEnd = std::min(archiveEnd, position + extension.size());
+    }
+  }
+
+  if (archiveEnd == std::string::npos) {
+    return std::nullopt;
+  }
+
+  const size_t queryEnd = std::min(url.find('#', pathEnd), url.size());
+  return ArchiveFileUrl{
+      url.substr(0, archiveEnd) + url.substr(pathEnd, queryEnd - pathEnd),
+      decodePercents(url.substr(archiveEnd + 1, pathEnd - archiveEnd - 1))};
+}
+
+} // namespace
+
+struct ArchiveAssetAccessor::Archives {
+  std::mutex mutex;
+  std::unordered_map<std::string, SharedFuture<std::shared_ptr<const Archive>>>
+      archives;
+};
+
+ArchiveAssetAccessor::ArchiveAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::vector<std::string>& archiveExtensions)
+    : _pAssetAccessor(pAssetAccessor),
+      _archiveExtensions(archiveExtensions),
+      _pArchives(std::make_shared<Archives>()) {}
+
+ArchiveAssetAccessor::~ArchiveAssetAccessor() noexcept {}
+
+Future<std::shared_ptr<IAssetRequest>> ArchiveAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  std::optional<ArchiveFileUrl> maybeFileUrl =
+      splitArchiveFileUrl(url, this->_archiveExtensions);
+  if (!maybeFileUrl) {
+    return this->_pAssetAccessor->get(asyncSystem, url, headers);
+  }
+
+  ArchiveFileUrl& fileUrl = *maybeFileUrl;
+  std::optional<Promise<std::shared_ptr<const Archive>>> promise;
+  std::optional<SharedFuture<std::shared_ptr<const Archive>>> future;
+  {
+    std::lock_guard<std::mutex> lock(this->_pArchives->mutex);
+    auto it = this->_pArchives->archives.find(fileUrl.archiveUrl);
+    if (it != this->_pArchives->archives.end()) {
+      future = it->second;
+    } else {
+      promise = asyncSystem.createPromise<std::shared_ptr<const Archive>>();
+      future = promise->getFuture().share();
+      this->_pArchives->archives.emplace(fileUrl.archiveUrl, *future);
+    }
+  }
+
+  if (promise) {
+    // An archive that could not be read is read again by later callers.
+    const auto forgetIfFailed = [pArchives = this->_pArchives,
+                                 archiveUrl = fileUrl.archiveUrl](bool failed) {
+      if (failed) {
+        std::lock_guard<std::mutex> lock(pArchives->mutex);
+        pArchives->archives.erase(archiveUrl);
+      }
+    };
+
+    loadArchive(asyncSystem, this->_pAssetAccessor, fileUrl.archiveUrl, headers)
+        .thenImmediately([forgetIfFailed, archivePromise = *promise](
+                             std::shared_ptr<Archive>&& pArchive) {
+          forgetIfFailed(pArchive->statusCode != 200);
+          archivePromise.resolve(
+              std::shared_ptr<const Archive>(std::move(pArchive)));
+        })
+        .catchImmediately(
+            [forgetIfFailed, archivePromise = *promise](std::exception&&) {
+              forgetIfFailed(true);
+              archivePromise.reject(std::current_exception());
+            });
+  }
+
+  return future->thenImmediately(
+      [asyncSystem,
+       pAssetAccessor = this->_pAssetAccessor,
+       url,
+       headers,
+       path = std::move(fileUrl.path)](
+          const std::shared_ptr<const Archive>& pArchive) {
+        return readFile(
+            asyncSystem,
+            pAssetAccessor,
+            pArchive,
+            url,
+            headers,
+            path);
+      });
+}
+
+Future<std::shared_ptr<IAssetRequest>> ArchiveAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  if (verb == "GET") {
+    return this->get(asyncSystem, url, headers);
+  }
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void ArchiveAssetAccessor::tick() noexcept { this->_pAssetAccessor->tick(); }
+
+} // namespace CesiumAsync
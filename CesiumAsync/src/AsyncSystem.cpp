@@ -2,6 +2,7 @@
 
 #include "CesiumAsync/ITaskProcessor.h"
 
+#include <chrono>
 #include <future>
 
 namespace CesiumAsync {
@@ -19,8 +20,32 @@ bool AsyncSystem::dispatchOneMainThreadTask() {
   return this->_pSchedulers->mainThread.dispatchZeroOrOneContinuation();
 }
 
-ThreadPool AsyncSystem::createThreadPool(int32_t numberOfThreads) const {
-  return ThreadPool(numberOfThreads);
+MainThreadDispatchResult
+AsyncSystem::dispatchMainThreadTasks(double budgetMilliseconds) {
+  using namespace std::chrono;
+
+  const steady_clock::time_point start = steady_clock::now();
+  const steady_clock::time_point end =
+      start + duration_cast<steady_clock::duration>(
+                  duration<double, std::milli>(budgetMilliseconds));
+
+  MainThreadDispatchResult result;
+  result.tasksDispatched =
+      this->_pSchedulers->mainThread.dispatchContinuationsUntil(end);
+  result.tasksRemaining = this->_pSchedulers->mainThread.getQueuedCount();
+  result.elapsedMilliseconds =
+      duration<double, std::milli>(steady_clock::now() - start).count();
+  return result;
+}
+
+size_t AsyncSystem::getMainThreadTaskCount() const noexcept {
+  return this->_pSchedulers->mainThread.getQueuedCount();
+}
+
+ThreadPool AsyncSystem::createThreadPool(
+    int32_t numberOfThreads,
+    const ThreadPoolOptions& options) const {
+  return ThreadPool(numberOfThreads, options);
 }
 
 bool AsyncSystem::operator==(const AsyncSystem& rhs) const noexcept {
@@ -0,0 +1,86 @@
+#include "CesiumAsync/BandwidthLimiter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CesiumAsync {
+
+BandwidthLimiter::BandwidthLimiter(
+    double bytesPerSecond,
+    int64_t burstBytes) noexcept
+    : _mutex(),
+      _bytesPerSecond(std::max(bytesPerSecond, 0.0)),
+      _burstBytes(std::max(burstBytes, int64_t(0))),
+      _availableBytes(double(this->_burstBytes)),
+      _lastRefill(Clock::now()),
+      _totalConsumedBytes(0) {}
+
+double BandwidthLimiter::getBytesPerSecond() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_bytesPerSecond;
+}
+
+void BandwidthLimiter::setBytesPerSecond(double bytesPerSecond) noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->refill();
+  this->_bytesPerSecond = std::max(bytesPerSecond, 0.0);
+}
+
+int64_t BandwidthLimiter::getBurstBytes() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_burstBytes;
+}
+
+void BandwidthLimiter::setBurstBytes(int64_t burstBytes) noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->refill();
+  this->_burstBytes = std::max(burstBytes, int64_t(0));
+  this->_availableBytes =
+      std::min(this->_availableBytes, double(this->_burstBytes));
+}
+
+void BandwidthLimiter::consume(int64_t bytes) noexcept {
+  if (bytes <= 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->refill();
+  this->_availableBytes -= double(bytes);
+  this->_totalConsumedBytes += bytes;
+}
+
+int64_t BandwidthLimiter::getAvailableBytes() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->refill();
+  return int64_t(std::floor(this->_availableBytes));
+}
+
+bool BandwidthLimiter::isExhausted() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->refill();
+  return this->_availableBytes < 1.0;
+}
+
+bool BandwidthLimiter::isFull() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->refill();
+  return this->_availableBytes >= double(this->_burstBytes);
+}
+
+int64_t BandwidthLimiter::getTotalConsumedBytes() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_totalConsumedBytes;
+}
+
+void BandwidthLimiter::refill() const noexcept {
+  const Clock::time_point now = Clock::now();
+  const double seconds =
+      std::chrono::duration<double>(now - this->_lastRefill).count();
+  this->_lastRefill = now;
+  this->_availableBytes = std::min(
+      this->_availableBytes + seconds * this->_bytesPerSecond,
+      double(this->_burstBytes));
+}
+
+} // namespace CesiumAsync
@@ -0,0 +1,98 @@
+#include "CesiumAsync/BandwidthLimitingAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/BandwidthLimiter.h"
+#include "CesiumAsync/IAssetResponse.h"
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace CesiumAsync {
+
+namespace {
+
+Future<std::shared_ptr<IAssetRequest>> consumeResponseData(
+    const std::shared_ptr<BandwidthLimiter>& pLimiter,
+    const std::shared_ptr<std::atomic<int64_t>>& pStreamedBytes,
+    Future<std::shared_ptr<IAssetRequest>>&& future) {
+  return std::move(future).thenImmediately(
+      [pLimiter, pStreamedBytes](
+          std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
+        const IAssetResponse* pResponse =
+            pCompletedRequest ? pCompletedRequest->response() : nullptr;
+        if (pResponse) {
+          // The streamed pieces were already taken as they arrived.
+          const int64_t streamedBytes =
+              pStreamedBytes ? pStreamedBytes->load() : int64_t(0);
+          pLimiter->consume(
+              int64_t(pResponse->data().size()) - streamedBytes);
+        }
+        return std::move(pCompletedRequest);
+      });
+}
+
+} // namespace
+
+BandwidthLimitingAssetAccessor::BandwidthLimitingAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<BandwidthLimiter>& pLimiter)
+    : _pAssetAccessor(pAssetAccessor), _pLimiter(pLimiter) {}
+
+BandwidthLimitingAssetAccessor::~BandwidthLimitingAssetAccessor() noexcept {}
+
+Future<std::shared_ptr<IAssetRequest>> BandwidthLimitingAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return consumeResponseData(
+      this->_pLimiter,
+      nullptr,
+      this->_pAssetAccessor->get(asyncSystem, url, headers));
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+BandwidthLimitingAssetAccessor::getStreaming(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const DataReceivedCallback& onDataReceived) {
+  std::shared_ptr<std::atomic<int64_t>> pStreamedBytes =
+      std::make_shared<std::atomic<int64_t>>(0);
+  DataReceivedCallback consumePiece =
+      [pLimiter = this->_pLimiter, pStreamedBytes, onDataReceived](
+          const gsl::span<const std::byte>& data) {
+        const int64_t bytes = int64_t(data.size());
+        *pStreamedBytes += bytes;
+        pLimiter->consume(bytes);
+
+        if (onDataReceived) {
+          onDataReceived(data);
+        }
+      };
+
+  return consumeResponseData(
+      this->_pLimiter,
+      pStreamedBytes,
+      this->_pAssetAccessor
+          ->getStreaming(asyncSystem, url, headers, consumePiece));
+}
+
+Future<std::shared_ptr<IAssetRequest>> BandwidthLimitingAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return consumeResponseData(
+      this->_pLimiter,
+      nullptr,
+      this->_pAssetAccessor
+          ->request(asyncSystem, verb, url, headers, contentPayload));
+}
+
+void BandwidthLimitingAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+} // namespace CesiumAsync
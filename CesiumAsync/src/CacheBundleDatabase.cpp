@@ -0,0 +1,292 @@
+#include "CesiumAsync/CacheBundleDatabase.h"
+
+#include "CacheBundleFormat.h"
+
+#include <CesiumUtility/MemoryMappedFile.h>
+#include <CesiumUtility/Tracing.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace CesiumAsync {
+
+struct CacheBundleDatabase::MappedFile {
+  std::shared_ptr<const CesiumUtility::MemoryMappedFile> pMapping;
+  const std::byte* pData = nullptr;
+  size_t size = 0;
+  uint64_t entryCount = 0;
+  uint64_t indexOffset = 0;
+};
+
+namespace {
+template <typename T> T readValue(const std::byte* pData) noexcept {
+  T value;
+  std::memcpy(&value, pData, sizeof(T));
+  return value;
+}
+
+// Reads a string of the given length from the entry, and moves past it.
+bool readString(
+    const std::byte*& pData,
+    const std::byte* pEnd,
+    uint32_t length,
+    std::string& result) {
+  if (size_t(pEnd - pData) < length) {
+    return false;
+  }
+  result.assign(reinterpret_cast<const char*>(pData), length);
+  pData += length;
+  return true;
+}
+
+bool readHeaders(
+    const std::byte*& pData,
+    const std::byte* pEnd,
+    uint32_t length,
+    HttpHeaders& headers) {
+  std::string serialized;
+  if (!readString(pData, pEnd, length, serialized)) {
+    return false;
+  }
+
+  // A name and a value for each header, each followed by a zero byte.
+  size_t position = 0;
+  while (position < serialized.size()) {
+    const size_t nameEnd = serialized.find('\0', position);
+    if (nameEnd == std::string::npos) {
+      return false;
+    }
+    const size_t valueEnd = serialized.find('\0', nameEnd + 1);
+    if (valueEnd == std::string::npos) {
+      return false;
+    }
+
+    headers.emplace(
+        serialized.substr(position, nameEnd - position),
+        serialized.substr(nameEnd + 1, valueEnd - nameEnd - 1));
+    position = valueEnd + 1;
+  }
+  return true;
+}
+} // namespace
+
+CacheBundleDatabase::CacheBundleDatabase(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& bundlePath,
+    const std::shared_ptr<ICacheDatabase>& pDatabase)
+    : _pLogger(pLogger),
+      _pFile(std::make_unique<MappedFile>()),
+      _pDatabase(pDatabase),
+      _mutex(),
+      _replacedKeys() {
+  MappedFile& file = *this->_pFile;
+  file.pMapping = CesiumUtility::MemoryMappedFile::open(bundlePath);
+  if (!file.pMapping) {
+    SPDLOG_LOGGER_ERROR(
+        this->_pLogger,
+        "Unable to open the cache bundle {}.",
+        bundlePath);
+    return;
+  }
+  file.pData = file.pMapping->getData().data();
+  file.size = file.pMapping->getData().size();
+
+  bool valid = file.size >= sizeof(CacheBundleFormat::Header);
+  if (valid) {
+    const CacheBundleFormat::Header header =
+        readValue<CacheBundleFormat::Header>(file.pData);
+    valid = std::equal(
+                std::begin(header.magic),
+                std::end(header.magic),
+                std::begin(CacheBundleFormat::MAGIC)) &&
+            header.version == CacheBundleFormat::VERSION &&
+            header.indexOffset <= file.size &&
+            header.entryCount <= (file.size - header.indexOffset) /
+                                     sizeof(CacheBundleFormat::IndexRecord);
+    if (valid) {
+      file.entryCount = header.entryCount;
+      file.indexOffset = header.indexOffset;
+    }
+  }
+
+  if (!valid) {
+    SPDLOG_LOGGER_ERROR(
+        this->_pLogger,
+        "The cache bundle {} is not valid.",
+        bundlePath);
+  }
+}
+
+CacheBundleDatabase::~CacheBundleDatabase() noexcept {}
+
+std::optional<CacheItem>
+CacheBundleDatabase::getEntry(const std::string& key) const {
+  CESIUM_TRACE("CacheBundleDatabase::getEntry");
+
+  bool replaced = false;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    replaced = this->_replacedKeys.find(key) != this->_replacedKeys.end();
+  }
+
+  if (!replaced) {
+    std::optional<CacheItem> item = this->findInBundle(key);
+    if (item) {
+      return item;
+    }
+  }
+
+  return this->_pDatabase->getEntry(key);
+}
+
+bool CacheBundleDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  CESIUM_TRACE("CacheBundleDatabase::storeEntry");
+
+  const bool stored = this->_pDatabase->storeEntry(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+
+  // The stored entry is newer than the one in the bundle.
+  if (stored && this->findInBundle(key)) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_replacedKeys.insert(key);
+  }
+
+  return stored;
+}
+
+bool CacheBundleDatabase::prune() { return this->_pDatabase->prune(); }
+
+bool CacheBundleDatabase::clearAll() {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_replacedKeys.clear();
+  }
+
+  return this->_pDatabase->clearAll();
+}
+
+uint64_t CacheBundleDatabase::getBundleEntryCount() const noexcept {
+  return this->_pFile->entryCount;
+}
+
+std::optional<CacheItem>
+CacheBundleDatabase::findInBundle(const std::string& key) const {
+  const MappedFile& file = *this->_pFile;
+  if (file.entryCount == 0) {
+    return std::nullopt;
+  }
+
+  // Find the first index record with the hash of the key.
+  const uint64_t keyHash = CacheBundleFormat::hashKey(key);
+  const std::byte* pIndex = file.pData + file.indexOffset;
+  const auto getRecord = [pIndex](uint64_t i) {
+    return readValue<CacheBundleFormat::IndexRecord>(
+        pIndex + i * sizeof(CacheBundleFormat::IndexRecord));
+  };
+
+  uint64_t first = 0;
+  uint64_t count = file.entryCount;
+  while (count > 0) {
+    const uint64_t step = count / 2;
+    if (getRecord(first + step).keyHash < keyHash) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+
+  for (uint64_t i = first; i < file.entryCount; ++i) {
+    const CacheBundleFormat::IndexRecord record = getRecord(i);
+    if (record.keyHash != keyHash) {
+      break;
+    }
+
+    if (record.offset > file.size ||
+        record.size > file.size - record.offset ||
+        record.size < sizeof(CacheBundleFormat::EntryHeader)) {
+      SPDLOG_LOGGER_ERROR(this->_pLogger, "The cache bundle is not valid.");
+      return std::nullopt;
+    }
+
+    const std::byte* pData = file.pData + record.offset;
+    const std::byte* pEnd = pData + record.size;
+    const CacheBundleFormat::EntryHeader entryHeader =
+        readValue<CacheBundleFormat::EntryHeader>(pData);
+    pData += sizeof(CacheBundleFormat::EntryHeader);
+
+    // Skip the entries whose keys only have the same hash.
+    std::string entryKey;
+    if (!readString(pData, pEnd, entryHeader.keyLength, entryKey)) {
+      SPDLOG_LOGGER_ERROR(this->_pLogger, "The cache bundle is not valid.");
+      return std::nullopt;
+    }
+    if (entryKey != key) {
+      continue;
+    }
+
+    std::string method;
+    std::string url;
+    HttpHeaders requestHeaders;
+    HttpHeaders responseHeaders;
+    if (!readString(pData, pEnd, entryHeader.methodLength, method) ||
+        !readString(pData, pEnd, entryHeader.urlLength, url) ||
+        !readHeaders(
+            pData,
+            pEnd,
+            entryHeader.requestHeadersLength,
+            requestHeaders) ||
+        !readHeaders(
+            pData,
+            pEnd,
+            entryHeader.responseHeadersLength,
+            responseHeaders)) {
+      SPDLOG_LOGGER_ERROR(this->_pLogger, "The cache bundle is not valid.");
+      return std::nullopt;
+    }
+
+    const uint64_t dataOffset = CacheBundleFormat::alignOffset(
+        static_cast<uint64_t>(pData - file.pData));
+    if (dataOffset > file.size ||
+        entryHeader.dataLength > uint64_t(pEnd - (file.pData + dataOffset))) {
+      SPDLOG_LOGGER_ERROR(this->_pLogger, "The cache bundle is not valid.");
+      return std::nullopt;
+    }
+
+    const std::byte* pResponseData = file.pData + dataOffset;
+    return CacheItem(
+        static_cast<std::time_t>(entryHeader.expiryTime),
+        CacheRequest(
+            std::move(requestHeaders),
+            std::move(method),
+            std::move(url)),
+        CacheResponse(
+            static_cast<uint16_t>(entryHeader.statusCode),
+            std::move(responseHeaders),
+            std::vector<std::byte>(
+                pResponseData,
+                pResponseData + entryHeader.dataLength)));
+  }
+
+  return std::nullopt;
+}
+
+} // namespace CesiumAsync
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace CesiumAsync {
+namespace CacheBundleFormat {
+
+// A bundle starts with a header, followed by the entries and then by the
+// index of the entries. Numbers are stored in the byte order of the machine
+// that wrote the bundle, which is little-endian on all supported platforms.
+// Everything is aligned to 8 bytes, so that a memory-mapped bundle can be read
+// in place.
+//
+// Each entry is an EntryHeader followed by the key, the request method, the
+// request URL, the request headers, the response headers, padding up to the
+// next multiple of 8 bytes, and the response data. Headers are stored as a
+// name and a value for each, each followed by a zero byte.
+//
+// The index has an IndexRecord for each entry, sorted by the hashes of their
+// keys.
+
+const char MAGIC[8] = {'C', 'E', 'S', 'B', 'N', 'D', 'L', '\0'};
+const uint32_t VERSION = 1;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t entryCount;
+  uint64_t indexOffset;
+};
+
+struct EntryHeader {
+  int64_t expiryTime;
+  uint32_t statusCode;
+  uint32_t keyLength;
+  uint32_t methodLength;
+  uint32_t urlLength;
+  uint32_t requestHeadersLength;
+  uint32_t responseHeadersLength;
+  uint64_t dataLength;
+};
+
+struct IndexRecord {
+  uint64_t keyHash;
+  uint64_t offset;
+  uint64_t size;
+};
+
+static_assert(sizeof(Header) == 32, "Unexpected bundle header size");
+static_assert(sizeof(EntryHeader) == 40, "Unexpected bundle entry size");
+static_assert(sizeof(IndexRecord) == 24, "Unexpected bundle index size");
+
+inline uint64_t alignOffset(uint64_t offset) noexcept {
+  return (offset + 7) & ~uint64_t(7);
+}
+
+// The 64-bit FNV-1a hash of a key.
+inline uint64_t hashKey(const std::string& key) noexcept {
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : key) {
+    hash ^= uint64_t(uint8_t(c));
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+} // namespace CacheBundleFormat
+} // namespace CesiumAsync
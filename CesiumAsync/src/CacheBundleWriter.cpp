@@ -0,0 +1,178 @@
+#include "CesiumAsync/CacheBundleWriter.h"
+
+#include "CacheBundleFormat.h"
+#include "CesiumAsync/SqliteCache.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <utility>
+
+namespace CesiumAsync {
+
+namespace {
+std::string serializeHeaders(const HttpHeaders& headers) {
+  std::string result;
+  for (const auto& [name, value] : headers) {
+    result += name;
+    result += '\0';
+    result += value;
+    result += '\0';
+  }
+  return result;
+}
+} // namespace
+
+CacheBundleWriter::CacheBundleWriter(const std::string& bundlePath)
+    : _bundlePath(bundlePath),
+      _temporaryPath(bundlePath + ".tmp"),
+      _file(this->_temporaryPath, std::ios::binary | std::ios::trunc),
+      _offset(0),
+      _index(),
+      _failed(!this->_file),
+      _finished(false) {
+  // The header is written again with the final counts by finish.
+  const CacheBundleFormat::Header header{};
+  this->write(&header, sizeof(header));
+}
+
+CacheBundleWriter::~CacheBundleWriter() noexcept {
+  if (!this->_finished) {
+    this->_file.close();
+    std::remove(this->_temporaryPath.c_str());
+  }
+}
+
+bool CacheBundleWriter::addEntry(
+    const std::string& key,
+    const CacheItem& item) {
+  if (this->_failed || this->_finished) {
+    return false;
+  }
+
+  const std::string requestHeaders =
+      serializeHeaders(item.cacheRequest.headers);
+  const std::string responseHeaders =
+      serializeHeaders(item.cacheResponse.headers);
+
+  const CacheBundleFormat::EntryHeader entryHeader{
+      static_cast<int64_t>(item.expiryTime),
+      uint32_t(item.cacheResponse.statusCode),
+      uint32_t(key.size()),
+      uint32_t(item.cacheRequest.method.size()),
+      uint32_t(item.cacheRequest.url.size()),
+      uint32_t(requestHeaders.size()),
+      uint32_t(responseHeaders.size()),
+      uint64_t(item.cacheResponse.data.size())};
+
+  const uint64_t offset = this->_offset;
+  this->write(&entryHeader, sizeof(entryHeader));
+  this->write(key.data(), key.size());
+  this->write(
+      item.cacheRequest.method.data(),
+      item.cacheRequest.method.size());
+  this->write(item.cacheRequest.url.data(), item.cacheRequest.url.size());
+  this->write(requestHeaders.data(), requestHeaders.size());
+  this->write(responseHeaders.data(), responseHeaders.size());
+  this->pad();
+  this->write(
+      item.cacheResponse.data.data(),
+      item.cacheResponse.data.size());
+  this->pad();
+
+  if (this->_failed) {
+    return false;
+  }
+
+  this->_index.push_back(IndexRecord{
+      CacheBundleFormat::hashKey(key),
+      offset,
+      this->_offset - offset});
+  return true;
+}
+
+bool CacheBundleWriter::addEntries(const SqliteCache& cache) {
+  CESIUM_TRACE("CacheBundleWriter::addEntries");
+  bool added = true;
+  const bool read = cache.forEachEntry(
+      [this, &added](const std::string& key, CacheItem&& item) {
+        added = this->addEntry(key, item) && added;
+      });
+  return read && added;
+}
+
+bool CacheBundleWriter::finish() {
+  CESIUM_TRACE("CacheBundleWriter::finish");
+  if (this->_failed || this->_finished) {
+    return false;
+  }
+
+  // Entries with the same key hash stay in the order in which they were
+  // added.
+  std::stable_sort(
+      this->_index.begin(),
+      this->_index.end(),
+      [](const IndexRecord& lhs, const IndexRecord& rhs) {
+        return lhs.keyHash < rhs.keyHash;
+      });
+
+  const uint64_t indexOffset = this->_offset;
+  for (const IndexRecord& record : this->_index) {
+    const CacheBundleFormat::IndexRecord indexRecord{
+        record.keyHash,
+        record.offset,
+        record.size};
+    this->write(&indexRecord, sizeof(indexRecord));
+  }
+
+  CacheBundleFormat::Header header{};
+  std::copy(
+      std::begin(CacheBundleFormat::MAGIC),
+      std::end(CacheBundleFormat::MAGIC),
+      std::begin(header.magic));
+  header.version = CacheBundleFormat::VERSION;
+  header.entryCount = this->_index.size();
+  header.indexOffset = indexOffset;
+  this->_file.seekp(0);
+  this->write(&header, sizeof(header));
+
+  this->_file.close();
+  this->_finished = true;
+  if (this->_failed || !this->_file) {
+    std::remove(this->_temporaryPath.c_str());
+    return false;
+  }
+
+  std::error_code error;
+  std::filesystem::rename(this->_temporaryPath, this->_bundlePath, error);
+  if (error) {
+    std::remove(this->_temporaryPath.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+void CacheBundleWriter::write(const void* pData, size_t size) {
+  if (this->_failed || size == 0) {
+    return;
+  }
+
+  this->_file.write(
+      static_cast<const char*>(pData),
+      static_cast<std::streamsize>(size));
+  this->_offset += size;
+  if (!this->_file) {
+    this->_failed = true;
+  }
+}
+
+void CacheBundleWriter::pad() {
+  const char zeros[8] = {};
+  const uint64_t alignedOffset = CacheBundleFormat::alignOffset(this->_offset);
+  this->write(zeros, size_t(alignedOffset - this->_offset));
+}
+
+} // namespace CesiumAsync
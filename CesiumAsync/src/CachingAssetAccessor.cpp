@@ -3,6 +3,8 @@
 #include "CesiumAsync/AsyncSystem.h"
 #include "CesiumAsync/CacheItem.h"
 #include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/Promise.h"
+#include "CesiumAsync/SharedFuture.h"
 #include "InternalTimegm.h"
 #include "ResponseCacheControl.h"
 
@@ -10,8 +12,14 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <exception>
 #include <iomanip>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 namespace CesiumAsync {
 class CacheAssetResponse : public IAssetResponse {
@@ -66,23 +74,83 @@ public:
     return &this->_response;
   }
 
+  virtual std::vector<std::byte> takeResponseData() override {
+    return std::exchange(this->_cacheItem.cacheResponse.data, {});
+  }
+
 private:
   CacheItem _cacheItem;
   CacheAssetResponse _response;
 };
 
+// The result of a request that is shared by several callers. Each of them
+// takes a copy of the response data, so that the others still find it.
+class SharedAssetRequest : public IAssetRequest {
+public:
+  SharedAssetRequest(const std::shared_ptr<IAssetRequest>& pRequest) noexcept
+      : _pRequest(pRequest) {}
+
+  virtual const std::string& method() const noexcept override {
+    return this->_pRequest->method();
+  }
+
+  virtual const std::string& url() const noexcept override {
+    return this->_pRequest->url();
+  }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_pRequest->headers();
+  }
+
+  virtual const IAssetResponse* response() const noexcept override {
+    return this->_pRequest->response();
+  }
+
+private:
+  std::shared_ptr<IAssetRequest> _pRequest;
+};
+
+struct InFlightResult {
+  std::shared_ptr<IAssetRequest> pRequest;
+  int32_t callerCount;
+};
+
+struct CachingAssetAccessor::InFlightRequests {
+  struct Request {
+    SharedFuture<InFlightResult> future;
+    int32_t callerCount;
+  };
+
+  std::mutex mutex;
+  std::unordered_map<std::string, Request> requests;
+
+  // The URLs of the stale cache items that are revalidated in the background.
+  std::unordered_set<std::string> revalidatingUrls;
+};
+
+struct CachingAssetAccessor::StatisticsCounters {
+  std::atomic<int64_t> hitCount{0};
+  std::atomic<int64_t> missCount{0};
+  std::atomic<int64_t> revalidationCount{0};
+  std::atomic<int64_t> staleHitCount{0};
+};
+
+static std::string calculateInFlightKey(
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers);
+
 static std::time_t convertHttpDateToTime(const std::string& httpDate);
 
 static bool shouldRevalidateCache(const CacheItem& cacheItem);
 
 static bool isCacheStale(const CacheItem& cacheItem) noexcept;
 
+static bool canServeStaleCache(const CacheItem& cacheItem);
+
 static bool shouldCacheRequest(
     const IAssetRequest& request,
     const std::optional<ResponseCacheControl>& cacheControl);
 
-static std::string calculateCacheKey(const IAssetRequest& request);
-
 static std::time_t calculateExpiryTime(
     const IAssetRequest& request,
     const std::optional<ResponseCacheControl>& cacheControl);
@@ -90,20 +158,53 @@ static std::time_t calculateExpiryTime(
 static std::unique_ptr<IAssetRequest>
 updateCacheItem(CacheItem&& cacheItem, const IAssetRequest& request);
 
+static Future<std::shared_ptr<IAssetRequest>> revalidateCacheItem(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const ThreadPool& threadPool,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const std::string& cacheKey,
+    CacheItem&& cacheItem);
+
+static std::string removeQueryParameters(
+    const std::string& url,
+    const std::vector<std::string>& parameterNames);
+
 CachingAssetAccessor::CachingAssetAccessor(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
     const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
-    int32_t requestsPerCachePrune)
+    int32_t requestsPerCachePrune,
+    bool staleWhileRevalidate,
+    const CacheKeyFunction& cacheKeyFunction)
     : _requestsPerCachePrune(requestsPerCachePrune),
       _requestSinceLastPrune(0),
       _pLogger(pLogger),
       _pAssetAccessor(pAssetAccessor),
       _pCacheDatabase(pCacheDatabase),
-      _cacheThreadPool(1) {}
+      _cacheThreadPool(
+          1,
+          {"Cesium cache", ThreadQualityOfService::Background, {}, -1}),
+      _pInFlightRequests(std::make_shared<InFlightRequests>()),
+      _staleWhileRevalidate(staleWhileRevalidate),
+      _cacheKeyFunction(cacheKeyFunction),
+      _pStatisticsCounters(std::make_shared<StatisticsCounters>()) {}
 
 CachingAssetAccessor::~CachingAssetAccessor() noexcept {}
 
+CachingAssetAccessor::CacheKeyFunction
+CachingAssetAccessor::ignoreQueryParameters(
+    const std::vector<std::string>& parameterNames) {
+  return [parameterNames](
+             const std::string& url,
+             const std::vector<THeader>& /*headers*/) {
+    return removeQueryParameters(url, parameterNames);
+  };
+}
+
 Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::get(
     const AsyncSystem& asyncSystem,
     const std::string& url,
@@ -120,10 +221,71 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::get(
     });
   }
 
+  std::string key = calculateInFlightKey(url, headers);
+  std::optional<Promise<InFlightResult>> promise;
+  std::optional<SharedFuture<InFlightResult>> future;
+  {
+    std::lock_guard<std::mutex> lock(this->_pInFlightRequests->mutex);
+    auto it = this->_pInFlightRequests->requests.find(key);
+    if (it != this->_pInFlightRequests->requests.end()) {
+      ++it->second.callerCount;
+      future = it->second.future;
+    } else {
+      promise = asyncSystem.createPromise<InFlightResult>();
+      future = promise->getFuture().share();
+      this->_pInFlightRequests->requests.emplace(
+          key,
+          InFlightRequests::Request{*future, 1});
+    }
+  }
+
+  if (promise) {
+    // Once the request completes, later callers make a new one.
+    const auto finish = [pInFlightRequests = this->_pInFlightRequests,
+                         key](std::shared_ptr<IAssetRequest>&& pRequest) {
+      std::lock_guard<std::mutex> lock(pInFlightRequests->mutex);
+      auto it = pInFlightRequests->requests.find(key);
+      const int32_t callerCount = it->second.callerCount;
+      pInFlightRequests->requests.erase(it);
+      return InFlightResult{std::move(pRequest), callerCount};
+    };
+
+    this->getFromCacheOrAccessor(asyncSystem, url, headers)
+        .thenImmediately(
+            [finish, resultPromise = *promise](
+                std::shared_ptr<IAssetRequest>&& pRequest) {
+              resultPromise.resolve(finish(std::move(pRequest)));
+            })
+        .catchImmediately(
+            [finish, resultPromise = *promise](std::exception&&) {
+              finish(nullptr);
+              resultPromise.reject(std::current_exception());
+            });
+  }
+
+  return future->thenImmediately([](const InFlightResult& result) {
+    if (result.callerCount == 1) {
+      return result.pRequest;
+    }
+    return std::shared_ptr<IAssetRequest>(
+        std::make_shared<SharedAssetRequest>(result.pRequest));
+  });
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+CachingAssetAccessor::getFromCacheOrAccessor(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
   CESIUM_TRACE_BEGIN_IN_TRACK("IAssetAccessor::get (cached)");
 
   const ThreadPool& threadPool = this->_cacheThreadPool;
 
+  // The response is stored under the key of the request, rather than that of
+  // its final URL, so that it is found by the next request.
+  std::string cacheKey =
+      this->_cacheKeyFunction ? this->_cacheKeyFunction(url, headers) : url;
+
   return asyncSystem
       .runInThreadPool(
           this->_cacheThreadPool,
@@ -131,17 +293,22 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::get(
            pAssetAccessor = this->_pAssetAccessor,
            pCacheDatabase = this->_pCacheDatabase,
            pLogger = this->_pLogger,
+           pInFlightRequests = this->_pInFlightRequests,
+           pStatisticsCounters = this->_pStatisticsCounters,
+           staleWhileRevalidate = this->_staleWhileRevalidate,
            url,
            headers,
+           cacheKey = std::move(cacheKey),
            threadPool]() -> Future<std::shared_ptr<IAssetRequest>> {
             std::optional<CacheItem> cacheLookup =
-                pCacheDatabase->getEntry(url);
+                pCacheDatabase->getEntry(cacheKey);
             if (!cacheLookup) {
               // No cache item found, request directly from the server
+              ++pStatisticsCounters->missCount;
               return pAssetAccessor->get(asyncSystem, url, headers)
                   .thenInThreadPool(
                       threadPool,
-                      [pCacheDatabase, pLogger](
+                      [pCacheDatabase, pLogger, cacheKey](
                           std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
                         const IAssetResponse* pResponse =
                             pCompletedRequest->response();
@@ -157,7 +324,7 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::get(
                                              *pCompletedRequest,
                                              cacheControl)) {
                           pCacheDatabase->storeEntry(
-                              calculateCacheKey(*pCompletedRequest),
+                              cacheKey,
                               calculateExpiryTime(
                                   *pCompletedRequest,
                                   cacheControl),
@@ -177,72 +344,58 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::get(
 
             if (shouldRevalidateCache(cacheItem)) {
               // Cache is stale and needs revalidation
-              std::vector<THeader> newHeaders = headers;
-              const CacheResponse& cacheResponse = cacheItem.cacheResponse;
-              const HttpHeaders& responseHeaders = cacheResponse.headers;
-              HttpHeaders::const_iterator etagHeader =
-                  responseHeaders.find("Etag");
-              if (etagHeader != responseHeaders.end()) {
-                newHeaders.emplace_back("If-None-Match", etagHeader->second);
+              if (staleWhileRevalidate && canServeStaleCache(cacheItem)) {
+                // Serve the stale item now, and revalidate it in the
+                // background, unless another request does that already.
+                ++pStatisticsCounters->staleHitCount;
+                bool revalidating = false;
+                {
+                  std::lock_guard<std::mutex> lock(pInFlightRequests->mutex);
+                  revalidating =
+                      !pInFlightRequests->revalidatingUrls.insert(url).second;
+                }
+
+                if (!revalidating) {
+                  const auto finish = [pInFlightRequests, url]() {
+                    std::lock_guard<std::mutex> lock(pInFlightRequests->mutex);
+                    pInFlightRequests->revalidatingUrls.erase(url);
+                  };
+                  revalidateCacheItem(
+                      asyncSystem,
+                      pAssetAccessor,
+                      pCacheDatabase,
+                      pLogger,
+                      threadPool,
+                      url,
+                      headers,
+                      cacheKey,
+                      CacheItem(cacheItem))
+                      .thenImmediately(
+                          [finish](std::shared_ptr<IAssetRequest>&&) {
+                            finish();
+                          })
+                      .catchImmediately(
+                          [finish](std::exception&&) { finish(); });
+                }
               } else {
-                HttpHeaders::const_iterator lastModifiedHeader =
-                    responseHeaders.find("Last-Modified");
-                if (lastModifiedHeader != responseHeaders.end())
-                  newHeaders.emplace_back(
-                      "If-Modified-Since",
-                      lastModifiedHeader->second);
+                ++pStatisticsCounters->revalidationCount;
+                return revalidateCacheItem(
+                    asyncSystem,
+                    pAssetAccessor,
+                    pCacheDatabase,
+                    pLogger,
+                    threadPool,
+                    url,
+                    headers,
+                    cacheKey,
+                    std::move(cacheItem));
               }
-
-              return pAssetAccessor->get(asyncSystem, url, newHeaders)
-                  .thenInThreadPool(
-                      threadPool,
-                      [cacheItem = std::move(cacheItem),
-                       pCacheDatabase,
-                       pLogger](std::shared_ptr<IAssetRequest>&&
-                                    pCompletedRequest) mutable {
-                        if (!pCompletedRequest) {
-                          return std::move(pCompletedRequest);
-                        }
-
-                        std::shared_ptr<IAssetRequest> pRequestToStore;
-                        if (pCompletedRequest->response()->statusCode() ==
-                            304) { // status Not-Modified
-                          pRequestToStore = updateCacheItem(
-                              std::move(cacheItem),
-                              *pCompletedRequest);
-                        } else {
-                          pRequestToStore = pCompletedRequest;
-                        }
-
-                        const IAssetResponse* pResponseToStore =
-                            pRequestToStore->response();
-                        const std::optional<ResponseCacheControl> cacheControl =
-                            ResponseCacheControl::parseFromResponseHeaders(
-                                pResponseToStore->headers());
-
-                        if (shouldCacheRequest(
-                                *pRequestToStore,
-                                cacheControl)) {
-
-                          pCacheDatabase->storeEntry(
-                              calculateCacheKey(*pRequestToStore),
-                              calculateExpiryTime(
-                                  *pRequestToStore,
-                                  cacheControl),
-                              pRequestToStore->url(),
-                              pRequestToStore->method(),
-                              pRequestToStore->headers(),
-                              pResponseToStore->statusCode(),
-                              pResponseToStore->headers(),
-                              pResponseToStore->data());
-                        }
-
-                        return pRequestToStore;
-                      });
+            } else {
+              ++pStatisticsCounters->hitCount;
             }
 
-            // Good cache item that doesn't need to be revalidated, just return
-            // it.
+            // Good cache item that doesn't need to be revalidated, or a stale
+            // one that is served while it is revalidated, just return it.
             std::shared_ptr<IAssetRequest> pRequest =
                 std::make_shared<CacheAssetRequest>(std::move(cacheItem));
             return asyncSystem.createResolvedFuture(std::move(pRequest));
@@ -265,6 +418,17 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::request(
 
 void CachingAssetAccessor::tick() noexcept { _pAssetAccessor->tick(); }
 
+CachingAssetAccessorStatistics
+CachingAssetAccessor::getStatistics() const noexcept {
+  CachingAssetAccessorStatistics statistics;
+  statistics.hitCount = this->_pStatisticsCounters->hitCount;
+  statistics.missCount = this->_pStatisticsCounters->missCount;
+  statistics.revalidationCount =
+      this->_pStatisticsCounters->revalidationCount;
+  statistics.staleHitCount = this->_pStatisticsCounters->staleHitCount;
+  return statistics;
+}
+
 bool shouldRevalidateCache(const CacheItem& cacheItem) {
   std::optional<ResponseCacheControl> cacheControl =
       ResponseCacheControl::parseFromResponseHeaders(
@@ -282,6 +446,29 @@ bool isCacheStale(const CacheItem& cacheItem) noexcept {
   return std::difftime(cacheItem.expiryTime, currentTime) < 0.0;
 }
 
+bool canServeStaleCache(const CacheItem& cacheItem) {
+  std::optional<ResponseCacheControl> cacheControl =
+      ResponseCacheControl::parseFromResponseHeaders(
+          cacheItem.cacheResponse.headers);
+  if (cacheControl) {
+    if (cacheControl->noCache() || cacheControl->mustRevalidate()) {
+      return false;
+    }
+
+    // https://developer.mozilla.org/en-US/docs/Web/HTTP/Headers/Cache-Control
+    //
+    // The stale-while-revalidate response directive indicates that the cache
+    // could reuse a stale response while it revalidates it, for the given
+    // number of seconds after it becomes stale.
+    if (cacheControl->staleWhileRevalidateExists()) {
+      return std::difftime(std::time(nullptr), cacheItem.expiryTime) <=
+             double(cacheControl->staleWhileRevalidateValue());
+    }
+  }
+
+  return true;
+}
+
 bool shouldCacheRequest(
     const IAssetRequest& request,
     const std::optional<ResponseCacheControl>& cacheControl) {
@@ -362,9 +549,60 @@ bool shouldCacheRequest(
   return false;
 }
 
-std::string calculateCacheKey(const IAssetRequest& request) {
-  // TODO: more complete cache key
-  return request.url();
+std::string calculateInFlightKey(
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers) {
+  // Requests with the same headers in a different order are the same.
+  std::vector<IAssetAccessor::THeader> sortedHeaders = headers;
+  std::sort(sortedHeaders.begin(), sortedHeaders.end());
+
+  std::string key = url;
+  for (const IAssetAccessor::THeader& header : sortedHeaders) {
+    key += '\n';
+    key += header.first;
+    key += ": ";
+    key += header.second;
+  }
+  return key;
+}
+
+std::string removeQueryParameters(
+    const std::string& url,
+    const std::vector<std::string>& parameterNames) {
+  const size_t queryStart = url.find('?');
+  if (queryStart == std::string::npos) {
+    return url;
+  }
+
+  const size_t fragmentStart = url.find('#', queryStart);
+  const size_t queryEnd =
+      fragmentStart == std::string::npos ? url.size() : fragmentStart;
+
+  std::string result = url.substr(0, queryStart);
+  char separator = '?';
+  size_t position = queryStart + 1;
+  while (position < queryEnd) {
+    size_t parameterEnd = url.find('&', position);
+    if (parameterEnd == std::string::npos || parameterEnd > queryEnd) {
+      parameterEnd = queryEnd;
+    }
+
+    const std::string parameter =
+        url.substr(position, parameterEnd - position);
+    const std::string name = parameter.substr(0, parameter.find('='));
+    if (!parameter.empty() &&
+        std::find(parameterNames.begin(), parameterNames.end(), name) ==
+            parameterNames.end()) {
+      result += separator;
+      result += parameter;
+      separator = '&';
+    }
+
+    position = parameterEnd + 1;
+  }
+
+  result += url.substr(queryEnd);
+  return result;
 }
 
 std::time_t calculateExpiryTime(
@@ -395,6 +633,69 @@ std::time_t calculateExpiryTime(
   }
 }
 
+Future<std::shared_ptr<IAssetRequest>> revalidateCacheItem(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const ThreadPool& threadPool,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const std::string& cacheKey,
+    CacheItem&& cacheItem) {
+  std::vector<IAssetAccessor::THeader> newHeaders = headers;
+  const CacheResponse& cacheResponse = cacheItem.cacheResponse;
+  const HttpHeaders& responseHeaders = cacheResponse.headers;
+  HttpHeaders::const_iterator etagHeader = responseHeaders.find("Etag");
+  if (etagHeader != responseHeaders.end()) {
+    newHeaders.emplace_back("If-None-Match", etagHeader->second);
+  } else {
+    HttpHeaders::const_iterator lastModifiedHeader =
+        responseHeaders.find("Last-Modified");
+    if (lastModifiedHeader != responseHeaders.end())
+      newHeaders.emplace_back("If-Modified-Since", lastModifiedHeader->second);
+  }
+
+  return pAssetAccessor->get(asyncSystem, url, newHeaders)
+      .thenInThreadPool(
+          threadPool,
+          [cacheItem = std::move(cacheItem), pCacheDatabase, pLogger, cacheKey](
+              std::shared_ptr<IAssetRequest>&& pCompletedRequest) mutable {
+            if (!pCompletedRequest) {
+              return std::move(pCompletedRequest);
+            }
+
+            std::shared_ptr<IAssetRequest> pRequestToStore;
+            if (pCompletedRequest->response()->statusCode() ==
+                304) { // status Not-Modified
+              pRequestToStore =
+                  updateCacheItem(std::move(cacheItem), *pCompletedRequest);
+            } else {
+              pRequestToStore = pCompletedRequest;
+            }
+
+            const IAssetResponse* pResponseToStore =
+                pRequestToStore->response();
+            const std::optional<ResponseCacheControl> cacheControl =
+                ResponseCacheControl::parseFromResponseHeaders(
+                    pResponseToStore->headers());
+
+            if (shouldCacheRequest(*pRequestToStore, cacheControl)) {
+              pCacheDatabase->storeEntry(
+                  cacheKey,
+                  calculateExpiryTime(*pRequestToStore, cacheControl),
+                  pRequestToStore->url(),
+                  pRequestToStore->method(),
+                  pRequestToStore->headers(),
+                  pResponseToStore->statusCode(),
+                  pResponseToStore->headers(),
+                  pResponseToStore->data());
+            }
+
+            return pRequestToStore;
+          });
+}
+
 std::unique_ptr<IAssetRequest>
 updateCacheItem(CacheItem&& cacheItem, const IAssetRequest& request) {
   for (const std::pair<const std::string, std::string>& header :
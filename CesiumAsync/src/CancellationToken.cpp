@@ -0,0 +1,17 @@
+#include "CesiumAsync/CancellationToken.h"
+
+namespace CesiumAsync {
+
+OperationCanceledException::OperationCanceledException()
+    : std::runtime_error("The operation was canceled.") {}
+
+void CancellationToken::throwIfCanceled() const {
+  if (this->isCanceled()) {
+    throw OperationCanceledException();
+  }
+}
+
+CancellationSource::CancellationSource()
+    : _pCanceled(std::make_shared<std::atomic<bool>>(false)) {}
+
+} // namespace CesiumAsync
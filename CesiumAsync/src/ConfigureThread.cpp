@@ -0,0 +1,226 @@
+#include "ConfigureThread.h"
+
+#include <string>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <pthread/qos.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace CesiumAsync {
+
+namespace {
+
+#if defined(_WIN32)
+
+void setName(const std::string& name) {
+  // SetThreadDescription is only available from Windows 10, version 1607.
+  using SetThreadDescriptionFunction = HRESULT(WINAPI*)(HANDLE, PCWSTR);
+  const HMODULE kernel32 = GetModuleHandleW(L"kernel32.dll");
+  if (kernel32 == nullptr) {
+    return;
+  }
+  const SetThreadDescriptionFunction pSetThreadDescription =
+      reinterpret_cast<SetThreadDescriptionFunction>(reinterpret_cast<void*>(
+          GetProcAddress(kernel32, "SetThreadDescription")));
+  if (pSetThreadDescription == nullptr) {
+    return;
+  }
+
+  const int length = MultiByteToWideChar(
+      CP_UTF8,
+      0,
+      name.c_str(),
+      static_cast<int>(name.size()),
+      nullptr,
+      0);
+  std::wstring wideName(static_cast<size_t>(length), L'\0');
+  MultiByteToWideChar(
+      CP_UTF8,
+      0,
+      name.c_str(),
+      static_cast<int>(name.size()),
+      wideName.data(),
+      length);
+  pSetThreadDescription(GetCurrentThread(), wideName.c_str());
+}
+
+void setQualityOfService(ThreadQualityOfService qualityOfService) {
+  switch (qualityOfService) {
+  case ThreadQualityOfService::Background:
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+    break;
+  case ThreadQualityOfService::Utility:
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+    break;
+  case ThreadQualityOfService::Default:
+  case ThreadQualityOfService::UserInitiated:
+    break;
+  }
+}
+
+void setAffinity(const std::vector<uint32_t>& cpus) {
+  DWORD_PTR mask = 0;
+  for (const uint32_t cpu : cpus) {
+    if (cpu < sizeof(DWORD_PTR) * 8) {
+      mask |= DWORD_PTR(1) << cpu;
+    }
+  }
+  if (mask != 0) {
+    SetThreadAffinityMask(GetCurrentThread(), mask);
+  }
+}
+
+void setNumaNode(int32_t numaNode) {
+  GROUP_AFFINITY affinity{};
+  if (GetNumaNodeProcessorMaskEx(static_cast<USHORT>(numaNode), &affinity)) {
+    SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr);
+  }
+}
+
+#elif defined(__APPLE__)
+
+void setName(const std::string& name) {
+  pthread_setname_np(name.c_str());
+}
+
+void setQualityOfService(ThreadQualityOfService qualityOfService) {
+  switch (qualityOfService) {
+  case ThreadQualityOfService::Background:
+    pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0);
+    break;
+  case ThreadQualityOfService::Utility:
+    pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+    break;
+  case ThreadQualityOfService::UserInitiated:
+    pthread_set_qos_class_self_np(QOS_CLASS_USER_INITIATED, 0);
+    break;
+  case ThreadQualityOfService::Default:
+    break;
+  }
+}
+
+// Apple platforms don't let threads choose the CPUs they run on.
+void setAffinity(const std::vector<uint32_t>&) {}
+
+void setNumaNode(int32_t) {}
+
+#elif defined(__linux__)
+
+void setName(const std::string& name) {
+  // Longer names are rejected rather than truncated.
+  pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+}
+
+void setQualityOfService(ThreadQualityOfService qualityOfService) {
+  // On Linux, the nice value of a thread ID applies to just that thread.
+  const id_t threadId = static_cast<id_t>(syscall(SYS_gettid));
+  switch (qualityOfService) {
+  case ThreadQualityOfService::Background:
+    setpriority(PRIO_PROCESS, threadId, 10);
+    break;
+  case ThreadQualityOfService::Utility:
+    setpriority(PRIO_PROCESS, threadId, 5);
+    break;
+  case ThreadQualityOfService::Default:
+  case ThreadQualityOfService::UserInitiated:
+    break;
+  }
+}
+
+void setAffinity(const std::vector<uint32_t>& cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  bool anySet = false;
+  for (const uint32_t cpu : cpus) {
+    if (cpu < uint32_t(CPU_SETSIZE)) {
+      CPU_SET(cpu, &set);
+      anySet = true;
+    }
+  }
+  if (anySet) {
+    sched_setaffinity(0, sizeof(set), &set);
+  }
+}
+
+void setNumaNode(int32_t numaNode) {
+  // The CPUs of a node are listed as ranges, like "0-7,16-23".
+  std::ifstream file(
+      "/sys/devices/system/node/node" + std::to_string(numaNode) +
+      "/cpulist");
+  std::string list;
+  if (!std::getline(file, list)) {
+    return;
+  }
+
+  std::vector<uint32_t> cpus;
+  std::istringstream ranges(list);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    uint32_t first = 0;
+    uint32_t last = 0;
+    char dash = 0;
+    std::istringstream parser(range);
+    if (!(parser >> first)) {
+      continue;
+    }
+    if (!(parser >> dash >> last) || dash != '-') {
+      last = first;
+    }
+    last = std::min(last, uint32_t(CPU_SETSIZE) - 1);
+    for (uint32_t cpu = first; cpu <= last; ++cpu) {
+      cpus.emplace_back(cpu);
+    }
+  }
+  setAffinity(cpus);
+}
+
+#else
+
+void setName(const std::string&) {}
+void setQualityOfService(ThreadQualityOfService) {}
+void setAffinity(const std::vector<uint32_t>&) {}
+void setNumaNode(int32_t) {}
+
+#endif
+
+} // namespace
+
+void configureCurrentThread(
+    const ThreadPoolOptions& options,
+    size_t threadIndex) noexcept {
+  try {
+    if (!options.threadName.empty()) {
+      setName(options.threadName + " " + std::to_string(threadIndex));
+    }
+    if (!options.cpuAffinity.empty()) {
+      setAffinity(options.cpuAffinity);
+    } else if (options.numaNode >= 0) {
+      setNumaNode(options.numaNode);
+    }
+  } catch (...) {
+    // The names and node CPUs can't be built if memory runs out, in which
+    // case the thread is left as it is.
+  }
+  setQualityOfService(options.qualityOfService);
+}
+
+} // namespace CesiumAsync
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "CesiumAsync/ThreadPoolOptions.h"
+
+#include <cstddef>
+
+namespace CesiumAsync {
+// Applies the name, quality of service, and affinity of the options to the
+// calling thread, which is the thread with the given index in its pool.
+void configureCurrentThread(
+    const ThreadPoolOptions& options,
+    size_t threadIndex) noexcept;
+} // namespace CesiumAsync
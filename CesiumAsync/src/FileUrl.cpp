@@ -0,0 +1,59 @@
+#include "FileUrl.h"
+
+namespace CesiumAsync {
+
+namespace {
+const std::string FILE_SCHEME = "file://";
+
+int hexDigitValue(char c) noexcept {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+} // namespace
+
+bool isFileUrl(const std::string& url) noexcept {
+  return url.compare(0, FILE_SCHEME.size(), FILE_SCHEME) == 0;
+}
+
+std::string fileUrlToPath(const std::string& url) {
+  std::string path = url.substr(0, url.find_first_of("?#"));
+  if (isFileUrl(path)) {
+    path.erase(0, FILE_SCHEME.size());
+  }
+
+  // Remove the slash in front of a Windows drive letter.
+  if (path.size() > 2 && path[0] == '/' && path[2] == ':') {
+    path.erase(0, 1);
+  }
+
+  return decodePercents(path);
+}
+
+std::string decodePercents(const std::string& s) {
+  std::string decoded;
+  decoded.reserve(s.size());
+  for (size_t i = 0; i < s.size(); ++i) {
+    if (s[i] == '%' && i + 2 < s.size()) {
+      const int high = hexDigitValue(s[i + 1]);
+      const int low = hexDigitValue(s[i + 2]);
+      if (high >= 0 && low >= 0) {
+        decoded += static_cast<char>(high * 16 + low);
+        i += 2;
+        continue;
+      }
+    }
+
+    decoded += s[i];
+  }
+  return decoded;
+}
+
+} // namespace CesiumAsync
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+namespace CesiumAsync {
+// Whether a URL is a `file` URL.
+bool isFileUrl(const std::string& url) noexcept;
+
+// Converts a `file` URL to a local path, ignoring its query and fragment.
+std::string fileUrlToPath(const std::string& url);
+
+// Decodes the percent-encoded characters in a part of a URL.
+std::string decodePercents(const std::string& s);
+} // namespace CesiumAsync
@@ -4,6 +4,9 @@
 #include "CesiumAsync/IAssetResponse.h"
 #include "CesiumUtility/Gunzip.h"
 
+#include <utility>
+#include <vector>
+
 namespace CesiumAsync {
 
 namespace {
@@ -17,6 +20,13 @@ public:
         this->_gunzippedData);
   }
 
+  GunzippedAssetResponse(
+      const IAssetResponse* pOther,
+      std::vector<std::byte>&& gunzippedData) noexcept
+      : _pAssetResponse{pOther},
+        _gunzippedData(std::move(gunzippedData)),
+        _dataValid(true) {}
+
   virtual uint16_t statusCode() const noexcept override {
     return this->_pAssetResponse->statusCode();
   }
@@ -34,6 +44,12 @@ public:
                             : this->_pAssetResponse->data();
   }
 
+  bool hasGunzippedData() const noexcept { return this->_dataValid; }
+
+  std::vector<std::byte> takeGunzippedData() noexcept {
+    return std::exchange(this->_gunzippedData, {});
+  }
+
 private:
   const IAssetResponse* _pAssetResponse;
   std::vector<std::byte> _gunzippedData;
@@ -45,6 +61,15 @@ public:
   GunzippedAssetRequest(std::shared_ptr<IAssetRequest>&& pOther)
       : _pAssetRequest(std::move(pOther)),
         _AssetResponse(_pAssetRequest->response()){};
+
+  GunzippedAssetRequest(
+      std::shared_ptr<IAssetRequest>&& pOther,
+      std::vector<std::byte>&& gunzippedData)
+      : _pAssetRequest(std::move(pOther)),
+        _AssetResponse(
+            _pAssetRequest->response(),
+            std::move(gunzippedData)) {}
+
   virtual const std::string& method() const noexcept override {
     return this->_pAssetRequest->method();
   }
@@ -61,6 +86,14 @@ public:
     return &this->_AssetResponse;
   }
 
+  virtual std::vector<std::byte> takeResponseData() override {
+    if (this->_AssetResponse.hasGunzippedData()) {
+      return this->_AssetResponse.takeGunzippedData();
+    }
+
+    return this->_pAssetRequest->takeResponseData();
+  }
+
 private:
   std::shared_ptr<IAssetRequest> _pAssetRequest;
   GunzippedAssetResponse _AssetResponse;
@@ -81,6 +114,81 @@ Future<std::shared_ptr<IAssetRequest>> gunzipIfNeeded(
   return asyncSystem.createResolvedFuture(std::move(pCompletedRequest));
 }
 
+// Gunzips the pieces of a streamed response as they are received, and passes
+// the gunzipped pieces on. The underlying accessor passes the pieces one at a
+// time, so this needs no locking.
+struct StreamingGunzip {
+  StreamingGunzip(const IAssetAccessor::DataReceivedCallback& callback)
+      : onDataReceived(callback),
+        prefix(),
+        decided(false),
+        gzipped(false),
+        failed(false),
+        stream(),
+        gunzippedData() {}
+
+  void receive(const gsl::span<const std::byte>& data) {
+    if (this->decided) {
+      this->process(data);
+      return;
+    }
+
+    // The gzip header can only be recognized from its first three bytes.
+    this->prefix.insert(this->prefix.end(), data.begin(), data.end());
+    if (this->prefix.size() < 3) {
+      return;
+    }
+
+    this->decided = true;
+    this->gzipped = CesiumUtility::isGzip(this->prefix);
+    this->process(this->prefix);
+    this->prefix = std::vector<std::byte>();
+  }
+
+  void finish() {
+    if (!this->decided && !this->prefix.empty()) {
+      this->onDataReceived(this->prefix);
+    }
+  }
+
+  bool isFinished() const noexcept {
+    return this->gzipped && !this->failed && this->stream.isFinished();
+  }
+
+  IAssetAccessor::DataReceivedCallback onDataReceived;
+  std::vector<std::byte> prefix;
+  bool decided;
+  bool gzipped;
+  bool failed;
+  CesiumUtility::GunzipStream stream;
+  std::vector<std::byte> gunzippedData;
+
+private:
+  void process(const gsl::span<const std::byte>& data) {
+    if (!this->gzipped) {
+      this->onDataReceived(data);
+      return;
+    }
+
+    if (this->failed) {
+      return;
+    }
+
+    const size_t previousSize = this->gunzippedData.size();
+    if (!this->stream.write(data, this->gunzippedData)) {
+      this->failed = true;
+      return;
+    }
+
+    if (this->gunzippedData.size() > previousSize) {
+      this->onDataReceived(gsl::span<const std::byte>(
+          this->gunzippedData.data() + previousSize,
+          this->gunzippedData.size() - previousSize));
+    }
+  }
+};
+
+
 } // namespace
 
 GunzipAssetAccessor::GunzipAssetAccessor(
@@ -100,6 +208,45 @@ Future<std::shared_ptr<IAssetRequest>> GunzipAssetAccessor::get(
           });
 }
 
+Future<std::shared_ptr<IAssetRequest>> GunzipAssetAccessor::getStreaming(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const DataReceivedCallback& onDataReceived) {
+  if (!onDataReceived) {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  std::shared_ptr<StreamingGunzip> pGunzip =
+      std::make_shared<StreamingGunzip>(onDataReceived);
+  return this->_pAssetAccessor
+      ->getStreaming(
+          asyncSystem,
+          url,
+          headers,
+          [pGunzip](const gsl::span<const std::byte>& data) {
+            pGunzip->receive(data);
+          })
+      .thenImmediately(
+          [asyncSystem,
+           pGunzip](std::shared_ptr<IAssetRequest>&& pCompletedRequest)
+              -> Future<std::shared_ptr<IAssetRequest>> {
+            pGunzip->finish();
+
+            // The streamed data was already gunzipped. Otherwise, such as when
+            // the underlying accessor does not stream or the stream could not
+            // be gunzipped, the completed response is gunzipped as a whole.
+            if (pGunzip->isFinished()) {
+              return asyncSystem.createResolvedFuture<
+                  std::shared_ptr<IAssetRequest>>(
+                  std::make_shared<GunzippedAssetRequest>(
+                      std::move(pCompletedRequest),
+                      std::move(pGunzip->gunzippedData)));
+            }
+            return gunzipIfNeeded(asyncSystem, std::move(pCompletedRequest));
+          });
+}
+
 Future<std::shared_ptr<IAssetRequest>> GunzipAssetAccessor::request(
     const AsyncSystem& asyncSystem,
     const std::string& verb,
@@ -0,0 +1,410 @@
+#include "CesiumAsync/HttpAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/Promise.h"
+#include "CesiumAsync/ThreadPool.h"
+
+#include <CesiumUtility/Gunzip.h>
+#include <CesiumUtility/Tracing.h>
+#include <httplib.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <ctime>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace CesiumAsync {
+
+namespace {
+
+class HttpAssetResponse : public IAssetResponse {
+public:
+  HttpAssetResponse(
+      uint16_t statusCode,
+      HttpHeaders&& headers,
+      std::vector<std::byte>&& data)
+      : _statusCode(statusCode),
+        _headers(std::move(headers)),
+        _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const noexcept override {
+    return this->_statusCode;
+  }
+
+  virtual std::string contentType() const override {
+    auto it = this->_headers.find("Content-Type");
+    if (it == this->_headers.end()) {
+      return std::string();
+    }
+    return it->second;
+  }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const noexcept override {
+    return this->_data;
+  }
+
+  std::vector<std::byte> takeData() noexcept {
+    return std::exchange(this->_data, {});
+  }
+
+private:
+  uint16_t _statusCode;
+  HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class HttpAssetRequest : public IAssetRequest {
+public:
+  HttpAssetRequest(
+      const std::string& method,
+      const std::string& url,
+      HttpHeaders&& headers,
+      HttpAssetResponse&& response)
+      : _method(method),
+        _url(url),
+        _headers(std::move(headers)),
+        _response(std::move(response)) {}
+
+  virtual const std::string& method() const noexcept override {
+    return this->_method;
+  }
+
+  virtual const std::string& url() const noexcept override {
+    return this->_url;
+  }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const noexcept override {
+    return &this->_response;
+  }
+
+  virtual std::vector<std::byte> takeResponseData() override {
+    return this->_response.takeData();
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  HttpAssetResponse _response;
+};
+
+struct PendingRequest {
+  Promise<std::shared_ptr<IAssetRequest>> promise;
+  std::string method;
+  std::string url;
+  std::string path;
+  HttpHeaders headers;
+  std::string body;
+};
+
+// Splits a URL into the scheme, host and port that identify its connections,
+// and the path and query that are sent to the host.
+bool splitUrl(const std::string& url, std::string& origin, std::string& path) {
+  const size_t schemeEnd = url.find("://");
+  if (schemeEnd == std::string::npos) {
+    return false;
+  }
+
+  const std::string scheme = url.substr(0, schemeEnd);
+  if (scheme != "http" && scheme != "https") {
+    return false;
+  }
+
+  const size_t hostStart = schemeEnd + 3;
+  const size_t pathStart = url.find_first_of("/?#", hostStart);
+  origin = url.substr(0, pathStart);
+  if (origin.size() == hostStart) {
+    return false;
+  }
+
+  if (pathStart == std::string::npos) {
+    path = "/";
+  } else {
+    // The fragment is not sent to the host.
+    path = url.substr(pathStart, url.find('#', pathStart) - pathStart);
+    if (path.empty() || path[0] != '/') {
+      path.insert(0, "/");
+    }
+  }
+
+  return true;
+}
+
+HttpAssetResponse createResponse(
+    const HttpAssetAccessorOptions& options,
+    httplib::Response&& response) {
+  // Headers that are received more than once are combined into one.
+  HttpHeaders headers;
+  for (const auto& [name, value] : response.headers) {
+    auto [it, added] = headers.emplace(name, value);
+    if (!added) {
+      it->second += ", ";
+      it->second += value;
+    }
+  }
+
+  const std::byte* pBody =
+      reinterpret_cast<const std::byte*>(response.body.data());
+  std::vector<std::byte> data(pBody, pBody + response.body.size());
+
+  auto encodingIt = headers.find("Content-Encoding");
+  if (options.requestGzip && encodingIt != headers.end() &&
+      encodingIt->second == "gzip" && CesiumUtility::isGzip(data)) {
+    std::vector<std::byte> gunzippedData;
+    if (CesiumUtility::gunzip(data, gunzippedData)) {
+      // The headers describe the data that is returned.
+      data = std::move(gunzippedData);
+      headers.erase(encodingIt);
+      headers.erase("Content-Length");
+    }
+  }
+
+  return HttpAssetResponse(
+      static_cast<uint16_t>(response.status),
+      std::move(headers),
+      std::move(data));
+}
+
+std::shared_ptr<httplib::Client> createClient(
+    const std::string& origin,
+    const HttpAssetAccessorOptions& options) {
+  std::shared_ptr<httplib::Client> pClient =
+      std::make_shared<httplib::Client>(origin);
+  if (!pClient->is_valid()) {
+    return nullptr;
+  }
+
+  pClient->set_keep_alive(true);
+  pClient->set_follow_location(true);
+  pClient->set_connection_timeout(
+      static_cast<time_t>(options.connectionTimeoutSeconds));
+  pClient->set_read_timeout(static_cast<time_t>(options.readTimeoutSeconds));
+  return pClient;
+}
+
+// Sends a request on a connection to its host, creating the connection if
+// there is none. The connection is reset if the request fails, so that it is
+// not used again.
+std::shared_ptr<IAssetRequest> sendRequest(
+    const HttpAssetAccessorOptions& options,
+    const std::string& origin,
+    const PendingRequest& request,
+    std::shared_ptr<httplib::Client>& pClient) {
+  CESIUM_TRACE("HttpAssetAccessor::sendRequest");
+  if (!pClient) {
+    pClient = createClient(origin, options);
+    if (!pClient) {
+      throw std::runtime_error(
+          "Unable to create a connection to " + origin +
+          ". HTTPS requires cpp-httplib with OpenSSL.");
+    }
+  }
+
+  httplib::Request httpRequest;
+  httpRequest.method = request.method;
+  httpRequest.path = request.path;
+  for (const auto& [name, value] : request.headers) {
+    httpRequest.headers.emplace(name, value);
+  }
+  if (options.requestGzip &&
+      request.headers.find("Accept-Encoding") == request.headers.end()) {
+    httpRequest.headers.emplace("Accept-Encoding", "gzip");
+  }
+  httpRequest.body = request.body;
+
+  httplib::Result result = pClient->send(httpRequest);
+  if (!result) {
+    pClient.reset();
+    throw std::runtime_error(
+        "Request for " + request.url +
+        " failed: " + httplib::to_string(result.error()));
+  }
+
+  return std::make_shared<HttpAssetRequest>(
+      request.method,
+      request.url,
+      HttpHeaders(request.headers),
+      createResponse(options, std::move(result.value())));
+}
+
+} // namespace
+
+struct HttpAssetAccessor::Connections {
+  struct Host {
+    std::vector<std::shared_ptr<httplib::Client>> idleClients;
+    int32_t activeCount = 0;
+    std::deque<PendingRequest> queue;
+  };
+
+  Connections(const HttpAssetAccessorOptions& accessorOptions)
+      : options(accessorOptions),
+        threadPool(
+            std::max(accessorOptions.maximumSimultaneousRequests, 1),
+            {"Cesium HTTP", ThreadQualityOfService::Default, {}, -1}),
+        mutex(),
+        hosts() {}
+
+  // Starts the queued requests to a host for which connections are free.
+  static void dispatchRequests(
+      const AsyncSystem& asyncSystem,
+      const std::shared_ptr<Connections>& pConnections,
+      const std::string& origin);
+
+  static void startRequest(
+      const AsyncSystem& asyncSystem,
+      const std::shared_ptr<Connections>& pConnections,
+      const std::string& origin,
+      PendingRequest&& request,
+      std::shared_ptr<httplib::Client>&& pClient);
+
+  HttpAssetAccessorOptions options;
+  ThreadPool threadPool;
+  std::mutex mutex;
+  std::unordered_map<std::string, Host> hosts;
+};
+
+void HttpAssetAccessor::Connections::dispatchRequests(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<Connections>& pConnections,
+    const std::string& origin) {
+  std::vector<std::pair<PendingRequest, std::shared_ptr<httplib::Client>>>
+      requestsToStart;
+
+  {
+    std::lock_guard<std::mutex> lock(pConnections->mutex);
+    Host& host = pConnections->hosts[origin];
+    const int32_t maximumConnections =
+        std::max(pConnections->options.maximumConnectionsPerHost, 1);
+    while (host.activeCount < maximumConnections && !host.queue.empty()) {
+      std::shared_ptr<httplib::Client> pClient;
+      if (!host.idleClients.empty()) {
+        pClient = std::move(host.idleClients.back());
+        host.idleClients.pop_back();
+      }
+
+      requestsToStart.emplace_back(
+          std::move(host.queue.front()),
+          std::move(pClient));
+      host.queue.pop_front();
+      ++host.activeCount;
+    }
+  }
+
+  // A thread pool may run a task right away in the calling thread, so the
+  // requests are started without holding the lock.
+  for (auto& [request, pClient] : requestsToStart) {
+    startRequest(
+        asyncSystem,
+        pConnections,
+        origin,
+        std::move(request),
+        std::move(pClient));
+  }
+}
+
+void HttpAssetAccessor::Connections::startRequest(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<Connections>& pConnections,
+    const std::string& origin,
+    PendingRequest&& request,
+    std::shared_ptr<httplib::Client>&& pClient) {
+  // The connection sends the requests that are queued for its host one after
+  // another, until there are none left.
+  asyncSystem.runInThreadPool(
+      pConnections->threadPool,
+      [pConnections,
+       origin,
+       request = std::move(request),
+       pClient = std::move(pClient)]() mutable {
+        for (;;) {
+          try {
+            request.promise.resolve(
+                sendRequest(pConnections->options, origin, request, pClient));
+          } catch (...) {
+            request.promise.reject(std::current_exception());
+          }
+
+          std::lock_guard<std::mutex> lock(pConnections->mutex);
+          Host& host = pConnections->hosts[origin];
+          if (host.queue.empty()) {
+            --host.activeCount;
+            if (pClient) {
+              host.idleClients.emplace_back(std::move(pClient));
+            }
+            return;
+          }
+
+          request = std::move(host.queue.front());
+          host.queue.pop_front();
+        }
+      });
+}
+
+HttpAssetAccessor::HttpAssetAccessor(const HttpAssetAccessorOptions& options)
+    : _pConnections(std::make_shared<Connections>(options)) {}
+
+HttpAssetAccessor::~HttpAssetAccessor() noexcept {}
+
+Future<std::shared_ptr<IAssetRequest>> HttpAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->request(asyncSystem, "GET", url, headers, {});
+}
+
+Future<std::shared_ptr<IAssetRequest>> HttpAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  std::string origin;
+  std::string path;
+  if (!splitUrl(url, origin, path)) {
+    return asyncSystem.createFuture<std::shared_ptr<IAssetRequest>>(
+        [&url](const auto& promise) {
+          promise.reject(std::runtime_error("Unsupported URL " + url));
+        });
+  }
+
+  Promise<std::shared_ptr<IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+  Future<std::shared_ptr<IAssetRequest>> future = promise.getFuture();
+
+  PendingRequest pendingRequest{
+      promise,
+      verb,
+      url,
+      std::move(path),
+      HttpHeaders(headers.begin(), headers.end()),
+      std::string(
+          reinterpret_cast<const char*>(contentPayload.data()),
+          contentPayload.size())};
+
+  {
+    std::lock_guard<std::mutex> lock(this->_pConnections->mutex);
+    this->_pConnections->hosts[origin].queue.emplace_back(
+        std::move(pendingRequest));
+  }
+  Connections::dispatchRequests(asyncSystem, this->_pConnections, origin);
+
+  return future;
+}
+
+void HttpAssetAccessor::tick() noexcept {}
+
+} // namespace CesiumAsync
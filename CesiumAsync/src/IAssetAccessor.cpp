@@ -0,0 +1,13 @@
+#include "CesiumAsync/IAssetAccessor.h"
+
+namespace CesiumAsync {
+
+Future<std::shared_ptr<IAssetRequest>> IAssetAccessor::getStreaming(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const DataReceivedCallback& /*onDataReceived*/) {
+  return this->get(asyncSystem, url, headers);
+}
+
+} // namespace CesiumAsync
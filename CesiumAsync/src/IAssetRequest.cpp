@@ -0,0 +1,17 @@
+#include "CesiumAsync/IAssetRequest.h"
+
+#include "CesiumAsync/IAssetResponse.h"
+
+namespace CesiumAsync {
+
+std::vector<std::byte> IAssetRequest::takeResponseData() {
+  const IAssetResponse* pResponse = this->response();
+  if (!pResponse) {
+    return {};
+  }
+
+  const gsl::span<const std::byte> data = pResponse->data();
+  return std::vector<std::byte>(data.begin(), data.end());
+}
+
+} // namespace CesiumAsync
@@ -0,0 +1,198 @@
+#include "CesiumAsync/LocalFileAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumUtility/MemoryMappedFile.h"
+#include "CesiumUtility/SharedBytes.h"
+#include "FileUrl.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+using namespace CesiumUtility;
+
+namespace CesiumAsync {
+
+namespace {
+
+class LocalFileResponse : public IAssetResponse {
+public:
+  LocalFileResponse(uint16_t statusCode) noexcept
+      : _statusCode(statusCode), _headers(), _mappedData(), _readData() {}
+
+  LocalFileResponse(SharedBytes&& mappedData) noexcept
+      : _statusCode(200),
+        _headers(),
+        _mappedData(std::move(mappedData)),
+        _readData() {}
+
+  LocalFileResponse(std::vector<std::byte>&& readData) noexcept
+      : _statusCode(200),
+        _headers(),
+        _mappedData(),
+        _readData(std::move(readData)) {}
+
+  virtual uint16_t statusCode() const noexcept override {
+    return this->_statusCode;
+  }
+
+  virtual std::string contentType() const override { return std::string(); }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const noexcept override {
+    if (this->_mappedData.getOwner()) {
+      return this->_mappedData.getBytes();
+    }
+    return this->_readData;
+  }
+
+  bool isMapped() const noexcept {
+    return this->_mappedData.getOwner() != nullptr;
+  }
+
+  std::vector<std::byte> takeReadData() noexcept {
+    return std::exchange(this->_readData, {});
+  }
+
+private:
+  uint16_t _statusCode;
+  HttpHeaders _headers;
+  SharedBytes _mappedData;
+  std::vector<std::byte> _readData;
+};
+
+class LocalFileRequest : public IAssetRequest {
+public:
+  LocalFileRequest(
+      const std::string& method,
+      const std::string& url,
+      const std::vector<IAssetAccessor::THeader>& headers,
+      LocalFileResponse&& response)
+      : _method(method),
+        _url(url),
+        _headers(headers.begin(), headers.end()),
+        _response(std::move(response)) {}
+
+  virtual const std::string& method() const noexcept override {
+    return this->_method;
+  }
+
+  virtual const std::string& url() const noexcept override {
+    return this->_url;
+  }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const noexcept override {
+    return &this->_response;
+  }
+
+  virtual std::vector<std::byte> takeResponseData() override {
+    // The mapped pages can't be taken, so they are copied.
+    if (this->_response.isMapped()) {
+      return IAssetRequest::takeResponseData();
+    }
+    return this->_response.takeReadData();
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  LocalFileResponse _response;
+};
+
+LocalFileResponse readFile(
+    const std::string& verb,
+    const std::string& url,
+    const LocalFileAssetAccessorOptions& options) {
+  if (verb != "GET" && verb != "HEAD") {
+    return LocalFileResponse(405);
+  }
+
+  if (!isFileUrl(url)) {
+    return LocalFileResponse(404);
+  }
+
+  const std::string path = fileUrlToPath(url);
+  std::error_code errorCode;
+  const uintmax_t size =
+      std::filesystem::file_size(std::filesystem::u8path(path), errorCode);
+  if (errorCode) {
+    return LocalFileResponse(404);
+  }
+
+  if (verb == "HEAD") {
+    return LocalFileResponse(200);
+  }
+
+  if (size > 0 && size >= options.minimumMappedFileSize) {
+    std::shared_ptr<const MemoryMappedFile> pFile =
+        MemoryMappedFile::open(path);
+    if (pFile) {
+      if (options.prefetchMappedFiles) {
+        pFile->prefetch();
+      }
+      const gsl::span<const std::byte> data = pFile->getData();
+      return LocalFileResponse(SharedBytes(std::move(pFile), data));
+    }
+  }
+
+  // Files that are too small to map, or that can't be mapped, are read.
+  std::ifstream file(std::filesystem::u8path(path), std::ios::binary);
+  if (!file) {
+    return LocalFileResponse(404);
+  }
+
+  std::vector<std::byte> data(static_cast<size_t>(size));
+  file.read(
+      reinterpret_cast<char*>(data.data()),
+      static_cast<std::streamsize>(size));
+  data.resize(static_cast<size_t>(file.gcount()));
+  return LocalFileResponse(std::move(data));
+}
+
+} // namespace
+
+LocalFileAssetAccessor::LocalFileAssetAccessor(
+    const LocalFileAssetAccessorOptions& options)
+    : _options(options), _threadPool(options.threadCount) {}
+
+LocalFileAssetAccessor::~LocalFileAssetAccessor() noexcept {}
+
+Future<std::shared_ptr<IAssetRequest>> LocalFileAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->request(asyncSystem, "GET", url, headers, {});
+}
+
+Future<std::shared_ptr<IAssetRequest>> LocalFileAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& /* contentPayload */) {
+  return asyncSystem.runInThreadPool(
+      this->_threadPool,
+      [verb, url, headers, options = this->_options]() {
+        return std::shared_ptr<IAssetRequest>(
+            std::make_shared<LocalFileRequest>(
+                verb,
+                url,
+                headers,
+                readFile(verb, url, options)));
+      });
+}
+
+void LocalFileAssetAccessor::tick() noexcept {}
+
+} // namespace CesiumAsync
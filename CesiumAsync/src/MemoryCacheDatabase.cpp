@@ -0,0 +1,192 @@
+#include "CesiumAsync/MemoryCacheDatabase.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <ctime>
+#include <utility>
+#include <vector>
+
+namespace CesiumAsync {
+
+namespace {
+int64_t computeByteSize(const std::string& key, const CacheItem& item) {
+  size_t byteSize = sizeof(CacheItem) + key.size() +
+                    item.cacheRequest.method.size() +
+                    item.cacheRequest.url.size() +
+                    item.cacheResponse.data.size();
+  for (const auto& [name, value] : item.cacheRequest.headers) {
+    byteSize += name.size() + value.size();
+  }
+  for (const auto& [name, value] : item.cacheResponse.headers) {
+    byteSize += name.size() + value.size();
+  }
+  return static_cast<int64_t>(byteSize);
+}
+} // namespace
+
+MemoryCacheDatabase::MemoryCacheDatabase(
+    const std::shared_ptr<ICacheDatabase>& pDatabase,
+    int64_t maximumBytes)
+    : _pDatabase(pDatabase),
+      _mutex(),
+      _entries(),
+      _entriesByKey(),
+      _byteSize(0),
+      _maximumBytes(maximumBytes) {}
+
+std::optional<CacheItem>
+MemoryCacheDatabase::getEntry(const std::string& key) const {
+  CESIUM_TRACE("MemoryCacheDatabase::getEntry");
+
+  std::shared_ptr<const CacheItem> pItem;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entriesByKey.find(key);
+    if (it != this->_entriesByKey.end()) {
+      this->_entries.splice(this->_entries.begin(), this->_entries, it->second);
+      pItem = it->second->pItem;
+    }
+  }
+
+  // Copy the entry outside the lock, so that other threads are not held up
+  // by large responses.
+  if (pItem) {
+    return *pItem;
+  }
+
+  // An entry that was stored meanwhile is newer than the one found here.
+  std::optional<CacheItem> item = this->_pDatabase->getEntry(key);
+  if (item) {
+    this->insert(key, CacheItem(*item), false);
+  }
+  return item;
+}
+
+bool MemoryCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  CESIUM_TRACE("MemoryCacheDatabase::storeEntry");
+
+  const bool stored = this->_pDatabase->storeEntry(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+
+  if (stored) {
+    this->insert(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(
+                HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))),
+        true);
+  } else {
+    // Do not keep an older response that the database may no longer have.
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entriesByKey.find(key);
+    if (it != this->_entriesByKey.end()) {
+      this->_byteSize -= it->second->byteSize;
+      this->_entries.erase(it->second);
+      this->_entriesByKey.erase(it);
+    }
+  }
+
+  return stored;
+}
+
+bool MemoryCacheDatabase::prune() {
+  const std::time_t now = std::time(nullptr);
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    for (auto it = this->_entries.begin(); it != this->_entries.end();) {
+      if (it->pItem->expiryTime < now) {
+        this->_byteSize -= it->byteSize;
+        this->_entriesByKey.erase(it->key);
+        it = this->_entries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  return this->_pDatabase->prune();
+}
+
+bool MemoryCacheDatabase::clearAll() {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_entries.clear();
+    this->_entriesByKey.clear();
+    this->_byteSize = 0;
+  }
+
+  return this->_pDatabase->clearAll();
+}
+
+size_t MemoryCacheDatabase::getCount() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_entries.size();
+}
+
+int64_t MemoryCacheDatabase::getByteSize() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_byteSize;
+}
+
+void MemoryCacheDatabase::insert(
+    const std::string& key,
+    CacheItem&& item,
+    bool replace) const {
+  const int64_t byteSize = computeByteSize(key, item);
+  std::shared_ptr<const CacheItem> pItem =
+      std::make_shared<const CacheItem>(std::move(item));
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  auto it = this->_entriesByKey.find(key);
+  if (it != this->_entriesByKey.end()) {
+    if (!replace) {
+      return;
+    }
+
+    this->_byteSize -= it->second->byteSize;
+    this->_entries.erase(it->second);
+    this->_entriesByKey.erase(it);
+  }
+
+  if (byteSize > this->_maximumBytes) {
+    return;
+  }
+
+  while (!this->_entries.empty() &&
+         this->_byteSize + byteSize > this->_maximumBytes) {
+    this->_byteSize -= this->_entries.back().byteSize;
+    this->_entriesByKey.erase(this->_entries.back().key);
+    this->_entries.pop_back();
+  }
+
+  this->_entries.push_front(Entry{key, std::move(pItem), byteSize});
+  this->_entriesByKey.emplace(key, this->_entries.begin());
+  this->_byteSize += byteSize;
+}
+
+} // namespace CesiumAsync
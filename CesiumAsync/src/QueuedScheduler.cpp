@@ -3,15 +3,42 @@
 using namespace CesiumAsync::CesiumImpl;
 
 void QueuedScheduler::schedule(async::task_run_handle t) {
+  ++this->_queuedCount;
   this->_scheduler.schedule(std::move(t));
 }
 
 void QueuedScheduler::dispatchQueuedContinuations() {
   auto scope = this->immediate.scope();
-  this->_scheduler.run_all_tasks();
+  while (this->_scheduler.try_run_one_task()) {
+    --this->_queuedCount;
+  }
 }
 
 bool QueuedScheduler::dispatchZeroOrOneContinuation() {
   auto scope = this->immediate.scope();
-  return this->_scheduler.try_run_one_task();
+  if (!this->_scheduler.try_run_one_task()) {
+    return false;
+  }
+
+  --this->_queuedCount;
+  return true;
+}
+
+size_t QueuedScheduler::dispatchContinuationsUntil(
+    std::chrono::steady_clock::time_point end) {
+  auto scope = this->immediate.scope();
+
+  // Always run at least one continuation, so that a small budget still makes
+  // progress. The rest run in the order in which they were queued, so none
+  // of them waits for more than the continuations queued before it.
+  size_t dispatched = 0;
+  do {
+    if (!this->_scheduler.try_run_one_task()) {
+      break;
+    }
+    --this->_queuedCount;
+    ++dispatched;
+  } while (std::chrono::steady_clock::now() < end);
+
+  return dispatched;
 }
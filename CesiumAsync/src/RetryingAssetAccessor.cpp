@@ -0,0 +1,482 @@
+#include "CesiumAsync/RetryingAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/Promise.h"
+#include "CesiumAsync/TelemetryAssetAccessor.h"
+#include "UrlHost.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace CesiumAsync {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+Clock::duration toDuration(double milliseconds) {
+  return std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double, std::milli>(std::max(milliseconds, 0.0)));
+}
+
+// Gets the delay in a `Retry-After` header, in milliseconds, if it is a number
+// of seconds. HTTP dates are ignored.
+double getRetryAfterMilliseconds(const IAssetResponse& response) {
+  const HttpHeaders& headers = response.headers();
+  const auto it = headers.find("Retry-After");
+  if (it == headers.end() || it->second.empty() ||
+      !std::all_of(it->second.begin(), it->second.end(), [](char c) {
+        return c >= '0' && c <= '9';
+      })) {
+    return 0.0;
+  }
+
+  return std::stod(it->second) * 1000.0;
+}
+
+} // namespace
+
+struct RetryingAssetAccessor::Requests
+    : public std::enable_shared_from_this<Requests> {
+  // A request from a caller, which may be sent several times.
+  struct Request {
+    Request(
+        const AsyncSystem& asyncSystem_,
+        const std::string& verb_,
+        const std::string& url_,
+        const std::vector<THeader>& headers_,
+        const gsl::span<const std::byte>& contentPayload_)
+        : asyncSystem(asyncSystem_),
+          verb(verb_),
+          url(url_),
+          headers(headers_),
+          contentPayload(contentPayload_.begin(), contentPayload_.end()),
+          host(getUrlHost(url_)),
+          promise(
+              asyncSystem_.createPromise<std::shared_ptr<IAssetRequest>>()),
+          retryable(verb_ == "GET" || verb_ == "HEAD"),
+          completed(false),
+          attemptsInFlight(0),
+          retries(0),
+          pLastRequest(),
+          pLastException() {}
+
+    AsyncSystem asyncSystem;
+    std::string verb;
+    std::string url;
+    std::vector<THeader> headers;
+    std::vector<std::byte> contentPayload;
+    std::string host;
+    Promise<std::shared_ptr<IAssetRequest>> promise;
+    bool retryable;
+
+    // Guarded by Requests::mutex.
+    bool completed;
+    uint32_t attemptsInFlight;
+    uint32_t retries;
+    std::shared_ptr<IAssetRequest> pLastRequest;
+    std::exception_ptr pLastException;
+  };
+
+  struct Host {
+    int32_t requestsInFlight = 0;
+    std::deque<std::shared_ptr<Request>> waitingRequests;
+    LatencyHistogram latency;
+  };
+
+  Requests(
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor_,
+      const RetryingAssetAccessorOptions& options_)
+      : pAssetAccessor(pAssetAccessor_),
+        options(options_),
+        mutex(),
+        hosts(),
+        statistics(),
+        timerMutex(),
+        timerChanged(),
+        timers(),
+        stopping(false) {}
+
+  Future<std::shared_ptr<IAssetRequest>>
+  start(const std::shared_ptr<Request>& pRequest) {
+    Future<std::shared_ptr<IAssetRequest>> future =
+        pRequest->promise.getFuture();
+    this->sendWhenPossible(pRequest);
+    return future;
+  }
+
+  // Sends an attempt of a request, or queues it until its host has a free
+  // slot.
+  void sendWhenPossible(const std::shared_ptr<Request>& pRequest) {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      Host& host = this->hosts[pRequest->host];
+      if (!this->tryAcquire(host)) {
+        host.waitingRequests.emplace_back(pRequest);
+        return;
+      }
+      ++pRequest->attemptsInFlight;
+    }
+
+    this->send(pRequest, false);
+  }
+
+  bool tryAcquire(Host& host) const noexcept {
+    if (this->options.maximumRequestsPerHost > 0 &&
+        host.requestsInFlight >= this->options.maximumRequestsPerHost) {
+      return false;
+    }
+    ++host.requestsInFlight;
+    return true;
+  }
+
+  // Frees the slot of a completed attempt, and gives it to the next waiting
+  // request, which is returned so that it is sent once the lock is released.
+  std::shared_ptr<Request> release(Host& host) {
+    --host.requestsInFlight;
+    if (host.waitingRequests.empty() || !this->tryAcquire(host)) {
+      return nullptr;
+    }
+
+    std::shared_ptr<Request> pNext = std::move(host.waitingRequests.front());
+    host.waitingRequests.pop_front();
+    ++pNext->attemptsInFlight;
+    return pNext;
+  }
+
+  void send(const std::shared_ptr<Request>& pRequest, bool hedge) {
+    uint32_t attempt;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      attempt = pRequest->retries;
+    }
+
+    const Clock::time_point startTime = Clock::now();
+
+    Future<std::shared_ptr<IAssetRequest>> future =
+        pRequest->verb == "GET"
+            ? this->pAssetAccessor->get(
+                  pRequest->asyncSystem,
+                  pRequest->url,
+                  pRequest->headers)
+            : this->pAssetAccessor->request(
+                  pRequest->asyncSystem,
+                  pRequest->verb,
+                  pRequest->url,
+                  pRequest->headers,
+                  pRequest->contentPayload);
+
+    std::shared_ptr<Requests> pThis = this->shared_from_this();
+    std::move(future)
+        .thenImmediately(
+            [pThis, pRequest, startTime, hedge](
+                std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
+              pThis->onAttemptComplete(
+                  pRequest,
+                  startTime,
+                  hedge,
+                  std::move(pCompletedRequest),
+                  nullptr);
+            })
+        .catchImmediately([pThis, pRequest, startTime, hedge](
+                              std::exception&&) {
+          pThis->onAttemptComplete(
+              pRequest,
+              startTime,
+              hedge,
+              nullptr,
+              std::current_exception());
+        });
+
+    if (!hedge) {
+      this->scheduleHedge(pRequest, attempt);
+    }
+  }
+
+  void
+  scheduleHedge(const std::shared_ptr<Request>& pRequest, uint32_t attempt) {
+    if (!this->options.enableHedging || !pRequest->retryable) {
+      return;
+    }
+
+    double delay;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      const LatencyHistogram& latency = this->hosts[pRequest->host].latency;
+      if (latency.sampleCount < this->options.minimumHedgingSamples) {
+        return;
+      }
+      delay = std::max(
+          latency.getPercentileMilliseconds(this->options.hedgingPercentile),
+          this->options.minimumHedgingDelayMilliseconds);
+    }
+
+    std::shared_ptr<Requests> pThis = this->shared_from_this();
+    this->schedule(delay, [pThis, pRequest, attempt]() {
+      pThis->hedge(pRequest, attempt);
+    });
+  }
+
+  // Sends a duplicate of an attempt that is still in progress, if its host
+  // has a free slot.
+  void hedge(const std::shared_ptr<Request>& pRequest, uint32_t attempt) {
+    if (this->isStopping()) {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (pRequest->completed || pRequest->retries != attempt ||
+          pRequest->attemptsInFlight != 1 ||
+          !this->tryAcquire(this->hosts[pRequest->host])) {
+        return;
+      }
+      ++pRequest->attemptsInFlight;
+      ++this->statistics.hedgedRequestCount;
+    }
+
+    this->send(pRequest, true);
+  }
+
+  bool isTransient(const IAssetRequest* pCompletedRequest) const {
+    const IAssetResponse* pResponse =
+        pCompletedRequest ? pCompletedRequest->response() : nullptr;
+    if (!pResponse) {
+      return true;
+    }
+
+    const std::vector<uint16_t>& codes = this->options.retryStatusCodes;
+    return std::find(codes.begin(), codes.end(), pResponse->statusCode()) !=
+           codes.end();
+  }
+
+  double computeRetryDelay(
+      uint32_t retry,
+      const IAssetRequest* pCompletedRequest) const {
+    double delay = this->options.initialRetryDelayMilliseconds *
+                   std::pow(
+                       this->options.retryBackoffMultiplier,
+                       static_cast<double>(retry - 1));
+    const IAssetResponse* pResponse =
+        pCompletedRequest ? pCompletedRequest->response() : nullptr;
+    if (pResponse) {
+      delay = std::max(delay, getRetryAfterMilliseconds(*pResponse));
+    }
+    return std::min(delay, this->options.maximumRetryDelayMilliseconds);
+  }
+
+  void onAttemptComplete(
+      const std::shared_ptr<Request>& pRequest,
+      Clock::time_point startTime,
+      bool hedge,
+      std::shared_ptr<IAssetRequest>&& pCompletedRequest,
+      std::exception_ptr pException) {
+    const bool transient =
+        pException || this->isTransient(pCompletedRequest.get());
+
+    enum class Action { None, Resolve, Reject, Retry };
+    Action action = Action::None;
+    double retryDelay = 0.0;
+    std::shared_ptr<Request> pNext;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      Host& host = this->hosts[pRequest->host];
+      pNext = this->release(host);
+
+      if (!pRequest->completed) {
+        --pRequest->attemptsInFlight;
+        if (!transient) {
+          host.latency.add(std::chrono::duration<double, std::milli>(
+                               Clock::now() - startTime)
+                               .count());
+          if (hedge) {
+            ++this->statistics.hedgeWinCount;
+          }
+          pRequest->completed = true;
+          pRequest->pLastRequest = std::move(pCompletedRequest);
+          action = Action::Resolve;
+        } else {
+          pRequest->pLastRequest = std::move(pCompletedRequest);
+          pRequest->pLastException = pException;
+
+          // Wait for the other attempt if there is one.
+          if (pRequest->attemptsInFlight > 0) {
+            action = Action::None;
+          } else if (
+              pRequest->retryable &&
+              pRequest->retries < this->options.maximumRetries) {
+            ++pRequest->retries;
+            ++this->statistics.retryCount;
+            retryDelay = this->computeRetryDelay(
+                pRequest->retries,
+                pRequest->pLastRequest.get());
+            action = Action::Retry;
+          } else {
+            ++this->statistics.exhaustedCount;
+            pRequest->completed = true;
+            action = pRequest->pLastException ? Action::Reject
+                                              : Action::Resolve;
+          }
+        }
+      }
+    }
+
+    if (pNext) {
+      this->send(pNext, false);
+    }
+
+    switch (action) {
+    case Action::Resolve:
+      pRequest->promise.resolve(std::move(pRequest->pLastRequest));
+      break;
+    case Action::Reject:
+      pRequest->promise.reject(pRequest->pLastException);
+      break;
+    case Action::Retry: {
+      std::shared_ptr<Requests> pThis = this->shared_from_this();
+      this->schedule(retryDelay, [pThis, pRequest]() {
+        pThis->sendWhenPossible(pRequest);
+      });
+      break;
+    }
+    case Action::None:
+      break;
+    }
+  }
+
+  // Runs a function in the timer thread after a delay, or right away if the
+  // accessor is being destroyed.
+  void schedule(double milliseconds, std::function<void()>&& f) {
+    {
+      std::lock_guard<std::mutex> lock(this->timerMutex);
+      if (!this->stopping) {
+        this->timers.emplace(
+            Clock::now() + toDuration(milliseconds),
+            std::move(f));
+        this->timerChanged.notify_one();
+        return;
+      }
+    }
+    f();
+  }
+
+  void runTimers() {
+    std::unique_lock<std::mutex> lock(this->timerMutex);
+    while (!this->stopping) {
+      if (this->timers.empty()) {
+        this->timerChanged.wait(lock);
+        continue;
+      }
+
+      auto it = this->timers.begin();
+      if (it->first > Clock::now()) {
+        this->timerChanged.wait_until(lock, it->first);
+        continue;
+      }
+
+      std::function<void()> f = std::move(it->second);
+      this->timers.erase(it);
+      lock.unlock();
+      f();
+      lock.lock();
+    }
+  }
+
+  // Stops the timer thread, after which functions are run when scheduled.
+  void stop() {
+    std::lock_guard<std::mutex> lock(this->timerMutex);
+    this->stopping = true;
+    this->timerChanged.notify_one();
+  }
+
+  bool isStopping() {
+    std::lock_guard<std::mutex> lock(this->timerMutex);
+    return this->stopping;
+  }
+
+  void runRemainingTimers() {
+    std::multimap<Clock::time_point, std::function<void()>> remaining;
+    {
+      std::lock_guard<std::mutex> lock(this->timerMutex);
+      remaining.swap(this->timers);
+    }
+    for (auto& timer : remaining) {
+      timer.second();
+    }
+  }
+
+  std::shared_ptr<IAssetAccessor> pAssetAccessor;
+  RetryingAssetAccessorOptions options;
+
+  mutable std::mutex mutex;
+  std::map<std::string, Host> hosts;
+  RetryingAssetAccessorStatistics statistics;
+
+  std::mutex timerMutex;
+  std::condition_variable timerChanged;
+  std::multimap<Clock::time_point, std::function<void()>> timers;
+  bool stopping;
+};
+
+RetryingAssetAccessor::RetryingAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const RetryingAssetAccessorOptions& options)
+    : _pRequests(std::make_shared<Requests>(pAssetAccessor, options)),
+      _timerThread([pRequests = this->_pRequests]() {
+        pRequests->runTimers();
+      }) {}
+
+RetryingAssetAccessor::~RetryingAssetAccessor() noexcept {
+  this->_pRequests->stop();
+  this->_timerThread.join();
+
+  // Hedges that were waiting are dropped, and retries are sent right away.
+  this->_pRequests->runRemainingTimers();
+}
+
+Future<std::shared_ptr<IAssetRequest>> RetryingAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->_pRequests->start(std::make_shared<Requests::Request>(
+      asyncSystem,
+      "GET",
+      url,
+      headers,
+      gsl::span<const std::byte>()));
+}
+
+Future<std::shared_ptr<IAssetRequest>> RetryingAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pRequests->start(std::make_shared<Requests::Request>(
+      asyncSystem,
+      verb,
+      url,
+      headers,
+      contentPayload));
+}
+
+void RetryingAssetAccessor::tick() noexcept {
+  this->_pRequests->pAssetAccessor->tick();
+}
+
+RetryingAssetAccessorStatistics RetryingAssetAccessor::getStatistics() const {
+  std::lock_guard<std::mutex> lock(this->_pRequests->mutex);
+  return this->_pRequests->statistics;
+}
+
+} // namespace CesiumAsync
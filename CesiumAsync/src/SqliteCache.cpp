@@ -2,6 +2,9 @@
 
 #include "CesiumAsync/IAssetResponse.h"
 
+#include <CesiumUtility/Gunzip.h>
+#include <CesiumUtility/Metrics.h>
+#include <CesiumUtility/ScopeGuard.h>
 #include <CesiumUtility/Tracing.h>
 #include <cesium-sqlite3.h>
 
@@ -10,9 +13,21 @@
 #include <spdlog/spdlog.h>
 #include <sqlite3.h>
 
+#include <condition_variable>
 #include <cstddef>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 using namespace CesiumAsync;
 
@@ -29,7 +44,11 @@ const std::string CACHE_TABLE_RESPONSE_DATA_COLUMN = "responseData";
 const std::string CACHE_TABLE_REQUEST_HEADER_COLUMN = "requestHeader";
 const std::string CACHE_TABLE_REQUEST_METHOD_COLUMN = "requestMethod";
 const std::string CACHE_TABLE_REQUEST_URL_COLUMN = "requestUrl";
-const std::string CACHE_TABLE_VIRTUAL_TOTAL_ITEMS_COLUMN = "totalItems";
+const std::string CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN = "responseDataFile";
+const std::string CACHE_TABLE_RESPONSE_DATA_COMPRESSED_COLUMN =
+    "responseDataCompressed";
+const std::string CACHE_TABLE_LAST_ACCESSED_TIME_INDEX =
+    CACHE_TABLE + "LastAccessedTimeIndex";
 
 // Sql commands for setting up database
 const std::string CREATE_CACHE_TABLE_SQL =
@@ -41,7 +60,21 @@ const std::string CREATE_CACHE_TABLE_SQL =
     " INTEGER NOT NULL," + CACHE_TABLE_RESPONSE_DATA_COLUMN + " BLOB," +
     CACHE_TABLE_REQUEST_HEADER_COLUMN + " TEXT NOT NULL," +
     CACHE_TABLE_REQUEST_METHOD_COLUMN + " TEXT NOT NULL," +
-    CACHE_TABLE_REQUEST_URL_COLUMN + " TEXT NOT NULL)";
+    CACHE_TABLE_REQUEST_URL_COLUMN + " TEXT NOT NULL," +
+    CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + " TEXT," +
+    CACHE_TABLE_RESPONSE_DATA_COMPRESSED_COLUMN + " INTEGER)";
+
+// Adds the data file column to a table that was created without it. This
+// fails if the column exists already.
+const std::string ADD_DATA_FILE_COLUMN_SQL =
+    "ALTER TABLE " + CACHE_TABLE + " ADD COLUMN " +
+    CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + " TEXT";
+
+// Adds the column that marks compressed response data to a table that was
+// created without it. This fails if the column exists already.
+const std::string ADD_DATA_COMPRESSED_COLUMN_SQL =
+    "ALTER TABLE " + CACHE_TABLE + " ADD COLUMN " +
+    CACHE_TABLE_RESPONSE_DATA_COMPRESSED_COLUMN + " INTEGER";
 
 const std::string PRAGMA_WAL_SQL = "PRAGMA journal_mode=WAL";
 
@@ -57,11 +90,17 @@ const std::string GET_ENTRY_SQL =
     CACHE_TABLE_RESPONSE_DATA_COLUMN + ", " +
     CACHE_TABLE_REQUEST_HEADER_COLUMN + ", " +
     CACHE_TABLE_REQUEST_METHOD_COLUMN + ", " + CACHE_TABLE_REQUEST_URL_COLUMN +
-    " FROM " + CACHE_TABLE + " WHERE " + CACHE_TABLE_KEY_COLUMN + "=?";
+    ", " + CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_COMPRESSED_COLUMN + " FROM " + CACHE_TABLE +
+    " WHERE " + CACHE_TABLE_KEY_COLUMN + "=?";
 
 const std::string UPDATE_LAST_ACCESSED_TIME_SQL =
     "UPDATE " + CACHE_TABLE + " SET " + CACHE_TABLE_LAST_ACCESSED_TIME_COLUMN +
-    " = strftime('%s','now') WHERE rowid =?";
+    " = ? WHERE rowid =?";
+
+const std::string BEGIN_TRANSACTION_SQL = "BEGIN";
+
+const std::string COMMIT_TRANSACTION_SQL = "COMMIT";
 
 // Sql commands for storing response
 const std::string STORE_RESPONSE_SQL =
@@ -72,25 +111,72 @@ const std::string STORE_RESPONSE_SQL =
     CACHE_TABLE_RESPONSE_DATA_COLUMN + ", " +
     CACHE_TABLE_REQUEST_HEADER_COLUMN + ", " +
     CACHE_TABLE_REQUEST_METHOD_COLUMN + ", " + CACHE_TABLE_REQUEST_URL_COLUMN +
-    ", " + CACHE_TABLE_KEY_COLUMN + ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)";
+    ", " + CACHE_TABLE_KEY_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_COMPRESSED_COLUMN +
+    ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
 
 // Sql commands for prunning the database
-const std::string TOTAL_ITEMS_QUERY_SQL =
-    "SELECT COUNT(*) " + CACHE_TABLE_VIRTUAL_TOTAL_ITEMS_COLUMN + " FROM " +
-    CACHE_TABLE;
 
-const std::string DELETE_EXPIRED_ITEMS_SQL =
-    "DELETE FROM " + CACHE_TABLE + " WHERE " + CACHE_TABLE_EXPIRY_TIME_COLUMN +
-    " < strftime('%s','now')";
+// The size of the response data of an entry. Data files are named by 16
+// random hexadecimal digits, a dash, and the size of their data.
+const std::string ITEM_BYTE_SIZE_SQL =
+    "IFNULL(LENGTH(" + CACHE_TABLE_RESPONSE_DATA_COLUMN +
+    "), 0) + IFNULL(CAST(SUBSTR(" + CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN +
+    ", 18) AS INTEGER), 0)";
+
+const std::string TOTALS_QUERY_SQL = "SELECT COUNT(*), TOTAL(" +
+                                     ITEM_BYTE_SIZE_SQL + ") FROM " +
+                                     CACHE_TABLE;
+
+const std::string ITEM_BYTE_SIZE_QUERY_SQL =
+    "SELECT " + ITEM_BYTE_SIZE_SQL + ", " +
+    CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + " FROM " + CACHE_TABLE +
+    " WHERE " + CACHE_TABLE_KEY_COLUMN + "=?";
+
+const std::string EXPIRED_ITEMS_QUERY_SQL =
+    "SELECT rowid, " + ITEM_BYTE_SIZE_SQL + " FROM " + CACHE_TABLE +
+    " WHERE " + CACHE_TABLE_EXPIRY_TIME_COLUMN +
+    " < strftime('%s','now') LIMIT ?";
+
+const std::string LRU_ITEMS_QUERY_SQL =
+    "SELECT rowid, " + ITEM_BYTE_SIZE_SQL + " FROM " + CACHE_TABLE +
+    " ORDER BY " + CACHE_TABLE_LAST_ACCESSED_TIME_COLUMN +
+    " ASC, rowid ASC LIMIT ?";
+
+const std::string DELETE_ITEM_SQL =
+    "DELETE FROM " + CACHE_TABLE + " WHERE rowid =?";
+
+const std::string CREATE_LAST_ACCESSED_TIME_INDEX_SQL =
+    "CREATE INDEX IF NOT EXISTS " + CACHE_TABLE_LAST_ACCESSED_TIME_INDEX +
+    " ON " + CACHE_TABLE + "(" + CACHE_TABLE_LAST_ACCESSED_TIME_COLUMN + ")";
 
-const std::string DELETE_LRU_ITEMS_SQL =
-    "DELETE FROM " + CACHE_TABLE + " WHERE rowid " + " IN (SELECT rowid FROM " +
-    CACHE_TABLE + " ORDER BY " + CACHE_TABLE_LAST_ACCESSED_TIME_COLUMN +
-    " ASC " + " LIMIT ?)";
+// The number of entries that prune deletes in each transaction. Other
+// calls only wait for one transaction.
+const size_t PRUNE_BATCH_SIZE = 256;
 
 // Sql commands for clean all items
 const std::string CLEAR_ALL_SQL = "DELETE FROM " + CACHE_TABLE;
 
+// Sql commands for reading all entries, with the same columns as
+// GET_ENTRY_SQL followed by the key
+const std::string ALL_ENTRIES_SQL =
+    "SELECT rowid, " + CACHE_TABLE_EXPIRY_TIME_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_HEADER_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_STATUS_CODE_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_COLUMN + ", " +
+    CACHE_TABLE_REQUEST_HEADER_COLUMN + ", " +
+    CACHE_TABLE_REQUEST_METHOD_COLUMN + ", " + CACHE_TABLE_REQUEST_URL_COLUMN +
+    ", " + CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_COMPRESSED_COLUMN + ", " +
+    CACHE_TABLE_KEY_COLUMN + " FROM " + CACHE_TABLE + " ORDER BY rowid";
+
+// Sql commands for finding the data files that are still used
+const std::string DATA_FILES_QUERY_SQL =
+    "SELECT DISTINCT " + CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + " FROM " +
+    CACHE_TABLE + " WHERE " + CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN +
+    " IS NOT NULL";
+
 std::string convertHeadersToString(const HttpHeaders& headers) {
   rapidjson::Document document;
   rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
@@ -163,284 +249,171 @@ SqliteStatementPtr prepareStatement(
   return SqliteStatementPtr(pStmt);
 }
 
-} // namespace
-
-namespace CesiumAsync {
-
-struct SqliteCache::Impl {
-  Impl(
-      const std::shared_ptr<spdlog::logger>& pLogger,
-      const std::string& databaseName,
-      uint64_t maxItems)
-      : _pLogger(pLogger),
-        _pConnection(nullptr),
-        _databaseName(databaseName),
-        _maxItems(maxItems),
-        _getEntryStmtWrapper(),
-        _updateLastAccessedTimeStmtWrapper(),
-        _storeResponseStmtWrapper(),
-        _totalItemsQueryStmtWrapper(),
-        _deleteExpiredStmtWrapper(),
-        _deleteLRUStmtWrapper(),
-        _clearAllStmtWrapper() {}
-
-  std::shared_ptr<spdlog::logger> _pLogger;
-  SqliteConnectionPtr _pConnection;
-  std::string _databaseName;
-  uint64_t _maxItems;
-  mutable std::mutex _mutex;
-  SqliteStatementPtr _getEntryStmtWrapper;
-  SqliteStatementPtr _updateLastAccessedTimeStmtWrapper;
-  SqliteStatementPtr _storeResponseStmtWrapper;
-  SqliteStatementPtr _totalItemsQueryStmtWrapper;
-  SqliteStatementPtr _deleteExpiredStmtWrapper;
-  SqliteStatementPtr _deleteLRUStmtWrapper;
-  SqliteStatementPtr _clearAllStmtWrapper;
-};
-
-SqliteCache::SqliteCache(
-    const std::shared_ptr<spdlog::logger>& pLogger,
-    const std::string& databaseName,
-    uint64_t maxItems)
-    : _pImpl(std::make_unique<Impl>(pLogger, databaseName, maxItems)) {
-  createConnection();
-}
-
-void SqliteCache::createConnection() const {
-  CESIUM_SQLITE(sqlite3*) pConnection;
-  int status = CESIUM_SQLITE(
-      sqlite3_open)(this->_pImpl->_databaseName.c_str(), &pConnection);
-  if (status != SQLITE_OK) {
-    throw std::runtime_error(CESIUM_SQLITE(sqlite3_errstr)(status));
-  }
-
-  this->_pImpl->_pConnection =
-      std::unique_ptr<CESIUM_SQLITE(sqlite3), DeleteSqliteConnection>(
-          pConnection);
-
-  // create cache tables if not exist. Key -> Cache table: one-to-many
-  // relationship
-  char* createTableError = nullptr;
-  status = CESIUM_SQLITE(sqlite3_exec)(
-      this->_pImpl->_pConnection.get(),
-      CREATE_CACHE_TABLE_SQL.c_str(),
-      nullptr,
-      nullptr,
-      &createTableError);
-  if (status != SQLITE_OK) {
-    std::string errorStr(createTableError);
-    CESIUM_SQLITE(sqlite3_free)(createTableError);
-    throw std::runtime_error(errorStr);
-  }
-
-  // turn on WAL mode
-  char* walError = nullptr;
-  status = CESIUM_SQLITE(sqlite3_exec)(
-      this->_pImpl->_pConnection.get(),
-      PRAGMA_WAL_SQL.c_str(),
-      nullptr,
-      nullptr,
-      &walError);
-  if (status != SQLITE_OK) {
-    std::string errorStr(walError);
-    CESIUM_SQLITE(sqlite3_free)(walError);
-    throw std::runtime_error(errorStr);
-  }
+// The number of cache hits in reader connections after which their last
+// accessed times are written.
+const size_t ACCESSED_ITEMS_BATCH_SIZE = 64;
 
-  // turn off synchronous mode
-  char* syncError = nullptr;
-  status = CESIUM_SQLITE(sqlite3_exec)(
-      this->_pImpl->_pConnection.get(),
-      PRAGMA_SYNC_SQL.c_str(),
-      nullptr,
-      nullptr,
-      &syncError);
-  if (status != SQLITE_OK) {
-    std::string errorStr(syncError);
-    CESIUM_SQLITE(sqlite3_free)(syncError);
-    throw std::runtime_error(errorStr);
-  }
+// The number of stored entries, and their total size in bytes, from which
+// they are written.
+const size_t PENDING_ENTRIES_BATCH_SIZE = 64;
+const size_t PENDING_ENTRIES_BATCH_BYTES = 16 * 1024 * 1024;
 
-  // increase page size
-  char* pageSizeError = nullptr;
-  status = CESIUM_SQLITE(sqlite3_exec)(
-      this->_pImpl->_pConnection.get(),
-      PRAGMA_PAGE_SIZE_SQL.c_str(),
+int executeStatement(
+    const SqliteConnectionPtr& pConnection,
+    const std::string& sql,
+    const std::shared_ptr<spdlog::logger>& pLogger) {
+  char* error = nullptr;
+  const int status = CESIUM_SQLITE(sqlite3_exec)(
+      pConnection.get(),
+      sql.c_str(),
       nullptr,
       nullptr,
-      &pageSizeError);
+      &error);
   if (status != SQLITE_OK) {
-    std::string errorStr(pageSizeError);
-    CESIUM_SQLITE(sqlite3_free)(pageSizeError);
-    throw std::runtime_error(errorStr);
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        error ? error : CESIUM_SQLITE(sqlite3_errstr)(status));
+    CESIUM_SQLITE(sqlite3_free)(error);
   }
+  return status;
+}
 
-  // get entry based on key
-  this->_pImpl->_getEntryStmtWrapper =
-      prepareStatement(this->_pImpl->_pConnection, GET_ENTRY_SQL);
-
-  // update last accessed for entry
-  this->_pImpl->_updateLastAccessedTimeStmtWrapper = prepareStatement(
-      this->_pImpl->_pConnection,
-      UPDATE_LAST_ACCESSED_TIME_SQL);
-
-  // store response
-  this->_pImpl->_storeResponseStmtWrapper =
-      prepareStatement(this->_pImpl->_pConnection, STORE_RESPONSE_SQL);
-
-  // query total items
-  this->_pImpl->_totalItemsQueryStmtWrapper =
-      prepareStatement(this->_pImpl->_pConnection, TOTAL_ITEMS_QUERY_SQL);
-
-  // delete expired items
-  this->_pImpl->_deleteExpiredStmtWrapper =
-      prepareStatement(this->_pImpl->_pConnection, DELETE_EXPIRED_ITEMS_SQL);
-
-  // delete expired items
-  this->_pImpl->_deleteLRUStmtWrapper =
-      prepareStatement(this->_pImpl->_pConnection, DELETE_LRU_ITEMS_SQL);
+struct ResetStatementOnExit {
+  ~ResetStatementOnExit() noexcept { CESIUM_SQLITE(sqlite3_reset)(pStmt); }
+  CESIUM_SQLITE(sqlite3_stmt*) pStmt;
+};
 
-  // clear all items
-  this->_pImpl->_clearAllStmtWrapper =
-      prepareStatement(this->_pImpl->_pConnection, CLEAR_ALL_SQL);
+std::mt19937_64 createDataFileNameGenerator() {
+  std::random_device device;
+  std::seed_seq seed{device(), device(), device(), device()};
+  return std::mt19937_64(seed);
 }
 
-SqliteCache::~SqliteCache() = default;
-
-std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
-  CESIUM_TRACE("SqliteCache::getEntry");
-  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+// Names a data file randomly. Each entry gets its own file, so that an entry
+// can never read the data of another.
+std::string
+createDataFileName(std::mt19937_64& generator, size_t byteSize) {
+  std::ostringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << generator()
+         << "-" << std::dec << byteSize;
+  return stream.str();
+}
 
-  // get entry based on key
-  int status =
-      CESIUM_SQLITE(sqlite3_reset)(this->_pImpl->_getEntryStmtWrapper.get());
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return std::nullopt;
+bool readDataFile(const std::string& path, std::vector<std::byte>& data) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
   }
 
-  status = CESIUM_SQLITE(sqlite3_clear_bindings)(
-      this->_pImpl->_getEntryStmtWrapper.get());
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return std::nullopt;
+  const std::streamoff size = file.tellg();
+  if (size < 0) {
+    return false;
   }
 
-  status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_getEntryStmtWrapper.get(),
-      1,
-      key.c_str(),
-      -1,
-      SQLITE_STATIC);
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return std::nullopt;
-  }
+  data.resize(static_cast<size_t>(size));
+  file.seekg(0, std::ios::beg);
+  file.read(reinterpret_cast<char*>(data.data()), size);
+  return bool(file);
+}
 
-  status =
-      CESIUM_SQLITE(sqlite3_step)(this->_pImpl->_getEntryStmtWrapper.get());
-  if (status == SQLITE_DONE) {
-    // Cache miss
-    return std::nullopt;
+bool writeDataFile(
+    const std::string& path,
+    const std::vector<std::byte>& data) {
+  // Write a temporary file first, so that a data file is always complete.
+  const std::string temporaryPath = path + ".tmp";
+  {
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    file.write(
+        reinterpret_cast<const char*>(data.data()),
+        static_cast<std::streamsize>(data.size()));
+    if (!file) {
+      return false;
+    }
   }
 
-  if (status != SQLITE_ROW) {
-    // Something went wrong.
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return std::nullopt;
+  std::error_code error;
+  std::filesystem::rename(temporaryPath, path, error);
+  return !error;
+}
+
+bool decompressResponseData(
+    std::vector<std::byte>& data,
+    const std::shared_ptr<spdlog::logger>& pLogger) {
+  std::vector<std::byte> decompressedData;
+  if (!CesiumUtility::gunzip(data, decompressedData)) {
+    SPDLOG_LOGGER_ERROR(pLogger, "Unable to decompress cached response data.");
+    return false;
   }
 
-  // Cache hit - unpack and return it.
-  const int64_t itemIndex = CESIUM_SQLITE(
-      sqlite3_column_int64)(this->_pImpl->_getEntryStmtWrapper.get(), 0);
+  data = std::move(decompressedData);
+  return true;
+}
 
+// Reads the item of the current row of a GET_ENTRY_SQL or ALL_ENTRIES_SQL
+// statement. Response data that is stored in a file is read from the given
+// directory.
+std::optional<CacheItem> readItem(
+    CESIUM_SQLITE(sqlite3_stmt*) pStmt,
+    const std::string& dataFileDirectory,
+    const std::shared_ptr<spdlog::logger>& pLogger) {
   // parse cache item metadata
-  const std::time_t expiryTime = CESIUM_SQLITE(
-      sqlite3_column_int64)(this->_pImpl->_getEntryStmtWrapper.get(), 1);
+  const std::time_t expiryTime = CESIUM_SQLITE(sqlite3_column_int64)(pStmt, 1);
 
   // parse response cache
-  std::string serializedResponseHeaders =
-      reinterpret_cast<const char*>(CESIUM_SQLITE(
-          sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 2));
+  std::string serializedResponseHeaders = reinterpret_cast<const char*>(
+      CESIUM_SQLITE(sqlite3_column_text)(pStmt, 2));
   std::optional<HttpHeaders> responseHeaders =
-      convertStringToHeaders(serializedResponseHeaders, this->_pImpl->_pLogger);
+      convertStringToHeaders(serializedResponseHeaders, pLogger);
   if (!responseHeaders) {
     return std::nullopt;
   }
-  const uint16_t statusCode = static_cast<uint16_t>(CESIUM_SQLITE(
-      sqlite3_column_int)(this->_pImpl->_getEntryStmtWrapper.get(), 3));
-
-  const std::byte* rawResponseData =
-      reinterpret_cast<const std::byte*>(CESIUM_SQLITE(
-          sqlite3_column_blob)(this->_pImpl->_getEntryStmtWrapper.get(), 4));
-  const int responseDataSize = CESIUM_SQLITE(
-      sqlite3_column_bytes)(this->_pImpl->_getEntryStmtWrapper.get(), 4);
-  std::vector<std::byte> responseData(
-      rawResponseData,
-      rawResponseData + responseDataSize);
-
-  // parse request
-  std::string serializedRequestHeaders =
-      reinterpret_cast<const char*>(CESIUM_SQLITE(
-          sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 5));
-  std::optional<HttpHeaders> requestHeaders =
-      convertStringToHeaders(serializedRequestHeaders, this->_pImpl->_pLogger);
-  if (!requestHeaders) {
-    return std::nullopt;
+  const uint16_t statusCode =
+      static_cast<uint16_t>(CESIUM_SQLITE(sqlite3_column_int)(pStmt, 3));
+
+  std::vector<std::byte> responseData;
+  const unsigned char* dataFileName =
+      CESIUM_SQLITE(sqlite3_column_text)(pStmt, 8);
+  if (dataFileName) {
+    // The response data is in a file, which is read without copying it into
+    // SQLite's pages first.
+    const std::string dataFilePath =
+        dataFileDirectory + "/" + reinterpret_cast<const char*>(dataFileName);
+    if (dataFileDirectory.empty() ||
+        !readDataFile(dataFilePath, responseData)) {
+      SPDLOG_LOGGER_ERROR(
+          pLogger,
+          "Unable to read cached response data file {}.",
+          dataFilePath);
+      return std::nullopt;
+    }
+  } else {
+    const std::byte* rawResponseData = reinterpret_cast<const std::byte*>(
+        CESIUM_SQLITE(sqlite3_column_blob)(pStmt, 4));
+    const int responseDataSize =
+        CESIUM_SQLITE(sqlite3_column_bytes)(pStmt, 4);
+    responseData.assign(rawResponseData, rawResponseData + responseDataSize);
   }
 
-  std::string requestMethod = reinterpret_cast<const char*>(CESIUM_SQLITE(
-      sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 6));
-
-  std::string requestUrl = reinterpret_cast<const char*>(CESIUM_SQLITE(
-      sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 7));
-
-  // update the last accessed time
-  int updateStatus = CESIUM_SQLITE(sqlite3_reset)(
-      this->_pImpl->_updateLastAccessedTimeStmtWrapper.get());
-  if (updateStatus != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
+  // Compressed response data is only decompressed when it is read.
+  if (CESIUM_SQLITE(sqlite3_column_int)(pStmt, 9) != 0 &&
+      !decompressResponseData(responseData, pLogger)) {
     return std::nullopt;
   }
 
-  updateStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
-      this->_pImpl->_updateLastAccessedTimeStmtWrapper.get());
-  if (updateStatus != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
+  // parse request
+  std::string serializedRequestHeaders = reinterpret_cast<const char*>(
+      CESIUM_SQLITE(sqlite3_column_text)(pStmt, 5));
+  std::optional<HttpHeaders> requestHeaders =
+      convertStringToHeaders(serializedRequestHeaders, pLogger);
+  if (!requestHeaders) {
     return std::nullopt;
   }
 
-  updateStatus = CESIUM_SQLITE(sqlite3_bind_int64)(
-      this->_pImpl->_updateLastAccessedTimeStmtWrapper.get(),
-      1,
-      itemIndex);
-  if (updateStatus != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
-    return std::nullopt;
-  }
+  std::string requestMethod = reinterpret_cast<const char*>(
+      CESIUM_SQLITE(sqlite3_column_text)(pStmt, 6));
 
-  updateStatus = CESIUM_SQLITE(sqlite3_step)(
-      this->_pImpl->_updateLastAccessedTimeStmtWrapper.get());
-  if (updateStatus != SQLITE_DONE) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
-    return std::nullopt;
-  }
+  std::string requestUrl = reinterpret_cast<const char*>(
+      CESIUM_SQLITE(sqlite3_column_text)(pStmt, 7));
 
   return CacheItem{
       expiryTime,
@@ -454,310 +427,1246 @@ std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
           std::move(responseData)}};
 }
 
-bool SqliteCache::storeEntry(
+// Reads an entry with a GET_ENTRY_SQL statement, and gets its rowid.
+std::optional<CacheItem> readEntry(
+    CESIUM_SQLITE(sqlite3_stmt*) pStmt,
     const std::string& key,
-    std::time_t expiryTime,
-    const std::string& url,
-    const std::string& requestMethod,
-    const HttpHeaders& requestHeaders,
-    uint16_t statusCode,
-    const HttpHeaders& responseHeaders,
-    const gsl::span<const std::byte>& responseData) {
-  CESIUM_TRACE("SqliteCache::storeEntry");
-  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
-
-  // cache the request with the key
-  int status = CESIUM_SQLITE(sqlite3_reset)(
-      this->_pImpl->_storeResponseStmtWrapper.get());
+    const std::string& dataFileDirectory,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    int64_t& itemIndex) {
+  // get entry based on key
+  int status = CESIUM_SQLITE(sqlite3_reset)(pStmt);
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+    SPDLOG_LOGGER_ERROR(pLogger, CESIUM_SQLITE(sqlite3_errstr)(status));
+    return std::nullopt;
   }
 
-  status = CESIUM_SQLITE(sqlite3_clear_bindings)(
-      this->_pImpl->_storeResponseStmtWrapper.get());
+  status = CESIUM_SQLITE(sqlite3_clear_bindings)(pStmt);
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+    SPDLOG_LOGGER_ERROR(pLogger, CESIUM_SQLITE(sqlite3_errstr)(status));
+    return std::nullopt;
   }
 
-  status = CESIUM_SQLITE(sqlite3_bind_int64)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      1,
-      static_cast<int64_t>(expiryTime));
+  status = CESIUM_SQLITE(
+      sqlite3_bind_text)(pStmt, 1, key.c_str(), -1, SQLITE_STATIC);
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+    SPDLOG_LOGGER_ERROR(pLogger, CESIUM_SQLITE(sqlite3_errstr)(status));
+    return std::nullopt;
   }
 
-  status = CESIUM_SQLITE(sqlite3_bind_int64)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      2,
-      static_cast<int64_t>(std::time(nullptr)));
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
-  }
+  // Reset the statement when done, so that it does not keep the read
+  // transaction open. Otherwise the connection would keep reading an old
+  // snapshot of the database.
+  ResetStatementOnExit resetOnExit{pStmt};
 
-  std::string responseHeaderString = convertHeadersToString(responseHeaders);
-  status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      3,
+  status = CESIUM_SQLITE(sqlite3_step)(pStmt);
+  if (status == SQLITE_DONE) {
+    // Cache miss
+    return std::nullopt;
+  }
+
+  if (status != SQLITE_ROW) {
+    // Something went wrong.
+    SPDLOG_LOGGER_ERROR(pLogger, CESIUM_SQLITE(sqlite3_errstr)(status));
+    return std::nullopt;
+  }
+
+  // Cache hit - unpack and return it.
+  itemIndex = CESIUM_SQLITE(sqlite3_column_int64)(pStmt, 0);
+  return readItem(pStmt, dataFileDirectory, pLogger);
+}
+
+// A read-only connection for reading entries concurrently with other reader
+// connections and with the writer connection.
+struct ReaderConnection {
+  SqliteConnectionPtr pConnection;
+  SqliteStatementPtr pGetEntryStmt;
+};
+
+std::unique_ptr<ReaderConnection> openReaderConnection(
+    const std::string& databaseName,
+    const std::shared_ptr<spdlog::logger>& pLogger) {
+  CESIUM_SQLITE(sqlite3*) pConnection = nullptr;
+  const int status = CESIUM_SQLITE(sqlite3_open_v2)(
+      databaseName.c_str(),
+      &pConnection,
+      SQLITE_OPEN_READONLY,
+      nullptr);
+
+  // The connection must be closed even if it could not be opened.
+  SqliteConnectionPtr pReaderConnection(pConnection);
+  if (status != SQLITE_OK) {
+    SPDLOG_LOGGER_ERROR(pLogger, CESIUM_SQLITE(sqlite3_errstr)(status));
+    return nullptr;
+  }
+
+  // In WAL mode, readers are only busy while the WAL is recovered.
+  CESIUM_SQLITE(sqlite3_busy_timeout)(pReaderConnection.get(), 1000);
+
+  try {
+    SqliteStatementPtr pGetEntryStmt =
+        prepareStatement(pReaderConnection, GET_ENTRY_SQL);
+    return std::make_unique<ReaderConnection>(ReaderConnection{
+        std::move(pReaderConnection),
+        std::move(pGetEntryStmt)});
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(pLogger, e.what());
+    return nullptr;
+  }
+}
+
+} // namespace
+
+namespace CesiumAsync {
+
+struct SqliteCache::Impl {
+  Impl(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& databaseName,
+      uint64_t maxItems,
+      size_t maxReaderConnections,
+      size_t responseDataFileThreshold,
+      uint64_t maxBytes,
+      bool compressResponseData)
+      : _pLogger(pLogger),
+        _pConnection(nullptr),
+        _databaseName(databaseName),
+        _maxItems(maxItems),
+        _maxBytes(maxBytes),
+        _itemCount(0),
+        _byteSize(0),
+        _getEntryStmtWrapper(),
+        _updateLastAccessedTimeStmtWrapper(),
+        _storeResponseStmtWrapper(),
+        _totalsQueryStmtWrapper(),
+        _itemByteSizeQueryStmtWrapper(),
+        _expiredItemsQueryStmtWrapper(),
+        _lruItemsQueryStmtWrapper(),
+        _deleteItemStmtWrapper(),
+        _clearAllStmtWrapper(),
+        _dataFilesQueryStmtWrapper(),
+        _allEntriesStmtWrapper(),
+        _compressResponseData(compressResponseData),
+        _responseDataFileThreshold(responseDataFileThreshold),
+        _dataFileDirectory(
+            databaseName.empty() || databaseName == ":memory:" ||
+                    responseDataFileThreshold == 0
+                ? std::string()
+                : databaseName + ".files"),
+        _dataFileNameGenerator(createDataFileNameGenerator()),
+        _replacedDataFiles(),
+        _maxReaderConnections(
+            databaseName.empty() || databaseName == ":memory:"
+                ? 0
+                : maxReaderConnections),
+        _readerConnectionCount(0),
+        _readerConnectionsInUse(0),
+        _readerConnectionsClosing(false),
+        _idleReaderConnections(),
+        _accessedItems(),
+        _pendingEntries(),
+        _writingEntries(),
+        _pendingByteSize(0) {}
+
+  // Hands out a reader connection for as long as it exists.
+  struct ReaderLease {
+    explicit ReaderLease(Impl& owner)
+        : impl(owner), pReader(owner.acquireReaderConnection()) {}
+    ~ReaderLease() noexcept {
+      if (this->pReader) {
+        this->impl.releaseReaderConnection(std::move(this->pReader));
+      }
+    }
+    Impl& impl;
+    std::unique_ptr<ReaderConnection> pReader;
+  };
+
+  struct AccessedItem {
+    int64_t itemIndex;
+    int64_t accessedTime;
+  };
+
+  struct PendingEntry {
+    std::string key;
+    CacheItem item;
+    int64_t storedTime;
+
+    // Whether the response data of the item is compressed.
+    bool compressed;
+  };
+
+  // The stored entries in the order in which they were stored, so that they
+  // are written in that order, too. An entry that was stored again later is
+  // skipped.
+  struct PendingEntries {
+    std::vector<PendingEntry> entries;
+    std::unordered_map<std::string, size_t> latestEntryIndices;
+
+    bool isLatest(size_t index) const {
+      return this->latestEntryIndices.at(this->entries[index].key) == index;
+    }
+
+    void clear() {
+      this->entries.clear();
+      this->latestEntryIndices.clear();
+    }
+
+    void swap(PendingEntries& other) {
+      this->entries.swap(other.entries);
+      this->latestEntryIndices.swap(other.latestEntryIndices);
+    }
+  };
+
+  std::unique_ptr<ReaderConnection> acquireReaderConnection();
+  void
+  releaseReaderConnection(std::unique_ptr<ReaderConnection>&& pConnection);
+  void closeReaderConnections();
+  void reopenReaderConnections();
+
+  size_t recordAccess(int64_t itemIndex);
+  const PendingEntry* findPendingEntry(const std::string& key) const;
+
+  // These require _mutex, and return the status of the last statement.
+  int writeEntry(const std::string& key, const PendingEntry& entry);
+  int writeAccessedItem(const AccessedItem& accessedItem);
+  int writePendingChanges();
+  void removeUnusedDataFiles();
+
+  int countItems();
+  bool isOverLimits() const noexcept;
+  int deleteItems(
+      CESIUM_SQLITE(sqlite3_stmt*) pQueryStmt,
+      bool stopWhenWithinLimits,
+      size_t& deletedCount);
+
+  std::shared_ptr<spdlog::logger> _pLogger;
+  SqliteConnectionPtr _pConnection;
+  std::string _databaseName;
+  uint64_t _maxItems;
+  uint64_t _maxBytes;
+
+  // The number of entries in the database, and the size of their response
+  // data, which are kept up to date as entries are written and deleted.
+  int64_t _itemCount;
+  int64_t _byteSize;
+
+  mutable std::mutex _mutex;
+  SqliteStatementPtr _getEntryStmtWrapper;
+  SqliteStatementPtr _updateLastAccessedTimeStmtWrapper;
+  SqliteStatementPtr _storeResponseStmtWrapper;
+  SqliteStatementPtr _totalsQueryStmtWrapper;
+  SqliteStatementPtr _itemByteSizeQueryStmtWrapper;
+  SqliteStatementPtr _expiredItemsQueryStmtWrapper;
+  SqliteStatementPtr _lruItemsQueryStmtWrapper;
+  SqliteStatementPtr _deleteItemStmtWrapper;
+  SqliteStatementPtr _clearAllStmtWrapper;
+  SqliteStatementPtr _dataFilesQueryStmtWrapper;
+  SqliteStatementPtr _allEntriesStmtWrapper;
+
+  // Whether response data is compressed before it is stored, when that makes
+  // it smaller.
+  bool _compressResponseData;
+
+  // Response data of at least this many bytes is stored in a file in the
+  // directory, instead of in the database. The directory is empty when all
+  // response data is stored in the database.
+  size_t _responseDataFileThreshold;
+  std::string _dataFileDirectory;
+  std::mt19937_64 _dataFileNameGenerator;
+
+  // The data files of the entries that were replaced in the transaction that
+  // is being written, which are deleted once it is committed.
+  std::vector<std::string> _replacedDataFiles;
+
+  // The pool of reader connections. Cache hits only wait for each other when
+  // all of them are in use, and never for the writer connection above, which
+  // is guarded by _mutex.
+  size_t _maxReaderConnections;
+  size_t _readerConnectionCount;
+  size_t _readerConnectionsInUse;
+  bool _readerConnectionsClosing;
+  std::vector<std::unique_ptr<ReaderConnection>> _idleReaderConnections;
+  std::mutex _readerConnectionsMutex;
+  std::condition_variable _readerConnectionAvailable;
+
+  // The items that were read with reader connections, whose last accessed
+  // times are still to be written with the writer connection.
+  std::vector<AccessedItem> _accessedItems;
+  std::mutex _accessedItemsMutex;
+
+  // The stored entries that are still to be written, and the ones that are
+  // being written, which getEntry finds before reading the database.
+  PendingEntries _pendingEntries;
+  PendingEntries _writingEntries;
+  size_t _pendingByteSize;
+  std::mutex _pendingEntriesMutex;
+};
+
+std::unique_ptr<ReaderConnection>
+SqliteCache::Impl::acquireReaderConnection() {
+  std::unique_lock<std::mutex> lock(this->_readerConnectionsMutex);
+  this->_readerConnectionAvailable.wait(lock, [this]() {
+    return this->_maxReaderConnections == 0 ||
+           (!this->_readerConnectionsClosing &&
+            (!this->_idleReaderConnections.empty() ||
+             this->_readerConnectionCount < this->_maxReaderConnections));
+  });
+
+  if (this->_maxReaderConnections == 0) {
+    return nullptr;
+  }
+
+  ++this->_readerConnectionsInUse;
+  if (!this->_idleReaderConnections.empty()) {
+    std::unique_ptr<ReaderConnection> pConnection =
+        std::move(this->_idleReaderConnections.back());
+    this->_idleReaderConnections.pop_back();
+    return pConnection;
+  }
+
+  ++this->_readerConnectionCount;
+  lock.unlock();
+
+  std::unique_ptr<ReaderConnection> pConnection =
+      openReaderConnection(this->_databaseName, this->_pLogger);
+  if (!pConnection) {
+    // Read with the writer connection from now on.
+    lock.lock();
+    this->_maxReaderConnections = 0;
+    --this->_readerConnectionCount;
+    --this->_readerConnectionsInUse;
+    this->_readerConnectionAvailable.notify_all();
+  }
+
+  return pConnection;
+}
+
+void SqliteCache::Impl::releaseReaderConnection(
+    std::unique_ptr<ReaderConnection>&& pConnection) {
+  std::lock_guard<std::mutex> lock(this->_readerConnectionsMutex);
+  --this->_readerConnectionsInUse;
+  if (this->_readerConnectionsClosing) {
+    --this->_readerConnectionCount;
+    pConnection.reset();
+  } else {
+    this->_idleReaderConnections.emplace_back(std::move(pConnection));
+  }
+  this->_readerConnectionAvailable.notify_all();
+}
+
+void SqliteCache::Impl::closeReaderConnections() {
+  std::unique_lock<std::mutex> lock(this->_readerConnectionsMutex);
+  this->_readerConnectionsClosing = true;
+  this->_readerConnectionAvailable.wait(lock, [this]() {
+    return this->_readerConnectionsInUse == 0;
+  });
+  this->_readerConnectionCount -= this->_idleReaderConnections.size();
+  this->_idleReaderConnections.clear();
+}
+
+void SqliteCache::Impl::reopenReaderConnections() {
+  std::lock_guard<std::mutex> lock(this->_readerConnectionsMutex);
+  this->_readerConnectionsClosing = false;
+  this->_readerConnectionAvailable.notify_all();
+}
+
+size_t SqliteCache::Impl::recordAccess(int64_t itemIndex) {
+  std::lock_guard<std::mutex> lock(this->_accessedItemsMutex);
+  this->_accessedItems.push_back(
+      AccessedItem{itemIndex, static_cast<int64_t>(std::time(nullptr))});
+  return this->_accessedItems.size();
+}
+
+const SqliteCache::Impl::PendingEntry*
+SqliteCache::Impl::findPendingEntry(const std::string& key) const {
+  auto it = this->_pendingEntries.latestEntryIndices.find(key);
+  if (it != this->_pendingEntries.latestEntryIndices.end()) {
+    return &this->_pendingEntries.entries[it->second];
+  }
+
+  it = this->_writingEntries.latestEntryIndices.find(key);
+  if (it != this->_writingEntries.latestEntryIndices.end()) {
+    return &this->_writingEntries.entries[it->second];
+  }
+
+  return nullptr;
+}
+
+int SqliteCache::Impl::writeEntry(
+    const std::string& key,
+    const PendingEntry& entry) {
+  const CacheItem& item = entry.item;
+
+  // Find the size of the entry that this one replaces, if any.
+  CESIUM_SQLITE(sqlite3_stmt*) pSizeStmt =
+      this->_itemByteSizeQueryStmtWrapper.get();
+  int status = CESIUM_SQLITE(sqlite3_reset)(pSizeStmt);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  status = CESIUM_SQLITE(
+      sqlite3_bind_text)(pSizeStmt, 1, key.c_str(), -1, SQLITE_STATIC);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  status = CESIUM_SQLITE(sqlite3_step)(pSizeStmt);
+  if (status != SQLITE_ROW && status != SQLITE_DONE) {
+    return status;
+  }
+  const bool replacesItem = status == SQLITE_ROW;
+  const int64_t replacedByteSize =
+      replacesItem ? CESIUM_SQLITE(sqlite3_column_int64)(pSizeStmt, 0) : 0;
+  const unsigned char* pReplacedDataFileName =
+      replacesItem ? CESIUM_SQLITE(sqlite3_column_text)(pSizeStmt, 1)
+                   : nullptr;
+  std::string replacedDataFileName =
+      pReplacedDataFileName
+          ? reinterpret_cast<const char*>(pReplacedDataFileName)
+          : "";
+  CESIUM_SQLITE(sqlite3_reset)(pSizeStmt);
+
+  CESIUM_SQLITE(sqlite3_stmt*) pStmt = this->_storeResponseStmtWrapper.get();
+  status = CESIUM_SQLITE(sqlite3_reset)(pStmt);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  status = CESIUM_SQLITE(sqlite3_clear_bindings)(pStmt);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  status = CESIUM_SQLITE(
+      sqlite3_bind_int64)(pStmt, 1, static_cast<int64_t>(item.expiryTime));
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  status = CESIUM_SQLITE(sqlite3_bind_int64)(pStmt, 2, entry.storedTime);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  const std::string responseHeaderString =
+      convertHeadersToString(item.cacheResponse.headers);
+  status = CESIUM_SQLITE(sqlite3_bind_text)(
+      pStmt,
+      3,
       responseHeaderString.c_str(),
       -1,
       SQLITE_STATIC);
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+    return status;
   }
 
   status = CESIUM_SQLITE(sqlite3_bind_int)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
+      pStmt,
       4,
-      static_cast<int>(statusCode));
+      static_cast<int>(item.cacheResponse.statusCode));
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+    return status;
   }
 
-  status = CESIUM_SQLITE(sqlite3_bind_blob)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      5,
-      responseData.data(),
-      static_cast<int>(responseData.size()),
-      SQLITE_STATIC);
+  const std::vector<std::byte>& data = item.cacheResponse.data;
+  std::string dataFileName;
+  if (!this->_dataFileDirectory.empty() &&
+      data.size() >= this->_responseDataFileThreshold) {
+    // Random names practically never collide, but the file of another entry
+    // must never be overwritten, so a name that is in use is drawn again.
+    std::string dataFilePath;
+    std::error_code error;
+    do {
+      dataFileName =
+          createDataFileName(this->_dataFileNameGenerator, data.size());
+      dataFilePath = this->_dataFileDirectory + "/" + dataFileName;
+    } while (std::filesystem::exists(dataFilePath, error));
+
+    if (error || !writeDataFile(dataFilePath, data)) {
+      SPDLOG_LOGGER_WARN(
+          this->_pLogger,
+          "Unable to write cached response data file {}, storing the data "
+          "in the database instead.",
+          dataFilePath);
+      dataFileName.clear();
+    }
+  }
+
+  if (dataFileName.empty()) {
+    status = CESIUM_SQLITE(sqlite3_bind_blob)(
+        pStmt,
+        5,
+        data.data(),
+        static_cast<int>(data.size()),
+        SQLITE_STATIC);
+  } else {
+    status = CESIUM_SQLITE(sqlite3_bind_null)(pStmt, 5);
+  }
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+    return status;
   }
 
-  std::string requestHeaderString = convertHeadersToString(requestHeaders);
+  const std::string requestHeaderString =
+      convertHeadersToString(item.cacheRequest.headers);
   status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
+      pStmt,
       6,
       requestHeaderString.c_str(),
       -1,
       SQLITE_STATIC);
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+    return status;
   }
 
   status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
+      pStmt,
       7,
-      requestMethod.c_str(),
+      item.cacheRequest.method.c_str(),
       -1,
       SQLITE_STATIC);
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+    return status;
   }
 
   status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
+      pStmt,
       8,
-      url.c_str(),
+      item.cacheRequest.url.c_str(),
       -1,
       SQLITE_STATIC);
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+    return status;
   }
 
-  status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      9,
-      key.c_str(),
-      -1,
-      SQLITE_STATIC);
+  status = CESIUM_SQLITE(
+      sqlite3_bind_text)(pStmt, 9, key.c_str(), -1, SQLITE_STATIC);
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+    return status;
   }
 
-  status = CESIUM_SQLITE(sqlite3_step)(
-      this->_pImpl->_storeResponseStmtWrapper.get());
-  if (status != SQLITE_DONE) {
-    if (status == SQLITE_CORRUPT) {
-      destroyDatabase();
-    }
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+  if (dataFileName.empty()) {
+    status = CESIUM_SQLITE(sqlite3_bind_null)(pStmt, 10);
+  } else {
+    status = CESIUM_SQLITE(sqlite3_bind_text)(
+        pStmt,
+        10,
+        dataFileName.c_str(),
+        -1,
+        SQLITE_STATIC);
+  }
+  if (status != SQLITE_OK) {
+    return status;
   }
 
-  return true;
+  status =
+      CESIUM_SQLITE(sqlite3_bind_int)(pStmt, 11, entry.compressed ? 1 : 0);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  status = CESIUM_SQLITE(sqlite3_step)(pStmt);
+  if (status == SQLITE_DONE) {
+    if (!replacesItem) {
+      ++this->_itemCount;
+    }
+    this->_byteSize += static_cast<int64_t>(data.size()) - replacedByteSize;
+    if (!replacedDataFileName.empty()) {
+      this->_replacedDataFiles.emplace_back(std::move(replacedDataFileName));
+    }
+  }
+  return status;
 }
 
-bool SqliteCache::prune() {
-  CESIUM_TRACE("SqliteCache::prune");
-  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+int SqliteCache::Impl::writeAccessedItem(const AccessedItem& accessedItem) {
+  CESIUM_SQLITE(sqlite3_stmt*) pStmt =
+      this->_updateLastAccessedTimeStmtWrapper.get();
+
+  int status = CESIUM_SQLITE(sqlite3_reset)(pStmt);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  status = CESIUM_SQLITE(sqlite3_clear_bindings)(pStmt);
+  if (status != SQLITE_OK) {
+    return status;
+  }
 
-  int64_t totalItems = 0;
+  status =
+      CESIUM_SQLITE(sqlite3_bind_int64)(pStmt, 1, accessedItem.accessedTime);
+  if (status != SQLITE_OK) {
+    return status;
+  }
 
-  // query total size of response's data
+  status = CESIUM_SQLITE(sqlite3_bind_int64)(pStmt, 2, accessedItem.itemIndex);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  return CESIUM_SQLITE(sqlite3_step)(pStmt);
+}
+
+int SqliteCache::Impl::writePendingChanges() {
+  std::vector<AccessedItem> accessedItems;
   {
-    int totalItemsQueryStatus = CESIUM_SQLITE(sqlite3_reset)(
-        this->_pImpl->_totalItemsQueryStmtWrapper.get());
-    if (totalItemsQueryStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(totalItemsQueryStatus));
-      return false;
+    // The entries stay visible to getEntry until they are committed.
+    std::lock_guard<std::mutex> lock(this->_pendingEntriesMutex);
+    this->_writingEntries.swap(this->_pendingEntries);
+    this->_pendingByteSize = 0;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->_accessedItemsMutex);
+    accessedItems.swap(this->_accessedItems);
+  }
+
+  int status = SQLITE_DONE;
+  if (!this->_writingEntries.entries.empty() || !accessedItems.empty()) {
+    // Write all of them in one transaction instead of one transaction each.
+    status = executeStatement(
+        this->_pConnection,
+        BEGIN_TRANSACTION_SQL,
+        this->_pLogger);
+    if (status == SQLITE_OK) {
+      status = SQLITE_DONE;
+      const std::vector<PendingEntry>& entries =
+          this->_writingEntries.entries;
+      for (size_t i = 0; status == SQLITE_DONE && i < entries.size(); ++i) {
+        if (this->_writingEntries.isLatest(i)) {
+          status = this->writeEntry(entries[i].key, entries[i]);
+        }
+      }
+
+      for (size_t i = 0; status == SQLITE_DONE && i < accessedItems.size();
+           ++i) {
+        status = this->writeAccessedItem(accessedItems[i]);
+      }
+
+      if (status != SQLITE_DONE) {
+        SPDLOG_LOGGER_ERROR(
+            this->_pLogger,
+            CESIUM_SQLITE(sqlite3_errstr)(status));
+      }
+
+      // A corrupt database is deleted instead, which rolls back.
+      if (status != SQLITE_CORRUPT) {
+        const int commitStatus = executeStatement(
+            this->_pConnection,
+            COMMIT_TRANSACTION_SQL,
+            this->_pLogger);
+        if (status == SQLITE_DONE && commitStatus != SQLITE_OK) {
+          status = commitStatus;
+        }
+
+        // No committed entry uses the files of the entries that were
+        // replaced anymore. If the commit failed, they are removed as unused
+        // files later instead.
+        if (commitStatus == SQLITE_OK) {
+          for (const std::string& fileName : this->_replacedDataFiles) {
+            std::error_code error;
+            std::filesystem::remove(
+                this->_dataFileDirectory + "/" + fileName,
+                error);
+          }
+        }
+      }
     }
+  }
+  this->_replacedDataFiles.clear();
 
-    totalItemsQueryStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
-        this->_pImpl->_totalItemsQueryStmtWrapper.get());
-    if (totalItemsQueryStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(totalItemsQueryStatus));
-      return false;
+  // Whatever was rolled back is counted again.
+  if (status != SQLITE_DONE && status != SQLITE_CORRUPT) {
+    this->countItems();
+  }
+
+  std::lock_guard<std::mutex> lock(this->_pendingEntriesMutex);
+  this->_writingEntries.clear();
+  return status;
+}
+
+int SqliteCache::Impl::countItems() {
+  CESIUM_SQLITE(sqlite3_stmt*) pStmt = this->_totalsQueryStmtWrapper.get();
+  int status = CESIUM_SQLITE(sqlite3_reset)(pStmt);
+  if (status != SQLITE_OK) {
+    SPDLOG_LOGGER_ERROR(this->_pLogger, CESIUM_SQLITE(sqlite3_errstr)(status));
+    return status;
+  }
+
+  status = CESIUM_SQLITE(sqlite3_step)(pStmt);
+  if (status != SQLITE_ROW) {
+    SPDLOG_LOGGER_ERROR(this->_pLogger, CESIUM_SQLITE(sqlite3_errstr)(status));
+    return status;
+  }
+
+  this->_itemCount = CESIUM_SQLITE(sqlite3_column_int64)(pStmt, 0);
+  this->_byteSize = static_cast<int64_t>(
+      CESIUM_SQLITE(sqlite3_column_double)(pStmt, 1));
+  CESIUM_SQLITE(sqlite3_reset)(pStmt);
+  return SQLITE_DONE;
+}
+
+bool SqliteCache::Impl::isOverLimits() const noexcept {
+  return this->_itemCount > static_cast<int64_t>(this->_maxItems) ||
+         (this->_maxBytes > 0 &&
+          this->_byteSize > static_cast<int64_t>(this->_maxBytes));
+}
+
+int SqliteCache::Impl::deleteItems(
+    CESIUM_SQLITE(sqlite3_stmt*) pQueryStmt,
+    bool stopWhenWithinLimits,
+    size_t& deletedCount) {
+  deletedCount = 0;
+
+  // Find a batch of entries to delete.
+  std::vector<std::pair<int64_t, int64_t>> items;
+  int status = CESIUM_SQLITE(sqlite3_reset)(pQueryStmt);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  status = CESIUM_SQLITE(sqlite3_bind_int64)(
+      pQueryStmt,
+      1,
+      static_cast<int64_t>(PRUNE_BATCH_SIZE));
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  while ((status = CESIUM_SQLITE(sqlite3_step)(pQueryStmt)) == SQLITE_ROW) {
+    items.emplace_back(
+        CESIUM_SQLITE(sqlite3_column_int64)(pQueryStmt, 0),
+        CESIUM_SQLITE(sqlite3_column_int64)(pQueryStmt, 1));
+  }
+  CESIUM_SQLITE(sqlite3_reset)(pQueryStmt);
+  if (status != SQLITE_DONE) {
+    return status;
+  }
+
+  if (items.empty()) {
+    return SQLITE_DONE;
+  }
+
+  status = executeStatement(
+      this->_pConnection,
+      BEGIN_TRANSACTION_SQL,
+      this->_pLogger);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  CESIUM_SQLITE(sqlite3_stmt*) pDeleteStmt = this->_deleteItemStmtWrapper.get();
+  status = SQLITE_DONE;
+  for (const auto& [itemIndex, itemByteSize] : items) {
+    if (stopWhenWithinLimits && !this->isOverLimits()) {
+      break;
     }
 
-    totalItemsQueryStatus = CESIUM_SQLITE(sqlite3_step)(
-        this->_pImpl->_totalItemsQueryStmtWrapper.get());
+    status = CESIUM_SQLITE(sqlite3_reset)(pDeleteStmt);
+    if (status != SQLITE_OK) {
+      break;
+    }
 
-    if (totalItemsQueryStatus == SQLITE_DONE) {
-      return true;
+    status = CESIUM_SQLITE(sqlite3_bind_int64)(pDeleteStmt, 1, itemIndex);
+    if (status != SQLITE_OK) {
+      break;
     }
 
-    if (totalItemsQueryStatus != SQLITE_ROW) {
-      if (totalItemsQueryStatus == SQLITE_CORRUPT) {
-        destroyDatabase();
-      }
+    status = CESIUM_SQLITE(sqlite3_step)(pDeleteStmt);
+    if (status != SQLITE_DONE) {
+      break;
+    }
+
+    --this->_itemCount;
+    this->_byteSize -= itemByteSize;
+    ++deletedCount;
+  }
+
+  if (status == SQLITE_CORRUPT) {
+    return status;
+  }
+
+  const int commitStatus = executeStatement(
+      this->_pConnection,
+      COMMIT_TRANSACTION_SQL,
+      this->_pLogger);
+  if (status == SQLITE_DONE && commitStatus != SQLITE_OK) {
+    status = commitStatus;
+  }
+
+  // Whatever was not deleted is counted again.
+  if (status != SQLITE_DONE) {
+    this->countItems();
+  }
+
+  return status;
+}
+
+void SqliteCache::Impl::removeUnusedDataFiles() {
+  if (this->_dataFileDirectory.empty()) {
+    return;
+  }
+
+  // Every data file is written before the entries that use it are
+  // committed, and with _mutex locked, so the files that no committed entry
+  // uses are unused.
+  std::unordered_set<std::string> usedDataFiles;
+  CESIUM_SQLITE(sqlite3_stmt*) pStmt = this->_dataFilesQueryStmtWrapper.get();
+  int status = CESIUM_SQLITE(sqlite3_reset)(pStmt);
+  while (status == SQLITE_OK || status == SQLITE_ROW) {
+    status = CESIUM_SQLITE(sqlite3_step)(pStmt);
+    if (status == SQLITE_ROW) {
+      usedDataFiles.emplace(reinterpret_cast<const char*>(
+          CESIUM_SQLITE(sqlite3_column_text)(pStmt, 0)));
+    }
+  }
+  CESIUM_SQLITE(sqlite3_reset)(pStmt);
+
+  if (status != SQLITE_DONE) {
+    SPDLOG_LOGGER_ERROR(this->_pLogger, CESIUM_SQLITE(sqlite3_errstr)(status));
+    return;
+  }
+
+  std::error_code error;
+  std::filesystem::directory_iterator it(this->_dataFileDirectory, error);
+  const std::filesystem::directory_iterator end;
+  while (!error && it != end) {
+    const std::filesystem::path& path = it->path();
+    if (usedDataFiles.find(path.filename().string()) == usedDataFiles.end()) {
+      std::error_code removeError;
+      std::filesystem::remove(path, removeError);
+    }
+    it.increment(error);
+  }
+}
+
+SqliteCache::SqliteCache(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& databaseName,
+    uint64_t maxItems,
+    size_t maxReaderConnections,
+    size_t responseDataFileThreshold,
+    uint64_t maxBytes,
+    bool compressResponseData)
+    : _pImpl(std::make_unique<Impl>(
+          pLogger,
+          databaseName,
+          maxItems,
+          maxReaderConnections,
+          responseDataFileThreshold,
+          maxBytes,
+          compressResponseData)) {
+  createConnection();
+}
+
+void SqliteCache::createConnection() const {
+  CESIUM_SQLITE(sqlite3*) pConnection;
+  int status = CESIUM_SQLITE(
+      sqlite3_open)(this->_pImpl->_databaseName.c_str(), &pConnection);
+  if (status != SQLITE_OK) {
+    throw std::runtime_error(CESIUM_SQLITE(sqlite3_errstr)(status));
+  }
+
+  this->_pImpl->_pConnection =
+      std::unique_ptr<CESIUM_SQLITE(sqlite3), DeleteSqliteConnection>(
+          pConnection);
+
+  // create cache tables if not exist. Key -> Cache table: one-to-many
+  // relationship
+  char* createTableError = nullptr;
+  status = CESIUM_SQLITE(sqlite3_exec)(
+      this->_pImpl->_pConnection.get(),
+      CREATE_CACHE_TABLE_SQL.c_str(),
+      nullptr,
+      nullptr,
+      &createTableError);
+  if (status != SQLITE_OK) {
+    std::string errorStr(createTableError);
+    CESIUM_SQLITE(sqlite3_free)(createTableError);
+    throw std::runtime_error(errorStr);
+  }
+
+  // add the data file and compression columns to a database from an older
+  // version, if they are not there already
+  CESIUM_SQLITE(sqlite3_exec)(
+      this->_pImpl->_pConnection.get(),
+      ADD_DATA_FILE_COLUMN_SQL.c_str(),
+      nullptr,
+      nullptr,
+      nullptr);
+  CESIUM_SQLITE(sqlite3_exec)(
+      this->_pImpl->_pConnection.get(),
+      ADD_DATA_COMPRESSED_COLUMN_SQL.c_str(),
+      nullptr,
+      nullptr,
+      nullptr);
+
+  // index the last accessed time, which orders the items for pruning
+  char* createIndexError = nullptr;
+  status = CESIUM_SQLITE(sqlite3_exec)(
+      this->_pImpl->_pConnection.get(),
+      CREATE_LAST_ACCESSED_TIME_INDEX_SQL.c_str(),
+      nullptr,
+      nullptr,
+      &createIndexError);
+  if (status != SQLITE_OK) {
+    std::string errorStr(createIndexError);
+    CESIUM_SQLITE(sqlite3_free)(createIndexError);
+    throw std::runtime_error(errorStr);
+  }
+
+  // turn on WAL mode
+  char* walError = nullptr;
+  status = CESIUM_SQLITE(sqlite3_exec)(
+      this->_pImpl->_pConnection.get(),
+      PRAGMA_WAL_SQL.c_str(),
+      nullptr,
+      nullptr,
+      &walError);
+  if (status != SQLITE_OK) {
+    std::string errorStr(walError);
+    CESIUM_SQLITE(sqlite3_free)(walError);
+    throw std::runtime_error(errorStr);
+  }
+
+  // turn off synchronous mode
+  char* syncError = nullptr;
+  status = CESIUM_SQLITE(sqlite3_exec)(
+      this->_pImpl->_pConnection.get(),
+      PRAGMA_SYNC_SQL.c_str(),
+      nullptr,
+      nullptr,
+      &syncError);
+  if (status != SQLITE_OK) {
+    std::string errorStr(syncError);
+    CESIUM_SQLITE(sqlite3_free)(syncError);
+    throw std::runtime_error(errorStr);
+  }
+
+  // increase page size
+  char* pageSizeError = nullptr;
+  status = CESIUM_SQLITE(sqlite3_exec)(
+      this->_pImpl->_pConnection.get(),
+      PRAGMA_PAGE_SIZE_SQL.c_str(),
+      nullptr,
+      nullptr,
+      &pageSizeError);
+  if (status != SQLITE_OK) {
+    std::string errorStr(pageSizeError);
+    CESIUM_SQLITE(sqlite3_free)(pageSizeError);
+    throw std::runtime_error(errorStr);
+  }
+
+  // get entry based on key
+  this->_pImpl->_getEntryStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, GET_ENTRY_SQL);
+
+  // update last accessed for entry
+  this->_pImpl->_updateLastAccessedTimeStmtWrapper = prepareStatement(
+      this->_pImpl->_pConnection,
+      UPDATE_LAST_ACCESSED_TIME_SQL);
+
+  // store response
+  this->_pImpl->_storeResponseStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, STORE_RESPONSE_SQL);
+
+  // query the number and size of the items
+  this->_pImpl->_totalsQueryStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, TOTALS_QUERY_SQL);
+
+  // query the size of an item
+  this->_pImpl->_itemByteSizeQueryStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, ITEM_BYTE_SIZE_QUERY_SQL);
+
+  // query expired items
+  this->_pImpl->_expiredItemsQueryStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, EXPIRED_ITEMS_QUERY_SQL);
+
+  // query least recently used items
+  this->_pImpl->_lruItemsQueryStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, LRU_ITEMS_QUERY_SQL);
+
+  // delete an item
+  this->_pImpl->_deleteItemStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, DELETE_ITEM_SQL);
+
+  // clear all items
+  this->_pImpl->_clearAllStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, CLEAR_ALL_SQL);
+
+  // query the used data files
+  this->_pImpl->_dataFilesQueryStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, DATA_FILES_QUERY_SQL);
+
+  // read all entries
+  this->_pImpl->_allEntriesStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, ALL_ENTRIES_SQL);
+
+  // create the data file directory
+  if (!this->_pImpl->_dataFileDirectory.empty()) {
+    std::error_code error;
+    std::filesystem::create_directories(
+        this->_pImpl->_dataFileDirectory,
+        error);
+    if (error) {
       SPDLOG_LOGGER_ERROR(
           this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(totalItemsQueryStatus));
-      return false;
+          "Unable to create the directory for cached response data files, "
+          "storing all response data in the database instead.");
+      this->_pImpl->_dataFileDirectory.clear();
     }
+  }
 
-    // prune the rows if over maximum
-    totalItems = CESIUM_SQLITE(sqlite3_column_int64)(
-        this->_pImpl->_totalItemsQueryStmtWrapper.get(),
-        0);
-    if (totalItems > 0 &&
-        totalItems <= static_cast<int64_t>(this->_pImpl->_maxItems)) {
-      return true;
+  // count the items once, and keep the count up to date from then on
+  status = this->_pImpl->countItems();
+  if (status != SQLITE_DONE) {
+    throw std::runtime_error(CESIUM_SQLITE(sqlite3_errstr)(status));
+  }
+}
+
+SqliteCache::~SqliteCache() {
+  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+  this->_pImpl->writePendingChanges();
+}
+
+std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
+  CESIUM_TRACE("SqliteCache::getEntry");
+
+  static CesiumUtility::MetricCounter& hits =
+      CesiumUtility::MetricsRegistry::getDefault().counter(
+          "cesium_sqlite_cache_reads_total",
+          "The number of entries read from the SQLite cache.",
+          {{"result", "hit"}});
+  static CesiumUtility::MetricCounter& misses =
+      CesiumUtility::MetricsRegistry::getDefault().counter(
+          "cesium_sqlite_cache_reads_total",
+          "The number of entries read from the SQLite cache.",
+          {{"result", "miss"}});
+  static CesiumUtility::MetricHistogram& latency =
+      CesiumUtility::MetricsRegistry::getDefault().histogram(
+          "cesium_sqlite_cache_read_seconds",
+          "The time taken to read an entry from the SQLite cache.");
+
+  CesiumUtility::ScopedMetricTimer timer(latency);
+  std::optional<CacheItem> result;
+  CesiumUtility::ScopeGuard countResult(
+      [&result]() { (result ? hits : misses).increment(); });
+
+  bool compressed = false;
+  {
+    std::lock_guard<std::mutex> lock(this->_pImpl->_pendingEntriesMutex);
+    const Impl::PendingEntry* pEntry = this->_pImpl->findPendingEntry(key);
+    if (pEntry) {
+      result = pEntry->item;
+      compressed = pEntry->compressed;
+    }
+  }
+
+  if (result) {
+    if (compressed && !decompressResponseData(
+                          result->cacheResponse.data,
+                          this->_pImpl->_pLogger)) {
+      return std::nullopt;
     }
+    return result;
   }
 
-  // delete expired rows first
+  int64_t itemIndex = 0;
+  bool usedReaderConnection = false;
   {
-    int deleteExpiredStatus = CESIUM_SQLITE(sqlite3_reset)(
-        this->_pImpl->_deleteExpiredStmtWrapper.get());
-    if (deleteExpiredStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
+    Impl::ReaderLease lease(*this->_pImpl);
+    if (lease.pReader) {
+      result = readEntry(
+          lease.pReader->pGetEntryStmt.get(),
+          key,
+          this->_pImpl->_dataFileDirectory,
           this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteExpiredStatus));
-      return false;
+          itemIndex);
+      usedReaderConnection = true;
     }
+  }
 
-    deleteExpiredStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
-        this->_pImpl->_deleteExpiredStmtWrapper.get());
-    if (deleteExpiredStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteExpiredStatus));
-      return false;
+  if (usedReaderConnection) {
+    // The last accessed times are written in batches, so that cache hits
+    // rarely wait for the writer connection.
+    if (result && this->_pImpl->recordAccess(itemIndex) >=
+                      ACCESSED_ITEMS_BATCH_SIZE) {
+      std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+      this->_pImpl->writePendingChanges();
     }
+    return result;
+  }
 
-    deleteExpiredStatus = CESIUM_SQLITE(sqlite3_step)(
-        this->_pImpl->_deleteExpiredStmtWrapper.get());
-    if (deleteExpiredStatus != SQLITE_DONE) {
-      if (deleteExpiredStatus == SQLITE_CORRUPT) {
-        destroyDatabase();
-      }
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteExpiredStatus));
-      return false;
+  // Without reader connections, read with the writer connection.
+  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+  result = readEntry(
+      this->_pImpl->_getEntryStmtWrapper.get(),
+      key,
+      this->_pImpl->_dataFileDirectory,
+      this->_pImpl->_pLogger,
+      itemIndex);
+  if (result) {
+    this->_pImpl->recordAccess(itemIndex);
+    this->_pImpl->writePendingChanges();
+  }
+  return result;
+}
+
+bool SqliteCache::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  CESIUM_TRACE("SqliteCache::storeEntry");
+
+  static CesiumUtility::MetricHistogram& latency =
+      CesiumUtility::MetricsRegistry::getDefault().histogram(
+          "cesium_sqlite_cache_write_seconds",
+          "The time taken to store an entry in the SQLite cache, including "
+          "any write of the queued entries.");
+  CesiumUtility::ScopedMetricTimer timer(latency);
+
+  // Compress the response data, unless it is gzipped already, as it is when
+  // the server sent it that way. The compressed data is only kept when it is
+  // smaller.
+  std::vector<std::byte> data;
+  bool compressed = false;
+  if (this->_pImpl->_compressResponseData &&
+      !CesiumUtility::isGzip(responseData)) {
+    compressed = CesiumUtility::gzip(responseData, data) &&
+                 data.size() < responseData.size();
+  }
+  if (!compressed) {
+    data.assign(responseData.begin(), responseData.end());
+  }
+
+  // Queue the entry, and only write the queued entries once there are enough
+  // of them to be worth a transaction.
+  Impl::PendingEntry entry{
+      key,
+      CacheItem(
+          expiryTime,
+          CacheRequest(
+              HttpHeaders(requestHeaders),
+              std::string(requestMethod),
+              std::string(url)),
+          CacheResponse(
+              statusCode,
+              HttpHeaders(responseHeaders),
+              std::move(data))),
+      static_cast<int64_t>(std::time(nullptr)),
+      compressed};
+
+  bool shouldWrite = false;
+  {
+    std::lock_guard<std::mutex> lock(this->_pImpl->_pendingEntriesMutex);
+    Impl::PendingEntries& pending = this->_pImpl->_pendingEntries;
+
+    auto it = pending.latestEntryIndices.find(key);
+    if (it != pending.latestEntryIndices.end()) {
+      this->_pImpl->_pendingByteSize -=
+          pending.entries[it->second].item.cacheResponse.data.size();
+      it->second = pending.entries.size();
+    } else {
+      pending.latestEntryIndices.emplace(key, pending.entries.size());
     }
+    this->_pImpl->_pendingByteSize += entry.item.cacheResponse.data.size();
+    pending.entries.emplace_back(std::move(entry));
+
+    shouldWrite =
+        pending.entries.size() >= PENDING_ENTRIES_BATCH_SIZE ||
+        this->_pImpl->_pendingByteSize >= PENDING_ENTRIES_BATCH_BYTES;
   }
 
-  // check if we should delete more
-  const int deletedRows =
-      CESIUM_SQLITE(sqlite3_changes)(this->_pImpl->_pConnection.get());
-  if (totalItems - deletedRows < static_cast<int>(this->_pImpl->_maxItems)) {
+  if (!shouldWrite) {
     return true;
   }
 
-  totalItems -= deletedRows;
+  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+  const int status = this->_pImpl->writePendingChanges();
+  if (status == SQLITE_CORRUPT) {
+    destroyDatabase();
+  }
+  return status == SQLITE_DONE;
+}
+
+bool SqliteCache::prune() {
+  CESIUM_TRACE("SqliteCache::prune");
 
-  // delete rows LRU if we are still over maximum
   {
-    int deleteLLRUStatus =
-        CESIUM_SQLITE(sqlite3_reset)(this->_pImpl->_deleteLRUStmtWrapper.get());
-    if (deleteLLRUStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
+    std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+
+    // Write the pending changes first, so that they are pruned, too.
+    if (this->_pImpl->writePendingChanges() == SQLITE_CORRUPT) {
+      destroyDatabase();
       return false;
     }
 
-    deleteLLRUStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
-        this->_pImpl->_deleteLRUStmtWrapper.get());
-    if (deleteLLRUStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
-      return false;
+    if (!this->_pImpl->isOverLimits()) {
+      return true;
     }
+  }
 
-    deleteLLRUStatus = CESIUM_SQLITE(sqlite3_bind_int64)(
-        this->_pImpl->_deleteLRUStmtWrapper.get(),
-        1,
-        totalItems - static_cast<int64_t>(this->_pImpl->_maxItems));
-    if (deleteLLRUStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
+  // Delete the entries in batches, each in its own transaction, and let the
+  // other calls use the database between them. Expired entries are deleted
+  // first, then the least recently used ones until the cache is within its
+  // limits.
+  bool deletingExpiredItems = true;
+  while (true) {
+    std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+    if (!this->_pImpl->_pConnection) {
       return false;
     }
 
-    deleteLLRUStatus =
-        CESIUM_SQLITE(sqlite3_step)(this->_pImpl->_deleteLRUStmtWrapper.get());
-    if (deleteLLRUStatus != SQLITE_DONE) {
-      if (deleteLLRUStatus == SQLITE_CORRUPT) {
+    if (!deletingExpiredItems && !this->_pImpl->isOverLimits()) {
+      break;
+    }
+
+    size_t deletedCount = 0;
+    const int status = this->_pImpl->deleteItems(
+        deletingExpiredItems
+            ? this->_pImpl->_expiredItemsQueryStmtWrapper.get()
+            : this->_pImpl->_lruItemsQueryStmtWrapper.get(),
+        !deletingExpiredItems,
+        deletedCount);
+    if (status != SQLITE_DONE) {
+      if (status == SQLITE_CORRUPT) {
         destroyDatabase();
       }
       SPDLOG_LOGGER_ERROR(
           this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
+          CESIUM_SQLITE(sqlite3_errstr)(status));
       return false;
     }
+
+    if (deletedCount < PRUNE_BATCH_SIZE) {
+      if (!deletingExpiredItems) {
+        break;
+      }
+      deletingExpiredItems = false;
+    }
   }
 
+  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+  this->_pImpl->removeUnusedDataFiles();
   return true;
 }
 
 bool SqliteCache::clearAll() {
   std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
 
+  {
+    std::lock_guard<std::mutex> lock(this->_pImpl->_pendingEntriesMutex);
+    this->_pImpl->_pendingEntries.clear();
+    this->_pImpl->_pendingByteSize = 0;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->_pImpl->_accessedItemsMutex);
+    this->_pImpl->_accessedItems.clear();
+  }
+
   int status =
       CESIUM_SQLITE(sqlite3_reset)(this->_pImpl->_clearAllStmtWrapper.get());
   if (status != SQLITE_OK) {
@@ -779,21 +1688,87 @@ bool SqliteCache::clearAll() {
     return false;
   }
 
+  this->_pImpl->_itemCount = 0;
+  this->_pImpl->_byteSize = 0;
+  this->_pImpl->removeUnusedDataFiles();
+  return true;
+}
+
+bool SqliteCache::forEachEntry(
+    const std::function<void(const std::string& key, CacheItem&& item)>&
+        callback) const {
+  CESIUM_TRACE("SqliteCache::forEachEntry");
+  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+
+  // Write the pending changes first, so that they are read, too.
+  int status = this->_pImpl->writePendingChanges();
+  if (status != SQLITE_DONE) {
+    return false;
+  }
+
+  CESIUM_SQLITE(sqlite3_stmt*) pStmt =
+      this->_pImpl->_allEntriesStmtWrapper.get();
+  status = CESIUM_SQLITE(sqlite3_reset)(pStmt);
+  if (status != SQLITE_OK) {
+    SPDLOG_LOGGER_ERROR(
+        this->_pImpl->_pLogger,
+        CESIUM_SQLITE(sqlite3_errstr)(status));
+    return false;
+  }
+
+  ResetStatementOnExit resetOnExit{pStmt};
+  while ((status = CESIUM_SQLITE(sqlite3_step)(pStmt)) == SQLITE_ROW) {
+    std::optional<CacheItem> item = readItem(
+        pStmt,
+        this->_pImpl->_dataFileDirectory,
+        this->_pImpl->_pLogger);
+    if (item) {
+      const std::string key = reinterpret_cast<const char*>(
+          CESIUM_SQLITE(sqlite3_column_text)(pStmt, 10));
+      callback(key, std::move(*item));
+    }
+  }
+
+  if (status != SQLITE_DONE) {
+    SPDLOG_LOGGER_ERROR(
+        this->_pImpl->_pLogger,
+        CESIUM_SQLITE(sqlite3_errstr)(status));
+    return false;
+  }
+
   return true;
 }
 
 void SqliteCache::destroyDatabase() {
-  std::shared_ptr<spdlog::logger> pLogger = _pImpl->_pLogger;
-  std::string databaseName = _pImpl->_databaseName;
-  uint64_t maxItems = _pImpl->_maxItems;
-  _pImpl.reset();
-  _pImpl = std::make_unique<Impl>(pLogger, databaseName, maxItems);
+  // Wait for the reads in progress, and close all the connections, so that
+  // the file can be deleted.
+  this->_pImpl->closeReaderConnections();
+  {
+    std::lock_guard<std::mutex> lock(this->_pImpl->_accessedItemsMutex);
+    this->_pImpl->_accessedItems.clear();
+  }
+
+  this->_pImpl->_getEntryStmtWrapper.reset();
+  this->_pImpl->_updateLastAccessedTimeStmtWrapper.reset();
+  this->_pImpl->_storeResponseStmtWrapper.reset();
+  this->_pImpl->_totalsQueryStmtWrapper.reset();
+  this->_pImpl->_itemByteSizeQueryStmtWrapper.reset();
+  this->_pImpl->_expiredItemsQueryStmtWrapper.reset();
+  this->_pImpl->_lruItemsQueryStmtWrapper.reset();
+  this->_pImpl->_deleteItemStmtWrapper.reset();
+  this->_pImpl->_clearAllStmtWrapper.reset();
+  this->_pImpl->_dataFilesQueryStmtWrapper.reset();
+  this->_pImpl->_allEntriesStmtWrapper.reset();
+  this->_pImpl->_pConnection.reset();
+
   if (remove(_pImpl->_databaseName.c_str()) != 0) {
     SPDLOG_LOGGER_ERROR(
         this->_pImpl->_pLogger,
         "Unable to delete database file.");
   }
   createConnection();
+
+  this->_pImpl->reopenReaderConnections();
 }
 
 } // namespace CesiumAsync
@@ -1,27 +1,163 @@
 #include "CesiumAsync/Impl/TaskScheduler.h"
 
+#include <CesiumUtility/Metrics.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
 using namespace CesiumAsync::CesiumImpl;
 
 TaskScheduler::TaskScheduler(
     const std::shared_ptr<CesiumAsync::ITaskProcessor>& pTaskProcessor)
     : _pTaskProcessor(pTaskProcessor) {}
 
+namespace {
+CesiumUtility::MetricGauge& getQueuedTasksGauge() {
+  static CesiumUtility::MetricGauge& gauge =
+      CesiumUtility::MetricsRegistry::getDefault().gauge(
+          "cesium_worker_tasks_queued",
+          "The number of worker thread tasks waiting to start.");
+  return gauge;
+}
+
+// A task passed to the task processor. std::function must be copyable, so it
+// can't capture the move-only task_run_handle directly, and its copies share
+// this instead, counting their references to it. Only the first copy that is
+// called runs the task. If the processor destroys every copy without calling
+// one, the task_run_handle cancels the task, which rejects its future.
+struct ScheduledTask {
+  TaskScheduler* pScheduler = nullptr;
+  async::task_run_handle task;
+  std::atomic<uint32_t> references{0};
+  std::atomic<bool> started{false};
+  ScheduledTask* pNextFree = nullptr;
+};
+
+// Keeps the scheduled tasks whose functions have all been destroyed, so that
+// scheduling a task does not allocate one.
+class ScheduledTaskPool {
+public:
+  ScheduledTask*
+  acquire(TaskScheduler* pScheduler, async::task_run_handle&& t) {
+    ScheduledTask* pTask = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      pTask = this->_pFirstFree;
+      if (pTask) {
+        this->_pFirstFree = pTask->pNextFree;
+        --this->_freeCount;
+      }
+    }
+
+    if (!pTask) {
+      pTask = new ScheduledTask();
+    }
+
+    pTask->pScheduler = pScheduler;
+    pTask->task = std::move(t);
+    pTask->references.store(1, std::memory_order_relaxed);
+    pTask->started.store(false, std::memory_order_relaxed);
+    pTask->pNextFree = nullptr;
+    return pTask;
+  }
+
+  void release(ScheduledTask* pTask) noexcept {
+    if (!pTask->started.load(std::memory_order_relaxed)) {
+      getQueuedTasksGauge().add(-1);
+    }
+
+    {
+      // Cancels the task if it never ran.
+      async::task_run_handle dropped = std::move(pTask->task);
+    }
+    pTask->pScheduler = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      if (this->_freeCount < MaximumFreeCount) {
+        pTask->pNextFree = this->_pFirstFree;
+        this->_pFirstFree = pTask;
+        ++this->_freeCount;
+        return;
+      }
+    }
+
+    delete pTask;
+  }
+
+private:
+  static constexpr size_t MaximumFreeCount = 1024;
+
+  std::mutex _mutex;
+  ScheduledTask* _pFirstFree = nullptr;
+  size_t _freeCount = 0;
+};
+
+ScheduledTaskPool& getScheduledTaskPool() {
+  // Never destroyed, because worker threads may still release tasks while
+  // static objects are destroyed.
+  static ScheduledTaskPool& pool = *new ScheduledTaskPool();
+  return pool;
+}
+
+// The function passed to the task processor. Its only member is a pointer, so
+// standard libraries that store small functions inside the std::function do
+// so with this one. libstdc++ only stores trivially copyable functions inline,
+// which this can't be, because its copies count their references.
+class RunTask {
+public:
+  // Takes over the reference of a task that was just acquired.
+  explicit RunTask(ScheduledTask* pTask) noexcept : _pTask(pTask) {}
+
+  RunTask(const RunTask& rhs) noexcept : _pTask(rhs._pTask) {
+    this->_pTask->references.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  RunTask(RunTask&& rhs) noexcept : _pTask(rhs._pTask) {
+    rhs._pTask = nullptr;
+  }
+
+  RunTask& operator=(const RunTask&) = delete;
+  RunTask& operator=(RunTask&&) = delete;
+
+  ~RunTask() noexcept {
+    if (this->_pTask &&
+        this->_pTask->references.fetch_sub(1, std::memory_order_acq_rel) ==
+            1) {
+      getScheduledTaskPool().release(this->_pTask);
+    }
+  }
+
+  void operator()() const {
+    if (this->_pTask->started.exchange(true)) {
+      return;
+    }
+
+    getQueuedTasksGauge().add(-1);
+    auto scope = this->_pTask->pScheduler->immediate.scope();
+    this->_pTask->task.run();
+  }
+
+private:
+  ScheduledTask* _pTask;
+};
+} // namespace
+
 void TaskScheduler::schedule(async::task_run_handle t) {
-  // std::function must be copyable, so we can't put a move-only
-  // task_run_handle in the capture list of a lambda we want to use with it.
-  // So, we wrap it with a copyable type (shared_ptr).
-  // https://riptutorial.com/cplusplus/example/1950/generalized-capture has
-  // a good explanation of this problem.
-
-  struct Receiver {
-    async::task_run_handle taskHandle;
-  };
-
-  std::shared_ptr<Receiver> pReceiver = std::make_shared<Receiver>();
-  pReceiver->taskHandle = std::move(t);
-
-  this->_pTaskProcessor->startTask([this, pReceiver]() mutable {
-    auto scope = this->immediate.scope();
-    pReceiver->taskHandle.run();
-  });
+  getQueuedTasksGauge().add(1);
+  this->_pTaskProcessor->startTask(
+      RunTask(getScheduledTaskPool().acquire(this, std::move(t))));
+}
+
+void TaskScheduler::schedule(
+    async::task_run_handle t,
+    const CesiumAsync::TaskPriority& priority) {
+  getQueuedTasksGauge().add(1);
+  this->_pTaskProcessor->startTaskWithPriority(
+      RunTask(getScheduledTaskPool().acquire(this, std::move(t))),
+      priority);
 }
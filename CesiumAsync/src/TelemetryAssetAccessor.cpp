@@ -0,0 +1,234 @@
+#include "CesiumAsync/TelemetryAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "UrlHost.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <utility>
+
+namespace CesiumAsync {
+
+void LatencyHistogram::add(double milliseconds) noexcept {
+  const auto it = std::lower_bound(
+      bucketUpperBounds.begin(),
+      bucketUpperBounds.end(),
+      milliseconds);
+  ++this->counts[size_t(it - bucketUpperBounds.begin())];
+  ++this->sampleCount;
+  this->totalMilliseconds += milliseconds;
+  this->maximumMilliseconds = std::max(this->maximumMilliseconds, milliseconds);
+}
+
+double LatencyHistogram::getMeanMilliseconds() const noexcept {
+  if (this->sampleCount == 0) {
+    return 0.0;
+  }
+  return this->totalMilliseconds / double(this->sampleCount);
+}
+
+double
+LatencyHistogram::getPercentileMilliseconds(double percentile) const noexcept {
+  if (this->sampleCount == 0) {
+    return 0.0;
+  }
+
+  const double rank = std::ceil(
+      std::clamp(percentile, 0.0, 100.0) / 100.0 * double(this->sampleCount));
+  int64_t count = 0;
+  for (size_t i = 0; i < bucketUpperBounds.size(); ++i) {
+    count += this->counts[i];
+    if (count > 0 && double(count) >= rank) {
+      return std::min(bucketUpperBounds[i], this->maximumMilliseconds);
+    }
+  }
+  return this->maximumMilliseconds;
+}
+
+namespace {
+
+bool equalsIgnoreCase(const std::string& lhs, const std::string& rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(
+             lhs.begin(),
+             lhs.end(),
+             rhs.begin(),
+             [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) ==
+                      std::tolower(static_cast<unsigned char>(b));
+             });
+}
+
+bool isRevalidation(const std::vector<IAssetAccessor::THeader>& headers) {
+  return std::any_of(
+      headers.begin(),
+      headers.end(),
+      [](const IAssetAccessor::THeader& header) {
+        return equalsIgnoreCase(header.first, "If-None-Match") ||
+               equalsIgnoreCase(header.first, "If-Modified-Since");
+      });
+}
+
+} // namespace
+
+struct TelemetryAssetAccessor::Records {
+  struct Request {
+    Request(const std::string& url)
+        : host(getUrlHost(url)),
+          startTime(std::chrono::steady_clock::now()),
+          firstByteReceived(false) {}
+
+    double getElapsedMilliseconds() const {
+      return std::chrono::duration<double, std::milli>(
+                 std::chrono::steady_clock::now() - this->startTime)
+          .count();
+    }
+
+    std::string host;
+    std::chrono::steady_clock::time_point startTime;
+    std::atomic<bool> firstByteReceived;
+  };
+
+  template <typename Func> void update(const std::string& host, Func&& f) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    f(this->hosts[host]);
+  }
+
+  std::shared_ptr<Request>
+  start(const std::string& url, const std::vector<THeader>& headers) {
+    std::shared_ptr<Request> pRequest = std::make_shared<Request>(url);
+    const bool revalidation = isRevalidation(headers);
+    this->update(pRequest->host, [revalidation](HostTelemetry& telemetry) {
+      ++telemetry.requestCount;
+      if (revalidation) {
+        ++telemetry.revalidationCount;
+      }
+    });
+    return pRequest;
+  }
+
+  static Future<std::shared_ptr<IAssetRequest>> finish(
+      const std::shared_ptr<Records>& pRecords,
+      const std::shared_ptr<Request>& pRequest,
+      Future<std::shared_ptr<IAssetRequest>>&& future) {
+    return std::move(future)
+        .thenImmediately(
+            [pRecords, pRequest](
+                std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
+              const double milliseconds = pRequest->getElapsedMilliseconds();
+              const IAssetResponse* pResponse =
+                  pCompletedRequest ? pCompletedRequest->response() : nullptr;
+              pRecords->update(
+                  pRequest->host,
+                  [milliseconds, pResponse](HostTelemetry& telemetry) {
+                    if (!pResponse) {
+                      ++telemetry.failedRequestCount;
+                      return;
+                    }
+
+                    telemetry.latency.add(milliseconds);
+                    telemetry.receivedBytes += pResponse->data().size();
+                    if (pResponse->statusCode() >= 400) {
+                      ++telemetry.errorResponseCount;
+                    } else if (pResponse->statusCode() == 304) {
+                      ++telemetry.notModifiedCount;
+                    }
+                  });
+              return std::move(pCompletedRequest);
+            })
+        .catchImmediately(
+            [pRecords, pRequest](
+                std::exception&&) -> std::shared_ptr<IAssetRequest> {
+              pRecords->update(pRequest->host, [](HostTelemetry& telemetry) {
+                ++telemetry.failedRequestCount;
+              });
+              throw;
+            });
+  }
+
+  std::mutex mutex;
+  std::map<std::string, HostTelemetry> hosts;
+};
+
+TelemetryAssetAccessor::TelemetryAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor)
+    : _pAssetAccessor(pAssetAccessor),
+      _pRecords(std::make_shared<Records>()) {}
+
+TelemetryAssetAccessor::~TelemetryAssetAccessor() noexcept {}
+
+Future<std::shared_ptr<IAssetRequest>> TelemetryAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->getStreaming(asyncSystem, url, headers, {});
+}
+
+Future<std::shared_ptr<IAssetRequest>> TelemetryAssetAccessor::getStreaming(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const DataReceivedCallback& onDataReceived) {
+  std::shared_ptr<Records::Request> pRequest =
+      this->_pRecords->start(url, headers);
+
+  // The data is streamed from the underlying accessor, if it can, to find the
+  // time to the first byte.
+  DataReceivedCallback recordFirstByte =
+      [pRecords = this->_pRecords, pRequest, onDataReceived](
+          const gsl::span<const std::byte>& data) {
+        if (!pRequest->firstByteReceived.exchange(true)) {
+          const double milliseconds = pRequest->getElapsedMilliseconds();
+          pRecords->update(
+              pRequest->host,
+              [milliseconds](HostTelemetry& telemetry) {
+                telemetry.timeToFirstByte.add(milliseconds);
+              });
+        }
+
+        if (onDataReceived) {
+          onDataReceived(data);
+        }
+      };
+
+  return Records::finish(
+      this->_pRecords,
+      pRequest,
+      this->_pAssetAccessor
+          ->getStreaming(asyncSystem, url, headers, recordFirstByte));
+}
+
+Future<std::shared_ptr<IAssetRequest>> TelemetryAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  std::shared_ptr<Records::Request> pRequest =
+      this->_pRecords->start(url, headers);
+  return Records::finish(
+      this->_pRecords,
+      pRequest,
+      this->_pAssetAccessor
+          ->request(asyncSystem, verb, url, headers, contentPayload));
+}
+
+void TelemetryAssetAccessor::tick() noexcept { this->_pAssetAccessor->tick(); }
+
+std::map<std::string, HostTelemetry>
+TelemetryAssetAccessor::getSnapshot() const {
+  std::lock_guard<std::mutex> lock(this->_pRecords->mutex);
+  return this->_pRecords->hosts;
+}
+
+void TelemetryAssetAccessor::reset() {
+  std::lock_guard<std::mutex> lock(this->_pRecords->mutex);
+  this->_pRecords->hosts.clear();
+}
+
+} // namespace CesiumAsync
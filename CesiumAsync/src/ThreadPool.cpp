@@ -1,5 +1,7 @@
 #include "CesiumAsync/ThreadPool.h"
 
+#include "ConfigureThread.h"
+
 using namespace CesiumAsync;
 
 // Each thread may be enrolled in a single scheduler scope.
@@ -7,11 +9,16 @@ using namespace CesiumAsync;
 /*static*/ thread_local CesiumImpl::ImmediateScheduler<
     ThreadPool::Scheduler>::SchedulerScope ThreadPool::_scope;
 
-ThreadPool::ThreadPool(int32_t numberOfThreads)
-    : _pScheduler(std::make_shared<Scheduler>(numberOfThreads)) {}
+ThreadPool::ThreadPool(
+    int32_t numberOfThreads,
+    const ThreadPoolOptions& options)
+    : _pScheduler(std::make_shared<Scheduler>(numberOfThreads, options)) {}
 
-ThreadPool::Scheduler::Scheduler(int32_t numberOfThreads)
-    : scheduler(
+ThreadPool::Scheduler::Scheduler(
+    int32_t numberOfThreads,
+    const ThreadPoolOptions& options_)
+    : options(options_),
+      scheduler(
           size_t(numberOfThreads <= 0 ? 1 : numberOfThreads),
           createPreRun(this),
           createPostRun()) {}
@@ -19,3 +26,7 @@ ThreadPool::Scheduler::Scheduler(int32_t numberOfThreads)
 void ThreadPool::Scheduler::schedule(async::task_run_handle t) {
   this->scheduler.schedule(std::move(t));
 }
+
+void ThreadPool::Scheduler::configureThread() noexcept {
+  configureCurrentThread(this->options, this->nextThreadIndex++);
+}
@@ -0,0 +1,25 @@
+#include "UrlHost.h"
+
+namespace CesiumAsync {
+
+std::string getUrlHost(const std::string& url) {
+  const size_t schemeEnd = url.find("://");
+  if (schemeEnd == std::string::npos) {
+    return std::string();
+  }
+
+  const size_t authorityStart = schemeEnd + 3;
+  const size_t authorityEnd = url.find_first_of("/?#", authorityStart);
+  std::string authority = url.substr(
+      authorityStart,
+      authorityEnd == std::string::npos ? std::string::npos
+                                        : authorityEnd - authorityStart);
+
+  const size_t userInfoEnd = authority.rfind('@');
+  if (userInfoEnd != std::string::npos) {
+    authority.erase(0, userInfoEnd + 1);
+  }
+  return authority;
+}
+
+} // namespace CesiumAsync
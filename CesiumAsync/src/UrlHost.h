@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+
+namespace CesiumAsync {
+// Gets the host name and port of a URL, without any user name or password, or
+// an empty string if the URL has no host, like a `file` URL.
+std::string getUrlHost(const std::string& url);
+} // namespace CesiumAsync
@@ -0,0 +1,184 @@
+#include "CesiumAsync/WorkStealingTaskProcessor.h"
+
+#include "ConfigureThread.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace CesiumAsync {
+namespace {
+// The processor whose thread this is, if any, and the index of the thread's
+// own queue.
+thread_local const WorkStealingTaskProcessor* pCurrentProcessor = nullptr;
+thread_local size_t currentQueueIndex = 0;
+
+template <typename TTask>
+bool runsLater(const TTask& lhs, const TTask& rhs) noexcept {
+  if (rhs.priority < lhs.priority) {
+    return true;
+  }
+  if (lhs.priority < rhs.priority) {
+    return false;
+  }
+  return lhs.sequenceNumber > rhs.sequenceNumber;
+}
+} // namespace
+
+WorkStealingTaskProcessor::WorkStealingTaskProcessor(
+    size_t threadCount,
+    const ThreadPoolOptions& options)
+    : _queues(),
+      _nextQueue(0),
+      _prioritizedMutex(),
+      _prioritizedTasks(),
+      _prioritizedCount(0),
+      _nextSequenceNumber(0),
+      _queuedCount(0),
+      _sleepingCount(0),
+      _sleepMutex(),
+      _tasksAvailable(),
+      _stopping(false),
+      _threads() {
+  threadCount = std::max(threadCount, size_t(1));
+
+  this->_queues.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; ++i) {
+    this->_queues.emplace_back(std::make_unique<TaskQueue>());
+  }
+
+  this->_threads.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; ++i) {
+    this->_threads.emplace_back([this, i, options]() {
+      configureCurrentThread(options, i);
+      this->runTasks(i);
+    });
+  }
+}
+
+WorkStealingTaskProcessor::~WorkStealingTaskProcessor() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(this->_sleepMutex);
+    this->_stopping = true;
+  }
+
+  this->_tasksAvailable.notify_all();
+
+  for (std::thread& thread : this->_threads) {
+    thread.join();
+  }
+}
+
+void WorkStealingTaskProcessor::startTask(std::function<void()> f) {
+  const size_t queueIndex =
+      pCurrentProcessor == this
+          ? currentQueueIndex
+          : this->_nextQueue.fetch_add(1) % this->_queues.size();
+
+  TaskQueue& queue = *this->_queues[queueIndex];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.emplace_back(std::move(f));
+  }
+
+  this->notifyTaskQueued();
+}
+
+void WorkStealingTaskProcessor::startTaskWithPriority(
+    std::function<void()> f,
+    const TaskPriority& priority) {
+  {
+    std::lock_guard<std::mutex> lock(this->_prioritizedMutex);
+    this->_prioritizedTasks.push_back(
+        PrioritizedTask{priority, this->_nextSequenceNumber++, std::move(f)});
+    std::push_heap(
+        this->_prioritizedTasks.begin(),
+        this->_prioritizedTasks.end(),
+        runsLater<PrioritizedTask>);
+    ++this->_prioritizedCount;
+  }
+
+  this->notifyTaskQueued();
+}
+
+void WorkStealingTaskProcessor::notifyTaskQueued() {
+  // A thread that is about to sleep counts itself as sleeping before it
+  // checks for queued tasks, so it either sees this task or is woken here.
+  ++this->_queuedCount;
+  if (this->_sleepingCount > 0) {
+    std::lock_guard<std::mutex> lock(this->_sleepMutex);
+    this->_tasksAvailable.notify_one();
+  }
+}
+
+bool WorkStealingTaskProcessor::takeTask(
+    size_t queueIndex,
+    std::function<void()>& task) {
+  // The most important prioritized task.
+  if (this->_prioritizedCount > 0) {
+    std::lock_guard<std::mutex> lock(this->_prioritizedMutex);
+    if (!this->_prioritizedTasks.empty()) {
+      std::pop_heap(
+          this->_prioritizedTasks.begin(),
+          this->_prioritizedTasks.end(),
+          runsLater<PrioritizedTask>);
+      task = std::move(this->_prioritizedTasks.back().f);
+      this->_prioritizedTasks.pop_back();
+      --this->_prioritizedCount;
+      --this->_queuedCount;
+      return true;
+    }
+  }
+
+  // Otherwise the newest task of the thread's own queue.
+  {
+    TaskQueue& queue = *this->_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      --this->_queuedCount;
+      return true;
+    }
+  }
+
+  // Otherwise the oldest task of another queue.
+  const size_t queueCount = this->_queues.size();
+  for (size_t i = 1; i < queueCount; ++i) {
+    TaskQueue& queue = *this->_queues[(queueIndex + i) % queueCount];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      --this->_queuedCount;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void WorkStealingTaskProcessor::runTasks(size_t queueIndex) {
+  pCurrentProcessor = this;
+  currentQueueIndex = queueIndex;
+
+  while (true) {
+    std::function<void()> task;
+    if (this->takeTask(queueIndex, task)) {
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(this->_sleepMutex);
+    ++this->_sleepingCount;
+    this->_tasksAvailable.wait(lock, [this]() {
+      return this->_stopping || this->_queuedCount > 0;
+    });
+    --this->_sleepingCount;
+
+    if (this->_stopping && this->_queuedCount == 0) {
+      return;
+    }
+  }
+}
+
+} // namespace CesiumAsync
@@ -0,0 +1,71 @@
+#include "CesiumAsync/forEachInParallel.h"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace CesiumAsync {
+
+namespace {
+// This is shared with the worker threads, because those may only get to it
+// after all of the work is done and the caller has returned. They then find
+// no index left to claim and never call the function.
+struct ParallelWork {
+  const std::function<void(size_t)>* pFunction;
+  size_t count;
+  std::atomic<size_t> nextIndex{0};
+  std::atomic<size_t> completedCount{0};
+  std::mutex exceptionMutex;
+  std::exception_ptr pException;
+};
+
+void runClaimedWork(ParallelWork& work) {
+  size_t index;
+  while ((index = work.nextIndex++) < work.count) {
+    try {
+      (*work.pFunction)(index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(work.exceptionMutex);
+      if (!work.pException) {
+        work.pException = std::current_exception();
+      }
+    }
+    ++work.completedCount;
+  }
+}
+} // namespace
+
+void forEachInParallel(
+    const std::optional<AsyncSystem>& asyncSystem,
+    size_t count,
+    const std::function<void(size_t)>& function) {
+  if (!asyncSystem || count < 2) {
+    for (size_t i = 0; i < count; ++i) {
+      function(i);
+    }
+    return;
+  }
+
+  auto pWork = std::make_shared<ParallelWork>();
+  pWork->pFunction = &function;
+  pWork->count = count;
+
+  for (size_t i = 1; i < count; ++i) {
+    asyncSystem->runInWorkerThread([pWork]() { runClaimedWork(*pWork); });
+  }
+
+  runClaimedWork(*pWork);
+
+  // Wait for the indices claimed by worker threads to finish.
+  while (pWork->completedCount < count) {
+    std::this_thread::yield();
+  }
+
+  if (pWork->pException) {
+    std::rethrow_exception(pWork->pException);
+  }
+}
+
+} // namespace CesiumAsync
@@ -0,0 +1,73 @@
+#include "CesiumAsync/AdaptiveConcurrencyLimiter.h"
+
+#include <catch2/catch.hpp>
+
+using namespace CesiumAsync;
+
+TEST_CASE("AdaptiveConcurrencyLimiter") {
+  AdaptiveConcurrencyLimiterOptions options;
+  options.initialLimit = 10;
+  options.minimumLimit = 2;
+  options.maximumLimit = 12;
+  options.decreaseFactor = 0.5;
+  options.latencyInflationThreshold = 2.0;
+  options.latencySmoothing = 1.0;
+
+  AdaptiveConcurrencyLimiter limiter(options);
+  CHECK(limiter.getLimit() == 10);
+
+  SECTION("raises the limit by one per limit's worth of requests") {
+    for (int i = 0; i < 10; ++i) {
+      limiter.recordCompletion(0.1, 1000, true);
+    }
+    CHECK(limiter.getLimit() == 10);
+    limiter.recordCompletion(0.1, 1000, true);
+    CHECK(limiter.getLimit() == 11);
+
+    for (int i = 0; i < 100; ++i) {
+      limiter.recordCompletion(0.1, 1000, true);
+    }
+    CHECK(limiter.getLimit() == 12);
+    CHECK(limiter.getBaselineLatency() == Approx(0.1));
+    CHECK(limiter.getSmoothedLatency() == Approx(0.1));
+  }
+
+  SECTION("halves the limit once per limit's worth of failures") {
+    limiter.recordCompletion(0.1, 0, false);
+    CHECK(limiter.getLimit() == 5);
+
+    // The requests that were already in flight fail too.
+    for (int i = 0; i < 4; ++i) {
+      limiter.recordCompletion(0.1, 0, false);
+    }
+    CHECK(limiter.getLimit() == 5);
+
+    limiter.recordCompletion(0.1, 0, false);
+    CHECK(limiter.getLimit() == 2);
+
+    for (int i = 0; i < 10; ++i) {
+      limiter.recordCompletion(0.1, 0, false);
+    }
+    CHECK(limiter.getLimit() == 2);
+  }
+
+  SECTION("decreases the limit when latency is inflated") {
+    limiter.recordCompletion(0.1, 1000, true);
+    limiter.recordCompletion(0.15, 1000, true);
+    CHECK(limiter.getLimit() == 10);
+
+    limiter.recordCompletion(0.5, 1000, true);
+    CHECK(limiter.getLimit() == 5);
+    CHECK(limiter.getBaselineLatency() < 0.2);
+  }
+
+  SECTION("sanitizes the options") {
+    AdaptiveConcurrencyLimiterOptions invalid;
+    invalid.initialLimit = 100;
+    invalid.minimumLimit = 0;
+    invalid.maximumLimit = 8;
+    AdaptiveConcurrencyLimiter sanitized(invalid);
+    CHECK(sanitized.getLimit() == 8);
+    CHECK(sanitized.getOptions().minimumLimit == 1);
+  }
+}
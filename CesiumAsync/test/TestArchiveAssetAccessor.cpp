@@ -0,0 +1,371 @@
+#include "CesiumAsync/ArchiveAssetAccessor.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "MockAssetAccessor.h"
+#include "MockAssetRequest.h"
+#include "MockAssetResponse.h"
+#include "MockTaskProcessor.h"
+
+#include <CesiumUtility/Gunzip.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+struct ZipFile {
+  std::string name;
+  std::string contents;
+  bool deflate;
+};
+
+void writeUint(std::vector<std::byte>& out, uint64_t value, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    out.emplace_back(std::byte(static_cast<uint8_t>(value >> (8 * i))));
+  }
+}
+
+void writeString(std::vector<std::byte>& out, const std::string& s) {
+  for (const char c : s) {
+    out.emplace_back(std::byte(static_cast<uint8_t>(c)));
+  }
+}
+
+std::vector<std::byte> deflateData(const std::string& contents) {
+  std::vector<std::byte> data;
+  writeString(data, contents);
+  std::vector<std::byte> gzipped;
+  REQUIRE(CesiumUtility::gzip(data, gzipped));
+
+  // The gzip header that zlib writes without a file name is 10 bytes, and
+  // the trailer is 8 bytes, so the raw deflate data is between them.
+  return std::vector<std::byte>(gzipped.begin() + 10, gzipped.end() - 8);
+}
+
+std::vector<std::byte> createZip(
+    const std::vector<ZipFile>& files,
+    const std::string& comment = std::string()) {
+  std::vector<std::byte> zip;
+  std::vector<std::byte> directory;
+  for (const ZipFile& file : files) {
+    std::vector<std::byte> data;
+    if (file.deflate) {
+      data = deflateData(file.contents);
+    } else {
+      writeString(data, file.contents);
+    }
+
+    const size_t offset = zip.size();
+    const uint16_t method = file.deflate ? 8 : 0;
+
+    writeUint(zip, 0x04034b50, 4);
+    writeUint(zip, 20, 2);
+    writeUint(zip, 0, 2);
+    writeUint(zip, method, 2);
+    writeUint(zip, 0, 8);
+    writeUint(zip, data.size(), 4);
+    writeUint(zip, file.contents.size(), 4);
+    writeUint(zip, file.name.size(), 2);
+    writeUint(zip, 0, 2);
+    writeString(zip, file.name);
+    zip.insert(zip.end(), data.begin(), data.end());
+
+    writeUint(directory, 0x02014b50, 4);
+    writeUint(directory, 20, 2);
+    writeUint(directory, 20, 2);
+    writeUint(directory, 0, 2);
+    writeUint(directory, method, 2);
+    writeUint(directory, 0, 8);
+    writeUint(directory, data.size(), 4);
+    writeUint(directory, file.contents.size(), 4);
+    writeUint(directory, file.name.size(), 2);
+    writeUint(directory, 0, 8);
+    writeUint(directory, 0, 4);
+    writeUint(directory, offset, 4);
+    writeString(directory, file.name);
+  }
+
+  const size_t directoryOffset = zip.size();
+  zip.insert(zip.end(), directory.begin(), directory.end());
+
+  writeUint(zip, 0x06054b50, 4);
+  writeUint(zip, 0, 4);
+  writeUint(zip, files.size(), 2);
+  writeUint(zip, files.size(), 2);
+  writeUint(zip, directory.size(), 4);
+  writeUint(zip, directoryOffset, 4);
+  writeUint(zip, comment.size(), 2);
+  writeString(zip, comment);
+  return zip;
+}
+
+std::string toString(const gsl::span<const std::byte>& data) {
+  return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+// Serves files, and the range of a file that a request's Range header asks
+// for, unless ranges are ignored.
+class RangeAssetAccessor : public MockAssetAccessor {
+public:
+  RangeAssetAccessor() : MockAssetAccessor(nullptr) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    std::string range;
+    for (const THeader& header : headers) {
+      if (header.first == "Range") {
+        range = header.second;
+      }
+    }
+    this->requests.emplace_back(url, range);
+
+    auto it = this->files.find(url);
+    if (it == this->files.end()) {
+      return asyncSystem.createResolvedFuture(createRequest(url, 404, {}, {}));
+    }
+
+    const std::vector<std::byte>& file = it->second;
+    if (range.empty() || this->ignoreRanges) {
+      return asyncSystem.createResolvedFuture(
+          createRequest(url, this->statusCode, {}, file));
+    }
+
+    // The range is either "bytes=first-last" or "bytes=-suffixLength".
+    const std::string spec = range.substr(6);
+    const size_t dash = spec.find('-');
+    size_t first;
+    size_t last;
+    if (dash == 0) {
+      const size_t length = std::stoul(spec.substr(1));
+      first = length < file.size() ? file.size() - length : 0;
+      last = file.size() - 1;
+    } else {
+      first = std::stoul(spec.substr(0, dash));
+      last = std::min(
+          size_t(std::stoul(spec.substr(dash + 1))),
+          file.size() - 1);
+    }
+
+    HttpHeaders responseHeaders{
+        {"Content-Range",
+         "bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" +
+             std::to_string(file.size())}};
+    return asyncSystem.createResolvedFuture(createRequest(
+        url,
+        206,
+        responseHeaders,
+        std::vector<std::byte>(
+            file.begin() + ptrdiff_t(first),
+            file.begin() + ptrdiff_t(last + 1))));
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& /* verb */,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& /* contentPayload */) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  std::mutex mutex;
+  std::map<std::string, std::vector<std::byte>> files;
+  bool ignoreRanges = false;
+  uint16_t statusCode = 200;
+  std::vector<std::pair<std::string, std::string>> requests;
+
+private:
+  static std::shared_ptr<IAssetRequest> createRequest(
+      const std::string& url,
+      uint16_t status,
+      const HttpHeaders& headers,
+      const std::vector<std::byte>& data) {
+    return std::make_shared<MockAssetRequest>(
+        "GET",
+        url,
+        HttpHeaders{},
+        std::make_unique<MockAssetResponse>(
+            status,
+            "application/octet-stream",
+            headers,
+            data));
+  }
+};
+
+const std::string ARCHIVE_URL = "https://a.com/city.3tz";
+
+const std::vector<ZipFile> FILES{
+    {"tileset.json", R"({"asset":{"version":"1.0"}})", false},
+    {"tiles/", "", false},
+    {"tiles/0 b.b3dm", std::string(5000, 'x') + "0", true},
+    {"tiles/1.b3dm", "one", false},
+    {"tiles/2.b3dm", std::string(70000, 'y'), false}};
+
+} // namespace
+
+TEST_CASE("ArchiveAssetAccessor") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  auto pMock = std::make_shared<RangeAssetAccessor>();
+  ArchiveAssetAccessor accessor(pMock);
+
+  SECTION("reads stored and deflated files with range requests") {
+    pMock->files[ARCHIVE_URL] = createZip(FILES);
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, ARCHIVE_URL + "/tileset.json", {}).wait();
+    REQUIRE(pRequest->response());
+    CHECK(pRequest->url() == ARCHIVE_URL + "/tileset.json");
+    CHECK(pRequest->response()->statusCode() == 200);
+    CHECK(pRequest->response()->contentType() == "application/json");
+    CHECK(toString(pRequest->response()->data()) == FILES[0].contents);
+
+    pRequest = accessor.get(asyncSystem, ARCHIVE_URL + "/tiles/0%20b.b3dm", {})
+                   .wait();
+    CHECK(pRequest->response()->statusCode() == 200);
+    CHECK(toString(pRequest->response()->data()) == FILES[2].contents);
+
+    pRequest =
+        accessor.get(asyncSystem, ARCHIVE_URL + "/tiles/1.b3dm", {}).wait();
+    CHECK(toString(pRequest->response()->data()) == "one");
+
+    // The central directory is in the tail that is read first, and each file
+    // before the tail is read with one request.
+    REQUIRE(pMock->requests.size() == 4);
+    CHECK(pMock->requests[0].second == "bytes=-65577");
+    for (const auto& request : pMock->requests) {
+      CHECK(request.first == ARCHIVE_URL);
+      CHECK(!request.second.empty());
+    }
+  }
+
+  SECTION("reads a small archive with one request") {
+    pMock->files[ARCHIVE_URL] = createZip({FILES[0], FILES[3]});
+
+    for (const ZipFile& file : {FILES[0], FILES[3]}) {
+      std::shared_ptr<IAssetRequest> pRequest =
+          accessor.get(asyncSystem, ARCHIVE_URL + "/" + file.name, {}).wait();
+      CHECK(toString(pRequest->response()->data()) == file.contents);
+    }
+    CHECK(pMock->requests.size() == 1);
+  }
+
+  SECTION("reads the central directory when it is not in the tail") {
+    pMock->files[ARCHIVE_URL] = createZip(FILES, std::string(65535, 'c'));
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, ARCHIVE_URL + "/tiles/1.b3dm", {}).wait();
+    CHECK(toString(pRequest->response()->data()) == "one");
+    CHECK(pMock->requests.size() == 3);
+  }
+
+  SECTION("responds with 404 for files that are not in the archive") {
+    pMock->files[ARCHIVE_URL] = createZip(FILES);
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, ARCHIVE_URL + "/missing.json", {}).wait();
+    CHECK(pRequest->response()->statusCode() == 404);
+    pRequest = accessor.get(asyncSystem, ARCHIVE_URL + "/tiles/", {}).wait();
+    CHECK(pRequest->response()->statusCode() == 404);
+    CHECK(pMock->requests.size() == 1);
+  }
+
+  SECTION("passes other requests to the underlying accessor") {
+    pMock->files["https://a.com/tileset.json"] = createZip({});
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, "https://a.com/tileset.json", {}).wait();
+    CHECK(pRequest->response()->statusCode() == 200);
+    accessor.get(asyncSystem, "https://a.com/.3tz/tileset.json", {}).wait();
+    REQUIRE(pMock->requests.size() == 2);
+    CHECK(pMock->requests[0].second.empty());
+    CHECK(pMock->requests[1].first == "https://a.com/.3tz/tileset.json");
+  }
+
+  SECTION("sends the query with the requests for the archive") {
+    pMock->files[ARCHIVE_URL + "?key=1"] = createZip(FILES);
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, ARCHIVE_URL + "/tiles/1.b3dm?key=1", {})
+            .wait();
+    CHECK(toString(pRequest->response()->data()) == "one");
+    CHECK(pMock->requests[0].first == ARCHIVE_URL + "?key=1");
+  }
+
+  SECTION("keeps the whole archive when the server ignores ranges") {
+    pMock->files[ARCHIVE_URL] = createZip(FILES);
+    pMock->ignoreRanges = true;
+
+    for (const ZipFile& file : {FILES[0], FILES[2], FILES[3]}) {
+      std::shared_ptr<IAssetRequest> pRequest =
+          accessor.get(asyncSystem, ARCHIVE_URL + "/" + file.name, {}).wait();
+      CHECK(toString(pRequest->response()->data()) == file.contents);
+    }
+    CHECK(pMock->requests.size() == 1);
+  }
+
+  SECTION("reads an archive again after it could not be read") {
+    pMock->files[ARCHIVE_URL] = createZip(FILES);
+    pMock->ignoreRanges = true;
+    pMock->statusCode = 503;
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, ARCHIVE_URL + "/tileset.json", {}).wait();
+    CHECK(pRequest->response()->statusCode() == 503);
+
+    pMock->statusCode = 200;
+    pRequest =
+        accessor.get(asyncSystem, ARCHIVE_URL + "/tileset.json", {}).wait();
+    CHECK(pRequest->response()->statusCode() == 200);
+    CHECK(pMock->requests.size() == 2);
+  }
+
+  SECTION("rejects archives that are not zip files") {
+    pMock->files[ARCHIVE_URL] = std::vector<std::byte>(100);
+
+    CHECK_THROWS_AS(
+        accessor.get(asyncSystem, ARCHIVE_URL + "/tileset.json", {}).wait(),
+        std::runtime_error);
+  }
+
+  SECTION("maps local archives into memory") {
+    std::remove("test.3tz");
+    const std::vector<std::byte> zip = createZip(FILES);
+    std::FILE* pFile = std::fopen("test.3tz", "wb");
+    REQUIRE(pFile);
+    std::fwrite(zip.data(), 1, zip.size(), pFile);
+    std::fclose(pFile);
+
+    std::string path = std::filesystem::absolute("test.3tz")
+                           .lexically_normal()
+                           .generic_string();
+    if (path.front() != '/') {
+      // Windows paths start with a drive letter.
+      path = "/" + path;
+    }
+
+    for (const ZipFile& file : {FILES[0], FILES[2], FILES[3]}) {
+      std::shared_ptr<IAssetRequest> pRequest =
+          accessor.get(asyncSystem, "file://" + path + "/" + file.name, {})
+              .wait();
+      CHECK(toString(pRequest->response()->data()) == file.contents);
+    }
+    CHECK(pMock->requests.empty());
+
+    std::remove("test.3tz");
+  }
+}
@@ -3,8 +3,11 @@
 #include <catch2/catch.hpp>
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <thread>
+#include <utility>
+#include <vector>
 
 using namespace CesiumAsync;
 
@@ -356,6 +359,84 @@ TEST_CASE("AsyncSystem") {
     CHECK(rejected);
   }
 
+  SECTION("forEachAsCompleted invokes the function in completion order") {
+    auto one = asyncSystem.createPromise<std::unique_ptr<int>>();
+    auto two = asyncSystem.createPromise<std::unique_ptr<int>>();
+    auto three = asyncSystem.createPromise<std::unique_ptr<int>>();
+
+    std::vector<Future<std::unique_ptr<int>>> futures;
+    futures.emplace_back(one.getFuture());
+    futures.emplace_back(two.getFuture());
+    futures.emplace_back(three.getFuture());
+
+    std::vector<std::pair<size_t, int>> completed;
+    auto last = asyncSystem.forEachAsCompleted(
+        std::move(futures),
+        [&completed](size_t index, std::unique_ptr<int>&& pValue) {
+          completed.emplace_back(index, *pValue);
+        });
+
+    three.resolve(std::make_unique<int>(3));
+    CHECK(!last.isReady());
+    one.resolve(std::make_unique<int>(1));
+    two.resolve(std::make_unique<int>(2));
+
+    last.wait();
+    REQUIRE(completed.size() == 3);
+    CHECK(completed[0] == std::make_pair(size_t(2), 3));
+    CHECK(completed[1] == std::make_pair(size_t(0), 1));
+    CHECK(completed[2] == std::make_pair(size_t(1), 2));
+  }
+
+  SECTION("forEachAsCompleted rejects after every Future completes when any "
+          "Future rejects") {
+    auto one = asyncSystem.createPromise<int>();
+    auto two = asyncSystem.createPromise<int>();
+    auto three = asyncSystem.createPromise<int>();
+
+    std::vector<Future<int>> futures;
+    futures.emplace_back(one.getFuture());
+    futures.emplace_back(two.getFuture());
+    futures.emplace_back(three.getFuture());
+
+    std::vector<int> values;
+    bool rejected = false;
+    auto last =
+        asyncSystem
+            .forEachAsCompleted(
+                std::move(futures),
+                [&values](size_t /*index*/, int value) {
+                  values.emplace_back(value);
+                })
+            .thenImmediately([]() {
+              // Should not happen.
+              CHECK(false);
+            })
+            .catchImmediately([&rejected](std::exception&& e) {
+              CHECK(std::string(e.what()) == "2");
+              rejected = true;
+            });
+
+    two.reject(std::runtime_error("2"));
+    CHECK(!rejected);
+    three.resolve(3);
+    one.resolve(1);
+
+    last.wait();
+    CHECK(rejected);
+    CHECK(values == std::vector<int>{3, 1});
+  }
+
+  SECTION("forEachAsCompleted with no Futures resolves immediately") {
+    bool invoked = false;
+    auto last = asyncSystem.forEachAsCompleted(
+        std::vector<Future<int>>(),
+        [&invoked](size_t /*index*/, int /*value*/) { invoked = true; });
+    CHECK(last.isReady());
+    last.wait();
+    CHECK(!invoked);
+  }
+
   SECTION("conversion to SharedFuture") {
     auto promise = asyncSystem.createPromise<int>();
     auto sharedFuture = promise.getFuture().share();
@@ -572,4 +653,102 @@ TEST_CASE("AsyncSystem") {
 
     CHECK(checksCompleted);
   }
+
+  SECTION("dispatchMainThreadTasks with a budget stops when it is used up") {
+    std::vector<int32_t> order;
+    std::vector<Future<void>> futures;
+    for (int32_t i = 0; i < 3; ++i) {
+      futures.emplace_back(asyncSystem.runInMainThread([&order, i]() {
+        order.push_back(i);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      }));
+    }
+    CHECK(asyncSystem.getMainThreadTaskCount() == 3);
+
+    // A budget of zero still runs the first task.
+    MainThreadDispatchResult result = asyncSystem.dispatchMainThreadTasks(0.0);
+    CHECK(result.tasksDispatched == 1);
+    CHECK(result.tasksRemaining == 2);
+    CHECK(result.elapsedMilliseconds >= 20.0);
+    CHECK(order == std::vector<int32_t>{0});
+
+    result = asyncSystem.dispatchMainThreadTasks(10000.0);
+    CHECK(result.tasksDispatched == 2);
+    CHECK(result.tasksRemaining == 0);
+    CHECK(order == std::vector<int32_t>{0, 1, 2});
+    CHECK(asyncSystem.getMainThreadTaskCount() == 0);
+
+    result = asyncSystem.dispatchMainThreadTasks(10000.0);
+    CHECK(result.tasksDispatched == 0);
+  }
+}
+
+TEST_CASE("AsyncSystem settles tasks that the task processor drops") {
+  class StoringTaskProcessor : public ITaskProcessor {
+  public:
+    std::vector<std::function<void()>> tasks;
+
+    virtual void startTask(std::function<void()> f) override {
+      this->tasks.emplace_back(std::move(f));
+    }
+  };
+
+  std::shared_ptr<StoringTaskProcessor> pTaskProcessor =
+      std::make_shared<StoringTaskProcessor>();
+  AsyncSystem asyncSystem(pTaskProcessor);
+
+  SECTION("a task that is dropped rejects its future and is freed") {
+    auto pCaptured = std::make_shared<int32_t>(1);
+    std::weak_ptr<int32_t> pWeakCaptured = pCaptured;
+    bool ran = false;
+
+    Future<void> future = asyncSystem.runInWorkerThread(
+        [pCaptured = std::move(pCaptured), &ran]() { ran = true; });
+    REQUIRE(pTaskProcessor->tasks.size() == 1);
+
+    pTaskProcessor->tasks.clear();
+    CHECK(future.isReady());
+    CHECK_THROWS(future.wait());
+    CHECK(!ran);
+    CHECK(pWeakCaptured.expired());
+  }
+
+  SECTION("a task that is called more than once only runs once") {
+    int32_t calls = 0;
+    Future<int32_t> future =
+        asyncSystem.runInWorkerThread([&calls]() { return ++calls; });
+    REQUIRE(pTaskProcessor->tasks.size() == 1);
+
+    std::function<void()> copy = pTaskProcessor->tasks[0];
+    pTaskProcessor->tasks[0]();
+    copy();
+    pTaskProcessor->tasks.clear();
+
+    CHECK(calls == 1);
+    CHECK(future.wait() == 1);
+  }
+
+  SECTION("tasks settle correctly when their state is reused") {
+    // The state of each task goes back to a pool once its functions are
+    // destroyed, and the next task may take it over.
+    for (int32_t i = 0; i < 10; ++i) {
+      bool ran = false;
+      Future<void> future =
+          asyncSystem.runInWorkerThread([&ran]() { ran = true; });
+      REQUIRE(pTaskProcessor->tasks.size() == 1);
+
+      const bool drop = i % 2 == 0;
+      if (!drop) {
+        pTaskProcessor->tasks[0]();
+      }
+      pTaskProcessor->tasks.clear();
+
+      CHECK(ran == !drop);
+      if (drop) {
+        CHECK_THROWS(future.wait());
+      } else {
+        CHECK_NOTHROW(future.wait());
+      }
+    }
+  }
 }
@@ -0,0 +1,131 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/BandwidthLimiter.h"
+#include "CesiumAsync/BandwidthLimitingAssetAccessor.h"
+#include "MockAssetAccessor.h"
+#include "MockAssetRequest.h"
+#include "MockAssetResponse.h"
+#include "MockTaskProcessor.h"
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+class StreamingAssetAccessor : public MockAssetAccessor {
+public:
+  StreamingAssetAccessor(const std::shared_ptr<IAssetRequest>& request)
+      : MockAssetAccessor(request) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>> getStreaming(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const DataReceivedCallback& onDataReceived) override {
+    gsl::span<const std::byte> data = this->testRequest->response()->data();
+    onDataReceived(data.first(2));
+    onDataReceived(data.subspan(2));
+    return this->get(asyncSystem, url, headers);
+  }
+};
+
+std::shared_ptr<IAssetRequest> createRequest(size_t size) {
+  return std::make_shared<MockAssetRequest>(
+      "GET",
+      "test.com",
+      HttpHeaders{},
+      std::make_unique<MockAssetResponse>(
+          uint16_t(200),
+          "app/json",
+          HttpHeaders{},
+          std::vector<std::byte>(size)));
+}
+
+} // namespace
+
+TEST_CASE("BandwidthLimiter") {
+  SECTION("starts with a full bucket") {
+    BandwidthLimiter limiter(0.0, 1000);
+    CHECK(limiter.getAvailableBytes() == 1000);
+    CHECK(limiter.isFull());
+    CHECK(!limiter.isExhausted());
+  }
+
+  SECTION("goes into debt") {
+    BandwidthLimiter limiter(0.0, 1000);
+    limiter.consume(400);
+    CHECK(limiter.getAvailableBytes() == 600);
+    CHECK(!limiter.isFull());
+    CHECK(!limiter.isExhausted());
+
+    limiter.consume(1000);
+    CHECK(limiter.getAvailableBytes() == -400);
+    CHECK(limiter.isExhausted());
+    CHECK(limiter.getTotalConsumedBytes() == 1400);
+  }
+
+  SECTION("ignores negative sizes") {
+    BandwidthLimiter limiter(0.0, 1000);
+    limiter.consume(-100);
+    CHECK(limiter.getAvailableBytes() == 1000);
+    CHECK(limiter.getTotalConsumedBytes() == 0);
+  }
+
+  SECTION("drops the excess when the bucket shrinks") {
+    BandwidthLimiter limiter(0.0, 1000);
+    limiter.setBurstBytes(500);
+    CHECK(limiter.getBurstBytes() == 500);
+    CHECK(limiter.getAvailableBytes() == 500);
+  }
+
+  SECTION("refills over time up to the burst size") {
+    BandwidthLimiter limiter(100000.0, 1000);
+    limiter.consume(2000);
+    CHECK(limiter.isExhausted());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(!limiter.isExhausted());
+    CHECK(limiter.isFull());
+    CHECK(limiter.getAvailableBytes() == 1000);
+  }
+}
+
+TEST_CASE("BandwidthLimitingAssetAccessor") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  std::shared_ptr<BandwidthLimiter> pLimiter =
+      std::make_shared<BandwidthLimiter>(0.0, 100);
+
+  SECTION("takes the data of complete responses") {
+    BandwidthLimitingAssetAccessor accessor(
+        std::make_shared<MockAssetAccessor>(createRequest(30)),
+        pLimiter);
+    accessor.get(asyncSystem, "http://a.com/tile.b3dm", {}).wait();
+    accessor.request(asyncSystem, "GET", "http://a.com/b.b3dm", {}, {}).wait();
+    CHECK(pLimiter->getAvailableBytes() == 40);
+    CHECK(pLimiter->getTotalConsumedBytes() == 60);
+  }
+
+  SECTION("takes streamed data once") {
+    BandwidthLimitingAssetAccessor accessor(
+        std::make_shared<StreamingAssetAccessor>(createRequest(30)),
+        pLimiter);
+    size_t receivedBytes = 0;
+    accessor
+        .getStreaming(
+            asyncSystem,
+            "http://a.com/tile.b3dm",
+            {},
+            [&receivedBytes](const gsl::span<const std::byte>& data) {
+              receivedBytes += data.size();
+            })
+        .wait();
+    CHECK(receivedBytes == 30);
+    CHECK(pLimiter->getTotalConsumedBytes() == 30);
+  }
+}
@@ -11,6 +11,7 @@
 #include <catch2/catch.hpp>
 #include <spdlog/spdlog.h>
 
+#include <atomic>
 #include <cstddef>
 #include <optional>
 
@@ -38,8 +39,9 @@ public:
         clearAllCall{false} {}
 
   virtual std::optional<CacheItem>
-  getEntry(const std::string& /*key*/) const override {
+  getEntry(const std::string& key) const override {
     this->getEntryCall = true;
+    this->getEntryKey = key;
     return this->cacheItem;
   }
 
@@ -76,6 +78,7 @@ public:
   }
 
   mutable bool getEntryCall;
+  mutable std::string getEntryKey;
   bool storeResponseCall;
   bool pruneCall;
   bool clearAllCall;
@@ -84,6 +87,38 @@ public:
   std::optional<CacheItem> cacheItem;
 };
 
+class DeferredAssetAccessor : public IAssetAccessor {
+public:
+  DeferredAssetAccessor(
+      SharedFuture<std::shared_ptr<IAssetRequest>>&& sharedFuture)
+      : future(std::move(sharedFuture)), getCalls(0) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& /*asyncSystem*/,
+      const std::string& /*url*/,
+      const std::vector<THeader>& /*headers*/) override {
+    ++this->getCalls;
+    return this->future.thenImmediately(
+        [](const std::shared_ptr<IAssetRequest>& pRequest) {
+          return pRequest;
+        });
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& /*verb*/,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& /*contentPayload*/) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+
+  SharedFuture<std::shared_ptr<IAssetRequest>> future;
+  std::atomic<int32_t> getCalls;
+};
+
 } // namespace
 
 bool runResponseCacheTest(
@@ -900,3 +935,176 @@ TEST_CASE("Test serving cache item") {
         .wait();
   }
 }
+
+TEST_CASE("Test sharing requests that are in flight") {
+  std::shared_ptr<IAssetRequest> mockRequest =
+      std::make_shared<MockAssetRequest>(
+          "GET",
+          "test.com",
+          HttpHeaders{},
+          std::make_unique<MockAssetResponse>(
+              static_cast<uint16_t>(200),
+              "app/json",
+              HttpHeaders{{"Content-Type", "app/json"}},
+              std::vector<std::byte>{std::byte(1), std::byte(2)}));
+
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  Promise<std::shared_ptr<IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+  std::shared_ptr<DeferredAssetAccessor> pAssetAccessor =
+      std::make_shared<DeferredAssetAccessor>(promise.getFuture().share());
+  CachingAssetAccessor cacheAssetAccessor(
+      spdlog::default_logger(),
+      pAssetAccessor,
+      std::make_shared<MockStoreCacheDatabase>());
+
+  // The first two are the same request, with the headers in another order.
+  Future<std::shared_ptr<IAssetRequest>> first = cacheAssetAccessor.get(
+      asyncSystem,
+      "test.com",
+      {{"Header-A", "A"}, {"Header-B", "B"}});
+  Future<std::shared_ptr<IAssetRequest>> second = cacheAssetAccessor.get(
+      asyncSystem,
+      "test.com",
+      {{"Header-B", "B"}, {"Header-A", "A"}});
+  Future<std::shared_ptr<IAssetRequest>> other =
+      cacheAssetAccessor.get(asyncSystem, "test.com", {});
+
+  promise.resolve(mockRequest);
+  std::shared_ptr<IAssetRequest> pFirst = first.wait();
+  std::shared_ptr<IAssetRequest> pSecond = second.wait();
+  REQUIRE(other.wait() != nullptr);
+  CHECK(pAssetAccessor->getCalls == 2);
+
+  // Taking the response data of one leaves it for the other.
+  REQUIRE(pFirst != nullptr);
+  REQUIRE(pSecond != nullptr);
+  CHECK(pFirst->takeResponseData().size() == 2);
+  REQUIRE(pSecond->response() != nullptr);
+  CHECK(pSecond->response()->data().size() == 2);
+
+  // A request after the earlier ones completed is made again.
+  cacheAssetAccessor.get(asyncSystem, "test.com", {}).wait();
+  CHECK(pAssetAccessor->getCalls == 3);
+}
+
+TEST_CASE("Test serving stale cache items while revalidating them") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  Promise<std::shared_ptr<IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+  std::shared_ptr<DeferredAssetAccessor> pAssetAccessor =
+      std::make_shared<DeferredAssetAccessor>(promise.getFuture().share());
+
+  const auto createCacheDatabase = [](const std::string& cacheControl) {
+    std::shared_ptr<MockStoreCacheDatabase> pCacheDatabase =
+        std::make_shared<MockStoreCacheDatabase>();
+    pCacheDatabase->cacheItem = CacheItem(
+        std::time(nullptr) - 100,
+        CacheRequest(HttpHeaders{}, "GET", "cache.com"),
+        CacheResponse(
+            static_cast<uint16_t>(200),
+            HttpHeaders{
+                {"Content-Type", "app/json"},
+                {"Cache-Control", cacheControl},
+                {"ETag", "deadbeef"}},
+            std::vector<std::byte>()));
+    return pCacheDatabase;
+  };
+
+  SECTION("Serve the stale item without waiting for the revalidation") {
+    CachingAssetAccessor cacheAssetAccessor(
+        spdlog::default_logger(),
+        pAssetAccessor,
+        createCacheDatabase("max-age=100"),
+        10000,
+        true);
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        cacheAssetAccessor.get(asyncSystem, "test.com", {}).wait();
+    REQUIRE(pRequest != nullptr);
+    CHECK(pRequest->url() == "cache.com");
+    CHECK(pAssetAccessor->getCalls == 1);
+
+    // The item is only revalidated once at a time.
+    pRequest = cacheAssetAccessor.get(asyncSystem, "test.com", {}).wait();
+    REQUIRE(pRequest != nullptr);
+    CHECK(pRequest->url() == "cache.com");
+    CHECK(pAssetAccessor->getCalls == 1);
+    CHECK(cacheAssetAccessor.getStatistics().staleHitCount == 2);
+    CHECK(cacheAssetAccessor.getStatistics().revalidationCount == 0);
+  }
+
+  SECTION("Wait for the revalidation once stale-while-revalidate expires") {
+    CachingAssetAccessor cacheAssetAccessor(
+        spdlog::default_logger(),
+        pAssetAccessor,
+        createCacheDatabase("max-age=100, stale-while-revalidate=10"),
+        10000,
+        true);
+
+    Future<std::shared_ptr<IAssetRequest>> future =
+        cacheAssetAccessor.get(asyncSystem, "test.com", {});
+    promise.resolve(std::make_shared<MockAssetRequest>(
+        "GET",
+        "test.com",
+        HttpHeaders{},
+        std::make_unique<MockAssetResponse>(
+            static_cast<uint16_t>(200),
+            "app/json",
+            HttpHeaders{{"Content-Type", "app/json"}},
+            std::vector<std::byte>())));
+
+    std::shared_ptr<IAssetRequest> pRequest = future.wait();
+    REQUIRE(pRequest != nullptr);
+    CHECK(pRequest->url() == "test.com");
+    CHECK(cacheAssetAccessor.getStatistics().revalidationCount == 1);
+    CHECK(cacheAssetAccessor.getStatistics().staleHitCount == 0);
+  }
+}
+
+TEST_CASE("Test normalizing cache keys") {
+  SECTION("Remove query parameters from the key") {
+    CachingAssetAccessor::CacheKeyFunction cacheKeyFunction =
+        CachingAssetAccessor::ignoreQueryParameters({"access_token", "v"});
+    CHECK(cacheKeyFunction("test.com/a.b3dm", {}) == "test.com/a.b3dm");
+    CHECK(cacheKeyFunction("test.com/a?access_token=1", {}) == "test.com/a");
+    CHECK(
+        cacheKeyFunction("test.com/a?v=1&x=2&access_token=3", {}) ==
+        "test.com/a?x=2");
+    CHECK(
+        cacheKeyFunction("test.com/a?access_tokens=1", {}) ==
+        "test.com/a?access_tokens=1");
+  }
+
+  SECTION("Look up and store the response under the normalized key") {
+    std::shared_ptr<IAssetRequest> mockRequest =
+        std::make_shared<MockAssetRequest>(
+            "GET",
+            "test.com?access_token=1",
+            HttpHeaders{},
+            std::make_unique<MockAssetResponse>(
+                static_cast<uint16_t>(200),
+                "app/json",
+                HttpHeaders{{"Cache-Control", "max-age=100"}},
+                std::vector<std::byte>()));
+
+    std::shared_ptr<MockStoreCacheDatabase> pCacheDatabase =
+        std::make_shared<MockStoreCacheDatabase>();
+    CachingAssetAccessor cacheAssetAccessor(
+        spdlog::default_logger(),
+        std::make_shared<MockAssetAccessor>(mockRequest),
+        pCacheDatabase,
+        10000,
+        false,
+        CachingAssetAccessor::ignoreQueryParameters({"access_token"}));
+
+    AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+    cacheAssetAccessor.get(asyncSystem, "test.com?access_token=1", {}).wait();
+    CHECK(pCacheDatabase->getEntryKey == "test.com");
+    REQUIRE(pCacheDatabase->storeRequestParam);
+    CHECK(pCacheDatabase->storeRequestParam->key == "test.com");
+    CHECK(pCacheDatabase->storeRequestParam->url == "test.com?access_token=1");
+    CHECK(cacheAssetAccessor.getStatistics().missCount == 1);
+    CHECK(cacheAssetAccessor.getStatistics().hitCount == 0);
+  }
+}
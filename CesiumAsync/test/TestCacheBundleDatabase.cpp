@@ -0,0 +1,206 @@
+#include "CesiumAsync/CacheBundleDatabase.h"
+#include "CesiumAsync/CacheBundleWriter.h"
+#include "CesiumAsync/SqliteCache.h"
+
+#include <catch2/catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+class MockCacheDatabase : public ICacheDatabase {
+public:
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override {
+    ++this->getEntryCalls;
+    auto it = this->items.find(key);
+    if (it == this->items.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    this->items.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(
+                HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  virtual bool prune() override { return true; }
+
+  virtual bool clearAll() override {
+    this->items.clear();
+    return true;
+  }
+
+  std::map<std::string, CacheItem> items;
+  mutable int32_t getEntryCalls = 0;
+};
+
+CacheItem createItem(const std::string& url, size_t dataSize) {
+  return CacheItem(
+      std::time(nullptr) + 1000,
+      CacheRequest(
+          HttpHeaders{{"Accept", "*/*"}},
+          std::string("GET"),
+          std::string(url)),
+      CacheResponse(
+          200,
+          HttpHeaders{{"Content-Type", "application/octet-stream"}},
+          std::vector<std::byte>(dataSize, std::byte(7))));
+}
+
+} // namespace
+
+TEST_CASE("CacheBundleDatabase") {
+  auto pDatabase = std::make_shared<MockCacheDatabase>();
+  std::remove("test.bundle");
+
+  SECTION("finds the entries of the bundle") {
+    CacheBundleWriter writer("test.bundle");
+    REQUIRE(writer.addEntry("a", createItem("a.com", 3)));
+    REQUIRE(writer.addEntry("b", createItem("b.com", 1000)));
+    REQUIRE(writer.addEntry("c", createItem("c.com", 0)));
+    REQUIRE(writer.finish());
+
+    CacheBundleDatabase database(
+        spdlog::default_logger(),
+        "test.bundle",
+        pDatabase);
+    CHECK(database.getBundleEntryCount() == 3);
+
+    std::optional<CacheItem> cacheItem = database.getEntry("b");
+    REQUIRE(cacheItem);
+    CHECK(cacheItem->cacheRequest.url == "b.com");
+    CHECK(cacheItem->cacheRequest.method == "GET");
+    CHECK(cacheItem->cacheRequest.headers.at("Accept") == "*/*");
+    CHECK(cacheItem->cacheResponse.statusCode == 200);
+    CHECK(
+        cacheItem->cacheResponse.headers.at("Content-Type") ==
+        "application/octet-stream");
+    CHECK(
+        cacheItem->cacheResponse.data ==
+        std::vector<std::byte>(1000, std::byte(7)));
+
+    cacheItem = database.getEntry("c");
+    REQUIRE(cacheItem);
+    CHECK(cacheItem->cacheResponse.data.empty());
+    CHECK(pDatabase->getEntryCalls == 0);
+
+    CHECK(!database.getEntry("missing"));
+    CHECK(pDatabase->getEntryCalls == 1);
+  }
+
+  SECTION("finds entries that were stored again in the underlying database") {
+    CacheBundleWriter writer("test.bundle");
+    REQUIRE(writer.addEntry("a", createItem("a.com", 3)));
+    REQUIRE(writer.finish());
+
+    CacheBundleDatabase database(
+        spdlog::default_logger(),
+        "test.bundle",
+        pDatabase);
+    const std::vector<std::byte> data(5, std::byte(9));
+    REQUIRE(database.storeEntry(
+        "a",
+        std::time(nullptr) + 1000,
+        "a.com",
+        "GET",
+        HttpHeaders(),
+        200,
+        HttpHeaders(),
+        data));
+
+    std::optional<CacheItem> cacheItem = database.getEntry("a");
+    REQUIRE(cacheItem);
+    CHECK(cacheItem->cacheResponse.data == data);
+    CHECK(pDatabase->getEntryCalls == 1);
+
+    REQUIRE(database.clearAll());
+    cacheItem = database.getEntry("a");
+    REQUIRE(cacheItem);
+    CHECK(cacheItem->cacheResponse.data.size() == 3);
+  }
+
+  SECTION("writes the entries of a SqliteCache") {
+    {
+      SqliteCache diskCache(spdlog::default_logger(), "test-bundle.db", 10);
+      REQUIRE(diskCache.clearAll());
+      for (int i = 0; i < 5; ++i) {
+        const std::string key = "key" + std::to_string(i);
+        const std::vector<std::byte> data(size_t(i + 1), std::byte(i));
+        REQUIRE(diskCache.storeEntry(
+            key,
+            std::time(nullptr) + 1000,
+            "test.com/" + key,
+            "GET",
+            HttpHeaders(),
+            200,
+            HttpHeaders{{"Content-Type", "text/html"}},
+            data));
+      }
+
+      CacheBundleWriter writer("test.bundle");
+      REQUIRE(writer.addEntries(diskCache));
+      CHECK(writer.getEntryCount() == 5);
+      REQUIRE(writer.finish());
+    }
+
+    CacheBundleDatabase database(
+        spdlog::default_logger(),
+        "test.bundle",
+        pDatabase);
+    CHECK(database.getBundleEntryCount() == 5);
+    for (int i = 0; i < 5; ++i) {
+      const std::string key = "key" + std::to_string(i);
+      std::optional<CacheItem> cacheItem = database.getEntry(key);
+      REQUIRE(cacheItem);
+      CHECK(cacheItem->cacheRequest.url == "test.com/" + key);
+      CHECK(cacheItem->cacheResponse.headers.at("Content-Type") == "text/html");
+      CHECK(
+          cacheItem->cacheResponse.data ==
+          std::vector<std::byte>(size_t(i + 1), std::byte(i)));
+    }
+    CHECK(pDatabase->getEntryCalls == 0);
+  }
+
+  SECTION("uses the underlying database if the bundle cannot be opened") {
+    pDatabase->items.emplace("key", createItem("test.com", 1));
+    CacheBundleDatabase database(
+        spdlog::default_logger(),
+        "missing.bundle",
+        pDatabase);
+    CHECK(database.getBundleEntryCount() == 0);
+    CHECK(database.getEntry("key"));
+    CHECK(pDatabase->getEntryCalls == 1);
+  }
+}
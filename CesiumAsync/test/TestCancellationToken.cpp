@@ -0,0 +1,87 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/CancellationToken.h"
+#include "MockTaskProcessor.h"
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace CesiumAsync;
+
+TEST_CASE("CancellationToken") {
+  SECTION("is canceled by its source") {
+    CancellationSource source;
+    CancellationToken token = source.getToken();
+    CancellationToken copy = token;
+    CHECK(!token.isCanceled());
+    CHECK_NOTHROW(token.throwIfCanceled());
+
+    source.cancel();
+    CHECK(source.isCanceled());
+    CHECK(token.isCanceled());
+    CHECK(copy.isCanceled());
+    CHECK_THROWS_AS(token.throwIfCanceled(), OperationCanceledException);
+  }
+
+  SECTION("is never canceled when default-constructed") {
+    CancellationToken token;
+    CHECK(!token.isCanceled());
+  }
+}
+
+TEST_CASE("Future::withCancellation") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+
+  SECTION("resolves when the operation is not canceled") {
+    CancellationSource source;
+    int32_t result = asyncSystem.createResolvedFuture(3)
+                         .withCancellation(source.getToken())
+                         .thenImmediately([](int32_t value) {
+                           return value * 2;
+                         })
+                         .wait();
+    CHECK(result == 6);
+  }
+
+  SECTION("skips the remaining continuations once canceled") {
+    CancellationSource source;
+    Promise<void> promise = asyncSystem.createPromise<void>();
+
+    bool firstRan = false;
+    bool secondRan = false;
+    std::string caught;
+    Future<void> future =
+        promise.getFuture()
+            .thenImmediately([&firstRan]() { firstRan = true; })
+            .withCancellation(source.getToken())
+            .thenInWorkerThread([&secondRan]() { secondRan = true; })
+            .catchImmediately([&caught](std::exception&& e) {
+              caught = e.what();
+            });
+
+    source.cancel();
+    promise.resolve();
+    future.wait();
+
+    CHECK(firstRan);
+    CHECK(!secondRan);
+    CHECK(caught == OperationCanceledException().what());
+  }
+
+  SECTION("passes on the rejection of the future") {
+    CancellationSource source;
+    std::string caught;
+    asyncSystem.createFuture<int32_t>([](const auto& promise) {
+      promise.reject(std::runtime_error("failed"));
+    })
+        .withCancellation(source.getToken())
+        .thenImmediately([](int32_t value) { return value; })
+        .catchImmediately([&caught](std::exception&& e) {
+          caught = e.what();
+          return 0;
+        })
+        .wait();
+    CHECK(caught == "failed");
+  }
+}
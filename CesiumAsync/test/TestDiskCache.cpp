@@ -3,10 +3,15 @@
 #include "MockAssetResponse.h"
 #include "ResponseCacheControl.h"
 
+#include <CesiumUtility/Gunzip.h>
 #include <catch2/catch.hpp>
 #include <spdlog/spdlog.h>
 
+#include <atomic>
 #include <cstddef>
+#include <filesystem>
+#include <thread>
+#include <vector>
 
 using namespace CesiumAsync;
 
@@ -213,4 +218,270 @@ TEST_CASE("Test disk cache with Sqlite") {
       REQUIRE(cacheItem == std::nullopt);
     }
   }
+
+  SECTION("Test concurrent reads and writes") {
+    std::vector<std::byte> responseData =
+        {std::byte(0), std::byte(1), std::byte(2), std::byte(3), std::byte(4)};
+    const std::time_t expiryTime = std::time(nullptr) + 1000;
+    for (size_t i = 0; i < 3; ++i) {
+      REQUIRE(diskCache.storeEntry(
+          "TestKey" + std::to_string(i),
+          expiryTime,
+          "test.com",
+          "GET",
+          HttpHeaders(),
+          200,
+          HttpHeaders(),
+          responseData));
+    }
+
+    // Readers see the entries written before they started, while another
+    // thread keeps writing.
+    std::atomic<int32_t> hits = 0;
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < 8; ++i) {
+      readers.emplace_back([&diskCache, &hits, &responseData, i]() {
+        for (size_t j = 0; j < 50; ++j) {
+          std::optional<CacheItem> cacheItem =
+              diskCache.getEntry("TestKey" + std::to_string((i + j) % 3));
+          if (cacheItem && cacheItem->cacheResponse.data == responseData) {
+            ++hits;
+          }
+        }
+      });
+    }
+
+    for (size_t i = 0; i < 20; ++i) {
+      CHECK(diskCache.storeEntry(
+          "OtherKey" + std::to_string(i),
+          expiryTime,
+          "test.com",
+          "GET",
+          HttpHeaders(),
+          200,
+          HttpHeaders(),
+          responseData));
+    }
+
+    for (std::thread& reader : readers) {
+      reader.join();
+    }
+
+    CHECK(hits == 400);
+    CHECK(diskCache.getEntry("OtherKey19") != std::nullopt);
+  }
+
+  SECTION("Test stored entries are written when the cache is destroyed") {
+    std::vector<std::byte> responseData = {std::byte(0), std::byte(1)};
+    {
+      SqliteCache otherCache(spdlog::default_logger(), "test-writes.db", 100);
+      REQUIRE(otherCache.clearAll());
+      for (size_t i = 0; i < 10; ++i) {
+        REQUIRE(otherCache.storeEntry(
+            "TestKey" + std::to_string(i),
+            std::time(nullptr) + 1000,
+            "test.com",
+            "GET",
+            HttpHeaders(),
+            200,
+            HttpHeaders(),
+            responseData));
+      }
+
+      // Entries that are not written yet are found, too.
+      REQUIRE(otherCache.getEntry("TestKey0") != std::nullopt);
+    }
+
+    SqliteCache otherCache(spdlog::default_logger(), "test-writes.db", 100);
+    for (size_t i = 0; i < 10; ++i) {
+      std::optional<CacheItem> cacheItem =
+          otherCache.getEntry("TestKey" + std::to_string(i));
+      REQUIRE(cacheItem != std::nullopt);
+      REQUIRE(cacheItem->cacheResponse.data == responseData);
+    }
+  }
+
+  SECTION("Test large response data is stored in files") {
+    std::vector<std::byte> largeData(1000, std::byte(9));
+    std::vector<std::byte> smallData(10, std::byte(1));
+    SqliteCache
+        otherCache(spdlog::default_logger(), "test-files.db", 100, 4, 100);
+    REQUIRE(otherCache.clearAll());
+
+    const std::time_t expiryTime = std::time(nullptr) + 1000;
+    for (const char* key : {"Large0", "Large1"}) {
+      REQUIRE(otherCache.storeEntry(
+          key,
+          expiryTime,
+          "test.com",
+          "GET",
+          HttpHeaders(),
+          200,
+          HttpHeaders(),
+          largeData));
+    }
+    REQUIRE(otherCache.storeEntry(
+        "Small",
+        expiryTime,
+        "test.com",
+        "GET",
+        HttpHeaders(),
+        200,
+        HttpHeaders(),
+        smallData));
+
+    // Write the entries.
+    REQUIRE(otherCache.prune());
+
+    for (const char* key : {"Large0", "Large1"}) {
+      std::optional<CacheItem> cacheItem = otherCache.getEntry(key);
+      REQUIRE(cacheItem != std::nullopt);
+      REQUIRE(cacheItem->cacheResponse.data == largeData);
+    }
+    std::optional<CacheItem> cacheItem = otherCache.getEntry("Small");
+    REQUIRE(cacheItem != std::nullopt);
+    REQUIRE(cacheItem->cacheResponse.data == smallData);
+
+    // Each entry has its own file, even when the data is the same.
+    auto countDataFiles = []() {
+      size_t count = 0;
+      for ([[maybe_unused]] const std::filesystem::directory_entry& file :
+           std::filesystem::directory_iterator("test-files.db.files")) {
+        ++count;
+      }
+      return count;
+    };
+    CHECK(countDataFiles() == 2);
+
+    // Replacing an entry with other data of the same size leaves the data of
+    // the other entry alone, and its old file is deleted once the
+    // replacement is written.
+    std::vector<std::byte> otherLargeData(1000, std::byte(7));
+    REQUIRE(otherCache.storeEntry(
+        "Large0",
+        expiryTime,
+        "test.com",
+        "GET",
+        HttpHeaders(),
+        200,
+        HttpHeaders(),
+        otherLargeData));
+    REQUIRE(otherCache.prune());
+    CHECK(countDataFiles() == 2);
+
+    std::optional<CacheItem> replacedItem = otherCache.getEntry("Large0");
+    REQUIRE(replacedItem != std::nullopt);
+    CHECK(replacedItem->cacheResponse.data == otherLargeData);
+    std::optional<CacheItem> otherItem = otherCache.getEntry("Large1");
+    REQUIRE(otherItem != std::nullopt);
+    CHECK(otherItem->cacheResponse.data == largeData);
+
+    REQUIRE(otherCache.clearAll());
+    REQUIRE(otherCache.getEntry("Large0") == std::nullopt);
+    CHECK(countDataFiles() == 0);
+  }
+
+  SECTION("Test prune keeps the size of the response data within a limit") {
+    std::vector<std::byte> responseData(100, std::byte(1));
+    SqliteCache
+        otherCache(spdlog::default_logger(), "test-bytes.db", 100, 4, 0, 250);
+    REQUIRE(otherCache.clearAll());
+
+    const std::time_t expiryTime = std::time(nullptr) + 1000;
+    const auto store = [&otherCache, expiryTime](
+                           const std::string& key,
+                           const std::vector<std::byte>& data) {
+      return otherCache.storeEntry(
+          key,
+          expiryTime,
+          "test.com",
+          "GET",
+          HttpHeaders(),
+          200,
+          HttpHeaders(),
+          data);
+    };
+
+    for (size_t i = 0; i < 5; ++i) {
+      REQUIRE(store("TestKey" + std::to_string(i), responseData));
+    }
+
+    // The least recently used entries are deleted.
+    REQUIRE(otherCache.prune());
+    for (size_t i = 0; i < 3; ++i) {
+      REQUIRE(
+          otherCache.getEntry("TestKey" + std::to_string(i)) == std::nullopt);
+    }
+    REQUIRE(otherCache.getEntry("TestKey3") != std::nullopt);
+    REQUIRE(otherCache.getEntry("TestKey4") != std::nullopt);
+
+    // A replaced entry only counts with its new size.
+    REQUIRE(store("TestKey4", std::vector<std::byte>(10, std::byte(2))));
+    REQUIRE(store("TestKey5", responseData));
+    REQUIRE(otherCache.prune());
+    for (size_t i = 3; i < 6; ++i) {
+      REQUIRE(
+          otherCache.getEntry("TestKey" + std::to_string(i)) != std::nullopt);
+    }
+  }
+
+  SECTION("Test response data is stored compressed") {
+    std::vector<std::byte> responseData(10000);
+    for (size_t i = 0; i < responseData.size(); ++i) {
+      responseData[i] = std::byte(i % 10);
+    }
+    std::vector<std::byte> gzippedData;
+    REQUIRE(CesiumUtility::gzip(responseData, gzippedData));
+
+    // The compressed entries fit within a limit that the uncompressed ones
+    // would not.
+    SqliteCache otherCache(
+        spdlog::default_logger(),
+        "test-compressed.db",
+        100,
+        4,
+        0,
+        5000,
+        true);
+    REQUIRE(otherCache.clearAll());
+
+    const std::time_t expiryTime = std::time(nullptr) + 1000;
+    for (const char* key : {"TestKey0", "TestKey1"}) {
+      REQUIRE(otherCache.storeEntry(
+          key,
+          expiryTime,
+          "test.com",
+          "GET",
+          HttpHeaders(),
+          200,
+          HttpHeaders(),
+          responseData));
+    }
+    REQUIRE(otherCache.storeEntry(
+        "Gzipped",
+        expiryTime,
+        "test.com",
+        "GET",
+        HttpHeaders(),
+        200,
+        HttpHeaders(),
+        gzippedData));
+
+    // Entries that are not written yet are decompressed, too.
+    std::optional<CacheItem> cacheItem = otherCache.getEntry("TestKey0");
+    REQUIRE(cacheItem != std::nullopt);
+    REQUIRE(cacheItem->cacheResponse.data == responseData);
+
+    REQUIRE(otherCache.prune());
+    for (const char* key : {"TestKey0", "TestKey1"}) {
+      cacheItem = otherCache.getEntry(key);
+      REQUIRE(cacheItem != std::nullopt);
+      REQUIRE(cacheItem->cacheResponse.data == responseData);
+    }
+
+    // Data that was gzipped already is returned as it was stored.
+    cacheItem = otherCache.getEntry("Gzipped");
+    REQUIRE(cacheItem != std::nullopt);
+    REQUIRE(cacheItem->cacheResponse.data == gzippedData);
+  }
 }
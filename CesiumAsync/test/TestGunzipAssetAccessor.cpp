@@ -4,9 +4,12 @@
 #include "MockTaskProcessor.h"
 
 #include <CesiumAsync/GunzipAssetAccessor.h>
+#include <CesiumUtility/Gunzip.h>
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+
 using namespace CesiumAsync;
 
 namespace {
@@ -23,6 +26,43 @@ std::vector<std::byte> asBytes(const std::vector<int>& ints) {
   return bytes;
 }
 
+class StreamingAssetAccessor : public MockAssetAccessor {
+public:
+  StreamingAssetAccessor(
+      const std::shared_ptr<IAssetRequest>& request,
+      size_t pieceSize_)
+      : MockAssetAccessor(request), pieceSize(pieceSize_) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>> getStreaming(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const DataReceivedCallback& onDataReceived) override {
+    const gsl::span<const std::byte> data =
+        this->testRequest->response()->data();
+    for (size_t i = 0; i < data.size(); i += this->pieceSize) {
+      onDataReceived(
+          data.subspan(i, std::min(this->pieceSize, data.size() - i)));
+    }
+    return this->get(asyncSystem, url, headers);
+  }
+
+  size_t pieceSize;
+};
+
+std::shared_ptr<IAssetRequest>
+createRequest(const std::vector<std::byte>& data) {
+  return std::make_shared<MockAssetRequest>(
+      "GET",
+      "https://example.com",
+      HttpHeaders{},
+      std::make_unique<MockAssetResponse>(
+          static_cast<uint16_t>(200),
+          "Application/Whatever",
+          HttpHeaders{},
+          data));
+}
+
 } // namespace
 
 TEST_CASE("GunzipAssetAccessor") {
@@ -104,6 +144,12 @@ TEST_CASE("GunzipAssetAccessor") {
             pResponse->data().data(),
             pResponse->data().data() + pResponse->data().size()) ==
         asBytes(std::vector<int>{0x01, 0x02, 0x03}));
+
+    // The gunzipped data can be moved out of the request.
+    CHECK(
+        pCompletedRequest->takeResponseData() ==
+        asBytes(std::vector<int>{0x01, 0x02, 0x03}));
+    CHECK(pResponse->data().empty());
   }
 
   SECTION("passes through a response that has a gzip header but can't be "
@@ -192,4 +238,71 @@ TEST_CASE("GunzipAssetAccessor") {
             pResponse->data().data() + pResponse->data().size()) ==
         asBytes(std::vector<int>{0x01, 0x02, 0x03}));
   }
+
+  SECTION("gunzips a streamed response as it is received") {
+    std::vector<std::byte> data(100000);
+    for (size_t i = 0; i < data.size(); ++i) {
+      data[i] = std::byte(i % 7);
+    }
+
+    std::vector<std::byte> gzipped;
+    REQUIRE(CesiumUtility::gzip(data, gzipped));
+
+    std::shared_ptr<MockTaskProcessor> mockTaskProcessor =
+        std::make_shared<MockTaskProcessor>();
+    AsyncSystem asyncSystem(mockTaskProcessor);
+
+    for (size_t pieceSize : std::vector<size_t>{1, 2, 100, 1000000}) {
+      GunzipAssetAccessor accessor(std::make_shared<StreamingAssetAccessor>(
+          createRequest(gzipped),
+          pieceSize));
+
+      std::vector<std::byte> received;
+      std::shared_ptr<IAssetRequest> pCompletedRequest =
+          accessor
+              .getStreaming(
+                  asyncSystem,
+                  "https://example.com",
+                  {},
+                  [&received](const gsl::span<const std::byte>& piece) {
+                    received.insert(received.end(), piece.begin(), piece.end());
+                  })
+              .wait();
+      CHECK(received == data);
+
+      const IAssetResponse* pResponse = pCompletedRequest->response();
+      REQUIRE(pResponse != nullptr);
+      CHECK(
+          std::vector<std::byte>(
+              pResponse->data().data(),
+              pResponse->data().data() + pResponse->data().size()) == data);
+    }
+  }
+
+  SECTION("passes through a streamed response without gzip header") {
+    std::shared_ptr<MockTaskProcessor> mockTaskProcessor =
+        std::make_shared<MockTaskProcessor>();
+    AsyncSystem asyncSystem(mockTaskProcessor);
+
+    for (const std::vector<int>& ints :
+         {std::vector<int>{0x01, 0x02, 0x03, 0x04}, std::vector<int>{0x1F}}) {
+      const std::vector<std::byte> data = asBytes(ints);
+      GunzipAssetAccessor accessor(
+          std::make_shared<StreamingAssetAccessor>(createRequest(data), 1));
+
+      std::vector<std::byte> received;
+      std::shared_ptr<IAssetRequest> pCompletedRequest =
+          accessor
+              .getStreaming(
+                  asyncSystem,
+                  "https://example.com",
+                  {},
+                  [&received](const gsl::span<const std::byte>& piece) {
+                    received.insert(received.end(), piece.begin(), piece.end());
+                  })
+              .wait();
+      CHECK(received == data);
+      CHECK(pCompletedRequest->response()->data().size() == data.size());
+    }
+  }
 }
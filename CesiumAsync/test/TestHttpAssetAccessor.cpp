@@ -0,0 +1,163 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/HttpAssetAccessor.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "MockTaskProcessor.h"
+
+#include <CesiumUtility/Gunzip.h>
+#include <catch2/catch.hpp>
+#include <httplib.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+std::string toString(const gsl::span<const std::byte>& data) {
+  return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+class TestServer {
+public:
+  TestServer() : server(), port(0), thread(), mutex(), remotePorts() {
+    this->server.Get(
+        "/hello",
+        [this](const httplib::Request& request, httplib::Response& response) {
+          this->addRemotePort(request);
+          response.set_content("hello", "text/plain");
+        });
+
+    this->server.Get(
+        "/gzip",
+        [this](const httplib::Request& request, httplib::Response& response) {
+          this->addRemotePort(request);
+          const std::string content = "gzipped hello";
+          if (request.get_header_value("Accept-Encoding") != "gzip") {
+            response.set_content(content, "text/plain");
+            return;
+          }
+
+          std::vector<std::byte> gzipped;
+          CesiumUtility::gzip(
+              gsl::span<const std::byte>(
+                  reinterpret_cast<const std::byte*>(content.data()),
+                  content.size()),
+              gzipped);
+          response.set_header("Content-Encoding", "gzip");
+          response.set_content(toString(gzipped), "text/plain");
+        });
+
+    this->port = this->server.bind_to_any_port("127.0.0.1");
+    this->thread = std::thread([this]() { this->server.listen_after_bind(); });
+    while (!this->server.is_running()) {
+      std::this_thread::yield();
+    }
+  }
+
+  ~TestServer() {
+    this->server.stop();
+    this->thread.join();
+  }
+
+  std::string url(const std::string& path) const {
+    return "http://127.0.0.1:" + std::to_string(this->port) + path;
+  }
+
+  size_t getConnectionCount() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->remotePorts.size();
+  }
+
+private:
+  void addRemotePort(const httplib::Request& request) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->remotePorts.insert(request.remote_port);
+  }
+
+  httplib::Server server;
+  int port;
+  std::thread thread;
+  std::mutex mutex;
+  std::set<int> remotePorts;
+};
+
+} // namespace
+
+TEST_CASE("HttpAssetAccessor") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  TestServer server;
+
+  SECTION("gets an asset") {
+    HttpAssetAccessor accessor;
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, server.url("/hello"), {}).wait();
+    REQUIRE(pRequest);
+    CHECK(pRequest->method() == "GET");
+    CHECK(pRequest->url() == server.url("/hello"));
+
+    const IAssetResponse* pResponse = pRequest->response();
+    REQUIRE(pResponse);
+    CHECK(pResponse->statusCode() == 200);
+    CHECK(pResponse->contentType() == "text/plain");
+    CHECK(toString(pResponse->data()) == "hello");
+  }
+
+  SECTION("reuses connections to a host") {
+    HttpAssetAccessorOptions options;
+    options.maximumConnectionsPerHost = 1;
+    HttpAssetAccessor accessor(options);
+
+    std::vector<Future<std::shared_ptr<IAssetRequest>>> futures;
+    for (int i = 0; i < 5; ++i) {
+      futures.emplace_back(
+          accessor.get(asyncSystem, server.url("/hello"), {}));
+    }
+    for (Future<std::shared_ptr<IAssetRequest>>& future : futures) {
+      std::shared_ptr<IAssetRequest> pRequest = future.wait();
+      REQUIRE(pRequest);
+      CHECK(toString(pRequest->response()->data()) == "hello");
+    }
+
+    CHECK(server.getConnectionCount() == 1);
+  }
+
+  SECTION("limits the connections to a host") {
+    HttpAssetAccessorOptions options;
+    options.maximumConnectionsPerHost = 2;
+    HttpAssetAccessor accessor(options);
+
+    std::vector<Future<std::shared_ptr<IAssetRequest>>> futures;
+    for (int i = 0; i < 20; ++i) {
+      futures.emplace_back(
+          accessor.get(asyncSystem, server.url("/hello"), {}));
+    }
+    for (Future<std::shared_ptr<IAssetRequest>>& future : futures) {
+      REQUIRE(future.wait());
+    }
+
+    CHECK(server.getConnectionCount() <= 2);
+  }
+
+  SECTION("unzips gzipped responses") {
+    HttpAssetAccessor accessor;
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, server.url("/gzip"), {}).wait();
+    REQUIRE(pRequest);
+
+    const IAssetResponse* pResponse = pRequest->response();
+    REQUIRE(pResponse);
+    CHECK(toString(pResponse->data()) == "gzipped hello");
+    CHECK(pResponse->headers().count("Content-Encoding") == 0);
+  }
+
+  SECTION("rejects unsupported URLs") {
+    HttpAssetAccessor accessor;
+    CHECK_THROWS(accessor.get(asyncSystem, "file:///hello", {}).wait());
+  }
+}
@@ -0,0 +1,121 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/LocalFileAssetAccessor.h"
+#include "MockTaskProcessor.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+void writeFile(const std::string& path, const std::string& contents) {
+  std::FILE* pFile = std::fopen(path.c_str(), "wb");
+  REQUIRE(pFile);
+  std::fwrite(contents.data(), 1, contents.size(), pFile);
+  std::fclose(pFile);
+}
+
+std::string toUrl(const std::string& path) {
+  std::string generic =
+      std::filesystem::absolute(path).lexically_normal().generic_string();
+  if (generic.front() != '/') {
+    // Windows paths start with a drive letter.
+    generic = "/" + generic;
+  }
+  return "file://" + generic;
+}
+
+std::string toString(const gsl::span<const std::byte>& data) {
+  return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+} // namespace
+
+TEST_CASE("LocalFileAssetAccessor") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  LocalFileAssetAccessorOptions options;
+  options.minimumMappedFileSize = 100;
+  LocalFileAssetAccessor accessor(options);
+
+  const std::string small = "small";
+  const std::string large(1000, 'l');
+  writeFile("test-small.b3dm", small);
+  writeFile("test-large.b3dm", large);
+  writeFile("test-empty.b3dm", "");
+
+  SECTION("reads small files and maps large ones") {
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, toUrl("test-small.b3dm"), {}).wait();
+    REQUIRE(pRequest->response());
+    CHECK(pRequest->response()->statusCode() == 200);
+    CHECK(toString(pRequest->response()->data()) == small);
+    CHECK(toString(pRequest->takeResponseData()) == small);
+
+    pRequest = accessor.get(asyncSystem, toUrl("test-large.b3dm"), {}).wait();
+    CHECK(pRequest->response()->statusCode() == 200);
+    CHECK(toString(pRequest->response()->data()) == large);
+
+    // The mapped data is copied when it is taken, so it stays readable.
+    CHECK(toString(pRequest->takeResponseData()) == large);
+    CHECK(toString(pRequest->response()->data()) == large);
+
+    pRequest = accessor.get(asyncSystem, toUrl("test-empty.b3dm"), {}).wait();
+    CHECK(pRequest->response()->statusCode() == 200);
+    CHECK(pRequest->response()->data().empty());
+  }
+
+  SECTION("decodes the URL and ignores its query") {
+    writeFile("test file.b3dm", small);
+    const std::string url = toUrl("test file.b3dm");
+    std::string encoded = url;
+    encoded.replace(encoded.find(' '), 1, "%20");
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, encoded + "?v=1", {}).wait();
+    CHECK(pRequest->url() == encoded + "?v=1");
+    CHECK(toString(pRequest->response()->data()) == small);
+    std::remove("test file.b3dm");
+  }
+
+  SECTION("responds with 404 for missing files and other URLs") {
+    CHECK(
+        accessor.get(asyncSystem, toUrl("test-missing.b3dm"), {})
+            .wait()
+            ->response()
+            ->statusCode() == 404);
+    CHECK(
+        accessor.get(asyncSystem, toUrl("."), {})
+            .wait()
+            ->response()
+            ->statusCode() == 404);
+    CHECK(
+        accessor.get(asyncSystem, "https://a.com/tile.b3dm", {})
+            .wait()
+            ->response()
+            ->statusCode() == 404);
+  }
+
+  SECTION("answers HEAD requests without data and rejects other verbs") {
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.request(asyncSystem, "HEAD", toUrl("test-large.b3dm"), {}, {})
+            .wait();
+    CHECK(pRequest->method() == "HEAD");
+    CHECK(pRequest->response()->statusCode() == 200);
+    CHECK(pRequest->response()->data().empty());
+
+    pRequest =
+        accessor.request(asyncSystem, "PUT", toUrl("test-large.b3dm"), {}, {})
+            .wait();
+    CHECK(pRequest->response()->statusCode() == 405);
+  }
+
+  std::remove("test-small.b3dm");
+  std::remove("test-large.b3dm");
+  std::remove("test-empty.b3dm");
+}
@@ -0,0 +1,168 @@
+#include "CesiumAsync/MemoryCacheDatabase.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+class MockCacheDatabase : public ICacheDatabase {
+public:
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override {
+    ++this->getEntryCalls;
+    auto it = this->items.find(key);
+    if (it == this->items.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    if (!this->storeSucceeds) {
+      return false;
+    }
+    this->items.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(
+                HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  virtual bool prune() override {
+    ++this->pruneCalls;
+    return true;
+  }
+
+  virtual bool clearAll() override {
+    this->items.clear();
+    return true;
+  }
+
+  std::map<std::string, CacheItem> items;
+  mutable int32_t getEntryCalls = 0;
+  int32_t pruneCalls = 0;
+  bool storeSucceeds = true;
+};
+
+bool store(
+    ICacheDatabase& database,
+    const std::string& key,
+    size_t dataSize,
+    std::time_t expiryTime = std::time(nullptr) + 1000) {
+  return database.storeEntry(
+      key,
+      expiryTime,
+      "test.com",
+      "GET",
+      HttpHeaders(),
+      200,
+      HttpHeaders{{"Content-Type", "text/html"}},
+      std::vector<std::byte>(dataSize, std::byte(1)));
+}
+
+} // namespace
+
+TEST_CASE("MemoryCacheDatabase") {
+  auto pDatabase = std::make_shared<MockCacheDatabase>();
+
+  SECTION("stores entries in memory and in the underlying database") {
+    MemoryCacheDatabase database(pDatabase);
+    REQUIRE(store(database, "key", 100));
+    CHECK(pDatabase->items.count("key") == 1);
+    CHECK(database.getCount() == 1);
+
+    std::optional<CacheItem> cacheItem = database.getEntry("key");
+    REQUIRE(cacheItem);
+    CHECK(cacheItem->cacheResponse.data.size() == 100);
+    CHECK(cacheItem->cacheResponse.headers.at("Content-Type") == "text/html");
+    CHECK(pDatabase->getEntryCalls == 0);
+  }
+
+  SECTION("keeps the entries found in the underlying database") {
+    MemoryCacheDatabase database(pDatabase);
+    REQUIRE(store(*pDatabase, "key", 100));
+
+    CHECK(database.getEntry("key"));
+    CHECK(database.getEntry("key"));
+    CHECK(pDatabase->getEntryCalls == 1);
+
+    CHECK(!database.getEntry("missing"));
+    CHECK(pDatabase->getEntryCalls == 2);
+  }
+
+  SECTION("evicts the least recently used entries when over budget") {
+    MemoryCacheDatabase measure(std::make_shared<MockCacheDatabase>());
+    REQUIRE(store(measure, "key0", 1000));
+    MemoryCacheDatabase database(pDatabase, 2 * measure.getByteSize());
+
+    REQUIRE(store(database, "key0", 1000));
+    REQUIRE(store(database, "key1", 1000));
+
+    // Use the first entry, so that the second is the least recently used.
+    CHECK(database.getEntry("key0"));
+
+    REQUIRE(store(database, "key2", 1000));
+    CHECK(database.getCount() == 2);
+    CHECK(database.getByteSize() == 2 * measure.getByteSize());
+
+    // The evicted entry is still in the underlying database.
+    CHECK(database.getEntry("key1"));
+    CHECK(pDatabase->getEntryCalls == 1);
+  }
+
+  SECTION("does not keep entries that failed to be stored") {
+    MemoryCacheDatabase database(pDatabase);
+    REQUIRE(store(database, "key", 100));
+
+    pDatabase->storeSucceeds = false;
+    CHECK(!store(database, "key", 200));
+    CHECK(database.getCount() == 0);
+  }
+
+  SECTION("evicts expired entries when pruned") {
+    MemoryCacheDatabase database(pDatabase);
+    REQUIRE(store(database, "expired", 100, std::time(nullptr) - 10));
+    REQUIRE(store(database, "fresh", 100));
+
+    CHECK(database.prune());
+    CHECK(pDatabase->pruneCalls == 1);
+    CHECK(database.getCount() == 1);
+  }
+
+  SECTION("clears the entries in memory and in the underlying database") {
+    MemoryCacheDatabase database(pDatabase);
+    REQUIRE(store(database, "key", 100));
+
+    CHECK(database.clearAll());
+    CHECK(database.getCount() == 0);
+    CHECK(database.getByteSize() == 0);
+    CHECK(pDatabase->items.empty());
+    CHECK(!database.getEntry("key"));
+  }
+}
@@ -0,0 +1,238 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/RetryingAssetAccessor.h"
+#include "MockAssetAccessor.h"
+#include "MockAssetRequest.h"
+#include "MockAssetResponse.h"
+#include "MockTaskProcessor.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+std::shared_ptr<IAssetRequest>
+createRequest(uint16_t statusCode, const HttpHeaders& headers = {}) {
+  return std::make_shared<MockAssetRequest>(
+      "GET",
+      "test.com",
+      HttpHeaders{},
+      std::make_unique<MockAssetResponse>(
+          statusCode,
+          "app/json",
+          headers,
+          std::vector<std::byte>(5)));
+}
+
+// Answers each request with the next of a list of responses. A response with
+// the status code 0 fails the request, and requests beyond the list wait
+// until they are completed by the test.
+class ScriptedAssetAccessor : public MockAssetAccessor {
+public:
+  ScriptedAssetAccessor(std::vector<uint16_t>&& statusCodes_)
+      : MockAssetAccessor(nullptr), statusCodes(std::move(statusCodes_)) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& /* headers */) override {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->urls.emplace_back(url);
+    if (this->next >= this->statusCodes.size()) {
+      this->waiting.emplace_back(
+          asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>());
+      return this->waiting.back().getFuture();
+    }
+
+    const uint16_t statusCode = this->statusCodes[this->next++];
+    lock.unlock();
+    if (statusCode == 0) {
+      return asyncSystem.createFuture<std::shared_ptr<IAssetRequest>>(
+          [](const auto& promise) {
+            promise.reject(std::runtime_error("Request failed"));
+          });
+    }
+    return asyncSystem.createResolvedFuture(createRequest(statusCode));
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& /* verb */,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& /* contentPayload */) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  void completeWaiting(uint16_t statusCode) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    Promise<std::shared_ptr<IAssetRequest>> promise =
+        std::move(this->waiting.front());
+    this->waiting.pop_front();
+    lock.unlock();
+    promise.resolve(createRequest(statusCode));
+  }
+
+  size_t getRequestCount() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->urls.size();
+  }
+
+  std::mutex mutex;
+  std::vector<uint16_t> statusCodes;
+  size_t next = 0;
+  std::vector<std::string> urls;
+  std::deque<Promise<std::shared_ptr<IAssetRequest>>> waiting;
+};
+
+RetryingAssetAccessorOptions createFastOptions() {
+  RetryingAssetAccessorOptions options;
+  options.initialRetryDelayMilliseconds = 1.0;
+  options.maximumRetryDelayMilliseconds = 10.0;
+  options.minimumHedgingDelayMilliseconds = 1.0;
+  return options;
+}
+
+} // namespace
+
+TEST_CASE("RetryingAssetAccessor") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+
+  SECTION("retries transient errors until a request succeeds") {
+    auto pMock = std::make_shared<ScriptedAssetAccessor>(
+        std::vector<uint16_t>{503, 0, 200});
+    RetryingAssetAccessor accessor(pMock, createFastOptions());
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, "http://a.com/tile.b3dm", {}).wait();
+    REQUIRE(pRequest);
+    REQUIRE(pRequest->response());
+    CHECK(pRequest->response()->statusCode() == 200);
+    CHECK(pMock->getRequestCount() == 3);
+
+    const RetryingAssetAccessorStatistics statistics =
+        accessor.getStatistics();
+    CHECK(statistics.retryCount == 2);
+    CHECK(statistics.exhaustedCount == 0);
+  }
+
+  SECTION("returns the last response once the retries are used up") {
+    auto pMock = std::make_shared<ScriptedAssetAccessor>(
+        std::vector<uint16_t>{503, 503, 503});
+    RetryingAssetAccessorOptions options = createFastOptions();
+    options.maximumRetries = 2;
+    RetryingAssetAccessor accessor(pMock, options);
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        accessor.get(asyncSystem, "http://a.com/tile.b3dm", {}).wait();
+    REQUIRE(pRequest);
+    CHECK(pRequest->response()->statusCode() == 503);
+    CHECK(pMock->getRequestCount() == 3);
+    CHECK(accessor.getStatistics().exhaustedCount == 1);
+  }
+
+  SECTION("rejects when the last attempt fails without a response") {
+    auto pMock =
+        std::make_shared<ScriptedAssetAccessor>(std::vector<uint16_t>{0, 0});
+    RetryingAssetAccessorOptions options = createFastOptions();
+    options.maximumRetries = 1;
+    RetryingAssetAccessor accessor(pMock, options);
+
+    CHECK_THROWS_AS(
+        accessor.get(asyncSystem, "http://a.com/tile.b3dm", {}).wait(),
+        std::runtime_error);
+    CHECK(pMock->getRequestCount() == 2);
+  }
+
+  SECTION("does not retry other errors or other verbs") {
+    auto pMock = std::make_shared<ScriptedAssetAccessor>(
+        std::vector<uint16_t>{404, 503});
+    RetryingAssetAccessor accessor(pMock, createFastOptions());
+
+    CHECK(
+        accessor.get(asyncSystem, "http://a.com/tile.b3dm", {})
+            .wait()
+            ->response()
+            ->statusCode() == 404);
+    CHECK(
+        accessor.request(asyncSystem, "POST", "http://a.com/tile.b3dm", {}, {})
+            .wait()
+            ->response()
+            ->statusCode() == 503);
+    CHECK(pMock->getRequestCount() == 2);
+    CHECK(accessor.getStatistics().retryCount == 0);
+  }
+
+  SECTION("hedges a request that is slower than the earlier ones") {
+    auto pMock = std::make_shared<ScriptedAssetAccessor>(
+        std::vector<uint16_t>{200});
+    RetryingAssetAccessorOptions options = createFastOptions();
+    options.enableHedging = true;
+    options.minimumHedgingSamples = 1;
+    RetryingAssetAccessor accessor(pMock, options);
+
+    // The first request completes right away, and has no latency to compare
+    // against, so it is not hedged.
+    accessor.get(asyncSystem, "http://a.com/fast.b3dm", {}).wait();
+    CHECK(accessor.getStatistics().hedgedRequestCount == 0);
+
+    // The second one never completes by itself, so the hedged duplicate
+    // supplies the response.
+    Future<std::shared_ptr<IAssetRequest>> future =
+        accessor.get(asyncSystem, "http://a.com/slow.b3dm", {});
+    while (pMock->getRequestCount() < 3) {
+      std::this_thread::yield();
+    }
+    pMock->completeWaiting(503);
+    CHECK(!future.isReady());
+    pMock->completeWaiting(200);
+
+    std::shared_ptr<IAssetRequest> pRequest = future.wait();
+    CHECK(pRequest->response()->statusCode() == 200);
+    CHECK(pMock->urls[2] == "http://a.com/slow.b3dm");
+
+    const RetryingAssetAccessorStatistics statistics =
+        accessor.getStatistics();
+    CHECK(statistics.hedgedRequestCount == 1);
+    CHECK(statistics.hedgeWinCount == 1);
+    CHECK(statistics.retryCount == 0);
+  }
+
+  SECTION("limits the requests in flight to each host") {
+    auto pMock = std::make_shared<ScriptedAssetAccessor>(
+        std::vector<uint16_t>{});
+    RetryingAssetAccessorOptions options = createFastOptions();
+    options.maximumRequestsPerHost = 1;
+    RetryingAssetAccessor accessor(pMock, options);
+
+    Future<std::shared_ptr<IAssetRequest>> first =
+        accessor.get(asyncSystem, "http://a.com/1.b3dm", {});
+    Future<std::shared_ptr<IAssetRequest>> second =
+        accessor.get(asyncSystem, "http://a.com/2.b3dm", {});
+    Future<std::shared_ptr<IAssetRequest>> other =
+        accessor.get(asyncSystem, "http://b.com/1.b3dm", {});
+    CHECK(
+        pMock->urls ==
+        std::vector<std::string>{"http://a.com/1.b3dm", "http://b.com/1.b3dm"});
+
+    // The second request is sent once the first one has completed.
+    pMock->completeWaiting(200);
+    CHECK(first.wait()->response()->statusCode() == 200);
+    REQUIRE(pMock->urls.size() == 3);
+    CHECK(pMock->urls[2] == "http://a.com/2.b3dm");
+
+    pMock->completeWaiting(200);
+    pMock->completeWaiting(200);
+    CHECK(other.wait()->response()->statusCode() == 200);
+    CHECK(second.wait()->response()->statusCode() == 200);
+  }
+}
@@ -0,0 +1,145 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/TelemetryAssetAccessor.h"
+#include "MockAssetAccessor.h"
+#include "MockAssetRequest.h"
+#include "MockAssetResponse.h"
+#include "MockTaskProcessor.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+class StreamingAssetAccessor : public MockAssetAccessor {
+public:
+  StreamingAssetAccessor(const std::shared_ptr<IAssetRequest>& request)
+      : MockAssetAccessor(request), fail(false) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>> getStreaming(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const DataReceivedCallback& onDataReceived) override {
+    if (this->fail) {
+      return asyncSystem.createFuture<std::shared_ptr<IAssetRequest>>(
+          [](const auto& promise) {
+            promise.reject(std::runtime_error("Request failed"));
+          });
+    }
+
+    onDataReceived(this->testRequest->response()->data());
+    return this->get(asyncSystem, url, headers);
+  }
+
+  bool fail;
+};
+
+std::shared_ptr<IAssetRequest> createRequest(uint16_t statusCode) {
+  return std::make_shared<MockAssetRequest>(
+      "GET",
+      "test.com",
+      HttpHeaders{},
+      std::make_unique<MockAssetResponse>(
+          statusCode,
+          "app/json",
+          HttpHeaders{},
+          std::vector<std::byte>(5)));
+}
+
+} // namespace
+
+TEST_CASE("TelemetryAssetAccessor") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+
+  SECTION("records the requests to each host") {
+    TelemetryAssetAccessor accessor(
+        std::make_shared<MockAssetAccessor>(createRequest(200)));
+    accessor.get(asyncSystem, "http://a.com/tile.b3dm", {}).wait();
+    accessor.get(asyncSystem, "http://a.com/other/tile.b3dm?v=1", {}).wait();
+    accessor
+        .get(
+            asyncSystem,
+            "https://user@b.com:8080/tile.b3dm",
+            {{"If-None-Match", "deadbeef"}})
+        .wait();
+
+    std::map<std::string, HostTelemetry> snapshot = accessor.getSnapshot();
+    REQUIRE(snapshot.size() == 2);
+
+    const HostTelemetry& a = snapshot["a.com"];
+    CHECK(a.requestCount == 2);
+    CHECK(a.failedRequestCount == 0);
+    CHECK(a.revalidationCount == 0);
+    CHECK(a.receivedBytes == 10);
+    CHECK(a.latency.sampleCount == 2);
+    CHECK(a.timeToFirstByte.sampleCount == 0);
+
+    const HostTelemetry& b = snapshot["b.com:8080"];
+    CHECK(b.requestCount == 1);
+    CHECK(b.revalidationCount == 1);
+
+    accessor.reset();
+    CHECK(accessor.getSnapshot().empty());
+  }
+
+  SECTION("records the time to the first byte of streamed responses") {
+    TelemetryAssetAccessor accessor(
+        std::make_shared<StreamingAssetAccessor>(createRequest(200)));
+
+    size_t receivedSize = 0;
+    accessor
+        .getStreaming(
+            asyncSystem,
+            "http://a.com/tile.b3dm",
+            {},
+            [&receivedSize](const gsl::span<const std::byte>& data) {
+              receivedSize += data.size();
+            })
+        .wait();
+    CHECK(receivedSize == 5);
+
+    const HostTelemetry a = accessor.getSnapshot()["a.com"];
+    CHECK(a.timeToFirstByte.sampleCount == 1);
+    CHECK(a.latency.sampleCount == 1);
+  }
+
+  SECTION("records failed requests and error responses") {
+    std::shared_ptr<StreamingAssetAccessor> pAssetAccessor =
+        std::make_shared<StreamingAssetAccessor>(createRequest(404));
+    TelemetryAssetAccessor accessor(pAssetAccessor);
+    accessor.get(asyncSystem, "http://a.com/missing.b3dm", {}).wait();
+
+    pAssetAccessor->fail = true;
+    CHECK_THROWS(
+        accessor.get(asyncSystem, "http://a.com/tile.b3dm", {}).wait());
+
+    const HostTelemetry a = accessor.getSnapshot()["a.com"];
+    CHECK(a.requestCount == 2);
+    CHECK(a.errorResponseCount == 1);
+    CHECK(a.failedRequestCount == 1);
+    CHECK(a.latency.sampleCount == 1);
+  }
+}
+
+TEST_CASE("LatencyHistogram") {
+  LatencyHistogram histogram;
+  CHECK(histogram.getMeanMilliseconds() == 0.0);
+  CHECK(histogram.getPercentileMilliseconds(50.0) == 0.0);
+
+  for (double milliseconds : {1.0, 3.0, 7.0, 20.0, 30000.0}) {
+    histogram.add(milliseconds);
+  }
+
+  CHECK(histogram.sampleCount == 5);
+  CHECK(histogram.counts[0] == 2);
+  CHECK(histogram.counts.back() == 1);
+  CHECK(histogram.getMeanMilliseconds() == Approx(6006.2));
+  CHECK(histogram.getPercentileMilliseconds(50.0) == 10.0);
+  CHECK(histogram.getPercentileMilliseconds(100.0) == 30000.0);
+}
@@ -0,0 +1,216 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/WorkStealingTaskProcessor.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace CesiumAsync;
+
+namespace {
+// The name of the calling thread, where the tests know how to get it.
+std::string getCurrentThreadName() {
+#ifdef __linux__
+  char name[16] = {};
+  pthread_getname_np(pthread_self(), name, sizeof(name));
+  return name;
+#else
+  return std::string();
+#endif
+}
+
+#ifdef __linux__
+bool isOnlyOnFirstCpu() {
+  cpu_set_t set;
+  sched_getaffinity(0, sizeof(set), &set);
+  return CPU_COUNT(&set) == 1 && CPU_ISSET(0, &set);
+}
+#endif
+} // namespace
+
+TEST_CASE("WorkStealingTaskProcessor") {
+  SECTION("starts at least one thread") {
+    WorkStealingTaskProcessor taskProcessor(0);
+    CHECK(taskProcessor.getThreadCount() == 1);
+  }
+
+  SECTION("runs all tasks before it is destroyed") {
+    std::atomic<int32_t> tasksRun = 0;
+    {
+      WorkStealingTaskProcessor taskProcessor(4);
+      for (int32_t i = 0; i < 1000; ++i) {
+        taskProcessor.startTask([&tasksRun]() { ++tasksRun; });
+      }
+    }
+
+    CHECK(tasksRun == 1000);
+  }
+
+  SECTION("runs tasks that are started by its own tasks") {
+    std::atomic<int32_t> tasksRun = 0;
+    {
+      WorkStealingTaskProcessor taskProcessor(4);
+      for (int32_t i = 0; i < 10; ++i) {
+        taskProcessor.startTask([&taskProcessor, &tasksRun]() {
+          for (int32_t j = 0; j < 100; ++j) {
+            taskProcessor.startTask([&tasksRun]() { ++tasksRun; });
+          }
+          ++tasksRun;
+        });
+      }
+    }
+
+    CHECK(tasksRun == 1010);
+  }
+
+  SECTION("other threads take the tasks of a busy thread") {
+    WorkStealingTaskProcessor taskProcessor(2);
+
+    // Both tasks go into the queue of the thread that runs the first one,
+    // which then waits for the second one to run.
+    std::atomic<bool> secondTaskRun = false;
+    std::atomic<bool> firstTaskDone = false;
+    taskProcessor.startTask([&]() {
+      taskProcessor.startTask([&secondTaskRun]() { secondTaskRun = true; });
+      while (!secondTaskRun) {
+        std::this_thread::yield();
+      }
+      firstTaskDone = true;
+    });
+
+    while (!firstTaskDone) {
+      std::this_thread::yield();
+    }
+    CHECK(secondTaskRun);
+  }
+
+  SECTION("runs the most important prioritized tasks first") {
+    std::vector<int32_t> order;
+    {
+      WorkStealingTaskProcessor taskProcessor(1);
+
+      // Keep the only thread busy until all the tasks are started.
+      std::atomic<bool> blocking = false;
+      std::atomic<bool> released = false;
+      taskProcessor.startTask([&]() {
+        blocking = true;
+        while (!released) {
+          std::this_thread::yield();
+        }
+      });
+      while (!blocking) {
+        std::this_thread::yield();
+      }
+
+      taskProcessor.startTask([&order]() { order.push_back(0); });
+      taskProcessor.startTaskWithPriority(
+          [&order]() { order.push_back(1); },
+          TaskPriority{0, 1.0});
+      taskProcessor.startTaskWithPriority(
+          [&order]() { order.push_back(2); },
+          TaskPriority{1, 5.0});
+      taskProcessor.startTaskWithPriority(
+          [&order]() { order.push_back(3); },
+          TaskPriority{0, 0.5});
+      taskProcessor.startTaskWithPriority(
+          [&order]() { order.push_back(4); },
+          TaskPriority{1, 5.0});
+
+      released = true;
+    }
+
+    CHECK(order == std::vector<int32_t>{2, 4, 3, 1, 0});
+  }
+
+  SECTION("runs the prioritized worker thread tasks of an AsyncSystem") {
+    auto pTaskProcessor = std::make_shared<WorkStealingTaskProcessor>(1);
+    AsyncSystem asyncSystem(pTaskProcessor);
+
+    std::atomic<bool> blocking = false;
+    std::atomic<bool> released = false;
+    Future<void> blocker = asyncSystem.runInWorkerThread([&]() {
+      blocking = true;
+      while (!released) {
+        std::this_thread::yield();
+      }
+    });
+    while (!blocking) {
+      std::this_thread::yield();
+    }
+
+    std::vector<int32_t> order;
+    Future<void> low = asyncSystem.runInWorkerThread(
+        [&order]() { order.push_back(0); },
+        TaskPriority{0, 0.0});
+    Future<void> high =
+        asyncSystem.createResolvedFuture(1).thenInWorkerThread(
+            [&order](int32_t value) { order.push_back(value); },
+            TaskPriority{2, 0.0});
+
+    released = true;
+    blocker.wait();
+    low.wait();
+    high.wait();
+
+    CHECK(order == std::vector<int32_t>{1, 0});
+  }
+
+  SECTION("runs the worker thread continuations of an AsyncSystem") {
+    auto pTaskProcessor = std::make_shared<WorkStealingTaskProcessor>(4);
+    AsyncSystem asyncSystem(pTaskProcessor);
+
+    std::vector<Future<int32_t>> futures;
+    for (int32_t i = 0; i < 100; ++i) {
+      futures.emplace_back(
+          asyncSystem.runInWorkerThread([i]() { return i; })
+              .thenInWorkerThread([](int32_t value) { return value * 2; }));
+    }
+
+    std::vector<int32_t> results = asyncSystem.all(std::move(futures)).wait();
+    REQUIRE(results.size() == 100);
+    for (int32_t i = 0; i < 100; ++i) {
+      CHECK(results[size_t(i)] == i * 2);
+    }
+  }
+
+  SECTION("applies the thread options to its threads and thread pools") {
+    ThreadPoolOptions options;
+    options.threadName = "Decode";
+    options.qualityOfService = ThreadQualityOfService::Background;
+    options.cpuAffinity = {0};
+
+    auto pTaskProcessor =
+        std::make_shared<WorkStealingTaskProcessor>(1, options);
+    AsyncSystem asyncSystem(pTaskProcessor);
+
+    options.threadName = "Pool";
+    ThreadPool threadPool = asyncSystem.createThreadPool(1, options);
+
+    std::string workerName =
+        asyncSystem.runInWorkerThread([]() { return getCurrentThreadName(); })
+            .wait();
+    std::string poolName =
+        asyncSystem
+            .runInThreadPool(
+                threadPool,
+                []() { return getCurrentThreadName(); })
+            .wait();
+
+#ifdef __linux__
+    CHECK(workerName == "Decode 0");
+    CHECK(poolName == "Pool 0");
+
+    CHECK(asyncSystem.runInWorkerThread([]() { return isOnlyOnFirstCpu(); })
+              .wait());
+#endif
+  }
+}
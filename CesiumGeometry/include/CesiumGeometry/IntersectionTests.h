@@ -10,6 +10,9 @@
 namespace CesiumGeometry {
 class Ray;
 class Plane;
+struct AxisAlignedBox;
+class BoundingSphere;
+class OrientedBoundingBox;
 
 /**
  * @brief Functions for computing the intersection between geometries such as
@@ -28,6 +31,66 @@ public:
   static std::optional<glm::dvec3>
   rayPlane(const Ray& ray, const Plane& plane) noexcept;
 
+  /**
+   * @brief Computes the intersection of a ray and a triangle, as the distance
+   * along the ray to the point of intersection.
+   *
+   * @param ray The ray.
+   * @param p0 The first vertex of the triangle.
+   * @param p1 The second vertex of the triangle.
+   * @param p2 The third vertex of the triangle.
+   * @param cullBackFaces Whether to ignore the intersection if the ray hits
+   * the back of the triangle, the side from which its vertices are in
+   * clockwise order.
+   * @return The distance along the ray to the point of intersection, or
+   * `std::nullopt` if there is no intersection.
+   */
+  static std::optional<double> rayTriangleParametric(
+      const Ray& ray,
+      const glm::dvec3& p0,
+      const glm::dvec3& p1,
+      const glm::dvec3& p2,
+      bool cullBackFaces = false) noexcept;
+
+  /**
+   * @brief Computes the intersection of a ray and an axis-aligned box, as the
+   * distance along the ray to the point where it enters the box.
+   *
+   * @param ray The ray.
+   * @param box The box.
+   * @return The distance along the ray to the point where it enters the box,
+   * which is 0.0 if the origin of the ray is in the box, or `std::nullopt` if
+   * there is no intersection.
+   */
+  static std::optional<double>
+  rayAABBParametric(const Ray& ray, const AxisAlignedBox& box) noexcept;
+
+  /**
+   * @brief Computes the intersection of a ray and an oriented box, as the
+   * distance along the ray to the point where it enters the box.
+   *
+   * @param ray The ray.
+   * @param box The box.
+   * @return The distance along the ray to the point where it enters the box,
+   * which is 0.0 if the origin of the ray is in the box, or `std::nullopt` if
+   * there is no intersection.
+   */
+  static std::optional<double>
+  rayOBBParametric(const Ray& ray, const OrientedBoundingBox& box) noexcept;
+
+  /**
+   * @brief Computes the intersection of a ray and a sphere, as the distance
+   * along the ray to the point where it enters the sphere.
+   *
+   * @param ray The ray.
+   * @param sphere The sphere.
+   * @return The distance along the ray to the point where it enters the
+   * sphere, which is 0.0 if the origin of the ray is in the sphere, or
+   * `std::nullopt` if there is no intersection.
+   */
+  static std::optional<double>
+  raySphereParametric(const Ray& ray, const BoundingSphere& sphere) noexcept;
+
   /**
    * @brief Determines whether the point is completely inside the triangle.
    *
@@ -2,7 +2,10 @@
 
 #include "Library.h"
 
+#include <CesiumUtility/Hash.h>
+
 #include <cstdint>
+#include <functional>
 
 namespace CesiumGeometry {
 
@@ -74,3 +77,22 @@ struct CESIUMGEOMETRY_API OctreeTileID {
 };
 
 } // namespace CesiumGeometry
+
+namespace std {
+
+/**
+ * @brief A hash function for {@link CesiumGeometry::OctreeTileID} objects.
+ */
+template <> struct hash<CesiumGeometry::OctreeTileID> {
+
+  /**
+   * @brief A specialization of the `std::hash` template for
+   * {@link CesiumGeometry::OctreeTileID} objects.
+   */
+  size_t operator()(const CesiumGeometry::OctreeTileID& key) const noexcept {
+    return CesiumUtility::Hash::combine(
+        (uint64_t(key.x) << 32) | key.y,
+        (uint64_t(key.z) << 32) | key.level);
+  }
+};
+} // namespace std
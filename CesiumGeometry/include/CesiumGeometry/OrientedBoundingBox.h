@@ -7,6 +7,7 @@
 
 #include <glm/mat3x3.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 namespace CesiumGeometry {
 
@@ -140,6 +141,24 @@ public:
    */
   static OrientedBoundingBox fromSphere(const BoundingSphere& sphere) noexcept;
 
+  /**
+   * @brief Creates a tight oriented bounding box that contains the given
+   * positions.
+   *
+   * The axes of the box are the principal components of the positions, so it
+   * fits elongated or rotated sets of positions much more tightly than an
+   * axis-aligned box does. So that the box can be inverted even when the
+   * positions are coplanar or collinear, each of its half-axes is at least
+   * {@link CesiumUtility::Math::Epsilon7} times the longest one, and at least
+   * that many units, long.
+   *
+   * @param positions The positions. If there are none, the box is a tiny one
+   * at the origin.
+   * @return The bounding box.
+   */
+  static OrientedBoundingBox
+  fromPositions(const gsl::span<const glm::dvec3>& positions) noexcept;
+
 private:
   glm::dvec3 _center;
   glm::dmat3 _halfAxes;
@@ -7,7 +7,6 @@
 
 #include <glm/vec2.hpp>
 
-#include <memory>
 #include <vector>
 
 namespace CesiumGeometry {
@@ -64,58 +63,39 @@ public:
    */
   uint8_t isTileAvailable(const QuadtreeTileID& id) const noexcept;
 
-private:
-  struct RectangleWithLevel {
-    uint32_t level;
-    Rectangle rectangle;
-  };
-
-  struct QuadtreeNode {
-    QuadtreeNode(
-        const QuadtreeTileID& id_,
-        const Rectangle& extent_,
-        QuadtreeNode* pParent_) noexcept
-        : id(id_),
-          extent(extent_),
-          pParent(pParent_),
-          ll(),
-          lr(),
-          ul(),
-          ur(),
-          rectangles() {}
-
-    QuadtreeTileID id;
+  /**
+   * @brief Computes the number of bytes allocated for the available tile
+   * ranges.
+   */
+  int64_t computeByteSize() const;
 
-    CesiumGeometry::Rectangle extent;
+private:
+  /**
+   * @brief The rectangles of the available tile ranges at one level.
+   *
+   * Most of the rectangles are sorted by their minimum X coordinate, with the
+   * largest maximum X coordinate of the rectangles up to each one, so that
+   * the rectangles that may contain a position are found with a binary search
+   * and a short scan. New rectangles are added to a short unsorted list,
+   * which is merged into the sorted one when it grows too long.
+   */
+  struct LevelRectangles {
+    std::vector<Rectangle> sorted;
+    std::vector<double> runningMaximumX;
+    std::vector<Rectangle> unsorted;
+    Rectangle bounds{0.0, 0.0, 0.0, 0.0};
 
-    QuadtreeNode* pParent;
-    std::unique_ptr<QuadtreeNode> ll;
-    std::unique_ptr<QuadtreeNode> lr;
-    std::unique_ptr<QuadtreeNode> ul;
-    std::unique_ptr<QuadtreeNode> ur;
+    void add(const Rectangle& rectangle);
+    bool contains(const glm::dvec2& position) const noexcept;
 
-    std::vector<RectangleWithLevel> rectangles;
+  private:
+    void mergeUnsorted();
   };
 
   QuadtreeTilingScheme _tilingScheme;
   uint32_t _maximumLevel;
-  std::vector<std::unique_ptr<QuadtreeNode>> _rootNodes;
 
-  static void putRectangleInQuadtree(
-      const QuadtreeTilingScheme& tilingScheme,
-      uint32_t maximumLevel,
-      QuadtreeRectangleAvailability::QuadtreeNode& node,
-      const QuadtreeRectangleAvailability::RectangleWithLevel&
-          rectangle) noexcept;
-  static bool rectangleLevelComparator(
-      const QuadtreeRectangleAvailability::RectangleWithLevel& a,
-      const QuadtreeRectangleAvailability::RectangleWithLevel& b) noexcept;
-  static uint32_t findMaxLevelFromNode(
-      QuadtreeNode* pStopNode,
-      QuadtreeNode& node,
-      const glm::dvec2& position) noexcept;
-  static void createNodeChildrenIfNecessary(
-      QuadtreeNode& node,
-      const QuadtreeTilingScheme& tilingScheme) noexcept;
+  // The rectangles of each level, indexed by level.
+  std::vector<LevelRectangles> _levels;
 };
 } // namespace CesiumGeometry
@@ -2,6 +2,8 @@
 
 #include "Library.h"
 
+#include <CesiumUtility/Hash.h>
+
 #include <cstdint>
 #include <functional>
 
@@ -97,6 +99,20 @@ struct CESIUMGEOMETRY_API UpsampledQuadtreeNode final {
    * @brief The {@link QuadtreeTileID} for this tree node.
    */
   QuadtreeTileID tileID;
+
+  /**
+   * @brief Returns `true` if two nodes are equal.
+   */
+  constexpr bool operator==(const UpsampledQuadtreeNode& other) const noexcept {
+    return this->tileID == other.tileID;
+  }
+
+  /**
+   * @brief Returns `true` if two nodes are *not* equal.
+   */
+  constexpr bool operator!=(const UpsampledQuadtreeNode& other) const noexcept {
+    return !(*this == other);
+  }
 };
 } // namespace CesiumGeometry
 
@@ -112,9 +128,25 @@ template <> struct hash<CesiumGeometry::QuadtreeTileID> {
    * {@link CesiumGeometry::QuadtreeTileID} objects.
    */
   size_t operator()(const CesiumGeometry::QuadtreeTileID& key) const noexcept {
-    // TODO: is this hash function any good? Probably not.
-    std::hash<uint32_t> h;
-    return h(key.level) ^ (h(key.x) << 1) ^ (h(key.y) << 2);
+    return CesiumUtility::Hash::combine(
+        (uint64_t(key.x) << 32) | key.y,
+        key.level);
+  }
+};
+
+/**
+ * @brief A hash function for {@link CesiumGeometry::UpsampledQuadtreeNode}
+ * objects.
+ */
+template <> struct hash<CesiumGeometry::UpsampledQuadtreeNode> {
+
+  /**
+   * @brief A specialization of the `std::hash` template for
+   * {@link CesiumGeometry::UpsampledQuadtreeNode} objects.
+   */
+  size_t operator()(
+      const CesiumGeometry::UpsampledQuadtreeNode& key) const noexcept {
+    return std::hash<CesiumGeometry::QuadtreeTileID>{}(key.tileID);
   }
 };
 } // namespace std
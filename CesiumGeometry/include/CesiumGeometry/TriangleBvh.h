@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Library.h"
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace CesiumGeometry {
+
+class Ray;
+
+/**
+ * @brief The intersection of a ray with a triangle of a {@link TriangleBvh}.
+ */
+struct CESIUMGEOMETRY_API TriangleBvhIntersection {
+  /**
+   * @brief The distance along the ray to the point of intersection.
+   */
+  double t = 0.0;
+
+  /**
+   * @brief The index of the triangle that the ray intersects, in the order of
+   * the triangles given to the {@link TriangleBvh}.
+   */
+  uint32_t triangleIndex = 0;
+};
+
+/**
+ * @brief A bounding volume hierarchy of triangles, for finding the
+ * intersections of rays with them without testing each triangle.
+ *
+ * The hierarchy is a binary tree of axis-aligned boxes. Each box is split at
+ * the median of the centers of its triangles along its longest axis, until
+ * there are only a few triangles in it. The hierarchy keeps a copy of the
+ * vertex positions, so it does not depend on the mesh that it was built from.
+ */
+class CESIUMGEOMETRY_API TriangleBvh final {
+public:
+  /**
+   * @brief Constructs an empty hierarchy, which no ray intersects.
+   */
+  TriangleBvh() noexcept = default;
+
+  /**
+   * @brief Builds the hierarchy of the given triangles.
+   *
+   * @param positions The positions of the vertices of the triangles.
+   * @param triangles The indices of the three vertices of each triangle, in
+   * the `positions`. Triangles with an index that is not in range are
+   * ignored.
+   */
+  TriangleBvh(
+      std::vector<glm::vec3>&& positions,
+      const std::vector<uint32_t>& triangles);
+
+  /**
+   * @brief Finds the closest intersection of a ray with the triangles.
+   *
+   * The ray must be in the same coordinate system as the positions.
+   *
+   * @param ray The ray.
+   * @param cullBackFaces Whether to ignore triangles hit from the back, the
+   * side from which their vertices are in clockwise order.
+   * @return The closest intersection, or `std::nullopt` if the ray does not
+   * intersect any triangle.
+   */
+  std::optional<TriangleBvhIntersection>
+  intersectRay(const Ray& ray, bool cullBackFaces = false) const noexcept;
+
+  /**
+   * @brief Gets the number of triangles in the hierarchy.
+   */
+  size_t getTriangleCount() const noexcept {
+    return this->_triangleIndices.size();
+  }
+
+  /**
+   * @brief Gets an estimate of the number of bytes of memory used by the
+   * hierarchy.
+   */
+  int64_t getSizeBytes() const noexcept;
+
+private:
+  struct Node {
+    glm::vec3 minimum;
+    glm::vec3 maximum;
+
+    // The index of the first child of an inner node, whose second child
+    // follows it, or of the first triangle of a leaf.
+    uint32_t first;
+
+    // The number of triangles of a leaf, or 0 for an inner node.
+    uint32_t count;
+  };
+
+  std::vector<glm::vec3> _positions;
+
+  // The indices of the vertices of the triangles, in the order of the leaves.
+  std::vector<uint32_t> _vertexIndices;
+
+  // The index of each triangle in the triangles given to the constructor.
+  std::vector<uint32_t> _triangleIndices;
+
+  std::vector<Node> _nodes;
+};
+
+} // namespace CesiumGeometry
@@ -1,5 +1,8 @@
 #include "CesiumGeometry/IntersectionTests.h"
 
+#include "CesiumGeometry/AxisAlignedBox.h"
+#include "CesiumGeometry/BoundingSphere.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
 #include "CesiumGeometry/Plane.h"
 #include "CesiumGeometry/Ray.h"
 
@@ -7,10 +10,44 @@
 
 #include <glm/geometric.hpp>
 
+#include <algorithm>
+#include <limits>
+
 using namespace CesiumUtility;
 
 namespace CesiumGeometry {
 
+namespace {
+
+// Narrows the range [tMin, tMax] of distances along a ray to those between
+// two planes perpendicular to an axis, at minimum and maximum along the axis.
+// The origin and direction are those of the ray along the axis.
+bool clipToSlab(
+    double origin,
+    double direction,
+    double minimum,
+    double maximum,
+    double& tMin,
+    double& tMax) noexcept {
+  if (direction == 0.0) {
+    // The ray is parallel to the planes.
+    return origin >= minimum && origin <= maximum;
+  }
+
+  const double inverseDirection = 1.0 / direction;
+  double t0 = (minimum - origin) * inverseDirection;
+  double t1 = (maximum - origin) * inverseDirection;
+  if (t0 > t1) {
+    std::swap(t0, t1);
+  }
+
+  tMin = std::max(tMin, t0);
+  tMax = std::min(tMax, t1);
+  return tMin <= tMax;
+}
+
+} // namespace
+
 /*static*/ std::optional<glm::dvec3>
 IntersectionTests::rayPlane(const Ray& ray, const Plane& plane) noexcept {
   const double denominator = glm::dot(plane.getNormal(), ray.getDirection());
@@ -31,6 +68,148 @@ IntersectionTests::rayPlane(const Ray& ray, const Plane& plane) noexcept {
   return ray.getOrigin() + ray.getDirection() * t;
 }
 
+/*static*/ std::optional<double> IntersectionTests::rayTriangleParametric(
+    const Ray& ray,
+    const glm::dvec3& p0,
+    const glm::dvec3& p1,
+    const glm::dvec3& p2,
+    bool cullBackFaces) noexcept {
+  const glm::dvec3& origin = ray.getOrigin();
+  const glm::dvec3& direction = ray.getDirection();
+
+  const glm::dvec3 edge0 = p1 - p0;
+  const glm::dvec3 edge1 = p2 - p0;
+
+  const glm::dvec3 p = glm::cross(direction, edge1);
+  const double determinant = glm::dot(edge0, p);
+
+  if (cullBackFaces ? determinant < Math::Epsilon15
+                    : glm::abs(determinant) < Math::Epsilon15) {
+    // The ray is parallel to the triangle, or hits its back.
+    return std::nullopt;
+  }
+
+  const double inverseDeterminant = 1.0 / determinant;
+  const glm::dvec3 tvec = origin - p0;
+  const double u = glm::dot(tvec, p) * inverseDeterminant;
+  if (u < 0.0 || u > 1.0) {
+    return std::nullopt;
+  }
+
+  const glm::dvec3 q = glm::cross(tvec, edge0);
+  const double v = glm::dot(direction, q) * inverseDeterminant;
+  if (v < 0.0 || u + v > 1.0) {
+    return std::nullopt;
+  }
+
+  const double t = glm::dot(edge1, q) * inverseDeterminant;
+  if (t < 0.0) {
+    return std::nullopt;
+  }
+
+  return t;
+}
+
+/*static*/ std::optional<double> IntersectionTests::rayAABBParametric(
+    const Ray& ray,
+    const AxisAlignedBox& box) noexcept {
+  const glm::dvec3& origin = ray.getOrigin();
+  const glm::dvec3& direction = ray.getDirection();
+
+  double tMin = 0.0;
+  double tMax = std::numeric_limits<double>::max();
+  if (!clipToSlab(
+          origin.x,
+          direction.x,
+          box.minimumX,
+          box.maximumX,
+          tMin,
+          tMax) ||
+      !clipToSlab(
+          origin.y,
+          direction.y,
+          box.minimumY,
+          box.maximumY,
+          tMin,
+          tMax) ||
+      !clipToSlab(
+          origin.z,
+          direction.z,
+          box.minimumZ,
+          box.maximumZ,
+          tMin,
+          tMax)) {
+    return std::nullopt;
+  }
+
+  return tMin;
+}
+
+/*static*/ std::optional<double> IntersectionTests::rayOBBParametric(
+    const Ray& ray,
+    const OrientedBoundingBox& box) noexcept {
+  // Clip the ray to the slab of each axis of the box. The axes are used
+  // directly, rather than the inverse half axes, so that boxes that are flat
+  // along an axis still work.
+  const glm::dvec3 offset = ray.getOrigin() - box.getCenter();
+  const glm::dmat3& halfAxes = box.getHalfAxes();
+
+  double tMin = 0.0;
+  double tMax = std::numeric_limits<double>::max();
+  for (glm::length_t i = 0; i < 3; ++i) {
+    const double halfLength = glm::length(halfAxes[i]);
+
+    glm::dvec3 axis;
+    if (halfLength > 0.0) {
+      axis = halfAxes[i] / halfLength;
+    } else {
+      // A flat box has no length along this axis, so its direction is
+      // perpendicular to the other two.
+      axis = glm::cross(halfAxes[(i + 1) % 3], halfAxes[(i + 2) % 3]);
+      const double axisLength = glm::length(axis);
+      if (axisLength == 0.0) {
+        // The axis has no direction, so it cannot clip the ray.
+        continue;
+      }
+      axis /= axisLength;
+    }
+
+    if (!clipToSlab(
+            glm::dot(offset, axis),
+            glm::dot(ray.getDirection(), axis),
+            -halfLength,
+            halfLength,
+            tMin,
+            tMax)) {
+      return std::nullopt;
+    }
+  }
+
+  return tMin;
+}
+
+/*static*/ std::optional<double> IntersectionTests::raySphereParametric(
+    const Ray& ray,
+    const BoundingSphere& sphere) noexcept {
+  const glm::dvec3 offset = ray.getOrigin() - sphere.getCenter();
+  const double radiusSquared = sphere.getRadius() * sphere.getRadius();
+  const double c = glm::dot(offset, offset) - radiusSquared;
+  if (c <= 0.0) {
+    // The origin is in the sphere.
+    return 0.0;
+  }
+
+  // The direction is normalized, so the quadratic's leading coefficient is 1.
+  const double b = glm::dot(offset, ray.getDirection());
+  const double discriminant = b * b - c;
+  if (b > 0.0 || discriminant < 0.0) {
+    // The sphere is behind the ray, or the ray misses it.
+    return std::nullopt;
+  }
+
+  return -b - glm::sqrt(discriminant);
+}
+
 bool IntersectionTests::pointInTriangle2D(
     const glm::dvec2& point,
     const glm::dvec2& triangleVertA,
@@ -4,12 +4,70 @@
 
 #include <CesiumUtility/Math.h>
 
+#include <glm/common.hpp>
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
 
+#include <array>
+#include <limits>
 #include <stdexcept>
+#include <utility>
 
 namespace CesiumGeometry {
+
+namespace {
+
+/**
+ * Computes the eigenvectors of a symmetric matrix with the cyclic Jacobi
+ * method, which rotates the matrix until it is diagonal. The eigenvectors are
+ * the columns of the returned rotation.
+ */
+glm::dmat3 computeEigenvectors(glm::dmat3 matrix) noexcept {
+  constexpr int maximumSweeps = 16;
+  constexpr std::array<std::pair<glm::length_t, glm::length_t>, 3> pairs{
+      {{0, 1}, {0, 2}, {1, 2}}};
+
+  glm::dmat3 eigenvectors(1.0);
+  for (int sweep = 0; sweep < maximumSweeps; ++sweep) {
+    const double offDiagonal = matrix[1][0] * matrix[1][0] +
+                               matrix[2][0] * matrix[2][0] +
+                               matrix[2][1] * matrix[2][1];
+    const double diagonal = matrix[0][0] * matrix[0][0] +
+                            matrix[1][1] * matrix[1][1] +
+                            matrix[2][2] * matrix[2][2];
+    if (offDiagonal <= 1e-30 * diagonal) {
+      break;
+    }
+
+    for (const auto& [p, q] : pairs) {
+      const double apq = matrix[q][p];
+      if (apq == 0.0) {
+        continue;
+      }
+
+      // The rotation in the p-q plane that zeroes the p-q element.
+      const double theta = (matrix[q][q] - matrix[p][p]) / (2.0 * apq);
+      const double t = (theta >= 0.0 ? 1.0 : -1.0) /
+                       (glm::abs(theta) + glm::sqrt(theta * theta + 1.0));
+      const double c = 1.0 / glm::sqrt(t * t + 1.0);
+      const double s = t * c;
+
+      glm::dmat3 rotation(1.0);
+      rotation[p][p] = c;
+      rotation[q][q] = c;
+      rotation[q][p] = s;
+      rotation[p][q] = -s;
+
+      matrix = glm::transpose(rotation) * matrix * rotation;
+      eigenvectors = eigenvectors * rotation;
+    }
+  }
+
+  return eigenvectors;
+}
+
+} // namespace
 CullingResult
 OrientedBoundingBox::intersectPlane(const Plane& plane) const noexcept {
   const glm::dvec3 normal = plane.getNormal();
@@ -148,4 +206,76 @@ OrientedBoundingBox::fromSphere(const BoundingSphere& sphere) noexcept {
   return OrientedBoundingBox(center, halfAxes);
 }
 
+/*static*/ OrientedBoundingBox OrientedBoundingBox::fromPositions(
+    const gsl::span<const glm::dvec3>& positions) noexcept {
+  const double minimumHalfLength = CesiumUtility::Math::Epsilon7;
+  if (positions.empty()) {
+    return OrientedBoundingBox(glm::dvec3(0.0), glm::dmat3(minimumHalfLength));
+  }
+
+  // The reductions below are kept to scalar accumulators in simple loops, so
+  // that the compiler can vectorize them.
+  double sumX = 0.0;
+  double sumY = 0.0;
+  double sumZ = 0.0;
+  for (const glm::dvec3& position : positions) {
+    sumX += position.x;
+    sumY += position.y;
+    sumZ += position.z;
+  }
+
+  const double inverseCount = 1.0 / double(positions.size());
+  const glm::dvec3 mean(
+      sumX * inverseCount,
+      sumY * inverseCount,
+      sumZ * inverseCount);
+
+  // The covariance of the positions, relative to their mean to keep the
+  // precision of positions far from the origin.
+  double xx = 0.0;
+  double xy = 0.0;
+  double xz = 0.0;
+  double yy = 0.0;
+  double yz = 0.0;
+  double zz = 0.0;
+  for (const glm::dvec3& position : positions) {
+    const double x = position.x - mean.x;
+    const double y = position.y - mean.y;
+    const double z = position.z - mean.z;
+    xx += x * x;
+    xy += x * y;
+    xz += x * z;
+    yy += y * y;
+    yz += y * z;
+    zz += z * z;
+  }
+
+  const glm::dmat3 axes = computeEigenvectors(
+      glm::dmat3(xx, xy, xz, xy, yy, yz, xz, yz, zz) * inverseCount);
+
+  // Find the extent of the positions along each axis.
+  const glm::dmat3 toAxes = glm::transpose(axes);
+  glm::dvec3 minimum(std::numeric_limits<double>::max());
+  glm::dvec3 maximum(std::numeric_limits<double>::lowest());
+  for (const glm::dvec3& position : positions) {
+    const glm::dvec3 local = toAxes * (position - mean);
+    minimum = glm::min(minimum, local);
+    maximum = glm::max(maximum, local);
+  }
+
+  glm::dvec3 halfLengths = 0.5 * (maximum - minimum);
+  const double longest =
+      glm::max(glm::max(halfLengths.x, halfLengths.y), halfLengths.z);
+  halfLengths = glm::max(
+      halfLengths,
+      glm::dvec3(minimumHalfLength * glm::max(longest, 1.0)));
+
+  return OrientedBoundingBox(
+      mean + axes * (0.5 * (minimum + maximum)),
+      glm::dmat3(
+          axes[0] * halfLengths.x,
+          axes[1] * halfLengths.y,
+          axes[2] * halfLengths.z));
+}
+
 } // namespace CesiumGeometry
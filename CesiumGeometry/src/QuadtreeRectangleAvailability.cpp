@@ -5,27 +5,32 @@
 #include <glm/common.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
 
 namespace CesiumGeometry {
 
+namespace {
+
+// The unsorted rectangles of a level are merged into the sorted ones when
+// there are more than this many of them, or more than the square root of the
+// number of sorted ones. That keeps both the scan of the unsorted rectangles
+// and the cost of the merges small.
+constexpr size_t minimumUnsortedLimit = 32;
+
+bool compareMinimumX(const Rectangle& a, const Rectangle& b) noexcept {
+  return a.minimumX < b.minimumX;
+}
+
+} // namespace
+
 QuadtreeRectangleAvailability::QuadtreeRectangleAvailability(
     const QuadtreeTilingScheme& tilingScheme,
     uint32_t maximumLevel) noexcept
     : _tilingScheme(tilingScheme),
       _maximumLevel(maximumLevel),
-      _rootNodes(
-          this->_tilingScheme.getRootTilesX() *
-          this->_tilingScheme.getRootTilesY()) {
-  for (uint32_t j = 0; j < this->_tilingScheme.getRootTilesY(); ++j) {
-    const uint32_t rowStart = j * this->_tilingScheme.getRootTilesX();
-    for (uint32_t i = 0; i < this->_tilingScheme.getRootTilesX(); ++i) {
-      QuadtreeTileID id(0, i, j);
-      Rectangle extent = tilingScheme.tileToRectangle(id);
-      this->_rootNodes[rowStart + i] =
-          std::make_unique<QuadtreeNode>(id, extent, nullptr);
-    }
-  }
-}
+      _levels(size_t(maximumLevel) + 1) {}
 
 void QuadtreeRectangleAvailability::addAvailableTileRange(
     const QuadtreeTileRectangularRange& range) noexcept {
@@ -34,27 +39,22 @@ void QuadtreeRectangleAvailability::addAvailableTileRange(
   const Rectangle ur = this->_tilingScheme.tileToRectangle(
       QuadtreeTileID(range.level, range.maximumX, range.maximumY));
 
-  RectangleWithLevel rectangleWithLevel{
-      range.level,
-      Rectangle(ll.minimumX, ll.minimumY, ur.maximumX, ur.maximumY)};
-
-  for (const std::unique_ptr<QuadtreeNode>& pNode : this->_rootNodes) {
-    if (pNode->extent.overlaps(rectangleWithLevel.rectangle)) {
-      putRectangleInQuadtree(
-          this->_tilingScheme,
-          this->_maximumLevel,
-          *pNode,
-          rectangleWithLevel);
-    }
+  const Rectangle rectangle(ll.minimumX, ll.minimumY, ur.maximumX, ur.maximumY);
+
+  // The ranges may be deeper than the maximum level.
+  if (this->_levels.size() <= range.level) {
+    this->_levels.resize(size_t(range.level) + 1);
   }
+
+  this->_levels[range.level].add(rectangle);
 }
 
 uint32_t QuadtreeRectangleAvailability::computeMaximumLevelAtPosition(
     const glm::dvec2& position) const noexcept {
-  // Find the root node that contains this position.
-  for (const std::unique_ptr<QuadtreeNode>& pNode : this->_rootNodes) {
-    if (pNode->extent.contains(position)) {
-      return findMaxLevelFromNode(nullptr, *pNode, position);
+  // Level 0 is the answer whether or not it is available.
+  for (size_t level = this->_levels.size() - 1; level > 0; --level) {
+    if (this->_levels[level].contains(position)) {
+      return static_cast<uint32_t>(level);
     }
   }
 
@@ -80,159 +80,92 @@ uint8_t QuadtreeRectangleAvailability::isTileAvailable(
   return 0;
 }
 
-/*static*/ void QuadtreeRectangleAvailability::putRectangleInQuadtree(
-    const QuadtreeTilingScheme& tilingScheme,
-    uint32_t maximumLevel,
-    QuadtreeRectangleAvailability::QuadtreeNode& node,
-    const QuadtreeRectangleAvailability::RectangleWithLevel&
-        rectangle) noexcept {
-  QuadtreeNode* pNode = &node;
-
-  while (pNode->id.level < maximumLevel) {
-    createNodeChildrenIfNecessary(*pNode, tilingScheme);
-    if (pNode->ll && pNode->ll->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ll.get();
-    } else if (
-        pNode->lr && pNode->lr->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->lr.get();
-    } else if (
-        pNode->ul && pNode->ul->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ul.get();
-    } else if (
-        pNode->ur && pNode->ur->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ur.get();
-    } else {
-      break;
-    }
+int64_t QuadtreeRectangleAvailability::computeByteSize() const {
+  int64_t bytes = int64_t(this->_levels.capacity() * sizeof(LevelRectangles));
+  for (const LevelRectangles& level : this->_levels) {
+    bytes += int64_t(
+        (level.sorted.capacity() + level.unsorted.capacity()) *
+            sizeof(Rectangle) +
+        level.runningMaximumX.capacity() * sizeof(double));
   }
 
-  if (pNode->rectangles.empty() ||
-      pNode->rectangles.back().level <= rectangle.level) {
-    pNode->rectangles.push_back(rectangle);
+  return bytes;
+}
+
+void QuadtreeRectangleAvailability::LevelRectangles::add(
+    const Rectangle& rectangle) {
+  if (this->sorted.empty() && this->unsorted.empty()) {
+    this->bounds = rectangle;
   } else {
-    // Maintain ordering by level when inserting.
-    std::push_heap(
-        pNode->rectangles.begin(),
-        pNode->rectangles.end(),
-        QuadtreeRectangleAvailability::rectangleLevelComparator);
+    this->bounds = this->bounds.computeUnion(rectangle);
   }
-}
 
-/*static*/ bool QuadtreeRectangleAvailability::rectangleLevelComparator(
-    const QuadtreeRectangleAvailability::RectangleWithLevel& a,
-    const QuadtreeRectangleAvailability::RectangleWithLevel& b) noexcept {
-  return a.level < b.level;
+  this->unsorted.emplace_back(rectangle);
+
+  const size_t limit = std::max(
+      minimumUnsortedLimit,
+      size_t(std::sqrt(double(this->sorted.size()))));
+  if (this->unsorted.size() > limit) {
+    this->mergeUnsorted();
+  }
 }
 
-/*static*/ uint32_t QuadtreeRectangleAvailability::findMaxLevelFromNode(
-    QuadtreeRectangleAvailability::QuadtreeNode* pStopNode,
-    QuadtreeRectangleAvailability::QuadtreeNode& node,
-    const glm::dvec2& position) noexcept {
-  uint32_t maxLevel = 0;
-  QuadtreeRectangleAvailability::QuadtreeNode* pNode = &node;
-
-  // Find the deepest quadtree node containing this point.
-  bool found = false;
-  while (!found) {
-    const uint32_t ll =
-        pNode->ll && pNode->ll->extent.contains(position) ? 1 : 0;
-    const uint32_t lr =
-        pNode->lr && pNode->lr->extent.contains(position) ? 1 : 0;
-    const uint32_t ul =
-        pNode->ul && pNode->ul->extent.contains(position) ? 1 : 0;
-    const uint32_t ur =
-        pNode->ur && pNode->ur->extent.contains(position) ? 1 : 0;
-
-    // The common scenario is that the point is in only one quadrant and we can
-    // simply iterate down the tree.  But if the point is on a boundary between
-    // tiles, it is in multiple tiles and we need to check all of them, so use
-    // recursion.
-    if (ll + lr + ul + ur > 1) {
-      if (ll) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ll, position));
-      }
-      if (lr) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->lr, position));
-      }
-      if (ul) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ul, position));
-      }
-      if (ur) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ur, position));
-      }
-      break;
-    }
-    if (ll) {
-      pNode = pNode->ll.get();
-    } else if (lr) {
-      pNode = pNode->lr.get();
-    } else if (ul) {
-      pNode = pNode->ul.get();
-    } else if (ur) {
-      pNode = pNode->ur.get();
-    } else {
-      found = true;
+bool QuadtreeRectangleAvailability::LevelRectangles::contains(
+    const glm::dvec2& position) const noexcept {
+  if ((this->sorted.empty() && this->unsorted.empty()) ||
+      !this->bounds.contains(position)) {
+    return false;
+  }
+
+  for (const Rectangle& rectangle : this->unsorted) {
+    if (rectangle.contains(position)) {
+      return true;
     }
   }
 
-  // Wal up the tree until we find a rectangle that contains this point.
-  while (pNode != pStopNode) {
-    const std::vector<RectangleWithLevel>& rectangles = pNode->rectangles;
-
-    // Rectangles are sorted by level, lowest first.
-    for (int32_t i = static_cast<int32_t>(rectangles.size()) - 1;
-         i >= 0 && rectangles[static_cast<size_t>(i)].level > maxLevel;
-         --i) {
-      const RectangleWithLevel& rectangle = rectangles[static_cast<size_t>(i)];
-      if (rectangle.rectangle.contains(position)) {
-        maxLevel = rectangle.level;
-      }
+  // Scan back from the last rectangle that starts at or before the position,
+  // until no earlier rectangle reaches it.
+  auto it = std::upper_bound(
+      this->sorted.begin(),
+      this->sorted.end(),
+      position.x,
+      [](double x, const Rectangle& rectangle) {
+        return x < rectangle.minimumX;
+      });
+  for (size_t i = size_t(it - this->sorted.begin()); i > 0; --i) {
+    if (this->runningMaximumX[i - 1] < position.x) {
+      break;
     }
 
-    pNode = pNode->pParent;
+    if (this->sorted[i - 1].contains(position)) {
+      return true;
+    }
   }
 
-  return maxLevel;
+  return false;
 }
 
-/*static*/ void QuadtreeRectangleAvailability::createNodeChildrenIfNecessary(
-    QuadtreeRectangleAvailability::QuadtreeNode& node,
-    const QuadtreeTilingScheme& tilingScheme) noexcept {
-  if (node.ll) {
-    return;
+void QuadtreeRectangleAvailability::LevelRectangles::mergeUnsorted() {
+  std::sort(this->unsorted.begin(), this->unsorted.end(), compareMinimumX);
+
+  const size_t sortedCount = this->sorted.size();
+  this->sorted.insert(
+      this->sorted.end(),
+      this->unsorted.begin(),
+      this->unsorted.end());
+  std::inplace_merge(
+      this->sorted.begin(),
+      this->sorted.begin() + std::ptrdiff_t(sortedCount),
+      this->sorted.end(),
+      compareMinimumX);
+  this->unsorted.clear();
+
+  this->runningMaximumX.resize(this->sorted.size());
+  double maximumX = -std::numeric_limits<double>::max();
+  for (size_t i = 0; i < this->sorted.size(); ++i) {
+    maximumX = std::max(maximumX, this->sorted[i].maximumX);
+    this->runningMaximumX[i] = maximumX;
   }
-
-  QuadtreeTileID llID(node.id.level + 1, node.id.x * 2, node.id.y * 2);
-  node.ll = std::make_unique<QuadtreeNode>(
-      llID,
-      tilingScheme.tileToRectangle(llID),
-      &node);
-
-  QuadtreeTileID lrID(llID.level, llID.x + 1, llID.y);
-  node.lr = std::make_unique<QuadtreeNode>(
-      lrID,
-      tilingScheme.tileToRectangle(lrID),
-      &node);
-
-  QuadtreeTileID ulID(llID.level, llID.x, llID.y + 1);
-  node.ul = std::make_unique<QuadtreeNode>(
-      ulID,
-      tilingScheme.tileToRectangle(ulID),
-      &node);
-
-  QuadtreeTileID urID(llID.level, llID.x + 1, llID.y + 1);
-  node.ur = std::make_unique<QuadtreeNode>(
-      urID,
-      tilingScheme.tileToRectangle(urID),
-      &node);
 }
 
 } // namespace CesiumGeometry
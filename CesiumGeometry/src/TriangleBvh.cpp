@@ -0,0 +1,249 @@
+#include "CesiumGeometry/TriangleBvh.h"
+
+#include "CesiumGeometry/IntersectionTests.h"
+#include "CesiumGeometry/Ray.h"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace CesiumGeometry {
+
+namespace {
+
+// The largest number of triangles in a leaf. Leaves with a few triangles take
+// less memory than leaves with one, and are about as fast to test.
+constexpr uint32_t maximumLeafSize = 4;
+
+// Each inner node has at least twice as many triangles as each of its
+// children, so the hierarchy of no more than 2^32 triangles is less deep than
+// this, and a traversal stack of this size cannot overflow.
+constexpr size_t maximumDepth = 64;
+
+struct TriangleBounds {
+  glm::vec3 minimum;
+  glm::vec3 maximum;
+  glm::vec3 center;
+};
+
+// Computes the distance along a ray to where it enters a box, or infinity if
+// it does not. Components of the inverse direction may be infinite, and the
+// NaNs that they may produce are ignored by the order of the min and max.
+double computeEntryDistance(
+    const glm::vec3& minimum,
+    const glm::vec3& maximum,
+    const glm::dvec3& origin,
+    const glm::dvec3& inverseDirection) noexcept {
+  double tMin = 0.0;
+  double tMax = std::numeric_limits<double>::infinity();
+  for (glm::length_t i = 0; i < 3; ++i) {
+    const double t0 = (double(minimum[i]) - origin[i]) * inverseDirection[i];
+    const double t1 = (double(maximum[i]) - origin[i]) * inverseDirection[i];
+    tMin = std::max(tMin, std::min(t0, t1));
+    tMax = std::min(tMax, std::max(t0, t1));
+  }
+
+  return tMin <= tMax ? tMin : std::numeric_limits<double>::infinity();
+}
+
+} // namespace
+
+TriangleBvh::TriangleBvh(
+    std::vector<glm::vec3>&& positions,
+    const std::vector<uint32_t>& triangles)
+    : _positions(std::move(positions)) {
+  const size_t vertexCount = this->_positions.size();
+
+  std::vector<TriangleBounds> bounds;
+  bounds.reserve(triangles.size() / 3);
+  this->_triangleIndices.reserve(triangles.size() / 3);
+  for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+    if (triangles[i] >= vertexCount || triangles[i + 1] >= vertexCount ||
+        triangles[i + 2] >= vertexCount) {
+      continue;
+    }
+
+    const glm::vec3& p0 = this->_positions[triangles[i]];
+    const glm::vec3& p1 = this->_positions[triangles[i + 1]];
+    const glm::vec3& p2 = this->_positions[triangles[i + 2]];
+    bounds.emplace_back(TriangleBounds{
+        glm::min(glm::min(p0, p1), p2),
+        glm::max(glm::max(p0, p1), p2),
+        (p0 + p1 + p2) / 3.0f});
+    this->_triangleIndices.emplace_back(static_cast<uint32_t>(i / 3));
+  }
+
+  if (bounds.empty()) {
+    return;
+  }
+
+  // The order of the triangles, as indices in `bounds`, which is rearranged
+  // so that the triangles of each node are contiguous.
+  std::vector<uint32_t> order(bounds.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = static_cast<uint32_t>(i);
+  }
+
+  struct Task {
+    uint32_t node;
+    uint32_t begin;
+    uint32_t end;
+  };
+
+  std::vector<Task> tasks{Task{0, 0, static_cast<uint32_t>(order.size())}};
+  this->_nodes.reserve(2 * (order.size() / maximumLeafSize) + 1);
+  this->_nodes.emplace_back();
+
+  while (!tasks.empty()) {
+    const Task task = tasks.back();
+    tasks.pop_back();
+
+    glm::vec3 minimum(std::numeric_limits<float>::max());
+    glm::vec3 maximum(std::numeric_limits<float>::lowest());
+    glm::vec3 centerMinimum = minimum;
+    glm::vec3 centerMaximum = maximum;
+    for (uint32_t i = task.begin; i < task.end; ++i) {
+      const TriangleBounds& triangle = bounds[order[i]];
+      minimum = glm::min(minimum, triangle.minimum);
+      maximum = glm::max(maximum, triangle.maximum);
+      centerMinimum = glm::min(centerMinimum, triangle.center);
+      centerMaximum = glm::max(centerMaximum, triangle.center);
+    }
+
+    Node& node = this->_nodes[task.node];
+    node.minimum = minimum;
+    node.maximum = maximum;
+
+    const glm::vec3 extent = centerMaximum - centerMinimum;
+    glm::length_t axis = 2;
+    if (extent.x >= extent.y && extent.x >= extent.z) {
+      axis = 0;
+    } else if (extent.y >= extent.z) {
+      axis = 1;
+    }
+
+    const uint32_t count = task.end - task.begin;
+    if (count <= maximumLeafSize || extent[axis] <= 0.0f) {
+      node.first = task.begin;
+      node.count = count;
+      continue;
+    }
+
+    const uint32_t middle = task.begin + count / 2;
+    std::nth_element(
+        order.begin() + task.begin,
+        order.begin() + middle,
+        order.begin() + task.end,
+        [&bounds, axis](uint32_t a, uint32_t b) {
+          return bounds[a].center[axis] < bounds[b].center[axis];
+        });
+
+    const uint32_t firstChild = static_cast<uint32_t>(this->_nodes.size());
+    node.first = firstChild;
+    node.count = 0;
+
+    // This invalidates `node`.
+    this->_nodes.emplace_back();
+    this->_nodes.emplace_back();
+
+    tasks.emplace_back(Task{firstChild, task.begin, middle});
+    tasks.emplace_back(Task{firstChild + 1, middle, task.end});
+  }
+
+  // Store the triangles in the order of the leaves.
+  std::vector<uint32_t> triangleIndices(order.size());
+  this->_vertexIndices.resize(order.size() * 3);
+  for (size_t i = 0; i < order.size(); ++i) {
+    const uint32_t triangleIndex = this->_triangleIndices[order[i]];
+    triangleIndices[i] = triangleIndex;
+    this->_vertexIndices[i * 3] = triangles[size_t(triangleIndex) * 3];
+    this->_vertexIndices[i * 3 + 1] = triangles[size_t(triangleIndex) * 3 + 1];
+    this->_vertexIndices[i * 3 + 2] = triangles[size_t(triangleIndex) * 3 + 2];
+  }
+  this->_triangleIndices = std::move(triangleIndices);
+}
+
+std::optional<TriangleBvhIntersection>
+TriangleBvh::intersectRay(const Ray& ray, bool cullBackFaces) const noexcept {
+  if (this->_nodes.empty()) {
+    return std::nullopt;
+  }
+
+  const glm::dvec3& origin = ray.getOrigin();
+  const glm::dvec3 inverseDirection = 1.0 / ray.getDirection();
+
+  std::optional<TriangleBvhIntersection> result;
+  double closest = std::numeric_limits<double>::infinity();
+
+  std::array<uint32_t, maximumDepth> stack;
+  size_t stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0) {
+    const Node& node = this->_nodes[stack[--stackSize]];
+    if (computeEntryDistance(
+            node.minimum,
+            node.maximum,
+            origin,
+            inverseDirection) >= closest) {
+      continue;
+    }
+
+    if (node.count > 0) {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        const size_t vertex = size_t(i) * 3;
+        const std::optional<double> t =
+            IntersectionTests::rayTriangleParametric(
+                ray,
+                glm::dvec3(this->_positions[this->_vertexIndices[vertex]]),
+                glm::dvec3(this->_positions[this->_vertexIndices[vertex + 1]]),
+                glm::dvec3(this->_positions[this->_vertexIndices[vertex + 2]]),
+                cullBackFaces);
+        if (t && *t < closest) {
+          closest = *t;
+          result = TriangleBvhIntersection{*t, this->_triangleIndices[i]};
+        }
+      }
+      continue;
+    }
+
+    // Visit the nearer child first, so that the farther one is more likely
+    // to be skipped.
+    uint32_t nearChild = node.first;
+    uint32_t farChild = node.first + 1;
+    const double nearDistance = computeEntryDistance(
+        this->_nodes[nearChild].minimum,
+        this->_nodes[nearChild].maximum,
+        origin,
+        inverseDirection);
+    const double farDistance = computeEntryDistance(
+        this->_nodes[farChild].minimum,
+        this->_nodes[farChild].maximum,
+        origin,
+        inverseDirection);
+    if (farDistance < nearDistance) {
+      std::swap(nearChild, farChild);
+    }
+
+    if (std::max(nearDistance, farDistance) < closest) {
+      stack[stackSize++] = farChild;
+    }
+    if (std::min(nearDistance, farDistance) < closest) {
+      stack[stackSize++] = nearChild;
+    }
+  }
+
+  return result;
+}
+
+int64_t TriangleBvh::getSizeBytes() const noexcept {
+  return static_cast<int64_t>(
+      sizeof(TriangleBvh) + this->_positions.capacity() * sizeof(glm::vec3) +
+      this->_vertexIndices.capacity() * sizeof(uint32_t) +
+      this->_triangleIndices.capacity() * sizeof(uint32_t) +
+      this->_nodes.capacity() * sizeof(Node));
+}
+
+} // namespace CesiumGeometry
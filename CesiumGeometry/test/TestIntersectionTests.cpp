@@ -1,11 +1,17 @@
+#include "CesiumGeometry/AxisAlignedBox.h"
+#include "CesiumGeometry/BoundingSphere.h"
 #include "CesiumGeometry/IntersectionTests.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
 #include "CesiumGeometry/Plane.h"
 #include "CesiumGeometry/Ray.h"
 
+#include <CesiumUtility/Math.h>
+
 #include <catch2/catch.hpp>
 #include <glm/mat3x3.hpp>
 
 using namespace CesiumGeometry;
+using namespace CesiumUtility;
 
 TEST_CASE("IntersectionTests::rayPlane") {
   struct TestCase {
@@ -35,3 +41,103 @@ TEST_CASE("IntersectionTests::rayPlane") {
       IntersectionTests::rayPlane(testCase.ray, testCase.plane);
   CHECK(intersectionPoint == testCase.expectedIntersectionPoint);
 }
+
+TEST_CASE("IntersectionTests::rayTriangleParametric") {
+  const glm::dvec3 p0(-1.0, -1.0, 0.0);
+  const glm::dvec3 p1(1.0, -1.0, 0.0);
+  const glm::dvec3 p2(0.0, 1.0, 0.0);
+
+  SECTION("hits the front") {
+    const Ray ray(glm::dvec3(0.0, 0.0, 2.0), glm::dvec3(0.0, 0.0, -1.0));
+    const std::optional<double> t =
+        IntersectionTests::rayTriangleParametric(ray, p0, p1, p2, true);
+    REQUIRE(t);
+    CHECK(*t == 2.0);
+  }
+
+  SECTION("hits the back unless back faces are culled") {
+    const Ray ray(glm::dvec3(0.0, 0.0, -2.0), glm::dvec3(0.0, 0.0, 1.0));
+    CHECK(IntersectionTests::rayTriangleParametric(ray, p0, p1, p2) == 2.0);
+    CHECK(!IntersectionTests::rayTriangleParametric(ray, p0, p1, p2, true));
+  }
+
+  SECTION("misses") {
+    CHECK(!IntersectionTests::rayTriangleParametric(
+        Ray(glm::dvec3(2.0, 0.0, 2.0), glm::dvec3(0.0, 0.0, -1.0)),
+        p0,
+        p1,
+        p2));
+    CHECK(!IntersectionTests::rayTriangleParametric(
+        Ray(glm::dvec3(0.0, 0.0, 2.0), glm::dvec3(0.0, 0.0, 1.0)),
+        p0,
+        p1,
+        p2));
+    CHECK(!IntersectionTests::rayTriangleParametric(
+        Ray(glm::dvec3(0.0, 0.0, 2.0), glm::dvec3(1.0, 0.0, 0.0)),
+        p0,
+        p1,
+        p2));
+  }
+}
+
+TEST_CASE("IntersectionTests::rayAABBParametric") {
+  const AxisAlignedBox box(-1.0, -1.0, -1.0, 1.0, 1.0, 1.0);
+
+  CHECK(
+      IntersectionTests::rayAABBParametric(
+          Ray(glm::dvec3(-3.0, 0.0, 0.0), glm::dvec3(1.0, 0.0, 0.0)),
+          box) == 2.0);
+  CHECK(
+      IntersectionTests::rayAABBParametric(
+          Ray(glm::dvec3(0.5, 0.5, 0.0), glm::dvec3(0.0, 1.0, 0.0)),
+          box) == 0.0);
+  CHECK(!IntersectionTests::rayAABBParametric(
+      Ray(glm::dvec3(-3.0, 2.0, 0.0), glm::dvec3(1.0, 0.0, 0.0)),
+      box));
+  CHECK(!IntersectionTests::rayAABBParametric(
+      Ray(glm::dvec3(-3.0, 0.0, 0.0), glm::dvec3(-1.0, 0.0, 0.0)),
+      box));
+}
+
+TEST_CASE("IntersectionTests::rayOBBParametric") {
+  // A box rotated by 90 degrees around Z, 4 long along Y, and flat along Z.
+  const OrientedBoundingBox box(
+      glm::dvec3(10.0, 0.0, 0.0),
+      glm::dmat3(
+          glm::dvec3(0.0, 2.0, 0.0),
+          glm::dvec3(-1.0, 0.0, 0.0),
+          glm::dvec3(0.0, 0.0, 0.0)));
+
+  const std::optional<double> t = IntersectionTests::rayOBBParametric(
+      Ray(glm::dvec3(10.0, 1.5, 5.0), glm::dvec3(0.0, 0.0, -1.0)),
+      box);
+  REQUIRE(t);
+  CHECK(Math::equalsEpsilon(*t, 5.0, Math::Epsilon12));
+
+  CHECK(!IntersectionTests::rayOBBParametric(
+      Ray(glm::dvec3(11.5, 0.0, 5.0), glm::dvec3(0.0, 0.0, -1.0)),
+      box));
+  CHECK(
+      IntersectionTests::rayOBBParametric(
+          Ray(glm::dvec3(0.0, 0.0, 0.0), glm::dvec3(1.0, 0.0, 0.0)),
+          box) == 9.0);
+}
+
+TEST_CASE("IntersectionTests::raySphereParametric") {
+  const BoundingSphere sphere(glm::dvec3(0.0, 0.0, 5.0), 2.0);
+
+  CHECK(
+      IntersectionTests::raySphereParametric(
+          Ray(glm::dvec3(0.0), glm::dvec3(0.0, 0.0, 1.0)),
+          sphere) == 3.0);
+  CHECK(
+      IntersectionTests::raySphereParametric(
+          Ray(glm::dvec3(0.0, 0.0, 4.0), glm::dvec3(1.0, 0.0, 0.0)),
+          sphere) == 0.0);
+  CHECK(!IntersectionTests::raySphereParametric(
+      Ray(glm::dvec3(0.0), glm::dvec3(0.0, 0.0, -1.0)),
+      sphere));
+  CHECK(!IntersectionTests::raySphereParametric(
+      Ray(glm::dvec3(3.0, 0.0, 0.0), glm::dvec3(0.0, 0.0, 1.0)),
+      sphere));
+}
@@ -9,6 +9,7 @@
 #include <glm/gtx/string_cast.hpp>
 
 #include <optional>
+#include <vector>
 
 using namespace CesiumGeometry;
 using namespace Cesium3DTilesSelection;
@@ -479,3 +480,56 @@ TEST_CASE("OrientedBoundingBox::contains") {
     CHECK(!obb.contains(center + rotation * glm::dvec3(0.0, 0.0, 5.0)));
   }
 }
+
+TEST_CASE("OrientedBoundingBox::fromPositions") {
+  const glm::dmat3 rotation = glm::dmat3(glm::eulerAngleYXZ(0.3, -0.7, 1.1));
+  const glm::dvec3 center(6378137.0, 1000.0, -2000.0);
+
+  // A lattice filling a rotated box with half-lengths of 1, 3, and 8.
+  std::vector<glm::dvec3> positions;
+  for (int x = -2; x <= 2; ++x) {
+    for (int y = -3; y <= 3; ++y) {
+      for (int z = -8; z <= 8; ++z) {
+        positions.emplace_back(
+            center + rotation * glm::dvec3(0.5 * x, double(y), double(z)));
+      }
+    }
+  }
+
+  SECTION("fits the positions tightly") {
+    const OrientedBoundingBox obb =
+        OrientedBoundingBox::fromPositions(positions);
+    for (const glm::dvec3& position : positions) {
+      CHECK(obb.computeDistanceSquaredToPosition(position) < Math::Epsilon6);
+    }
+
+    CHECK(Math::equalsEpsilon(obb.getCenter(), center, 0.0, Math::Epsilon6));
+    const glm::dvec3& lengths = obb.getLengths();
+    CHECK(Math::equalsEpsilon(
+        lengths.x * lengths.y * lengths.z,
+        2.0 * 6.0 * 16.0,
+        Math::Epsilon6));
+  }
+
+  SECTION("has a thickness for coplanar positions") {
+    std::vector<glm::dvec3> coplanar;
+    for (const glm::dvec3& position : positions) {
+      const glm::dvec3 local = glm::transpose(rotation) * (position - center);
+      coplanar.emplace_back(
+          center + rotation * glm::dvec3(local.x, local.y, 0.0));
+    }
+
+    const OrientedBoundingBox obb =
+        OrientedBoundingBox::fromPositions(coplanar);
+    const glm::dvec3& lengths = obb.getLengths();
+    CHECK(glm::min(glm::min(lengths.x, lengths.y), lengths.z) > 0.0);
+    CHECK(obb.contains(center));
+    CHECK(!obb.contains(center + rotation * glm::dvec3(0.0, 0.0, 1.0)));
+  }
+
+  SECTION("is a tiny box at the origin without positions") {
+    const OrientedBoundingBox obb = OrientedBoundingBox::fromPositions({});
+    CHECK(obb.getCenter() == glm::dvec3(0.0));
+    CHECK(obb.contains(glm::dvec3(0.0)));
+  }
+}
@@ -0,0 +1,66 @@
+#include "CesiumGeometry/QuadtreeRectangleAvailability.h"
+#include "CesiumGeometry/QuadtreeTileID.h"
+#include "CesiumGeometry/QuadtreeTileRectangularRange.h"
+#include "CesiumGeometry/QuadtreeTilingScheme.h"
+#include "CesiumGeometry/Rectangle.h"
+#include "CesiumGeometry/TileAvailabilityFlags.h"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using namespace CesiumGeometry;
+
+TEST_CASE("QuadtreeRectangleAvailability") {
+  const QuadtreeTilingScheme tilingScheme(Rectangle(0.0, 0.0, 2.0, 1.0), 2, 1);
+  QuadtreeRectangleAvailability availability(tilingScheme, 10);
+
+  SECTION("finds the maximum level of the ranges at a position") {
+    availability.addAvailableTileRange({0, 0, 0, 1, 0});
+    availability.addAvailableTileRange({3, 0, 0, 3, 3});
+    availability.addAvailableTileRange({1, 0, 0, 3, 1});
+
+    CHECK(availability.computeMaximumLevelAtPosition({0.1, 0.1}) == 3);
+    CHECK(availability.computeMaximumLevelAtPosition({1.5, 0.5}) == 1);
+    CHECK(availability.computeMaximumLevelAtPosition({3.0, 0.5}) == 0);
+
+    CHECK(
+        availability.isTileAvailable(QuadtreeTileID(3, 3, 3)) ==
+        (TileAvailabilityFlags::TILE_AVAILABLE |
+         TileAvailabilityFlags::REACHABLE));
+    CHECK(availability.isTileAvailable(QuadtreeTileID(3, 4, 3)) == 0);
+    CHECK(availability.isTileAvailable(QuadtreeTileID(2, 1, 1)) != 0);
+    CHECK(availability.isTileAvailable(QuadtreeTileID(2, 3, 1)) == 0);
+  }
+
+  SECTION("tracks ranges deeper than the maximum level") {
+    availability.addAvailableTileRange({12, 5, 5, 5, 5});
+    CHECK(availability.isTileAvailable(QuadtreeTileID(12, 5, 5)) != 0);
+    CHECK(availability.isTileAvailable(QuadtreeTileID(12, 6, 5)) == 0);
+  }
+
+  SECTION("finds the same tiles as testing each range") {
+    // Enough single-tile ranges, in no particular order, to be merged into
+    // the sorted ranges several times.
+    std::vector<QuadtreeTileRectangularRange> ranges;
+    for (uint32_t i = 0; i < 300; ++i) {
+      const uint32_t x = (i * 37) % 64;
+      const uint32_t y = (i * 11) % 32;
+      ranges.push_back({6, x, y, x, y});
+      availability.addAvailableTileRange(ranges.back());
+    }
+
+    for (uint32_t y = 0; y < 32; ++y) {
+      for (uint32_t x = 0; x < 64; ++x) {
+        bool expected = false;
+        for (const QuadtreeTileRectangularRange& range : ranges) {
+          expected = expected || (range.minimumX == x && range.minimumY == y);
+        }
+
+        CHECK(
+            (availability.isTileAvailable(QuadtreeTileID(6, x, y)) != 0) ==
+            expected);
+      }
+    }
+  }
+}
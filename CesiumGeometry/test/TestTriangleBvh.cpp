@@ -0,0 +1,129 @@
+#include "CesiumGeometry/IntersectionTests.h"
+#include "CesiumGeometry/Ray.h"
+#include "CesiumGeometry/TriangleBvh.h"
+
+#include <catch2/catch.hpp>
+#include <glm/geometric.hpp>
+
+#include <cmath>
+#include <optional>
+#include <vector>
+
+using namespace CesiumGeometry;
+
+namespace {
+
+// A wavy grid of triangles, with the vertices of each row and column of
+// cells.
+struct Grid {
+  std::vector<glm::vec3> positions;
+  std::vector<uint32_t> triangles;
+};
+
+Grid createGrid(uint32_t size) {
+  Grid grid;
+  for (uint32_t y = 0; y <= size; ++y) {
+    for (uint32_t x = 0; x <= size; ++x) {
+      grid.positions.emplace_back(
+          float(x),
+          float(y),
+          std::sin(float(x) * 0.7f) * std::cos(float(y) * 0.3f));
+    }
+  }
+
+  for (uint32_t y = 0; y < size; ++y) {
+    for (uint32_t x = 0; x < size; ++x) {
+      const uint32_t i = y * (size + 1) + x;
+      grid.triangles.insert(
+          grid.triangles.end(),
+          {i, i + 1, i + size + 1, i + 1, i + size + 2, i + size + 1});
+    }
+  }
+
+  return grid;
+}
+
+std::optional<TriangleBvhIntersection> intersectEachTriangle(
+    const Grid& grid,
+    const Ray& ray,
+    bool cullBackFaces) {
+  std::optional<TriangleBvhIntersection> result;
+  for (size_t i = 0; i < grid.triangles.size(); i += 3) {
+    const std::optional<double> t = IntersectionTests::rayTriangleParametric(
+        ray,
+        glm::dvec3(grid.positions[grid.triangles[i]]),
+        glm::dvec3(grid.positions[grid.triangles[i + 1]]),
+        glm::dvec3(grid.positions[grid.triangles[i + 2]]),
+        cullBackFaces);
+    if (t && (!result || *t < result->t)) {
+      result = TriangleBvhIntersection{*t, uint32_t(i / 3)};
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("TriangleBvh") {
+  const Grid grid = createGrid(20);
+
+  SECTION("finds the same intersections as testing each triangle") {
+    const TriangleBvh bvh(
+        std::vector<glm::vec3>(grid.positions),
+        grid.triangles);
+    REQUIRE(bvh.getTriangleCount() == grid.triangles.size() / 3);
+
+    for (int i = 0; i < 200; ++i) {
+      const glm::dvec3 origin(
+          -5.0 + 0.37 * i,
+          25.0 - 0.23 * i,
+          i % 2 ? 10.0 : -10.0);
+      const glm::dvec3 target(2.0 + 0.08 * i, 1.0 + 0.09 * i, 0.0);
+      const Ray ray(origin, glm::normalize(target - origin));
+
+      for (bool cullBackFaces : {false, true}) {
+        const std::optional<TriangleBvhIntersection> expected =
+            intersectEachTriangle(grid, ray, cullBackFaces);
+        const std::optional<TriangleBvhIntersection> actual =
+            bvh.intersectRay(ray, cullBackFaces);
+        REQUIRE(actual.has_value() == expected.has_value());
+        if (expected) {
+          // Rays through an edge hit two triangles at the same distance, so
+          // check the distance to the triangle rather than its index.
+          CHECK(actual->t == expected->t);
+          const size_t vertex = size_t(actual->triangleIndex) * 3;
+          CHECK(
+              IntersectionTests::rayTriangleParametric(
+                  ray,
+                  glm::dvec3(grid.positions[grid.triangles[vertex]]),
+                  glm::dvec3(grid.positions[grid.triangles[vertex + 1]]),
+                  glm::dvec3(grid.positions[grid.triangles[vertex + 2]]),
+                  cullBackFaces) == expected->t);
+        }
+      }
+    }
+  }
+
+  SECTION("misses rays that pass by the triangles") {
+    const TriangleBvh bvh(
+        std::vector<glm::vec3>(grid.positions),
+        grid.triangles);
+    CHECK(!bvh.intersectRay(
+        Ray(glm::dvec3(-1.0, -1.0, 5.0), glm::dvec3(0.0, 0.0, -1.0))));
+    CHECK(!bvh.intersectRay(
+        Ray(glm::dvec3(5.0, 5.0, 5.0), glm::dvec3(0.0, 0.0, 1.0))));
+  }
+
+  SECTION("ignores triangles with indices out of range") {
+    std::vector<uint32_t> triangles{0, 1, 2, 0, 1, 1000};
+    const TriangleBvh bvh(std::vector<glm::vec3>(grid.positions), triangles);
+    CHECK(bvh.getTriangleCount() == 1);
+  }
+
+  SECTION("is empty without triangles") {
+    const TriangleBvh bvh;
+    CHECK(bvh.getTriangleCount() == 0);
+    CHECK(!bvh.intersectRay(
+        Ray(glm::dvec3(5.0, 5.0, 5.0), glm::dvec3(0.0, 0.0, -1.0))));
+  }
+}
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "BoundingRegion.h"
+#include "Ellipsoid.h"
 #include "Library.h"
 
+#include <gsl/span>
+
 namespace CesiumGeospatial {
 
 class CESIUMGEOSPATIAL_API BoundingRegionBuilder {
@@ -57,7 +60,68 @@ public:
    */
   bool expandToIncludePosition(const Cartographic& position);
 
+  /**
+   * @brief Expands the bounding region to include many positions.
+   *
+   * The positions are given as separate arrays of their coordinates, which
+   * must all have the same size. The region is the same as if each position
+   * were given to {@link expandToIncludePosition} in turn, but the latitude
+   * and height ranges of a block of positions are found together, with loops
+   * that the compiler vectorizes, and the longitude range is only updated
+   * position by position for blocks that are not already within it.
+   * Positions with a NaN coordinate, like those that
+   * {@link Ellipsoid::cartesianToCartographic} gives for the center of the
+   * ellipsoid, are skipped.
+   *
+   * @param longitudes The longitudes of the positions, in radians.
+   * @param latitudes The latitudes of the positions, in radians.
+   * @param heights The heights of the positions, in meters.
+   * @returns True if the region was modified, or false if the region already
+   * contained all of the positions.
+   */
+  bool expandToIncludePositions(
+      const gsl::span<const double>& longitudes,
+      const gsl::span<const double>& latitudes,
+      const gsl::span<const double>& heights);
+
+  /**
+   * @brief Expands the bounding region to include many cartesian positions.
+   *
+   * The positions are converted to {@link Cartographic} in blocks with the
+   * batch conversion of the ellipsoid, and then included as by
+   * {@link expandToIncludePositions}.
+   *
+   * @param xs The x coordinates of the positions.
+   * @param ys The y coordinates of the positions.
+   * @param zs The z coordinates of the positions.
+   * @param ellipsoid The ellipsoid of the positions.
+   * @returns True if the region was modified, or false if the region already
+   * contained all of the positions.
+   */
+  bool expandToIncludeCartesianPositions(
+      const gsl::span<const double>& xs,
+      const gsl::span<const double>& ys,
+      const gsl::span<const double>& zs,
+      const Ellipsoid& ellipsoid = Ellipsoid::WGS84);
+
+  /**
+   * @brief Expands the bounding region to include the region of another
+   * builder.
+   *
+   * This lets separate builders bound parts of a large set of positions, for
+   * example on separate threads, and then be merged. The longitude range is
+   * the smallest one that contains the ranges of both builders, which may be
+   * larger than if all of the positions had been given to one builder.
+   *
+   * @param other The other builder.
+   * @returns True if the region was modified, or false if the region already
+   * contained the region of the other builder.
+   */
+  bool merge(const BoundingRegionBuilder& other);
+
 private:
+  bool expandLongitudeToInclude(const Cartographic& position);
+
   /**
    * @brief When a position's latitude is within this distance in radians from
    * the North or South pole, its longitude should be considered unreliable and
@@ -64,6 +64,28 @@ public:
     return this->_boundingRectangle;
   }
 
+  /**
+   * @brief Determines whether a globe rectangle is completely inside this
+   * polygon.
+   *
+   * @param rectangle The {@link CesiumGeospatial::GlobeRectangle} of the tile.
+   * @return True if the rectangle is completely inside the polygon; otherwise,
+   * false.
+   */
+  bool rectangleIsWithinPolygon(
+      const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept;
+
+  /**
+   * @brief Determines whether a globe rectangle is completely outside this
+   * polygon.
+   *
+   * @param rectangle The {@link CesiumGeospatial::GlobeRectangle} of the tile.
+   * @return True if the rectangle is completely outside the polygon;
+   * otherwise, false.
+   */
+  bool rectangleIsOutsidePolygon(
+      const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept;
+
   /**
    * @brief Determines whether a globe rectangle is completely inside any of the
    * polygons in a list.
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CartographicPolygon.h"
+#include "GlobeRectangle.h"
+#include "Library.h"
+
+#include <CesiumGeometry/Rectangle.h>
+
+#include <glm/vec2.hpp>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace CesiumGeospatial {
+
+/**
+ * @brief A list of {@link CartographicPolygon} instances with a spatial index
+ * over the polygons and their triangles.
+ *
+ * The index is a uniform grid over the longitude-latitude extent of the
+ * polygons, built once at construction. Queries with a {@link GlobeRectangle}
+ * only test the polygons and triangles in the grid cells that the rectangle
+ * overlaps, so their cost depends on the polygons near the rectangle rather
+ * than on all of them.
+ */
+class CESIUMGEOSPATIAL_API CartographicPolygonIndex final {
+public:
+  /**
+   * @brief Constructs an index of the given polygons.
+   *
+   * @param polygons The polygons to index.
+   */
+  explicit CartographicPolygonIndex(
+      const std::vector<CartographicPolygon>& polygons);
+
+  /**
+   * @brief Gets the indexed polygons, in the order they were given.
+   */
+  const std::vector<CartographicPolygon>& getPolygons() const noexcept {
+    return this->_polygons;
+  }
+
+  /**
+   * @brief Determines whether a globe rectangle is completely inside any of the
+   * polygons.
+   *
+   * This gives the same result as
+   * {@link CartographicPolygon::rectangleIsWithinPolygons}.
+   *
+   * @param rectangle The rectangle to check.
+   * @return True if the rectangle is completely inside a polygon; otherwise,
+   * false.
+   */
+  bool rectangleIsWithinPolygons(const GlobeRectangle& rectangle) const;
+
+  /**
+   * @brief Determines whether a globe rectangle is completely outside all the
+   * polygons.
+   *
+   * This gives the same result as
+   * {@link CartographicPolygon::rectangleIsOutsidePolygons}.
+   *
+   * @param rectangle The rectangle to check.
+   * @return True if the rectangle is completely outside all the polygons;
+   * otherwise, false.
+   */
+  bool rectangleIsOutsidePolygons(const GlobeRectangle& rectangle) const;
+
+  /**
+   * @brief Determines whether the bounding rectangle of any of the polygons
+   * intersects a globe rectangle.
+   *
+   * @param rectangle The rectangle to check.
+   * @return True if a polygon's bounding rectangle intersects the rectangle;
+   * otherwise, false.
+   */
+  bool anyBoundingRectangleIntersects(const GlobeRectangle& rectangle) const;
+
+  /**
+   * @brief Finds the triangles of the polygons that may overlap a globe
+   * rectangle.
+   *
+   * The result contains the triangles whose longitude-latitude bounds
+   * intersect the rectangle, in no particular order. The vertices are the
+   * ones of {@link CartographicPolygon::getVertices}, so their longitudes are
+   * not adjusted across the antimeridian.
+   *
+   * @param rectangle The rectangle to check.
+   * @return The vertices of the triangles.
+   */
+  std::vector<std::array<glm::dvec2, 3>>
+  findTriangles(const GlobeRectangle& rectangle) const;
+
+private:
+  // A uniform grid whose cells list the items that overlap them, stored as
+  // the ranges of one array.
+  struct Grid {
+    CesiumGeometry::Rectangle bounds;
+    uint32_t columns = 0;
+    uint32_t rows = 0;
+    std::vector<uint32_t> cellStarts;
+    std::vector<uint32_t> items;
+  };
+
+  struct GridEntry {
+    uint32_t item;
+    CesiumGeometry::Rectangle bounds;
+  };
+
+  static Grid buildGrid(const std::vector<GridEntry>& entries);
+
+  static void findItems(
+      const Grid& grid,
+      const GlobeRectangle& rectangle,
+      std::vector<uint32_t>& items);
+
+  std::vector<uint32_t> _findPolygons(const GlobeRectangle& rectangle) const;
+
+  std::vector<CartographicPolygon> _polygons;
+
+  // The polygon and the position of the first index of each triangle.
+  std::vector<std::pair<uint32_t, uint32_t>> _triangles;
+
+  Grid _polygonGrid;
+  Grid _triangleGrid;
+};
+
+} // namespace CesiumGeospatial
@@ -6,6 +6,7 @@
 #include <CesiumUtility/Math.h>
 
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 #include <optional>
 
@@ -119,6 +120,103 @@ public:
   std::optional<glm::dvec3>
   scaleToGeodeticSurface(const glm::dvec3& cartesian) const noexcept;
 
+  /**
+   * @brief Computes the normals of the planes tangent to the surface of the
+   * ellipsoid at many cartesian positions.
+   *
+   * The positions and the normals are given as separate arrays of their x, y,
+   * and z coordinates, which must all have the same size. The positions are
+   * converted together in blocks, with loops that the compiler vectorizes.
+   *
+   * @param xs The x coordinates of the positions.
+   * @param ys The y coordinates of the positions.
+   * @param zs The z coordinates of the positions.
+   * @param normalXs The x coordinates of the normals.
+   * @param normalYs The y coordinates of the normals.
+   * @param normalZs The z coordinates of the normals.
+   */
+  void geodeticSurfaceNormal(
+      const gsl::span<const double>& xs,
+      const gsl::span<const double>& ys,
+      const gsl::span<const double>& zs,
+      const gsl::span<double>& normalXs,
+      const gsl::span<double>& normalYs,
+      const gsl::span<double>& normalZs) const noexcept;
+
+  /**
+   * @brief Converts many {@link Cartographic} positions to cartesian.
+   *
+   * The positions are given as separate arrays of their coordinates, which
+   * must all have the same size. The results agree with those of
+   * {@link cartographicToCartesian(const Cartographic&) const} to within
+   * rounding.
+   *
+   * @param longitudes The longitudes of the positions, in radians.
+   * @param latitudes The latitudes of the positions, in radians.
+   * @param heights The heights of the positions, in meters.
+   * @param xs The x coordinates of the cartesian positions.
+   * @param ys The y coordinates of the cartesian positions.
+   * @param zs The z coordinates of the cartesian positions.
+   */
+  void cartographicToCartesian(
+      const gsl::span<const double>& longitudes,
+      const gsl::span<const double>& latitudes,
+      const gsl::span<const double>& heights,
+      const gsl::span<double>& xs,
+      const gsl::span<double>& ys,
+      const gsl::span<double>& zs) const noexcept;
+
+  /**
+   * @brief Converts many cartesian positions to {@link Cartographic}.
+   *
+   * The positions are given as separate arrays of their coordinates, which
+   * must all have the same size. The coordinates of a position at the center
+   * of this ellipsoid, for which
+   * {@link cartesianToCartographic(const glm::dvec3&) const} returns the
+   * empty optional, are NaN.
+   *
+   * @param xs The x coordinates of the positions.
+   * @param ys The y coordinates of the positions.
+   * @param zs The z coordinates of the positions.
+   * @param longitudes The longitudes of the positions, in radians.
+   * @param latitudes The latitudes of the positions, in radians.
+   * @param heights The heights of the positions, in meters.
+   */
+  void cartesianToCartographic(
+      const gsl::span<const double>& xs,
+      const gsl::span<const double>& ys,
+      const gsl::span<const double>& zs,
+      const gsl::span<double>& longitudes,
+      const gsl::span<double>& latitudes,
+      const gsl::span<double>& heights) const noexcept;
+
+  /**
+   * @brief Scales many cartesian positions along their geodetic surface normals
+   * so that they are on the surface of this ellipsoid.
+   *
+   * The positions are given as separate arrays of their coordinates, which
+   * must all have the same size, and may be scaled in place. The iterations
+   * that find the scaled positions run for a block of positions at once,
+   * until all of them have converged. The coordinates of a position at the
+   * center of this ellipsoid, for which
+   * {@link scaleToGeodeticSurface(const glm::dvec3&) const} returns the empty
+   * optional, are NaN.
+   *
+   * @param xs The x coordinates of the positions.
+   * @param ys The y coordinates of the positions.
+   * @param zs The z coordinates of the positions.
+   * @param resultXs The x coordinates of the scaled positions.
+   * @param resultYs The y coordinates of the scaled positions.
+   * @param resultZs The z coordinates of the scaled positions.
+   */
+  void scaleToGeodeticSurface(
+      const gsl::span<const double>& xs,
+      const gsl::span<const double>& ys,
+      const gsl::span<const double>& zs,
+      const gsl::span<double>& resultXs,
+      const gsl::span<double>& resultYs,
+      const gsl::span<double>& resultZs) const noexcept;
+
   /**
    * @brief The maximum radius in any dimension.
    *
@@ -8,6 +8,7 @@
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 namespace CesiumGeospatial {
 
@@ -82,6 +83,25 @@ public:
    */
   glm::dvec3 project(const Cartographic& cartographic) const noexcept;
 
+  /**
+   * @brief Converts many geodetic positions to geographic X and Y coordinates.
+   *
+   * The positions are given as separate arrays of their coordinates, which
+   * must all have the same size. The results are the X and Y coordinates of
+   * {@link project(const Cartographic&) const}; the heights are not changed
+   * by the projection.
+   *
+   * @param longitudes The longitudes of the positions, in radians.
+   * @param latitudes The latitudes of the positions, in radians.
+   * @param xs The projected X coordinates, in meters.
+   * @param ys The projected Y coordinates, in meters.
+   */
+  void project(
+      const gsl::span<const double>& longitudes,
+      const gsl::span<const double>& latitudes,
+      const gsl::span<double>& xs,
+      const gsl::span<double>& ys) const noexcept;
+
   /**
    * @brief Projects a globe rectangle to geographic coordinates.
    *
@@ -5,6 +5,7 @@
 #include <CesiumGeospatial/Ellipsoid.h>
 
 #include <glm/mat4x4.hpp>
+#include <gsl/span>
 
 #include <optional>
 
@@ -128,6 +129,70 @@ public:
       bool adjustOrientation = true,
       const Ellipsoid& ellipsoid = Ellipsoid::WGS84);
 
+  /**
+   * @brief Sets the new transformations from the coordinate systems of many
+   * anchors to globe-fixed coordinates.
+   *
+   * This is equivalent to calling {@link setAnchorToFixedTransform} on each
+   * anchor, but the ellipsoid normals used to adjust the orientations are
+   * computed for blocks of anchors together, with loops that the compiler
+   * vectorizes. Disjoint ranges of anchors may be updated by separate threads.
+   *
+   * @param anchors The anchors.
+   * @param newAnchorToFixed The new matrices transforming from the coordinate
+   * system of each anchor to the globe-fixed coordinate system. There must be
+   * one for each anchor.
+   * @param adjustOrientation Whether to adjust the orientation of the anchors
+   * based on globe curvature as they move, as described for
+   * {@link setAnchorToFixedTransform}.
+   * @param ellipsoid The ellipsoid of the globe.
+   */
+  static void setAnchorToFixedTransforms(
+      const gsl::span<GlobeAnchor>& anchors,
+      const gsl::span<const glm::dmat4>& newAnchorToFixed,
+      bool adjustOrientation = true,
+      const Ellipsoid& ellipsoid = Ellipsoid::WGS84);
+
+  /**
+   * @brief Gets the transformations from the coordinate systems of many
+   * anchors to the given local-horizontal coordinate system.
+   *
+   * @param localCoordinateSystem The local coordinate system.
+   * @param anchors The anchors.
+   * @param anchorToLocal The transformations of the anchors, one for each
+   * anchor.
+   */
+  static void getAnchorToLocalTransforms(
+      const LocalHorizontalCoordinateSystem& localCoordinateSystem,
+      const gsl::span<const GlobeAnchor>& anchors,
+      const gsl::span<glm::dmat4>& anchorToLocal);
+
+  /**
+   * @brief Sets the globe-fixed transformations of many anchors based on new
+   * transformations from their coordinates to a local-horizontal coordinate
+   * system.
+   *
+   * This is equivalent to calling {@link setAnchorToLocalTransform} on each
+   * anchor, and is computed like {@link setAnchorToFixedTransforms}.
+   *
+   * @param localCoordinateSystem The local coordinate system that is the target
+   * of the transformations.
+   * @param anchors The anchors.
+   * @param newAnchorToLocal The new matrices transforming from the coordinate
+   * system of each anchor to the local coordinate system. There must be one
+   * for each anchor.
+   * @param adjustOrientation Whether to adjust the orientation of the anchors
+   * based on globe curvature as they move, as described for
+   * {@link setAnchorToLocalTransform}.
+   * @param ellipsoid The ellipsoid of the globe.
+   */
+  static void setAnchorToLocalTransforms(
+      const LocalHorizontalCoordinateSystem& localCoordinateSystem,
+      const gsl::span<GlobeAnchor>& anchors,
+      const gsl::span<const glm::dmat4>& newAnchorToLocal,
+      bool adjustOrientation = true,
+      const Ellipsoid& ellipsoid = Ellipsoid::WGS84);
+
 private:
   glm::dmat4 _anchorToFixed;
 };
@@ -5,6 +5,7 @@
 
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 namespace CesiumGeospatial {
 
@@ -34,6 +35,30 @@ public:
   static glm::dmat4x4 eastNorthUpToFixedFrame(
       const glm::dvec3& origin,
       const Ellipsoid& ellipsoid = Ellipsoid::WGS84) noexcept;
+
+  /**
+   * @brief Computes the transformations from east-north-up axes to an
+   * ellipsoid-fixed reference frame at many origins.
+   *
+   * The origins are given as separate arrays of their x, y, and z
+   * coordinates, which must all have the same size as the array of the
+   * transformations. The axes of the origins are computed together in blocks,
+   * with loops that the compiler vectorizes. The transformations are those of
+   * {@link eastNorthUpToFixedFrame}, to within rounding.
+   *
+   * @param xs The x coordinates of the origins.
+   * @param ys The y coordinates of the origins.
+   * @param zs The z coordinates of the origins.
+   * @param frames The transformation matrices.
+   * @param ellipsoid The {@link Ellipsoid} whose fixed frame is used in the
+   * transformation. Default value: {@link Ellipsoid::WGS84}.
+   */
+  static void eastNorthUpToFixedFrames(
+      const gsl::span<const double>& xs,
+      const gsl::span<const double>& ys,
+      const gsl::span<const double>& zs,
+      const gsl::span<glm::dmat4x4>& frames,
+      const Ellipsoid& ellipsoid = Ellipsoid::WGS84) noexcept;
 };
 
 } // namespace CesiumGeospatial
@@ -5,6 +5,7 @@
 
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 namespace CesiumGeospatial {
 class Cartographic;
@@ -150,6 +151,60 @@ public:
    */
   glm::dvec3 ecefPositionToLocal(const glm::dvec3& ecefPosition) const noexcept;
 
+  /**
+   * @brief Converts many positions in the local horizontal coordinate system
+   * managed by this instance to Earth-Centered, Earth-Fixed (ECEF).
+   *
+   * The positions are given as separate arrays of their x, y, and z
+   * coordinates, which must all have the same size, and may be converted in
+   * place. The conversion is a loop that the compiler vectorizes, and
+   * disjoint ranges of positions may be converted from several threads at
+   * once.
+   *
+   * @param xs The x coordinates of the positions in the local coordinate
+   * system.
+   * @param ys The y coordinates of the positions in the local coordinate
+   * system.
+   * @param zs The z coordinates of the positions in the local coordinate
+   * system.
+   * @param ecefXs The x coordinates of the positions in ECEF.
+   * @param ecefYs The y coordinates of the positions in ECEF.
+   * @param ecefZs The z coordinates of the positions in ECEF.
+   */
+  void localPositionsToEcef(
+      const gsl::span<const double>& xs,
+      const gsl::span<const double>& ys,
+      const gsl::span<const double>& zs,
+      const gsl::span<double>& ecefXs,
+      const gsl::span<double>& ecefYs,
+      const gsl::span<double>& ecefZs) const noexcept;
+
+  /**
+   * @brief Converts many positions in the Earth-Centered, Earth-Fixed (ECEF)
+   * coordinate system to the local horizontal coordinate system managed by
+   * this instance.
+   *
+   * The positions are given as separate arrays of their coordinates, as for
+   * {@link localPositionsToEcef}.
+   *
+   * @param ecefXs The x coordinates of the positions in ECEF.
+   * @param ecefYs The y coordinates of the positions in ECEF.
+   * @param ecefZs The z coordinates of the positions in ECEF.
+   * @param xs The x coordinates of the positions in the local coordinate
+   * system.
+   * @param ys The y coordinates of the positions in the local coordinate
+   * system.
+   * @param zs The z coordinates of the positions in the local coordinate
+   * system.
+   */
+  void ecefPositionsToLocal(
+      const gsl::span<const double>& ecefXs,
+      const gsl::span<const double>& ecefYs,
+      const gsl::span<const double>& ecefZs,
+      const gsl::span<double>& xs,
+      const gsl::span<double>& ys,
+      const gsl::span<double>& zs) const noexcept;
+
   /**
    * @brief Converts a direction in the local horizontal coordinate system
    * managed by this instance to Earth-Centered, Earth-Fixed (ECEF).
@@ -7,6 +7,7 @@
 #include "WebMercatorProjection.h"
 
 #include <glm/vec2.hpp>
+#include <gsl/span>
 
 #include <variant>
 
@@ -34,6 +35,27 @@ typedef std::variant<GeographicProjection, WebMercatorProjection> Projection;
 glm::dvec3
 projectPosition(const Projection& projection, const Cartographic& position);
 
+/**
+ * @brief Projects many positions on the globe using the given
+ * {@link Projection}.
+ *
+ * The positions are given as separate arrays of their coordinates, which must
+ * all have the same size. The projection is chosen once for all of the
+ * positions, which are then projected in loops that the compiler vectorizes.
+ *
+ * @param projection The projection.
+ * @param longitudes The longitudes of the positions, in radians.
+ * @param latitudes The latitudes of the positions, in radians.
+ * @param xs The X coordinates of the projected positions.
+ * @param ys The Y coordinates of the projected positions.
+ */
+void projectPositions(
+    const Projection& projection,
+    const gsl::span<const double>& longitudes,
+    const gsl::span<const double>& latitudes,
+    const gsl::span<double>& xs,
+    const gsl::span<double>& ys);
+
 /**
  * @brief Unprojects a position from the globe using the given
  * {@link Projection}.
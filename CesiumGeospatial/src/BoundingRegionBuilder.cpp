@@ -3,16 +3,29 @@
 #include <CesiumGeospatial/Cartographic.h>
 #include <CesiumUtility/Math.h>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
 #include <limits>
 
 using namespace CesiumUtility;
 
 namespace {
 
+constexpr size_t blockSize = 64;
+
 bool isCloseToPole(double latitude, double tolerance) {
   return Math::PiOverTwo - glm::abs(latitude) < tolerance;
 }
 
+// The eastward distance from the west to the east longitude of a range.
+double getLongitudeWidth(double west, double east) {
+  const double width = east - west;
+  return width < 0.0 ? width + Math::TwoPi : width;
+}
+
 } // namespace
 
 namespace CesiumGeospatial {
@@ -71,38 +84,140 @@ bool BoundingRegionBuilder::expandToIncludePosition(
 
   // Only update the longitude range if this position isn't too close to the
   // North or South pole.
-  if (!isCloseToPole(position.latitude, this->_poleTolerance)) {
-    if (this->_longitudeRangeIsEmpty) {
-      this->_rectangle.setWest(position.longitude);
-      this->_rectangle.setEast(position.longitude);
-      this->_longitudeRangeIsEmpty = false;
+  if (!isCloseToPole(position.latitude, this->_poleTolerance) &&
+      this->expandLongitudeToInclude(position)) {
+    modified = true;
+  }
+
+  return modified;
+}
+
+bool BoundingRegionBuilder::expandToIncludePositions(
+    const gsl::span<const double>& longitudes,
+    const gsl::span<const double>& latitudes,
+    const gsl::span<const double>& heights) {
+  const size_t count = longitudes.size();
+  assert(latitudes.size() == count && heights.size() == count);
+
+  bool modified = false;
+
+  for (size_t begin = 0; begin < count; begin += blockSize) {
+    const size_t end = std::min(begin + blockSize, count);
+
+    double south = this->_rectangle.getSouth();
+    double north = this->_rectangle.getNorth();
+    double minimumHeight = this->_minimumHeight;
+    double maximumHeight = this->_maximumHeight;
+    double minimumLongitude = std::numeric_limits<double>::max();
+    double maximumLongitude = std::numeric_limits<double>::lowest();
+
+    for (size_t i = begin; i < end; ++i) {
+      const double longitude = longitudes[i];
+      const double latitude = latitudes[i];
+      const double height = heights[i];
+      const bool isValid = !std::isnan(longitude) && !std::isnan(latitude) &&
+                           !std::isnan(height);
+      const bool hasLongitude =
+          isValid && !isCloseToPole(latitude, this->_poleTolerance);
+
+      south = isValid ? std::min(south, latitude) : south;
+      north = isValid ? std::max(north, latitude) : north;
+      minimumHeight = isValid ? std::min(minimumHeight, height) : minimumHeight;
+      maximumHeight = isValid ? std::max(maximumHeight, height) : maximumHeight;
+      minimumLongitude = hasLongitude ? std::min(minimumLongitude, longitude)
+                                      : minimumLongitude;
+      maximumLongitude = hasLongitude ? std::max(maximumLongitude, longitude)
+                                      : maximumLongitude;
+    }
+
+    if (south < this->_rectangle.getSouth()) {
+      this->_rectangle.setSouth(south);
+      modified = true;
+    }
+
+    if (north > this->_rectangle.getNorth()) {
+      this->_rectangle.setNorth(north);
+      modified = true;
+    }
+
+    if (minimumHeight < this->_minimumHeight) {
+      this->_minimumHeight = minimumHeight;
+      modified = true;
+    }
+
+    if (maximumHeight > this->_maximumHeight) {
+      this->_maximumHeight = maximumHeight;
       modified = true;
-    } else if (!this->_rectangle.contains(position)) {
-      double positionToWestDistance =
-          this->_rectangle.getWest() - position.longitude;
-      if (positionToWestDistance < 0.0) {
-        const double antiMeridianToWest =
-            this->_rectangle.getWest() - (-Math::OnePi);
-        const double positionToAntiMeridian = Math::OnePi - position.longitude;
-        positionToWestDistance = antiMeridianToWest + positionToAntiMeridian;
+    }
+
+    if (minimumLongitude > maximumLongitude) {
+      // None of the positions in this block have a usable longitude.
+      continue;
+    }
+
+    if (!this->_longitudeRangeIsEmpty) {
+      const double west = this->_rectangle.getWest();
+      const double east = this->_rectangle.getEast();
+      const bool isWithinRange =
+          west <= east
+              ? west <= minimumLongitude && maximumLongitude <= east
+              : west <= minimumLongitude || maximumLongitude <= east;
+      if (isWithinRange) {
+        continue;
       }
+    }
 
-      double eastToPositionDistance =
-          position.longitude - this->_rectangle.getEast();
-      if (eastToPositionDistance < 0.0) {
-        const double antiMeridianToPosition =
-            position.longitude - (-Math::OnePi);
-        const double eastToAntiMeridian =
-            Math::OnePi - this->_rectangle.getEast();
-        eastToPositionDistance = antiMeridianToPosition + eastToAntiMeridian;
+    // The longitude range depends on the order of the positions, so it is
+    // expanded by each of them in turn.
+    for (size_t i = begin; i < end; ++i) {
+      const Cartographic position(longitudes[i], latitudes[i], heights[i]);
+      if (std::isnan(position.longitude) || std::isnan(position.latitude) ||
+          std::isnan(position.height) ||
+          isCloseToPole(position.latitude, this->_poleTolerance)) {
+        continue;
       }
 
-      if (positionToWestDistance < eastToPositionDistance) {
-        this->_rectangle.setWest(position.longitude);
-      } else {
-        this->_rectangle.setEast(position.longitude);
+      if (this->expandLongitudeToInclude(position)) {
+        modified = true;
       }
+    }
+  }
 
+  return modified;
+}
+
+bool BoundingRegionBuilder::expandToIncludeCartesianPositions(
+    const gsl::span<const double>& xs,
+    const gsl::span<const double>& ys,
+    const gsl::span<const double>& zs,
+    const Ellipsoid& ellipsoid) {
+  const size_t count = xs.size();
+  assert(ys.size() == count && zs.size() == count);
+
+  std::array<double, blockSize> longitudes;
+  std::array<double, blockSize> latitudes;
+  std::array<double, blockSize> heights;
+
+  bool modified = false;
+
+  for (size_t begin = 0; begin < count; begin += blockSize) {
+    const size_t blockCount = std::min(blockSize, count - begin);
+    const gsl::span<double> blockLongitudes(longitudes.data(), blockCount);
+    const gsl::span<double> blockLatitudes(latitudes.data(), blockCount);
+    const gsl::span<double> blockHeights(heights.data(), blockCount);
+
+    ellipsoid.cartesianToCartographic(
+        xs.subspan(begin, blockCount),
+        ys.subspan(begin, blockCount),
+        zs.subspan(begin, blockCount),
+        blockLongitudes,
+        blockLatitudes,
+        blockHeights);
+
+    if (this->expandToIncludePositions(
+            blockLongitudes,
+            blockLatitudes,
+            blockHeights)) {
       modified = true;
     }
   }
@@ -110,4 +225,114 @@ bool BoundingRegionBuilder::expandToIncludePosition(
   return modified;
 }
 
+bool BoundingRegionBuilder::merge(const BoundingRegionBuilder& other) {
+  bool modified = false;
+
+  if (other._rectangle.getSouth() < this->_rectangle.getSouth()) {
+    this->_rectangle.setSouth(other._rectangle.getSouth());
+    modified = true;
+  }
+
+  if (other._rectangle.getNorth() > this->_rectangle.getNorth()) {
+    this->_rectangle.setNorth(other._rectangle.getNorth());
+    modified = true;
+  }
+
+  if (other._minimumHeight < this->_minimumHeight) {
+    this->_minimumHeight = other._minimumHeight;
+    modified = true;
+  }
+
+  if (other._maximumHeight > this->_maximumHeight) {
+    this->_maximumHeight = other._maximumHeight;
+    modified = true;
+  }
+
+  if (other._longitudeRangeIsEmpty) {
+    return modified;
+  }
+
+  const double otherWest = other._rectangle.getWest();
+  const double otherEast = other._rectangle.getEast();
+
+  if (this->_longitudeRangeIsEmpty) {
+    this->_rectangle.setWest(otherWest);
+    this->_rectangle.setEast(otherEast);
+    this->_longitudeRangeIsEmpty = false;
+    return true;
+  }
+
+  const double west = this->_rectangle.getWest();
+  const double east = this->_rectangle.getEast();
+  const double width = getLongitudeWidth(west, east);
+  const double otherWidth = getLongitudeWidth(otherWest, otherEast);
+
+  // The smallest range that contains both ranges starts at the west end of
+  // one of them, and ends at the east end of one of them.
+  const double widthFromWest =
+      std::max(width, getLongitudeWidth(west, otherWest) + otherWidth);
+  const double widthFromOtherWest =
+      std::max(otherWidth, getLongitudeWidth(otherWest, west) + width);
+
+  double newWest;
+  double newEast;
+  if (std::min(widthFromWest, widthFromOtherWest) >= Math::TwoPi) {
+    newWest = -Math::OnePi;
+    newEast = Math::OnePi;
+  } else if (widthFromWest <= widthFromOtherWest) {
+    newWest = west;
+    newEast = widthFromWest == width ? east : otherEast;
+  } else {
+    newWest = otherWest;
+    newEast = widthFromOtherWest == otherWidth ? otherEast : east;
+  }
+
+  if (newWest != west || newEast != east) {
+    this->_rectangle.setWest(newWest);
+    this->_rectangle.setEast(newEast);
+    modified = true;
+  }
+
+  return modified;
+}
+
+bool BoundingRegionBuilder::expandLongitudeToInclude(
+    const Cartographic& position) {
+  if (this->_longitudeRangeIsEmpty) {
+    this->_rectangle.setWest(position.longitude);
+    this->_rectangle.setEast(position.longitude);
+    this->_longitudeRangeIsEmpty = false;
+    return true;
+  }
+
+  if (this->_rectangle.contains(position)) {
+    return false;
+  }
+
+  double positionToWestDistance =
+      this->_rectangle.getWest() - position.longitude;
+  if (positionToWestDistance < 0.0) {
+    const double antiMeridianToWest =
+        this->_rectangle.getWest() - (-Math::OnePi);
+    const double positionToAntiMeridian = Math::OnePi - position.longitude;
+    positionToWestDistance = antiMeridianToWest + positionToAntiMeridian;
+  }
+
+  double eastToPositionDistance =
+      position.longitude - this->_rectangle.getEast();
+  if (eastToPositionDistance < 0.0) {
+    const double antiMeridianToPosition = position.longitude - (-Math::OnePi);
+    const double eastToAntiMeridian = Math::OnePi - this->_rectangle.getEast();
+    eastToPositionDistance = antiMeridianToPosition + eastToAntiMeridian;
+  }
+
+  if (positionToWestDistance < eastToPositionDistance) {
+    this->_rectangle.setWest(position.longitude);
+  } else {
+    this->_rectangle.setEast(position.longitude);
+  }
+
+  return true;
+}
+
 } // namespace CesiumGeospatial
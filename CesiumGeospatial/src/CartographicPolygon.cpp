@@ -111,90 +111,152 @@ CartographicPolygon::CartographicPolygon(const std::vector<glm::dvec2>& polygon)
       _indices(triangulatePolygon(polygon)),
       _boundingRectangle(computeBoundingRectangle(polygon)) {}
 
-/*static*/ bool CartographicPolygon::rectangleIsWithinPolygons(
-    const CesiumGeospatial::GlobeRectangle& rectangle,
-    const std::vector<CartographicPolygon>& cartographicPolygons) noexcept {
-
-  glm::dvec2 rectangleCorners[] = {
-      glm::dvec2(rectangle.getWest(), rectangle.getSouth()),
-      glm::dvec2(rectangle.getWest(), rectangle.getNorth()),
-      glm::dvec2(rectangle.getEast(), rectangle.getNorth()),
-      glm::dvec2(rectangle.getEast(), rectangle.getSouth())};
-
-  glm::dvec2 rectangleEdges[] = {
-      rectangleCorners[1] - rectangleCorners[0],
-      rectangleCorners[2] - rectangleCorners[1],
-      rectangleCorners[3] - rectangleCorners[2],
-      rectangleCorners[0] - rectangleCorners[3]};
-
-  // Iterate through all polygons.
-  for (size_t i = 0; i < cartographicPolygons.size(); ++i) {
-    const CartographicPolygon& selection = cartographicPolygons[i];
-
-    const std::optional<CesiumGeospatial::GlobeRectangle>&
-        polygonBoundingRectangle = selection.getBoundingRectangle();
-    if (!polygonBoundingRectangle ||
-        !rectangle.computeIntersection(*polygonBoundingRectangle)) {
-      continue;
+namespace {
+
+struct RectangleOutline {
+  explicit RectangleOutline(const GlobeRectangle& rectangle) noexcept
+      : corners{
+            glm::dvec2(rectangle.getWest(), rectangle.getSouth()),
+            glm::dvec2(rectangle.getWest(), rectangle.getNorth()),
+            glm::dvec2(rectangle.getEast(), rectangle.getNorth()),
+            glm::dvec2(rectangle.getEast(), rectangle.getSouth())},
+        edges{
+            corners[1] - corners[0],
+            corners[2] - corners[1],
+            corners[3] - corners[2],
+            corners[0] - corners[3]} {}
+
+  glm::dvec2 corners[4];
+  glm::dvec2 edges[4];
+};
+
+bool pointIsInPolygonTriangles(
+    const glm::dvec2& point,
+    const CartographicPolygon& polygon) noexcept {
+  const std::vector<glm::dvec2>& vertices = polygon.getVertices();
+  const std::vector<uint32_t>& indices = polygon.getIndices();
+  for (size_t j = 2; j < indices.size(); j += 3) {
+    if (IntersectionTests::pointInTriangle2D(
+            point,
+            vertices[indices[j - 2]],
+            vertices[indices[j - 1]],
+            vertices[indices[j]])) {
+      return true;
     }
+  }
+
+  return false;
+}
 
-    const std::vector<glm::dvec2>& vertices = selection.getVertices();
-    const std::vector<uint32_t>& indices = selection.getIndices();
-
-    // First check if an arbitrary point on the bounding globe rectangle is
-    // inside the polygon.
-    bool inside = false;
-    for (size_t j = 2; j < indices.size(); j += 3) {
-      if (IntersectionTests::pointInTriangle2D(
-              rectangleCorners[0],
-              vertices[indices[j - 2]],
-              vertices[indices[j - 1]],
-              vertices[indices[j]])) {
-        inside = true;
-        break;
+bool perimeterIntersectsOutline(
+    const CartographicPolygon& polygon,
+    const RectangleOutline& outline) noexcept {
+  const std::vector<glm::dvec2>& vertices = polygon.getVertices();
+  for (size_t j = 0; j < vertices.size(); ++j) {
+    const glm::dvec2& a = vertices[j];
+    const glm::dvec2& b = vertices[(j + 1) % vertices.size()];
+
+    const glm::dvec2 ba = a - b;
+
+    // Check each rectangle edge.
+    for (size_t k = 0; k < 4; ++k) {
+      const glm::dvec2& cd = outline.edges[k];
+      const glm::dmat2 lineSegmentMatrix(cd, ba);
+      const glm::dvec2 ca = a - outline.corners[k];
+
+      // s and t are calculated such that:
+      // line_intersection = a + t * ab = c + s * cd
+      const glm::dvec2 st = glm::inverse(lineSegmentMatrix) * ca;
+
+      // check that the intersection is within the line segments
+      if (st.x <= 1.0 && st.x >= 0.0 && st.y <= 1.0 && st.y >= 0.0) {
+        return true;
       }
     }
+  }
 
-    // If the arbitrary point was outside, then this polygon does not entirely
-    // cull the tile.
-    if (!inside) {
-      continue;
-    }
+  return false;
+}
 
-    // Check if the polygon perimeter intersects the bounding globe rectangle
-    // edges.
-    bool intersectionFound = false;
-    for (size_t j = 0; j < vertices.size(); ++j) {
-      const glm::dvec2& a = vertices[j];
-      const glm::dvec2& b = vertices[(j + 1) % vertices.size()];
-
-      const glm::dvec2 ba = a - b;
-
-      // Check each rectangle edge.
-      for (size_t k = 0; k < 4; ++k) {
-        const glm::dvec2& cd = rectangleEdges[k];
-        const glm::dmat2 lineSegmentMatrix(cd, ba);
-        const glm::dvec2 ca = a - rectangleCorners[k];
-
-        // s and t are calculated such that:
-        // line_intersection = a + t * ab = c + s * cd
-        const glm::dvec2 st = glm::inverse(lineSegmentMatrix) * ca;
-
-        // check that the intersection is within the line segments
-        if (st.x <= 1.0 && st.x >= 0.0 && st.y <= 1.0 && st.y >= 0.0) {
-          intersectionFound = true;
-          break;
-        }
-      }
+bool outlineIsWithinPolygon(
+    const GlobeRectangle& rectangle,
+    const RectangleOutline& outline,
+    const CartographicPolygon& polygon) noexcept {
+  const std::optional<CesiumGeospatial::GlobeRectangle>&
+      polygonBoundingRectangle = polygon.getBoundingRectangle();
+  if (!polygonBoundingRectangle ||
+      !rectangle.computeIntersection(*polygonBoundingRectangle)) {
+    return false;
+  }
 
-      if (intersectionFound) {
-        break;
-      }
-    }
+  // First check if an arbitrary point on the bounding globe rectangle is
+  // inside the polygon. If it is outside, then this polygon does not entirely
+  // cull the tile.
+  if (!pointIsInPolygonTriangles(outline.corners[0], polygon)) {
+    return false;
+  }
+
+  // If there is no intersection with the perimeter and at least one point is
+  // inside the polygon, the tile is completely inside this polygon.
+  return !perimeterIntersectsOutline(polygon, outline);
+}
+
+bool outlineIsOutsidePolygon(
+    const GlobeRectangle& rectangle,
+    const RectangleOutline& outline,
+    const CartographicPolygon& polygon) noexcept {
+  const std::optional<CesiumGeospatial::GlobeRectangle>&
+      polygonBoundingRectangle = polygon.getBoundingRectangle();
+  if (!polygonBoundingRectangle ||
+      !rectangle.computeIntersection(*polygonBoundingRectangle)) {
+    return true;
+  }
+
+  // Check if an arbitrary point on the polygon is in the globe rectangle.
+  const glm::dvec2& vertex = polygon.getVertices()[0];
+  if (IntersectionTests::pointInTriangle2D(
+          vertex,
+          outline.corners[0],
+          outline.corners[1],
+          outline.corners[2]) ||
+      IntersectionTests::pointInTriangle2D(
+          vertex,
+          outline.corners[0],
+          outline.corners[2],
+          outline.corners[3])) {
+    return false;
+  }
+
+  // Check if an arbitrary point on the bounding globe rectangle is
+  // inside the polygon.
+  if (pointIsInPolygonTriangles(outline.corners[0], polygon)) {
+    return false;
+  }
+
+  // Now we know the rectangle does not fully contain the polygon and the
+  // polygon does not fully contain the rectangle. Now check if the polygon
+  // perimeter intersects the bounding globe rectangle edges.
+  return !perimeterIntersectsOutline(polygon, outline);
+}
+
+} // namespace
 
-    // There is no intersection with the perimeter and at least one point is
-    // inside the polygon so the tile is completely inside this polygon.
-    if (!intersectionFound) {
+bool CartographicPolygon::rectangleIsWithinPolygon(
+    const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept {
+  return outlineIsWithinPolygon(rectangle, RectangleOutline(rectangle), *this);
+}
+
+bool CartographicPolygon::rectangleIsOutsidePolygon(
+    const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept {
+  return outlineIsOutsidePolygon(rectangle, RectangleOutline(rectangle), *this);
+}
+
+/*static*/ bool CartographicPolygon::rectangleIsWithinPolygons(
+    const CesiumGeospatial::GlobeRectangle& rectangle,
+    const std::vector<CartographicPolygon>& cartographicPolygons) noexcept {
+  const RectangleOutline outline(rectangle);
+  for (const CartographicPolygon& polygon : cartographicPolygons) {
+    if (outlineIsWithinPolygon(rectangle, outline, polygon)) {
       return true;
     }
   }
@@ -206,84 +268,11 @@ CartographicPolygon::CartographicPolygon(const std::vector<glm::dvec2>& polygon)
     const CesiumGeospatial::GlobeRectangle& rectangle,
     const std::vector<CesiumGeospatial::CartographicPolygon>&
         cartographicPolygons) noexcept {
-
-  glm::dvec2 rectangleCorners[] = {
-      glm::dvec2(rectangle.getWest(), rectangle.getSouth()),
-      glm::dvec2(rectangle.getWest(), rectangle.getNorth()),
-      glm::dvec2(rectangle.getEast(), rectangle.getNorth()),
-      glm::dvec2(rectangle.getEast(), rectangle.getSouth())};
-
-  glm::dvec2 rectangleEdges[] = {
-      rectangleCorners[1] - rectangleCorners[0],
-      rectangleCorners[2] - rectangleCorners[1],
-      rectangleCorners[3] - rectangleCorners[2],
-      rectangleCorners[0] - rectangleCorners[3]};
-
-  // Iterate through all polygons.
-  for (size_t i = 0; i < cartographicPolygons.size(); ++i) {
-    const CartographicPolygon& selection = cartographicPolygons[i];
-
-    const std::optional<CesiumGeospatial::GlobeRectangle>&
-        polygonBoundingRectangle = selection.getBoundingRectangle();
-    if (!polygonBoundingRectangle ||
-        !rectangle.computeIntersection(*polygonBoundingRectangle)) {
-      continue;
-    }
-
-    const std::vector<glm::dvec2>& vertices = selection.getVertices();
-    const std::vector<uint32_t>& indices = selection.getIndices();
-
-    // Check if an arbitrary point on the polygon is in the globe rectangle.
-    if (IntersectionTests::pointInTriangle2D(
-            vertices[0],
-            rectangleCorners[0],
-            rectangleCorners[1],
-            rectangleCorners[2]) ||
-        IntersectionTests::pointInTriangle2D(
-            vertices[0],
-            rectangleCorners[0],
-            rectangleCorners[2],
-            rectangleCorners[3])) {
+  const RectangleOutline outline(rectangle);
+  for (const CartographicPolygon& polygon : cartographicPolygons) {
+    if (!outlineIsOutsidePolygon(rectangle, outline, polygon)) {
       return false;
     }
-
-    // Check if an arbitrary point on the bounding globe rectangle is
-    // inside the polygon.
-    for (size_t j = 2; j < indices.size(); j += 3) {
-      if (IntersectionTests::pointInTriangle2D(
-              rectangleCorners[0],
-              vertices[indices[j - 2]],
-              vertices[indices[j - 1]],
-              vertices[indices[j]])) {
-        return false;
-      }
-    }
-
-    // Now we know the rectangle does not fully contain the polygon and the
-    // polygon does not fully contain the rectangle. Now check if the polygon
-    // perimeter intersects the bounding globe rectangle edges.
-    for (size_t j = 0; j < vertices.size(); ++j) {
-      const glm::dvec2& a = vertices[j];
-      const glm::dvec2& b = vertices[(j + 1) % vertices.size()];
-
-      const glm::dvec2 ba = a - b;
-
-      // Check each rectangle edge.
-      for (size_t k = 0; k < 4; ++k) {
-        const glm::dvec2& cd = rectangleEdges[k];
-        const glm::dmat2 lineSegmentMatrix(cd, ba);
-        const glm::dvec2 ca = a - rectangleCorners[k];
-
-        // s and t are calculated such that:
-        // line_intersection = a + t * ab = c + s * cd
-        const glm::dvec2 st = glm::inverse(lineSegmentMatrix) * ca;
-
-        // check that the intersection is within the line segments
-        if (st.x <= 1.0 && st.x >= 0.0 && st.y <= 1.0 && st.y >= 0.0) {
-          return false;
-        }
-      }
-    }
   }
 
   return true;
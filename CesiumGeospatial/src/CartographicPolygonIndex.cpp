@@ -0,0 +1,311 @@
+#include "CesiumGeospatial/CartographicPolygonIndex.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace CesiumGeometry;
+using namespace CesiumUtility;
+
+namespace CesiumGeospatial {
+
+namespace {
+
+// The largest number of grid cells along each axis, which bounds the memory
+// used by polygons that cover most of the grid.
+constexpr uint32_t maximumCellsPerAxis = 256;
+
+// Splits a globe rectangle that may cross the antimeridian into the plain
+// rectangles it covers.
+size_t splitAtAntimeridian(
+    const GlobeRectangle& rectangle,
+    Rectangle (&result)[2]) noexcept {
+  if (rectangle.getWest() <= rectangle.getEast()) {
+    result[0] = Rectangle(
+        rectangle.getWest(),
+        rectangle.getSouth(),
+        rectangle.getEast(),
+        rectangle.getNorth());
+    return 1;
+  }
+
+  result[0] = Rectangle(
+      rectangle.getWest(),
+      rectangle.getSouth(),
+      Math::OnePi,
+      rectangle.getNorth());
+  result[1] = Rectangle(
+      -Math::OnePi,
+      rectangle.getSouth(),
+      rectangle.getEast(),
+      rectangle.getNorth());
+  return 2;
+}
+
+uint32_t computeCell(
+    double value,
+    double minimum,
+    double maximum,
+    uint32_t cellCount) noexcept {
+  if (maximum <= minimum) {
+    return 0;
+  }
+
+  const double cell =
+      glm::floor((value - minimum) / (maximum - minimum) * double(cellCount));
+  return uint32_t(glm::clamp(cell, 0.0, double(cellCount - 1)));
+}
+
+// Calls a function with the index of each cell of a grid that a rectangle
+// overlaps, clamping the rectangle to the grid.
+template <typename Function>
+void forEachCell(
+    const Rectangle& gridBounds,
+    uint32_t columns,
+    uint32_t rows,
+    const Rectangle& bounds,
+    Function&& f) {
+  const uint32_t minimumColumn = computeCell(
+      bounds.minimumX,
+      gridBounds.minimumX,
+      gridBounds.maximumX,
+      columns);
+  const uint32_t maximumColumn = computeCell(
+      bounds.maximumX,
+      gridBounds.minimumX,
+      gridBounds.maximumX,
+      columns);
+  const uint32_t minimumRow = computeCell(
+      bounds.minimumY,
+      gridBounds.minimumY,
+      gridBounds.maximumY,
+      rows);
+  const uint32_t maximumRow = computeCell(
+      bounds.maximumY,
+      gridBounds.minimumY,
+      gridBounds.maximumY,
+      rows);
+  for (uint32_t row = minimumRow; row <= maximumRow; ++row) {
+    for (uint32_t column = minimumColumn; column <= maximumColumn; ++column) {
+      f(size_t(row) * columns + column);
+    }
+  }
+}
+
+GlobeRectangle computeTriangleBounds(
+    const glm::dvec2& a,
+    const glm::dvec2& b,
+    const glm::dvec2& c) noexcept {
+  return GlobeRectangle(
+      glm::min(a.x, glm::min(b.x, c.x)),
+      glm::min(a.y, glm::min(b.y, c.y)),
+      glm::max(a.x, glm::max(b.x, c.x)),
+      glm::max(a.y, glm::max(b.y, c.y)));
+}
+
+} // namespace
+
+CartographicPolygonIndex::CartographicPolygonIndex(
+    const std::vector<CartographicPolygon>& polygons)
+    : _polygons(polygons), _triangles(), _polygonGrid(), _triangleGrid() {
+  std::vector<GridEntry> polygonEntries;
+  std::vector<GridEntry> triangleEntries;
+  for (size_t i = 0; i < this->_polygons.size(); ++i) {
+    const CartographicPolygon& polygon = this->_polygons[i];
+    const std::optional<GlobeRectangle>& boundingRectangle =
+        polygon.getBoundingRectangle();
+    if (!boundingRectangle) {
+      continue;
+    }
+
+    Rectangle parts[2];
+    const size_t partCount = splitAtAntimeridian(*boundingRectangle, parts);
+    for (size_t j = 0; j < partCount; ++j) {
+      polygonEntries.push_back({uint32_t(i), parts[j]});
+    }
+
+    const std::vector<glm::dvec2>& vertices = polygon.getVertices();
+    const std::vector<uint32_t>& indices = polygon.getIndices();
+    for (size_t j = 2; j < indices.size(); j += 3) {
+      const GlobeRectangle bounds = computeTriangleBounds(
+          vertices[indices[j - 2]],
+          vertices[indices[j - 1]],
+          vertices[indices[j]]);
+      triangleEntries.push_back(
+          {uint32_t(this->_triangles.size()),
+           Rectangle(
+               bounds.getWest(),
+               bounds.getSouth(),
+               bounds.getEast(),
+               bounds.getNorth())});
+      this->_triangles.emplace_back(uint32_t(i), uint32_t(j - 2));
+    }
+  }
+
+  this->_polygonGrid = buildGrid(polygonEntries);
+  this->_triangleGrid = buildGrid(triangleEntries);
+}
+
+bool CartographicPolygonIndex::rectangleIsWithinPolygons(
+    const GlobeRectangle& rectangle) const {
+  for (uint32_t i : this->_findPolygons(rectangle)) {
+    if (this->_polygons[i].rectangleIsWithinPolygon(rectangle)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool CartographicPolygonIndex::rectangleIsOutsidePolygons(
+    const GlobeRectangle& rectangle) const {
+  for (uint32_t i : this->_findPolygons(rectangle)) {
+    if (!this->_polygons[i].rectangleIsOutsidePolygon(rectangle)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool CartographicPolygonIndex::anyBoundingRectangleIntersects(
+    const GlobeRectangle& rectangle) const {
+  for (uint32_t i : this->_findPolygons(rectangle)) {
+    const std::optional<GlobeRectangle>& boundingRectangle =
+        this->_polygons[i].getBoundingRectangle();
+    if (boundingRectangle &&
+        rectangle.computeIntersection(*boundingRectangle)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::vector<std::array<glm::dvec2, 3>>
+CartographicPolygonIndex::findTriangles(const GlobeRectangle& rectangle) const {
+  std::vector<uint32_t> triangles;
+  findItems(this->_triangleGrid, rectangle, triangles);
+
+  std::vector<std::array<glm::dvec2, 3>> result;
+  for (uint32_t i : triangles) {
+    const auto [polygon, firstIndex] = this->_triangles[i];
+    const std::vector<glm::dvec2>& vertices =
+        this->_polygons[polygon].getVertices();
+    const std::vector<uint32_t>& indices =
+        this->_polygons[polygon].getIndices();
+    const std::array<glm::dvec2, 3> triangle{
+        vertices[indices[firstIndex]],
+        vertices[indices[firstIndex + 1]],
+        vertices[indices[firstIndex + 2]]};
+    if (rectangle.computeIntersection(
+            computeTriangleBounds(triangle[0], triangle[1], triangle[2]))) {
+      result.emplace_back(triangle);
+    }
+  }
+
+  return result;
+}
+
+/*static*/ CartographicPolygonIndex::Grid
+CartographicPolygonIndex::buildGrid(const std::vector<GridEntry>& entries) {
+  Grid grid;
+  if (entries.empty()) {
+    return grid;
+  }
+
+  grid.bounds = entries[0].bounds;
+  for (const GridEntry& entry : entries) {
+    grid.bounds = grid.bounds.computeUnion(entry.bounds);
+  }
+
+  // Aim for about one entry per cell.
+  const uint32_t cellsPerAxis = uint32_t(glm::clamp(
+      std::ceil(std::sqrt(double(entries.size()))),
+      1.0,
+      double(maximumCellsPerAxis)));
+  grid.columns = cellsPerAxis;
+  grid.rows = cellsPerAxis;
+
+  // Count the entries in each cell, then fill in the ranges of each cell.
+  const size_t cellCount = size_t(grid.columns) * grid.rows;
+  grid.cellStarts.resize(cellCount + 1, 0);
+  for (const GridEntry& entry : entries) {
+    forEachCell(
+        grid.bounds,
+        grid.columns,
+        grid.rows,
+        entry.bounds,
+        [&grid](size_t cell) { ++grid.cellStarts[cell + 1]; });
+  }
+
+  for (size_t i = 0; i < cellCount; ++i) {
+    grid.cellStarts[i + 1] += grid.cellStarts[i];
+  }
+
+  std::vector<uint32_t> cellEnds(
+      grid.cellStarts.begin(),
+      grid.cellStarts.end() - 1);
+  grid.items.resize(grid.cellStarts.back());
+  for (const GridEntry& entry : entries) {
+    forEachCell(
+        grid.bounds,
+        grid.columns,
+        grid.rows,
+        entry.bounds,
+        [&grid, &cellEnds, &entry](size_t cell) {
+          grid.items[cellEnds[cell]++] = entry.item;
+        });
+  }
+
+  return grid;
+}
+
+/*static*/ void CartographicPolygonIndex::findItems(
+    const Grid& grid,
+    const GlobeRectangle& rectangle,
+    std::vector<uint32_t>& items) {
+  if (grid.columns == 0) {
+    return;
+  }
+
+  Rectangle parts[2];
+  const size_t partCount = splitAtAntimeridian(rectangle, parts);
+  for (size_t i = 0; i < partCount; ++i) {
+    const Rectangle& part = parts[i];
+    if (part.maximumX < grid.bounds.minimumX ||
+        part.minimumX > grid.bounds.maximumX ||
+        part.maximumY < grid.bounds.minimumY ||
+        part.minimumY > grid.bounds.maximumY) {
+      continue;
+    }
+
+    forEachCell(
+        grid.bounds,
+        grid.columns,
+        grid.rows,
+        part,
+        [&grid, &items](size_t cell) {
+          items.insert(
+              items.end(),
+              grid.items.begin() + grid.cellStarts[cell],
+              grid.items.begin() + grid.cellStarts[cell + 1]);
+        });
+  }
+
+  // An item that covers several cells is listed in each of them.
+  std::sort(items.begin(), items.end());
+  items.erase(std::unique(items.begin(), items.end()), items.end());
+}
+
+std::vector<uint32_t> CartographicPolygonIndex::_findPolygons(
+    const GlobeRectangle& rectangle) const {
+  std::vector<uint32_t> polygons;
+  findItems(this->_polygonGrid, rectangle, polygons);
+  return polygons;
+}
+
+} // namespace CesiumGeospatial
@@ -5,10 +5,132 @@
 #include <glm/geometric.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
 using namespace CesiumUtility;
 
 namespace CesiumGeospatial {
 
+namespace {
+
+// The number of positions that are converted together by the batch
+// functions, which is small enough for their scratch arrays to stay in the
+// cache.
+constexpr size_t batchSize = 64;
+
+using BatchArray = std::array<double, batchSize>;
+
+// The batched scaleToGeodeticSurface of `count` positions. The Newton
+// iterations of all of the positions run together, in loops without
+// branches, and the multipliers of each position stop changing once it has
+// converged, so that the result is the same as that of the scalar function.
+void scaleBlockToGeodeticSurface(
+    const glm::dvec3& oneOverRadii,
+    const glm::dvec3& oneOverRadiiSquared,
+    double centerToleranceSquared,
+    size_t count,
+    const double* pXs,
+    const double* pYs,
+    const double* pZs,
+    double* pResultXs,
+    double* pResultYs,
+    double* pResultZs) noexcept {
+  BatchArray x2s, y2s, z2s;
+  BatchArray lambdas, corrections;
+  BatchArray xMultipliers, yMultipliers, zMultipliers;
+  std::array<bool, batchSize> active;
+
+  for (size_t i = 0; i < count; ++i) {
+    const double positionX = pXs[i];
+    const double positionY = pYs[i];
+    const double positionZ = pZs[i];
+
+    const double x2 = positionX * positionX * oneOverRadii.x * oneOverRadii.x;
+    const double y2 = positionY * positionY * oneOverRadii.y * oneOverRadii.y;
+    const double z2 = positionZ * positionZ * oneOverRadii.z * oneOverRadii.z;
+    x2s[i] = x2;
+    y2s[i] = y2;
+    z2s[i] = z2;
+
+    const double squaredNorm = x2 + y2 + z2;
+    const double ratio = std::sqrt(1.0 / squaredNorm);
+
+    const double gradientX = positionX * ratio * oneOverRadiiSquared.x * 2.0;
+    const double gradientY = positionY * ratio * oneOverRadiiSquared.y * 2.0;
+    const double gradientZ = positionZ * ratio * oneOverRadiiSquared.z * 2.0;
+    const double positionLength = std::sqrt(
+        positionX * positionX + positionY * positionY + positionZ * positionZ);
+    const double gradientLength = std::sqrt(
+        gradientX * gradientX + gradientY * gradientY + gradientZ * gradientZ);
+    lambdas[i] = ((1.0 - ratio) * positionLength) / (0.5 * gradientLength);
+    corrections[i] = 0.0;
+
+    // A position near the center is scaled radially, since the iteration will
+    // not converge, and has no result at the center itself.
+    const bool isNearCenter = squaredNorm < centerToleranceSquared;
+    const double centerMultiplier =
+        std::isfinite(ratio) ? ratio : std::numeric_limits<double>::quiet_NaN();
+    active[i] = !isNearCenter;
+    xMultipliers[i] = centerMultiplier;
+    yMultipliers[i] = centerMultiplier;
+    zMultipliers[i] = centerMultiplier;
+  }
+
+  bool anyActive = std::any_of(
+      active.begin(),
+      active.begin() + static_cast<std::ptrdiff_t>(count),
+      [](bool isActive) { return isActive; });
+  while (anyActive) {
+    anyActive = false;
+    for (size_t i = 0; i < count; ++i) {
+      const bool isActive = active[i];
+      const double lambda = lambdas[i] - corrections[i];
+
+      const double xMultiplier = 1.0 / (1.0 + lambda * oneOverRadiiSquared.x);
+      const double yMultiplier = 1.0 / (1.0 + lambda * oneOverRadiiSquared.y);
+      const double zMultiplier = 1.0 / (1.0 + lambda * oneOverRadiiSquared.z);
+
+      const double xMultiplier2 = xMultiplier * xMultiplier;
+      const double yMultiplier2 = yMultiplier * yMultiplier;
+      const double zMultiplier2 = zMultiplier * zMultiplier;
+
+      const double xMultiplier3 = xMultiplier2 * xMultiplier;
+      const double yMultiplier3 = yMultiplier2 * yMultiplier;
+      const double zMultiplier3 = zMultiplier2 * zMultiplier;
+
+      const double func = x2s[i] * xMultiplier2 + y2s[i] * yMultiplier2 +
+                          z2s[i] * zMultiplier2 - 1.0;
+      const double denominator =
+          x2s[i] * xMultiplier3 * oneOverRadiiSquared.x +
+          y2s[i] * yMultiplier3 * oneOverRadiiSquared.y +
+          z2s[i] * zMultiplier3 * oneOverRadiiSquared.z;
+
+      lambdas[i] = isActive ? lambda : lambdas[i];
+      corrections[i] = isActive ? func / (-2.0 * denominator) : corrections[i];
+      xMultipliers[i] = isActive ? xMultiplier : xMultipliers[i];
+      yMultipliers[i] = isActive ? yMultiplier : yMultipliers[i];
+      zMultipliers[i] = isActive ? zMultiplier : zMultipliers[i];
+
+      const bool stillActive = isActive && std::abs(func) > Math::Epsilon12;
+      active[i] = stillActive;
+      anyActive |= stillActive;
+    }
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    pResultXs[i] = pXs[i] * xMultipliers[i];
+    pResultYs[i] = pYs[i] * yMultipliers[i];
+    pResultZs[i] = pZs[i] * zMultipliers[i];
+  }
+}
+
+} // namespace
+
 const Ellipsoid Ellipsoid::WGS84(6378137.0, 6378137.0, 6356752.3142451793);
 
 glm::dvec3
@@ -145,4 +267,143 @@ Ellipsoid::scaleToGeodeticSurface(const glm::dvec3& cartesian) const noexcept {
       positionZ * zMultiplier);
 }
 
+void Ellipsoid::geodeticSurfaceNormal(
+    const gsl::span<const double>& xs,
+    const gsl::span<const double>& ys,
+    const gsl::span<const double>& zs,
+    const gsl::span<double>& normalXs,
+    const gsl::span<double>& normalYs,
+    const gsl::span<double>& normalZs) const noexcept {
+  const size_t count = xs.size();
+  assert(ys.size() == count && zs.size() == count);
+  assert(normalXs.size() == count);
+  assert(normalYs.size() == count && normalZs.size() == count);
+
+  const glm::dvec3& scale = this->_oneOverRadiiSquared;
+  for (size_t i = 0; i < count; ++i) {
+    const double x = xs[i] * scale.x;
+    const double y = ys[i] * scale.y;
+    const double z = zs[i] * scale.z;
+    const double oneOverLength = 1.0 / std::sqrt(x * x + y * y + z * z);
+    normalXs[i] = x * oneOverLength;
+    normalYs[i] = y * oneOverLength;
+    normalZs[i] = z * oneOverLength;
+  }
+}
+
+void Ellipsoid::cartographicToCartesian(
+    const gsl::span<const double>& longitudes,
+    const gsl::span<const double>& latitudes,
+    const gsl::span<const double>& heights,
+    const gsl::span<double>& xs,
+    const gsl::span<double>& ys,
+    const gsl::span<double>& zs) const noexcept {
+  const size_t count = longitudes.size();
+  assert(latitudes.size() == count && heights.size() == count);
+  assert(xs.size() == count && ys.size() == count && zs.size() == count);
+
+  // The normals are computed first, in a loop of their own, because the
+  // trigonometric functions are not vectorized. They are already of unit
+  // length, so they are not normalized again.
+  for (size_t i = 0; i < count; ++i) {
+    const double cosLatitude = std::cos(latitudes[i]);
+    xs[i] = cosLatitude * std::cos(longitudes[i]);
+    ys[i] = cosLatitude * std::sin(longitudes[i]);
+    zs[i] = std::sin(latitudes[i]);
+  }
+
+  const glm::dvec3& radiiSquared = this->_radiiSquared;
+  for (size_t i = 0; i < count; ++i) {
+    const double n0 = xs[i];
+    const double n1 = ys[i];
+    const double n2 = zs[i];
+    const double k0 = radiiSquared.x * n0;
+    const double k1 = radiiSquared.y * n1;
+    const double k2 = radiiSquared.z * n2;
+    const double oneOverGamma = 1.0 / std::sqrt(n0 * k0 + n1 * k1 + n2 * k2);
+    xs[i] = k0 * oneOverGamma + n0 * heights[i];
+    ys[i] = k1 * oneOverGamma + n1 * heights[i];
+    zs[i] = k2 * oneOverGamma + n2 * heights[i];
+  }
+}
+
+void Ellipsoid::cartesianToCartographic(
+    const gsl::span<const double>& xs,
+    const gsl::span<const double>& ys,
+    const gsl::span<const double>& zs,
+    const gsl::span<double>& longitudes,
+    const gsl::span<double>& latitudes,
+    const gsl::span<double>& heights) const noexcept {
+  const size_t count = xs.size();
+  assert(ys.size() == count && zs.size() == count);
+  assert(longitudes.size() == count);
+  assert(latitudes.size() == count && heights.size() == count);
+
+  BatchArray surfaceXs, surfaceYs, surfaceZs;
+  for (size_t begin = 0; begin < count; begin += batchSize) {
+    const size_t blockCount = std::min(batchSize, count - begin);
+    const double* pXs = xs.data() + begin;
+    const double* pYs = ys.data() + begin;
+    const double* pZs = zs.data() + begin;
+    scaleBlockToGeodeticSurface(
+        this->_oneOverRadii,
+        this->_oneOverRadiiSquared,
+        this->_centerToleranceSquared,
+        blockCount,
+        pXs,
+        pYs,
+        pZs,
+        surfaceXs.data(),
+        surfaceYs.data(),
+        surfaceZs.data());
+
+    double* pLongitudes = longitudes.data() + begin;
+    double* pLatitudes = latitudes.data() + begin;
+    double* pHeights = heights.data() + begin;
+    const glm::dvec3& scale = this->_oneOverRadiiSquared;
+    for (size_t i = 0; i < blockCount; ++i) {
+      const double x = surfaceXs[i] * scale.x;
+      const double y = surfaceYs[i] * scale.y;
+      const double z = surfaceZs[i] * scale.z;
+      const double oneOverLength = 1.0 / std::sqrt(x * x + y * y + z * z);
+
+      const double hX = pXs[i] - surfaceXs[i];
+      const double hY = pYs[i] - surfaceYs[i];
+      const double hZ = pZs[i] - surfaceZs[i];
+      const double dot = hX * pXs[i] + hY * pYs[i] + hZ * pZs[i];
+
+      pLongitudes[i] = std::atan2(y * oneOverLength, x * oneOverLength);
+      pLatitudes[i] = std::asin(z * oneOverLength);
+      pHeights[i] = Math::sign(dot) * std::sqrt(hX * hX + hY * hY + hZ * hZ);
+    }
+  }
+}
+
+void Ellipsoid::scaleToGeodeticSurface(
+    const gsl::span<const double>& xs,
+    const gsl::span<const double>& ys,
+    const gsl::span<const double>& zs,
+    const gsl::span<double>& resultXs,
+    const gsl::span<double>& resultYs,
+    const gsl::span<double>& resultZs) const noexcept {
+  const size_t count = xs.size();
+  assert(ys.size() == count && zs.size() == count);
+  assert(resultXs.size() == count);
+  assert(resultYs.size() == count && resultZs.size() == count);
+
+  for (size_t begin = 0; begin < count; begin += batchSize) {
+    scaleBlockToGeodeticSurface(
+        this->_oneOverRadii,
+        this->_oneOverRadiiSquared,
+        this->_centerToleranceSquared,
+        std::min(batchSize, count - begin),
+        xs.data() + begin,
+        ys.data() + begin,
+        zs.data() + begin,
+        resultXs.data() + begin,
+        resultYs.data() + begin,
+        resultZs.data() + begin);
+  }
+}
+
 } // namespace CesiumGeospatial
@@ -4,6 +4,8 @@
 
 #include <CesiumUtility/Math.h>
 
+#include <cassert>
+
 namespace CesiumGeospatial {
 
 GeographicProjection::GeographicProjection(const Ellipsoid& ellipsoid) noexcept
@@ -20,6 +22,22 @@ GeographicProjection::project(const Cartographic& cartographic) const noexcept {
       cartographic.height);
 }
 
+void GeographicProjection::project(
+    const gsl::span<const double>& longitudes,
+    const gsl::span<const double>& latitudes,
+    const gsl::span<double>& xs,
+    const gsl::span<double>& ys) const noexcept {
+  const size_t count = longitudes.size();
+  assert(latitudes.size() == count);
+  assert(xs.size() == count && ys.size() == count);
+
+  const double semimajorAxis = this->_semimajorAxis;
+  for (size_t i = 0; i < count; ++i) {
+    xs[i] = longitudes[i] * semimajorAxis;
+    ys[i] = latitudes[i] * semimajorAxis;
+  }
+}
+
 CesiumGeometry::Rectangle GeographicProjection::project(
     const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept {
   const glm::dvec3 sw = this->project(rectangle.getSouthwest());
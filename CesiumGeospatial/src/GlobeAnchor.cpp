@@ -4,19 +4,17 @@
 #include <glm/gtx/quaternion.hpp>
 #include <glm/vec3.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+
 namespace {
 
-glm::dmat4 adjustOrientationForMove(
-    const CesiumGeospatial::Ellipsoid& ellipsoid,
-    const glm::dvec3& oldPosition,
-    const glm::dvec3& newPosition,
+glm::dmat4 rotateForNormals(
+    const glm::dvec3& oldNormal,
+    const glm::dvec3& newNormal,
     const glm::dmat4& anchorToFixed) {
-  if (oldPosition == newPosition)
-    return anchorToFixed;
-
-  glm::dvec3 oldNormal = ellipsoid.geodeticSurfaceNormal(oldPosition);
-  glm::dvec3 newNormal = ellipsoid.geodeticSurfaceNormal(newPosition);
-
   glm::dmat3 ellipsoidNormalRotation =
       glm::mat3_cast(glm::rotation(oldNormal, newNormal));
   glm::dmat3 newRotationScale =
@@ -29,6 +27,19 @@ glm::dmat4 adjustOrientationForMove(
       anchorToFixed[3]);
 }
 
+glm::dmat4 adjustOrientationForMove(
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    const glm::dvec3& oldPosition,
+    const glm::dvec3& newPosition,
+    const glm::dmat4& anchorToFixed) {
+  if (oldPosition == newPosition)
+    return anchorToFixed;
+
+  glm::dvec3 oldNormal = ellipsoid.geodeticSurfaceNormal(oldPosition);
+  glm::dvec3 newNormal = ellipsoid.geodeticSurfaceNormal(newPosition);
+  return rotateForNormals(oldNormal, newNormal, anchorToFixed);
+}
+
 } // namespace
 
 namespace CesiumGeospatial {
@@ -86,4 +97,118 @@ void GlobeAnchor::setAnchorToLocalTransform(
       ellipsoid);
 }
 
+/*static*/ void GlobeAnchor::setAnchorToFixedTransforms(
+    const gsl::span<GlobeAnchor>& anchors,
+    const gsl::span<const glm::dmat4>& newAnchorToFixed,
+    bool adjustOrientation,
+    const Ellipsoid& ellipsoid) {
+  const size_t count = anchors.size();
+  assert(newAnchorToFixed.size() == count);
+
+  if (!adjustOrientation) {
+    for (size_t i = 0; i < count; ++i) {
+      anchors[i]._anchorToFixed = newAnchorToFixed[i];
+    }
+    return;
+  }
+
+  // The old and new positions of a block of anchors are gathered into arrays
+  // of their coordinates so that their normals are computed together.
+  constexpr size_t blockSize = 64;
+  using BlockArray = std::array<double, blockSize>;
+  BlockArray oldXs, oldYs, oldZs, newXs, newYs, newZs;
+  BlockArray oldNormalXs, oldNormalYs, oldNormalZs;
+  BlockArray newNormalXs, newNormalYs, newNormalZs;
+
+  const auto first = [](BlockArray& values, size_t blockCount) {
+    return gsl::span<double>(values.data(), blockCount);
+  };
+
+  for (size_t begin = 0; begin < count; begin += blockSize) {
+    const size_t blockCount = std::min(blockSize, count - begin);
+
+    for (size_t i = 0; i < blockCount; ++i) {
+      const glm::dvec4& oldPosition = anchors[begin + i]._anchorToFixed[3];
+      const glm::dvec4& newPosition = newAnchorToFixed[begin + i][3];
+      oldXs[i] = oldPosition.x;
+      oldYs[i] = oldPosition.y;
+      oldZs[i] = oldPosition.z;
+      newXs[i] = newPosition.x;
+      newYs[i] = newPosition.y;
+      newZs[i] = newPosition.z;
+    }
+
+    ellipsoid.geodeticSurfaceNormal(
+        first(oldXs, blockCount),
+        first(oldYs, blockCount),
+        first(oldZs, blockCount),
+        first(oldNormalXs, blockCount),
+        first(oldNormalYs, blockCount),
+        first(oldNormalZs, blockCount));
+    ellipsoid.geodeticSurfaceNormal(
+        first(newXs, blockCount),
+        first(newYs, blockCount),
+        first(newZs, blockCount),
+        first(newNormalXs, blockCount),
+        first(newNormalYs, blockCount),
+        first(newNormalZs, blockCount));
+
+    for (size_t i = 0; i < blockCount; ++i) {
+      GlobeAnchor& anchor = anchors[begin + i];
+      const glm::dmat4& anchorToFixed = newAnchorToFixed[begin + i];
+      const glm::dvec3 oldPosition(anchor._anchorToFixed[3]);
+      if (oldPosition == glm::dvec3(anchorToFixed[3])) {
+        anchor._anchorToFixed = anchorToFixed;
+        continue;
+      }
+
+      anchor._anchorToFixed = rotateForNormals(
+          glm::dvec3(oldNormalXs[i], oldNormalYs[i], oldNormalZs[i]),
+          glm::dvec3(newNormalXs[i], newNormalYs[i], newNormalZs[i]),
+          anchorToFixed);
+    }
+  }
+}
+
+/*static*/ void GlobeAnchor::getAnchorToLocalTransforms(
+    const LocalHorizontalCoordinateSystem& localCoordinateSystem,
+    const gsl::span<const GlobeAnchor>& anchors,
+    const gsl::span<glm::dmat4>& anchorToLocal) {
+  assert(anchorToLocal.size() == anchors.size());
+
+  const glm::dmat4& ecefToLocal =
+      localCoordinateSystem.getEcefToLocalTransformation();
+  for (size_t i = 0; i < anchors.size(); ++i) {
+    anchorToLocal[i] = ecefToLocal * anchors[i]._anchorToFixed;
+  }
+}
+
+/*static*/ void GlobeAnchor::setAnchorToLocalTransforms(
+    const LocalHorizontalCoordinateSystem& localCoordinateSystem,
+    const gsl::span<GlobeAnchor>& anchors,
+    const gsl::span<const glm::dmat4>& newAnchorToLocal,
+    bool adjustOrientation,
+    const Ellipsoid& ellipsoid) {
+  const size_t count = anchors.size();
+  assert(newAnchorToLocal.size() == count);
+
+  constexpr size_t blockSize = 64;
+  std::array<glm::dmat4, blockSize> newAnchorToFixed;
+
+  const glm::dmat4& localToEcef =
+      localCoordinateSystem.getLocalToEcefTransformation();
+  for (size_t begin = 0; begin < count; begin += blockSize) {
+    const size_t blockCount = std::min(blockSize, count - begin);
+    for (size_t i = 0; i < blockCount; ++i) {
+      newAnchorToFixed[i] = localToEcef * newAnchorToLocal[begin + i];
+    }
+
+    setAnchorToFixedTransforms(
+        anchors.subspan(begin, blockCount),
+        gsl::span<const glm::dmat4>(newAnchorToFixed.data(), blockCount),
+        adjustOrientation,
+        ellipsoid);
+  }
+}
+
 } // namespace CesiumGeospatial
@@ -4,6 +4,12 @@
 
 #include <glm/gtc/epsilon.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
 using namespace CesiumUtility;
 
 namespace CesiumGeospatial {
@@ -42,4 +48,61 @@ namespace CesiumGeospatial {
       glm::dvec4(origin, 1.0));
 }
 
+/*static*/ void GlobeTransforms::eastNorthUpToFixedFrames(
+    const gsl::span<const double>& xs,
+    const gsl::span<const double>& ys,
+    const gsl::span<const double>& zs,
+    const gsl::span<glm::dmat4x4>& frames,
+    const Ellipsoid& ellipsoid /*= Ellipsoid::WGS84*/) noexcept {
+  const size_t count = xs.size();
+  assert(ys.size() == count && zs.size() == count);
+  assert(frames.size() == count);
+
+  constexpr size_t blockSize = 64;
+  std::array<double, blockSize> upXs, upYs, upZs;
+  std::array<double, blockSize> eastXs, eastYs;
+
+  for (size_t begin = 0; begin < count; begin += blockSize) {
+    const size_t blockCount = std::min(blockSize, count - begin);
+    const gsl::span<const double> blockXs = xs.subspan(begin, blockCount);
+    const gsl::span<const double> blockYs = ys.subspan(begin, blockCount);
+
+    ellipsoid.geodeticSurfaceNormal(
+        blockXs,
+        blockYs,
+        zs.subspan(begin, blockCount),
+        gsl::span<double>(upXs.data(), blockCount),
+        gsl::span<double>(upYs.data(), blockCount),
+        gsl::span<double>(upZs.data(), blockCount));
+
+    for (size_t i = 0; i < blockCount; ++i) {
+      const double x = blockXs[i];
+      const double y = blockYs[i];
+      const double oneOverLength = 1.0 / std::sqrt(x * x + y * y);
+      eastXs[i] = -y * oneOverLength;
+      eastYs[i] = x * oneOverLength;
+    }
+
+    for (size_t i = 0; i < blockCount; ++i) {
+      const size_t index = begin + i;
+      const glm::dvec3 origin(xs[index], ys[index], zs[index]);
+
+      // The origins at the center and at the poles have frames of their own.
+      if (Math::equalsEpsilon(origin.x, 0.0, Math::Epsilon14) &&
+          Math::equalsEpsilon(origin.y, 0.0, Math::Epsilon14)) {
+        frames[index] = eastNorthUpToFixedFrame(origin, ellipsoid);
+        continue;
+      }
+
+      const glm::dvec3 up(upXs[i], upYs[i], upZs[i]);
+      const glm::dvec3 east(eastXs[i], eastYs[i], 0.0);
+      frames[index] = glm::dmat4x4(
+          glm::dvec4(east, 0.0),
+          glm::dvec4(glm::cross(up, east), 0.0),
+          glm::dvec4(up, 0.0),
+          glm::dvec4(origin, 1.0));
+    }
+  }
+}
+
 } // namespace CesiumGeospatial
@@ -1,43 +1,120 @@
 #include "HilbertOrder.h"
 
+#include <array>
 #include <cassert>
 
 using namespace CesiumGeospatial;
 
 namespace {
 
-void rotate(uint32_t n, uint32_t& x, uint32_t& y, bool rx, bool ry) {
-  if (ry) {
-    return;
-  }
+// The curve is traversed four bits of each coordinate, and so eight bits of
+// the index, at a time, with lookup tables. The orientation of the curve in a
+// block is a combination of swapping the coordinates and inverting their
+// bits. These commute, so an orientation is stored as two flags.
+constexpr uint32_t swapFlag = 1;
+constexpr uint32_t invertFlag = 2;
+constexpr uint32_t bitsPerStep = 4;
+constexpr uint32_t coordinateMask = (1U << bitsPerStep) - 1;
+constexpr uint32_t indexMask = (1U << (2 * bitsPerStep)) - 1;
+
+struct LookupTables {
+  // Indexed by the orientation, x, and y, as `o << 8 | x << 4 | y`, and
+  // giving the next orientation and the index, as `o << 8 | index`.
+  std::array<uint16_t, 1024> encode;
+
+  // Indexed by the orientation and the index, as `o << 8 | index`, and giving
+  // the next orientation, x, and y, as `o << 8 | x << 4 | y`.
+  std::array<uint16_t, 1024> decode;
+};
+
+constexpr LookupTables createLookupTables() {
+  LookupTables tables{};
+  for (uint32_t orientation = 0; orientation < 4; ++orientation) {
+    for (uint32_t x = 0; x <= coordinateMask; ++x) {
+      for (uint32_t y = 0; y <= coordinateMask; ++y) {
+        uint32_t current = orientation;
+        uint32_t index = 0;
+        for (uint32_t bit = bitsPerStep; bit-- > 0;) {
+          uint32_t rx = (x >> bit) & 1;
+          uint32_t ry = (y >> bit) & 1;
+          if ((current & swapFlag) != 0) {
+            const uint32_t t = rx;
+            rx = ry;
+            ry = t;
+          }
+          if ((current & invertFlag) != 0) {
+            rx ^= 1;
+            ry ^= 1;
+          }
 
-  if (rx) {
-    x = n - 1 - x;
-    y = n - 1 - y;
+          index = (index << 2) | ((3 * rx) ^ ry);
+
+          if (ry == 0) {
+            current ^= rx == 1 ? swapFlag | invertFlag : swapFlag;
+          }
+        }
+
+        tables.encode[orientation << 8 | x << bitsPerStep | y] =
+            uint16_t(current << 8 | index);
+        tables.decode[orientation << 8 | index] =
+            uint16_t(current << 8 | x << bitsPerStep | y);
+      }
+    }
   }
+  return tables;
+}
 
-  uint32_t t = x;
-  x = y;
-  y = t;
+constexpr LookupTables lookupTables = createLookupTables();
+
+// The levels of a curve are padded with zero bits above its coordinates up to
+// a whole number of steps. Each of those bits swaps the orientation, so the
+// curve starts in the orientation that undoes them.
+uint32_t getStartOrientation(uint32_t steps, uint32_t level) {
+  return (steps * bitsPerStep - level) & swapFlag;
 }
 
 } // namespace
 
 /*static*/ uint64_t
 HilbertOrder::encode2D(uint32_t level, uint32_t x, uint32_t y) {
-  uint32_t n = 1U << level;
+  assert(level < 32);
+  assert(x < (1U << level) && y < (1U << level));
 
-  assert(x < n && y < n);
+  const uint32_t steps = (level + bitsPerStep - 1) / bitsPerStep;
+  uint32_t orientation = getStartOrientation(steps, level);
 
   uint64_t index = 0;
+  for (uint32_t step = steps; step-- > 0;) {
+    const uint32_t shift = step * bitsPerStep;
+    const uint32_t value = lookupTables.encode
+                               [orientation << 8 |
+                                ((x >> shift) & coordinateMask) << bitsPerStep |
+                                ((y >> shift) & coordinateMask)];
+    index = index << (2 * bitsPerStep) | (value & indexMask);
+    orientation = value >> 8;
+  }
 
-  for (uint64_t s = n >> 1; s > 0; s >>= 1) {
-    bool rx = (x & s) > 0;
-    bool ry = (y & s) > 0;
+  return index;
+}
 
-    index += ((3ULL * uint64_t(rx)) ^ uint64_t(ry)) * s * s;
-    rotate(n, x, y, rx, ry);
+/*static*/ glm::uvec2
+HilbertOrder::decode2D(uint32_t level, uint64_t index) {
+  assert(level < 32);
+  assert(index < (uint64_t(1) << (2 * level)));
+
+  const uint32_t steps = (level + bitsPerStep - 1) / bitsPerStep;
+  uint32_t orientation = getStartOrientation(steps, level);
+
+  glm::uvec2 result(0);
+  for (uint32_t step = steps; step-- > 0;) {
+    const uint32_t shift = step * 2 * bitsPerStep;
+    const uint32_t value =
+        lookupTables.decode[orientation << 8 | ((index >> shift) & indexMask)];
+    result.x = result.x << bitsPerStep |
+               ((value >> bitsPerStep) & coordinateMask);
+    result.y = result.y << bitsPerStep | (value & coordinateMask);
+    orientation = value >> 8;
   }
 
-  return index;
+  return result;
 }
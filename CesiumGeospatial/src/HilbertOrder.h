@@ -1,5 +1,7 @@
 #pragma once
 
+#include <glm/vec2.hpp>
+
 #include <cstdint>
 
 namespace CesiumGeospatial {
@@ -7,6 +9,7 @@ namespace CesiumGeospatial {
 class HilbertOrder {
 public:
   static uint64_t encode2D(uint32_t level, uint32_t x, uint32_t y);
+  static glm::uvec2 decode2D(uint32_t level, uint64_t index);
 };
 
 } // namespace CesiumGeospatial
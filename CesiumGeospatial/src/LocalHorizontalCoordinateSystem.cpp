@@ -5,6 +5,9 @@
 #include <glm/gtc/matrix_inverse.hpp>
 #include <glm/mat3x3.hpp>
 
+#include <cassert>
+#include <cstddef>
+
 using namespace CesiumGeospatial;
 
 namespace {
@@ -44,6 +47,39 @@ glm::dvec3 directionToEnuVector(LocalDirection direction) {
   }
 }
 
+// Transforms positions given as arrays of their coordinates by an affine
+// transformation. Each position is read before it is written, so that the
+// positions may be transformed in place.
+void transformPositions(
+    const glm::dmat4& transform,
+    const gsl::span<const double>& xs,
+    const gsl::span<const double>& ys,
+    const gsl::span<const double>& zs,
+    const gsl::span<double>& resultXs,
+    const gsl::span<double>& resultYs,
+    const gsl::span<double>& resultZs) noexcept {
+  const size_t count = xs.size();
+  assert(ys.size() == count && zs.size() == count);
+  assert(resultXs.size() == count);
+  assert(resultYs.size() == count && resultZs.size() == count);
+
+  const glm::dvec3 column0(transform[0]);
+  const glm::dvec3 column1(transform[1]);
+  const glm::dvec3 column2(transform[2]);
+  const glm::dvec3 translation(transform[3]);
+  for (size_t i = 0; i < count; ++i) {
+    const double x = xs[i];
+    const double y = ys[i];
+    const double z = zs[i];
+    resultXs[i] =
+        column0.x * x + column1.x * y + column2.x * z + translation.x;
+    resultYs[i] =
+        column0.y * x + column1.y * y + column2.y * z + translation.y;
+    resultZs[i] =
+        column0.z * x + column1.z * y + column2.z * z + translation.z;
+  }
+}
+
 } // namespace
 
 LocalHorizontalCoordinateSystem::LocalHorizontalCoordinateSystem(
@@ -107,6 +143,26 @@ glm::dvec3 LocalHorizontalCoordinateSystem::ecefPositionToLocal(
   return glm::dvec3(this->_ecefToLocal * glm::dvec4(ecefPosition, 1.0));
 }
 
+void LocalHorizontalCoordinateSystem::localPositionsToEcef(
+    const gsl::span<const double>& xs,
+    const gsl::span<const double>& ys,
+    const gsl::span<const double>& zs,
+    const gsl::span<double>& ecefXs,
+    const gsl::span<double>& ecefYs,
+    const gsl::span<double>& ecefZs) const noexcept {
+  transformPositions(this->_localToEcef, xs, ys, zs, ecefXs, ecefYs, ecefZs);
+}
+
+void LocalHorizontalCoordinateSystem::ecefPositionsToLocal(
+    const gsl::span<const double>& ecefXs,
+    const gsl::span<const double>& ecefYs,
+    const gsl::span<const double>& ecefZs,
+    const gsl::span<double>& xs,
+    const gsl::span<double>& ys,
+    const gsl::span<double>& zs) const noexcept {
+  transformPositions(this->_ecefToLocal, ecefXs, ecefYs, ecefZs, xs, ys, zs);
+}
+
 glm::dvec3 LocalHorizontalCoordinateSystem::localDirectionToEcef(
     const glm::dvec3& localDirection) const noexcept {
   return glm::dvec3(this->_localToEcef * glm::dvec4(localDirection, 0.0));
@@ -22,6 +22,19 @@ projectPosition(const Projection& projection, const Cartographic& position) {
   return std::visit(Operation{position}, projection);
 }
 
+void projectPositions(
+    const Projection& projection,
+    const gsl::span<const double>& longitudes,
+    const gsl::span<const double>& latitudes,
+    const gsl::span<double>& xs,
+    const gsl::span<double>& ys) {
+  std::visit(
+      [&longitudes, &latitudes, &xs, &ys](const auto& concreteProjection) {
+        concreteProjection.project(longitudes, latitudes, xs, ys);
+      },
+      projection);
+}
+
 Cartographic
 unprojectPosition(const Projection& projection, const glm::dvec3& position) {
   struct Operation {
@@ -7,6 +7,9 @@
 #include <glm/matrix.hpp>
 
 #include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
 
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -127,6 +130,81 @@ computeVertices(const std::array<Plane, 6>& boundingPlanes) {
   return vertices;
 }
 
+struct S2CellGeometryKey {
+  uint64_t cellID;
+  double minimumHeight;
+  double maximumHeight;
+  glm::dvec3 radii;
+
+  bool operator==(const S2CellGeometryKey& rhs) const noexcept {
+    return this->cellID == rhs.cellID &&
+           this->minimumHeight == rhs.minimumHeight &&
+           this->maximumHeight == rhs.maximumHeight && this->radii == rhs.radii;
+  }
+};
+
+struct S2CellGeometry {
+  glm::dvec3 center;
+  std::array<Plane, 6> boundingPlanes;
+  std::array<glm::dvec3, 8> vertices;
+};
+
+/**
+ * A small direct-mapped cache of the geometry of S2 cell bounding volumes.
+ * The same volumes are constructed again whenever the tiles of an implicit
+ * tileset are created again, such as when a subtree is reloaded, and
+ * computing them with s2geometry costs much more than copying them.
+ */
+class S2CellGeometryCache {
+public:
+  bool find(const S2CellGeometryKey& key, S2CellGeometry& geometry) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    const Entry& entry = this->_entries[computeSlot(key)];
+    if (!entry.valid || !(entry.key == key)) {
+      return false;
+    }
+
+    geometry = entry.geometry;
+    return true;
+  }
+
+  void insert(const S2CellGeometryKey& key, const S2CellGeometry& geometry) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    Entry& entry = this->_entries[computeSlot(key)];
+    entry.key = key;
+    entry.geometry = geometry;
+    entry.valid = true;
+  }
+
+private:
+  // Each entry takes about 450 bytes.
+  static constexpr size_t entryCount = 512;
+
+  struct Entry {
+    S2CellGeometryKey key{};
+    S2CellGeometry geometry{};
+    bool valid = false;
+  };
+
+  static size_t computeSlot(const S2CellGeometryKey& key) noexcept {
+    // The low bits of S2 cell IDs are mostly zeros, so mix in the high bits.
+    size_t hash = std::hash<uint64_t>()(key.cellID ^ (key.cellID >> 29));
+    hash ^= std::hash<double>()(key.minimumHeight) + 0x9e3779b9 + (hash << 6) +
+            (hash >> 2);
+    hash ^= std::hash<double>()(key.maximumHeight) + 0x9e3779b9 + (hash << 6) +
+            (hash >> 2);
+    return hash % entryCount;
+  }
+
+  std::mutex _mutex;
+  std::array<Entry, entryCount> _entries;
+};
+
+S2CellGeometryCache& getGeometryCache() {
+  static S2CellGeometryCache cache;
+  return cache;
+}
+
 } // namespace
 
 S2CellBoundingVolume::S2CellBoundingVolume(
@@ -137,11 +215,29 @@ S2CellBoundingVolume::S2CellBoundingVolume(
     : _cellID(cellID),
       _minimumHeight(minimumHeight),
       _maximumHeight(maximumHeight) {
+  const S2CellGeometryKey key{
+      cellID.getID(),
+      minimumHeight,
+      maximumHeight,
+      ellipsoid.getRadii()};
+
+  S2CellGeometry geometry;
+  if (getGeometryCache().find(key, geometry)) {
+    this->_center = geometry.center;
+    this->_boundingPlanes = geometry.boundingPlanes;
+    this->_vertices = geometry.vertices;
+    return;
+  }
+
   Cartographic result = this->_cellID.getCenter();
   result.height = (this->_minimumHeight + this->_maximumHeight) * 0.5;
   this->_center = ellipsoid.cartographicToCartesian(result);
   this->_boundingPlanes = computeBoundingPlanes(*this, ellipsoid);
   this->_vertices = computeVertices(this->_boundingPlanes);
+
+  getGeometryCache().insert(
+      key,
+      S2CellGeometry{this->_center, this->_boundingPlanes, this->_vertices});
 }
 
 glm::dvec3 S2CellBoundingVolume::getCenter() const noexcept {
@@ -164,6 +260,11 @@ CesiumGeometry::CullingResult S2CellBoundingVolume::intersectPlane(
     } else {
       ++plusCount;
     }
+
+    // The remaining vertices can't change the result.
+    if (plusCount > 0 && negCount > 0) {
+      return CullingResult::Intersecting;
+    }
   }
 
   if (plusCount == this->_vertices.size()) {
@@ -195,15 +296,21 @@ getPlaneVertices(const std::array<glm::dvec3, 8>& vertices, size_t index) {
       vertices[4 + i]};
 }
 
+/**
+ * Computes the outward normals of the edges of a face, in the plane of the
+ * face. They are only used to find on which side of each edge a point is, so
+ * they are not normalized.
+ * @private
+ */
 std::array<glm::dvec3, 4> computeEdgeNormals(
     const Plane& plane,
     const std::array<glm::dvec3, 4>& vertices,
     bool invert) {
   std::array<glm::dvec3, 4> result = {
-      glm::normalize(glm::cross(plane.getNormal(), vertices[1] - vertices[0])),
-      glm::normalize(glm::cross(plane.getNormal(), vertices[2] - vertices[1])),
-      glm::normalize(glm::cross(plane.getNormal(), vertices[3] - vertices[2])),
-      glm::normalize(glm::cross(plane.getNormal(), vertices[0] - vertices[3]))};
+      glm::cross(plane.getNormal(), vertices[1] - vertices[0]),
+      glm::cross(plane.getNormal(), vertices[2] - vertices[1]),
+      glm::cross(plane.getNormal(), vertices[3] - vertices[2]),
+      glm::cross(plane.getNormal(), vertices[0] - vertices[3])};
 
   if (invert) {
     result[0] = -result[0];
@@ -251,26 +358,23 @@ glm::dvec3 closestPointPolygon(
     const glm::dvec3& p,
     const std::array<glm::dvec3, 4>& vertices,
     const std::array<glm::dvec3, 4>& edgeNormals) {
-  double minDistance = std::numeric_limits<double>::max();
+  double minDistanceSquared = std::numeric_limits<double>::max();
   glm::dvec3 closestPoint = p;
 
   for (size_t i = 0; i < vertices.size(); ++i) {
-    Plane edgePlane(vertices[i], edgeNormals[i]);
-    double edgePlaneDistance = edgePlane.getPointDistance(p);
-
     // Skip checking against the edge if the point is not in the half-space that
-    // the edgePlane's normal points towards i.e. if the edgePlane is facing
-    // away from the point.
-    if (edgePlaneDistance < 0.0) {
+    // the edge's normal points towards i.e. if the edge is facing away from the
+    // point.
+    if (glm::dot(edgeNormals[i], p - vertices[i]) < 0.0) {
       continue;
     }
 
     glm::dvec3 closestPointOnEdge =
         closestPointLineSegment(p, vertices[i], vertices[(i + 1) % 4]);
 
-    double distance = glm::distance(p, closestPointOnEdge);
-    if (distance < minDistance) {
-      minDistance = distance;
+    double distanceSquared = glm::distance2(p, closestPointOnEdge);
+    if (distanceSquared < minDistanceSquared) {
+      minDistanceSquared = distanceSquared;
       closestPoint = closestPointOnEdge;
     }
   }
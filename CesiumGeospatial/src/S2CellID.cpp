@@ -22,7 +22,10 @@
 
 #include <CesiumGeometry/QuadtreeTileID.h>
 
+#include <glm/vec3.hpp>
+
 #include <cfloat>
+#include <cmath>
 
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -80,21 +83,77 @@ Cartographic S2CellID::getCenter() const {
 }
 
 namespace {
-Cartographic toCartographic(const S2Point& p) {
-  S2LatLng ll(p);
-  return Cartographic(ll.lng().radians(), ll.lat().radians(), 0.0);
+
+// These are s2geometry's conversions from cell coordinates to points on the
+// cube, with its default quadratic projection, which are computed here
+// because every S2 cell bounding volume that is created needs the vertices of
+// its cell.
+double stToUV(double s) {
+  if (s >= 0.5) {
+    return (1.0 / 3.0) * (4.0 * s * s - 1.0);
+  }
+  return (1.0 / 3.0) * (1.0 - 4.0 * (1.0 - s) * (1.0 - s));
+}
+
+double ijToUV(uint64_t ij, int32_t level) {
+  constexpr double oneOverLimitIJ =
+      1.0 / double(uint64_t(1) << GoogleS2CellID::kMaxLevel);
+  return stToUV(
+      oneOverLimitIJ * double(ij << (GoogleS2CellID::kMaxLevel - level)));
+}
+
+glm::dvec3 faceUVToXYZ(uint8_t face, double u, double v) {
+  switch (face) {
+  case 0:
+    return glm::dvec3(1.0, u, v);
+  case 1:
+    return glm::dvec3(-u, 1.0, v);
+  case 2:
+    return glm::dvec3(-u, -v, 1.0);
+  case 3:
+    return glm::dvec3(-1.0, -v, -u);
+  case 4:
+    return glm::dvec3(v, -1.0, -u);
+  default:
+    return glm::dvec3(v, u, -1.0);
+  }
+}
+
+Cartographic toCartographic(const glm::dvec3& p) {
+  return Cartographic(
+      std::atan2(p.y, p.x),
+      std::atan2(p.z, std::sqrt(p.x * p.x + p.y * p.y)),
+      0.0);
 }
+
 } // namespace
 
 std::array<Cartographic, 4> S2CellID::getVertices() const {
-  GoogleS2CellID cell(this->_id);
-  R2Rect rect = cell.GetBoundUV();
-  int face = cell.face();
+  const uint8_t face = this->getFace();
+  const int32_t level = this->getLevel();
+
+  // The position of the cell along the Hilbert curve of its face is below the
+  // face bits and above the trailing one bit.
+  const uint64_t position =
+      (this->_id & ((uint64_t(1) << 61) - 1)) >>
+      (2 * (GoogleS2CellID::kMaxLevel - level) + 1);
+  const glm::uvec2 curve =
+      HilbertOrder::decode2D(static_cast<uint32_t>(level), position);
+
+  // The curves of the odd faces start with the coordinates swapped, as in
+  // fromQuadtreeTileID.
+  const uint64_t i = (face & 1) == 0 ? curve.x : curve.y;
+  const uint64_t j = (face & 1) == 0 ? curve.y : curve.x;
+
+  const double uLow = ijToUV(i, level);
+  const double uHigh = ijToUV(i + 1, level);
+  const double vLow = ijToUV(j, level);
+  const double vHigh = ijToUV(j + 1, level);
   return {
-      toCartographic(S2::FaceUVtoXYZ(face, rect.GetVertex(0, 0))),
-      toCartographic(S2::FaceUVtoXYZ(face, rect.GetVertex(1, 0))),
-      toCartographic(S2::FaceUVtoXYZ(face, rect.GetVertex(1, 1))),
-      toCartographic(S2::FaceUVtoXYZ(face, rect.GetVertex(0, 1)))};
+      toCartographic(faceUVToXYZ(face, uLow, vLow)),
+      toCartographic(faceUVToXYZ(face, uHigh, vLow)),
+      toCartographic(faceUVToXYZ(face, uHigh, vHigh)),
+      toCartographic(faceUVToXYZ(face, uLow, vHigh))};
 }
 
 S2CellID S2CellID::getParent() const {
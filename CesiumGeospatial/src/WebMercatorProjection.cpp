@@ -7,6 +7,8 @@
 #include <glm/exponential.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <cassert>
+
 namespace CesiumGeospatial {
 
 /*static*/ const double WebMercatorProjection::MAXIMUM_LATITUDE =
@@ -37,6 +39,38 @@ glm::dvec3 WebMercatorProjection::project(
       cartographic.height);
 }
 
+void WebMercatorProjection::project(
+    const gsl::span<const double>& longitudes,
+    const gsl::span<const double>& latitudes,
+    const gsl::span<double>& xs,
+    const gsl::span<double>& ys) const noexcept {
+  const size_t count = longitudes.size();
+  assert(latitudes.size() == count);
+  assert(xs.size() == count && ys.size() == count);
+
+  const double semimajorAxis = this->_semimajorAxis;
+  for (size_t i = 0; i < count; ++i) {
+    xs[i] = longitudes[i] * semimajorAxis;
+  }
+
+  // This is geodeticLatitudeToMercatorAngle, with the clamping, which is
+  // vectorized, kept apart from the sines and logarithms, which are not.
+  for (size_t i = 0; i < count; ++i) {
+    ys[i] = CesiumUtility::Math::clamp(
+        latitudes[i],
+        -WebMercatorProjection::MAXIMUM_LATITUDE,
+        WebMercatorProjection::MAXIMUM_LATITUDE);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    ys[i] = glm::sin(ys[i]);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const double sinLatitude = ys[i];
+    ys[i] = 0.5 * glm::log((1.0 + sinLatitude) / (1.0 - sinLatitude)) *
+            semimajorAxis;
+  }
+}
+
 CesiumGeometry::Rectangle WebMercatorProjection::project(
     const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept {
   const glm::dvec3 sw = this->project(rectangle.getSouthwest());
@@ -4,6 +4,9 @@
 
 #include <catch2/catch.hpp>
 
+#include <cmath>
+#include <vector>
+
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
 
@@ -53,4 +56,104 @@ TEST_CASE("BoundingRegionBuilder") {
     CHECK(wrapped.contains(Cartographic(0.0, 1.0, 0.0)));
     CHECK(!wrapped.contains(Cartographic(0.0, -1.0, 0.0)));
   }
+
+  SECTION("expandToIncludePositions") {
+    // More positions than are bounded in one block, crossing the
+    // anti-meridian, with some near a pole and one without a cartographic.
+    std::vector<double> longitudes, latitudes, heights;
+    for (int i = 0; i < 150; ++i) {
+      longitudes.push_back(Math::convertLongitudeRange(2.0 + 0.01 * i));
+      latitudes.push_back(i % 50 == 0 ? Math::PiOverTwo : -0.5 + 0.005 * i);
+      heights.push_back(100.0 - i);
+    }
+    longitudes[75] = std::nan("");
+    latitudes[75] = std::nan("");
+    heights[75] = std::nan("");
+
+    BoundingRegionBuilder expected;
+    for (size_t i = 0; i < longitudes.size(); ++i) {
+      if (!std::isnan(longitudes[i])) {
+        expected.expandToIncludePosition(
+            Cartographic(longitudes[i], latitudes[i], heights[i]));
+      }
+    }
+
+    BoundingRegionBuilder batch;
+    CHECK(batch.expandToIncludePositions(longitudes, latitudes, heights));
+    CHECK(!batch.expandToIncludePositions(longitudes, latitudes, heights));
+
+    const BoundingRegion expectedRegion = expected.toRegion();
+    const BoundingRegion region = batch.toRegion();
+    CHECK(region.getRectangle().getWest() ==
+          expectedRegion.getRectangle().getWest());
+    CHECK(region.getRectangle().getEast() ==
+          expectedRegion.getRectangle().getEast());
+    CHECK(region.getRectangle().getSouth() ==
+          expectedRegion.getRectangle().getSouth());
+    CHECK(region.getRectangle().getNorth() == Math::PiOverTwo);
+    CHECK(region.getMinimumHeight() == expectedRegion.getMinimumHeight());
+    CHECK(region.getMaximumHeight() == 100.0);
+    CHECK(region.getRectangle().getEast() < region.getRectangle().getWest());
+  }
+
+  SECTION("expandToIncludeCartesianPositions") {
+    const Cartographic position(0.5, 0.25, 10.0);
+    const glm::dvec3 cartesian =
+        Ellipsoid::WGS84.cartographicToCartesian(position);
+    const std::vector<double> xs{cartesian.x, 0.0};
+    const std::vector<double> ys{cartesian.y, 0.0};
+    const std::vector<double> zs{cartesian.z, 0.0};
+
+    BoundingRegionBuilder batch;
+    CHECK(batch.expandToIncludeCartesianPositions(xs, ys, zs));
+
+    const BoundingRegion region = batch.toRegion();
+    CHECK(Math::equalsEpsilon(
+        region.getRectangle().getWest(),
+        0.5,
+        Math::Epsilon10));
+    CHECK(Math::equalsEpsilon(
+        region.getRectangle().getSouth(),
+        0.25,
+        Math::Epsilon10));
+    CHECK(Math::equalsEpsilon(region.getMinimumHeight(), 10.0, Math::Epsilon6));
+    CHECK(Math::equalsEpsilon(region.getMaximumHeight(), 10.0, Math::Epsilon6));
+  }
+
+  SECTION("merge") {
+    BoundingRegionBuilder first;
+    first.expandToIncludePosition(Cartographic(2.5, 0.0, 0.0));
+    first.expandToIncludePosition(Cartographic(3.0, 0.1, 5.0));
+
+    BoundingRegionBuilder second;
+    second.expandToIncludePosition(Cartographic(-3.0, -0.2, -5.0));
+    second.expandToIncludePosition(Cartographic(-2.5, 0.0, 0.0));
+
+    // The gap across the anti-meridian is smaller than the one across the
+    // prime meridian.
+    BoundingRegionBuilder merged = first;
+    CHECK(merged.merge(second));
+    CHECK(!merged.merge(second));
+    CHECK(!merged.merge(BoundingRegionBuilder()));
+
+    BoundingRegion region = merged.toRegion();
+    CHECK(region.getRectangle().getWest() == 2.5);
+    CHECK(region.getRectangle().getEast() == -2.5);
+    CHECK(region.getRectangle().getSouth() == -0.2);
+    CHECK(region.getRectangle().getNorth() == 0.1);
+    CHECK(region.getMinimumHeight() == -5.0);
+    CHECK(region.getMaximumHeight() == 5.0);
+
+    BoundingRegionBuilder reversed = second;
+    CHECK(reversed.merge(first));
+    region = reversed.toRegion();
+    CHECK(region.getRectangle().getWest() == 2.5);
+    CHECK(region.getRectangle().getEast() == -2.5);
+
+    BoundingRegionBuilder empty;
+    CHECK(empty.merge(first));
+    region = empty.toRegion();
+    CHECK(region.getRectangle().getWest() == 2.5);
+    CHECK(region.getRectangle().getEast() == 3.0);
+  }
 }
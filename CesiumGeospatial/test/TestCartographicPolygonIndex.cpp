@@ -0,0 +1,98 @@
+#include "CesiumGeospatial/CartographicPolygon.h"
+#include "CesiumGeospatial/CartographicPolygonIndex.h"
+#include "CesiumGeospatial/GlobeRectangle.h"
+
+#include <catch2/catch.hpp>
+#include <glm/vec2.hpp>
+
+#include <array>
+#include <vector>
+
+using namespace CesiumGeospatial;
+
+namespace {
+std::vector<CartographicPolygon> createParcels() {
+  // A 10x10 block of small triangular and square parcels, and one polygon
+  // that crosses the antimeridian.
+  std::vector<CartographicPolygon> polygons;
+  for (int y = 0; y < 10; ++y) {
+    for (int x = 0; x < 10; ++x) {
+      const double west = 0.1 + 0.01 * x;
+      const double south = 0.2 + 0.01 * y;
+      if ((x + y) % 2 == 0) {
+        polygons.emplace_back(std::vector<glm::dvec2>{
+            glm::dvec2(west, south),
+            glm::dvec2(west + 0.008, south),
+            glm::dvec2(west + 0.008, south + 0.008),
+            glm::dvec2(west, south + 0.008)});
+      } else {
+        polygons.emplace_back(std::vector<glm::dvec2>{
+            glm::dvec2(west, south),
+            glm::dvec2(west + 0.008, south),
+            glm::dvec2(west, south + 0.008)});
+      }
+    }
+  }
+
+  polygons.emplace_back(std::vector<glm::dvec2>{
+      glm::dvec2(3.1, -0.1),
+      glm::dvec2(-3.1, -0.1),
+      glm::dvec2(-3.1, 0.1),
+      glm::dvec2(3.1, 0.1)});
+  return polygons;
+}
+} // namespace
+
+TEST_CASE("CartographicPolygonIndex") {
+  const std::vector<CartographicPolygon> polygons = createParcels();
+  const CartographicPolygonIndex index(polygons);
+  CHECK(index.getPolygons().size() == polygons.size());
+
+  SECTION("gives the same results as testing every polygon") {
+    std::vector<GlobeRectangle> rectangles;
+    for (int y = 0; y < 24; ++y) {
+      for (int x = 0; x < 24; ++x) {
+        const double west = 0.095 + 0.005 * x;
+        const double south = 0.195 + 0.005 * y;
+        rectangles.emplace_back(west, south, west + 0.002, south + 0.002);
+      }
+    }
+    rectangles.emplace_back(0.0, 0.0, 1.0, 1.0);
+    rectangles.emplace_back(-1.0, -1.0, -0.5, -0.5);
+    rectangles.emplace_back(3.11, -0.01, -3.11, 0.01);
+    rectangles.emplace_back(-3.12, 0.05, -3.11, 0.06);
+
+    for (const GlobeRectangle& rectangle : rectangles) {
+      CHECK(
+          index.rectangleIsWithinPolygons(rectangle) ==
+          CartographicPolygon::rectangleIsWithinPolygons(rectangle, polygons));
+      CHECK(
+          index.rectangleIsOutsidePolygons(rectangle) ==
+          CartographicPolygon::rectangleIsOutsidePolygons(rectangle, polygons));
+    }
+  }
+
+  SECTION("finds the triangles that overlap a rectangle") {
+    const GlobeRectangle rectangle(0.1, 0.2, 0.1185, 0.2185);
+    const std::vector<std::array<glm::dvec2, 3>> triangles =
+        index.findTriangles(rectangle);
+
+    // The four parcels in the corner are two squares and two triangles.
+    CHECK(triangles.size() == 6);
+    for (const std::array<glm::dvec2, 3>& triangle : triangles) {
+      for (const glm::dvec2& vertex : triangle) {
+        CHECK(vertex.x < 0.12);
+        CHECK(vertex.y < 0.22);
+      }
+    }
+
+    CHECK(index.findTriangles(GlobeRectangle(1.0, 1.0, 1.1, 1.1)).empty());
+  }
+
+  SECTION("finds polygons whose bounding rectangles intersect a rectangle") {
+    CHECK(index.anyBoundingRectangleIntersects(
+        GlobeRectangle(3.12, 0.0, 3.13, 0.01)));
+    CHECK(!index.anyBoundingRectangleIntersects(
+        GlobeRectangle(1.0, 1.0, 1.1, 1.1)));
+  }
+}
@@ -0,0 +1,145 @@
+#include "CesiumGeospatial/Ellipsoid.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace {
+// More positions than are converted in one block, from the surface of the
+// ellipsoid to far above it, with the center of the ellipsoid last.
+std::vector<Cartographic> createPositions() {
+  std::vector<Cartographic> positions;
+  for (int i = 0; i < 100; ++i) {
+    positions.emplace_back(
+        Math::degreesToRadians(-180.0 + 3.6 * i),
+        Math::degreesToRadians(-89.0 + 1.78 * i),
+        -1000.0 + 5000.0 * i * i);
+  }
+  return positions;
+}
+
+struct Coordinates {
+  std::vector<double> xs;
+  std::vector<double> ys;
+  std::vector<double> zs;
+
+  explicit Coordinates(size_t size) : xs(size), ys(size), zs(size) {}
+};
+} // namespace
+
+TEST_CASE("Ellipsoid batch conversions") {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const std::vector<Cartographic> cartographics = createPositions();
+  const size_t count = cartographics.size();
+
+  Coordinates cartesians(count + 1);
+  for (size_t i = 0; i < count; ++i) {
+    const glm::dvec3 cartesian =
+        ellipsoid.cartographicToCartesian(cartographics[i]);
+    cartesians.xs[i] = cartesian.x;
+    cartesians.ys[i] = cartesian.y;
+    cartesians.zs[i] = cartesian.z;
+  }
+  cartesians.xs[count] = 0.0;
+  cartesians.ys[count] = 0.0;
+  cartesians.zs[count] = 0.0;
+
+  SECTION("cartographicToCartesian") {
+    Coordinates positions(count);
+    Coordinates results(count);
+    for (size_t i = 0; i < count; ++i) {
+      positions.xs[i] = cartographics[i].longitude;
+      positions.ys[i] = cartographics[i].latitude;
+      positions.zs[i] = cartographics[i].height;
+    }
+
+    ellipsoid.cartographicToCartesian(
+        positions.xs,
+        positions.ys,
+        positions.zs,
+        results.xs,
+        results.ys,
+        results.zs);
+
+    for (size_t i = 0; i < count; ++i) {
+      CHECK(Math::equalsEpsilon(
+          glm::dvec3(results.xs[i], results.ys[i], results.zs[i]),
+          glm::dvec3(cartesians.xs[i], cartesians.ys[i], cartesians.zs[i]),
+          Math::Epsilon12));
+    }
+  }
+
+  SECTION("cartesianToCartographic") {
+    Coordinates results(count + 1);
+    ellipsoid.cartesianToCartographic(
+        cartesians.xs,
+        cartesians.ys,
+        cartesians.zs,
+        results.xs,
+        results.ys,
+        results.zs);
+
+    for (size_t i = 0; i < count; ++i) {
+      const std::optional<Cartographic> expected =
+          ellipsoid.cartesianToCartographic(
+              glm::dvec3(cartesians.xs[i], cartesians.ys[i], cartesians.zs[i]));
+      REQUIRE(expected);
+      CHECK(Math::equalsEpsilon(
+          glm::dvec3(results.xs[i], results.ys[i], results.zs[i]),
+          glm::dvec3(expected->longitude, expected->latitude, expected->height),
+          Math::Epsilon12));
+    }
+
+    CHECK(std::isnan(results.xs[count]));
+    CHECK(std::isnan(results.ys[count]));
+    CHECK(std::isnan(results.zs[count]));
+  }
+
+  SECTION("scaleToGeodeticSurface in place") {
+    Coordinates results = cartesians;
+    ellipsoid.scaleToGeodeticSurface(
+        results.xs,
+        results.ys,
+        results.zs,
+        results.xs,
+        results.ys,
+        results.zs);
+
+    for (size_t i = 0; i < count; ++i) {
+      const std::optional<glm::dvec3> expected =
+          ellipsoid.scaleToGeodeticSurface(
+              glm::dvec3(cartesians.xs[i], cartesians.ys[i], cartesians.zs[i]));
+      REQUIRE(expected);
+      CHECK(
+          glm::dvec3(results.xs[i], results.ys[i], results.zs[i]) == *expected);
+    }
+
+    CHECK(std::isnan(results.xs[count]));
+  }
+
+  SECTION("geodeticSurfaceNormal") {
+    Coordinates results(count);
+    ellipsoid.geodeticSurfaceNormal(
+        gsl::span<const double>(cartesians.xs).first(count),
+        gsl::span<const double>(cartesians.ys).first(count),
+        gsl::span<const double>(cartesians.zs).first(count),
+        results.xs,
+        results.ys,
+        results.zs);
+
+    for (size_t i = 0; i < count; ++i) {
+      const glm::dvec3 expected = ellipsoid.geodeticSurfaceNormal(
+          glm::dvec3(cartesians.xs[i], cartesians.ys[i], cartesians.zs[i]));
+      CHECK(Math::equalsEpsilon(
+          glm::dvec3(results.xs[i], results.ys[i], results.zs[i]),
+          expected,
+          Math::Epsilon14));
+    }
+  }
+}
@@ -3,8 +3,11 @@
 #include <CesiumGeospatial/LocalHorizontalCoordinateSystem.h>
 
 #include <catch2/catch.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include <vector>
+
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
@@ -178,4 +181,64 @@ TEST_CASE("GlobeAnchor") {
         0.0,
         Math::Epsilon10));
   }
+
+  SECTION("Moving many anchors is equivalent to moving each") {
+    std::vector<glm::dmat4> toLocal{
+        glm::dmat4(1.0),
+        glm::translate(glm::dmat4(1.0), glm::dvec3(100.0, 0.0, 0.0)),
+        glm::translate(glm::dmat4(1.0), glm::dvec3(0.0, 0.0, -250.0))};
+
+    std::vector<GlobeAnchor> anchors;
+    for (const glm::dmat4& transform : toLocal) {
+      anchors.emplace_back(GlobeAnchor::fromAnchorToLocalTransform(
+          leftHandedEastUpNorth,
+          transform));
+    }
+
+    // The last anchor does not move.
+    std::vector<glm::dmat4> newToLocal{
+        toLocal[0],
+        glm::translate(glm::dmat4(1.0), glm::dvec3(0.0, 5000.0, 0.0)),
+        toLocal[2]};
+
+    std::vector<GlobeAnchor> expected = anchors;
+    for (size_t i = 0; i < expected.size(); ++i) {
+      expected[i].setAnchorToLocalTransform(
+          i == 2 ? leftHandedEastUpNorth : leftHandedEastUpNorth90,
+          newToLocal[i]);
+    }
+
+    GlobeAnchor::setAnchorToLocalTransforms(
+        leftHandedEastUpNorth90,
+        gsl::span<GlobeAnchor>(anchors).first(2),
+        gsl::span<const glm::dmat4>(newToLocal).first(2));
+    GlobeAnchor::setAnchorToLocalTransforms(
+        leftHandedEastUpNorth,
+        gsl::span<GlobeAnchor>(anchors).last(1),
+        gsl::span<const glm::dmat4>(newToLocal).last(1));
+
+    std::vector<glm::dmat4> actualToLocal(anchors.size());
+    GlobeAnchor::getAnchorToLocalTransforms(
+        leftHandedEastUpNorth90,
+        anchors,
+        actualToLocal);
+
+    for (size_t i = 0; i < anchors.size(); ++i) {
+      const glm::dmat4& actual = anchors[i].getAnchorToFixedTransform();
+      const glm::dmat4 expectedToLocal =
+          expected[i].getAnchorToLocalTransform(leftHandedEastUpNorth90);
+      for (glm::length_t column = 0; column < 4; ++column) {
+        CHECK(Math::equalsEpsilon(
+            actual[column],
+            expected[i].getAnchorToFixedTransform()[column],
+            0.0,
+            Math::Epsilon10));
+        CHECK(Math::equalsEpsilon(
+            actualToLocal[i][column],
+            expectedToLocal[column],
+            0.0,
+            Math::Epsilon7));
+      }
+    }
+  }
 }
@@ -0,0 +1,47 @@
+#include "CesiumGeospatial/GlobeTransforms.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+TEST_CASE("GlobeTransforms::eastNorthUpToFixedFrames") {
+  // More origins than are computed in one block, with the special cases of the
+  // center of the ellipsoid and of a pole last.
+  std::vector<glm::dvec3> origins;
+  for (int i = 0; i < 100; ++i) {
+    const Cartographic position = Cartographic::fromDegrees(
+        -180.0 + 3.6 * i,
+        -89.0 + 1.78 * i,
+        10.0 * i);
+    origins.emplace_back(Ellipsoid::WGS84.cartographicToCartesian(position));
+  }
+  origins.emplace_back(0.0, 0.0, 0.0);
+  origins.emplace_back(0.0, 0.0, Ellipsoid::WGS84.getRadii().z);
+
+  std::vector<double> xs, ys, zs;
+  for (const glm::dvec3& origin : origins) {
+    xs.push_back(origin.x);
+    ys.push_back(origin.y);
+    zs.push_back(origin.z);
+  }
+
+  std::vector<glm::dmat4> frames(origins.size());
+  GlobeTransforms::eastNorthUpToFixedFrames(xs, ys, zs, frames);
+
+  for (size_t i = 0; i < origins.size(); ++i) {
+    const glm::dmat4 expected =
+        GlobeTransforms::eastNorthUpToFixedFrame(origins[i]);
+    for (glm::length_t column = 0; column < 4; ++column) {
+      CHECK(Math::equalsEpsilon(
+          frames[i][column],
+          expected[column],
+          0.0,
+          Math::Epsilon12));
+    }
+  }
+}
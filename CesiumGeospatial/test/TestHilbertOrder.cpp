@@ -0,0 +1,51 @@
+#include "HilbertOrder.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+
+using namespace CesiumGeospatial;
+
+TEST_CASE("HilbertOrder") {
+  SECTION("encodes the first level in the order of the curve") {
+    CHECK(HilbertOrder::encode2D(1, 0, 0) == 0);
+    CHECK(HilbertOrder::encode2D(1, 0, 1) == 1);
+    CHECK(HilbertOrder::encode2D(1, 1, 1) == 2);
+    CHECK(HilbertOrder::encode2D(1, 1, 0) == 3);
+  }
+
+  SECTION("visits each cell of a level once, moving to a neighbor") {
+    for (uint32_t level = 0; level <= 6; ++level) {
+      const uint32_t size = 1U << level;
+      uint32_t previousX = 0;
+      uint32_t previousY = 0;
+      for (uint64_t index = 0; index < uint64_t(size) * size; ++index) {
+        const glm::uvec2 position = HilbertOrder::decode2D(level, index);
+        REQUIRE(position.x < size);
+        REQUIRE(position.y < size);
+        CHECK(HilbertOrder::encode2D(level, position.x, position.y) == index);
+
+        if (index > 0) {
+          const uint32_t dx = position.x > previousX ? position.x - previousX
+                                                     : previousX - position.x;
+          const uint32_t dy = position.y > previousY ? position.y - previousY
+                                                     : previousY - position.y;
+          CHECK(dx + dy == 1);
+        }
+        previousX = position.x;
+        previousY = position.y;
+      }
+    }
+  }
+
+  SECTION("round trips the deepest S2 level") {
+    const uint32_t x = 0x2ABCDEF1;
+    const uint32_t y = 0x1234567;
+    const uint64_t index = HilbertOrder::encode2D(30, x, y);
+    CHECK(index < (uint64_t(1) << 60));
+
+    const glm::uvec2 position = HilbertOrder::decode2D(30, index);
+    CHECK(position.x == x);
+    CHECK(position.y == y);
+  }
+}
@@ -3,6 +3,8 @@
 
 #include <catch2/catch.hpp>
 
+#include <vector>
+
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
 
@@ -168,4 +170,45 @@ TEST_CASE("LocalHorizontalCoordinateSystem") {
         glm::dvec3(transform * glm::dvec4(somePointInOriginal, 1.0));
     CHECK(Math::equalsEpsilon(computedByTransform, samePointInTarget, 1e-15));
   }
+
+  SECTION("Converts arrays of positions") {
+    LocalHorizontalCoordinateSystem lh(
+        Cartographic::fromDegrees(12.0, 23.0, 1000.0),
+        LocalDirection::East,
+        LocalDirection::Up,
+        LocalDirection::North,
+        2.0);
+
+    const std::vector<glm::dvec3> positions{
+        glm::dvec3(0.0, 0.0, 0.0),
+        glm::dvec3(1781.0, 373.0, 7777.2),
+        glm::dvec3(-5.0, 12.5, -0.25)};
+
+    std::vector<double> xs, ys, zs;
+    for (const glm::dvec3& position : positions) {
+      xs.push_back(position.x);
+      ys.push_back(position.y);
+      zs.push_back(position.z);
+    }
+
+    std::vector<double> ecefXs(3), ecefYs(3), ecefZs(3);
+    lh.localPositionsToEcef(xs, ys, zs, ecefXs, ecefYs, ecefZs);
+    for (size_t i = 0; i < positions.size(); ++i) {
+      CHECK(Math::equalsEpsilon(
+          glm::dvec3(ecefXs[i], ecefYs[i], ecefZs[i]),
+          lh.localPositionToEcef(positions[i]),
+          0.0,
+          1e-8));
+    }
+
+    // The positions are converted back in place.
+    lh.ecefPositionsToLocal(ecefXs, ecefYs, ecefZs, ecefXs, ecefYs, ecefZs);
+    for (size_t i = 0; i < positions.size(); ++i) {
+      CHECK(Math::equalsEpsilon(
+          glm::dvec3(ecefXs[i], ecefYs[i], ecefZs[i]),
+          positions[i],
+          0.0,
+          1e-8));
+    }
+  }
 }
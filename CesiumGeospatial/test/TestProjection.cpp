@@ -6,6 +6,8 @@
 #include <catch2/catch.hpp>
 #include <glm/geometric.hpp>
 
+#include <vector>
+
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
@@ -105,3 +107,29 @@ TEST_CASE("computeProjectedRectangleSize") {
         1.0));
   }
 }
+
+TEST_CASE("projectPositions") {
+  std::vector<double> longitudes;
+  std::vector<double> latitudes;
+  for (int i = 0; i <= 100; ++i) {
+    longitudes.emplace_back(Math::degreesToRadians(-180.0 + 3.6 * i));
+    latitudes.emplace_back(Math::degreesToRadians(-90.0 + 1.8 * i));
+  }
+
+  const std::vector<Projection> projections{
+      GeographicProjection(),
+      WebMercatorProjection()};
+  for (const Projection& projection : projections) {
+    std::vector<double> xs(longitudes.size());
+    std::vector<double> ys(latitudes.size());
+    projectPositions(projection, longitudes, latitudes, xs, ys);
+
+    for (size_t i = 0; i < longitudes.size(); ++i) {
+      const glm::dvec3 expected = projectPosition(
+          projection,
+          Cartographic(longitudes[i], latitudes[i], 0.0));
+      CHECK(xs[i] == expected.x);
+      CHECK(ys[i] == expected.y);
+    }
+  }
+}
@@ -127,6 +127,29 @@ TEST_CASE("S2CellBoundingVolume") {
         CullingResult::Inside);
   }
 
+  SECTION("reuses the geometry of volumes with the same cell and heights") {
+    S2CellBoundingVolume same(S2CellID::fromToken("1"), 0.0, 100000.0);
+    CHECK(same.getCenter() == tileS2Cell.getCenter());
+    for (size_t i = 0; i < 8; ++i) {
+      CHECK(same.getVertices()[i] == tileS2Cell.getVertices()[i]);
+    }
+    for (size_t i = 0; i < 6; ++i) {
+      CHECK(
+          same.getBoundingPlanes()[i].getNormal() ==
+          tileS2Cell.getBoundingPlanes()[i].getNormal());
+      CHECK(
+          same.getBoundingPlanes()[i].getDistance() ==
+          tileS2Cell.getBoundingPlanes()[i].getDistance());
+    }
+
+    S2CellBoundingVolume higher(S2CellID::fromToken("1"), 0.0, 200000.0);
+    CHECK(higher.getMaximumHeight() == 200000.0);
+    CHECK(
+        higher.getBoundingPlanes()[0].getDistance() !=
+        tileS2Cell.getBoundingPlanes()[0].getDistance());
+    CHECK(higher.getCenter() != tileS2Cell.getCenter());
+  }
+
   SECTION("can construct face 2 (North pole)") {
     S2CellBoundingVolume face2Root(S2CellID::fromToken("5"), 1000.0, 2000.0);
     CHECK(face2Root.getCellID().isValid());
@@ -217,6 +217,23 @@ TEST_CASE("S2CellID") {
         Math::Epsilon10));
   }
 
+  SECTION("gets vertices on the bounding rectangle of cells of every face") {
+    for (uint8_t face = 0; face < 6; ++face) {
+      const S2CellID cell =
+          S2CellID::fromQuadtreeTileID(face, QuadtreeTileID(5, 11, 22));
+      const GlobeRectangle rectangle = cell.computeBoundingRectangle();
+      for (const Cartographic& vertex : cell.getVertices()) {
+        CHECK(rectangle.contains(vertex));
+        const bool onEdge =
+            Math::equalsEpsilon(vertex.longitude, rectangle.getWest(), 1e-12) ||
+            Math::equalsEpsilon(vertex.longitude, rectangle.getEast(), 1e-12) ||
+            Math::equalsEpsilon(vertex.latitude, rectangle.getSouth(), 1e-12) ||
+            Math::equalsEpsilon(vertex.latitude, rectangle.getNorth(), 1e-12);
+        CHECK(onEdge);
+      }
+    }
+  }
+
   SECTION("fromQuadtreeTileID") {
     S2CellID a = S2CellID::fromQuadtreeTileID(
         S2CellID::fromToken("1").getFace(),
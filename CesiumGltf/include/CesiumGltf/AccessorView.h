@@ -2,7 +2,12 @@
 
 #include "CesiumGltf/Model.h"
 
+#include <gsl/span>
+
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
 #include <stdexcept>
 
 namespace CesiumGltf {
@@ -178,10 +183,212 @@ public:
       throw std::range_error("index out of range");
     }
 
+    return this->getUnchecked(i);
+  }
+
+  /**
+   * @brief Provides the specified accessor element without checking that the
+   * index is in range.
+   *
+   * Use this in loops whose indices are known to be in range, where the check
+   * of {@link operator[]} would be paid for every element.
+   *
+   * @param i The index of the element, which must be non-negative and smaller
+   * than the {@link size} of this accessor.
+   * @returns The constant reference to the accessor element.
+   */
+  const T& getUnchecked(int64_t i) const noexcept {
     return *reinterpret_cast<const T*>(
         this->_pData + i * this->_stride + this->_offset);
   }
 
+  /**
+   * @brief An iterator over the elements of an {@link AccessorView}, which
+   * steps by the {@link stride} without checking the range.
+   */
+  class const_iterator {
+  public:
+    /** @brief The iterator category. */
+    using iterator_category = std::random_access_iterator_tag;
+    /** @brief The type of the elements. */
+    using value_type = T;
+    /** @brief The type of the distance between iterators. */
+    using difference_type = int64_t;
+    /** @brief The type of a pointer to an element. */
+    using pointer = const T*;
+    /** @brief The type of a reference to an element. */
+    using reference = const T&;
+
+    /**
+     * @brief Constructs an iterator that points to no element.
+     */
+    const_iterator() noexcept : _pElement(nullptr), _stride(0) {}
+
+    /**
+     * @brief Constructs an iterator from the address of an element and the
+     * stride between elements.
+     */
+    const_iterator(const std::byte* pElement, int64_t stride) noexcept
+        : _pElement(pElement), _stride(stride) {}
+
+    /** @brief Gets the element. */
+    reference operator*() const noexcept {
+      return *reinterpret_cast<const T*>(this->_pElement);
+    }
+
+    /** @brief Gets a pointer to the element. */
+    pointer operator->() const noexcept { return &**this; }
+
+    /** @brief Gets the element a number of elements away. */
+    reference operator[](difference_type n) const noexcept {
+      return *(*this + n);
+    }
+
+    /** @brief Moves to the next element. */
+    const_iterator& operator++() noexcept {
+      this->_pElement += this->_stride;
+      return *this;
+    }
+
+    /** @brief Moves to the next element. */
+    const_iterator operator++(int) noexcept {
+      const_iterator result = *this;
+      ++*this;
+      return result;
+    }
+
+    /** @brief Moves to the previous element. */
+    const_iterator& operator--() noexcept {
+      this->_pElement -= this->_stride;
+      return *this;
+    }
+
+    /** @brief Moves to the previous element. */
+    const_iterator operator--(int) noexcept {
+      const_iterator result = *this;
+      --*this;
+      return result;
+    }
+
+    /** @brief Moves by a number of elements. */
+    const_iterator& operator+=(difference_type n) noexcept {
+      this->_pElement += n * this->_stride;
+      return *this;
+    }
+
+    /** @brief Moves back by a number of elements. */
+    const_iterator& operator-=(difference_type n) noexcept {
+      this->_pElement -= n * this->_stride;
+      return *this;
+    }
+
+    /** @brief Gets an iterator a number of elements later. */
+    const_iterator operator+(difference_type n) const noexcept {
+      return const_iterator(this->_pElement + n * this->_stride, this->_stride);
+    }
+
+    /** @brief Gets an iterator a number of elements earlier. */
+    const_iterator operator-(difference_type n) const noexcept {
+      return const_iterator(this->_pElement - n * this->_stride, this->_stride);
+    }
+
+    /** @brief Gets the number of elements between two iterators. */
+    difference_type operator-(const const_iterator& other) const noexcept {
+      return this->_stride == 0
+                 ? 0
+                 : (this->_pElement - other._pElement) / this->_stride;
+    }
+
+    /** @brief Compares two iterators. */
+    bool operator==(const const_iterator& other) const noexcept {
+      return this->_pElement == other._pElement;
+    }
+
+    /** @brief Compares two iterators. */
+    bool operator!=(const const_iterator& other) const noexcept {
+      return this->_pElement != other._pElement;
+    }
+
+    /** @brief Compares two iterators. */
+    bool operator<(const const_iterator& other) const noexcept {
+      return this->_pElement < other._pElement;
+    }
+
+    /** @brief Compares two iterators. */
+    bool operator>(const const_iterator& other) const noexcept {
+      return this->_pElement > other._pElement;
+    }
+
+    /** @brief Compares two iterators. */
+    bool operator<=(const const_iterator& other) const noexcept {
+      return this->_pElement <= other._pElement;
+    }
+
+    /** @brief Compares two iterators. */
+    bool operator>=(const const_iterator& other) const noexcept {
+      return this->_pElement >= other._pElement;
+    }
+
+  private:
+    const std::byte* _pElement;
+    int64_t _stride;
+  };
+
+  /**
+   * @brief Gets an iterator to the first element of this accessor. The
+   * iterators do not check the range, so a range-based `for` loop over the
+   * view does no more work per element than a loop over an array.
+   */
+  const_iterator begin() const noexcept {
+    return const_iterator(this->data(), this->_stride);
+  }
+
+  /**
+   * @brief Gets an iterator past the last element of this accessor.
+   */
+  const_iterator end() const noexcept {
+    return const_iterator(
+        this->data() + this->_size * this->_stride,
+        this->_stride);
+  }
+
+  /**
+   * @brief Copies a range of the elements of this accessor into contiguous
+   * memory.
+   *
+   * Tightly packed elements are copied with a single `memcpy`. Interleaved
+   * elements are copied one by one with a copy of constant size, which the
+   * compiler can turn into strided loads.
+   *
+   * @param destination The memory to copy to. As many elements are copied as
+   * fit, up to the end of this accessor.
+   * @param start The index of the first element to copy.
+   * @returns The number of elements copied, which is 0 if `start` is not in
+   * range.
+   */
+  int64_t
+  copyTo(const gsl::span<T>& destination, int64_t start = 0) const noexcept {
+    if (start < 0 || start >= this->_size) {
+      return 0;
+    }
+
+    const int64_t count =
+        std::min(this->_size - start, static_cast<int64_t>(destination.size()));
+    const std::byte* pSource = this->data() + start * this->_stride;
+    T* pDestination = destination.data();
+    if (this->_stride == static_cast<int64_t>(sizeof(T))) {
+      std::memcpy(
+          pDestination,
+          pSource,
+          static_cast<size_t>(count) * sizeof(T));
+    } else {
+      for (int64_t i = 0; i < count; ++i) {
+        std::memcpy(pDestination + i, pSource + i * this->_stride, sizeof(T));
+      }
+    }
+    return count;
+  }
+
   /**
    * @brief Returns the size (number of elements) of this accessor.
    *
@@ -233,7 +440,7 @@ private:
       return;
     }
 
-    const std::vector<std::byte>& data = pBuffer->cesium.data;
+    const gsl::span<const std::byte> data = pBuffer->cesium.getData();
     const int64_t bufferBytes = int64_t(data.size());
     if (pBufferView->byteOffset + pBufferView->byteLength > bufferBytes) {
       this->_status = AccessorViewStatus::BufferTooSmall;
@@ -264,7 +471,7 @@ private:
       return;
     }
 
-    this->_pData = pBuffer->cesium.data.data();
+    this->_pData = data.data();
     this->_stride = accessorByteStride;
     this->_offset = accessor.byteOffset + pBufferView->byteOffset;
     this->_size = accessor.count;
@@ -33,6 +33,11 @@ public:
   /** @copydoc AccessorView::operator[]() */
   T& operator[](int64_t i) { return const_cast<T&>(this->_accessor[i]); }
 
+  /** @copydoc AccessorView::getUnchecked */
+  T& getUnchecked(int64_t i) noexcept {
+    return const_cast<T&>(this->_accessor.getUnchecked(i));
+  }
+
   /** @copydoc AccessorView::size */
   int64_t size() const noexcept { return this->_accessor.size(); }
 
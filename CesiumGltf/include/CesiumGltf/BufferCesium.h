@@ -2,6 +2,9 @@
 
 #include "CesiumGltf/Library.h"
 
+#include <CesiumUtility/SharedBytes.h>
+#include <gsl/span>
+
 #include <cstddef>
 #include <vector>
 
@@ -15,5 +18,28 @@ struct CESIUMGLTF_API BufferCesium final {
    * @brief The buffer's data.
    */
   std::vector<std::byte> data;
+
+  /**
+   * @brief The buffer's data when it is stored elsewhere, such as in a
+   * memory-mapped file, in place of {@link data}.
+   *
+   * When this is not empty, `data` is empty. Use {@link getData} to read the
+   * buffer's data wherever it is stored.
+   */
+  CesiumUtility::SharedBytes sharedData;
+
+  /**
+   * @brief Gets the buffer's data, from {@link sharedData} if it is set, or
+   * from {@link data} otherwise.
+   */
+  gsl::span<const std::byte> getData() const noexcept;
+
+  /**
+   * @brief Gets the buffer's data so that it can be modified.
+   *
+   * If the data is stored in {@link sharedData}, it is first copied into
+   * {@link data}, and `sharedData` is cleared.
+   */
+  std::vector<std::byte>& getMutableData();
 };
 } // namespace CesiumGltf
@@ -6,6 +6,9 @@
 #include "ImageCesium.h"
 #include "Model.h"
 
+#include <glm/vec2.hpp>
+#include <gsl/span>
+
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
@@ -98,6 +101,25 @@ public:
    */
   int64_t getFeatureID(double u, double v) const noexcept;
 
+  /**
+   * @brief Get the feature IDs from the texture at many texture coordinates at
+   * once, as {@link getFeatureID} would return them.
+   *
+   * The pixels are sampled in blocks, computing the pixel offsets of a block
+   * first and then assembling the feature IDs one channel at a time, which is
+   * much faster than calling {@link getFeatureID} for each texture coordinate.
+   * If the texture is somehow invalid, every feature ID is -1.
+   *
+   * @param uvs The texture coordinates, whose components must be within
+   * [0.0, 1.0].
+   * @param featureIDs The feature IDs at the nearest pixels to the texture
+   * coordinates, which must have room for a feature ID for each texture
+   * coordinate.
+   */
+  void getFeatureIDs(
+      const gsl::span<const glm::dvec2>& uvs,
+      const gsl::span<int64_t>& featureIDs) const noexcept;
+
   /**
    * @brief Get the status of this view.
    *
@@ -3,6 +3,9 @@
 #include "CesiumGltf/Ktx2TranscodeTargets.h"
 #include "CesiumGltf/Library.h"
 
+#include <CesiumUtility/SharedBytes.h>
+#include <gsl/span>
+
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -95,5 +98,28 @@ struct CESIUMGLTF_API ImageCesium final {
    * | 4                  | red, green, blue, alpha   |
    */
   std::vector<std::byte> pixelData;
+
+  /**
+   * @brief Pixel data that is stored elsewhere, such as in a memory-mapped
+   * file, in place of {@link pixelData}.
+   *
+   * When this is not empty, `pixelData` is empty. Use {@link getPixelData} to
+   * read the pixels wherever they are stored.
+   */
+  CesiumUtility::SharedBytes sharedPixelData;
+
+  /**
+   * @brief Gets the pixel data, from {@link sharedPixelData} if it is set, or
+   * from {@link pixelData} otherwise.
+   */
+  gsl::span<const std::byte> getPixelData() const noexcept;
+
+  /**
+   * @brief Gets the pixel data so that it can be modified.
+   *
+   * If the pixels are stored in {@link sharedPixelData}, they are first copied
+   * into {@link pixelData}, and `sharedPixelData` is cleared.
+   */
+  std::vector<std::byte>& getMutablePixelData();
 };
 } // namespace CesiumGltf
@@ -124,6 +124,19 @@ struct CESIUMGLTF_API Ktx2TranscodeTargets {
   Ktx2TranscodeTargets(
       const SupportedGpuCompressedPixelFormats& supportedFormats,
       bool preserveHighQuality);
+
+  /**
+   * @brief Returns whether two sets of targets transcode every format in the
+   * same way.
+   */
+  bool operator==(const Ktx2TranscodeTargets& rhs) const noexcept {
+    return this->ETC1S_R == rhs.ETC1S_R && this->ETC1S_RG == rhs.ETC1S_RG &&
+           this->ETC1S_RGB == rhs.ETC1S_RGB &&
+           this->ETC1S_RGBA == rhs.ETC1S_RGBA &&
+           this->UASTC_R == rhs.UASTC_R && this->UASTC_RG == rhs.UASTC_RG &&
+           this->UASTC_RGB == rhs.UASTC_RGB &&
+           this->UASTC_RGBA == rhs.UASTC_RGBA;
+  }
 };
 
 } // namespace CesiumGltf
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CesiumGltf/Library.h"
+#include "CesiumGltf/PropertyTableView.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CesiumGltf {
+
+/**
+ * @brief Where the values of a property are in a {@link PackedPropertyTable}.
+ */
+struct PackedProperty {
+  /**
+   * @brief The ID of the property in its class.
+   */
+  std::string propertyId;
+
+  /**
+   * @brief The number of values of each feature: 1 for a scalar or a
+   * boolean, or the number of components of a vector.
+   */
+  int64_t componentCount = 0;
+
+  /**
+   * @brief The index of the first value of the property among the
+   * {@link PackedPropertyTable::texelsPerFeature} texels of a feature, counted
+   * in channels. The values of a property never span two texels.
+   */
+  int64_t firstChannel = 0;
+};
+
+/**
+ * @brief Chosen properties of a {@link PropertyTable}, packed as 32-bit
+ * floats into the RGBA texels of a texture that is indexed by feature ID, so
+ * that a renderer can style features on the GPU.
+ *
+ * Each feature has {@link texelsPerFeature} consecutive texels, so the
+ * values of feature `f` start at texel `t = f * texelsPerFeature`, which is
+ * at column `t % width` and row `t / width`. A feature's texels are never
+ * split between rows. The values have the property's offset, scale, and
+ * normalization applied, and a "no data" value is replaced by the
+ * property's default value or, if there is none, by NaN. Booleans are 0 or
+ * 1. Integers larger than 2^24 and doubles lose precision.
+ */
+struct CESIUMGLTF_API PackedPropertyTable {
+  /**
+   * @brief The properties that were packed, in the order they were requested.
+   * Properties that do not exist, are invalid, or are not scalars, vectors, or
+   * booleans are left out.
+   */
+  std::vector<PackedProperty> properties;
+
+  /**
+   * @brief The number of features, which is {@link PropertyTable::count}.
+   */
+  int64_t featureCount = 0;
+
+  /**
+   * @brief The number of RGBA texels of each feature.
+   */
+  int64_t texelsPerFeature = 0;
+
+  /**
+   * @brief The width of the texture in texels, which is a multiple of
+   * {@link texelsPerFeature}.
+   */
+  int64_t width = 0;
+
+  /**
+   * @brief The height of the texture in texels.
+   */
+  int64_t height = 0;
+
+  /**
+   * @brief The `width * height * 4` channels of the texels, row by row. The
+   * texels after those of the last feature are zero.
+   */
+  std::vector<float> values;
+
+  /**
+   * @brief Gets the number of bytes of memory used by the values.
+   */
+  int64_t getSizeBytes() const noexcept;
+};
+
+/**
+ * @brief Packs properties of a {@link PropertyTable} into a
+ * {@link PackedPropertyTable}.
+ *
+ * @param propertyTable The view of the property table.
+ * @param propertyIds The IDs of the properties to pack.
+ * @param maximumWidth The largest width of the texture, in texels.
+ * @return The packed properties, which have no values if the view is invalid
+ * or none of the properties could be packed.
+ */
+PackedPropertyTable packPropertyTable(
+    const PropertyTableView& propertyTable,
+    const std::vector<std::string>& propertyIds,
+    int64_t maximumWidth = 4096);
+
+} // namespace CesiumGltf
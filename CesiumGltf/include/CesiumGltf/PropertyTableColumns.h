@@ -0,0 +1,205 @@
+#pragma once
+
+#include "CesiumGltf/PropertyTablePropertyView.h"
+#include "CesiumGltf/PropertyTableView.h"
+#include "CesiumGltf/PropertyType.h"
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace CesiumGltf {
+
+/**
+ * @brief The layout of the buffers of a {@link PropertyTableColumn}, which
+ * corresponds to an Apache Arrow array type.
+ */
+enum class PropertyTableColumnLayout {
+  /**
+   * @brief The property was not exported, because it is invalid or because its
+   * type has no columnar layout. Arrays of booleans and arrays of strings are
+   * not exported.
+   */
+  None,
+
+  /**
+   * @brief Each element has {@link PropertyTableColumn::componentCount} values
+   * of {@link PropertyTableColumn::componentType}, stored one after another in
+   * the values buffer. This is an Arrow primitive array when there is one
+   * component, and a fixed-size list otherwise.
+   */
+  FixedWidth,
+
+  /**
+   * @brief Each element is a bit of the values buffer, from the least
+   * significant bit of each byte. This is an Arrow boolean array.
+   */
+  Boolean,
+
+  /**
+   * @brief Element `i` is the UTF-8 text of the values buffer between offsets
+   * `i` and `i + 1` of the offsets buffer. This is an Arrow utf8 array, or a
+   * large_utf8 array if the offsets are 64-bit.
+   */
+  String,
+
+  /**
+   * @brief Element `i` is the array of the values buffer between offsets `i`
+   * and `i + 1` of the offsets buffer, which count the elements of the array.
+   * Each array element has {@link PropertyTableColumn::componentCount} values
+   * of {@link PropertyTableColumn::componentType}. This is an Arrow list
+   * array, or a large_list array if the offsets are 64-bit.
+   */
+  List
+};
+
+/**
+ * @brief A buffer of a {@link PropertyTableColumn}, which either views the
+ * data of the glTF buffer in place or owns the data that had to be converted.
+ */
+class PropertyTableColumnBuffer {
+public:
+  /**
+   * @brief Constructs an empty buffer.
+   */
+  PropertyTableColumnBuffer() noexcept : _data{gsl::span<const std::byte>()} {}
+
+  /**
+   * @brief Constructs a buffer that views data in place. The data must
+   * outlive the buffer.
+   */
+  explicit PropertyTableColumnBuffer(
+      const gsl::span<const std::byte>& buffer) noexcept
+      : _data{buffer} {}
+
+  /**
+   * @brief Constructs a buffer that owns its data.
+   */
+  explicit PropertyTableColumnBuffer(std::vector<std::byte>&& bytes) noexcept
+      : _data{std::move(bytes)} {}
+
+  /**
+   * @brief Gets the data of the buffer.
+   */
+  gsl::span<const std::byte> data() const noexcept {
+    return std::visit(
+        [](const auto& value) { return gsl::span<const std::byte>(value); },
+        this->_data);
+  }
+
+  /**
+   * @brief Gets whether the data is owned by the buffer, rather than viewed
+   * in place.
+   */
+  bool isOwned() const noexcept {
+    return std::holds_alternative<std::vector<std::byte>>(this->_data);
+  }
+
+private:
+  std::variant<gsl::span<const std::byte>, std::vector<std::byte>> _data;
+};
+
+/**
+ * @brief A property of a {@link PropertyTable} as columnar buffers of values,
+ * offsets, and validity, in the layout of an Apache Arrow array.
+ *
+ * The buffers view the glTF buffers in place where their layout already
+ * matches, so a column of a property with fixed-width values, booleans, or
+ * strings with 32-bit or 64-bit offsets copies nothing. The values are
+ * converted where the layout does not match: when a property is normalized
+ * or has an offset, scale, "no data" value, or only a default value, and
+ * when offsets must be widened or counted in elements rather than bytes.
+ */
+struct PropertyTableColumn {
+  /**
+   * @brief The ID of the property in its class.
+   */
+  std::string propertyId;
+
+  /**
+   * @brief The status of the view of the property, which is
+   * {@link PropertyTablePropertyViewStatus::Valid} or
+   * {@link PropertyTablePropertyViewStatus::EmptyPropertyWithDefault} if the
+   * property was exported.
+   */
+  PropertyViewStatusType status =
+      PropertyTablePropertyViewStatus::ErrorNonexistentProperty;
+
+  /**
+   * @brief The layout of the buffers.
+   */
+  PropertyTableColumnLayout layout = PropertyTableColumnLayout::None;
+
+  /**
+   * @brief The type of the values. A normalized property is exported as its
+   * normalized {@link PropertyComponentType::Float64} values.
+   */
+  PropertyComponentType componentType = PropertyComponentType::None;
+
+  /**
+   * @brief The number of values of each element, or of each array element of
+   * a {@link PropertyTableColumnLayout::List}: for example, 3 for a `VEC3`, or
+   * 6 for a fixed-length array of two `VEC3`s.
+   */
+  int64_t componentCount = 0;
+
+  /**
+   * @brief The type of the offsets, which is either
+   * {@link PropertyComponentType::Uint32} or
+   * {@link PropertyComponentType::Uint64}. The offsets never exceed the
+   * largest signed value of their type, so they may be read as the signed
+   * offsets of Arrow. This is {@link PropertyComponentType::None} if there are
+   * no offsets.
+   */
+  PropertyComponentType offsetType = PropertyComponentType::None;
+
+  /**
+   * @brief The number of elements, which is {@link PropertyTable::count}.
+   */
+  int64_t length = 0;
+
+  /**
+   * @brief The number of elements that are null, which are those equal to the
+   * "no data" value of a property without a default value.
+   */
+  int64_t nullCount = 0;
+
+  /**
+   * @brief The values of the elements.
+   */
+  PropertyTableColumnBuffer values;
+
+  /**
+   * @brief The `length + 1` offsets of the elements, for the
+   * {@link PropertyTableColumnLayout::String} and
+   * {@link PropertyTableColumnLayout::List} layouts.
+   */
+  PropertyTableColumnBuffer offsets;
+
+  /**
+   * @brief The validity bitmap of the elements, where bit `i % 8` of byte
+   * `i / 8` is set if element `i` is not null. This is empty if no element is
+   * null.
+   */
+  PropertyTableColumnBuffer validity;
+};
+
+/**
+ * @brief Exports each property of a {@link PropertyTable} as a
+ * {@link PropertyTableColumn}, in the order of the properties of its class.
+ *
+ * The columns may view the buffers of the model of the property table, which
+ * must outlive them.
+ *
+ * @param propertyTable The view of the property table.
+ * @return The columns, or an empty vector if the view is invalid.
+ */
+std::vector<PropertyTableColumn>
+exportPropertyTableColumns(const PropertyTableView& propertyTable);
+
+} // namespace CesiumGltf
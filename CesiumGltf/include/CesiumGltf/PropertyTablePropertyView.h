@@ -7,11 +7,13 @@
 
 #include <gsl/span>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 namespace CesiumGltf {
 /**
@@ -375,6 +377,104 @@ public:
     }
   }
 
+  /**
+   * @brief The type of the values that {@link getRange} writes one after
+   * another for each element: the element type itself for numeric types, or
+   * the type of the array elements for fixed-length numeric arrays.
+   */
+  using RangeValueType = typename MetadataRangeType<ElementType>::type;
+
+  /**
+   * @brief Gets the values of a contiguous range of elements of the
+   * {@link PropertyTable} at once, with offset and scale applied, as
+   * {@link get} would return them.
+   *
+   * The raw values are copied out in one pass, and the scale and offset are
+   * then applied to the whole range, which is much faster than calling
+   * {@link get} for each element. Only numeric properties and fixed-length
+   * arrays of numeric values are supported. The values of an array element
+   * are written one after another.
+   *
+   * An element whose raw value equals the "no data" value is given the
+   * default value. If there is no default value, its values are zeroed and it
+   * is marked as invalid in the validity bitmap, where {@link get} would
+   * return std::nullopt. Bit `i % 8` of byte `i / 8` of the bitmap is set if
+   * the `i`th element of the range is valid.
+   *
+   * @param start The index of the first element of the range.
+   * @param count The number of elements in the range.
+   * @param values The values of the elements, which must have room for `count`
+   * times the number of values of an element.
+   * @param validity The validity bitmap, which must have room for `count`
+   * bits.
+   * @return The number of valid elements in the range.
+   */
+  int64_t getRange(
+      int64_t start,
+      int64_t count,
+      gsl::span<RangeValueType> values,
+      gsl::span<std::byte> validity) const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value ||
+            IsMetadataNumericArray<ElementType>::value,
+        "Only numeric properties and arrays support range reads");
+    assert(
+        (this->_status == PropertyTablePropertyViewStatus::Valid ||
+         this->_status ==
+             PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) &&
+        "Check the status() first to make sure view is valid");
+    assert(start >= 0 && "start must be non-negative");
+    assert(count >= 0 && "count must be non-negative");
+    assert(start + count <= _size && "range must be within size");
+
+    size_t componentCount = 1;
+    if constexpr (IsMetadataNumericArray<ElementType>::value) {
+      assert(
+          this->arrayCount() > 0 &&
+          "Only fixed-length arrays support range reads");
+      componentCount = static_cast<size_t>(this->arrayCount());
+    }
+
+    const size_t valueCount = static_cast<size_t>(count) * componentCount;
+    assert(values.size() >= valueCount && "values must fit the range");
+    assert(
+        validity.size() >= static_cast<size_t>((count + 7) / 8) &&
+        "validity must fit the range");
+    const gsl::span<RangeValueType> range = values.first(valueCount);
+
+    if (this->_status ==
+        PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+      return CesiumImpl::fillRangeWithDefault<RangeValueType>(
+          range,
+          validity,
+          CesiumImpl::getRangeComponents(this->defaultValue()));
+    }
+
+    const gsl::span<const RangeValueType> raw(
+        reinterpret_cast<const RangeValueType*>(_values.data()) +
+            static_cast<size_t>(start) * componentCount,
+        valueCount);
+    std::copy(raw.begin(), raw.end(), range.data());
+
+    const std::vector<RangeValueType> scale =
+        CesiumImpl::getRangeComponents(this->scale());
+    const std::vector<RangeValueType> offset =
+        CesiumImpl::getRangeComponents(this->offset());
+    transformValues<RangeValueType>(range, scale, offset);
+
+    CesiumImpl::setRangeValidity(validity, count);
+    if (!this->noData()) {
+      return count;
+    }
+
+    return CesiumImpl::replaceRangeNoData<RangeValueType, RangeValueType>(
+        raw,
+        range,
+        validity,
+        CesiumImpl::getRangeComponents(this->noData()),
+        CesiumImpl::getRangeComponents(this->defaultValue()));
+  }
+
   /**
    * @brief Get the number of elements in this
    * PropertyTablePropertyView. If the view is valid, this returns
@@ -384,6 +484,45 @@ public:
    */
   int64_t size() const noexcept { return _size; }
 
+  /**
+   * @brief Gets the buffer of the raw values of this property, as specified
+   * by {@link PropertyTableProperty::values}. This is empty if the property
+   * has no data.
+   */
+  gsl::span<const std::byte> valuesBuffer() const noexcept { return _values; }
+
+  /**
+   * @brief Gets the buffer of the array offsets of this property, as
+   * specified by {@link PropertyTableProperty::arrayOffsets}. This is empty
+   * unless the property is a variable-length array.
+   */
+  gsl::span<const std::byte> arrayOffsetsBuffer() const noexcept {
+    return _arrayOffsets;
+  }
+
+  /**
+   * @brief Gets the type of the offsets in {@link arrayOffsetsBuffer}.
+   */
+  PropertyComponentType arrayOffsetType() const noexcept {
+    return _arrayOffsetType;
+  }
+
+  /**
+   * @brief Gets the buffer of the string offsets of this property, as
+   * specified by {@link PropertyTableProperty::stringOffsets}. This is empty
+   * unless the property is a string or an array of strings.
+   */
+  gsl::span<const std::byte> stringOffsetsBuffer() const noexcept {
+    return _stringOffsets;
+  }
+
+  /**
+   * @brief Gets the type of the offsets in {@link stringOffsetsBuffer}.
+   */
+  PropertyComponentType stringOffsetType() const noexcept {
+    return _stringOffsetType;
+  }
+
 private:
   ElementType getNumericValue(int64_t index) const noexcept {
     return reinterpret_cast<const ElementType*>(_values.data())[index];
@@ -746,6 +885,110 @@ public:
     }
   }
 
+  /**
+   * @brief The type of the normalized values that {@link getRange} writes one
+   * after another for each element: the normalized type for numeric types, or
+   * the normalized type of the array elements for fixed-length arrays.
+   */
+  using RangeValueType = typename TypeToNormalizedType<
+      typename MetadataRangeType<ElementType>::type>::type;
+
+  /**
+   * @brief Gets the normalized values of a contiguous range of elements of the
+   * {@link PropertyTable} at once, with offset and scale applied, as
+   * {@link get} would return them.
+   *
+   * The raw values are normalized in one pass, and the scale and offset are
+   * then applied to the whole range, which is much faster than calling
+   * {@link get} for each element. Only numeric properties and fixed-length
+   * arrays of numeric values are supported. The values of an array element
+   * are written one after another.
+   *
+   * An element whose raw value equals the "no data" value is given the
+   * default value. If there is no default value, its values are zeroed and it
+   * is marked as invalid in the validity bitmap, where {@link get} would
+   * return std::nullopt. Bit `i % 8` of byte `i / 8` of the bitmap is set if
+   * the `i`th element of the range is valid.
+   *
+   * @param start The index of the first element of the range.
+   * @param count The number of elements in the range.
+   * @param values The values of the elements, which must have room for `count`
+   * times the number of values of an element.
+   * @param validity The validity bitmap, which must have room for `count`
+   * bits.
+   * @return The number of valid elements in the range.
+   */
+  int64_t getRange(
+      int64_t start,
+      int64_t count,
+      gsl::span<RangeValueType> values,
+      gsl::span<std::byte> validity) const noexcept {
+    using RawType = typename MetadataRangeType<ElementType>::type;
+    assert(
+        (this->_status == PropertyTablePropertyViewStatus::Valid ||
+         this->_status ==
+             PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) &&
+        "Check the status() first to make sure view is valid");
+    assert(start >= 0 && "start must be non-negative");
+    assert(count >= 0 && "count must be non-negative");
+    assert(start + count <= _size && "range must be within size");
+
+    size_t componentCount = 1;
+    if constexpr (IsMetadataArray<ElementType>::value) {
+      assert(
+          this->arrayCount() > 0 &&
+          "Only fixed-length arrays support range reads");
+      componentCount = static_cast<size_t>(this->arrayCount());
+    }
+
+    const size_t valueCount = static_cast<size_t>(count) * componentCount;
+    assert(values.size() >= valueCount && "values must fit the range");
+    assert(
+        validity.size() >= static_cast<size_t>((count + 7) / 8) &&
+        "validity must fit the range");
+    const gsl::span<RangeValueType> range = values.first(valueCount);
+
+    if (this->_status ==
+        PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+      return CesiumImpl::fillRangeWithDefault<RangeValueType>(
+          range,
+          validity,
+          CesiumImpl::getRangeComponents(this->defaultValue()));
+    }
+
+    const gsl::span<const RawType> raw(
+        reinterpret_cast<const RawType*>(_values.data()) +
+            static_cast<size_t>(start) * componentCount,
+        valueCount);
+    for (size_t i = 0; i < valueCount; ++i) {
+      if constexpr (IsMetadataScalar<RawType>::value) {
+        range[i] = normalize<RawType>(raw[i]);
+      } else {
+        constexpr glm::length_t N = RawType::length();
+        using T = typename RawType::value_type;
+        range[i] = normalize<N, T>(raw[i]);
+      }
+    }
+
+    const std::vector<RangeValueType> scale =
+        CesiumImpl::getRangeComponents(this->scale());
+    const std::vector<RangeValueType> offset =
+        CesiumImpl::getRangeComponents(this->offset());
+    transformValues<RangeValueType>(range, scale, offset);
+
+    CesiumImpl::setRangeValidity(validity, count);
+    if (!this->noData()) {
+      return count;
+    }
+
+    return CesiumImpl::replaceRangeNoData<RawType, RangeValueType>(
+        raw,
+        range,
+        validity,
+        CesiumImpl::getRangeComponents(this->noData()),
+        CesiumImpl::getRangeComponents(this->defaultValue()));
+  }
+
   /**
    * @brief Get the number of elements in this
    * PropertyTablePropertyView. If the view is valid, this returns
@@ -757,6 +1000,29 @@ public:
     return this->_status == PropertyTablePropertyViewStatus::Valid ? _size : 0;
   }
 
+  /**
+   * @brief Gets the buffer of the raw values of this property, as specified
+   * by {@link PropertyTableProperty::values}. This is empty if the property
+   * has no data.
+   */
+  gsl::span<const std::byte> valuesBuffer() const noexcept { return _values; }
+
+  /**
+   * @brief Gets the buffer of the array offsets of this property, as
+   * specified by {@link PropertyTableProperty::arrayOffsets}. This is empty
+   * unless the property is a variable-length array.
+   */
+  gsl::span<const std::byte> arrayOffsetsBuffer() const noexcept {
+    return _arrayOffsets;
+  }
+
+  /**
+   * @brief Gets the type of the offsets in {@link arrayOffsetsBuffer}.
+   */
+  PropertyComponentType arrayOffsetType() const noexcept {
+    return _arrayOffsetType;
+  }
+
 private:
   ElementType getValue(int64_t index) const noexcept {
     return reinterpret_cast<const ElementType*>(_values.data())[index];
@@ -7,10 +7,15 @@
 #include "CesiumGltf/PropertyView.h"
 #include "CesiumGltf/Sampler.h"
 
+#include <glm/vec2.hpp>
+#include <gsl/span>
+
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace CesiumGltf {
 /**
@@ -199,6 +204,32 @@ std::array<uint8_t, 4> sampleNearestPixel(
     const double u,
     const double v);
 
+/**
+ * @brief Samples the nearest pixels of an image for many texture coordinates,
+ * applying the sampler's wrapping modes, as {@link sampleNearestPixel} does
+ * for each of them.
+ *
+ * The pixel offsets of a block of texture coordinates are computed first, and
+ * the channels are then gathered one at a time across the block, so that
+ * both loops can be vectorized.
+ *
+ * @param image The image to sample.
+ * @param channels The channels to gather from each pixel.
+ * @param wrapS The wrapping mode of the u-component.
+ * @param wrapT The wrapping mode of the v-component.
+ * @param uvs The texture coordinates.
+ * @param channelValues The values of the channels of each pixel, one after
+ * another, which must have room for the number of channels for each texture
+ * coordinate.
+ */
+void sampleNearestPixels(
+    const ImageCesium& image,
+    const std::vector<int64_t>& channels,
+    const int32_t wrapS,
+    const int32_t wrapT,
+    const gsl::span<const glm::dvec2>& uvs,
+    const gsl::span<uint8_t>& channelValues);
+
 /**
  * @brief A view of the data specified by a {@link PropertyTextureProperty}.
  *
@@ -403,6 +434,109 @@ public:
         gsl::span(sample.data(), this->_channels.size()));
   }
 
+  /**
+   * @brief Gets the values of the property for many texture coordinates at
+   * once, with all value transforms applied, as {@link get} would return them.
+   *
+   * The texels are sampled in blocks, and the offset and scale are then
+   * applied to all of the values at once, which is much faster than calling
+   * {@link get} for each texture coordinate. Only scalar and vecN properties
+   * are supported.
+   *
+   * A value that equals the "no data" value is given the default value. If
+   * there is no default value, it is zeroed and marked as invalid in the
+   * validity bitmap, where {@link get} would return std::nullopt. Bit `i % 8`
+   * of byte `i / 8` of the bitmap is set if the `i`th value is valid.
+   *
+   * @param uvs The texture coordinates.
+   * @param values The values, which must have room for a value for each
+   * texture coordinate.
+   * @param validity The validity bitmap, which must have room for a bit for
+   * each texture coordinate.
+   * @return The number of valid values.
+   */
+  int64_t getBatch(
+      const gsl::span<const glm::dvec2>& uvs,
+      const gsl::span<ElementType>& values,
+      const gsl::span<std::byte>& validity) const noexcept {
+    assert(values.size() >= uvs.size() && "values must fit the batch");
+    assert(
+        validity.size() >= (uvs.size() + 7) / 8 &&
+        "validity must fit the batch");
+    const gsl::span<ElementType> batch = values.first(uvs.size());
+
+    if (this->_status ==
+        PropertyTexturePropertyViewStatus::EmptyPropertyWithDefault) {
+      return CesiumImpl::fillRangeWithDefault<ElementType>(
+          batch,
+          validity,
+          CesiumImpl::getRangeComponents(this->defaultValue()));
+    }
+
+    getRawBatch(uvs, batch);
+
+    std::vector<ElementType> raw;
+    if (this->noData()) {
+      raw.assign(batch.begin(), batch.end());
+    }
+
+    const std::vector<ElementType> scale =
+        CesiumImpl::getRangeComponents(this->scale());
+    const std::vector<ElementType> offset =
+        CesiumImpl::getRangeComponents(this->offset());
+    transformValues<ElementType>(batch, scale, offset);
+
+    const int64_t count = static_cast<int64_t>(uvs.size());
+    CesiumImpl::setRangeValidity(validity, count);
+    if (!this->noData()) {
+      return count;
+    }
+
+    return CesiumImpl::replaceRangeNoData<ElementType, ElementType>(
+        raw,
+        batch,
+        validity,
+        CesiumImpl::getRangeComponents(this->noData()),
+        CesiumImpl::getRangeComponents(this->defaultValue()));
+  }
+
+  /**
+   * @brief Gets the raw values of the property for many texture coordinates at
+   * once, as {@link getRaw} would return them. Only scalar and vecN properties
+   * are supported.
+   *
+   * @param uvs The texture coordinates.
+   * @param values The values, which must have room for a value for each
+   * texture coordinate.
+   */
+  void getRawBatch(
+      const gsl::span<const glm::dvec2>& uvs,
+      const gsl::span<ElementType>& values) const noexcept {
+    static_assert(
+        IsMetadataScalar<ElementType>::value ||
+            IsMetadataVecN<ElementType>::value,
+        "Only scalar and vecN properties support batch sampling");
+    assert(
+        this->_status == PropertyTexturePropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+    assert(values.size() >= uvs.size() && "values must fit the batch");
+
+    const size_t channelCount = this->_channels.size();
+    std::vector<uint8_t> channelValues(uvs.size() * channelCount);
+    sampleNearestPixels(
+        *this->_pImage,
+        this->_channels,
+        this->_pSampler->wrapS,
+        this->_pSampler->wrapT,
+        uvs,
+        channelValues);
+
+    for (size_t i = 0; i < uvs.size(); ++i) {
+      values[i] = assembleValueFromChannels<ElementType>(
+          gsl::span(channelValues.data() + i * channelCount, channelCount));
+    }
+  }
+
   /**
    * @brief Get the texture coordinate set index for this property.
    */
@@ -663,6 +797,115 @@ public:
         gsl::span(sample.data(), this->_channels.size()));
   }
 
+  /**
+   * @brief Gets the normalized values of the property for many texture
+   * coordinates at once, with all value transforms applied, as {@link get}
+   * would return them.
+   *
+   * The texels are sampled in blocks, and the offset and scale are then
+   * applied to all of the values at once, which is much faster than calling
+   * {@link get} for each texture coordinate. Only scalar and vecN properties
+   * are supported.
+   *
+   * A value that equals the "no data" value is given the default value. If
+   * there is no default value, it is zeroed and marked as invalid in the
+   * validity bitmap, where {@link get} would return std::nullopt. Bit `i % 8`
+   * of byte `i / 8` of the bitmap is set if the `i`th value is valid.
+   *
+   * @param uvs The texture coordinates.
+   * @param values The values, which must have room for a value for each
+   * texture coordinate.
+   * @param validity The validity bitmap, which must have room for a bit for
+   * each texture coordinate.
+   * @return The number of valid values.
+   */
+  int64_t getBatch(
+      const gsl::span<const glm::dvec2>& uvs,
+      const gsl::span<NormalizedType>& values,
+      const gsl::span<std::byte>& validity) const noexcept {
+    assert(values.size() >= uvs.size() && "values must fit the batch");
+    assert(
+        validity.size() >= (uvs.size() + 7) / 8 &&
+        "validity must fit the batch");
+    const gsl::span<NormalizedType> batch = values.first(uvs.size());
+
+    if (this->_status ==
+        PropertyTexturePropertyViewStatus::EmptyPropertyWithDefault) {
+      return CesiumImpl::fillRangeWithDefault<NormalizedType>(
+          batch,
+          validity,
+          CesiumImpl::getRangeComponents(this->defaultValue()));
+    }
+
+    std::vector<ElementType> raw(uvs.size());
+    getRawBatch(uvs, raw);
+    for (size_t i = 0; i < raw.size(); ++i) {
+      if constexpr (IsMetadataScalar<ElementType>::value) {
+        batch[i] = normalize<ElementType>(raw[i]);
+      } else {
+        constexpr glm::length_t N = ElementType::length();
+        using T = typename ElementType::value_type;
+        batch[i] = normalize<N, T>(raw[i]);
+      }
+    }
+
+    const std::vector<NormalizedType> scale =
+        CesiumImpl::getRangeComponents(this->scale());
+    const std::vector<NormalizedType> offset =
+        CesiumImpl::getRangeComponents(this->offset());
+    transformValues<NormalizedType>(batch, scale, offset);
+
+    const int64_t count = static_cast<int64_t>(uvs.size());
+    CesiumImpl::setRangeValidity(validity, count);
+    if (!this->noData()) {
+      return count;
+    }
+
+    return CesiumImpl::replaceRangeNoData<ElementType, NormalizedType>(
+        raw,
+        batch,
+        validity,
+        CesiumImpl::getRangeComponents(this->noData()),
+        CesiumImpl::getRangeComponents(this->defaultValue()));
+  }
+
+  /**
+   * @brief Gets the raw values of the property for many texture coordinates at
+   * once, as {@link getRaw} would return them. Only scalar and vecN properties
+   * are supported.
+   *
+   * @param uvs The texture coordinates.
+   * @param values The values, which must have room for a value for each
+   * texture coordinate.
+   */
+  void getRawBatch(
+      const gsl::span<const glm::dvec2>& uvs,
+      const gsl::span<ElementType>& values) const noexcept {
+    static_assert(
+        IsMetadataScalar<ElementType>::value ||
+            IsMetadataVecN<ElementType>::value,
+        "Only scalar and vecN properties support batch sampling");
+    assert(
+        this->_status == PropertyTexturePropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+    assert(values.size() >= uvs.size() && "values must fit the batch");
+
+    const size_t channelCount = this->_channels.size();
+    std::vector<uint8_t> channelValues(uvs.size() * channelCount);
+    sampleNearestPixels(
+        *this->_pImage,
+        this->_channels,
+        this->_pSampler->wrapS,
+        this->_pSampler->wrapT,
+        uvs,
+        channelValues);
+
+    for (size_t i = 0; i < uvs.size(); ++i) {
+      values[i] = assembleValueFromChannels<ElementType>(
+          gsl::span(channelValues.data() + i * channelCount, channelCount));
+    }
+  }
+
   /**
    * @brief Get the texture coordinate set index for this property.
    */
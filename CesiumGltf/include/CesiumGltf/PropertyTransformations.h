@@ -4,10 +4,14 @@
 #include "CesiumGltf/PropertyTypeTraits.h"
 
 #include <glm/common.hpp>
+#include <gsl/span>
 
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 namespace CesiumGltf {
 template <typename T> double normalize(T value) {
@@ -78,6 +82,53 @@ T transformValue(
   return result;
 }
 
+/**
+ * @brief Transforms values that are stored one after another by a scale and
+ * then an offset, as {@link transformValue} does for each value.
+ *
+ * The scale and offset have a value for each of the values of an element,
+ * such as each value of a fixed-length array, which are applied to each
+ * element in turn. Either may be empty to not apply it. The scale and offset
+ * are each applied to all of the values in a separate loop, so that the
+ * loops can be vectorized.
+ *
+ * @param values The values, whose number must be a multiple of the number of
+ * values of the scale and the offset.
+ * @param scale The scale, or an empty span.
+ * @param offset The offset, or an empty span.
+ */
+template <typename T>
+void transformValues(
+    const gsl::span<T>& values,
+    const gsl::span<const T>& scale,
+    const gsl::span<const T>& offset) {
+  if (scale.size() == 1) {
+    const T s = scale[0];
+    for (T& value : values) {
+      value = applyScale<T>(value, s);
+    }
+  } else if (!scale.empty()) {
+    for (size_t i = 0; i < values.size(); i += scale.size()) {
+      for (size_t j = 0; j < scale.size(); ++j) {
+        values[i + j] = applyScale<T>(values[i + j], scale[j]);
+      }
+    }
+  }
+
+  if (offset.size() == 1) {
+    const T o = offset[0];
+    for (T& value : values) {
+      value += o;
+    }
+  } else if (!offset.empty()) {
+    for (size_t i = 0; i < values.size(); i += offset.size()) {
+      for (size_t j = 0; j < offset.size(); ++j) {
+        values[i + j] += offset[j];
+      }
+    }
+  }
+}
+
 template <typename T>
 PropertyArrayView<T> transformArray(
     const PropertyArrayView<T>& value,
@@ -163,4 +214,118 @@ PropertyArrayView<glm::mat<N, N, double>> transformNormalizedMatNArray(
 
   return PropertyArrayView<glm::mat<N, N, double>>(std::move(result));
 }
+namespace CesiumImpl {
+/**
+ * @brief Gets the components of an optional value of a property, as they are
+ * stored one after another in a range: the value itself, or nothing if it is
+ * not present.
+ */
+template <typename T>
+std::vector<T> getRangeComponents(const std::optional<T>& value) {
+  if (!value) {
+    return {};
+  }
+  return {*value};
+}
+
+/**
+ * @brief Gets the components of an optional array value of a property, as
+ * they are stored one after another in a range: the elements of the array, or
+ * nothing if it is not present.
+ */
+template <typename T>
+std::vector<T>
+getRangeComponents(const std::optional<PropertyArrayView<T>>& value) {
+  std::vector<T> result;
+  if (value) {
+    result.reserve(static_cast<size_t>(value->size()));
+    for (int64_t i = 0; i < value->size(); ++i) {
+      result.push_back((*value)[i]);
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Marks the first `count` elements of a validity bitmap as valid, and
+ * clears the rest of the last byte.
+ */
+inline void setRangeValidity(gsl::span<std::byte> validity, int64_t count) {
+  const size_t fullBytes = static_cast<size_t>(count / 8);
+  std::fill_n(validity.data(), fullBytes, std::byte{0xFF});
+  if (count % 8 != 0) {
+    validity[fullBytes] =
+        std::byte(static_cast<unsigned char>((1u << (count % 8)) - 1u));
+  }
+}
+
+/**
+ * @brief Fills a range with the default value of a property that has no data
+ * but a default value, marking each element as valid.
+ *
+ * @return The number of elements in the range.
+ */
+template <typename T>
+int64_t fillRangeWithDefault(
+    gsl::span<T> values,
+    gsl::span<std::byte> validity,
+    const std::vector<T>& defaultValue) {
+  assert(!defaultValue.empty() && "A default value is required");
+  const size_t count = values.size() / defaultValue.size();
+  for (size_t i = 0; i < count; ++i) {
+    std::copy(
+        defaultValue.begin(),
+        defaultValue.end(),
+        values.data() + i * defaultValue.size());
+  }
+  setRangeValidity(validity, static_cast<int64_t>(count));
+  return static_cast<int64_t>(count);
+}
+
+/**
+ * @brief Replaces the elements of a range whose raw values equal the "no
+ * data" value of the property with its default value. Without a default
+ * value, the elements are zeroed instead and marked as invalid in the
+ * validity bitmap.
+ *
+ * @param raw The raw values of the elements in the range.
+ * @param values The transformed values of the elements in the range.
+ * @param validity The validity bitmap of the range, with every element marked
+ * as valid.
+ * @param noData The components of the "no data" value.
+ * @param defaultValue The components of the default value, or nothing.
+ * @return The number of valid elements in the range.
+ */
+template <typename RawType, typename T>
+int64_t replaceRangeNoData(
+    gsl::span<const RawType> raw,
+    gsl::span<T> values,
+    gsl::span<std::byte> validity,
+    const std::vector<RawType>& noData,
+    const std::vector<T>& defaultValue) {
+  const size_t componentCount = noData.size();
+  const size_t count = values.size() / componentCount;
+  int64_t validCount = static_cast<int64_t>(count);
+  for (size_t i = 0; i < count; ++i) {
+    const size_t first = i * componentCount;
+    if (!std::equal(noData.begin(), noData.end(), raw.data() + first)) {
+      continue;
+    }
+
+    if (!defaultValue.empty()) {
+      std::copy(
+          defaultValue.begin(),
+          defaultValue.end(),
+          values.data() + first);
+      continue;
+    }
+
+    std::fill_n(values.data() + first, componentCount, T(0));
+    validity[i / 8] &= ~std::byte(static_cast<unsigned char>(1u << (i % 8)));
+    --validCount;
+  }
+  return validCount;
+}
+} // namespace CesiumImpl
+
 } // namespace CesiumGltf
@@ -135,6 +135,19 @@ struct MetadataArrayType<CesiumGltf::PropertyArrayView<T>> {
   using type = T;
 };
 
+/**
+ * @brief Retrieve the type of the values of a metadata property that are
+ * stored one after another: the component type of an array, or the type itself
+ * otherwise.
+ */
+template <typename T> struct MetadataRangeType {
+  using type = T;
+};
+template <typename T>
+struct MetadataRangeType<CesiumGltf::PropertyArrayView<T>> {
+  using type = T;
+};
+
 /**
  * @brief Convert a C++ type to PropertyType and PropertyComponentType
  */
@@ -0,0 +1,21 @@
+#include "CesiumGltf/BufferCesium.h"
+
+namespace CesiumGltf {
+
+gsl::span<const std::byte> BufferCesium::getData() const noexcept {
+  if (!this->sharedData.getBytes().empty()) {
+    return this->sharedData.getBytes();
+  }
+  return this->data;
+}
+
+std::vector<std::byte>& BufferCesium::getMutableData() {
+  const gsl::span<const std::byte> shared = this->sharedData.getBytes();
+  if (!shared.empty()) {
+    this->data.assign(shared.begin(), shared.end());
+    this->sharedData = CesiumUtility::SharedBytes();
+  }
+  return this->data;
+}
+
+} // namespace CesiumGltf
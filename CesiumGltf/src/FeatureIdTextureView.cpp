@@ -1,5 +1,10 @@
 #include "CesiumGltf/FeatureIdTextureView.h"
 
+#include <glm/common.hpp>
+
+#include <array>
+#include <cassert>
+
 namespace CesiumGltf {
 FeatureIdTextureView::FeatureIdTextureView() noexcept
     : _status(FeatureIdTextureViewStatus::ErrorUninitialized),
@@ -97,14 +102,69 @@ int64_t FeatureIdTextureView::getFeatureID(double u, double v) const noexcept {
   // As stated in the spec: values from the selected channels are treated as
   // unsigned 8 bit integers, and represent the bytes of the actual feature ID,
   // in little-endian order.
+  const gsl::span<const std::byte> pixels = this->_pImage->getPixelData();
   for (size_t i = 0; i < this->_channels.size(); i++) {
     int64_t channelValue = static_cast<int64_t>(
-        this->_pImage
-            ->pixelData[static_cast<size_t>(pixelOffset + this->_channels[i])]);
+        pixels[static_cast<size_t>(pixelOffset + this->_channels[i])]);
     value |= channelValue << bitOffset;
     bitOffset += 8;
   }
 
   return value;
 }
+
+void FeatureIdTextureView::getFeatureIDs(
+    const gsl::span<const glm::dvec2>& uvs,
+    const gsl::span<int64_t>& featureIDs) const noexcept {
+  assert(featureIDs.size() >= uvs.size());
+  if (this->_status != FeatureIdTextureViewStatus::Valid) {
+    std::fill_n(featureIDs.data(), uvs.size(), -1);
+    return;
+  }
+
+  const double width = static_cast<double>(this->_pImage->width);
+  const double height = static_cast<double>(this->_pImage->height);
+  const int64_t maxX = static_cast<int64_t>(this->_pImage->width) - 1;
+  const int64_t maxY = static_cast<int64_t>(this->_pImage->height) - 1;
+  const int64_t pixelSize =
+      this->_pImage->bytesPerChannel * this->_pImage->channels;
+  const uint8_t* pPixels =
+      reinterpret_cast<const uint8_t*>(this->_pImage->getPixelData().data());
+
+  // Sample in blocks so that the pixel offsets of a block can be computed in
+  // one loop and each channel gathered in another, both without branches.
+  constexpr size_t blockSize = 64;
+  std::array<int64_t, blockSize> pixelOffsets;
+
+  for (size_t blockStart = 0; blockStart < uvs.size();
+       blockStart += blockSize) {
+    const size_t count = std::min(blockSize, uvs.size() - blockStart);
+
+    for (size_t i = 0; i < count; ++i) {
+      const glm::dvec2& uv = uvs[blockStart + i];
+      // Use std::floor for the reason given in getFeatureID.
+      const int64_t x = glm::clamp(
+          static_cast<int64_t>(std::floor(uv.x * width)),
+          static_cast<int64_t>(0),
+          maxX);
+      const int64_t y = glm::clamp(
+          static_cast<int64_t>(std::floor(uv.y * height)),
+          static_cast<int64_t>(0),
+          maxY);
+      pixelOffsets[i] = pixelSize * (y * this->_pImage->width + x);
+    }
+
+    int64_t* pFeatureIDs = featureIDs.data() + blockStart;
+    std::fill_n(pFeatureIDs, count, 0);
+    int64_t bitOffset = 0;
+    for (size_t c = 0; c < this->_channels.size(); ++c) {
+      const uint8_t* pChannel = pPixels + this->_channels[c];
+      for (size_t i = 0; i < count; ++i) {
+        pFeatureIDs[i] |= static_cast<int64_t>(pChannel[pixelOffsets[i]])
+                          << bitOffset;
+      }
+      bitOffset += 8;
+    }
+  }
+}
 } // namespace CesiumGltf
@@ -0,0 +1,21 @@
+#include "CesiumGltf/ImageCesium.h"
+
+namespace CesiumGltf {
+
+gsl::span<const std::byte> ImageCesium::getPixelData() const noexcept {
+  if (!this->sharedPixelData.getBytes().empty()) {
+    return this->sharedPixelData.getBytes();
+  }
+  return this->pixelData;
+}
+
+std::vector<std::byte>& ImageCesium::getMutablePixelData() {
+  const gsl::span<const std::byte> shared = this->sharedPixelData.getBytes();
+  if (!shared.empty()) {
+    this->pixelData.assign(shared.begin(), shared.end());
+    this->sharedPixelData = CesiumUtility::SharedBytes();
+  }
+  return this->pixelData;
+}
+
+} // namespace CesiumGltf
@@ -1,6 +1,7 @@
 #include "CesiumGltf/Model.h"
 
 #include "CesiumGltf/AccessorView.h"
+#include "CesiumGltf/ExtensionExtMeshGpuInstancing.h"
 #include "CesiumGltf/ExtensionKhrDracoMeshCompression.h"
 
 #include <glm/gtc/quaternion.hpp>
@@ -9,6 +10,8 @@
 #include <gsl/span>
 
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 namespace CesiumGltf {
 namespace {
@@ -135,6 +138,14 @@ void Model::merge(Model&& rhs) {
     for (auto& nodeIndex : node.children) {
       updateIndex(nodeIndex, firstNode);
     }
+
+    ExtensionExtMeshGpuInstancing* pInstancing =
+        node.getExtension<ExtensionExtMeshGpuInstancing>();
+    if (pInstancing) {
+      for (auto& attribute : pInstancing->attributes) {
+        updateIndex(attribute.second, firstAccessor);
+      }
+    }
   }
 
   for (size_t i = firstScene; i < this->scenes.size(); ++i) {
@@ -400,80 +411,43 @@ void Model::forEachPrimitiveInScene(
 }
 
 namespace {
-template <typename TIndex>
-void addTriangleNormalToVertexNormals(
-    const gsl::span<glm::vec3>& normals,
-    const AccessorView<glm::vec3>& positionView,
-    TIndex tIndex0,
-    TIndex tIndex1,
-    TIndex tIndex2) {
-
-  // Add the triangle's normal to each vertex's accumulated normal.
-
-  const uint32_t index0 = static_cast<uint32_t>(tIndex0);
-  const uint32_t index1 = static_cast<uint32_t>(tIndex1);
-  const uint32_t index2 = static_cast<uint32_t>(tIndex2);
-
-  const glm::vec3& vertex0 = positionView[index0];
-  const glm::vec3& vertex1 = positionView[index1];
-  const glm::vec3& vertex2 = positionView[index2];
-
-  const glm::vec3 triangleNormal =
-      glm::cross(vertex1 - vertex0, vertex2 - vertex0);
-
-  // Add the triangle normal to each vertex's accumulated normal. At the end
-  // we will normalize the accumulated vertex normals to average.
-  normals[index0] += triangleNormal;
-  normals[index1] += triangleNormal;
-  normals[index2] += triangleNormal;
-}
-
-template <typename TIndex, typename GetIndex>
-bool accumulateNormals(
+// Appends the vertex indices of each triangle to a flat list, whatever the
+// primitive's mode and index type, so that the normals can then be computed
+// in simple loops over contiguous arrays. Triangles that refer to vertices
+// that don't exist are skipped.
+template <typename GetIndex>
+bool collectTriangles(
     int32_t meshPrimitiveMode,
-    const gsl::span<glm::vec3>& normals,
-    const AccessorView<glm::vec3>& positionView,
     int64_t numIndices,
-    GetIndex getIndex) {
+    uint32_t vertexCount,
+    GetIndex getIndex,
+    std::vector<uint32_t>& triangles) {
+  auto addTriangle = [vertexCount, &triangles](
+                         uint32_t index0,
+                         uint32_t index1,
+                         uint32_t index2) {
+    if (index0 < vertexCount && index1 < vertexCount &&
+        index2 < vertexCount) {
+      triangles.insert(triangles.end(), {index0, index1, index2});
+    }
+  };
 
   switch (meshPrimitiveMode) {
   case MeshPrimitive::Mode::TRIANGLES:
+    triangles.reserve(size_t(std::max(numIndices, int64_t(0))));
     for (int64_t i = 2; i < numIndices; i += 3) {
-      TIndex index0 = getIndex(i - 2);
-      TIndex index1 = getIndex(i - 1);
-      TIndex index2 = getIndex(i);
-
-      addTriangleNormalToVertexNormals<TIndex>(
-          normals,
-          positionView,
-          index0,
-          index1,
-          index2);
+      addTriangle(getIndex(i - 2), getIndex(i - 1), getIndex(i));
     }
     break;
 
   case MeshPrimitive::Mode::TRIANGLE_STRIP:
+    triangles.reserve(size_t(std::max(numIndices - 2, int64_t(0))) * 3);
     for (int64_t i = 0; i < numIndices - 2; ++i) {
-      TIndex index0;
-      TIndex index1;
-      TIndex index2;
-
       if (i % 2) {
-        index0 = getIndex(i);
-        index1 = getIndex(i + 2);
-        index2 = getIndex(i + 1);
+        addTriangle(getIndex(i), getIndex(i + 2), getIndex(i + 1));
       } else {
-        index0 = getIndex(i);
-        index1 = getIndex(i + 1);
-        index2 = getIndex(i + 2);
+        addTriangle(getIndex(i), getIndex(i + 1), getIndex(i + 2));
       }
-
-      addTriangleNormalToVertexNormals<TIndex>(
-          normals,
-          positionView,
-          index0,
-          index1,
-          index2);
     }
     break;
 
@@ -483,17 +457,10 @@ bool accumulateNormals(
     }
 
     {
-      TIndex index0 = getIndex(0);
+      triangles.reserve(size_t(numIndices - 2) * 3);
+      const uint32_t index0 = getIndex(0);
       for (int64_t i = 2; i < numIndices; ++i) {
-        TIndex index1 = getIndex(i - 1);
-        TIndex index2 = getIndex(i);
-
-        addTriangleNormalToVertexNormals<TIndex>(
-            normals,
-            positionView,
-            index0,
-            index1,
-            index2);
+        addTriangle(index0, getIndex(i - 1), getIndex(i));
       }
     }
     break;
@@ -506,59 +473,70 @@ bool accumulateNormals(
 }
 
 template <typename TIndex>
-void generateSmoothNormals(
+bool collectIndexedTriangles(
+    const Model& gltf,
+    const MeshPrimitive& primitive,
+    const Accessor& indexAccessor,
+    uint32_t vertexCount,
+    std::vector<uint32_t>& triangles) {
+  const AccessorView<TIndex> indexView(gltf, indexAccessor);
+  if (indexView.status() != AccessorViewStatus::Valid) {
+    return false;
+  }
+
+  return collectTriangles(
+      primitive.mode,
+      indexView.size(),
+      vertexCount,
+      [&indexView](int64_t index) {
+        return static_cast<uint32_t>(indexView.getUnchecked(index));
+      },
+      triangles);
+}
+
+void computeSmoothNormals(
     Model& gltf,
     MeshPrimitive& primitive,
     const AccessorView<glm::vec3>& positionView,
-    const std::optional<Accessor>& indexAccessor) {
-
+    const std::vector<uint32_t>& triangles) {
   const size_t count = static_cast<size_t>(positionView.size());
   const size_t normalBufferStride = sizeof(glm::vec3);
   const size_t normalBufferSize = count * normalBufferStride;
 
+  // Copy the positions once, rather than going through the accessor view,
+  // which applies the stride, three times per triangle.
+  std::vector<glm::vec3> positions(count);
+  positionView.copyTo(positions);
+
   std::vector<std::byte> normalByteBuffer(normalBufferSize);
   gsl::span<glm::vec3> normals(
       reinterpret_cast<glm::vec3*>(normalByteBuffer.data()),
       count);
 
-  // In the indexed case, the positions are accessed with the
-  // indices from the indexView. Otherwise, the elements are
-  // accessed directly.
-  bool accumulationResult = false;
-  if (indexAccessor) {
-    CesiumGltf::AccessorView<TIndex> indexView(gltf, *indexAccessor);
-    if (indexView.status() != AccessorViewStatus::Valid) {
-      return;
-    }
-
-    accumulationResult = accumulateNormals<TIndex>(
-        primitive.mode,
-        normals,
-        positionView,
-        indexView.size(),
-        [&indexView](int64_t index) { return indexView[index]; });
-
-  } else {
-    accumulationResult = accumulateNormals<TIndex>(
-        primitive.mode,
-        normals,
-        positionView,
-        int64_t(count),
-        [](int64_t index) { return static_cast<TIndex>(index); });
-  }
-
-  if (!accumulationResult) {
-    return;
+  // Add each triangle's normal to each of its vertices' accumulated normals.
+  // The normals are weighted by the triangle's area.
+  for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+    const uint32_t index0 = triangles[i];
+    const uint32_t index1 = triangles[i + 1];
+    const uint32_t index2 = triangles[i + 2];
+
+    const glm::vec3 vertex0 = positions[index0];
+    const glm::vec3 triangleNormal = glm::cross(
+        positions[index1] - vertex0,
+        positions[index2] - vertex0);
+
+    normals[index0] += triangleNormal;
+    normals[index1] += triangleNormal;
+    normals[index2] += triangleNormal;
   }
 
-  // normalizes the accumulated vertex normals
+  // Normalize the accumulated vertex normals, without branches so that the
+  // loop can be vectorized.
   for (size_t i = 0; i < count; ++i) {
     const float lengthSquared = glm::length2(normals[i]);
-    if (lengthSquared < 1e-8f) {
-      normals[i] = glm::vec3(0.0f);
-    } else {
-      normals[i] /= glm::sqrt(lengthSquared);
-    }
+    const float scale =
+        lengthSquared < 1e-8f ? 0.0f : 1.0f / glm::sqrt(lengthSquared);
+    normals[i] *= scale;
   }
 
   const size_t normalBufferId = gltf.buffers.size();
@@ -592,39 +570,55 @@ void generateSmoothNormals(
     MeshPrimitive& primitive,
     const AccessorView<glm::vec3>& positionView,
     const std::optional<Accessor>& indexAccessor) {
+  const uint32_t vertexCount = static_cast<uint32_t>(std::min(
+      positionView.size(),
+      int64_t(std::numeric_limits<uint32_t>::max())));
+
+  std::vector<uint32_t> triangles;
+  bool collected = false;
   if (indexAccessor) {
     switch (indexAccessor->componentType) {
     case Accessor::ComponentType::UNSIGNED_BYTE:
-      generateSmoothNormals<uint8_t>(
+      collected = collectIndexedTriangles<uint8_t>(
           gltf,
           primitive,
-          positionView,
-          indexAccessor);
+          *indexAccessor,
+          vertexCount,
+          triangles);
       break;
     case Accessor::ComponentType::UNSIGNED_SHORT:
-      generateSmoothNormals<uint16_t>(
+      collected = collectIndexedTriangles<uint16_t>(
           gltf,
           primitive,
-          positionView,
-          indexAccessor);
+          *indexAccessor,
+          vertexCount,
+          triangles);
       break;
     case Accessor::ComponentType::UNSIGNED_INT:
-      generateSmoothNormals<uint32_t>(
+      collected = collectIndexedTriangles<uint32_t>(
           gltf,
           primitive,
-          positionView,
-          indexAccessor);
+          *indexAccessor,
+          vertexCount,
+          triangles);
       break;
     default:
       return;
     };
   } else {
-    generateSmoothNormals<uint32_t>(
-        gltf,
-        primitive,
-        positionView,
-        std::nullopt);
+    collected = collectTriangles(
+        primitive.mode,
+        int64_t(vertexCount),
+        vertexCount,
+        [](int64_t index) { return static_cast<uint32_t>(index); },
+        triangles);
   }
+
+  if (!collected) {
+    return;
+  }
+
+  computeSmoothNormals(gltf, primitive, positionView, triangles);
 }
 } // namespace
 
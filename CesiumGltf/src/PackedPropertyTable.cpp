@@ -0,0 +1,149 @@
+#include "CesiumGltf/PackedPropertyTable.h"
+
+#include "CesiumGltf/PropertyTypeTraits.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <utility>
+
+namespace CesiumGltf {
+
+namespace {
+
+constexpr int64_t channelsPerTexel = 4;
+
+template <typename T> constexpr int64_t getPackedComponentCount() {
+  if constexpr (IsMetadataVecN<T>::value) {
+    return static_cast<int64_t>(T::length());
+  } else if constexpr (
+      IsMetadataScalar<T>::value || IsMetadataBoolean<T>::value) {
+    return 1;
+  } else {
+    return 0;
+  }
+}
+
+template <typename T> void packValue(const T& value, float* pChannels) {
+  if constexpr (IsMetadataVecN<T>::value) {
+    for (glm::length_t i = 0; i < T::length(); ++i) {
+      pChannels[i] = static_cast<float>(value[i]);
+    }
+  } else if constexpr (IsMetadataBoolean<T>::value) {
+    pChannels[0] = value ? 1.0f : 0.0f;
+  } else {
+    pChannels[0] = static_cast<float>(value);
+  }
+}
+
+/**
+ * @brief The values of a property of every feature, before they are packed.
+ */
+struct UnpackedProperty {
+  PackedProperty property;
+  std::vector<float> values;
+};
+
+} // namespace
+
+int64_t PackedPropertyTable::getSizeBytes() const noexcept {
+  return static_cast<int64_t>(this->values.capacity() * sizeof(float));
+}
+
+PackedPropertyTable packPropertyTable(
+    const PropertyTableView& propertyTable,
+    const std::vector<std::string>& propertyIds,
+    int64_t maximumWidth) {
+  PackedPropertyTable result;
+  const int64_t featureCount = propertyTable.size();
+  if (featureCount <= 0) {
+    return result;
+  }
+
+  std::vector<UnpackedProperty> unpacked;
+  int64_t channelCount = 0;
+  for (const std::string& propertyId : propertyIds) {
+    propertyTable.getPropertyView(
+        propertyId,
+        [featureCount, &unpacked, &channelCount](
+            const std::string& id,
+            const auto& propertyView) {
+          using ValueType = typename decltype(propertyView.get(0))::value_type;
+          constexpr int64_t componentCount =
+              getPackedComponentCount<ValueType>();
+
+          if constexpr (componentCount > 0) {
+            if (propertyView.status() !=
+                    PropertyTablePropertyViewStatus::Valid &&
+                propertyView.status() !=
+                    PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+              return;
+            }
+
+            // The values of a property are kept within one texel.
+            if (channelCount % channelsPerTexel + componentCount >
+                channelsPerTexel) {
+              channelCount = (channelCount / channelsPerTexel + 1) *
+                             channelsPerTexel;
+            }
+
+            UnpackedProperty& property = unpacked.emplace_back();
+            property.property.propertyId = id;
+            property.property.componentCount = componentCount;
+            property.property.firstChannel = channelCount;
+            property.values.resize(
+                static_cast<size_t>(featureCount * componentCount),
+                std::numeric_limits<float>::quiet_NaN());
+            channelCount += componentCount;
+
+            for (int64_t i = 0; i < featureCount; ++i) {
+              const std::optional<ValueType> maybeValue = propertyView.get(i);
+              if (maybeValue) {
+                packValue(
+                    *maybeValue,
+                    property.values.data() + i * componentCount);
+              }
+            }
+          }
+        });
+  }
+
+  if (unpacked.empty()) {
+    return result;
+  }
+
+  const int64_t texelsPerFeature =
+      (channelCount + channelsPerTexel - 1) / channelsPerTexel;
+  const int64_t featuresPerRow = std::clamp(
+      maximumWidth / texelsPerFeature,
+      int64_t(1),
+      featureCount);
+
+  result.featureCount = featureCount;
+  result.texelsPerFeature = texelsPerFeature;
+  result.width = featuresPerRow * texelsPerFeature;
+  result.height = (featureCount + featuresPerRow - 1) / featuresPerRow;
+  result.values.resize(
+      static_cast<size_t>(result.width * result.height * channelsPerTexel),
+      0.0f);
+
+  // Each feature's texels follow those of the previous feature, so a row
+  // holds whole features and the channels of feature `f` start at
+  // `f * texelsPerFeature * 4`.
+  const int64_t channelsPerFeature = texelsPerFeature * channelsPerTexel;
+  for (UnpackedProperty& property : unpacked) {
+    const int64_t componentCount = property.property.componentCount;
+    for (int64_t i = 0; i < featureCount; ++i) {
+      std::copy_n(
+          property.values.begin() + i * componentCount,
+          componentCount,
+          result.values.begin() + i * channelsPerFeature +
+              property.property.firstChannel);
+    }
+    result.properties.emplace_back(std::move(property.property));
+  }
+
+  return result;
+}
+
+} // namespace CesiumGltf
@@ -0,0 +1,304 @@
+#include "CesiumGltf/PropertyTableColumns.h"
+
+#include "CesiumGltf/PropertyTypeTraits.h"
+#include "CesiumGltf/getOffsetFromOffsetsBuffer.h"
+
+#include <CesiumUtility/SpanHelper.h>
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace CesiumGltf {
+
+namespace {
+
+template <typename T> constexpr int64_t getComponentCount() {
+  if constexpr (IsMetadataVecN<T>::value) {
+    return static_cast<int64_t>(T::length());
+  } else if constexpr (IsMetadataMatN<T>::value) {
+    return static_cast<int64_t>(T::length() * T::length());
+  } else {
+    return 1;
+  }
+}
+
+template <typename T> std::vector<std::byte> toBytes(const std::vector<T>& v) {
+  std::vector<std::byte> bytes(v.size() * sizeof(T));
+  if (!bytes.empty()) {
+    std::memcpy(bytes.data(), v.data(), bytes.size());
+  }
+  return bytes;
+}
+
+void setValidity(
+    PropertyTableColumn& column,
+    std::vector<std::byte>&& validity,
+    int64_t validCount) {
+  column.nullCount = column.length - validCount;
+  if (column.nullCount > 0) {
+    column.validity = PropertyTableColumnBuffer(std::move(validity));
+  }
+}
+
+void setValid(std::vector<std::byte>& validity, size_t index) {
+  validity[index / 8] |=
+      std::byte(static_cast<unsigned char>(1u << (index % 8)));
+}
+
+void setOwnedOffsets(
+    PropertyTableColumn& column,
+    const std::vector<uint64_t>& offsets) {
+  if (offsets.back() <=
+      static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+    std::vector<uint32_t> narrowOffsets(offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+      narrowOffsets[i] = static_cast<uint32_t>(offsets[i]);
+    }
+    column.offsetType = PropertyComponentType::Uint32;
+    column.offsets = PropertyTableColumnBuffer(toBytes(narrowOffsets));
+  } else {
+    column.offsetType = PropertyComponentType::Uint64;
+    column.offsets = PropertyTableColumnBuffer(toBytes(offsets));
+  }
+}
+
+/**
+ * @brief Exports offsets into the values of a property, which count the
+ * values in units of `unitSize` bytes. The offsets are viewed in place if they
+ * count bytes already and are 32-bit or 64-bit.
+ */
+void exportOffsets(
+    PropertyTableColumn& column,
+    const gsl::span<const std::byte>& buffer,
+    PropertyComponentType offsetType,
+    size_t unitSize) {
+  const size_t count = static_cast<size_t>(column.length) + 1;
+  const uint64_t last = static_cast<uint64_t>(
+      getOffsetFromOffsetsBuffer(count - 1, buffer, offsetType));
+
+  if (unitSize == 1 && offsetType == PropertyComponentType::Uint32 &&
+      last <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+    column.offsetType = offsetType;
+    column.offsets =
+        PropertyTableColumnBuffer(buffer.first(count * sizeof(uint32_t)));
+    return;
+  }
+
+  if (unitSize == 1 && offsetType == PropertyComponentType::Uint64 &&
+      last <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+    column.offsetType = offsetType;
+    column.offsets =
+        PropertyTableColumnBuffer(buffer.first(count * sizeof(uint64_t)));
+    return;
+  }
+
+  std::vector<uint64_t> offsets(count);
+  for (size_t i = 0; i < count; ++i) {
+    offsets[i] = static_cast<uint64_t>(
+                     getOffsetFromOffsetsBuffer(i, buffer, offsetType)) /
+                 unitSize;
+  }
+  setOwnedOffsets(column, offsets);
+}
+
+template <typename T, bool Normalized>
+void exportFixedWidth(
+    PropertyTableColumn& column,
+    const PropertyTablePropertyView<T, Normalized>& view) {
+  using RangeValueType =
+      typename PropertyTablePropertyView<T, Normalized>::RangeValueType;
+
+  size_t valuesPerElement = 1;
+  if constexpr (IsMetadataArray<T>::value) {
+    valuesPerElement = static_cast<size_t>(view.arrayCount());
+  }
+
+  column.layout = PropertyTableColumnLayout::FixedWidth;
+  column.componentType = TypeToPropertyType<RangeValueType>::component;
+  column.componentCount = getComponentCount<RangeValueType>() *
+                          static_cast<int64_t>(valuesPerElement);
+
+  const size_t valueCount = static_cast<size_t>(column.length) *
+                            valuesPerElement;
+  const bool isConverted =
+      Normalized || view.offset() || view.scale() || view.noData() ||
+      column.status ==
+          PropertyTablePropertyViewStatus::EmptyPropertyWithDefault;
+  if (!isConverted) {
+    column.values = PropertyTableColumnBuffer(
+        view.valuesBuffer().first(valueCount * sizeof(RangeValueType)));
+    return;
+  }
+
+  std::vector<std::byte> values(valueCount * sizeof(RangeValueType));
+  std::vector<std::byte> validity(static_cast<size_t>(column.length + 7) / 8);
+  const int64_t validCount = view.getRange(
+      0,
+      column.length,
+      CesiumUtility::reintepretCastSpan<RangeValueType>(
+          gsl::span<std::byte>(values)),
+      validity);
+  column.values = PropertyTableColumnBuffer(std::move(values));
+  setValidity(column, std::move(validity), validCount);
+}
+
+void exportBoolean(
+    PropertyTableColumn& column,
+    const PropertyTablePropertyView<bool>& view) {
+  column.layout = PropertyTableColumnLayout::Boolean;
+  column.componentCount = 1;
+
+  const size_t byteCount = static_cast<size_t>(column.length + 7) / 8;
+  if (column.status == PropertyTablePropertyViewStatus::Valid) {
+    column.values =
+        PropertyTableColumnBuffer(view.valuesBuffer().first(byteCount));
+    return;
+  }
+
+  std::vector<std::byte> values(byteCount);
+  for (int64_t i = 0; i < column.length; ++i) {
+    if (view.get(i).value_or(false)) {
+      setValid(values, static_cast<size_t>(i));
+    }
+  }
+  column.values = PropertyTableColumnBuffer(std::move(values));
+}
+
+void exportString(
+    PropertyTableColumn& column,
+    const PropertyTablePropertyView<std::string_view>& view) {
+  column.layout = PropertyTableColumnLayout::String;
+  column.componentType = PropertyComponentType::Uint8;
+  column.componentCount = 1;
+
+  if (column.status == PropertyTablePropertyViewStatus::Valid &&
+      !view.noData()) {
+    column.values = PropertyTableColumnBuffer(view.valuesBuffer());
+    exportOffsets(
+        column,
+        view.stringOffsetsBuffer(),
+        view.stringOffsetType(),
+        1);
+    return;
+  }
+
+  std::vector<std::byte> values;
+  std::vector<uint64_t> offsets{0};
+  std::vector<std::byte> validity(static_cast<size_t>(column.length + 7) / 8);
+  int64_t validCount = 0;
+  for (int64_t i = 0; i < column.length; ++i) {
+    const std::optional<std::string_view> maybeValue = view.get(i);
+    if (maybeValue) {
+      const std::byte* pBegin =
+          reinterpret_cast<const std::byte*>(maybeValue->data());
+      values.insert(values.end(), pBegin, pBegin + maybeValue->size());
+      setValid(validity, static_cast<size_t>(i));
+      ++validCount;
+    }
+    offsets.push_back(static_cast<uint64_t>(values.size()));
+  }
+
+  column.values = PropertyTableColumnBuffer(std::move(values));
+  setOwnedOffsets(column, offsets);
+  setValidity(column, std::move(validity), validCount);
+}
+
+template <typename T, bool Normalized>
+void exportList(
+    PropertyTableColumn& column,
+    const PropertyTablePropertyView<T, Normalized>& view) {
+  using RawType = typename MetadataArrayType<T>::type;
+  using ValueType = typename MetadataArrayType<
+      typename decltype(view.get(0))::value_type>::type;
+
+  column.layout = PropertyTableColumnLayout::List;
+  column.componentType = TypeToPropertyType<ValueType>::component;
+  column.componentCount = getComponentCount<ValueType>();
+
+  const bool isConverted =
+      Normalized || view.offset() || view.scale() || view.noData() ||
+      column.status ==
+          PropertyTablePropertyViewStatus::EmptyPropertyWithDefault;
+  if (!isConverted) {
+    column.values = PropertyTableColumnBuffer(view.valuesBuffer());
+    exportOffsets(
+        column,
+        view.arrayOffsetsBuffer(),
+        view.arrayOffsetType(),
+        sizeof(RawType));
+    return;
+  }
+
+  std::vector<ValueType> values;
+  std::vector<uint64_t> offsets{0};
+  std::vector<std::byte> validity(static_cast<size_t>(column.length + 7) / 8);
+  int64_t validCount = 0;
+  for (int64_t i = 0; i < column.length; ++i) {
+    const auto maybeValue = view.get(i);
+    if (maybeValue) {
+      for (int64_t j = 0; j < maybeValue->size(); ++j) {
+        values.push_back((*maybeValue)[j]);
+      }
+      setValid(validity, static_cast<size_t>(i));
+      ++validCount;
+    }
+    offsets.push_back(static_cast<uint64_t>(values.size()));
+  }
+
+  column.values = PropertyTableColumnBuffer(toBytes(values));
+  setOwnedOffsets(column, offsets);
+  setValidity(column, std::move(validity), validCount);
+}
+
+template <typename T, bool Normalized>
+PropertyTableColumn exportColumn(
+    const std::string& propertyId,
+    const PropertyTablePropertyView<T, Normalized>& view,
+    int64_t length) {
+  PropertyTableColumn column;
+  column.propertyId = propertyId;
+  column.status = view.status();
+  column.length = length;
+
+  if (column.status != PropertyTablePropertyViewStatus::Valid &&
+      column.status !=
+          PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+    return column;
+  }
+
+  if constexpr (IsMetadataNumeric<T>::value) {
+    exportFixedWidth(column, view);
+  } else if constexpr (IsMetadataBoolean<T>::value) {
+    exportBoolean(column, view);
+  } else if constexpr (IsMetadataString<T>::value) {
+    exportString(column, view);
+  } else if constexpr (IsMetadataNumericArray<T>::value) {
+    if (view.arrayCount() > 0) {
+      exportFixedWidth(column, view);
+    } else {
+      exportList(column, view);
+    }
+  }
+
+  return column;
+}
+
+} // namespace
+
+std::vector<PropertyTableColumn>
+exportPropertyTableColumns(const PropertyTableView& propertyTable) {
+  std::vector<PropertyTableColumn> columns;
+  if (propertyTable.status() != PropertyTableViewStatus::Valid) {
+    return columns;
+  }
+
+  const int64_t length = propertyTable.size();
+  propertyTable.forEachProperty(
+      [&columns, length](const std::string& propertyId, auto propertyView) {
+        columns.emplace_back(exportColumn(propertyId, propertyView, length));
+      });
+  return columns;
+}
+
+} // namespace CesiumGltf
@@ -164,13 +164,14 @@ PropertyViewStatusType PropertyTableView::getBufferSafe(
     return PropertyTablePropertyViewStatus::ErrorInvalidValueBuffer;
   }
 
+  const gsl::span<const std::byte> data = pBuffer->cesium.getData();
   if (pBufferView->byteOffset + pBufferView->byteLength >
-      static_cast<int64_t>(pBuffer->cesium.data.size())) {
+      static_cast<int64_t>(data.size())) {
     return PropertyTablePropertyViewStatus::ErrorBufferViewOutOfBounds;
   }
 
   buffer = gsl::span<const std::byte>(
-      pBuffer->cesium.data.data() + pBufferView->byteOffset,
+      data.data() + pBufferView->byteOffset,
       static_cast<size_t>(pBufferView->byteLength));
   return PropertyTablePropertyViewStatus::Valid;
 }
@@ -88,8 +88,8 @@ std::array<uint8_t, 4> sampleNearestPixel(
 
   // TODO: Currently stb only outputs uint8 pixel types. If that
   // changes this should account for additional pixel byte sizes.
-  const uint8_t* pValue =
-      reinterpret_cast<const uint8_t*>(image.pixelData.data() + pixelIndex);
+  const uint8_t* pValue = reinterpret_cast<const uint8_t*>(
+      image.getPixelData().data() + pixelIndex);
 
   std::array<uint8_t, 4> channelValues{0, 0, 0, 0};
   size_t len = glm::min(channels.size(), channelValues.size());
@@ -100,4 +100,57 @@ std::array<uint8_t, 4> sampleNearestPixel(
   return channelValues;
 }
 
+void sampleNearestPixels(
+    const ImageCesium& image,
+    const std::vector<int64_t>& channels,
+    const int32_t wrapS,
+    const int32_t wrapT,
+    const gsl::span<const glm::dvec2>& uvs,
+    const gsl::span<uint8_t>& channelValues) {
+  const size_t channelCount = glm::min(channels.size(), size_t(4));
+  assert(channelValues.size() >= uvs.size() * channelCount);
+
+  const double width = static_cast<double>(image.width);
+  const double height = static_cast<double>(image.height);
+  const int64_t maxX = static_cast<int64_t>(image.width) - 1;
+  const int64_t maxY = static_cast<int64_t>(image.height) - 1;
+  const int64_t pixelSize = image.bytesPerChannel * image.channels;
+  const uint8_t* pPixels =
+      reinterpret_cast<const uint8_t*>(image.getPixelData().data());
+
+  // Sample in blocks so that the pixel indices of a block can be computed in
+  // one loop and the channels gathered in another, both without branches.
+  constexpr size_t blockSize = 64;
+  std::array<int64_t, blockSize> pixelIndices;
+
+  for (size_t blockStart = 0; blockStart < uvs.size();
+       blockStart += blockSize) {
+    const size_t count = glm::min(blockSize, uvs.size() - blockStart);
+
+    for (size_t i = 0; i < count; ++i) {
+      const glm::dvec2& uv = uvs[blockStart + i];
+      // Use std::floor for the reason given in sampleNearestPixel.
+      const int64_t x = glm::clamp(
+          static_cast<int64_t>(
+              std::floor(applySamplerWrapS(uv.x, wrapS) * width)),
+          static_cast<int64_t>(0),
+          maxX);
+      const int64_t y = glm::clamp(
+          static_cast<int64_t>(
+              std::floor(applySamplerWrapT(uv.y, wrapT) * height)),
+          static_cast<int64_t>(0),
+          maxY);
+      pixelIndices[i] = pixelSize * (y * image.width + x);
+    }
+
+    uint8_t* pOutput = channelValues.data() + blockStart * channelCount;
+    for (size_t c = 0; c < channelCount; ++c) {
+      const uint8_t* pChannel = pPixels + channels[c];
+      for (size_t i = 0; i < count; ++i) {
+        pOutput[i * channelCount + c] = pChannel[pixelIndices[i]];
+      }
+    }
+  }
+}
+
 } // namespace CesiumGltf
@@ -4,6 +4,8 @@
 #include <catch2/catch.hpp>
 #include <glm/vec3.hpp>
 
+#include <vector>
+
 TEST_CASE("AccessorView construct and read example") {
   auto anyOldFunctionToGetAModel = []() {
     CesiumGltf::Model model;
@@ -90,3 +92,93 @@ TEST_CASE("Create AccessorView of unknown type with lambda") {
     CHECK(int64_t(accessorView[0].value[0]) == int64_t(0x0201));
   });
 }
+
+TEST_CASE("Iterate and copy AccessorView elements") {
+  using namespace CesiumGltf;
+
+  // Four vec3s interleaved with a float, for a stride of 16 bytes.
+  std::vector<float> interleaved;
+  for (int i = 0; i < 4; ++i) {
+    const float value = float(i);
+    interleaved.insert(interleaved.end(), {value, value, value, -1.0f});
+  }
+  const std::byte* pInterleaved =
+      reinterpret_cast<const std::byte*>(interleaved.data());
+
+  std::vector<glm::vec3> packed{{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}};
+  const std::byte* pPacked = reinterpret_cast<const std::byte*>(packed.data());
+
+  SECTION("iterates over interleaved elements") {
+    const AccessorView<glm::vec3> view(pInterleaved, 16, 0, 4);
+    REQUIRE(view.end() - view.begin() == 4);
+
+    float expected = 0.0f;
+    for (const glm::vec3& value : view) {
+      CHECK(value == glm::vec3(expected));
+      expected += 1.0f;
+    }
+    CHECK(view.begin()[2] == view.getUnchecked(2));
+    CHECK(*(view.end() - 1) == glm::vec3(3.0f));
+  }
+
+  SECTION("copies interleaved elements") {
+    const AccessorView<glm::vec3> view(pInterleaved, 16, 0, 4);
+    std::vector<glm::vec3> copied(3);
+    CHECK(view.copyTo(copied, 1) == 3);
+    CHECK(copied[0] == glm::vec3(1.0f));
+    CHECK(copied[1] == glm::vec3(2.0f));
+    CHECK(copied[2] == glm::vec3(3.0f));
+  }
+
+  SECTION("copies packed elements") {
+    const AccessorView<glm::vec3> view(pPacked, 12, 0, 2);
+    std::vector<glm::vec3> copied(4, glm::vec3(-1.0f));
+    CHECK(view.copyTo(copied) == 2);
+    CHECK(copied[0] == packed[0]);
+    CHECK(copied[1] == packed[1]);
+    CHECK(copied[2] == glm::vec3(-1.0f));
+  }
+
+  SECTION("copies nothing out of range") {
+    const AccessorView<glm::vec3> view(pPacked, 12, 0, 2);
+    std::vector<glm::vec3> copied(1);
+    CHECK(view.copyTo(copied, 2) == 0);
+    CHECK(view.copyTo(copied, -1) == 0);
+    CHECK(AccessorView<glm::vec3>().copyTo(copied) == 0);
+    CHECK(AccessorView<glm::vec3>().begin() == AccessorView<glm::vec3>().end());
+  }
+}
+
+TEST_CASE("AccessorView reads buffers stored elsewhere") {
+  using namespace CesiumGltf;
+
+  const std::vector<float> values{1.0f, 2.0f, 3.0f};
+  const gsl::span<const std::byte> bytes(
+      reinterpret_cast<const std::byte*>(values.data()),
+      values.size() * sizeof(float));
+
+  Model model;
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.byteLength = int64_t(bytes.size());
+  buffer.cesium.sharedData = CesiumUtility::SharedBytes(nullptr, bytes);
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteLength = buffer.byteLength;
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = 0;
+  accessor.componentType = Accessor::ComponentType::FLOAT;
+  accessor.type = Accessor::Type::VEC3;
+  accessor.count = 1;
+
+  const AccessorView<glm::vec3> view(model, 0);
+  REQUIRE(view.status() == AccessorViewStatus::Valid);
+  CHECK(view[0] == glm::vec3(1.0f, 2.0f, 3.0f));
+
+  // Modifying the buffer copies its data.
+  std::vector<std::byte>& data = buffer.cesium.getMutableData();
+  CHECK(data.size() == bytes.size());
+  CHECK(buffer.cesium.sharedData.getBytes().empty());
+  CHECK(buffer.cesium.getData().data() == data.data());
+}
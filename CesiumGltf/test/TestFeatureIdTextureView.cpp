@@ -422,4 +422,66 @@ TEST_CASE("Test getFeatureID handles multiple channels") {
   REQUIRE(view.getFeatureID(1, 0) == 512);
   REQUIRE(view.getFeatureID(0, 1) == 8);
   REQUIRE(view.getFeatureID(1, 1) == 17);
+
+  std::vector<glm::dvec2> texCoords{
+      glm::dvec2(0, 0),
+      glm::dvec2(1, 0),
+      glm::dvec2(0, 1),
+      glm::dvec2(1, 1),
+      glm::dvec2(0.25, 0.75)};
+  std::vector<int64_t> batch(texCoords.size());
+  view.getFeatureIDs(texCoords, batch);
+  REQUIRE(batch == std::vector<int64_t>{260, 512, 8, 17, 8});
+}
+
+TEST_CASE("Test getFeatureIDs samples many texture coordinates") {
+  Model model;
+
+  // Use enough texture coordinates to span more than one block of samples.
+  const size_t width = 100;
+  std::vector<uint8_t> featureIDs(width);
+  for (size_t i = 0; i < width; ++i) {
+    featureIDs[i] = static_cast<uint8_t>(i);
+  }
+
+  Image& image = model.images.emplace_back();
+  image.cesium.width = static_cast<int32_t>(width);
+  image.cesium.height = 1;
+  image.cesium.channels = 1;
+  image.cesium.bytesPerChannel = 1;
+
+  auto& data = image.cesium.pixelData;
+  data.resize(featureIDs.size());
+  std::memcpy(data.data(), featureIDs.data(), data.size());
+
+  Texture& texture = model.textures.emplace_back();
+  texture.sampler = 0;
+  texture.source = 0;
+
+  FeatureIdTexture featureIdTexture;
+  featureIdTexture.index = 0;
+  featureIdTexture.texCoord = 0;
+  featureIdTexture.channels = {0};
+
+  FeatureIdTextureView view(model, featureIdTexture);
+  REQUIRE(view.status() == FeatureIdTextureViewStatus::Valid);
+
+  std::vector<glm::dvec2> texCoords;
+  for (size_t i = 0; i < width; ++i) {
+    texCoords.emplace_back(
+        (static_cast<double>(i) + 0.5) / static_cast<double>(width),
+        0.5);
+  }
+
+  std::vector<int64_t> batch(texCoords.size());
+  view.getFeatureIDs(texCoords, batch);
+  for (size_t i = 0; i < texCoords.size(); ++i) {
+    REQUIRE(batch[i] == view.getFeatureID(texCoords[i].x, texCoords[i].y));
+  }
+
+  SECTION("Returns -1 for an invalid view") {
+    FeatureIdTextureView invalidView;
+    invalidView.getFeatureIDs(texCoords, batch);
+    REQUIRE(batch == std::vector<int64_t>(texCoords.size(), -1));
+  }
 }
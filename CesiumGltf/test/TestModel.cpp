@@ -416,6 +416,31 @@ TEST_CASE("Test smooth normal generation") {
         glm::epsilonEqual(vertex6Normal, expectedNormal, DEFAULT_EPSILON)));
   }
 
+  SECTION("Test normal generation skips triangles with invalid indices") {
+    Model model = createCubeGltf();
+
+    // The last triangle, which doesn't use vertex 0, refers to a vertex that
+    // doesn't exist.
+    model.buffers[1].cesium.data[35] = std::byte(200);
+
+    model.generateMissingNormalsSmooth();
+
+    MeshPrimitive& primitive = model.meshes[0].primitives[0];
+    auto normalIt = primitive.attributes.find("NORMAL");
+    REQUIRE(normalIt != primitive.attributes.end());
+
+    AccessorView<glm::vec3> normalView(model, normalIt->second);
+    REQUIRE(normalView.status() == AccessorViewStatus::Valid);
+    REQUIRE(normalView.size() == 8);
+
+    const glm::vec3& vertex0Normal = normalView[0];
+    glm::vec3 expectedNormal(-1.0f, -1.0f, -1.0f);
+    expectedNormal = glm::normalize(expectedNormal);
+
+    REQUIRE(glm::all(
+        glm::epsilonEqual(vertex0Normal, expectedNormal, DEFAULT_EPSILON)));
+  }
+
   SECTION("Test normal generation for TRIANGLE_STRIP") {
     Model model = createTriangleStrip();
 
@@ -0,0 +1,158 @@
+#include "CesiumGltf/PackedPropertyTable.h"
+#include "CesiumGltf/PropertyTableView.h"
+
+#include <catch2/catch.hpp>
+#include <glm/vec3.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+
+template <typename T>
+int32_t addBufferToModel(Model& model, const std::vector<T>& values) {
+  Buffer& valueBuffer = model.buffers.emplace_back();
+  valueBuffer.cesium.data.resize(values.size() * sizeof(T));
+  valueBuffer.byteLength = static_cast<int64_t>(valueBuffer.cesium.data.size());
+  std::memcpy(
+      valueBuffer.cesium.data.data(),
+      values.data(),
+      valueBuffer.cesium.data.size());
+
+  BufferView& valueBufferView = model.bufferViews.emplace_back();
+  valueBufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  valueBufferView.byteOffset = 0;
+  valueBufferView.byteLength = valueBuffer.byteLength;
+  return static_cast<int32_t>(model.bufferViews.size() - 1);
+}
+
+} // namespace
+
+TEST_CASE("Test packing property tables") {
+  Model model;
+  ExtensionModelExtStructuralMetadata& metadata =
+      model.addExtension<ExtensionModelExtStructuralMetadata>();
+  Schema& schema = metadata.schema.emplace();
+  Class& testClass = schema.classes["TestClass"];
+
+  PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+  propertyTable.classProperty = "TestClass";
+  propertyTable.count = 3;
+
+  {
+    ClassProperty& classProperty = testClass.properties["scaled"];
+    classProperty.type = ClassProperty::Type::SCALAR;
+    classProperty.componentType = ClassProperty::ComponentType::FLOAT32;
+    classProperty.scale = 2.0;
+    classProperty.offset = 1.0;
+    propertyTable.properties["scaled"].values =
+        addBufferToModel(model, std::vector<float>{1.0f, 2.0f, 3.0f});
+  }
+
+  {
+    ClassProperty& classProperty = testClass.properties["withNoData"];
+    classProperty.type = ClassProperty::Type::SCALAR;
+    classProperty.componentType = ClassProperty::ComponentType::INT32;
+    classProperty.noData = -1;
+    propertyTable.properties["withNoData"].values =
+        addBufferToModel(model, std::vector<int32_t>{5, -1, 7});
+  }
+
+  {
+    ClassProperty& classProperty = testClass.properties["positions"];
+    classProperty.type = ClassProperty::Type::VEC3;
+    classProperty.componentType = ClassProperty::ComponentType::FLOAT32;
+    propertyTable.properties["positions"].values = addBufferToModel(
+        model,
+        std::vector<glm::vec3>{
+            glm::vec3(1.0f, 2.0f, 3.0f),
+            glm::vec3(4.0f, 5.0f, 6.0f),
+            glm::vec3(7.0f, 8.0f, 9.0f)});
+  }
+
+  {
+    ClassProperty& classProperty = testClass.properties["flags"];
+    classProperty.type = ClassProperty::Type::BOOLEAN;
+    propertyTable.properties["flags"].values =
+        addBufferToModel(model, std::vector<uint8_t>{0b010});
+  }
+
+  {
+    ClassProperty& classProperty = testClass.properties["name"];
+    classProperty.type = ClassProperty::Type::STRING;
+  }
+
+  const PropertyTableView view(model, propertyTable);
+  REQUIRE(view.status() == PropertyTableViewStatus::Valid);
+
+  SECTION("Packs the properties into whole texels of each feature") {
+    const PackedPropertyTable packed = packPropertyTable(
+        view,
+        {"scaled", "withNoData", "positions", "flags", "name", "missing"});
+
+    REQUIRE(packed.properties.size() == 4);
+    CHECK(packed.properties[0].propertyId == "scaled");
+    CHECK(packed.properties[0].firstChannel == 0);
+    CHECK(packed.properties[1].propertyId == "withNoData");
+    CHECK(packed.properties[1].firstChannel == 1);
+    // The vector doesn't fit in the rest of the first texel.
+    CHECK(packed.properties[2].propertyId == "positions");
+    CHECK(packed.properties[2].componentCount == 3);
+    CHECK(packed.properties[2].firstChannel == 4);
+    CHECK(packed.properties[3].propertyId == "flags");
+    CHECK(packed.properties[3].firstChannel == 7);
+
+    CHECK(packed.featureCount == 3);
+    CHECK(packed.texelsPerFeature == 2);
+    CHECK(packed.width == 6);
+    CHECK(packed.height == 1);
+    REQUIRE(packed.values.size() == 24);
+
+    const std::vector<float>& values = packed.values;
+    CHECK(values[0] == 3.0f);
+    CHECK(values[1] == 5.0f);
+    CHECK(values[4] == 1.0f);
+    CHECK(values[5] == 2.0f);
+    CHECK(values[6] == 3.0f);
+    CHECK(values[7] == 0.0f);
+
+    CHECK(values[8] == 5.0f);
+    CHECK(std::isnan(values[9]));
+    CHECK(values[12] == 4.0f);
+    CHECK(values[15] == 1.0f);
+
+    CHECK(values[16] == 7.0f);
+    CHECK(values[17] == 7.0f);
+    CHECK(values[22] == 9.0f);
+    CHECK(values[23] == 0.0f);
+
+    CHECK(packed.getSizeBytes() >= int64_t(24 * sizeof(float)));
+  }
+
+  SECTION("Wraps features onto rows no wider than the maximum") {
+    const PackedPropertyTable packed =
+        packPropertyTable(view, {"scaled", "withNoData"}, 2);
+
+    CHECK(packed.texelsPerFeature == 1);
+    CHECK(packed.width == 2);
+    CHECK(packed.height == 2);
+    REQUIRE(packed.values.size() == 16);
+    CHECK(packed.values[8] == 7.0f);
+    CHECK(packed.values[9] == 7.0f);
+    CHECK(packed.values[12] == 0.0f);
+  }
+
+  SECTION("Packs nothing if no property can be packed") {
+    const PackedPropertyTable packed =
+        packPropertyTable(view, {"name", "missing"});
+
+    CHECK(packed.properties.empty());
+    CHECK(packed.values.empty());
+    CHECK(packed.width == 0);
+    CHECK(packed.height == 0);
+  }
+}
@@ -0,0 +1,232 @@
+#include "CesiumGltf/PropertyTableColumns.h"
+#include "CesiumGltf/PropertyTableView.h"
+
+#include <catch2/catch.hpp>
+#include <gsl/span>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+
+template <typename T>
+int32_t addBufferToModel(Model& model, const std::vector<T>& values) {
+  Buffer& valueBuffer = model.buffers.emplace_back();
+  valueBuffer.cesium.data.resize(values.size() * sizeof(T));
+  valueBuffer.byteLength = static_cast<int64_t>(valueBuffer.cesium.data.size());
+  std::memcpy(
+      valueBuffer.cesium.data.data(),
+      values.data(),
+      valueBuffer.cesium.data.size());
+
+  BufferView& valueBufferView = model.bufferViews.emplace_back();
+  valueBufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  valueBufferView.byteOffset = 0;
+  valueBufferView.byteLength = valueBuffer.byteLength;
+  return static_cast<int32_t>(model.bufferViews.size() - 1);
+}
+
+template <typename T>
+std::vector<T> getValues(const PropertyTableColumnBuffer& buffer) {
+  const gsl::span<const std::byte> data = buffer.data();
+  std::vector<T> result(data.size() / sizeof(T));
+  std::memcpy(result.data(), data.data(), result.size() * sizeof(T));
+  return result;
+}
+
+const PropertyTableColumn& findColumn(
+    const std::vector<PropertyTableColumn>& columns,
+    const std::string& propertyId) {
+  auto it = std::find_if(
+      columns.begin(),
+      columns.end(),
+      [&propertyId](const PropertyTableColumn& column) {
+        return column.propertyId == propertyId;
+      });
+  REQUIRE(it != columns.end());
+  return *it;
+}
+
+} // namespace
+
+TEST_CASE("Test exporting property table columns") {
+  Model model;
+  ExtensionModelExtStructuralMetadata& metadata =
+      model.addExtension<ExtensionModelExtStructuralMetadata>();
+  Schema& schema = metadata.schema.emplace();
+  Class& testClass = schema.classes["TestClass"];
+
+  PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+  propertyTable.classProperty = "TestClass";
+  propertyTable.count = 4;
+
+  const std::vector<uint32_t> integers{12, 34, 56, 78};
+  {
+    ClassProperty& classProperty = testClass.properties["integers"];
+    classProperty.type = ClassProperty::Type::SCALAR;
+    classProperty.componentType = ClassProperty::ComponentType::UINT32;
+    propertyTable.properties["integers"].values =
+        addBufferToModel(model, integers);
+  }
+
+  {
+    ClassProperty& classProperty = testClass.properties["scaled"];
+    classProperty.type = ClassProperty::Type::SCALAR;
+    classProperty.componentType = ClassProperty::ComponentType::FLOAT32;
+    classProperty.scale = 2.0;
+    classProperty.offset = 1.0;
+    propertyTable.properties["scaled"].values =
+        addBufferToModel(model, std::vector<float>{1.0f, 2.0f, 3.0f, 4.0f});
+  }
+
+  {
+    ClassProperty& classProperty = testClass.properties["withNoData"];
+    classProperty.type = ClassProperty::Type::SCALAR;
+    classProperty.componentType = ClassProperty::ComponentType::INT32;
+    classProperty.noData = -1;
+    propertyTable.properties["withNoData"].values =
+        addBufferToModel(model, std::vector<int32_t>{5, -1, 7, -1});
+  }
+
+  {
+    ClassProperty& classProperty = testClass.properties["flags"];
+    classProperty.type = ClassProperty::Type::BOOLEAN;
+    propertyTable.properties["flags"].values =
+        addBufferToModel(model, std::vector<uint8_t>{0b1010});
+  }
+
+  const std::string text = "abcdefghij";
+  const std::vector<uint32_t> stringOffsets{0, 1, 3, 6, 10};
+  {
+    ClassProperty& classProperty = testClass.properties["names"];
+    classProperty.type = ClassProperty::Type::STRING;
+    PropertyTableProperty& property = propertyTable.properties["names"];
+    property.values = addBufferToModel(
+        model,
+        std::vector<char>(text.begin(), text.end()));
+    property.stringOffsets = addBufferToModel(model, stringOffsets);
+  }
+
+  {
+    ClassProperty& classProperty = testClass.properties["shortNames"];
+    classProperty.type = ClassProperty::Type::STRING;
+    PropertyTableProperty& property = propertyTable.properties["shortNames"];
+    property.values = addBufferToModel(
+        model,
+        std::vector<char>(text.begin(), text.end()));
+    property.stringOffsets =
+        addBufferToModel(model, std::vector<uint8_t>{0, 1, 3, 6, 10});
+    property.stringOffsetType = PropertyTableProperty::StringOffsetType::UINT8;
+  }
+
+  {
+    ClassProperty& classProperty = testClass.properties["lists"];
+    classProperty.type = ClassProperty::Type::SCALAR;
+    classProperty.componentType = ClassProperty::ComponentType::UINT16;
+    classProperty.array = true;
+    PropertyTableProperty& property = propertyTable.properties["lists"];
+    property.values =
+        addBufferToModel(model, std::vector<uint16_t>{1, 2, 3, 4, 5, 6});
+    property.arrayOffsets =
+        addBufferToModel(model, std::vector<uint32_t>{0, 2, 2, 8, 12});
+  }
+
+  {
+    ClassProperty& classProperty = testClass.properties["arrayOfStrings"];
+    classProperty.type = ClassProperty::Type::STRING;
+    classProperty.array = true;
+    classProperty.count = 1;
+    PropertyTableProperty& property =
+        propertyTable.properties["arrayOfStrings"];
+    property.values = addBufferToModel(
+        model,
+        std::vector<char>(text.begin(), text.end()));
+    property.stringOffsets = addBufferToModel(model, stringOffsets);
+  }
+
+  PropertyTableView view(model, propertyTable);
+  REQUIRE(view.status() == PropertyTableViewStatus::Valid);
+
+  const std::vector<PropertyTableColumn> columns =
+      exportPropertyTableColumns(view);
+  REQUIRE(columns.size() == testClass.properties.size());
+
+  SECTION("Views fixed-width values in place") {
+    const PropertyTableColumn& column = findColumn(columns, "integers");
+    REQUIRE(column.status == PropertyTablePropertyViewStatus::Valid);
+    REQUIRE(column.layout == PropertyTableColumnLayout::FixedWidth);
+    REQUIRE(column.componentType == PropertyComponentType::Uint32);
+    REQUIRE(column.componentCount == 1);
+    REQUIRE(column.length == 4);
+    REQUIRE(column.nullCount == 0);
+    REQUIRE(!column.values.isOwned());
+    REQUIRE(getValues<uint32_t>(column.values) == integers);
+    REQUIRE(column.validity.data().empty());
+  }
+
+  SECTION("Applies the scale and offset") {
+    const PropertyTableColumn& column = findColumn(columns, "scaled");
+    REQUIRE(column.layout == PropertyTableColumnLayout::FixedWidth);
+    REQUIRE(column.componentType == PropertyComponentType::Float32);
+    REQUIRE(column.values.isOwned());
+    REQUIRE(
+        getValues<float>(column.values) ==
+        std::vector<float>{3.0f, 5.0f, 7.0f, 9.0f});
+  }
+
+  SECTION("Marks no data values as null") {
+    const PropertyTableColumn& column = findColumn(columns, "withNoData");
+    REQUIRE(column.nullCount == 2);
+    REQUIRE(
+        getValues<int32_t>(column.values) ==
+        std::vector<int32_t>{5, 0, 7, 0});
+    REQUIRE(
+        getValues<uint8_t>(column.validity) == std::vector<uint8_t>{0b0101});
+  }
+
+  SECTION("Views booleans in place") {
+    const PropertyTableColumn& column = findColumn(columns, "flags");
+    REQUIRE(column.layout == PropertyTableColumnLayout::Boolean);
+    REQUIRE(!column.values.isOwned());
+    REQUIRE(getValues<uint8_t>(column.values) == std::vector<uint8_t>{0b1010});
+  }
+
+  SECTION("Views strings with 32-bit offsets in place") {
+    const PropertyTableColumn& column = findColumn(columns, "names");
+    REQUIRE(column.layout == PropertyTableColumnLayout::String);
+    REQUIRE(column.offsetType == PropertyComponentType::Uint32);
+    REQUIRE(!column.values.isOwned());
+    REQUIRE(!column.offsets.isOwned());
+    REQUIRE(getValues<uint32_t>(column.offsets) == stringOffsets);
+  }
+
+  SECTION("Widens 8-bit string offsets") {
+    const PropertyTableColumn& column = findColumn(columns, "shortNames");
+    REQUIRE(column.layout == PropertyTableColumnLayout::String);
+    REQUIRE(column.offsetType == PropertyComponentType::Uint32);
+    REQUIRE(!column.values.isOwned());
+    REQUIRE(column.offsets.isOwned());
+    REQUIRE(getValues<uint32_t>(column.offsets) == stringOffsets);
+  }
+
+  SECTION("Counts list offsets in array elements") {
+    const PropertyTableColumn& column = findColumn(columns, "lists");
+    REQUIRE(column.layout == PropertyTableColumnLayout::List);
+    REQUIRE(column.componentType == PropertyComponentType::Uint16);
+    REQUIRE(column.componentCount == 1);
+    REQUIRE(!column.values.isOwned());
+    REQUIRE(
+        getValues<uint32_t>(column.offsets) ==
+        std::vector<uint32_t>{0, 1, 1, 4, 6});
+  }
+
+  SECTION("Does not export arrays of strings") {
+    const PropertyTableColumn& column = findColumn(columns, "arrayOfStrings");
+    REQUIRE(column.status == PropertyTablePropertyViewStatus::Valid);
+    REQUIRE(column.layout == PropertyTableColumnLayout::None);
+  }
+}
@@ -14,6 +14,52 @@ using namespace CesiumUtility;
 
 namespace {
 
+template <typename T, bool Normalized>
+static void
+checkRange(const PropertyTablePropertyView<T, Normalized>& property) {
+  using RangeValueType =
+      typename PropertyTablePropertyView<T, Normalized>::RangeValueType;
+
+  size_t componentCount = 1;
+  if constexpr (IsMetadataArray<T>::value) {
+    componentCount = static_cast<size_t>(property.arrayCount());
+  }
+
+  // Skip the first element so that the range starts inside the data.
+  const int64_t start = property.size() > 1 ? 1 : 0;
+  const int64_t count = property.size() - start;
+  std::vector<RangeValueType> values(
+      static_cast<size_t>(count) * componentCount);
+  std::vector<std::byte> validity(static_cast<size_t>((count + 7) / 8));
+  const int64_t validCount =
+      property.getRange(start, count, values, validity);
+
+  int64_t expectedValidCount = 0;
+  for (int64_t i = 0; i < count; ++i) {
+    const size_t index = static_cast<size_t>(i);
+    const auto maybeValue = property.get(start + i);
+    const bool isValid =
+        (std::to_integer<int>(validity[index / 8]) >> (index % 8) & 1) == 1;
+    REQUIRE(isValid == maybeValue.has_value());
+    if (!maybeValue) {
+      continue;
+    }
+
+    ++expectedValidCount;
+    if constexpr (IsMetadataArray<T>::value) {
+      for (size_t j = 0; j < componentCount; ++j) {
+        REQUIRE(
+            values[index * componentCount + j] ==
+            (*maybeValue)[static_cast<int64_t>(j)]);
+      }
+    } else {
+      REQUIRE(values[index] == *maybeValue);
+    }
+  }
+
+  REQUIRE(validCount == expectedValidCount);
+}
+
 template <typename T>
 static void
 checkArrayEqual(PropertyArrayView<T> arrayView, std::vector<T> expected) {
@@ -96,6 +142,8 @@ static void checkNumeric(
       REQUIRE(property.get(i) == expected[static_cast<size_t>(i)]);
     }
   }
+
+  checkRange(property);
 }
 
 template <typename T, typename D = typename TypeToNormalizedType<T>::type>
@@ -139,6 +187,8 @@ static void checkNormalizedNumeric(
     REQUIRE(property.getRaw(i) == values[static_cast<size_t>(i)]);
     REQUIRE(property.get(i) == expected[static_cast<size_t>(i)]);
   }
+
+  checkRange(property);
 }
 
 template <typename DataType, typename OffsetType>
@@ -488,6 +538,10 @@ static void checkFixedLengthArray(
       REQUIRE(values[j] == expectedValues[static_cast<size_t>(j)]);
     }
   }
+
+  if constexpr (IsMetadataNumeric<T>::value) {
+    checkRange(property);
+  }
 }
 
 template <typename T, typename D = typename TypeToNormalizedType<T>::type>
@@ -561,6 +615,8 @@ static void checkNormalizedFixedLengthArray(
       REQUIRE(values[j] == expectedValues[static_cast<size_t>(j)]);
     }
   }
+
+  checkRange(property);
 }
 } // namespace
 
@@ -1276,6 +1332,66 @@ TEST_CASE("Check matN PropertyTablePropertyView (normalized)") {
   }
 }
 
+TEST_CASE("Check range reads of PropertyTablePropertyView") {
+  std::vector<int32_t> values{1, -1, 3, 4, -1, 6, 7, 8, 9, -1};
+  std::vector<std::byte> data;
+  data.resize(values.size() * sizeof(int32_t));
+  std::memcpy(data.data(), values.data(), data.size());
+
+  PropertyTableProperty propertyTableProperty;
+  ClassProperty classProperty;
+  classProperty.type = ClassProperty::Type::SCALAR;
+  classProperty.componentType = ClassProperty::ComponentType::INT32;
+  classProperty.noData = -1;
+
+  SECTION("Marks no data values as invalid") {
+    PropertyTablePropertyView<int32_t> property(
+        propertyTableProperty,
+        classProperty,
+        static_cast<int64_t>(values.size()),
+        gsl::span<const std::byte>(data.data(), data.size()));
+
+    std::vector<int32_t> range(values.size());
+    std::vector<std::byte> validity(2);
+    REQUIRE(
+        property.getRange(0, property.size(), range, validity) ==
+        static_cast<int64_t>(values.size()) - 3);
+    REQUIRE(range == std::vector<int32_t>{1, 0, 3, 4, 0, 6, 7, 8, 9, 0});
+    REQUIRE(validity[0] == std::byte(0b11101101));
+    REQUIRE(validity[1] == std::byte(0b00000001));
+  }
+
+  SECTION("Replaces no data values with the default value") {
+    classProperty.defaultProperty = 10;
+    PropertyTablePropertyView<int32_t> property(
+        propertyTableProperty,
+        classProperty,
+        static_cast<int64_t>(values.size()),
+        gsl::span<const std::byte>(data.data(), data.size()));
+
+    std::vector<int32_t> range(3);
+    std::vector<std::byte> validity(1);
+    REQUIRE(property.getRange(3, 3, range, validity) == 3);
+    REQUIRE(range == std::vector<int32_t>{4, 10, 6});
+    REQUIRE(validity[0] == std::byte(0b00000111));
+  }
+
+  SECTION("Fills an empty property with the default value") {
+    classProperty.defaultProperty = 10;
+    PropertyTablePropertyView<int32_t> property(classProperty, 9);
+    REQUIRE(
+        property.status() ==
+        PropertyTablePropertyViewStatus::EmptyPropertyWithDefault);
+
+    std::vector<int32_t> range(9);
+    std::vector<std::byte> validity(2);
+    REQUIRE(property.getRange(0, 9, range, validity) == 9);
+    REQUIRE(range == std::vector<int32_t>(9, 10));
+    REQUIRE(validity[0] == std::byte(0b11111111));
+    REQUIRE(validity[1] == std::byte(0b00000001));
+  }
+}
+
 TEST_CASE("Check boolean PropertyTablePropertyView") {
   std::bitset<sizeof(unsigned long)* CHAR_BIT> bits = 0b11110101;
   unsigned long val = bits.to_ulong();
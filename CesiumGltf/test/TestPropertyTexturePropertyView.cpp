@@ -11,6 +11,31 @@ using namespace CesiumGltf;
 using namespace CesiumUtility;
 
 namespace {
+template <typename T, bool Normalized>
+void checkBatch(
+    const PropertyTexturePropertyView<T, Normalized>& view,
+    const std::vector<glm::dvec2>& texCoords) {
+  using ValueType = typename decltype(view.get(0, 0))::value_type;
+  std::vector<ValueType> values(texCoords.size());
+  std::vector<std::byte> validity((texCoords.size() + 7) / 8);
+  const int64_t validCount = view.getBatch(texCoords, values, validity);
+
+  int64_t expectedValidCount = 0;
+  for (size_t i = 0; i < texCoords.size(); i++) {
+    const glm::dvec2 uv = texCoords[i];
+    const std::optional<ValueType> maybeValue = view.get(uv[0], uv[1]);
+    const bool isValid =
+        (std::to_integer<int>(validity[i / 8]) >> (i % 8) & 1) == 1;
+    REQUIRE(isValid == maybeValue.has_value());
+    if (maybeValue) {
+      REQUIRE(values[i] == *maybeValue);
+      ++expectedValidCount;
+    }
+  }
+
+  REQUIRE(validCount == expectedValidCount);
+}
+
 template <typename T>
 void checkTextureValues(
     const std::vector<uint8_t>& data,
@@ -71,6 +96,11 @@ void checkTextureValues(
     REQUIRE(view.getRaw(uv[0], uv[1]) == expected[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expected[i]);
   }
+
+  std::vector<T> rawValues(texCoords.size());
+  view.getRawBatch(texCoords, rawValues);
+  REQUIRE(rawValues == expected);
+  checkBatch(view, texCoords);
 }
 
 template <typename T>
@@ -143,6 +173,8 @@ void checkTextureValues(
     REQUIRE(view.getRaw(uv[0], uv[1]) == expectedRaw[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expectedTransformed[i]);
   }
+
+  checkBatch(view, texCoords);
 }
 
 template <typename T, typename D = typename TypeToNormalizedType<T>::type>
@@ -221,6 +253,8 @@ void checkNormalizedTextureValues(
     REQUIRE(view.getRaw(uv[0], uv[1]) == expectedRaw[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expectedTransformed[i]);
   }
+
+  checkBatch(view, texCoords);
 }
 
 template <typename T>
@@ -1454,6 +1488,8 @@ TEST_CASE("Check that PropertyTextureProperty values override class property "
     REQUIRE(view.getRaw(uv[0], uv[1]) == expectedRaw[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expectedTransformed[i]);
   }
+
+  checkBatch(view, texCoords);
 }
 
 TEST_CASE("Check that non-adjacent channels resolve to expected output") {
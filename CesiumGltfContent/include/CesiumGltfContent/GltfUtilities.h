@@ -2,17 +2,22 @@
 
 #include "Library.h"
 
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
 #include <CesiumGeospatial/BoundingRegion.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
 
 #include <glm/fwd.hpp>
 
+#include <cstdint>
+#include <optional>
 #include <string_view>
 #include <vector>
 
 namespace CesiumGltf {
 struct Buffer;
 struct Model;
+struct Node;
 } // namespace CesiumGltf
 
 namespace CesiumGltfContent {
@@ -73,14 +78,85 @@ struct CESIUMGLTFCONTENT_API GltfUtilities {
    * its maximum height will be -1.0 (the minimum will be greater than the
    * maximum).
    *
+   * The meshes of nodes with the `EXT_mesh_gpu_instancing` extension are
+   * bounded at each of their instances, by the corners of the box around
+   * their positions rather than by every position, which is conservative but
+   * stays cheap for dense instancing.
+   *
+   * The positions of a large primitive are bounded in ranges on the worker
+   * threads of the given async system, if there is one, and the regions of the
+   * ranges are then merged. The longitude range of a merged region may be
+   * slightly larger than if the positions were bounded in one go.
+   *
    * @param gltf The model.
    * @param transform The transform from model coordinates to ECEF coordinates.
+   * @param asyncSystem The async system whose worker threads bound the ranges
+   * of large primitives in parallel, or `std::nullopt` to bound them all in
+   * the calling thread.
    * @return The computed bounding region.
    */
   static CesiumGeospatial::BoundingRegion computeBoundingRegion(
+      const CesiumGltf::Model& gltf,
+      const glm::dmat4& transform,
+      const std::optional<CesiumAsync::AsyncSystem>& asyncSystem =
+          std::nullopt);
+
+  /**
+   * @brief Computes a tight oriented bounding box from the vertex positions in
+   * a glTF model, with
+   * {@link CesiumGeometry::OrientedBoundingBox::fromPositions}.
+   *
+   * Like {@link computeBoundingRegion}, this ignores the skirts of terrain
+   * meshes and bounds instanced meshes at each of their instances.
+   *
+   * @param gltf The model.
+   * @param transform The transform from model coordinates to the coordinates
+   * of the box, usually ECEF.
+   * @return The computed box, or `std::nullopt` if the model contains no
+   * geometry.
+   */
+  static std::optional<CesiumGeometry::OrientedBoundingBox>
+  computeOrientedBoundingBox(
       const CesiumGltf::Model& gltf,
       const glm::dmat4& transform);
 
+  /**
+   * @brief Gets the transform of each instance of a node with the
+   * `EXT_mesh_gpu_instancing` extension, which is applied before the node's
+   * own transform.
+   *
+   * @param gltf The model.
+   * @param node The node.
+   * @return The transforms, or an empty vector if the node is not instanced or
+   * its instance attributes are invalid.
+   */
+  static std::vector<glm::dmat4> getInstanceTransforms(
+      const CesiumGltf::Model& gltf,
+      const CesiumGltf::Node& node);
+
+  /**
+   * @brief Groups the instances of the glTF's nodes with the
+   * `EXT_mesh_gpu_instancing` extension into spatially coherent clusters, so
+   * that a renderer can cull them cluster by cluster.
+   *
+   * The instances of each node are split at the median of their translations
+   * along their longest axis until no cluster has more than
+   * `maxInstancesPerCluster` of them. The node's instance attributes are
+   * replaced by copies in a new buffer, ordered so that each cluster is a
+   * contiguous range of instances, and the clusters and their bounding boxes
+   * are stored in the node's extras as an {@link InstanceClusterMetadata}.
+   * Nodes with no more instances than that, whose mesh positions are not
+   * floats, or that are already clustered are left as they are.
+   *
+   * @param gltf The glTF model to modify.
+   * @param maxInstancesPerCluster The largest number of instances in a
+   * cluster. Nothing is clustered if this is zero.
+   * @return True if any node was clustered.
+   */
+  static bool clusterInstances(
+      CesiumGltf::Model& gltf,
+      uint32_t maxInstancesPerCluster);
+
   /**
    * @brief Parse the copyright field of a glTF model and return the individual
    * credits.
@@ -121,5 +197,64 @@ struct CESIUMGLTFCONTENT_API GltfUtilities {
       CesiumGltf::Model& gltf,
       CesiumGltf::Buffer& destination,
       CesiumGltf::Buffer& source);
+
+  /**
+   * @brief Merges the primitives of each of the glTF's meshes that can be
+   * drawn together, so that the renderer issues fewer draw calls.
+   *
+   * Primitives are merged when they have the same material and mode, the
+   * same attributes with the same types, and `EXT_mesh_features` feature ID
+   * sets that refer to the same property tables. Their vertices are
+   * concatenated into a new buffer and their indices are offset to match.
+   * Feature ID attributes take the names that the first primitive of a group
+   * uses for the same feature ID sets, so that each feature ID still refers
+   * to the same row of its property table, and the feature counts are
+   * recomputed.
+   *
+   * Only triangle, line, and point lists are merged. Primitives with morph
+   * targets, extensions other than `EXT_mesh_features` and a decoded
+   * `KHR_draco_mesh_compression`, or implicit feature IDs are left as they
+   * are. The data of the merged primitives stays in its original buffers.
+   *
+   * @param gltf The glTF model to modify.
+   * @return True if any primitives were merged.
+   */
+  static bool mergePrimitives(CesiumGltf::Model& gltf);
+
+  /**
+   * @brief Stores the floating-point positions and normals of the glTF's
+   * meshes as integers, using the `KHR_mesh_quantization` extension.
+   *
+   * Positions are stored as unsigned shorts relative to the bounds of their
+   * mesh, and normals as normalized bytes, which takes less than half the
+   * memory of the floats. The mesh is moved to a new child node of the node
+   * that used it, whose translation and uniform scale convert the quantized
+   * positions back. Because the scale is uniform, normals and tangents need
+   * no adjustment.
+   *
+   * A mesh is left as it is if it is used by more than one node, is skinned
+   * or instanced, has morph targets, or shares its position accessors with
+   * other meshes.
+   * The data of an accessor is replaced in place if nothing else uses its
+   * buffer, so that the memory is actually released.
+   *
+   * @param gltf The glTF model to modify.
+   * @return True if any mesh was quantized.
+   */
+  static bool quantizeMeshes(CesiumGltf::Model& gltf);
+
+  /**
+   * @brief Converts the integer positions and normals of meshes stored with
+   * `KHR_mesh_quantization` back to floats, undoing
+   * {@link quantizeMeshes}.
+   *
+   * The translation and scale of the node that uses a mesh are applied to its
+   * positions and reset. Meshes whose node also has a rotation, a matrix, or
+   * children are left as they are. The extension is removed from the glTF if
+   * no quantized meshes remain.
+   *
+   * @param gltf The glTF model to modify.
+   */
+  static void dequantizeMeshes(CesiumGltf::Model& gltf);
 };
 } // namespace CesiumGltfContent
@@ -2,8 +2,11 @@
 
 #include "Library.h"
 
+#include <CesiumGltf/Ktx2TranscodeTargets.h>
+
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 // Forward declarations
 namespace CesiumGltf {
@@ -115,6 +118,57 @@ public:
    */
   static void
   savePng(const CesiumGltf::ImageCesium& image, std::vector<std::byte>& output);
+
+  /**
+   * @brief Reduces the number of channels of an image in place, keeping its
+   * first channels.
+   *
+   * This stores single-channel data that was decoded or created with more
+   * channels, such as a grayscale mask in an RGBA image, with fewer bytes. For
+   * example, reducing an RGBA image to one channel keeps its red channel. The
+   * image's mipmaps, if it has any, are reduced as well.
+   *
+   * The image must not be compressed, and the number of channels must be at
+   * least one and no more than the image has. If these requirements are
+   * violated, this function will return false and will not change the image.
+   *
+   * @param image The image whose channels to reduce.
+   * @param channels The number of channels to keep.
+   * @returns True if the image has the given number of channels, or false if
+   * it could not be reduced to them.
+   */
+  static bool
+  truncateChannels(CesiumGltf::ImageCesium& image, int32_t channels);
+
+  /**
+   * @brief Encodes an image, and its mipmaps if it has any, to a GPU block
+   * compression format in place.
+   *
+   * The image is encoded with the fast, single-pass encoder of `stb_dxt`. The
+   * supported formats, and the images they can encode, are:
+   *
+   * - {@link CesiumGltf::GpuCompressedPixelFormat::BC1_RGB}: images with three
+   *   or four channels. Alpha is discarded.
+   * - {@link CesiumGltf::GpuCompressedPixelFormat::BC3_RGBA}: images with four
+   *   channels.
+   * - {@link CesiumGltf::GpuCompressedPixelFormat::BC4_R}: images with one
+   *   channel.
+   * - {@link CesiumGltf::GpuCompressedPixelFormat::BC5_RG}: images with two
+   *   channels.
+   *
+   * The image must use 1 byte per channel and must not already be compressed.
+   * Levels whose sizes are not multiples of four are padded by repeating their
+   * last row and column. If any of these requirements are violated, this
+   * function will return false and will not change the image.
+   *
+   * @param image The image to encode.
+   * @param format The format to encode the image to.
+   * @returns True if the image was encoded, or false if the format or image is
+   * not supported.
+   */
+  static bool compressImage(
+      CesiumGltf::ImageCesium& image,
+      CesiumGltf::GpuCompressedPixelFormat format);
 };
 
 } // namespace CesiumGltfContent
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Library.h"
+
+#include <CesiumGeometry/AxisAlignedBox.h>
+#include <CesiumUtility/JsonValue.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace CesiumGltfContent {
+/**
+ * @brief A contiguous range of the instances of a node with the
+ * `EXT_mesh_gpu_instancing` extension, and the box that bounds them.
+ */
+struct InstanceCluster {
+  /**
+   * @brief The index of the first instance in the cluster.
+   */
+  int64_t firstInstance = 0;
+
+  /**
+   * @brief The number of instances in the cluster.
+   */
+  int64_t instanceCount = 0;
+
+  /**
+   * @brief The box that bounds the node's mesh at every instance in the
+   * cluster, in the coordinates of the node, before the node's own transform
+   * is applied.
+   */
+  CesiumGeometry::AxisAlignedBox boundingBox;
+};
+
+/**
+ * @brief The clusters into which
+ * {@link GltfUtilities::clusterInstances} grouped the instances of a node,
+ * stored in the node's extras.
+ *
+ * A renderer can test each cluster's box against the view and draw only the
+ * instance ranges of the visible ones, rather than all of a node's instances
+ * or none of them.
+ */
+struct CESIUMGLTFCONTENT_API InstanceClusterMetadata {
+  /**
+   * @brief The clusters, which are ordered by their first instance and
+   * together cover all of the instances of the node.
+   */
+  std::vector<InstanceCluster> clusters;
+
+  static std::optional<InstanceClusterMetadata>
+  parseFromGltfExtras(const CesiumUtility::JsonValue::Object& extras);
+
+  static CesiumUtility::JsonValue::Object
+  createGltfExtras(const InstanceClusterMetadata& metadata);
+};
+} // namespace CesiumGltfContent
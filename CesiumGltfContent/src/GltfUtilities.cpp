@@ -1,11 +1,35 @@
+#include <CesiumAsync/forEachInParallel.h>
 #include <CesiumGeometry/Axis.h>
 #include <CesiumGeometry/Transforms.h>
 #include <CesiumGeospatial/BoundingRegionBuilder.h>
+#include <CesiumGeospatial/Ellipsoid.h>
 #include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/ExtensionCesiumRTC.h>
+#include <CesiumGltf/ExtensionExtMeshFeatures.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
 #include <CesiumGltfContent/GltfUtilities.h>
+#include <CesiumGltfContent/InstanceClusterMetadata.h>
 #include <CesiumGltfContent/SkirtMeshMetadata.h>
 
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <gsl/span>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 using namespace CesiumGltf;
@@ -56,10 +80,164 @@ namespace CesiumGltfContent {
   return rootTransform;
 }
 
+namespace {
+// Reads the values of an instance attribute, leaving them empty if the
+// attribute is missing. Returns false if the attribute is invalid.
+bool readInstanceVec3s(
+    const Model& gltf,
+    const ExtensionExtMeshGpuInstancing& instancing,
+    const std::string& name,
+    std::vector<glm::dvec3>& values) {
+  auto it = instancing.attributes.find(name);
+  if (it == instancing.attributes.end()) {
+    return true;
+  }
+
+  const AccessorView<glm::vec3> view(gltf, it->second);
+  if (view.status() != AccessorViewStatus::Valid) {
+    return false;
+  }
+
+  values.reserve(size_t(view.size()));
+  for (int64_t i = 0; i < view.size(); ++i) {
+    values.emplace_back(view[i]);
+  }
+  return true;
+}
+
+template <typename T>
+bool readInstanceRotations(
+    const AccessorView<T>& view,
+    double divisor,
+    std::vector<glm::dquat>& values) {
+  if (view.status() != AccessorViewStatus::Valid) {
+    return false;
+  }
+
+  values.reserve(size_t(view.size()));
+  for (int64_t i = 0; i < view.size(); ++i) {
+    const glm::dvec4 q = glm::max(glm::dvec4(view[i]) / divisor, -1.0);
+    values.emplace_back(q.w, q.x, q.y, q.z);
+  }
+  return true;
+}
+
+// Rotations may be floats or normalized signed bytes or shorts.
+bool readInstanceRotations(
+    const Model& gltf,
+    const ExtensionExtMeshGpuInstancing& instancing,
+    std::vector<glm::dquat>& values) {
+  auto it = instancing.attributes.find("ROTATION");
+  if (it == instancing.attributes.end()) {
+    return true;
+  }
+
+  const Accessor* pAccessor = Model::getSafe(&gltf.accessors, it->second);
+  if (!pAccessor) {
+    return false;
+  }
+
+  switch (pAccessor->componentType) {
+  case Accessor::ComponentType::FLOAT:
+    return readInstanceRotations(
+        AccessorView<glm::vec4>(gltf, *pAccessor),
+        1.0,
+        values);
+  case Accessor::ComponentType::BYTE:
+    return readInstanceRotations(
+        AccessorView<glm::i8vec4>(gltf, *pAccessor),
+        127.0,
+        values);
+  case Accessor::ComponentType::SHORT:
+    return readInstanceRotations(
+        AccessorView<glm::i16vec4>(gltf, *pAccessor),
+        32767.0,
+        values);
+  default:
+    return false;
+  }
+}
+
+// Finds the box that bounds a range of positions.
+std::optional<std::pair<glm::dvec3, glm::dvec3>> computePositionBounds(
+    const AccessorView<glm::vec3>& positions,
+    int64_t begin,
+    int64_t end) {
+  if (begin >= end) {
+    return std::nullopt;
+  }
+
+  glm::dvec3 minimum(positions.getUnchecked(begin));
+  glm::dvec3 maximum = minimum;
+  for (int64_t i = begin + 1; i < end; ++i) {
+    const glm::dvec3 position(positions.getUnchecked(i));
+    minimum = glm::min(minimum, position);
+    maximum = glm::max(maximum, position);
+  }
+  return std::make_pair(minimum, maximum);
+}
+
+// Calls `f` with each corner of a box, transformed by `transform`. Instanced
+// meshes are bounded by the corners of their box at each instance, rather
+// than by every vertex at every instance, which would be far more positions.
+template <typename Func>
+void forEachTransformedCorner(
+    const std::pair<glm::dvec3, glm::dvec3>& box,
+    const glm::dmat4& transform,
+    Func&& f) {
+  for (int corner = 0; corner < 8; ++corner) {
+    const glm::dvec3 position(
+        (corner & 1) ? box.second.x : box.first.x,
+        (corner & 2) ? box.second.y : box.first.y,
+        (corner & 4) ? box.second.z : box.first.z);
+    f(glm::dvec3(transform * glm::dvec4(position, 1.0)));
+  }
+}
+} // namespace
+
+/*static*/ std::vector<glm::dmat4> GltfUtilities::getInstanceTransforms(
+    const CesiumGltf::Model& gltf,
+    const CesiumGltf::Node& node) {
+  const ExtensionExtMeshGpuInstancing* pInstancing =
+      node.getExtension<ExtensionExtMeshGpuInstancing>();
+  if (!pInstancing) {
+    return {};
+  }
+
+  std::vector<glm::dvec3> translations;
+  std::vector<glm::dquat> rotations;
+  std::vector<glm::dvec3> scales;
+  if (!readInstanceVec3s(gltf, *pInstancing, "TRANSLATION", translations) ||
+      !readInstanceRotations(gltf, *pInstancing, rotations) ||
+      !readInstanceVec3s(gltf, *pInstancing, "SCALE", scales)) {
+    return {};
+  }
+
+  const size_t count =
+      std::max(translations.size(), std::max(rotations.size(), scales.size()));
+  if ((!translations.empty() && translations.size() != count) ||
+      (!rotations.empty() && rotations.size() != count) ||
+      (!scales.empty() && scales.size() != count)) {
+    return {};
+  }
+
+  std::vector<glm::dmat4> transforms;
+  transforms.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    transforms.emplace_back(
+        CesiumGeometry::Transforms::createTranslationRotationScaleMatrix(
+            translations.empty() ? glm::dvec3(0.0) : translations[i],
+            rotations.empty() ? glm::dquat(1.0, 0.0, 0.0, 0.0) : rotations[i],
+            scales.empty() ? glm::dvec3(1.0) : scales[i]));
+  }
+  return transforms;
+}
+
 /*static*/ CesiumGeospatial::BoundingRegion
 GltfUtilities::computeBoundingRegion(
     const CesiumGltf::Model& gltf,
-    const glm::dmat4& transform) {
+    const glm::dmat4& transform,
+    const std::optional<CesiumAsync::AsyncSystem>& asyncSystem) {
   glm::dmat4 rootTransform = transform;
   rootTransform = applyRtcCenter(gltf, rootTransform);
   rootTransform = applyGltfUpAxisTransform(gltf, rootTransform);
@@ -71,9 +249,9 @@ GltfUtilities::computeBoundingRegion(
 
   gltf.forEachPrimitiveInScene(
       -1,
-      [&rootTransform, &computedBounds](
+      [&rootTransform, &computedBounds, &asyncSystem](
           const CesiumGltf::Model& gltf_,
-          const CesiumGltf::Node& /*node*/,
+          const CesiumGltf::Node& node,
           const CesiumGltf::Mesh& /*mesh*/,
           const CesiumGltf::MeshPrimitive& primitive,
           const glm::dmat4& nodeTransform) {
@@ -108,28 +286,181 @@ GltfUtilities::computeBoundingRegion(
           vertexBegin = 0;
           vertexEnd = positionView.size();
         }
+        vertexBegin = std::max(vertexBegin, int64_t(0));
+        vertexEnd = std::min(vertexEnd, positionView.size());
 
-        for (int64_t i = vertexBegin; i < vertexEnd; ++i) {
-          // Get the ECEF position
-          const glm::vec3 position = positionView[i];
-          const glm::dvec3 positionEcef =
-              glm::dvec3(fullTransform * glm::dvec4(position, 1.0));
-
-          // Convert it to cartographic
-          std::optional<CesiumGeospatial::Cartographic> cartographic =
-              CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographic(
-                  positionEcef);
-          if (!cartographic) {
-            continue;
+        const std::vector<glm::dmat4> instances =
+            getInstanceTransforms(gltf_, node);
+        if (!instances.empty()) {
+          const std::optional<std::pair<glm::dvec3, glm::dvec3>> box =
+              computePositionBounds(positionView, vertexBegin, vertexEnd);
+          if (!box) {
+            return;
           }
 
-          computedBounds.expandToIncludePosition(*cartographic);
+          for (const glm::dmat4& instance : instances) {
+            forEachTransformedCorner(
+                *box,
+                fullTransform * instance,
+                [&computedBounds](const glm::dvec3& positionEcef) {
+                  const std::optional<CesiumGeospatial::Cartographic>
+                      cartographic =
+                          CesiumGeospatial::Ellipsoid::WGS84
+                              .cartesianToCartographic(positionEcef);
+                  if (cartographic) {
+                    computedBounds.expandToIncludePosition(*cartographic);
+                  }
+                });
+          }
+          return;
+        }
+
+        // Bounds the positions from begin to end, converting them to
+        // cartographic a chunk at a time with the batch conversion of the
+        // ellipsoid.
+        const auto boundPositions =
+            [&positionView, &fullTransform](
+                CesiumGeospatial::BoundingRegionBuilder& bounds,
+                int64_t begin,
+                int64_t end) {
+              constexpr int64_t chunkSize = 1024;
+              std::vector<double> xs(chunkSize), ys(chunkSize),
+                  zs(chunkSize);
+              for (int64_t chunkBegin = begin; chunkBegin < end;
+                   chunkBegin += chunkSize) {
+                const size_t count = static_cast<size_t>(
+                    std::min(chunkSize, end - chunkBegin));
+                for (size_t i = 0; i < count; ++i) {
+                  // Get the ECEF position
+                  const glm::vec3 position = positionView.getUnchecked(
+                      chunkBegin + static_cast<int64_t>(i));
+                  const glm::dvec3 positionEcef =
+                      glm::dvec3(fullTransform * glm::dvec4(position, 1.0));
+                  xs[i] = positionEcef.x;
+                  ys[i] = positionEcef.y;
+                  zs[i] = positionEcef.z;
+                }
+
+                bounds.expandToIncludeCartesianPositions(
+                    gsl::span<const double>(xs).first(count),
+                    gsl::span<const double>(ys).first(count),
+                    gsl::span<const double>(zs).first(count));
+              }
+            };
+
+        // Large primitives are split into ranges that are bounded in
+        // parallel, and whose regions are then merged in order.
+        constexpr int64_t rangeSize = 65536;
+        const int64_t vertexCount = vertexEnd - vertexBegin;
+        if (!asyncSystem || vertexCount <= rangeSize) {
+          boundPositions(computedBounds, vertexBegin, vertexEnd);
+          return;
+        }
+
+        const size_t rangeCount =
+            static_cast<size_t>((vertexCount + rangeSize - 1) / rangeSize);
+        std::vector<CesiumGeospatial::BoundingRegionBuilder> rangeBounds(
+            rangeCount);
+        CesiumAsync::forEachInParallel(
+            asyncSystem,
+            rangeCount,
+            [&boundPositions, &rangeBounds, vertexBegin, vertexEnd](
+                size_t rangeIndex) {
+              const int64_t begin =
+                  vertexBegin + static_cast<int64_t>(rangeIndex) * rangeSize;
+              boundPositions(
+                  rangeBounds[rangeIndex],
+                  begin,
+                  std::min(begin + rangeSize, vertexEnd));
+            });
+
+        for (const CesiumGeospatial::BoundingRegionBuilder& bounds :
+             rangeBounds) {
+          computedBounds.merge(bounds);
         }
       });
 
   return computedBounds.toRegion();
 }
 
+/*static*/ std::optional<CesiumGeometry::OrientedBoundingBox>
+GltfUtilities::computeOrientedBoundingBox(
+    const CesiumGltf::Model& gltf,
+    const glm::dmat4& transform) {
+  glm::dmat4 rootTransform = transform;
+  rootTransform = applyRtcCenter(gltf, rootTransform);
+  rootTransform = applyGltfUpAxisTransform(gltf, rootTransform);
+
+  std::vector<glm::dvec3> positions;
+  gltf.forEachPrimitiveInScene(
+      -1,
+      [&rootTransform, &positions](
+          const CesiumGltf::Model& gltf_,
+          const CesiumGltf::Node& node,
+          const CesiumGltf::Mesh& /*mesh*/,
+          const CesiumGltf::MeshPrimitive& primitive,
+          const glm::dmat4& nodeTransform) {
+        auto positionIt = primitive.attributes.find("POSITION");
+        if (positionIt == primitive.attributes.end()) {
+          return;
+        }
+
+        const CesiumGltf::AccessorView<glm::vec3> positionView(
+            gltf_,
+            positionIt->second);
+        if (positionView.status() != CesiumGltf::AccessorViewStatus::Valid) {
+          return;
+        }
+
+        std::optional<SkirtMeshMetadata> skirtMeshMetadata =
+            SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
+        int64_t vertexBegin = 0;
+        int64_t vertexEnd = positionView.size();
+        if (skirtMeshMetadata) {
+          vertexBegin = int64_t(skirtMeshMetadata->noSkirtVerticesBegin);
+          vertexEnd = std::min(
+              vertexBegin + int64_t(skirtMeshMetadata->noSkirtVerticesCount),
+              vertexEnd);
+        }
+
+        const glm::dmat4 fullTransform = rootTransform * nodeTransform;
+        const std::vector<glm::dmat4> instances =
+            getInstanceTransforms(gltf_, node);
+        if (!instances.empty()) {
+          const std::optional<std::pair<glm::dvec3, glm::dvec3>> box =
+              computePositionBounds(positionView, vertexBegin, vertexEnd);
+          if (!box) {
+            return;
+          }
+
+          positions.reserve(positions.size() + 8 * instances.size());
+          for (const glm::dmat4& instance : instances) {
+            forEachTransformedCorner(
+                *box,
+                fullTransform * instance,
+                [&positions](const glm::dvec3& position) {
+                  positions.emplace_back(position);
+                });
+          }
+          return;
+        }
+
+        positions.reserve(
+            positions.size() +
+            size_t(std::max(vertexEnd - vertexBegin, int64_t(0))));
+        for (int64_t i = vertexBegin; i < vertexEnd; ++i) {
+          positions.emplace_back(fullTransform *
+                                 glm::dvec4(positionView.getUnchecked(i), 1.0));
+        }
+      });
+
+  if (positions.empty()) {
+    return std::nullopt;
+  }
+
+  return CesiumGeometry::OrientedBoundingBox::fromPositions(positions);
+}
+
 std::vector<std::string_view>
 GltfUtilities::parseGltfCopyright(const CesiumGltf::Model& gltf) {
   std::vector<std::string_view> result;
@@ -174,8 +505,9 @@ GltfUtilities::parseGltfCopyright(const CesiumGltf::Model& gltf) {
     CesiumGltf::Buffer& source) {
   // Assert that the byteLength and the size of the cesium data vector are in
   // sync.
-  assert(source.byteLength == int64_t(source.cesium.data.size()));
-  assert(destination.byteLength == int64_t(destination.cesium.data.size()));
+  assert(source.byteLength == int64_t(source.cesium.getData().size()));
+  assert(
+      destination.byteLength == int64_t(destination.cesium.getData().size()));
 
   int64_t sourceIndex = &source - &gltf.buffers[0];
   int64_t destinationIndex = &destination - &gltf.buffers[0];
@@ -189,18 +521,21 @@ GltfUtilities::parseGltfCopyright(const CesiumGltf::Model& gltf) {
   }
 
   // Copy the data to the destination and keep track of where we put it.
-  size_t start = destination.cesium.data.size();
+  std::vector<std::byte>& destinationData = destination.cesium.getMutableData();
+  size_t start = destinationData.size();
 
-  destination.cesium.data.insert(
-      destination.cesium.data.end(),
-      source.cesium.data.begin(),
-      source.cesium.data.end());
+  const gsl::span<const std::byte> sourceData = source.cesium.getData();
+  destinationData.insert(
+      destinationData.end(),
+      sourceData.begin(),
+      sourceData.end());
 
   source.byteLength = 0;
   source.cesium.data.clear();
   source.cesium.data.shrink_to_fit();
+  source.cesium.sharedData = CesiumUtility::SharedBytes();
 
-  destination.byteLength = int64_t(destination.cesium.data.size());
+  destination.byteLength = int64_t(destinationData.size());
 
   // Update all the bufferViews that previously referred to the source Buffer to
   // refer to the destination Buffer instead.
@@ -213,4 +548,1299 @@ GltfUtilities::parseGltfCopyright(const CesiumGltf::Model& gltf) {
   }
 }
 
+namespace {
+const std::string meshQuantizationExtension = "KHR_mesh_quantization";
+
+void countUse(std::vector<size_t>& uses, int32_t index) noexcept {
+  if (index >= 0 && size_t(index) < uses.size()) {
+    ++uses[size_t(index)];
+  }
+}
+
+// Counts the users of each mesh, accessor, bufferView, and buffer, to find
+// out which can be changed without affecting anything else.
+struct UseCounts {
+  explicit UseCounts(const Model& gltf)
+      : meshes(gltf.meshes.size(), 0),
+        accessors(gltf.accessors.size(), 0),
+        bufferViews(gltf.bufferViews.size(), 0),
+        buffers(gltf.buffers.size(), 0) {
+    for (const Node& node : gltf.nodes) {
+      countUse(this->meshes, node.mesh);
+    }
+
+    for (const Mesh& mesh : gltf.meshes) {
+      for (const MeshPrimitive& primitive : mesh.primitives) {
+        for (const auto& attribute : primitive.attributes) {
+          countUse(this->accessors, attribute.second);
+        }
+        for (const auto& target : primitive.targets) {
+          for (const auto& attribute : target) {
+            countUse(this->accessors, attribute.second);
+          }
+        }
+        countUse(this->accessors, primitive.indices);
+      }
+    }
+
+    for (const Skin& skin : gltf.skins) {
+      countUse(this->accessors, skin.inverseBindMatrices);
+    }
+
+    for (const Animation& animation : gltf.animations) {
+      for (const AnimationSampler& sampler : animation.samplers) {
+        countUse(this->accessors, sampler.input);
+        countUse(this->accessors, sampler.output);
+      }
+    }
+
+    for (const Accessor& accessor : gltf.accessors) {
+      countUse(this->bufferViews, accessor.bufferView);
+      if (accessor.sparse) {
+        countUse(this->bufferViews, accessor.sparse->indices.bufferView);
+        countUse(this->bufferViews, accessor.sparse->values.bufferView);
+      }
+    }
+
+    for (const Image& image : gltf.images) {
+      countUse(this->bufferViews, image.bufferView);
+    }
+
+    for (const BufferView& bufferView : gltf.bufferViews) {
+      countUse(this->buffers, bufferView.buffer);
+    }
+  }
+
+  // Determines if an accessor is the only user of its bufferView and buffer.
+  bool ownsData(const Model& gltf, int32_t accessorIndex) const noexcept {
+    const Accessor& accessor = gltf.accessors[size_t(accessorIndex)];
+    if (accessor.bufferView < 0 ||
+        size_t(accessor.bufferView) >= gltf.bufferViews.size() ||
+        this->bufferViews[size_t(accessor.bufferView)] != 1) {
+      return false;
+    }
+
+    const int32_t buffer =
+        gltf.bufferViews[size_t(accessor.bufferView)].buffer;
+    return buffer >= 0 && size_t(buffer) < gltf.buffers.size() &&
+           this->buffers[size_t(buffer)] == 1;
+  }
+
+  std::vector<size_t> meshes;
+  std::vector<size_t> accessors;
+  std::vector<size_t> bufferViews;
+  std::vector<size_t> buffers;
+};
+
+// Points an accessor at new vertex data, reusing its bufferView and buffer if
+// nothing else uses them, so that the old data is released.
+void replaceAccessorData(
+    Model& gltf,
+    int32_t accessorIndex,
+    std::vector<std::byte>&& data,
+    int64_t byteStride,
+    bool ownsData) {
+  const int64_t byteLength = int64_t(data.size());
+  Accessor& accessor = gltf.accessors[size_t(accessorIndex)];
+  accessor.byteOffset = 0;
+
+  if (ownsData) {
+    BufferView& bufferView = gltf.bufferViews[size_t(accessor.bufferView)];
+    Buffer& buffer = gltf.buffers[size_t(bufferView.buffer)];
+    buffer.cesium.data = std::move(data);
+    buffer.cesium.sharedData = CesiumUtility::SharedBytes();
+    buffer.byteLength = byteLength;
+    bufferView.byteOffset = 0;
+    bufferView.byteLength = byteLength;
+    bufferView.byteStride = byteStride;
+    return;
+  }
+
+  Buffer& buffer = gltf.buffers.emplace_back();
+  buffer.cesium.data = std::move(data);
+  buffer.byteLength = byteLength;
+
+  BufferView& bufferView = gltf.bufferViews.emplace_back();
+  bufferView.buffer = int32_t(gltf.buffers.size() - 1);
+  bufferView.byteOffset = 0;
+  bufferView.byteLength = byteLength;
+  bufferView.byteStride = byteStride;
+  bufferView.target = BufferView::Target::ARRAY_BUFFER;
+
+  accessor.bufferView = int32_t(gltf.bufferViews.size() - 1);
+}
+
+int32_t findAttribute(
+    const MeshPrimitive& primitive,
+    const std::string& name) noexcept {
+  auto it = primitive.attributes.find(name);
+  return it == primitive.attributes.end() ? -1 : it->second;
+}
+
+bool isFloatVec3(const Model& gltf, int32_t accessorIndex) noexcept {
+  if (accessorIndex < 0 || size_t(accessorIndex) >= gltf.accessors.size()) {
+    return false;
+  }
+
+  const Accessor& accessor = gltf.accessors[size_t(accessorIndex)];
+  return accessor.componentType == Accessor::ComponentType::FLOAT &&
+         accessor.type == Accessor::Type::VEC3 && !accessor.sparse;
+}
+
+// Finds the bounds of the positions of a mesh, or nothing if the mesh can't
+// be quantized.
+std::optional<std::pair<glm::dvec3, glm::dvec3>> computeQuantizableBounds(
+    const Model& gltf,
+    const Mesh& mesh,
+    const UseCounts& uses) {
+  glm::dvec3 minimum(std::numeric_limits<double>::max());
+  glm::dvec3 maximum(std::numeric_limits<double>::lowest());
+  for (const MeshPrimitive& primitive : mesh.primitives) {
+    const int32_t positionAccessor = findAttribute(primitive, "POSITION");
+    if (!primitive.targets.empty() || !isFloatVec3(gltf, positionAccessor) ||
+        uses.accessors[size_t(positionAccessor)] != 1) {
+      return std::nullopt;
+    }
+
+    const AccessorView<glm::vec3> positions(gltf, positionAccessor);
+    if (positions.status() != AccessorViewStatus::Valid) {
+      return std::nullopt;
+    }
+
+    for (const glm::vec3& value : positions) {
+      const glm::dvec3 position(value);
+      minimum = glm::min(minimum, position);
+      maximum = glm::max(maximum, position);
+    }
+  }
+
+  if (minimum.x > maximum.x) {
+    return std::nullopt;
+  }
+
+  return std::make_pair(minimum, maximum);
+}
+
+void quantizePositions(
+    Model& gltf,
+    int32_t accessorIndex,
+    const glm::dvec3& origin,
+    double scale,
+    bool ownsData) {
+  std::vector<std::byte> data;
+  glm::u16vec3 minimum(std::numeric_limits<uint16_t>::max());
+  glm::u16vec3 maximum(0);
+  {
+    const AccessorView<glm::vec3> positions(gltf, accessorIndex);
+    data.resize(size_t(positions.size()) * sizeof(glm::u16vec4));
+    glm::u16vec4* pQuantized = reinterpret_cast<glm::u16vec4*>(data.data());
+    for (int64_t i = 0; i < positions.size(); ++i) {
+      const glm::dvec3 quantized = glm::clamp(
+          glm::round((glm::dvec3(positions.getUnchecked(i)) - origin) / scale),
+          0.0,
+          65535.0);
+      const glm::u16vec3 value(quantized);
+      pQuantized[i] = glm::u16vec4(value, 0);
+      minimum = glm::min(minimum, value);
+      maximum = glm::max(maximum, value);
+    }
+  }
+
+  // Each vertex is padded to 8 bytes, because vertex attributes must be
+  // aligned to 4 bytes.
+  replaceAccessorData(
+      gltf,
+      accessorIndex,
+      std::move(data),
+      int64_t(sizeof(glm::u16vec4)),
+      ownsData);
+
+  Accessor& accessor = gltf.accessors[size_t(accessorIndex)];
+  accessor.componentType = Accessor::ComponentType::UNSIGNED_SHORT;
+  accessor.normalized = false;
+  accessor.min = {double(minimum.x), double(minimum.y), double(minimum.z)};
+  accessor.max = {double(maximum.x), double(maximum.y), double(maximum.z)};
+}
+
+void quantizeNormals(Model& gltf, int32_t accessorIndex, bool ownsData) {
+  std::vector<std::byte> data;
+  {
+    const AccessorView<glm::vec3> normals(gltf, accessorIndex);
+    if (normals.status() != AccessorViewStatus::Valid) {
+      return;
+    }
+
+    data.resize(size_t(normals.size()) * sizeof(glm::i8vec4));
+    glm::i8vec4* pQuantized = reinterpret_cast<glm::i8vec4*>(data.data());
+    for (int64_t i = 0; i < normals.size(); ++i) {
+      const glm::vec3 quantized =
+          glm::round(glm::clamp(normals.getUnchecked(i), -1.0f, 1.0f) * 127.0f);
+      pQuantized[i] = glm::i8vec4(glm::i8vec3(quantized), 0);
+    }
+  }
+
+  replaceAccessorData(
+      gltf,
+      accessorIndex,
+      std::move(data),
+      int64_t(sizeof(glm::i8vec4)),
+      ownsData);
+
+  Accessor& accessor = gltf.accessors[size_t(accessorIndex)];
+  accessor.componentType = Accessor::ComponentType::BYTE;
+  accessor.normalized = true;
+  accessor.min.clear();
+  accessor.max.clear();
+}
+
+template <typename T>
+std::optional<std::vector<glm::vec3>>
+readQuantizedVec3(const Model& gltf, int32_t accessorIndex, bool normalized) {
+  using TVec3 = glm::vec<3, T>;
+  const AccessorView<TVec3> view(gltf, accessorIndex);
+  if (view.status() != AccessorViewStatus::Valid) {
+    return std::nullopt;
+  }
+
+  // Normalized integers are mapped to [0, 1] or [-1, 1].
+  const float divisor =
+      normalized ? float(std::numeric_limits<T>::max()) : 1.0f;
+  std::vector<glm::vec3> result(size_t(view.size()));
+  for (int64_t i = 0; i < view.size(); ++i) {
+    result[size_t(i)] = glm::vec3(view.getUnchecked(i)) / divisor;
+  }
+
+  if (normalized && std::numeric_limits<T>::is_signed) {
+    for (glm::vec3& value : result) {
+      value = glm::max(value, glm::vec3(-1.0f));
+    }
+  }
+
+  return result;
+}
+
+std::optional<std::vector<glm::vec3>>
+readIntegerVec3(const Model& gltf, int32_t accessorIndex) {
+  if (accessorIndex < 0 || size_t(accessorIndex) >= gltf.accessors.size()) {
+    return std::nullopt;
+  }
+
+  const Accessor& accessor = gltf.accessors[size_t(accessorIndex)];
+  if (accessor.type != Accessor::Type::VEC3 || accessor.sparse) {
+    return std::nullopt;
+  }
+
+  switch (accessor.componentType) {
+  case Accessor::ComponentType::BYTE:
+    return readQuantizedVec3<int8_t>(gltf, accessorIndex, accessor.normalized);
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    return readQuantizedVec3<uint8_t>(
+        gltf,
+        accessorIndex,
+        accessor.normalized);
+  case Accessor::ComponentType::SHORT:
+    return readQuantizedVec3<int16_t>(
+        gltf,
+        accessorIndex,
+        accessor.normalized);
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    return readQuantizedVec3<uint16_t>(
+        gltf,
+        accessorIndex,
+        accessor.normalized);
+  default:
+    return std::nullopt;
+  }
+}
+
+void writeFloatVec3(
+    Model& gltf,
+    int32_t accessorIndex,
+    const std::vector<glm::vec3>& values,
+    bool ownsData,
+    bool computeBounds) {
+  std::vector<std::byte> data(values.size() * sizeof(glm::vec3));
+  std::memcpy(data.data(), values.data(), data.size());
+  replaceAccessorData(
+      gltf,
+      accessorIndex,
+      std::move(data),
+      int64_t(sizeof(glm::vec3)),
+      ownsData);
+
+  Accessor& accessor = gltf.accessors[size_t(accessorIndex)];
+  accessor.componentType = Accessor::ComponentType::FLOAT;
+  accessor.normalized = false;
+  accessor.min.clear();
+  accessor.max.clear();
+  if (computeBounds && !values.empty()) {
+    glm::vec3 minimum = values.front();
+    glm::vec3 maximum = values.front();
+    for (const glm::vec3& value : values) {
+      minimum = glm::min(minimum, value);
+      maximum = glm::max(maximum, value);
+    }
+    accessor.min = {minimum.x, minimum.y, minimum.z};
+    accessor.max = {maximum.x, maximum.y, maximum.z};
+  }
+}
+
+bool isIdentityMatrix(const std::vector<double>& matrix) noexcept {
+  static const std::vector<double> identity =
+      {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+  return matrix.empty() || matrix == identity;
+}
+
+void addExtension(std::vector<std::string>& extensions) {
+  if (std::find(
+          extensions.begin(),
+          extensions.end(),
+          meshQuantizationExtension) == extensions.end()) {
+    extensions.emplace_back(meshQuantizationExtension);
+  }
+}
+
+void removeExtension(std::vector<std::string>& extensions) {
+  extensions.erase(
+      std::remove(
+          extensions.begin(),
+          extensions.end(),
+          meshQuantizationExtension),
+      extensions.end());
+}
+} // namespace
+
+/*static*/ bool GltfUtilities::quantizeMeshes(CesiumGltf::Model& gltf) {
+  const UseCounts uses(gltf);
+
+  bool quantizedAny = false;
+  const size_t nodeCount = gltf.nodes.size();
+  for (size_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+    const int32_t meshIndex = gltf.nodes[nodeIndex].mesh;
+    if (meshIndex < 0 || size_t(meshIndex) >= gltf.meshes.size() ||
+        uses.meshes[size_t(meshIndex)] != 1 ||
+        gltf.nodes[nodeIndex].skin >= 0 ||
+        gltf.nodes[nodeIndex].hasExtension<ExtensionExtMeshGpuInstancing>()) {
+      continue;
+    }
+
+    const Mesh& mesh = gltf.meshes[size_t(meshIndex)];
+    std::optional<std::pair<glm::dvec3, glm::dvec3>> bounds =
+        computeQuantizableBounds(gltf, mesh, uses);
+    if (!bounds) {
+      continue;
+    }
+
+    const glm::dvec3& origin = bounds->first;
+    const glm::dvec3 extent = bounds->second - bounds->first;
+    const double largestExtent =
+        glm::max(extent.x, glm::max(extent.y, extent.z));
+    const double scale = largestExtent > 0.0 ? largestExtent / 65535.0 : 1.0;
+
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      const int32_t positionAccessor = findAttribute(primitive, "POSITION");
+      quantizePositions(
+          gltf,
+          positionAccessor,
+          origin,
+          scale,
+          uses.ownsData(gltf, positionAccessor));
+
+      const int32_t normalAccessor = findAttribute(primitive, "NORMAL");
+      if (isFloatVec3(gltf, normalAccessor) &&
+          uses.accessors[size_t(normalAccessor)] == 1) {
+        quantizeNormals(
+            gltf,
+            normalAccessor,
+            uses.ownsData(gltf, normalAccessor));
+      }
+    }
+
+    // The child node's transform converts the quantized positions back, and
+    // doesn't affect the original node's other children.
+    Node& quantizedNode = gltf.nodes.emplace_back();
+    quantizedNode.mesh = meshIndex;
+    quantizedNode.translation = {origin.x, origin.y, origin.z};
+    quantizedNode.scale = {scale, scale, scale};
+
+    gltf.nodes[nodeIndex].mesh = -1;
+    gltf.nodes[nodeIndex].children.emplace_back(
+        int32_t(gltf.nodes.size() - 1));
+    quantizedAny = true;
+  }
+
+  if (quantizedAny) {
+    addExtension(gltf.extensionsUsed);
+    addExtension(gltf.extensionsRequired);
+  }
+
+  return quantizedAny;
+}
+
+/*static*/ void GltfUtilities::dequantizeMeshes(CesiumGltf::Model& gltf) {
+  const UseCounts uses(gltf);
+
+  bool quantizedRemain = false;
+  for (Node& node : gltf.nodes) {
+    if (node.mesh < 0 || size_t(node.mesh) >= gltf.meshes.size()) {
+      continue;
+    }
+
+    const Mesh& mesh = gltf.meshes[size_t(node.mesh)];
+    bool isQuantized = false;
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      const int32_t positionAccessor = findAttribute(primitive, "POSITION");
+      if (positionAccessor >= 0 &&
+          size_t(positionAccessor) < gltf.accessors.size() &&
+          gltf.accessors[size_t(positionAccessor)].componentType !=
+              Accessor::ComponentType::FLOAT) {
+        isQuantized = true;
+      }
+    }
+
+    if (!isQuantized) {
+      continue;
+    }
+
+    const std::vector<double> noRotation = {0, 0, 0, 1};
+    if (uses.meshes[size_t(node.mesh)] != 1 || !node.children.empty() ||
+        !isIdentityMatrix(node.matrix) ||
+        (!node.rotation.empty() && node.rotation != noRotation) ||
+        (!node.translation.empty() && node.translation.size() != 3) ||
+        (!node.scale.empty() && node.scale.size() != 3)) {
+      quantizedRemain = true;
+      continue;
+    }
+
+    const glm::dvec3 translation =
+        node.translation.empty() ? glm::dvec3(0.0)
+                                 : glm::dvec3(
+                                       node.translation[0],
+                                       node.translation[1],
+                                       node.translation[2]);
+    const glm::dvec3 scale =
+        node.scale.empty()
+            ? glm::dvec3(1.0)
+            : glm::dvec3(node.scale[0], node.scale[1], node.scale[2]);
+
+    // Read all the positions first, so that the node is left alone if any
+    // of them can't be read.
+    std::vector<std::vector<glm::vec3>> meshPositions;
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      const int32_t positionAccessor = findAttribute(primitive, "POSITION");
+      std::optional<std::vector<glm::vec3>> positions =
+          readIntegerVec3(gltf, positionAccessor);
+      if (!positions || uses.accessors[size_t(positionAccessor)] != 1) {
+        break;
+      }
+
+      meshPositions.emplace_back(std::move(*positions));
+    }
+
+    if (meshPositions.size() != mesh.primitives.size()) {
+      quantizedRemain = true;
+      continue;
+    }
+
+    for (size_t i = 0; i < mesh.primitives.size(); ++i) {
+      const MeshPrimitive& primitive = mesh.primitives[i];
+      const int32_t positionAccessor = findAttribute(primitive, "POSITION");
+      std::vector<glm::vec3>& positions = meshPositions[i];
+      for (glm::vec3& position : positions) {
+        position = glm::vec3(translation + glm::dvec3(position) * scale);
+      }
+      writeFloatVec3(
+          gltf,
+          positionAccessor,
+          positions,
+          uses.ownsData(gltf, positionAccessor),
+          true);
+
+      const int32_t normalAccessor = findAttribute(primitive, "NORMAL");
+      std::optional<std::vector<glm::vec3>> normals =
+          readIntegerVec3(gltf, normalAccessor);
+      if (normals && uses.accessors[size_t(normalAccessor)] == 1) {
+        for (glm::vec3& normal : *normals) {
+          if (glm::dot(normal, normal) > 0.0f) {
+            normal = glm::normalize(normal);
+          }
+        }
+        writeFloatVec3(
+            gltf,
+            normalAccessor,
+            *normals,
+            uses.ownsData(gltf, normalAccessor),
+            false);
+      }
+    }
+
+    node.translation = {0, 0, 0};
+    node.scale = {1, 1, 1};
+  }
+
+  if (!quantizedRemain) {
+    removeExtension(gltf.extensionsUsed);
+    removeExtension(gltf.extensionsRequired);
+  }
+}
+
+namespace {
+// Finds the box that bounds the positions of all of a mesh's primitives, or
+// nothing if any of them are not floats.
+std::optional<std::pair<glm::dvec3, glm::dvec3>>
+computeMeshBounds(const Model& gltf, const Mesh& mesh) {
+  std::optional<std::pair<glm::dvec3, glm::dvec3>> result;
+  for (const MeshPrimitive& primitive : mesh.primitives) {
+    const AccessorView<glm::vec3> positions(
+        gltf,
+        findAttribute(primitive, "POSITION"));
+    if (positions.status() != AccessorViewStatus::Valid) {
+      return std::nullopt;
+    }
+
+    const std::optional<std::pair<glm::dvec3, glm::dvec3>> box =
+        computePositionBounds(positions, 0, positions.size());
+    if (box && result) {
+      result->first = glm::min(result->first, box->first);
+      result->second = glm::max(result->second, box->second);
+    } else if (box) {
+      result = box;
+    }
+  }
+  return result;
+}
+
+// Splits a range of instances at the median of their translations along the
+// axis in which the range is longest, until no range has more than
+// `maxCount` instances.
+void splitInstances(
+    const std::vector<glm::dmat4>& instances,
+    std::vector<size_t>& order,
+    size_t begin,
+    size_t end,
+    size_t maxCount,
+    std::vector<std::pair<size_t, size_t>>& ranges) {
+  if (end - begin <= maxCount) {
+    ranges.emplace_back(begin, end);
+    return;
+  }
+
+  glm::dvec3 minimum(instances[order[begin]][3]);
+  glm::dvec3 maximum = minimum;
+  for (size_t i = begin + 1; i < end; ++i) {
+    const glm::dvec3 translation(instances[order[i]][3]);
+    minimum = glm::min(minimum, translation);
+    maximum = glm::max(maximum, translation);
+  }
+
+  const glm::dvec3 extent = maximum - minimum;
+  const glm::length_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0
+                             : extent.y >= extent.z                       ? 1
+                                                                          : 2;
+  const size_t middle = begin + (end - begin) / 2;
+  std::nth_element(
+      order.begin() + std::ptrdiff_t(begin),
+      order.begin() + std::ptrdiff_t(middle),
+      order.begin() + std::ptrdiff_t(end),
+      [&instances, axis](size_t a, size_t b) {
+        return instances[a][3][axis] < instances[b][3][axis];
+      });
+
+  splitInstances(instances, order, begin, middle, maxCount, ranges);
+  splitInstances(instances, order, middle, end, maxCount, ranges);
+}
+
+// Copies the elements of an instance attribute in the given order, or
+// returns nothing if the accessor cannot be read.
+std::optional<std::vector<std::byte>> reorderElements(
+    const Model& gltf,
+    int32_t accessorIndex,
+    const std::vector<size_t>& order) {
+  const Accessor* pAccessor = Model::getSafe(&gltf.accessors, accessorIndex);
+  if (!pAccessor || pAccessor->sparse ||
+      pAccessor->count != int64_t(order.size()) || order.empty()) {
+    return std::nullopt;
+  }
+
+  const BufferView* pBufferView =
+      Model::getSafe(&gltf.bufferViews, pAccessor->bufferView);
+  if (!pBufferView) {
+    return std::nullopt;
+  }
+
+  const Buffer* pBuffer = Model::getSafe(&gltf.buffers, pBufferView->buffer);
+  if (!pBuffer) {
+    return std::nullopt;
+  }
+
+  const int64_t elementSize = pAccessor->computeBytesPerVertex();
+  const int64_t stride = pAccessor->computeByteStride(gltf);
+  const int64_t offset = pBufferView->byteOffset + pAccessor->byteOffset;
+  const int64_t lastByte =
+      pAccessor->byteOffset + (pAccessor->count - 1) * stride + elementSize;
+  if (elementSize <= 0 || stride <= 0 || lastByte > pBufferView->byteLength ||
+      pBufferView->byteOffset + lastByte >
+          int64_t(pBuffer->cesium.getData().size())) {
+    return std::nullopt;
+  }
+
+  std::vector<std::byte> result(order.size() * size_t(elementSize));
+  for (size_t i = 0; i < order.size(); ++i) {
+    std::memcpy(
+        result.data() + i * size_t(elementSize),
+        pBuffer->cesium.getData().data() + offset +
+            int64_t(order[i]) * stride,
+        size_t(elementSize));
+  }
+  return result;
+}
+} // namespace
+
+/*static*/ bool GltfUtilities::clusterInstances(
+    CesiumGltf::Model& gltf,
+    uint32_t maxInstancesPerCluster) {
+  if (maxInstancesPerCluster == 0) {
+    return false;
+  }
+
+  int32_t bufferIndex = -1;
+  for (Node& node : gltf.nodes) {
+    ExtensionExtMeshGpuInstancing* pInstancing =
+        node.getExtension<ExtensionExtMeshGpuInstancing>();
+    const Mesh* pMesh = Model::getSafe(&gltf.meshes, node.mesh);
+    if (!pInstancing || !pMesh ||
+        InstanceClusterMetadata::parseFromGltfExtras(node.extras)) {
+      continue;
+    }
+
+    const std::vector<glm::dmat4> instances =
+        getInstanceTransforms(gltf, node);
+    const std::optional<std::pair<glm::dvec3, glm::dvec3>> meshBox =
+        computeMeshBounds(gltf, *pMesh);
+    if (instances.size() <= maxInstancesPerCluster || !meshBox) {
+      continue;
+    }
+
+    std::vector<size_t> order(instances.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::vector<std::pair<size_t, size_t>> ranges;
+    splitInstances(
+        instances,
+        order,
+        0,
+        instances.size(),
+        maxInstancesPerCluster,
+        ranges);
+
+    // Copy the attributes rather than reordering them in place, since they
+    // may be shared with other nodes.
+    std::vector<std::pair<std::string, std::vector<std::byte>>> reordered;
+    for (const auto& [name, accessorIndex] : pInstancing->attributes) {
+      std::optional<std::vector<std::byte>> maybeBytes =
+          reorderElements(gltf, accessorIndex, order);
+      if (!maybeBytes) {
+        break;
+      }
+      reordered.emplace_back(name, std::move(*maybeBytes));
+    }
+    if (reordered.size() != pInstancing->attributes.size()) {
+      continue;
+    }
+
+    if (bufferIndex < 0) {
+      bufferIndex = int32_t(gltf.buffers.size());
+      gltf.buffers.emplace_back();
+    }
+
+    for (const auto& [name, bytes] : reordered) {
+      std::vector<std::byte>& data =
+          gltf.buffers[size_t(bufferIndex)].cesium.data;
+      const size_t byteOffset = (data.size() + 3) / 4 * 4;
+      data.resize(byteOffset + bytes.size());
+      std::memcpy(data.data() + byteOffset, bytes.data(), bytes.size());
+
+      BufferView& bufferView = gltf.bufferViews.emplace_back();
+      bufferView.buffer = bufferIndex;
+      bufferView.byteOffset = int64_t(byteOffset);
+      bufferView.byteLength = int64_t(bytes.size());
+
+      Accessor accessor =
+          gltf.accessors[size_t(pInstancing->attributes.at(name))];
+      accessor.bufferView = int32_t(gltf.bufferViews.size() - 1);
+      accessor.byteOffset = 0;
+      gltf.accessors.emplace_back(std::move(accessor));
+      pInstancing->attributes[name] = int32_t(gltf.accessors.size() - 1);
+    }
+
+    InstanceClusterMetadata metadata;
+    for (const auto& [begin, end] : ranges) {
+      glm::dvec3 minimum(std::numeric_limits<double>::max());
+      glm::dvec3 maximum(std::numeric_limits<double>::lowest());
+      for (size_t i = begin; i < end; ++i) {
+        forEachTransformedCorner(
+            *meshBox,
+            instances[order[i]],
+            [&minimum, &maximum](const glm::dvec3& position) {
+              minimum = glm::min(minimum, position);
+              maximum = glm::max(maximum, position);
+            });
+      }
+
+      metadata.clusters.push_back(InstanceCluster{
+          int64_t(begin),
+          int64_t(end - begin),
+          CesiumGeometry::AxisAlignedBox(
+              minimum.x,
+              minimum.y,
+              minimum.z,
+              maximum.x,
+              maximum.y,
+              maximum.z)});
+    }
+
+    for (const auto& pair :
+         InstanceClusterMetadata::createGltfExtras(metadata)) {
+      node.extras[pair.first] = pair.second;
+    }
+  }
+
+  if (bufferIndex < 0) {
+    return false;
+  }
+
+  Buffer& buffer = gltf.buffers[size_t(bufferIndex)];
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+  return true;
+}
+
+namespace {
+const std::string featureIdAttributePrefix = "_FEATURE_ID_";
+
+/**
+ * @brief The elements of an accessor in its buffer.
+ */
+struct ElementData {
+  const std::byte* pData;
+  int64_t count;
+  int64_t stride;
+  int64_t elementSize;
+};
+
+std::optional<ElementData>
+getElementData(const Model& gltf, int32_t accessorIndex) {
+  const Accessor* pAccessor = Model::getSafe(&gltf.accessors, accessorIndex);
+  if (!pAccessor || pAccessor->sparse || pAccessor->count <= 0) {
+    return std::nullopt;
+  }
+
+  const BufferView* pBufferView =
+      Model::getSafe(&gltf.bufferViews, pAccessor->bufferView);
+  if (!pBufferView) {
+    return std::nullopt;
+  }
+
+  const Buffer* pBuffer = Model::getSafe(&gltf.buffers, pBufferView->buffer);
+  if (!pBuffer) {
+    return std::nullopt;
+  }
+
+  const int64_t elementSize = pAccessor->computeBytesPerVertex();
+  const int64_t stride = pAccessor->computeByteStride(gltf);
+  const int64_t lastByte =
+      pAccessor->byteOffset + (pAccessor->count - 1) * stride + elementSize;
+  if (elementSize <= 0 || stride < elementSize ||
+      lastByte > pBufferView->byteLength ||
+      pBufferView->byteOffset + lastByte >
+          int64_t(pBuffer->cesium.getData().size())) {
+    return std::nullopt;
+  }
+
+  return ElementData{
+      pBuffer->cesium.getData().data() + pBufferView->byteOffset +
+          pAccessor->byteOffset,
+      pAccessor->count,
+      stride,
+      elementSize};
+}
+
+// Keys the attributes of a primitive so that the feature ID attributes of two
+// primitives match when the same feature ID set refers to them, even if they
+// have different names. The other attributes are keyed by their names.
+std::map<std::string, std::string>
+getAttributeKeys(const MeshPrimitive& primitive) {
+  std::map<std::string, std::string> result;
+  std::vector<std::string> featureIdAttributes;
+  const ExtensionExtMeshFeatures* pMeshFeatures =
+      primitive.getExtension<ExtensionExtMeshFeatures>();
+  if (pMeshFeatures) {
+    for (size_t i = 0; i < pMeshFeatures->featureIds.size(); ++i) {
+      const FeatureId& featureId = pMeshFeatures->featureIds[i];
+      if (!featureId.attribute) {
+        continue;
+      }
+
+      const std::string name =
+          featureIdAttributePrefix + std::to_string(*featureId.attribute);
+      if (std::find(
+              featureIdAttributes.begin(),
+              featureIdAttributes.end(),
+              name) == featureIdAttributes.end()) {
+        featureIdAttributes.emplace_back(name);
+        result[ExtensionExtMeshFeatures::ExtensionName + std::to_string(i)] =
+            name;
+      }
+    }
+  }
+
+  for (const auto& attribute : primitive.attributes) {
+    if (std::find(
+            featureIdAttributes.begin(),
+            featureIdAttributes.end(),
+            attribute.first) == featureIdAttributes.end()) {
+      result[attribute.first] = attribute.first;
+    }
+  }
+
+  return result;
+}
+
+// Reads the indices of a primitive, which are the vertices in order if it has
+// none.
+std::optional<std::vector<uint32_t>>
+readIndices(const Model& gltf, const MeshPrimitive& primitive) {
+  const Accessor* pPositions =
+      Model::getSafe(&gltf.accessors, findAttribute(primitive, "POSITION"));
+  if (!pPositions) {
+    return std::nullopt;
+  }
+
+  std::vector<uint32_t> result;
+  if (primitive.indices < 0) {
+    result.resize(size_t(pPositions->count));
+    std::iota(result.begin(), result.end(), uint32_t(0));
+    return result;
+  }
+
+  const Accessor* pIndices = Model::getSafe(&gltf.accessors, primitive.indices);
+  if (!pIndices) {
+    return std::nullopt;
+  }
+
+  auto read = [&result](auto&& indices) {
+    if (indices.status() != AccessorViewStatus::Valid) {
+      return false;
+    }
+    result.resize(size_t(indices.size()));
+    for (int64_t i = 0; i < indices.size(); ++i) {
+      result[size_t(i)] = uint32_t(indices[i]);
+    }
+    return true;
+  };
+
+  bool valid = false;
+  switch (pIndices->componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    valid = read(AccessorView<uint8_t>(gltf, primitive.indices));
+    break;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    valid = read(AccessorView<uint16_t>(gltf, primitive.indices));
+    break;
+  case Accessor::ComponentType::UNSIGNED_INT:
+    valid = read(AccessorView<uint32_t>(gltf, primitive.indices));
+    break;
+  default:
+    break;
+  }
+
+  if (!valid || std::any_of(result.begin(), result.end(), [&](uint32_t i) {
+        return int64_t(i) >= pPositions->count;
+      })) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+// Determines if a primitive's data can be read and concatenated with that of
+// other primitives.
+bool isMergeable(const Model& gltf, const MeshPrimitive& primitive) {
+  if ((primitive.mode != MeshPrimitive::Mode::TRIANGLES &&
+       primitive.mode != MeshPrimitive::Mode::LINES &&
+       primitive.mode != MeshPrimitive::Mode::POINTS) ||
+      !primitive.targets.empty()) {
+    return false;
+  }
+
+  // A decoded Draco extension no longer describes the data once it is merged.
+  for (const auto& extension : primitive.extensions) {
+    if (extension.first != ExtensionExtMeshFeatures::ExtensionName &&
+        extension.first != ExtensionKhrDracoMeshCompression::ExtensionName) {
+      return false;
+    }
+  }
+
+  // Implicit feature IDs are the indices of the vertices, which change.
+  const ExtensionExtMeshFeatures* pMeshFeatures =
+      primitive.getExtension<ExtensionExtMeshFeatures>();
+  if (pMeshFeatures) {
+    for (const FeatureId& featureId : pMeshFeatures->featureIds) {
+      if (!featureId.attribute && !featureId.texture) {
+        return false;
+      }
+      if (featureId.attribute &&
+          findAttribute(
+              primitive,
+              featureIdAttributePrefix +
+                  std::to_string(*featureId.attribute)) < 0) {
+        return false;
+      }
+    }
+  }
+
+  const Accessor* pPositions =
+      Model::getSafe(&gltf.accessors, findAttribute(primitive, "POSITION"));
+  if (!pPositions) {
+    return false;
+  }
+
+  for (const auto& attribute : primitive.attributes) {
+    const std::optional<ElementData> maybeData =
+        getElementData(gltf, attribute.second);
+    if (!maybeData || maybeData->count != pPositions->count) {
+      return false;
+    }
+  }
+
+  return readIndices(gltf, primitive).has_value();
+}
+
+bool haveSameFeatureIds(const MeshPrimitive& a, const MeshPrimitive& b) {
+  const ExtensionExtMeshFeatures* pA =
+      a.getExtension<ExtensionExtMeshFeatures>();
+  const ExtensionExtMeshFeatures* pB =
+      b.getExtension<ExtensionExtMeshFeatures>();
+  if (!pA || !pB) {
+    return !pA && !pB;
+  }
+
+  if (pA->featureIds.size() != pB->featureIds.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < pA->featureIds.size(); ++i) {
+    const FeatureId& featureIdA = pA->featureIds[i];
+    const FeatureId& featureIdB = pB->featureIds[i];
+    if (featureIdA.nullFeatureId != featureIdB.nullFeatureId ||
+        featureIdA.label != featureIdB.label ||
+        featureIdA.propertyTable != featureIdB.propertyTable ||
+        featureIdA.attribute.has_value() != featureIdB.attribute.has_value() ||
+        featureIdA.texture.has_value() != featureIdB.texture.has_value()) {
+      return false;
+    }
+
+    if (featureIdA.texture &&
+        (featureIdA.texture->index != featureIdB.texture->index ||
+         featureIdA.texture->texCoord != featureIdB.texture->texCoord ||
+         featureIdA.texture->channels != featureIdB.texture->channels)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool canMerge(
+    const Model& gltf,
+    const MeshPrimitive& a,
+    const MeshPrimitive& b) {
+  if (a.material != b.material || a.mode != b.mode ||
+      !haveSameFeatureIds(a, b)) {
+    return false;
+  }
+
+  const std::map<std::string, std::string> keysA = getAttributeKeys(a);
+  const std::map<std::string, std::string> keysB = getAttributeKeys(b);
+  if (keysA.size() != keysB.size()) {
+    return false;
+  }
+
+  for (const auto& [key, name] : keysA) {
+    auto it = keysB.find(key);
+    if (it == keysB.end()) {
+      return false;
+    }
+
+    const Accessor& accessorA =
+        gltf.accessors[size_t(a.attributes.at(name))];
+    const Accessor& accessorB =
+        gltf.accessors[size_t(b.attributes.at(it->second))];
+    if (accessorA.type != accessorB.type ||
+        accessorA.componentType != accessorB.componentType ||
+        accessorA.normalized != accessorB.normalized) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int64_t readFeatureId(const std::byte* pData, int32_t componentType) {
+  switch (componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE: {
+    uint8_t value;
+    std::memcpy(&value, pData, sizeof(value));
+    return value;
+  }
+  case Accessor::ComponentType::UNSIGNED_SHORT: {
+    uint16_t value;
+    std::memcpy(&value, pData, sizeof(value));
+    return value;
+  }
+  case Accessor::ComponentType::UNSIGNED_INT: {
+    uint32_t value;
+    std::memcpy(&value, pData, sizeof(value));
+    return value;
+  }
+  case Accessor::ComponentType::FLOAT: {
+    float value;
+    std::memcpy(&value, pData, sizeof(value));
+    return int64_t(value);
+  }
+  default:
+    return -1;
+  }
+}
+
+// Appends data to a buffer, at an offset that is a multiple of 4 bytes, and
+// adds a bufferView for it.
+int32_t addBufferView(
+    Model& gltf,
+    int32_t bufferIndex,
+    const std::vector<std::byte>& bytes,
+    std::optional<int64_t> byteStride,
+    int32_t target) {
+  std::vector<std::byte>& data = gltf.buffers[size_t(bufferIndex)].cesium.data;
+  const size_t byteOffset = (data.size() + 3) / 4 * 4;
+  data.resize(byteOffset + bytes.size());
+  std::memcpy(data.data() + byteOffset, bytes.data(), bytes.size());
+
+  BufferView& bufferView = gltf.bufferViews.emplace_back();
+  bufferView.buffer = bufferIndex;
+  bufferView.byteOffset = int64_t(byteOffset);
+  bufferView.byteLength = int64_t(bytes.size());
+  bufferView.byteStride = byteStride;
+  bufferView.target = target;
+  return int32_t(gltf.bufferViews.size() - 1);
+}
+
+// Concatenates the vertices and indices of a group of primitives into a new
+// primitive, whose data is appended to the given buffer.
+MeshPrimitive mergeGroup(
+    Model& gltf,
+    const std::vector<const MeshPrimitive*>& group,
+    int32_t bufferIndex) {
+  const MeshPrimitive& first = *group.front();
+  MeshPrimitive merged = first;
+  merged.attributes.clear();
+  merged.extensions.erase(ExtensionKhrDracoMeshCompression::ExtensionName);
+
+  std::vector<std::map<std::string, std::string>> keys;
+  std::vector<int64_t> vertexOffsets;
+  int64_t vertexCount = 0;
+  for (const MeshPrimitive* pPrimitive : group) {
+    keys.emplace_back(getAttributeKeys(*pPrimitive));
+    vertexOffsets.emplace_back(vertexCount);
+    vertexCount +=
+        gltf.accessors[size_t(findAttribute(*pPrimitive, "POSITION"))].count;
+  }
+
+  std::map<std::string, int32_t> mergedFeatureIdAccessors;
+  for (const auto& [key, name] : keys.front()) {
+    Accessor accessor = gltf.accessors[size_t(first.attributes.at(name))];
+    const int64_t elementSize = accessor.computeBytesPerVertex();
+
+    // Vertex attributes must be aligned to 4 bytes.
+    const int64_t stride = (elementSize + 3) / 4 * 4;
+    std::vector<std::byte> bytes(size_t(vertexCount * stride));
+
+    bool hasBounds = true;
+    for (size_t i = 0; i < group.size(); ++i) {
+      const int32_t accessorIndex =
+          group[i]->attributes.at(keys[i].at(key));
+      const ElementData data = *getElementData(gltf, accessorIndex);
+      for (int64_t j = 0; j < data.count; ++j) {
+        std::memcpy(
+            bytes.data() + (vertexOffsets[i] + j) * stride,
+            data.pData + j * data.stride,
+            size_t(elementSize));
+      }
+
+      const Accessor& source = gltf.accessors[size_t(accessorIndex)];
+      if (source.min.size() != accessor.min.size() ||
+          source.max.size() != accessor.max.size() || accessor.min.empty()) {
+        hasBounds = false;
+        continue;
+      }
+      for (size_t k = 0; k < accessor.min.size(); ++k) {
+        accessor.min[k] = std::min(accessor.min[k], source.min[k]);
+        accessor.max[k] = std::max(accessor.max[k], source.max[k]);
+      }
+    }
+
+    if (!hasBounds) {
+      accessor.min.clear();
+      accessor.max.clear();
+    }
+
+    accessor.bufferView = addBufferView(
+        gltf,
+        bufferIndex,
+        bytes,
+        stride,
+        BufferView::Target::ARRAY_BUFFER);
+    accessor.byteOffset = 0;
+    accessor.count = vertexCount;
+    gltf.accessors.emplace_back(std::move(accessor));
+    const int32_t mergedIndex = int32_t(gltf.accessors.size() - 1);
+    merged.attributes[name] = mergedIndex;
+    if (key != name) {
+      mergedFeatureIdAccessors[name] = mergedIndex;
+    }
+  }
+
+  // If any of the primitives have indices, the others are given the indices
+  // of their vertices in order.
+  const bool hasIndices =
+      std::any_of(group.begin(), group.end(), [](const MeshPrimitive* p) {
+        return p->indices >= 0;
+      });
+  if (hasIndices) {
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < group.size(); ++i) {
+      const std::vector<uint32_t> primitiveIndices =
+          *readIndices(gltf, *group[i]);
+      for (uint32_t index : primitiveIndices) {
+        indices.emplace_back(index + uint32_t(vertexOffsets[i]));
+      }
+    }
+
+    Accessor accessor;
+    accessor.type = Accessor::Type::SCALAR;
+    accessor.count = int64_t(indices.size());
+    std::vector<std::byte> bytes;
+    if (vertexCount < int64_t(std::numeric_limits<uint16_t>::max())) {
+      accessor.componentType = Accessor::ComponentType::UNSIGNED_SHORT;
+      bytes.resize(indices.size() * sizeof(uint16_t));
+      for (size_t i = 0; i < indices.size(); ++i) {
+        const uint16_t index = uint16_t(indices[i]);
+        std::memcpy(bytes.data() + i * sizeof(index), &index, sizeof(index));
+      }
+    } else {
+      accessor.componentType = Accessor::ComponentType::UNSIGNED_INT;
+      bytes.resize(indices.size() * sizeof(uint32_t));
+      std::memcpy(bytes.data(), indices.data(), bytes.size());
+    }
+
+    accessor.bufferView = addBufferView(
+        gltf,
+        bufferIndex,
+        bytes,
+        std::nullopt,
+        BufferView::Target::ELEMENT_ARRAY_BUFFER);
+    gltf.accessors.emplace_back(std::move(accessor));
+    merged.indices = int32_t(gltf.accessors.size() - 1);
+  } else {
+    merged.indices = -1;
+  }
+
+  // The feature IDs of each primitive still refer to the same rows of the
+  // property tables, but the number of distinct features has changed.
+  ExtensionExtMeshFeatures* pMeshFeatures =
+      merged.getExtension<ExtensionExtMeshFeatures>();
+  if (pMeshFeatures) {
+    for (size_t i = 0; i < pMeshFeatures->featureIds.size(); ++i) {
+      FeatureId& featureId = pMeshFeatures->featureIds[i];
+      if (featureId.texture) {
+        for (const MeshPrimitive* pPrimitive : group) {
+          featureId.featureCount = std::max(
+              featureId.featureCount,
+              pPrimitive->getExtension<ExtensionExtMeshFeatures>()
+                  ->featureIds[i]
+                  .featureCount);
+        }
+        continue;
+      }
+
+      const int32_t accessorIndex = mergedFeatureIdAccessors.at(
+          featureIdAttributePrefix + std::to_string(*featureId.attribute));
+      const Accessor& accessor = gltf.accessors[size_t(accessorIndex)];
+      const ElementData data = *getElementData(gltf, accessorIndex);
+      std::unordered_set<int64_t> features;
+      for (int64_t j = 0; j < data.count; ++j) {
+        const int64_t feature =
+            readFeatureId(data.pData + j * data.stride, accessor.componentType);
+        if (feature != featureId.nullFeatureId) {
+          features.insert(feature);
+        }
+      }
+      featureId.featureCount = int64_t(features.size());
+    }
+  }
+
+  return merged;
+}
+} // namespace
+
+/*static*/ bool GltfUtilities::mergePrimitives(CesiumGltf::Model& gltf) {
+  int32_t bufferIndex = -1;
+  for (Mesh& mesh : gltf.meshes) {
+    // Each primitive joins the first group that it can be merged with.
+    std::vector<std::vector<const MeshPrimitive*>> groups;
+    std::vector<bool> mergeableGroups;
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      const bool mergeable = isMergeable(gltf, primitive);
+      size_t groupIndex = 0;
+      while (mergeable && groupIndex < groups.size() &&
+             !(mergeableGroups[groupIndex] &&
+               canMerge(gltf, *groups[groupIndex].front(), primitive))) {
+        ++groupIndex;
+      }
+
+      if (!mergeable || groupIndex == groups.size()) {
+        groupIndex = groups.size();
+        groups.emplace_back();
+        mergeableGroups.emplace_back(mergeable);
+      }
+      groups[groupIndex].emplace_back(&primitive);
+    }
+
+    if (groups.size() == mesh.primitives.size()) {
+      continue;
+    }
+
+    if (bufferIndex < 0) {
+      bufferIndex = int32_t(gltf.buffers.size());
+      gltf.buffers.emplace_back();
+    }
+
+    std::vector<MeshPrimitive> primitives;
+    primitives.reserve(groups.size());
+    for (const std::vector<const MeshPrimitive*>& group : groups) {
+      if (group.size() == 1) {
+        primitives.emplace_back(*group.front());
+      } else {
+        primitives.emplace_back(mergeGroup(gltf, group, bufferIndex));
+      }
+    }
+    mesh.primitives = std::move(primitives);
+  }
+
+  if (bufferIndex < 0) {
+    return false;
+  }
+
+  Buffer& buffer = gltf.buffers[size_t(bufferIndex)];
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+  return true;
+}
+
 } // namespace CesiumGltfContent
@@ -1,16 +1,278 @@
 #include <CesiumGltf/ImageCesium.h>
 #include <CesiumGltfContent/ImageManipulation.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <vector>
 
+namespace {
+
+// stb_image_resize allocates a single block of scratch memory for each resize
+// and frees it when the resize is done. Each thread keeps the largest block it
+// has needed and reuses it, so that resizing many images, such as the raster
+// overlay images that are combined for each geometry tile, does not allocate
+// each time.
+void* allocateResizeScratch(size_t size) {
+  thread_local std::vector<std::max_align_t> scratch;
+  const size_t count =
+      (size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+  if (scratch.size() < count) {
+    scratch.resize(count);
+  }
+  return scratch.data();
+}
+
+} // namespace
+
+#define STBIR_MALLOC(size, context)                                            \
+  ((void)(context), allocateResizeScratch(size))
+#define STBIR_FREE(pointer, context) ((void)(context), (void)(pointer))
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 #include <stb_image_resize.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
 
 namespace CesiumGltfContent {
 
+namespace {
+
+// The two source pixels that a target pixel of a bilinear resize lies between
+// along one axis, and the weight of the second one, out of 256.
+struct BilinearTap {
+  size_t first;
+  size_t second;
+  uint32_t weight;
+};
+
+std::vector<BilinearTap>
+computeBilinearTaps(size_t sourceSize, size_t targetSize) {
+  std::vector<BilinearTap> taps(targetSize);
+  const double scale = double(sourceSize) / double(targetSize);
+  for (size_t i = 0; i < targetSize; ++i) {
+    // Line up the pixel centers of the source and target, and clamp to the
+    // edge pixels.
+    const double position = std::max((double(i) + 0.5) * scale - 0.5, 0.0);
+    const size_t first = std::min(size_t(position), sourceSize - 1);
+    const size_t second = std::min(first + 1, sourceSize - 1);
+    taps[i] = {
+        first,
+        second,
+        uint32_t(std::lround((position - double(first)) * 256.0))};
+  }
+  return taps;
+}
+
+// Enlarges 8-bit pixels with bilinear filtering, in fixed point. The source
+// rows are blended into one row of 16-bit values for each target row, and
+// that row is then expanded horizontally. The blend has no dependencies
+// between iterations, and the channel count is fixed, so compilers vectorize
+// and unroll the loops without any platform-specific code.
+template <size_t Channels>
+void upsampleBilinear(
+    std::byte* pTarget,
+    size_t targetRowStride,
+    size_t targetWidth,
+    size_t targetHeight,
+    const std::byte* pSource,
+    size_t sourceRowStride,
+    size_t sourceWidth,
+    size_t sourceHeight) {
+  const std::vector<BilinearTap> columns =
+      computeBilinearTaps(sourceWidth, targetWidth);
+  const std::vector<BilinearTap> rows =
+      computeBilinearTaps(sourceHeight, targetHeight);
+
+  const size_t blendedSize = sourceWidth * Channels;
+  std::vector<uint16_t> blended(blendedSize);
+  for (size_t j = 0; j < targetHeight; ++j) {
+    const BilinearTap& row = rows[j];
+    const uint8_t* pFirst =
+        reinterpret_cast<const uint8_t*>(pSource + row.first * sourceRowStride);
+    const uint8_t* pSecond = reinterpret_cast<const uint8_t*>(
+        pSource + row.second * sourceRowStride);
+    const uint32_t firstWeight = 256 - row.weight;
+    const uint32_t secondWeight = row.weight;
+    for (size_t i = 0; i < blendedSize; ++i) {
+      blended[i] = uint16_t(
+          uint32_t(pFirst[i]) * firstWeight +
+          uint32_t(pSecond[i]) * secondWeight);
+    }
+
+    uint8_t* pTargetRow =
+        reinterpret_cast<uint8_t*>(pTarget + j * targetRowStride);
+    for (size_t i = 0; i < targetWidth; ++i) {
+      const BilinearTap& column = columns[i];
+      const uint16_t* pLeft = blended.data() + column.first * Channels;
+      const uint16_t* pRight = blended.data() + column.second * Channels;
+      const uint32_t leftWeight = 256 - column.weight;
+      const uint32_t rightWeight = column.weight;
+      uint8_t* pPixel = pTargetRow + i * Channels;
+      for (size_t k = 0; k < Channels; ++k) {
+        // The weights of both passes add up to 65536, so round and shift.
+        pPixel[k] = uint8_t(
+            (uint32_t(pLeft[k]) * leftWeight +
+             uint32_t(pRight[k]) * rightWeight + 32768) >>
+            16);
+      }
+    }
+  }
+}
+
+// Shrinks 8-bit pixels by integer factors, averaging each block of source
+// pixels. Like upsampleBilinear, the source rows of each block are summed
+// into one row first so that the summing loop vectorizes.
+template <size_t Channels>
+void downsampleBox(
+    std::byte* pTarget,
+    size_t targetRowStride,
+    size_t targetWidth,
+    size_t targetHeight,
+    const std::byte* pSource,
+    size_t sourceRowStride,
+    size_t factorX,
+    size_t factorY) {
+  const size_t sumsSize = targetWidth * factorX * Channels;
+  const uint32_t count = uint32_t(factorX * factorY);
+  std::vector<uint32_t> sums(sumsSize);
+  for (size_t j = 0; j < targetHeight; ++j) {
+    std::fill(sums.begin(), sums.end(), 0U);
+    for (size_t r = 0; r < factorY; ++r) {
+      const uint8_t* pSourceRow = reinterpret_cast<const uint8_t*>(
+          pSource + (j * factorY + r) * sourceRowStride);
+      for (size_t i = 0; i < sumsSize; ++i) {
+        sums[i] += uint32_t(pSourceRow[i]);
+      }
+    }
+
+    uint8_t* pTargetRow =
+        reinterpret_cast<uint8_t*>(pTarget + j * targetRowStride);
+    for (size_t i = 0; i < targetWidth; ++i) {
+      const uint32_t* pBlock = sums.data() + i * factorX * Channels;
+      uint8_t* pPixel = pTargetRow + i * Channels;
+      for (size_t k = 0; k < Channels; ++k) {
+        uint32_t sum = 0;
+        for (size_t s = 0; s < factorX; ++s) {
+          sum += pBlock[s * Channels + k];
+        }
+        pPixel[k] = uint8_t((sum + count / 2) / count);
+      }
+    }
+  }
+}
+
+// Resizes 8-bit pixels when the target is an integer multiple or an integer
+// fraction of the source along both axes, as when raster overlay tiles of
+// neighboring levels are combined, and returns false for any other sizes.
+template <size_t Channels>
+bool resizeByIntegerFactors(
+    std::byte* pTarget,
+    size_t targetRowStride,
+    size_t targetWidth,
+    size_t targetHeight,
+    const std::byte* pSource,
+    size_t sourceRowStride,
+    size_t sourceWidth,
+    size_t sourceHeight) {
+  if (sourceWidth == 0 || sourceHeight == 0 || targetWidth == 0 ||
+      targetHeight == 0) {
+    return false;
+  }
+
+  if (targetWidth >= sourceWidth && targetHeight >= sourceHeight &&
+      targetWidth % sourceWidth == 0 && targetHeight % sourceHeight == 0) {
+    upsampleBilinear<Channels>(
+        pTarget,
+        targetRowStride,
+        targetWidth,
+        targetHeight,
+        pSource,
+        sourceRowStride,
+        sourceWidth,
+        sourceHeight);
+    return true;
+  }
+
+  if (targetWidth <= sourceWidth && targetHeight <= sourceHeight &&
+      sourceWidth % targetWidth == 0 && sourceHeight % targetHeight == 0) {
+    downsampleBox<Channels>(
+        pTarget,
+        targetRowStride,
+        targetWidth,
+        targetHeight,
+        pSource,
+        sourceRowStride,
+        sourceWidth / targetWidth,
+        sourceHeight / targetHeight);
+    return true;
+  }
+
+  return false;
+}
+
+bool resizeByIntegerFactors(
+    int32_t channels,
+    std::byte* pTarget,
+    size_t targetRowStride,
+    size_t targetWidth,
+    size_t targetHeight,
+    const std::byte* pSource,
+    size_t sourceRowStride,
+    size_t sourceWidth,
+    size_t sourceHeight) {
+  switch (channels) {
+  case 1:
+    return resizeByIntegerFactors<1>(
+        pTarget,
+        targetRowStride,
+        targetWidth,
+        targetHeight,
+        pSource,
+        sourceRowStride,
+        sourceWidth,
+        sourceHeight);
+  case 2:
+    return resizeByIntegerFactors<2>(
+        pTarget,
+        targetRowStride,
+        targetWidth,
+        targetHeight,
+        pSource,
+        sourceRowStride,
+        sourceWidth,
+        sourceHeight);
+  case 3:
+    return resizeByIntegerFactors<3>(
+        pTarget,
+        targetRowStride,
+        targetWidth,
+        targetHeight,
+        pSource,
+        sourceRowStride,
+        sourceWidth,
+        sourceHeight);
+  case 4:
+    return resizeByIntegerFactors<4>(
+        pTarget,
+        targetRowStride,
+        targetWidth,
+        targetHeight,
+        pSource,
+        sourceRowStride,
+        sourceWidth,
+        sourceHeight);
+  default:
+    return false;
+  }
+}
+
+} // namespace
+
 void ImageManipulation::unsafeBlitImage(
     std::byte* pTarget,
     size_t targetRowStride,
@@ -100,6 +362,19 @@ bool ImageManipulation::blitImage(
       return false;
     }
 
+    if (resizeByIntegerFactors(
+            target.channels,
+            pTarget,
+            bytesPerTargetRow,
+            size_t(targetPixels.width),
+            size_t(targetPixels.height),
+            pSource,
+            bytesPerSourceRow,
+            size_t(sourcePixels.width),
+            size_t(sourcePixels.height))) {
+      return true;
+    }
+
     // Use STB to do the copy / scale
     stbir_resize_uint8(
         reinterpret_cast<const unsigned char*>(pSource),
@@ -151,4 +426,178 @@ ImageManipulation::savePng(const CesiumGltf::ImageCesium& image) {
   return result;
 }
 
+/*static*/ bool ImageManipulation::truncateChannels(
+    CesiumGltf::ImageCesium& image,
+    int32_t channels) {
+  if (image.compressedPixelFormat !=
+          CesiumGltf::GpuCompressedPixelFormat::NONE ||
+      channels < 1 || channels > image.channels) {
+    return false;
+  }
+
+  if (channels == image.channels) {
+    return true;
+  }
+
+  // Each pixel, and each mip level, shrinks by the same ratio, so the pixels
+  // can be compacted in place from the front.
+  const size_t oldPixelSize = size_t(image.channels * image.bytesPerChannel);
+  const size_t newPixelSize = size_t(channels * image.bytesPerChannel);
+  const size_t pixelCount = image.pixelData.size() / oldPixelSize;
+  std::byte* pPixels = image.pixelData.data();
+  for (size_t i = 0; i < pixelCount; ++i) {
+    std::memmove(
+        pPixels + i * newPixelSize,
+        pPixels + i * oldPixelSize,
+        newPixelSize);
+  }
+  image.pixelData.resize(pixelCount * newPixelSize);
+  image.pixelData.shrink_to_fit();
+
+  for (CesiumGltf::ImageCesiumMipPosition& mip : image.mipPositions) {
+    mip.byteOffset = mip.byteOffset / oldPixelSize * newPixelSize;
+    mip.byteSize = mip.byteSize / oldPixelSize * newPixelSize;
+  }
+
+  image.channels = channels;
+  return true;
+}
+
+namespace {
+// Gets the number of bytes in each 4x4 block of a supported compressed format,
+// or 0 if the format can't encode images with the given number of channels.
+size_t getCompressedBlockSize(
+    CesiumGltf::GpuCompressedPixelFormat format,
+    int32_t channels) noexcept {
+  using CesiumGltf::GpuCompressedPixelFormat;
+  switch (format) {
+  case GpuCompressedPixelFormat::BC1_RGB:
+    return channels == 3 || channels == 4 ? 8 : 0;
+  case GpuCompressedPixelFormat::BC3_RGBA:
+    return channels == 4 ? 16 : 0;
+  case GpuCompressedPixelFormat::BC4_R:
+    return channels == 1 ? 8 : 0;
+  case GpuCompressedPixelFormat::BC5_RG:
+    return channels == 2 ? 16 : 0;
+  default:
+    return 0;
+  }
+}
+
+void compressBlock(
+    CesiumGltf::GpuCompressedPixelFormat format,
+    const std::byte* pLevel,
+    size_t width,
+    size_t height,
+    size_t channels,
+    size_t blockX,
+    size_t blockY,
+    std::byte* pBlock) {
+  // Gather the block's pixels in the layout that stb_dxt expects: RGBA for
+  // BC1 and BC3, and the channels as they are for BC4 and BC5. Pixels past
+  // the edges of the level repeat the last row and column.
+  const size_t blockChannels =
+      format == CesiumGltf::GpuCompressedPixelFormat::BC1_RGB ||
+              format == CesiumGltf::GpuCompressedPixelFormat::BC3_RGBA
+          ? 4
+          : channels;
+  const size_t copiedChannels = std::min(channels, blockChannels);
+  unsigned char pixels[16 * 4];
+  std::memset(pixels, 0xff, sizeof(pixels));
+  for (size_t y = 0; y < 4; ++y) {
+    const size_t sourceY = std::min(blockY * 4 + y, height - 1);
+    for (size_t x = 0; x < 4; ++x) {
+      const size_t sourceX = std::min(blockX * 4 + x, width - 1);
+      const std::byte* pSource =
+          pLevel + (sourceY * width + sourceX) * channels;
+      unsigned char* pPixel = pixels + (y * 4 + x) * blockChannels;
+      for (size_t k = 0; k < copiedChannels; ++k) {
+        pPixel[k] = static_cast<unsigned char>(pSource[k]);
+      }
+    }
+  }
+
+  unsigned char* pDestination = reinterpret_cast<unsigned char*>(pBlock);
+  switch (format) {
+  case CesiumGltf::GpuCompressedPixelFormat::BC1_RGB:
+    stb_compress_dxt_block(pDestination, pixels, 0, STB_DXT_NORMAL);
+    break;
+  case CesiumGltf::GpuCompressedPixelFormat::BC3_RGBA:
+    stb_compress_dxt_block(pDestination, pixels, 1, STB_DXT_NORMAL);
+    break;
+  case CesiumGltf::GpuCompressedPixelFormat::BC4_R:
+    stb_compress_bc4_block(pDestination, pixels);
+    break;
+  case CesiumGltf::GpuCompressedPixelFormat::BC5_RG:
+    stb_compress_bc5_block(pDestination, pixels);
+    break;
+  default:
+    break;
+  }
+}
+} // namespace
+
+/*static*/ bool ImageManipulation::compressImage(
+    CesiumGltf::ImageCesium& image,
+    CesiumGltf::GpuCompressedPixelFormat format) {
+  const size_t blockSize = getCompressedBlockSize(format, image.channels);
+  if (blockSize == 0 ||
+      image.compressedPixelFormat !=
+          CesiumGltf::GpuCompressedPixelFormat::NONE ||
+      image.bytesPerChannel != 1 || image.width <= 0 || image.height <= 0) {
+    return false;
+  }
+
+  // An image without mipmaps is a single level that covers all the pixels.
+  const size_t channels = size_t(image.channels);
+  std::vector<CesiumGltf::ImageCesiumMipPosition> levels = image.mipPositions;
+  if (levels.empty()) {
+    levels.push_back(
+        {0, size_t(image.width) * size_t(image.height) * channels});
+  }
+
+  std::vector<std::byte> compressed;
+  std::vector<CesiumGltf::ImageCesiumMipPosition> compressedLevels;
+  compressedLevels.reserve(levels.size());
+  for (size_t i = 0; i < levels.size(); ++i) {
+    const size_t width = std::max(size_t(image.width) >> i, size_t(1));
+    const size_t height = std::max(size_t(image.height) >> i, size_t(1));
+    const CesiumGltf::ImageCesiumMipPosition& level = levels[i];
+    if (level.byteSize < width * height * channels ||
+        level.byteOffset + level.byteSize > image.pixelData.size()) {
+      return false;
+    }
+
+    const size_t blocksX = (width + 3) / 4;
+    const size_t blocksY = (height + 3) / 4;
+    const size_t byteOffset = compressed.size();
+    const size_t byteSize = blocksX * blocksY * blockSize;
+    compressed.resize(byteOffset + byteSize);
+    compressedLevels.push_back({byteOffset, byteSize});
+
+    const std::byte* pLevel = image.pixelData.data() + level.byteOffset;
+    for (size_t blockY = 0; blockY < blocksY; ++blockY) {
+      for (size_t blockX = 0; blockX < blocksX; ++blockX) {
+        compressBlock(
+            format,
+            pLevel,
+            width,
+            height,
+            channels,
+            blockX,
+            blockY,
+            compressed.data() + byteOffset +
+                (blockY * blocksX + blockX) * blockSize);
+      }
+    }
+  }
+
+  if (!image.mipPositions.empty()) {
+    image.mipPositions = std::move(compressedLevels);
+  }
+  image.pixelData = std::move(compressed);
+  image.compressedPixelFormat = format;
+  return true;
+}
+
 } // namespace CesiumGltfContent
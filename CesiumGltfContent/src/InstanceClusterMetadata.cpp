@@ -0,0 +1,89 @@
+#include <CesiumGltfContent/InstanceClusterMetadata.h>
+#include <CesiumUtility/JsonValue.h>
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace CesiumUtility;
+
+namespace CesiumGltfContent {
+namespace {
+std::optional<glm::dvec3>
+getVec3(const JsonValue& cluster, const std::string& key) {
+  const auto* pArray = cluster.getValuePtrForKey<JsonValue::Array>(key);
+  if (!pArray || pArray->size() != 3 || !(*pArray)[0].isNumber() ||
+      !(*pArray)[1].isNumber() || !(*pArray)[2].isNumber()) {
+    return std::nullopt;
+  }
+
+  return glm::dvec3(
+      (*pArray)[0].getSafeNumberOrDefault<double>(0.0),
+      (*pArray)[1].getSafeNumberOrDefault<double>(0.0),
+      (*pArray)[2].getSafeNumberOrDefault<double>(0.0));
+}
+} // namespace
+
+std::optional<InstanceClusterMetadata>
+InstanceClusterMetadata::parseFromGltfExtras(const JsonValue::Object& extras) {
+  auto clustersIt = extras.find("instanceClusters");
+  if (clustersIt == extras.end() || !clustersIt->second.isArray()) {
+    return std::nullopt;
+  }
+
+  InstanceClusterMetadata metadata;
+  for (const JsonValue& cluster : clustersIt->second.getArray()) {
+    if (!cluster.isObject()) {
+      return std::nullopt;
+    }
+
+    const int64_t firstInstance =
+        cluster.getSafeNumericalValueOrDefaultForKey<int64_t>(
+            "firstInstance",
+            -1);
+    const int64_t instanceCount =
+        cluster.getSafeNumericalValueOrDefaultForKey<int64_t>(
+            "instanceCount",
+            -1);
+    const std::optional<glm::dvec3> minimum = getVec3(cluster, "minimum");
+    const std::optional<glm::dvec3> maximum = getVec3(cluster, "maximum");
+    if (firstInstance < 0 || instanceCount < 0 || !minimum || !maximum) {
+      return std::nullopt;
+    }
+
+    metadata.clusters.push_back(InstanceCluster{
+        firstInstance,
+        instanceCount,
+        CesiumGeometry::AxisAlignedBox(
+            minimum->x,
+            minimum->y,
+            minimum->z,
+            maximum->x,
+            maximum->y,
+            maximum->z)});
+  }
+
+  return metadata;
+}
+
+JsonValue::Object InstanceClusterMetadata::createGltfExtras(
+    const InstanceClusterMetadata& metadata) {
+  JsonValue::Array clusters;
+  clusters.reserve(metadata.clusters.size());
+  for (const InstanceCluster& cluster : metadata.clusters) {
+    const CesiumGeometry::AxisAlignedBox& box = cluster.boundingBox;
+    clusters.emplace_back(JsonValue::Object{
+        {"firstInstance", cluster.firstInstance},
+        {"instanceCount", cluster.instanceCount},
+        {"minimum", JsonValue::Array{box.minimumX, box.minimumY, box.minimumZ}},
+        {"maximum",
+         JsonValue::Array{box.maximumX, box.maximumY, box.maximumZ}}});
+  }
+
+  return {{"instanceClusters", std::move(clusters)}};
+}
+} // namespace CesiumGltfContent
@@ -0,0 +1,379 @@
+#include <CesiumGeometry/Axis.h>
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/ExtensionExtMeshFeatures.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+#include <CesiumGltfContent/InstanceClusterMetadata.h>
+
+#include <catch2/catch.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+
+namespace {
+int32_t addVec3Accessor(Model& model, const std::vector<glm::vec3>& values) {
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(values.size() * sizeof(glm::vec3));
+  std::memcpy(
+      buffer.cesium.data.data(),
+      values.data(),
+      buffer.cesium.data.size());
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = int32_t(model.buffers.size() - 1);
+  bufferView.byteLength = buffer.byteLength;
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = int32_t(model.bufferViews.size() - 1);
+  accessor.componentType = Accessor::ComponentType::FLOAT;
+  accessor.type = Accessor::Type::VEC3;
+  accessor.count = int64_t(values.size());
+  return int32_t(model.accessors.size() - 1);
+}
+
+template <typename T>
+int32_t addScalarAccessor(
+    Model& model,
+    const std::vector<T>& values,
+    int32_t componentType) {
+  const int32_t accessor = addVec3Accessor(model, {});
+  Buffer& buffer = model.buffers.back();
+  buffer.cesium.data.resize(values.size() * sizeof(T));
+  std::memcpy(
+      buffer.cesium.data.data(),
+      values.data(),
+      buffer.cesium.data.size());
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+  model.bufferViews.back().byteLength = buffer.byteLength;
+
+  model.accessors.back().componentType = componentType;
+  model.accessors.back().type = Accessor::Type::SCALAR;
+  model.accessors.back().count = int64_t(values.size());
+  return accessor;
+}
+
+Model createModel(
+    const std::vector<glm::vec3>& positions,
+    const std::vector<glm::vec3>& normals) {
+  Model model;
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = addVec3Accessor(model, positions);
+  primitive.attributes["NORMAL"] = addVec3Accessor(model, normals);
+
+  Node& node = model.nodes.emplace_back();
+  node.mesh = 0;
+  model.scenes.emplace_back().nodes.emplace_back(0);
+  model.scene = 0;
+  return model;
+}
+
+std::vector<glm::vec3> transformedPositions(const Model& model) {
+  std::vector<glm::vec3> result;
+  model.forEachPrimitiveInScene(
+      -1,
+      [&result](
+          const Model& gltf,
+          const Node& /*node*/,
+          const Mesh& /*mesh*/,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& transform) {
+        const Accessor& accessor =
+            gltf.accessors[size_t(primitive.attributes.at("POSITION"))];
+        const BufferView& bufferView =
+            gltf.bufferViews[size_t(accessor.bufferView)];
+        const std::vector<std::byte>& data =
+            gltf.buffers[size_t(bufferView.buffer)].cesium.data;
+        const int64_t stride = accessor.computeByteStride(gltf);
+        for (int64_t i = 0; i < accessor.count; ++i) {
+          uint16_t values[3];
+          std::memcpy(
+              values,
+              data.data() + bufferView.byteOffset + accessor.byteOffset +
+                  i * stride,
+              sizeof(values));
+          const glm::dvec4 position =
+              transform * glm::dvec4(values[0], values[1], values[2], 1.0);
+          result.emplace_back(glm::vec3(position));
+        }
+      });
+  return result;
+}
+} // namespace
+
+TEST_CASE("GltfUtilities::quantizeMeshes") {
+  const std::vector<glm::vec3> positions{
+      glm::vec3(-100.0f, 5.0f, 20.0f),
+      glm::vec3(300.0f, -50.0f, 25.0f),
+      glm::vec3(120.0f, 80.0f, -10.0f)};
+  const std::vector<glm::vec3> normals{
+      glm::vec3(0.0f, 0.0f, 1.0f),
+      glm::normalize(glm::vec3(1.0f, 1.0f, 0.0f)),
+      glm::normalize(glm::vec3(-0.2f, 0.5f, -0.7f))};
+  Model model = createModel(positions, normals);
+
+  REQUIRE(GltfUtilities::quantizeMeshes(model));
+
+  SECTION("stores integers that transform to the original positions") {
+    const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+    const Accessor& positionAccessor =
+        model.accessors[size_t(primitive.attributes.at("POSITION"))];
+    CHECK(
+        positionAccessor.componentType ==
+        Accessor::ComponentType::UNSIGNED_SHORT);
+    CHECK(positionAccessor.computeByteStride(model) == 8);
+    CHECK(positionAccessor.min.size() == 3);
+    CHECK(positionAccessor.max.size() == 3);
+
+    const Accessor& normalAccessor =
+        model.accessors[size_t(primitive.attributes.at("NORMAL"))];
+    CHECK(normalAccessor.componentType == Accessor::ComponentType::BYTE);
+    CHECK(normalAccessor.normalized);
+    CHECK(normalAccessor.computeByteStride(model) == 4);
+
+    // The data was replaced in place, so no buffers were added.
+    CHECK(model.buffers.size() == 2);
+    CHECK(model.buffers[0].cesium.data.size() == positions.size() * 8);
+
+    CHECK(model.nodes.size() == 2);
+    CHECK(model.nodes[0].mesh == -1);
+    CHECK(model.nodes[0].children == std::vector<int32_t>{1});
+    CHECK(model.nodes[1].mesh == 0);
+    CHECK(
+        std::find(
+            model.extensionsRequired.begin(),
+            model.extensionsRequired.end(),
+            "KHR_mesh_quantization") != model.extensionsRequired.end());
+
+    // The largest extent is 400 meters, in 65535 steps.
+    const std::vector<glm::vec3> quantized = transformedPositions(model);
+    REQUIRE(quantized.size() == positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+      CHECK(glm::distance(quantized[i], positions[i]) < 0.01f);
+    }
+  }
+
+  SECTION("dequantizes back to floats") {
+    GltfUtilities::dequantizeMeshes(model);
+    CHECK(model.extensionsUsed.empty());
+    CHECK(model.extensionsRequired.empty());
+
+    const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+    const AccessorView<glm::vec3> dequantizedPositions(
+        model,
+        primitive.attributes.at("POSITION"));
+    const AccessorView<glm::vec3> dequantizedNormals(
+        model,
+        primitive.attributes.at("NORMAL"));
+    REQUIRE(dequantizedPositions.status() == AccessorViewStatus::Valid);
+    REQUIRE(dequantizedNormals.status() == AccessorViewStatus::Valid);
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+      const int64_t index = int64_t(i);
+      CHECK(glm::distance(dequantizedPositions[index], positions[i]) < 0.01f);
+      CHECK(glm::distance(dequantizedNormals[index], normals[i]) < 0.01f);
+    }
+
+    CHECK(model.nodes[1].translation == std::vector<double>{0, 0, 0});
+    CHECK(model.nodes[1].scale == std::vector<double>{1, 1, 1});
+  }
+}
+
+TEST_CASE("GltfUtilities::quantizeMeshes skips meshes used by several nodes") {
+  Model model = createModel(
+      {glm::vec3(0.0f), glm::vec3(1.0f)},
+      {glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 1.0f)});
+  model.nodes.emplace_back().mesh = 0;
+
+  CHECK(!GltfUtilities::quantizeMeshes(model));
+  CHECK(model.extensionsUsed.empty());
+  CHECK(model.accessors[0].componentType == Accessor::ComponentType::FLOAT);
+}
+
+TEST_CASE("GltfUtilities::computeOrientedBoundingBox") {
+  const std::vector<glm::vec3> positions{
+      glm::vec3(-100.0f, 5.0f, 20.0f),
+      glm::vec3(300.0f, -50.0f, 25.0f),
+      glm::vec3(120.0f, 80.0f, -10.0f),
+      glm::vec3(40.0f, 10.0f, 60.0f)};
+  const std::vector<glm::vec3> normals(
+      positions.size(),
+      glm::vec3(0.0f, 0.0f, 1.0f));
+  Model model = createModel(positions, normals);
+  model.extras["gltfUpAxis"] =
+      static_cast<std::underlying_type_t<CesiumGeometry::Axis>>(
+          CesiumGeometry::Axis::Z);
+
+  const glm::dvec3 translation(6378137.0, 1000.0, -500.0);
+  const glm::dmat4 transform = glm::translate(glm::dmat4(1.0), translation);
+
+  SECTION("contains the transformed positions") {
+    const std::optional<CesiumGeometry::OrientedBoundingBox> maybeBox =
+        GltfUtilities::computeOrientedBoundingBox(model, transform);
+    REQUIRE(maybeBox);
+    for (const glm::vec3& position : positions) {
+      CHECK(maybeBox->contains(glm::dvec3(position) + translation));
+    }
+    CHECK(!maybeBox->contains(translation + glm::dvec3(0.0, 0.0, 1000.0)));
+  }
+
+  SECTION("returns nothing for a model without positions") {
+    model.meshes[0].primitives[0].attributes.erase("POSITION");
+    CHECK(!GltfUtilities::computeOrientedBoundingBox(model, transform));
+  }
+}
+
+TEST_CASE("GltfUtilities with EXT_mesh_gpu_instancing") {
+  Model model = createModel(
+      {glm::vec3(-1.0f), glm::vec3(1.0f)},
+      {glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 1.0f)});
+  model.extras["gltfUpAxis"] =
+      static_cast<std::underlying_type_t<CesiumGeometry::Axis>>(
+          CesiumGeometry::Axis::Z);
+
+  // Eight instances along the x axis, out of order.
+  std::vector<glm::vec3> translations;
+  for (int i = 0; i < 8; ++i) {
+    translations.emplace_back(float(i * 3 % 8) * 100.0f, 0.0f, 0.0f);
+  }
+  model.nodes[0]
+      .addExtension<ExtensionExtMeshGpuInstancing>()
+      .attributes["TRANSLATION"] = addVec3Accessor(model, translations);
+
+  SECTION("bounds the mesh at each instance") {
+    const glm::dvec3 translation(6378137.0, 1000.0, -500.0);
+    const std::optional<CesiumGeometry::OrientedBoundingBox> maybeBox =
+        GltfUtilities::computeOrientedBoundingBox(
+            model,
+            glm::translate(glm::dmat4(1.0), translation));
+    REQUIRE(maybeBox);
+    for (const glm::vec3& instance : translations) {
+      CHECK(maybeBox->contains(glm::dvec3(instance) + translation));
+    }
+    CHECK(!maybeBox->contains(translation + glm::dvec3(-50.0, 0.0, 0.0)));
+  }
+
+  SECTION("does not quantize instanced meshes") {
+    CHECK(!GltfUtilities::quantizeMeshes(model));
+  }
+
+  SECTION("groups the instances into clusters") {
+    REQUIRE(GltfUtilities::clusterInstances(model, 2));
+
+    const std::optional<InstanceClusterMetadata> metadata =
+        InstanceClusterMetadata::parseFromGltfExtras(model.nodes[0].extras);
+    REQUIRE(metadata);
+    REQUIRE(metadata->clusters.size() == 4);
+
+    const std::vector<glm::dmat4> instances =
+        GltfUtilities::getInstanceTransforms(model, model.nodes[0]);
+    REQUIRE(instances.size() == 8);
+    for (size_t i = 0; i < metadata->clusters.size(); ++i) {
+      const InstanceCluster& cluster = metadata->clusters[i];
+      CHECK(cluster.firstInstance == int64_t(2 * i));
+      CHECK(cluster.instanceCount == 2);
+      CHECK(cluster.boundingBox.minimumX == Approx(200.0 * double(i) - 1.0));
+      CHECK(cluster.boundingBox.maximumX == Approx(200.0 * double(i) + 101.0));
+      for (int64_t j = 0; j < cluster.instanceCount; ++j) {
+        const glm::dvec3 instance(
+            instances[size_t(cluster.firstInstance + j)][3]);
+        CHECK(cluster.boundingBox.contains(instance));
+      }
+    }
+
+    // Clustered nodes are not clustered again.
+    CHECK(!GltfUtilities::clusterInstances(model, 2));
+  }
+}
+
+TEST_CASE("GltfUtilities::mergePrimitives") {
+  Model model;
+  Mesh& mesh = model.meshes.emplace_back();
+  for (int32_t i = 0; i < 3; ++i) {
+    MeshPrimitive& primitive = mesh.primitives.emplace_back();
+    primitive.material = i == 2 ? 1 : 0;
+
+    const float x = float(i);
+    primitive.attributes["POSITION"] = addVec3Accessor(
+        model,
+        {glm::vec3(x, 0.0f, 0.0f),
+         glm::vec3(x, 1.0f, 0.0f),
+         glm::vec3(x, 0.0f, 1.0f)});
+
+    // The second primitive names its feature ID attribute differently.
+    const int64_t featureIdAttribute = i == 1 ? 3 : 0;
+    primitive.attributes["_FEATURE_ID_" + std::to_string(featureIdAttribute)] =
+        addScalarAccessor<uint8_t>(
+            model,
+            {uint8_t(i), uint8_t(i), uint8_t(i + 10)},
+            Accessor::ComponentType::UNSIGNED_BYTE);
+    FeatureId& featureId = primitive.addExtension<ExtensionExtMeshFeatures>()
+                               .featureIds.emplace_back();
+    featureId.attribute = featureIdAttribute;
+    featureId.featureCount = 2;
+    featureId.propertyTable = 0;
+
+    // The second primitive has no indices.
+    if (i != 1) {
+      primitive.indices = addScalarAccessor<uint16_t>(
+          model,
+          {0, 1, 2},
+          Accessor::ComponentType::UNSIGNED_SHORT);
+    }
+  }
+
+  REQUIRE(GltfUtilities::mergePrimitives(model));
+  REQUIRE(mesh.primitives.size() == 2);
+  CHECK(mesh.primitives[1].material == 1);
+
+  const MeshPrimitive& merged = mesh.primitives[0];
+  CHECK(merged.material == 0);
+  CHECK(merged.attributes.size() == 2);
+
+  const AccessorView<glm::vec3> positions(
+      model,
+      merged.attributes.at("POSITION"));
+  REQUIRE(positions.status() == AccessorViewStatus::Valid);
+  REQUIRE(positions.size() == 6);
+  CHECK(positions[0] == glm::vec3(0.0f, 0.0f, 0.0f));
+  CHECK(positions[5] == glm::vec3(1.0f, 0.0f, 1.0f));
+
+  const AccessorView<uint16_t> indices(model, merged.indices);
+  REQUIRE(indices.status() == AccessorViewStatus::Valid);
+  REQUIRE(indices.size() == 6);
+  for (int64_t i = 0; i < indices.size(); ++i) {
+    CHECK(indices[i] == i);
+  }
+
+  // The feature IDs keep their values under the first primitive's name.
+  const AccessorView<uint8_t> featureIds(
+      model,
+      merged.attributes.at("_FEATURE_ID_0"));
+  REQUIRE(featureIds.status() == AccessorViewStatus::Valid);
+  const std::vector<uint8_t> expected{0, 0, 10, 1, 1, 11};
+  for (int64_t i = 0; i < featureIds.size(); ++i) {
+    CHECK(featureIds[i] == expected[size_t(i)]);
+  }
+
+  const ExtensionExtMeshFeatures* pMeshFeatures =
+      merged.getExtension<ExtensionExtMeshFeatures>();
+  REQUIRE(pMeshFeatures);
+  REQUIRE(pMeshFeatures->featureIds.size() == 1);
+  CHECK(pMeshFeatures->featureIds[0].attribute == 0);
+  CHECK(pMeshFeatures->featureIds[0].featureCount == 4);
+
+  // Nothing is left to merge.
+  CHECK(!GltfUtilities::mergePrimitives(model));
+}
@@ -4,6 +4,8 @@
 #include <catch2/catch.hpp>
 
 #include <algorithm>
+#include <cstdint>
+#include <vector>
 
 using namespace CesiumGltf;
 using namespace CesiumGltfContent;
@@ -237,6 +239,28 @@ TEST_CASE("ImageManipulation::blitImage") {
     verifySuccessfulCopy();
   }
 
+  SECTION("succeeds for consecutive scaled blits of different sizes") {
+    // Resizing is currently only supported for images that use one byte per
+    // channel.
+    target.bytesPerChannel = 1;
+    source.bytesPerChannel = 1;
+
+    // The second blit covers the first, and needs more scratch memory.
+    targetRect.width = 2;
+    targetRect.height = 3;
+    CHECK(
+        ImageManipulation::blitImage(target, targetRect, source, sourceRect) ==
+        true);
+
+    targetRect.y = 4;
+    targetRect.width = 4;
+    targetRect.height = 5;
+    CHECK(
+        ImageManipulation::blitImage(target, targetRect, source, sourceRect) ==
+        true);
+    verifySuccessfulCopy();
+  }
+
   SECTION("returns false for mismatched bytesPerChannel") {
     target.bytesPerChannel = 1;
     CHECK(
@@ -332,3 +356,190 @@ TEST_CASE("ImageManipulation::blitImage") {
     verifyTargetUnchanged();
   }
 }
+
+TEST_CASE("ImageManipulation::blitImage by integer factors") {
+  SECTION("interpolates between source pixels when scaling up") {
+    // Two RGBA pixels, scaled up four times in each direction.
+    ImageCesium source;
+    source.width = 2;
+    source.height = 1;
+    source.channels = 4;
+    source.bytesPerChannel = 1;
+    source.pixelData = {
+        std::byte(0),
+        std::byte(255),
+        std::byte(100),
+        std::byte(255),
+        std::byte(255),
+        std::byte(0),
+        std::byte(100),
+        std::byte(255)};
+
+    ImageCesium target;
+    target.width = 8;
+    target.height = 4;
+    target.channels = 4;
+    target.bytesPerChannel = 1;
+    target.pixelData.resize(size_t(target.width * target.height * 4));
+
+    CHECK(ImageManipulation::blitImage(
+        target,
+        PixelRectangle{0, 0, 8, 4},
+        source,
+        PixelRectangle{0, 0, 2, 1}));
+
+    // The outer pixels take the edge values, and those in between are
+    // interpolated between the source pixel centers.
+    const std::vector<uint8_t> expectedRed{0, 0, 32, 96, 159, 223, 255, 255};
+    bool matches = true;
+    for (size_t j = 0; j < 4; ++j) {
+      for (size_t i = 0; i < 8; ++i) {
+        const std::byte* pPixel = target.pixelData.data() + (j * 8 + i) * 4;
+        matches = matches && pPixel[0] == std::byte(expectedRed[i]) &&
+                  pPixel[1] == std::byte(255 - expectedRed[i]) &&
+                  pPixel[2] == std::byte(100) && pPixel[3] == std::byte(255);
+      }
+    }
+    CHECK(matches);
+  }
+
+  SECTION("averages blocks of source pixels when scaling down") {
+    ImageCesium source;
+    source.width = 4;
+    source.height = 2;
+    source.channels = 1;
+    source.bytesPerChannel = 1;
+    source.pixelData = {
+        std::byte(10),
+        std::byte(20),
+        std::byte(30),
+        std::byte(41),
+        std::byte(50),
+        std::byte(60),
+        std::byte(70),
+        std::byte(80)};
+
+    ImageCesium target;
+    target.width = 3;
+    target.height = 1;
+    target.channels = 1;
+    target.bytesPerChannel = 1;
+    target.pixelData = {std::byte(1), std::byte(1), std::byte(1)};
+
+    CHECK(ImageManipulation::blitImage(
+        target,
+        PixelRectangle{1, 0, 2, 1},
+        source,
+        PixelRectangle{0, 0, 4, 2}));
+    CHECK(target.pixelData[0] == std::byte(1));
+    CHECK(target.pixelData[1] == std::byte(35));
+    CHECK(target.pixelData[2] == std::byte(55));
+  }
+}
+
+TEST_CASE("ImageManipulation::compressImage") {
+  ImageCesium image;
+  image.width = 5;
+  image.height = 6;
+  image.channels = 1;
+  image.bytesPerChannel = 1;
+  image.pixelData = std::vector<std::byte>(30, std::byte(0x80));
+
+  SECTION("encodes partial blocks at the edges") {
+    REQUIRE(ImageManipulation::compressImage(
+        image,
+        GpuCompressedPixelFormat::BC4_R));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::BC4_R);
+    CHECK(image.mipPositions.empty());
+    CHECK(image.pixelData.size() == 4 * 8);
+  }
+
+  SECTION("encodes each mip level") {
+    image.width = 8;
+    image.height = 8;
+    image.channels = 4;
+    image.pixelData = std::vector<std::byte>(
+        size_t((64 + 16 + 4 + 1) * 4),
+        std::byte(0x80));
+    image.mipPositions = {{0, 256}, {256, 64}, {320, 16}, {336, 4}};
+
+    REQUIRE(ImageManipulation::compressImage(
+        image,
+        GpuCompressedPixelFormat::BC3_RGBA));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::BC3_RGBA);
+    REQUIRE(image.mipPositions.size() == 4);
+    CHECK(image.mipPositions[0].byteOffset == 0);
+    CHECK(image.mipPositions[0].byteSize == 4 * 16);
+    CHECK(image.mipPositions[1].byteOffset == 64);
+    CHECK(image.mipPositions[1].byteSize == 16);
+    CHECK(image.mipPositions[2].byteOffset == 80);
+    CHECK(image.mipPositions[3].byteOffset == 96);
+    CHECK(image.pixelData.size() == 112);
+  }
+
+  SECTION("returns false for formats that can't be encoded") {
+    CHECK(!ImageManipulation::compressImage(
+        image,
+        GpuCompressedPixelFormat::ETC1_RGB));
+    CHECK(!ImageManipulation::compressImage(
+        image,
+        GpuCompressedPixelFormat::BC1_RGB));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::NONE);
+    CHECK(image.pixelData.size() == 30);
+  }
+
+  SECTION("returns false for images that are too small") {
+    image.pixelData.resize(10);
+    CHECK(!ImageManipulation::compressImage(
+        image,
+        GpuCompressedPixelFormat::BC4_R));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::NONE);
+  }
+}
+
+TEST_CASE("ImageManipulation::truncateChannels") {
+  ImageCesium image;
+  image.width = 2;
+  image.height = 1;
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.pixelData = {
+      std::byte(1),
+      std::byte(2),
+      std::byte(3),
+      std::byte(4),
+      std::byte(5),
+      std::byte(6),
+      std::byte(7),
+      std::byte(8),
+      std::byte(9),
+      std::byte(10),
+      std::byte(11),
+      std::byte(12)};
+  image.mipPositions = {{0, 8}, {8, 4}};
+
+  SECTION("keeps the first channels of each pixel and mip level") {
+    REQUIRE(ImageManipulation::truncateChannels(image, 2));
+    CHECK(image.channels == 2);
+    CHECK(
+        image.pixelData == std::vector<std::byte>{
+                               std::byte(1),
+                               std::byte(2),
+                               std::byte(5),
+                               std::byte(6),
+                               std::byte(9),
+                               std::byte(10)});
+    REQUIRE(image.mipPositions.size() == 2);
+    CHECK(image.mipPositions[0].byteOffset == 0);
+    CHECK(image.mipPositions[0].byteSize == 4);
+    CHECK(image.mipPositions[1].byteOffset == 4);
+    CHECK(image.mipPositions[1].byteSize == 2);
+  }
+
+  SECTION("returns false for more channels than the image has") {
+    CHECK(!ImageManipulation::truncateChannels(image, 5));
+    CHECK(!ImageManipulation::truncateChannels(image, 0));
+    CHECK(image.channels == 4);
+    CHECK(image.pixelData.size() == 12);
+  }
+}
@@ -50,10 +50,14 @@ ExtensionCesiumRTCJsonHandler::readObjectKeyExtensionCesiumRTC(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::ExtensionCesiumRTC& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("center"s == str)
-    return property("center", this->_center, o.center);
+  switch (str.size()) {
+  case 6:
+    if ("center"sv == str)
+      return property("center", this->_center, o.center);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -153,16 +157,26 @@ ExtensionCesiumTileEdgesJsonHandler::readObjectKeyExtensionCesiumTileEdges(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::ExtensionCesiumTileEdges& o) {
-  using namespace std::string_literals;
-
-  if ("left"s == str)
-    return property("left", this->_left, o.left);
-  if ("bottom"s == str)
-    return property("bottom", this->_bottom, o.bottom);
-  if ("right"s == str)
-    return property("right", this->_right, o.right);
-  if ("top"s == str)
-    return property("top", this->_top, o.top);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("top"sv == str)
+      return property("top", this->_top, o.top);
+    break;
+  case 4:
+    if ("left"sv == str)
+      return property("left", this->_left, o.left);
+    break;
+  case 5:
+    if ("right"sv == str)
+      return property("right", this->_right, o.right);
+    break;
+  case 6:
+    if ("bottom"sv == str)
+      return property("bottom", this->_bottom, o.bottom);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -268,21 +282,33 @@ CesiumJsonReader::IJsonHandler* ExtensionModelExtFeatureMetadataJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionModelExtFeatureMetadata& o) {
-  using namespace std::string_literals;
-
-  if ("schema"s == str)
-    return property("schema", this->_schema, o.schema);
-  if ("schemaUri"s == str)
-    return property("schemaUri", this->_schemaUri, o.schemaUri);
-  if ("statistics"s == str)
-    return property("statistics", this->_statistics, o.statistics);
-  if ("featureTables"s == str)
-    return property("featureTables", this->_featureTables, o.featureTables);
-  if ("featureTextures"s == str)
-    return property(
-        "featureTextures",
-        this->_featureTextures,
-        o.featureTextures);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 6:
+    if ("schema"sv == str)
+      return property("schema", this->_schema, o.schema);
+    break;
+  case 9:
+    if ("schemaUri"sv == str)
+      return property("schemaUri", this->_schemaUri, o.schemaUri);
+    break;
+  case 10:
+    if ("statistics"sv == str)
+      return property("statistics", this->_statistics, o.statistics);
+    break;
+  case 13:
+    if ("featureTables"sv == str)
+      return property("featureTables", this->_featureTables, o.featureTables);
+    break;
+  case 15:
+    if ("featureTextures"sv == str)
+      return property(
+          "featureTextures",
+          this->_featureTextures,
+          o.featureTextures);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -390,23 +416,31 @@ ExtensionMeshPrimitiveExtFeatureMetadataJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionMeshPrimitiveExtFeatureMetadata& o) {
-  using namespace std::string_literals;
-
-  if ("featureIdAttributes"s == str)
-    return property(
-        "featureIdAttributes",
-        this->_featureIdAttributes,
-        o.featureIdAttributes);
-  if ("featureIdTextures"s == str)
-    return property(
-        "featureIdTextures",
-        this->_featureIdTextures,
-        o.featureIdTextures);
-  if ("featureTextures"s == str)
-    return property(
-        "featureTextures",
-        this->_featureTextures,
-        o.featureTextures);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 15:
+    if ("featureTextures"sv == str)
+      return property(
+          "featureTextures",
+          this->_featureTextures,
+          o.featureTextures);
+    break;
+  case 17:
+    if ("featureIdTextures"sv == str)
+      return property(
+          "featureIdTextures",
+          this->_featureIdTextures,
+          o.featureIdTextures);
+    break;
+  case 19:
+    if ("featureIdAttributes"sv == str)
+      return property(
+          "featureIdAttributes",
+          this->_featureIdAttributes,
+          o.featureIdAttributes);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -510,10 +544,14 @@ CesiumJsonReader::IJsonHandler* ExtensionExtInstanceFeaturesJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtInstanceFeatures& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("featureIds"s == str)
-    return property("featureIds", this->_featureIds, o.featureIds);
+  switch (str.size()) {
+  case 10:
+    if ("featureIds"sv == str)
+      return property("featureIds", this->_featureIds, o.featureIds);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -613,10 +651,14 @@ ExtensionExtMeshFeaturesJsonHandler::readObjectKeyExtensionExtMeshFeatures(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::ExtensionExtMeshFeatures& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("featureIds"s == str)
-    return property("featureIds", this->_featureIds, o.featureIds);
+  switch (str.size()) {
+  case 10:
+    if ("featureIds"sv == str)
+      return property("featureIds", this->_featureIds, o.featureIds);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -716,10 +758,14 @@ CesiumJsonReader::IJsonHandler* ExtensionExtMeshGpuInstancingJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtMeshGpuInstancing& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("attributes"s == str)
-    return property("attributes", this->_attributes, o.attributes);
+  switch (str.size()) {
+  case 10:
+    if ("attributes"sv == str)
+      return property("attributes", this->_attributes, o.attributes);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -821,10 +867,14 @@ ExtensionBufferExtMeshoptCompressionJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionBufferExtMeshoptCompression& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("fallback"s == str)
-    return property("fallback", this->_fallback, o.fallback);
+  switch (str.size()) {
+  case 8:
+    if ("fallback"sv == str)
+      return property("fallback", this->_fallback, o.fallback);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -938,22 +988,32 @@ ExtensionBufferViewExtMeshoptCompressionJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionBufferViewExtMeshoptCompression& o) {
-  using namespace std::string_literals;
-
-  if ("buffer"s == str)
-    return property("buffer", this->_buffer, o.buffer);
-  if ("byteOffset"s == str)
-    return property("byteOffset", this->_byteOffset, o.byteOffset);
-  if ("byteLength"s == str)
-    return property("byteLength", this->_byteLength, o.byteLength);
-  if ("byteStride"s == str)
-    return property("byteStride", this->_byteStride, o.byteStride);
-  if ("count"s == str)
-    return property("count", this->_count, o.count);
-  if ("mode"s == str)
-    return property("mode", this->_mode, o.mode);
-  if ("filter"s == str)
-    return property("filter", this->_filter, o.filter);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("mode"sv == str)
+      return property("mode", this->_mode, o.mode);
+    break;
+  case 5:
+    if ("count"sv == str)
+      return property("count", this->_count, o.count);
+    break;
+  case 6:
+    if ("buffer"sv == str)
+      return property("buffer", this->_buffer, o.buffer);
+    if ("filter"sv == str)
+      return property("filter", this->_filter, o.filter);
+    break;
+  case 10:
+    if ("byteOffset"sv == str)
+      return property("byteOffset", this->_byteOffset, o.byteOffset);
+    if ("byteLength"sv == str)
+      return property("byteLength", this->_byteLength, o.byteLength);
+    if ("byteStride"sv == str)
+      return property("byteStride", this->_byteStride, o.byteStride);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1062,24 +1122,39 @@ CesiumJsonReader::IJsonHandler* ExtensionModelExtStructuralMetadataJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionModelExtStructuralMetadata& o) {
-  using namespace std::string_literals;
-
-  if ("schema"s == str)
-    return property("schema", this->_schema, o.schema);
-  if ("schemaUri"s == str)
-    return property("schemaUri", this->_schemaUri, o.schemaUri);
-  if ("propertyTables"s == str)
-    return property("propertyTables", this->_propertyTables, o.propertyTables);
-  if ("propertyTextures"s == str)
-    return property(
-        "propertyTextures",
-        this->_propertyTextures,
-        o.propertyTextures);
-  if ("propertyAttributes"s == str)
-    return property(
-        "propertyAttributes",
-        this->_propertyAttributes,
-        o.propertyAttributes);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 6:
+    if ("schema"sv == str)
+      return property("schema", this->_schema, o.schema);
+    break;
+  case 9:
+    if ("schemaUri"sv == str)
+      return property("schemaUri", this->_schemaUri, o.schemaUri);
+    break;
+  case 14:
+    if ("propertyTables"sv == str)
+      return property(
+          "propertyTables",
+          this->_propertyTables,
+          o.propertyTables);
+    break;
+  case 16:
+    if ("propertyTextures"sv == str)
+      return property(
+          "propertyTextures",
+          this->_propertyTextures,
+          o.propertyTextures);
+    break;
+  case 18:
+    if ("propertyAttributes"sv == str)
+      return property(
+          "propertyAttributes",
+          this->_propertyAttributes,
+          o.propertyAttributes);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1188,18 +1263,24 @@ ExtensionMeshPrimitiveExtStructuralMetadataJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionMeshPrimitiveExtStructuralMetadata& o) {
-  using namespace std::string_literals;
-
-  if ("propertyTextures"s == str)
-    return property(
-        "propertyTextures",
-        this->_propertyTextures,
-        o.propertyTextures);
-  if ("propertyAttributes"s == str)
-    return property(
-        "propertyAttributes",
-        this->_propertyAttributes,
-        o.propertyAttributes);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 16:
+    if ("propertyTextures"sv == str)
+      return property(
+          "propertyTextures",
+          this->_propertyTextures,
+          o.propertyTextures);
+    break;
+  case 18:
+    if ("propertyAttributes"sv == str)
+      return property(
+          "propertyAttributes",
+          this->_propertyAttributes,
+          o.propertyAttributes);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1307,12 +1388,16 @@ CesiumJsonReader::IJsonHandler* ExtensionKhrDracoMeshCompressionJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionKhrDracoMeshCompression& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("bufferView"s == str)
-    return property("bufferView", this->_bufferView, o.bufferView);
-  if ("attributes"s == str)
-    return property("attributes", this->_attributes, o.attributes);
+  switch (str.size()) {
+  case 10:
+    if ("bufferView"sv == str)
+      return property("bufferView", this->_bufferView, o.bufferView);
+    if ("attributes"sv == str)
+      return property("attributes", this->_attributes, o.attributes);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1412,7 +1497,7 @@ ExtensionKhrMaterialsUnlitJsonHandler::readObjectKeyExtensionKhrMaterialsUnlit(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::ExtensionKhrMaterialsUnlit& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
   (void)o;
 
@@ -1516,10 +1601,14 @@ CesiumJsonReader::IJsonHandler* ExtensionModelKhrMaterialsVariantsJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionModelKhrMaterialsVariants& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("variants"s == str)
-    return property("variants", this->_variants, o.variants);
+  switch (str.size()) {
+  case 8:
+    if ("variants"sv == str)
+      return property("variants", this->_variants, o.variants);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1625,10 +1714,14 @@ ExtensionMeshPrimitiveKhrMaterialsVariantsJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionMeshPrimitiveKhrMaterialsVariants& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("mappings"s == str)
-    return property("mappings", this->_mappings, o.mappings);
+  switch (str.size()) {
+  case 8:
+    if ("mappings"sv == str)
+      return property("mappings", this->_mappings, o.mappings);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1730,10 +1823,14 @@ ExtensionKhrTextureBasisuJsonHandler::readObjectKeyExtensionKhrTextureBasisu(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::ExtensionKhrTextureBasisu& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("source"s == str)
-    return property("source", this->_source, o.source);
+  switch (str.size()) {
+  case 6:
+    if ("source"sv == str)
+      return property("source", this->_source, o.source);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1835,12 +1932,18 @@ CesiumJsonReader::IJsonHandler* ExtensionModelMaxarMeshVariantsJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionModelMaxarMeshVariants& o) {
-  using namespace std::string_literals;
-
-  if ("default"s == str)
-    return property("default", this->_defaultProperty, o.defaultProperty);
-  if ("variants"s == str)
-    return property("variants", this->_variants, o.variants);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 7:
+    if ("default"sv == str)
+      return property("default", this->_defaultProperty, o.defaultProperty);
+    break;
+  case 8:
+    if ("variants"sv == str)
+      return property("variants", this->_variants, o.variants);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1941,10 +2044,14 @@ CesiumJsonReader::IJsonHandler* ExtensionNodeMaxarMeshVariantsJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionNodeMaxarMeshVariants& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("mappings"s == str)
-    return property("mappings", this->_mappings, o.mappings);
+  switch (str.size()) {
+  case 8:
+    if ("mappings"sv == str)
+      return property("mappings", this->_mappings, o.mappings);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -2048,16 +2155,24 @@ CesiumJsonReader::IJsonHandler* ExtensionKhrTextureTransformJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionKhrTextureTransform& o) {
-  using namespace std::string_literals;
-
-  if ("offset"s == str)
-    return property("offset", this->_offset, o.offset);
-  if ("rotation"s == str)
-    return property("rotation", this->_rotation, o.rotation);
-  if ("scale"s == str)
-    return property("scale", this->_scale, o.scale);
-  if ("texCoord"s == str)
-    return property("texCoord", this->_texCoord, o.texCoord);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("scale"sv == str)
+      return property("scale", this->_scale, o.scale);
+    break;
+  case 6:
+    if ("offset"sv == str)
+      return property("offset", this->_offset, o.offset);
+    break;
+  case 8:
+    if ("rotation"sv == str)
+      return property("rotation", this->_rotation, o.rotation);
+    if ("texCoord"sv == str)
+      return property("texCoord", this->_texCoord, o.texCoord);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -2154,10 +2269,14 @@ ExtensionTextureWebpJsonHandler::readObjectKeyExtensionTextureWebp(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::ExtensionTextureWebp& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("source"s == str)
-    return property("source", this->_source, o.source);
+  switch (str.size()) {
+  case 6:
+    if ("source"sv == str)
+      return property("source", this->_source, o.source);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -2245,14 +2364,20 @@ ExtensionNodeMaxarMeshVariantsMappingsValueJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionNodeMaxarMeshVariantsMappingsValue& o) {
-  using namespace std::string_literals;
-
-  if ("variants"s == str)
-    return property("variants", this->_variants, o.variants);
-  if ("mesh"s == str)
-    return property("mesh", this->_mesh, o.mesh);
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("mesh"sv == str)
+      return property("mesh", this->_mesh, o.mesh);
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 8:
+    if ("variants"sv == str)
+      return property("variants", this->_variants, o.variants);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -2345,10 +2470,14 @@ ExtensionModelMaxarMeshVariantsValueJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionModelMaxarMeshVariantsValue& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -2446,14 +2575,20 @@ ExtensionMeshPrimitiveKhrMaterialsVariantsMappingsValueJsonHandler::
         const std::string_view& str,
         CesiumGltf::ExtensionMeshPrimitiveKhrMaterialsVariantsMappingsValue&
             o) {
-  using namespace std::string_literals;
-
-  if ("variants"s == str)
-    return property("variants", this->_variants, o.variants);
-  if ("material"s == str)
-    return property("material", this->_material, o.material);
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 8:
+    if ("variants"sv == str)
+      return property("variants", this->_variants, o.variants);
+    if ("material"sv == str)
+      return property("material", this->_material, o.material);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -2547,10 +2682,14 @@ ExtensionModelKhrMaterialsVariantsValueJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionModelKhrMaterialsVariantsValue& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -2641,14 +2780,22 @@ PropertyAttributeJsonHandler::readObjectKeyPropertyAttribute(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::PropertyAttribute& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("class"s == str)
-    return property("class", this->_classProperty, o.classProperty);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 5:
+    if ("class"sv == str)
+      return property("class", this->_classProperty, o.classProperty);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -2736,18 +2883,28 @@ PropertyAttributePropertyJsonHandler::readObjectKeyPropertyAttributeProperty(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::PropertyAttributeProperty& o) {
-  using namespace std::string_literals;
-
-  if ("attribute"s == str)
-    return property("attribute", this->_attribute, o.attribute);
-  if ("offset"s == str)
-    return property("offset", this->_offset, o.offset);
-  if ("scale"s == str)
-    return property("scale", this->_scale, o.scale);
-  if ("max"s == str)
-    return property("max", this->_max, o.max);
-  if ("min"s == str)
-    return property("min", this->_min, o.min);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("max"sv == str)
+      return property("max", this->_max, o.max);
+    if ("min"sv == str)
+      return property("min", this->_min, o.min);
+    break;
+  case 5:
+    if ("scale"sv == str)
+      return property("scale", this->_scale, o.scale);
+    break;
+  case 6:
+    if ("offset"sv == str)
+      return property("offset", this->_offset, o.offset);
+    break;
+  case 9:
+    if ("attribute"sv == str)
+      return property("attribute", this->_attribute, o.attribute);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -2835,14 +2992,22 @@ PropertyTextureJsonHandler::readObjectKeyPropertyTexture(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::PropertyTexture& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("class"s == str)
-    return property("class", this->_classProperty, o.classProperty);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 5:
+    if ("class"sv == str)
+      return property("class", this->_classProperty, o.classProperty);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -2927,18 +3092,28 @@ PropertyTexturePropertyJsonHandler::readObjectKeyPropertyTextureProperty(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::PropertyTextureProperty& o) {
-  using namespace std::string_literals;
-
-  if ("channels"s == str)
-    return property("channels", this->_channels, o.channels);
-  if ("offset"s == str)
-    return property("offset", this->_offset, o.offset);
-  if ("scale"s == str)
-    return property("scale", this->_scale, o.scale);
-  if ("max"s == str)
-    return property("max", this->_max, o.max);
-  if ("min"s == str)
-    return property("min", this->_min, o.min);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("max"sv == str)
+      return property("max", this->_max, o.max);
+    if ("min"sv == str)
+      return property("min", this->_min, o.min);
+    break;
+  case 5:
+    if ("scale"sv == str)
+      return property("scale", this->_scale, o.scale);
+    break;
+  case 6:
+    if ("offset"sv == str)
+      return property("offset", this->_offset, o.offset);
+    break;
+  case 8:
+    if ("channels"sv == str)
+      return property("channels", this->_channels, o.channels);
+    break;
+  }
 
   return this->readObjectKeyTextureInfo(objectType, str, *this->_pObject);
 }
@@ -3025,12 +3200,18 @@ TextureInfoJsonHandler::readObjectKeyTextureInfo(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::TextureInfo& o) {
-  using namespace std::string_literals;
-
-  if ("index"s == str)
-    return property("index", this->_index, o.index);
-  if ("texCoord"s == str)
-    return property("texCoord", this->_texCoord, o.texCoord);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("index"sv == str)
+      return property("index", this->_index, o.index);
+    break;
+  case 8:
+    if ("texCoord"sv == str)
+      return property("texCoord", this->_texCoord, o.texCoord);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -3111,16 +3292,24 @@ PropertyTableJsonHandler::readObjectKeyPropertyTable(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::PropertyTable& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("class"s == str)
-    return property("class", this->_classProperty, o.classProperty);
-  if ("count"s == str)
-    return property("count", this->_count, o.count);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 5:
+    if ("class"sv == str)
+      return property("class", this->_classProperty, o.classProperty);
+    if ("count"sv == str)
+      return property("count", this->_count, o.count);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -3209,32 +3398,48 @@ PropertyTablePropertyJsonHandler::readObjectKeyPropertyTableProperty(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::PropertyTableProperty& o) {
-  using namespace std::string_literals;
-
-  if ("values"s == str)
-    return property("values", this->_values, o.values);
-  if ("arrayOffsets"s == str)
-    return property("arrayOffsets", this->_arrayOffsets, o.arrayOffsets);
-  if ("stringOffsets"s == str)
-    return property("stringOffsets", this->_stringOffsets, o.stringOffsets);
-  if ("arrayOffsetType"s == str)
-    return property(
-        "arrayOffsetType",
-        this->_arrayOffsetType,
-        o.arrayOffsetType);
-  if ("stringOffsetType"s == str)
-    return property(
-        "stringOffsetType",
-        this->_stringOffsetType,
-        o.stringOffsetType);
-  if ("offset"s == str)
-    return property("offset", this->_offset, o.offset);
-  if ("scale"s == str)
-    return property("scale", this->_scale, o.scale);
-  if ("max"s == str)
-    return property("max", this->_max, o.max);
-  if ("min"s == str)
-    return property("min", this->_min, o.min);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("max"sv == str)
+      return property("max", this->_max, o.max);
+    if ("min"sv == str)
+      return property("min", this->_min, o.min);
+    break;
+  case 5:
+    if ("scale"sv == str)
+      return property("scale", this->_scale, o.scale);
+    break;
+  case 6:
+    if ("values"sv == str)
+      return property("values", this->_values, o.values);
+    if ("offset"sv == str)
+      return property("offset", this->_offset, o.offset);
+    break;
+  case 12:
+    if ("arrayOffsets"sv == str)
+      return property("arrayOffsets", this->_arrayOffsets, o.arrayOffsets);
+    break;
+  case 13:
+    if ("stringOffsets"sv == str)
+      return property("stringOffsets", this->_stringOffsets, o.stringOffsets);
+    break;
+  case 15:
+    if ("arrayOffsetType"sv == str)
+      return property(
+          "arrayOffsetType",
+          this->_arrayOffsetType,
+          o.arrayOffsetType);
+    break;
+  case 16:
+    if ("stringOffsetType"sv == str)
+      return property(
+          "stringOffsetType",
+          this->_stringOffsetType,
+          o.stringOffsetType);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -3321,20 +3526,32 @@ CesiumJsonReader::IJsonHandler* SchemaJsonHandler::readObjectKeySchema(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Schema& o) {
-  using namespace std::string_literals;
-
-  if ("id"s == str)
-    return property("id", this->_id, o.id);
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("version"s == str)
-    return property("version", this->_version, o.version);
-  if ("classes"s == str)
-    return property("classes", this->_classes, o.classes);
-  if ("enums"s == str)
-    return property("enums", this->_enums, o.enums);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 2:
+    if ("id"sv == str)
+      return property("id", this->_id, o.id);
+    break;
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 5:
+    if ("enums"sv == str)
+      return property("enums", this->_enums, o.enums);
+    break;
+  case 7:
+    if ("version"sv == str)
+      return property("version", this->_version, o.version);
+    if ("classes"sv == str)
+      return property("classes", this->_classes, o.classes);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -3412,16 +3629,26 @@ CesiumJsonReader::IJsonHandler* EnumJsonHandler::readObjectKeyEnum(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Enum& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("valueType"s == str)
-    return property("valueType", this->_valueType, o.valueType);
-  if ("values"s == str)
-    return property("values", this->_values, o.values);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 6:
+    if ("values"sv == str)
+      return property("values", this->_values, o.values);
+    break;
+  case 9:
+    if ("valueType"sv == str)
+      return property("valueType", this->_valueType, o.valueType);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -3498,14 +3725,22 @@ CesiumJsonReader::IJsonHandler* EnumValueJsonHandler::readObjectKeyEnumValue(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::EnumValue& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("value"s == str)
-    return property("value", this->_value, o.value);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 5:
+    if ("value"sv == str)
+      return property("value", this->_value, o.value);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -3583,14 +3818,22 @@ CesiumJsonReader::IJsonHandler* ClassJsonHandler::readObjectKeyClass(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Class& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -3681,40 +3924,60 @@ ClassPropertyJsonHandler::readObjectKeyClassProperty(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::ClassProperty& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("type"s == str)
-    return property("type", this->_type, o.type);
-  if ("componentType"s == str)
-    return property("componentType", this->_componentType, o.componentType);
-  if ("enumType"s == str)
-    return property("enumType", this->_enumType, o.enumType);
-  if ("array"s == str)
-    return property("array", this->_array, o.array);
-  if ("count"s == str)
-    return property("count", this->_count, o.count);
-  if ("normalized"s == str)
-    return property("normalized", this->_normalized, o.normalized);
-  if ("offset"s == str)
-    return property("offset", this->_offset, o.offset);
-  if ("scale"s == str)
-    return property("scale", this->_scale, o.scale);
-  if ("max"s == str)
-    return property("max", this->_max, o.max);
-  if ("min"s == str)
-    return property("min", this->_min, o.min);
-  if ("required"s == str)
-    return property("required", this->_required, o.required);
-  if ("noData"s == str)
-    return property("noData", this->_noData, o.noData);
-  if ("default"s == str)
-    return property("default", this->_defaultProperty, o.defaultProperty);
-  if ("semantic"s == str)
-    return property("semantic", this->_semantic, o.semantic);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("max"sv == str)
+      return property("max", this->_max, o.max);
+    if ("min"sv == str)
+      return property("min", this->_min, o.min);
+    break;
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    if ("type"sv == str)
+      return property("type", this->_type, o.type);
+    break;
+  case 5:
+    if ("array"sv == str)
+      return property("array", this->_array, o.array);
+    if ("count"sv == str)
+      return property("count", this->_count, o.count);
+    if ("scale"sv == str)
+      return property("scale", this->_scale, o.scale);
+    break;
+  case 6:
+    if ("offset"sv == str)
+      return property("offset", this->_offset, o.offset);
+    if ("noData"sv == str)
+      return property("noData", this->_noData, o.noData);
+    break;
+  case 7:
+    if ("default"sv == str)
+      return property("default", this->_defaultProperty, o.defaultProperty);
+    break;
+  case 8:
+    if ("enumType"sv == str)
+      return property("enumType", this->_enumType, o.enumType);
+    if ("required"sv == str)
+      return property("required", this->_required, o.required);
+    if ("semantic"sv == str)
+      return property("semantic", this->_semantic, o.semantic);
+    break;
+  case 10:
+    if ("normalized"sv == str)
+      return property("normalized", this->_normalized, o.normalized);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  case 13:
+    if ("componentType"sv == str)
+      return property("componentType", this->_componentType, o.componentType);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -3799,20 +4062,32 @@ CesiumJsonReader::IJsonHandler* FeatureIdJsonHandler::readObjectKeyFeatureId(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::FeatureId& o) {
-  using namespace std::string_literals;
-
-  if ("featureCount"s == str)
-    return property("featureCount", this->_featureCount, o.featureCount);
-  if ("nullFeatureId"s == str)
-    return property("nullFeatureId", this->_nullFeatureId, o.nullFeatureId);
-  if ("label"s == str)
-    return property("label", this->_label, o.label);
-  if ("attribute"s == str)
-    return property("attribute", this->_attribute, o.attribute);
-  if ("texture"s == str)
-    return property("texture", this->_texture, o.texture);
-  if ("propertyTable"s == str)
-    return property("propertyTable", this->_propertyTable, o.propertyTable);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("label"sv == str)
+      return property("label", this->_label, o.label);
+    break;
+  case 7:
+    if ("texture"sv == str)
+      return property("texture", this->_texture, o.texture);
+    break;
+  case 9:
+    if ("attribute"sv == str)
+      return property("attribute", this->_attribute, o.attribute);
+    break;
+  case 12:
+    if ("featureCount"sv == str)
+      return property("featureCount", this->_featureCount, o.featureCount);
+    break;
+  case 13:
+    if ("nullFeatureId"sv == str)
+      return property("nullFeatureId", this->_nullFeatureId, o.nullFeatureId);
+    if ("propertyTable"sv == str)
+      return property("propertyTable", this->_propertyTable, o.propertyTable);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -3888,10 +4163,14 @@ FeatureIdTextureJsonHandler::readObjectKeyFeatureIdTexture(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::FeatureIdTexture& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("channels"s == str)
-    return property("channels", this->_channels, o.channels);
+  switch (str.size()) {
+  case 8:
+    if ("channels"sv == str)
+      return property("channels", this->_channels, o.channels);
+    break;
+  }
 
   return this->readObjectKeyTextureInfo(objectType, str, *this->_pObject);
 }
@@ -3980,18 +4259,28 @@ ExtensionExtInstanceFeaturesFeatureIdJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtInstanceFeaturesFeatureId& o) {
-  using namespace std::string_literals;
-
-  if ("featureCount"s == str)
-    return property("featureCount", this->_featureCount, o.featureCount);
-  if ("nullFeatureId"s == str)
-    return property("nullFeatureId", this->_nullFeatureId, o.nullFeatureId);
-  if ("label"s == str)
-    return property("label", this->_label, o.label);
-  if ("attribute"s == str)
-    return property("attribute", this->_attribute, o.attribute);
-  if ("propertyTable"s == str)
-    return property("propertyTable", this->_propertyTable, o.propertyTable);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("label"sv == str)
+      return property("label", this->_label, o.label);
+    break;
+  case 9:
+    if ("attribute"sv == str)
+      return property("attribute", this->_attribute, o.attribute);
+    break;
+  case 12:
+    if ("featureCount"sv == str)
+      return property("featureCount", this->_featureCount, o.featureCount);
+    break;
+  case 13:
+    if ("nullFeatureId"sv == str)
+      return property("nullFeatureId", this->_nullFeatureId, o.nullFeatureId);
+    if ("propertyTable"sv == str)
+      return property("propertyTable", this->_propertyTable, o.propertyTable);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -4084,12 +4373,18 @@ ExtensionExtFeatureMetadataFeatureIDTextureJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataFeatureIDTexture& o) {
-  using namespace std::string_literals;
-
-  if ("featureTable"s == str)
-    return property("featureTable", this->_featureTable, o.featureTable);
-  if ("featureIds"s == str)
-    return property("featureIds", this->_featureIds, o.featureIds);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 10:
+    if ("featureIds"sv == str)
+      return property("featureIds", this->_featureIds, o.featureIds);
+    break;
+  case 12:
+    if ("featureTable"sv == str)
+      return property("featureTable", this->_featureTable, o.featureTable);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -4184,12 +4479,18 @@ ExtensionExtFeatureMetadataTextureAccessorJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataTextureAccessor& o) {
-  using namespace std::string_literals;
-
-  if ("channels"s == str)
-    return property("channels", this->_channels, o.channels);
-  if ("texture"s == str)
-    return property("texture", this->_texture, o.texture);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 7:
+    if ("texture"sv == str)
+      return property("texture", this->_texture, o.texture);
+    break;
+  case 8:
+    if ("channels"sv == str)
+      return property("channels", this->_channels, o.channels);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -4282,12 +4583,18 @@ ExtensionExtFeatureMetadataFeatureIDAttributeJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataFeatureIDAttribute& o) {
-  using namespace std::string_literals;
-
-  if ("featureTable"s == str)
-    return property("featureTable", this->_featureTable, o.featureTable);
-  if ("featureIds"s == str)
-    return property("featureIds", this->_featureIds, o.featureIds);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 10:
+    if ("featureIds"sv == str)
+      return property("featureIds", this->_featureIds, o.featureIds);
+    break;
+  case 12:
+    if ("featureTable"sv == str)
+      return property("featureTable", this->_featureTable, o.featureTable);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -4383,14 +4690,22 @@ ExtensionExtFeatureMetadataFeatureIDsJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataFeatureIDs& o) {
-  using namespace std::string_literals;
-
-  if ("attribute"s == str)
-    return property("attribute", this->_attribute, o.attribute);
-  if ("constant"s == str)
-    return property("constant", this->_constant, o.constant);
-  if ("divisor"s == str)
-    return property("divisor", this->_divisor, o.divisor);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 7:
+    if ("divisor"sv == str)
+      return property("divisor", this->_divisor, o.divisor);
+    break;
+  case 8:
+    if ("constant"sv == str)
+      return property("constant", this->_constant, o.constant);
+    break;
+  case 9:
+    if ("attribute"sv == str)
+      return property("attribute", this->_attribute, o.attribute);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -4483,12 +4798,18 @@ ExtensionExtFeatureMetadataFeatureTextureJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataFeatureTexture& o) {
-  using namespace std::string_literals;
-
-  if ("class"s == str)
-    return property("class", this->_classProperty, o.classProperty);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("class"sv == str)
+      return property("class", this->_classProperty, o.classProperty);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -4582,14 +4903,20 @@ ExtensionExtFeatureMetadataFeatureTableJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataFeatureTable& o) {
-  using namespace std::string_literals;
-
-  if ("class"s == str)
-    return property("class", this->_classProperty, o.classProperty);
-  if ("count"s == str)
-    return property("count", this->_count, o.count);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("class"sv == str)
+      return property("class", this->_classProperty, o.classProperty);
+    if ("count"sv == str)
+      return property("count", this->_count, o.count);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -4684,22 +5011,30 @@ ExtensionExtFeatureMetadataFeatureTablePropertyJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataFeatureTableProperty& o) {
-  using namespace std::string_literals;
-
-  if ("bufferView"s == str)
-    return property("bufferView", this->_bufferView, o.bufferView);
-  if ("offsetType"s == str)
-    return property("offsetType", this->_offsetType, o.offsetType);
-  if ("arrayOffsetBufferView"s == str)
-    return property(
-        "arrayOffsetBufferView",
-        this->_arrayOffsetBufferView,
-        o.arrayOffsetBufferView);
-  if ("stringOffsetBufferView"s == str)
-    return property(
-        "stringOffsetBufferView",
-        this->_stringOffsetBufferView,
-        o.stringOffsetBufferView);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 10:
+    if ("bufferView"sv == str)
+      return property("bufferView", this->_bufferView, o.bufferView);
+    if ("offsetType"sv == str)
+      return property("offsetType", this->_offsetType, o.offsetType);
+    break;
+  case 21:
+    if ("arrayOffsetBufferView"sv == str)
+      return property(
+          "arrayOffsetBufferView",
+          this->_arrayOffsetBufferView,
+          o.arrayOffsetBufferView);
+    break;
+  case 22:
+    if ("stringOffsetBufferView"sv == str)
+      return property(
+          "stringOffsetBufferView",
+          this->_stringOffsetBufferView,
+          o.stringOffsetBufferView);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -4793,10 +5128,14 @@ ExtensionExtFeatureMetadataStatisticsJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataStatistics& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("classes"s == str)
-    return property("classes", this->_classes, o.classes);
+  switch (str.size()) {
+  case 7:
+    if ("classes"sv == str)
+      return property("classes", this->_classes, o.classes);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -4889,12 +5228,18 @@ ExtensionExtFeatureMetadataClassStatisticsJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataClassStatistics& o) {
-  using namespace std::string_literals;
-
-  if ("count"s == str)
-    return property("count", this->_count, o.count);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("count"sv == str)
+      return property("count", this->_count, o.count);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -4993,27 +5338,41 @@ ExtensionExtFeatureMetadataPropertyStatisticsJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataPropertyStatistics& o) {
-  using namespace std::string_literals;
-
-  if ("min"s == str)
-    return property("min", this->_min, o.min);
-  if ("max"s == str)
-    return property("max", this->_max, o.max);
-  if ("mean"s == str)
-    return property("mean", this->_mean, o.mean);
-  if ("median"s == str)
-    return property("median", this->_median, o.median);
-  if ("standardDeviation"s == str)
-    return property(
-        "standardDeviation",
-        this->_standardDeviation,
-        o.standardDeviation);
-  if ("variance"s == str)
-    return property("variance", this->_variance, o.variance);
-  if ("sum"s == str)
-    return property("sum", this->_sum, o.sum);
-  if ("occurrences"s == str)
-    return property("occurrences", this->_occurrences, o.occurrences);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("min"sv == str)
+      return property("min", this->_min, o.min);
+    if ("max"sv == str)
+      return property("max", this->_max, o.max);
+    if ("sum"sv == str)
+      return property("sum", this->_sum, o.sum);
+    break;
+  case 4:
+    if ("mean"sv == str)
+      return property("mean", this->_mean, o.mean);
+    break;
+  case 6:
+    if ("median"sv == str)
+      return property("median", this->_median, o.median);
+    break;
+  case 8:
+    if ("variance"sv == str)
+      return property("variance", this->_variance, o.variance);
+    break;
+  case 11:
+    if ("occurrences"sv == str)
+      return property("occurrences", this->_occurrences, o.occurrences);
+    break;
+  case 17:
+    if ("standardDeviation"sv == str)
+      return property(
+          "standardDeviation",
+          this->_standardDeviation,
+          o.standardDeviation);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -5110,18 +5469,28 @@ CesiumJsonReader::IJsonHandler* ExtensionExtFeatureMetadataSchemaJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataSchema& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("version"s == str)
-    return property("version", this->_version, o.version);
-  if ("classes"s == str)
-    return property("classes", this->_classes, o.classes);
-  if ("enums"s == str)
-    return property("enums", this->_enums, o.enums);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 5:
+    if ("enums"sv == str)
+      return property("enums", this->_enums, o.enums);
+    break;
+  case 7:
+    if ("version"sv == str)
+      return property("version", this->_version, o.version);
+    if ("classes"sv == str)
+      return property("classes", this->_classes, o.classes);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -5213,16 +5582,26 @@ CesiumJsonReader::IJsonHandler* ExtensionExtFeatureMetadataEnumJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataEnum& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("valueType"s == str)
-    return property("valueType", this->_valueType, o.valueType);
-  if ("values"s == str)
-    return property("values", this->_values, o.values);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 6:
+    if ("values"sv == str)
+      return property("values", this->_values, o.values);
+    break;
+  case 9:
+    if ("valueType"sv == str)
+      return property("valueType", this->_valueType, o.valueType);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -5313,14 +5692,22 @@ ExtensionExtFeatureMetadataEnumValueJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataEnumValue& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("value"s == str)
-    return property("value", this->_value, o.value);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 5:
+    if ("value"sv == str)
+      return property("value", this->_value, o.value);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -5413,14 +5800,22 @@ CesiumJsonReader::IJsonHandler* ExtensionExtFeatureMetadataClassJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataClass& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("properties"s == str)
-    return property("properties", this->_properties, o.properties);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    break;
+  case 10:
+    if ("properties"sv == str)
+      return property("properties", this->_properties, o.properties);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -5521,32 +5916,53 @@ ExtensionExtFeatureMetadataClassPropertyJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::ExtensionExtFeatureMetadataClassProperty& o) {
-  using namespace std::string_literals;
-
-  if ("name"s == str)
-    return property("name", this->_name, o.name);
-  if ("description"s == str)
-    return property("description", this->_description, o.description);
-  if ("type"s == str)
-    return property("type", this->_type, o.type);
-  if ("enumType"s == str)
-    return property("enumType", this->_enumType, o.enumType);
-  if ("componentType"s == str)
-    return property("componentType", this->_componentType, o.componentType);
-  if ("componentCount"s == str)
-    return property("componentCount", this->_componentCount, o.componentCount);
-  if ("normalized"s == str)
-    return property("normalized", this->_normalized, o.normalized);
-  if ("max"s == str)
-    return property("max", this->_max, o.max);
-  if ("min"s == str)
-    return property("min", this->_min, o.min);
-  if ("default"s == str)
-    return property("default", this->_defaultProperty, o.defaultProperty);
-  if ("optional"s == str)
-    return property("optional", this->_optional, o.optional);
-  if ("semantic"s == str)
-    return property("semantic", this->_semantic, o.semantic);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("max"sv == str)
+      return property("max", this->_max, o.max);
+    if ("min"sv == str)
+      return property("min", this->_min, o.min);
+    break;
+  case 4:
+    if ("name"sv == str)
+      return property("name", this->_name, o.name);
+    if ("type"sv == str)
+      return property("type", this->_type, o.type);
+    break;
+  case 7:
+    if ("default"sv == str)
+      return property("default", this->_defaultProperty, o.defaultProperty);
+    break;
+  case 8:
+    if ("enumType"sv == str)
+      return property("enumType", this->_enumType, o.enumType);
+    if ("optional"sv == str)
+      return property("optional", this->_optional, o.optional);
+    if ("semantic"sv == str)
+      return property("semantic", this->_semantic, o.semantic);
+    break;
+  case 10:
+    if ("normalized"sv == str)
+      return property("normalized", this->_normalized, o.normalized);
+    break;
+  case 11:
+    if ("description"sv == str)
+      return property("description", this->_description, o.description);
+    break;
+  case 13:
+    if ("componentType"sv == str)
+      return property("componentType", this->_componentType, o.componentType);
+    break;
+  case 14:
+    if ("componentCount"sv == str)
+      return property(
+          "componentCount",
+          this->_componentCount,
+          o.componentCount);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -5650,45 +6066,68 @@ CesiumJsonReader::IJsonHandler* ModelJsonHandler::readObjectKeyModel(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Model& o) {
-  using namespace std::string_literals;
-
-  if ("extensionsUsed"s == str)
-    return property("extensionsUsed", this->_extensionsUsed, o.extensionsUsed);
-  if ("extensionsRequired"s == str)
-    return property(
-        "extensionsRequired",
-        this->_extensionsRequired,
-        o.extensionsRequired);
-  if ("accessors"s == str)
-    return property("accessors", this->_accessors, o.accessors);
-  if ("animations"s == str)
-    return property("animations", this->_animations, o.animations);
-  if ("asset"s == str)
-    return property("asset", this->_asset, o.asset);
-  if ("buffers"s == str)
-    return property("buffers", this->_buffers, o.buffers);
-  if ("bufferViews"s == str)
-    return property("bufferViews", this->_bufferViews, o.bufferViews);
-  if ("cameras"s == str)
-    return property("cameras", this->_cameras, o.cameras);
-  if ("images"s == str)
-    return property("images", this->_images, o.images);
-  if ("materials"s == str)
-    return property("materials", this->_materials, o.materials);
-  if ("meshes"s == str)
-    return property("meshes", this->_meshes, o.meshes);
-  if ("nodes"s == str)
-    return property("nodes", this->_nodes, o.nodes);
-  if ("samplers"s == str)
-    return property("samplers", this->_samplers, o.samplers);
-  if ("scene"s == str)
-    return property("scene", this->_scene, o.scene);
-  if ("scenes"s == str)
-    return property("scenes", this->_scenes, o.scenes);
-  if ("skins"s == str)
-    return property("skins", this->_skins, o.skins);
-  if ("textures"s == str)
-    return property("textures", this->_textures, o.textures);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("asset"sv == str)
+      return property("asset", this->_asset, o.asset);
+    if ("nodes"sv == str)
+      return property("nodes", this->_nodes, o.nodes);
+    if ("scene"sv == str)
+      return property("scene", this->_scene, o.scene);
+    if ("skins"sv == str)
+      return property("skins", this->_skins, o.skins);
+    break;
+  case 6:
+    if ("images"sv == str)
+      return property("images", this->_images, o.images);
+    if ("meshes"sv == str)
+      return property("meshes", this->_meshes, o.meshes);
+    if ("scenes"sv == str)
+      return property("scenes", this->_scenes, o.scenes);
+    break;
+  case 7:
+    if ("buffers"sv == str)
+      return property("buffers", this->_buffers, o.buffers);
+    if ("cameras"sv == str)
+      return property("cameras", this->_cameras, o.cameras);
+    break;
+  case 8:
+    if ("samplers"sv == str)
+      return property("samplers", this->_samplers, o.samplers);
+    if ("textures"sv == str)
+      return property("textures", this->_textures, o.textures);
+    break;
+  case 9:
+    if ("accessors"sv == str)
+      return property("accessors", this->_accessors, o.accessors);
+    if ("materials"sv == str)
+      return property("materials", this->_materials, o.materials);
+    break;
+  case 10:
+    if ("animations"sv == str)
+      return property("animations", this->_animations, o.animations);
+    break;
+  case 11:
+    if ("bufferViews"sv == str)
+      return property("bufferViews", this->_bufferViews, o.bufferViews);
+    break;
+  case 14:
+    if ("extensionsUsed"sv == str)
+      return property(
+          "extensionsUsed",
+          this->_extensionsUsed,
+          o.extensionsUsed);
+    break;
+  case 18:
+    if ("extensionsRequired"sv == str)
+      return property(
+          "extensionsRequired",
+          this->_extensionsRequired,
+          o.extensionsRequired);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -5764,12 +6203,18 @@ CesiumJsonReader::IJsonHandler* TextureJsonHandler::readObjectKeyTexture(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Texture& o) {
-  using namespace std::string_literals;
-
-  if ("sampler"s == str)
-    return property("sampler", this->_sampler, o.sampler);
-  if ("source"s == str)
-    return property("source", this->_source, o.source);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 6:
+    if ("source"sv == str)
+      return property("source", this->_source, o.source);
+    break;
+  case 7:
+    if ("sampler"sv == str)
+      return property("sampler", this->_sampler, o.sampler);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -5846,17 +6291,25 @@ CesiumJsonReader::IJsonHandler* SkinJsonHandler::readObjectKeySkin(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Skin& o) {
-  using namespace std::string_literals;
-
-  if ("inverseBindMatrices"s == str)
-    return property(
-        "inverseBindMatrices",
-        this->_inverseBindMatrices,
-        o.inverseBindMatrices);
-  if ("skeleton"s == str)
-    return property("skeleton", this->_skeleton, o.skeleton);
-  if ("joints"s == str)
-    return property("joints", this->_joints, o.joints);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 6:
+    if ("joints"sv == str)
+      return property("joints", this->_joints, o.joints);
+    break;
+  case 8:
+    if ("skeleton"sv == str)
+      return property("skeleton", this->_skeleton, o.skeleton);
+    break;
+  case 19:
+    if ("inverseBindMatrices"sv == str)
+      return property(
+          "inverseBindMatrices",
+          this->_inverseBindMatrices,
+          o.inverseBindMatrices);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -5930,10 +6383,14 @@ CesiumJsonReader::IJsonHandler* SceneJsonHandler::readObjectKeyScene(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Scene& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("nodes"s == str)
-    return property("nodes", this->_nodes, o.nodes);
+  switch (str.size()) {
+  case 5:
+    if ("nodes"sv == str)
+      return property("nodes", this->_nodes, o.nodes);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -6011,16 +6468,22 @@ CesiumJsonReader::IJsonHandler* SamplerJsonHandler::readObjectKeySampler(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Sampler& o) {
-  using namespace std::string_literals;
-
-  if ("magFilter"s == str)
-    return property("magFilter", this->_magFilter, o.magFilter);
-  if ("minFilter"s == str)
-    return property("minFilter", this->_minFilter, o.minFilter);
-  if ("wrapS"s == str)
-    return property("wrapS", this->_wrapS, o.wrapS);
-  if ("wrapT"s == str)
-    return property("wrapT", this->_wrapT, o.wrapT);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("wrapS"sv == str)
+      return property("wrapS", this->_wrapS, o.wrapS);
+    if ("wrapT"sv == str)
+      return property("wrapT", this->_wrapT, o.wrapT);
+    break;
+  case 9:
+    if ("magFilter"sv == str)
+      return property("magFilter", this->_magFilter, o.magFilter);
+    if ("minFilter"sv == str)
+      return property("minFilter", this->_minFilter, o.minFilter);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -6103,26 +6566,40 @@ CesiumJsonReader::IJsonHandler* NodeJsonHandler::readObjectKeyNode(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Node& o) {
-  using namespace std::string_literals;
-
-  if ("camera"s == str)
-    return property("camera", this->_camera, o.camera);
-  if ("children"s == str)
-    return property("children", this->_children, o.children);
-  if ("skin"s == str)
-    return property("skin", this->_skin, o.skin);
-  if ("matrix"s == str)
-    return property("matrix", this->_matrix, o.matrix);
-  if ("mesh"s == str)
-    return property("mesh", this->_mesh, o.mesh);
-  if ("rotation"s == str)
-    return property("rotation", this->_rotation, o.rotation);
-  if ("scale"s == str)
-    return property("scale", this->_scale, o.scale);
-  if ("translation"s == str)
-    return property("translation", this->_translation, o.translation);
-  if ("weights"s == str)
-    return property("weights", this->_weights, o.weights);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("skin"sv == str)
+      return property("skin", this->_skin, o.skin);
+    if ("mesh"sv == str)
+      return property("mesh", this->_mesh, o.mesh);
+    break;
+  case 5:
+    if ("scale"sv == str)
+      return property("scale", this->_scale, o.scale);
+    break;
+  case 6:
+    if ("camera"sv == str)
+      return property("camera", this->_camera, o.camera);
+    if ("matrix"sv == str)
+      return property("matrix", this->_matrix, o.matrix);
+    break;
+  case 7:
+    if ("weights"sv == str)
+      return property("weights", this->_weights, o.weights);
+    break;
+  case 8:
+    if ("children"sv == str)
+      return property("children", this->_children, o.children);
+    if ("rotation"sv == str)
+      return property("rotation", this->_rotation, o.rotation);
+    break;
+  case 11:
+    if ("translation"sv == str)
+      return property("translation", this->_translation, o.translation);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -6198,12 +6675,18 @@ CesiumJsonReader::IJsonHandler* MeshJsonHandler::readObjectKeyMesh(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Mesh& o) {
-  using namespace std::string_literals;
-
-  if ("primitives"s == str)
-    return property("primitives", this->_primitives, o.primitives);
-  if ("weights"s == str)
-    return property("weights", this->_weights, o.weights);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 7:
+    if ("weights"sv == str)
+      return property("weights", this->_weights, o.weights);
+    break;
+  case 10:
+    if ("primitives"sv == str)
+      return property("primitives", this->_primitives, o.primitives);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -6283,18 +6766,28 @@ MeshPrimitiveJsonHandler::readObjectKeyMeshPrimitive(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::MeshPrimitive& o) {
-  using namespace std::string_literals;
-
-  if ("attributes"s == str)
-    return property("attributes", this->_attributes, o.attributes);
-  if ("indices"s == str)
-    return property("indices", this->_indices, o.indices);
-  if ("material"s == str)
-    return property("material", this->_material, o.material);
-  if ("mode"s == str)
-    return property("mode", this->_mode, o.mode);
-  if ("targets"s == str)
-    return property("targets", this->_targets, o.targets);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("mode"sv == str)
+      return property("mode", this->_mode, o.mode);
+    break;
+  case 7:
+    if ("indices"sv == str)
+      return property("indices", this->_indices, o.indices);
+    if ("targets"sv == str)
+      return property("targets", this->_targets, o.targets);
+    break;
+  case 8:
+    if ("material"sv == str)
+      return property("material", this->_material, o.material);
+    break;
+  case 10:
+    if ("attributes"sv == str)
+      return property("attributes", this->_attributes, o.attributes);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -6381,33 +6874,52 @@ CesiumJsonReader::IJsonHandler* MaterialJsonHandler::readObjectKeyMaterial(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Material& o) {
-  using namespace std::string_literals;
-
-  if ("pbrMetallicRoughness"s == str)
-    return property(
-        "pbrMetallicRoughness",
-        this->_pbrMetallicRoughness,
-        o.pbrMetallicRoughness);
-  if ("normalTexture"s == str)
-    return property("normalTexture", this->_normalTexture, o.normalTexture);
-  if ("occlusionTexture"s == str)
-    return property(
-        "occlusionTexture",
-        this->_occlusionTexture,
-        o.occlusionTexture);
-  if ("emissiveTexture"s == str)
-    return property(
-        "emissiveTexture",
-        this->_emissiveTexture,
-        o.emissiveTexture);
-  if ("emissiveFactor"s == str)
-    return property("emissiveFactor", this->_emissiveFactor, o.emissiveFactor);
-  if ("alphaMode"s == str)
-    return property("alphaMode", this->_alphaMode, o.alphaMode);
-  if ("alphaCutoff"s == str)
-    return property("alphaCutoff", this->_alphaCutoff, o.alphaCutoff);
-  if ("doubleSided"s == str)
-    return property("doubleSided", this->_doubleSided, o.doubleSided);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 9:
+    if ("alphaMode"sv == str)
+      return property("alphaMode", this->_alphaMode, o.alphaMode);
+    break;
+  case 11:
+    if ("alphaCutoff"sv == str)
+      return property("alphaCutoff", this->_alphaCutoff, o.alphaCutoff);
+    if ("doubleSided"sv == str)
+      return property("doubleSided", this->_doubleSided, o.doubleSided);
+    break;
+  case 13:
+    if ("normalTexture"sv == str)
+      return property("normalTexture", this->_normalTexture, o.normalTexture);
+    break;
+  case 14:
+    if ("emissiveFactor"sv == str)
+      return property(
+          "emissiveFactor",
+          this->_emissiveFactor,
+          o.emissiveFactor);
+    break;
+  case 15:
+    if ("emissiveTexture"sv == str)
+      return property(
+          "emissiveTexture",
+          this->_emissiveTexture,
+          o.emissiveTexture);
+    break;
+  case 16:
+    if ("occlusionTexture"sv == str)
+      return property(
+          "occlusionTexture",
+          this->_occlusionTexture,
+          o.occlusionTexture);
+    break;
+  case 20:
+    if ("pbrMetallicRoughness"sv == str)
+      return property(
+          "pbrMetallicRoughness",
+          this->_pbrMetallicRoughness,
+          o.pbrMetallicRoughness);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -6484,10 +6996,14 @@ CesiumJsonReader::IJsonHandler* MaterialOcclusionTextureInfoJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::MaterialOcclusionTextureInfo& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("strength"s == str)
-    return property("strength", this->_strength, o.strength);
+  switch (str.size()) {
+  case 8:
+    if ("strength"sv == str)
+      return property("strength", this->_strength, o.strength);
+    break;
+  }
 
   return this->readObjectKeyTextureInfo(objectType, str, *this->_pObject);
 }
@@ -6573,10 +7089,14 @@ MaterialNormalTextureInfoJsonHandler::readObjectKeyMaterialNormalTextureInfo(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::MaterialNormalTextureInfo& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("scale"s == str)
-    return property("scale", this->_scale, o.scale);
+  switch (str.size()) {
+  case 5:
+    if ("scale"sv == str)
+      return property("scale", this->_scale, o.scale);
+    break;
+  }
 
   return this->readObjectKeyTextureInfo(objectType, str, *this->_pObject);
 }
@@ -6668,30 +7188,43 @@ CesiumJsonReader::IJsonHandler* MaterialPBRMetallicRoughnessJsonHandler::
         const std::string& objectType,
         const std::string_view& str,
         CesiumGltf::MaterialPBRMetallicRoughness& o) {
-  using namespace std::string_literals;
-
-  if ("baseColorFactor"s == str)
-    return property(
-        "baseColorFactor",
-        this->_baseColorFactor,
-        o.baseColorFactor);
-  if ("baseColorTexture"s == str)
-    return property(
-        "baseColorTexture",
-        this->_baseColorTexture,
-        o.baseColorTexture);
-  if ("metallicFactor"s == str)
-    return property("metallicFactor", this->_metallicFactor, o.metallicFactor);
-  if ("roughnessFactor"s == str)
-    return property(
-        "roughnessFactor",
-        this->_roughnessFactor,
-        o.roughnessFactor);
-  if ("metallicRoughnessTexture"s == str)
-    return property(
-        "metallicRoughnessTexture",
-        this->_metallicRoughnessTexture,
-        o.metallicRoughnessTexture);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 14:
+    if ("metallicFactor"sv == str)
+      return property(
+          "metallicFactor",
+          this->_metallicFactor,
+          o.metallicFactor);
+    break;
+  case 15:
+    if ("baseColorFactor"sv == str)
+      return property(
+          "baseColorFactor",
+          this->_baseColorFactor,
+          o.baseColorFactor);
+    if ("roughnessFactor"sv == str)
+      return property(
+          "roughnessFactor",
+          this->_roughnessFactor,
+          o.roughnessFactor);
+    break;
+  case 16:
+    if ("baseColorTexture"sv == str)
+      return property(
+          "baseColorTexture",
+          this->_baseColorTexture,
+          o.baseColorTexture);
+    break;
+  case 24:
+    if ("metallicRoughnessTexture"sv == str)
+      return property(
+          "metallicRoughnessTexture",
+          this->_metallicRoughnessTexture,
+          o.metallicRoughnessTexture);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -6778,14 +7311,22 @@ CesiumJsonReader::IJsonHandler* ImageJsonHandler::readObjectKeyImage(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Image& o) {
-  using namespace std::string_literals;
-
-  if ("uri"s == str)
-    return property("uri", this->_uri, o.uri);
-  if ("mimeType"s == str)
-    return property("mimeType", this->_mimeType, o.mimeType);
-  if ("bufferView"s == str)
-    return property("bufferView", this->_bufferView, o.bufferView);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("uri"sv == str)
+      return property("uri", this->_uri, o.uri);
+    break;
+  case 8:
+    if ("mimeType"sv == str)
+      return property("mimeType", this->_mimeType, o.mimeType);
+    break;
+  case 10:
+    if ("bufferView"sv == str)
+      return property("bufferView", this->_bufferView, o.bufferView);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -6862,14 +7403,22 @@ CesiumJsonReader::IJsonHandler* CameraJsonHandler::readObjectKeyCamera(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Camera& o) {
-  using namespace std::string_literals;
-
-  if ("orthographic"s == str)
-    return property("orthographic", this->_orthographic, o.orthographic);
-  if ("perspective"s == str)
-    return property("perspective", this->_perspective, o.perspective);
-  if ("type"s == str)
-    return property("type", this->_type, o.type);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("type"sv == str)
+      return property("type", this->_type, o.type);
+    break;
+  case 11:
+    if ("perspective"sv == str)
+      return property("perspective", this->_perspective, o.perspective);
+    break;
+  case 12:
+    if ("orthographic"sv == str)
+      return property("orthographic", this->_orthographic, o.orthographic);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -6948,16 +7497,24 @@ CameraPerspectiveJsonHandler::readObjectKeyCameraPerspective(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::CameraPerspective& o) {
-  using namespace std::string_literals;
-
-  if ("aspectRatio"s == str)
-    return property("aspectRatio", this->_aspectRatio, o.aspectRatio);
-  if ("yfov"s == str)
-    return property("yfov", this->_yfov, o.yfov);
-  if ("zfar"s == str)
-    return property("zfar", this->_zfar, o.zfar);
-  if ("znear"s == str)
-    return property("znear", this->_znear, o.znear);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("yfov"sv == str)
+      return property("yfov", this->_yfov, o.yfov);
+    if ("zfar"sv == str)
+      return property("zfar", this->_zfar, o.zfar);
+    break;
+  case 5:
+    if ("znear"sv == str)
+      return property("znear", this->_znear, o.znear);
+    break;
+  case 11:
+    if ("aspectRatio"sv == str)
+      return property("aspectRatio", this->_aspectRatio, o.aspectRatio);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -7043,16 +7600,22 @@ CameraOrthographicJsonHandler::readObjectKeyCameraOrthographic(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::CameraOrthographic& o) {
-  using namespace std::string_literals;
-
-  if ("xmag"s == str)
-    return property("xmag", this->_xmag, o.xmag);
-  if ("ymag"s == str)
-    return property("ymag", this->_ymag, o.ymag);
-  if ("zfar"s == str)
-    return property("zfar", this->_zfar, o.zfar);
-  if ("znear"s == str)
-    return property("znear", this->_znear, o.znear);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 4:
+    if ("xmag"sv == str)
+      return property("xmag", this->_xmag, o.xmag);
+    if ("ymag"sv == str)
+      return property("ymag", this->_ymag, o.ymag);
+    if ("zfar"sv == str)
+      return property("zfar", this->_zfar, o.zfar);
+    break;
+  case 5:
+    if ("znear"sv == str)
+      return property("znear", this->_znear, o.znear);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -7138,18 +7701,24 @@ CesiumJsonReader::IJsonHandler* BufferViewJsonHandler::readObjectKeyBufferView(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::BufferView& o) {
-  using namespace std::string_literals;
-
-  if ("buffer"s == str)
-    return property("buffer", this->_buffer, o.buffer);
-  if ("byteOffset"s == str)
-    return property("byteOffset", this->_byteOffset, o.byteOffset);
-  if ("byteLength"s == str)
-    return property("byteLength", this->_byteLength, o.byteLength);
-  if ("byteStride"s == str)
-    return property("byteStride", this->_byteStride, o.byteStride);
-  if ("target"s == str)
-    return property("target", this->_target, o.target);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 6:
+    if ("buffer"sv == str)
+      return property("buffer", this->_buffer, o.buffer);
+    if ("target"sv == str)
+      return property("target", this->_target, o.target);
+    break;
+  case 10:
+    if ("byteOffset"sv == str)
+      return property("byteOffset", this->_byteOffset, o.byteOffset);
+    if ("byteLength"sv == str)
+      return property("byteLength", this->_byteLength, o.byteLength);
+    if ("byteStride"sv == str)
+      return property("byteStride", this->_byteStride, o.byteStride);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -7227,12 +7796,18 @@ CesiumJsonReader::IJsonHandler* BufferJsonHandler::readObjectKeyBuffer(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Buffer& o) {
-  using namespace std::string_literals;
-
-  if ("uri"s == str)
-    return property("uri", this->_uri, o.uri);
-  if ("byteLength"s == str)
-    return property("byteLength", this->_byteLength, o.byteLength);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("uri"sv == str)
+      return property("uri", this->_uri, o.uri);
+    break;
+  case 10:
+    if ("byteLength"sv == str)
+      return property("byteLength", this->_byteLength, o.byteLength);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -7310,16 +7885,24 @@ CesiumJsonReader::IJsonHandler* AssetJsonHandler::readObjectKeyAsset(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Asset& o) {
-  using namespace std::string_literals;
-
-  if ("copyright"s == str)
-    return property("copyright", this->_copyright, o.copyright);
-  if ("generator"s == str)
-    return property("generator", this->_generator, o.generator);
-  if ("version"s == str)
-    return property("version", this->_version, o.version);
-  if ("minVersion"s == str)
-    return property("minVersion", this->_minVersion, o.minVersion);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 7:
+    if ("version"sv == str)
+      return property("version", this->_version, o.version);
+    break;
+  case 9:
+    if ("copyright"sv == str)
+      return property("copyright", this->_copyright, o.copyright);
+    if ("generator"sv == str)
+      return property("generator", this->_generator, o.generator);
+    break;
+  case 10:
+    if ("minVersion"sv == str)
+      return property("minVersion", this->_minVersion, o.minVersion);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -7395,12 +7978,16 @@ CesiumJsonReader::IJsonHandler* AnimationJsonHandler::readObjectKeyAnimation(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Animation& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("channels"s == str)
-    return property("channels", this->_channels, o.channels);
-  if ("samplers"s == str)
-    return property("samplers", this->_samplers, o.samplers);
+  switch (str.size()) {
+  case 8:
+    if ("channels"sv == str)
+      return property("channels", this->_channels, o.channels);
+    if ("samplers"sv == str)
+      return property("samplers", this->_samplers, o.samplers);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -7479,14 +8066,22 @@ AnimationSamplerJsonHandler::readObjectKeyAnimationSampler(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::AnimationSampler& o) {
-  using namespace std::string_literals;
-
-  if ("input"s == str)
-    return property("input", this->_input, o.input);
-  if ("interpolation"s == str)
-    return property("interpolation", this->_interpolation, o.interpolation);
-  if ("output"s == str)
-    return property("output", this->_output, o.output);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("input"sv == str)
+      return property("input", this->_input, o.input);
+    break;
+  case 6:
+    if ("output"sv == str)
+      return property("output", this->_output, o.output);
+    break;
+  case 13:
+    if ("interpolation"sv == str)
+      return property("interpolation", this->_interpolation, o.interpolation);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -7569,12 +8164,18 @@ AnimationChannelJsonHandler::readObjectKeyAnimationChannel(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::AnimationChannel& o) {
-  using namespace std::string_literals;
-
-  if ("sampler"s == str)
-    return property("sampler", this->_sampler, o.sampler);
-  if ("target"s == str)
-    return property("target", this->_target, o.target);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 6:
+    if ("target"sv == str)
+      return property("target", this->_target, o.target);
+    break;
+  case 7:
+    if ("sampler"sv == str)
+      return property("sampler", this->_sampler, o.sampler);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -7657,12 +8258,16 @@ AnimationChannelTargetJsonHandler::readObjectKeyAnimationChannelTarget(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::AnimationChannelTarget& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("node"s == str)
-    return property("node", this->_node, o.node);
-  if ("path"s == str)
-    return property("path", this->_path, o.path);
+  switch (str.size()) {
+  case 4:
+    if ("node"sv == str)
+      return property("node", this->_node, o.node);
+    if ("path"sv == str)
+      return property("path", this->_path, o.path);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -7755,26 +8360,40 @@ CesiumJsonReader::IJsonHandler* AccessorJsonHandler::readObjectKeyAccessor(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::Accessor& o) {
-  using namespace std::string_literals;
-
-  if ("bufferView"s == str)
-    return property("bufferView", this->_bufferView, o.bufferView);
-  if ("byteOffset"s == str)
-    return property("byteOffset", this->_byteOffset, o.byteOffset);
-  if ("componentType"s == str)
-    return property("componentType", this->_componentType, o.componentType);
-  if ("normalized"s == str)
-    return property("normalized", this->_normalized, o.normalized);
-  if ("count"s == str)
-    return property("count", this->_count, o.count);
-  if ("type"s == str)
-    return property("type", this->_type, o.type);
-  if ("max"s == str)
-    return property("max", this->_max, o.max);
-  if ("min"s == str)
-    return property("min", this->_min, o.min);
-  if ("sparse"s == str)
-    return property("sparse", this->_sparse, o.sparse);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 3:
+    if ("max"sv == str)
+      return property("max", this->_max, o.max);
+    if ("min"sv == str)
+      return property("min", this->_min, o.min);
+    break;
+  case 4:
+    if ("type"sv == str)
+      return property("type", this->_type, o.type);
+    break;
+  case 5:
+    if ("count"sv == str)
+      return property("count", this->_count, o.count);
+    break;
+  case 6:
+    if ("sparse"sv == str)
+      return property("sparse", this->_sparse, o.sparse);
+    break;
+  case 10:
+    if ("bufferView"sv == str)
+      return property("bufferView", this->_bufferView, o.bufferView);
+    if ("byteOffset"sv == str)
+      return property("byteOffset", this->_byteOffset, o.byteOffset);
+    if ("normalized"sv == str)
+      return property("normalized", this->_normalized, o.normalized);
+    break;
+  case 13:
+    if ("componentType"sv == str)
+      return property("componentType", this->_componentType, o.componentType);
+    break;
+  }
 
   return this->readObjectKeyNamedObject(objectType, str, *this->_pObject);
 }
@@ -7852,14 +8471,22 @@ AccessorSparseJsonHandler::readObjectKeyAccessorSparse(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::AccessorSparse& o) {
-  using namespace std::string_literals;
-
-  if ("count"s == str)
-    return property("count", this->_count, o.count);
-  if ("indices"s == str)
-    return property("indices", this->_indices, o.indices);
-  if ("values"s == str)
-    return property("values", this->_values, o.values);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 5:
+    if ("count"sv == str)
+      return property("count", this->_count, o.count);
+    break;
+  case 6:
+    if ("values"sv == str)
+      return property("values", this->_values, o.values);
+    break;
+  case 7:
+    if ("indices"sv == str)
+      return property("indices", this->_indices, o.indices);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -7941,12 +8568,16 @@ AccessorSparseValuesJsonHandler::readObjectKeyAccessorSparseValues(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::AccessorSparseValues& o) {
-  using namespace std::string_literals;
+  using namespace std::string_view_literals;
 
-  if ("bufferView"s == str)
-    return property("bufferView", this->_bufferView, o.bufferView);
-  if ("byteOffset"s == str)
-    return property("byteOffset", this->_byteOffset, o.byteOffset);
+  switch (str.size()) {
+  case 10:
+    if ("bufferView"sv == str)
+      return property("bufferView", this->_bufferView, o.bufferView);
+    if ("byteOffset"sv == str)
+      return property("byteOffset", this->_byteOffset, o.byteOffset);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -8031,14 +8662,20 @@ AccessorSparseIndicesJsonHandler::readObjectKeyAccessorSparseIndices(
     const std::string& objectType,
     const std::string_view& str,
     CesiumGltf::AccessorSparseIndices& o) {
-  using namespace std::string_literals;
-
-  if ("bufferView"s == str)
-    return property("bufferView", this->_bufferView, o.bufferView);
-  if ("byteOffset"s == str)
-    return property("byteOffset", this->_byteOffset, o.byteOffset);
-  if ("componentType"s == str)
-    return property("componentType", this->_componentType, o.componentType);
+  using namespace std::string_view_literals;
+
+  switch (str.size()) {
+  case 10:
+    if ("bufferView"sv == str)
+      return property("bufferView", this->_bufferView, o.bufferView);
+    if ("byteOffset"sv == str)
+      return property("byteOffset", this->_byteOffset, o.byteOffset);
+    break;
+  case 13:
+    if ("componentType"sv == str)
+      return property("componentType", this->_componentType, o.componentType);
+    break;
+  }
 
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CesiumGltfReader/Library.h"
+#include "CesiumGltfReader/TranscodedImageCache.h"
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/Future.h>
@@ -95,12 +96,35 @@ struct CESIUMGLTFREADER_API GltfReaderOptions {
    */
   bool decodeEmbeddedImages = true;
 
+  /**
+   * @brief Whether images are loaded at all.
+   *
+   * If this is false, no image is decoded or fetched, whether it is embedded,
+   * in a data URL, or external, regardless of {@link decodeEmbeddedImages}
+   * and {@link decodeDataUrls}. The images are kept with their `uri` and
+   * `bufferView`, but their {@link Image::cesium} is left empty. This is for
+   * models whose geometry is used without rendering them, such as for
+   * collision.
+   */
+  bool loadImages = true;
+
   /**
    * @brief Whether geometry compressed using the `KHR_draco_mesh_compression`
    * extension should be automatically decoded as part of the load process.
    */
   bool decodeDraco = true;
 
+  /**
+   * @brief The async system whose worker threads are used to decode the parts
+   * of a model that can be decoded independently in parallel. These are its
+   * embedded and data URL images, Draco-compressed primitives, and
+   * meshopt-compressed bufferViews.
+   *
+   * If this is `std::nullopt`, the model is decoded entirely in the thread
+   * that reads it. Either way, the result is the same.
+   */
+  std::optional<CesiumAsync::AsyncSystem> decodeAsyncSystem;
+
   /**
    * @brief Whether the mesh data are decompressed as part of the load process,
    * or left in the compressed format according to the EXT_meshopt_compression
@@ -115,6 +139,76 @@ struct CESIUMGLTFREADER_API GltfReaderOptions {
    */
   bool dequantizeMeshData = true;
 
+  /**
+   * @brief Decides which quantized attributes are kept as they are when
+   * {@link dequantizeMeshData} is true.
+   *
+   * It is called with the name and accessor of each quantized `POSITION`,
+   * `NORMAL`, `TANGENT`, and `TEXCOORD_n` attribute, and should return true
+   * if the renderer can use its values directly. Keeping them quantized uses
+   * a quarter to a half of the memory of the dequantized values. If this is
+   * not set, all of the attributes are dequantized.
+   */
+  std::function<bool(
+      const std::string& attributeName,
+      const CesiumGltf::Accessor& accessor)>
+      keepQuantizedAttribute;
+
+  /**
+   * @brief The names of the vertex attributes that are kept, or
+   * `std::nullopt` to keep all of them.
+   *
+   * The other attributes are removed from the primitives and their morph
+   * targets before the model is decoded, so the values of Draco-compressed
+   * attributes that are not required are not copied out of the decoded mesh,
+   * and meshopt-compressed bufferViews that only they used are not decoded.
+   * Accessors that are then no longer used lose their bufferView, and the
+   * bufferViews that only those accessors used are emptied and their bytes
+   * removed from the buffers in memory, so that they are not passed on to the
+   * renderer. The bufferViews themselves are kept so that the indices of the
+   * others do not change.
+   *
+   * The `POSITION` attribute is always kept, and so is `_BATCHID`, which the
+   * 3D Tiles 1.0 converters turn into a feature ID attribute after the model
+   * is read. Feature ID attributes that `EXT_mesh_features` refers to must be
+   * listed for the features to keep working.
+   */
+  std::optional<std::vector<std::string>> requiredAttributes;
+
+  /**
+   * @brief Determines whether a vertex attribute is kept according to
+   * {@link requiredAttributes}.
+   *
+   * @param attributeName The name of the attribute, such as `TEXCOORD_1`.
+   * @return True if the attribute is kept.
+   */
+  bool isAttributeRequired(const std::string& attributeName) const;
+
+  /**
+   * @brief Whether the 3D Tiles 1.0 converters of `Cesium3DTilesContent`
+   * upgrade the batch tables of `b3dm`, `i3dm`, and `pnts` content to
+   * `EXT_structural_metadata`.
+   *
+   * If this is false, the batch tables are ignored, and the `_BATCHID`
+   * attributes are not turned into feature ID attributes. The glTF reader
+   * itself does not use this option.
+   */
+  bool upgradeBatchTables = true;
+
+  /**
+   * @brief Whether the indexed triangle meshes are optimized for the GPU when
+   * they are loaded.
+   *
+   * The triangles are reordered so that their vertices are more likely to be
+   * in the GPU's vertex cache, the vertices are reordered in the order that
+   * the triangles use them, and 32-bit indices are narrowed to 16 bits when
+   * the mesh has fewer than 65536 vertices. This is done after the model is
+   * decoded and dequantized, and changes neither the triangles nor the
+   * counts of the accessors. The vertices of a primitive are not reordered
+   * when their accessors are also used elsewhere.
+   */
+  bool optimizeMeshes = false;
+
   /**
    * @brief  Whether the texture coordinates of a texture are transformed or
    * not, according to the KHR_texture_transform extension
@@ -126,6 +220,30 @@ struct CESIUMGLTFREADER_API GltfReaderOptions {
    * the ideal target gpu-compressed pixel format to transcode to.
    */
   CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets;
+
+  /**
+   * @brief The maximum width and height of the decoded images, or
+   * `std::nullopt` to decode them at their full size.
+   *
+   * Larger images are reduced to fit while keeping their aspect ratio. JPEG
+   * and WebP images are scaled by their decoders, which is faster and uses
+   * less memory than decoding them at their full size. A JPEG is decoded at
+   * the largest size up to an eighth of its full size that fits, so it may be
+   * somewhat smaller than the maximum. KTX2 images with mipmaps leave out the
+   * levels that are too large. Other uncompressed images are resized after
+   * they are decoded. GPU-compressed KTX2 images without mipmaps are not
+   * reduced.
+   */
+  std::optional<int32_t> maximumTextureSize;
+
+  /**
+   * @brief The cache of transcoded KTX2 images, or nullptr to transcode every
+   * KTX2 image that is read.
+   *
+   * A cache shared by several readers, or kept across many reads, avoids
+   * transcoding the same texture again when it is used by several models.
+   */
+  std::shared_ptr<TranscodedImageCache> pTranscodedImageCache;
 };
 
 /**
@@ -159,6 +277,25 @@ public:
       const gsl::span<const std::byte>& data,
       const GltfReaderOptions& options = GltfReaderOptions()) const;
 
+  /**
+   * @brief Reads a glTF or binary glTF (GLB) from a buffer that the reader
+   * takes ownership of.
+   *
+   * The binary chunk of a GLB is moved to the front of `data`, which then
+   * becomes the data of the first buffer, instead of being copied into a new
+   * allocation. This avoids holding two copies of a large model in memory at
+   * once. The strings of the JSON are also decoded in place in `data`, with
+   * {@link CesiumJsonReader::JsonReader::readJsonInSitu}, unless an extension
+   * is set to `ExtensionState::Deferred`.
+   *
+   * @param data The buffer from which to read the glTF.
+   * @param options Options for how to read the glTF.
+   * @return The result of reading the glTF.
+   */
+  GltfReaderResult readGltf(
+      std::vector<std::byte>&& data,
+      const GltfReaderOptions& options = GltfReaderOptions()) const;
+
   /**
    * @brief Accepts the result of {@link readGltf} and resolves any remaining
    * external buffers and images.
@@ -189,11 +326,30 @@ public:
    * @param ktx2TranscodeTargetFormat The compression format to transcode
    * KTX v2 textures into. If this is std::nullopt, KTX v2 textures will be
    * fully decompressed into raw pixels.
+   * @param maximumSize The maximum width and height of the image, as
+   * described by {@link GltfReaderOptions::maximumTextureSize}.
+   * @return The result of reading the image.
+   */
+  static ImageReaderResult readImage(
+      const gsl::span<const std::byte>& data,
+      const CesiumGltf::Ktx2TranscodeTargets& ktx2TranscodeTargets,
+      const std::optional<int32_t>& maximumSize = std::nullopt);
+
+  /**
+   * @brief Reads an image from a buffer, as it is read as part of a glTF.
+   *
+   * KTX v2 textures are transcoded to the
+   * {@link GltfReaderOptions::ktx2TranscodeTargets}, and found in or added to
+   * the {@link GltfReaderOptions::pTranscodedImageCache} if there is one. All
+   * images are limited to the {@link GltfReaderOptions::maximumTextureSize}.
+   *
+   * @param data The buffer from which to read the image.
+   * @param options Options for how to read the glTF.
    * @return The result of reading the image.
    */
   static ImageReaderResult readImage(
       const gsl::span<const std::byte>& data,
-      const CesiumGltf::Ktx2TranscodeTargets& ktx2TranscodeTargets);
+      const GltfReaderOptions& options);
 
   /**
    * @brief Generate mipmaps for this image.
@@ -201,11 +357,19 @@ public:
    * Does nothing if mipmaps already exist or the compressedPixelFormat is not
    * GpuCompressedPixelFormat::NONE.
    *
-   * @param image The image to generate mipmaps for.   *
+   * Each level is computed from the previous one. When both of its
+   * dimensions are halved, as for images with power-of-two sizes, it is
+   * computed with a fast box filter. Otherwise it is resized with
+   * stb_image_resize.
+   *
+   * @param image The image to generate mipmaps for.
+   * @param sRGB Whether the color channels of the image are sRGB-encoded, in
+   * which case they are filtered in linear space so that the mipmaps do not
+   * get darker.
    * @return A string describing the error, if unable to generate mipmaps.
    */
   static std::optional<std::string>
-  generateMipMaps(CesiumGltf::ImageCesium& image);
+  generateMipMaps(CesiumGltf::ImageCesium& image, bool sRGB = false);
 
 private:
   CesiumJsonReader::JsonReaderOptions _context;
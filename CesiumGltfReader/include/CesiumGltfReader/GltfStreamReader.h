@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CesiumGltfReader/GltfReader.h"
+#include "CesiumGltfReader/Library.h"
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace CesiumGltfReader {
+
+/**
+ * @brief Reads a binary glTF (GLB) in pieces, as it is downloaded.
+ *
+ * The JSON chunk is parsed as soon as it has arrived, and the rest of the
+ * data is received straight into the binary buffer, so that little work is
+ * left by the time the download completes. Data that is not a GLB is ignored,
+ * and should be read with {@link GltfReader::readGltf} once it is complete.
+ *
+ * The pieces must be passed in order and one at a time, but may be passed
+ * from any thread.
+ */
+class CESIUMGLTFREADER_API GltfStreamReader {
+public:
+  /**
+   * @brief Creates a new instance.
+   *
+   * @param reader The reader whose extensions and options are used to read
+   * the glTF. It must outlive this instance.
+   */
+  explicit GltfStreamReader(const GltfReader& reader) noexcept;
+
+  /**
+   * @brief Receives the next piece of the data.
+   */
+  void append(const gsl::span<const std::byte>& data);
+
+  /**
+   * @brief Determines if all of a GLB, as given by the length in its header,
+   * has been received.
+   */
+  bool isComplete() const noexcept;
+
+  /**
+   * @brief Finishes reading the GLB, including decoding its images and
+   * compressed meshes, like {@link GltfReader::readGltf}.
+   *
+   * Call this once, after {@link isComplete} returns true.
+   *
+   * @param options Options for how to read the glTF.
+   * @return The result of reading the glTF.
+   */
+  GltfReaderResult finish(const GltfReaderOptions& options);
+
+private:
+  enum class Stage { Header, Json, BinaryHeader, Binary, Done, NotGlb };
+
+  void readChunkHeaders();
+  void stopReading() noexcept;
+
+  const GltfReader* _pReader;
+  Stage _stage;
+  std::vector<std::byte> _chunkHeaders;
+  size_t _chunkHeadersLength;
+  std::optional<GltfReaderResult> _jsonResult;
+  std::vector<std::byte> _binaryChunk;
+  uint32_t _binaryChunkLength;
+  uint32_t _glbLength;
+  size_t _bytesReceived;
+};
+
+} // namespace CesiumGltfReader
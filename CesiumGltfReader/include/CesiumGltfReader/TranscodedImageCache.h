@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CesiumGltfReader/Library.h"
+
+#include <CesiumGltf/ImageCesium.h>
+#include <CesiumGltf/Ktx2TranscodeTargets.h>
+#include <CesiumUtility/ContentHash.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace CesiumGltfReader {
+
+/**
+ * @brief A cache of the images transcoded from KTX2 images, keyed by a hash of
+ * the KTX2 data and by how it is transcoded.
+ *
+ * Transcoding a Basis Universal texture is one of the most expensive parts of
+ * reading a glTF, and the same texture is often used by many tiles. When a
+ * {@link GltfReaderOptions::pTranscodedImageCache} is set, a KTX2 image that
+ * has already been transcoded to the same targets and maximum size is copied
+ * from here instead. The same cache can be shared by several readers.
+ *
+ * When the cached images take more than {@link getMaximumBytes}, the least
+ * recently used are evicted. The cache may be used from any thread.
+ */
+class CESIUMGLTFREADER_API TranscodedImageCache {
+public:
+  /**
+   * @brief Identifies a transcoded image by the KTX2 data that it was
+   * transcoded from and by how it was transcoded.
+   */
+  struct Key {
+    /**
+     * @brief The hash of the KTX2 data.
+     */
+    CesiumUtility::ContentHash content;
+
+    /**
+     * @brief The formats that the KTX2 data was transcoded to.
+     */
+    CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets;
+
+    /**
+     * @brief The maximum width and height of the image, as described by
+     * {@link GltfReaderOptions::maximumTextureSize}.
+     */
+    std::optional<int32_t> maximumSize;
+
+    /**
+     * @brief Returns whether two keys identify the same transcoded image.
+     */
+    bool operator==(const Key& rhs) const noexcept {
+      return this->content == rhs.content &&
+             this->ktx2TranscodeTargets == rhs.ktx2TranscodeTargets &&
+             this->maximumSize == rhs.maximumSize;
+    }
+  };
+
+  /**
+   * @brief Creates an empty cache.
+   *
+   * @param maximumBytes The number of bytes that the cached images may take
+   * before the least recently used are evicted.
+   */
+  explicit TranscodedImageCache(
+      int64_t maximumBytes = 64 * 1024 * 1024) noexcept;
+
+  /**
+   * @brief Finds a transcoded image, and marks it as recently used.
+   *
+   * @param key The key of the image.
+   * @return A copy of the image, or std::nullopt if it is not cached.
+   */
+  std::optional<CesiumGltf::ImageCesium> find(const Key& key);
+
+  /**
+   * @brief Adds a transcoded image, replacing any that has the same key, and
+   * evicts the least recently used images while over {@link getMaximumBytes}.
+   *
+   * An image that is larger than {@link getMaximumBytes} is not added.
+   *
+   * @param key The key of the image.
+   * @param image The transcoded image.
+   */
+  void insert(const Key& key, const CesiumGltf::ImageCesium& image);
+
+  /**
+   * @brief Gets the number of bytes that the cached images may take before
+   * the least recently used are evicted.
+   */
+  int64_t getMaximumBytes() const noexcept { return this->_maximumBytes; }
+
+  /**
+   * @brief Gets the number of cached images.
+   */
+  size_t getCount() const;
+
+  /**
+   * @brief Gets the number of bytes of pixel data of the cached images.
+   */
+  int64_t getByteSize() const;
+
+private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const noexcept {
+      return static_cast<size_t>(key.content.hash1);
+    }
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<const CesiumGltf::ImageCesium> pImage;
+    int64_t byteSize;
+  };
+
+  mutable std::mutex _mutex;
+  // The most recently used entry is at the front.
+  std::list<Entry> _entries;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> _entriesByKey;
+  int64_t _byteSize;
+  int64_t _maximumBytes;
+};
+
+} // namespace CesiumGltfReader
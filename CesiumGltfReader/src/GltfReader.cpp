@@ -1,20 +1,28 @@
 #include "CesiumGltfReader/GltfReader.h"
 
+#include "CesiumGltfReader/GltfStreamReader.h"
+
 #include "ModelJsonHandler.h"
 #include "applyKHRTextureTransform.h"
 #include "decodeDataUrls.h"
 #include "decodeDraco.h"
 #include "decodeMeshOpt.h"
 #include "dequantizeMeshData.h"
+#include "halveImage.h"
+#include "optimizeMeshes.h"
 #include "registerExtensions.h"
+#include "removeUnrequiredAttributes.h"
 
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/forEachInParallel.h>
 #include <CesiumGltf/ExtensionKhrTextureBasisu.h>
 #include <CesiumGltf/ExtensionTextureWebp.h>
 #include <CesiumJsonReader/JsonHandler.h>
 #include <CesiumJsonReader/JsonReader.h>
 #include <CesiumJsonReader/JsonReaderOptions.h>
+#include <CesiumUtility/ContentHash.h>
+#include <CesiumUtility/PixelBufferPool.h>
 #include <CesiumUtility/Tracing.h>
 #include <CesiumUtility/Uri.h>
 
@@ -27,6 +35,8 @@
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include <tuple>
+#include <utility>
 
 #define STB_IMAGE_IMPLEMENTATION
 #define STBI_FAILURE_USERMSG
@@ -62,15 +72,26 @@ bool isBinaryGltf(const gsl::span<const std::byte>& data) noexcept {
   return reinterpret_cast<const GlbHeader*>(data.data())->magic == 0x46546C67;
 }
 
+// If pOwnedData is not nullptr, data must be within *pOwnedData, which may
+// then be overwritten by decoding the JSON strings in place.
 GltfReaderResult readJsonGltf(
     const CesiumJsonReader::JsonReaderOptions& context,
-    const gsl::span<const std::byte>& data) {
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>* pOwnedData = nullptr) {
 
   CESIUM_TRACE("CesiumGltfReader::GltfReader::readJsonGltf");
 
   ModelJsonHandler modelHandler(context);
-  CesiumJsonReader::ReadJsonResult<Model> jsonResult =
-      CesiumJsonReader::JsonReader::readJson(data, modelHandler);
+  CesiumJsonReader::ReadJsonResult<Model> jsonResult;
+  if (pOwnedData && !context.hasDeferredExtensions()) {
+    const gsl::span<std::byte> ownedJson(
+        pOwnedData->data() + (data.data() - pOwnedData->data()),
+        data.size());
+    jsonResult =
+        CesiumJsonReader::JsonReader::readJsonInSitu(ownedJson, modelHandler);
+  } else {
+    jsonResult = CesiumJsonReader::JsonReader::readJson(data, modelHandler);
+  }
 
   return GltfReaderResult{
       std::move(jsonResult.value),
@@ -98,9 +119,42 @@ std::string toMagicString(uint32_t i) {
   return stream.str();
 }
 
+// Returns the buffer that holds the binary chunk of a GLB, or nullptr after
+// adding an error to the result if the JSON chunk has no such buffer.
+Buffer*
+getBinaryChunkBuffer(GltfReaderResult& result, size_t binaryChunkLength) {
+  Model& model = result.model.value();
+
+  if (model.buffers.empty()) {
+    result.errors.emplace_back(
+        "GLB has a binary chunk but the JSON does not define any buffers.");
+    return nullptr;
+  }
+
+  Buffer& buffer = model.buffers[0];
+  if (buffer.uri) {
+    result.errors.emplace_back("GLB has a binary chunk but the first buffer "
+                               "in the JSON chunk also has a 'uri'.");
+    return nullptr;
+  }
+
+  const int64_t binaryChunkSize = static_cast<int64_t>(binaryChunkLength);
+  if (buffer.byteLength > binaryChunkSize ||
+      buffer.byteLength + 3 < binaryChunkSize) {
+    result.errors.emplace_back("GLB binary chunk size does not match the "
+                               "size of the first buffer in the JSON chunk.");
+    return nullptr;
+  }
+
+  return &buffer;
+}
+
+// If pOwnedData is not nullptr, data must be all of *pOwnedData, and the
+// binary chunk is moved into the first buffer instead of copied.
 GltfReaderResult readBinaryGltf(
     const CesiumJsonReader::JsonReaderOptions& context,
-    const gsl::span<const std::byte>& data) {
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>* pOwnedData = nullptr) {
   CESIUM_TRACE("CesiumGltfReader::GltfReader::readBinaryGltf");
 
   if (data.size() < sizeof(GlbHeader) + sizeof(ChunkHeader)) {
@@ -188,35 +242,26 @@ GltfReaderResult readBinaryGltf(
     binaryChunk = glbData.subspan(binaryStart, pBinaryChunkHeader->chunkLength);
   }
 
-  GltfReaderResult result = readJsonGltf(context, jsonChunk);
+  GltfReaderResult result = readJsonGltf(context, jsonChunk, pOwnedData);
 
   if (result.model && !binaryChunk.empty()) {
-    Model& model = result.model.value();
-
-    if (model.buffers.empty()) {
-      result.errors.emplace_back(
-          "GLB has a binary chunk but the JSON does not define any buffers.");
-      return result;
-    }
-
-    Buffer& buffer = model.buffers[0];
-    if (buffer.uri) {
-      result.errors.emplace_back("GLB has a binary chunk but the first buffer "
-                                 "in the JSON chunk also has a 'uri'.");
+    Buffer* pBuffer = getBinaryChunkBuffer(result, binaryChunk.size());
+    if (!pBuffer) {
       return result;
     }
 
-    const int64_t binaryChunkSize = static_cast<int64_t>(binaryChunk.size());
-    if (buffer.byteLength > binaryChunkSize ||
-        buffer.byteLength + 3 < binaryChunkSize) {
-      result.errors.emplace_back("GLB binary chunk size does not match the "
-                                 "size of the first buffer in the JSON chunk.");
-      return result;
+    Buffer& buffer = *pBuffer;
+    if (pOwnedData) {
+      std::vector<std::byte>& ownedData = *pOwnedData;
+      const std::ptrdiff_t binaryStart = binaryChunk.data() - ownedData.data();
+      ownedData.erase(ownedData.begin(), ownedData.begin() + binaryStart);
+      ownedData.resize(static_cast<size_t>(buffer.byteLength));
+      buffer.cesium.data = std::move(ownedData);
+    } else {
+      buffer.cesium.data = std::vector<std::byte>(
+          binaryChunk.begin(),
+          binaryChunk.begin() + buffer.byteLength);
     }
-
-    buffer.cesium.data = std::vector<std::byte>(
-        binaryChunk.begin(),
-        binaryChunk.begin() + buffer.byteLength);
   }
 
   return result;
@@ -244,8 +289,10 @@ void postprocess(
     decodeDataUrls(reader, readGltf, options);
   }
 
-  if (options.decodeEmbeddedImages) {
+  if (options.decodeEmbeddedImages && options.loadImages) {
     CESIUM_TRACE("CesiumGltfReader::decodeEmbeddedImages");
+    std::vector<Image*> images;
+    std::vector<gsl::span<const std::byte>> imageData;
     for (Image& image : model.images) {
       // Ignore external images for now.
       if (image.uri) {
@@ -274,11 +321,25 @@ void postprocess(
       }
 
       const gsl::span<const std::byte> bufferSpan(buffer.cesium.data);
-      const gsl::span<const std::byte> bufferViewSpan = bufferSpan.subspan(
+      images.emplace_back(&image);
+      imageData.emplace_back(bufferSpan.subspan(
           static_cast<size_t>(bufferView.byteOffset),
-          static_cast<size_t>(bufferView.byteLength));
-      ImageReaderResult imageResult =
-          GltfReader::readImage(bufferViewSpan, options.ktx2TranscodeTargets);
+          static_cast<size_t>(bufferView.byteLength)));
+    }
+
+    // The images are independent, so decode them in parallel, and then report
+    // the results in order.
+    std::vector<ImageReaderResult> imageResults(images.size());
+    CesiumAsync::forEachInParallel(
+        options.decodeAsyncSystem,
+        images.size(),
+        [&imageData, &imageResults, &options](size_t i) {
+          imageResults[i] = GltfReader::readImage(imageData[i], options);
+        });
+
+    for (size_t i = 0; i < images.size(); ++i) {
+      Image& image = *images[i];
+      ImageReaderResult& imageResult = imageResults[i];
       readGltf.warnings.insert(
           readGltf.warnings.end(),
           imageResult.warnings.begin(),
@@ -317,8 +378,12 @@ void postprocess(
     }
   }
 
+  if (options.requiredAttributes) {
+    removeUnrequiredAttributes(model, options);
+  }
+
   if (options.decodeDraco) {
-    decodeDraco(readGltf);
+    decodeDraco(readGltf, options);
   }
 
   if (options.decodeMeshOptData &&
@@ -326,7 +391,7 @@ void postprocess(
           model.extensionsUsed.begin(),
           model.extensionsUsed.end(),
           "EXT_meshopt_compression") != model.extensionsUsed.end()) {
-    decodeMeshOpt(model, readGltf);
+    decodeMeshOpt(model, readGltf, options);
   }
 
   if (options.dequantizeMeshData &&
@@ -334,7 +399,11 @@ void postprocess(
           model.extensionsUsed.begin(),
           model.extensionsUsed.end(),
           "KHR_mesh_quantization") != model.extensionsUsed.end()) {
-    dequantizeMeshData(model);
+    dequantizeMeshData(model, options);
+  }
+
+  if (options.optimizeMeshes) {
+    optimizeMeshes(model);
   }
 
   if (options.applyTextureTransform &&
@@ -348,6 +417,19 @@ void postprocess(
 
 } // namespace
 
+bool GltfReaderOptions::isAttributeRequired(
+    const std::string& attributeName) const {
+  if (!this->requiredAttributes || attributeName == "POSITION" ||
+      attributeName == "_BATCHID") {
+    return true;
+  }
+
+  return std::find(
+             this->requiredAttributes->begin(),
+             this->requiredAttributes->end(),
+             attributeName) != this->requiredAttributes->end();
+}
+
 GltfReader::GltfReader() : _context() { registerExtensions(this->_context); }
 
 CesiumJsonReader::JsonReaderOptions& GltfReader::getOptions() {
@@ -373,6 +455,22 @@ GltfReaderResult GltfReader::readGltf(
   return result;
 }
 
+GltfReaderResult GltfReader::readGltf(
+    std::vector<std::byte>&& data,
+    const GltfReaderOptions& options) const {
+
+  const CesiumJsonReader::JsonReaderOptions& context = this->getExtensions();
+  GltfReaderResult result = isBinaryGltf(data)
+                                ? readBinaryGltf(context, data, &data)
+                                : readJsonGltf(context, data, &data);
+
+  if (result.model) {
+    postprocess(*this, result, options);
+  }
+
+  return result;
+}
+
 /*static*/
 Future<GltfReaderResult> GltfReader::resolveExternalData(
     AsyncSystem asyncSystem,
@@ -399,7 +497,7 @@ Future<GltfReaderResult> GltfReader::resolveExternalData(
   }
 
   for (const Image& image : result.model->images) {
-    if (image.uri) {
+    if (image.uri && options.loadImages) {
       ++uriBuffersCount;
     }
   }
@@ -448,13 +546,13 @@ Future<GltfReaderResult> GltfReader::resolveExternalData(
   }
 
   for (Image& image : pResult->model->images) {
-    if (image.uri && image.uri->substr(0, dataPrefixLength) != dataPrefix) {
+    if (options.loadImages && image.uri &&
+        image.uri->substr(0, dataPrefixLength) != dataPrefix) {
       resolvedBuffers.push_back(
           pAssetAccessor
               ->get(asyncSystem, Uri::resolve(baseUrl, *image.uri), tHeaders)
               .thenInWorkerThread(
-                  [pImage = &image,
-                   ktx2TranscodeTargets = options.ktx2TranscodeTargets](
+                  [pImage = &image, options](
                       std::shared_ptr<IAssetRequest>&& pRequest) {
                     const IAssetResponse* pResponse = pRequest->response();
 
@@ -464,7 +562,7 @@ Future<GltfReaderResult> GltfReader::resolveExternalData(
                       pImage->uri = std::nullopt;
 
                       ImageReaderResult imageResult =
-                          readImage(pResponse->data(), ktx2TranscodeTargets);
+                          readImage(pResponse->data(), options);
                       if (imageResult.image) {
                         pImage->cesium = std::move(*imageResult.image);
                         return ExternalBufferLoadResult{true, imageUri};
@@ -512,10 +610,95 @@ bool isWebP(const gsl::span<const std::byte>& data) {
   return magic1 == 0x46464952 && magic2 == 0x50424557;
 }
 
+namespace {
+bool exceedsMaximumSize(
+    int32_t width,
+    int32_t height,
+    const std::optional<int32_t>& maximumSize) {
+  return maximumSize && (width > *maximumSize || height > *maximumSize);
+}
+
+// Gets the size that fits within the maximum size in both dimensions, with the
+// same aspect ratio.
+std::pair<int32_t, int32_t>
+fitToMaximumSize(int32_t width, int32_t height, int32_t maximumSize) {
+  const double scale =
+      double(std::max(maximumSize, 1)) / double(std::max(width, height));
+  return std::make_pair(
+      std::max(1, std::min(maximumSize, int32_t(width * scale + 0.5))),
+      std::max(1, std::min(maximumSize, int32_t(height * scale + 0.5))));
+}
+
+// Finds the largest JPEG size that fits within the maximum size and that
+// libjpeg-turbo can decode to directly, by scaling in its inverse DCT. If even
+// the smallest one is too large, that one is returned.
+std::pair<int32_t, int32_t>
+getScaledJpegSize(int32_t width, int32_t height, int32_t maximumSize) {
+  std::pair<int32_t, int32_t> bestSize(width, height);
+  int numScalingFactors = 0;
+  const tjscalingfactor* pScalingFactors =
+      tjGetScalingFactors(&numScalingFactors);
+  for (int i = 0; i < numScalingFactors; ++i) {
+    const tjscalingfactor factor = pScalingFactors[i];
+    const std::pair<int32_t, int32_t> size(
+        TJSCALED(width, factor),
+        TJSCALED(height, factor));
+    const bool fits = size.first <= maximumSize && size.second <= maximumSize;
+    const bool bestFits =
+        bestSize.first <= maximumSize && bestSize.second <= maximumSize;
+    if (fits ? !bestFits || size.first > bestSize.first
+             : !bestFits && size.first < bestSize.first) {
+      bestSize = size;
+    }
+  }
+  return bestSize;
+}
+
+// Resizes an uncompressed image without mipmaps to fit within the maximum
+// size, for the formats that cannot be scaled while they are decoded.
+void downsampleToMaximumSize(
+    ImageCesium& image,
+    const std::optional<int32_t>& maximumSize,
+    ImageReaderResult& result) {
+  if (!exceedsMaximumSize(image.width, image.height, maximumSize) ||
+      image.compressedPixelFormat != GpuCompressedPixelFormat::NONE ||
+      !image.mipPositions.empty() || image.bytesPerChannel != 1) {
+    return;
+  }
+
+  CESIUM_TRACE("Downsample image");
+  const auto [width, height] =
+      fitToMaximumSize(image.width, image.height, *maximumSize);
+  std::vector<std::byte> pixelData = PixelBufferPool::getDefault().acquire(
+      size_t(width) * size_t(height) * size_t(image.channels));
+  if (!stbir_resize_uint8(
+          reinterpret_cast<const unsigned char*>(image.pixelData.data()),
+          image.width,
+          image.height,
+          0,
+          reinterpret_cast<unsigned char*>(pixelData.data()),
+          width,
+          height,
+          0,
+          image.channels)) {
+    result.warnings.emplace_back(
+        "Unable to reduce the image to the maximum texture size.");
+    PixelBufferPool::getDefault().release(pixelData);
+    return;
+  }
+
+  image.width = width;
+  image.height = height;
+  PixelBufferPool::getDefault().release(image.pixelData);
+  image.pixelData = std::move(pixelData);
+}
+} // namespace
+
 /*static*/
 ImageReaderResult GltfReader::readImage(
     const gsl::span<const std::byte>& data,
-    const Ktx2TranscodeTargets& ktx2TranscodeTargets) {
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets,
+    const std::optional<int32_t>& maximumSize) {
   CESIUM_TRACE("CesiumGltfReader::readImage");
 
   ImageReaderResult result;
@@ -671,6 +854,53 @@ ImageReaderResult GltfReader::readImage(
           // don't generate any more. When it's true, we treat all the image
           // data as belonging to a single base-level image and generate mipmaps
           // from that if necessary.
+          // Leave out the mip levels that are larger than the maximum size.
+          ktx_uint32_t firstLevel = 0;
+          if (!pTexture->generateMipmaps) {
+            while (firstLevel + 1 < pTexture->numLevels &&
+                   exceedsMaximumSize(
+                       std::max(image.width >> firstLevel, 1),
+                       std::max(image.height >> firstLevel, 1),
+                       maximumSize)) {
+              ++firstLevel;
+            }
+          }
+
+          if (firstLevel > 0) {
+            image.width = std::max(image.width >> firstLevel, 1);
+            image.height = std::max(image.height >> firstLevel, 1);
+
+            const ktx_uint8_t* pixelData =
+                ktxTexture_GetData(ktxTexture(pTexture));
+            image.mipPositions.resize(pTexture->numLevels - firstLevel);
+            size_t byteOffset = 0;
+            for (ktx_uint32_t level = firstLevel; level < pTexture->numLevels;
+                 ++level) {
+              ktx_size_t imageOffset;
+              ktxTexture_GetImageOffset(
+                  ktxTexture(pTexture),
+                  level,
+                  0,
+                  0,
+                  &imageOffset);
+              ktx_size_t imageSize =
+                  ktxTexture_GetImageSize(ktxTexture(pTexture), level);
+
+              image.mipPositions[level - firstLevel] = {byteOffset, imageSize};
+              image.pixelData.resize(byteOffset + imageSize);
+              std::copy(
+                  pixelData + imageOffset,
+                  pixelData + imageOffset + imageSize,
+                  reinterpret_cast<std::uint8_t*>(
+                      image.pixelData.data() + byteOffset));
+              byteOffset += imageSize;
+            }
+
+            ktxTexture_Destroy(ktxTexture(pTexture));
+
+            return result;
+          }
+
           if (!pTexture->generateMipmaps) {
             // Copy over the positions of each mip within the buffer.
             image.mipPositions.resize(pTexture->numLevels);
@@ -696,13 +926,16 @@ ImageReaderResult GltfReader::readImage(
           ktx_size_t pixelDataSize =
               ktxTexture_GetDataSize(ktxTexture(pTexture));
 
-          image.pixelData.resize(pixelDataSize);
+          image.pixelData =
+              PixelBufferPool::getDefault().acquire(pixelDataSize);
           std::uint8_t* u8Pointer =
               reinterpret_cast<std::uint8_t*>(image.pixelData.data());
           std::copy(pixelData, pixelData + pixelDataSize, u8Pointer);
 
           ktxTexture_Destroy(ktxTexture(pTexture));
 
+          downsampleToMaximumSize(image, maximumSize, result);
+
           return result;
         }
       }
@@ -722,9 +955,47 @@ ImageReaderResult GltfReader::readImage(
             &image.height)) {
       image.channels = 4;
       image.bytesPerChannel = 1;
+
+      if (exceedsMaximumSize(image.width, image.height, maximumSize)) {
+        // Let libwebp scale the image while it decodes it.
+        CESIUM_TRACE("Decode scaled WebP");
+        WebPDecoderConfig config;
+        if (!WebPInitDecoderConfig(&config)) {
+          result.image.reset();
+          result.errors.emplace_back("Unable to decode WebP");
+          return result;
+        }
+
+        std::tie(image.width, image.height) =
+            fitToMaximumSize(image.width, image.height, *maximumSize);
+        image.pixelData =
+            PixelBufferPool::getDefault().acquire(static_cast<std::size_t>(
+                image.width * image.height * image.channels));
+
+        config.options.use_scaling = 1;
+        config.options.scaled_width = image.width;
+        config.options.scaled_height = image.height;
+        config.output.colorspace = MODE_RGBA;
+        config.output.is_external_memory = 1;
+        config.output.u.RGBA.rgba =
+            reinterpret_cast<uint8_t*>(image.pixelData.data());
+        config.output.u.RGBA.stride = image.width * image.channels;
+        config.output.u.RGBA.size = image.pixelData.size();
+        if (WebPDecode(
+                reinterpret_cast<const uint8_t*>(data.data()),
+                data.size(),
+                &config) != VP8_STATUS_OK) {
+          result.image.reset();
+          result.errors.emplace_back("Unable to decode WebP");
+        }
+        WebPFreeDecBuffer(&config.output);
+        return result;
+      }
+
       uint8_t* pImage = NULL;
       const auto bufferSize = image.width * image.height * image.channels;
-      image.pixelData.resize(static_cast<std::size_t>(bufferSize));
+      image.pixelData = PixelBufferPool::getDefault().acquire(
+          static_cast<std::size_t>(bufferSize));
       pImage = WebPDecodeRGBAInto(
           reinterpret_cast<const uint8_t*>(data.data()),
           data.size(),
@@ -753,9 +1024,16 @@ ImageReaderResult GltfReader::readImage(
       CESIUM_TRACE("Decode JPG");
       image.bytesPerChannel = 1;
       image.channels = 4;
+      if (exceedsMaximumSize(image.width, image.height, maximumSize)) {
+        // TurboJPEG decodes to the largest size it can that fits within the
+        // requested one.
+        std::tie(image.width, image.height) =
+            getScaledJpegSize(image.width, image.height, *maximumSize);
+      }
       const auto lastByte =
           image.width * image.height * image.channels * image.bytesPerChannel;
-      image.pixelData.resize(static_cast<std::size_t>(lastByte));
+      image.pixelData = PixelBufferPool::getDefault().acquire(
+          static_cast<std::size_t>(lastByte));
       if (tjDecompress2(
               tjInstance,
               reinterpret_cast<const unsigned char*>(data.data()),
@@ -768,6 +1046,8 @@ ImageReaderResult GltfReader::readImage(
               0)) {
         result.errors.emplace_back("Unable to decode JPEG");
         result.image.reset();
+      } else {
+        downsampleToMaximumSize(image, maximumSize, result);
       }
     } else {
       CESIUM_TRACE("Decode PNG");
@@ -792,11 +1072,13 @@ ImageReaderResult GltfReader::readImage(
         // use reinterpret_cast to (safely) force the conversion.
         const auto lastByte =
             image.width * image.height * image.channels * image.bytesPerChannel;
-        image.pixelData.resize(static_cast<std::size_t>(lastByte));
+        image.pixelData = PixelBufferPool::getDefault().acquire(
+            static_cast<std::size_t>(lastByte));
         std::uint8_t* u8Pointer =
             reinterpret_cast<std::uint8_t*>(image.pixelData.data());
         std::copy(pImage, pImage + lastByte, u8Pointer);
         stbi_image_free(pImage);
+        downsampleToMaximumSize(image, maximumSize, result);
       } else {
         result.image.reset();
         result.errors.emplace_back(stbi_failure_reason());
@@ -808,7 +1090,42 @@ ImageReaderResult GltfReader::readImage(
 }
 
 /*static*/
-std::optional<std::string> GltfReader::generateMipMaps(ImageCesium& image) {
+ImageReaderResult GltfReader::readImage(
+    const gsl::span<const std::byte>& data,
+    const GltfReaderOptions& options) {
+  if (!options.pTranscodedImageCache || !isKtx(data)) {
+    return GltfReader::readImage(
+        data,
+        options.ktx2TranscodeTargets,
+        options.maximumTextureSize);
+  }
+
+  const TranscodedImageCache::Key key{
+      ContentHash::compute(data),
+      options.ktx2TranscodeTargets,
+      options.maximumTextureSize};
+
+  std::optional<ImageCesium> cachedImage =
+      options.pTranscodedImageCache->find(key);
+  if (cachedImage) {
+    ImageReaderResult result;
+    result.image = std::move(cachedImage);
+    return result;
+  }
+
+  ImageReaderResult result = GltfReader::readImage(
+      data,
+      options.ktx2TranscodeTargets,
+      options.maximumTextureSize);
+  if (result.image) {
+    options.pTranscodedImageCache->insert(key, *result.image);
+  }
+  return result;
+}
+
+/*static*/
+std::optional<std::string>
+GltfReader::generateMipMaps(ImageCesium& image, bool sRGB) {
   if (!image.mipPositions.empty() ||
       image.compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
     // No error message needed, since this is not technically a failure.
@@ -851,8 +1168,17 @@ std::optional<std::string> GltfReader::generateMipMaps(ImageCesium& image) {
   image.mipPositions[0].byteOffset = 0;
   image.mipPositions[0].byteSize = imageByteSize;
 
-  image.pixelData.resize(static_cast<size_t>(
-      totalPixelCount * image.channels * image.bytesPerChannel));
+  // The mips are added to a buffer from the pool, since resizing the base
+  // image's buffer would allocate one anyway.
+  std::vector<std::byte> pixelData =
+      PixelBufferPool::getDefault().acquire(static_cast<size_t>(
+          totalPixelCount * image.channels * image.bytesPerChannel));
+  std::copy_n(
+      image.pixelData.begin(),
+      std::min(image.pixelData.size(), imageByteSize),
+      pixelData.begin());
+  PixelBufferPool::getDefault().release(image.pixelData);
+  image.pixelData = std::move(pixelData);
 
   mipWidth = image.width;
   mipHeight = image.height;
@@ -880,17 +1206,52 @@ std::optional<std::string> GltfReader::generateMipMaps(ImageCesium& image) {
     image.mipPositions[mipIndex].byteOffset = byteOffset;
     image.mipPositions[mipIndex].byteSize = byteSize;
 
-    if (!stbir_resize_uint8(
-            reinterpret_cast<const unsigned char*>(
-                &image.pixelData[lastByteOffset]),
-            lastWidth,
-            lastHeight,
-            0,
-            reinterpret_cast<unsigned char*>(&image.pixelData[byteOffset]),
-            mipWidth,
-            mipHeight,
-            0,
-            image.channels)) {
+    // Halving each dimension, as for power-of-two images, only needs a box
+    // filter, which is much faster than the general resize.
+    if (image.bytesPerChannel == 1 && image.channels >= 1 &&
+        image.channels <= 4 && (lastWidth == 1 || lastWidth % 2 == 0) &&
+        (lastHeight == 1 || lastHeight % 2 == 0)) {
+      halveImage(
+          &image.pixelData[lastByteOffset],
+          lastWidth,
+          lastHeight,
+          image.channels,
+          sRGB,
+          &image.pixelData[byteOffset]);
+      continue;
+    }
+
+    const int alphaChannel = image.channels == 2   ? 1
+                             : image.channels == 4 ? 3
+                                                   : STBIR_ALPHA_CHANNEL_NONE;
+    const int resized =
+        sRGB ? stbir_resize_uint8_srgb(
+                   reinterpret_cast<const unsigned char*>(
+                       &image.pixelData[lastByteOffset]),
+                   lastWidth,
+                   lastHeight,
+                   0,
+                   reinterpret_cast<unsigned char*>(
+                       &image.pixelData[byteOffset]),
+                   mipWidth,
+                   mipHeight,
+                   0,
+                   image.channels,
+                   alphaChannel,
+                   0)
+             : stbir_resize_uint8(
+                   reinterpret_cast<const unsigned char*>(
+                       &image.pixelData[lastByteOffset]),
+                   lastWidth,
+                   lastHeight,
+                   0,
+                   reinterpret_cast<unsigned char*>(
+                       &image.pixelData[byteOffset]),
+                   mipWidth,
+                   mipHeight,
+                   0,
+                   image.channels);
+    if (!resized) {
       // Remove any added mipmaps.
       image.mipPositions.clear();
       image.pixelData.resize(imageByteSize);
@@ -900,3 +1261,157 @@ std::optional<std::string> GltfReader::generateMipMaps(ImageCesium& image) {
 
   return std::nullopt;
 }
+
+GltfStreamReader::GltfStreamReader(const GltfReader& reader) noexcept
+    : _pReader(&reader),
+      _stage(Stage::Header),
+      _chunkHeaders(),
+      _chunkHeadersLength(sizeof(GlbHeader) + sizeof(ChunkHeader)),
+      _jsonResult(),
+      _binaryChunk(),
+      _binaryChunkLength(0),
+      _glbLength(0),
+      _bytesReceived(0) {}
+
+void GltfStreamReader::append(const gsl::span<const std::byte>& data) {
+  CESIUM_TRACE("CesiumGltfReader::GltfStreamReader::append");
+
+  size_t offset = 0;
+  while (offset < data.size() && (this->_stage == Stage::Header ||
+                                  this->_stage == Stage::Json ||
+                                  this->_stage == Stage::BinaryHeader)) {
+    const size_t count = std::min(
+        this->_chunkHeadersLength - this->_chunkHeaders.size(),
+        data.size() - offset);
+    const gsl::span<const std::byte> piece = data.subspan(offset, count);
+    this->_chunkHeaders.insert(
+        this->_chunkHeaders.end(),
+        piece.begin(),
+        piece.end());
+    offset += count;
+    this->readChunkHeaders();
+  }
+
+  if (this->_stage == Stage::Binary && offset < data.size()) {
+    const size_t count = std::min(
+        this->_binaryChunkLength - this->_binaryChunk.size(),
+        data.size() - offset);
+    const gsl::span<const std::byte> piece = data.subspan(offset, count);
+    this->_binaryChunk.insert(
+        this->_binaryChunk.end(),
+        piece.begin(),
+        piece.end());
+    if (this->_binaryChunk.size() == this->_binaryChunkLength) {
+      this->_stage = Stage::Done;
+    }
+  }
+
+  this->_bytesReceived += data.size();
+}
+
+bool GltfStreamReader::isComplete() const noexcept {
+  return this->_stage == Stage::Done &&
+         this->_bytesReceived >= this->_glbLength;
+}
+
+GltfReaderResult GltfStreamReader::finish(const GltfReaderOptions& options) {
+  CESIUM_TRACE("CesiumGltfReader::GltfStreamReader::finish");
+
+  if (!this->isComplete()) {
+    return {std::nullopt, {"The GLB has not been received completely."}, {}};
+  }
+
+  GltfReaderResult result = std::move(*this->_jsonResult);
+  this->_stage = Stage::NotGlb;
+  this->_jsonResult.reset();
+
+  if (result.model && this->_binaryChunkLength > 0) {
+    Buffer* pBuffer = getBinaryChunkBuffer(result, this->_binaryChunkLength);
+    if (!pBuffer) {
+      return result;
+    }
+
+    this->_binaryChunk.resize(static_cast<size_t>(pBuffer->byteLength));
+    pBuffer->cesium.data = std::move(this->_binaryChunk);
+  }
+
+  if (result.model) {
+    postprocess(*this->_pReader, result, options);
+  }
+
+  return result;
+}
+
+// Called whenever more of the chunk headers has arrived. Once all that is
+// expected for the current stage is there, moves on to the next stage.
+void GltfStreamReader::readChunkHeaders() {
+  const size_t jsonStart = sizeof(GlbHeader) + sizeof(ChunkHeader);
+
+  while (this->_chunkHeaders.size() == this->_chunkHeadersLength) {
+    if (this->_stage == Stage::Header) {
+      const GlbHeader* pHeader =
+          reinterpret_cast<const GlbHeader*>(this->_chunkHeaders.data());
+      const ChunkHeader* pJsonChunkHeader =
+          reinterpret_cast<const ChunkHeader*>(
+              this->_chunkHeaders.data() + sizeof(GlbHeader));
+      const size_t jsonEnd = jsonStart + pJsonChunkHeader->chunkLength;
+      if (pHeader->magic != 0x46546C67 || pHeader->version != 2 ||
+          pJsonChunkHeader->chunkType != 0x4E4F534A ||
+          jsonEnd > pHeader->length) {
+        this->stopReading();
+        return;
+      }
+
+      this->_glbLength = pHeader->length;
+      this->_chunkHeadersLength = jsonEnd;
+      this->_stage = Stage::Json;
+    } else if (this->_stage == Stage::Json) {
+      const gsl::span<const std::byte> jsonChunk =
+          gsl::span<const std::byte>(this->_chunkHeaders).subspan(jsonStart);
+      this->_jsonResult =
+          readJsonGltf(this->_pReader->getExtensions(), jsonChunk);
+      if (!this->_jsonResult->model) {
+        this->stopReading();
+        return;
+      }
+
+      const size_t jsonEnd = this->_chunkHeaders.size();
+      if (jsonEnd + sizeof(ChunkHeader) > this->_glbLength) {
+        this->_stage = Stage::Done;
+        return;
+      }
+
+      this->_chunkHeadersLength = jsonEnd + sizeof(ChunkHeader);
+      this->_stage = Stage::BinaryHeader;
+    } else if (this->_stage == Stage::BinaryHeader) {
+      const ChunkHeader* pBinaryChunkHeader =
+          reinterpret_cast<const ChunkHeader*>(
+              this->_chunkHeaders.data() + this->_chunkHeaders.size() -
+              sizeof(ChunkHeader));
+      const size_t binaryEnd =
+          this->_chunkHeaders.size() + pBinaryChunkHeader->chunkLength;
+      if (pBinaryChunkHeader->chunkType != 0x004E4942 ||
+          binaryEnd > this->_glbLength) {
+        this->stopReading();
+        return;
+      }
+
+      this->_binaryChunkLength = pBinaryChunkHeader->chunkLength;
+      this->_binaryChunk.reserve(this->_binaryChunkLength);
+      this->_stage =
+          this->_binaryChunkLength > 0 ? Stage::Binary : Stage::Done;
+      return;
+    } else {
+      return;
+    }
+  }
+}
+
+// Gives up on reading the data incrementally, so that it can be read with
+// GltfReader::readGltf instead, which reports any errors.
+void GltfStreamReader::stopReading() noexcept {
+  this->_stage = Stage::NotGlb;
+  this->_chunkHeaders = std::vector<std::byte>();
+  this->_jsonResult.reset();
+  this->_binaryChunk = std::vector<std::byte>();
+}
@@ -0,0 +1,71 @@
+#include "CesiumGltfReader/TranscodedImageCache.h"
+
+#include <utility>
+
+using namespace CesiumGltf;
+
+namespace CesiumGltfReader {
+
+TranscodedImageCache::TranscodedImageCache(int64_t maximumBytes) noexcept
+    : _mutex(),
+      _entries(),
+      _entriesByKey(),
+      _byteSize(0),
+      _maximumBytes(maximumBytes) {}
+
+std::optional<ImageCesium> TranscodedImageCache::find(const Key& key) {
+  std::shared_ptr<const ImageCesium> pImage;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entriesByKey.find(key);
+    if (it == this->_entriesByKey.end()) {
+      return std::nullopt;
+    }
+
+    this->_entries.splice(this->_entries.begin(), this->_entries, it->second);
+    pImage = it->second->pImage;
+  }
+
+  // Copy outside the lock, which may take a while for a large image.
+  return *pImage;
+}
+
+void TranscodedImageCache::insert(const Key& key, const ImageCesium& image) {
+  const int64_t byteSize = static_cast<int64_t>(image.pixelData.size());
+  if (byteSize > this->_maximumBytes) {
+    return;
+  }
+
+  auto pImage = std::make_shared<const ImageCesium>(image);
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  auto it = this->_entriesByKey.find(key);
+  if (it != this->_entriesByKey.end()) {
+    this->_byteSize -= it->second->byteSize;
+    this->_entries.erase(it->second);
+    this->_entriesByKey.erase(it);
+  }
+
+  this->_entries.push_front(Entry{key, std::move(pImage), byteSize});
+  this->_entriesByKey.emplace(key, this->_entries.begin());
+  this->_byteSize += byteSize;
+
+  while (this->_byteSize > this->_maximumBytes) {
+    const Entry& leastRecentlyUsed = this->_entries.back();
+    this->_byteSize -= leastRecentlyUsed.byteSize;
+    this->_entriesByKey.erase(leastRecentlyUsed.key);
+    this->_entries.pop_back();
+  }
+}
+
+size_t TranscodedImageCache::getCount() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_entries.size();
+}
+
+int64_t TranscodedImageCache::getByteSize() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_byteSize;
+}
+
+} // namespace CesiumGltfReader
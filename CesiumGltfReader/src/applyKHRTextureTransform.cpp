@@ -26,8 +26,7 @@ void transformBufferView(
     float ScaleY = static_cast<float>(textureTransform.scale[1]);
 
     glm::vec2* uvs = reinterpret_cast<glm::vec2*>(data.data());
-    for (int i = 0; i < accessorView.size(); i++) {
-      glm::vec2 uv = accessorView[i];
+    for (glm::vec2 uv : accessorView) {
       uv.x = uv.x * ScaleX + OffsetX;
       uv.y = uv.y * ScaleY + OffsetY;
       *uvs++ = uv;
@@ -51,8 +50,8 @@ void transformBufferView(
 
     glm::vec2* uvs = reinterpret_cast<glm::vec2*>(data.data());
 
-    for (int i = 0; i < accessorView.size(); i++) {
-      *uvs++ = glm::vec2((matrix * glm::vec3(accessorView[i], 1)));
+    for (const glm::vec2& uv : accessorView) {
+      *uvs++ = glm::vec2((matrix * glm::vec3(uv, 1)));
     }
   }
 }
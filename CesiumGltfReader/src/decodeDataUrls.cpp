@@ -2,6 +2,7 @@
 
 #include "CesiumGltfReader/GltfReader.h"
 
+#include <CesiumAsync/forEachInParallel.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumUtility/Tracing.h>
 
@@ -114,29 +115,38 @@ void decodeDataUrls(
     }
   }
 
-  for (CesiumGltf::Image& image : model.images) {
-    if (!image.uri) {
-      continue;
-    }
-
-    std::optional<DecodeResult> decoded = tryDecode(image.uri.value());
-    if (!decoded) {
-      continue;
-    }
-
-    ImageReaderResult imageResult =
-        reader.readImage(decoded.value().data, options.ktx2TranscodeTargets);
-
-    if (!imageResult.image) {
-      continue;
-    }
-
-    image.cesium = std::move(imageResult.image.value());
-
-    if (options.clearDecodedDataUrls) {
-      image.uri.reset();
-    }
+  if (!options.loadImages) {
+    return;
   }
+
+  // Each image only touches itself, so they are decoded in parallel.
+  CesiumAsync::forEachInParallel(
+      options.decodeAsyncSystem,
+      model.images.size(),
+      [&model, &reader, &options](size_t i) {
+        CesiumGltf::Image& image = model.images[i];
+        if (!image.uri) {
+          return;
+        }
+
+        std::optional<DecodeResult> decoded = tryDecode(image.uri.value());
+        if (!decoded) {
+          return;
+        }
+
+        ImageReaderResult imageResult =
+            reader.readImage(decoded.value().data, options);
+
+        if (!imageResult.image) {
+          return;
+        }
+
+        image.cesium = std::move(imageResult.image.value());
+
+        if (options.clearDecodedDataUrls) {
+          image.uri.reset();
+        }
+      });
 }
 
 } // namespace CesiumGltfReader
@@ -2,12 +2,17 @@
 
 #include "CesiumGltfReader/GltfReader.h"
 
+#include <CesiumAsync/forEachInParallel.h>
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumUtility/Tracing.h>
 
 #include <cstddef>
+#include <cstring>
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -24,18 +29,27 @@
 namespace CesiumGltfReader {
 
 namespace {
-std::unique_ptr<draco::Mesh> decodeBufferViewToDracoMesh(
+/**
+ * @brief A Draco-compressed primitive, and the result of decoding it.
+ */
+struct DracoPrimitive {
+  CesiumGltf::MeshPrimitive* pPrimitive;
+  const CesiumGltf::ExtensionKhrDracoMeshCompression* pDraco;
+  gsl::span<const std::byte> data;
+  std::unique_ptr<draco::Mesh> pMesh;
+  std::string error;
+};
+
+std::optional<gsl::span<const std::byte>> getDracoData(
     GltfReaderResult& readGltf,
-    CesiumGltf::MeshPrimitive& /* primitive */,
     const CesiumGltf::ExtensionKhrDracoMeshCompression& draco) {
-  CESIUM_TRACE("CesiumGltfReader::decodeBufferViewToDracoMesh");
   CesiumGltf::Model& model = readGltf.model.value();
 
   CesiumGltf::BufferView* pBufferView =
       CesiumGltf::Model::getSafe(&model.bufferViews, draco.bufferView);
   if (!pBufferView) {
     readGltf.warnings.emplace_back("Draco bufferView index is invalid.");
-    return nullptr;
+    return std::nullopt;
   }
 
   const CesiumGltf::BufferView& bufferView = *pBufferView;
@@ -45,7 +59,7 @@ std::unique_ptr<draco::Mesh> decodeBufferViewToDracoMesh(
   if (!pBuffer) {
     readGltf.warnings.emplace_back(
         "Draco bufferView has an invalid buffer index.");
-    return nullptr;
+    return std::nullopt;
   }
 
   CesiumGltf::Buffer& buffer = *pBuffer;
@@ -55,50 +69,83 @@ std::unique_ptr<draco::Mesh> decodeBufferViewToDracoMesh(
           static_cast<int64_t>(buffer.cesium.data.size())) {
     readGltf.warnings.emplace_back(
         "Draco bufferView extends beyond its buffer.");
-    return nullptr;
+    return std::nullopt;
   }
 
-  const gsl::span<const std::byte> data(
+  return gsl::span<const std::byte>(
       buffer.cesium.data.data() + bufferView.byteOffset,
       static_cast<uint64_t>(bufferView.byteLength));
+}
 
-  draco::DecoderBuffer decodeBuffer;
-  decodeBuffer.Init(reinterpret_cast<const char*>(data.data()), data.size());
+// This only touches the given primitive's own members, so it may be called
+// for several primitives at once from different threads.
+void decodeDracoMesh(DracoPrimitive& primitive) noexcept {
+  CESIUM_TRACE("CesiumGltfReader::decodeDracoMesh");
+  try {
+    draco::DecoderBuffer decodeBuffer;
+    decodeBuffer.Init(
+        reinterpret_cast<const char*>(primitive.data.data()),
+        primitive.data.size());
+
+    draco::Decoder decoder;
+    draco::StatusOr<std::unique_ptr<draco::Mesh>> result =
+        decoder.DecodeMeshFromBuffer(&decodeBuffer);
+    if (!result.ok()) {
+      primitive.error = std::string("Draco decoding failed: ") +
+                        result.status().error_msg_string();
+      return;
+    }
 
-  draco::Decoder decoder;
-  draco::Mesh mesh;
-  draco::StatusOr<std::unique_ptr<draco::Mesh>> result =
-      decoder.DecodeMeshFromBuffer(&decodeBuffer);
-  if (!result.ok()) {
-    readGltf.warnings.emplace_back(
-        std::string("Draco decoding failed: ") +
-        result.status().error_msg_string());
-    return nullptr;
+    primitive.pMesh = std::move(result).value();
+  } catch (const std::exception& e) {
+    primitive.error = std::string("Draco decoding failed: ") + e.what();
+  } catch (...) {
+    primitive.error = "Draco decoding failed.";
   }
-
-  return std::move(result).value();
 }
 
-template <typename TSource, typename TDestination>
-void copyData(
-    const TSource* pSource,
-    TDestination* pDestination,
-    int64_t length) {
-  std::transform(pSource, pSource + length, pDestination, [](auto x) {
-    return static_cast<TDestination>(x);
-  });
-}
+/**
+ * @brief A part of the output buffer that will be filled with decoded
+ * indices, if `pAttribute` is `nullptr`, or with a decoded attribute.
+ */
+struct DracoCopy {
+  const draco::Mesh* pMesh;
+  const draco::PointAttribute* pAttribute;
+  const CesiumGltf::Accessor* pAccessor;
+  int64_t byteOffset;
+};
+
+int64_t addBufferView(
+    CesiumGltf::Model& model,
+    int32_t bufferIndex,
+    int64_t& byteLength,
+    int64_t sizeBytes,
+    int64_t stride,
+    CesiumGltf::Accessor& accessor) {
+  // Keep each bufferView aligned for the largest component type.
+  byteLength = (byteLength + 7) & ~int64_t(7);
+
+  accessor.bufferView = static_cast<int32_t>(model.bufferViews.size());
+  accessor.byteOffset = 0;
 
-template <typename T>
-void copyData(const T* pSource, T* pDestination, int64_t length) {
-  std::copy(pSource, pSource + length, pDestination);
+  CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = bufferIndex;
+  bufferView.byteOffset = byteLength;
+  bufferView.byteLength = sizeBytes;
+  bufferView.byteStride = stride;
+
+  const int64_t byteOffset = byteLength;
+  byteLength += sizeBytes;
+  return byteOffset;
 }
 
-void copyDecodedIndices(
+void addDecodedIndices(
     GltfReaderResult& readGltf,
     const CesiumGltf::MeshPrimitive& primitive,
-    draco::Mesh* pMesh) {
-  CESIUM_TRACE("CesiumGltfReader::copyDecodedIndices");
+    const draco::Mesh* pMesh,
+    int32_t bufferIndex,
+    int64_t& byteLength,
+    std::vector<DracoCopy>& copies) {
   CesiumGltf::Model& model = readGltf.model.value();
 
   if (primitive.indices < 0) {
@@ -136,77 +183,30 @@ void copyDecodedIndices(
     pIndicesAccessor->componentType = supposedComponentType;
   }
 
-  pIndicesAccessor->bufferView = static_cast<int32_t>(model.bufferViews.size());
-  CesiumGltf::BufferView& indicesBufferView = model.bufferViews.emplace_back();
-
-  indicesBufferView.buffer = static_cast<int32_t>(model.buffers.size());
-  CesiumGltf::Buffer& indicesBuffer = model.buffers.emplace_back();
-
-  int64_t indexBytes = pIndicesAccessor->computeByteSizeOfComponent();
-  const int64_t indicesBytes = pIndicesAccessor->count * indexBytes;
-
-  indicesBuffer.cesium.data.resize(static_cast<size_t>(indicesBytes));
-  indicesBuffer.byteLength = indicesBytes;
-  indicesBufferView.byteLength = indicesBytes;
-  indicesBufferView.byteStride = indexBytes;
-  indicesBufferView.byteOffset = 0;
-  indicesBufferView.target =
-      CesiumGltf::BufferView::Target::ELEMENT_ARRAY_BUFFER;
   pIndicesAccessor->type = CesiumGltf::Accessor::Type::SCALAR;
-  pIndicesAccessor->byteOffset = 0;
-
-  static_assert(sizeof(draco::PointIndex) == sizeof(uint32_t));
 
-  const uint32_t* pSourceIndices =
-      reinterpret_cast<const uint32_t*>(&pMesh->face(draco::FaceIndex(0))[0]);
+  const int64_t indexBytes = pIndicesAccessor->computeByteSizeOfComponent();
+  const int64_t byteOffset = addBufferView(
+      model,
+      bufferIndex,
+      byteLength,
+      pIndicesAccessor->count * indexBytes,
+      indexBytes,
+      *pIndicesAccessor);
+  model.bufferViews.back().target =
+      CesiumGltf::BufferView::Target::ELEMENT_ARRAY_BUFFER;
 
-  switch (pIndicesAccessor->componentType) {
-  case CesiumGltf::Accessor::ComponentType::BYTE:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<int8_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<uint8_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  case CesiumGltf::Accessor::ComponentType::SHORT:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<int16_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<uint16_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<uint32_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  case CesiumGltf::Accessor::ComponentType::FLOAT:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<float*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  }
+  copies.emplace_back(DracoCopy{pMesh, nullptr, pIndicesAccessor, byteOffset});
 }
 
-void copyDecodedAttribute(
+void addDecodedAttribute(
     GltfReaderResult& readGltf,
-    CesiumGltf::MeshPrimitive& /* primitive */,
     CesiumGltf::Accessor* pAccessor,
     const draco::Mesh* pMesh,
-    const draco::PointAttribute* pAttribute) {
-  CESIUM_TRACE("CesiumGltfReader::copyDecodedAttribute");
+    const draco::PointAttribute* pAttribute,
+    int32_t bufferIndex,
+    int64_t& byteLength,
+    std::vector<DracoCopy>& copies) {
   CesiumGltf::Model& model = readGltf.model.value();
 
   if (pAccessor->count != pMesh->num_points()) {
@@ -216,50 +216,13 @@ void copyDecodedAttribute(
     pAccessor->count = pMesh->num_points();
   }
 
-  pAccessor->bufferView = static_cast<int32_t>(model.bufferViews.size());
-  CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
-
-  bufferView.buffer = static_cast<int32_t>(model.buffers.size());
-  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
-
-  const int8_t numberOfComponents = pAccessor->computeNumberOfComponents();
-  const int64_t stride =
-      numberOfComponents * pAccessor->computeByteSizeOfComponent();
-  const int64_t sizeBytes = pAccessor->count * stride;
-
-  buffer.cesium.data.resize(static_cast<size_t>(sizeBytes));
-  buffer.byteLength = sizeBytes;
-  bufferView.byteLength = sizeBytes;
-  bufferView.byteStride = stride;
-  bufferView.byteOffset = 0;
-  pAccessor->byteOffset = 0;
-
-  const auto doCopy = [pMesh, pAttribute, numberOfComponents](auto pOut) {
-    for (draco::PointIndex i(0); i < pMesh->num_points(); ++i) {
-      const draco::AttributeValueIndex valueIndex = pAttribute->mapped_index(i);
-      pAttribute->ConvertValue(valueIndex, numberOfComponents, pOut);
-      pOut += pAttribute->num_components();
-    }
-  };
-
   switch (pAccessor->componentType) {
   case CesiumGltf::Accessor::ComponentType::BYTE:
-    doCopy(reinterpret_cast<int8_t*>(buffer.cesium.data.data()));
-    break;
   case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
-    doCopy(reinterpret_cast<uint8_t*>(buffer.cesium.data.data()));
-    break;
   case CesiumGltf::Accessor::ComponentType::SHORT:
-    doCopy(reinterpret_cast<int16_t*>(buffer.cesium.data.data()));
-    break;
   case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
-    doCopy(reinterpret_cast<uint16_t*>(buffer.cesium.data.data()));
-    break;
   case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
-    doCopy(reinterpret_cast<uint32_t*>(buffer.cesium.data.data()));
-    break;
   case CesiumGltf::Accessor::ComponentType::FLOAT:
-    doCopy(reinterpret_cast<float*>(buffer.cesium.data.data()));
     break;
   default:
     readGltf.warnings.emplace_back(
@@ -267,25 +230,40 @@ void copyDecodedAttribute(
         std::to_string(int32_t(pAccessor->componentType)));
     break;
   }
+
+  const int64_t stride = pAccessor->computeNumberOfComponents() *
+                         pAccessor->computeByteSizeOfComponent();
+  const int64_t byteOffset = addBufferView(
+      model,
+      bufferIndex,
+      byteLength,
+      pAccessor->count * stride,
+      stride,
+      *pAccessor);
+
+  copies.emplace_back(DracoCopy{pMesh, pAttribute, pAccessor, byteOffset});
 }
 
-void decodePrimitive(
+void addDecodedPrimitive(
     GltfReaderResult& readGltf,
-    CesiumGltf::MeshPrimitive& primitive,
-    CesiumGltf::ExtensionKhrDracoMeshCompression& draco) {
-  CESIUM_TRACE("CesiumGltfReader::decodePrimitive");
+    DracoPrimitive& decoded,
+    int32_t bufferIndex,
+    int64_t& byteLength,
+    std::vector<DracoCopy>& copies) {
   CesiumGltf::Model& model = readGltf.model.value();
+  CesiumGltf::MeshPrimitive& primitive = *decoded.pPrimitive;
+  const draco::Mesh* pMesh = decoded.pMesh.get();
 
-  std::unique_ptr<draco::Mesh> pMesh =
-      decodeBufferViewToDracoMesh(readGltf, primitive, draco);
-  if (!pMesh) {
-    return;
-  }
-
-  copyDecodedIndices(readGltf, primitive, pMesh.get());
+  addDecodedIndices(
+      readGltf,
+      primitive,
+      pMesh,
+      bufferIndex,
+      byteLength,
+      copies);
 
   for (const std::pair<const std::string, int32_t>& attribute :
-       draco.attributes) {
+       decoded.pDraco->attributes) {
     auto primitiveAttrIt = primitive.attributes.find(attribute.first);
     if (primitiveAttrIt == primitive.attributes.end()) {
       // The primitive does not use this attribute. The
@@ -315,17 +293,164 @@ void decodePrimitive(
       continue;
     }
 
-    copyDecodedAttribute(
+    addDecodedAttribute(
         readGltf,
-        primitive,
         pAccessor,
-        pMesh.get(),
-        pAttribute);
+        pMesh,
+        pAttribute,
+        bufferIndex,
+        byteLength,
+        copies);
+  }
+}
+
+template <typename TSource, typename TDestination>
+void copyData(
+    const TSource* pSource,
+    TDestination* pDestination,
+    int64_t length) {
+  std::transform(pSource, pSource + length, pDestination, [](auto x) {
+    return static_cast<TDestination>(x);
+  });
+}
+
+template <typename T>
+void copyData(const T* pSource, T* pDestination, int64_t length) {
+  std::copy(pSource, pSource + length, pDestination);
+}
+
+void copyDecodedIndices(
+    const draco::Mesh* pMesh,
+    const CesiumGltf::Accessor& accessor,
+    std::byte* pDestination) {
+  CESIUM_TRACE("CesiumGltfReader::copyDecodedIndices");
+  if (accessor.count <= 0) {
+    return;
+  }
+
+  static_assert(sizeof(draco::PointIndex) == sizeof(uint32_t));
+
+  const uint32_t* pSourceIndices =
+      reinterpret_cast<const uint32_t*>(&pMesh->face(draco::FaceIndex(0))[0]);
+
+  switch (accessor.componentType) {
+  case CesiumGltf::Accessor::ComponentType::BYTE:
+    copyData(
+        pSourceIndices,
+        reinterpret_cast<int8_t*>(pDestination),
+        accessor.count);
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
+    copyData(
+        pSourceIndices,
+        reinterpret_cast<uint8_t*>(pDestination),
+        accessor.count);
+    break;
+  case CesiumGltf::Accessor::ComponentType::SHORT:
+    copyData(
+        pSourceIndices,
+        reinterpret_cast<int16_t*>(pDestination),
+        accessor.count);
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
+    copyData(
+        pSourceIndices,
+        reinterpret_cast<uint16_t*>(pDestination),
+        accessor.count);
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
+    copyData(
+        pSourceIndices,
+        reinterpret_cast<uint32_t*>(pDestination),
+        accessor.count);
+    break;
+  case CesiumGltf::Accessor::ComponentType::FLOAT:
+    copyData(
+        pSourceIndices,
+        reinterpret_cast<float*>(pDestination),
+        accessor.count);
+    break;
+  }
+}
+
+draco::DataType getDracoDataType(int32_t componentType) {
+  switch (componentType) {
+  case CesiumGltf::Accessor::ComponentType::BYTE:
+    return draco::DT_INT8;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
+    return draco::DT_UINT8;
+  case CesiumGltf::Accessor::ComponentType::SHORT:
+    return draco::DT_INT16;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
+    return draco::DT_UINT16;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
+    return draco::DT_UINT32;
+  case CesiumGltf::Accessor::ComponentType::FLOAT:
+    return draco::DT_FLOAT32;
+  default:
+    return draco::DT_INVALID;
+  }
+}
+
+void copyDecodedAttribute(
+    const draco::Mesh* pMesh,
+    const draco::PointAttribute* pAttribute,
+    const CesiumGltf::Accessor& accessor,
+    std::byte* pDestination) {
+  CESIUM_TRACE("CesiumGltfReader::copyDecodedAttribute");
+
+  const int8_t numberOfComponents = accessor.computeNumberOfComponents();
+  const int64_t stride =
+      numberOfComponents * accessor.computeByteSizeOfComponent();
+
+  // When Draco has already decoded the values in the accessor's layout, with
+  // one value per point, they can be copied all at once.
+  if (pAttribute->is_mapping_identity() &&
+      pAttribute->data_type() == getDracoDataType(accessor.componentType) &&
+      pAttribute->num_components() == numberOfComponents &&
+      pAttribute->byte_stride() == stride &&
+      pAttribute->size() >= size_t(pMesh->num_points())) {
+    std::memcpy(
+        pDestination,
+        pAttribute->GetAddress(draco::AttributeValueIndex(0)),
+        size_t(accessor.count * stride));
+    return;
+  }
+
+  const auto doCopy = [pMesh, pAttribute, numberOfComponents](auto pOut) {
+    for (draco::PointIndex i(0); i < pMesh->num_points(); ++i) {
+      const draco::AttributeValueIndex valueIndex = pAttribute->mapped_index(i);
+      pAttribute->ConvertValue(valueIndex, numberOfComponents, pOut);
+      pOut += pAttribute->num_components();
+    }
+  };
+
+  switch (accessor.componentType) {
+  case CesiumGltf::Accessor::ComponentType::BYTE:
+    doCopy(reinterpret_cast<int8_t*>(pDestination));
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
+    doCopy(reinterpret_cast<uint8_t*>(pDestination));
+    break;
+  case CesiumGltf::Accessor::ComponentType::SHORT:
+    doCopy(reinterpret_cast<int16_t*>(pDestination));
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
+    doCopy(reinterpret_cast<uint16_t*>(pDestination));
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
+    doCopy(reinterpret_cast<uint32_t*>(pDestination));
+    break;
+  case CesiumGltf::Accessor::ComponentType::FLOAT:
+    doCopy(reinterpret_cast<float*>(pDestination));
+    break;
   }
 }
 } // namespace
 
-void decodeDraco(CesiumGltfReader::GltfReaderResult& readGltf) {
+void decodeDraco(
+    CesiumGltfReader::GltfReaderResult& readGltf,
+    const GltfReaderOptions& options) {
   CESIUM_TRACE("CesiumGltfReader::decodeDraco");
   if (!readGltf.model) {
     return;
@@ -333,6 +458,7 @@ void decodeDraco(CesiumGltfReader::GltfReaderResult& readGltf) {
 
   CesiumGltf::Model& model = readGltf.model.value();
 
+  std::vector<DracoPrimitive> primitives;
   for (CesiumGltf::Mesh& mesh : model.meshes) {
     for (CesiumGltf::MeshPrimitive& primitive : mesh.primitives) {
       CesiumGltf::ExtensionKhrDracoMeshCompression* pDraco =
@@ -342,7 +468,54 @@ void decodeDraco(CesiumGltfReader::GltfReaderResult& readGltf) {
         continue;
       }
 
-      decodePrimitive(readGltf, primitive, *pDraco);
+      std::optional<gsl::span<const std::byte>> maybeData =
+          getDracoData(readGltf, *pDraco);
+      if (!maybeData) {
+        continue;
+      }
+
+      primitives.emplace_back(
+          DracoPrimitive{&primitive, pDraco, *maybeData, nullptr, {}});
+    }
+  }
+
+  if (primitives.empty()) {
+    return;
+  }
+
+  CesiumAsync::forEachInParallel(
+      options.decodeAsyncSystem,
+      primitives.size(),
+      [&primitives](size_t i) { decodeDracoMesh(primitives[i]); });
+
+  // Lay out all of the decoded indices and attributes in a single new buffer,
+  // in the order of the primitives, and then fill it in.
+  const int32_t bufferIndex = static_cast<int32_t>(model.buffers.size());
+  int64_t byteLength = 0;
+  std::vector<DracoCopy> copies;
+  for (DracoPrimitive& primitive : primitives) {
+    if (!primitive.pMesh) {
+      readGltf.warnings.emplace_back(std::move(primitive.error));
+      continue;
+    }
+
+    addDecodedPrimitive(readGltf, primitive, bufferIndex, byteLength, copies);
+  }
+
+  if (copies.empty()) {
+    return;
+  }
+
+  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(static_cast<size_t>(byteLength));
+  buffer.byteLength = byteLength;
+
+  for (const DracoCopy& copy : copies) {
+    std::byte* pOut = buffer.cesium.data.data() + copy.byteOffset;
+    if (copy.pAttribute) {
+      copyDecodedAttribute(copy.pMesh, copy.pAttribute, *copy.pAccessor, pOut);
+    } else {
+      copyDecodedIndices(copy.pMesh, *copy.pAccessor, pOut);
     }
   }
 }
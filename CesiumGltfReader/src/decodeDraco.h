@@ -2,6 +2,9 @@
 
 namespace CesiumGltfReader {
 struct GltfReaderResult;
+struct GltfReaderOptions;
 
-void decodeDraco(GltfReaderResult& readGltf);
+void decodeDraco(
+    GltfReaderResult& readGltf,
+    const GltfReaderOptions& options);
 } // namespace CesiumGltfReader
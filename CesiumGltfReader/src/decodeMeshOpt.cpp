@@ -1,5 +1,6 @@
 #include "decodeMeshOpt.h"
 
+#include <CesiumAsync/forEachInParallel.h>
 #include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
 #include <CesiumGltfReader/GltfReader.h>
 
@@ -12,12 +13,27 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <cstdint>
+#include <vector>
+
 using namespace CesiumGltf;
 
 namespace CesiumGltfReader {
 
 namespace {
 
+/**
+ * @brief A compressed bufferView, and where it is decoded to.
+ */
+struct MeshOptBufferView {
+  BufferView* pBufferView;
+  const ExtensionBufferViewExtMeshoptCompression* pMeshOpt;
+  gsl::span<const std::byte> source;
+  int64_t byteOffset;
+  int64_t byteLength;
+  bool decoded;
+};
+
 void decodeFilter(
     std::byte* buffer,
     const ExtensionBufferViewExtMeshoptCompression& meshOpt) {
@@ -101,7 +117,15 @@ int decodeBufferView(
 }
 } // namespace
 
-void decodeMeshOpt(Model& model, CesiumGltfReader::GltfReaderResult& readGltf) {
+void decodeMeshOpt(
+    Model& model,
+    CesiumGltfReader::GltfReaderResult& readGltf,
+    const GltfReaderOptions& options) {
+  // Lay out the decoded bufferViews in a single new buffer, so that it is
+  // allocated once and each bufferView can be decoded independently into its
+  // own part of it.
+  std::vector<MeshOptBufferView> compressedViews;
+  int64_t totalByteLength = 0;
   for (BufferView& bufferView : model.bufferViews) {
     const ExtensionBufferViewExtMeshoptCompression* pMeshOpt =
         bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>();
@@ -129,30 +153,63 @@ void decodeMeshOpt(Model& model, CesiumGltfReader::GltfReaderResult& readGltf) {
         continue;
       }
 
-      std::vector<std::byte> data;
-      data.resize(static_cast<size_t>(byteLength));
-      if (decodeBufferView(
-              data.data(),
-              gsl::span<const std::byte>(
-                  pBuffer->cesium.data.data() + pMeshOpt->byteOffset,
-                  static_cast<size_t>(pMeshOpt->byteLength)),
-              *pMeshOpt) != 0) {
-        readGltf.warnings.emplace_back(
-            "The EXT_meshopt_compression extension has a corrupted or "
-            "incompatible meshopt compression buffer.");
-        continue;
-      }
-      decodeFilter(data.data(), *pMeshOpt);
-      Buffer& buffer = model.buffers.emplace_back();
-      buffer.byteLength = byteLength;
-      buffer.cesium.data = std::move(data);
-
-      bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
-      bufferView.byteOffset = 0;
-      bufferView.byteLength = byteLength;
-      bufferView.extensions.erase(
-          ExtensionBufferViewExtMeshoptCompression::ExtensionName);
+      // Align each bufferView for the SIMD filters.
+      totalByteLength = (totalByteLength + 15) & ~int64_t(15);
+
+      compressedViews.emplace_back(MeshOptBufferView{
+          &bufferView,
+          pMeshOpt,
+          gsl::span<const std::byte>(
+              pBuffer->cesium.data.data() + pMeshOpt->byteOffset,
+              static_cast<size_t>(pMeshOpt->byteLength)),
+          totalByteLength,
+          byteLength,
+          false});
+      totalByteLength += byteLength;
+    }
+  }
+
+  if (compressedViews.empty()) {
+    return;
+  }
+
+  std::vector<std::byte> data(static_cast<size_t>(totalByteLength));
+  CesiumAsync::forEachInParallel(
+      options.decodeAsyncSystem,
+      compressedViews.size(),
+      [&compressedViews, &data](size_t i) {
+        MeshOptBufferView& view = compressedViews[i];
+        std::byte* pDestination = data.data() + view.byteOffset;
+        view.decoded =
+            decodeBufferView(pDestination, view.source, *view.pMeshOpt) == 0;
+        if (view.decoded) {
+          decodeFilter(pDestination, *view.pMeshOpt);
+        }
+      });
+
+  const int32_t bufferIndex = static_cast<int32_t>(model.buffers.size());
+  bool anyDecoded = false;
+  for (const MeshOptBufferView& view : compressedViews) {
+    if (!view.decoded) {
+      readGltf.warnings.emplace_back(
+          "The EXT_meshopt_compression extension has a corrupted or "
+          "incompatible meshopt compression buffer.");
+      continue;
     }
+
+    anyDecoded = true;
+    BufferView& bufferView = *view.pBufferView;
+    bufferView.buffer = bufferIndex;
+    bufferView.byteOffset = view.byteOffset;
+    bufferView.byteLength = view.byteLength;
+    bufferView.extensions.erase(
+        ExtensionBufferViewExtMeshoptCompression::ExtensionName);
+  }
+
+  if (anyDecoded) {
+    Buffer& buffer = model.buffers.emplace_back();
+    buffer.byteLength = totalByteLength;
+    buffer.cesium.data = std::move(data);
   }
 }
 } // namespace CesiumGltfReader
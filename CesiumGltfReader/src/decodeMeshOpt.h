@@ -6,6 +6,7 @@ struct Model;
 
 namespace CesiumGltfReader {
 struct GltfReaderResult;
+struct GltfReaderOptions;
 }
 
 namespace CesiumGltfReader {
@@ -17,8 +18,13 @@ namespace CesiumGltfReader {
  * The decompressed buffer may be in a quantized format as specified by the
  * KHR_mesh_quantization extension, in which case the data will have to be
  * dequantized to get the original values.
+ *
+ * The bufferViews are decoded in parallel if
+ * {@link GltfReaderOptions::decodeAsyncSystem} is set, and are all placed in
+ * a single new buffer.
  **/
 void decodeMeshOpt(
     CesiumGltf::Model& model,
-    CesiumGltfReader::GltfReaderResult& readGltf);
+    CesiumGltfReader::GltfReaderResult& readGltf,
+    const CesiumGltfReader::GltfReaderOptions& options);
 } // namespace CesiumGltfReader
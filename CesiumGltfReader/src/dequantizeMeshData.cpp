@@ -22,17 +22,41 @@ template <> float intToFloat(std::int16_t c) {
 
 template <> float intToFloat(std::uint16_t c) { return c / 65535.0f; }
 
+template <typename T, size_t N, typename TConvert>
+void convertQuantized(
+    float* fPtr,
+    int64_t count,
+    const std::byte* bPtr,
+    int64_t stride,
+    TConvert convert) {
+  if (stride == static_cast<int64_t>(sizeof(T) * N)) {
+    // Tightly-packed values are converted in a single loop without
+    // dependencies between iterations, which compilers vectorize.
+    const T* pSource = reinterpret_cast<const T*>(bPtr);
+    const int64_t length = count * static_cast<int64_t>(N);
+    for (int64_t i = 0; i < length; ++i) {
+      fPtr[i] = convert(pSource[i]);
+    }
+    return;
+  }
+
+  for (int64_t i = 0; i < count; ++i, bPtr += stride, fPtr += N) {
+    const T* pSource = reinterpret_cast<const T*>(bPtr);
+    for (size_t j = 0; j < N; ++j) {
+      fPtr[j] = convert(pSource[j]);
+    }
+  }
+}
+
 template <typename T, size_t N>
 void normalizeQuantized(
     float* fPtr,
     int64_t count,
     const std::byte* bPtr,
     int64_t stride) {
-  for (int i = 0; i < count; i++, bPtr += stride) {
-    for (unsigned int j = 0; j < N; j++) {
-      *fPtr++ = intToFloat<T>(reinterpret_cast<const T*>(bPtr)[j]);
-    }
-  }
+  convertQuantized<T, N>(fPtr, count, bPtr, stride, [](T t) {
+    return intToFloat<T>(t);
+  });
 }
 
 template <typename T, size_t N>
@@ -41,11 +65,9 @@ void castQuantizedToFloat(
     int64_t count,
     const std::byte* bPtr,
     int64_t stride) {
-  for (int i = 0; i < count; i++, bPtr += stride) {
-    for (unsigned int j = 0; j < N; j++) {
-      *fPtr++ = static_cast<float>(reinterpret_cast<const T*>(bPtr)[j]);
-    }
-  }
+  convertQuantized<T, N>(fPtr, count, bPtr, stride, [](T t) {
+    return static_cast<float>(t);
+  });
 }
 
 template <typename T, size_t N>
@@ -155,7 +177,7 @@ void dequantizeAccessor(Model& model, Accessor& accessor) {
 }
 } // namespace
 
-void dequantizeMeshData(Model& model) {
+void dequantizeMeshData(Model& model, const GltfReaderOptions& options) {
   for (Mesh& mesh : model.meshes) {
     for (MeshPrimitive& primitive : mesh.primitives) {
       for (std::pair<const std::string, int32_t> attribute :
@@ -169,10 +191,15 @@ void dequantizeMeshData(Model& model) {
           continue;
         }
         const std::string& attributeName = attribute.first;
-        if (attributeName == "POSITION" || attributeName == "NORMAL" ||
-            attributeName == "TANGENT" || attributeName.find("TEXCOORD") == 0) {
-          dequantizeAccessor(model, *pAccessor);
+        if (attributeName != "POSITION" && attributeName != "NORMAL" &&
+            attributeName != "TANGENT" && attributeName.find("TEXCOORD") != 0) {
+          continue;
+        }
+        if (options.keepQuantizedAttribute &&
+            options.keepQuantizedAttribute(attributeName, *pAccessor)) {
+          continue;
         }
+        dequantizeAccessor(model, *pAccessor);
       }
     }
   }
@@ -5,11 +5,17 @@ struct Model;
 }
 
 namespace CesiumGltfReader {
+struct GltfReaderOptions;
 
 /**
  * @brief Dequantizes any quantized data in the accessors of the glTF model and
  * converts them to floating-point data as specified in the
  * KHR_quantization extension.
+ *
+ * Attributes for which {@link GltfReaderOptions::keepQuantizedAttribute}
+ * returns true are left as they are.
  */
-void dequantizeMeshData(CesiumGltf::Model& model);
+void dequantizeMeshData(
+    CesiumGltf::Model& model,
+    const GltfReaderOptions& options);
 } // namespace CesiumGltfReader
@@ -0,0 +1,162 @@
+#include "halveImage.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace CesiumGltfReader {
+
+namespace {
+// Linear values are kept with 12 bits of precision, which still distinguishes
+// all of the sRGB values and keeps the table back to sRGB small.
+constexpr int linearBits = 12;
+constexpr int linearMax = (1 << linearBits) - 1;
+
+const std::array<uint16_t, 256>& getSrgbToLinear() {
+  static const std::array<uint16_t, 256> table = []() {
+    std::array<uint16_t, 256> result{};
+    for (size_t i = 0; i < result.size(); ++i) {
+      const double srgb = double(i) / 255.0;
+      const double linear = srgb <= 0.04045
+                                ? srgb / 12.92
+                                : std::pow((srgb + 0.055) / 1.055, 2.4);
+      result[i] = uint16_t(std::lround(linear * linearMax));
+    }
+    return result;
+  }();
+  return table;
+}
+
+const std::array<uint8_t, linearMax + 1>& getLinearToSrgb() {
+  static const std::array<uint8_t, linearMax + 1> table = []() {
+    std::array<uint8_t, linearMax + 1> result{};
+    for (size_t i = 0; i < result.size(); ++i) {
+      const double linear = double(i) / linearMax;
+      const double srgb = linear <= 0.0031308
+                              ? linear * 12.92
+                              : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+      result[i] = uint8_t(std::lround(srgb * 255.0));
+    }
+    return result;
+  }();
+  return table;
+}
+
+// The channels are a template parameter so that the loops over the pixels of
+// a row have a fixed stride, which lets compilers vectorize them.
+template <int32_t Channels>
+void halveRows(
+    const uint8_t* pSource,
+    int32_t width,
+    int32_t height,
+    uint8_t* pDestination) {
+  const int32_t destinationWidth = std::max(width / 2, 1);
+  const int32_t destinationHeight = std::max(height / 2, 1);
+  const size_t sourceRowBytes = size_t(width) * Channels;
+  const size_t destinationRowBytes = size_t(destinationWidth) * Channels;
+
+  // An image that is one pixel wide or tall averages pairs of pixels, which
+  // is the same as averaging 2x2 blocks in which each pixel appears twice.
+  const size_t nextColumn = width > 1 ? Channels : 0;
+  const size_t nextRow = height > 1 ? sourceRowBytes : 0;
+
+  for (int32_t y = 0; y < destinationHeight; ++y) {
+    const uint8_t* pRow0 = pSource + size_t(y) * 2 * nextRow;
+    const uint8_t* pRow1 = pRow0 + nextRow;
+    uint8_t* pOut = pDestination + size_t(y) * destinationRowBytes;
+    for (int32_t x = 0; x < destinationWidth; ++x) {
+      const size_t i = size_t(x) * 2 * nextColumn;
+      for (size_t c = 0; c < size_t(Channels); ++c) {
+        const uint32_t sum = uint32_t(pRow0[i + c]) +
+                             pRow0[i + nextColumn + c] + pRow1[i + c] +
+                             pRow1[i + nextColumn + c];
+        pOut[size_t(x) * Channels + c] = uint8_t((sum + 2) >> 2);
+      }
+    }
+  }
+}
+
+template <int32_t Channels>
+void halveRowsSrgb(
+    const uint8_t* pSource,
+    int32_t width,
+    int32_t height,
+    uint8_t* pDestination) {
+  const std::array<uint16_t, 256>& toLinear = getSrgbToLinear();
+  const std::array<uint8_t, linearMax + 1>& toSrgb = getLinearToSrgb();
+
+  const int32_t destinationWidth = std::max(width / 2, 1);
+  const int32_t destinationHeight = std::max(height / 2, 1);
+  const size_t sourceRowBytes = size_t(width) * Channels;
+  const size_t destinationRowBytes = size_t(destinationWidth) * Channels;
+  const size_t nextColumn = width > 1 ? Channels : 0;
+  const size_t nextRow = height > 1 ? sourceRowBytes : 0;
+
+  // Two- and four-channel images have an alpha channel, which is linear.
+  constexpr size_t colorChannels =
+      Channels == 2 || Channels == 4 ? size_t(Channels) - 1 : size_t(Channels);
+
+  for (int32_t y = 0; y < destinationHeight; ++y) {
+    const uint8_t* pRow0 = pSource + size_t(y) * 2 * nextRow;
+    const uint8_t* pRow1 = pRow0 + nextRow;
+    uint8_t* pOut = pDestination + size_t(y) * destinationRowBytes;
+    for (int32_t x = 0; x < destinationWidth; ++x) {
+      const size_t i = size_t(x) * 2 * nextColumn;
+      for (size_t c = 0; c < colorChannels; ++c) {
+        const uint32_t sum =
+            uint32_t(toLinear[pRow0[i + c]]) +
+            toLinear[pRow0[i + nextColumn + c]] + toLinear[pRow1[i + c]] +
+            toLinear[pRow1[i + nextColumn + c]];
+        pOut[size_t(x) * Channels + c] = toSrgb[(sum + 2) >> 2];
+      }
+      for (size_t c = colorChannels; c < size_t(Channels); ++c) {
+        const uint32_t sum = uint32_t(pRow0[i + c]) +
+                             pRow0[i + nextColumn + c] + pRow1[i + c] +
+                             pRow1[i + nextColumn + c];
+        pOut[size_t(x) * Channels + c] = uint8_t((sum + 2) >> 2);
+      }
+    }
+  }
+}
+
+template <int32_t Channels>
+void halveImage(
+    const uint8_t* pSource,
+    int32_t width,
+    int32_t height,
+    bool sRGB,
+    uint8_t* pDestination) {
+  if (sRGB) {
+    halveRowsSrgb<Channels>(pSource, width, height, pDestination);
+  } else {
+    halveRows<Channels>(pSource, width, height, pDestination);
+  }
+}
+} // namespace
+
+void halveImage(
+    const std::byte* pSource,
+    int32_t width,
+    int32_t height,
+    int32_t channels,
+    bool sRGB,
+    std::byte* pDestination) {
+  const uint8_t* pIn = reinterpret_cast<const uint8_t*>(pSource);
+  uint8_t* pOut = reinterpret_cast<uint8_t*>(pDestination);
+  switch (channels) {
+  case 1:
+    halveImage<1>(pIn, width, height, sRGB, pOut);
+    break;
+  case 2:
+    halveImage<2>(pIn, width, height, sRGB, pOut);
+    break;
+  case 3:
+    halveImage<3>(pIn, width, height, sRGB, pOut);
+    break;
+  case 4:
+    halveImage<4>(pIn, width, height, sRGB, pOut);
+    break;
+  }
+}
+
+} // namespace CesiumGltfReader
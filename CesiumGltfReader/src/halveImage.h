@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumGltfReader {
+
+/**
+ * @brief Computes the next mip level of an image with one byte per channel, by
+ * averaging each 2x2 block of its pixels.
+ *
+ * The width and height must each be even or 1. The destination must have room
+ * for `max(width / 2, 1) * max(height / 2, 1)` pixels.
+ *
+ * @param pSource The pixels of the image, without padding between rows.
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param channels The number of channels, from 1 to 4.
+ * @param sRGB Whether the color channels are sRGB-encoded, in which case they
+ * are averaged in linear space. The alpha channel of a two- or four-channel
+ * image is always averaged as it is.
+ * @param pDestination The pixels of the next mip level.
+ */
+void halveImage(
+    const std::byte* pSource,
+    int32_t width,
+    int32_t height,
+    int32_t channels,
+    bool sRGB,
+    std::byte* pDestination);
+
+} // namespace CesiumGltfReader
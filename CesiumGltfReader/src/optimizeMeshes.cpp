@@ -0,0 +1,361 @@
+#include "optimizeMeshes.h"
+
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumGltf/Model.h>
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#endif
+#include <meshoptimizer.h>
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace CesiumGltfReader {
+
+namespace {
+
+void countUse(std::vector<uint32_t>& useCounts, int32_t index) {
+  if (index >= 0 && static_cast<size_t>(index) < useCounts.size()) {
+    ++useCounts[static_cast<size_t>(index)];
+  }
+}
+
+uint32_t getUseCount(const std::vector<uint32_t>& useCounts, int32_t index) {
+  if (index < 0 || static_cast<size_t>(index) >= useCounts.size()) {
+    return 0;
+  }
+  return useCounts[static_cast<size_t>(index)];
+}
+
+// The data of an accessor is only rewritten when nothing else refers to it.
+std::vector<uint32_t> countAccessorUses(const Model& model) {
+  std::vector<uint32_t> useCounts(model.accessors.size(), 0);
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      for (const auto& attribute : primitive.attributes) {
+        countUse(useCounts, attribute.second);
+      }
+      for (const auto& target : primitive.targets) {
+        for (const auto& attribute : target) {
+          countUse(useCounts, attribute.second);
+        }
+      }
+      countUse(useCounts, primitive.indices);
+    }
+  }
+
+  for (const Node& node : model.nodes) {
+    const ExtensionExtMeshGpuInstancing* pInstancing =
+        node.getExtension<ExtensionExtMeshGpuInstancing>();
+    if (pInstancing) {
+      for (const auto& attribute : pInstancing->attributes) {
+        countUse(useCounts, attribute.second);
+      }
+    }
+  }
+
+  for (const Skin& skin : model.skins) {
+    countUse(useCounts, skin.inverseBindMatrices);
+  }
+
+  for (const Animation& animation : model.animations) {
+    for (const AnimationSampler& sampler : animation.samplers) {
+      countUse(useCounts, sampler.input);
+      countUse(useCounts, sampler.output);
+    }
+  }
+
+  return useCounts;
+}
+
+/**
+ * @brief Where the elements of an accessor are in its buffer.
+ */
+struct AccessorData {
+  Accessor* pAccessor;
+  int32_t buffer;
+  std::byte* pData;
+  int64_t begin;
+  int64_t end;
+  int64_t stride;
+  int64_t elementSize;
+};
+
+std::optional<AccessorData> getAccessorData(Model& model, int32_t index) {
+  Accessor* pAccessor = Model::getSafe(&model.accessors, index);
+  if (!pAccessor || pAccessor->sparse || pAccessor->count <= 0) {
+    return std::nullopt;
+  }
+
+  const BufferView* pBufferView =
+      Model::getSafe(&model.bufferViews, pAccessor->bufferView);
+  if (!pBufferView) {
+    return std::nullopt;
+  }
+
+  Buffer* pBuffer = Model::getSafe(&model.buffers, pBufferView->buffer);
+  if (!pBuffer) {
+    return std::nullopt;
+  }
+
+  const int64_t elementSize = pAccessor->computeBytesPerVertex();
+  const int64_t stride = pAccessor->computeByteStride(model);
+  if (elementSize <= 0 || stride < elementSize) {
+    return std::nullopt;
+  }
+
+  const int64_t begin = pBufferView->byteOffset + pAccessor->byteOffset;
+  const int64_t end = begin + (pAccessor->count - 1) * stride + elementSize;
+  if (pBufferView->byteOffset < 0 || pAccessor->byteOffset < 0 ||
+      end > pBufferView->byteOffset + pBufferView->byteLength ||
+      end > static_cast<int64_t>(pBuffer->cesium.data.size())) {
+    return std::nullopt;
+  }
+
+  return AccessorData{
+      pAccessor,
+      pBufferView->buffer,
+      pBuffer->cesium.data.data() + begin,
+      begin,
+      end,
+      stride,
+      elementSize};
+}
+
+// Whether rewriting the elements of one accessor can change those of another.
+bool elementsOverlap(const AccessorData& a, const AccessorData& b) {
+  if (a.buffer != b.buffer || a.end <= b.begin || b.end <= a.begin) {
+    return false;
+  }
+
+  if (a.stride != b.stride) {
+    return true;
+  }
+
+  // Interleaved attributes share a range of bytes, but not their elements.
+  const int64_t offset = ((b.begin - a.begin) % a.stride + a.stride) % a.stride;
+  return offset < a.elementSize || a.stride - offset < b.elementSize;
+}
+
+template <typename T>
+void readIndices(const AccessorData& data, std::vector<uint32_t>& indices) {
+  for (size_t i = 0; i < indices.size(); ++i) {
+    T index;
+    std::memcpy(&index, data.pData + i * sizeof(T), sizeof(T));
+    indices[i] = index;
+  }
+}
+
+template <typename T>
+void writeIndices(std::byte* pData, const std::vector<uint32_t>& indices) {
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const T index = static_cast<T>(indices[i]);
+    std::memcpy(pData + i * sizeof(T), &index, sizeof(T));
+  }
+}
+
+void remapVertices(
+    const AccessorData& data,
+    const std::vector<uint32_t>& remap) {
+  const size_t elementSize = static_cast<size_t>(data.elementSize);
+  const size_t stride = static_cast<size_t>(data.stride);
+
+  std::vector<std::byte> elements(remap.size() * elementSize);
+  for (size_t i = 0; i < remap.size(); ++i) {
+    std::memcpy(
+        elements.data() + i * elementSize,
+        data.pData + i * stride,
+        elementSize);
+  }
+
+  for (size_t i = 0; i < remap.size(); ++i) {
+    std::memcpy(
+        data.pData + size_t(remap[i]) * stride,
+        elements.data() + i * elementSize,
+        elementSize);
+  }
+}
+
+void optimizePrimitive(
+    Model& model,
+    MeshPrimitive& primitive,
+    const std::vector<uint32_t>& useCounts) {
+  if (primitive.mode != MeshPrimitive::Mode::TRIANGLES ||
+      getUseCount(useCounts, primitive.indices) != 1) {
+    return;
+  }
+
+  const std::optional<AccessorData> maybeIndices =
+      getAccessorData(model, primitive.indices);
+  if (!maybeIndices || maybeIndices->stride != maybeIndices->elementSize) {
+    return;
+  }
+
+  Accessor& indexAccessor = *maybeIndices->pAccessor;
+  const int32_t componentType = indexAccessor.componentType;
+  if (indexAccessor.type != Accessor::Type::SCALAR ||
+      indexAccessor.count % 3 != 0 ||
+      (componentType != Accessor::ComponentType::UNSIGNED_BYTE &&
+       componentType != Accessor::ComponentType::UNSIGNED_SHORT &&
+       componentType != Accessor::ComponentType::UNSIGNED_INT)) {
+    return;
+  }
+
+  auto positionIt = primitive.attributes.find("POSITION");
+  if (positionIt == primitive.attributes.end()) {
+    return;
+  }
+
+  const Accessor* pPosition =
+      Model::getSafe(&model.accessors, positionIt->second);
+  if (!pPosition || pPosition->count <= 0 ||
+      pPosition->count > int64_t(UINT32_MAX)) {
+    return;
+  }
+  const int64_t vertexCount = pPosition->count;
+
+  // The vertices are only reordered if all of their accessors can be
+  // rewritten, but the triangles are reordered either way.
+  std::vector<AccessorData> vertexData;
+  bool canRemapVertices = true;
+  auto addVertexAccessor = [&](int32_t index) {
+    const Accessor* pAccessor = Model::getSafe(&model.accessors, index);
+    if (!pAccessor || pAccessor->count != vertexCount) {
+      return false;
+    }
+
+    std::optional<AccessorData> maybeData = getAccessorData(model, index);
+    if (!maybeData || getUseCount(useCounts, index) != 1) {
+      canRemapVertices = false;
+    } else {
+      vertexData.emplace_back(*maybeData);
+    }
+    return true;
+  };
+
+  for (const auto& attribute : primitive.attributes) {
+    if (!addVertexAccessor(attribute.second)) {
+      return;
+    }
+  }
+  for (const auto& target : primitive.targets) {
+    for (const auto& attribute : target) {
+      if (!addVertexAccessor(attribute.second)) {
+        return;
+      }
+    }
+  }
+
+  for (size_t i = 0; canRemapVertices && i < vertexData.size(); ++i) {
+    for (size_t j = i + 1; j < vertexData.size(); ++j) {
+      if (elementsOverlap(vertexData[i], vertexData[j])) {
+        canRemapVertices = false;
+        break;
+      }
+    }
+  }
+
+  std::vector<uint32_t> indices(static_cast<size_t>(indexAccessor.count));
+  switch (componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    readIndices<uint8_t>(*maybeIndices, indices);
+    break;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    readIndices<uint16_t>(*maybeIndices, indices);
+    break;
+  default:
+    readIndices<uint32_t>(*maybeIndices, indices);
+    break;
+  }
+
+  if (std::any_of(indices.begin(), indices.end(), [vertexCount](uint32_t i) {
+        return int64_t(i) >= vertexCount;
+      })) {
+    return;
+  }
+
+  std::vector<uint32_t> optimized(indices.size());
+  meshopt_optimizeVertexCache(
+      optimized.data(),
+      indices.data(),
+      indices.size(),
+      static_cast<size_t>(vertexCount));
+
+  if (canRemapVertices) {
+    std::vector<uint32_t> remap(static_cast<size_t>(vertexCount));
+    const size_t usedVertexCount = meshopt_optimizeVertexFetchRemap(
+        remap.data(),
+        optimized.data(),
+        optimized.size(),
+        remap.size());
+
+    // The vertices that no triangle uses are kept after the others, so that
+    // the counts and the bounds of the accessors stay the same.
+    uint32_t nextVertex = static_cast<uint32_t>(usedVertexCount);
+    for (uint32_t& vertex : remap) {
+      if (vertex == ~0u) {
+        vertex = nextVertex++;
+      }
+    }
+
+    meshopt_remapIndexBuffer(
+        optimized.data(),
+        optimized.data(),
+        optimized.size(),
+        remap.data());
+
+    for (const AccessorData& data : vertexData) {
+      remapVertices(data, remap);
+    }
+
+    if (!indexAccessor.min.empty() && !indexAccessor.max.empty()) {
+      const auto minMax =
+          std::minmax_element(optimized.begin(), optimized.end());
+      indexAccessor.min = {double(*minMax.first)};
+      indexAccessor.max = {double(*minMax.second)};
+    }
+  }
+
+  // 32-bit indices are narrowed when every vertex can be addressed with 16
+  // bits, because the largest value is reserved for primitive restart. The
+  // narrowed indices are written over the start of the original ones.
+  switch (componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    writeIndices<uint8_t>(maybeIndices->pData, optimized);
+    break;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    writeIndices<uint16_t>(maybeIndices->pData, optimized);
+    break;
+  default:
+    if (vertexCount <= int64_t(UINT16_MAX)) {
+      writeIndices<uint16_t>(maybeIndices->pData, optimized);
+      indexAccessor.componentType = Accessor::ComponentType::UNSIGNED_SHORT;
+    } else {
+      writeIndices<uint32_t>(maybeIndices->pData, optimized);
+    }
+    break;
+  }
+}
+
+} // namespace
+
+void optimizeMeshes(Model& model) {
+  const std::vector<uint32_t> useCounts = countAccessorUses(model);
+  for (Mesh& mesh : model.meshes) {
+    for (MeshPrimitive& primitive : mesh.primitives) {
+      optimizePrimitive(model, primitive, useCounts);
+    }
+  }
+}
+} // namespace CesiumGltfReader
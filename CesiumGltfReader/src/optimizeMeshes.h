@@ -0,0 +1,19 @@
+#pragma once
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumGltfReader {
+
+/**
+ * @brief Reorders the triangles and vertices of the indexed triangle
+ * primitives of the glTF model for the GPU's vertex cache and vertex fetch,
+ * and narrows 32-bit indices to 16 bits where the vertices allow it.
+ *
+ * The data is rewritten in place. The vertices are only reordered when the
+ * accessors of a primitive are not shared with anything else, and
+ * primitives whose data can't be read are left as they are.
+ */
+void optimizeMeshes(CesiumGltf::Model& model);
+} // namespace CesiumGltfReader
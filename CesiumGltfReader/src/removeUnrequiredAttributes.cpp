@@ -0,0 +1,339 @@
+#include "removeUnrequiredAttributes.h"
+
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfReader/GltfReader.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace CesiumGltfReader {
+
+namespace {
+
+void markUsed(std::vector<bool>& used, int32_t index) {
+  if (index >= 0 && static_cast<size_t>(index) < used.size()) {
+    used[static_cast<size_t>(index)] = true;
+  }
+}
+
+std::vector<bool> findUsedAccessors(const Model& model) {
+  std::vector<bool> used(model.accessors.size(), false);
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      for (const auto& attribute : primitive.attributes) {
+        markUsed(used, attribute.second);
+      }
+      for (const auto& target : primitive.targets) {
+        for (const auto& attribute : target) {
+          markUsed(used, attribute.second);
+        }
+      }
+      markUsed(used, primitive.indices);
+    }
+  }
+
+  for (const Node& node : model.nodes) {
+    const ExtensionExtMeshGpuInstancing* pInstancing =
+        node.getExtension<ExtensionExtMeshGpuInstancing>();
+    if (pInstancing) {
+      for (const auto& attribute : pInstancing->attributes) {
+        markUsed(used, attribute.second);
+      }
+    }
+  }
+
+  for (const Skin& skin : model.skins) {
+    markUsed(used, skin.inverseBindMatrices);
+  }
+
+  for (const Animation& animation : model.animations) {
+    for (const AnimationSampler& sampler : animation.samplers) {
+      markUsed(used, sampler.input);
+      markUsed(used, sampler.output);
+    }
+  }
+
+  return used;
+}
+
+std::vector<bool> findUsedBufferViews(const Model& model) {
+  std::vector<bool> used(model.bufferViews.size(), false);
+  for (const Accessor& accessor : model.accessors) {
+    markUsed(used, accessor.bufferView);
+    if (accessor.sparse) {
+      markUsed(used, accessor.sparse->indices.bufferView);
+      markUsed(used, accessor.sparse->values.bufferView);
+    }
+  }
+
+  for (const Image& image : model.images) {
+    markUsed(used, image.bufferView);
+  }
+
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      const ExtensionKhrDracoMeshCompression* pDraco =
+          primitive.getExtension<ExtensionKhrDracoMeshCompression>();
+      if (pDraco) {
+        markUsed(used, pDraco->bufferView);
+      }
+    }
+  }
+
+  const ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  if (pMetadata) {
+    for (const PropertyTable& propertyTable : pMetadata->propertyTables) {
+      for (const auto& property : propertyTable.properties) {
+        markUsed(used, property.second.values);
+        markUsed(used, property.second.arrayOffsets);
+        markUsed(used, property.second.stringOffsets);
+      }
+    }
+  }
+
+  return used;
+}
+
+bool removeAttributes(
+    std::unordered_map<std::string, int32_t>& attributes,
+    const GltfReaderOptions& options) {
+  bool anyRemoved = false;
+  for (auto it = attributes.begin(); it != attributes.end();) {
+    if (options.isAttributeRequired(it->first)) {
+      ++it;
+    } else {
+      it = attributes.erase(it);
+      anyRemoved = true;
+    }
+  }
+  return anyRemoved;
+}
+
+/**
+ * @brief A part of a buffer that is still used, and where it is moved to.
+ */
+struct BufferSpan {
+  int64_t byteOffset;
+  int64_t byteEnd;
+  int64_t newByteOffset;
+};
+
+bool addUsedRange(
+    std::vector<BufferSpan>& ranges,
+    int64_t byteOffset,
+    int64_t byteLength,
+    int64_t bufferByteLength) {
+  if (byteOffset < 0 || byteLength < 0 ||
+      byteOffset + byteLength > bufferByteLength) {
+    return false;
+  }
+  ranges.emplace_back(BufferSpan{byteOffset, byteOffset + byteLength, 0});
+  return true;
+}
+
+int64_t moveOffset(const std::vector<BufferSpan>& spans, int64_t byteOffset) {
+  auto it = std::upper_bound(
+      spans.begin(),
+      spans.end(),
+      byteOffset,
+      [](int64_t offset, const BufferSpan& span) {
+        return offset < span.byteOffset;
+      });
+  const BufferSpan& span = *(it - 1);
+  return span.newByteOffset + (byteOffset - span.byteOffset);
+}
+
+/**
+ * @brief Removes the bytes of the dropped bufferViews from the buffers that
+ * have data, and moves the other bufferViews to match.
+ *
+ * Each part of a buffer that is still used keeps its position modulo 16, so
+ * the alignment of the data in it is preserved.
+ */
+void compactBuffers(Model& model, const std::vector<bool>& isDropped) {
+  for (size_t bufferIndex = 0; bufferIndex < model.buffers.size();
+       ++bufferIndex) {
+    Buffer& buffer = model.buffers[bufferIndex];
+    const int64_t bufferByteLength =
+        static_cast<int64_t>(buffer.cesium.data.size());
+    if (bufferByteLength == 0) {
+      continue;
+    }
+
+    const int32_t index = static_cast<int32_t>(bufferIndex);
+    std::vector<BufferSpan> ranges;
+    bool anyDropped = false;
+    bool valid = true;
+    for (size_t i = 0; i < model.bufferViews.size() && valid; ++i) {
+      const BufferView& bufferView = model.bufferViews[i];
+      const ExtensionBufferViewExtMeshoptCompression* pMeshOpt =
+          bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>();
+      if (isDropped[i]) {
+        anyDropped = anyDropped || bufferView.buffer == index ||
+                     (pMeshOpt && pMeshOpt->buffer == index);
+        continue;
+      }
+
+      if (bufferView.buffer == index) {
+        valid = addUsedRange(
+            ranges,
+            bufferView.byteOffset,
+            bufferView.byteLength,
+            bufferByteLength);
+      }
+      if (valid && pMeshOpt && pMeshOpt->buffer == index) {
+        valid = addUsedRange(
+            ranges,
+            pMeshOpt->byteOffset,
+            pMeshOpt->byteLength,
+            bufferByteLength);
+      }
+    }
+
+    // A buffer with a bufferView that extends beyond it is left alone.
+    if (!anyDropped || !valid) {
+      continue;
+    }
+
+    std::sort(
+        ranges.begin(),
+        ranges.end(),
+        [](const BufferSpan& a, const BufferSpan& b) {
+          return a.byteOffset < b.byteOffset;
+        });
+
+    std::vector<BufferSpan> spans;
+    int64_t newByteLength = 0;
+    for (const BufferSpan& range : ranges) {
+      if (!spans.empty() && range.byteOffset <= spans.back().byteEnd) {
+        BufferSpan& span = spans.back();
+        span.byteEnd = std::max(span.byteEnd, range.byteEnd);
+        newByteLength = span.newByteOffset + (span.byteEnd - span.byteOffset);
+        continue;
+      }
+
+      const int64_t padding = (range.byteOffset - newByteLength) & 15;
+      spans.emplace_back(BufferSpan{
+          range.byteOffset,
+          range.byteEnd,
+          newByteLength + padding});
+      newByteLength += padding + (range.byteEnd - range.byteOffset);
+    }
+
+    if (newByteLength >= bufferByteLength) {
+      continue;
+    }
+
+    std::vector<std::byte> data(static_cast<size_t>(newByteLength));
+    for (const BufferSpan& span : spans) {
+      std::copy(
+          buffer.cesium.data.begin() + span.byteOffset,
+          buffer.cesium.data.begin() + span.byteEnd,
+          data.begin() + span.newByteOffset);
+    }
+    buffer.cesium.data = std::move(data);
+    buffer.byteLength = newByteLength;
+
+    for (size_t i = 0; i < model.bufferViews.size(); ++i) {
+      if (isDropped[i]) {
+        continue;
+      }
+
+      BufferView& bufferView = model.bufferViews[i];
+      if (bufferView.buffer == index) {
+        bufferView.byteOffset = moveOffset(spans, bufferView.byteOffset);
+      }
+
+      ExtensionBufferViewExtMeshoptCompression* pMeshOpt =
+          bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>();
+      if (pMeshOpt && pMeshOpt->buffer == index) {
+        pMeshOpt->byteOffset = moveOffset(spans, pMeshOpt->byteOffset);
+      }
+    }
+  }
+}
+
+} // namespace
+
+void removeUnrequiredAttributes(
+    Model& model,
+    const GltfReaderOptions& options) {
+  const std::vector<bool> accessorsUsedBefore = findUsedAccessors(model);
+  const std::vector<bool> bufferViewsUsedBefore = findUsedBufferViews(model);
+
+  bool anyRemoved = false;
+  for (Mesh& mesh : model.meshes) {
+    for (MeshPrimitive& primitive : mesh.primitives) {
+      anyRemoved = removeAttributes(primitive.attributes, options) ||
+                   anyRemoved;
+      for (auto& target : primitive.targets) {
+        anyRemoved = removeAttributes(target, options) || anyRemoved;
+      }
+
+      // The decoded values of the removed attributes are not copied out of
+      // the decoded Draco mesh.
+      ExtensionKhrDracoMeshCompression* pDraco =
+          primitive.getExtension<ExtensionKhrDracoMeshCompression>();
+      if (pDraco) {
+        removeAttributes(pDraco->attributes, options);
+      }
+    }
+  }
+
+  if (!anyRemoved) {
+    return;
+  }
+
+  // Accessors that were used only by the removed attributes no longer refer
+  // to any data.
+  const std::vector<bool> accessorsUsedAfter = findUsedAccessors(model);
+  for (size_t i = 0; i < model.accessors.size(); ++i) {
+    if (accessorsUsedBefore[i] && !accessorsUsedAfter[i]) {
+      Accessor& accessor = model.accessors[i];
+      accessor.bufferView = -1;
+      accessor.byteOffset = 0;
+      accessor.sparse.reset();
+    }
+  }
+
+  // The bufferViews that were used only by those accessors are dropped.
+  const std::vector<bool> bufferViewsUsedAfter = findUsedBufferViews(model);
+  std::vector<bool> isDropped(model.bufferViews.size(), false);
+  bool anyDropped = false;
+  for (size_t i = 0; i < model.bufferViews.size(); ++i) {
+    isDropped[i] = bufferViewsUsedBefore[i] && !bufferViewsUsedAfter[i];
+    anyDropped = anyDropped || isDropped[i];
+  }
+
+  if (!anyDropped) {
+    return;
+  }
+
+  compactBuffers(model, isDropped);
+
+  // The dropped bufferViews stay in the model so that the indices of the
+  // others don't change, but they no longer have any bytes to decode.
+  for (size_t i = 0; i < model.bufferViews.size(); ++i) {
+    if (isDropped[i]) {
+      BufferView& bufferView = model.bufferViews[i];
+      bufferView.byteOffset = 0;
+      bufferView.byteLength = 0;
+      bufferView.byteStride.reset();
+      bufferView.extensions.erase(
+          ExtensionBufferViewExtMeshoptCompression::ExtensionName);
+    }
+  }
+}
+
+} // namespace CesiumGltfReader
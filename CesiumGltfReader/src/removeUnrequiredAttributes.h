@@ -0,0 +1,23 @@
+#pragma once
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumGltfReader {
+struct GltfReaderOptions;
+
+/**
+ * @brief Removes the vertex attributes that are not in
+ * {@link GltfReaderOptions::requiredAttributes} from the primitives of the
+ * glTF model, and drops the data that only they used.
+ *
+ * This is done before the model is decoded, so that the decoders skip the
+ * removed attributes. Accessors that are no longer used lose their
+ * bufferView, and the bufferViews that are then unused are emptied and
+ * their bytes are removed from their buffers.
+ */
+void removeUnrequiredAttributes(
+    CesiumGltf::Model& model,
+    const GltfReaderOptions& options);
+} // namespace CesiumGltfReader
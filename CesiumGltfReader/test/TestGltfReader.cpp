@@ -1,22 +1,45 @@
 #include "CesiumGltfReader/GltfReader.h"
+#include "CesiumGltfReader/GltfStreamReader.h"
 
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/WorkStealingTaskProcessor.h>
 #include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/ExtensionCesiumRTC.h>
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
+#include <CesiumUtility/DeferredJsonValue.h>
 #include <CesiumUtility/Math.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
 
 #include <catch2/catch.hpp>
 #include <glm/vec3.hpp>
 #include <gsl/span>
 #include <rapidjson/reader.h>
 
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4127 4018 4804)
+#endif
+
+#include <draco/compression/encode.h>
+#include <draco/core/encoder_buffer.h>
+#include <draco/mesh/triangle_soup_mesh_builder.h>
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <limits>
+#include <memory>
 #include <string>
 
 using namespace CesiumGltf;
 using namespace CesiumGltfReader;
+using namespace CesiumNativeTests;
 using namespace CesiumUtility;
 
 namespace {
@@ -218,6 +241,210 @@ TEST_CASE("Can decompress meshes using EXT_meshopt_compression") {
   }
 }
 
+TEST_CASE("Decodes EXT_meshopt_compression bufferViews into one buffer") {
+  std::vector<std::byte> data = readFile(
+      CesiumGltfReader_TEST_DATA_DIR +
+      std::string("/DucksMeshopt/Duck-vp-9-vt-9-vn-9.glb"));
+  GltfReader reader;
+
+  GltfReaderOptions options;
+  GltfReaderResult serialResult = reader.readGltf(data, options);
+  REQUIRE(serialResult.model);
+
+  options.decodeAsyncSystem =
+      CesiumAsync::AsyncSystem(std::make_shared<SimpleTaskProcessor>());
+  GltfReaderResult parallelResult = reader.readGltf(data, options);
+  REQUIRE(parallelResult.model);
+  CHECK(parallelResult.warnings.empty());
+
+  const Model& serialModel = *serialResult.model;
+  const Model& parallelModel = *parallelResult.model;
+  REQUIRE(
+      parallelModel.bufferViews.size() == serialModel.bufferViews.size());
+
+  // All of the decoded bufferViews share the one new buffer.
+  const int32_t decodedBuffer =
+      static_cast<int32_t>(parallelModel.buffers.size()) - 1;
+  size_t decodedViews = 0;
+  for (size_t i = 0; i < parallelModel.bufferViews.size(); ++i) {
+    const BufferView& parallelView = parallelModel.bufferViews[i];
+    const BufferView& serialView = serialModel.bufferViews[i];
+    if (parallelView.buffer != decodedBuffer) {
+      continue;
+    }
+    ++decodedViews;
+    CHECK(parallelView.byteOffset % 16 == 0);
+    REQUIRE(parallelView.byteLength == serialView.byteLength);
+
+    const std::vector<std::byte>& parallelData =
+        parallelModel.buffers[size_t(parallelView.buffer)].cesium.data;
+    const std::vector<std::byte>& serialData =
+        serialModel.buffers[size_t(serialView.buffer)].cesium.data;
+    CHECK(std::equal(
+        parallelData.begin() + parallelView.byteOffset,
+        parallelData.begin() + parallelView.byteOffset +
+            parallelView.byteLength,
+        serialData.begin() + serialView.byteOffset));
+  }
+  CHECK(decodedViews > 1);
+}
+
+TEST_CASE("Can keep some attributes quantized") {
+  std::vector<std::byte> data = readFile(
+      CesiumGltfReader_TEST_DATA_DIR +
+      std::string("/DucksMeshopt/Duck-vp-9-vt-9-vn-9.glb"));
+  GltfReader reader;
+
+  GltfReaderOptions options;
+  options.keepQuantizedAttribute = [](const std::string& attributeName,
+                                      const Accessor& accessor) {
+    return attributeName == "NORMAL" &&
+           accessor.componentType == Accessor::ComponentType::SHORT;
+  };
+  GltfReaderResult result = reader.readGltf(data, options);
+  REQUIRE(result.model);
+  const Model& model = *result.model;
+
+  const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+  const Accessor& normal =
+      model.accessors[size_t(primitive.attributes.at("NORMAL"))];
+  const Accessor& position =
+      model.accessors[size_t(primitive.attributes.at("POSITION"))];
+  const Accessor& texCoord =
+      model.accessors[size_t(primitive.attributes.at("TEXCOORD_0"))];
+  CHECK(normal.componentType == Accessor::ComponentType::SHORT);
+  CHECK(normal.normalized);
+  CHECK(position.componentType == Accessor::ComponentType::FLOAT);
+  CHECK(texCoord.componentType == Accessor::ComponentType::FLOAT);
+}
+
+TEST_CASE("Drops the vertex attributes that are not required") {
+  GltfReader reader;
+  GltfReaderOptions options;
+  options.requiredAttributes = std::vector<std::string>{"TEXCOORD_0"};
+
+  auto getBufferBytes = [](const Model& model) {
+    size_t bytes = 0;
+    for (const Buffer& buffer : model.buffers) {
+      bytes += buffer.cesium.data.size();
+    }
+    return bytes;
+  };
+
+  SECTION("Uncompressed") {
+    std::vector<std::byte> data = readFile(
+        CesiumGltfReader_TEST_DATA_DIR +
+        std::string("/DucksMeshopt/Duck.glb"));
+    GltfReaderResult fullResult = reader.readGltf(data);
+    GltfReaderResult result = reader.readGltf(data, options);
+    REQUIRE(fullResult.model);
+    REQUIRE(result.model);
+    const Model& fullModel = *fullResult.model;
+    const Model& model = *result.model;
+
+    const MeshPrimitive& fullPrimitive = fullModel.meshes[0].primitives[0];
+    const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+    CHECK(primitive.attributes.size() == 2);
+    CHECK(primitive.attributes.count("POSITION") == 1);
+    CHECK(primitive.attributes.count("TEXCOORD_0") == 1);
+    CHECK(primitive.attributes.count("NORMAL") == 0);
+
+    const Accessor& normal =
+        model.accessors[size_t(fullPrimitive.attributes.at("NORMAL"))];
+    CHECK(normal.bufferView == -1);
+    CHECK(getBufferBytes(model) <= getBufferBytes(fullModel));
+
+    // The data that is kept is unchanged wherever it was moved to.
+    AccessorView<glm::vec3> fullPositions(
+        fullModel,
+        fullPrimitive.attributes.at("POSITION"));
+    AccessorView<glm::vec3> positions(
+        model,
+        primitive.attributes.at("POSITION"));
+    REQUIRE(positions.status() == AccessorViewStatus::Valid);
+    REQUIRE(positions.size() == fullPositions.size());
+    for (int64_t i = 0; i < positions.size(); ++i) {
+      CHECK(positions[i] == fullPositions[i]);
+    }
+
+    AccessorView<uint16_t> fullIndices(fullModel, fullPrimitive.indices);
+    AccessorView<uint16_t> indices(model, primitive.indices);
+    REQUIRE(indices.status() == AccessorViewStatus::Valid);
+    REQUIRE(indices.size() == fullIndices.size());
+    for (int64_t i = 0; i < indices.size(); ++i) {
+      CHECK(indices[i] == fullIndices[i]);
+    }
+  }
+
+  SECTION("Compressed with EXT_meshopt_compression") {
+    std::vector<std::byte> data = readFile(
+        CesiumGltfReader_TEST_DATA_DIR +
+        std::string("/DucksMeshopt/Duck-vp-9-vt-9-vn-9.glb"));
+    GltfReaderResult fullResult = reader.readGltf(data);
+    GltfReaderResult result = reader.readGltf(data, options);
+    REQUIRE(fullResult.model);
+    REQUIRE(result.model);
+    CHECK(result.warnings.empty());
+
+    const Model& model = *result.model;
+    const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+    CHECK(primitive.attributes.count("NORMAL") == 0);
+
+    // The normals are not decoded.
+    CHECK(getBufferBytes(model) < getBufferBytes(*fullResult.model));
+  }
+}
+
+TEST_CASE("Optimizes meshes for the vertex cache and vertex fetch") {
+  std::vector<std::byte> data = readFile(
+      CesiumGltfReader_TEST_DATA_DIR + std::string("/DucksMeshopt/Duck.glb"));
+
+  GltfReader reader;
+  GltfReaderOptions options;
+  options.optimizeMeshes = true;
+  GltfReaderResult fullResult = reader.readGltf(data);
+  GltfReaderResult result = reader.readGltf(data, options);
+  REQUIRE(fullResult.model);
+  REQUIRE(result.model);
+
+  auto getTriangles = [](const Model& model) {
+    const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+    AccessorView<glm::vec3> positions(
+        model,
+        primitive.attributes.at("POSITION"));
+    AccessorView<uint16_t> indices(model, primitive.indices);
+    REQUIRE(positions.status() == AccessorViewStatus::Valid);
+    REQUIRE(indices.status() == AccessorViewStatus::Valid);
+
+    std::vector<std::array<float, 9>> triangles;
+    for (int64_t i = 0; i + 2 < indices.size(); i += 3) {
+      std::array<float, 9>& triangle = triangles.emplace_back();
+      for (int64_t j = 0; j < 3; ++j) {
+        const glm::vec3& position = positions[indices[i + j]];
+        for (glm::length_t k = 0; k < 3; ++k) {
+          triangle[size_t(j * 3 + k)] = position[k];
+        }
+      }
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+  };
+
+  // The same triangles are drawn, with the same winding.
+  CHECK(getTriangles(*result.model) == getTriangles(*fullResult.model));
+
+  // The vertices are in the order that the triangles first use them.
+  const Model& model = *result.model;
+  AccessorView<uint16_t> indices(model, model.meshes[0].primitives[0].indices);
+  uint16_t nextVertex = 0;
+  for (int64_t i = 0; i < indices.size(); ++i) {
+    CHECK(indices[i] <= nextVertex);
+    if (indices[i] == nextVertex) {
+      ++nextVertex;
+    }
+  }
+}
+
 TEST_CASE("Read TriangleWithoutIndices") {
   std::filesystem::path gltfFile = CesiumGltfReader_TEST_DATA_DIR;
   gltfFile /=
@@ -388,6 +615,335 @@ TEST_CASE("Can deserialize KHR_draco_mesh_compression") {
   REQUIRE(!primitive3.getExtension<ExtensionKhrDracoMeshCompression>());
 }
 
+namespace {
+struct DracoGrid {
+  std::vector<std::byte> data;
+  uint32_t positionAttribute;
+  int64_t pointCount;
+  int64_t faceCount;
+};
+
+// Encodes a grid of quads with Draco, two triangles per quad.
+DracoGrid encodeDracoGrid(uint32_t columns, uint32_t rows) {
+  draco::TriangleSoupMeshBuilder builder;
+  builder.Start(static_cast<int>(2 * columns * rows));
+  const int positionAttribute = builder.AddAttribute(
+      draco::GeometryAttribute::POSITION,
+      3,
+      draco::DT_FLOAT32);
+
+  uint32_t face = 0;
+  for (uint32_t y = 0; y < rows; ++y) {
+    for (uint32_t x = 0; x < columns; ++x) {
+      const float x0 = static_cast<float>(x);
+      const float y0 = static_cast<float>(y);
+      const std::array<float, 3> p00{x0, y0, 0.0f};
+      const std::array<float, 3> p10{x0 + 1.0f, y0, 0.0f};
+      const std::array<float, 3> p01{x0, y0 + 1.0f, 0.0f};
+      const std::array<float, 3> p11{x0 + 1.0f, y0 + 1.0f, 0.0f};
+      builder.SetAttributeValuesForFace(
+          positionAttribute,
+          draco::FaceIndex(face++),
+          p00.data(),
+          p10.data(),
+          p11.data());
+      builder.SetAttributeValuesForFace(
+          positionAttribute,
+          draco::FaceIndex(face++),
+          p00.data(),
+          p11.data(),
+          p01.data());
+    }
+  }
+
+  std::unique_ptr<draco::Mesh> pMesh = builder.Finalize();
+  REQUIRE(pMesh);
+
+  draco::Encoder encoder;
+  encoder.SetEncodingMethod(draco::MESH_SEQUENTIAL_ENCODING);
+  draco::EncoderBuffer buffer;
+  REQUIRE(encoder.EncodeMeshToBuffer(*pMesh, &buffer).ok());
+
+  DracoGrid grid;
+  grid.data.resize(buffer.size());
+  std::memcpy(grid.data.data(), buffer.data(), buffer.size());
+  grid.positionAttribute = pMesh->attribute(positionAttribute)->unique_id();
+  grid.pointCount = static_cast<int64_t>(pMesh->num_points());
+  grid.faceCount = static_cast<int64_t>(pMesh->num_faces());
+  return grid;
+}
+
+// Creates a GLB with a mesh that has one Draco-compressed primitive per grid,
+// each with its own bufferView of the binary chunk.
+std::vector<std::byte> createDracoGlb(const std::vector<DracoGrid>& grids) {
+  std::vector<std::byte> binary;
+  std::string accessors;
+  std::string bufferViews;
+  std::string primitives;
+  for (size_t i = 0; i < grids.size(); ++i) {
+    const DracoGrid& grid = grids[i];
+    const std::string separator = i == 0 ? "" : ",";
+    accessors += separator + R"({"componentType":5126,"type":"VEC3","count":)" +
+                 std::to_string(grid.pointCount) + "}," +
+                 R"({"componentType":5123,"type":"SCALAR","count":)" +
+                 std::to_string(3 * grid.faceCount) + "}";
+    bufferViews += separator + R"({"buffer":0,"byteOffset":)" +
+                   std::to_string(binary.size()) + R"(,"byteLength":)" +
+                   std::to_string(grid.data.size()) + "}";
+    primitives += separator + R"({"attributes":{"POSITION":)" +
+                  std::to_string(2 * i) + R"(},"indices":)" +
+                  std::to_string(2 * i + 1) +
+                  R"(,"extensions":{"KHR_draco_mesh_compression":{)" +
+                  R"("bufferView":)" + std::to_string(i) +
+                  R"(,"attributes":{"POSITION":)" +
+                  std::to_string(grid.positionAttribute) + "}}}}";
+    binary.insert(binary.end(), grid.data.begin(), grid.data.end());
+  }
+
+  std::string json =
+      R"({"asset":{"version":"2.0"},)"
+      R"("extensionsUsed":["KHR_draco_mesh_compression"],)"
+      R"("extensionsRequired":["KHR_draco_mesh_compression"],)"
+      R"("buffers":[{"byteLength":)" +
+      std::to_string(binary.size()) + R"(}],"bufferViews":[)" + bufferViews +
+      R"(],"accessors":[)" + accessors + R"(],"meshes":[{"primitives":[)" +
+      primitives + "]}]}";
+
+  // Both chunks must be padded to four bytes.
+  json.resize((json.size() + 3) & ~size_t(3), ' ');
+  binary.resize((binary.size() + 3) & ~size_t(3), std::byte(0));
+
+  std::vector<std::byte> glb;
+  const auto addUint32 = [&glb](size_t value) {
+    const uint32_t value32 = static_cast<uint32_t>(value);
+    const std::byte* pValue = reinterpret_cast<const std::byte*>(&value32);
+    glb.insert(glb.end(), pValue, pValue + sizeof(value32));
+  };
+  addUint32(0x46546C67); // glTF
+  addUint32(2);
+  addUint32(12 + 8 + json.size() + 8 + binary.size());
+  addUint32(json.size());
+  addUint32(0x4E4F534A); // JSON
+  const std::byte* pJson = reinterpret_cast<const std::byte*>(json.data());
+  glb.insert(glb.end(), pJson, pJson + json.size());
+  addUint32(binary.size());
+  addUint32(0x004E4942); // BIN
+  glb.insert(glb.end(), binary.begin(), binary.end());
+  return glb;
+}
+} // namespace
+
+TEST_CASE("Decodes Draco primitives in worker threads like in one thread") {
+  std::vector<DracoGrid> grids;
+  for (uint32_t i = 0; i < 8; ++i) {
+    grids.emplace_back(encodeDracoGrid(i + 1, 2 * i + 3));
+  }
+  const std::vector<std::byte> data = createDracoGlb(grids);
+
+  GltfReader reader;
+  GltfReaderOptions options;
+  GltfReaderResult serialResult = reader.readGltf(data, options);
+  REQUIRE(serialResult.model);
+  CHECK(serialResult.errors.empty());
+  CHECK(serialResult.warnings.empty());
+
+  options.decodeAsyncSystem = CesiumAsync::AsyncSystem(
+      std::make_shared<CesiumAsync::WorkStealingTaskProcessor>(4));
+  GltfReaderResult parallelResult = reader.readGltf(data, options);
+  REQUIRE(parallelResult.model);
+  CHECK(parallelResult.errors.empty());
+  CHECK(parallelResult.warnings.empty());
+
+  const Model& serialModel = *serialResult.model;
+  const Model& parallelModel = *parallelResult.model;
+  REQUIRE(serialModel.accessors.size() == 2 * grids.size());
+  REQUIRE(parallelModel.accessors.size() == serialModel.accessors.size());
+  for (size_t i = 0; i < grids.size(); ++i) {
+    const Accessor& positions = parallelModel.accessors[2 * i];
+    const Accessor& indices = parallelModel.accessors[2 * i + 1];
+    CHECK(positions.count == grids[i].pointCount);
+    CHECK(indices.count == 3 * grids[i].faceCount);
+    CHECK(positions.count == serialModel.accessors[2 * i].count);
+    CHECK(indices.count == serialModel.accessors[2 * i + 1].count);
+    CHECK(
+        indices.componentType ==
+        serialModel.accessors[2 * i + 1].componentType);
+    CHECK(positions.bufferView == serialModel.accessors[2 * i].bufferView);
+    CHECK(indices.bufferView == serialModel.accessors[2 * i + 1].bufferView);
+  }
+
+  // The decoded indices and attributes are laid out in one new buffer, in the
+  // same way whichever threads decoded them.
+  REQUIRE(parallelModel.buffers.size() == 2);
+  REQUIRE(serialModel.buffers.size() == 2);
+  CHECK(
+      parallelModel.buffers[1].cesium.data ==
+      serialModel.buffers[1].cesium.data);
+}
+
+TEST_CASE("Reads repeated arrays and extensions of the same type") {
+  const std::string s = R"(
+    {
+      "meshes": [
+        {
+          "primitives": [
+            {
+              "extensions": {
+                "KHR_draco_mesh_compression": {
+                  "bufferView": 1,
+                  "attributes": { "POSITION": 0 }
+                },
+                "SOME_unknown_extension": { "value": 1 }
+              }
+            },
+            {
+              "extensions": {
+                "KHR_draco_mesh_compression": {
+                  "bufferView": 2,
+                  "attributes": { "NORMAL": 3 }
+                },
+                "SOME_unknown_extension": { "value": 2 }
+              }
+            }
+          ]
+        },
+        {
+          "primitives": [
+            {
+              "extensions": {
+                "KHR_draco_mesh_compression": { "bufferView": 4 }
+              }
+            }
+          ]
+        }
+      ]
+    }
+  )";
+
+  GltfReader reader;
+  GltfReaderResult result = reader.readGltf(
+      gsl::span(reinterpret_cast<const std::byte*>(s.c_str()), s.size()));
+
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.model.has_value());
+
+  Model& model = result.model.value();
+  REQUIRE(model.meshes.size() == 2);
+  REQUIRE(model.meshes[0].primitives.size() == 2);
+  REQUIRE(model.meshes[1].primitives.size() == 1);
+
+  const std::vector<int32_t> expectedBufferViews{1, 2, 4};
+  std::vector<int32_t> bufferViews;
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      const ExtensionKhrDracoMeshCompression* pDraco =
+          primitive.getExtension<ExtensionKhrDracoMeshCompression>();
+      REQUIRE(pDraco);
+      bufferViews.emplace_back(pDraco->bufferView);
+    }
+  }
+  CHECK(bufferViews == expectedBufferViews);
+
+  const ExtensionKhrDracoMeshCompression* pSecondDraco =
+      model.meshes[0]
+          .primitives[1]
+          .getExtension<ExtensionKhrDracoMeshCompression>();
+  CHECK(pSecondDraco->attributes.size() == 1);
+  CHECK(pSecondDraco->attributes.at("NORMAL") == 3);
+  CHECK(model.meshes[1]
+            .primitives[0]
+            .getExtension<ExtensionKhrDracoMeshCompression>()
+            ->attributes.empty());
+
+  const JsonValue* pUnknown =
+      model.meshes[0].primitives[1].getGenericExtension(
+          "SOME_unknown_extension");
+  REQUIRE(pUnknown);
+  REQUIRE(pUnknown->getValuePtrForKey("value"));
+  CHECK(
+      pUnknown->getValuePtrForKey("value")->getSafeNumberOrDefault<int64_t>(
+          0) == 2);
+  CHECK(!model.meshes[1].primitives[0].getGenericExtension(
+      "SOME_unknown_extension"));
+}
+
+TEST_CASE("Defers parsing extensions until they are accessed") {
+  const std::string s = R"(
+    {
+      "meshes": [
+        {
+          "primitives": [
+            {
+              "extensions": {
+                "KHR_draco_mesh_compression": {
+                  "bufferView": 1,
+                  "attributes": { "POSITION": [0, -1, 2.5] }
+                },
+                "SOME_scalar_extension": 5
+              }
+            }
+          ]
+        }
+      ]
+    }
+  )";
+
+  GltfReader reader;
+  reader.getOptions().setExtensionState(
+      "KHR_draco_mesh_compression",
+      CesiumJsonReader::ExtensionState::Deferred);
+  reader.getOptions().setExtensionState(
+      "SOME_scalar_extension",
+      CesiumJsonReader::ExtensionState::Deferred);
+
+  GltfReaderResult result = reader.readGltf(
+      gsl::span(reinterpret_cast<const std::byte*>(s.c_str()), s.size()));
+
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.model.has_value());
+  REQUIRE(result.model->meshes.size() == 1);
+  REQUIRE(result.model->meshes[0].primitives.size() == 1);
+
+  MeshPrimitive& primitive = result.model->meshes[0].primitives[0];
+  CHECK(!primitive.getExtension<ExtensionKhrDracoMeshCompression>());
+
+  auto it = primitive.extensions.find("KHR_draco_mesh_compression");
+  REQUIRE(it != primitive.extensions.end());
+  const DeferredJsonValue* pDeferred =
+      std::any_cast<DeferredJsonValue>(&it->second);
+  REQUIRE(pDeferred);
+  CHECK(!pDeferred->isParsed());
+  CHECK(
+      pDeferred->getJson() == R"({
+                  "bufferView": 1,
+                  "attributes": { "POSITION": [0, -1, 2.5] }
+                })");
+
+  const JsonValue* pDraco =
+      primitive.getGenericExtension("KHR_draco_mesh_compression");
+  REQUIRE(pDraco);
+  CHECK(pDeferred->isParsed());
+  CHECK(
+      pDraco->getValuePtrForKey("bufferView")
+          ->getSafeNumberOrDefault<int64_t>(0) == 1);
+
+  const JsonValue* pPosition =
+      pDraco->getValuePtrForKey("attributes")->getValuePtrForKey("POSITION");
+  REQUIRE(pPosition);
+  REQUIRE(pPosition->isArray());
+  const JsonValue::Array& position = pPosition->getArray();
+  REQUIRE(position.size() == 3);
+  CHECK(position[0].getSafeNumberOrDefault<int64_t>(-1) == 0);
+  CHECK(position[1].getSafeNumberOrDefault<int64_t>(0) == -1);
+  CHECK(position[2].getSafeNumberOrDefault<double>(0.0) == 2.5);
+
+  // A value that is not an object is read right away.
+  const JsonValue* pScalar =
+      primitive.getGenericExtension("SOME_scalar_extension");
+  REQUIRE(pScalar);
+  CHECK(pScalar->getSafeNumberOrDefault<int64_t>(0) == 5);
+}
+
 TEST_CASE("Extensions deserialize to JsonVaue iff "
           "a default extension is registered") {
   const std::string s = R"(
@@ -524,6 +1080,72 @@ TEST_CASE("Test KTX2") {
   REQUIRE(model.meshes.size() == 1);
 }
 
+TEST_CASE("Moves the GLB binary chunk into the buffer when given the data") {
+  std::vector<std::byte> data = readFile(
+      CesiumGltfReader_TEST_DATA_DIR + std::string("/DucksMeshopt/Duck.glb"));
+  GltfReader reader;
+  GltfReaderResult copied = reader.readGltf(data);
+  REQUIRE(copied.model);
+  REQUIRE(!copied.model->buffers.empty());
+
+  const std::byte* pAllocation = data.data();
+  GltfReaderResult moved = reader.readGltf(std::move(data));
+  REQUIRE(moved.model);
+  REQUIRE(!moved.model->buffers.empty());
+  CHECK(moved.errors.empty());
+
+  const std::vector<std::byte>& bufferData =
+      moved.model->buffers[0].cesium.data;
+  CHECK(bufferData.data() == pAllocation);
+  CHECK(bufferData == copied.model->buffers[0].cesium.data);
+  CHECK(
+      static_cast<int64_t>(bufferData.size()) ==
+      moved.model->buffers[0].byteLength);
+}
+
+TEST_CASE("GltfStreamReader reads a GLB as it arrives") {
+  GltfReader reader;
+
+  SECTION("reads the same model as reading all of the data") {
+    std::vector<std::byte> data = readFile(
+        CesiumGltfReader_TEST_DATA_DIR +
+        std::string("/DucksMeshopt/Duck.glb"));
+    GltfReaderResult expected = reader.readGltf(data);
+    REQUIRE(expected.model);
+    REQUIRE(!expected.model->buffers.empty());
+
+    GltfStreamReader streamReader(reader);
+    const gsl::span<const std::byte> span(data);
+    const size_t pieceSize = 1000;
+    for (size_t i = 0; i < span.size(); i += pieceSize) {
+      CHECK(!streamReader.isComplete());
+      streamReader.append(
+          span.subspan(i, std::min(pieceSize, span.size() - i)));
+    }
+    REQUIRE(streamReader.isComplete());
+
+    GltfReaderResult result = streamReader.finish(GltfReaderOptions());
+    REQUIRE(result.model);
+    CHECK(result.errors.empty());
+    REQUIRE(result.model->buffers.size() == expected.model->buffers.size());
+    CHECK(
+        result.model->buffers[0].cesium.data ==
+        expected.model->buffers[0].cesium.data);
+    CHECK(result.model->meshes.size() == expected.model->meshes.size());
+  }
+
+  SECTION("ignores data that is not a GLB") {
+    std::filesystem::path gltfFile = CesiumGltfReader_TEST_DATA_DIR;
+    gltfFile /=
+        "TriangleWithoutIndices/glTF-Embedded/TriangleWithoutIndices.gltf";
+    std::vector<std::byte> data = readFile(gltfFile);
+
+    GltfStreamReader streamReader(reader);
+    streamReader.append(data);
+    CHECK(!streamReader.isComplete());
+  }
+}
+
 TEST_CASE("Can apply RTC CENTER if model uses Cesium RTC extension") {
   const std::string s = R"(
     {
@@ -610,6 +1232,143 @@ TEST_CASE("Can correctly interpret mipmaps in KTX2 files") {
   }
 }
 
+TEST_CASE("Can limit the size of decoded images") {
+  SECTION("JPEG is scaled while it is decoded") {
+    std::filesystem::path file = CesiumGltfReader_TEST_DATA_DIR;
+    file /= "ktx2/kota.jpg";
+    std::vector<std::byte> data = readFile(file.string());
+
+    // 256x192 scaled by 3/8, the largest scaling factor that fits.
+    ImageReaderResult imageResult =
+        GltfReader::readImage(data, Ktx2TranscodeTargets{}, 100);
+    REQUIRE(imageResult.image.has_value());
+    CHECK(imageResult.image->width == 96);
+    CHECK(imageResult.image->height == 72);
+    CHECK(imageResult.image->pixelData.size() == 96 * 72 * 4);
+  }
+
+  SECTION("WebP is scaled while it is decoded") {
+    std::filesystem::path file = CesiumGltfReader_TEST_DATA_DIR;
+    file /= "BoxTexturedWebp/glTF/CesiumLogoFlat.webp";
+    std::vector<std::byte> data = readFile(file.string());
+
+    ImageReaderResult imageResult =
+        GltfReader::readImage(data, Ktx2TranscodeTargets{}, 100);
+    REQUIRE(imageResult.image.has_value());
+    CHECK(imageResult.image->width == 100);
+    CHECK(imageResult.image->height == 100);
+    CHECK(imageResult.image->pixelData.size() == 100 * 100 * 4);
+  }
+
+  SECTION("KTX2 mip levels that are too large are left out") {
+    std::filesystem::path file = CesiumGltfReader_TEST_DATA_DIR;
+    file /= "ktx2/kota-mipmaps.ktx2";
+    std::vector<std::byte> data = readFile(file.string());
+
+    ImageReaderResult imageResult =
+        GltfReader::readImage(data, Ktx2TranscodeTargets{}, 64);
+    REQUIRE(imageResult.image.has_value());
+
+    const ImageCesium& image = *imageResult.image;
+    CHECK(image.width == 64);
+    CHECK(image.height == 48);
+    REQUIRE(image.mipPositions.size() == 7);
+    CHECK(image.mipPositions[0].byteOffset == 0);
+    CHECK(
+        image.mipPositions[0].byteSize ==
+        size_t(image.width * image.height * image.channels));
+    const ImageCesiumMipPosition& last = image.mipPositions.back();
+    CHECK(last.byteOffset + last.byteSize == image.pixelData.size());
+  }
+
+  SECTION("Images that are small enough are not changed") {
+    std::filesystem::path file = CesiumGltfReader_TEST_DATA_DIR;
+    file /= "ktx2/kota.jpg";
+    std::vector<std::byte> data = readFile(file.string());
+
+    ImageReaderResult imageResult =
+        GltfReader::readImage(data, Ktx2TranscodeTargets{}, 256);
+    REQUIRE(imageResult.image.has_value());
+    CHECK(imageResult.image->width == 256);
+    CHECK(imageResult.image->height == 192);
+  }
+}
+
+TEST_CASE("Caches transcoded KTX2 images") {
+  std::filesystem::path file = CesiumGltfReader_TEST_DATA_DIR;
+  file /= "ktx2/kota-mipmaps.ktx2";
+  std::vector<std::byte> data = readFile(file.string());
+
+  GltfReaderOptions options;
+  options.pTranscodedImageCache = std::make_shared<TranscodedImageCache>();
+  const TranscodedImageCache& cache = *options.pTranscodedImageCache;
+
+  ImageReaderResult first = GltfReader::readImage(data, options);
+  REQUIRE(first.image.has_value());
+  CHECK(cache.getCount() == 1);
+  CHECK(cache.getByteSize() == int64_t(first.image->pixelData.size()));
+
+  ImageReaderResult second = GltfReader::readImage(data, options);
+  REQUIRE(second.image.has_value());
+  CHECK(cache.getCount() == 1);
+  CHECK(second.image->width == first.image->width);
+  CHECK(second.image->mipPositions.size() == first.image->mipPositions.size());
+  CHECK(second.image->pixelData == first.image->pixelData);
+
+  // A different maximum size produces a different image.
+  options.maximumTextureSize = 64;
+  ImageReaderResult smaller = GltfReader::readImage(data, options);
+  REQUIRE(smaller.image.has_value());
+  CHECK(smaller.image->width == 64);
+  CHECK(cache.getCount() == 2);
+
+  // Other images are not cached.
+  file = CesiumGltfReader_TEST_DATA_DIR;
+  file /= "ktx2/kota.jpg";
+  ImageReaderResult jpeg = GltfReader::readImage(readFile(file), options);
+  REQUIRE(jpeg.image.has_value());
+  CHECK(cache.getCount() == 2);
+}
+
+TEST_CASE("Generates mipmaps") {
+  // A 4x2 image whose columns alternate between black and white.
+  ImageCesium image;
+  image.width = 4;
+  image.height = 2;
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  for (int32_t i = 0; i < image.width * image.height; ++i) {
+    const std::byte color = i % 2 == 0 ? std::byte(0) : std::byte(255);
+    image.pixelData.insert(image.pixelData.end(), 3, color);
+    image.pixelData.push_back(std::byte(100 + i));
+  }
+
+  SECTION("averaging each 2x2 block of a power-of-two image") {
+    REQUIRE(!GltfReader::generateMipMaps(image));
+    REQUIRE(image.mipPositions.size() == 3);
+    CHECK(image.mipPositions[1].byteSize == 2 * 4);
+    CHECK(image.mipPositions[2].byteSize == 4);
+
+    const std::byte* pLevel1 =
+        image.pixelData.data() + image.mipPositions[1].byteOffset;
+    CHECK(pLevel1[0] == std::byte(128));
+    CHECK(pLevel1[3] == std::byte((100 + 101 + 104 + 105 + 2) / 4));
+    CHECK(pLevel1[7] == std::byte((102 + 103 + 106 + 107 + 2) / 4));
+  }
+
+  SECTION("averaging sRGB colors in linear space") {
+    REQUIRE(!GltfReader::generateMipMaps(image, true));
+    REQUIRE(image.mipPositions.size() == 3);
+
+    // Averaging black and white in linear space gives a brighter sRGB value
+    // than averaging their sRGB values.
+    const std::byte* pLevel1 =
+        image.pixelData.data() + image.mipPositions[1].byteOffset;
+    CHECK(pLevel1[0] == std::byte(188));
+    CHECK(pLevel1[3] == std::byte((100 + 101 + 104 + 105 + 2) / 4));
+  }
+}
+
 TEST_CASE("Can read unknown properties from a glTF") {
   const std::string s = R"(
     {
@@ -663,6 +1422,58 @@ TEST_CASE("Ignores unknown properties if requested") {
   CHECK(result.model->asset.unknownProperties.empty());
 }
 
+TEST_CASE("Reads the JSON of owned data in place") {
+  const std::string s = R"(
+    {
+      "asset": {
+        "version": "2.0",
+        "copyright": "Quote \" and \u00e9 and tab\t"
+      },
+      "nodes": [
+        {
+          "name": "first\\node",
+          "someUnknownProperty": "value"
+        },
+        {
+          "name": "second/node"
+        }
+      ]
+    }
+  )";
+
+  GltfReader reader;
+
+  std::vector<std::byte> data(
+      reinterpret_cast<const std::byte*>(s.data()),
+      reinterpret_cast<const std::byte*>(s.data()) + s.size());
+  GltfReaderResult result = reader.readGltf(std::move(data));
+
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.model.has_value());
+  CHECK(result.model->asset.copyright == "Quote \" and \xc3\xa9 and tab\t");
+  REQUIRE(result.model->nodes.size() == 2);
+  CHECK(result.model->nodes[0].name == "first\\node");
+  CHECK(result.model->nodes[1].name == "second/node");
+
+  auto unknownIt =
+      result.model->nodes[0].unknownProperties.find("someUnknownProperty");
+  REQUIRE(unknownIt != result.model->nodes[0].unknownProperties.end());
+  CHECK(unknownIt->second.getStringOrDefault("") == "value");
+
+  SECTION("does not read past the end of the data") {
+    const std::string truncated = R"({"asset": {"version": "2.0)";
+    std::vector<std::byte> truncatedData(
+        reinterpret_cast<const std::byte*>(truncated.data()),
+        reinterpret_cast<const std::byte*>(truncated.data()) +
+            truncated.size());
+
+    GltfReaderResult truncatedResult =
+        reader.readGltf(std::move(truncatedData));
+    CHECK(!truncatedResult.model.has_value());
+    CHECK(!truncatedResult.errors.empty());
+  }
+}
+
 TEST_CASE("Decodes images with data uris") {
   GltfReader reader;
   GltfReaderResult result = reader.readGltf(readFile(
@@ -681,3 +1492,22 @@ TEST_CASE("Decodes images with data uris") {
   CHECK(image.height == 256);
   CHECK(!image.pixelData.empty());
 }
+
+TEST_CASE("Does not load images if not requested") {
+  GltfReader reader;
+  GltfReaderOptions options;
+  options.loadImages = false;
+  GltfReaderResult result = reader.readGltf(
+      readFile(
+          CesiumGltfReader_TEST_DATA_DIR + std::string("/BoxTextured.gltf")),
+      options);
+
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.model);
+
+  const Model& model = result.model.value();
+  REQUIRE(model.images.size() == 1);
+  CHECK(model.images.front().uri);
+  CHECK(model.images.front().cesium.pixelData.empty());
+  CHECK(model.images.front().cesium.width == 0);
+}
@@ -2,10 +2,17 @@
 
 #include "CesiumGltfWriter/Library.h"
 
+#include <CesiumAsync/AsyncSystem.h>
 #include <CesiumJsonWriter/ExtensionWriterContext.h>
 
 #include <gsl/span>
 
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
 // forward declarations
 namespace CesiumGltf {
 struct Model;
@@ -49,8 +56,54 @@ struct CESIUMGLTFWRITER_API GltfWriterOptions {
    * EXT_mesh_features or EXT_feature_metadata this value should be set to 8.
    */
   size_t binaryChunkByteAlignment = 4;
+
+  /**
+   * @brief Whether the vertex attributes and indices in the GLB binary chunk
+   * are compressed according to the EXT_meshopt_compression extension when
+   * writing a glb.
+   *
+   * A bufferView is compressed when it is only used by the attributes or only
+   * by the indices of mesh primitives, and when compressing it makes it
+   * smaller. The uncompressed data is left out of the glb, so the extension
+   * is required to read it.
+   */
+  bool compressMeshData = false;
+
+  /**
+   * @brief Whether floating-point normals, tangents, and texture coordinates
+   * are quantized according to the KHR_mesh_quantization extension when
+   * writing a glb.
+   *
+   * Normals and tangents become normalized 8-bit integers, which are encoded
+   * with the meshopt octahedral filter when {@link compressMeshData} is also
+   * true. Texture coordinates between 0 and 1 become normalized 16-bit
+   * integers. Positions are not quantized, because that would require
+   * changing the transforms of the nodes. An attribute is only quantized when
+   * its bufferView is not used by any other accessor.
+   */
+  bool quantizeMeshData = false;
+
+  /**
+   * @brief The async system whose worker threads are used to quantize and
+   * compress the bufferViews in parallel.
+   *
+   * If this is `std::nullopt`, they are processed entirely in the thread that
+   * writes the glb. Either way, the result is the same.
+   */
+  std::optional<CesiumAsync::AsyncSystem> encodeAsyncSystem;
 };
 
+/**
+ * @brief Receives the bytes of a glTF or GLB, in order, as they are written by
+ * {@link GltfWriter::writeGltf} or {@link GltfWriter::writeGlb}.
+ *
+ * The bytes are only valid during the call, so they must be copied or written
+ * out before it returns. It returns false if they could not be written, such
+ * as when a file cannot be written, which stops the writing.
+ */
+using GltfWriterSink =
+    std::function<bool(const gsl::span<const std::byte>& bytes)>;
+
 /**
  * @brief Writes glTF.
  */
@@ -88,6 +141,23 @@ public:
       const CesiumGltf::Model& model,
       const GltfWriterOptions& options = GltfWriterOptions()) const;
 
+  /**
+   * @brief Serializes the provided model into glTF JSON that is passed to a
+   * sink rather than returned.
+   *
+   * @details The same as {@link writeGltf}, except that the
+   * {@link GltfWriterResult::gltfBytes} of the result are empty.
+   *
+   * @param model The model.
+   * @param sink The sink that receives the bytes of the glTF.
+   * @param options Options for how to write the glTF.
+   * @return The result of writing the glTF.
+   */
+  GltfWriterResult writeGltf(
+      const CesiumGltf::Model& model,
+      const GltfWriterSink& sink,
+      const GltfWriterOptions& options = GltfWriterOptions()) const;
+
   /**
    * @brief Serializes the provided model into a glb byte vector.
    *
@@ -95,6 +165,11 @@ public:
    * and should not have a uri. Ignores internal data such as
    * {@link CesiumGltf::BufferCesium} and {@link CesiumGltf::ImageCesium}.
    *
+   * When {@link GltfWriterOptions::compressMeshData} or
+   * {@link GltfWriterOptions::quantizeMeshData} is true, the bufferViews of
+   * the first buffer are rewritten into a new binary chunk, and the written
+   * glTF JSON describes them rather than the given model.
+   *
    * @param model The model.
    * @param bufferData The buffer data to store in the GLB binary chunk.
    * @param options Options for how to write the glb.
@@ -105,6 +180,36 @@ public:
       const gsl::span<const std::byte>& bufferData,
       const GltfWriterOptions& options = GltfWriterOptions()) const;
 
+  /**
+   * @brief Serializes the provided model into a glb that is passed to a sink
+   * as it is written, rather than returned.
+   *
+   * @details The sink receives the GLB header and JSON chunk, and then each
+   * of the buffer chunks in turn, as they are, followed by the padding. The
+   * buffer chunks are never copied or concatenated, so a large glb is written
+   * without holding a second copy of its binary data in memory. Only the JSON
+   * is produced in memory before it is passed to the sink, because its length
+   * is in the GLB header. The {@link GltfWriterResult::gltfBytes} of the
+   * result are empty.
+   *
+   * The first buffer object implicitly refers to the GLB binary chunk, which
+   * is the concatenation of the buffer chunks, and should not have a uri.
+   * When the mesh data is compressed or quantized, the binary chunk is
+   * rebuilt first, so the buffer chunks are then copied into it.
+   *
+   * @param model The model.
+   * @param bufferChunks The parts of the data to store in the GLB binary
+   * chunk, in order.
+   * @param sink The sink that receives the bytes of the glb.
+   * @param options Options for how to write the glb.
+   * @return The result of writing the glb.
+   */
+  GltfWriterResult writeGlb(
+      const CesiumGltf::Model& model,
+      const std::vector<gsl::span<const std::byte>>& bufferChunks,
+      const GltfWriterSink& sink,
+      const GltfWriterOptions& options = GltfWriterOptions()) const;
+
 private:
   CesiumJsonWriter::ExtensionWriterContext _context;
 };
@@ -1,12 +1,21 @@
 #include "CesiumGltfWriter/GltfWriter.h"
 
 #include "ModelJsonWriter.h"
+#include "encodeMeshData.h"
 #include "registerExtensions.h"
 
+#include <CesiumGltf/Model.h>
 #include <CesiumJsonWriter/JsonWriter.h>
 #include <CesiumJsonWriter/PrettyJsonWriter.h>
 #include <CesiumUtility/Tracing.h>
 
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string_view>
+
 namespace CesiumGltfWriter {
 
 namespace {
@@ -19,14 +28,30 @@ getPadding(size_t byteCount, size_t byteAlignment) noexcept {
   return padding;
 }
 
-[[nodiscard]] std::vector<std::byte> writeGlbBuffer(
+gsl::span<const std::byte> asBytes(std::string_view string) noexcept {
+  return gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(string.data()),
+      string.size());
+}
+
+void writeUint32(std::byte* pDestination, uint32_t value) noexcept {
+  std::memcpy(pDestination, &value, sizeof(value));
+}
+
+bool writeGlbChunks(
     const gsl::span<const std::byte>& jsonData,
-    const gsl::span<const std::byte>& bufferData,
-    size_t binaryChunkByteAlignment) {
+    const std::vector<gsl::span<const std::byte>>& bufferChunks,
+    size_t binaryChunkByteAlignment,
+    const GltfWriterSink& sink) {
   assert(binaryChunkByteAlignment > 0 && binaryChunkByteAlignment % 4 == 0);
 
-  size_t headerSize = 12;
-  size_t chunkHeaderSize = 8;
+  const size_t headerSize = 12;
+  const size_t chunkHeaderSize = 8;
+
+  size_t bufferDataSize = 0;
+  for (const gsl::span<const std::byte>& chunk : bufferChunks) {
+    bufferDataSize += chunk.size();
+  }
 
   size_t jsonPaddingSize =
       getPadding(headerSize + chunkHeaderSize + jsonData.size(), 4);
@@ -36,7 +61,7 @@ getPadding(size_t byteCount, size_t byteAlignment) noexcept {
   size_t binaryPaddingSize = 0;
   size_t binaryChunkDataSize = 0;
 
-  if (bufferData.size() > 0) {
+  if (bufferDataSize > 0) {
     size_t extraJsonPadding =
         getPadding(glbSize + chunkHeaderSize, binaryChunkByteAlignment);
     if (extraJsonPadding > 0) {
@@ -46,61 +71,68 @@ getPadding(size_t byteCount, size_t byteAlignment) noexcept {
     }
 
     binaryPaddingSize =
-        getPadding(glbSize + chunkHeaderSize + bufferData.size(), 4);
-    binaryChunkDataSize = bufferData.size() + binaryPaddingSize;
+        getPadding(glbSize + chunkHeaderSize + bufferDataSize, 4);
+    binaryChunkDataSize = bufferDataSize + binaryPaddingSize;
     glbSize += chunkHeaderSize + binaryChunkDataSize;
   }
 
-  std::vector<std::byte> glb(glbSize);
-  uint8_t* glb8 = reinterpret_cast<uint8_t*>(glb.data());
-  uint32_t* glb32 = reinterpret_cast<uint32_t*>(glb.data());
-
-  // GLB header
-  size_t byteOffset = 0;
-  glb8[byteOffset++] = 'g';
-  glb8[byteOffset++] = 'l';
-  glb8[byteOffset++] = 'T';
-  glb8[byteOffset++] = 'F';
-  glb32[byteOffset / 4] = 2;
-  byteOffset += 4;
-  glb32[byteOffset / 4] = static_cast<uint32_t>(glbSize);
-  byteOffset += 4;
-
-  // JSON chunk header
-  glb32[byteOffset / 4] = static_cast<uint32_t>(jsonChunkDataSize);
-  byteOffset += 4;
-  glb8[byteOffset++] = 'J';
-  glb8[byteOffset++] = 'S';
-  glb8[byteOffset++] = 'O';
-  glb8[byteOffset++] = 'N';
-
-  // JSON chunk
-  memcpy(glb8 + byteOffset, jsonData.data(), jsonData.size());
-  byteOffset += jsonData.size();
-
-  // JSON chunk padding
-  memset(glb8 + byteOffset, ' ', jsonPaddingSize);
-  byteOffset += jsonPaddingSize;
-
-  if (bufferData.size() > 0) {
-    // Binary chunk header
-    glb32[byteOffset / 4] = static_cast<uint32_t>(binaryChunkDataSize);
-    byteOffset += 4;
-    glb8[byteOffset++] = 'B';
-    glb8[byteOffset++] = 'I';
-    glb8[byteOffset++] = 'N';
-    glb8[byteOffset++] = 0;
-
-    // Binary chunk
-    memcpy(glb8 + byteOffset, bufferData.data(), bufferData.size());
-    byteOffset += bufferData.size();
-
-    // Binary chunk padding
-    memset(glb8 + byteOffset, 0, binaryPaddingSize);
+  // GLB header and JSON chunk header
+  std::byte header[headerSize + chunkHeaderSize];
+  std::memcpy(header, "glTF", 4);
+  writeUint32(header + 4, 2);
+  writeUint32(header + 8, static_cast<uint32_t>(glbSize));
+  writeUint32(header + 12, static_cast<uint32_t>(jsonChunkDataSize));
+  std::memcpy(header + 16, "JSON", 4);
+
+  // JSON chunk and padding
+  const std::vector<std::byte> jsonPadding(jsonPaddingSize, std::byte(' '));
+  if (!sink(gsl::span<const std::byte>(header, sizeof(header))) ||
+      !sink(jsonData) ||
+      (!jsonPadding.empty() && !sink(jsonPadding))) {
+    return false;
+  }
+
+  if (bufferDataSize == 0) {
+    return true;
+  }
+
+  // Binary chunk header
+  std::byte binaryHeader[chunkHeaderSize];
+  writeUint32(binaryHeader, static_cast<uint32_t>(binaryChunkDataSize));
+  std::memcpy(binaryHeader + 4, "BIN\0", 4);
+  if (!sink(gsl::span<const std::byte>(binaryHeader, sizeof(binaryHeader)))) {
+    return false;
   }
 
-  return glb;
+  // Binary chunk, passed to the sink as it is, and padding
+  for (const gsl::span<const std::byte>& chunk : bufferChunks) {
+    if (!chunk.empty() && !sink(chunk)) {
+      return false;
+    }
+  }
+
+  const std::byte binaryPadding[3]{};
+  return binaryPaddingSize == 0 ||
+         sink(gsl::span<const std::byte>(binaryPadding, binaryPaddingSize));
 }
+
+std::unique_ptr<CesiumJsonWriter::JsonWriter> writeJson(
+    const CesiumGltf::Model& model,
+    const CesiumJsonWriter::ExtensionWriterContext& context,
+    const GltfWriterOptions& options) {
+  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer;
+
+  if (options.prettyPrint) {
+    writer = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
+  } else {
+    writer = std::make_unique<CesiumJsonWriter::JsonWriter>();
+  }
+
+  ModelJsonWriter::write(model, *writer, context);
+  return writer;
+}
+
+constexpr const char* sinkError = "The glTF could not be written to the sink.";
 } // namespace
 
 GltfWriter::GltfWriter() { registerExtensions(this->_context); }
@@ -119,21 +151,24 @@ GltfWriterResult GltfWriter::writeGltf(
     const GltfWriterOptions& options) const {
   CESIUM_TRACE("GltfWriter::writeGltf");
 
-  const CesiumJsonWriter::ExtensionWriterContext& context =
-      this->getExtensions();
-
   GltfWriterResult result;
-  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer;
-
-  if (options.prettyPrint) {
-    writer = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
-  } else {
-    writer = std::make_unique<CesiumJsonWriter::JsonWriter>();
-  }
+  result.gltfBytes =
+      writeJson(model, this->getExtensions(), options)->toBytes();
+  return result;
+}
 
-  ModelJsonWriter::write(model, *writer, context);
-  result.gltfBytes = writer->toBytes();
+GltfWriterResult GltfWriter::writeGltf(
+    const CesiumGltf::Model& model,
+    const GltfWriterSink& sink,
+    const GltfWriterOptions& options) const {
+  CESIUM_TRACE("GltfWriter::writeGltf");
 
+  GltfWriterResult result;
+  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer =
+      writeJson(model, this->getExtensions(), options);
+  if (!sink(asBytes(writer->toStringView()))) {
+    result.errors.emplace_back(sinkError);
+  }
   return result;
 }
 
@@ -143,27 +178,75 @@ GltfWriterResult GltfWriter::writeGlb(
     const GltfWriterOptions& options) const {
   CESIUM_TRACE("GltfWriter::writeGlb");
 
-  const CesiumJsonWriter::ExtensionWriterContext& context =
-      this->getExtensions();
-
   GltfWriterResult result;
 
-  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer;
-
-  if (options.prettyPrint) {
-    writer = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
-  } else {
-    writer = std::make_unique<CesiumJsonWriter::JsonWriter>();
+  std::optional<CesiumGltf::Model> encodedModel;
+  std::optional<std::vector<std::byte>> encodedData;
+  if (options.compressMeshData || options.quantizeMeshData) {
+    encodedModel = model;
+    encodedData =
+        encodeMeshData(*encodedModel, bufferData, options, result.warnings);
   }
 
-  ModelJsonWriter::write(model, *writer, context);
-  std::vector<std::byte> jsonData = writer->toBytes();
-
-  result.gltfBytes = writeGlbBuffer(
-      gsl::span(jsonData),
-      bufferData,
+  const gsl::span<const std::byte> binaryData =
+      encodedData ? gsl::span<const std::byte>(*encodedData) : bufferData;
+  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer = writeJson(
+      encodedData ? *encodedModel : model,
+      this->getExtensions(),
+      options);
+  const gsl::span<const std::byte> jsonData = asBytes(writer->toStringView());
+
+  // Allow for the header and padding, so that the bytes are copied once.
+  result.gltfBytes.reserve(
+      jsonData.size() + binaryData.size() + 32 +
       options.binaryChunkByteAlignment);
+  writeGlbChunks(
+      jsonData,
+      {binaryData},
+      options.binaryChunkByteAlignment,
+      [&result](const gsl::span<const std::byte>& bytes) {
+        result.gltfBytes.insert(
+            result.gltfBytes.end(),
+            bytes.begin(),
+            bytes.end());
+        return true;
+      });
+
+  return result;
+}
 
+GltfWriterResult GltfWriter::writeGlb(
+    const CesiumGltf::Model& model,
+    const std::vector<gsl::span<const std::byte>>& bufferChunks,
+    const GltfWriterSink& sink,
+    const GltfWriterOptions& options) const {
+  CESIUM_TRACE("GltfWriter::writeGlb");
+
+  if (options.compressMeshData || options.quantizeMeshData) {
+    // The mesh data is rebuilt from a single contiguous copy of the chunks.
+    std::vector<std::byte> bufferData;
+    for (const gsl::span<const std::byte>& chunk : bufferChunks) {
+      bufferData.insert(bufferData.end(), chunk.begin(), chunk.end());
+    }
+
+    GltfWriterResult result = this->writeGlb(model, bufferData, options);
+    if (!sink(result.gltfBytes)) {
+      result.errors.emplace_back(sinkError);
+    }
+    result.gltfBytes.clear();
+    return result;
+  }
+
+  GltfWriterResult result;
+  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer =
+      writeJson(model, this->getExtensions(), options);
+  if (!writeGlbChunks(
+          asBytes(writer->toStringView()),
+          bufferChunks,
+          options.binaryChunkByteAlignment,
+          sink)) {
+    result.errors.emplace_back(sinkError);
+  }
   return result;
 }
 
@@ -0,0 +1,602 @@
+#include "encodeMeshData.h"
+
+#include "CesiumGltfWriter/GltfWriter.h"
+
+#include <CesiumAsync/forEachInParallel.h>
+#include <CesiumGltf/ExtensionBufferExtMeshoptCompression.h>
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Tracing.h>
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#endif
+#include <meshoptimizer.h>
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+using namespace CesiumGltf;
+
+namespace CesiumGltfWriter {
+
+namespace {
+
+using MeshOpt = ExtensionBufferViewExtMeshoptCompression;
+
+const std::string meshQuantizationExtension = "KHR_mesh_quantization";
+
+// How the accessors that refer to a bufferView use it.
+enum class BufferViewUse { None, Attributes, Indices, Other };
+
+// The attributes that can be quantized.
+enum class Semantic { None, Normal, Tangent, TexCoord, Other };
+
+/**
+ * @brief A bufferView of the first buffer, and what it is encoded to.
+ */
+struct EncodedBufferView {
+  BufferViewUse use = BufferViewUse::None;
+  int32_t accessorCount = 0;
+  int32_t firstAccessor = -1;
+  int32_t indexComponentType = -1;
+  bool triangles = true;
+
+  // The new uncompressed data of the bufferView, if it is quantized.
+  std::optional<std::vector<std::byte>> data;
+  int64_t byteStride = 0;
+  std::string filter = MeshOpt::Filter::NONE;
+
+  // The compressed data of the bufferView, if it is compressed.
+  std::vector<std::byte> compressed;
+  std::string mode = MeshOpt::Mode::ATTRIBUTES;
+  int64_t count = 0;
+};
+
+/**
+ * @brief An accessor that can be quantized, and what it is quantized to.
+ */
+struct QuantizedAccessor {
+  int32_t accessor;
+  Semantic semantic;
+  std::optional<std::vector<std::byte>> data;
+};
+
+template <typename T> void mergeUse(T& use, T newUse, T none, T other) {
+  use = use == none || use == newUse ? newUse : other;
+}
+
+Semantic getSemantic(const std::string& attributeName) {
+  if (attributeName == "NORMAL") {
+    return Semantic::Normal;
+  }
+  if (attributeName == "TANGENT") {
+    return Semantic::Tangent;
+  }
+  if (attributeName.rfind("TEXCOORD_", 0) == 0) {
+    return Semantic::TexCoord;
+  }
+  return Semantic::Other;
+}
+
+void addExtension(
+    std::vector<std::string>& extensions,
+    const std::string& name) {
+  if (std::find(extensions.begin(), extensions.end(), name) ==
+      extensions.end()) {
+    extensions.emplace_back(name);
+  }
+}
+
+gsl::span<const std::byte> getBufferViewData(
+    const BufferView& bufferView,
+    const gsl::span<const std::byte>& bufferData) {
+  return bufferData.subspan(
+      static_cast<size_t>(bufferView.byteOffset),
+      static_cast<size_t>(bufferView.byteLength));
+}
+
+int8_t quantizeSigned(float value) noexcept {
+  return static_cast<int8_t>(
+      std::lround(std::clamp(value, -1.0f, 1.0f) * 127.0f));
+}
+
+/**
+ * @brief Quantizes the values of a floating-point accessor, four bytes per
+ * element.
+ *
+ * Normals and tangents become normalized signed bytes, which are encoded with
+ * the meshopt octahedral filter if `octahedral` is true. Texture coordinates
+ * become normalized unsigned shorts, unless some are outside of the range
+ * from 0 to 1, in which case std::nullopt is returned.
+ */
+std::optional<std::vector<std::byte>> quantizeAccessor(
+    const Accessor& accessor,
+    int64_t byteStride,
+    Semantic semantic,
+    bool octahedral,
+    const gsl::span<const std::byte>& bufferViewData) {
+  const size_t count = static_cast<size_t>(accessor.count);
+  const size_t componentCount =
+      static_cast<size_t>(accessor.computeNumberOfComponents());
+
+  std::vector<float> values(count * 4, 0.0f);
+  const std::byte* pSource =
+      bufferViewData.data() + static_cast<size_t>(accessor.byteOffset);
+  for (size_t i = 0; i < count; ++i) {
+    std::memcpy(
+        &values[i * 4],
+        pSource + i * static_cast<size_t>(byteStride),
+        componentCount * sizeof(float));
+  }
+
+  std::vector<std::byte> result(count * 4);
+  if (semantic == Semantic::TexCoord) {
+    for (size_t i = 0; i < count; ++i) {
+      uint16_t quantized[2];
+      for (size_t j = 0; j < 2; ++j) {
+        const float value = values[i * 4 + j];
+        if (!(value >= 0.0f && value <= 1.0f)) {
+          return std::nullopt;
+        }
+        quantized[j] = static_cast<uint16_t>(std::lround(value * 65535.0f));
+      }
+      std::memcpy(&result[i * 4], quantized, sizeof(quantized));
+    }
+  } else if (octahedral) {
+    meshopt_encodeFilterOct(result.data(), count, 4, 8, values.data());
+  } else {
+    for (size_t i = 0; i < values.size(); ++i) {
+      result[i] = static_cast<std::byte>(quantizeSigned(values[i]));
+    }
+  }
+
+  return result;
+}
+
+template <typename T>
+std::vector<std::byte> compressIndices(
+    const gsl::span<const std::byte>& data,
+    bool triangles) {
+  const size_t count = data.size() / sizeof(T);
+  std::vector<T> indices(count);
+  std::memcpy(indices.data(), data.data(), count * sizeof(T));
+  const size_t vertexCount =
+      static_cast<size_t>(*std::max_element(indices.begin(), indices.end())) +
+      1;
+
+  std::vector<std::byte> result;
+  if (triangles) {
+    result.resize(meshopt_encodeIndexBufferBound(count, vertexCount));
+    result.resize(meshopt_encodeIndexBuffer(
+        reinterpret_cast<unsigned char*>(result.data()),
+        result.size(),
+        indices.data(),
+        count));
+  } else {
+    result.resize(meshopt_encodeIndexSequenceBound(count, vertexCount));
+    result.resize(meshopt_encodeIndexSequence(
+        reinterpret_cast<unsigned char*>(result.data()),
+        result.size(),
+        indices.data(),
+        count));
+  }
+  return result;
+}
+
+/**
+ * @brief Compresses a bufferView that is only used by vertex attributes or
+ * only by indices, if the meshopt codecs support it.
+ */
+void compressBufferView(
+    const Model& model,
+    const BufferView& bufferView,
+    const gsl::span<const std::byte>& data,
+    EncodedBufferView& encoded) {
+  if (data.empty()) {
+    return;
+  }
+
+  if (encoded.use == BufferViewUse::Attributes) {
+    int64_t byteStride = encoded.data ? encoded.byteStride : 0;
+    if (byteStride == 0 && bufferView.byteStride) {
+      byteStride = *bufferView.byteStride;
+    }
+    if (byteStride == 0 && encoded.accessorCount == 1) {
+      byteStride = model.accessors[static_cast<size_t>(encoded.firstAccessor)]
+                       .computeBytesPerVertex();
+    }
+    if (byteStride <= 0 || byteStride > 256 || byteStride % 4 != 0 ||
+        data.size() % static_cast<size_t>(byteStride) != 0) {
+      return;
+    }
+
+    const size_t count = data.size() / static_cast<size_t>(byteStride);
+    std::vector<std::byte>& compressed = encoded.compressed;
+    compressed.resize(meshopt_encodeVertexBufferBound(
+        count,
+        static_cast<size_t>(byteStride)));
+    compressed.resize(meshopt_encodeVertexBuffer(
+        reinterpret_cast<unsigned char*>(compressed.data()),
+        compressed.size(),
+        data.data(),
+        count,
+        static_cast<size_t>(byteStride)));
+    encoded.byteStride = byteStride;
+    encoded.count = static_cast<int64_t>(count);
+    encoded.mode = MeshOpt::Mode::ATTRIBUTES;
+  } else if (encoded.use == BufferViewUse::Indices) {
+    const int32_t componentType = encoded.indexComponentType;
+    const int64_t byteStride =
+        Accessor::computeByteSizeOfComponent(componentType);
+    if ((componentType != Accessor::ComponentType::UNSIGNED_SHORT &&
+         componentType != Accessor::ComponentType::UNSIGNED_INT) ||
+        (bufferView.byteStride && *bufferView.byteStride != byteStride) ||
+        data.size() % static_cast<size_t>(byteStride) != 0) {
+      return;
+    }
+
+    const int64_t count = static_cast<int64_t>(data.size()) / byteStride;
+    const bool triangles = encoded.triangles && count % 3 == 0;
+    encoded.compressed = byteStride == 2
+                             ? compressIndices<uint16_t>(data, triangles)
+                             : compressIndices<uint32_t>(data, triangles);
+    encoded.byteStride = byteStride;
+    encoded.count = count;
+    encoded.mode =
+        triangles ? MeshOpt::Mode::TRIANGLES : MeshOpt::Mode::INDICES;
+  }
+
+  // Filtered data must be compressed, so that it is decoded by the filter.
+  // Otherwise, only keep the compressed data if it is smaller.
+  if (encoded.filter == MeshOpt::Filter::NONE &&
+      encoded.compressed.size() >= data.size()) {
+    encoded.compressed.clear();
+  }
+}
+
+int64_t appendAligned(
+    std::vector<std::byte>& destination,
+    const gsl::span<const std::byte>& data) {
+  destination.resize((destination.size() + 7) / 8 * 8);
+  const int64_t byteOffset = static_cast<int64_t>(destination.size());
+  destination.insert(destination.end(), data.begin(), data.end());
+  return byteOffset;
+}
+
+/**
+ * @brief Determines how the accessors of the mesh primitives use each
+ * bufferView of the first buffer.
+ *
+ * Only bufferViews that are used exclusively as vertex attributes or
+ * exclusively as indices, by accessors that are not sparse, are compressed.
+ * Any other use, including by images, by accessors that are not used by mesh
+ * primitives, and by extensions that we do not know about, which do not
+ * refer to the bufferView through an accessor, leaves them as they are.
+ */
+void findBufferViewUses(
+    const Model& model,
+    std::vector<EncodedBufferView>& views,
+    std::vector<Semantic>& semantics) {
+  std::vector<BufferViewUse> accessorUses(
+      model.accessors.size(),
+      BufferViewUse::None);
+  std::vector<bool> triangleAccessors(model.accessors.size(), true);
+
+  auto useAccessor = [&model, &accessorUses](int32_t index, BufferViewUse use) {
+    if (Model::getSafe(&model.accessors, index)) {
+      mergeUse(
+          accessorUses[static_cast<size_t>(index)],
+          use,
+          BufferViewUse::None,
+          BufferViewUse::Other);
+    }
+  };
+
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      for (const auto& [name, accessorIndex] : primitive.attributes) {
+        useAccessor(accessorIndex, BufferViewUse::Attributes);
+        if (Model::getSafe(&model.accessors, accessorIndex)) {
+          mergeUse(
+              semantics[static_cast<size_t>(accessorIndex)],
+              getSemantic(name),
+              Semantic::None,
+              Semantic::Other);
+        }
+      }
+      for (const auto& target : primitive.targets) {
+        for (const auto& [name, accessorIndex] : target) {
+          useAccessor(accessorIndex, BufferViewUse::Other);
+        }
+      }
+      useAccessor(primitive.indices, BufferViewUse::Indices);
+      if (Model::getSafe(&model.accessors, primitive.indices) &&
+          primitive.mode != MeshPrimitive::Mode::TRIANGLES) {
+        triangleAccessors[static_cast<size_t>(primitive.indices)] = false;
+      }
+    }
+  }
+
+  auto useBufferView = [&views](int32_t index, BufferViewUse use) {
+    if (index >= 0 && static_cast<size_t>(index) < views.size()) {
+      mergeUse(
+          views[static_cast<size_t>(index)].use,
+          use,
+          BufferViewUse::None,
+          BufferViewUse::Other);
+    }
+  };
+
+  for (size_t i = 0; i < model.accessors.size(); ++i) {
+    const Accessor& accessor = model.accessors[i];
+    if (accessor.sparse) {
+      useBufferView(accessor.bufferView, BufferViewUse::Other);
+      useBufferView(accessor.sparse->indices.bufferView, BufferViewUse::Other);
+      useBufferView(accessor.sparse->values.bufferView, BufferViewUse::Other);
+      continue;
+    }
+
+    const BufferViewUse use = accessorUses[i] == BufferViewUse::None
+                                  ? BufferViewUse::Other
+                                  : accessorUses[i];
+    useBufferView(accessor.bufferView, use);
+
+    if (accessor.bufferView < 0 ||
+        static_cast<size_t>(accessor.bufferView) >= views.size()) {
+      continue;
+    }
+
+    EncodedBufferView& view = views[static_cast<size_t>(accessor.bufferView)];
+    if (view.accessorCount++ == 0) {
+      view.firstAccessor = static_cast<int32_t>(i);
+      view.indexComponentType = accessor.componentType;
+    } else if (view.indexComponentType != accessor.componentType) {
+      view.indexComponentType = -1;
+    }
+
+    // Triangles may be rotated by the index codec, so each accessor must
+    // start at a triangle.
+    const int64_t componentSize = accessor.computeByteSizeOfComponent();
+    if (!triangleAccessors[i] || accessor.count % 3 != 0 ||
+        componentSize <= 0 || accessor.byteOffset % (3 * componentSize) != 0) {
+      view.triangles = false;
+    }
+  }
+
+  for (const Image& image : model.images) {
+    useBufferView(image.bufferView, BufferViewUse::Other);
+  }
+
+  for (size_t i = 0; i < views.size(); ++i) {
+    const BufferView& bufferView = model.bufferViews[i];
+    if (bufferView.buffer != 0 || bufferView.hasExtension<MeshOpt>()) {
+      views[i].use = BufferViewUse::Other;
+    }
+  }
+}
+
+/**
+ * @brief Finds the accessors that can be quantized: floating-point normals,
+ * tangents, and texture coordinates that do not share their bufferView.
+ */
+std::vector<QuantizedAccessor> findQuantizableAccessors(
+    const Model& model,
+    const std::vector<EncodedBufferView>& views,
+    const std::vector<Semantic>& semantics) {
+  std::vector<QuantizedAccessor> result;
+  for (size_t i = 0; i < model.accessors.size(); ++i) {
+    const Accessor& accessor = model.accessors[i];
+    const Semantic semantic = semantics[i];
+    const std::string& expectedType =
+        semantic == Semantic::Normal    ? Accessor::Type::VEC3
+        : semantic == Semantic::Tangent ? Accessor::Type::VEC4
+                                        : Accessor::Type::VEC2;
+    if (semantic == Semantic::None || semantic == Semantic::Other ||
+        accessor.type != expectedType ||
+        accessor.componentType != Accessor::ComponentType::FLOAT ||
+        accessor.normalized || accessor.sparse || accessor.count <= 0 ||
+        accessor.byteOffset < 0 || accessor.bufferView < 0 ||
+        static_cast<size_t>(accessor.bufferView) >= views.size()) {
+      continue;
+    }
+
+    const EncodedBufferView& view =
+        views[static_cast<size_t>(accessor.bufferView)];
+    const BufferView& bufferView =
+        model.bufferViews[static_cast<size_t>(accessor.bufferView)];
+    const int64_t byteStride = accessor.computeByteStride(model);
+    if (view.use != BufferViewUse::Attributes || view.accessorCount != 1 ||
+        byteStride <= 0 ||
+        accessor.byteOffset + byteStride * (accessor.count - 1) +
+                accessor.computeBytesPerVertex() >
+            bufferView.byteLength) {
+      continue;
+    }
+
+    result.emplace_back(
+        QuantizedAccessor{static_cast<int32_t>(i), semantic, std::nullopt});
+  }
+  return result;
+}
+
+} // namespace
+
+std::optional<std::vector<std::byte>> encodeMeshData(
+    Model& model,
+    const gsl::span<const std::byte>& bufferData,
+    const GltfWriterOptions& options,
+    std::vector<std::string>& warnings) {
+  CESIUM_TRACE("CesiumGltfWriter::encodeMeshData");
+
+  if (model.buffers.empty()) {
+    return std::nullopt;
+  }
+
+  for (const BufferView& bufferView : model.bufferViews) {
+    if (bufferView.buffer == 0 &&
+        (bufferView.byteOffset < 0 || bufferView.byteLength < 0 ||
+         static_cast<size_t>(bufferView.byteOffset + bufferView.byteLength) >
+             bufferData.size())) {
+      warnings.emplace_back(
+          "A bufferView extends beyond the GLB binary chunk, so the mesh data "
+          "is not quantized or compressed.");
+      return std::nullopt;
+    }
+  }
+
+  std::vector<EncodedBufferView> views(model.bufferViews.size());
+  std::vector<Semantic> semantics(model.accessors.size(), Semantic::None);
+  findBufferViewUses(model, views, semantics);
+
+  // Quantize the accessors in parallel, each into a new copy of the data of
+  // its bufferView.
+  bool quantized = false;
+  if (options.quantizeMeshData) {
+    std::vector<QuantizedAccessor> accessors =
+        findQuantizableAccessors(model, views, semantics);
+    CesiumAsync::forEachInParallel(
+        options.encodeAsyncSystem,
+        accessors.size(),
+        [&model, &accessors, &bufferData, &options](size_t i) {
+          QuantizedAccessor& quantizedAccessor = accessors[i];
+          const Accessor& accessor =
+              model.accessors[static_cast<size_t>(quantizedAccessor.accessor)];
+          quantizedAccessor.data = quantizeAccessor(
+              accessor,
+              accessor.computeByteStride(model),
+              quantizedAccessor.semantic,
+              options.compressMeshData,
+              getBufferViewData(
+                  model.bufferViews[static_cast<size_t>(accessor.bufferView)],
+                  bufferData));
+        });
+
+    for (QuantizedAccessor& quantizedAccessor : accessors) {
+      if (!quantizedAccessor.data) {
+        continue;
+      }
+
+      Accessor& accessor =
+          model.accessors[static_cast<size_t>(quantizedAccessor.accessor)];
+      EncodedBufferView& view = views[static_cast<size_t>(accessor.bufferView)];
+      view.data = std::move(quantizedAccessor.data);
+      view.byteStride = 4;
+      if (quantizedAccessor.semantic == Semantic::TexCoord) {
+        accessor.componentType = Accessor::ComponentType::UNSIGNED_SHORT;
+      } else {
+        accessor.componentType = Accessor::ComponentType::BYTE;
+        if (options.compressMeshData) {
+          view.filter = MeshOpt::Filter::OCTAHEDRAL;
+        }
+      }
+      accessor.normalized = true;
+      accessor.byteOffset = 0;
+      accessor.min.clear();
+      accessor.max.clear();
+      quantized = true;
+    }
+  }
+
+  // Compress the bufferViews in parallel.
+  bool compressed = false;
+  if (options.compressMeshData) {
+    CesiumAsync::forEachInParallel(
+        options.encodeAsyncSystem,
+        views.size(),
+        [&model, &views, &bufferData](size_t i) {
+          EncodedBufferView& view = views[i];
+          if (view.use == BufferViewUse::Attributes ||
+              view.use == BufferViewUse::Indices) {
+            const BufferView& bufferView = model.bufferViews[i];
+            compressBufferView(
+                model,
+                bufferView,
+                view.data ? gsl::span<const std::byte>(*view.data)
+                          : getBufferViewData(bufferView, bufferData),
+                view);
+          }
+        });
+
+    compressed = std::any_of(
+        views.begin(),
+        views.end(),
+        [](const EncodedBufferView& view) { return !view.compressed.empty(); });
+  }
+
+  if (!quantized && !compressed) {
+    return std::nullopt;
+  }
+
+  // Lay out the bufferViews of the first buffer again. The compressed ones
+  // refer to a new fallback buffer, which has the length of their
+  // uncompressed data but no data of its own.
+  std::vector<std::byte> result;
+  result.reserve(bufferData.size());
+  const int32_t fallbackBuffer = static_cast<int32_t>(model.buffers.size());
+  int64_t fallbackByteLength = 0;
+
+  for (size_t i = 0; i < views.size(); ++i) {
+    BufferView& bufferView = model.bufferViews[i];
+    if (bufferView.buffer != 0) {
+      continue;
+    }
+
+    EncodedBufferView& view = views[i];
+    const gsl::span<const std::byte> data =
+        view.data ? gsl::span<const std::byte>(*view.data)
+                  : getBufferViewData(bufferView, bufferData);
+    if (view.data) {
+      bufferView.byteStride = view.byteStride;
+    }
+
+    if (view.compressed.empty()) {
+      bufferView.byteOffset = appendAligned(result, data);
+      bufferView.byteLength = static_cast<int64_t>(data.size());
+      continue;
+    }
+
+    MeshOpt& meshOpt = bufferView.addExtension<MeshOpt>();
+    meshOpt.buffer = 0;
+    meshOpt.byteOffset = appendAligned(result, view.compressed);
+    meshOpt.byteLength = static_cast<int64_t>(view.compressed.size());
+    meshOpt.byteStride = view.byteStride;
+    meshOpt.count = view.count;
+    meshOpt.mode = view.mode;
+    meshOpt.filter = view.filter;
+
+    fallbackByteLength = (fallbackByteLength + 7) / 8 * 8;
+    bufferView.buffer = fallbackBuffer;
+    bufferView.byteOffset = fallbackByteLength;
+    bufferView.byteLength = static_cast<int64_t>(data.size());
+    if (view.mode == MeshOpt::Mode::ATTRIBUTES) {
+      bufferView.byteStride = view.byteStride;
+    }
+    fallbackByteLength += bufferView.byteLength;
+  }
+
+  model.buffers[0].byteLength = static_cast<int64_t>(result.size());
+
+  if (quantized) {
+    addExtension(model.extensionsUsed, meshQuantizationExtension);
+    addExtension(model.extensionsRequired, meshQuantizationExtension);
+  }
+
+  if (compressed) {
+    Buffer& buffer = model.buffers.emplace_back();
+    buffer.byteLength = fallbackByteLength;
+    buffer.addExtension<ExtensionBufferExtMeshoptCompression>().fallback = true;
+    addExtension(model.extensionsUsed, MeshOpt::ExtensionName);
+    addExtension(model.extensionsRequired, MeshOpt::ExtensionName);
+  }
+
+  return result;
+}
+
+} // namespace CesiumGltfWriter
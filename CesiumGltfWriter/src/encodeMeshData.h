@@ -0,0 +1,47 @@
+#pragma once
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumGltfWriter {
+struct GltfWriterOptions;
+}
+
+namespace CesiumGltfWriter {
+
+/**
+ * @brief Quantizes and compresses the mesh data in the first buffer of a
+ * model according to the KHR_mesh_quantization and EXT_meshopt_compression
+ * extensions, as requested by {@link GltfWriterOptions::quantizeMeshData}
+ * and {@link GltfWriterOptions::compressMeshData}.
+ *
+ * The bufferViews of the first buffer are laid out again in a new GLB binary
+ * chunk, and the accessors, bufferViews, buffers, and the extensions used by
+ * the model are updated to describe it. The uncompressed data of the
+ * compressed bufferViews is placed in a new fallback buffer without data.
+ *
+ * The bufferViews are processed in parallel if
+ * {@link GltfWriterOptions::encodeAsyncSystem} is set.
+ *
+ * @param model The model, which is updated.
+ * @param bufferData The data of the first buffer of the model.
+ * @param options The options for how to write the glb.
+ * @param warnings The warnings, which are added to.
+ * @return The new data of the first buffer, or std::nullopt if the model is
+ * unchanged.
+ */
+std::optional<std::vector<std::byte>> encodeMeshData(
+    CesiumGltf::Model& model,
+    const gsl::span<const std::byte>& bufferData,
+    const GltfWriterOptions& options,
+    std::vector<std::string>& warnings);
+
+} // namespace CesiumGltfWriter
@@ -1,12 +1,17 @@
 #include "CesiumGltfWriter/GltfWriter.h"
 
+#include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
 #include <CesiumGltfReader/GltfReader.h>
 
 #include <catch2/catch.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 #include <rapidjson/document.h>
 
+#include <algorithm>
 #include <cctype>
+#include <cstring>
 
 namespace {
 void check(const std::string& input, const std::string& expectedOutput) {
@@ -579,3 +584,228 @@ TEST_CASE("Writes glb with binaryChunkByteAlignment of 8") {
 
   REQUIRE(glbBytesExtraPadding.size() == 88);
 }
+
+TEST_CASE("Writes glb to a sink") {
+  const std::vector<std::byte> bufferData{
+      std::byte('H'),
+      std::byte('e'),
+      std::byte('l'),
+      std::byte('l'),
+      std::byte('o'),
+      std::byte('W'),
+      std::byte('o'),
+      std::byte('r'),
+      std::byte('l'),
+      std::byte('d'),
+      std::byte('!')};
+  const gsl::span<const std::byte> bufferSpan(bufferData);
+
+  CesiumGltf::Model model;
+  model.asset.version = "2.0";
+  CesiumGltf::Buffer buffer;
+  buffer.byteLength = static_cast<int64_t>(bufferData.size());
+  model.buffers.push_back(buffer);
+
+  CesiumGltfWriter::GltfWriter writer;
+  const std::vector<std::byte> expected =
+      writer.writeGlb(model, bufferSpan).gltfBytes;
+
+  SECTION("writes the same bytes from several buffer chunks") {
+    std::vector<std::byte> glbBytes;
+    size_t callCount = 0;
+    CesiumGltfWriter::GltfWriterResult writeResult = writer.writeGlb(
+        model,
+        {bufferSpan.first(5), bufferSpan.subspan(5)},
+        [&glbBytes, &callCount](const gsl::span<const std::byte>& bytes) {
+          glbBytes.insert(glbBytes.end(), bytes.begin(), bytes.end());
+          ++callCount;
+          return true;
+        });
+
+    REQUIRE(writeResult.errors.empty());
+    CHECK(writeResult.gltfBytes.empty());
+    CHECK(glbBytes == expected);
+
+    // Each buffer chunk is passed to the sink by itself.
+    CHECK(callCount >= 5);
+  }
+
+  SECTION("stops when the sink fails") {
+    size_t callCount = 0;
+    CesiumGltfWriter::GltfWriterResult writeResult = writer.writeGlb(
+        model,
+        {bufferSpan},
+        [&callCount](const gsl::span<const std::byte>&) {
+          ++callCount;
+          return false;
+        });
+
+    CHECK(callCount == 1);
+    CHECK(writeResult.errors.size() == 1);
+  }
+
+  SECTION("writes glTF JSON") {
+    std::vector<std::byte> gltfBytes;
+    CesiumGltfWriter::GltfWriterResult writeResult = writer.writeGltf(
+        model,
+        [&gltfBytes](const gsl::span<const std::byte>& bytes) {
+          gltfBytes.insert(gltfBytes.end(), bytes.begin(), bytes.end());
+          return true;
+        });
+
+    REQUIRE(writeResult.errors.empty());
+    CHECK(gltfBytes == writer.writeGltf(model).gltfBytes);
+  }
+}
+
+namespace {
+template <typename T>
+int32_t addAccessor(
+    CesiumGltf::Model& model,
+    std::vector<std::byte>& bufferData,
+    const std::vector<T>& values,
+    int32_t componentType,
+    const std::string& type) {
+  CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteOffset = static_cast<int64_t>(bufferData.size());
+  bufferView.byteLength = static_cast<int64_t>(values.size() * sizeof(T));
+  bufferData.resize(bufferData.size() + values.size() * sizeof(T));
+  std::memcpy(
+      bufferData.data() + bufferView.byteOffset,
+      values.data(),
+      values.size() * sizeof(T));
+
+  CesiumGltf::Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = static_cast<int32_t>(model.bufferViews.size() - 1);
+  accessor.componentType = componentType;
+  accessor.type = type;
+  accessor.count = static_cast<int64_t>(values.size());
+  return static_cast<int32_t>(model.accessors.size() - 1);
+}
+} // namespace
+
+TEST_CASE("Writes glb with compressed and quantized mesh data") {
+  using namespace CesiumGltf;
+
+  const std::vector<glm::vec3> positions{
+      {0.0f, 0.0f, 0.0f},
+      {1.0f, 0.0f, 0.0f},
+      {1.0f, 1.0f, 0.0f},
+      {0.0f, 1.0f, 0.0f}};
+  const std::vector<glm::vec3> normals(4, glm::vec3(0.0f, 0.6f, 0.8f));
+  const std::vector<glm::vec2> texCoords{
+      {0.0f, 0.0f},
+      {1.0f, 0.0f},
+      {1.0f, 1.0f},
+      {0.25f, 0.75f}};
+  const std::vector<uint16_t> indices{0, 1, 2, 0, 2, 3};
+
+  Model model;
+  model.asset.version = "2.0";
+  std::vector<std::byte> bufferData;
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = addAccessor(
+      model,
+      bufferData,
+      positions,
+      Accessor::ComponentType::FLOAT,
+      Accessor::Type::VEC3);
+  primitive.attributes["NORMAL"] = addAccessor(
+      model,
+      bufferData,
+      normals,
+      Accessor::ComponentType::FLOAT,
+      Accessor::Type::VEC3);
+  primitive.attributes["TEXCOORD_0"] = addAccessor(
+      model,
+      bufferData,
+      texCoords,
+      Accessor::ComponentType::FLOAT,
+      Accessor::Type::VEC2);
+  primitive.indices = addAccessor(
+      model,
+      bufferData,
+      indices,
+      Accessor::ComponentType::UNSIGNED_SHORT,
+      Accessor::Type::SCALAR);
+  model.buffers.emplace_back().byteLength =
+      static_cast<int64_t>(bufferData.size());
+
+  CesiumGltfWriter::GltfWriter writer;
+  CesiumGltfWriter::GltfWriterOptions options;
+  options.compressMeshData = true;
+  options.quantizeMeshData = true;
+  CesiumGltfWriter::GltfWriterResult writeResult =
+      writer.writeGlb(model, bufferData, options);
+  REQUIRE(writeResult.errors.empty());
+  REQUIRE(writeResult.warnings.empty());
+
+  // The given model is not changed.
+  CHECK(model.accessors[1].componentType == Accessor::ComponentType::FLOAT);
+
+  CesiumGltfReader::GltfReader reader;
+  CesiumGltfReader::GltfReaderResult readResult =
+      reader.readGltf(writeResult.gltfBytes);
+  REQUIRE(readResult.errors.empty());
+  REQUIRE(readResult.model.has_value());
+
+  const Model& readModel = *readResult.model;
+  const std::vector<std::string>& required = readModel.extensionsRequired;
+  CHECK(
+      std::count(required.begin(), required.end(), "EXT_meshopt_compression") ==
+      1);
+  CHECK(
+      std::count(required.begin(), required.end(), "KHR_mesh_quantization") ==
+      1);
+
+  const MeshPrimitive& readPrimitive = readModel.meshes[0].primitives[0];
+
+  AccessorView<glm::vec3> readPositions(
+      readModel,
+      readPrimitive.attributes.at("POSITION"));
+  REQUIRE(readPositions.size() == 4);
+  for (int64_t i = 0; i < readPositions.size(); ++i) {
+    CHECK(readPositions[i] == positions[size_t(i)]);
+  }
+
+  AccessorView<glm::vec3> readNormals(
+      readModel,
+      readPrimitive.attributes.at("NORMAL"));
+  REQUIRE(readNormals.size() == 4);
+  for (int64_t i = 0; i < readNormals.size(); ++i) {
+    CHECK(readNormals[i].x == Approx(normals[size_t(i)].x).margin(0.02));
+    CHECK(readNormals[i].y == Approx(normals[size_t(i)].y).margin(0.02));
+    CHECK(readNormals[i].z == Approx(normals[size_t(i)].z).margin(0.02));
+  }
+
+  AccessorView<glm::vec2> readTexCoords(
+      readModel,
+      readPrimitive.attributes.at("TEXCOORD_0"));
+  REQUIRE(readTexCoords.size() == 4);
+  for (int64_t i = 0; i < readTexCoords.size(); ++i) {
+    CHECK(readTexCoords[i].x == Approx(texCoords[size_t(i)].x).margin(1e-4));
+    CHECK(readTexCoords[i].y == Approx(texCoords[size_t(i)].y).margin(1e-4));
+  }
+
+  // The index codec may rotate the vertices of each triangle, but keeps
+  // their winding.
+  AccessorView<uint16_t> readIndices(readModel, readPrimitive.indices);
+  REQUIRE(readIndices.size() == 6);
+  for (int64_t triangle = 0; triangle < 2; ++triangle) {
+    std::vector<uint16_t> original(
+        indices.begin() + triangle * 3,
+        indices.begin() + triangle * 3 + 3);
+    std::vector<uint16_t> read{
+        readIndices[triangle * 3],
+        readIndices[triangle * 3 + 1],
+        readIndices[triangle * 3 + 2]};
+    bool isRotation = false;
+    for (int rotation = 0; rotation < 3; ++rotation) {
+      std::rotate(read.begin(), read.begin() + 1, read.end());
+      isRotation = isRotation || read == original;
+    }
+    CHECK(isRotation);
+  }
+}
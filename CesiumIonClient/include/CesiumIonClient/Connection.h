@@ -11,6 +11,7 @@
 #include <CesiumAsync/Library.h>
 
 #include <cstdint>
+#include <functional>
 
 namespace CesiumIonClient {
 
@@ -57,6 +58,51 @@ struct ListTokensOptions {
   std::optional<SortOrder> sortOrder;
 };
 
+/**
+ * @brief Options to be passed to {@link Connection::assets}.
+ */
+struct ListAssetsOptions {
+  /**
+   * @brief The maximum number of assets to return in a single page.
+   */
+  std::optional<int32_t> limit;
+
+  /**
+   * @brief The page number, where the first page of results is page 1 (not 0).
+   */
+  std::optional<int32_t> page;
+
+  /**
+   * @brief One or more keywords separated by whitespace by which to filter the
+   * list of assets. The asset name or description will contain each keyword
+   * of the search string.
+   */
+  std::optional<std::string> search;
+
+  /**
+   * @brief The asset types to include, such as `"3DTILES"`, `"IMAGERY"` or
+   * `"TERRAIN"`. If empty, assets of all types are included.
+   */
+  std::vector<std::string> types;
+
+  /**
+   * @brief The asset statuses to include, such as `"COMPLETE"` or
+   * `"IN_PROGRESS"`. If empty, assets of all statuses are included.
+   */
+  std::vector<std::string> statuses;
+
+  /**
+   * @brief The property by which to sort results. Valid values include
+   * `"ID"`, `"NAME"`, `"TYPE"` and `"DATE_ADDED"`.
+   */
+  std::optional<std::string> sortBy;
+
+  /**
+   * @brief Whether the results are sorted in ascending or descending order.
+   */
+  std::optional<SortOrder> sortOrder;
+};
+
 /**
  * @brief A connection to Cesium ion that can be used to interact with it via
  * its REST API.
@@ -167,9 +213,37 @@ public:
   /**
    * @brief Gets the list of available assets.
    *
+   * Without a {@link ListAssetsOptions::limit}, the server decides how many
+   * assets are returned. To get all of the pages, use
+   * {@link Connection::forEachAssetsPage}.
+   *
+   * @param options Options to include in the "List assets" request.
    * @return A future that resolves to the asset information.
    */
-  CesiumAsync::Future<Response<Assets>> assets() const;
+  CesiumAsync::Future<Response<Assets>>
+  assets(const ListAssetsOptions& options = {}) const;
+
+  /**
+   * @brief Gets all of the pages of the "List assets" service, starting at
+   * the page of the options, and passes each page to a callback.
+   *
+   * When the server reports the last page, the remaining pages are requested
+   * concurrently. Otherwise, each page is requested after the previous one.
+   * Either way, the pages are passed to the callback in order, in the main
+   * thread, as soon as they and the pages before them are received.
+   *
+   * @param options Options to include in each "List assets" request.
+   * @param onPage The function that receives each page.
+   * @param maximumSimultaneousRequests The maximum number of pages to request
+   * at once.
+   * @return A future that resolves after the last page has been passed to the
+   * callback, or to the error response of the first page that could not be
+   * received. The pages after that page are not passed to the callback.
+   */
+  CesiumAsync::Future<Response<NoValue>> forEachAssetsPage(
+      const ListAssetsOptions& options,
+      const std::function<void(Response<Assets>&& page)>& onPage,
+      int32_t maximumSimultaneousRequests = 4) const;
 
   /**
    * @brief Invokes the "List tokens" service to get the list of available
@@ -184,6 +258,25 @@ public:
   CesiumAsync::Future<Response<TokenList>>
   tokens(const ListTokensOptions& options = {}) const;
 
+  /**
+   * @brief Gets all of the pages of the "List tokens" service, starting at
+   * the page of the options, and passes each page to a callback.
+   *
+   * This works like {@link Connection::forEachAssetsPage}.
+   *
+   * @param options Options to include in each "List tokens" request.
+   * @param onPage The function that receives each page.
+   * @param maximumSimultaneousRequests The maximum number of pages to request
+   * at once.
+   * @return A future that resolves after the last page has been passed to the
+   * callback, or to the error response of the first page that could not be
+   * received.
+   */
+  CesiumAsync::Future<Response<NoValue>> forEachTokensPage(
+      const ListTokensOptions& options,
+      const std::function<void(Response<TokenList>&& page)>& onPage,
+      int32_t maximumSimultaneousRequests = 4) const;
+
   /**
    * @brief Gets details of the asset with the given ID.
    *
@@ -283,6 +376,7 @@ private:
       const std::string& redirectUrl,
       const std::string& codeVerifier);
 
+  CesiumAsync::Future<Response<Assets>> assets(const std::string& url) const;
   CesiumAsync::Future<Response<TokenList>> tokens(const std::string& url) const;
 
   CesiumAsync::AsyncSystem _asyncSystem;
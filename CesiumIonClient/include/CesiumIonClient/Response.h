@@ -84,6 +84,16 @@ template <typename T> struct Response final {
    * Call {@link Connection::previousPage} rather than using this field directly.
    */
   std::optional<std::string> previousPageUrl;
+
+  /**
+   * @brief The URL to use to obtain the last page of results, if the server
+   * reported it.
+   *
+   * When it is known, {@link Connection::forEachTokensPage} and
+   * {@link Connection::forEachAssetsPage} request the remaining pages
+   * concurrently.
+   */
+  std::optional<std::string> lastPageUrl;
 };
 
 /**
@@ -17,6 +17,9 @@
 #include <rapidjson/writer.h>
 #include <uriparser/Uri.h>
 
+#include <cstdlib>
+#include <limits>
+#include <map>
 #include <thread>
 
 #ifdef _MSC_VER
@@ -292,6 +295,189 @@ bool parseJsonObject(const IAssetResponse* pResponse, rapidjson::Document& d) {
   return !d.HasParseError();
 }
 
+std::string sortOrderToString(SortOrder sortOrder) {
+  return sortOrder == SortOrder::Ascending ? "ASC" : "DESC";
+}
+
+// Gets the page number from the `page` query parameter of a page URL.
+std::optional<int32_t> getPageNumber(const std::string& url) {
+  const std::string page = Uri::getQueryValue(url, "page");
+  char* pEnd = nullptr;
+  const long pageNumber = std::strtol(page.c_str(), &pEnd, 10);
+  if (page.empty() || *pEnd != '\0' || pageNumber < 1 ||
+      pageNumber > std::numeric_limits<int32_t>::max()) {
+    return std::nullopt;
+  }
+  return static_cast<int32_t>(pageNumber);
+}
+
+/**
+ * @brief Gets the pages of a listing service and passes them to a callback in
+ * order.
+ *
+ * All of the page futures resolve in the main thread, so the state of the
+ * listing is only accessed from there.
+ */
+template <typename T> class PageListing {
+public:
+  using GetPage = std::function<Future<Response<T>>(const std::string& url)>;
+  using GetPageUrl = std::function<std::string(int32_t page)>;
+  using PageCallback = std::function<void(Response<T>&& page)>;
+
+  static Future<Response<NoValue>> start(
+      const AsyncSystem& asyncSystem,
+      GetPage&& getPage,
+      GetPageUrl&& getPageUrl,
+      const PageCallback& onPage,
+      int32_t firstPage,
+      int32_t maximumSimultaneousRequests) {
+    std::shared_ptr<PageListing> pListing = std::make_shared<PageListing>(
+        asyncSystem,
+        std::move(getPage),
+        std::move(getPageUrl),
+        onPage,
+        firstPage,
+        maximumSimultaneousRequests);
+    Future<Response<NoValue>> future = pListing->_promise.getFuture();
+    requestSequentially(pListing, pListing->_getPageUrl(firstPage), true);
+    return future;
+  }
+
+  PageListing(
+      const AsyncSystem& asyncSystem,
+      GetPage&& getPage,
+      GetPageUrl&& getPageUrl,
+      const PageCallback& onPage,
+      int32_t firstPage,
+      int32_t maximumSimultaneousRequests)
+      : _getPage(std::move(getPage)),
+        _getPageUrl(std::move(getPageUrl)),
+        _onPage(onPage),
+        _maximumSimultaneousRequests(
+            std::max(maximumSimultaneousRequests, int32_t(1))),
+        _promise(asyncSystem.createPromise<Response<NoValue>>()),
+        _nextPageToRequest(firstPage + 1),
+        _nextPageToDeliver(firstPage + 1),
+        _lastPage(0),
+        _requestsInFlight(0),
+        _received(),
+        _error() {}
+
+private:
+  // Requests the page at the given URL, and then the page after it. After
+  // the first page, the remaining pages are requested concurrently if the
+  // last page is known.
+  static void requestSequentially(
+      const std::shared_ptr<PageListing>& pListing,
+      const std::string& url,
+      bool isFirstPage) {
+    pListing->_getPage(url).thenImmediately(
+        [pListing, isFirstPage](Response<T>&& page) {
+          if (!page.value) {
+            pListing->finish(std::move(page));
+            return;
+          }
+
+          const std::optional<int32_t> lastPage =
+              isFirstPage && page.lastPageUrl
+                  ? getPageNumber(*page.lastPageUrl)
+                  : std::nullopt;
+          std::optional<std::string> nextPageUrl = page.nextPageUrl;
+          const uint16_t statusCode = page.httpStatusCode;
+          pListing->_onPage(std::move(page));
+
+          if (!nextPageUrl) {
+            pListing->succeed(statusCode);
+          } else if (lastPage && *lastPage >= pListing->_nextPageToRequest) {
+            pListing->_lastPage = *lastPage;
+            requestConcurrently(pListing);
+          } else {
+            requestSequentially(pListing, *nextPageUrl, false);
+          }
+        });
+  }
+
+  static void
+  requestConcurrently(const std::shared_ptr<PageListing>& pListing) {
+    while (!pListing->_error &&
+           pListing->_nextPageToRequest <= pListing->_lastPage &&
+           pListing->_requestsInFlight <
+               pListing->_maximumSimultaneousRequests) {
+      const int32_t pageNumber = pListing->_nextPageToRequest++;
+      ++pListing->_requestsInFlight;
+      pListing->_getPage(pListing->_getPageUrl(pageNumber))
+          .thenImmediately([pListing, pageNumber](Response<T>&& page) {
+            --pListing->_requestsInFlight;
+            pListing->receive(pageNumber, std::move(page));
+            requestConcurrently(pListing);
+          });
+    }
+  }
+
+  void receive(int32_t pageNumber, Response<T>&& page) {
+    if (this->_error) {
+      this->finishIfIdle();
+      return;
+    }
+
+    this->_received.emplace(pageNumber, std::move(page));
+
+    // Pass on the pages that are now in order.
+    auto it = this->_received.find(this->_nextPageToDeliver);
+    while (it != this->_received.end()) {
+      Response<T> nextPage = std::move(it->second);
+      this->_received.erase(it);
+      if (!nextPage.value) {
+        this->_received.clear();
+        this->_error = Response<NoValue>(
+            nextPage.httpStatusCode,
+            nextPage.errorCode,
+            nextPage.errorMessage);
+        this->finishIfIdle();
+        return;
+      }
+
+      const uint16_t statusCode = nextPage.httpStatusCode;
+      this->_onPage(std::move(nextPage));
+      if (this->_nextPageToDeliver++ == this->_lastPage) {
+        this->succeed(statusCode);
+        return;
+      }
+      it = this->_received.find(this->_nextPageToDeliver);
+    }
+  }
+
+  void finishIfIdle() {
+    if (this->_requestsInFlight == 0) {
+      this->_promise.resolve(std::move(*this->_error));
+    }
+  }
+
+  void finish(Response<T>&& page) {
+    this->_promise.resolve(Response<NoValue>(
+        page.httpStatusCode,
+        page.errorCode,
+        page.errorMessage));
+  }
+
+  void succeed(uint16_t statusCode) {
+    this->_promise.resolve(
+        Response<NoValue>(NoValue(), statusCode, std::string(), std::string()));
+  }
+
+  GetPage _getPage;
+  GetPageUrl _getPageUrl;
+  PageCallback _onPage;
+  int32_t _maximumSimultaneousRequests;
+  Promise<Response<NoValue>> _promise;
+  int32_t _nextPageToRequest;
+  int32_t _nextPageToDeliver;
+  int32_t _lastPage;
+  int32_t _requestsInFlight;
+  std::map<int32_t, Response<T>> _received;
+  std::optional<Response<NoValue>> _error;
+};
+
 } // namespace
 
 CesiumAsync::Future<Response<Profile>> Connection::me() const {
@@ -419,11 +605,98 @@ CesiumIonClient::Connection::getApiUrl(
       });
 }
 
-CesiumAsync::Future<Response<Assets>> Connection::assets() const {
+namespace {
+
+std::string
+createAssetsUrl(const std::string& apiUrl, const ListAssetsOptions& options) {
+  std::string url = Uri::resolve(apiUrl, "v1/assets");
+
+  if (options.limit) {
+    url = Uri::addQuery(url, "limit", std::to_string(*options.limit));
+  }
+  if (options.page) {
+    url = Uri::addQuery(url, "page", std::to_string(*options.page));
+  }
+  if (options.search) {
+    url = Uri::addQuery(url, "search", Uri::escape(*options.search));
+  }
+  for (const std::string& type : options.types) {
+    url = Uri::addQuery(url, "type", Uri::escape(type));
+  }
+  for (const std::string& status : options.statuses) {
+    url = Uri::addQuery(url, "status", Uri::escape(status));
+  }
+  if (options.sortBy) {
+    url = Uri::addQuery(url, "sortBy", *options.sortBy);
+  }
+  if (options.sortOrder) {
+    url = Uri::addQuery(
+        url,
+        "sortOrder",
+        sortOrderToString(*options.sortOrder));
+  }
+
+  return url;
+}
+
+std::string
+createTokensUrl(const std::string& apiUrl, const ListTokensOptions& options) {
+  std::string url = Uri::resolve(apiUrl, "v2/tokens");
+
+  if (options.limit) {
+    url = Uri::addQuery(url, "limit", std::to_string(*options.limit));
+  }
+  if (options.page) {
+    url = Uri::addQuery(url, "page", std::to_string(*options.page));
+  }
+  if (options.search) {
+    url = Uri::addQuery(url, "search", *options.search);
+  }
+  if (options.sortBy) {
+    url = Uri::addQuery(url, "sortBy", *options.sortBy);
+  }
+  if (options.sortOrder) {
+    url = Uri::addQuery(
+        url,
+        "sortOrder",
+        sortOrderToString(*options.sortOrder));
+  }
+
+  return url;
+}
+
+} // namespace
+
+CesiumAsync::Future<Response<Assets>>
+Connection::assets(const ListAssetsOptions& options) const {
+  return this->assets(createAssetsUrl(this->_apiUrl, options));
+}
+
+CesiumAsync::Future<Response<NoValue>> Connection::forEachAssetsPage(
+    const ListAssetsOptions& options,
+    const std::function<void(Response<Assets>&& page)>& onPage,
+    int32_t maximumSimultaneousRequests) const {
+  return PageListing<Assets>::start(
+      this->_asyncSystem,
+      [connection = *this](const std::string& url) {
+        return connection.assets(url);
+      },
+      [apiUrl = this->_apiUrl, options](int32_t page) {
+        ListAssetsOptions pageOptions = options;
+        pageOptions.page = page;
+        return createAssetsUrl(apiUrl, pageOptions);
+      },
+      onPage,
+      options.page.value_or(1),
+      maximumSimultaneousRequests);
+}
+
+CesiumAsync::Future<Response<Assets>>
+Connection::assets(const std::string& url) const {
   return this->_pAssetAccessor
       ->get(
           this->_asyncSystem,
-          CesiumUtility::Uri::resolve(this->_apiUrl, "v1/assets"),
+          url,
           {{"Accept", "application/json"},
            {"Authorization", "Bearer " + this->_accessToken}})
       .thenInMainThread(
@@ -461,11 +734,7 @@ CesiumAsync::Future<Response<Assets>> Connection::assets() const {
                   jsonToAsset);
             }
 
-            return Response<Assets>{
-                std::move(result),
-                pResponse->statusCode(),
-                std::string(),
-                std::string()};
+            return Response<Assets>(pRequest, std::move(result));
           });
 }
 
@@ -527,28 +796,26 @@ TokenList tokenListFromJson(const rapidjson::Value& json) {
 
 Future<Response<TokenList>>
 Connection::tokens(const ListTokensOptions& options) const {
-  std::string url = Uri::resolve(this->_apiUrl, "v2/tokens");
-
-  if (options.limit) {
-    url = Uri::addQuery(url, "limit", std::to_string(*options.limit));
-  }
-  if (options.page) {
-    url = Uri::addQuery(url, "page", std::to_string(*options.page));
-  }
-  if (options.search) {
-    url = Uri::addQuery(url, "search", *options.search);
-  }
-  if (options.sortBy) {
-    url = Uri::addQuery(url, "sortBy", *options.sortBy);
-  }
-  if (options.sortOrder) {
-    url = Uri::addQuery(
-        url,
-        "sortOrder",
-        *options.sortOrder == SortOrder::Ascending ? "ASC" : "DESC");
-  }
+  return this->tokens(createTokensUrl(this->_apiUrl, options));
+}
 
-  return this->tokens(url);
+Future<Response<NoValue>> Connection::forEachTokensPage(
+    const ListTokensOptions& options,
+    const std::function<void(Response<TokenList>&& page)>& onPage,
+    int32_t maximumSimultaneousRequests) const {
+  return PageListing<TokenList>::start(
+      this->_asyncSystem,
+      [connection = *this](const std::string& url) {
+        return connection.tokens(url);
+      },
+      [apiUrl = this->_apiUrl, options](int32_t page) {
+        ListTokensOptions pageOptions = options;
+        pageOptions.page = page;
+        return createTokensUrl(apiUrl, pageOptions);
+      },
+      onPage,
+      options.page.value_or(1),
+      maximumSimultaneousRequests);
 }
 
 CesiumAsync::Future<Response<Asset>> Connection::asset(int64_t assetID) const {
@@ -29,7 +29,8 @@ Response<T>::Response(
       errorCode(errorCode_),
       errorMessage(errorMessage_),
       nextPageUrl(),
-      previousPageUrl() {}
+      previousPageUrl(),
+      lastPageUrl() {}
 
 template <typename T>
 Response<T>::Response(
@@ -41,7 +42,8 @@ Response<T>::Response(
       errorCode(errorCode_),
       errorMessage(errorMessage_),
       nextPageUrl(),
-      previousPageUrl() {}
+      previousPageUrl(),
+      lastPageUrl() {}
 
 template <typename T>
 Response<T>::Response(
@@ -52,7 +54,8 @@ Response<T>::Response(
       errorCode(),
       errorMessage(),
       nextPageUrl(),
-      previousPageUrl() {
+      previousPageUrl(),
+      lastPageUrl() {
   const HttpHeaders& headers = pRequest->response()->headers();
   auto it = headers.find("link");
   if (it == headers.end()) {
@@ -66,6 +69,8 @@ Response<T>::Response(
       this->nextPageUrl = Uri::resolve(pRequest->url(), link.url);
     } else if (link.rel == "prev") {
       this->previousPageUrl = Uri::resolve(pRequest->url(), link.url);
+    } else if (link.rel == "last") {
+      this->lastPageUrl = Uri::resolve(pRequest->url(), link.url);
     }
   }
 }
@@ -28,7 +28,12 @@ public:
     JsonHandler::reset(pParent);
     this->_pArray = pArray;
     this->_arrayIsOpen = false;
-    this->_objectHandler.reset(this->_handlerFactory());
+
+    // The element handler is reset for each element, so it is created once
+    // and reused by every array this handler reads.
+    if (!this->_objectHandler) {
+      this->_objectHandler.reset(this->_handlerFactory());
+    }
   }
 
   virtual IJsonHandler* readNull() override {
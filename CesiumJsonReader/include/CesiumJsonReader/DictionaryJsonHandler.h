@@ -4,6 +4,8 @@
 #include "Library.h"
 #include "ObjectJsonHandler.h"
 
+#include <CesiumUtility/FlatStringMap.h>
+
 #include <map>
 #include <unordered_map>
 
@@ -27,8 +29,16 @@ public:
     this->_pDictionary2 = pDictionary;
   }
 
+  void reset(
+      IJsonHandler* pParent,
+      CesiumUtility::FlatStringMap<T>* pDictionary) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pDictionary3 = pDictionary;
+  }
+
   virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
-    assert(this->_pDictionary1 || this->_pDictionary2);
+    assert(
+        this->_pDictionary1 || this->_pDictionary2 || this->_pDictionary3);
 
     if (this->_pDictionary1) {
       auto it = this->_pDictionary1->emplace(str, T()).first;
@@ -36,6 +46,12 @@ public:
       return this->property(it->first.c_str(), this->_item, it->second);
     }
 
+    if (this->_pDictionary3) {
+      auto it = this->_pDictionary3->emplace(str, T()).first;
+
+      return this->property(it->first.c_str(), this->_item, it->second);
+    }
+
     auto it = this->_pDictionary2->emplace(str, T()).first;
 
     return this->property(it->first.c_str(), this->_item, it->second);
@@ -44,6 +60,7 @@ public:
 private:
   std::unordered_map<std::string, T>* _pDictionary1 = nullptr;
   std::map<std::string, T>* _pDictionary2 = nullptr;
+  CesiumUtility::FlatStringMap<T>* _pDictionary3 = nullptr;
   THandler _item;
 };
 } // namespace CesiumJsonReader
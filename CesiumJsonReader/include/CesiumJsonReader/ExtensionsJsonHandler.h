@@ -6,7 +6,10 @@
 
 #include <CesiumUtility/ExtensibleObject.h>
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <string>
 
 namespace CesiumJsonReader {
 
@@ -16,7 +19,7 @@ public:
       : ObjectJsonHandler(),
         _context(context),
         _pObject(nullptr),
-        _currentExtensionHandler() {}
+        _extensionHandlers() {}
 
   void reset(
       IJsonHandler* pParent,
@@ -29,7 +32,12 @@ private:
   const JsonReaderOptions& _context;
   CesiumUtility::ExtensibleObject* _pObject = nullptr;
   std::string _objectType;
-  std::unique_ptr<IExtensionJsonHandler> _currentExtensionHandler;
+
+  // The handlers of the extensions read so far, by name, which are reused
+  // for the same extension on later objects of the same type. A null handler
+  // means the extension is disabled.
+  std::map<std::string, std::unique_ptr<IExtensionJsonHandler>, std::less<>>
+      _extensionHandlers;
 };
 
 } // namespace CesiumJsonReader
@@ -27,5 +27,11 @@ public:
   virtual void reportWarning(
       const std::string& warning,
       std::vector<std::string>&& context = std::vector<std::string>()) = 0;
+
+  /**
+   * @brief Gets the position of the reader in the JSON text, or nullptr if
+   * the JSON is not being read from text.
+   */
+  virtual const char* getReadPosition() const noexcept { return nullptr; }
 };
 } // namespace CesiumJsonReader
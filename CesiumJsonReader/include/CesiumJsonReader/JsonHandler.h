@@ -29,6 +29,8 @@ public:
       const std::string& warning,
       std::vector<std::string>&& context = std::vector<std::string>()) override;
 
+  virtual const char* getReadPosition() const noexcept override;
+
 protected:
   void reset(IJsonHandler* pParent);
 
@@ -34,6 +34,23 @@ enum class ExtensionState {
    */
   JsonOnly,
 
+  /**
+   * @brief The extension is enabled, but its JSON text is only kept while
+   * reading, and is parsed into a {@link CesiumUtility::JsonValue} when it is
+   * first accessed.
+   *
+   * The extension is stored as a {@link CesiumUtility::DeferredJsonValue},
+   * which {@link CesiumUtility::ExtensibleObject::getGenericExtension} parses.
+   * Even if a statically-typed class is available for the extension, it will
+   * not be used. This makes reading faster, and the loaded model smaller, when
+   * most objects with the extension are never inspected.
+   *
+   * Only extensions whose value is an object are deferred, and only when
+   * reading from JSON text. Otherwise the extension is read as with
+   * `JsonOnly`.
+   */
+  Deferred,
+
   /**
    * @brief The extension is disabled.
    *
@@ -129,6 +146,15 @@ public:
   void
   setExtensionState(const std::string& extensionName, ExtensionState newState);
 
+  /**
+   * @brief Gets a value indicating whether any extension is set to
+   * `ExtensionState::Deferred`, which needs the JSON text to be left as it is
+   * while it is read.
+   *
+   * @see JsonReader::readJsonInSitu
+   */
+  bool hasDeferredExtensions() const noexcept;
+
   std::unique_ptr<IExtensionJsonHandler> createExtensionHandler(
       const std::string_view& extensionName,
       const std::string& extendedObjectType) const;
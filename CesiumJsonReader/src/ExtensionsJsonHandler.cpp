@@ -12,16 +12,25 @@ void ExtensionsJsonHandler::reset(
 
   if (this->_objectType != objectType) {
     this->_objectType = objectType;
+    this->_extensionHandlers.clear();
   }
 }
 
 IJsonHandler*
 ExtensionsJsonHandler::readObjectKey(const std::string_view& str) {
-  this->_currentExtensionHandler =
-      this->_context.createExtensionHandler(str, this->_objectType);
-  if (this->_currentExtensionHandler) {
-    this->_currentExtensionHandler->reset(this, *this->_pObject, str);
-    return &this->_currentExtensionHandler->getHandler();
+  auto it = this->_extensionHandlers.find(str);
+  if (it == this->_extensionHandlers.end()) {
+    it = this->_extensionHandlers
+             .emplace(
+                 std::string(str),
+                 this->_context.createExtensionHandler(str, this->_objectType))
+             .first;
+  }
+
+  IExtensionJsonHandler* pExtensionHandler = it->second.get();
+  if (pExtensionHandler) {
+    pExtensionHandler->reset(this, *this->_pObject, str);
+    return &pExtensionHandler->getHandler();
   } else {
     return this->ignoreAndContinue();
   }
@@ -79,5 +79,9 @@ void JsonHandler::reportWarning(
   this->parent()->reportWarning(warning, std::move(context));
 }
 
+const char* JsonHandler::getReadPosition() const noexcept {
+  return this->_pParent ? this->_pParent->getReadPosition() : nullptr;
+}
+
 void JsonHandler::reset(IJsonHandler* pParent) { this->_pParent = pParent; }
 } // namespace CesiumJsonReader
@@ -90,11 +90,74 @@ std::string getMessageFromRapidJsonError(rapidjson::ParseErrorCode code) {
   }
 }
 
+// A rapidjson stream that decodes strings in place in a buffer of a known
+// size, unlike rapidjson::InsituStringStream, which reads up to a null
+// character.
+struct InSituStream {
+  using Ch = char;
+
+  InSituStream(char* pBegin, size_t size) noexcept
+      : src_(pBegin), dst_(nullptr), head_(pBegin), end_(pBegin + size) {}
+
+  Ch Peek() const noexcept {
+    return this->src_ == this->end_ ? '\0' : *this->src_;
+  }
+  Ch Take() noexcept {
+    return this->src_ == this->end_ ? '\0' : *this->src_++;
+  }
+  size_t Tell() const noexcept { return size_t(this->src_ - this->head_); }
+
+  // The strings are written over their own text, which is never shorter.
+  Ch* PutBegin() noexcept { return this->dst_ = this->src_; }
+  void Put(Ch c) noexcept {
+    assert(this->dst_ != nullptr && this->dst_ < this->src_);
+    *this->dst_++ = c;
+  }
+  void Flush() noexcept {}
+  size_t PutEnd(Ch* pBegin) noexcept { return size_t(this->dst_ - pBegin); }
+
+  char* src_;
+  char* dst_;
+  char* head_;
+  char* end_;
+};
+
+template <unsigned parseFlags, typename Stream>
+void parse(
+    Stream& inputStream,
+    IJsonHandler& handler,
+    std::vector<std::string>& errors) {
+  rapidjson::Reader reader;
+  Dispatcher dispatcher{&handler};
+
+  reader.IterativeParseInit();
+
+  bool success = true;
+  while (success && !reader.IterativeParseComplete()) {
+    success = reader.IterativeParseNext<
+        parseFlags | rapidjson::kParseFullPrecisionFlag>(
+        inputStream,
+        dispatcher);
+  }
+
+  if (reader.HasParseError()) {
+    std::string s("JSON parsing error at byte offset ");
+    s += std::to_string(reader.GetErrorOffset());
+    s += ": ";
+    s += getMessageFromRapidJsonError(reader.GetParseErrorCode());
+    errors.emplace_back(std::move(s));
+  }
+}
+
 } // namespace
 
 JsonReader::FinalJsonHandler::FinalJsonHandler(
     std::vector<std::string>& warnings)
-    : JsonHandler(), _warnings(warnings), _pInputStream(nullptr) {
+    : JsonHandler(),
+      _warnings(warnings),
+      _pBegin(nullptr),
+      _ppPosition(nullptr),
+      _isTextIntact(false) {
   reset(this);
 }
 
@@ -108,16 +171,26 @@ void JsonReader::FinalJsonHandler::reportWarning(
   }
 
   fullWarning += "\n  From byte offset: ";
-  fullWarning += this->_pInputStream
-                     ? std::to_string(this->_pInputStream->Tell())
+  fullWarning += this->_ppPosition
+                     ? std::to_string(*this->_ppPosition - this->_pBegin)
                      : "unknown";
 
   this->_warnings.emplace_back(std::move(fullWarning));
 }
 
-void JsonReader::FinalJsonHandler::setInputStream(
-    rapidjson::MemoryStream* pInputStream) noexcept {
-  this->_pInputStream = pInputStream;
+const char* JsonReader::FinalJsonHandler::getReadPosition() const noexcept {
+  // Text that is decoded in place can't be read again.
+  return this->_ppPosition && this->_isTextIntact ? *this->_ppPosition
+                                                  : nullptr;
+}
+
+void JsonReader::FinalJsonHandler::setInput(
+    const char* pBegin,
+    const char* const* ppPosition,
+    bool isTextIntact) noexcept {
+  this->_pBegin = pBegin;
+  this->_ppPosition = ppPosition;
+  this->_isTextIntact = isTextIntact;
 }
 
 /*static*/ void JsonReader::internalRead(
@@ -127,32 +200,29 @@ void JsonReader::FinalJsonHandler::setInputStream(
     std::vector<std::string>& errors,
     std::vector<std::string>& /* warnings */) {
 
-  rapidjson::Reader reader;
   rapidjson::MemoryStream inputStream(
       reinterpret_cast<const char*>(data.data()),
       data.size());
 
-  finalHandler.setInputStream(&inputStream);
-
-  Dispatcher dispatcher{&handler};
-
-  reader.IterativeParseInit();
-
-  bool success = true;
-  while (success && !reader.IterativeParseComplete()) {
-    success = reader.IterativeParseNext<
-        rapidjson::kParseDefaultFlags | rapidjson::kParseFullPrecisionFlag>(
-        inputStream,
-        dispatcher);
-  }
+  finalHandler.setInput(inputStream.begin_, &inputStream.src_, true);
+  parse<rapidjson::kParseDefaultFlags>(inputStream, handler, errors);
+  finalHandler.setInput(nullptr, nullptr, false);
+}
 
-  if (reader.HasParseError()) {
-    std::string s("JSON parsing error at byte offset ");
-    s += std::to_string(reader.GetErrorOffset());
-    s += ": ";
-    s += getMessageFromRapidJsonError(reader.GetParseErrorCode());
-    errors.emplace_back(std::move(s));
-  }
+/*static*/ void JsonReader::internalReadInSitu(
+    const gsl::span<std::byte>& data,
+    IJsonHandler& handler,
+    FinalJsonHandler& finalHandler,
+    std::vector<std::string>& errors,
+    std::vector<std::string>& /* warnings */) {
+  InSituStream inputStream(reinterpret_cast<char*>(data.data()), data.size());
+
+  finalHandler.setInput(inputStream.head_, &inputStream.src_, false);
+  parse<rapidjson::kParseDefaultFlags | rapidjson::kParseInsituFlag>(
+      inputStream,
+      handler,
+      errors);
+  finalHandler.setInput(nullptr, nullptr, false);
 }
 
 void CesiumJsonReader::JsonReader::internalRead(
@@ -4,6 +4,10 @@
 #include "CesiumJsonReader/JsonObjectJsonHandler.h"
 #include "CesiumJsonReader/JsonReader.h"
 
+#include <CesiumUtility/DeferredJsonValue.h>
+
+#include <string>
+
 namespace CesiumJsonReader {
 class AnyExtensionJsonHandler : public JsonObjectJsonHandler,
                                 public IExtensionJsonHandler {
@@ -28,12 +32,148 @@ public:
   virtual IJsonHandler& getHandler() override { return *this; }
 };
 
+// Skips over the value of an extension, and stores its JSON text in a
+// DeferredJsonValue.
+class DeferredExtensionJsonHandler : public JsonHandler,
+                                     public IExtensionJsonHandler {
+public:
+  DeferredExtensionJsonHandler() noexcept : JsonHandler(), _json() {}
+
+  virtual void reset(
+      IJsonHandler* pParentHandler,
+      CesiumUtility::ExtensibleObject& o,
+      const std::string_view& extensionName) override {
+    JsonHandler::reset(pParentHandler);
+    this->_pObject = &o;
+    this->_extensionName = extensionName;
+    this->_pStart = nullptr;
+    this->_positionIsBeforeToken = false;
+    this->_depth = 0;
+  }
+
+  virtual IJsonHandler& getHandler() override { return *this; }
+
+  virtual IJsonHandler* readNull() override {
+    return this->_depth == 0 ? this->readAsJsonValue()->readNull() : this;
+  }
+
+  virtual IJsonHandler* readBool(bool b) override {
+    return this->_depth == 0 ? this->readAsJsonValue()->readBool(b) : this;
+  }
+
+  virtual IJsonHandler* readInt32(int32_t i) override {
+    return this->_depth == 0 ? this->readAsJsonValue()->readInt32(i) : this;
+  }
+
+  virtual IJsonHandler* readUint32(uint32_t i) override {
+    return this->_depth == 0 ? this->readAsJsonValue()->readUint32(i) : this;
+  }
+
+  virtual IJsonHandler* readInt64(int64_t i) override {
+    return this->_depth == 0 ? this->readAsJsonValue()->readInt64(i) : this;
+  }
+
+  virtual IJsonHandler* readUint64(uint64_t i) override {
+    return this->_depth == 0 ? this->readAsJsonValue()->readUint64(i) : this;
+  }
+
+  virtual IJsonHandler* readDouble(double d) override {
+    return this->_depth == 0 ? this->readAsJsonValue()->readDouble(d) : this;
+  }
+
+  virtual IJsonHandler* readString(const std::string_view& str) override {
+    return this->_depth == 0 ? this->readAsJsonValue()->readString(str)
+                             : this;
+  }
+
+  virtual IJsonHandler* readObjectStart() override {
+    if (this->_depth == 0) {
+      // The reader reports the start of an object either before or after it
+      // consumes the opening brace. Which one it is can be told by whether
+      // the position is at the brace, because an object can't start with
+      // another brace.
+      const char* pPosition = this->getReadPosition();
+      if (!pPosition) {
+        return this->readAsJsonValue()->readObjectStart();
+      }
+
+      this->_positionIsBeforeToken = *pPosition == '{';
+      this->_pStart =
+          this->_positionIsBeforeToken ? pPosition : pPosition - 1;
+    }
+
+    ++this->_depth;
+    return this;
+  }
+
+  virtual IJsonHandler*
+  readObjectKey(const std::string_view& /* str */) override {
+    return this;
+  }
+
+  virtual IJsonHandler* readObjectEnd() override { return this->end(); }
+
+  virtual IJsonHandler* readArrayStart() override {
+    if (this->_depth == 0) {
+      return this->readAsJsonValue()->readArrayStart();
+    }
+
+    ++this->_depth;
+    return this;
+  }
+
+  virtual IJsonHandler* readArrayEnd() override { return this->end(); }
+
+private:
+  IJsonHandler* end() {
+    --this->_depth;
+    if (this->_depth > 0) {
+      return this;
+    }
+
+    const char* pEnd = this->getReadPosition();
+    if (this->_positionIsBeforeToken) {
+      ++pEnd;
+    }
+
+    this->_pObject->extensions.insert_or_assign(
+        this->_extensionName,
+        CesiumUtility::DeferredJsonValue(std::string(this->_pStart, pEnd)));
+    return this->parent();
+  }
+
+  IJsonHandler* readAsJsonValue() {
+    std::any& value = this->_pObject->extensions[this->_extensionName];
+    value = CesiumUtility::JsonValue(CesiumUtility::JsonValue::Object());
+    this->_json.reset(
+        this->parent(),
+        &std::any_cast<CesiumUtility::JsonValue&>(value));
+    return &this->_json;
+  }
+
+  CesiumUtility::ExtensibleObject* _pObject = nullptr;
+  std::string _extensionName;
+  const char* _pStart = nullptr;
+  bool _positionIsBeforeToken = false;
+  int32_t _depth = 0;
+  JsonObjectJsonHandler _json;
+};
+
 void JsonReaderOptions::setExtensionState(
     const std::string& extensionName,
     ExtensionState newState) {
   this->_extensionStates[extensionName] = newState;
 }
 
+bool JsonReaderOptions::hasDeferredExtensions() const noexcept {
+  for (const auto& extensionState : this->_extensionStates) {
+    if (extensionState.second == ExtensionState::Deferred) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::unique_ptr<IExtensionJsonHandler>
 JsonReaderOptions::createExtensionHandler(
     const std::string_view& extensionName,
@@ -47,6 +187,8 @@ JsonReaderOptions::createExtensionHandler(
       return nullptr;
     } else if (stateIt->second == ExtensionState::JsonOnly) {
       return std::make_unique<AnyExtensionJsonHandler>();
+    } else if (stateIt->second == ExtensionState::Deferred) {
+      return std::make_unique<DeferredExtensionJsonHandler>();
     }
   }
 
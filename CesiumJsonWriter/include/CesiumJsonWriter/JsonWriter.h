@@ -1,75 +1,187 @@
 #pragma once
 
+#include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
 #include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <vector>
 
 namespace CesiumJsonWriter {
+/**
+ * @brief Writes JSON to a buffer in memory.
+ *
+ * The methods that write tokens are not virtual. They are inlined into the
+ * code that calls them, which selects between the compact rapidjson writer
+ * and the pretty one that a {@link PrettyJsonWriter} uses with a single,
+ * well-predicted branch, rather than calling through a virtual function for
+ * each token.
+ */
 class JsonWriter {
-  rapidjson::StringBuffer _compactBuffer;
-  std::unique_ptr<rapidjson::Writer<rapidjson::StringBuffer>> compact;
-
 public:
   JsonWriter();
-  virtual ~JsonWriter() {}
+  virtual ~JsonWriter();
+
+  JsonWriter(const JsonWriter&) = delete;
+  JsonWriter& operator=(const JsonWriter&) = delete;
 
   // rapidjson methods
-  virtual bool Null();
-  virtual bool Bool(bool b);
-  virtual bool Int(int i);
-  virtual bool Uint(unsigned int i);
-  virtual bool Uint64(std::uint64_t i);
-  virtual bool Int64(std::int64_t i);
-  virtual bool Double(double d);
-  virtual bool RawNumber(const char* str, unsigned int length, bool copy);
-  virtual bool Key(std::string_view string);
-  virtual bool String(std::string_view string);
-  virtual bool StartObject();
-  virtual bool EndObject();
-  virtual bool StartArray();
-  virtual bool EndArray();
+  bool Null() {
+    return this->write([](auto& writer) { return writer.Null(); });
+  }
+  bool Bool(bool b) {
+    return this->write([b](auto& writer) { return writer.Bool(b); });
+  }
+  bool Int(int i) {
+    return this->write([i](auto& writer) { return writer.Int(i); });
+  }
+  bool Uint(unsigned int i) {
+    return this->write([i](auto& writer) { return writer.Uint(i); });
+  }
+  bool Uint64(std::uint64_t i) {
+    return this->write([i](auto& writer) { return writer.Uint64(i); });
+  }
+  bool Int64(std::int64_t i) {
+    return this->write([i](auto& writer) { return writer.Int64(i); });
+  }
+  bool Double(double d) {
+    return this->write([d](auto& writer) { return writer.Double(d); });
+  }
+  bool RawNumber(const char* str, unsigned int length, bool copy) {
+    return this->write([str, length, copy](auto& writer) {
+      return writer.RawNumber(str, length, copy);
+    });
+  }
+  bool Key(std::string_view string) {
+    return this->write([string](auto& writer) {
+      return writer.Key(
+          string.data(),
+          static_cast<unsigned int>(string.size()));
+    });
+  }
+  bool String(std::string_view string) {
+    return this->write([string](auto& writer) {
+      return writer.String(
+          string.data(),
+          static_cast<unsigned int>(string.size()));
+    });
+  }
+  bool StartObject() {
+    return this->write([](auto& writer) { return writer.StartObject(); });
+  }
+  bool EndObject() {
+    return this->write([](auto& writer) { return writer.EndObject(); });
+  }
+  bool StartArray() {
+    return this->write([](auto& writer) { return writer.StartArray(); });
+  }
+  bool EndArray() {
+    return this->write([](auto& writer) { return writer.EndArray(); });
+  }
 
   // Primitive overloads
-  virtual void Primitive(std::int32_t value);
-  virtual void Primitive(std::uint32_t value);
-  virtual void Primitive(std::int64_t value);
-  virtual void Primitive(std::uint64_t value);
-  virtual void Primitive(float value);
-  virtual void Primitive(double value);
-  virtual void Primitive(std::nullptr_t value);
-  virtual void Primitive(std::string_view string);
+  void Primitive(std::int32_t value) { this->Int(value); }
+  void Primitive(std::uint32_t value) { this->Uint(value); }
+  void Primitive(std::int64_t value) { this->Int64(value); }
+  void Primitive(std::uint64_t value) { this->Uint64(value); }
+  void Primitive(float value) { this->Double(static_cast<double>(value)); }
+  void Primitive(double value) { this->Double(value); }
+  void Primitive(std::nullptr_t) { this->Null(); }
+  void Primitive(std::string_view string) { this->String(string); }
 
   // Integral
-  virtual void KeyPrimitive(std::string_view keyName, std::int32_t value);
-  virtual void KeyPrimitive(std::string_view keyName, std::uint32_t value);
-  virtual void KeyPrimitive(std::string_view keyName, std::int64_t value);
-  virtual void KeyPrimitive(std::string_view keyName, std::uint64_t value);
+  void KeyPrimitive(std::string_view keyName, std::int32_t value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+  void KeyPrimitive(std::string_view keyName, std::uint32_t value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+  void KeyPrimitive(std::string_view keyName, std::int64_t value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+  void KeyPrimitive(std::string_view keyName, std::uint64_t value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
 
   // String
-  virtual void KeyPrimitive(std::string_view keyName, std::string_view value);
+  void KeyPrimitive(std::string_view keyName, std::string_view value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
 
   // Floating Point
-  virtual void KeyPrimitive(std::string_view keyName, float value);
-  virtual void KeyPrimitive(std::string_view keyName, double value);
+  void KeyPrimitive(std::string_view keyName, float value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+  void KeyPrimitive(std::string_view keyName, double value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
 
   // Null
-  virtual void KeyPrimitive(std::string_view keyName, std::nullptr_t value);
+  void KeyPrimitive(std::string_view keyName, std::nullptr_t value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
 
   // Array / Objects
-  virtual void
-  KeyArray(std::string_view keyName, std::function<void(void)> insideArray);
+  template <typename Func>
+  void KeyArray(std::string_view keyName, Func&& insideArray) {
+    this->Key(keyName);
+    this->StartArray();
+    insideArray();
+    this->EndArray();
+  }
+
+  template <typename Func>
+  void KeyObject(std::string_view keyName, Func&& insideObject) {
+    this->Key(keyName);
+    this->StartObject();
+    insideObject();
+    this->EndObject();
+  }
+
+  /**
+   * @brief Allocates room for the given number of bytes of output up front,
+   * so that the buffer is not grown over and over while it is written.
+   */
+  void reserve(size_t bytes);
+
+  /**
+   * @brief Discards everything that has been written, so that another
+   * document can be written into the memory that is already allocated.
+   */
+  void clear();
+
+  std::string toString();
+  std::string_view toStringView();
+  std::vector<std::byte> toBytes();
+
+protected:
+  /**
+   * @brief Creates a writer that writes indented JSON if `pretty` is true.
+   */
+  explicit JsonWriter(bool pretty);
 
-  virtual void
-  KeyObject(std::string_view keyName, std::function<void(void)> insideObject);
+private:
+  template <typename Func> bool write(Func&& f) {
+    if (this->_pPretty) {
+      return f(*this->_pPretty);
+    }
+    return f(this->_compact);
+  }
 
-  virtual std::string toString();
-  virtual std::string_view toStringView();
-  virtual std::vector<std::byte> toBytes();
+  rapidjson::StringBuffer _buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> _compact;
+  std::unique_ptr<rapidjson::PrettyWriter<rapidjson::StringBuffer>> _pPretty;
 };
 } // namespace CesiumJsonWriter
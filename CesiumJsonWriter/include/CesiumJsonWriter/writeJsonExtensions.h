@@ -1,8 +1,13 @@
 #pragma once
 
 #include "CesiumJsonWriter/ExtensionWriterContext.h"
+#include "CesiumJsonWriter/JsonObjectWriter.h"
 #include "CesiumJsonWriter/JsonWriter.h"
 
+#include <CesiumUtility/DeferredJsonValue.h>
+
+#include <any>
+
 namespace CesiumJsonWriter {
 template <typename TExtended>
 void writeJsonExtensions(
@@ -20,7 +25,16 @@ void writeJsonExtensions(
       continue;
     }
     jsonWriter.Key(item.first);
-    handler(item.second, jsonWriter, context);
+
+    // Extensions whose reading was deferred are written as JSON, whether or
+    // not they have a statically-typed class.
+    const CesiumUtility::DeferredJsonValue* pDeferred =
+        std::any_cast<CesiumUtility::DeferredJsonValue>(&item.second);
+    if (pDeferred) {
+      writeJsonValue(pDeferred->getValue(), jsonWriter);
+    } else {
+      handler(item.second, jsonWriter, context);
+    }
   }
   jsonWriter.EndObject();
 }
@@ -0,0 +1,63 @@
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace CesiumJsonWriter;
+
+namespace {
+void writeSample(JsonWriter& writer) {
+  writer.StartObject();
+  writer.KeyPrimitive("a", int32_t(1));
+  writer.KeyArray("b", [&writer]() {
+    writer.Double(1.5);
+    writer.Null();
+  });
+  writer.KeyObject("c", [&writer]() { writer.KeyPrimitive("d", "e"); });
+  writer.EndObject();
+}
+} // namespace
+
+TEST_CASE("JsonWriter") {
+  SECTION("writes compact JSON") {
+    JsonWriter writer;
+    writeSample(writer);
+    CHECK(writer.toStringView() == R"({"a":1,"b":[1.5,null],"c":{"d":"e"}})");
+  }
+
+  SECTION("writes indented JSON when pretty") {
+    std::unique_ptr<JsonWriter> pWriter = std::make_unique<PrettyJsonWriter>();
+    writeSample(*pWriter);
+    CHECK(
+        pWriter->toString() == "{\n"
+                               "  \"a\": 1,\n"
+                               "  \"b\": [1.5, null],\n"
+                               "  \"c\": {\n"
+                               "    \"d\": \"e\"\n"
+                               "  }\n"
+                               "}");
+  }
+
+  SECTION("reserving room does not change the output") {
+    JsonWriter writer;
+    writer.reserve(1024);
+    writeSample(writer);
+    writer.reserve(1);
+    CHECK(writer.toString() == R"({"a":1,"b":[1.5,null],"c":{"d":"e"}})");
+  }
+
+  SECTION("writes another document after clearing") {
+    std::unique_ptr<JsonWriter> pWriter = std::make_unique<PrettyJsonWriter>();
+    writeSample(*pWriter);
+    pWriter->clear();
+    CHECK(pWriter->toStringView().empty());
+
+    pWriter->StartArray();
+    pWriter->Int(1);
+    pWriter->EndArray();
+    CHECK(pWriter->toString() == "[1]");
+  }
+}
@@ -0,0 +1,161 @@
+#include "AllocationTracking.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifndef CESIUM_BENCHMARKS_TRACK_ALLOCATIONS
+#define CESIUM_BENCHMARKS_TRACK_ALLOCATIONS 0
+#endif
+
+namespace CesiumNativeBenchmarks {
+namespace {
+// These are constant-initialized, so they can be used by allocations that
+// happen before main.
+std::atomic<int64_t> allocations{0};
+std::atomic<int64_t> bytesAllocated{0};
+std::atomic<int64_t> currentBytes{0};
+std::atomic<int64_t> peakBytes{0};
+
+#if CESIUM_BENCHMARKS_TRACK_ALLOCATIONS
+void recordAllocation(size_t size) noexcept {
+  const int64_t bytes = static_cast<int64_t>(size);
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+  const int64_t current =
+      currentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+  int64_t peak = peakBytes.load(std::memory_order_relaxed);
+  while (current > peak && !peakBytes.compare_exchange_weak(
+                               peak,
+                               current,
+                               std::memory_order_relaxed)) {
+  }
+}
+
+void recordFree(size_t size) noexcept {
+  currentBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+}
+
+// Each allocation is preceded by its size, padded so that the allocation keeps
+// the alignment that malloc guarantees.
+constexpr size_t headerSize = alignof(std::max_align_t);
+
+void* allocate(size_t size) noexcept {
+  void* pHeader = std::malloc(size + headerSize);
+  if (!pHeader) {
+    return nullptr;
+  }
+
+  *static_cast<size_t*>(pHeader) = size;
+  recordAllocation(size);
+  return static_cast<std::byte*>(pHeader) + headerSize;
+}
+
+void deallocate(void* p) noexcept {
+  if (!p) {
+    return;
+  }
+
+  void* pHeader = static_cast<std::byte*>(p) - headerSize;
+  recordFree(*static_cast<size_t*>(pHeader));
+  std::free(pHeader);
+}
+#endif
+} // namespace
+
+bool isAllocationTrackingEnabled() noexcept {
+  return CESIUM_BENCHMARKS_TRACK_ALLOCATIONS != 0;
+}
+
+AllocationScope::AllocationScope() noexcept
+    : _allocations(allocations.load()),
+      _bytesAllocated(bytesAllocated.load()),
+      _currentBytes(currentBytes.load()) {
+  peakBytes.store(this->_currentBytes);
+}
+
+AllocationStatistics AllocationScope::getStatistics() const noexcept {
+  AllocationStatistics statistics;
+  statistics.allocations = allocations.load() - this->_allocations;
+  statistics.bytesAllocated = bytesAllocated.load() - this->_bytesAllocated;
+  statistics.peakBytes = peakBytes.load() - this->_currentBytes;
+  statistics.currentBytes = currentBytes.load() - this->_currentBytes;
+  return statistics;
+}
+
+void printAllocationStatistics(
+    const char* name,
+    const AllocationStatistics& statistics,
+    bool last) {
+  if (!isAllocationTrackingEnabled()) {
+    std::printf("  \"%s\": null%s\n", name, last ? "" : ",");
+    return;
+  }
+
+  std::printf("  \"%s\": {\n", name);
+  std::printf(
+      "    \"allocations\": %lld,\n",
+      static_cast<long long>(statistics.allocations));
+  std::printf(
+      "    \"bytesAllocated\": %lld,\n",
+      static_cast<long long>(statistics.bytesAllocated));
+  std::printf(
+      "    \"peakBytes\": %lld,\n",
+      static_cast<long long>(statistics.peakBytes));
+  std::printf(
+      "    \"steadyStateBytes\": %lld\n",
+      static_cast<long long>(statistics.currentBytes));
+  std::printf("  }%s\n", last ? "" : ",");
+}
+
+} // namespace CesiumNativeBenchmarks
+
+#if CESIUM_BENCHMARKS_TRACK_ALLOCATIONS
+// Replacements of the global allocation functions. The aligned versions are
+// not replaced, and keep allocating without being counted.
+
+void* operator new(std::size_t size) {
+  void* p = CesiumNativeBenchmarks::allocate(size);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return CesiumNativeBenchmarks::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return CesiumNativeBenchmarks::allocate(size);
+}
+
+void operator delete(void* p) noexcept {
+  CesiumNativeBenchmarks::deallocate(p);
+}
+
+void operator delete[](void* p) noexcept {
+  CesiumNativeBenchmarks::deallocate(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  CesiumNativeBenchmarks::deallocate(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+  CesiumNativeBenchmarks::deallocate(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+  CesiumNativeBenchmarks::deallocate(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  CesiumNativeBenchmarks::deallocate(p);
+}
+#endif
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief The memory allocated with the global `operator new` while an
+ * {@link AllocationScope} was open.
+ */
+struct AllocationStatistics {
+  /**
+   * @brief The number of allocations.
+   */
+  int64_t allocations = 0;
+
+  /**
+   * @brief The total size in bytes of the allocations, including those that
+   * were freed again.
+   */
+  int64_t bytesAllocated = 0;
+
+  /**
+   * @brief The largest number of bytes that were allocated, and not yet
+   * freed, at any one time, relative to when the scope opened.
+   */
+  int64_t peakBytes = 0;
+
+  /**
+   * @brief The number of bytes that were allocated, and not yet freed, when
+   * the statistics were taken, relative to when the scope opened.
+   *
+   * After a scenario has finished loading, this is its steady-state memory.
+   */
+  int64_t currentBytes = 0;
+};
+
+/**
+ * @brief Whether allocations are tracked, which they are when the benchmarks
+ * are built with the `CESIUM_BENCHMARKS_TRACK_ALLOCATIONS` CMake option.
+ *
+ * That option replaces the global `operator new` and `operator delete` of the
+ * benchmark executable with versions that count the bytes they allocate.
+ * Otherwise, all {@link AllocationStatistics} are zero.
+ */
+bool isAllocationTrackingEnabled() noexcept;
+
+/**
+ * @brief Measures the memory allocated from when it is constructed.
+ *
+ * Scopes do not nest: opening a scope restarts the peak of any scope that is
+ * already open.
+ */
+class AllocationScope {
+public:
+  /**
+   * @brief Opens the scope.
+   */
+  AllocationScope() noexcept;
+
+  /**
+   * @brief Gets the memory allocated since the scope opened.
+   */
+  AllocationStatistics getStatistics() const noexcept;
+
+private:
+  int64_t _allocations;
+  int64_t _bytesAllocated;
+  int64_t _currentBytes;
+};
+
+/**
+ * @brief Prints allocation statistics as a JSON object member, indented to be
+ * nested one object deep, or `null` if allocations are not tracked.
+ *
+ * @param name The name of the member.
+ * @param statistics The statistics.
+ * @param last Whether this is the last member of its object, which is not
+ * followed by a comma.
+ */
+void printAllocationStatistics(
+    const char* name,
+    const AllocationStatistics& statistics,
+    bool last);
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,72 @@
+#include "BenchmarkTimings.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+
+  const size_t rank = static_cast<size_t>(
+      std::ceil(fraction * static_cast<double>(sorted.size())));
+  return sorted[std::clamp(rank, size_t(1), sorted.size()) - 1];
+}
+
+Timings summarizeTimes(std::vector<double>&& seconds) {
+  Timings result;
+  if (seconds.empty()) {
+    return result;
+  }
+
+  std::sort(seconds.begin(), seconds.end());
+  double total = 0.0;
+  for (double t : seconds) {
+    total += t;
+  }
+
+  const double milliseconds = 1000.0;
+  result.mean = total / static_cast<double>(seconds.size()) * milliseconds;
+  result.median = seconds[seconds.size() / 2] * milliseconds;
+  result.min = seconds.front() * milliseconds;
+  return result;
+}
+
+std::optional<Timings>
+timeRepeatedly(size_t iterations, const std::function<bool()>& f) {
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> times;
+  times.reserve(iterations);
+  for (size_t i = 0; i < iterations; ++i) {
+    const Clock::time_point start = Clock::now();
+    const bool succeeded = f();
+    times.emplace_back(
+        std::chrono::duration<double>(Clock::now() - start).count());
+    if (!succeeded) {
+      return std::nullopt;
+    }
+  }
+
+  return summarizeTimes(std::move(times));
+}
+
+void printTimings(
+    const char* name,
+    const Timings& timings,
+    bool last,
+    size_t depth) {
+  const int indent = static_cast<int>(depth * 2);
+  std::printf("%*s\"%s\": {\n", indent, "", name);
+  std::printf("%*s  \"mean\": %.4f,\n", indent, "", timings.mean);
+  std::printf("%*s  \"median\": %.4f,\n", indent, "", timings.median);
+  std::printf("%*s  \"min\": %.4f\n", indent, "", timings.min);
+  std::printf("%*s}%s\n", indent, "", last ? "" : ",");
+}
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief Gets the given percentile of sorted values, using the nearest rank.
+ *
+ * @param sorted The values, sorted in ascending order.
+ * @param fraction The percentile, from 0.0 to 1.0.
+ * @return The value, or 0.0 if there are no values.
+ */
+double percentile(const std::vector<double>& sorted, double fraction);
+
+/**
+ * @brief Summarizes the times of repeated runs of a benchmark, in
+ * milliseconds.
+ */
+struct Timings {
+  double mean = 0.0;
+  double median = 0.0;
+  double min = 0.0;
+};
+
+/**
+ * @brief Gets the given percentile of sorted values, using the nearest rank.
+ *
+ * @param sorted The values, sorted in ascending order.
+ * @param fraction The percentile, from 0.0 to 1.0.
+ * @return The value, or 0.0 if there are no values.
+ */
+double percentile(const std::vector<double>& sorted, double fraction);
+
+/**
+ * @brief Summarizes the times of runs of a benchmark.
+ *
+ * @param seconds The time of each run, in seconds.
+ * @return The timings, which are all zero if there were no runs.
+ */
+Timings summarizeTimes(std::vector<double>&& seconds);
+
+/**
+ * @brief Runs a function repeatedly and measures how long each run takes.
+ *
+ * @param iterations The number of times to run the function.
+ * @param f The function, which returns whether its run succeeded.
+ * @return The timings, or std::nullopt if a run did not succeed.
+ */
+std::optional<Timings>
+timeRepeatedly(size_t iterations, const std::function<bool()>& f);
+
+/**
+ * @brief Prints timings as a JSON object member.
+ *
+ * @param name The name of the member.
+ * @param timings The timings.
+ * @param last Whether this is the last member of its object, which is not
+ * followed by a comma.
+ * @param depth The number of objects and arrays that the member is nested in,
+ * which determines its indentation.
+ */
+void printTimings(
+    const char* name,
+    const Timings& timings,
+    bool last,
+    size_t depth = 2);
+
+} // namespace CesiumNativeBenchmarks
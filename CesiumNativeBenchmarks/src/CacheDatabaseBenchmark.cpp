@@ -0,0 +1,293 @@
+#include "CacheDatabaseBenchmark.h"
+
+#include "BenchmarkTimings.h"
+
+#include <CesiumAsync/HttpHeaders.h>
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumAsync/MemoryCacheDatabase.h>
+#include <CesiumAsync/SqliteCache.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace CesiumNativeBenchmarks {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// What a database operation found.
+enum class OperationResult { Succeeded, Missed, Failed };
+
+struct ScenarioResult {
+  size_t operations = 0;
+  size_t misses = 0;
+  size_t failures = 0;
+  double seconds = 0.0;
+  std::vector<double> latencies;
+};
+
+// Runs the operations with the given indices, from 0 to operationCount,
+// spread over the threads, and measures how long each one takes.
+ScenarioResult runConcurrently(
+    size_t threadCount,
+    size_t operationCount,
+    const std::function<OperationResult(size_t thread, size_t operation)>&
+        operation) {
+  std::vector<ScenarioResult> threadResults(threadCount);
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount);
+
+  const Clock::time_point start = Clock::now();
+  for (size_t i = 0; i < threadCount; ++i) {
+    ScenarioResult& threadResult = threadResults[i];
+    threads.emplace_back(
+        [i, threadCount, operationCount, &operation, &threadResult]() {
+          for (size_t j = i; j < operationCount; j += threadCount) {
+            const Clock::time_point operationStart = Clock::now();
+            const OperationResult result = operation(i, j);
+            threadResult.latencies.emplace_back(secondsSince(operationStart));
+            if (result == OperationResult::Missed) {
+              ++threadResult.misses;
+            } else if (result == OperationResult::Failed) {
+              ++threadResult.failures;
+            }
+          }
+        });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  ScenarioResult result;
+  result.seconds = secondsSince(start);
+  for (ScenarioResult& threadResult : threadResults) {
+    result.misses += threadResult.misses;
+    result.failures += threadResult.failures;
+    result.latencies.insert(
+        result.latencies.end(),
+        threadResult.latencies.begin(),
+        threadResult.latencies.end());
+  }
+  result.operations = result.latencies.size();
+  std::sort(result.latencies.begin(), result.latencies.end());
+  return result;
+}
+
+void printScenario(
+    const char* name,
+    const ScenarioResult& result,
+    bool last) {
+  const double milliseconds = 1000.0;
+  const double operationsPerSecond =
+      result.seconds > 0.0
+          ? static_cast<double>(result.operations) / result.seconds
+          : 0.0;
+  const double maximum =
+      result.latencies.empty() ? 0.0 : result.latencies.back();
+
+  std::printf("    \"%s\": {\n", name);
+  std::printf("      \"operations\": %zu,\n", result.operations);
+  std::printf("      \"misses\": %zu,\n", result.misses);
+  std::printf("      \"failures\": %zu,\n", result.failures);
+  std::printf("      \"seconds\": %.4f,\n", result.seconds);
+  std::printf("      \"operationsPerSecond\": %.1f,\n", operationsPerSecond);
+  std::printf("      \"latencyMilliseconds\": {\n");
+  std::printf(
+      "        \"p50\": %.4f,\n",
+      percentile(result.latencies, 0.5) * milliseconds);
+  std::printf(
+      "        \"p99\": %.4f,\n",
+      percentile(result.latencies, 0.99) * milliseconds);
+  std::printf("        \"max\": %.4f\n", maximum * milliseconds);
+  std::printf("      }\n");
+  std::printf("    }%s\n", last ? "" : ",");
+}
+
+std::shared_ptr<ICacheDatabase>
+createDatabase(const CacheDatabaseBenchmarkOptions& options) {
+  std::error_code error;
+  std::filesystem::remove(options.databasePath, error);
+
+  auto pSqlite = std::make_shared<SqliteCache>(
+      spdlog::default_logger(),
+      options.databasePath.string(),
+      options.entries);
+  if (options.backend == "sqlite") {
+    return pSqlite;
+  }
+  if (options.backend == "memory") {
+    return std::make_shared<MemoryCacheDatabase>(pSqlite);
+  }
+
+  throw std::runtime_error(
+      "Unknown cache database backend \"" + options.backend +
+      "\". Expected sqlite or memory.");
+}
+
+std::vector<std::byte> createResponseData(size_t size) {
+  // Random bytes, so that backends that compress their data can't shrink it.
+  std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+  std::uniform_int_distribution<int> distribution(0, 255);
+  std::vector<std::byte> data(size);
+  for (std::byte& b : data) {
+    b = std::byte(distribution(generator));
+  }
+  return data;
+}
+
+std::string entryKey(size_t index) {
+  return "https://example.com/tiles/" + std::to_string(index) + ".b3dm";
+}
+} // namespace
+
+int runCacheDatabaseBenchmark(const CacheDatabaseBenchmarkOptions& options) {
+  const size_t threadCount = std::max(options.threads, size_t(1));
+  const size_t entryCount = std::max(options.entries, size_t(1));
+  std::shared_ptr<ICacheDatabase> pDatabase = createDatabase(options);
+
+  const std::vector<std::byte> responseData =
+      createResponseData(options.entryBytes);
+  const std::vector<std::byte> largeResponseData =
+      createResponseData(options.largeEntryBytes);
+  const HttpHeaders requestHeaders;
+  const HttpHeaders responseHeaders{
+      {"Content-Type", "application/octet-stream"}};
+  const std::time_t expiryTime = std::time(nullptr) + 60 * 60 * 24;
+
+  auto store = [&](const std::string& key,
+                   const std::vector<std::byte>& data) {
+    return pDatabase->storeEntry(
+               key,
+               expiryTime,
+               key,
+               "GET",
+               requestHeaders,
+               200,
+               responseHeaders,
+               data)
+               ? OperationResult::Succeeded
+               : OperationResult::Failed;
+  };
+
+  auto get = [&](const std::string& key) {
+    return pDatabase->getEntry(key) ? OperationResult::Succeeded
+                                    : OperationResult::Missed;
+  };
+
+  std::vector<std::mt19937> generators;
+  for (size_t i = 0; i < threadCount; ++i) {
+    generators.emplace_back(static_cast<std::mt19937::result_type>(i));
+  }
+  auto randomKey = [&generators, entryCount](size_t thread) {
+    std::uniform_int_distribution<size_t> distribution(0, entryCount - 1);
+    return entryKey(distribution(generators[thread]));
+  };
+
+  const ScenarioResult populate = runConcurrently(
+      threadCount,
+      entryCount,
+      [&](size_t /* thread */, size_t operation) {
+        return store(entryKey(operation), responseData);
+      });
+
+  const ScenarioResult getEntry = runConcurrently(
+      threadCount,
+      options.operations,
+      [&](size_t thread, size_t /* operation */) {
+        return get(randomKey(thread));
+      });
+
+  auto getAndStore = [&](size_t thread, size_t operation) {
+    if (operation % 5 == 0) {
+      return store(randomKey(thread), responseData);
+    }
+    return get(randomKey(thread));
+  };
+  const ScenarioResult getAndStoreEntry =
+      runConcurrently(threadCount, options.operations, getAndStore);
+
+  // New entries push the database over its maximum number of items, so that
+  // each prune has work to do.
+  std::atomic<bool> storesFinished{false};
+  ScenarioResult prune;
+  std::thread pruner([&]() {
+    const Clock::time_point start = Clock::now();
+    while (!storesFinished) {
+      const Clock::time_point pruneStart = Clock::now();
+      if (!pDatabase->prune()) {
+        ++prune.failures;
+      }
+      prune.latencies.emplace_back(secondsSince(pruneStart));
+    }
+    prune.seconds = secondsSince(start);
+  });
+  const ScenarioResult getAndStoreEntryWhilePruning = runConcurrently(
+      threadCount,
+      options.operations,
+      [&](size_t thread, size_t operation) {
+        if (operation % 5 == 0) {
+          return store(entryKey(entryCount + operation), responseData);
+        }
+        return get(randomKey(thread));
+      });
+  storesFinished = true;
+  pruner.join();
+  prune.operations = prune.latencies.size();
+  std::sort(prune.latencies.begin(), prune.latencies.end());
+
+  const ScenarioResult storeLargeEntry = runConcurrently(
+      threadCount,
+      options.largeEntries,
+      [&](size_t /* thread */, size_t operation) {
+        return store(
+            "https://example.com/large/" + std::to_string(operation),
+            largeResponseData);
+      });
+
+  std::printf("{\n");
+  std::printf("  \"backend\": \"%s\",\n", options.backend.c_str());
+  std::printf("  \"entries\": %zu,\n", entryCount);
+  std::printf("  \"threads\": %zu,\n", threadCount);
+  std::printf("  \"entryBytes\": %zu,\n", options.entryBytes);
+  std::printf("  \"largeEntryBytes\": %zu,\n", options.largeEntryBytes);
+  std::printf("  \"scenarios\": {\n");
+  printScenario("populate", populate, false);
+  printScenario("getEntry", getEntry, false);
+  printScenario("getAndStoreEntry", getAndStoreEntry, false);
+  printScenario(
+      "getAndStoreEntryWhilePruning",
+      getAndStoreEntryWhilePruning,
+      false);
+  printScenario("prune", prune, false);
+  printScenario("storeLargeEntry", storeLargeEntry, true);
+  std::printf("  }\n");
+  std::printf("}\n");
+
+  const size_t failures = populate.failures + getEntry.failures +
+                          getAndStoreEntry.failures +
+                          getAndStoreEntryWhilePruning.failures +
+                          prune.failures + storeLargeEntry.failures;
+  return failures == 0 ? 0 : 2;
+}
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief Options for {@link runCacheDatabaseBenchmark}.
+ */
+struct CacheDatabaseBenchmarkOptions {
+  /**
+   * @brief The path of the database, which is deleted and created again.
+   */
+  std::filesystem::path databasePath;
+
+  /**
+   * @brief The {@link CesiumAsync::ICacheDatabase} to benchmark.
+   *
+   * `sqlite` is a {@link CesiumAsync::SqliteCache}, and `memory` is a
+   * {@link CesiumAsync::MemoryCacheDatabase} in front of one.
+   */
+  std::string backend = "sqlite";
+
+  /**
+   * @brief The number of entries the database is populated with.
+   */
+  size_t entries = 100000;
+
+  /**
+   * @brief The number of threads that use the database at the same time.
+   */
+  size_t threads = 8;
+
+  /**
+   * @brief The number of operations of each concurrent scenario, shared
+   * between the threads.
+   */
+  size_t operations = 100000;
+
+  /**
+   * @brief The size in bytes of the response data of the entries.
+   */
+  size_t entryBytes = 2048;
+
+  /**
+   * @brief The size in bytes of the response data of the large entries.
+   */
+  size_t largeEntryBytes = 4 * 1024 * 1024;
+
+  /**
+   * @brief The number of large entries that are stored.
+   */
+  size_t largeEntries = 64;
+};
+
+/**
+ * @brief Stresses an {@link CesiumAsync::ICacheDatabase} from many threads,
+ * and reports the operations per second and the latencies of each scenario,
+ * as JSON.
+ *
+ * The scenarios run in order on the same database:
+ *
+ * - `populate` stores the entries.
+ * - `getEntry` finds random entries.
+ * - `getAndStoreEntry` finds random entries, and replaces one in five.
+ * - `getAndStoreEntryWhilePruning` does the same while another thread prunes
+ *   the database over and over, with enough new entries that each prune
+ *   removes some. The latencies of the prunes are reported as `prune`.
+ * - `storeLargeEntry` stores entries with large response data.
+ *
+ * @param options The options.
+ * @return The exit code of the benchmark.
+ * @throws std::runtime_error If the backend is not known.
+ */
+int runCacheDatabaseBenchmark(const CacheDatabaseBenchmarkOptions& options);
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,113 @@
+#include "CameraPath.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <rapidjson/document.h>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumUtility;
+
+namespace CesiumNativeBenchmarks {
+
+namespace {
+const rapidjson::Value&
+getMember(const rapidjson::Value& object, const char* name) {
+  auto it = object.FindMember(name);
+  if (it == object.MemberEnd()) {
+    throw std::runtime_error(
+        std::string("Camera path is missing \"") + name + "\".");
+  }
+  return it->value;
+}
+
+double getNumber(const rapidjson::Value& object, const char* name) {
+  const rapidjson::Value& value = getMember(object, name);
+  if (!value.IsNumber()) {
+    throw std::runtime_error(
+        std::string("Camera path \"") + name + "\" is not a number.");
+  }
+  return value.GetDouble();
+}
+
+template <typename TVector>
+TVector getVector(const rapidjson::Value& object, const char* name) {
+  const rapidjson::Value& value = getMember(object, name);
+  TVector result;
+  if (!value.IsArray() || value.Size() != result.length()) {
+    throw std::runtime_error(
+        std::string("Camera path \"") + name + "\" has the wrong length.");
+  }
+
+  for (rapidjson::SizeType i = 0; i < value.Size(); ++i) {
+    if (!value[i].IsNumber()) {
+      throw std::runtime_error(
+          std::string("Camera path \"") + name + "\" is not a number array.");
+    }
+    result[i] = value[i].GetDouble();
+  }
+
+  return result;
+}
+} // namespace
+
+CameraPath readCameraPath(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Could not open camera path " + path.string());
+  }
+
+  const std::string json{
+      std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>()};
+
+  rapidjson::Document document;
+  document.Parse(json.data(), json.size());
+  if (document.HasParseError() || !document.IsObject()) {
+    throw std::runtime_error("Camera path " + path.string() + " is not JSON.");
+  }
+
+  const glm::dvec2 viewportSize =
+      getVector<glm::dvec2>(document, "viewportSize");
+  const double horizontalFieldOfView =
+      Math::degreesToRadians(getNumber(document, "horizontalFieldOfView"));
+  const double aspectRatio = viewportSize.x / viewportSize.y;
+  const double verticalFieldOfView =
+      std::atan(std::tan(horizontalFieldOfView * 0.5) / aspectRatio) * 2.0;
+
+  CameraPath cameraPath;
+  if (document.HasMember("frameTime")) {
+    cameraPath.frameTime = getNumber(document, "frameTime");
+  }
+
+  const rapidjson::Value& frames = getMember(document, "frames");
+  if (!frames.IsArray()) {
+    throw std::runtime_error("Camera path \"frames\" is not an array.");
+  }
+
+  cameraPath.views.reserve(frames.Size());
+  for (const rapidjson::Value& frame : frames.GetArray()) {
+    if (!frame.IsObject()) {
+      throw std::runtime_error("Camera path frame is not an object.");
+    }
+
+    cameraPath.views.emplace_back(ViewState::create(
+        getVector<glm::dvec3>(frame, "position"),
+        getVector<glm::dvec3>(frame, "direction"),
+        getVector<glm::dvec3>(frame, "up"),
+        viewportSize,
+        horizontalFieldOfView,
+        verticalFieldOfView));
+  }
+
+  return cameraPath;
+}
+
+} // namespace CesiumNativeBenchmarks
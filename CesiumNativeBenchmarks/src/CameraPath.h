@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/ViewState.h>
+
+#include <filesystem>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief A recorded sequence of views, one per frame.
+ *
+ * Camera paths are stored as JSON of the following form, where positions and
+ * directions are Earth-centered, Earth-fixed, the field of view is in degrees,
+ * and the frame time is in seconds:
+ *
+ * ```
+ * {
+ *   "viewportSize": [1920, 1080],
+ *   "horizontalFieldOfView": 60.0,
+ *   "frameTime": 0.0166667,
+ *   "frames": [
+ *     { "position": [x, y, z], "direction": [x, y, z], "up": [x, y, z] }
+ *   ]
+ * }
+ * ```
+ *
+ * The frame time is optional and defaults to 1/60th of a second. The vertical
+ * field of view is derived from the aspect ratio of the viewport.
+ */
+struct CameraPath {
+  /**
+   * @brief The time between two frames, in seconds.
+   */
+  double frameTime = 1.0 / 60.0;
+
+  /**
+   * @brief The view of each frame.
+   */
+  std::vector<Cesium3DTilesSelection::ViewState> views;
+};
+
+/**
+ * @brief Reads a camera path from a JSON file.
+ *
+ * @throws std::runtime_error If the file cannot be read or is malformed.
+ */
+CameraPath readCameraPath(const std::filesystem::path& path);
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,142 @@
+#include "ContinuationBenchmark.h"
+
+#include "AllocationTracking.h"
+#include "BenchmarkTimings.h"
+#include "ThreadPoolTaskProcessor.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/Future.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <utility>
+
+using namespace CesiumAsync;
+
+namespace CesiumNativeBenchmarks {
+namespace {
+// The number of continuations in each chain.
+constexpr int32_t chainLength = 1000;
+
+enum class ContinuationKind { Immediately, MainThread, WorkerThread };
+
+bool runChain(const AsyncSystem& asyncSystem, ContinuationKind kind) {
+  auto increment = [](int32_t value) { return value + 1; };
+
+  Future<int32_t> future = asyncSystem.createResolvedFuture<int32_t>(0);
+  for (int32_t i = 0; i < chainLength; ++i) {
+    switch (kind) {
+    case ContinuationKind::Immediately:
+      future = std::move(future).thenImmediately(increment);
+      break;
+    case ContinuationKind::MainThread:
+      future = std::move(future).thenInMainThread(increment);
+      break;
+    case ContinuationKind::WorkerThread:
+      future = std::move(future).thenInWorkerThread(increment);
+      break;
+    }
+  }
+
+  while (!future.isReady()) {
+    asyncSystem.dispatchMainThreadTasks();
+  }
+  return future.wait() == chainLength;
+}
+
+struct ContinuationResult {
+  const char* name;
+  std::optional<Timings> timings;
+  AllocationStatistics memory;
+};
+
+ContinuationResult timeChains(
+    const char* name,
+    size_t iterations,
+    const AsyncSystem& asyncSystem,
+    ContinuationKind kind) {
+  ContinuationResult result{name, std::nullopt, {}};
+  {
+    const AllocationScope scope;
+    runChain(asyncSystem, kind);
+    result.memory = scope.getStatistics();
+  }
+  result.timings = timeRepeatedly(iterations, [&asyncSystem, kind]() {
+    return runChain(asyncSystem, kind);
+  });
+  return result;
+}
+} // namespace
+
+int runContinuationBenchmark(size_t iterations) {
+  const AsyncSystem inlineSystem(std::make_shared<ThreadPoolTaskProcessor>(0));
+  const AsyncSystem threadSystem(std::make_shared<ThreadPoolTaskProcessor>(1));
+
+  const ContinuationResult results[] = {
+      timeChains(
+          "thenImmediately",
+          iterations,
+          inlineSystem,
+          ContinuationKind::Immediately),
+      timeChains(
+          "thenInMainThread",
+          iterations,
+          inlineSystem,
+          ContinuationKind::MainThread),
+      timeChains(
+          "thenInWorkerThreadInline",
+          iterations,
+          inlineSystem,
+          ContinuationKind::WorkerThread),
+      timeChains(
+          "thenInWorkerThread",
+          iterations,
+          threadSystem,
+          ContinuationKind::WorkerThread)};
+
+  for (const ContinuationResult& result : results) {
+    if (!result.timings) {
+      std::fprintf(stderr, "The %s chain did not finish.\n", result.name);
+      return 1;
+    }
+  }
+
+  // Report the time of a single continuation, rather than of a chain.
+  const double nanosecondsPerMillisecond = 1.0e6 / chainLength;
+  std::printf("{\n");
+  std::printf("  \"iterations\": %zu,\n", iterations);
+  std::printf("  \"chainLength\": %d,\n", chainLength);
+  std::printf("  \"continuationTimeNanoseconds\": {\n");
+  const size_t count = sizeof(results) / sizeof(results[0]);
+  for (size_t i = 0; i < count; ++i) {
+    Timings timings = *results[i].timings;
+    timings.mean *= nanosecondsPerMillisecond;
+    timings.median *= nanosecondsPerMillisecond;
+    timings.min *= nanosecondsPerMillisecond;
+    printTimings(results[i].name, timings, i + 1 == count);
+  }
+  std::printf("  },\n");
+  std::printf("  \"allocationsPerChain\": {\n");
+  for (size_t i = 0; i < count; ++i) {
+    if (isAllocationTrackingEnabled()) {
+      std::printf(
+          "    \"%s\": %lld%s\n",
+          results[i].name,
+          static_cast<long long>(results[i].memory.allocations),
+          i + 1 == count ? "" : ",");
+    } else {
+      std::printf(
+          "    \"%s\": null%s\n",
+          results[i].name,
+          i + 1 == count ? "" : ",");
+    }
+  }
+  std::printf("  }\n");
+  std::printf("}\n");
+
+  return 0;
+}
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief Attaches long chains of continuations to futures repeatedly, and
+ * reports how long a continuation takes, as JSON.
+ *
+ * Chains of {@link CesiumAsync::Future::thenImmediately},
+ * {@link CesiumAsync::Future::thenInMainThread}, and
+ * {@link CesiumAsync::Future::thenInWorkerThread} continuations are timed.
+ * The worker thread continuations run with a task processor that runs tasks
+ * in the thread that starts them, which measures the overhead of scheduling
+ * them alone, and with one that runs them in a single other thread. When
+ * allocations are tracked, the allocations of each kind of continuation are
+ * reported as well.
+ *
+ * @param iterations The number of chains of each kind of continuation.
+ * @return The exit code of the benchmark.
+ */
+int runContinuationBenchmark(size_t iterations);
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,192 @@
+#include "FileAssetAccessor.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <cctype>
+#include <fstream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace CesiumNativeBenchmarks {
+
+namespace {
+class FileAssetResponse : public IAssetResponse {
+public:
+  FileAssetResponse(uint16_t statusCode, std::vector<std::byte>&& data)
+      : _statusCode(statusCode), _headers(), _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const override { return this->_statusCode; }
+
+  virtual std::string contentType() const override { return std::string(); }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return gsl::span<const std::byte>(this->_data.data(), this->_data.size());
+  }
+
+  std::vector<std::byte> takeData() noexcept {
+    return std::exchange(this->_data, {});
+  }
+
+private:
+  uint16_t _statusCode;
+  HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class FileAssetRequest : public IAssetRequest {
+public:
+  FileAssetRequest(
+      const std::string& method,
+      const std::string& url,
+      std::unique_ptr<FileAssetResponse>&& pResponse)
+      : _method(method),
+        _url(url),
+        _headers(),
+        _pResponse(std::move(pResponse)) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const override {
+    return this->_pResponse.get();
+  }
+
+  virtual std::vector<std::byte> takeResponseData() override {
+    return this->_pResponse->takeData();
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  std::unique_ptr<FileAssetResponse> _pResponse;
+};
+
+std::unique_ptr<FileAssetResponse> readFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return std::make_unique<FileAssetResponse>(
+        uint16_t(404),
+        std::vector<std::byte>());
+  }
+
+  const std::streamsize size = file.tellg();
+  file.seekg(0, std::ios::beg);
+
+  std::vector<std::byte> data(static_cast<size_t>(size));
+  file.read(reinterpret_cast<char*>(data.data()), size);
+
+  return std::make_unique<FileAssetResponse>(uint16_t(200), std::move(data));
+}
+
+int hexDigitValue(char c) noexcept {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+} // namespace
+
+Future<std::shared_ptr<IAssetRequest>> FileAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->request(asyncSystem, "GET", url, headers, {});
+}
+
+Future<std::shared_ptr<IAssetRequest>> FileAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& /* headers */,
+    const gsl::span<const std::byte>& /* contentPayload */) {
+  return asyncSystem.runInWorkerThread([this, verb, url]() {
+    std::unique_ptr<FileAssetResponse> pResponse = readFile(urlToPath(url));
+
+    ++this->_requestsCompleted;
+    this->_bytesFetched += static_cast<int64_t>(pResponse->data().size());
+
+    return std::shared_ptr<IAssetRequest>(
+        std::make_shared<FileAssetRequest>(verb, url, std::move(pResponse)));
+  });
+}
+
+std::string FileAssetAccessor::pathToUrl(const std::filesystem::path& path) {
+  const std::string generic =
+      std::filesystem::absolute(path).lexically_normal().generic_string();
+
+  std::string url = "file://";
+  if (generic.empty() || generic.front() != '/') {
+    // Windows paths start with a drive letter.
+    url += '/';
+  }
+
+  const char* hexDigits = "0123456789ABCDEF";
+  for (const char c : generic) {
+    const unsigned char byte = static_cast<unsigned char>(c);
+    if (std::isalnum(byte) || c == '/' || c == ':' || c == '-' || c == '_' ||
+        c == '.' || c == '~') {
+      url += c;
+    } else {
+      url += '%';
+      url += hexDigits[byte >> 4];
+      url += hexDigits[byte & 0xF];
+    }
+  }
+
+  return url;
+}
+
+std::filesystem::path FileAssetAccessor::urlToPath(const std::string& url) {
+  std::string path = url.substr(0, url.find_first_of("?#"));
+
+  const std::string scheme = "file://";
+  if (path.compare(0, scheme.size(), scheme) == 0) {
+    path.erase(0, scheme.size());
+  }
+
+  // Remove the slash in front of a Windows drive letter.
+  if (path.size() > 2 && path[0] == '/' && path[2] == ':') {
+    path.erase(0, 1);
+  }
+
+  std::string decoded;
+  decoded.reserve(path.size());
+  for (size_t i = 0; i < path.size(); ++i) {
+    if (path[i] == '%' && i + 2 < path.size()) {
+      const int high = hexDigitValue(path[i + 1]);
+      const int low = hexDigitValue(path[i + 2]);
+      if (high >= 0 && low >= 0) {
+        decoded += static_cast<char>(high * 16 + low);
+        i += 2;
+        continue;
+      }
+    }
+
+    decoded += path[i];
+  }
+
+  return std::filesystem::u8path(decoded);
+}
+
+} // namespace CesiumNativeBenchmarks
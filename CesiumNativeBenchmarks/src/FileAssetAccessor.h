@@ -0,0 +1,64 @@
+#pragma once
+
+#include <CesiumAsync/IAssetAccessor.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief An {@link CesiumAsync::IAssetAccessor} that reads `file://` URLs from
+ * the local disk, and counts what it reads.
+ *
+ * Files are read in a worker thread. Missing files are reported with a 404
+ * status code.
+ */
+class FileAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override {}
+
+  /**
+   * @brief Gets the number of requests that have completed.
+   */
+  int64_t getRequestsCompleted() const noexcept {
+    return this->_requestsCompleted;
+  }
+
+  /**
+   * @brief Gets the number of bytes read by the completed requests.
+   */
+  int64_t getBytesFetched() const noexcept { return this->_bytesFetched; }
+
+  /**
+   * @brief Converts a local path to a `file://` URL.
+   */
+  static std::string pathToUrl(const std::filesystem::path& path);
+
+  /**
+   * @brief Converts a `file://` URL to a local path, ignoring its query and
+   * fragment.
+   */
+  static std::filesystem::path urlToPath(const std::string& url);
+
+private:
+  std::atomic<int64_t> _requestsCompleted{0};
+  std::atomic<int64_t> _bytesFetched{0};
+};
+
+} // namespace CesiumNativeBenchmarks
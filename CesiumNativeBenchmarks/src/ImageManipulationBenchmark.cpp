@@ -0,0 +1,128 @@
+#include "ImageManipulationBenchmark.h"
+
+#include "AllocationTracking.h"
+#include "BenchmarkTimings.h"
+
+#include <CesiumGltf/ImageCesium.h>
+#include <CesiumGltfContent/ImageManipulation.h>
+#include <CesiumRasterOverlays/RasterOverlayUtilities.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+using namespace CesiumRasterOverlays;
+
+namespace CesiumNativeBenchmarks {
+namespace {
+constexpr int32_t tileSize = 256;
+constexpr int32_t imageSize = 1024;
+
+ImageCesium createImage(int32_t size) {
+  ImageCesium image;
+  image.width = size;
+  image.height = size;
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(size_t(size) * size_t(size) * 4);
+  for (size_t i = 0; i < image.pixelData.size(); ++i) {
+    image.pixelData[i] = std::byte((i * 7 + i / 1024) & 0xff);
+  }
+  return image;
+}
+} // namespace
+
+int runImageManipulationBenchmark(size_t iterations) {
+  const ImageCesium tile = createImage(tileSize);
+  const ImageCesium image = createImage(imageSize);
+  ImageCesium target = createImage(imageSize);
+  ImageCesium smallTarget = createImage(tileSize);
+
+  const PixelRectangle tilePixels{0, 0, tileSize, tileSize};
+  const PixelRectangle imagePixels{0, 0, imageSize, imageSize};
+
+  const std::optional<Timings> copy = timeRepeatedly(iterations, [&]() {
+    bool succeeded = true;
+    for (int32_t y = 0; y < imageSize; y += tileSize) {
+      for (int32_t x = 0; x < imageSize; x += tileSize) {
+        succeeded = ImageManipulation::blitImage(
+                        target,
+                        PixelRectangle{x, y, tileSize, tileSize},
+                        tile,
+                        tilePixels) &&
+                    succeeded;
+      }
+    }
+    return succeeded;
+  });
+
+  const std::optional<Timings> scaleUp = timeRepeatedly(iterations, [&]() {
+    return ImageManipulation::blitImage(target, imagePixels, tile, tilePixels);
+  });
+
+  const std::optional<Timings> scaleDown = timeRepeatedly(iterations, [&]() {
+    return ImageManipulation::blitImage(
+        smallTarget,
+        tilePixels,
+        image,
+        imagePixels);
+  });
+
+  const std::optional<Timings> scaleOther = timeRepeatedly(iterations, [&]() {
+    return ImageManipulation::blitImage(
+        target,
+        PixelRectangle{0, 0, 600, 600},
+        tile,
+        tilePixels);
+  });
+
+  const std::vector<const ImageCesium*> atlasImages(16, &tile);
+  const std::optional<Timings> atlas = timeRepeatedly(iterations, [&]() {
+    return RasterOverlayUtilities::createAtlas(atlasImages).has_value();
+  });
+
+  // Measure the memory of compositing the tiles of a raster overlay into one
+  // new image and into an atlas, while the results are still alive.
+  AllocationStatistics memory;
+  {
+    const AllocationScope scope;
+    ImageCesium composite = createImage(imageSize);
+    for (int32_t y = 0; y < imageSize; y += tileSize) {
+      for (int32_t x = 0; x < imageSize; x += tileSize) {
+        ImageManipulation::blitImage(
+            composite,
+            PixelRectangle{x, y, tileSize, tileSize},
+            tile,
+            tilePixels);
+      }
+    }
+    const std::optional<RasterOverlayAtlas> maybeAtlas =
+        RasterOverlayUtilities::createAtlas(atlasImages);
+    memory = scope.getStatistics();
+  }
+
+  if (!copy || !scaleUp || !scaleDown || !scaleOther || !atlas) {
+    std::fprintf(stderr, "An image could not be blitted.\n");
+    return 1;
+  }
+
+  std::printf("{\n");
+  std::printf("  \"iterations\": %zu,\n", iterations);
+  std::printf("  \"blitTimeMilliseconds\": {\n");
+  printTimings("copy16Tiles256To1024", *copy, false);
+  printTimings("scale256To1024", *scaleUp, false);
+  printTimings("scale1024To256", *scaleDown, false);
+  printTimings("scale256To600", *scaleOther, false);
+  printTimings("packAtlas16Tiles256", *atlas, true);
+  std::printf("  },\n");
+  printAllocationStatistics("compositingMemory", memory, true);
+  std::printf("}\n");
+
+  return 0;
+}
+
+} // namespace CesiumNativeBenchmarks
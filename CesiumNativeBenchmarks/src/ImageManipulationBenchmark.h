@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief Combines synthetic raster overlay images with
+ * {@link CesiumGltfContent::ImageManipulation::blitImage} repeatedly, and
+ * reports how long each kind of blit takes, as JSON.
+ *
+ * The blits are the ones used to compose 256x256 RGBA overlay tiles into a
+ * 1024x1024 image: copying sixteen tiles without scaling, scaling one tile up
+ * by a factor of four, scaling the whole image down by a factor of four, and
+ * scaling one tile to a size that isn't an integer multiple. Packing sixteen
+ * tiles into an atlas with
+ * {@link CesiumRasterOverlays::RasterOverlayUtilities::createAtlas} is timed
+ * as well, and the memory that compositing the tiles allocates is reported
+ * when allocations are tracked.
+ *
+ * @param iterations The number of times to do each kind of blit.
+ * @return The exit code of the benchmark.
+ */
+int runImageManipulationBenchmark(size_t iterations);
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,106 @@
+#include "JsonParseBenchmark.h"
+
+#include "AllocationTracking.h"
+
+#include <Cesium3DTilesReader/TilesetReader.h>
+#include <CesiumGltfReader/GltfReader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+using namespace Cesium3DTilesReader;
+using namespace CesiumGltfReader;
+
+namespace CesiumNativeBenchmarks {
+
+int runJsonParseBenchmark(
+    const std::filesystem::path& path,
+    size_t iterations) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Could not open " + path.string());
+  }
+
+  const std::vector<char> contents{
+      std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>()};
+  const gsl::span<const std::byte> data(
+      reinterpret_cast<const std::byte*>(contents.data()),
+      contents.size());
+
+  const bool isGltf = path.extension() == ".gltf";
+  const GltfReader gltfReader;
+  const TilesetReader tilesetReader;
+
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> times;
+  times.reserve(iterations);
+  for (size_t i = 0; i < iterations; ++i) {
+    const Clock::time_point start = Clock::now();
+    bool succeeded;
+    if (isGltf) {
+      GltfReaderResult result = gltfReader.readGltf(data);
+      succeeded = result.model && result.errors.empty();
+    } else {
+      auto result = tilesetReader.readFromJson(data);
+      succeeded = result.value && result.errors.empty();
+    }
+    times.emplace_back(
+        std::chrono::duration<double>(Clock::now() - start).count());
+
+    if (!succeeded) {
+      std::fprintf(stderr, "The file could not be read.\n");
+      return 1;
+    }
+  }
+
+  if (times.empty()) {
+    return 0;
+  }
+
+  // Measure the memory of one more read, while its result is still alive.
+  AllocationStatistics memory;
+  {
+    const AllocationScope scope;
+    if (isGltf) {
+      const GltfReaderResult result = gltfReader.readGltf(data);
+      memory = scope.getStatistics();
+    } else {
+      const auto result = tilesetReader.readFromJson(data);
+      memory = scope.getStatistics();
+    }
+  }
+
+  std::sort(times.begin(), times.end());
+  double total = 0.0;
+  for (double time : times) {
+    total += time;
+  }
+
+  const double milliseconds = 1000.0;
+  const double mean = total / static_cast<double>(times.size());
+  std::printf("{\n");
+  std::printf("  \"iterations\": %zu,\n", times.size());
+  std::printf("  \"fileBytes\": %zu,\n", contents.size());
+  std::printf("  \"parseTimeMilliseconds\": {\n");
+  std::printf("    \"mean\": %.4f,\n", mean * milliseconds);
+  std::printf(
+      "    \"median\": %.4f,\n",
+      times[times.size() / 2] * milliseconds);
+  std::printf("    \"min\": %.4f\n", times.front() * milliseconds);
+  std::printf("  },\n");
+  std::printf(
+      "  \"megabytesPerSecond\": %.1f,\n",
+      static_cast<double>(contents.size()) / mean / 1.0e6);
+  printAllocationStatistics("memory", memory, true);
+  std::printf("}\n");
+
+  return 0;
+}
+
+} // namespace CesiumNativeBenchmarks
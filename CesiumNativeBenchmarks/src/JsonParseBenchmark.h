@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief Reads a `tileset.json` or glTF JSON file repeatedly, and reports how
+ * long it takes, as JSON.
+ *
+ * Files ending in `.gltf` are read with
+ * {@link CesiumGltfReader::GltfReader::readGltf}, and all others with
+ * {@link Cesium3DTilesReader::TilesetReader::readFromJson}. When allocations
+ * are tracked, the peak memory of a read, and the memory its result keeps, are
+ * reported as well.
+ *
+ * @param path The path of the file.
+ * @param iterations The number of times to read the file.
+ * @return The exit code of the benchmark.
+ * @throws std::runtime_error If the file cannot be read.
+ */
+int runJsonParseBenchmark(
+    const std::filesystem::path& path,
+    size_t iterations);
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,314 @@
+#include "KernelBenchmarks.h"
+
+#include "BenchmarkTimings.h"
+
+#include <Cesium3DTilesContent/PntsToGltfConverter.h>
+#include <Cesium3DTilesContent/QuantizedMeshLoader.h>
+#include <Cesium3DTilesContent/upsampleGltfForRasterOverlays.h>
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeometry/QuadtreeTilingScheme.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GeographicProjection.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumGltfReader/GltfReader.h>
+#include <CesiumRasterOverlays/RasterOverlayUtilities.h>
+#include <CesiumUtility/Math.h>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesContent;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltfReader;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace CesiumNativeBenchmarks {
+namespace {
+// The number of positions along each axis of the grids of positions and
+// bounding volumes.
+constexpr size_t gridSize = 128;
+
+std::vector<std::byte> readFixture(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Could not open fixture " + path.string());
+  }
+
+  const std::vector<char> contents{
+      std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>()};
+  std::vector<std::byte> result(contents.size());
+  std::copy(
+      contents.begin(),
+      contents.end(),
+      reinterpret_cast<char*>(result.data()));
+  return result;
+}
+
+// Cartographic positions covering most of the globe, with varied heights.
+std::vector<Cartographic> createPositionGrid() {
+  std::vector<Cartographic> positions;
+  positions.reserve(gridSize * gridSize);
+  for (size_t j = 0; j < gridSize; ++j) {
+    const double latitude =
+        Math::lerp(-1.5, 1.5, double(j) / double(gridSize - 1));
+    for (size_t i = 0; i < gridSize; ++i) {
+      const double longitude = Math::lerp(
+          -Math::OnePi,
+          Math::OnePi,
+          double(i) / double(gridSize - 1));
+      positions.emplace_back(longitude, latitude, double((i + j) % 17) * 100.0);
+    }
+  }
+  return positions;
+}
+
+struct KernelResult {
+  const char* name;
+  std::optional<Timings> timings;
+};
+} // namespace
+
+int runKernelBenchmarks(size_t iterations) {
+  const std::filesystem::path selectionData =
+      Cesium3DTilesSelection_TEST_DATA_DIR;
+  const std::filesystem::path gltfData = CesiumGltfReader_TEST_DATA_DIR;
+
+  const std::vector<std::byte> terrain =
+      readFixture(selectionData / "CesiumTerrainTileJson" / "tile.terrain");
+  const std::vector<std::byte> pointCloud =
+      readFixture(selectionData / "PointCloud" / "pointCloudDraco.pnts");
+  const std::vector<std::byte> gltf =
+      readFixture(gltfData / "BoxTextured.gltf");
+  const std::vector<std::byte> glb =
+      readFixture(gltfData / "CesiumBalloon.glb");
+
+  std::vector<KernelResult> results;
+
+  // Quantized-mesh decoding of the western root tile.
+  const GeographicProjection projection;
+  const QuadtreeTilingScheme tilingScheme(
+      projection.project(GeographicProjection::MAXIMUM_GLOBE_RECTANGLE),
+      2,
+      1);
+  const QuadtreeTileID terrainID(0, 0, 0);
+  const GlobeRectangle terrainRectangle =
+      projection.unproject(tilingScheme.tileToRectangle(terrainID));
+  const BoundingRegion terrainRegion(terrainRectangle, -1000.0, 9000.0);
+
+  std::optional<CesiumGltf::Model> terrainModel;
+  results.push_back(
+      {"quantizedMeshLoad", timeRepeatedly(iterations, [&]() {
+         QuantizedMeshLoadResult result = QuantizedMeshLoader::load(
+             terrainID,
+             terrainRegion,
+             "tile.terrain",
+             terrain,
+             false);
+         terrainModel = std::move(result.model);
+         return terrainModel && !result.errors.hasErrors();
+       })});
+
+  // Upsampling of the decoded tile into its four children.
+  std::optional<Timings> upsample;
+  if (terrainModel &&
+      RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
+          *terrainModel,
+          glm::dmat4(1.0),
+          terrainRectangle,
+          {projection},
+          false,
+          "_CESIUMOVERLAY_",
+          0)) {
+    const std::vector<UpsampledQuadtreeNode> children{
+        {QuadtreeTileID(1, 0, 0)},
+        {QuadtreeTileID(1, 1, 0)},
+        {QuadtreeTileID(1, 0, 1)},
+        {QuadtreeTileID(1, 1, 1)}};
+    upsample = timeRepeatedly(iterations, [&]() {
+      const std::vector<std::optional<CesiumGltf::Model>> upsampled =
+          upsampleGltfForRasterOverlays(*terrainModel, children, 0);
+      return upsampled.size() == children.size();
+    });
+  }
+  results.push_back({"upsampleGltfForRasterOverlays", upsample});
+
+  // glTF reading.
+  const GltfReader reader;
+  results.push_back(
+      {"readGltfJson", timeRepeatedly(iterations, [&]() {
+         GltfReaderResult result = reader.readGltf(gltf);
+         return result.model && result.errors.empty();
+       })});
+  results.push_back(
+      {"readGltfBinary", timeRepeatedly(iterations, [&]() {
+         GltfReaderResult result = reader.readGltf(glb);
+         return result.model && result.errors.empty();
+       })});
+
+  // Draco decoding of a point cloud.
+  results.push_back(
+      {"decodeDracoPointCloud", timeRepeatedly(iterations, [&]() {
+         GltfConverterResult result =
+             PntsToGltfConverter::convert(pointCloud, {});
+         return result.model && !result.errors.hasErrors();
+       })});
+
+  // Ellipsoid conversions.
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const std::vector<Cartographic> cartographics = createPositionGrid();
+  const size_t positionCount = cartographics.size();
+  std::vector<double> longitudes(positionCount);
+  std::vector<double> latitudes(positionCount);
+  std::vector<double> heights(positionCount);
+  for (size_t i = 0; i < positionCount; ++i) {
+    longitudes[i] = cartographics[i].longitude;
+    latitudes[i] = cartographics[i].latitude;
+    heights[i] = cartographics[i].height;
+  }
+
+  std::vector<glm::dvec3> cartesians(positionCount);
+  std::vector<double> xs(positionCount);
+  std::vector<double> ys(positionCount);
+  std::vector<double> zs(positionCount);
+  results.push_back(
+      {"ellipsoidCartographicToCartesian", timeRepeatedly(iterations, [&]() {
+         for (size_t i = 0; i < positionCount; ++i) {
+           cartesians[i] = ellipsoid.cartographicToCartesian(cartographics[i]);
+         }
+         return true;
+       })});
+  results.push_back(
+      {"ellipsoidCartographicToCartesianBatch",
+       timeRepeatedly(iterations, [&]() {
+         ellipsoid.cartographicToCartesian(
+             longitudes,
+             latitudes,
+             heights,
+             xs,
+             ys,
+             zs);
+         return true;
+       })});
+  results.push_back(
+      {"ellipsoidCartesianToCartographic", timeRepeatedly(iterations, [&]() {
+         bool succeeded = true;
+         for (size_t i = 0; i < positionCount; ++i) {
+           const std::optional<Cartographic> maybeCartographic =
+               ellipsoid.cartesianToCartographic(cartesians[i]);
+           succeeded = succeeded && maybeCartographic.has_value();
+         }
+         return succeeded;
+       })});
+  results.push_back(
+      {"ellipsoidCartesianToCartographicBatch",
+       timeRepeatedly(iterations, [&]() {
+         ellipsoid.cartesianToCartographic(
+             xs,
+             ys,
+             zs,
+             longitudes,
+             latitudes,
+             heights);
+         return true;
+       })});
+
+  // Culling of bounding volumes around a camera looking at the ground from
+  // above.
+  const glm::dvec3 target =
+      ellipsoid.cartographicToCartesian(Cartographic(0.1, 0.2, 0.0));
+  const glm::dvec3 normal = ellipsoid.geodeticSurfaceNormal(target);
+  const ViewState viewState = ViewState::create(
+      target + normal * 20000.0,
+      -normal,
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(1920.0, 1080.0),
+      Math::degreesToRadians(60.0),
+      Math::degreesToRadians(40.0));
+
+  std::vector<BoundingVolume> volumes;
+  volumes.reserve(gridSize * gridSize);
+  const double spacing = 0.0005;
+  for (size_t j = 0; j < gridSize; ++j) {
+    for (size_t i = 0; i < gridSize; ++i) {
+      const double west = 0.1 + (double(i) - double(gridSize / 2)) * spacing;
+      const double south = 0.2 + (double(j) - double(gridSize / 2)) * spacing;
+      const GlobeRectangle rectangle(
+          west,
+          south,
+          west + spacing,
+          south + spacing);
+      if ((i + j) % 2 == 0) {
+        volumes.emplace_back(BoundingRegion(rectangle, 0.0, 500.0));
+      } else {
+        volumes.emplace_back(BoundingSphere(
+            ellipsoid.cartographicToCartesian(rectangle.computeCenter()),
+            spacing * ellipsoid.getMaximumRadius()));
+      }
+    }
+  }
+
+  std::vector<const BoundingVolume*> volumePointers(volumes.size());
+  for (size_t i = 0; i < volumes.size(); ++i) {
+    volumePointers[i] = &volumes[i];
+  }
+  std::unique_ptr<bool[]> visible(new bool[volumes.size()]);
+
+  results.push_back(
+      {"isBoundingVolumeVisible", timeRepeatedly(iterations, [&]() {
+         for (size_t i = 0; i < volumes.size(); ++i) {
+           visible[i] = viewState.isBoundingVolumeVisible(volumes[i]);
+         }
+         return true;
+       })});
+  results.push_back(
+      {"areBoundingVolumesVisible", timeRepeatedly(iterations, [&]() {
+         viewState.areBoundingVolumesVisible(
+             volumePointers,
+             gsl::span<bool>(visible.get(), volumes.size()));
+         return true;
+       })});
+
+  for (const KernelResult& result : results) {
+    if (!result.timings) {
+      std::fprintf(stderr, "The %s kernel failed.\n", result.name);
+      return 1;
+    }
+  }
+
+  std::printf("{\n");
+  std::printf("  \"iterations\": %zu,\n", iterations);
+  std::printf("  \"positions\": %zu,\n", positionCount);
+  std::printf("  \"boundingVolumes\": %zu,\n", volumes.size());
+  std::printf("  \"kernelTimeMilliseconds\": {\n");
+  for (size_t i = 0; i < results.size(); ++i) {
+    printTimings(results[i].name, *results[i].timings, i + 1 == results.size());
+  }
+  std::printf("  }\n");
+  std::printf("}\n");
+
+  return 0;
+}
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief Runs microbenchmarks of the core loading and selection kernels over
+ * the checked-in test fixtures, and reports how long each takes, as JSON.
+ *
+ * The kernels are:
+ *
+ * - {@link Cesium3DTilesContent::QuantizedMeshLoader::load} of the
+ *   `CesiumTerrainTileJson/tile.terrain` root tile.
+ * - {@link Cesium3DTilesContent::upsampleGltfForRasterOverlays} of all four
+ *   children of that tile.
+ * - {@link CesiumGltfReader::GltfReader::readGltf} of `BoxTextured.gltf` and
+ *   `CesiumBalloon.glb`.
+ * - Draco decoding of `PointCloud/pointCloudDraco.pnts`. There is no Draco
+ *   compressed glTF among the fixtures, so the point cloud is decoded with
+ *   {@link Cesium3DTilesContent::PntsToGltfConverter}.
+ * - {@link CesiumGeospatial::Ellipsoid} conversions between cartographic and
+ *   cartesian positions for a grid of positions, one at a time and in
+ *   batches.
+ * - {@link Cesium3DTilesSelection::ViewState} culling of a grid of bounding
+ *   regions and spheres, one at a time and in a batch.
+ *
+ * @param iterations The number of times to run each kernel.
+ * @return The exit code of the benchmark.
+ * @throws std::runtime_error If a fixture cannot be read.
+ */
+int runKernelBenchmarks(size_t iterations);
+
+} // namespace CesiumNativeBenchmarks
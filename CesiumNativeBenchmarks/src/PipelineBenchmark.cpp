@@ -0,0 +1,452 @@
+#include "PipelineBenchmark.h"
+
+#include "BenchmarkTimings.h"
+#include "FileAssetAccessor.h"
+#include "QuantizedMeshBenchmark.h"
+#include "ThreadPoolTaskProcessor.h"
+
+#include <Cesium3DTilesContent/GltfConverters.h>
+#include <Cesium3DTilesContent/QuantizedMeshLoader.h>
+#include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <Cesium3DTilesReader/SubtreeFileReader.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumGeometry/QuadtreeTilingScheme.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/GeographicProjection.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+#include <CesiumGltfReader/GltfReader.h>
+#include <CesiumUtility/Gunzip.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Cesium3DTiles;
+using namespace Cesium3DTilesContent;
+using namespace Cesium3DTilesReader;
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+using namespace CesiumGltfReader;
+using namespace CesiumUtility;
+
+namespace CesiumNativeBenchmarks {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+enum class ContentType : size_t {
+  B3dm,
+  Pnts,
+  Cmpt,
+  Glb,
+  QuantizedMesh,
+  Subtree,
+};
+
+constexpr size_t contentTypeCount = 6;
+
+constexpr std::array<const char*, contentTypeCount> contentTypeExtensions{
+    ".b3dm",
+    ".pnts",
+    ".cmpt",
+    ".glb",
+    ".terrain",
+    ".subtree"};
+
+constexpr std::array<const char*, contentTypeCount> contentTypeNames{
+    "b3dm",
+    "pnts",
+    "cmpt",
+    "glb",
+    "quantizedMesh",
+    "subtree"};
+
+std::optional<ContentType> getContentType(const std::filesystem::path& path) {
+  std::string extension = path.extension().string();
+  std::transform(
+      extension.begin(),
+      extension.end(),
+      extension.begin(),
+      [](char c) { return static_cast<char>(std::tolower(c)); });
+  for (size_t i = 0; i < contentTypeCount; ++i) {
+    if (extension == contentTypeExtensions[i]) {
+      return static_cast<ContentType>(i);
+    }
+  }
+  return std::nullopt;
+}
+
+struct ContentFile {
+  std::string url;
+  ContentType type;
+  QuadtreeTileID tileID;
+};
+
+// The time each stage of loading a tile took, in seconds.
+struct StageTimes {
+  bool succeeded = false;
+  size_t bytesFetched = 0;
+  double fetch = 0.0;
+  double gunzip = 0.0;
+  double parse = 0.0;
+  double decode = 0.0;
+  double postProcess = 0.0;
+};
+
+constexpr std::array<const char*, 5> stageNames{
+    "fetch",
+    "gunzip",
+    "parse",
+    "decode",
+    "postProcess"};
+
+std::array<double, 5> getStageTimes(const StageTimes& times) {
+  return {
+      times.fetch,
+      times.gunzip,
+      times.parse,
+      times.decode,
+      times.postProcess};
+}
+
+std::vector<std::vector<ContentFile>>
+findContentFiles(const std::filesystem::path& directory) {
+  std::vector<std::vector<ContentFile>> files(contentTypeCount);
+  for (const std::filesystem::directory_entry& entry :
+       std::filesystem::recursive_directory_iterator(directory)) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
+
+    const std::optional<ContentType> maybeType =
+        getContentType(entry.path());
+    if (!maybeType) {
+      continue;
+    }
+
+    QuadtreeTileID tileID(0, 0, 0);
+    if (*maybeType == ContentType::QuantizedMesh) {
+      try {
+        tileID = parseTerrainTileID(entry.path());
+      } catch (const std::runtime_error&) {
+        // Decode the tile as the western root tile.
+      }
+    }
+
+    files[size_t(*maybeType)].push_back(ContentFile{
+        FileAssetAccessor::pathToUrl(entry.path()),
+        *maybeType,
+        tileID});
+  }
+
+  // Sort the files so that runs load the same files in the same order.
+  for (std::vector<ContentFile>& filesOfType : files) {
+    std::sort(
+        filesOfType.begin(),
+        filesOfType.end(),
+        [](const ContentFile& a, const ContentFile& b) {
+          return a.url < b.url;
+        });
+  }
+
+  return files;
+}
+
+// Decodes the embedded images of a glTF, as GltfReader does when
+// GltfReaderOptions::decodeEmbeddedImages is set.
+bool decodeEmbeddedImages(Model& model) {
+  const GltfReaderOptions options;
+  for (Image& image : model.images) {
+    if (image.uri || !image.cesium.pixelData.empty()) {
+      continue;
+    }
+
+    const BufferView& bufferView =
+        Model::getSafe(model.bufferViews, image.bufferView);
+    const Buffer& buffer = Model::getSafe(model.buffers, bufferView.buffer);
+    if (bufferView.byteOffset + bufferView.byteLength >
+        static_cast<int64_t>(buffer.cesium.data.size())) {
+      return false;
+    }
+
+    const gsl::span<const std::byte> imageData =
+        gsl::span<const std::byte>(buffer.cesium.data)
+            .subspan(
+                static_cast<size_t>(bufferView.byteOffset),
+                static_cast<size_t>(bufferView.byteLength));
+    ImageReaderResult imageResult = GltfReader::readImage(imageData, options);
+    if (!imageResult.image) {
+      return false;
+    }
+    image.cesium = std::move(*imageResult.image);
+  }
+
+  return true;
+}
+
+// Parses, decodes, and post-processes the content of a tile that is
+// converted to glTF.
+bool processContent(
+    const ContentFile& file,
+    const std::vector<std::byte>& data,
+    StageTimes& times) {
+  Clock::time_point stageStart = Clock::now();
+  std::optional<Model> model;
+  if (file.type == ContentType::QuantizedMesh) {
+    const GeographicProjection projection;
+    const QuadtreeTilingScheme tilingScheme(
+        projection.project(GeographicProjection::MAXIMUM_GLOBE_RECTANGLE),
+        2,
+        1);
+    const BoundingRegion boundingRegion(
+        projection.unproject(tilingScheme.tileToRectangle(file.tileID)),
+        -1000.0,
+        9000.0);
+    QuantizedMeshLoadResult result = QuantizedMeshLoader::load(
+        file.tileID,
+        boundingRegion,
+        file.url,
+        data,
+        false);
+    times.parse = secondsSince(stageStart);
+    if (!result.model || result.errors.hasErrors()) {
+      return false;
+    }
+    model = std::move(result.model);
+  } else {
+    // The images are decoded separately below.
+    GltfReaderOptions options;
+    options.decodeEmbeddedImages = false;
+    GltfConverterResult result =
+        GltfConverters::convert(file.url, data, options);
+    times.parse = secondsSince(stageStart);
+    if (!result.model || result.errors.hasErrors()) {
+      return false;
+    }
+    model = std::move(result.model);
+
+    stageStart = Clock::now();
+    const bool decoded = decodeEmbeddedImages(*model);
+    times.decode = secondsSince(stageStart);
+    if (!decoded) {
+      return false;
+    }
+  }
+
+  stageStart = Clock::now();
+  model->generateMissingNormalsSmooth();
+  GltfUtilities::computeBoundingRegion(*model, glm::dmat4(1.0));
+  times.postProcess = secondsSince(stageStart);
+  return true;
+}
+
+Future<StageTimes> loadContent(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<FileAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<SubtreeFileReader>& pSubtreeReader,
+    const ContentFile& file) {
+  const Clock::time_point start = Clock::now();
+  return pAssetAccessor->get(asyncSystem, file.url, {})
+      .thenInWorkerThread([asyncSystem,
+                           pAssetAccessor,
+                           pSubtreeReader,
+                           file,
+                           start](std::shared_ptr<IAssetRequest>&& pRequest) {
+        StageTimes times;
+        times.fetch = secondsSince(start);
+
+        const IAssetResponse* pResponse = pRequest->response();
+        if (!pResponse || pResponse->statusCode() != 200) {
+          return asyncSystem.createResolvedFuture(std::move(times));
+        }
+
+        std::vector<std::byte> data(
+            pResponse->data().begin(),
+            pResponse->data().end());
+        times.bytesFetched = data.size();
+
+        Clock::time_point stageStart = Clock::now();
+        if (isGzip(data)) {
+          std::vector<std::byte> gunzipped;
+          if (!gunzip(data, gunzipped)) {
+            return asyncSystem.createResolvedFuture(std::move(times));
+          }
+          data = std::move(gunzipped);
+        }
+        times.gunzip = secondsSince(stageStart);
+
+        if (file.type != ContentType::Subtree) {
+          times.succeeded = processContent(file, data, times);
+          return asyncSystem.createResolvedFuture(std::move(times));
+        }
+
+        stageStart = Clock::now();
+        return pSubtreeReader
+            ->load(asyncSystem, pAssetAccessor, file.url, {}, std::move(data))
+            .thenImmediately([times, stageStart](
+                                 CesiumJsonReader::ReadJsonResult<Subtree>&&
+                                     result) mutable {
+              times.parse = secondsSince(stageStart);
+              times.succeeded = result.value.has_value();
+              return times;
+            });
+      });
+}
+
+void printRun(
+    size_t threadCount,
+    const std::vector<StageTimes>& results,
+    const std::vector<ContentType>& types,
+    double seconds,
+    bool last) {
+  size_t failedTiles = 0;
+  size_t bytesFetched = 0;
+  for (const StageTimes& times : results) {
+    if (!times.succeeded) {
+      ++failedTiles;
+    }
+    bytesFetched += times.bytesFetched;
+  }
+
+  const double tiles = static_cast<double>(results.size());
+  const double megabytes = static_cast<double>(bytesFetched) / 1.0e6;
+
+  std::printf("    {\n");
+  std::printf("      \"threads\": %zu,\n", threadCount);
+  std::printf("      \"tiles\": %zu,\n", results.size());
+  std::printf("      \"failedTiles\": %zu,\n", failedTiles);
+  std::printf("      \"bytesFetched\": %zu,\n", bytesFetched);
+  std::printf("      \"seconds\": %.4f,\n", seconds);
+  std::printf("      \"tilesPerSecond\": %.2f,\n", tiles / seconds);
+  std::printf("      \"megabytesPerSecond\": %.2f,\n", megabytes / seconds);
+  std::printf("      \"stageMilliseconds\": {\n");
+
+  // The results are in the order of the types, with the same number of each.
+  const size_t tilesPerType = results.size() / types.size();
+  for (size_t i = 0; i < types.size(); ++i) {
+    std::array<std::vector<double>, stageNames.size()> stageTimes;
+    for (size_t j = i * tilesPerType; j < (i + 1) * tilesPerType; ++j) {
+      if (!results[j].succeeded) {
+        continue;
+      }
+      const std::array<double, stageNames.size()> times =
+          getStageTimes(results[j]);
+      for (size_t k = 0; k < stageNames.size(); ++k) {
+        stageTimes[k].emplace_back(times[k]);
+      }
+    }
+
+    std::printf("        \"%s\": {\n", contentTypeNames[size_t(types[i])]);
+    for (size_t k = 0; k < stageNames.size(); ++k) {
+      printTimings(
+          stageNames[k],
+          summarizeTimes(std::move(stageTimes[k])),
+          k + 1 == stageNames.size(),
+          5);
+    }
+    std::printf("        }%s\n", i + 1 == types.size() ? "" : ",");
+  }
+
+  std::printf("      }\n");
+  std::printf("    }%s\n", last ? "" : ",");
+}
+} // namespace
+
+int runPipelineBenchmark(
+    const std::filesystem::path& directory,
+    size_t tilesPerType,
+    const std::vector<size_t>& threadCounts) {
+  registerAllTileContentTypes();
+
+  const std::vector<std::vector<ContentFile>> files =
+      findContentFiles(directory);
+  std::vector<ContentType> types;
+  for (size_t i = 0; i < contentTypeCount; ++i) {
+    if (!files[i].empty()) {
+      types.emplace_back(static_cast<ContentType>(i));
+    }
+  }
+
+  if (types.empty() || tilesPerType == 0) {
+    throw std::runtime_error(
+        "Found no tile content files in " + directory.string());
+  }
+
+  std::printf("{\n");
+  std::printf("  \"tilesPerContentType\": %zu,\n", tilesPerType);
+  std::printf("  \"files\": {\n");
+  for (size_t i = 0; i < types.size(); ++i) {
+    std::printf(
+        "    \"%s\": %zu%s\n",
+        contentTypeNames[size_t(types[i])],
+        files[size_t(types[i])].size(),
+        i + 1 == types.size() ? "" : ",");
+  }
+  std::printf("  },\n");
+  std::printf("  \"runs\": [\n");
+
+  bool allSucceeded = true;
+  for (size_t i = 0; i < threadCounts.size(); ++i) {
+    auto pTaskProcessor =
+        std::make_shared<ThreadPoolTaskProcessor>(threadCounts[i]);
+    const AsyncSystem asyncSystem(pTaskProcessor);
+    auto pAssetAccessor = std::make_shared<FileAssetAccessor>();
+    auto pSubtreeReader = std::make_shared<SubtreeFileReader>();
+
+    const Clock::time_point start = Clock::now();
+    std::vector<Future<StageTimes>> loads;
+    loads.reserve(types.size() * tilesPerType);
+    for (ContentType type : types) {
+      const std::vector<ContentFile>& filesOfType = files[size_t(type)];
+      for (size_t j = 0; j < tilesPerType; ++j) {
+        loads.emplace_back(loadContent(
+            asyncSystem,
+            pAssetAccessor,
+            pSubtreeReader,
+            filesOfType[j % filesOfType.size()]));
+      }
+    }
+
+    const std::vector<StageTimes> results =
+        asyncSystem.all(std::move(loads)).wait();
+    const double seconds = secondsSince(start);
+
+    allSucceeded = allSucceeded &&
+                   std::all_of(
+                       results.begin(),
+                       results.end(),
+                       [](const StageTimes& times) { return times.succeeded; });
+    printRun(
+        threadCounts[i],
+        results,
+        types,
+        seconds,
+        i + 1 == threadCounts.size());
+  }
+
+  std::printf("  ]\n");
+  std::printf("}\n");
+
+  return allSucceeded ? 0 : 2;
+}
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief Loads tile content files from the local disk concurrently, the way a
+ * tileset loads them, and reports the throughput and the latency of each
+ * stage of loading, as JSON.
+ *
+ * The `.b3dm`, `.pnts`, `.cmpt`, `.glb`, `.terrain`, and `.subtree` files in
+ * the directory and its subdirectories are loaded, cycling through the files
+ * of each type until the given number of tiles of that type have loaded.
+ * Each tile is fetched with a {@link FileAssetAccessor}, gunzipped if it is
+ * gzipped, and then parsed, decoded, and post-processed in a worker thread:
+ *
+ * - Parsing converts the content to glTF, which includes decoding Draco and
+ *   meshopt compressed geometry. Quantized-mesh tiles are decoded here.
+ * - Decoding decodes the embedded images of the glTF.
+ * - Post-processing generates missing normals and computes the bounding
+ *   region, as {@link Cesium3DTilesSelection::TilesetContentOptions} can
+ *   ask for.
+ *
+ * Subtrees are only parsed. Quantized-mesh tiles are assumed to be in the
+ * geographic tiling scheme with two root tiles, and to be stored at paths
+ * ending in `<level>/<x>/<y>.terrain`. Tiles at other paths are decoded as
+ * the western root tile.
+ *
+ * The fetch latency is the time from when a load starts until its data has
+ * been read, so it includes the time the load waits for a worker thread. All
+ * loads start together, so this shows how loads queue as the number of
+ * threads changes.
+ *
+ * @param directory The directory containing the tile content files.
+ * @param tilesPerType The number of tiles of each type to load.
+ * @param threadCounts The numbers of worker threads to load the tiles with,
+ * each of which is a separate run.
+ * @return The exit code of the benchmark.
+ * @throws std::runtime_error If the directory contains no tile content files.
+ */
+int runPipelineBenchmark(
+    const std::filesystem::path& directory,
+    size_t tilesPerType,
+    const std::vector<size_t>& threadCounts);
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,133 @@
+#include "QuantizedMeshBenchmark.h"
+
+#include <Cesium3DTilesContent/QuantizedMeshLoader.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeometry/QuadtreeTilingScheme.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/GeographicProjection.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesContent;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+namespace CesiumNativeBenchmarks {
+namespace {
+uint32_t parseTileCoordinate(const std::filesystem::path& component) {
+  const std::string text = component.string();
+  if (text.empty() ||
+      !std::all_of(text.begin(), text.end(), [](char c) {
+        return c >= '0' && c <= '9';
+      })) {
+    throw std::runtime_error(
+        "Expected a tile coordinate in the tile path, but found \"" + text +
+        "\".");
+  }
+
+  return static_cast<uint32_t>(std::stoul(text));
+}
+} // namespace
+
+QuadtreeTileID parseTerrainTileID(const std::filesystem::path& path) {
+  const std::filesystem::path yPath = path.stem();
+  const std::filesystem::path xPath = path.parent_path().filename();
+  const std::filesystem::path levelPath =
+      path.parent_path().parent_path().filename();
+  return QuadtreeTileID(
+      parseTileCoordinate(levelPath),
+      parseTileCoordinate(xPath),
+      parseTileCoordinate(yPath));
+}
+
+int runQuantizedMeshBenchmark(
+    const std::filesystem::path& path,
+    size_t iterations) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Could not open tile " + path.string());
+  }
+
+  const std::vector<char> contents{
+      std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>()};
+  const gsl::span<const std::byte> data(
+      reinterpret_cast<const std::byte*>(contents.data()),
+      contents.size());
+
+  const QuadtreeTileID tileID = parseTerrainTileID(path);
+  const GeographicProjection projection;
+  const QuadtreeTilingScheme tilingScheme(
+      projection.project(GeographicProjection::MAXIMUM_GLOBE_RECTANGLE),
+      2,
+      1);
+  const BoundingRegion boundingRegion(
+      projection.unproject(tilingScheme.tileToRectangle(tileID)),
+      -1000.0,
+      9000.0);
+
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> times;
+  times.reserve(iterations);
+  size_t vertexCount = 0;
+  for (size_t i = 0; i < iterations; ++i) {
+    const Clock::time_point start = Clock::now();
+    QuantizedMeshLoadResult result = QuantizedMeshLoader::load(
+        tileID,
+        boundingRegion,
+        path.string(),
+        data,
+        false);
+    times.emplace_back(
+        std::chrono::duration<double>(Clock::now() - start).count());
+
+    if (!result.model || result.errors.hasErrors()) {
+      std::fprintf(stderr, "The tile could not be decoded.\n");
+      return 1;
+    }
+
+    const auto positionIt =
+        result.model->meshes[0].primitives[0].attributes.find("POSITION");
+    vertexCount = static_cast<size_t>(
+        result.model->accessors[size_t(positionIt->second)].count);
+  }
+
+  if (times.empty()) {
+    return 0;
+  }
+
+  std::sort(times.begin(), times.end());
+  double total = 0.0;
+  for (double time : times) {
+    total += time;
+  }
+
+  const double milliseconds = 1000.0;
+  std::printf("{\n");
+  std::printf("  \"iterations\": %zu,\n", times.size());
+  std::printf("  \"tileBytes\": %zu,\n", contents.size());
+  std::printf("  \"verticesWithSkirts\": %zu,\n", vertexCount);
+  std::printf("  \"decodeTimeMilliseconds\": {\n");
+  std::printf(
+      "    \"mean\": %.4f,\n",
+      total / static_cast<double>(times.size()) * milliseconds);
+  std::printf(
+      "    \"median\": %.4f,\n",
+      times[times.size() / 2] * milliseconds);
+  std::printf("    \"min\": %.4f\n", times.front() * milliseconds);
+  std::printf("  }\n");
+  std::printf("}\n");
+
+  return 0;
+}
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <CesiumGeometry/QuadtreeTileID.h>
+
+#include <cstddef>
+#include <filesystem>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief Gets the ID of a quantized-mesh terrain tile from its path, which
+ * must end in `<level>/<x>/<y>.terrain`, as layer.json terrain is stored.
+ *
+ * @param path The path of the tile.
+ * @return The ID of the tile.
+ * @throws std::runtime_error If the path doesn't identify a tile.
+ */
+CesiumGeometry::QuadtreeTileID
+parseTerrainTileID(const std::filesystem::path& path);
+
+/**
+ * @brief Decodes a quantized-mesh terrain tile repeatedly, and reports how
+ * long {@link Cesium3DTilesContent::QuantizedMeshLoader::load} takes, as JSON.
+ *
+ * The tile must be stored at a path ending in `<level>/<x>/<y>.terrain`, as
+ * layer.json terrain is, and is assumed to be in the geographic tiling scheme
+ * with two root tiles.
+ *
+ * @param path The path of the tile.
+ * @param iterations The number of times to decode the tile.
+ * @return The exit code of the benchmark.
+ * @throws std::runtime_error If the file cannot be read, or its path doesn't
+ * identify a tile.
+ */
+int runQuantizedMeshBenchmark(
+    const std::filesystem::path& path,
+    size_t iterations);
+
+} // namespace CesiumNativeBenchmarks
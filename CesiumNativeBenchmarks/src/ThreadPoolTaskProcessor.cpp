@@ -0,0 +1,62 @@
+#include "ThreadPoolTaskProcessor.h"
+
+namespace CesiumNativeBenchmarks {
+
+ThreadPoolTaskProcessor::ThreadPoolTaskProcessor(size_t threadCount)
+    : _mutex(), _tasksAvailable(), _tasks(), _stopping(false), _threads() {
+  this->_threads.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; ++i) {
+    this->_threads.emplace_back([this]() { this->_runTasks(); });
+  }
+}
+
+ThreadPoolTaskProcessor::~ThreadPoolTaskProcessor() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_stopping = true;
+  }
+
+  this->_tasksAvailable.notify_all();
+
+  for (std::thread& thread : this->_threads) {
+    thread.join();
+  }
+}
+
+void ThreadPoolTaskProcessor::startTask(std::function<void()> f) {
+  if (this->_threads.empty()) {
+    f();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_tasks.emplace_back(std::move(f));
+  }
+
+  this->_tasksAvailable.notify_one();
+}
+
+void ThreadPoolTaskProcessor::_runTasks() {
+  while (true) {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      this->_tasksAvailable.wait(lock, [this]() {
+        return this->_stopping || !this->_tasks.empty();
+      });
+
+      if (this->_tasks.empty()) {
+        return;
+      }
+
+      task = std::move(this->_tasks.front());
+      this->_tasks.pop_front();
+    }
+
+    task();
+  }
+}
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <CesiumAsync/ITaskProcessor.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief An {@link CesiumAsync::ITaskProcessor} that runs tasks on a fixed
+ * number of threads.
+ *
+ * With zero threads, tasks run immediately in the thread that starts them,
+ * which makes tile loading deterministic.
+ */
+class ThreadPoolTaskProcessor : public CesiumAsync::ITaskProcessor {
+public:
+  /**
+   * @brief Starts the threads.
+   *
+   * @param threadCount The number of threads.
+   */
+  explicit ThreadPoolTaskProcessor(size_t threadCount);
+
+  /**
+   * @brief Finishes the tasks that were already started, and stops the
+   * threads.
+   */
+  virtual ~ThreadPoolTaskProcessor() noexcept override;
+
+  virtual void startTask(std::function<void()> f) override;
+
+private:
+  void _runTasks();
+
+  std::mutex _mutex;
+  std::condition_variable _tasksAvailable;
+  std::deque<std::function<void()>> _tasks;
+  bool _stopping;
+  std::vector<std::thread> _threads;
+};
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,448 @@
+// Replays a recorded camera path against a tileset on the local disk, and
+// reports frame time percentiles, tiles loaded, bytes fetched, and the time
+// it takes to reach full detail at the end of the path, as JSON. When the
+// benchmarks are built with CESIUM_BENCHMARKS_TRACK_ALLOCATIONS, the peak and
+// steady-state memory of the tileset are reported too, as they are by the
+// --parse-json and --blit-image modes.
+//
+// Usage:
+//   cesium-native-benchmarks <tileset.json> <camera-path.json> [options]
+//
+// Options:
+//   --threads <count>   The number of worker threads. With 0, tiles load
+//                       synchronously, which makes runs deterministic.
+//                       Defaults to 4.
+//   --unpaced           Run frames back to back instead of at the frame time
+//                       of the camera path.
+//   --timeout <seconds> How long to wait for full detail after the path.
+//                       Defaults to 60.
+//   --maximum-screen-space-error <pixels>
+//                       See TilesetOptions::maximumScreenSpaceError.
+//
+// It can also time the decoding of a single quantized-mesh terrain tile:
+//   cesium-native-benchmarks --quantized-mesh <level/x/y.terrain>
+//                            [--iterations <count>]
+//
+// Or time the reading of a tileset.json or .gltf file:
+//   cesium-native-benchmarks --parse-json <file> [--iterations <count>]
+//
+// Or time the blits that combine raster overlay images:
+//   cesium-native-benchmarks --blit-image [--iterations <count>]
+//
+// Or time the hot kernels of tile loading and selection, using the test data
+// in the tree:
+//   cesium-native-benchmarks --kernels [--iterations <count>]
+//
+// Or time the continuations of futures:
+//   cesium-native-benchmarks --continuations [--iterations <count>]
+//
+// Or time the loading of the tile content files in a directory, with each of
+// a list of worker thread counts:
+//   cesium-native-benchmarks --pipeline <directory> [--tiles <count>]
+//                            [--threads <count>,<count>,...]
+//
+// Or stress a cache database from many threads:
+//   cesium-native-benchmarks --cache-database <path> [--backend sqlite|memory]
+//                            [--entries <count>] [--threads <count>]
+//                            [--operations <count>]
+
+#include "AllocationTracking.h"
+#include "BenchmarkTimings.h"
+#include "CacheDatabaseBenchmark.h"
+#include "CameraPath.h"
+#include "ContinuationBenchmark.h"
+#include "FileAssetAccessor.h"
+#include "ImageManipulationBenchmark.h"
+#include "JsonParseBenchmark.h"
+#include "KernelBenchmarks.h"
+#include "NullPrepareRendererResources.h"
+#include "PipelineBenchmark.h"
+#include "QuantizedMeshBenchmark.h"
+#include "ThreadPoolTaskProcessor.h"
+
+#include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/TilesetExternals.h>
+#include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <Cesium3DTilesSelection/ViewUpdateResult.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumUtility/CreditSystem.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumNativeBenchmarks;
+using namespace CesiumUtility;
+
+namespace {
+struct BenchmarkOptions {
+  std::string tilesetPath;
+  std::string cameraPathPath;
+  size_t threadCount = 4;
+  bool paced = true;
+  double timeout = 60.0;
+  std::optional<double> maximumScreenSpaceError;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void printUsage() {
+  std::fprintf(
+      stderr,
+      "Usage: cesium-native-benchmarks <tileset.json> <camera-path.json> "
+      "[--threads <count>] [--unpaced] [--timeout <seconds>] "
+      "[--maximum-screen-space-error <pixels>]\n"
+      "       cesium-native-benchmarks --quantized-mesh <level/x/y.terrain> "
+      "[--iterations <count>]\n"
+      "       cesium-native-benchmarks --parse-json <file> "
+      "[--iterations <count>]\n"
+      "       cesium-native-benchmarks --blit-image "
+      "[--iterations <count>]\n"
+      "       cesium-native-benchmarks --kernels "
+      "[--iterations <count>]\n"
+      "       cesium-native-benchmarks --continuations "
+      "[--iterations <count>]\n"
+      "       cesium-native-benchmarks --pipeline <directory> "
+      "[--tiles <count>] [--threads <count>,<count>,...]\n"
+      "       cesium-native-benchmarks --cache-database <path> "
+      "[--backend sqlite|memory] [--entries <count>] [--threads <count>] "
+      "[--operations <count>]\n");
+}
+
+std::optional<BenchmarkOptions> parseArguments(int argc, char** argv) {
+  BenchmarkOptions options;
+  std::vector<std::string> positional;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string argument = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (argument == "--threads" && hasValue) {
+      options.threadCount = std::stoul(argv[++i]);
+    } else if (argument == "--unpaced") {
+      options.paced = false;
+    } else if (argument == "--timeout" && hasValue) {
+      options.timeout = std::stod(argv[++i]);
+    } else if (argument == "--maximum-screen-space-error" && hasValue) {
+      options.maximumScreenSpaceError = std::stod(argv[++i]);
+    } else if (!argument.empty() && argument[0] != '-') {
+      positional.emplace_back(argument);
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  if (positional.size() != 2) {
+    return std::nullopt;
+  }
+
+  options.tilesetPath = positional[0];
+  options.cameraPathPath = positional[1];
+  return options;
+}
+
+// Parses a comma-separated list of counts, such as "1,2,4".
+std::vector<size_t> parseCounts(const std::string& text) {
+  std::vector<size_t> counts;
+  size_t start = 0;
+  while (start <= text.size()) {
+    const size_t end = std::min(text.find(',', start), text.size());
+    counts.emplace_back(std::stoul(text.substr(start, end - start)));
+    start = end + 1;
+  }
+  return counts;
+}
+
+int runCacheDatabase(int argc, char** argv) {
+  CacheDatabaseBenchmarkOptions options;
+  options.databasePath = argv[2];
+  for (int i = 3; i < argc; ++i) {
+    const std::string argument = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (argument == "--backend" && hasValue) {
+      options.backend = argv[++i];
+    } else if (argument == "--entries" && hasValue) {
+      options.entries = std::stoul(argv[++i]);
+    } else if (argument == "--threads" && hasValue) {
+      options.threads = std::stoul(argv[++i]);
+    } else if (argument == "--operations" && hasValue) {
+      options.operations = std::stoul(argv[++i]);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  return runCacheDatabaseBenchmark(options);
+}
+
+int runPipeline(int argc, char** argv) {
+  size_t tilesPerType = 100;
+  std::vector<size_t> threadCounts{1, 2, 4, 8};
+  for (int i = 3; i < argc; ++i) {
+    const std::string argument = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (argument == "--tiles" && hasValue) {
+      tilesPerType = std::stoul(argv[++i]);
+    } else if (argument == "--threads" && hasValue) {
+      threadCounts = parseCounts(argv[++i]);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  return runPipelineBenchmark(argv[2], tilesPerType, threadCounts);
+}
+
+struct TimingTotals {
+  double traversalTime = 0.0;
+  double workerThreadLoadQueueTime = 0.0;
+  double mainThreadLoadQueueTime = 0.0;
+  double unloadCachedTilesTime = 0.0;
+  double lodTransitionTime = 0.0;
+  double rasterOverlayMappingTime = 0.0;
+
+  void add(const ViewUpdateTimings& timings) noexcept {
+    traversalTime += timings.traversalTime;
+    workerThreadLoadQueueTime += timings.workerThreadLoadQueueTime;
+    mainThreadLoadQueueTime += timings.mainThreadLoadQueueTime;
+    unloadCachedTilesTime += timings.unloadCachedTilesTime;
+    lodTransitionTime += timings.lodTransitionTime;
+    rasterOverlayMappingTime += timings.rasterOverlayMappingTime;
+  }
+};
+
+int runBenchmark(const BenchmarkOptions& options) {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  const CameraPath cameraPath = readCameraPath(options.cameraPathPath);
+  if (cameraPath.views.empty()) {
+    std::fprintf(stderr, "The camera path has no frames.\n");
+    return 1;
+  }
+
+  auto pAssetAccessor = std::make_shared<FileAssetAccessor>();
+  auto pTaskProcessor =
+      std::make_shared<ThreadPoolTaskProcessor>(options.threadCount);
+
+  TilesetExternals externals{
+      pAssetAccessor,
+      std::make_shared<NullPrepareRendererResources>(),
+      AsyncSystem(pTaskProcessor),
+      std::make_shared<CreditSystem>()};
+
+  TilesetOptions tilesetOptions;
+  tilesetOptions.enableViewUpdateTimings = true;
+  if (options.maximumScreenSpaceError) {
+    tilesetOptions.maximumScreenSpaceError = *options.maximumScreenSpaceError;
+  }
+
+  std::vector<double> frameTimes;
+  frameTimes.reserve(cameraPath.views.size());
+  TimingTotals totals;
+  int64_t bytesLoaded = 0;
+  std::optional<double> timeToFullDetail;
+  size_t framesToFullDetail = 0;
+  AllocationStatistics memory;
+
+  {
+    const AllocationScope scope;
+    Tileset tileset(
+        externals,
+        FileAssetAccessor::pathToUrl(options.tilesetPath),
+        tilesetOptions);
+
+    const auto frameDuration =
+        std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(cameraPath.frameTime));
+    const float deltaTime = static_cast<float>(cameraPath.frameTime);
+    const Clock::time_point start = Clock::now();
+
+    auto runFrame = [&](const ViewState& view) {
+      const Clock::time_point frameStart = Clock::now();
+      const ViewUpdateResult& result = tileset.updateView({view}, deltaTime);
+      frameTimes.emplace_back(secondsSince(frameStart));
+      totals.add(result.timings);
+      bytesLoaded += result.timings.bytesLoaded;
+
+      if (options.paced) {
+        std::this_thread::sleep_until(frameStart + frameDuration);
+      }
+    };
+
+    for (const ViewState& view : cameraPath.views) {
+      runFrame(view);
+    }
+
+    // Keep rendering the last view until everything it needs has loaded.
+    const ViewState& lastView = cameraPath.views.back();
+    while (secondsSince(start) < options.timeout) {
+      if (tileset.computeLoadProgress() >= 100.0f) {
+        timeToFullDetail = secondsSince(start);
+        break;
+      }
+
+      runFrame(lastView);
+      ++framesToFullDetail;
+    }
+
+    // The tiles that were loaded for the last view are still in memory.
+    memory = scope.getStatistics();
+
+    // Destroy the tileset, which waits for its loads to finish, before the
+    // task processor and asset accessor go away.
+  }
+
+  const size_t frameCount = frameTimes.size();
+  std::vector<double> sorted = frameTimes;
+  std::sort(sorted.begin(), sorted.end());
+
+  const double frames = static_cast<double>(frameCount);
+  const double milliseconds = 1000.0;
+
+  std::printf("{\n");
+  std::printf("  \"frames\": %zu,\n", frameCount);
+  std::printf("  \"framesAfterPath\": %zu,\n", framesToFullDetail);
+  std::printf("  \"frameTimeMilliseconds\": {\n");
+  std::printf("    \"p50\": %.3f,\n", percentile(sorted, 0.5) * milliseconds);
+  std::printf("    \"p90\": %.3f,\n", percentile(sorted, 0.9) * milliseconds);
+  std::printf("    \"p99\": %.3f,\n", percentile(sorted, 0.99) * milliseconds);
+  std::printf("    \"max\": %.3f\n", sorted.back() * milliseconds);
+  std::printf("  },\n");
+  std::printf("  \"averageTimingsMilliseconds\": {\n");
+  std::printf(
+      "    \"traversal\": %.3f,\n",
+      totals.traversalTime / frames * milliseconds);
+  std::printf(
+      "    \"workerThreadLoadQueue\": %.3f,\n",
+      totals.workerThreadLoadQueueTime / frames * milliseconds);
+  std::printf(
+      "    \"mainThreadLoadQueue\": %.3f,\n",
+      totals.mainThreadLoadQueueTime / frames * milliseconds);
+  std::printf(
+      "    \"unloadCachedTiles\": %.3f,\n",
+      totals.unloadCachedTilesTime / frames * milliseconds);
+  std::printf(
+      "    \"lodTransitions\": %.3f,\n",
+      totals.lodTransitionTime / frames * milliseconds);
+  std::printf(
+      "    \"rasterOverlayMapping\": %.3f\n",
+      totals.rasterOverlayMappingTime / frames * milliseconds);
+  std::printf("  },\n");
+  std::printf(
+      "  \"requests\": %lld,\n",
+      static_cast<long long>(pAssetAccessor->getRequestsCompleted()));
+  std::printf(
+      "  \"bytesFetched\": %lld,\n",
+      static_cast<long long>(pAssetAccessor->getBytesFetched()));
+  std::printf(
+      "  \"tileBytesLoaded\": %lld,\n",
+      static_cast<long long>(bytesLoaded));
+  printAllocationStatistics("memory", memory, false);
+  if (timeToFullDetail) {
+    std::printf("  \"timeToFullDetailSeconds\": %.3f\n", *timeToFullDetail);
+  } else {
+    std::printf("  \"timeToFullDetailSeconds\": null\n");
+  }
+  std::printf("}\n");
+
+  return timeToFullDetail ? 0 : 2;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  const bool isBlitImage =
+      argc >= 2 && std::string(argv[1]) == "--blit-image";
+  const bool isKernels = argc >= 2 && std::string(argv[1]) == "--kernels";
+  const bool isContinuations =
+      argc >= 2 && std::string(argv[1]) == "--continuations";
+  if (isBlitImage || isKernels || isContinuations) {
+    size_t iterations = 100;
+    try {
+      if (argc == 4 && std::string(argv[2]) == "--iterations") {
+        iterations = std::stoul(argv[3]);
+      } else if (argc != 2) {
+        printUsage();
+        return 1;
+      }
+
+      if (isKernels) {
+        return runKernelBenchmarks(iterations);
+      }
+      if (isContinuations) {
+        return runContinuationBenchmark(iterations);
+      }
+      return runImageManipulationBenchmark(iterations);
+    } catch (const std::exception& e) {
+      std::fprintf(stderr, "%s\n", e.what());
+      return 1;
+    }
+  }
+
+  const bool isQuantizedMesh =
+      argc >= 3 && std::string(argv[1]) == "--quantized-mesh";
+  const bool isJson = argc >= 3 && std::string(argv[1]) == "--parse-json";
+  if (isQuantizedMesh || isJson) {
+    size_t iterations = 1000;
+    try {
+      if (argc == 5 && std::string(argv[3]) == "--iterations") {
+        iterations = std::stoul(argv[4]);
+      } else if (argc != 3) {
+        printUsage();
+        return 1;
+      }
+
+      return isJson ? runJsonParseBenchmark(argv[2], iterations)
+                    : runQuantizedMeshBenchmark(argv[2], iterations);
+    } catch (const std::exception& e) {
+      std::fprintf(stderr, "%s\n", e.what());
+      return 1;
+    }
+  }
+
+  const bool isPipeline = argc >= 3 && std::string(argv[1]) == "--pipeline";
+  const bool isCacheDatabase =
+      argc >= 3 && std::string(argv[1]) == "--cache-database";
+  if (isPipeline || isCacheDatabase) {
+    try {
+      return isPipeline ? runPipeline(argc, argv)
+                        : runCacheDatabase(argc, argv);
+    } catch (const std::exception& e) {
+      std::fprintf(stderr, "%s\n", e.what());
+      return 1;
+    }
+  }
+
+  std::optional<BenchmarkOptions> options;
+  try {
+    options = parseArguments(argc, argv);
+  } catch (const std::exception&) {
+    options = std::nullopt;
+  }
+
+  if (!options) {
+    printUsage();
+    return 1;
+  }
+
+  try {
+    return runBenchmark(*options);
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+}
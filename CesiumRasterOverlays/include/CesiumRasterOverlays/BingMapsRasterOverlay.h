@@ -9,6 +9,10 @@
 #include <functional>
 #include <memory>
 
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
 namespace CesiumRasterOverlays {
 
 /**
@@ -99,6 +103,9 @@ public:
    * @param ellipsoid The ellipsoid. Default value:
    * {@link CesiumGeospatial::Ellipsoid::WGS84}.
    * @param overlayOptions The {@link RasterOverlayOptions} for this instance.
+   * @param pMetadataCacheDatabase An optional database in which the imagery
+   * metadata is kept for a day, so that later instances with the same URL,
+   * style and key, even in later sessions, do not have to request it again.
    */
   BingMapsRasterOverlay(
       const std::string& name,
@@ -108,7 +115,9 @@ public:
       const std::string& culture = "",
       const CesiumGeospatial::Ellipsoid& ellipsoid =
           CesiumGeospatial::Ellipsoid::WGS84,
-      const RasterOverlayOptions& overlayOptions = {});
+      const RasterOverlayOptions& overlayOptions = {},
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>&
+          pMetadataCacheDatabase = nullptr);
   virtual ~BingMapsRasterOverlay() override;
 
   virtual CesiumAsync::Future<CreateTileProviderResult> createTileProvider(
@@ -129,6 +138,7 @@ private:
   std::string _mapStyle;
   std::string _culture;
   CesiumGeospatial::Ellipsoid _ellipsoid;
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pMetadataCacheDatabase;
 };
 
 } // namespace CesiumRasterOverlays
@@ -3,6 +3,7 @@
 #include "Library.h"
 
 #include <any>
+#include <cstdint>
 
 namespace CesiumGltf {
 struct ImageCesium;
@@ -71,6 +72,27 @@ public:
       const RasterOverlayTile& rasterTile,
       void* pLoadThreadResult,
       void* pMainThreadResult) noexcept = 0;
+
+  /**
+   * @brief Gets the number of bytes of GPU memory used by previously-prepared
+   * renderer resources for a raster overlay tile.
+   *
+   * This method is called from the same thread that called
+   * {@link prepareRasterInMainThread}, right after it returns. The default
+   * implementation reports no GPU memory.
+   *
+   * @param rasterTile The tile that was prepared.
+   * @param pMainThreadResult The result returned by
+   * {@link prepareRasterInMainThread}.
+   * @return The number of bytes of GPU memory.
+   */
+  virtual int64_t getRasterGpuByteSize(
+      const RasterOverlayTile& rasterTile,
+      void* pMainThreadResult) const noexcept {
+    (void)rasterTile;
+    (void)pMainThreadResult;
+    return 0;
+  }
 };
 
 } // namespace CesiumRasterOverlays
@@ -9,6 +9,10 @@
 #include <functional>
 #include <memory>
 
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
 namespace CesiumRasterOverlays {
 
 /**
@@ -27,13 +31,21 @@ public:
    * @param ionAssetID The asset ID.
    * @param ionAccessToken The access token.
    * @param overlayOptions The {@link RasterOverlayOptions} for this instance.
+   * @param ionAssetEndpointUrl The URL of the Cesium ion API.
+   * @param pEndpointCacheDatabase An optional database in which the asset
+   * endpoint is kept until its access token expires, so that later instances
+   * for the same asset, even in later sessions, do not have to wait for the
+   * endpoint request. The metadata of the Bing Maps or tile map service
+   * overlay that the endpoint refers to is kept in it as well.
    */
   IonRasterOverlay(
       const std::string& name,
       int64_t ionAssetID,
       const std::string& ionAccessToken,
       const RasterOverlayOptions& overlayOptions = {},
-      const std::string& ionAssetEndpointUrl = "https://api.cesium.com/");
+      const std::string& ionAssetEndpointUrl = "https://api.cesium.com/",
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>&
+          pEndpointCacheDatabase = nullptr);
   virtual ~IonRasterOverlay() override;
 
   virtual CesiumAsync::Future<CreateTileProviderResult> createTileProvider(
@@ -50,6 +62,7 @@ private:
   int64_t _ionAssetID;
   std::string _ionAccessToken;
   std::string _ionAssetEndpointUrl;
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pEndpointCacheDatabase;
 
   struct AssetEndpointAttribution {
     std::string html;
@@ -68,6 +81,22 @@ private:
 
   static std::unordered_map<std::string, ExternalAssetEndpoint> endpointCache;
 
+  static nonstd::
+      expected<ExternalAssetEndpoint, RasterOverlayLoadFailureDetails>
+      parseEndpoint(
+          std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest,
+          const gsl::span<const std::byte>& data);
+
+  CesiumAsync::Future<CreateTileProviderResult> requestEndpoint(
+      const std::string& ionUrl,
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+      const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      CesiumUtility::IntrusivePointer<const RasterOverlay> pOwner) const;
+
   CesiumAsync::Future<CreateTileProviderResult> createTileProvider(
       const ExternalAssetEndpoint& endpoint,
       const CesiumAsync::AsyncSystem& asyncSystem,
@@ -10,9 +10,11 @@
 #include <CesiumGeometry/QuadtreeTilingScheme.h>
 #include <CesiumUtility/CreditSystem.h>
 
-#include <list>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <vector>
 
 namespace CesiumRasterOverlays {
 
@@ -83,6 +85,23 @@ public:
     return this->_tilingScheme;
   }
 
+  /**
+   * @brief Gets the number of bytes of the quadtree tile images that are
+   * cached to create raster overlay tiles from.
+   */
+  virtual int64_t getCachedDataBytes() const noexcept override {
+    return this->_cachedBytes;
+  }
+
+  /**
+   * @brief Releases the cached quadtree tile images that have finished
+   * loading.
+   *
+   * Images that are still used by raster overlay tiles are only released
+   * once those are.
+   */
+  virtual int64_t trimCachedData() override;
+
   /**
    * @brief Computes the best quadtree level to use for an image intended to
    * cover a given projected rectangle when it is a given size on the screen.
@@ -135,6 +154,7 @@ private:
       const glm::dvec2 targetScreenPixels);
 
   void unloadCachedTiles();
+  void unloadCachedTiles(int64_t maxCacheBytes);
 
   struct CombinedImageMeasurements {
     CesiumGeometry::Rectangle rectangle;
@@ -159,21 +179,46 @@ private:
   uint32_t _imageHeight;
   CesiumGeometry::QuadtreeTilingScheme _tilingScheme;
 
+  // The cached quadtree tiles are kept in a pool of entries that are reused
+  // once they are evicted, linked by index into a least recently used list.
+  // They are found through an open-addressing hash table of entry indices,
+  // so that neither caching nor using a tile allocates.
+  static constexpr uint32_t NoCacheEntry = UINT32_MAX;
+
   struct CacheEntry {
-    CesiumGeometry::QuadtreeTileID tileID;
-    CesiumAsync::SharedFuture<LoadedQuadtreeImage> future;
-  };
+    CesiumGeometry::QuadtreeTileID tileID{0, 0, 0};
+    std::optional<CesiumAsync::SharedFuture<LoadedQuadtreeImage>> future;
 
-  // Tiles at the beginning of this list are the least recently used (oldest),
-  // while the tiles at the end are most recently used (newest).
-  using TileLeastRecentlyUsedList = std::list<CacheEntry>;
-  TileLeastRecentlyUsedList _tilesOldToRecent;
+    // The next older and newer entries in the least recently used list. Free
+    // entries are chained through their newer entry.
+    uint32_t older = NoCacheEntry;
+    uint32_t newer = NoCacheEntry;
+  };
 
-  // Allows a Future to be looked up by quadtree tile ID.
-  std::unordered_map<
-      CesiumGeometry::QuadtreeTileID,
-      TileLeastRecentlyUsedList::iterator>
-      _tileLookup;
+  uint32_t findCacheEntry(const CesiumGeometry::QuadtreeTileID& tileID) const;
+  uint32_t countUncachedTiles(
+      const CesiumGeometry::QuadtreeTileID& southwest,
+      const CesiumGeometry::QuadtreeTileID& northeast) const;
+  uint32_t addCacheEntry(
+      const CesiumGeometry::QuadtreeTileID& tileID,
+      CesiumAsync::SharedFuture<LoadedQuadtreeImage>&& future);
+  void removeCacheEntry(uint32_t entry);
+  void linkNewestCacheEntry(uint32_t entry) noexcept;
+  void unlinkCacheEntry(uint32_t entry) noexcept;
+  size_t getCacheHomeSlot(
+      const CesiumGeometry::QuadtreeTileID& tileID) const noexcept;
+
+  std::vector<CacheEntry> _cacheEntries;
+  uint32_t _freeCacheEntry;
+
+  // The least recently used (oldest) and most recently used (newest)
+  // entries.
+  uint32_t _oldestCacheEntry;
+  uint32_t _newestCacheEntry;
+
+  // The hash table, whose size is a power of two, of entry indices.
+  std::vector<uint32_t> _cacheSlots;
+  size_t _cachedTileCount;
 
   std::atomic<int64_t> _cachedBytes;
 };
@@ -6,7 +6,7 @@
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumGltf/Ktx2TranscodeTargets.h>
 #include <CesiumUtility/IntrusivePointer.h>
-#include <CesiumUtility/ReferenceCountedNonThreadSafe.h>
+#include <CesiumUtility/ReferenceCountedThreadSafe.h>
 
 #include <nonstd/expected.hpp>
 #include <spdlog/fwd.h>
@@ -16,6 +16,12 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class AdaptiveConcurrencyLimiter;
+class BandwidthLimiter;
+}
 
 namespace CesiumUtility {
 struct Credit;
@@ -37,6 +43,37 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayOptions {
    */
   int32_t maximumSimultaneousTileLoads = 20;
 
+  /**
+   * @brief A limiter that caps the rate at which overlay tiles are
+   * downloaded.
+   *
+   * While the limiter is exhausted, throttled overlay tile loads wait as if
+   * {@link maximumSimultaneousTileLoads} were reached. The limiter only learns
+   * about the downloaded bytes from a
+   * {@link CesiumAsync::BandwidthLimitingAssetAccessor} that uses it, which
+   * should be, or be decorated by, the accessor that the overlay's tiles are
+   * requested with. Give it the same limiter as the tileset's, to cap their
+   * combined rate.
+   *
+   * If not specified, the downloads are not limited.
+   */
+  std::shared_ptr<CesiumAsync::BandwidthLimiter> pBandwidthLimiter;
+
+  /**
+   * @brief A limiter that adjusts the number of overlay tiles that may
+   * simultaneously be in the process of loading, in place of
+   * {@link maximumSimultaneousTileLoads}.
+   *
+   * Every overlay tile load tells the limiter how long it took, how many
+   * bytes of pixels it loaded, and whether it failed. Give each overlay its
+   * own limiter, unless their tiles come from the same server. The limit in
+   * effect is reported by
+   * {@link RasterOverlayTileProvider::getMaximumSimultaneousTileLoads}.
+   *
+   * If not specified, the fixed limit is used.
+   */
+  std::shared_ptr<CesiumAsync::AdaptiveConcurrencyLimiter> pConcurrencyLimiter;
+
   /**
    * @brief The maximum number of bytes to use to cache sub-tiles in memory.
    *
@@ -63,6 +100,30 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayOptions {
    */
   int32_t maximumTextureSize = 2048;
 
+  /**
+   * @brief The maximum number of sub-tiles that may need to be loaded to
+   * create a single raster overlay tile, or 0 for no limit.
+   *
+   * This is used by {@link QuadtreeRasterOverlayTileProvider}. Sub-tiles that
+   * are already in the sub-tile cache described by {@link subTileCacheBytes}
+   * are not counted. When more sub-tiles would need to be loaded at the level
+   * chosen for a geometry tile, the level is reduced one at a time, down to
+   * the provider's minimum level, until they are few enough. A geometry tile
+   * just past a level boundary then uses slightly less detail instead of
+   * requesting many more sub-tiles at once.
+   */
+  int32_t maximumSubTileLoadsPerTile = 0;
+
+  /**
+   * @brief The maximum number of bytes of sub-tiles that may need to be loaded
+   * to create a single raster overlay tile, or 0 for no limit.
+   *
+   * This works like {@link maximumSubTileLoadsPerTile}, with each sub-tile
+   * that is not cached estimated to take the number of bytes of an
+   * uncompressed four-channel image of the provider's tile size.
+   */
+  int64_t maximumSubTileBytesPerTile = 0;
+
   /**
    * @brief The maximum number of pixels of error when rendering this overlay.
    * This is used to select an appropriate level-of-detail.
@@ -79,6 +140,28 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayOptions {
    */
   CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets;
 
+  /**
+   * @brief The GPU block compression formats to which the images created by
+   * this overlay may be encoded, which reduces the GPU memory they use by four
+   * to eight times.
+   *
+   * When any of the formats that can be encoded is supported, each image is
+   * given mipmaps, because renderers can't generate mipmaps for compressed
+   * textures, and then encoded in a worker thread before it is passed to
+   * {@link IPrepareRasterOverlayRendererResources::prepareRasterInLoadThread}.
+   * Images with four channels are encoded to `BC1_RGB` if they are opaque and
+   * to `BC3_RGBA` otherwise, images with three channels to `BC1_RGB`, images
+   * with two channels to `BC5_RG`, and images with one channel, such as
+   * polygon masks, to `BC4_R`. Images are left uncompressed when the format
+   * for them isn't supported.
+   *
+   * Only these BC formats can be encoded; the others are ignored. By default,
+   * none are supported, and images are not compressed.
+   *
+   * @see CesiumGltfContent::ImageManipulation::compressImage
+   */
+  CesiumGltf::SupportedGpuCompressedPixelFormats gpuCompressedPixelFormats;
+
   /**
    * @brief A callback function that is invoked when a raster overlay resource
    * fails to load.
@@ -125,7 +208,7 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayOptions {
  * @see WebMapServiceRasterOverlay
  */
 class RasterOverlay
-    : public CesiumUtility::ReferenceCountedNonThreadSafe<RasterOverlay> {
+    : public CesiumUtility::ReferenceCountedThreadSafe<RasterOverlay> {
 public:
   /**
    * @brief Creates a new instance.
@@ -223,6 +306,72 @@ public:
       const std::shared_ptr<spdlog::logger>& pLogger,
       CesiumUtility::IntrusivePointer<const RasterOverlay> pOwner) const = 0;
 
+  /**
+   * @brief Gets a tile provider for this overlay that is shared by everything
+   * that uses this overlay with the same parameters, creating it with
+   * {@link createTileProvider} if it doesn't exist yet.
+   *
+   * This allows the same overlay instance to be added to the
+   * {@link RasterOverlayCollection} of several tilesets, such as terrain and
+   * buildings that are draped with the same imagery, while its tiles are
+   * requested, decoded, and cached only once. Each tileset maps its own
+   * {@link RasterOverlayTile} instances from the shared provider, and reports
+   * the provider's memory usage as its own.
+   *
+   * Errors creating the tile provider are logged, and passed to
+   * {@link RasterOverlayOptions::loadErrorCallback}, once.
+   *
+   * Every call must be balanced by a call to
+   * {@link releaseSharedTileProvider} with the same parameters. The tile
+   * provider refers to this overlay, so this overlay is kept alive until it
+   * has been released as many times as it was acquired.
+   *
+   * @param asyncSystem The async system used to do work in threads.
+   * @param pAssetAccessor The interface used to download assets like overlay
+   * metadata and tiles.
+   * @param pCreditSystem The {@link CreditSystem} to use when creating a
+   * per-TileProvider {@link Credit}.
+   * @param pPrepareRendererResources The interface used to prepare raster
+   * images for rendering.
+   * @param pLogger The logger to which to send messages about the tile provider
+   * and tiles.
+   * @return The future that resolves to the tile provider when it is ready, or
+   * to error details in the case of an error.
+   */
+  CesiumAsync::SharedFuture<CreateTileProviderResult> acquireSharedTileProvider(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+      const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger);
+
+  /**
+   * @brief Releases a tile provider acquired with
+   * {@link acquireSharedTileProvider}.
+   *
+   * When it has been released as many times as it was acquired, this overlay
+   * no longer refers to it, and it is destroyed once nothing else refers to it
+   * either.
+   *
+   * @param asyncSystem The async system given to
+   * {@link acquireSharedTileProvider}.
+   * @param pAssetAccessor The asset accessor given to
+   * {@link acquireSharedTileProvider}.
+   * @param pCreditSystem The credit system given to
+   * {@link acquireSharedTileProvider}.
+   * @param pPrepareRendererResources The interface given to
+   * {@link acquireSharedTileProvider}.
+   * @param pLogger The logger given to {@link acquireSharedTileProvider}.
+   */
+  void releaseSharedTileProvider(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+      const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger) noexcept;
+
 private:
   struct DestructionCompleteDetails {
     CesiumAsync::AsyncSystem asyncSystem;
@@ -230,10 +379,30 @@ private:
     CesiumAsync::SharedFuture<void> future;
   };
 
+  struct SharedTileProvider {
+    CesiumAsync::AsyncSystem asyncSystem;
+    std::shared_ptr<CesiumAsync::IAssetAccessor> pAssetAccessor;
+    std::shared_ptr<CesiumUtility::CreditSystem> pCreditSystem;
+    std::shared_ptr<IPrepareRasterOverlayRendererResources>
+        pPrepareRendererResources;
+    std::shared_ptr<spdlog::logger> pLogger;
+    CesiumAsync::SharedFuture<CreateTileProviderResult> future;
+    size_t users;
+  };
+
+  std::vector<SharedTileProvider>::iterator findSharedTileProvider(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+      const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger) noexcept;
+
   std::string _name;
   RasterOverlayOptions _options;
   std::vector<CesiumUtility::Credit> _credits;
   std::optional<DestructionCompleteDetails> _destructionCompleteDetails;
+  std::vector<SharedTileProvider> _sharedTileProviders;
 };
 
 } // namespace CesiumRasterOverlays
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Library.h"
+
+#include <CesiumGeometry/Rectangle.h>
+#include <CesiumGltf/ImageCesium.h>
+
+#include <vector>
+
+namespace CesiumRasterOverlays {
+
+/**
+ * @brief Several raster overlay images packed into a single image.
+ *
+ * Created by {@link RasterOverlayUtilities::createAtlas}.
+ */
+struct CESIUMRASTEROVERLAYS_API RasterOverlayAtlas {
+  /**
+   * @brief The image containing all the packed images.
+   *
+   * Each packed image is surrounded by copies of its edge pixels so that
+   * filtering near its edges does not blend in its neighbors. The image has
+   * no mipmaps.
+   */
+  CesiumGltf::ImageCesium image;
+
+  /**
+   * @brief The region of {@link image} covered by each packed image, in the
+   * order the images were given.
+   *
+   * The regions are in texture coordinates, following the convention of
+   * raster overlay images: (0.0, 0.0) is the south-west corner of the atlas,
+   * which is the first pixel of its last row in memory, and (1.0, 1.0) is the
+   * north-east corner.
+   */
+  std::vector<CesiumGeometry::Rectangle> regions;
+};
+
+} // namespace CesiumRasterOverlays
@@ -2,11 +2,13 @@
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/ITaskProcessor.h>
 #include <CesiumGeometry/Rectangle.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumUtility/IntrusivePointer.h>
-#include <CesiumUtility/ReferenceCountedNonThreadSafe.h>
+#include <CesiumUtility/ReferenceCountedThreadSafe.h>
 
+#include <optional>
 #include <vector>
 
 namespace CesiumUtility {
@@ -30,7 +32,7 @@ class RasterOverlayTileProvider;
  * image on the geometry of a {@link Tile}.
  */
 class RasterOverlayTile final
-    : public CesiumUtility::ReferenceCountedNonThreadSafe<RasterOverlayTile> {
+    : public CesiumUtility::ReferenceCountedThreadSafe<RasterOverlayTile> {
 public:
   /**
    * @brief Lifecycle states of a raster overlay tile.
@@ -233,6 +235,13 @@ public:
     this->_pRendererResources = pValue;
   }
 
+  /**
+   * @brief Returns the number of bytes of GPU memory used by the renderer
+   * resources of this tile, as reported by
+   * {@link IPrepareRasterOverlayRendererResources::getRasterGpuByteSize}.
+   */
+  int64_t getGpuByteSize() const noexcept { return this->_gpuByteSize; }
+
   /**
    * @brief Determines if more detailed data is available for the spatial area
    * covered by this tile.
@@ -258,6 +267,12 @@ private:
   LoadState _state;
   CesiumGltf::ImageCesium _image;
   void* _pRendererResources;
+  int64_t _gpuByteSize;
   MoreDetailAvailable _moreDetailAvailable;
+
+  // The priority of the most recent throttled load of this tile that was
+  // deferred because too many loads were in progress, or std::nullopt if the
+  // tile is not waiting for a throttled load.
+  std::optional<CesiumAsync::TaskPriority> _pendingLoadPriority;
 };
 } // namespace CesiumRasterOverlays
@@ -3,17 +3,19 @@
 #include "Library.h"
 
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/ITaskProcessor.h>
 #include <CesiumGeospatial/Projection.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumUtility/CreditSystem.h>
 #include <CesiumUtility/IntrusivePointer.h>
-#include <CesiumUtility/ReferenceCountedNonThreadSafe.h>
+#include <CesiumUtility/ReferenceCountedThreadSafe.h>
 #include <CesiumUtility/Tracing.h>
 
 #include <spdlog/fwd.h>
 
 #include <cassert>
 #include <optional>
+#include <vector>
 
 namespace CesiumRasterOverlays {
 
@@ -133,7 +135,7 @@ struct TileProviderAndTile {
  * must be managed with {@link CesiumUtility::IntrusivePointer}.
  */
 class CESIUMRASTEROVERLAYS_API RasterOverlayTileProvider
-    : public CesiumUtility::ReferenceCountedNonThreadSafe<
+    : public CesiumUtility::ReferenceCountedThreadSafe<
           RasterOverlayTileProvider> {
 public:
   /**
@@ -281,11 +283,51 @@ public:
       const CesiumGeometry::Rectangle& rectangle,
       const glm::dvec2& targetScreenPixels);
 
+  /**
+   * @brief Gets the number of channels of the images of this provider's
+   * tiles, or 0 if they keep the channels they were loaded with.
+   *
+   * Providers of single-channel data, such as masks, declare this with
+   * {@link setOutputChannels}, so that the images they load with more channels
+   * are stored and passed to
+   * {@link IPrepareRasterOverlayRendererResources::prepareRasterInLoadThread}
+   * with only the channels they use. The number of channels of each tile's
+   * image is given by its {@link CesiumGltf::ImageCesium::channels}.
+   */
+  int32_t getOutputChannels() const noexcept { return this->_outputChannels; }
+
   /**
    * @brief Gets the number of bytes of tile data that are currently loaded.
    */
   int64_t getTileDataBytes() const noexcept { return this->_tileDataBytes; }
 
+  /**
+   * @brief Gets the number of bytes of source images that are kept in a
+   * cache to create tiles from, and are not included in
+   * {@link getTileDataBytes}.
+   *
+   * The default implementation returns zero.
+   */
+  virtual int64_t getCachedDataBytes() const noexcept;
+
+  /**
+   * @brief Releases the source images that are kept in a cache to create
+   * tiles from, other than those that are still loading.
+   *
+   * The default implementation releases nothing.
+   *
+   * @return The number of bytes released, as counted by
+   * {@link getCachedDataBytes}.
+   */
+  virtual int64_t trimCachedData();
+
+  /**
+   * @brief Gets the number of bytes of GPU memory used by the renderer
+   * resources of the tiles that are currently loaded, as reported by
+   * {@link IPrepareRasterOverlayRendererResources::getRasterGpuByteSize}.
+   */
+  int64_t getTileGpuBytes() const noexcept { return this->_tileGpuBytes; }
+
   /**
    * @brief Returns the number of tiles that are currently loading.
    */
@@ -347,12 +389,34 @@ public:
    * {@link RasterOverlayOptions::maximumSimultaneousTileLoads} property of
    * {@link RasterOverlay::getOptions}.
    *
+   * A tile that could not be loaded because too many loads were in flight is
+   * remembered, along with its priority. When a throttled load completes, the
+   * freed slot goes to the remembered tile with the highest priority, so
+   * overlay tiles for the most important geometry tiles load first, without
+   * waiting for the next call to this method. A remembered tile is forgotten
+   * once nothing else references it. Calling this method again for a tile that
+   * is waiting updates its priority.
+   *
    * @param tile The tile to load.
+   * @param priority The priority of the load, usually the priority of the
+   * geometry tile that the overlay tile is mapped to.
    * @returns True if the tile load process is started or is already complete,
    * false if the load could not be started because too many loads are already
    * in progress.
    */
-  bool loadTileThrottled(RasterOverlayTile& tile);
+  bool loadTileThrottled(
+      RasterOverlayTile& tile,
+      const CesiumAsync::TaskPriority& priority = {});
+
+  /**
+   * @brief Gets the number of throttled tile loads that may currently be in
+   * progress at once.
+   *
+   * This is the limit of the {@link RasterOverlayOptions::pConcurrencyLimiter}
+   * of {@link RasterOverlay::getOptions} if there is one, or else its
+   * {@link RasterOverlayOptions::maximumSimultaneousTileLoads}.
+   */
+  int32_t getMaximumSimultaneousTileLoads() const noexcept;
 
 protected:
   /**
@@ -364,6 +428,24 @@ protected:
   virtual CesiumAsync::Future<LoadedRasterOverlayImage>
   loadTileImage(RasterOverlayTile& overlayTile) = 0;
 
+  /**
+   * @brief Declares the number of channels of the images of this provider's
+   * tiles.
+   *
+   * Images returned by {@link loadTileImage} with more channels than this,
+   * such as images decoded as RGBA that only carry data in their red channel,
+   * are reduced to their first channels in a worker thread, with
+   * {@link CesiumGltfContent::ImageManipulation::truncateChannels}, before
+   * they are prepared for rendering. Images with fewer channels are left
+   * as they are.
+   *
+   * @param channels The number of channels, from 1 to 4, or 0 to keep the
+   * channels that images are loaded with.
+   */
+  void setOutputChannels(int32_t channels) noexcept {
+    this->_outputChannels = channels;
+  }
+
   /**
    * @brief Loads an image from a URL and optionally some request headers.
    *
@@ -380,6 +462,8 @@ protected:
       LoadTileImageFromUrlOptions&& options = {}) const;
 
 private:
+  friend class RasterOverlayTile;
+
   CesiumAsync::Future<TileProviderAndTile>
   doLoad(RasterOverlayTile& tile, bool isThrottledLoad);
 
@@ -396,11 +480,25 @@ private:
    * @brief Finalizes loading of a tile.
    *
    * This method should be called at the end of the tile load process,
-   * no matter whether the load succeeded or failed.
+   * no matter whether the load succeeded or failed. If the load was
+   * throttled, it starts loading the waiting tiles with the highest priority.
    *
    * @param isThrottledLoad True if the load was originally throttled.
    */
-  void finalizeTileLoad(bool isThrottledLoad) noexcept;
+  void finalizeTileLoad(bool isThrottledLoad);
+
+  /**
+   * @brief Starts throttled loads of the waiting tiles, by priority, until
+   * the maximum number of simultaneous loads is reached.
+   */
+  void loadPendingTiles();
+
+  /**
+   * @brief Determines whether the owner's
+   * {@link RasterOverlayOptions::pBandwidthLimiter} is exhausted, so that no
+   * throttled loads may start.
+   */
+  bool isBandwidthExhausted() const noexcept;
 
 private:
   CesiumUtility::IntrusivePointer<RasterOverlay> _pOwner;
@@ -414,8 +512,12 @@ private:
   CesiumGeometry::Rectangle _coverageRectangle;
   CesiumUtility::IntrusivePointer<RasterOverlayTile> _pPlaceholder;
   int64_t _tileDataBytes;
+  int64_t _tileGpuBytes;
   int32_t _totalTilesCurrentlyLoading;
   int32_t _throttledTilesCurrentlyLoading;
+  int32_t _outputChannels;
+  std::vector<CesiumUtility::IntrusivePointer<RasterOverlayTile>>
+      _pendingTiles;
   CESIUM_TRACE_DECLARE_TRACK_SET(
       _loadingSlots,
       "Raster Overlay Tile Loading Slot");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Library.h"
+#include "RasterOverlayAtlas.h"
 #include "RasterOverlayDetails.h"
 
 #include <CesiumGeospatial/Ellipsoid.h>
@@ -132,6 +133,41 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayUtilities {
   static glm::dvec4 computeTranslationAndScale(
       const CesiumGeometry::Rectangle& geometryRectangle,
       const CesiumGeometry::Rectangle& overlayRectangle);
+
+  /**
+   * @brief Packs raster overlay images into a single atlas image.
+   *
+   * The images are placed in rows, tallest first, in an atlas that is about
+   * as wide as it is tall. Only the first mip level of each image is copied.
+   *
+   * @param images The images to pack. They must all be uncompressed and have
+   * the same number of channels and bytes per channel.
+   * @param padding The number of pixels around each image that are filled
+   * with copies of its edge pixels.
+   * @param maximumSize The largest width and height of the atlas.
+   * @return The atlas, or std::nullopt if there are no images, if the images
+   * can not be combined in one image, or if they do not fit in an atlas of
+   * the maximum size.
+   */
+  static std::optional<RasterOverlayAtlas> createAtlas(
+      const std::vector<const CesiumGltf::ImageCesium*>& images,
+      int32_t padding = 1,
+      int32_t maximumSize = 4096);
+
+  /**
+   * @brief Adjusts the texture translation and scale of a raster overlay
+   * image so that it samples the image's region of an atlas instead.
+   *
+   * @param translationAndScale The translation in X and Y, and the scale in Z
+   * and W, as computed by {@link computeTranslationAndScale}.
+   * @param region The region of the image in the atlas, from
+   * {@link RasterOverlayAtlas::regions}.
+   * @return The translation in X and Y, and the scale in Z and W, to use with
+   * the atlas.
+   */
+  static glm::dvec4 computeAtlasTranslationAndScale(
+      const glm::dvec4& translationAndScale,
+      const CesiumGeometry::Rectangle& region);
 };
 
 } // namespace CesiumRasterOverlays
@@ -6,6 +6,7 @@
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/CartographicPolygonIndex.h>
 #include <CesiumGeospatial/Ellipsoid.h>
 #include <CesiumGeospatial/Projection.h>
 
@@ -42,13 +43,23 @@ public:
 
   const std::vector<CesiumGeospatial::CartographicPolygon>&
   getPolygons() const noexcept {
-    return this->_polygons;
+    return this->_pPolygonIndex->getPolygons();
+  }
+
+  /**
+   * @brief Gets the spatial index of the polygons, which is built when the
+   * overlay is constructed.
+   */
+  const CesiumGeospatial::CartographicPolygonIndex&
+  getPolygonIndex() const noexcept {
+    return *this->_pPolygonIndex;
   }
 
   bool getInvertSelection() const noexcept { return this->_invertSelection; }
 
 private:
-  std::vector<CesiumGeospatial::CartographicPolygon> _polygons;
+  std::shared_ptr<const CesiumGeospatial::CartographicPolygonIndex>
+      _pPolygonIndex;
   bool _invertSelection;
   CesiumGeospatial::Ellipsoid _ellipsoid;
   CesiumGeospatial::Projection _projection;
@@ -12,6 +12,10 @@
 #include <functional>
 #include <memory>
 
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
 namespace CesiumRasterOverlays {
 
 /**
@@ -106,13 +110,18 @@ public:
    * form (Key,Value) that will be inserted as request headers internally.
    * @param tmsOptions The {@link TileMapServiceRasterOverlayOptions}.
    * @param overlayOptions The {@link RasterOverlayOptions} for this instance.
+   * @param pMetadataCacheDatabase An optional database in which the tile map
+   * resource XML document is kept for a day, so that later instances with the
+   * same URL, even in later sessions, do not have to request it again.
    */
   TileMapServiceRasterOverlay(
       const std::string& name,
       const std::string& url,
       const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers = {},
       const TileMapServiceRasterOverlayOptions& tmsOptions = {},
-      const RasterOverlayOptions& overlayOptions = {});
+      const RasterOverlayOptions& overlayOptions = {},
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>&
+          pMetadataCacheDatabase = nullptr);
   virtual ~TileMapServiceRasterOverlay() override;
 
   virtual CesiumAsync::Future<CreateTileProviderResult> createTileProvider(
@@ -129,6 +138,7 @@ private:
   std::string _url;
   std::vector<CesiumAsync::IAssetAccessor::THeader> _headers;
   TileMapServiceRasterOverlayOptions _options;
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pMetadataCacheDatabase;
 };
 
 } // namespace CesiumRasterOverlays
@@ -11,6 +11,10 @@
 
 #include <memory>
 
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
 namespace CesiumRasterOverlays {
 
 /**
@@ -62,6 +66,20 @@ struct WebMapServiceRasterOverlayOptions {
    * @brief Pixel height of image tiles.
    */
   int32_t tileHeight = 256;
+
+  /**
+   * @brief The number of tiles along each axis that are requested from the
+   * server with a single GetMap request.
+   *
+   * When this is greater than 1, the image of an aligned block of
+   * `requestTilesPerAxis` x `requestTilesPerAxis` tiles is requested once and
+   * split into the images of its tiles locally, which divides the number of
+   * requests by up to the number of tiles in a block. The server must accept
+   * images of `requestTilesPerAxis` times the tile width and height. Blocks
+   * that would extend past the edge of the tiling scheme, such as at the
+   * lowest levels, are requested one tile at a time.
+   */
+  int32_t requestTilesPerAxis = 1;
 };
 
 /**
@@ -79,13 +97,18 @@ public:
    * form (Key,Value) that will be inserted as request headers internally.
    * @param wmsOptions The {@link WebMapServiceRasterOverlayOptions}.
    * @param overlayOptions The {@link RasterOverlayOptions} for this instance.
+   * @param pMetadataCacheDatabase An optional database in which the server's
+   * capabilities are kept for a day, so that later instances with the same URL
+   * and version, even in later sessions, do not have to request them again.
    */
   WebMapServiceRasterOverlay(
       const std::string& name,
       const std::string& url,
       const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers = {},
       const WebMapServiceRasterOverlayOptions& wmsOptions = {},
-      const RasterOverlayOptions& overlayOptions = {});
+      const RasterOverlayOptions& overlayOptions = {},
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>&
+          pMetadataCacheDatabase = nullptr);
   virtual ~WebMapServiceRasterOverlay() override;
 
   virtual CesiumAsync::Future<CreateTileProviderResult> createTileProvider(
@@ -102,6 +125,7 @@ private:
   std::string _baseUrl;
   std::vector<CesiumAsync::IAssetAccessor::THeader> _headers;
   WebMapServiceRasterOverlayOptions _options;
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pMetadataCacheDatabase;
 };
 
 } // namespace CesiumRasterOverlays
@@ -1,3 +1,5 @@
+#include "RasterOverlayMetadataCache.h"
+
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
@@ -229,13 +231,15 @@ BingMapsRasterOverlay::BingMapsRasterOverlay(
     const std::string& mapStyle,
     const std::string& culture,
     const Ellipsoid& ellipsoid,
-    const RasterOverlayOptions& overlayOptions)
+    const RasterOverlayOptions& overlayOptions,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pMetadataCacheDatabase)
     : RasterOverlay(name, overlayOptions),
       _url(url),
       _key(key),
       _mapStyle(mapStyle),
       _culture(culture),
-      _ellipsoid(ellipsoid) {}
+      _ellipsoid(ellipsoid),
+      _pMetadataCacheDatabase(pMetadataCacheDatabase) {}
 
 BingMapsRasterOverlay::~BingMapsRasterOverlay() {}
 
@@ -445,32 +449,69 @@ BingMapsRasterOverlay::createTileProvider(
         handleResponse(nullptr, gsl::span<std::byte>(cacheResultIt->second)));
   }
 
-  return pAssetAccessor->get(asyncSystem, metadataUrl)
-      .thenInMainThread(
-          [metadataUrl,
-           handleResponse](std::shared_ptr<IAssetRequest>&& pRequest)
-              -> CreateTileProviderResult {
-            const IAssetResponse* pResponse = pRequest->response();
-
-            if (pResponse == nullptr) {
-              return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
-                  RasterOverlayLoadType::TileProvider,
-                  pRequest,
-                  "No response received from Bing Maps imagery metadata "
-                  "service."});
-            }
+  auto requestMetadata = [asyncSystem,
+                          pAssetAccessor,
+                          pCacheDatabase = this->_pMetadataCacheDatabase,
+                          metadataUrl,
+                          handleResponse]() {
+    return pAssetAccessor->get(asyncSystem, metadataUrl)
+        .thenInMainThread(
+            [asyncSystem, pCacheDatabase, metadataUrl, handleResponse](
+                std::shared_ptr<IAssetRequest>&& pRequest)
+                -> CreateTileProviderResult {
+              const IAssetResponse* pResponse = pRequest->response();
+
+              if (pResponse == nullptr) {
+                return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+                    RasterOverlayLoadType::TileProvider,
+                    pRequest,
+                    "No response received from Bing Maps imagery metadata "
+                    "service."});
+              }
+
+              CreateTileProviderResult handleResponseResult =
+                  handleResponse(pRequest, pResponse->data());
+
+              // If the response successfully created a tile provider, cache
+              // it.
+              if (handleResponseResult) {
+                sessionCache[metadataUrl] = std::vector<std::byte>(
+                    pResponse->data().begin(),
+                    pResponse->data().end());
+                storeCachedMetadata(
+                    asyncSystem,
+                    pCacheDatabase,
+                    metadataUrl,
+                    pResponse->data());
+              }
+
+              return handleResponseResult;
+            });
+  };
 
-            CreateTileProviderResult handleResponseResult =
-                handleResponse(pRequest, pResponse->data());
+  if (!this->_pMetadataCacheDatabase) {
+    return requestMetadata();
+  }
 
-            // If the response successfully created a tile provider, cache it.
-            if (handleResponseResult) {
-              sessionCache[metadataUrl] = std::vector<std::byte>(
-                  pResponse->data().begin(),
-                  pResponse->data().end());
+  return getCachedMetadata(
+             asyncSystem,
+             this->_pMetadataCacheDatabase,
+             metadataUrl)
+      .thenInMainThread(
+          [asyncSystem, metadataUrl, handleResponse, requestMetadata](
+              std::optional<std::vector<std::byte>>&& maybeCached)
+              -> Future<CreateTileProviderResult> {
+            if (maybeCached) {
+              CreateTileProviderResult result =
+                  handleResponse(nullptr, *maybeCached);
+              if (result) {
+                sessionCache[metadataUrl] = std::move(*maybeCached);
+                return asyncSystem.createResolvedFuture(std::move(result));
+              }
             }
 
-            return handleResponseResult;
+            // Nothing usable was cached, so request the metadata again.
+            return requestMetadata();
           });
 }
 
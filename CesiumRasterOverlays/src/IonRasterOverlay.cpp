@@ -1,5 +1,7 @@
+#include <CesiumAsync/CacheItem.h>
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/ICacheDatabase.h>
 #include <CesiumRasterOverlays/BingMapsRasterOverlay.h>
 #include <CesiumRasterOverlays/IonRasterOverlay.h>
 #include <CesiumRasterOverlays/RasterOverlayLoadFailureDetails.h>
@@ -7,26 +9,75 @@
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
 #include <CesiumRasterOverlays/TileMapServiceRasterOverlay.h>
 #include <CesiumUtility/JsonHelpers.h>
+#include <CesiumUtility/JsonWebToken.h>
 #include <CesiumUtility/Uri.h>
 
 #include <rapidjson/document.h>
 #include <spdlog/fwd.h>
 
+#include <chrono>
+#include <ctime>
+
 using namespace CesiumAsync;
 using namespace CesiumUtility;
 
 namespace CesiumRasterOverlays {
 
+namespace {
+
+// A cached endpoint is only used if its token is valid for at least this long,
+// so that the tile provider is not created with a token that is about to
+// expire.
+constexpr std::chrono::system_clock::duration MINIMUM_TOKEN_LIFETIME =
+    std::chrono::minutes(5);
+
+std::string getEndpointCacheKey(const std::string& ionUrl) {
+  return "cesium-ion-endpoint:" + ionUrl;
+}
+
+void storeEndpointResponse(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
+    const std::string& ionUrl,
+    const std::chrono::system_clock::time_point& expiry,
+    const gsl::span<const std::byte>& data) {
+  asyncSystem.runInWorkerThread(
+      [pCacheDatabase,
+       ionUrl,
+       expiryTime = std::chrono::system_clock::to_time_t(expiry),
+       responseData = std::vector<std::byte>(data.begin(), data.end())]() {
+        pCacheDatabase->storeEntry(
+            getEndpointCacheKey(ionUrl),
+            expiryTime,
+            ionUrl,
+            "GET",
+            HttpHeaders{},
+            200,
+            HttpHeaders{},
+            responseData);
+      });
+}
+
+bool isUnauthorized(const RasterOverlayLoadFailureDetails& failure) {
+  const IAssetResponse* pResponse =
+      failure.pRequest ? failure.pRequest->response() : nullptr;
+  return pResponse && pResponse->statusCode() == 401;
+}
+
+} // namespace
+
 IonRasterOverlay::IonRasterOverlay(
     const std::string& name,
     int64_t ionAssetID,
     const std::string& ionAccessToken,
     const RasterOverlayOptions& overlayOptions,
-    const std::string& ionAssetEndpointUrl)
+    const std::string& ionAssetEndpointUrl,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pEndpointCacheDatabase)
     : RasterOverlay(name, overlayOptions),
       _ionAssetID(ionAssetID),
       _ionAccessToken(ionAccessToken),
-      _ionAssetEndpointUrl(ionAssetEndpointUrl) {}
+      _ionAssetEndpointUrl(ionAssetEndpointUrl),
+      _pEndpointCacheDatabase(pEndpointCacheDatabase) {}
 
 IonRasterOverlay::~IonRasterOverlay() {}
 
@@ -50,13 +101,19 @@ IonRasterOverlay::createTileProvider(
         endpoint.url,
         endpoint.key,
         endpoint.mapStyle,
-        endpoint.culture);
+        endpoint.culture,
+        CesiumGeospatial::Ellipsoid::WGS84,
+        RasterOverlayOptions(),
+        this->_pEndpointCacheDatabase);
   } else {
     pOverlay = new TileMapServiceRasterOverlay(
         this->getName(),
         endpoint.url,
         std::vector<CesiumAsync::IAssetAccessor::THeader>{
-            std::make_pair("Authorization", "Bearer " + endpoint.accessToken)});
+            std::make_pair("Authorization", "Bearer " + endpoint.accessToken)},
+        TileMapServiceRasterOverlayOptions(),
+        RasterOverlayOptions(),
+        this->_pEndpointCacheDatabase);
   }
 
   if (pCreditSystem) {
@@ -107,100 +164,228 @@ IonRasterOverlay::createTileProvider(
         pOwner);
   }
 
+  if (!this->_pEndpointCacheDatabase) {
+    return this->requestEndpoint(
+        ionUrl,
+        asyncSystem,
+        pAssetAccessor,
+        pCreditSystem,
+        pPrepareRendererResources,
+        pLogger,
+        pOwner);
+  }
+
+  // Create the tile provider from an endpoint that was kept from an earlier
+  // session, if its token is still valid. If the token is rejected anyway,
+  // the endpoint is requested again.
+  return asyncSystem
+      .runInWorkerThread(
+          [pCacheDatabase = this->_pEndpointCacheDatabase, ionUrl]() {
+            return pCacheDatabase->getEntry(getEndpointCacheKey(ionUrl));
+          })
+      .thenInMainThread(
+          [asyncSystem,
+           pOwner,
+           pAssetAccessor,
+           pCreditSystem,
+           pPrepareRendererResources,
+           ionUrl,
+           this,
+           pLogger](std::optional<CacheItem>&& maybeCacheItem)
+              -> Future<CreateTileProviderResult> {
+            const std::time_t validUntil = std::chrono::system_clock::to_time_t(
+                std::chrono::system_clock::now() + MINIMUM_TOKEN_LIFETIME);
+            std::optional<ExternalAssetEndpoint> maybeEndpoint;
+            if (maybeCacheItem && maybeCacheItem->expiryTime > validUntil) {
+              auto parsed =
+                  parseEndpoint(nullptr, maybeCacheItem->cacheResponse.data);
+              if (parsed) {
+                maybeEndpoint = std::move(*parsed);
+              }
+            }
+
+            if (!maybeEndpoint) {
+              return this->requestEndpoint(
+                  ionUrl,
+                  asyncSystem,
+                  pAssetAccessor,
+                  pCreditSystem,
+                  pPrepareRendererResources,
+                  pLogger,
+                  pOwner);
+            }
+
+            IonRasterOverlay::endpointCache[ionUrl] = *maybeEndpoint;
+            return this
+                ->createTileProvider(
+                    *maybeEndpoint,
+                    asyncSystem,
+                    pAssetAccessor,
+                    pCreditSystem,
+                    pPrepareRendererResources,
+                    pLogger,
+                    pOwner)
+                .thenInMainThread(
+                    [asyncSystem,
+                     pOwner,
+                     pAssetAccessor,
+                     pCreditSystem,
+                     pPrepareRendererResources,
+                     ionUrl,
+                     this,
+                     pLogger](CreateTileProviderResult&& result)
+                        -> Future<CreateTileProviderResult> {
+                      if (result || !isUnauthorized(result.error())) {
+                        return asyncSystem.createResolvedFuture(
+                            std::move(result));
+                      }
+
+                      IonRasterOverlay::endpointCache.erase(ionUrl);
+                      return this->requestEndpoint(
+                          ionUrl,
+                          asyncSystem,
+                          pAssetAccessor,
+                          pCreditSystem,
+                          pPrepareRendererResources,
+                          pLogger,
+                          pOwner);
+                    });
+          });
+}
+
+/*static*/ nonstd::expected<
+    IonRasterOverlay::ExternalAssetEndpoint,
+    RasterOverlayLoadFailureDetails>
+IonRasterOverlay::parseEndpoint(
+    std::shared_ptr<IAssetRequest>&& pRequest,
+    const gsl::span<const std::byte>& data) {
+  rapidjson::Document response;
+  response.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+
+  if (response.HasParseError()) {
+    return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+        RasterOverlayLoadType::CesiumIon,
+        std::move(pRequest),
+        fmt::format(
+            "Error while parsing Cesium ion raster overlay response, "
+            "error code {} at byte offset {}",
+            response.GetParseError(),
+            response.GetErrorOffset())});
+  }
+
+  std::string type =
+      JsonHelpers::getStringOrDefault(response, "type", "unknown");
+  if (type != "IMAGERY") {
+    return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+        RasterOverlayLoadType::CesiumIon,
+        std::move(pRequest),
+        fmt::format(
+            "Assets used with a raster overlay must have type "
+            "'IMAGERY', but instead saw '{}'.",
+            type)});
+  }
+
+  ExternalAssetEndpoint endpoint;
+  endpoint.externalType = JsonHelpers::getStringOrDefault(
+      response,
+      "externalType",
+      "unknown");
+  if (endpoint.externalType == "BING") {
+    const auto optionsIt = response.FindMember("options");
+    if (optionsIt == response.MemberEnd() || !optionsIt->value.IsObject()) {
+      return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+          RasterOverlayLoadType::CesiumIon,
+          std::move(pRequest),
+          fmt::format(
+              "Cesium ion Bing Maps raster overlay metadata response "
+              "does not contain 'options' or it is not an object.")});
+    }
+
+    const auto attributionsIt = response.FindMember("attributions");
+    if (attributionsIt != response.MemberEnd() &&
+        attributionsIt->value.IsArray()) {
+
+      for (const rapidjson::Value& attribution :
+           attributionsIt->value.GetArray()) {
+        AssetEndpointAttribution& endpointAttribution =
+            endpoint.attributions.emplace_back();
+        const auto html = attribution.FindMember("html");
+        if (html != attribution.MemberEnd() && html->value.IsString()) {
+          endpointAttribution.html = html->value.GetString();
+        }
+        auto collapsible = attribution.FindMember("collapsible");
+        if (collapsible != attribution.MemberEnd() &&
+            collapsible->value.IsBool()) {
+          endpointAttribution.collapsible = collapsible->value.GetBool();
+        }
+      }
+    }
+
+    const auto& options = optionsIt->value;
+    endpoint.url = JsonHelpers::getStringOrDefault(options, "url", "");
+    endpoint.key = JsonHelpers::getStringOrDefault(options, "key", "");
+    endpoint.mapStyle = JsonHelpers::getStringOrDefault(
+        options,
+        "mapStyle",
+        "AERIAL");
+    endpoint.culture = JsonHelpers::getStringOrDefault(options, "culture", "");
+  } else {
+    endpoint.url = JsonHelpers::getStringOrDefault(response, "url", "");
+    endpoint.accessToken =
+        JsonHelpers::getStringOrDefault(response, "accessToken", "");
+  }
+
+  return endpoint;
+}
+
+Future<RasterOverlay::CreateTileProviderResult>
+IonRasterOverlay::requestEndpoint(
+    const std::string& ionUrl,
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CreditSystem>& pCreditSystem,
+    const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+        pPrepareRendererResources,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    CesiumUtility::IntrusivePointer<const RasterOverlay> pOwner) const {
   return pAssetAccessor->get(asyncSystem, ionUrl)
       .thenImmediately(
-          [](std::shared_ptr<IAssetRequest>&& pRequest)
+          [asyncSystem,
+           pCacheDatabase = this->_pEndpointCacheDatabase,
+           ionUrl](std::shared_ptr<IAssetRequest>&& pRequest)
               -> nonstd::expected<
                   ExternalAssetEndpoint,
                   RasterOverlayLoadFailureDetails> {
             const IAssetResponse* pResponse = pRequest->response();
-
-            rapidjson::Document response;
-            response.Parse(
-                reinterpret_cast<const char*>(pResponse->data().data()),
-                pResponse->data().size());
-
-            if (response.HasParseError()) {
+            if (!pResponse) {
               return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
                   RasterOverlayLoadType::CesiumIon,
                   std::move(pRequest),
-                  fmt::format(
-                      "Error while parsing Cesium ion raster overlay response, "
-                      "error code {} at byte offset {}",
-                      response.GetParseError(),
-                      response.GetErrorOffset())});
+                  "No response received from Cesium ion."});
             }
 
-            std::string type =
-                JsonHelpers::getStringOrDefault(response, "type", "unknown");
-            if (type != "IMAGERY") {
-              return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
-                  RasterOverlayLoadType::CesiumIon,
-                  std::move(pRequest),
-                  fmt::format(
-                      "Assets used with a raster overlay must have type "
-                      "'IMAGERY', but instead saw '{}'.",
-                      type)});
-            }
+            const gsl::span<const std::byte> data = pResponse->data();
+            nonstd::expected<
+                ExternalAssetEndpoint,
+                RasterOverlayLoadFailureDetails>
+                result = parseEndpoint(std::move(pRequest), data);
 
-            ExternalAssetEndpoint endpoint;
-            endpoint.externalType = JsonHelpers::getStringOrDefault(
-                response,
-                "externalType",
-                "unknown");
-            if (endpoint.externalType == "BING") {
-              const auto optionsIt = response.FindMember("options");
-              if (optionsIt == response.MemberEnd() ||
-                  !optionsIt->value.IsObject()) {
-                return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
-                    RasterOverlayLoadType::CesiumIon,
-                    std::move(pRequest),
-                    fmt::format(
-                        "Cesium ion Bing Maps raster overlay metadata response "
-                        "does not contain 'options' or it is not an object.")});
+            // Endpoints without an ion access token, like those of Bing Maps,
+            // have no known lifetime and are only kept in memory.
+            if (result && pCacheDatabase) {
+              const std::optional<std::chrono::system_clock::time_point>
+                  expiry = JsonWebToken::getExpiry(result->accessToken);
+              if (expiry) {
+                storeEndpointResponse(
+                    asyncSystem,
+                    pCacheDatabase,
+                    ionUrl,
+                    *expiry,
+                    data);
               }
-
-              const auto attributionsIt = response.FindMember("attributions");
-              if (attributionsIt != response.MemberEnd() &&
-                  attributionsIt->value.IsArray()) {
-
-                for (const rapidjson::Value& attribution :
-                     attributionsIt->value.GetArray()) {
-                  AssetEndpointAttribution& endpointAttribution =
-                      endpoint.attributions.emplace_back();
-                  const auto html = attribution.FindMember("html");
-                  if (html != attribution.MemberEnd() &&
-                      html->value.IsString()) {
-                    endpointAttribution.html = html->value.GetString();
-                  }
-                  auto collapsible = attribution.FindMember("collapsible");
-                  if (collapsible != attribution.MemberEnd() &&
-                      collapsible->value.IsBool()) {
-                    endpointAttribution.collapsible =
-                        collapsible->value.GetBool();
-                  }
-                }
-              }
-
-              const auto& options = optionsIt->value;
-              endpoint.url =
-                  JsonHelpers::getStringOrDefault(options, "url", "");
-              endpoint.key =
-                  JsonHelpers::getStringOrDefault(options, "key", "");
-              endpoint.mapStyle = JsonHelpers::getStringOrDefault(
-                  options,
-                  "mapStyle",
-                  "AERIAL");
-              endpoint.culture =
-                  JsonHelpers::getStringOrDefault(options, "culture", "");
-            } else {
-              endpoint.url =
-                  JsonHelpers::getStringOrDefault(response, "url", "");
-              endpoint.accessToken =
-                  JsonHelpers::getStringOrDefault(response, "accessToken", "");
             }
 
-            return endpoint;
+            return result;
           })
       .thenInMainThread(
           [asyncSystem,
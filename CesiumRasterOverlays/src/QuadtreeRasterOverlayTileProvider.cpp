@@ -4,8 +4,11 @@
 #include <CesiumRasterOverlays/RasterOverlay.h>
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
 #include <CesiumUtility/Math.h>
+#include <CesiumUtility/PixelBufferPool.h>
 #include <CesiumUtility/SpanHelper.h>
 
+#include <algorithm>
+
 using namespace CesiumAsync;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -53,8 +56,12 @@ QuadtreeRasterOverlayTileProvider::QuadtreeRasterOverlayTileProvider(
       _imageWidth(imageWidth),
       _imageHeight(imageHeight),
       _tilingScheme(tilingScheme),
-      _tilesOldToRecent(),
-      _tileLookup(),
+      _cacheEntries(),
+      _freeCacheEntry(NoCacheEntry),
+      _oldestCacheEntry(NoCacheEntry),
+      _newestCacheEntry(NoCacheEntry),
+      _cacheSlots(),
+      _cachedTileCount(0),
       _cachedBytes(0) {}
 
 uint32_t QuadtreeRasterOverlayTileProvider::computeLevelFromTargetScreenPixels(
@@ -239,6 +246,29 @@ QuadtreeRasterOverlayTileProvider::mapRasterTilesToGeometryTile(
     tilesY = northeastTileCoordinates.y - southwestTileCoordinates.y + 1;
   }
 
+  // If we'd need to load too many tiles that aren't cached yet, reduce the
+  // level until the cost is within budget.
+  const RasterOverlayOptions& options = this->getOwner().getOptions();
+  const int64_t maximumLoads = options.maximumSubTileLoadsPerTile;
+  const int64_t maximumBytes = options.maximumSubTileBytesPerTile;
+  if (maximumLoads > 0 || maximumBytes > 0) {
+    const int64_t bytesPerTile =
+        int64_t(this->getWidth()) * int64_t(this->getHeight()) * 4;
+    while (level > this->getMinimumLevel()) {
+      const int64_t loads = int64_t(this->countUncachedTiles(
+          southwestTileCoordinates,
+          northeastTileCoordinates));
+      if ((maximumLoads <= 0 || loads <= maximumLoads) &&
+          (maximumBytes <= 0 || loads * bytesPerTile <= maximumBytes)) {
+        break;
+      }
+
+      --level;
+      northeastTileCoordinates = northeastTileCoordinates.getParent();
+      southwestTileCoordinates = southwestTileCoordinates.getParent();
+    }
+  }
+
   // Create TileImagery instances for each imagery tile overlapping this terrain
   // tile. We need to do all texture coordinate computations in the imagery
   // provider's projection.
@@ -284,17 +314,13 @@ CesiumAsync::SharedFuture<
     QuadtreeRasterOverlayTileProvider::LoadedQuadtreeImage>
 QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
     const CesiumGeometry::QuadtreeTileID& tileID) {
-  auto lookupIt = this->_tileLookup.find(tileID);
-  if (lookupIt != this->_tileLookup.end()) {
-    auto& cacheIt = lookupIt->second;
+  const uint32_t cachedEntry = this->findCacheEntry(tileID);
+  if (cachedEntry != NoCacheEntry) {
+    // Move this entry to the newest end, indicating it's most recently used.
+    this->unlinkCacheEntry(cachedEntry);
+    this->linkNewestCacheEntry(cachedEntry);
 
-    // Move this entry to the end, indicating it's most recently used.
-    this->_tilesOldToRecent.splice(
-        this->_tilesOldToRecent.end(),
-        this->_tilesOldToRecent,
-        cacheIt);
-
-    return cacheIt->future;
+    return *this->_cacheEntries[cachedEntry].future;
   }
 
   // We create this lambda here instead of where it's used below so that we
@@ -366,12 +392,11 @@ QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
             }
           });
 
-  auto newIt = this->_tilesOldToRecent.emplace(
-      this->_tilesOldToRecent.end(),
-      CacheEntry{tileID, std::move(future).share()});
-  this->_tileLookup[tileID] = newIt;
+  const uint32_t newEntry =
+      this->addCacheEntry(tileID, std::move(future).share());
 
-  SharedFuture<LoadedQuadtreeImage> result = newIt->future;
+  SharedFuture<LoadedQuadtreeImage> result =
+      *this->_cacheEntries[newEntry].future;
 
   this->unloadCachedTiles();
 
@@ -487,22 +512,33 @@ QuadtreeRasterOverlayTileProvider::loadTileImage(
       });
 }
 
+int64_t QuadtreeRasterOverlayTileProvider::trimCachedData() {
+  const int64_t cachedBytes = this->_cachedBytes;
+  this->unloadCachedTiles(0);
+  return cachedBytes - this->_cachedBytes;
+}
+
 void QuadtreeRasterOverlayTileProvider::unloadCachedTiles() {
+  this->unloadCachedTiles(this->getOwner().getOptions().subTileCacheBytes);
+}
+
+void QuadtreeRasterOverlayTileProvider::unloadCachedTiles(
+    int64_t maxCacheBytes) {
   CESIUM_TRACE("QuadtreeRasterOverlayTileProvider::unloadCachedTiles");
 
-  const int64_t maxCacheBytes = this->getOwner().getOptions().subTileCacheBytes;
   if (this->_cachedBytes <= maxCacheBytes) {
     return;
   }
 
-  auto it = this->_tilesOldToRecent.begin();
+  uint32_t entry = this->_oldestCacheEntry;
 
-  while (it != this->_tilesOldToRecent.end() &&
-         this->_cachedBytes > maxCacheBytes) {
-    const SharedFuture<LoadedQuadtreeImage>& future = it->future;
+  while (entry != NoCacheEntry && this->_cachedBytes > maxCacheBytes) {
+    const uint32_t newer = this->_cacheEntries[entry].newer;
+    const SharedFuture<LoadedQuadtreeImage>& future =
+        *this->_cacheEntries[entry].future;
     if (!future.isReady()) {
       // Don't unload tiles that are still loading.
-      ++it;
+      entry = newer;
       continue;
     }
 
@@ -511,8 +547,8 @@ void QuadtreeRasterOverlayTileProvider::unloadCachedTiles() {
 
     std::shared_ptr<LoadedRasterOverlayImage> pImage = image.pLoaded;
 
-    this->_tileLookup.erase(it->tileID);
-    it = this->_tilesOldToRecent.erase(it);
+    this->removeCacheEntry(entry);
+    entry = newer;
 
     // If this is the last use of this data, it will be freed when the shared
     // pointer goes out of scope, so reduce the cachedBytes accordingly.
@@ -520,9 +556,171 @@ void QuadtreeRasterOverlayTileProvider::unloadCachedTiles() {
       if (pImage->image) {
         this->_cachedBytes -= int64_t(pImage->image->pixelData.size());
         assert(this->_cachedBytes >= 0);
+        PixelBufferPool::getDefault().release(pImage->image->pixelData);
+      }
+    }
+  }
+}
+
+uint32_t QuadtreeRasterOverlayTileProvider::countUncachedTiles(
+    const QuadtreeTileID& southwest,
+    const QuadtreeTileID& northeast) const {
+  uint32_t count = 0;
+  for (uint32_t x = southwest.x; x <= northeast.x; ++x) {
+    for (uint32_t y = southwest.y; y <= northeast.y; ++y) {
+      if (this->findCacheEntry(QuadtreeTileID(southwest.level, x, y)) ==
+          NoCacheEntry) {
+        ++count;
+      }
+    }
+  }
+  return count;
+}
+
+uint32_t QuadtreeRasterOverlayTileProvider::findCacheEntry(
+    const QuadtreeTileID& tileID) const {
+  if (this->_cacheSlots.empty()) {
+    return NoCacheEntry;
+  }
+
+  const size_t mask = this->_cacheSlots.size() - 1;
+  for (size_t slot = this->getCacheHomeSlot(tileID);
+       this->_cacheSlots[slot] != NoCacheEntry;
+       slot = (slot + 1) & mask) {
+    const uint32_t entry = this->_cacheSlots[slot];
+    if (this->_cacheEntries[entry].tileID == tileID) {
+      return entry;
+    }
+  }
+
+  return NoCacheEntry;
+}
+
+uint32_t QuadtreeRasterOverlayTileProvider::addCacheEntry(
+    const QuadtreeTileID& tileID,
+    SharedFuture<LoadedQuadtreeImage>&& future) {
+  // Keep at least a quarter of the slots free, so that probe sequences stay
+  // short.
+  if ((this->_cachedTileCount + 1) * 4 > this->_cacheSlots.size() * 3) {
+    std::vector<uint32_t> oldSlots = std::move(this->_cacheSlots);
+    this->_cacheSlots.assign(
+        std::max(oldSlots.size() * 2, size_t(64)),
+        NoCacheEntry);
+    const size_t mask = this->_cacheSlots.size() - 1;
+    for (uint32_t oldEntry : oldSlots) {
+      if (oldEntry == NoCacheEntry) {
+        continue;
       }
+
+      size_t slot =
+          this->getCacheHomeSlot(this->_cacheEntries[oldEntry].tileID);
+      while (this->_cacheSlots[slot] != NoCacheEntry) {
+        slot = (slot + 1) & mask;
+      }
+      this->_cacheSlots[slot] = oldEntry;
+    }
+  }
+
+  uint32_t entry = this->_freeCacheEntry;
+  if (entry != NoCacheEntry) {
+    this->_freeCacheEntry = this->_cacheEntries[entry].newer;
+  } else {
+    entry = uint32_t(this->_cacheEntries.size());
+    this->_cacheEntries.emplace_back();
+  }
+
+  CacheEntry& cacheEntry = this->_cacheEntries[entry];
+  cacheEntry.tileID = tileID;
+  cacheEntry.future = std::move(future);
+  this->linkNewestCacheEntry(entry);
+
+  const size_t mask = this->_cacheSlots.size() - 1;
+  size_t slot = this->getCacheHomeSlot(tileID);
+  while (this->_cacheSlots[slot] != NoCacheEntry) {
+    slot = (slot + 1) & mask;
+  }
+  this->_cacheSlots[slot] = entry;
+  ++this->_cachedTileCount;
+
+  return entry;
+}
+
+void QuadtreeRasterOverlayTileProvider::removeCacheEntry(uint32_t entry) {
+  CacheEntry& cacheEntry = this->_cacheEntries[entry];
+
+  // Free the slot, then move later entries of the same probe sequence back
+  // into the gap, so that lookups never need to skip over removed entries.
+  const size_t mask = this->_cacheSlots.size() - 1;
+  size_t hole = this->getCacheHomeSlot(cacheEntry.tileID);
+  while (this->_cacheSlots[hole] != entry) {
+    hole = (hole + 1) & mask;
+  }
+  this->_cacheSlots[hole] = NoCacheEntry;
+
+  for (size_t next = (hole + 1) & mask;
+       this->_cacheSlots[next] != NoCacheEntry;
+       next = (next + 1) & mask) {
+    const CacheEntry& nextEntry = this->_cacheEntries[this->_cacheSlots[next]];
+    const size_t home = this->getCacheHomeSlot(nextEntry.tileID);
+
+    // The entry can stay if its home slot is after the hole, up to and
+    // including where it is now.
+    const bool canStay = hole <= next ? hole < home && home <= next
+                                      : hole < home || home <= next;
+    if (!canStay) {
+      this->_cacheSlots[hole] = this->_cacheSlots[next];
+      this->_cacheSlots[next] = NoCacheEntry;
+      hole = next;
     }
   }
+  --this->_cachedTileCount;
+
+  this->unlinkCacheEntry(entry);
+  cacheEntry.future.reset();
+  cacheEntry.older = NoCacheEntry;
+  cacheEntry.newer = this->_freeCacheEntry;
+  this->_freeCacheEntry = entry;
+}
+
+void QuadtreeRasterOverlayTileProvider::linkNewestCacheEntry(
+    uint32_t entry) noexcept {
+  CacheEntry& cacheEntry = this->_cacheEntries[entry];
+  cacheEntry.older = this->_newestCacheEntry;
+  cacheEntry.newer = NoCacheEntry;
+  if (this->_newestCacheEntry != NoCacheEntry) {
+    this->_cacheEntries[this->_newestCacheEntry].newer = entry;
+  } else {
+    this->_oldestCacheEntry = entry;
+  }
+  this->_newestCacheEntry = entry;
+}
+
+void QuadtreeRasterOverlayTileProvider::unlinkCacheEntry(
+    uint32_t entry) noexcept {
+  CacheEntry& cacheEntry = this->_cacheEntries[entry];
+  if (cacheEntry.older != NoCacheEntry) {
+    this->_cacheEntries[cacheEntry.older].newer = cacheEntry.newer;
+  } else {
+    this->_oldestCacheEntry = cacheEntry.newer;
+  }
+
+  if (cacheEntry.newer != NoCacheEntry) {
+    this->_cacheEntries[cacheEntry.newer].older = cacheEntry.older;
+  } else {
+    this->_newestCacheEntry = cacheEntry.older;
+  }
+}
+
+size_t QuadtreeRasterOverlayTileProvider::getCacheHomeSlot(
+    const QuadtreeTileID& tileID) const noexcept {
+  // Pack the tile ID, then spread it over the table with the splitmix64
+  // finalizer, because the IDs of neighboring tiles differ in few bits.
+  uint64_t hash = (uint64_t(tileID.level) << 58) ^ (uint64_t(tileID.x) << 29) ^
+                  uint64_t(tileID.y);
+  hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+  hash ^= hash >> 31;
+  return size_t(hash) & (this->_cacheSlots.size() - 1);
 }
 
 /*static*/ QuadtreeRasterOverlayTileProvider::CombinedImageMeasurements
@@ -675,7 +873,7 @@ QuadtreeRasterOverlayTileProvider::combineImages(
   target.channels = measurements.channels;
   target.width = measurements.widthPixels;
   target.height = measurements.heightPixels;
-  target.pixelData.resize(size_t(
+  target.pixelData = PixelBufferPool::getDefault().acquire(size_t(
       target.width * target.height * target.channels * target.bytesPerChannel));
 
   for (auto it = images.begin(); it != images.end(); ++it) {
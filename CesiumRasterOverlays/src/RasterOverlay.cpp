@@ -2,7 +2,11 @@
 #include <CesiumRasterOverlays/RasterOverlayLoadFailureDetails.h>
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
 
-#include <spdlog/fwd.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cassert>
 
 using namespace CesiumAsync;
 using namespace CesiumRasterOverlays;
@@ -61,3 +65,114 @@ RasterOverlay::createPlaceholder(
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor) const {
   return new PlaceholderTileProvider(this, asyncSystem, pAssetAccessor);
 }
+
+CesiumAsync::SharedFuture<RasterOverlay::CreateTileProviderResult>
+RasterOverlay::acquireSharedTileProvider(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+    const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+        pPrepareRendererResources,
+    const std::shared_ptr<spdlog::logger>& pLogger) {
+  auto it = this->findSharedTileProvider(
+      asyncSystem,
+      pAssetAccessor,
+      pCreditSystem,
+      pPrepareRendererResources,
+      pLogger);
+  if (it != this->_sharedTileProviders.end()) {
+    ++it->users;
+    return it->future;
+  }
+
+  // Report errors here rather than where the future is used, so that they are
+  // reported once no matter how many tilesets use the provider.
+  SharedFuture<CreateTileProviderResult> future =
+      this->createTileProvider(
+              asyncSystem,
+              pAssetAccessor,
+              pCreditSystem,
+              pPrepareRendererResources,
+              pLogger,
+              nullptr)
+          .catchInMainThread(
+              [](const std::exception& e) -> CreateTileProviderResult {
+                return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+                    RasterOverlayLoadType::Unknown,
+                    nullptr,
+                    fmt::format(
+                        "Error while creating tile provider: {0}",
+                        e.what())});
+              })
+          .thenInMainThread(
+              [pThis = IntrusivePointer<RasterOverlay>(this),
+               pLogger](CreateTileProviderResult&& result) {
+                if (!result) {
+                  const RasterOverlayLoadFailureDetails& failureDetails =
+                      result.error();
+                  SPDLOG_LOGGER_ERROR(pLogger, failureDetails.message);
+                  if (pThis->getOptions().loadErrorCallback) {
+                    pThis->getOptions().loadErrorCallback(failureDetails);
+                  }
+                }
+                return std::move(result);
+              })
+          .share();
+
+  this->_sharedTileProviders.emplace_back(SharedTileProvider{
+      asyncSystem,
+      pAssetAccessor,
+      pCreditSystem,
+      pPrepareRendererResources,
+      pLogger,
+      future,
+      1});
+  return future;
+}
+
+void RasterOverlay::releaseSharedTileProvider(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+    const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+        pPrepareRendererResources,
+    const std::shared_ptr<spdlog::logger>& pLogger) noexcept {
+  auto it = this->findSharedTileProvider(
+      asyncSystem,
+      pAssetAccessor,
+      pCreditSystem,
+      pPrepareRendererResources,
+      pLogger);
+  assert(it != this->_sharedTileProviders.end());
+  if (it == this->_sharedTileProviders.end()) {
+    return;
+  }
+
+  --it->users;
+  if (it->users == 0) {
+    // Erasing the entry may release the last other reference to this overlay,
+    // which is held by the tile provider, so keep it alive until we're done.
+    IntrusivePointer<RasterOverlay> pThis = this;
+    this->_sharedTileProviders.erase(it);
+  }
+}
+
+std::vector<RasterOverlay::SharedTileProvider>::iterator
+RasterOverlay::findSharedTileProvider(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+    const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+        pPrepareRendererResources,
+    const std::shared_ptr<spdlog::logger>& pLogger) noexcept {
+  return std::find_if(
+      this->_sharedTileProviders.begin(),
+      this->_sharedTileProviders.end(),
+      [&](const SharedTileProvider& shared) noexcept {
+        return shared.asyncSystem == asyncSystem &&
+               shared.pAssetAccessor == pAssetAccessor &&
+               shared.pCreditSystem == pCreditSystem &&
+               shared.pPrepareRendererResources == pPrepareRendererResources &&
+               shared.pLogger == pLogger;
+      });
+}
@@ -0,0 +1,72 @@
+#include "RasterOverlayMetadataCache.h"
+
+#include <CesiumAsync/CacheItem.h>
+#include <CesiumAsync/HttpHeaders.h>
+#include <CesiumAsync/ICacheDatabase.h>
+
+#include <ctime>
+
+using namespace CesiumAsync;
+
+namespace CesiumRasterOverlays {
+
+namespace {
+
+std::string getMetadataCacheKey(const std::string& url) {
+  return "raster-overlay-metadata:" + url;
+}
+
+} // namespace
+
+Future<std::optional<std::vector<std::byte>>> getCachedMetadata(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
+    const std::string& url) {
+  if (!pCacheDatabase) {
+    return asyncSystem
+        .createResolvedFuture<std::optional<std::vector<std::byte>>>(
+            std::nullopt);
+  }
+
+  return asyncSystem.runInWorkerThread(
+      [pCacheDatabase, url]() -> std::optional<std::vector<std::byte>> {
+        std::optional<CacheItem> maybeCacheItem =
+            pCacheDatabase->getEntry(getMetadataCacheKey(url));
+        const std::time_t now = std::chrono::system_clock::to_time_t(
+            std::chrono::system_clock::now());
+        if (!maybeCacheItem || maybeCacheItem->expiryTime <= now) {
+          return std::nullopt;
+        }
+
+        return std::move(maybeCacheItem->cacheResponse.data);
+      });
+}
+
+void storeCachedMetadata(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
+    const std::string& url,
+    const gsl::span<const std::byte>& data) {
+  if (!pCacheDatabase) {
+    return;
+  }
+
+  asyncSystem.runInWorkerThread(
+      [pCacheDatabase,
+       url,
+       expiryTime = std::chrono::system_clock::to_time_t(
+           std::chrono::system_clock::now() + METADATA_CACHE_LIFETIME),
+       responseData = std::vector<std::byte>(data.begin(), data.end())]() {
+        pCacheDatabase->storeEntry(
+            getMetadataCacheKey(url),
+            expiryTime,
+            url,
+            "GET",
+            HttpHeaders{},
+            200,
+            HttpHeaders{},
+            responseData);
+      });
+}
+
+} // namespace CesiumRasterOverlays
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+
+#include <gsl/span>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
+namespace CesiumRasterOverlays {
+
+/**
+ * @brief How long raster overlay metadata, such as the Bing Maps imagery
+ * metadata or a web map service's capabilities, is kept in a cache database
+ * before it is requested again.
+ */
+constexpr std::chrono::system_clock::duration METADATA_CACHE_LIFETIME =
+    std::chrono::hours(24);
+
+/**
+ * @brief Gets the metadata that was stored for a URL with
+ * {@link storeCachedMetadata} and has not yet expired.
+ *
+ * The database is read in a worker thread. The future resolves to an empty
+ * optional when there is no database, or when it has no unexpired metadata
+ * for the URL.
+ */
+CesiumAsync::Future<std::optional<std::vector<std::byte>>> getCachedMetadata(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pCacheDatabase,
+    const std::string& url);
+
+/**
+ * @brief Stores the metadata for a URL in a cache database for
+ * {@link METADATA_CACHE_LIFETIME}, so that later sessions do not need to
+ * request it again.
+ *
+ * The database is written in a worker thread. This does nothing when there is
+ * no database. Only metadata that was successfully parsed should be stored.
+ */
+void storeCachedMetadata(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pCacheDatabase,
+    const std::string& url,
+    const gsl::span<const std::byte>& data);
+
+} // namespace CesiumRasterOverlays
@@ -4,6 +4,7 @@
 #include <CesiumRasterOverlays/RasterOverlay.h>
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
+#include <CesiumUtility/PixelBufferPool.h>
 #include <CesiumUtility/joinToString.h>
 
 using namespace CesiumAsync;
@@ -19,6 +20,7 @@ RasterOverlayTile::RasterOverlayTile(
       _state(LoadState::Placeholder),
       _image(),
       _pRendererResources(nullptr),
+      _gpuByteSize(0),
       _moreDetailAvailable(MoreDetailAvailable::Unknown) {}
 
 RasterOverlayTile::RasterOverlayTile(
@@ -32,6 +34,7 @@ RasterOverlayTile::RasterOverlayTile(
       _state(LoadState::Unloaded),
       _image(),
       _pRendererResources(nullptr),
+      _gpuByteSize(0),
       _moreDetailAvailable(MoreDetailAvailable::Unknown) {}
 
 RasterOverlayTile::~RasterOverlayTile() {
@@ -57,6 +60,8 @@ RasterOverlayTile::~RasterOverlayTile() {
         pLoadThreadResult,
         pMainThreadResult);
   }
+
+  CesiumUtility::PixelBufferPool::getDefault().release(this->_image.pixelData);
 }
 
 RasterOverlay& RasterOverlayTile::getOverlay() noexcept {
@@ -77,11 +82,18 @@ void RasterOverlayTile::loadInMainThread() {
 
   // Do the final main thread raster loading
   RasterOverlayTileProvider& tileProvider = *this->_pTileProvider;
+  const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+      pPrepareRendererResources = tileProvider.getPrepareRendererResources();
   this->_pRendererResources =
-      tileProvider.getPrepareRendererResources()->prepareRasterInMainThread(
+      pPrepareRendererResources->prepareRasterInMainThread(
           *this,
           this->_pRendererResources);
 
+  this->_gpuByteSize = pPrepareRendererResources->getRasterGpuByteSize(
+      *this,
+      this->_pRendererResources);
+  tileProvider._tileGpuBytes += this->_gpuByteSize;
+
   this->setState(LoadState::Done);
 }
 
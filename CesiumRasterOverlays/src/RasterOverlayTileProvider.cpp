@@ -1,18 +1,26 @@
+#include <CesiumAsync/AdaptiveConcurrencyLimiter.h>
+#include <CesiumAsync/BandwidthLimiter.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumGltfContent/ImageManipulation.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumRasterOverlays/IPrepareRasterOverlayRendererResources.h>
 #include <CesiumRasterOverlays/RasterOverlay.h>
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
+#include <CesiumUtility/Metrics.h>
 #include <CesiumUtility/Tracing.h>
 #include <CesiumUtility/joinToString.h>
 
 #include <spdlog/fwd.h>
 
+#include <algorithm>
+#include <chrono>
+
 using namespace CesiumAsync;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 using namespace CesiumGltf;
+using namespace CesiumGltfContent;
 using namespace CesiumGltfReader;
 using namespace CesiumUtility;
 
@@ -36,8 +44,11 @@ RasterOverlayTileProvider::RasterOverlayTileProvider(
                              computeMaximumProjectedRectangle()),
       _pPlaceholder(),
       _tileDataBytes(0),
+      _tileGpuBytes(0),
       _totalTilesCurrentlyLoading(0),
-      _throttledTilesCurrentlyLoading(0) {
+      _throttledTilesCurrentlyLoading(0),
+      _outputChannels(0),
+      _pendingTiles() {
   this->_pPlaceholder = new RasterOverlayTile(*this);
 }
 
@@ -61,10 +72,19 @@ RasterOverlayTileProvider::RasterOverlayTileProvider(
       _coverageRectangle(coverageRectangle),
       _pPlaceholder(nullptr),
       _tileDataBytes(0),
+      _tileGpuBytes(0),
       _totalTilesCurrentlyLoading(0),
-      _throttledTilesCurrentlyLoading(0) {}
+      _throttledTilesCurrentlyLoading(0),
+      _outputChannels(0),
+      _pendingTiles() {}
 
 RasterOverlayTileProvider::~RasterOverlayTileProvider() noexcept {
+  // Release the tiles waiting to load while this provider is still intact.
+  for (const IntrusivePointer<RasterOverlayTile>& pTile : this->_pendingTiles) {
+    pTile->_pendingLoadPriority.reset();
+  }
+  this->_pendingTiles.clear();
+
   // Explicitly release the placeholder first, because RasterOverlayTiles must
   // be destroyed before the tile provider that created them.
   if (this->_pPlaceholder) {
@@ -92,6 +112,7 @@ void RasterOverlayTileProvider::removeTile(RasterOverlayTile* pTile) noexcept {
   assert(pTile->getReferenceCount() == 0);
 
   this->_tileDataBytes -= int64_t(pTile->getImage().pixelData.size());
+  this->_tileGpuBytes -= pTile->getGpuByteSize();
 }
 
 CesiumAsync::Future<TileProviderAndTile>
@@ -105,13 +126,22 @@ RasterOverlayTileProvider::loadTile(RasterOverlayTile& tile) {
   return this->doLoad(tile, false);
 }
 
-bool RasterOverlayTileProvider::loadTileThrottled(RasterOverlayTile& tile) {
+bool RasterOverlayTileProvider::loadTileThrottled(
+    RasterOverlayTile& tile,
+    const TaskPriority& priority) {
   if (tile.getState() != RasterOverlayTile::LoadState::Unloaded) {
     return true;
   }
 
   if (this->_throttledTilesCurrentlyLoading >=
-      this->getOwner().getOptions().maximumSimultaneousTileLoads) {
+          this->getMaximumSimultaneousTileLoads() ||
+      this->isBandwidthExhausted()) {
+    // Remember the tile so that it can be loaded, in priority order, as soon
+    // as a throttled load completes.
+    if (!tile._pendingLoadPriority) {
+      this->_pendingTiles.emplace_back(&tile);
+    }
+    tile._pendingLoadPriority = priority;
     return false;
   }
 
@@ -203,6 +233,27 @@ RasterOverlayTileProvider::loadTileImageFromUrl(
 }
 
 namespace {
+MetricGauge& getTileLoadsInProgressGauge() {
+  static MetricGauge& gauge = MetricsRegistry::getDefault().gauge(
+      "cesium_raster_overlay_tile_loads_in_progress",
+      "The number of raster overlay tiles that are loading.");
+  return gauge;
+}
+
+MetricCounter& getTileLoadsCounter(RasterOverlayTile::LoadState state) {
+  static const char* help =
+      "The number of raster overlay tile loads, by result.";
+  static MetricCounter& loaded = MetricsRegistry::getDefault().counter(
+      "cesium_raster_overlay_tile_loads_total",
+      help,
+      {{"result", "success"}});
+  static MetricCounter& failed = MetricsRegistry::getDefault().counter(
+      "cesium_raster_overlay_tile_loads_total",
+      help,
+      {{"result", "failed"}});
+  return state == RasterOverlayTile::LoadState::Failed ? failed : loaded;
+}
+
 struct LoadResult {
   RasterOverlayTile::LoadState state = RasterOverlayTile::LoadState::Unloaded;
   CesiumGltf::ImageCesium image = {};
@@ -212,6 +263,47 @@ struct LoadResult {
   bool moreDetailAvailable = true;
 };
 
+bool isOpaque(const CesiumGltf::ImageCesium& image) {
+  const size_t pixelCount = size_t(image.width) * size_t(image.height);
+  for (size_t i = 0; i < pixelCount; ++i) {
+    if (image.pixelData[i * 4 + 3] != std::byte(0xff)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Chooses the block compression format for an image from the supported ones
+// that ImageManipulation::compressImage can encode.
+GpuCompressedPixelFormat chooseCompressedPixelFormat(
+    const CesiumGltf::ImageCesium& image,
+    const SupportedGpuCompressedPixelFormats& supported) {
+  if (image.bytesPerChannel != 1 ||
+      image.compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
+    return GpuCompressedPixelFormat::NONE;
+  }
+
+  switch (image.channels) {
+  case 1:
+    return supported.BC4_R ? GpuCompressedPixelFormat::BC4_R
+                           : GpuCompressedPixelFormat::NONE;
+  case 2:
+    return supported.BC5_RG ? GpuCompressedPixelFormat::BC5_RG
+                            : GpuCompressedPixelFormat::NONE;
+  case 3:
+    return supported.BC1_RGB ? GpuCompressedPixelFormat::BC1_RGB
+                             : GpuCompressedPixelFormat::NONE;
+  case 4:
+    if (supported.BC1_RGB && isOpaque(image)) {
+      return GpuCompressedPixelFormat::BC1_RGB;
+    }
+    return supported.BC3_RGBA ? GpuCompressedPixelFormat::BC3_RGBA
+                              : GpuCompressedPixelFormat::NONE;
+  default:
+    return GpuCompressedPixelFormat::NONE;
+  }
+}
+
 /**
  * @brief Processes the given `LoadedRasterOverlayImage`, producing a
  * `LoadResult`.
@@ -222,7 +314,9 @@ struct LoadResult {
  * `LoadResult` with the state `RasterOverlayTile::LoadState::Failed` will be
  * returned.
  *
- * Otherwise, the image data will be passed to
+ * Otherwise, the image will be reduced to the provider's output channels, if
+ * it declares them, given mipmaps and encoded to one of the
+ * `gpuCompressedPixelFormats`, if any apply to it, and then passed to
  * `IPrepareRasterOverlayRendererResources::prepareRasterInLoadThread`, and the
  * function will return a `LoadResult` with the image, the prepared renderer
  * resources, and the state `RasterOverlayTile::LoadState::Loaded`.
@@ -232,6 +326,10 @@ struct LoadResult {
  * @param pLogger The logger
  * @param loadedImage The `LoadedRasterOverlayImage`
  * @param rendererOptions Renderer options
+ * @param outputChannels The number of channels to reduce the image to, or 0
+ * to keep them all
+ * @param gpuCompressedPixelFormats The formats to which the image may be
+ * encoded
  * @return The `LoadResult`
  */
 static LoadResult createLoadResultFromLoadedImage(
@@ -239,7 +337,9 @@ static LoadResult createLoadResultFromLoadedImage(
         pPrepareRendererResources,
     const std::shared_ptr<spdlog::logger>& pLogger,
     LoadedRasterOverlayImage&& loadedImage,
-    const std::any& rendererOptions) {
+    const std::any& rendererOptions,
+    int32_t outputChannels,
+    const SupportedGpuCompressedPixelFormats& gpuCompressedPixelFormats) {
   if (!loadedImage.image.has_value()) {
     SPDLOG_LOGGER_ERROR(
         pLogger,
@@ -273,6 +373,23 @@ static LoadResult createLoadResultFromLoadedImage(
         std::to_string(image.height) + "x" + std::to_string(image.channels) +
         "x" + std::to_string(image.bytesPerChannel));
 
+    if (outputChannels > 0 && outputChannels < image.channels) {
+      ImageManipulation::truncateChannels(image, outputChannels);
+    }
+
+    const GpuCompressedPixelFormat compressedPixelFormat =
+        chooseCompressedPixelFormat(image, gpuCompressedPixelFormats);
+    if (compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
+      // Color channels are sRGB-encoded, but masks and other single or
+      // two-channel images are linear.
+      const std::optional<std::string> mipError =
+          GltfReader::generateMipMaps(image, image.channels >= 3);
+      if (mipError) {
+        SPDLOG_LOGGER_WARN(pLogger, *mipError);
+      }
+      ImageManipulation::compressImage(image, compressedPixelFormat);
+    }
+
     void* pRendererResources = nullptr;
     if (pPrepareRendererResources) {
       pRendererResources = pPrepareRendererResources->prepareRasterInLoadThread(
@@ -319,20 +436,40 @@ CesiumAsync::Future<TileProviderAndTile> RasterOverlayTileProvider::doLoad(
   IntrusivePointer<RasterOverlayTile> pTile = &tile;
   IntrusivePointer<RasterOverlayTileProvider> thiz = this;
 
+  // Tell the concurrency limiter, if there is one, how the load went.
+  std::shared_ptr<AdaptiveConcurrencyLimiter> pConcurrencyLimiter =
+      this->_pOwner->getOptions().pConcurrencyLimiter;
+  const auto loadStart = std::chrono::steady_clock::now();
+  auto recordCompletion = [pConcurrencyLimiter, loadStart](
+                              int64_t bytes,
+                              bool succeeded) noexcept {
+    if (pConcurrencyLimiter) {
+      const std::chrono::duration<double> loadTime =
+          std::chrono::steady_clock::now() - loadStart;
+      pConcurrencyLimiter->recordCompletion(loadTime.count(), bytes, succeeded);
+    }
+  };
+
   return this->loadTileImage(tile)
       .thenInWorkerThread(
           [pPrepareRendererResources = this->getPrepareRendererResources(),
            pLogger = this->getLogger(),
-           rendererOptions = this->_pOwner->getOptions().rendererOptions](
+           rendererOptions = this->_pOwner->getOptions().rendererOptions,
+           outputChannels = this->_outputChannels,
+           gpuCompressedPixelFormats =
+               this->_pOwner->getOptions().gpuCompressedPixelFormats](
               LoadedRasterOverlayImage&& loadedImage) {
             return createLoadResultFromLoadedImage(
                 pPrepareRendererResources,
                 pLogger,
                 std::move(loadedImage),
-                rendererOptions);
+                rendererOptions,
+                outputChannels,
+                gpuCompressedPixelFormats);
           })
       .thenInMainThread(
-          [thiz, pTile, isThrottledLoad](LoadResult&& result) noexcept {
+          [thiz, pTile, isThrottledLoad, recordCompletion](
+              LoadResult&& result) noexcept {
             pTile->_rectangle = result.rectangle;
             pTile->_pRendererResources = result.pRendererResources;
             pTile->_image = std::move(result.image);
@@ -345,12 +482,17 @@ CesiumAsync::Future<TileProviderAndTile> RasterOverlayTileProvider::doLoad(
 
             thiz->_tileDataBytes += int64_t(pTile->getImage().pixelData.size());
 
+            getTileLoadsCounter(result.state).increment();
+            recordCompletion(
+                int64_t(pTile->getImage().pixelData.size()),
+                result.state != RasterOverlayTile::LoadState::Failed);
             thiz->finalizeTileLoad(isThrottledLoad);
 
             return TileProviderAndTile{thiz, pTile};
           })
       .catchInMainThread(
-          [thiz, pTile, isThrottledLoad](const std::exception& /*e*/) {
+          [thiz, pTile, isThrottledLoad, recordCompletion](
+              const std::exception& /*e*/) {
             pTile->_pRendererResources = nullptr;
             pTile->_image = {};
             pTile->_tileCredits = {};
@@ -358,27 +500,89 @@ CesiumAsync::Future<TileProviderAndTile> RasterOverlayTileProvider::doLoad(
                 RasterOverlayTile::MoreDetailAvailable::No;
             pTile->setState(RasterOverlayTile::LoadState::Failed);
 
+            getTileLoadsCounter(RasterOverlayTile::LoadState::Failed)
+                .increment();
+            recordCompletion(0, false);
             thiz->finalizeTileLoad(isThrottledLoad);
 
             return TileProviderAndTile{thiz, pTile};
           });
 }
 
+int64_t RasterOverlayTileProvider::getCachedDataBytes() const noexcept {
+  return 0;
+}
+
+int64_t RasterOverlayTileProvider::trimCachedData() { return 0; }
+
 void RasterOverlayTileProvider::beginTileLoad(bool isThrottledLoad) noexcept {
+  getTileLoadsInProgressGauge().add(1);
   ++this->_totalTilesCurrentlyLoading;
   if (isThrottledLoad) {
     ++this->_throttledTilesCurrentlyLoading;
   }
 }
 
-void RasterOverlayTileProvider::finalizeTileLoad(
-    bool isThrottledLoad) noexcept {
+void RasterOverlayTileProvider::finalizeTileLoad(bool isThrottledLoad) {
+  getTileLoadsInProgressGauge().add(-1);
   --this->_totalTilesCurrentlyLoading;
   if (isThrottledLoad) {
     --this->_throttledTilesCurrentlyLoading;
+    this->loadPendingTiles();
+  }
+}
+
+void RasterOverlayTileProvider::loadPendingTiles() {
+  // Forget the tiles that have started loading some other way, and the ones
+  // that nothing but this list refers to anymore.
+  auto it = std::remove_if(
+      this->_pendingTiles.begin(),
+      this->_pendingTiles.end(),
+      [](const IntrusivePointer<RasterOverlayTile>& pTile) {
+        if (pTile->getState() == RasterOverlayTile::LoadState::Unloaded &&
+            pTile->getReferenceCount() > 1) {
+          return false;
+        }
+        pTile->_pendingLoadPriority.reset();
+        return true;
+      });
+  this->_pendingTiles.erase(it, this->_pendingTiles.end());
+
+  const int32_t maximumLoads = this->getMaximumSimultaneousTileLoads();
+  while (!this->_pendingTiles.empty() &&
+         this->_throttledTilesCurrentlyLoading < maximumLoads &&
+         !this->isBandwidthExhausted()) {
+    auto next = std::min_element(
+        this->_pendingTiles.begin(),
+        this->_pendingTiles.end(),
+        [](const IntrusivePointer<RasterOverlayTile>& pLeft,
+           const IntrusivePointer<RasterOverlayTile>& pRight) {
+          return *pLeft->_pendingLoadPriority < *pRight->_pendingLoadPriority;
+        });
+
+    std::swap(*next, this->_pendingTiles.back());
+    IntrusivePointer<RasterOverlayTile> pTile =
+        std::move(this->_pendingTiles.back());
+    this->_pendingTiles.pop_back();
+
+    pTile->_pendingLoadPriority.reset();
+    this->doLoad(*pTile, true);
   }
 }
 
+int32_t
+RasterOverlayTileProvider::getMaximumSimultaneousTileLoads() const noexcept {
+  const RasterOverlayOptions& options = this->getOwner().getOptions();
+  return options.pConcurrencyLimiter ? options.pConcurrencyLimiter->getLimit()
+                                     : options.maximumSimultaneousTileLoads;
+}
+
+bool RasterOverlayTileProvider::isBandwidthExhausted() const noexcept {
+  const std::shared_ptr<BandwidthLimiter>& pLimiter =
+      this->getOwner().getOptions().pBandwidthLimiter;
+  return pLimiter && pLimiter->isExhausted();
+}
+
 TileProviderAndTile::~TileProviderAndTile() noexcept {
   // Ensure the tile is released before the tile provider.
   pTile = nullptr;
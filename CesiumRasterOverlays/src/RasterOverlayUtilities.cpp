@@ -5,6 +5,15 @@
 #include <CesiumGltfContent/SkirtMeshMetadata.h>
 #include <CesiumRasterOverlays/RasterOverlayUtilities.h>
 
+#include <glm/vec2.hpp>
+#include <gsl/span>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
 using namespace CesiumGltfContent;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -171,100 +180,141 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
           primitive.attributes[attributeName] = uvAccessorId;
         }
 
-        // Generate texture coordinates for each position.
-        for (int64_t positionIndex = 0; positionIndex < positionView.size();
-             ++positionIndex) {
-          // Get the ECEF position
-          const glm::vec3 position = positionView[positionIndex];
-          const glm::dvec3 positionEcef =
-              glm::dvec3(fullTransform * glm::dvec4(position, 1.0));
-
-          // Convert it to cartographic
-          const std::optional<CesiumGeospatial::Cartographic> cartographic =
-              CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographic(
-                  positionEcef);
-          if (!cartographic) {
-            for (CesiumGltf::AccessorWriter<glm::vec2>& uvWriter : uvWriters) {
-              uvWriter[positionIndex] = glm::dvec2(0.0, 0.0);
-            }
-            continue;
+        // Generate texture coordinates for each position a chunk at a time.
+        // Each chunk is converted to cartographic once with the batch
+        // conversion of the ellipsoid, and then projected with the batch
+        // projection of each raster overlay projection in turn.
+        constexpr int64_t chunkSize = 1024;
+        std::vector<double> xs(chunkSize), ys(chunkSize), zs(chunkSize);
+        std::vector<double> longitudes(chunkSize);
+        std::vector<double> latitudes(chunkSize);
+        std::vector<double> heights(chunkSize);
+        std::vector<double> projectedXs(chunkSize);
+        std::vector<double> projectedYs(chunkSize);
+        for (int64_t chunkBegin = 0; chunkBegin < positionView.size();
+             chunkBegin += chunkSize) {
+          const size_t count = static_cast<size_t>(
+              std::min(chunkSize, positionView.size() - chunkBegin));
+          for (size_t i = 0; i < count; ++i) {
+            // Get the ECEF position
+            const glm::vec3 position =
+                positionView.getUnchecked(chunkBegin + int64_t(i));
+            const glm::dvec3 positionEcef =
+                glm::dvec3(fullTransform * glm::dvec4(position, 1.0));
+            xs[i] = positionEcef.x;
+            ys[i] = positionEcef.y;
+            zs[i] = positionEcef.z;
           }
 
-          // exclude skirt vertices from bounds
-          if (positionIndex >= vertexBegin && positionIndex < vertexEnd) {
-            computedBounds.expandToIncludePosition(*cartographic);
+          // Convert them to cartographic
+          const gsl::span<const double> chunkLongitudes =
+              gsl::span<const double>(longitudes).first(count);
+          const gsl::span<const double> chunkLatitudes =
+              gsl::span<const double>(latitudes).first(count);
+          CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographic(
+              gsl::span<const double>(xs).first(count),
+              gsl::span<const double>(ys).first(count),
+              gsl::span<const double>(zs).first(count),
+              gsl::span<double>(longitudes).first(count),
+              gsl::span<double>(latitudes).first(count),
+              gsl::span<double>(heights).first(count));
+
+          // Positions at the center of the ellipsoid have no cartographic,
+          // and skirt vertices are excluded from the bounds.
+          for (size_t i = 0; i < count; ++i) {
+            const int64_t positionIndex = chunkBegin + int64_t(i);
+            if (!std::isnan(longitudes[i]) && positionIndex >= vertexBegin &&
+                positionIndex < vertexEnd) {
+              computedBounds.expandToIncludePosition(
+                  CesiumGeospatial::Cartographic(
+                      longitudes[i],
+                      latitudes[i],
+                      heights[i]));
+            }
           }
 
-          // Generate texture coordinates at this position for each projection
-          for (size_t projectionIndex = 0; projectionIndex < projections.size();
+          // Generate texture coordinates for the chunk for each projection
+          for (size_t projectionIndex = 0;
+               projectionIndex < projections.size();
                ++projectionIndex) {
             const CesiumGeospatial::Projection& projection =
                 projections[projectionIndex];
             const CesiumGeometry::Rectangle& rectangle =
                 rectangles[projectionIndex];
+            CesiumGltf::AccessorWriter<glm::vec2>& uvWriter =
+                uvWriters[projectionIndex];
+
+            // Project them with the raster overlay's projection
+            projectPositions(
+                projection,
+                chunkLongitudes,
+                chunkLatitudes,
+                gsl::span<double>(projectedXs).first(count),
+                gsl::span<double>(projectedYs).first(count));
+
+            const double width = rectangle.computeWidth();
+            const double height = rectangle.computeHeight();
+            for (size_t i = 0; i < count; ++i) {
+              const int64_t positionIndex = chunkBegin + int64_t(i);
+              if (std::isnan(longitudes[i])) {
+                uvWriter.getUnchecked(positionIndex) = glm::vec2(0.0f, 0.0f);
+                continue;
+              }
 
-            // Project it with the raster overlay's projection
-            glm::dvec3 projectedPosition =
-                projectPosition(projection, cartographic.value());
-
-            double longitude = cartographic.value().longitude;
-            const double latitude = cartographic.value().latitude;
-            const double ellipsoidHeight = cartographic.value().height;
-
-            // If the position is near the anti-meridian and the projected
-            // position is outside the expected range, try using the equivalent
-            // longitude on the other side of the anti-meridian to see if that
-            // gets us closer.
-            if (glm::abs(
-                    glm::abs(cartographic.value().longitude) -
-                    CesiumUtility::Math::OnePi) <
-                    CesiumUtility::Math::Epsilon5 &&
-                (projectedPosition.x < rectangle.minimumX ||
-                 projectedPosition.x > rectangle.maximumX ||
-                 projectedPosition.y < rectangle.minimumY ||
-                 projectedPosition.y > rectangle.maximumY)) {
-              const double testLongitude = longitude + longitude < 0.0
-                                               ? CesiumUtility::Math::TwoPi
-                                               : -CesiumUtility::Math::TwoPi;
-              const glm::dvec3 projectedPosition2 = projectPosition(
-                  projection,
-                  CesiumGeospatial::Cartographic(
-                      testLongitude,
-                      latitude,
-                      ellipsoidHeight));
-
-              const double distance1 = rectangle.computeSignedDistance(
-                  glm::dvec2(projectedPosition));
-              const double distance2 = rectangle.computeSignedDistance(
-                  glm::dvec2(projectedPosition2));
-
-              if (distance2 < distance1) {
-                projectedPosition = projectedPosition2;
-                longitude = testLongitude;
+              glm::dvec2 projectedPosition(projectedXs[i], projectedYs[i]);
+
+              // If the position is near the anti-meridian and the projected
+              // position is outside the expected range, try using the
+              // equivalent longitude on the other side of the anti-meridian to
+              // see if that gets us closer. This is rare, so it is done one
+              // position at a time.
+              const double longitude = longitudes[i];
+              if (glm::abs(glm::abs(longitude) - CesiumUtility::Math::OnePi) <
+                      CesiumUtility::Math::Epsilon5 &&
+                  (projectedPosition.x < rectangle.minimumX ||
+                   projectedPosition.x > rectangle.maximumX ||
+                   projectedPosition.y < rectangle.minimumY ||
+                   projectedPosition.y > rectangle.maximumY)) {
+                const double testLongitude = longitude + longitude < 0.0
+                                                 ? CesiumUtility::Math::TwoPi
+                                                 : -CesiumUtility::Math::TwoPi;
+                const glm::dvec2 projectedPosition2(projectPosition(
+                    projection,
+                    CesiumGeospatial::Cartographic(
+                        testLongitude,
+                        latitudes[i],
+                        heights[i])));
+
+                const double distance1 =
+                    rectangle.computeSignedDistance(projectedPosition);
+                const double distance2 =
+                    rectangle.computeSignedDistance(projectedPosition2);
+
+                if (distance2 < distance1) {
+                  projectedPosition = projectedPosition2;
+                }
               }
-            }
 
-            // Scale to (0.0, 0.0) at the (minimumX, minimumY) corner, and
-            // (1.0, 1.0) at the (maximumX, maximumY) corner. The coordinates
-            // should stay inside these bounds if the input rectangle actually
-            // bounds the vertices, but we'll clamp to be safe.
-            glm::vec2 uv(
-                CesiumUtility::Math::clamp(
-                    (projectedPosition.x - rectangle.minimumX) /
-                        rectangle.computeWidth(),
-                    0.0,
-                    1.0),
-                CesiumUtility::Math::clamp(
-                    (projectedPosition.y - rectangle.minimumY) /
-                        rectangle.computeHeight(),
-                    0.0,
-                    1.0));
-
-            if (invertVCoordinate) {
-              uv.y = 1.0f - uv.y;
-            }
+              // Scale to (0.0, 0.0) at the (minimumX, minimumY) corner, and
+              // (1.0, 1.0) at the (maximumX, maximumY) corner. The coordinates
+              // should stay inside these bounds if the input rectangle actually
+              // bounds the vertices, but we'll clamp to be safe.
+              glm::vec2 uv(
+                  CesiumUtility::Math::clamp(
+                      (projectedPosition.x - rectangle.minimumX) / width,
+                      0.0,
+                      1.0),
+                  CesiumUtility::Math::clamp(
+                      (projectedPosition.y - rectangle.minimumY) / height,
+                      0.0,
+                      1.0));
+
+              if (invertVCoordinate) {
+                uv.y = 1.0f - uv.y;
+              }
 
-            uvWriters[projectionIndex][positionIndex] = uv;
+              uvWriter.getUnchecked(positionIndex) = uv;
+            }
           }
         }
       };
@@ -339,4 +389,154 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
   return glm::dvec4(translation, scale);
 }
 
+/*static*/ std::optional<RasterOverlayAtlas>
+RasterOverlayUtilities::createAtlas(
+    const std::vector<const CesiumGltf::ImageCesium*>& images,
+    int32_t padding,
+    int32_t maximumSize) {
+  if (images.empty() || padding < 0) {
+    return std::nullopt;
+  }
+
+  const CesiumGltf::ImageCesium& first = *images[0];
+  size_t totalArea = 0;
+  int32_t widestImage = 0;
+  for (const CesiumGltf::ImageCesium* pImage : images) {
+    const CesiumGltf::ImageCesium& image = *pImage;
+    if (image.compressedPixelFormat !=
+            CesiumGltf::GpuCompressedPixelFormat::NONE ||
+        image.channels != first.channels ||
+        image.bytesPerChannel != first.bytesPerChannel || image.width <= 0 ||
+        image.height <= 0 ||
+        image.pixelData.size() <
+            size_t(image.width) * size_t(image.height) *
+                size_t(image.channels) * size_t(image.bytesPerChannel)) {
+      return std::nullopt;
+    }
+
+    const int32_t width = image.width + 2 * padding;
+    const int32_t height = image.height + 2 * padding;
+    totalArea += size_t(width) * size_t(height);
+    widestImage = std::max(widestImage, width);
+  }
+
+  // Place the images in rows, tallest first, so that each row wastes little
+  // space below its shorter images.
+  std::vector<size_t> order(images.size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::stable_sort(
+      order.begin(),
+      order.end(),
+      [&images](size_t left, size_t right) {
+        return images[left]->height > images[right]->height;
+      });
+
+  const int32_t atlasWidth = std::max(
+      widestImage,
+      int32_t(std::ceil(std::sqrt(double(totalArea)))));
+  std::vector<glm::ivec2> positions(images.size());
+  int32_t x = 0;
+  int32_t y = 0;
+  int32_t rowHeight = 0;
+  for (size_t i : order) {
+    const int32_t width = images[i]->width + 2 * padding;
+    const int32_t height = images[i]->height + 2 * padding;
+    if (x + width > atlasWidth) {
+      x = 0;
+      y += rowHeight;
+      rowHeight = 0;
+    }
+
+    positions[i] = glm::ivec2(x, y);
+    x += width;
+    rowHeight = std::max(rowHeight, height);
+  }
+
+  const int32_t atlasHeight = y + rowHeight;
+  if (atlasWidth > maximumSize || atlasHeight > maximumSize) {
+    return std::nullopt;
+  }
+
+  RasterOverlayAtlas atlas;
+  CesiumGltf::ImageCesium& target = atlas.image;
+  target.width = atlasWidth;
+  target.height = atlasHeight;
+  target.channels = first.channels;
+  target.bytesPerChannel = first.bytesPerChannel;
+  const size_t pixelSize =
+      size_t(target.channels) * size_t(target.bytesPerChannel);
+  const size_t targetStride = size_t(atlasWidth) * pixelSize;
+  target.pixelData.resize(targetStride * size_t(atlasHeight));
+
+  atlas.regions.reserve(images.size());
+  for (size_t i = 0; i < images.size(); ++i) {
+    const CesiumGltf::ImageCesium& source = *images[i];
+    const size_t sourceStride = size_t(source.width) * pixelSize;
+    const size_t left = size_t(positions[i].x);
+    const size_t top = size_t(positions[i].y);
+    const size_t pad = size_t(padding);
+    const size_t paddedRowSize = sourceStride + 2 * pad * pixelSize;
+
+    // Copy each row along with copies of its first and last pixels.
+    for (size_t row = 0; row < size_t(source.height); ++row) {
+      const std::byte* pSource = source.pixelData.data() + row * sourceStride;
+      std::byte* pTarget = target.pixelData.data() +
+                           (top + pad + row) * targetStride +
+                           left * pixelSize;
+      for (size_t j = 0; j < pad; ++j) {
+        std::memcpy(pTarget + j * pixelSize, pSource, pixelSize);
+        std::memcpy(
+            pTarget + (pad + size_t(source.width) + j) * pixelSize,
+            pSource + sourceStride - pixelSize,
+            pixelSize);
+      }
+      std::memcpy(pTarget + pad * pixelSize, pSource, sourceStride);
+    }
+
+    // Copy the first and last padded rows above and below the image.
+    const std::byte* pFirstRow = target.pixelData.data() +
+                                 (top + pad) * targetStride + left * pixelSize;
+    const std::byte* pLastRow =
+        pFirstRow + (size_t(source.height) - 1) * targetStride;
+    for (size_t j = 0; j < pad; ++j) {
+      std::memcpy(
+          target.pixelData.data() + (top + j) * targetStride +
+              left * pixelSize,
+          pFirstRow,
+          paddedRowSize);
+      std::memcpy(
+          target.pixelData.data() +
+              (top + pad + size_t(source.height) + j) * targetStride +
+              left * pixelSize,
+          pLastRow,
+          paddedRowSize);
+    }
+
+    // Rows go from north to south, but texture coordinates go from south to
+    // north.
+    const double west = double(positions[i].x + padding) / double(atlasWidth);
+    const double north =
+        1.0 - double(positions[i].y + padding) / double(atlasHeight);
+    atlas.regions.emplace_back(
+        west,
+        north - double(source.height) / double(atlasHeight),
+        west + double(source.width) / double(atlasWidth),
+        north);
+  }
+
+  return atlas;
+}
+
+/*static*/ glm::dvec4 RasterOverlayUtilities::computeAtlasTranslationAndScale(
+    const glm::dvec4& translationAndScale,
+    const Rectangle& region) {
+  const glm::dvec2 regionSize(region.computeWidth(), region.computeHeight());
+  const glm::dvec2 translation =
+      glm::dvec2(region.minimumX, region.minimumY) +
+      glm::dvec2(translationAndScale.x, translationAndScale.y) * regionSize;
+  const glm::dvec2 scale =
+      glm::dvec2(translationAndScale.z, translationAndScale.w) * regionSize;
+  return glm::dvec4(translation, scale);
+}
+
 } // namespace CesiumRasterOverlays
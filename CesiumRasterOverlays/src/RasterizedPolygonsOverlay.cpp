@@ -5,11 +5,16 @@
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
 #include <CesiumRasterOverlays/RasterizedPolygonsOverlay.h>
 #include <CesiumUtility/IntrusivePointer.h>
+#include <CesiumUtility/PixelBufferPool.h>
 
 #include <spdlog/fwd.h>
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -17,140 +22,230 @@ using namespace CesiumUtility;
 
 namespace CesiumRasterOverlays {
 namespace {
-void rasterizePolygons(
-    LoadedRasterOverlayImage& loaded,
+// The number of image rows rasterized by each worker thread task.
+constexpr size_t rowsPerTask = 64;
+
+// A tile image whose rows remain to be rasterized, once it is known that the
+// tile is neither completely inside nor completely outside the polygons.
+struct PendingRasterization {
+  LoadedRasterOverlayImage loaded;
+  CesiumGeospatial::GlobeRectangle rectangle;
+  std::shared_ptr<const std::vector<std::array<glm::dvec2, 3>>> pTriangles;
+  std::byte insideColor;
+  std::byte outsideColor;
+};
+
+// Creates the mask image of a tile, which is complete unless the tile is
+// partially covered by the polygons, in which case the triangles to rasterize
+// are returned as well.
+PendingRasterization prepareMask(
     const CesiumGeospatial::GlobeRectangle& rectangle,
     const glm::dvec2& textureSize,
-    const std::vector<CartographicPolygon>& cartographicPolygons,
+    const CartographicPolygonIndex& polygonIndex,
     bool invertSelection) {
-
+  PendingRasterization pending{
+      LoadedRasterOverlayImage(),
+      rectangle,
+      nullptr,
+      static_cast<std::byte>(0),
+      static_cast<std::byte>(0)};
+  LoadedRasterOverlayImage& loaded = pending.loaded;
   CesiumGltf::ImageCesium& image = loaded.image.emplace();
 
-  std::byte insideColor;
-  std::byte outsideColor;
-
   if (invertSelection) {
-    insideColor = static_cast<std::byte>(0);
-    outsideColor = static_cast<std::byte>(0xff);
+    pending.insideColor = static_cast<std::byte>(0);
+    pending.outsideColor = static_cast<std::byte>(0xff);
   } else {
-    insideColor = static_cast<std::byte>(0xff);
-    outsideColor = static_cast<std::byte>(0);
+    pending.insideColor = static_cast<std::byte>(0xff);
+    pending.outsideColor = static_cast<std::byte>(0);
   }
 
+  // The mask has a single 8-bit channel.
+  image.channels = 1;
+  image.bytesPerChannel = 1;
+
   // create a 1x1 mask if the rectangle is completely inside a polygon
-  if (CartographicPolygon::rectangleIsWithinPolygons(
-          rectangle,
-          cartographicPolygons)) {
+  if (polygonIndex.rectangleIsWithinPolygons(rectangle)) {
     loaded.moreDetailAvailable = false;
     image.width = 1;
     image.height = 1;
-    image.channels = 1;
-    image.bytesPerChannel = 1;
-    image.pixelData.resize(1, insideColor);
-    return;
-  }
-
-  bool completelyOutsidePolygons = true;
-  for (const CartographicPolygon& selection : cartographicPolygons) {
-    const std::optional<CesiumGeospatial::GlobeRectangle>& boundingRectangle =
-        selection.getBoundingRectangle();
-
-    if (boundingRectangle &&
-        rectangle.computeIntersection(*boundingRectangle)) {
-      completelyOutsidePolygons = false;
-      break;
-    }
+    image.pixelData.resize(1, pending.insideColor);
+    return pending;
   }
 
   // create a 1x1 mask if the rectangle is completely outside all polygons
-  if (completelyOutsidePolygons) {
+  if (!polygonIndex.anyBoundingRectangleIntersects(rectangle)) {
     loaded.moreDetailAvailable = false;
     image.width = 1;
     image.height = 1;
-    image.channels = 1;
-    image.bytesPerChannel = 1;
-    image.pixelData.resize(1, outsideColor);
-    return;
+    image.pixelData.resize(1, pending.outsideColor);
+    return pending;
   }
 
-  const double rectangleWidth = rectangle.computeWidth();
-  const double rectangleHeight = rectangle.computeHeight();
-
   // create source image
   loaded.moreDetailAvailable = true;
   image.width = int32_t(glm::round(textureSize.x));
   image.height = int32_t(glm::round(textureSize.y));
-  image.channels = 1;
-  image.bytesPerChannel = 1;
-  image.pixelData.resize(size_t(image.width * image.height), outsideColor);
-
-  // TODO: this is naive approach, use line-triangle
-  // intersections to rasterize one row at a time
-  // NOTE: also completely ignores antimeridian (really these
-  // calculations should be normalized to the first vertex)
-  for (const CartographicPolygon& polygon : cartographicPolygons) {
-    const std::vector<glm::dvec2>& vertices = polygon.getVertices();
-    const std::vector<uint32_t>& indices = polygon.getIndices();
-    for (size_t triangle = 0; triangle < indices.size() / 3; ++triangle) {
-      const glm::dvec2& a = vertices[indices[3 * triangle]];
-      const glm::dvec2& b = vertices[indices[3 * triangle + 1]];
-      const glm::dvec2& c = vertices[indices[3 * triangle + 2]];
-
-      // TODO: deal with the corner cases here
-      const double minX = glm::min(a.x, glm::min(b.x, c.x));
-      const double minY = glm::min(a.y, glm::min(b.y, c.y));
-      const double maxX = glm::max(a.x, glm::max(b.x, c.x));
-      const double maxY = glm::max(a.y, glm::max(b.y, c.y));
-
-      const CesiumGeospatial::GlobeRectangle triangleBounds(
-          minX,
-          minY,
-          maxX,
-          maxY);
-
-      // skip this triangle if it is entirely outside the tile bounds
-      if (!rectangle.computeIntersection(triangleBounds)) {
+
+  if (image.width > 0 && image.height > 0 && rectangle.computeWidth() > 0.0 &&
+      rectangle.computeHeight() > 0.0) {
+    pending.pTriangles =
+        std::make_shared<const std::vector<std::array<glm::dvec2, 3>>>(
+            polygonIndex.findTriangles(rectangle));
+  } else {
+    image.pixelData = CesiumUtility::PixelBufferPool::getDefault().acquire(
+        size_t(image.width * image.height));
+    std::fill(
+        image.pixelData.begin(),
+        image.pixelData.end(),
+        pending.outsideColor);
+  }
+
+  return pending;
+}
+
+// Finds the range of pixel indices whose centers may be between two
+// coordinates, given as fractions of the image size, with a margin of a pixel
+// for rounding. The range is empty if its end is less than its start.
+std::pair<int64_t, int64_t>
+computePixelRange(double minimum, double maximum, size_t pixelCount) {
+  const double last = double(pixelCount) - 1.0;
+  const double start = glm::clamp(
+      glm::floor(minimum * double(pixelCount) - 0.5) - 1.0,
+      0.0,
+      last + 1.0);
+  const double end = glm::clamp(
+      glm::ceil(maximum * double(pixelCount) - 0.5) + 1.0,
+      -1.0,
+      last);
+  return std::make_pair(int64_t(start), int64_t(end));
+}
+
+// Rasterizes a band of rows of a mask image one row at a time. Each row is
+// intersected with the triangles that span it, and the pixels whose centers
+// are between the intersections are filled.
+//
+// NOTE: this completely ignores the antimeridian (really these calculations
+// should be normalized to the first vertex)
+std::vector<std::byte> rasterizeRows(
+    const CesiumGeospatial::GlobeRectangle& rectangle,
+    size_t width,
+    size_t height,
+    const std::vector<std::array<glm::dvec2, 3>>& triangles,
+    std::byte insideColor,
+    std::byte outsideColor,
+    size_t firstRow,
+    size_t rowCount) {
+  std::vector<std::byte> pixels(width * rowCount, outsideColor);
+
+  const double rectangleWidth = rectangle.computeWidth();
+  const double rectangleHeight = rectangle.computeHeight();
+
+  // The triangles that span any row of the band, with the rows they span,
+  // ordered by their first row. Rows go from north to south.
+  struct ActiveTriangle {
+    int64_t firstRow;
+    int64_t lastRow;
+    const std::array<glm::dvec2, 3>* pTriangle;
+  };
+  std::vector<ActiveTriangle> bandTriangles;
+  for (const std::array<glm::dvec2, 3>& triangle : triangles) {
+    const double minY =
+        glm::min(triangle[0].y, glm::min(triangle[1].y, triangle[2].y));
+    const double maxY =
+        glm::max(triangle[0].y, glm::max(triangle[1].y, triangle[2].y));
+    const auto [first, last] = computePixelRange(
+        (rectangle.getNorth() - maxY) / rectangleHeight,
+        (rectangle.getNorth() - minY) / rectangleHeight,
+        height);
+    if (last < int64_t(firstRow) || first >= int64_t(firstRow + rowCount) ||
+        last < first) {
+      continue;
+    }
+
+    bandTriangles.push_back({first, last, &triangle});
+  }
+
+  std::sort(
+      bandTriangles.begin(),
+      bandTriangles.end(),
+      [](const ActiveTriangle& a, const ActiveTriangle& b) {
+        return a.firstRow < b.firstRow;
+      });
+
+  std::vector<ActiveTriangle> active;
+  size_t nextTriangle = 0;
+  for (size_t j = firstRow; j < firstRow + rowCount; ++j) {
+    const int64_t row = int64_t(j);
+    active.erase(
+        std::remove_if(
+            active.begin(),
+            active.end(),
+            [row](const ActiveTriangle& triangle) {
+              return triangle.lastRow < row;
+            }),
+        active.end());
+    while (nextTriangle < bandTriangles.size() &&
+           bandTriangles[nextTriangle].firstRow <= row) {
+      active.emplace_back(bandTriangles[nextTriangle++]);
+    }
+
+    const double pixelY =
+        rectangle.getSouth() +
+        rectangleHeight * (1.0 - (double(j) + 0.5) / double(height));
+    std::byte* pRow = pixels.data() + width * (j - firstRow);
+
+    for (const ActiveTriangle& activeTriangle : active) {
+      const std::array<glm::dvec2, 3>& triangle = *activeTriangle.pTriangle;
+
+      // Find the span of the row that is inside the triangle, including its
+      // edges.
+      double spanMinimum = std::numeric_limits<double>::max();
+      double spanMaximum = std::numeric_limits<double>::lowest();
+      for (size_t k = 0; k < 3; ++k) {
+        const glm::dvec2& a = triangle[k];
+        const glm::dvec2& b = triangle[(k + 1) % 3];
+        if (pixelY < glm::min(a.y, b.y) || pixelY > glm::max(a.y, b.y)) {
+          continue;
+        }
+
+        if (a.y == b.y) {
+          spanMinimum = glm::min(spanMinimum, glm::min(a.x, b.x));
+          spanMaximum = glm::max(spanMaximum, glm::max(a.x, b.x));
+        } else {
+          const double x = a.x + (pixelY - a.y) / (b.y - a.y) * (b.x - a.x);
+          spanMinimum = glm::min(spanMinimum, x);
+          spanMaximum = glm::max(spanMaximum, x);
+        }
+      }
+
+      if (spanMaximum < spanMinimum) {
         continue;
       }
 
-      const glm::dvec2 ab = b - a;
-      const glm::dvec2 ab_perp(-ab.y, ab.x);
-      const glm::dvec2 bc = c - b;
-      const glm::dvec2 bc_perp(-bc.y, bc.x);
-      const glm::dvec2 ca = a - c;
-      const glm::dvec2 ca_perp(-ca.y, ca.x);
-
-      size_t width = size_t(image.width);
-      size_t height = size_t(image.height);
-
-      for (size_t j = 0; j < height; ++j) {
-        const double pixelY =
-            rectangle.getSouth() +
-            rectangleHeight * (1.0 - (double(j) + 0.5) / double(height));
-        for (size_t i = 0; i < width; ++i) {
-          const double pixelX = rectangle.getWest() + rectangleWidth *
-                                                          (double(i) + 0.5) /
-                                                          double(width);
-          const glm::dvec2 v(pixelX, pixelY);
-
-          const glm::dvec2 av = v - a;
-          const glm::dvec2 cv = v - c;
-
-          const double v_proj_ab_perp = glm::dot(av, ab_perp);
-          const double v_proj_bc_perp = glm::dot(cv, bc_perp);
-          const double v_proj_ca_perp = glm::dot(cv, ca_perp);
-
-          // will determine in or out, irrespective of winding
-          if ((v_proj_ab_perp >= 0.0 && v_proj_ca_perp >= 0.0 &&
-               v_proj_bc_perp >= 0.0) ||
-              (v_proj_ab_perp <= 0.0 && v_proj_ca_perp <= 0.0 &&
-               v_proj_bc_perp <= 0.0)) {
-            image.pixelData[width * j + i] = insideColor;
-          }
-        }
+      // Fill the pixels whose centers are within the span.
+      const double firstColumn = glm::ceil(
+          (spanMinimum - rectangle.getWest()) / rectangleWidth *
+              double(width) -
+          0.5);
+      const double lastColumn = glm::floor(
+          (spanMaximum - rectangle.getWest()) / rectangleWidth *
+              double(width) -
+          0.5);
+      const double clampedFirst = glm::max(firstColumn, 0.0);
+      const double clampedLast = glm::min(lastColumn, double(width) - 1.0);
+      if (clampedLast < clampedFirst) {
+        continue;
       }
+
+      std::fill(
+          pRow + size_t(clampedFirst),
+          pRow + size_t(clampedLast) + 1,
+          insideColor);
     }
   }
+
+  return pixels;
 }
 } // namespace
 
@@ -158,7 +253,7 @@ class CESIUMRASTEROVERLAYS_API RasterizedPolygonsTileProvider final
     : public RasterOverlayTileProvider {
 
 private:
-  std::vector<CartographicPolygon> _polygons;
+  std::shared_ptr<const CartographicPolygonIndex> _pPolygonIndex;
   bool _invertSelection;
 
 public:
@@ -170,7 +265,7 @@ public:
           pPrepareRendererResources,
       const std::shared_ptr<spdlog::logger>& pLogger,
       const CesiumGeospatial::Projection& projection,
-      const std::vector<CartographicPolygon>& polygons,
+      const std::shared_ptr<const CartographicPolygonIndex>& pPolygonIndex,
       bool invertSelection)
       : RasterOverlayTileProvider(
             pOwner,
@@ -188,8 +283,11 @@ public:
                     -CesiumUtility::Math::PiOverTwo,
                     CesiumUtility::Math::OnePi,
                     CesiumUtility::Math::PiOverTwo))),
-        _polygons(polygons),
-        _invertSelection(invertSelection) {}
+        _pPolygonIndex(pPolygonIndex),
+        _invertSelection(invertSelection) {
+    // The masks are single-channel coverage values.
+    this->setOutputChannels(1);
+  }
 
   virtual CesiumAsync::Future<LoadedRasterOverlayImage>
   loadTileImage(RasterOverlayTile& overlayTile) override {
@@ -200,26 +298,76 @@ public:
         overlayTile.getTargetScreenPixels() / options.maximumScreenSpaceError,
         glm::dvec2(options.maximumTextureSize));
 
-    return this->getAsyncSystem().runInWorkerThread(
-        [&polygons = this->_polygons,
-         invertSelection = this->_invertSelection,
-         projection = this->getProjection(),
-         rectangle = overlayTile.getRectangle(),
-         textureSize]() -> LoadedRasterOverlayImage {
-          const CesiumGeospatial::GlobeRectangle tileRectangle =
-              CesiumGeospatial::unprojectRectangleSimple(projection, rectangle);
-
-          LoadedRasterOverlayImage result;
-          result.rectangle = rectangle;
-
-          rasterizePolygons(
-              result,
-              tileRectangle,
-              textureSize,
-              polygons,
-              invertSelection);
-
-          return result;
+    const CesiumAsync::AsyncSystem& asyncSystem = this->getAsyncSystem();
+    return asyncSystem
+        .runInWorkerThread(
+            [pPolygonIndex = this->_pPolygonIndex,
+             invertSelection = this->_invertSelection,
+             projection = this->getProjection(),
+             rectangle = overlayTile.getRectangle(),
+             textureSize]() {
+              PendingRasterization pending = prepareMask(
+                  CesiumGeospatial::unprojectRectangleSimple(
+                      projection,
+                      rectangle),
+                  textureSize,
+                  *pPolygonIndex,
+                  invertSelection);
+              pending.loaded.rectangle = rectangle;
+              return pending;
+            })
+        .thenImmediately([asyncSystem](PendingRasterization&& pending) {
+          if (!pending.pTriangles) {
+            return asyncSystem.createResolvedFuture(std::move(pending.loaded));
+          }
+
+          // Rasterize bands of rows in parallel.
+          const CesiumGltf::ImageCesium& image = *pending.loaded.image;
+          const size_t width = size_t(image.width);
+          const size_t height = size_t(image.height);
+          std::vector<CesiumAsync::Future<std::vector<std::byte>>> bands;
+          for (size_t firstRow = 0; firstRow < height;
+               firstRow += rowsPerTask) {
+            bands.emplace_back(asyncSystem.runInWorkerThread(
+                [rectangle = pending.rectangle,
+                 width,
+                 height,
+                 pTriangles = pending.pTriangles,
+                 insideColor = pending.insideColor,
+                 outsideColor = pending.outsideColor,
+                 firstRow,
+                 rowCount = glm::min(rowsPerTask, height - firstRow)]() {
+                  return rasterizeRows(
+                      rectangle,
+                      width,
+                      height,
+                      *pTriangles,
+                      insideColor,
+                      outsideColor,
+                      firstRow,
+                      rowCount);
+                }));
+          }
+
+          return asyncSystem.all(std::move(bands))
+              .thenImmediately(
+                  [loaded = std::move(pending.loaded)](
+                      std::vector<std::vector<std::byte>>&& rows) mutable {
+                    size_t byteCount = 0;
+                    for (const std::vector<std::byte>& band : rows) {
+                      byteCount += band.size();
+                    }
+
+                    std::vector<std::byte> pixelData =
+                        CesiumUtility::PixelBufferPool::getDefault().acquire(
+                            byteCount);
+                    auto it = pixelData.begin();
+                    for (const std::vector<std::byte>& band : rows) {
+                      it = std::copy(band.begin(), band.end(), it);
+                    }
+                    loaded.image->pixelData = std::move(pixelData);
+                    return std::move(loaded);
+                  });
         });
   }
 };
@@ -232,7 +380,8 @@ RasterizedPolygonsOverlay::RasterizedPolygonsOverlay(
     const CesiumGeospatial::Projection& projection,
     const RasterOverlayOptions& overlayOptions)
     : RasterOverlay(name, overlayOptions),
-      _polygons(polygons),
+      _pPolygonIndex(
+          std::make_shared<const CartographicPolygonIndex>(polygons)),
       _invertSelection(invertSelection),
       _ellipsoid(ellipsoid),
       _projection(projection) {}
@@ -260,7 +409,7 @@ RasterizedPolygonsOverlay::createTileProvider(
               pPrepareRendererResources,
               pLogger,
               this->_projection,
-              this->_polygons,
+              this->_pPolygonIndex,
               this->_invertSelection)));
 }
 
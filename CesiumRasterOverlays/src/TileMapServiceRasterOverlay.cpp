@@ -1,3 +1,5 @@
+#include "RasterOverlayMetadataCache.h"
+
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
@@ -114,11 +116,13 @@ TileMapServiceRasterOverlay::TileMapServiceRasterOverlay(
     const std::string& url,
     const std::vector<IAssetAccessor::THeader>& headers,
     const TileMapServiceRasterOverlayOptions& tmsOptions,
-    const RasterOverlayOptions& overlayOptions)
+    const RasterOverlayOptions& overlayOptions,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pMetadataCacheDatabase)
     : RasterOverlay(name, overlayOptions),
       _url(url),
       _headers(headers),
-      _options(tmsOptions) {}
+      _options(tmsOptions),
+      _pMetadataCacheDatabase(pMetadataCacheDatabase) {}
 
 TileMapServiceRasterOverlay::~TileMapServiceRasterOverlay() {}
 
@@ -163,14 +167,71 @@ using GetXmlDocumentResult = nonstd::expected<
     std::unique_ptr<tinyxml2::XMLDocument>,
     RasterOverlayLoadFailureDetails>;
 
-Future<GetXmlDocumentResult> getXmlDocument(
+// Parses and checks a Tile Map Service XML document, returning nullptr and
+// setting the error message if it is not usable.
+std::unique_ptr<tinyxml2::XMLDocument> parseXmlDocument(
+    const gsl::span<const std::byte>& data,
+    std::string& errorMessage) {
+  std::unique_ptr<tinyxml2::XMLDocument> pDoc =
+      std::make_unique<tinyxml2::XMLDocument>();
+  const tinyxml2::XMLError error = pDoc->Parse(
+      reinterpret_cast<const char*>(data.data()),
+      data.size_bytes());
+
+  if (error != tinyxml2::XMLError::XML_SUCCESS) {
+    errorMessage = "Unable to parse Tile map service XML document.";
+    return nullptr;
+  }
+
+  tinyxml2::XMLElement* pRoot = pDoc->RootElement();
+  if (!pRoot) {
+    errorMessage = "Tile map service XML document does not have a root "
+                   "element.";
+    return nullptr;
+  }
+
+  bool hasError = false;
+  tinyxml2::XMLElement* pTilesets = pRoot->FirstChildElement("TileSets");
+  if (!pTilesets) {
+    hasError = true;
+    errorMessage = "Tile map service XML document does not have "
+                   "any tilesets.";
+  }
+  tinyxml2::XMLElement* srs = pRoot->FirstChildElement("SRS");
+  if (srs) {
+    std::string srsText = srs->GetText();
+    if (srsText.find("4326") == std::string::npos &&
+        srsText.find("3857") == std::string::npos &&
+        srsText.find("900913") == std::string::npos) {
+      hasError = true;
+      errorMessage = srsText + " is not supported.";
+    }
+  } else {
+    hasError = true;
+    errorMessage = "Tile map service XML document does not have an SRS.";
+  }
+
+  if (hasError) {
+    return nullptr;
+  }
+
+  return pDoc;
+}
+
+// Requests the XML document at a URL, falling back to the
+// tilemapresource.xml next to it. A usable document is stored in the cache
+// database under the URL that was originally asked for, so that the fallback
+// request is not needed in later sessions either.
+Future<GetXmlDocumentResult> requestXmlDocument(
     const CesiumAsync::AsyncSystem& asyncSystem,
     const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
+    const std::string& cacheUrl,
     const std::string& url,
     const std::vector<IAssetAccessor::THeader>& headers) {
   return pAssetAccessor->get(asyncSystem, url, headers)
       .thenInWorkerThread(
-          [asyncSystem, pAssetAccessor, url, headers](
+          [asyncSystem, pAssetAccessor, pCacheDatabase, cacheUrl, url, headers](
               std::shared_ptr<IAssetRequest>&& pRequest)
               -> Future<GetXmlDocumentResult> {
             const IAssetResponse* pResponse = pRequest->response();
@@ -184,60 +245,20 @@ Future<GetXmlDocumentResult> getXmlDocument(
 
             const gsl::span<const std::byte> data = pResponse->data();
 
-            std::unique_ptr<tinyxml2::XMLDocument> pDoc =
-                std::make_unique<tinyxml2::XMLDocument>(
-                    new tinyxml2::XMLDocument());
-            const tinyxml2::XMLError error = pDoc->Parse(
-                reinterpret_cast<const char*>(data.data()),
-                data.size_bytes());
-
-            bool hasError = false;
             std::string errorMessage;
-
-            if (error != tinyxml2::XMLError::XML_SUCCESS) {
-              hasError = true;
-              errorMessage = "Unable to parse Tile map service XML document.";
-            } else {
-              tinyxml2::XMLElement* pRoot = pDoc->RootElement();
-              if (!pRoot) {
-                hasError = true;
-                errorMessage =
-                    "Tile map service XML document does not have a root "
-                    "element.";
-              } else {
-                tinyxml2::XMLElement* pTilesets =
-                    pRoot->FirstChildElement("TileSets");
-
-                if (!pTilesets) {
-                  hasError = true;
-                  errorMessage = "Tile map service XML document does not have "
-                                 "any tilesets.";
-                }
-                tinyxml2::XMLElement* srs = pRoot->FirstChildElement("SRS");
-                if (srs) {
-                  std::string srsText = srs->GetText();
-                  if (srsText.find("4326") == std::string::npos &&
-                      srsText.find("3857") == std::string::npos &&
-                      srsText.find("900913") == std::string::npos) {
-                    hasError = true;
-                    errorMessage = srsText + " is not supported.";
-                  }
-                } else {
-                  hasError = true;
-                  errorMessage =
-                      "Tile map service XML document does not have an SRS.";
-                }
-              }
-            }
-            if (hasError) {
+            std::unique_ptr<tinyxml2::XMLDocument> pDoc =
+                parseXmlDocument(data, errorMessage);
+            if (!pDoc) {
               if (url.find("tilemapresource.xml") == std::string::npos) {
                 std::string baseUrl = url;
                 if (baseUrl.size() > 0 && baseUrl[baseUrl.size() - 1] != '/') {
                   baseUrl += '/';
                 }
-                return getXmlDocument(
+                return requestXmlDocument(
                     asyncSystem,
                     pAssetAccessor,
+                    pCacheDatabase,
+                    cacheUrl,
                     CesiumUtility::Uri::resolve(baseUrl, "tilemapresource.xml"),
                     headers);
               } else {
@@ -249,11 +270,54 @@ Future<GetXmlDocumentResult> getXmlDocument(
               }
             }
 
+            storeCachedMetadata(asyncSystem, pCacheDatabase, cacheUrl, data);
+
             return asyncSystem.createResolvedFuture<GetXmlDocumentResult>(
                 std::move(pDoc));
           });
 }
 
+Future<GetXmlDocumentResult> getXmlDocument(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers) {
+  if (!pCacheDatabase) {
+    return requestXmlDocument(
+        asyncSystem,
+        pAssetAccessor,
+        nullptr,
+        url,
+        url,
+        headers);
+  }
+
+  return getCachedMetadata(asyncSystem, pCacheDatabase, url)
+      .thenInWorkerThread(
+          [asyncSystem, pAssetAccessor, pCacheDatabase, url, headers](
+              std::optional<std::vector<std::byte>>&& maybeCached)
+              -> Future<GetXmlDocumentResult> {
+            if (maybeCached) {
+              std::string errorMessage;
+              std::unique_ptr<tinyxml2::XMLDocument> pDoc =
+                  parseXmlDocument(*maybeCached, errorMessage);
+              if (pDoc) {
+                return asyncSystem.createResolvedFuture<GetXmlDocumentResult>(
+                    std::move(pDoc));
+              }
+            }
+
+            return requestXmlDocument(
+                asyncSystem,
+                pAssetAccessor,
+                pCacheDatabase,
+                url,
+                url,
+                headers);
+          });
+}
+
 } // namespace
 
 Future<RasterOverlay::CreateTileProviderResult>
@@ -275,8 +339,15 @@ TileMapServiceRasterOverlay::createTileProvider(
                                   pOwner->getOptions().showCreditsOnScreen))
                             : std::nullopt;
 
-  return getXmlDocument(asyncSystem, pAssetAccessor, xmlUrl, this->_headers)
-      .thenInMainThread(
+  return getXmlDocument(
+             asyncSystem,
+             pAssetAccessor,
+             this->_pMetadataCacheDatabase,
+             xmlUrl,
+             this->_headers)
+      // The tile provider's reference counts are thread-safe, so it can be
+      // created along with parsing the document in a worker thread.
+      .thenInWorkerThread(
           [pOwner,
            asyncSystem,
            pAssetAccessor,
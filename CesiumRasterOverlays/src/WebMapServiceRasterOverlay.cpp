@@ -1,8 +1,12 @@
+#include "RasterOverlayMetadataCache.h"
+
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/SharedFuture.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
 #include <CesiumGeospatial/Projection.h>
 #include <CesiumGeospatial/WebMercatorProjection.h>
+#include <CesiumGltfContent/ImageManipulation.h>
 #include <CesiumRasterOverlays/QuadtreeRasterOverlayTileProvider.h>
 #include <CesiumRasterOverlays/RasterOverlayLoadFailureDetails.h>
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
@@ -12,16 +16,79 @@
 
 #include <tinyxml2.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <sstream>
 
 using namespace CesiumAsync;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
 using namespace CesiumUtility;
 
 namespace CesiumRasterOverlays {
 
+namespace {
+
+// The largest number of multi-tile images that are kept while they wait for
+// the rest of their tiles to be requested.
+constexpr size_t MAXIMUM_PENDING_BLOCKS = 8;
+
+// Creates the image of one tile of a block of tilesPerAxis x tilesPerAxis
+// tiles that was loaded with a single request. The column and row count from
+// the north-west tile of the block, because image rows go from north to south.
+LoadedRasterOverlayImage cropBlockImage(
+    const LoadedRasterOverlayImage& block,
+    const Rectangle& rectangle,
+    uint32_t tilesPerAxis,
+    uint32_t column,
+    uint32_t row) {
+  LoadedRasterOverlayImage result{
+      std::nullopt,
+      rectangle,
+      block.credits,
+      block.errors,
+      block.warnings,
+      block.moreDetailAvailable};
+  if (!block.image) {
+    return result;
+  }
+
+  const ImageCesium& image = *block.image;
+  const int32_t n = int32_t(tilesPerAxis);
+  if (image.compressedPixelFormat == GpuCompressedPixelFormat::NONE &&
+      image.width > 0 && image.height > 0 && image.width % n == 0 &&
+      image.height % n == 0) {
+    ImageCesium& tile = result.image.emplace();
+    tile.width = image.width / n;
+    tile.height = image.height / n;
+    tile.channels = image.channels;
+    tile.bytesPerChannel = image.bytesPerChannel;
+    tile.pixelData.resize(
+        size_t(tile.width) * size_t(tile.height) * size_t(tile.channels) *
+        size_t(tile.bytesPerChannel));
+
+    const PixelRectangle tilePixels{0, 0, tile.width, tile.height};
+    const PixelRectangle blockPixels{
+        int32_t(column) * tile.width,
+        int32_t(row) * tile.height,
+        tile.width,
+        tile.height};
+    if (ImageManipulation::blitImage(tile, tilePixels, image, blockPixels)) {
+      return result;
+    }
+  }
+
+  // The server sent an image that can't be split into tiles, so give each
+  // tile all of it; only the part within the tile is used.
+  result.image = image;
+  result.rectangle = block.rectangle;
+  return result;
+}
+
+} // namespace
+
 class WebMapServiceTileProvider final
     : public QuadtreeRasterOverlayTileProvider {
 public:
@@ -44,7 +111,8 @@ public:
       uint32_t width,
       uint32_t height,
       uint32_t minimumLevel,
-      uint32_t maximumLevel)
+      uint32_t maximumLevel,
+      uint32_t requestTilesPerAxis)
       : QuadtreeRasterOverlayTileProvider(
             pOwner,
             asyncSystem,
@@ -63,22 +131,49 @@ public:
         _headers(headers),
         _version(version),
         _layers(layers),
-        _format(format) {}
+        _format(format),
+        _requestTilesPerAxis(requestTilesPerAxis),
+        _pendingBlocks() {}
 
   virtual ~WebMapServiceTileProvider() {}
 
 protected:
   virtual CesiumAsync::Future<LoadedRasterOverlayImage> loadQuadtreeTileImage(
       const CesiumGeometry::QuadtreeTileID& tileID) const override {
+    const uint32_t n = this->_requestTilesPerAxis;
+    if (n > 1) {
+      // Request the aligned block of tiles that contains this one, unless it
+      // would extend past the edge of the tiling scheme.
+      const QuadtreeTileID blockID(tileID.level, tileID.x / n, tileID.y / n);
+      const QuadtreeTilingScheme& tilingScheme = this->getTilingScheme();
+      if ((blockID.x + 1) * n <=
+              tilingScheme.getNumberOfXTilesAtLevel(tileID.level) &&
+          (blockID.y + 1) * n <=
+              tilingScheme.getNumberOfYTilesAtLevel(tileID.level)) {
+        return this->loadTileImageFromBlock(tileID, blockID);
+      }
+    }
 
     LoadTileImageFromUrlOptions options;
     options.rectangle = this->getTilingScheme().tileToRectangle(tileID);
     options.moreDetailAvailable = tileID.level < this->getMaximumLevel();
 
+    const std::string url = this->createGetMapUrl(
+        options.rectangle,
+        this->getWidth(),
+        this->getHeight());
+    return this->loadTileImageFromUrl(url, this->_headers, std::move(options));
+  }
+
+private:
+  std::string createGetMapUrl(
+      const CesiumGeometry::Rectangle& rectangle,
+      uint32_t width,
+      uint32_t height) const {
     const CesiumGeospatial::GlobeRectangle tileRectangle =
         CesiumGeospatial::unprojectRectangleSimple(
             this->getProjection(),
-            options.rectangle);
+            rectangle);
 
     std::string queryString = "?";
 
@@ -106,26 +201,96 @@ protected:
         {"miny", radiansToDegrees(tileRectangle.getWest())},
         {"layers", this->_layers},
         {"format", this->_format},
-        {"width", std::to_string(this->getWidth())},
-        {"height", std::to_string(this->getHeight())}};
+        {"width", std::to_string(width)},
+        {"height", std::to_string(height)}};
 
-    std::string url = CesiumUtility::Uri::substituteTemplateParameters(
+    return CesiumUtility::Uri::substituteTemplateParameters(
         urlTemplate,
         [&map = urlTemplateMap](const std::string& placeholder) {
           auto it = map.find(placeholder);
           return it == map.end() ? "{" + placeholder + "}"
                                  : Uri::escape(it->second);
         });
+  }
 
-    return this->loadTileImageFromUrl(url, this->_headers, std::move(options));
+  CesiumAsync::Future<LoadedRasterOverlayImage> loadTileImageFromBlock(
+      const CesiumGeometry::QuadtreeTileID& tileID,
+      const CesiumGeometry::QuadtreeTileID& blockID) const {
+    const uint32_t n = this->_requestTilesPerAxis;
+    const QuadtreeTilingScheme& tilingScheme = this->getTilingScheme();
+
+    auto it = std::find_if(
+        this->_pendingBlocks.begin(),
+        this->_pendingBlocks.end(),
+        [&blockID](const PendingBlock& block) {
+          return block.blockID == blockID;
+        });
+    if (it == this->_pendingBlocks.end()) {
+      if (this->_pendingBlocks.size() >= MAXIMUM_PENDING_BLOCKS) {
+        this->_pendingBlocks.erase(this->_pendingBlocks.begin());
+      }
+
+      const QuadtreeTileID southwestID(
+          blockID.level,
+          blockID.x * n,
+          blockID.y * n);
+      const QuadtreeTileID northeastID(
+          blockID.level,
+          blockID.x * n + n - 1,
+          blockID.y * n + n - 1);
+
+      LoadTileImageFromUrlOptions options;
+      options.rectangle =
+          tilingScheme.tileToRectangle(southwestID)
+              .computeUnion(tilingScheme.tileToRectangle(northeastID));
+      options.moreDetailAvailable = blockID.level < this->getMaximumLevel();
+
+      const std::string url = this->createGetMapUrl(
+          options.rectangle,
+          this->getWidth() * n,
+          this->getHeight() * n);
+      this->_pendingBlocks.push_back(
+          {blockID,
+           this->loadTileImageFromUrl(url, this->_headers, std::move(options))
+               .share(),
+           n * n});
+      it = this->_pendingBlocks.end() - 1;
+    }
+
+    SharedFuture<LoadedRasterOverlayImage> future = it->future;
+
+    // Once every tile of the block has been requested, each one is kept in
+    // the sub-tile cache, so the block itself is no longer needed.
+    if (--it->tilesRemaining == 0) {
+      this->_pendingBlocks.erase(it);
+    }
+
+    return future.thenInWorkerThread(
+        [rectangle = tilingScheme.tileToRectangle(tileID),
+         n,
+         column = tileID.x - blockID.x * n,
+         row = n - 1 - (tileID.y - blockID.y * n)](
+            const LoadedRasterOverlayImage& block) {
+          return cropBlockImage(block, rectangle, n, column, row);
+        });
   }
 
-private:
+  struct PendingBlock {
+    CesiumGeometry::QuadtreeTileID blockID;
+    CesiumAsync::SharedFuture<LoadedRasterOverlayImage> future;
+    uint32_t tilesRemaining;
+  };
+
   std::string _url;
   std::vector<IAssetAccessor::THeader> _headers;
   std::string _version;
   std::string _layers;
   std::string _format;
+  uint32_t _requestTilesPerAxis;
+
+  // The multi-tile images that have been requested for some, but not yet all,
+  // of their tiles. Only accessed from the main thread.
+  mutable std::vector<PendingBlock> _pendingBlocks;
 };
 
 WebMapServiceRasterOverlay::WebMapServiceRasterOverlay(
@@ -133,11 +298,13 @@ WebMapServiceRasterOverlay::WebMapServiceRasterOverlay(
     const std::string& url,
     const std::vector<IAssetAccessor::THeader>& headers,
     const WebMapServiceRasterOverlayOptions& wmsOptions,
-    const RasterOverlayOptions& overlayOptions)
+    const RasterOverlayOptions& overlayOptions,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pMetadataCacheDatabase)
     : RasterOverlay(name, overlayOptions),
       _baseUrl(url),
       _headers(headers),
-      _options(wmsOptions) {}
+      _options(wmsOptions),
+      _pMetadataCacheDatabase(pMetadataCacheDatabase) {}
 
 WebMapServiceRasterOverlay::~WebMapServiceRasterOverlay() {}
 
@@ -275,91 +442,144 @@ WebMapServiceRasterOverlay::createTileProvider(
                                   this->_options.credit.value()))
                             : std::nullopt;
 
-  return pAssetAccessor->get(asyncSystem, xmlUrlGetcapabilities, this->_headers)
-      .thenInMainThread(
-          [pOwner,
-           asyncSystem,
-           pAssetAccessor,
-           credit,
-           pPrepareRendererResources,
-           pLogger,
-           options = this->_options,
-           url = this->_baseUrl,
-           headers =
-               this->_headers](const std::shared_ptr<IAssetRequest>& pRequest)
-              -> CreateTileProviderResult {
-            const IAssetResponse* pResponse = pRequest->response();
-            if (!pResponse) {
-              return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
-                  RasterOverlayLoadType::TileProvider,
-                  std::move(pRequest),
-                  "No response received from web map service."});
-            }
+  auto handleResponse =
+      [pOwner,
+       asyncSystem,
+       pAssetAccessor,
+       credit,
+       pPrepareRendererResources,
+       pLogger,
+       options = this->_options,
+       url = this->_baseUrl,
+       headers = this->_headers](
+          const std::shared_ptr<IAssetRequest>& pRequest,
+          const gsl::span<const std::byte>& data) -> CreateTileProviderResult {
+    tinyxml2::XMLDocument doc;
+    const tinyxml2::XMLError error = doc.Parse(
+        reinterpret_cast<const char*>(data.data()),
+        data.size_bytes());
+    if (error != tinyxml2::XMLError::XML_SUCCESS) {
+      return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+          RasterOverlayLoadType::TileProvider,
+          pRequest,
+          "Could not parse web map service XML."});
+    }
 
-            const gsl::span<const std::byte> data = pResponse->data();
-
-            tinyxml2::XMLDocument doc;
-            const tinyxml2::XMLError error = doc.Parse(
-                reinterpret_cast<const char*>(data.data()),
-                data.size_bytes());
-            if (error != tinyxml2::XMLError::XML_SUCCESS) {
-              return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
-                  RasterOverlayLoadType::TileProvider,
-                  std::move(pRequest),
-                  "Could not parse web map service XML."});
-            }
+    tinyxml2::XMLElement* pRoot = doc.RootElement();
+    if (!pRoot) {
+      return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+          RasterOverlayLoadType::TileProvider,
+          pRequest,
+          "Web map service XML document does not have a root "
+          "element."});
+    }
 
-            tinyxml2::XMLElement* pRoot = doc.RootElement();
-            if (!pRoot) {
-              return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
-                  RasterOverlayLoadType::TileProvider,
-                  std::move(pRequest),
-                  "Web map service XML document does not have a root "
-                  "element."});
-            }
+    std::string validationError;
+    if (!validateCapabilities(pRoot, options, validationError)) {
+      return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+          RasterOverlayLoadType::TileProvider,
+          pRequest,
+          validationError});
+    }
+
+    const auto projection = CesiumGeospatial::GeographicProjection();
+
+    CesiumGeospatial::GlobeRectangle tilingSchemeRectangle =
+        CesiumGeospatial::GeographicProjection::MAXIMUM_GLOBE_RECTANGLE;
+
+    CesiumGeometry::Rectangle coverageRectangle =
+        projectRectangleSimple(projection, tilingSchemeRectangle);
+
+    const int rootTilesX = 2;
+    const int rootTilesY = 1;
+    CesiumGeometry::QuadtreeTilingScheme tilingScheme(
+        coverageRectangle,
+        rootTilesX,
+        rootTilesY);
+
+    return new WebMapServiceTileProvider(
+        pOwner,
+        asyncSystem,
+        pAssetAccessor,
+        credit,
+        pPrepareRendererResources,
+        pLogger,
+        projection,
+        tilingScheme,
+        coverageRectangle,
+        url,
+        headers,
+        options.version,
+        options.layers,
+        options.format,
+        options.tileWidth < 1 ? 1 : uint32_t(options.tileWidth),
+        options.tileHeight < 1 ? 1 : uint32_t(options.tileHeight),
+        options.minimumLevel < 0 ? 0 : uint32_t(options.minimumLevel),
+        options.maximumLevel < 0 ? 0 : uint32_t(options.maximumLevel),
+        options.requestTilesPerAxis < 1
+            ? 1
+            : uint32_t(options.requestTilesPerAxis));
+  };
+
+  auto requestCapabilities = [asyncSystem,
+                              pAssetAccessor,
+                              pCacheDatabase = this->_pMetadataCacheDatabase,
+                              xmlUrlGetcapabilities,
+                              headers = this->_headers,
+                              handleResponse]() {
+    // The tile provider's reference counts are thread-safe, so it can be
+    // created along with parsing the capabilities in a worker thread.
+    return pAssetAccessor->get(asyncSystem, xmlUrlGetcapabilities, headers)
+        .thenInWorkerThread(
+            [asyncSystem,
+             pCacheDatabase,
+             xmlUrlGetcapabilities,
+             handleResponse](const std::shared_ptr<IAssetRequest>& pRequest)
+                -> CreateTileProviderResult {
+              const IAssetResponse* pResponse = pRequest->response();
+              if (!pResponse) {
+                return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+                    RasterOverlayLoadType::TileProvider,
+                    pRequest,
+                    "No response received from web map service."});
+              }
+
+              CreateTileProviderResult result =
+                  handleResponse(pRequest, pResponse->data());
+              if (result) {
+                storeCachedMetadata(
+                    asyncSystem,
+                    pCacheDatabase,
+                    xmlUrlGetcapabilities,
+                    pResponse->data());
+              }
+
+              return result;
+            });
+  };
+
+  if (!this->_pMetadataCacheDatabase) {
+    return requestCapabilities();
+  }
 
-            std::string validationError;
-            if (!validateCapabilities(pRoot, options, validationError)) {
-              return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
-                  RasterOverlayLoadType::TileProvider,
-                  std::move(pRequest),
-                  validationError});
+  return getCachedMetadata(
+             asyncSystem,
+             this->_pMetadataCacheDatabase,
+             xmlUrlGetcapabilities)
+      .thenInWorkerThread(
+          [asyncSystem, handleResponse, requestCapabilities](
+              std::optional<std::vector<std::byte>>&& maybeCached)
+              -> Future<CreateTileProviderResult> {
+            if (maybeCached) {
+              CreateTileProviderResult result =
+                  handleResponse(nullptr, *maybeCached);
+              if (result) {
+                return asyncSystem.createResolvedFuture(std::move(result));
+              }
             }
 
-            const auto projection = CesiumGeospatial::GeographicProjection();
-
-            CesiumGeospatial::GlobeRectangle tilingSchemeRectangle =
-                CesiumGeospatial::GeographicProjection::MAXIMUM_GLOBE_RECTANGLE;
-
-            CesiumGeometry::Rectangle coverageRectangle =
-                projectRectangleSimple(projection, tilingSchemeRectangle);
-
-            const int rootTilesX = 2;
-            const int rootTilesY = 1;
-            CesiumGeometry::QuadtreeTilingScheme tilingScheme(
-                coverageRectangle,
-                rootTilesX,
-                rootTilesY);
-
-            return new WebMapServiceTileProvider(
-                pOwner,
-                asyncSystem,
-                pAssetAccessor,
-                credit,
-                pPrepareRendererResources,
-                pLogger,
-                projection,
-                tilingScheme,
-                coverageRectangle,
-                url,
-                headers,
-                options.version,
-                options.layers,
-                options.format,
-                options.tileWidth < 1 ? 1 : uint32_t(options.tileWidth),
-                options.tileHeight < 1 ? 1 : uint32_t(options.tileHeight),
-                options.minimumLevel < 0 ? 0 : uint32_t(options.minimumLevel),
-                options.maximumLevel < 0 ? 0 : uint32_t(options.maximumLevel));
+            // Nothing usable was cached, so request the capabilities again.
+            return requestCapabilities();
           });
 }
 
@@ -7,6 +7,9 @@
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <utility>
+
 using namespace CesiumAsync;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -240,4 +243,94 @@ TEST_CASE("QuadtreeRasterOverlayTileProvider getTile") {
         image.pixelData.end(),
         [](std::byte b) { return b == std::byte(8); }));
   }
+
+  SECTION("reduces the level when too many tiles would be loaded") {
+    TestTileProvider* pTestProvider =
+        static_cast<TestTileProvider*>(pProvider.get());
+
+    // A rectangle that needs several tiles at level 8.
+    const uint32_t expectedLevel = 8;
+    std::optional<QuadtreeTileID> centerTileID =
+        pTestProvider->getTilingScheme().positionToTile(
+            glm::dvec2(0.1, 0.2),
+            expectedLevel);
+    REQUIRE(centerTileID);
+
+    const Rectangle centerRectangle =
+        pTestProvider->getTilingScheme().tileToRectangle(*centerTileID);
+    const Rectangle tileRectangle(
+        centerRectangle.minimumX - centerRectangle.computeWidth() * 0.5,
+        centerRectangle.minimumY - centerRectangle.computeHeight() * 0.5,
+        centerRectangle.maximumX + centerRectangle.computeWidth() * 0.5,
+        centerRectangle.maximumY + centerRectangle.computeHeight() * 0.5);
+    const glm::dvec2 targetScreenPixels = glm::dvec2(
+        pTestProvider->getWidth() * 2 * 2,
+        pTestProvider->getHeight() * 2 * 2);
+
+    auto loadLevels = [&]() {
+      IntrusivePointer<RasterOverlayTile> pTile =
+          pProvider->getTile(tileRectangle, targetScreenPixels);
+      pProvider->loadTile(*pTile);
+      while (pTile->getState() != RasterOverlayTile::LoadState::Loaded) {
+        asyncSystem.dispatchMainThreadTasks();
+      }
+
+      const ImageCesium& image = pTile->getImage();
+      REQUIRE(!image.pixelData.empty());
+      const auto [minimum, maximum] =
+          std::minmax_element(image.pixelData.begin(), image.pixelData.end());
+      return std::make_pair(uint32_t(*minimum), uint32_t(*maximum));
+    };
+
+    pOverlay->getOptions().maximumSubTileBytesPerTile = 1;
+    CHECK(loadLevels().second < expectedLevel);
+    pOverlay->getOptions().maximumSubTileBytesPerTile = 0;
+
+    pOverlay->getOptions().maximumSubTileLoadsPerTile = 4;
+    CHECK(loadLevels().second < expectedLevel);
+
+    // Once the tiles are cached, they don't count against the limit.
+    pOverlay->getOptions().maximumSubTileLoadsPerTile = 0;
+    CHECK(loadLevels() == std::make_pair(expectedLevel, expectedLevel));
+    pOverlay->getOptions().maximumSubTileLoadsPerTile = 4;
+    CHECK(loadLevels() == std::make_pair(expectedLevel, expectedLevel));
+  }
+
+  SECTION("reuses and evicts cached tiles") {
+    TestTileProvider* pTestProvider =
+        static_cast<TestTileProvider*>(pProvider.get());
+
+    // Room for about two tile images, so that most tiles are evicted.
+    pOverlay->getOptions().subTileCacheBytes =
+        int64_t(pTestProvider->getWidth() * pTestProvider->getHeight() * 4 * 2);
+
+    // Load each tile in a row at level 8 twice, once from the cache.
+    const uint32_t level = 8;
+    const glm::dvec2 screenPixels(
+        pTestProvider->getWidth() * 2,
+        pTestProvider->getHeight() * 2);
+    for (uint32_t x = 100; x < 140; ++x) {
+      const Rectangle rectangle =
+          pTestProvider->getTilingScheme().tileToRectangle(
+              QuadtreeTileID(level, x, 100));
+      for (int i = 0; i < 2; ++i) {
+        IntrusivePointer<RasterOverlayTile> pTile =
+            pProvider->getTile(rectangle, screenPixels);
+        pProvider->loadTile(*pTile);
+
+        while (pTile->getState() != RasterOverlayTile::LoadState::Loaded) {
+          asyncSystem.dispatchMainThreadTasks();
+        }
+
+        const ImageCesium& image = pTile->getImage();
+        CHECK(image.pixelData.size() > 0);
+        CHECK(std::all_of(
+            image.pixelData.begin(),
+            image.pixelData.end(),
+            [](std::byte b) { return b == std::byte(level); }));
+      }
+    }
+
+    CHECK(pProvider->getCachedDataBytes() > 0);
+  }
 }
@@ -0,0 +1,193 @@
+#include "CesiumRasterOverlays/RasterOverlay.h"
+#include "CesiumRasterOverlays/RasterOverlayTile.h"
+#include "CesiumRasterOverlays/RasterOverlayTileProvider.h"
+
+#include <CesiumGeospatial/GeographicProjection.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+using namespace CesiumNativeTests;
+using namespace CesiumRasterOverlays;
+
+namespace {
+
+// A tile provider whose tile images load when the test resolves them.
+class DeferredTileProvider : public RasterOverlayTileProvider {
+public:
+  DeferredTileProvider(
+      const IntrusivePointer<const RasterOverlay>& pOwner,
+      const AsyncSystem& asyncSystem,
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor)
+      : RasterOverlayTileProvider(
+            pOwner,
+            asyncSystem,
+            pAssetAccessor,
+            std::nullopt,
+            nullptr,
+            spdlog::default_logger(),
+            GeographicProjection(),
+            GeographicProjection::computeMaximumProjectedRectangle()) {}
+
+  // The tiles whose images are loading, in the order the loads started.
+  std::vector<
+      std::pair<RasterOverlayTile*, Promise<LoadedRasterOverlayImage>>>
+      loads;
+
+  void resolveLoad(size_t index) {
+    LoadedRasterOverlayImage result;
+    result.rectangle = this->loads[index].first->getRectangle();
+    result.image.emplace();
+    result.image->width = 1;
+    result.image->height = 1;
+    result.image->channels = 4;
+    result.image->bytesPerChannel = 1;
+    result.image->pixelData.resize(4, std::byte(0));
+    this->loads[index].second.resolve(std::move(result));
+  }
+
+protected:
+  virtual Future<LoadedRasterOverlayImage>
+  loadTileImage(RasterOverlayTile& overlayTile) override {
+    Promise<LoadedRasterOverlayImage> promise =
+        this->getAsyncSystem().createPromise<LoadedRasterOverlayImage>();
+    this->loads.emplace_back(&overlayTile, promise);
+    return promise.getFuture();
+  }
+};
+
+class DeferredRasterOverlay : public RasterOverlay {
+public:
+  DeferredRasterOverlay(const RasterOverlayOptions& options)
+      : RasterOverlay("Deferred", options) {}
+
+  virtual Future<CreateTileProviderResult> createTileProvider(
+      const AsyncSystem& asyncSystem,
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CreditSystem>& /* pCreditSystem */,
+      const std::shared_ptr<
+          IPrepareRasterOverlayRendererResources>& /* pPrepareResources */,
+      const std::shared_ptr<spdlog::logger>& /* pLogger */,
+      IntrusivePointer<const RasterOverlay> pOwner) const override {
+    if (!pOwner) {
+      pOwner = this;
+    }
+
+    return asyncSystem.createResolvedFuture<CreateTileProviderResult>(
+        new DeferredTileProvider(pOwner, asyncSystem, pAssetAccessor));
+  }
+};
+
+class MockTaskProcessor : public ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) { std::thread(f).detach(); }
+};
+
+void waitForLoad(
+    const AsyncSystem& asyncSystem,
+    const RasterOverlayTile& tile) {
+  while (tile.getState() == RasterOverlayTile::LoadState::Loading) {
+    asyncSystem.dispatchMainThreadTasks();
+  }
+}
+
+} // namespace
+
+TEST_CASE("RasterOverlayTileProvider::loadTileThrottled") {
+  auto pTaskProcessor = std::make_shared<MockTaskProcessor>();
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+  AsyncSystem asyncSystem(pTaskProcessor);
+
+  RasterOverlayOptions options;
+  options.maximumSimultaneousTileLoads = 1;
+  IntrusivePointer<DeferredRasterOverlay> pOverlay =
+      new DeferredRasterOverlay(options);
+
+  IntrusivePointer<DeferredTileProvider> pProvider;
+  pOverlay
+      ->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          nullptr,
+          nullptr,
+          spdlog::default_logger(),
+          nullptr)
+      .thenInMainThread(
+          [&pProvider](RasterOverlay::CreateTileProviderResult&& created) {
+            REQUIRE(created);
+            pProvider = static_cast<DeferredTileProvider*>(created->get());
+          });
+  asyncSystem.dispatchMainThreadTasks();
+  REQUIRE(pProvider);
+
+  const Rectangle rectangle(0.0, 0.0, 0.1, 0.1);
+  IntrusivePointer<RasterOverlayTile> pFirst =
+      pProvider->getTile(rectangle, glm::dvec2(256.0));
+  IntrusivePointer<RasterOverlayTile> pLow =
+      pProvider->getTile(rectangle, glm::dvec2(256.0));
+  IntrusivePointer<RasterOverlayTile> pHigh =
+      pProvider->getTile(rectangle, glm::dvec2(256.0));
+
+  CHECK(pProvider->loadTileThrottled(*pFirst));
+  CHECK(!pProvider->loadTileThrottled(*pLow, TaskPriority{0, 5.0}));
+  CHECK(!pProvider->loadTileThrottled(*pHigh, TaskPriority{0, 1.0}));
+  REQUIRE(pProvider->loads.size() == 1);
+
+  SECTION("a finished load starts the waiting tile with the highest priority") {
+    pProvider->resolveLoad(0);
+    waitForLoad(asyncSystem, *pFirst);
+    CHECK(pFirst->getState() == RasterOverlayTile::LoadState::Loaded);
+
+    REQUIRE(pProvider->loads.size() == 2);
+    CHECK(pProvider->loads[1].first == pHigh.get());
+    CHECK(pLow->getState() == RasterOverlayTile::LoadState::Unloaded);
+
+    pProvider->resolveLoad(1);
+    waitForLoad(asyncSystem, *pHigh);
+    REQUIRE(pProvider->loads.size() == 3);
+    CHECK(pProvider->loads[2].first == pLow.get());
+
+    pProvider->resolveLoad(2);
+    waitForLoad(asyncSystem, *pLow);
+    CHECK(pLow->getState() == RasterOverlayTile::LoadState::Loaded);
+  }
+
+  SECTION("a repeated request updates the priority of a waiting tile") {
+    CHECK(!pProvider->loadTileThrottled(*pLow, TaskPriority{1, 5.0}));
+
+    pProvider->resolveLoad(0);
+    waitForLoad(asyncSystem, *pFirst);
+    REQUIRE(pProvider->loads.size() == 2);
+    CHECK(pProvider->loads[1].first == pLow.get());
+
+    pProvider->resolveLoad(1);
+    waitForLoad(asyncSystem, *pLow);
+    REQUIRE(pProvider->loads.size() == 3);
+    CHECK(pProvider->loads[2].first == pHigh.get());
+
+    pProvider->resolveLoad(2);
+    waitForLoad(asyncSystem, *pHigh);
+  }
+
+  SECTION("a waiting tile that is no longer used is not loaded") {
+    pHigh = nullptr;
+
+    pProvider->resolveLoad(0);
+    waitForLoad(asyncSystem, *pFirst);
+    REQUIRE(pProvider->loads.size() == 2);
+    CHECK(pProvider->loads[1].first == pLow.get());
+
+    pProvider->resolveLoad(1);
+    waitForLoad(asyncSystem, *pLow);
+  }
+}
@@ -0,0 +1,110 @@
+#include "CesiumRasterOverlays/RasterOverlayUtilities.h"
+
+#include <CesiumGeometry/Rectangle.h>
+#include <CesiumGltf/ImageCesium.h>
+
+#include <catch2/catch.hpp>
+#include <glm/vec4.hpp>
+
+#include <vector>
+
+using namespace CesiumGeometry;
+using namespace CesiumGltf;
+using namespace CesiumRasterOverlays;
+
+namespace {
+ImageCesium createImage(int32_t width, int32_t height, std::byte value) {
+  ImageCesium image;
+  image.width = width;
+  image.height = height;
+  image.channels = 1;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(size_t(width * height), value);
+  return image;
+}
+} // namespace
+
+TEST_CASE("RasterOverlayUtilities::createAtlas") {
+  SECTION("packs images with padding copied from their edges") {
+    ImageCesium small = createImage(2, 2, std::byte(0));
+    small.pixelData = {std::byte(1), std::byte(2), std::byte(3), std::byte(4)};
+    const ImageCesium wide = createImage(3, 1, std::byte(5));
+
+    std::optional<RasterOverlayAtlas> maybeAtlas =
+        RasterOverlayUtilities::createAtlas({&small, &wide}, 1);
+    REQUIRE(maybeAtlas);
+
+    const ImageCesium& image = maybeAtlas->image;
+    CHECK(image.channels == 1);
+    REQUIRE(maybeAtlas->regions.size() == 2);
+    REQUIRE(
+        image.pixelData.size() == size_t(image.width) * size_t(image.height));
+
+    // Finds the pixel of the atlas at texture coordinates relative to a
+    // region, where (0, 0) is the south-west corner.
+    auto sample = [&image](const Rectangle& region, double u, double v) {
+      const double x = region.minimumX + u * region.computeWidth();
+      const double y = region.minimumY + v * region.computeHeight();
+      const int32_t column = int32_t(x * image.width);
+      const int32_t row = int32_t((1.0 - y) * image.height);
+      return image.pixelData[size_t(row * image.width + column)];
+    };
+
+    const Rectangle& smallRegion = maybeAtlas->regions[0];
+    CHECK(smallRegion.computeWidth() * image.width == Approx(small.width));
+    CHECK(smallRegion.computeHeight() * image.height == Approx(small.height));
+    CHECK(sample(smallRegion, 0.25, 0.75) == std::byte(1));
+    CHECK(sample(smallRegion, 0.75, 0.75) == std::byte(2));
+    CHECK(sample(smallRegion, 0.25, 0.25) == std::byte(3));
+    CHECK(sample(smallRegion, 0.75, 0.25) == std::byte(4));
+
+    // The padding repeats the edge pixels.
+    CHECK(sample(smallRegion, -0.25, 1.25) == std::byte(1));
+    CHECK(sample(smallRegion, 1.25, -0.25) == std::byte(4));
+
+    const Rectangle& wideRegion = maybeAtlas->regions[1];
+    CHECK(wideRegion.computeWidth() * image.width == Approx(wide.width));
+    CHECK(sample(wideRegion, 0.5, 0.5) == std::byte(5));
+    CHECK(!smallRegion.computeIntersection(wideRegion));
+  }
+
+  SECTION("fails for images that can not be combined") {
+    const ImageCesium gray = createImage(2, 2, std::byte(0));
+    ImageCesium rgba = createImage(2, 2, std::byte(0));
+    rgba.channels = 4;
+    rgba.pixelData.resize(16);
+    CHECK(!RasterOverlayUtilities::createAtlas({&gray, &rgba}));
+
+    ImageCesium compressed = createImage(4, 4, std::byte(0));
+    compressed.compressedPixelFormat = GpuCompressedPixelFormat::BC4_R;
+    CHECK(!RasterOverlayUtilities::createAtlas({&gray, &compressed}));
+
+    CHECK(!RasterOverlayUtilities::createAtlas({}));
+  }
+
+  SECTION("fails for images that do not fit") {
+    const ImageCesium large = createImage(64, 64, std::byte(0));
+    CHECK(!RasterOverlayUtilities::createAtlas({&large, &large}, 1, 100));
+    CHECK(RasterOverlayUtilities::createAtlas({&large, &large}, 1, 200));
+  }
+}
+
+TEST_CASE("RasterOverlayUtilities::computeAtlasTranslationAndScale") {
+  const glm::dvec4 translationAndScale(0.5, 0.25, 0.5, 0.5);
+  const Rectangle region(0.5, 0.0, 1.0, 0.25);
+  const glm::dvec4 result =
+      RasterOverlayUtilities::computeAtlasTranslationAndScale(
+          translationAndScale,
+          region);
+
+  // The corners of the geometry's texture coordinates map to the same places
+  // in the region as they did in the image.
+  const glm::dvec2 translation(result.x, result.y);
+  const glm::dvec2 scale(result.z, result.w);
+  const glm::dvec2 origin = translation;
+  const glm::dvec2 corner = glm::dvec2(1.0) * scale + translation;
+  CHECK(origin.x == Approx(0.5 + 0.5 * 0.5));
+  CHECK(origin.y == Approx(0.0 + 0.25 * 0.25));
+  CHECK(corner.x == Approx(0.5 + 1.0 * 0.5));
+  CHECK(corner.y == Approx(0.0 + 0.75 * 0.25));
+}
@@ -0,0 +1,141 @@
+#include "CesiumRasterOverlays/RasterOverlayTile.h"
+#include "CesiumRasterOverlays/RasterOverlayTileProvider.h"
+#include "CesiumRasterOverlays/RasterizedPolygonsOverlay.h"
+
+#include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/GeographicProjection.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <thread>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+using namespace CesiumNativeTests;
+using namespace CesiumRasterOverlays;
+
+namespace {
+class MockTaskProcessor : public ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) { std::thread(f).detach(); }
+};
+
+const ImageCesium& loadImage(
+    const AsyncSystem& asyncSystem,
+    RasterOverlayTileProvider& provider,
+    IntrusivePointer<RasterOverlayTile>& pTile,
+    const GlobeRectangle& rectangle) {
+  pTile = provider.getTile(
+      projectRectangleSimple(provider.getProjection(), rectangle),
+      glm::dvec2(512.0));
+  provider.loadTile(*pTile);
+  while (pTile->getState() != RasterOverlayTile::LoadState::Loaded) {
+    asyncSystem.dispatchMainThreadTasks();
+  }
+
+  return pTile->getImage();
+}
+} // namespace
+
+TEST_CASE("RasterizedPolygonsOverlay") {
+  auto pTaskProcessor = std::make_shared<MockTaskProcessor>();
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+  AsyncSystem asyncSystem(pTaskProcessor);
+
+  // A square from 0.1 to 0.2 radians in longitude and latitude.
+  const CartographicPolygon square(std::vector<glm::dvec2>{
+      glm::dvec2(0.1, 0.1),
+      glm::dvec2(0.2, 0.1),
+      glm::dvec2(0.2, 0.2),
+      glm::dvec2(0.1, 0.2)});
+  IntrusivePointer<RasterizedPolygonsOverlay> pOverlay =
+      new RasterizedPolygonsOverlay(
+          "Test",
+          {square},
+          false,
+          Ellipsoid::WGS84,
+          GeographicProjection());
+
+  IntrusivePointer<RasterOverlayTileProvider> pProvider = nullptr;
+  pOverlay
+      ->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          nullptr,
+          nullptr,
+          spdlog::default_logger(),
+          nullptr)
+      .thenInMainThread(
+          [&pProvider](RasterOverlay::CreateTileProviderResult&& created) {
+            CHECK(created);
+            pProvider = *created;
+          });
+  asyncSystem.dispatchMainThreadTasks();
+  REQUIRE(pProvider);
+  CHECK(pProvider->getOutputChannels() == 1);
+
+  IntrusivePointer<RasterOverlayTile> pTile;
+
+  SECTION("creates a single pixel for a tile inside a polygon") {
+    const ImageCesium& image = loadImage(
+        asyncSystem,
+        *pProvider,
+        pTile,
+        GlobeRectangle(0.12, 0.12, 0.18, 0.18));
+    CHECK(image.width == 1);
+    CHECK(image.height == 1);
+    CHECK(image.channels == 1);
+    REQUIRE(image.pixelData.size() == 1);
+    CHECK(image.pixelData[0] == std::byte(0xff));
+  }
+
+  SECTION("creates a single pixel for a tile outside the polygons") {
+    const ImageCesium& image = loadImage(
+        asyncSystem,
+        *pProvider,
+        pTile,
+        GlobeRectangle(0.3, 0.3, 0.4, 0.4));
+    CHECK(image.width == 1);
+    CHECK(image.height == 1);
+    REQUIRE(image.pixelData.size() == 1);
+    CHECK(image.pixelData[0] == std::byte(0));
+  }
+
+  SECTION("rasterizes a single channel mask of a partially covered tile") {
+    // The square covers the north-east quarter of the tile.
+    const ImageCesium& image = loadImage(
+        asyncSystem,
+        *pProvider,
+        pTile,
+        GlobeRectangle(0.0, 0.0, 0.2, 0.2));
+    const RasterOverlayOptions& options = pOverlay->getOptions();
+    const int32_t size = int32_t(512.0 / options.maximumScreenSpaceError);
+    REQUIRE(image.width == size);
+    REQUIRE(image.height == size);
+    CHECK(image.channels == 1);
+    CHECK(image.bytesPerChannel == 1);
+    REQUIRE(image.pixelData.size() == size_t(size * size));
+
+    // Rows go from north to south.
+    bool matches = true;
+    for (int32_t j = 0; j < size; ++j) {
+      for (int32_t i = 0; i < size; ++i) {
+        const bool inside = i >= size / 2 && j < size / 2;
+        const bool onEdge = i == size / 2 - 1 || i == size / 2 ||
+                            j == size / 2 - 1 || j == size / 2;
+        const std::byte expected = inside ? std::byte(0xff) : std::byte(0);
+        if (!onEdge && image.pixelData[size_t(j * size + i)] != expected) {
+          matches = false;
+        }
+      }
+    }
+    CHECK(matches);
+  }
+}
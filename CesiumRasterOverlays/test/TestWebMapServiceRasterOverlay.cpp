@@ -0,0 +1,276 @@
+#include "CesiumRasterOverlays/RasterOverlayTile.h"
+#include "CesiumRasterOverlays/RasterOverlayTileProvider.h"
+#include "CesiumRasterOverlays/WebMapServiceRasterOverlay.h"
+
+#include <CesiumAsync/CacheItem.h>
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeometry/QuadtreeTilingScheme.h>
+#include <CesiumGeospatial/GeographicProjection.h>
+#include <CesiumGltfContent/ImageManipulation.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+using namespace CesiumUtility;
+using namespace CesiumNativeTests;
+using namespace CesiumRasterOverlays;
+
+namespace {
+
+const char* capabilities =
+    "<WMS_Capabilities><Service><Name>WMS</Name></Service></WMS_Capabilities>";
+
+// Answers GetCapabilities requests with a minimal document and every other
+// request with the same image, recording the requested URLs.
+class WmsAssetAccessor : public IAssetAccessor {
+public:
+  WmsAssetAccessor(std::vector<std::byte>&& image_)
+      : image(std::move(image_)) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& /* headers */) override {
+    this->urls.emplace_back(url);
+
+    std::vector<std::byte> data = this->image;
+    if (url.find("request=GetCapabilities") != std::string::npos) {
+      data.resize(std::strlen(capabilities));
+      std::memcpy(data.data(), capabilities, data.size());
+    }
+
+    return asyncSystem.createResolvedFuture(
+        std::shared_ptr<IAssetRequest>(std::make_shared<SimpleAssetRequest>(
+            "GET",
+            url,
+            HttpHeaders(),
+            std::make_unique<SimpleAssetResponse>(
+                uint16_t(200),
+                "",
+                HttpHeaders(),
+                data))));
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& /* verb */,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>&) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+
+  size_t countRequests(const std::string& part) const {
+    return size_t(std::count_if(
+        this->urls.begin(),
+        this->urls.end(),
+        [&part](const std::string& url) {
+          return url.find(part) != std::string::npos;
+        }));
+  }
+
+  std::vector<std::byte> image;
+  std::vector<std::string> urls;
+};
+
+class MockCacheDatabase : public ICacheDatabase {
+public:
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override {
+    auto it = this->items.find(key);
+    if (it == this->items.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    this->items.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(
+                HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  virtual bool prune() override { return true; }
+
+  virtual bool clearAll() override {
+    this->items.clear();
+    return true;
+  }
+
+  std::map<std::string, CacheItem> items;
+};
+
+// A PNG of 2x2 tiles of the given size, in which every byte of the
+// north-west, north-east, south-west and south-east tiles is 1, 2, 3 and 4.
+std::vector<std::byte> createBlockImage(int32_t tileSize) {
+  ImageCesium image;
+  image.width = tileSize * 2;
+  image.height = tileSize * 2;
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(size_t(image.width * image.height * 4));
+  for (int32_t j = 0; j < image.height; ++j) {
+    for (int32_t i = 0; i < image.width; ++i) {
+      const int32_t value =
+          1 + (i >= tileSize ? 1 : 0) + (j >= tileSize ? 2 : 0);
+      for (int32_t k = 0; k < 4; ++k) {
+        image.pixelData[size_t((j * image.width + i) * 4 + k)] =
+            std::byte(value);
+      }
+    }
+  }
+  return ImageManipulation::savePng(image);
+}
+
+IntrusivePointer<RasterOverlayTileProvider> createProvider(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const IntrusivePointer<WebMapServiceRasterOverlay>& pOverlay) {
+  IntrusivePointer<RasterOverlayTileProvider> pProvider = nullptr;
+  bool done = false;
+  pOverlay
+      ->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          nullptr,
+          nullptr,
+          spdlog::default_logger(),
+          nullptr)
+      .thenInMainThread(
+          [&pProvider,
+           &done](RasterOverlay::CreateTileProviderResult&& created) {
+            CHECK(created);
+            if (created) {
+              pProvider = *created;
+            }
+            done = true;
+          });
+  while (!done) {
+    asyncSystem.dispatchMainThreadTasks();
+  }
+  return pProvider;
+}
+
+} // namespace
+
+TEST_CASE("WebMapServiceRasterOverlay") {
+  const int32_t tileSize = 4;
+  auto pAssetAccessor =
+      std::make_shared<WmsAssetAccessor>(createBlockImage(tileSize));
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+
+  WebMapServiceRasterOverlayOptions wmsOptions;
+  wmsOptions.layers = "test";
+  wmsOptions.tileWidth = tileSize;
+  wmsOptions.tileHeight = tileSize;
+  wmsOptions.maximumLevel = 1;
+
+  SECTION("keeps the capabilities in the metadata cache database") {
+    auto pDatabase = std::make_shared<MockCacheDatabase>();
+    IntrusivePointer<WebMapServiceRasterOverlay> pOverlay =
+        new WebMapServiceRasterOverlay(
+            "Test",
+            "https://example.com/wms",
+            {},
+            wmsOptions,
+            {},
+            pDatabase);
+    CHECK(createProvider(asyncSystem, pAssetAccessor, pOverlay));
+    CHECK(pAssetAccessor->countRequests("GetCapabilities") == 1);
+    CHECK(pDatabase->items.size() == 1);
+
+    IntrusivePointer<WebMapServiceRasterOverlay> pSecond =
+        new WebMapServiceRasterOverlay(
+            "Second",
+            "https://example.com/wms",
+            {},
+            wmsOptions,
+            {},
+            pDatabase);
+    CHECK(createProvider(asyncSystem, pAssetAccessor, pSecond));
+    CHECK(pAssetAccessor->countRequests("GetCapabilities") == 1);
+  }
+
+  SECTION("splits the image of a block of tiles into the tiles") {
+    wmsOptions.requestTilesPerAxis = 2;
+    IntrusivePointer<WebMapServiceRasterOverlay> pOverlay =
+        new WebMapServiceRasterOverlay(
+            "Test",
+            "https://example.com/wms",
+            {},
+            wmsOptions);
+    IntrusivePointer<RasterOverlayTileProvider> pProvider =
+        createProvider(asyncSystem, pAssetAccessor, pOverlay);
+    REQUIRE(pProvider);
+
+    // Level 1 has 4x2 tiles, so the western block covers its first two
+    // columns.
+    const QuadtreeTilingScheme tilingScheme(
+        GeographicProjection::computeMaximumProjectedRectangle(),
+        2,
+        1);
+    const std::vector<std::pair<QuadtreeTileID, std::byte>> tiles{
+        {QuadtreeTileID(1, 0, 0), std::byte(3)},
+        {QuadtreeTileID(1, 1, 0), std::byte(4)},
+        {QuadtreeTileID(1, 0, 1), std::byte(1)},
+        {QuadtreeTileID(1, 1, 1), std::byte(2)}};
+    for (const auto& [tileID, expected] : tiles) {
+      IntrusivePointer<RasterOverlayTile> pTile = pProvider->getTile(
+          tilingScheme.tileToRectangle(tileID),
+          glm::dvec2(tileSize * 2));
+      pProvider->loadTile(*pTile);
+      while (pTile->getState() != RasterOverlayTile::LoadState::Loaded) {
+        asyncSystem.dispatchMainThreadTasks();
+      }
+
+      const ImageCesium& image = pTile->getImage();
+      CHECK(!image.pixelData.empty());
+      CHECK(std::all_of(
+          image.pixelData.begin(),
+          image.pixelData.end(),
+          [expected = expected](std::byte b) { return b == expected; }));
+    }
+
+    CHECK(pAssetAccessor->countRequests("GetMap") == 1);
+    CHECK(pAssetAccessor->countRequests("width=8&height=8") == 1);
+  }
+}
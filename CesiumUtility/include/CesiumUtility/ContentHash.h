@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Library.h"
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumUtility {
+
+/**
+ * @brief Identifies content by its length and by two independent 64-bit
+ * hashes of its bytes, so that caches can recognize content that they have
+ * already processed regardless of where it came from.
+ *
+ * The hashes are not cryptographic, so a cache keyed by them must not be
+ * shared between sources whose content may be crafted to collide.
+ */
+struct CESIUMUTILITY_API ContentHash {
+  /**
+   * @brief The number of bytes of the content.
+   */
+  size_t byteLength = 0;
+
+  /**
+   * @brief The first hash of the content.
+   */
+  uint64_t hash1 = 0;
+
+  /**
+   * @brief The second hash of the content.
+   */
+  uint64_t hash2 = 0;
+
+  /**
+   * @brief Computes the hash of content.
+   *
+   * @param content The content.
+   * @return The hash.
+   */
+  static ContentHash compute(const gsl::span<const std::byte>& content) noexcept;
+
+  /**
+   * @brief Returns whether two hashes identify the same content.
+   */
+  bool operator==(const ContentHash& rhs) const noexcept {
+    return this->byteLength == rhs.byteLength && this->hash1 == rhs.hash1 &&
+           this->hash2 == rhs.hash2;
+  }
+};
+
+} // namespace CesiumUtility
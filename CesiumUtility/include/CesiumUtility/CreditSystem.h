@@ -2,6 +2,7 @@
 
 #include "Library.h"
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -71,20 +72,58 @@ public:
 
   /**
    * @brief Adds the Credit to the set of credits to show this frame
+   *
+   * @param credit The credit.
+   * @param count The number of times the credit is used this frame, such as
+   * by how many tiles. Credits used more often are shown first.
+   */
+  void addCreditToFrame(Credit credit, int32_t count = 1);
+
+  /**
+   * @brief Adds a reference to the Credit, so that it is shown this frame and
+   * every later frame until the reference is removed.
+   *
+   * Unlike with {@link addCreditToFrame}, a referenced credit does not need to
+   * be added again each frame, so the cost of a frame is proportional to the
+   * credits that are added and removed rather than to the credits that are
+   * shown. Each reference counts as one use when the credits are sorted.
+   *
+   * @param credit The credit.
+   */
+  void addCreditReference(Credit credit);
+
+  /**
+   * @brief Removes a reference to the Credit that was added with
+   * {@link addCreditReference}.
+   *
+   * When the last reference is removed, the credit is still shown for the rest
+   * of this frame, but not from the next frame unless it is referenced or
+   * added to that frame.
+   *
+   * @param credit The credit.
    */
-  void addCreditToFrame(Credit credit);
+  void removeCreditReference(Credit credit);
 
   /**
    * @brief Notifies this CreditSystem to start tracking the credits to show for
    * the next frame.
    */
-  void startNextFrame() noexcept;
+  void startNextFrame();
 
   /**
    * @brief Get the credits to show this frame.
    */
   const std::vector<Credit>& getCreditsToShowThisFrame() noexcept;
 
+  /**
+   * @brief Gets whether the credits to show this frame, their order, or
+   * whether they should be shown on screen differ from the last frame.
+   *
+   * When this is `false`, credits that were displayed last frame do not need
+   * to be updated.
+   */
+  bool haveCreditsChangedThisFrame() noexcept;
+
   /**
    * @brief Get the credits that were shown last frame but should no longer be
    * shown.
@@ -102,13 +141,18 @@ private:
     std::string html;
     bool showOnScreen;
     int32_t lastFrameNumber;
-    int count;
+    int32_t count;
+    int32_t referenceCount;
   };
 
+  void showThisFrame(Credit credit);
+
   std::vector<HtmlAndLastFrameNumber> _credits;
 
   int32_t _currentFrameNumber = 0;
   std::vector<Credit> _creditsToShowThisFrame;
   std::vector<Credit> _creditsToNoLongerShowThisFrame;
+  std::vector<Credit> _creditsShownLastFrame;
+  bool _showOnScreenChangedThisFrame = false;
 };
 } // namespace CesiumUtility
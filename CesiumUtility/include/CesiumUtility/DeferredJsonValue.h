@@ -0,0 +1,60 @@
+#pragma once
+
+#include "JsonValue.h"
+#include "Library.h"
+
+#include <optional>
+#include <string>
+
+namespace CesiumUtility {
+
+/**
+ * @brief The JSON text of a value that is only parsed into a
+ * {@link JsonValue} when it is first accessed.
+ *
+ * Extensions that are read with `CesiumJsonReader::ExtensionState::Deferred`
+ * are stored as instances of this class in
+ * {@link ExtensibleObject::extensions}, and are parsed by
+ * {@link ExtensibleObject::getGenericExtension}.
+ *
+ * The first access parses the JSON, so it must not happen concurrently with
+ * any other access to the same instance, even through a const reference.
+ */
+class CESIUMUTILITY_API DeferredJsonValue final {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param json The JSON text of the value.
+   */
+  explicit DeferredJsonValue(std::string&& json) noexcept;
+
+  /**
+   * @brief Gets the JSON text of the value, as it was read.
+   *
+   * Changes made to the parsed value are not reflected in this text.
+   */
+  const std::string& getJson() const noexcept { return this->_json; }
+
+  /**
+   * @brief Determines whether the JSON text has been parsed yet.
+   */
+  bool isParsed() const noexcept { return this->_value.has_value(); }
+
+  /**
+   * @brief Gets the value, parsing the JSON text if it has not been parsed
+   * yet.
+   *
+   * If the JSON text is not valid, the value is null.
+   */
+  const JsonValue& getValue() const;
+
+  /** @copydoc DeferredJsonValue::getValue */
+  JsonValue& getValue();
+
+private:
+  std::string _json;
+  mutable std::optional<JsonValue> _value;
+};
+
+} // namespace CesiumUtility
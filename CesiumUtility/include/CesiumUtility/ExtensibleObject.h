@@ -52,6 +52,9 @@ struct CESIUMUTILITY_API ExtensibleObject {
    * If the extension exists but has a static type, this method will return
    * nullptr. Use {@link getExtension} to retrieve a statically-typed extension.
    *
+   * If the extension is a {@link DeferredJsonValue}, it is parsed by the first
+   * call.
+   *
    * @param extensionName The name of the extension.
    * @return The generic extension, or nullptr if the generic extension doesn't
    * exist.
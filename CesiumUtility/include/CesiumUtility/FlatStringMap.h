@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace CesiumUtility {
+
+/**
+ * @brief A map from strings to values that stores its entries in a single
+ * vector, sorted by key.
+ *
+ * It has the subset of the interface of `std::map<std::string, TValue>` that
+ * is used for JSON objects, and iterates over its entries in the same order.
+ * Compared to a `std::map`, it uses one allocation rather than one per entry,
+ * and looks keys up with a binary search over contiguous memory. Keys may be
+ * looked up with a `std::string_view` or a `const char*` without creating a
+ * `std::string`.
+ *
+ * Unlike a `std::map`, adding or removing an entry invalidates the iterators
+ * of, and references to, all other entries. Adding many entries in an
+ * arbitrary order takes time proportional to the square of their number, but
+ * entries added in increasing key order, as is common, are appended.
+ *
+ * The keys of the entries must not be modified through the iterators.
+ *
+ * @tparam TValue The type of the values.
+ */
+template <typename TValue> class FlatStringMap {
+public:
+  /** @brief The type of the keys. */
+  using key_type = std::string;
+  /** @brief The type of the values. */
+  using mapped_type = TValue;
+  /** @brief The type of the entries. */
+  using value_type = std::pair<std::string, TValue>;
+  /** @brief The type of the sizes. */
+  using size_type = size_t;
+  /** @brief An iterator over the entries. */
+  using iterator = typename std::vector<value_type>::iterator;
+  /** @brief A const iterator over the entries. */
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  /**
+   * @brief Constructs an empty map.
+   */
+  FlatStringMap() noexcept = default;
+
+  /**
+   * @brief Constructs a map with the given entries.
+   *
+   * If a key appears more than once, the first entry with it is kept, as in
+   * a `std::map`.
+   */
+  FlatStringMap(std::initializer_list<value_type> entries)
+      : FlatStringMap(entries.begin(), entries.end()) {}
+
+  /**
+   * @brief Constructs a map with the entries in the given range, such as that
+   * of a `std::map`.
+   *
+   * If a key appears more than once, the first entry with it is kept.
+   */
+  template <typename TIterator>
+  FlatStringMap(TIterator first, TIterator last) : _entries() {
+    for (; first != last; ++first) {
+      this->emplace(first->first, first->second);
+    }
+  }
+
+  /** @brief Gets an iterator to the first entry. */
+  iterator begin() noexcept { return this->_entries.begin(); }
+  /** @copydoc begin */
+  const_iterator begin() const noexcept { return this->_entries.begin(); }
+  /** @copydoc begin */
+  const_iterator cbegin() const noexcept { return this->_entries.cbegin(); }
+
+  /** @brief Gets an iterator past the last entry. */
+  iterator end() noexcept { return this->_entries.end(); }
+  /** @copydoc end */
+  const_iterator end() const noexcept { return this->_entries.end(); }
+  /** @copydoc end */
+  const_iterator cend() const noexcept { return this->_entries.cend(); }
+
+  /** @brief Determines whether the map has no entries. */
+  bool empty() const noexcept { return this->_entries.empty(); }
+
+  /** @brief Gets the number of entries. */
+  size_type size() const noexcept { return this->_entries.size(); }
+
+  /** @brief Removes all of the entries. */
+  void clear() noexcept { this->_entries.clear(); }
+
+  /**
+   * @brief Allocates space for the given number of entries.
+   */
+  void reserve(size_type count) { this->_entries.reserve(count); }
+
+  /**
+   * @brief Finds the entry with the given key.
+   *
+   * @return An iterator to the entry, or {@link end} if there is none.
+   */
+  iterator find(std::string_view key) noexcept {
+    const iterator it = this->lowerBound(key);
+    return it != this->end() && it->first == key ? it : this->end();
+  }
+
+  /** @copydoc find */
+  const_iterator find(std::string_view key) const noexcept {
+    return const_cast<FlatStringMap*>(this)->find(key);
+  }
+
+  /**
+   * @brief Gets the number of entries with the given key, which is 0 or 1.
+   */
+  size_type count(std::string_view key) const noexcept {
+    return this->find(key) != this->end() ? 1 : 0;
+  }
+
+  /**
+   * @brief Gets the value with the given key.
+   *
+   * @throws std::out_of_range If there is no entry with the key.
+   */
+  TValue& at(std::string_view key) {
+    const iterator it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("The key is not in the map.");
+    }
+    return it->second;
+  }
+
+  /** @copydoc at */
+  const TValue& at(std::string_view key) const {
+    return const_cast<FlatStringMap*>(this)->at(key);
+  }
+
+  /**
+   * @brief Gets the value with the given key, adding a default-constructed
+   * one if there is none.
+   */
+  TValue& operator[](std::string_view key) {
+    return this->try_emplace(key).first->second;
+  }
+
+  /**
+   * @brief Adds an entry with the given key and a value constructed from the
+   * given arguments, unless there is already an entry with the key.
+   *
+   * @return An iterator to the entry with the key, and whether it was added.
+   */
+  template <typename TKey, typename... TArgs>
+  std::pair<iterator, bool> emplace(TKey&& key, TArgs&&... args) {
+    const std::string_view keyView(key);
+    const iterator it = this->lowerBound(keyView);
+    if (it != this->end() && it->first == keyView) {
+      return std::make_pair(it, false);
+    }
+
+    return std::make_pair(
+        this->_entries.emplace(
+            it,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<TKey>(key)),
+            std::forward_as_tuple(std::forward<TArgs>(args)...)),
+        true);
+  }
+
+  /** @copydoc emplace */
+  template <typename... TArgs>
+  std::pair<iterator, bool> try_emplace(std::string_view key, TArgs&&... args) {
+    return this->emplace(key, std::forward<TArgs>(args)...);
+  }
+
+  /**
+   * @brief Adds the given entry, unless there is already an entry with its
+   * key.
+   *
+   * @return An iterator to the entry with the key, and whether it was added.
+   */
+  std::pair<iterator, bool> insert(value_type&& entry) {
+    return this->emplace(std::move(entry.first), std::move(entry.second));
+  }
+
+  /** @copydoc insert */
+  std::pair<iterator, bool> insert(const value_type& entry) {
+    return this->emplace(entry.first, entry.second);
+  }
+
+  /**
+   * @brief Sets the value with the given key, adding an entry if there is
+   * none.
+   *
+   * @return An iterator to the entry with the key, and whether it was added.
+   */
+  template <typename TKey, typename TArg>
+  std::pair<iterator, bool> insert_or_assign(TKey&& key, TArg&& value) {
+    std::pair<iterator, bool> result =
+        this->emplace(std::forward<TKey>(key), std::forward<TArg>(value));
+    if (!result.second) {
+      result.first->second = std::forward<TArg>(value);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Removes the given entry.
+   *
+   * @return An iterator to the entry after the removed one.
+   */
+  iterator erase(const_iterator position) {
+    return this->_entries.erase(position);
+  }
+
+  /**
+   * @brief Removes the entry with the given key, if there is one.
+   *
+   * @return The number of entries removed, which is 0 or 1.
+   */
+  size_type erase(std::string_view key) {
+    const iterator it = this->find(key);
+    if (it == this->end()) {
+      return 0;
+    }
+    this->_entries.erase(it);
+    return 1;
+  }
+
+private:
+  iterator lowerBound(std::string_view key) noexcept {
+    // Entries are often added in increasing key order, so check for that
+    // before searching.
+    if (this->_entries.empty() ||
+        std::string_view(this->_entries.back().first) < key) {
+      return this->end();
+    }
+
+    return std::lower_bound(
+        this->_entries.begin(),
+        this->_entries.end(),
+        key,
+        [](const value_type& entry, std::string_view value) {
+          return std::string_view(entry.first) < value;
+        });
+  }
+
+  std::vector<value_type> _entries;
+};
+
+} // namespace CesiumUtility
@@ -1,14 +1,98 @@
 #pragma once
+#include "Library.h"
+
 #include <gsl/span>
 
+#include <cstddef>
+#include <memory>
+#include <optional>
 #include <vector>
 
+struct z_stream_s;
+
 namespace CesiumUtility {
 extern bool isGzip(const gsl::span<const std::byte>& data);
 /**
  * Gunzip data. If successful, it will return true and the result will be in the
  * provided vector.
+ *
+ * The vector is sized up front from {@link getGunzippedSize}, so that data
+ * that is gunzipped in one piece is not copied while the vector grows.
  */
 extern bool
 gunzip(const gsl::span<const std::byte>& data, std::vector<std::byte>& out);
+
+/**
+ * Gunzip data into a buffer provided by the caller, such as one that is sized
+ * with {@link getGunzippedSize}. If successful, it will return true and the
+ * size of the result will be in `outSize`. It will return false if the result
+ * does not fit in the buffer.
+ */
+extern bool gunzip(
+    const gsl::span<const std::byte>& data,
+    const gsl::span<std::byte>& out,
+    size_t& outSize);
+
+/**
+ * Gets the size of gzipped data after it is gunzipped, from the size that is
+ * stored at the end of the data, or `std::nullopt` if the data is not gzipped.
+ *
+ * The stored size is only a hint, because it is the size modulo 2^32, and a
+ * corrupt or malicious file may store any size.
+ */
+extern std::optional<size_t>
+getGunzippedSize(const gsl::span<const std::byte>& data);
+
+/**
+ * Inflates raw deflate data, which has no gzip or zlib header, such as an
+ * entry of a zip archive. If successful, it will return true and the result
+ * will be in the provided vector.
+ *
+ * The vector is sized up front from `sizeHint`, such as the uncompressed size
+ * that a zip archive records for the entry.
+ */
+extern bool inflateRaw(
+    const gsl::span<const std::byte>& data,
+    size_t sizeHint,
+    std::vector<std::byte>& out);
+
+/**
+ * Gzip data. If successful, it will return true and the result will be in the
+ * provided vector.
+ */
+extern bool
+gzip(const gsl::span<const std::byte>& data, std::vector<std::byte>& out);
+
+/**
+ * Gunzips data that is received in pieces, such as a response that is
+ * streamed, without waiting for all of it.
+ */
+class CESIUMUTILITY_API GunzipStream {
+public:
+  GunzipStream();
+  ~GunzipStream() noexcept;
+
+  GunzipStream(const GunzipStream&) = delete;
+  GunzipStream& operator=(const GunzipStream&) = delete;
+
+  /**
+   * Gunzips the next piece of the data, and appends the result to the
+   * provided vector. It will return false if the data is not valid, after
+   * which no more data is gunzipped.
+   *
+   * Data after the end of the gzipped data is ignored.
+   */
+  bool
+  write(const gsl::span<const std::byte>& data, std::vector<std::byte>& out);
+
+  /**
+   * Whether the end of the gzipped data was reached.
+   */
+  bool isFinished() const noexcept { return this->_finished; }
+
+private:
+  std::unique_ptr<z_stream_s> _pStream;
+  bool _failed;
+  bool _finished;
+};
 } // namespace CesiumUtility
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumUtility {
+
+/**
+ * @brief Functions for computing the hashes of small keys, such as tile IDs.
+ */
+struct Hash {
+  /**
+   * @brief Mixes the bits of a 64-bit value.
+   *
+   * Values that differ in only a few bits, like the coordinates of
+   * neighboring tiles, give very different results. This is the finalizer of
+   * MurmurHash3.
+   *
+   * @param value The value.
+   * @return The mixed value.
+   */
+  static constexpr uint64_t mix(uint64_t value) noexcept {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+  }
+
+  /**
+   * @brief Combines two 64-bit values into a hash.
+   *
+   * @param first The first value.
+   * @param second The second value.
+   * @return The hash.
+   */
+  static constexpr size_t combine(uint64_t first, uint64_t second) noexcept {
+    return static_cast<size_t>(
+        mix(first ^ (mix(second) + 0x9e3779b97f4a7c15ULL)));
+  }
+};
+
+} // namespace CesiumUtility
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FlatStringMap.h"
 #include "Library.h"
 
 #include <gsl/narrow>
@@ -83,8 +84,13 @@ public:
 
   /**
    * @brief The type to represent an `Object` JSON value.
+   *
+   * Its properties are kept in a single vector sorted by key, rather than in
+   * a node per property, which makes it smaller and faster to search for the
+   * many small objects of metadata. See {@link FlatStringMap} for how it
+   * differs from a `std::map`.
    */
-  using Object = std::map<std::string, JsonValue>;
+  using Object = FlatStringMap<JsonValue>;
 
   /**
    * @brief The type to represent an `Array` JSON value.
@@ -183,12 +189,18 @@ public:
   /**
    * @brief Creates an `Object` JSON value with the given properties.
    */
-  JsonValue(const std::map<std::string, JsonValue>& v) : value(v) {}
+  JsonValue(const Object& v) : value(v) {}
+
+  /**
+   * @brief Creates an `Object` JSON value with the given properties.
+   */
+  JsonValue(Object&& v) noexcept : value(std::move(v)) {}
 
   /**
    * @brief Creates an `Object` JSON value with the given properties.
    */
-  JsonValue(std::map<std::string, JsonValue>&& v) : value(std::move(v)) {}
+  JsonValue(const std::map<std::string, JsonValue>& v)
+      : value(Object(v.begin(), v.end())) {}
 
   /**
    * @brief Creates an `Array` JSON value with the given elements.
@@ -210,7 +222,7 @@ public:
    * @brief Creates an JSON value from the given initializer list.
    */
   JsonValue(std::initializer_list<std::pair<const std::string, JsonValue>> v)
-      : value(std::map<std::string, JsonValue>(v)) {}
+      : value(Object(v.begin(), v.end())) {}
 
   [[nodiscard]] const JsonValue*
   getValuePtrForKey(const std::string& key) const;
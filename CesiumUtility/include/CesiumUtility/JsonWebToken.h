@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Library.h"
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+namespace CesiumUtility {
+
+/**
+ * @brief Functions for reading the claims of a JSON Web Token (JWT), such as
+ * a Cesium ion access token.
+ *
+ * The signature of the token is not verified.
+ */
+class CESIUMUTILITY_API JsonWebToken final {
+public:
+  /**
+   * @brief Gets the decoded JSON payload of the given token.
+   *
+   * @param token The token.
+   * @return The JSON text of the payload, or `std::nullopt` if the token does
+   * not have a payload that can be decoded.
+   */
+  static std::optional<std::string> getPayload(const std::string& token);
+
+  /**
+   * @brief Gets the time at which the given token expires, from its `exp`
+   * claim.
+   *
+   * @param token The token.
+   * @return The expiry, or `std::nullopt` if the token is not a valid JSON Web
+   * Token or does not have an `exp` claim.
+   */
+  static std::optional<std::chrono::system_clock::time_point>
+  getExpiry(const std::string& token);
+};
+
+} // namespace CesiumUtility
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Library.h"
+#include "SharedBytes.h"
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace CesiumUtility {
+
+/**
+ * @brief A file that is mapped read-only into memory.
+ *
+ * The operating system reads the pages of the file as they are touched, and
+ * may drop pages that have not been touched recently without them counting
+ * against the memory of the process. The mapping is closed when the last
+ * reference to this object, including those held by the {@link SharedBytes}
+ * returned by {@link getRegion}, is released.
+ */
+class CESIUMUTILITY_API MemoryMappedFile final
+    : public std::enable_shared_from_this<MemoryMappedFile> {
+public:
+  /**
+   * @brief Maps a file into memory.
+   *
+   * @param path The path of the file.
+   * @return The mapped file, or nullptr if the file does not exist, is empty,
+   * or can't be mapped.
+   */
+  static std::shared_ptr<const MemoryMappedFile> open(const std::string& path);
+
+  ~MemoryMappedFile() noexcept;
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+  /**
+   * @brief Gets the contents of the file.
+   */
+  gsl::span<const std::byte> getData() const noexcept {
+    return gsl::span<const std::byte>(this->_pData, this->_size);
+  }
+
+  /**
+   * @brief Gets a region of the file that keeps the mapping open.
+   *
+   * @param offset The offset of the region from the start of the file.
+   * @param size The number of bytes in the region.
+   * @return The region, or an empty range if it does not fit in the file.
+   */
+  SharedBytes getRegion(size_t offset, size_t size) const;
+
+  /**
+   * @brief Asks the operating system to start reading the whole file in the
+   * background, so that touching its pages later does not wait for the disk.
+   *
+   * This returns without waiting for the file to be read. It is only a hint,
+   * which some operating systems ignore.
+   */
+  void prefetch() const noexcept;
+
+private:
+  MemoryMappedFile(const std::byte* pData, size_t size) noexcept
+      : _pData(pData), _size(size) {}
+
+  const std::byte* _pData;
+  size_t _size;
+};
+
+} // namespace CesiumUtility
@@ -0,0 +1,336 @@
+#pragma once
+
+#include "Library.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace CesiumUtility {
+
+/**
+ * @brief The labels of a metric, as name and value pairs.
+ */
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief A count that only increases, such as the number of completed
+ * requests.
+ *
+ * It may be updated from any thread.
+ */
+class CESIUMUTILITY_API MetricCounter final {
+public:
+  /**
+   * @brief Adds to the count.
+   *
+   * @param amount The amount to add, which must not be negative.
+   */
+  void increment(int64_t amount = 1) noexcept {
+    this->_value.fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the count.
+   */
+  int64_t getValue() const noexcept {
+    return this->_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<int64_t> _value{0};
+};
+
+/**
+ * @brief A value that may increase and decrease, such as the number of
+ * requests in progress.
+ *
+ * It may be updated from any thread.
+ */
+class CESIUMUTILITY_API MetricGauge final {
+public:
+  /**
+   * @brief Sets the value.
+   */
+  void set(int64_t value) noexcept {
+    this->_value.store(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Adds to the value.
+   *
+   * @param amount The amount to add, which may be negative.
+   */
+  void add(int64_t amount) noexcept {
+    this->_value.fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the value.
+   */
+  int64_t getValue() const noexcept {
+    return this->_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<int64_t> _value{0};
+};
+
+/**
+ * @brief Counts observed values, such as durations in seconds, in buckets
+ * with fixed upper bounds.
+ *
+ * It may be updated from any thread.
+ */
+class CESIUMUTILITY_API MetricHistogram final {
+public:
+  /**
+   * @brief Durations in seconds from 1 millisecond to 10 seconds.
+   */
+  static const std::vector<double> defaultSecondsBuckets;
+
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param bucketUpperBounds The upper bounds of the buckets, in increasing
+   * order. Values greater than the last bound are only counted by the
+   * implicit `+Inf` bucket.
+   */
+  explicit MetricHistogram(std::vector<double>&& bucketUpperBounds);
+
+  /**
+   * @brief Counts a value in the first bucket whose upper bound is greater
+   * than or equal to it.
+   */
+  void observe(double value) noexcept;
+
+  /**
+   * @brief Gets the upper bounds of the buckets.
+   */
+  const std::vector<double>& getBucketUpperBounds() const noexcept {
+    return this->_bucketUpperBounds;
+  }
+
+  /**
+   * @brief Gets the number of values in each bucket, and then the number of
+   * values greater than all of the upper bounds.
+   */
+  std::vector<int64_t> getBucketCounts() const;
+
+  /**
+   * @brief Gets the number of observed values.
+   */
+  int64_t getCount() const noexcept {
+    return this->_count.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the sum of the observed values.
+   */
+  double getSum() const noexcept {
+    return this->_sum.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::vector<double> _bucketUpperBounds;
+  std::unique_ptr<std::atomic<int64_t>[]> _bucketCounts;
+  std::atomic<int64_t> _count;
+  std::atomic<double> _sum;
+};
+
+/**
+ * @brief Observes the time in seconds from its construction to its
+ * destruction in a {@link MetricHistogram}.
+ */
+class CESIUMUTILITY_API ScopedMetricTimer final {
+public:
+  /**
+   * @brief Starts timing.
+   *
+   * @param histogram The histogram to observe the time in. It must outlive
+   * this timer.
+   */
+  explicit ScopedMetricTimer(MetricHistogram& histogram) noexcept
+      : _histogram(histogram), _startTime(std::chrono::steady_clock::now()) {}
+
+  ~ScopedMetricTimer() noexcept {
+    this->_histogram.observe(std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() -
+                                 this->_startTime)
+                                 .count());
+  }
+
+  ScopedMetricTimer(const ScopedMetricTimer&) = delete;
+  ScopedMetricTimer& operator=(const ScopedMetricTimer&) = delete;
+
+private:
+  MetricHistogram& _histogram;
+  std::chrono::steady_clock::time_point _startTime;
+};
+
+/**
+ * @brief The type of a metric in a {@link MetricsRegistry}.
+ */
+enum class MetricType { Counter, Gauge, Histogram };
+
+/**
+ * @brief The value of a metric at the time of
+ * {@link MetricsRegistry::getSnapshot}.
+ */
+struct CESIUMUTILITY_API MetricSnapshot {
+  /**
+   * @brief The name of the metric.
+   */
+  std::string name;
+
+  /**
+   * @brief The description of the metric.
+   */
+  std::string help;
+
+  /**
+   * @brief The labels of the metric, sorted by name.
+   */
+  MetricLabels labels;
+
+  /**
+   * @brief The type of the metric.
+   */
+  MetricType type = MetricType::Counter;
+
+  /**
+   * @brief The value of a counter or gauge.
+   */
+  int64_t value = 0;
+
+  /**
+   * @brief The upper bounds of the buckets of a histogram.
+   */
+  std::vector<double> bucketUpperBounds;
+
+  /**
+   * @brief The number of values in each bucket of a histogram, as returned by
+   * {@link MetricHistogram::getBucketCounts}.
+   */
+  std::vector<int64_t> bucketCounts;
+
+  /**
+   * @brief The number of values observed by a histogram.
+   */
+  int64_t count = 0;
+
+  /**
+   * @brief The sum of the values observed by a histogram.
+   */
+  double sum = 0.0;
+};
+
+/**
+ * @brief A set of named metrics, which may be read as a snapshot or in the
+ * Prometheus text format.
+ *
+ * Metrics are never removed from a registry, so the references returned when
+ * they are registered stay valid for its lifetime. Registering a metric with
+ * the name and labels of an existing one returns the existing one, so
+ * instrumented code usually keeps the reference in a function-local static
+ * variable rather than looking it up each time.
+ *
+ * All of the methods may be called from any thread.
+ */
+class CESIUMUTILITY_API MetricsRegistry final {
+public:
+  /**
+   * @brief Gets the registry of the metrics of cesium-native itself.
+   */
+  static MetricsRegistry& getDefault();
+
+  MetricsRegistry();
+  ~MetricsRegistry() noexcept;
+
+  MetricsRegistry(const MetricsRegistry&) = delete;
+  MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+  /**
+   * @brief Gets a counter, registering it if it does not exist.
+   *
+   * @param name The name of the metric, such as `cesium_requests_total`.
+   * @param help The description of the metric.
+   * @param labels The labels that distinguish this counter from others with
+   * the same name.
+   * @throws std::invalid_argument If a metric of another type has the same
+   * name and labels.
+   */
+  MetricCounter& counter(
+      const std::string& name,
+      const std::string& help,
+      const MetricLabels& labels = {});
+
+  /**
+   * @brief Gets a gauge, registering it if it does not exist.
+   *
+   * @copydetails counter
+   */
+  MetricGauge& gauge(
+      const std::string& name,
+      const std::string& help,
+      const MetricLabels& labels = {});
+
+  /**
+   * @brief Gets a histogram, registering it if it does not exist.
+   *
+   * @param name The name of the metric, such as `cesium_request_seconds`.
+   * @param help The description of the metric.
+   * @param bucketUpperBounds The upper bounds of the buckets, if the
+   * histogram is registered by this call.
+   * @param labels The labels that distinguish this histogram from others with
+   * the same name.
+   * @throws std::invalid_argument If a metric of another type has the same
+   * name and labels.
+   */
+  MetricHistogram& histogram(
+      const std::string& name,
+      const std::string& help,
+      const std::vector<double>& bucketUpperBounds =
+          MetricHistogram::defaultSecondsBuckets,
+      const MetricLabels& labels = {});
+
+  /**
+   * @brief Gets the current values of all of the metrics, sorted by name and
+   * labels.
+   */
+  std::vector<MetricSnapshot> getSnapshot() const;
+
+  /**
+   * @brief Gets the current values of all of the metrics in the Prometheus
+   * text exposition format.
+   */
+  std::string toPrometheusText() const;
+
+private:
+  struct Metric {
+    std::string name;
+    std::string help;
+    MetricLabels labels;
+    MetricType type;
+    std::unique_ptr<MetricCounter> pCounter;
+    std::unique_ptr<MetricGauge> pGauge;
+    std::unique_ptr<MetricHistogram> pHistogram;
+  };
+
+  Metric& getOrAddMetric(
+      const std::string& name,
+      const std::string& help,
+      const MetricLabels& labels,
+      MetricType type);
+
+  mutable std::mutex _mutex;
+  std::map<std::pair<std::string, MetricLabels>, Metric> _metrics;
+};
+
+} // namespace CesiumUtility
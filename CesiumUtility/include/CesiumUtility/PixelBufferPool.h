@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Library.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace CesiumUtility {
+
+/**
+ * @brief A pool of the buffers of image pixel data, such as
+ * `CesiumGltf::ImageCesium::pixelData`, that lets images reuse the memory of
+ * images that were freed rather than allocating a buffer of the same size
+ * again, which fragments the heap over a long session.
+ *
+ * Buffers are pooled by size class: a buffer that is acquired from the pool
+ * has a capacity of the smallest power of two that fits it, from
+ * {@link minimumPooledSize} to {@link maximumPooledSize}, so the standard
+ * sizes of overlay tiles and textures, like 256x256 or 1024x1024 RGBA,
+ * fit a class exactly. Smaller and larger buffers are not pooled.
+ *
+ * All of the methods may be called from any thread.
+ */
+class CESIUMUTILITY_API PixelBufferPool final {
+public:
+  /**
+   * @brief The capacity of the smallest size class, in bytes.
+   */
+  static constexpr size_t minimumPooledSize = size_t(1) << 16;
+
+  /**
+   * @brief The capacity of the largest size class, in bytes.
+   */
+  static constexpr size_t maximumPooledSize = size_t(1) << 26;
+
+  /**
+   * @brief Gets the pool used by the image readers and raster overlays of
+   * cesium-native.
+   */
+  static PixelBufferPool& getDefault();
+
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param maximumPooledBytes The most bytes of buffers the pool keeps. Buffers
+   * that are released while the pool is full are freed.
+   */
+  explicit PixelBufferPool(int64_t maximumPooledBytes = 256 * 1024 * 1024);
+
+  PixelBufferPool(const PixelBufferPool&) = delete;
+  PixelBufferPool& operator=(const PixelBufferPool&) = delete;
+
+  /**
+   * @brief Gets a buffer of a number of zero bytes, reusing a pooled buffer of
+   * its size class if there is one.
+   *
+   * @param size The number of bytes.
+   */
+  std::vector<std::byte> acquire(size_t size);
+
+  /**
+   * @brief Returns a buffer to the pool, so that a later call to
+   * {@link acquire} can reuse it, and leaves it empty and without capacity.
+   *
+   * Buffers whose capacity is not a size class are freed, so it is fine to
+   * release buffers that were not acquired from the pool.
+   *
+   * @param buffer The buffer.
+   */
+  void release(std::vector<std::byte>& buffer) noexcept;
+
+  /**
+   * @brief Frees all of the pooled buffers.
+   *
+   * @return The number of bytes freed.
+   */
+  int64_t clear() noexcept;
+
+  /**
+   * @brief Gets the number of bytes of the buffers in the pool.
+   */
+  int64_t getPooledBytes() const noexcept;
+
+  /**
+   * @brief Gets the most bytes of buffers the pool keeps.
+   */
+  int64_t getMaximumPooledBytes() const noexcept;
+
+  /**
+   * @brief Sets the most bytes of buffers the pool keeps, freeing pooled
+   * buffers until they fit.
+   */
+  void setMaximumPooledBytes(int64_t maximumPooledBytes) noexcept;
+
+private:
+  static constexpr size_t sizeClassCount = 11;
+
+  void trimToMaximum() noexcept;
+
+  mutable std::mutex _mutex;
+  std::array<std::vector<std::vector<std::byte>>, sizeClassCount> _buffers;
+  int64_t _pooledBytes;
+  int64_t _maximumPooledBytes;
+};
+
+} // namespace CesiumUtility
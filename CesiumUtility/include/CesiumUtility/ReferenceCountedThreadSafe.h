@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+
+namespace CesiumUtility {
+
+/**
+ * @brief A reference-counted base class, meant to be used with
+ * {@link IntrusivePointer}. The reference count is thread-safe, so references
+ * may be added and removed (including automatically via `IntrusivePointer`)
+ * from any thread, such as by capturing an `IntrusivePointer` in a
+ * continuation that runs in a worker thread.
+ *
+ * Only the reference count is thread-safe. Access to the rest of the object
+ * must still be synchronized by the derived class. Adding and removing a
+ * reference is an atomic operation, so prefer
+ * {@link ReferenceCountedNonThreadSafe} for objects that are only ever used
+ * from one thread.
+ *
+ * @tparam T The type that is _deriving_ from this class. For example, you
+ * should declare your class as
+ * `class MyClass : public ReferenceCountedThreadSafe<MyClass> { ... };`
+ */
+template <typename T> class ReferenceCountedThreadSafe {
+public:
+  ReferenceCountedThreadSafe() noexcept {}
+
+  /**
+   * @brief Copies an object without its references, so the copy starts with
+   * none.
+   */
+  ReferenceCountedThreadSafe(const ReferenceCountedThreadSafe&) noexcept {}
+
+  /**
+   * @brief Assigns an object without changing the references to this one.
+   */
+  ReferenceCountedThreadSafe&
+  operator=(const ReferenceCountedThreadSafe&) noexcept {
+    return *this;
+  }
+
+  ~ReferenceCountedThreadSafe() noexcept {
+    assert(this->_referenceCount.load(std::memory_order_relaxed) == 0);
+  }
+
+  /**
+   * @brief Adds a counted reference to this object. Use
+   * {@link CesiumUtility::IntrusivePointer} instead of calling this method
+   * directly.
+   *
+   * This method is thread safe.
+   */
+  void addReference() const noexcept {
+    this->_referenceCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Removes a counted reference from this object. When the last
+   * reference is removed, this method will delete this instance. Use
+   * {@link CesiumUtility::IntrusivePointer} instead of calling this method
+   * directly.
+   *
+   * This method is thread safe. The instance is deleted in the thread that
+   * removes the last reference.
+   */
+  void releaseReference() const /*noexcept*/ {
+    // Releasing makes this thread's writes to the object visible to the thread
+    // that deletes it, and acquiring makes the other threads' writes visible
+    // to this one in case it deletes it.
+    const int32_t references =
+        this->_referenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    assert(references >= 0);
+    if (references == 0) {
+      delete static_cast<const T*>(this);
+    }
+  }
+
+  /**
+   * @brief Returns the current reference count of this instance.
+   *
+   * If other threads hold references, the count may change at any time.
+   */
+  std::int32_t getReferenceCount() const noexcept {
+    return this->_referenceCount.load(std::memory_order_relaxed);
+  }
+
+private:
+  mutable std::atomic<std::int32_t> _referenceCount{0};
+};
+
+} // namespace CesiumUtility
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace CesiumUtility {
+
+/**
+ * @brief A read-only range of bytes that is stored elsewhere, such as in a
+ * region of a {@link MemoryMappedFile} or in a vector shared by several
+ * owners.
+ *
+ * The bytes stay valid for as long as any copy of this object holds their
+ * owner. When there is no owner, the bytes are not owned at all, and whoever
+ * created this object must keep them alive for as long as it is used.
+ */
+class SharedBytes final {
+public:
+  /**
+   * @brief Creates an empty range.
+   */
+  SharedBytes() noexcept = default;
+
+  /**
+   * @brief Creates a range of bytes that are kept alive by an owner.
+   *
+   * @param pOwner The object that keeps the bytes alive, or nullptr if they
+   * are not owned.
+   * @param bytes The bytes.
+   */
+  SharedBytes(
+      std::shared_ptr<const void> pOwner,
+      const gsl::span<const std::byte>& bytes) noexcept
+      : _pOwner(std::move(pOwner)), _bytes(bytes) {}
+
+  /**
+   * @brief Creates a range that takes ownership of a vector of bytes.
+   *
+   * @param bytes The bytes.
+   */
+  static SharedBytes fromVector(std::vector<std::byte>&& bytes) {
+    auto pBytes = std::make_shared<const std::vector<std::byte>>(
+        std::move(bytes));
+    const gsl::span<const std::byte> span(*pBytes);
+    return SharedBytes(std::move(pBytes), span);
+  }
+
+  /**
+   * @brief Gets the bytes.
+   */
+  const gsl::span<const std::byte>& getBytes() const noexcept {
+    return this->_bytes;
+  }
+
+  /**
+   * @brief Gets the object that keeps the bytes alive, or nullptr if they are
+   * not owned.
+   */
+  const std::shared_ptr<const void>& getOwner() const noexcept {
+    return this->_pOwner;
+  }
+
+  /**
+   * @brief Gets a range of some of these bytes, with the same owner.
+   *
+   * @param offset The offset of the first byte, which must not be past the
+   * end of these bytes.
+   * @param size The number of bytes, which must fit in these bytes after the
+   * offset.
+   */
+  SharedBytes subrange(size_t offset, size_t size) const noexcept {
+    return SharedBytes(this->_pOwner, this->_bytes.subspan(offset, size));
+  }
+
+private:
+  std::shared_ptr<const void> _pOwner;
+  gsl::span<const std::byte> _bytes;
+};
+
+} // namespace CesiumUtility
@@ -8,11 +8,46 @@
 #define CESIUM_TRACING_ENABLED 0
 #endif
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CesiumUtility {
+
+/**
+ * @brief Options for a tracing session started with
+ * {@link CESIUM_TRACE_INIT_WITH_OPTIONS}.
+ */
+struct TracingOptions {
+  /**
+   * @brief The categories of the events to record, or empty to record the
+   * events of all categories.
+   *
+   * The events of {@link CESIUM_TRACE} and the other macros without a
+   * category are in the `cesium` category.
+   */
+  std::vector<std::string> categories;
+
+  /**
+   * @brief Records the events of one in every this many frames, as counted by
+   * {@link CESIUM_TRACE_FRAME}.
+   *
+   * When this is 1, or the application does not use
+   * {@link CESIUM_TRACE_FRAME}, every event is recorded.
+   */
+  uint32_t frameSamplingInterval = 1;
+};
+
+} // namespace CesiumUtility
+
 #if !CESIUM_TRACING_ENABLED
 
 #define CESIUM_TRACE_INIT(filename)
+#define CESIUM_TRACE_INIT_WITH_OPTIONS(filename, options)
 #define CESIUM_TRACE_SHUTDOWN()
+#define CESIUM_TRACE_FRAME()
 #define CESIUM_TRACE(name)
+#define CESIUM_TRACE_IN_CATEGORY(category, name)
 #define CESIUM_TRACE_BEGIN(name)
 #define CESIUM_TRACE_END(name)
 #define CESIUM_TRACE_BEGIN_IN_TRACK(name)
@@ -27,11 +62,11 @@
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
+#include <memory>
 #include <mutex>
-#include <string>
 #include <thread>
-#include <vector>
 
 // helper macros to avoid shadowing variables
 #define TRACE_NAME_AUX1(A, B) A##B
@@ -41,17 +76,49 @@
  * @brief Initializes the tracing framework and begins recording to a given JSON
  * filename.
  *
+ * Each thread records its events into its own buffer without taking a lock,
+ * and a background thread writes them to the file. Names longer than
+ * {@link CesiumUtility::CesiumImpl::TraceRecord::maximumNameLength} characters
+ * are truncated, and events are dropped if a thread records them faster than
+ * they can be written.
+ *
  * @param filename The path and named of the file in which to record traces.
  */
 #define CESIUM_TRACE_INIT(filename)                                            \
   CesiumUtility::CesiumImpl::Tracer::instance().startTracing(filename)
 
+/**
+ * @brief Initializes the tracing framework and begins recording the events
+ * selected by {@link CesiumUtility::TracingOptions} to a given JSON filename.
+ *
+ * Tracing may be started and shut down any number of times while the
+ * application runs. While it is shut down, each traced operation costs only a
+ * relaxed atomic load.
+ *
+ * @param filename The path and named of the file in which to record traces.
+ * @param options The {@link CesiumUtility::TracingOptions}.
+ */
+#define CESIUM_TRACE_INIT_WITH_OPTIONS(filename, options)                      \
+  CesiumUtility::CesiumImpl::Tracer::instance().startTracing(filename, options)
+
 /**
  * @brief Shuts down tracing and closes the JSON tracing file.
  */
 #define CESIUM_TRACE_SHUTDOWN()                                                \
   CesiumUtility::CesiumImpl::Tracer::instance().endTracing()
 
+/**
+ * @brief Marks the start of a frame, for sampling with
+ * {@link CesiumUtility::TracingOptions::frameSamplingInterval}.
+ *
+ * This should be called once per frame by the main thread. The events that
+ * start in a frame that is not sampled are not recorded, even if they end in
+ * a sampled one. Events that are recorded with {@link CESIUM_TRACE_BEGIN} and
+ * {@link CESIUM_TRACE_END} in different frames may lose one of the pair.
+ */
+#define CESIUM_TRACE_FRAME()                                                   \
+  CesiumUtility::CesiumImpl::Tracer::instance().beginFrame()
+
 /**
  * @brief Measures and records the time spent in the current scope.
  *
@@ -67,6 +134,22 @@
       cesiumTrace,                                                             \
       __LINE__)(name)
 
+/**
+ * @brief Measures and records the time spent in the current scope, in a
+ * category that may be selected with
+ * {@link CesiumUtility::TracingOptions::categories}.
+ *
+ * This is otherwise identical to {@link CESIUM_TRACE}.
+ *
+ * @param category The category of the measured operation. This must be a
+ * string literal.
+ * @param name The name of the measured operation.
+ */
+#define CESIUM_TRACE_IN_CATEGORY(category, name)                               \
+  CesiumUtility::CesiumImpl::ScopedTrace TRACE_NAME_AUX2(                      \
+      cesiumTrace,                                                             \
+      __LINE__)(category, name)
+
 /**
  * @brief Begins measuring an operation which may span scope but not threads.
  *
@@ -211,6 +294,20 @@ struct Trace {
   std::thread::id threadID;
 };
 
+// A trace event as it is recorded, before it is written to the JSON file.
+struct TraceRecord {
+  static constexpr size_t maximumNameLength = 63;
+
+  const char* category;
+  int64_t start;
+  int64_t duration;
+  int64_t id;
+  std::thread::id threadID;
+  char type;
+  char name[maximumNameLength + 1];
+};
+
+class TraceBuffer;
 class TrackReference;
 
 class Tracer {
@@ -219,13 +316,30 @@ public:
 
   ~Tracer();
 
-  void startTracing(const std::string& filePath = "trace.json");
+  static constexpr const char* defaultCategory = "cesium";
+
+  void startTracing(
+      const std::string& filePath = "trace.json",
+      const TracingOptions& options = {});
   void endTracing();
+  void beginFrame();
 
-  void writeCompleteEvent(const Trace& trace);
-  void writeAsyncEventBegin(const char* name, int64_t id);
+  // Whether events in the given category are being recorded. This is only
+  // valid until the next call to beginFrame, startTracing or endTracing.
+  bool isRecording(const char* category = defaultCategory) const noexcept;
+
+  void writeCompleteEvent(
+      const Trace& trace,
+      const char* category = defaultCategory);
+  void writeAsyncEventBegin(
+      const char* name,
+      int64_t id,
+      const char* category = defaultCategory);
   void writeAsyncEventBegin(const char* name);
-  void writeAsyncEventEnd(const char* name, int64_t id);
+  void writeAsyncEventEnd(
+      const char* name,
+      int64_t id,
+      const char* category = defaultCategory);
   void writeAsyncEventEnd(const char* name);
 
   int64_t allocateTrackID();
@@ -233,22 +347,45 @@ public:
 private:
   Tracer();
 
+  bool isCategoryEnabled(const char* category) const noexcept;
   int64_t getCurrentThreadTrackID() const;
   void writeAsyncEvent(
       const char* category,
       const char* name,
       char type,
       int64_t id);
+  void writeRecord(const TraceRecord& record);
+
+  TraceBuffer& getCurrentThreadBuffer();
+  void drainBuffers();
+  void writeRecordToOutput(const TraceRecord& record);
 
   std::ofstream _output;
   uint32_t _numTraces;
-  std::mutex _lock;
+  // The options of each session are kept until the tracer is destroyed, so
+  // that other threads never read options that have been freed.
+  std::vector<std::unique_ptr<TracingOptions>> _sessionOptions;
+  std::atomic<const TracingOptions*> _pOptions;
+  uint32_t _frameNumber;
+  std::atomic<bool> _enabled;
+  std::atomic<bool> _recording;
+  std::atomic<uint64_t> _droppedRecords;
+  std::mutex _buffersLock;
+  std::vector<std::shared_ptr<TraceBuffer>> _buffers;
+  std::mutex _drainLock;
+  std::condition_variable _drainCondition;
+  bool _stopDraining;
+  std::thread _drainThread;
   std::atomic<int64_t> _lastAllocatedID;
+
+  friend class ScopedTrace;
+  friend class TrackSet;
 };
 
 class ScopedTrace {
 public:
   explicit ScopedTrace(const std::string& message);
+  ScopedTrace(const char* category, const std::string& message);
   ~ScopedTrace();
 
   void reset();
@@ -259,6 +396,7 @@ public:
   ScopedTrace& operator=(ScopedTrace&& rhs) = delete;
 
 private:
+  const char* _category;
   std::string _name;
   std::chrono::steady_clock::time_point _startTime;
   std::thread::id _threadId;
@@ -25,4 +25,50 @@ public:
 
   static std::string escape(const std::string& s);
 };
+
+/**
+ * @brief A base URI that is parsed once, so that the many relative URIs of a
+ * tileset or subtree can be resolved against it cheaply.
+ *
+ * {@link resolve} gives the same result as {@link Uri::resolve} with the same
+ * base. Relative paths made only of plain path characters, optionally followed
+ * by a query, are resolved by appending them to the base's directory without
+ * parsing them. Other URIs are resolved by {@link Uri::resolve}.
+ */
+class BaseUri final {
+public:
+  /**
+   * @brief Parses a base URI.
+   *
+   * @param uri The base URI. If it is not an absolute URI, relative URIs
+   * resolve to themselves, as with {@link Uri::resolve}.
+   */
+  explicit BaseUri(const std::string& uri);
+
+  /**
+   * @brief Gets the base URI that was parsed.
+   */
+  const std::string& getUri() const noexcept { return this->_uri; }
+
+  /**
+   * @brief Resolves a URI relative to this base URI.
+   *
+   * @param relative The relative URI.
+   * @param useBaseQuery Whether the query of the base URI is appended to the
+   * resolved URI.
+   * @return The resolved URI.
+   */
+  std::string
+  resolve(const std::string& relative, bool useBaseQuery = false) const;
+
+private:
+  std::string _uri;
+
+  // The normalized base URI up to and including the last slash of its path,
+  // or empty if relative paths cannot simply be appended to it.
+  std::string _directory;
+
+  // The query of the base URI, without the question mark.
+  std::string _query;
+};
 } // namespace CesiumUtility
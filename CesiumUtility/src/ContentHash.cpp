@@ -0,0 +1,52 @@
+#include "CesiumUtility/ContentHash.h"
+
+#include <cstring>
+
+namespace CesiumUtility {
+namespace {
+uint64_t rotateLeft(uint64_t value, int bits) noexcept {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+// The splitmix64 finalizer.
+uint64_t mix(uint64_t value) noexcept {
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+} // namespace
+
+/*static*/ ContentHash
+ContentHash::compute(const gsl::span<const std::byte>& content) noexcept {
+  const size_t byteLength = content.size();
+
+  // Two lanes with different constants, each a multiply-rotate hash of the
+  // content read eight bytes at a time.
+  uint64_t hash1 = 0x9E3779B97F4A7C15ULL ^ byteLength;
+  uint64_t hash2 = 0xC2B2AE3D27D4EB4FULL + byteLength;
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= byteLength; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, content.data() + i, sizeof(uint64_t));
+    hash1 = rotateLeft(hash1 ^ (word * 0x87C37B91114253D5ULL), 31) *
+            0x4CF5AD432745937FULL;
+    hash2 = rotateLeft(hash2 + (word * 0x52DCE729DA3ED7BBULL), 27) *
+                0x9FB21C651E98DF25ULL +
+            0x38495AB5ULL;
+  }
+
+  if (i < byteLength) {
+    uint64_t tail = 0;
+    std::memcpy(&tail, content.data() + i, byteLength - i);
+    hash1 ^= tail * 0x87C37B91114253D5ULL;
+    hash2 += tail * 0x52DCE729DA3ED7BBULL;
+  }
+
+  return ContentHash{
+      byteLength,
+      mix(hash1),
+      mix(hash2 ^ rotateLeft(hash1, 17))};
+}
+
+} // namespace CesiumUtility
@@ -13,12 +13,12 @@ Credit CreditSystem::createCredit(std::string&& html, bool showOnScreen) {
   for (size_t id = 0; id < _credits.size(); ++id) {
     if (_credits[id].html == html) {
       // Override the existing credit's showOnScreen value.
-      _credits[id].showOnScreen = showOnScreen;
+      this->setShowOnScreen(Credit(id), showOnScreen);
       return Credit(id);
     }
   }
 
-  _credits.push_back({std::move(html), showOnScreen, -1, 0});
+  _credits.push_back({std::move(html), showOnScreen, -1, 0, 0});
 
   return Credit(_credits.size() - 1);
 }
@@ -31,8 +31,10 @@ bool CreditSystem::shouldBeShownOnScreen(Credit credit) const noexcept {
 }
 
 void CreditSystem::setShowOnScreen(Credit credit, bool showOnScreen) noexcept {
-  if (credit.id < _credits.size()) {
+  if (credit.id < _credits.size() &&
+      _credits[credit.id].showOnScreen != showOnScreen) {
     _credits[credit.id].showOnScreen = showOnScreen;
+    _showOnScreenChangedThisFrame = true;
   }
 }
 
@@ -43,39 +45,50 @@ const std::string& CreditSystem::getHtml(Credit credit) const noexcept {
   return INVALID_CREDIT_MESSAGE;
 }
 
-void CreditSystem::addCreditToFrame(Credit credit) {
-  // if this credit has already been added to the current frame, there's nothing
-  // to do
-  if (_credits[credit.id].lastFrameNumber == _currentFrameNumber) {
-    ++_credits[credit.id].count;
-    return;
-  }
-
-  // add the credit to this frame
-  _creditsToShowThisFrame.push_back(credit);
+void CreditSystem::addCreditToFrame(Credit credit, int32_t count) {
+  _credits[credit.id].count += count;
+  this->showThisFrame(credit);
+}
 
-  // if the credit was shown last frame, remove it from
-  // _creditsToNoLongerShowThisFrame since it will still be shown
-  if (_credits[credit.id].lastFrameNumber == _currentFrameNumber - 1) {
-    _creditsToNoLongerShowThisFrame.erase(
-        std::remove(
-            _creditsToNoLongerShowThisFrame.begin(),
-            _creditsToNoLongerShowThisFrame.end(),
-            credit),
-        _creditsToNoLongerShowThisFrame.end());
+void CreditSystem::addCreditReference(Credit credit) {
+  if (++_credits[credit.id].referenceCount == 1) {
+    this->showThisFrame(credit);
   }
+}
 
-  // update the last frame this credit was shown
-  _credits[credit.id].lastFrameNumber = _currentFrameNumber;
+void CreditSystem::removeCreditReference(Credit credit) {
+  // The credit stays in this frame's list; startNextFrame does not carry it
+  // over to the next one.
+  if (_credits[credit.id].referenceCount > 0) {
+    --_credits[credit.id].referenceCount;
+  }
 }
 
-void CreditSystem::startNextFrame() noexcept {
+void CreditSystem::startNextFrame() {
   _creditsToNoLongerShowThisFrame.swap(_creditsToShowThisFrame);
+  _creditsShownLastFrame = _creditsToNoLongerShowThisFrame;
   _creditsToShowThisFrame.clear();
   _currentFrameNumber++;
-  for (const auto& credit : _creditsToNoLongerShowThisFrame) {
-    _credits[credit.id].count = 0;
-  }
+  _showOnScreenChangedThisFrame = false;
+
+  // Referenced credits are shown again without being added, so only the
+  // credits that are not are no longer shown.
+  auto referencedEnd = std::remove_if(
+      _creditsToNoLongerShowThisFrame.begin(),
+      _creditsToNoLongerShowThisFrame.end(),
+      [this](const Credit& credit) {
+        HtmlAndLastFrameNumber& record = _credits[credit.id];
+        record.count = 0;
+        if (record.referenceCount == 0) {
+          return false;
+        }
+        record.lastFrameNumber = _currentFrameNumber;
+        _creditsToShowThisFrame.push_back(credit);
+        return true;
+      });
+  _creditsToNoLongerShowThisFrame.erase(
+      referencedEnd,
+      _creditsToNoLongerShowThisFrame.end());
 }
 
 const std::vector<Credit>& CreditSystem::getCreditsToShowThisFrame() noexcept {
@@ -87,8 +100,8 @@ const std::vector<Credit>& CreditSystem::getCreditsToShowThisFrame() noexcept {
       _creditsToShowThisFrame.begin(),
       _creditsToShowThisFrame.end(),
       [this](const Credit& a, const Credit& b) {
-        int32_t aCounts = _credits[a.id].count;
-        int32_t bCounts = _credits[b.id].count;
+        int32_t aCounts = _credits[a.id].count + _credits[a.id].referenceCount;
+        int32_t bCounts = _credits[b.id].count + _credits[b.id].referenceCount;
         if (aCounts == bCounts)
           return a.id < b.id;
         else
@@ -96,4 +109,34 @@ const std::vector<Credit>& CreditSystem::getCreditsToShowThisFrame() noexcept {
       });
   return _creditsToShowThisFrame;
 }
+
+bool CreditSystem::haveCreditsChangedThisFrame() noexcept {
+  return _showOnScreenChangedThisFrame ||
+         this->getCreditsToShowThisFrame() != _creditsShownLastFrame;
+}
+
+void CreditSystem::showThisFrame(Credit credit) {
+  // if this credit has already been added to the current frame, there's nothing
+  // to do
+  if (_credits[credit.id].lastFrameNumber == _currentFrameNumber) {
+    return;
+  }
+
+  // add the credit to this frame
+  _creditsToShowThisFrame.push_back(credit);
+
+  // if the credit was shown last frame, remove it from
+  // _creditsToNoLongerShowThisFrame since it will still be shown
+  if (_credits[credit.id].lastFrameNumber == _currentFrameNumber - 1) {
+    _creditsToNoLongerShowThisFrame.erase(
+        std::remove(
+            _creditsToNoLongerShowThisFrame.begin(),
+            _creditsToNoLongerShowThisFrame.end(),
+            credit),
+        _creditsToNoLongerShowThisFrame.end());
+  }
+
+  // update the last frame this credit was shown
+  _credits[credit.id].lastFrameNumber = _currentFrameNumber;
+}
 } // namespace CesiumUtility
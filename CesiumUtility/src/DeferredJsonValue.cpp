@@ -0,0 +1,122 @@
+#include "CesiumUtility/DeferredJsonValue.h"
+
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace CesiumUtility {
+namespace {
+// Builds a JsonValue from the events of a rapidjson::Reader, representing
+// numbers the same way as CesiumJsonReader::JsonObjectJsonHandler.
+struct JsonValueBuilder {
+  JsonValue root;
+  std::vector<JsonValue*> containers;
+  std::string key;
+
+  JsonValue& next() {
+    if (this->containers.empty()) {
+      return this->root;
+    }
+
+    JsonValue& container = *this->containers.back();
+    JsonValue::Array* pArray = std::get_if<JsonValue::Array>(&container.value);
+    if (pArray) {
+      return pArray->emplace_back();
+    }
+    return std::get<JsonValue::Object>(container.value)[this->key];
+  }
+
+  bool Null() {
+    this->next() = JsonValue(nullptr);
+    return true;
+  }
+  bool Bool(bool b) {
+    this->next() = JsonValue(b);
+    return true;
+  }
+  bool Int(int i) {
+    this->next() = JsonValue(std::int64_t(i));
+    return true;
+  }
+  bool Uint(unsigned i) {
+    this->next() = JsonValue(std::uint64_t(i));
+    return true;
+  }
+  bool Int64(int64_t i) {
+    this->next() = JsonValue(i);
+    return true;
+  }
+  bool Uint64(uint64_t i) {
+    this->next() = JsonValue(i);
+    return true;
+  }
+  bool Double(double d) {
+    this->next() = JsonValue(d);
+    return true;
+  }
+  bool RawNumber(
+      const char* /* str */,
+      rapidjson::SizeType /* length */,
+      bool /* copy */) noexcept {
+    return false;
+  }
+  bool String(const char* str, rapidjson::SizeType length, bool /* copy */) {
+    this->next() = JsonValue(std::string(str, length));
+    return true;
+  }
+  bool StartObject() {
+    JsonValue& value = this->next();
+    value = JsonValue(JsonValue::Object());
+    this->containers.emplace_back(&value);
+    return true;
+  }
+  bool Key(const char* str, rapidjson::SizeType length, bool /* copy */) {
+    this->key.assign(str, length);
+    return true;
+  }
+  bool EndObject(rapidjson::SizeType /* memberCount */) {
+    this->containers.pop_back();
+    return true;
+  }
+  bool StartArray() {
+    JsonValue& value = this->next();
+    value = JsonValue(JsonValue::Array());
+    this->containers.emplace_back(&value);
+    return true;
+  }
+  bool EndArray(rapidjson::SizeType /* elementCount */) {
+    this->containers.pop_back();
+    return true;
+  }
+};
+} // namespace
+
+DeferredJsonValue::DeferredJsonValue(std::string&& json) noexcept
+    : _json(std::move(json)), _value() {}
+
+const JsonValue& DeferredJsonValue::getValue() const {
+  if (!this->_value) {
+    JsonValueBuilder builder;
+    rapidjson::Reader reader;
+    rapidjson::MemoryStream inputStream(this->_json.data(), this->_json.size());
+    if (reader.Parse<
+            rapidjson::kParseDefaultFlags | rapidjson::kParseFullPrecisionFlag>(
+            inputStream,
+            builder)) {
+      this->_value = std::move(builder.root);
+    } else {
+      this->_value = JsonValue(nullptr);
+    }
+  }
+
+  return *this->_value;
+}
+
+JsonValue& DeferredJsonValue::getValue() {
+  return const_cast<JsonValue&>(std::as_const(*this).getValue());
+}
+
+} // namespace CesiumUtility
@@ -1,5 +1,7 @@
 #include "CesiumUtility/ExtensibleObject.h"
 
+#include "CesiumUtility/DeferredJsonValue.h"
+
 namespace CesiumUtility {
 JsonValue* ExtensibleObject::getGenericExtension(
     const std::string& extensionName) noexcept {
@@ -15,6 +17,12 @@ const JsonValue* ExtensibleObject::getGenericExtension(
   }
 
   const JsonValue* pValue = std::any_cast<JsonValue>(&it->second);
-  return pValue;
+  if (pValue) {
+    return pValue;
+  }
+
+  const DeferredJsonValue* pDeferred =
+      std::any_cast<DeferredJsonValue>(&it->second);
+  return pDeferred ? &pDeferred->getValue() : nullptr;
 }
 } // namespace CesiumUtility
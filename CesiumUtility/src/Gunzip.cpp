@@ -2,6 +2,10 @@
 #define ZLIB_CONST
 #include "zlib.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
 #define CHUNK 65536
 
 bool CesiumUtility::isGzip(const gsl::span<const std::byte>& data) {
@@ -11,41 +15,221 @@ bool CesiumUtility::isGzip(const gsl::span<const std::byte>& data) {
   return data[0] == std::byte{31} && data[1] == std::byte{139};
 }
 
+namespace {
+// The largest ratio of the gunzipped size to the gzipped size that deflate
+// can achieve.
+const size_t MAXIMUM_INFLATE_RATIO = 1032;
+
+// Gzip data has a gzip header and trailer, while raw deflate data has none.
+bool initializeInflate(z_stream& strm, int windowBits = 16 + MAX_WBITS) {
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+  strm.avail_in = 0;
+  strm.next_in = Z_NULL;
+  return inflateInit2(&strm, windowBits) == Z_OK;
+}
+
+bool inflateIntoVector(
+    z_stream& strm,
+    const gsl::span<const std::byte>& data,
+    size_t sizeHint,
+    std::vector<std::byte>& out) {
+  int ret;
+  size_t index = 0;
+
+  strm.avail_in = static_cast<uInt>(data.size());
+  strm.next_in = reinterpret_cast<const Bytef*>(data.data());
+
+  // Start with the size hint, unless it cannot be right.
+  out.resize(std::max(
+      std::min(sizeHint, data.size() * MAXIMUM_INFLATE_RATIO),
+      size_t(CHUNK)));
+
+  do {
+    if (index == out.size()) {
+      out.resize(index + std::max(index / 2, size_t(CHUNK)));
+    }
+
+    const uInt available = static_cast<uInt>(
+        std::min(out.size() - index, size_t(std::numeric_limits<uInt>::max())));
+    strm.next_out = reinterpret_cast<Bytef*>(&out[index]);
+    strm.avail_out = available;
+    ret = inflate(&strm, Z_NO_FLUSH);
+    switch (ret) {
+    case Z_NEED_DICT:
+    case Z_DATA_ERROR:
+    case Z_MEM_ERROR:
+      inflateEnd(&strm);
+      return false;
+    }
+
+    // The data ended before the end of the deflated stream.
+    if (ret == Z_BUF_ERROR && strm.avail_in == 0) {
+      inflateEnd(&strm);
+      return false;
+    }
+
+    index += available - strm.avail_out;
+  } while (ret != Z_STREAM_END);
+
+  inflateEnd(&strm);
+  out.resize(index);
+  return true;
+}
+} // namespace
+
+std::optional<size_t> CesiumUtility::getGunzippedSize(
+    const gsl::span<const std::byte>& data) {
+  // The size is the last four bytes of the data, in little-endian order.
+  if (!isGzip(data) || data.size() < 18) {
+    return std::nullopt;
+  }
+
+  const std::byte* pSize = data.data() + data.size() - 4;
+  const uint32_t size = std::to_integer<uint32_t>(pSize[0]) |
+                        (std::to_integer<uint32_t>(pSize[1]) << 8) |
+                        (std::to_integer<uint32_t>(pSize[2]) << 16) |
+                        (std::to_integer<uint32_t>(pSize[3]) << 24);
+  return size_t(size);
+}
+
+bool CesiumUtility::gunzip(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out) {
+  z_stream strm;
+  if (!initializeInflate(strm)) {
+    return false;
+  }
+
+  return inflateIntoVector(
+      strm,
+      data,
+      getGunzippedSize(data).value_or(0),
+      out);
+}
+
+bool CesiumUtility::inflateRaw(
+    const gsl::span<const std::byte>& data,
+    size_t sizeHint,
+    std::vector<std::byte>& out) {
+  z_stream strm;
+  if (!initializeInflate(strm, -MAX_WBITS)) {
+    return false;
+  }
+
+  return inflateIntoVector(strm, data, sizeHint, out);
+}
+
 bool CesiumUtility::gunzip(
+    const gsl::span<const std::byte>& data,
+    const gsl::span<std::byte>& out,
+    size_t& outSize) {
+  z_stream strm;
+  if (!initializeInflate(strm)) {
+    return false;
+  }
+
+  strm.avail_in = static_cast<uInt>(data.size());
+  strm.next_in = reinterpret_cast<const Bytef*>(data.data());
+  strm.avail_out = static_cast<uInt>(out.size());
+  strm.next_out = reinterpret_cast<Bytef*>(out.data());
+  const int ret = inflate(&strm, Z_FINISH);
+  outSize = out.size() - strm.avail_out;
+  inflateEnd(&strm);
+  return ret == Z_STREAM_END;
+}
+
+bool CesiumUtility::gzip(
     const gsl::span<const std::byte>& data,
     std::vector<std::byte>& out) {
   int ret;
-  unsigned int index = 0;
   z_stream strm;
   strm.zalloc = Z_NULL;
   strm.zfree = Z_NULL;
   strm.opaque = Z_NULL;
-  strm.avail_in = 0;
-  strm.next_in = Z_NULL;
-  ret = inflateInit2(&strm, 16 + MAX_WBITS);
+  ret = deflateInit2(
+      &strm,
+      Z_DEFAULT_COMPRESSION,
+      Z_DEFLATED,
+      16 + MAX_WBITS,
+      8,
+      Z_DEFAULT_STRATEGY);
   if (ret != Z_OK) {
     return false;
   }
 
+  // Compress all of the data at once, into a buffer that is large enough for
+  // the result.
+  out.resize(deflateBound(&strm, static_cast<uLong>(data.size())));
+  strm.avail_in = static_cast<uInt>(data.size());
+  strm.next_in = reinterpret_cast<const Bytef*>(data.data());
+  strm.avail_out = static_cast<uInt>(out.size());
+  strm.next_out = reinterpret_cast<Bytef*>(out.data());
+  ret = deflate(&strm, Z_FINISH);
+  deflateEnd(&strm);
+  if (ret != Z_STREAM_END) {
+    return false;
+  }
+
+  out.resize(strm.total_out);
+  return true;
+}
+
+CesiumUtility::GunzipStream::GunzipStream()
+    : _pStream(std::make_unique<z_stream>()),
+      _failed(false),
+      _finished(false) {
+  if (!initializeInflate(*this->_pStream)) {
+    this->_pStream.reset();
+    this->_failed = true;
+  }
+}
+
+CesiumUtility::GunzipStream::~GunzipStream() noexcept {
+  if (this->_pStream) {
+    inflateEnd(this->_pStream.get());
+  }
+}
+
+bool CesiumUtility::GunzipStream::write(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out) {
+  if (this->_failed) {
+    return false;
+  }
+  if (this->_finished) {
+    return true;
+  }
+
+  z_stream& strm = *this->_pStream;
   strm.avail_in = static_cast<uInt>(data.size());
   strm.next_in = reinterpret_cast<const Bytef*>(data.data());
 
+  // Inflate until all of the piece is used, and no more output is pending.
+  size_t index = out.size();
   do {
     out.resize(index + CHUNK);
     strm.next_out = reinterpret_cast<Bytef*>(&out[index]);
     strm.avail_out = CHUNK;
-    ret = inflate(&strm, Z_NO_FLUSH);
+    const int ret = inflate(&strm, Z_NO_FLUSH);
     switch (ret) {
     case Z_NEED_DICT:
     case Z_DATA_ERROR:
     case Z_MEM_ERROR:
-      inflateEnd(&strm);
+    case Z_STREAM_ERROR:
+      out.resize(index);
+      this->_failed = true;
       return false;
     }
+
     index += CHUNK - strm.avail_out;
-  } while (ret != Z_STREAM_END);
+    if (ret == Z_STREAM_END) {
+      this->_finished = true;
+      break;
+    }
+  } while (strm.avail_in > 0 || strm.avail_out == 0);
 
-  inflateEnd(&strm);
   out.resize(index);
   return true;
 }
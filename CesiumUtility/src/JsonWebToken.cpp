@@ -0,0 +1,65 @@
+#include "CesiumUtility/JsonWebToken.h"
+
+#include <modp_b64.h>
+#include <rapidjson/document.h>
+
+#include <algorithm>
+
+namespace CesiumUtility {
+
+/*static*/ std::optional<std::string>
+JsonWebToken::getPayload(const std::string& token) {
+  const size_t startPos = token.find('.');
+  if (startPos == std::string::npos) {
+    return std::nullopt;
+  }
+
+  const size_t endPos = token.find('.', startPos + 1);
+  if (endPos == std::string::npos || endPos == startPos + 1) {
+    return std::nullopt;
+  }
+
+  // The payload is base64url encoded, without padding.
+  std::string encoded = token.substr(startPos + 1, endPos - startPos - 1);
+  std::replace(encoded.begin(), encoded.end(), '-', '+');
+  std::replace(encoded.begin(), encoded.end(), '_', '/');
+  const size_t remainder = encoded.size() % 4;
+  if (remainder != 0) {
+    encoded.resize(encoded.size() + 4 - remainder, '=');
+  }
+
+  std::string decoded(modp_b64_decode_len(encoded.size()), '\0');
+  const size_t decodedLength =
+      modp_b64_decode(decoded.data(), encoded.data(), encoded.size());
+  if (decodedLength == 0 || decodedLength == std::string::npos) {
+    return std::nullopt;
+  }
+
+  decoded.resize(decodedLength);
+  return decoded;
+}
+
+/*static*/ std::optional<std::chrono::system_clock::time_point>
+JsonWebToken::getExpiry(const std::string& token) {
+  const std::optional<std::string> maybePayload = getPayload(token);
+  if (!maybePayload) {
+    return std::nullopt;
+  }
+
+  rapidjson::Document payload;
+  payload.Parse(maybePayload->data(), maybePayload->size());
+  if (payload.HasParseError() || !payload.IsObject()) {
+    return std::nullopt;
+  }
+
+  const auto expIt = payload.FindMember("exp");
+  if (expIt == payload.MemberEnd() || !expIt->value.IsNumber()) {
+    return std::nullopt;
+  }
+
+  return std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::duration<double>(expIt->value.GetDouble())));
+}
+
+} // namespace CesiumUtility
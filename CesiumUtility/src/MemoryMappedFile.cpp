@@ -0,0 +1,113 @@
+#include "CesiumUtility/MemoryMappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CesiumUtility {
+
+/*static*/ std::shared_ptr<const MemoryMappedFile>
+MemoryMappedFile::open(const std::string& path) {
+#ifdef _WIN32
+  HANDLE file = CreateFileA(
+      path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+    CloseHandle(file);
+    return nullptr;
+  }
+
+  // The view keeps the mapping open after the handles are closed.
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping) {
+    return nullptr;
+  }
+
+  void* pView = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!pView) {
+    return nullptr;
+  }
+
+  return std::shared_ptr<const MemoryMappedFile>(new MemoryMappedFile(
+      static_cast<const std::byte*>(pView),
+      static_cast<size_t>(fileSize.QuadPart)));
+#else
+  const int file = ::open(path.c_str(), O_RDONLY);
+  if (file < 0) {
+    return nullptr;
+  }
+
+  struct stat fileStat;
+  if (fstat(file, &fileStat) != 0 || fileStat.st_size <= 0) {
+    close(file);
+    return nullptr;
+  }
+
+  // The mapping stays open after the file is closed.
+  const size_t fileSize = static_cast<size_t>(fileStat.st_size);
+  void* pMapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);
+  if (pMapping == MAP_FAILED) {
+    return nullptr;
+  }
+
+  return std::shared_ptr<const MemoryMappedFile>(
+      new MemoryMappedFile(static_cast<const std::byte*>(pMapping), fileSize));
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile() noexcept {
+#ifdef _WIN32
+  UnmapViewOfFile(this->_pData);
+#else
+  munmap(const_cast<std::byte*>(this->_pData), this->_size);
+#endif
+}
+
+void MemoryMappedFile::prefetch() const noexcept {
+#ifdef _WIN32
+#if _WIN32_WINNT >= _WIN32_WINNT_WIN8
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = const_cast<std::byte*>(this->_pData);
+  range.NumberOfBytes = this->_size;
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#endif
+#else
+  madvise(const_cast<std::byte*>(this->_pData), this->_size, MADV_WILLNEED);
+#endif
+}
+
+SharedBytes MemoryMappedFile::getRegion(size_t offset, size_t size) const {
+  if (offset > this->_size || size > this->_size - offset) {
+    return SharedBytes();
+  }
+  return SharedBytes(
+      this->shared_from_this(),
+      gsl::span<const std::byte>(this->_pData + offset, size));
+}
+
+} // namespace CesiumUtility
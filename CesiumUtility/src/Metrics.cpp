@@ -0,0 +1,265 @@
+#include "CesiumUtility/Metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace CesiumUtility {
+
+/*static*/ const std::vector<double> MetricHistogram::defaultSecondsBuckets =
+    {0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 10.0};
+
+MetricHistogram::MetricHistogram(std::vector<double>&& bucketUpperBounds)
+    : _bucketUpperBounds(std::move(bucketUpperBounds)),
+      _bucketCounts(std::make_unique<std::atomic<int64_t>[]>(
+          this->_bucketUpperBounds.size() + 1)),
+      _count(0),
+      _sum(0.0) {}
+
+void MetricHistogram::observe(double value) noexcept {
+  const auto it = std::lower_bound(
+      this->_bucketUpperBounds.begin(),
+      this->_bucketUpperBounds.end(),
+      value);
+  this->_bucketCounts[size_t(it - this->_bucketUpperBounds.begin())]
+      .fetch_add(1, std::memory_order_relaxed);
+  this->_count.fetch_add(1, std::memory_order_relaxed);
+
+  double sum = this->_sum.load(std::memory_order_relaxed);
+  while (!this->_sum.compare_exchange_weak(
+      sum,
+      sum + value,
+      std::memory_order_relaxed)) {
+  }
+}
+
+std::vector<int64_t> MetricHistogram::getBucketCounts() const {
+  std::vector<int64_t> counts(this->_bucketUpperBounds.size() + 1);
+  for (size_t i = 0; i < counts.size(); ++i) {
+    counts[i] = this->_bucketCounts[i].load(std::memory_order_relaxed);
+  }
+  return counts;
+}
+
+/*static*/ MetricsRegistry& MetricsRegistry::getDefault() {
+  static MetricsRegistry registry;
+  return registry;
+}
+
+MetricsRegistry::MetricsRegistry() : _mutex(), _metrics() {}
+
+MetricsRegistry::~MetricsRegistry() noexcept = default;
+
+MetricCounter& MetricsRegistry::counter(
+    const std::string& name,
+    const std::string& help,
+    const MetricLabels& labels) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  Metric& metric =
+      this->getOrAddMetric(name, help, labels, MetricType::Counter);
+  if (!metric.pCounter) {
+    metric.pCounter = std::make_unique<MetricCounter>();
+  }
+  return *metric.pCounter;
+}
+
+MetricGauge& MetricsRegistry::gauge(
+    const std::string& name,
+    const std::string& help,
+    const MetricLabels& labels) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  Metric& metric = this->getOrAddMetric(name, help, labels, MetricType::Gauge);
+  if (!metric.pGauge) {
+    metric.pGauge = std::make_unique<MetricGauge>();
+  }
+  return *metric.pGauge;
+}
+
+MetricHistogram& MetricsRegistry::histogram(
+    const std::string& name,
+    const std::string& help,
+    const std::vector<double>& bucketUpperBounds,
+    const MetricLabels& labels) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  Metric& metric =
+      this->getOrAddMetric(name, help, labels, MetricType::Histogram);
+  if (!metric.pHistogram) {
+    metric.pHistogram = std::make_unique<MetricHistogram>(
+        std::vector<double>(bucketUpperBounds));
+  }
+  return *metric.pHistogram;
+}
+
+std::vector<MetricSnapshot> MetricsRegistry::getSnapshot() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  std::vector<MetricSnapshot> snapshot;
+  snapshot.reserve(this->_metrics.size());
+  for (const auto& [key, metric] : this->_metrics) {
+    MetricSnapshot& value = snapshot.emplace_back();
+    value.name = metric.name;
+    value.help = metric.help;
+    value.labels = metric.labels;
+    value.type = metric.type;
+
+    switch (metric.type) {
+    case MetricType::Counter:
+      value.value = metric.pCounter->getValue();
+      break;
+    case MetricType::Gauge:
+      value.value = metric.pGauge->getValue();
+      break;
+    case MetricType::Histogram:
+      value.bucketUpperBounds = metric.pHistogram->getBucketUpperBounds();
+      value.bucketCounts = metric.pHistogram->getBucketCounts();
+      value.count = metric.pHistogram->getCount();
+      value.sum = metric.pHistogram->getSum();
+      break;
+    }
+  }
+
+  return snapshot;
+}
+
+namespace {
+
+const char* getTypeName(MetricType type) {
+  switch (type) {
+  case MetricType::Counter:
+    return "counter";
+  case MetricType::Gauge:
+    return "gauge";
+  case MetricType::Histogram:
+    return "histogram";
+  }
+  return "untyped";
+}
+
+std::string escape(const std::string& s, bool escapeQuotes) {
+  std::string result;
+  result.reserve(s.size());
+  for (char c : s) {
+    if (c == '\\') {
+      result += "\\\\";
+    } else if (c == '\n') {
+      result += "\\n";
+    } else if (c == '"' && escapeQuotes) {
+      result += "\\\"";
+    } else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+std::string formatNumber(double value) {
+  if (std::isinf(value)) {
+    return value > 0.0 ? "+Inf" : "-Inf";
+  }
+  std::ostringstream stream;
+  stream.precision(17);
+  stream << value;
+  return stream.str();
+}
+
+void writeLabels(
+    std::ostringstream& output,
+    const MetricLabels& labels,
+    const char* pExtraName = nullptr,
+    const std::string& extraValue = std::string()) {
+  if (labels.empty() && !pExtraName) {
+    return;
+  }
+
+  output << '{';
+  bool first = true;
+  for (const auto& [labelName, labelValue] : labels) {
+    if (!first) {
+      output << ',';
+    }
+    first = false;
+    output << labelName << "=\"" << escape(labelValue, true) << '"';
+  }
+  if (pExtraName) {
+    if (!first) {
+      output << ',';
+    }
+    output << pExtraName << "=\"" << extraValue << '"';
+  }
+  output << '}';
+}
+
+} // namespace
+
+std::string MetricsRegistry::toPrometheusText() const {
+  const std::vector<MetricSnapshot> snapshot = this->getSnapshot();
+
+  std::ostringstream output;
+  const std::string* pLastName = nullptr;
+  for (const MetricSnapshot& metric : snapshot) {
+    // The metrics are sorted by name, so each family is written together,
+    // with a single description.
+    if (!pLastName || *pLastName != metric.name) {
+      output << "# HELP " << metric.name << ' ' << escape(metric.help, false)
+             << '\n';
+      output << "# TYPE " << metric.name << ' ' << getTypeName(metric.type)
+             << '\n';
+      pLastName = &metric.name;
+    }
+
+    if (metric.type != MetricType::Histogram) {
+      output << metric.name;
+      writeLabels(output, metric.labels);
+      output << ' ' << metric.value << '\n';
+      continue;
+    }
+
+    // Prometheus buckets are cumulative.
+    int64_t cumulativeCount = 0;
+    for (size_t i = 0; i < metric.bucketCounts.size(); ++i) {
+      cumulativeCount += metric.bucketCounts[i];
+      const double upperBound = i < metric.bucketUpperBounds.size()
+                                    ? metric.bucketUpperBounds[i]
+                                    : std::numeric_limits<double>::infinity();
+      output << metric.name << "_bucket";
+      writeLabels(output, metric.labels, "le", formatNumber(upperBound));
+      output << ' ' << cumulativeCount << '\n';
+    }
+    output << metric.name << "_sum";
+    writeLabels(output, metric.labels);
+    output << ' ' << formatNumber(metric.sum) << '\n';
+    output << metric.name << "_count";
+    writeLabels(output, metric.labels);
+    output << ' ' << metric.count << '\n';
+  }
+
+  return output.str();
+}
+
+MetricsRegistry::Metric& MetricsRegistry::getOrAddMetric(
+    const std::string& name,
+    const std::string& help,
+    const MetricLabels& labels,
+    MetricType type) {
+  MetricLabels sortedLabels = labels;
+  std::sort(sortedLabels.begin(), sortedLabels.end());
+
+  auto it = this->_metrics.find(std::make_pair(name, sortedLabels));
+  if (it == this->_metrics.end()) {
+    Metric metric{name, help, sortedLabels, type, nullptr, nullptr, nullptr};
+    it = this->_metrics
+             .emplace(
+                 std::make_pair(name, std::move(sortedLabels)),
+                 std::move(metric))
+             .first;
+  } else if (it->second.type != type) {
+    throw std::invalid_argument(
+        "The metric " + name + " is already registered with another type.");
+  }
+
+  return it->second;
+}
+
+} // namespace CesiumUtility
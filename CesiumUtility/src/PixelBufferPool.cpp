@@ -0,0 +1,129 @@
+#include "CesiumUtility/PixelBufferPool.h"
+
+#include <utility>
+
+namespace CesiumUtility {
+
+namespace {
+
+// The index of the smallest size class that holds a buffer of a size, or the
+// number of size classes if the buffer is not pooled.
+size_t getSizeClass(size_t size) noexcept {
+  size_t sizeClass = 0;
+  size_t capacity = PixelBufferPool::minimumPooledSize;
+  while (capacity < size && capacity < PixelBufferPool::maximumPooledSize) {
+    capacity <<= 1;
+    ++sizeClass;
+  }
+  return capacity < size ? sizeClass + 1 : sizeClass;
+}
+
+} // namespace
+
+/*static*/ PixelBufferPool& PixelBufferPool::getDefault() {
+  static PixelBufferPool pool;
+  return pool;
+}
+
+PixelBufferPool::PixelBufferPool(int64_t maximumPooledBytes)
+    : _mutex(),
+      _buffers(),
+      _pooledBytes(0),
+      _maximumPooledBytes(maximumPooledBytes) {}
+
+std::vector<std::byte> PixelBufferPool::acquire(size_t size) {
+  std::vector<std::byte> result;
+  if (size < minimumPooledSize / 2) {
+    // Small buffers would waste too much of the smallest size class.
+    result.resize(size);
+    return result;
+  }
+
+  const size_t sizeClass = getSizeClass(size);
+  if (sizeClass >= sizeClassCount) {
+    result.resize(size);
+    return result;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    std::vector<std::vector<std::byte>>& buffers = this->_buffers[sizeClass];
+    if (!buffers.empty()) {
+      result = std::move(buffers.back());
+      buffers.pop_back();
+      this->_pooledBytes -= int64_t(result.capacity());
+    }
+  }
+
+  if (result.capacity() == 0) {
+    result.reserve(minimumPooledSize << sizeClass);
+  }
+  result.resize(size);
+  return result;
+}
+
+void PixelBufferPool::release(std::vector<std::byte>& buffer) noexcept {
+  std::vector<std::byte> released = std::exchange(buffer, {});
+  const size_t capacity = released.capacity();
+  const size_t sizeClass = getSizeClass(capacity);
+  if (sizeClass >= sizeClassCount ||
+      capacity != minimumPooledSize << sizeClass) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (this->_pooledBytes + int64_t(capacity) > this->_maximumPooledBytes) {
+    return;
+  }
+
+  try {
+    released.clear();
+    this->_buffers[sizeClass].emplace_back(std::move(released));
+    this->_pooledBytes += int64_t(capacity);
+  } catch (...) {
+    // The buffer is freed if the pool can't hold on to it.
+  }
+}
+
+int64_t PixelBufferPool::clear() noexcept {
+  std::array<std::vector<std::vector<std::byte>>, sizeClassCount> buffers;
+  int64_t freedBytes;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    buffers.swap(this->_buffers);
+    freedBytes = std::exchange(this->_pooledBytes, 0);
+  }
+  return freedBytes;
+}
+
+int64_t PixelBufferPool::getPooledBytes() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_pooledBytes;
+}
+
+int64_t PixelBufferPool::getMaximumPooledBytes() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_maximumPooledBytes;
+}
+
+void PixelBufferPool::setMaximumPooledBytes(
+    int64_t maximumPooledBytes) noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_maximumPooledBytes = maximumPooledBytes;
+  this->trimToMaximum();
+}
+
+void PixelBufferPool::trimToMaximum() noexcept {
+  // The largest buffers are freed first, as they are the least likely to be
+  // reused.
+  size_t sizeClass = sizeClassCount;
+  while (sizeClass > 0 && this->_pooledBytes > this->_maximumPooledBytes) {
+    std::vector<std::vector<std::byte>>& buffers = this->_buffers[--sizeClass];
+    while (!buffers.empty() && this->_pooledBytes > this->_maximumPooledBytes) {
+      this->_pooledBytes -= int64_t(buffers.back().capacity());
+      buffers.pop_back();
+    }
+  }
+}
+
+} // namespace CesiumUtility
@@ -5,12 +5,63 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 
 #if CESIUM_TRACING_ENABLED
 
 namespace CesiumUtility {
 namespace CesiumImpl {
 
+namespace {
+
+const std::chrono::milliseconds DRAIN_INTERVAL(10);
+
+int64_t getMicroseconds(std::chrono::steady_clock::time_point time) {
+  return std::chrono::time_point_cast<std::chrono::microseconds>(time)
+      .time_since_epoch()
+      .count();
+}
+
+} // namespace
+
+// A fixed-size ring buffer of the records of one thread. The thread that owns
+// it is the only one that pushes records, and the drain thread is the only one
+// that pops them, so neither needs a lock.
+class TraceBuffer {
+public:
+  static constexpr size_t capacity = 4096;
+
+  TraceBuffer() : _records(capacity), _head(0), _tail(0) {}
+
+  // Returns the number of records in the buffer after pushing this one, or
+  // zero if the buffer is full and the record was dropped.
+  size_t push(const TraceRecord& record) noexcept {
+    const size_t head = this->_head.load(std::memory_order_relaxed);
+    const size_t tail = this->_tail.load(std::memory_order_acquire);
+    if (head - tail == capacity) {
+      return 0;
+    }
+
+    this->_records[head % capacity] = record;
+    this->_head.store(head + 1, std::memory_order_release);
+    return head + 1 - tail;
+  }
+
+  template <typename Func> void drain(Func&& f) {
+    const size_t tail = this->_tail.load(std::memory_order_relaxed);
+    const size_t head = this->_head.load(std::memory_order_acquire);
+    for (size_t i = tail; i != head; ++i) {
+      f(this->_records[i % capacity]);
+    }
+    this->_tail.store(head, std::memory_order_release);
+  }
+
+private:
+  std::vector<TraceRecord> _records;
+  std::atomic<size_t> _head;
+  std::atomic<size_t> _tail;
+};
+
 Tracer& Tracer::instance() {
   static Tracer instance;
   return instance;
@@ -18,48 +69,112 @@ Tracer& Tracer::instance() {
 
 Tracer::~Tracer() { endTracing(); }
 
-void Tracer::startTracing(const std::string& filePath) {
+void Tracer::startTracing(
+    const std::string& filePath,
+    const TracingOptions& options) {
+  if (this->_drainThread.joinable()) {
+    return;
+  }
+
+  this->_sessionOptions.emplace_back(std::make_unique<TracingOptions>(options));
+  this->_pOptions = this->_sessionOptions.back().get();
+  this->_frameNumber = 0;
+
+  // Discard the records left over from an earlier session.
+  this->drainBuffers();
+
   this->_output.open(filePath);
-  this->_output << "{\"otherData\": {},\"traceEvents\":[";
+  this->_output << "{\"traceEvents\":[";
+  this->_numTraces = 0;
+  this->_droppedRecords = 0;
+  this->_stopDraining = false;
+  this->_enabled = true;
+  this->_recording = true;
+
+  this->_drainThread = std::thread([this]() {
+    std::unique_lock<std::mutex> lock(this->_drainLock);
+    while (!this->_stopDraining) {
+      this->_drainCondition.wait_for(lock, DRAIN_INTERVAL);
+      this->drainBuffers();
+    }
+  });
 }
 
 void Tracer::endTracing() {
-  this->_output << "]}";
+  if (!this->_drainThread.joinable()) {
+    return;
+  }
+
+  this->_enabled = false;
+  this->_recording = false;
+  {
+    std::lock_guard<std::mutex> lock(this->_drainLock);
+    this->_stopDraining = true;
+  }
+  this->_drainCondition.notify_one();
+  this->_drainThread.join();
+
+  this->drainBuffers();
+  this->_output << "],\"otherData\":{\"droppedEvents\":\""
+                << this->_droppedRecords << "\"}}";
   this->_output.close();
 }
 
-void Tracer::writeCompleteEvent(const Trace& trace) {
-  std::lock_guard<std::mutex> lock(_lock);
-  if (!this->_output) {
+void Tracer::beginFrame() {
+  if (!this->_enabled) {
     return;
   }
 
-  // Chrome tracing wants the text like this
-  if (this->_numTraces++ > 0) {
-    this->_output << ",";
-  }
+  const uint32_t interval =
+      std::max(this->_pOptions.load()->frameSamplingInterval, uint32_t(1));
+  this->_recording = ++this->_frameNumber % interval == 0;
+}
 
-  this->_output << "{";
-  this->_output << "\"cat\":\"cesium\",";
-  this->_output << "\"dur\":" << trace.duration << ',';
-  this->_output << "\"name\":\"" << trace.name << "\",";
-  this->_output << "\"ph\":\"X\",";
-  this->_output << "\"pid\":0,";
-  this->_output << "\"tid\":" << trace.threadID << ",";
-  this->_output << "\"ts\":" << trace.start;
-  this->_output << "}";
+bool Tracer::isRecording(const char* category) const noexcept {
+  return this->_recording.load(std::memory_order_acquire) &&
+         this->isCategoryEnabled(category);
 }
 
-void Tracer::writeAsyncEventBegin(const char* name, int64_t id) {
-  this->writeAsyncEvent("cesium", name, 'b', id);
+void Tracer::writeCompleteEvent(const Trace& trace, const char* category) {
+  if (!this->_enabled.load(std::memory_order_acquire) ||
+      !this->isCategoryEnabled(category)) {
+    return;
+  }
+
+  TraceRecord record;
+  record.category = category;
+  record.start = trace.start;
+  record.duration = trace.duration;
+  record.id = -1;
+  record.threadID = trace.threadID;
+  record.type = 'X';
+  const size_t length =
+      std::min(trace.name.size(), TraceRecord::maximumNameLength);
+  std::memcpy(record.name, trace.name.data(), length);
+  record.name[length] = '\0';
+  this->writeRecord(record);
+}
+
+void Tracer::writeAsyncEventBegin(
+    const char* name,
+    int64_t id,
+    const char* category) {
+  if (this->isRecording(category)) {
+    this->writeAsyncEvent(category, name, 'b', id);
+  }
 }
 
 void Tracer::writeAsyncEventBegin(const char* name) {
   this->writeAsyncEventBegin(name, this->getCurrentThreadTrackID());
 }
 
-void Tracer::writeAsyncEventEnd(const char* name, int64_t id) {
-  this->writeAsyncEvent("cesium", name, 'e', id);
+void Tracer::writeAsyncEventEnd(
+    const char* name,
+    int64_t id,
+    const char* category) {
+  if (this->isRecording(category)) {
+    this->writeAsyncEvent(category, name, 'e', id);
+  }
 }
 
 void Tracer::writeAsyncEventEnd(const char* name) {
@@ -68,7 +183,37 @@ void Tracer::writeAsyncEventEnd(const char* name) {
 
 int64_t Tracer::allocateTrackID() { return ++this->_lastAllocatedID; }
 
-Tracer::Tracer() : _output{}, _numTraces{0}, _lock{}, _lastAllocatedID(0) {}
+Tracer::Tracer()
+    : _output{},
+      _numTraces{0},
+      _sessionOptions{},
+      _pOptions{nullptr},
+      _frameNumber{0},
+      _enabled{false},
+      _recording{false},
+      _droppedRecords{0},
+      _buffersLock{},
+      _buffers{},
+      _drainLock{},
+      _drainCondition{},
+      _stopDraining{false},
+      _drainThread{},
+      _lastAllocatedID(0) {}
+
+bool Tracer::isCategoryEnabled(const char* category) const noexcept {
+  const TracingOptions* pOptions =
+      this->_pOptions.load(std::memory_order_acquire);
+  if (!pOptions || pOptions->categories.empty()) {
+    return true;
+  }
+
+  return std::any_of(
+      pOptions->categories.begin(),
+      pOptions->categories.end(),
+      [category](const std::string& enabledCategory) {
+        return enabledCategory == category;
+      });
+}
 
 int64_t Tracer::getCurrentThreadTrackID() const {
   const TrackReference* pTrack = TrackReference::current();
@@ -80,11 +225,13 @@ void Tracer::writeAsyncEvent(
     const char* name,
     char type,
     int64_t id) {
+  if (!this->_enabled.load(std::memory_order_acquire) ||
+      !this->isCategoryEnabled(category)) {
+    return;
+  }
 
-  bool isAsync = true;
   if (id < 0) {
     // Use a standard Duration event for slices without an async ID.
-    isAsync = false;
     if (type == 'b') {
       type = 'B';
     } else if (type == 'e') {
@@ -92,14 +239,64 @@ void Tracer::writeAsyncEvent(
     }
   }
 
-  std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
-  int64_t microseconds =
-      std::chrono::time_point_cast<std::chrono::microseconds>(time)
-          .time_since_epoch()
-          .count();
+  TraceRecord record;
+  record.category = category;
+  record.start = getMicroseconds(std::chrono::steady_clock::now());
+  record.duration = 0;
+  record.id = id;
+  record.threadID = std::this_thread::get_id();
+  record.type = type;
+  size_t length = 0;
+  while (length < TraceRecord::maximumNameLength && name[length] != '\0') {
+    record.name[length] = name[length];
+    ++length;
+  }
+  record.name[length] = '\0';
+  this->writeRecord(record);
+}
+
+void Tracer::writeRecord(const TraceRecord& record) {
+  const size_t size = this->getCurrentThreadBuffer().push(record);
+  if (size == 0) {
+    this->_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+  } else if (size == TraceBuffer::capacity / 2) {
+    // Drain the buffer early, rather than wait for the interval, before it
+    // fills up.
+    this->_drainCondition.notify_one();
+  }
+}
+
+TraceBuffer& Tracer::getCurrentThreadBuffer() {
+  // The tracer also holds each buffer, so that its records are still written
+  // after the thread exits.
+  thread_local std::shared_ptr<TraceBuffer> pBuffer = [this]() {
+    std::shared_ptr<TraceBuffer> pNewBuffer = std::make_shared<TraceBuffer>();
+    std::lock_guard<std::mutex> lock(this->_buffersLock);
+    this->_buffers.emplace_back(pNewBuffer);
+    return pNewBuffer;
+  }();
+  return *pBuffer;
+}
+
+void Tracer::drainBuffers() {
+  std::lock_guard<std::mutex> lock(this->_buffersLock);
+  for (auto it = this->_buffers.begin(); it != this->_buffers.end();) {
+    (*it)->drain([this](const TraceRecord& record) {
+      this->writeRecordToOutput(record);
+    });
+
+    // Forget the buffers of threads that have exited.
+    if (it->use_count() == 1) {
+      it = this->_buffers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  this->_output.flush();
+}
 
-  std::lock_guard<std::mutex> lock(_lock);
-  if (!this->_output) {
+void Tracer::writeRecordToOutput(const TraceRecord& record) {
+  if (!this->_output.is_open()) {
     return;
   }
 
@@ -107,51 +304,71 @@ void Tracer::writeAsyncEvent(
   if (this->_numTraces++ > 0) {
     this->_output << ",";
   }
+
   this->_output << "{";
-  this->_output << "\"cat\":\"" << category << "\",";
-  if (isAsync) {
-    this->_output << "\"id\":" << id << ",";
+  this->_output << "\"cat\":\"" << record.category << "\",";
+  if (record.type == 'X') {
+    this->_output << "\"dur\":" << record.duration << ',';
+  }
+  if (record.id >= 0) {
+    this->_output << "\"id\":" << record.id << ",";
   } else {
-    this->_output << "\"tid\":" << std::this_thread::get_id() << ",";
+    this->_output << "\"tid\":" << record.threadID << ",";
   }
-  this->_output << "\"name\":\"" << name << "\",";
-  this->_output << "\"ph\":\"" << type << "\",";
+  this->_output << "\"name\":\"" << record.name << "\",";
+  this->_output << "\"ph\":\"" << record.type << "\",";
   this->_output << "\"pid\":0,";
-  this->_output << "\"ts\":" << microseconds;
+  this->_output << "\"ts\":" << record.start;
   this->_output << "}";
 }
 
 ScopedTrace::ScopedTrace(const std::string& message)
-    : _name{message},
-      _startTime{std::chrono::steady_clock::now()},
-      _threadId{std::this_thread::get_id()},
-      _reset{false} {
-  CESIUM_TRACE_BEGIN_IN_TRACK(_name.c_str());
-}
+    : ScopedTrace(Tracer::defaultCategory, message) {}
+
+ScopedTrace::ScopedTrace(const char* category, const std::string& message)
+    : _category{category}, _name{}, _startTime{}, _threadId{}, _reset{false} {
+  // Whether the operation is recorded is decided when it starts, so that a
+  // recorded operation is not lost when it ends in a frame that isn't.
+  Tracer& tracer = Tracer::instance();
+  if (!tracer.isRecording(category)) {
+    this->_reset = true;
+    return;
+  }
+
+  this->_name = message;
+  this->_startTime = std::chrono::steady_clock::now();
+  this->_threadId = std::this_thread::get_id();
 
-ScopedTrace::~ScopedTrace() {
-  if (!this->_reset) {
-    this->reset();
+  if (TrackReference::current() != nullptr) {
+    tracer.writeAsyncEvent(
+        this->_category,
+        this->_name.c_str(),
+        'b',
+        tracer.getCurrentThreadTrackID());
   }
 }
 
+ScopedTrace::~ScopedTrace() { this->reset(); }
+
 void ScopedTrace::reset() {
+  if (this->_reset) {
+    return;
+  }
   this->_reset = true;
 
+  Tracer& tracer = Tracer::instance();
   if (TrackReference::current() != nullptr) {
-    CESIUM_TRACE_END(_name.c_str());
+    tracer.writeAsyncEvent(
+        this->_category,
+        this->_name.c_str(),
+        'e',
+        tracer.getCurrentThreadTrackID());
   } else {
-    auto endTimePoint = std::chrono::steady_clock::now();
-    int64_t start = std::chrono::time_point_cast<std::chrono::microseconds>(
-                        this->_startTime)
-                        .time_since_epoch()
-                        .count();
-    int64_t end =
-        std::chrono::time_point_cast<std::chrono::microseconds>(endTimePoint)
-            .time_since_epoch()
-            .count();
-    Tracer::instance().writeCompleteEvent(
-        {this->_name, start, end - start, this->_threadId});
+    int64_t start = getMicroseconds(this->_startTime);
+    int64_t end = getMicroseconds(std::chrono::steady_clock::now());
+    tracer.writeCompleteEvent(
+        {this->_name, start, end - start, this->_threadId},
+        this->_category);
   }
 }
 
@@ -161,8 +378,10 @@ TrackSet::~TrackSet() {
   std::scoped_lock lock(this->mutex);
   for (auto& track : this->tracks) {
     assert(!track.inUse);
-    Tracer::instance().writeAsyncEventEnd(
+    Tracer::instance().writeAsyncEvent(
+        Tracer::defaultCategory,
         (this->name + " " + std::to_string(track.id)).c_str(),
+        'e',
         track.id);
   }
 }
@@ -179,9 +398,12 @@ size_t TrackSet::acquireTrack() {
     it->inUse = true;
     return size_t(it - this->tracks.begin());
   } else {
+    // Tracks outlive frames, so their events are not sampled.
     Track track{Tracer::instance().allocateTrackID(), true};
-    Tracer::instance().writeAsyncEventBegin(
+    Tracer::instance().writeAsyncEvent(
+        Tracer::defaultCategory,
         (this->name + " " + std::to_string(track.id)).c_str(),
+        'b',
         track.id);
     size_t index = this->tracks.size();
     this->tracks.emplace_back(track);
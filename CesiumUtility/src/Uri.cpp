@@ -4,6 +4,7 @@
 
 #include <cstring>
 #include <stdexcept>
+#include <utility>
 
 namespace CesiumUtility {
 std::string Uri::resolve(
@@ -81,6 +82,100 @@ std::string Uri::resolve(
   return result;
 }
 
+namespace {
+// Whether the character can appear in a URI without being percent-encoded, and
+// is left unchanged by normalization. A ':' could start a scheme, so it is
+// left to uriparser.
+bool isPlainCharacter(char c) noexcept {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') ||
+         (c != '\0' && std::strchr("-._~!$&'()*+,;=@", c) != nullptr);
+}
+
+bool isDotSegment(const std::string& uri, size_t start, size_t end) noexcept {
+  const size_t length = end - start;
+  return (length == 1 && uri[start] == '.') ||
+         (length == 2 && uri[start] == '.' && uri[start + 1] == '.');
+}
+
+// Whether the URI is a relative path, optionally followed by a query, that
+// resolves to the same string as appending it to the base's directory. That
+// is the case when it has no scheme, fragment, or percent-encoded characters
+// for normalization to change, and no dot segments.
+bool isPlainRelativePath(const std::string& uri) noexcept {
+  if (uri.empty() || uri[0] == '/' || uri[0] == '?') {
+    return false;
+  }
+
+  size_t segmentStart = 0;
+  for (size_t i = 0; i < uri.size(); ++i) {
+    const char c = uri[i];
+    if (c == '/' || c == '?') {
+      if (isDotSegment(uri, segmentStart, i)) {
+        return false;
+      }
+      if (c == '?') {
+        // The rest is the query.
+        for (size_t j = i + 1; j < uri.size(); ++j) {
+          if (!isPlainCharacter(uri[j]) && uri[j] != '/' && uri[j] != '?') {
+            return false;
+          }
+        }
+        return true;
+      }
+      segmentStart = i + 1;
+    } else if (!isPlainCharacter(c)) {
+      return false;
+    }
+  }
+
+  return !isDotSegment(uri, segmentStart, uri.size());
+}
+} // namespace
+
+BaseUri::BaseUri(const std::string& uri) : _uri(uri), _directory(), _query() {
+  UriUriA baseUri;
+  if (uriParseSingleUriA(&baseUri, uri.c_str(), nullptr) != URI_SUCCESS) {
+    return;
+  }
+  this->_query.assign(baseUri.query.first, baseUri.query.afterLast);
+  uriFreeUriMembersA(&baseUri);
+
+  // Resolving a plain file name gives the normalized directory of the base,
+  // followed by that name. If the resolution fails, it gives back the name.
+  const std::string placeholder = "x";
+  std::string resolved = Uri::resolve(uri, placeholder);
+  if (resolved.size() > placeholder.size() &&
+      resolved.compare(
+          resolved.size() - placeholder.size(),
+          placeholder.size(),
+          placeholder) == 0) {
+    resolved.resize(resolved.size() - placeholder.size());
+    this->_directory = std::move(resolved);
+  }
+}
+
+std::string
+BaseUri::resolve(const std::string& relative, bool useBaseQuery) const {
+  if (this->_directory.empty() || !isPlainRelativePath(relative)) {
+    return Uri::resolve(this->_uri, relative, useBaseQuery);
+  }
+
+  const bool appendQuery = useBaseQuery && !this->_query.empty();
+
+  std::string result;
+  result.reserve(
+      this->_directory.size() + relative.size() +
+      (appendQuery ? this->_query.size() + 1 : 0));
+  result.append(this->_directory);
+  result.append(relative);
+  if (appendQuery) {
+    result += relative.find('?') != std::string::npos ? '&' : '?';
+    result.append(this->_query);
+  }
+  return result;
+}
+
 std::string Uri::addQuery(
     const std::string& uri,
     const std::string& key,
@@ -136,6 +231,7 @@ std::string Uri::substituteTemplateParameters(
     const std::string& templateUri,
     const std::function<SubstitutionCallbackSignature>& substitutionCallback) {
   std::string result;
+  result.reserve(templateUri.size());
   std::string placeholder;
 
   size_t startPos = 0;
@@ -152,7 +248,7 @@ std::string Uri::substituteTemplateParameters(
       throw std::runtime_error("Unclosed template parameter");
     }
 
-    placeholder = templateUri.substr(nextPos, endPos - nextPos);
+    placeholder.assign(templateUri, nextPos, endPos - nextPos);
     result.append(substitutionCallback(placeholder));
 
     startPos = endPos + 1;
@@ -0,0 +1,68 @@
+#include "CesiumUtility/Uri.h"
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace CesiumUtility;
+
+TEST_CASE("BaseUri::resolve") {
+  const std::vector<std::string> bases{
+      "https://example.com/tilesets/tileset.json",
+      "https://example.com/tilesets/tileset.json?v=1&key=abc",
+      "https://example.com/tilesets/",
+      "https://example.com",
+      "HTTPS://Example.COM/a/./b/../tileset.json",
+      "file:///C:/data/tileset.json",
+      "tileset.json",
+      ""};
+
+  const std::vector<std::string> relatives{
+      "content/0/0/0.b3dm",
+      "content.b3dm?v=2",
+      "child.json?a=b/c?d",
+      "a//b.glb",
+      "./content.b3dm",
+      "../content.b3dm",
+      "content/../other.b3dm",
+      "content/..",
+      ".",
+      "/absolute/content.b3dm",
+      "?v=3",
+      "#fragment",
+      "content.b3dm#fragment",
+      "content%20name.b3dm",
+      "https://other.example.com/content.b3dm",
+      "c:/data/content.b3dm",
+      "{level}/{x}/{y}.b3dm",
+      "content name.b3dm",
+      ""};
+
+  SECTION("gives the same result as Uri::resolve") {
+    for (const std::string& base : bases) {
+      const BaseUri baseUri(base);
+      CHECK(baseUri.getUri() == base);
+      for (const std::string& relative : relatives) {
+        CAPTURE(base, relative);
+        CHECK(baseUri.resolve(relative) == Uri::resolve(base, relative));
+        CHECK(
+            baseUri.resolve(relative, true) ==
+            Uri::resolve(base, relative, true));
+      }
+    }
+  }
+
+  SECTION("appends plain relative paths to the base directory") {
+    const BaseUri baseUri("https://example.com/tilesets/tileset.json?v=1");
+    CHECK(
+        baseUri.resolve("content/0.b3dm") ==
+        "https://example.com/tilesets/content/0.b3dm");
+    CHECK(
+        baseUri.resolve("content/0.b3dm", true) ==
+        "https://example.com/tilesets/content/0.b3dm?v=1");
+    CHECK(
+        baseUri.resolve("content/0.b3dm?key=abc", true) ==
+        "https://example.com/tilesets/content/0.b3dm?key=abc&v=1");
+  }
+}
@@ -0,0 +1,71 @@
+#include <CesiumUtility/FlatStringMap.h>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace CesiumUtility;
+
+namespace {
+std::vector<std::string> getKeys(const FlatStringMap<int>& map) {
+  std::vector<std::string> keys;
+  for (const auto& entry : map) {
+    keys.emplace_back(entry.first);
+  }
+  return keys;
+}
+} // namespace
+
+TEST_CASE("FlatStringMap") {
+  SECTION("keeps its entries sorted by key") {
+    FlatStringMap<int> map;
+    CHECK(map.emplace("b", 2).second);
+    CHECK(map.emplace(std::string("d"), 4).second);
+    CHECK(map.emplace(std::string_view("a"), 1).second);
+    map["c"] = 3;
+
+    CHECK(getKeys(map) == std::vector<std::string>{"a", "b", "c", "d"});
+    CHECK(map.size() == 4);
+  }
+
+  SECTION("keeps the first entry with a key, like std::map") {
+    FlatStringMap<int> map{{"a", 1}, {"b", 2}, {"a", 3}};
+    CHECK(map.size() == 2);
+    CHECK(map.at("a") == 1);
+
+    const auto [it, added] = map.emplace("b", 5);
+    CHECK(!added);
+    CHECK(it->second == 2);
+
+    CHECK(!map.insert_or_assign("b", 5).second);
+    CHECK(map.at("b") == 5);
+  }
+
+  SECTION("finds keys") {
+    const std::map<std::string, int> source{{"x", 1}, {"y", 2}, {"z", 3}};
+    const FlatStringMap<int> map(source.begin(), source.end());
+
+    const std::string key = "y";
+    REQUIRE(map.find(key) != map.end());
+    CHECK(map.find(key)->second == 2);
+    CHECK(map.find("w") == map.end());
+    CHECK(map.find("zz") == map.end());
+    CHECK(map.count("x") == 1);
+    CHECK(map.count("") == 0);
+    CHECK_THROWS_AS(map.at("w"), std::out_of_range);
+  }
+
+  SECTION("erases entries") {
+    FlatStringMap<int> map{{"a", 1}, {"b", 2}, {"c", 3}};
+    CHECK(map.erase("b") == 1);
+    CHECK(map.erase("b") == 0);
+    CHECK(getKeys(map) == std::vector<std::string>{"a", "c"});
+
+    map.erase(map.find("a"));
+    CHECK(getKeys(map) == std::vector<std::string>{"c"});
+  }
+}
@@ -0,0 +1,95 @@
+#include <CesiumUtility/Gunzip.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <vector>
+
+using namespace CesiumUtility;
+
+namespace {
+std::vector<std::byte> createData(size_t size) {
+  std::vector<std::byte> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = std::byte((i * 7) % 13);
+  }
+  return data;
+}
+
+std::vector<std::byte> gzipData(const std::vector<std::byte>& data) {
+  std::vector<std::byte> gzipped;
+  REQUIRE(gzip(data, gzipped));
+  return gzipped;
+}
+} // namespace
+
+TEST_CASE("gunzip") {
+  const std::vector<std::byte> data = createData(200000);
+  const std::vector<std::byte> gzipped = gzipData(data);
+
+  SECTION("gunzips into a vector") {
+    std::vector<std::byte> gunzipped;
+    REQUIRE(gunzip(gzipped, gunzipped));
+    CHECK(gunzipped == data);
+  }
+
+  SECTION("gets the gunzipped size") {
+    CHECK(getGunzippedSize(gzipped) == data.size());
+    CHECK(!getGunzippedSize(data));
+  }
+
+  SECTION("gunzips into a buffer") {
+    std::vector<std::byte> buffer(data.size());
+    size_t size = 0;
+    REQUIRE(gunzip(gzipped, gsl::span<std::byte>(buffer), size));
+    CHECK(size == data.size());
+    CHECK(buffer == data);
+
+    std::vector<std::byte> smallBuffer(data.size() - 1);
+    CHECK(!gunzip(gzipped, gsl::span<std::byte>(smallBuffer), size));
+  }
+
+  SECTION("fails on truncated data") {
+    const std::vector<std::byte> truncated(
+        gzipped.begin(),
+        gzipped.begin() + ptrdiff_t(gzipped.size() / 2));
+    std::vector<std::byte> gunzipped;
+    CHECK(!gunzip(truncated, gunzipped));
+  }
+
+  SECTION("inflates raw deflate data") {
+    // The gzip header that zlib writes without a file name is 10 bytes, and
+    // the trailer is 8 bytes, so the raw deflate data is between them.
+    const gsl::span<const std::byte> raw =
+        gsl::span<const std::byte>(gzipped).subspan(10, gzipped.size() - 18);
+    std::vector<std::byte> inflated;
+    REQUIRE(inflateRaw(raw, data.size(), inflated));
+    CHECK(inflated == data);
+
+    CHECK(!inflateRaw(raw.first(raw.size() / 2), data.size(), inflated));
+  }
+
+  SECTION("gunzips data that is received in pieces") {
+    GunzipStream stream;
+    std::vector<std::byte> gunzipped;
+    const size_t pieceSize = 1000;
+    for (size_t i = 0; i < gzipped.size(); i += pieceSize) {
+      CHECK(!stream.isFinished());
+      const size_t size = std::min(pieceSize, gzipped.size() - i);
+      REQUIRE(stream.write(
+          gsl::span<const std::byte>(gzipped.data() + i, size),
+          gunzipped));
+    }
+
+    CHECK(stream.isFinished());
+    CHECK(gunzipped == data);
+  }
+
+  SECTION("stops gunzipping pieces of invalid data") {
+    GunzipStream stream;
+    std::vector<std::byte> gunzipped;
+    CHECK(!stream.write(data, gunzipped));
+    CHECK(!stream.write(gzipped, gunzipped));
+    CHECK(gunzipped.empty());
+  }
+}
@@ -0,0 +1,35 @@
+#include <CesiumUtility/JsonWebToken.h>
+
+#include <catch2/catch.hpp>
+
+using namespace CesiumUtility;
+
+TEST_CASE("JsonWebToken") {
+  // {"alg":"HS256","typ":"JWT"}.{"jti":"~~~","exp":1700000000}.signature
+  const std::string token = "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9."
+                            "eyJqdGkiOiJ-fn4iLCJleHAiOjE3MDAwMDAwMDB9."
+                            "signature";
+
+  SECTION("gets the payload") {
+    CHECK(
+        JsonWebToken::getPayload(token) ==
+        std::string("{\"jti\":\"~~~\",\"exp\":1700000000}"));
+  }
+
+  SECTION("gets the expiry") {
+    std::optional<std::chrono::system_clock::time_point> expiry =
+        JsonWebToken::getExpiry(token);
+    REQUIRE(expiry);
+    CHECK(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            expiry->time_since_epoch())
+            .count() == 1700000000);
+  }
+
+  SECTION("rejects invalid tokens") {
+    CHECK(!JsonWebToken::getPayload("not a token"));
+    CHECK(!JsonWebToken::getPayload("header..signature"));
+    CHECK(!JsonWebToken::getExpiry("not a token"));
+    CHECK(!JsonWebToken::getExpiry("eyJhbGciOiJIUzI1NiJ9.e30.signature"));
+  }
+}
@@ -0,0 +1,85 @@
+#include <CesiumUtility/MemoryMappedFile.h>
+#include <CesiumUtility/SharedBytes.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumUtility;
+
+namespace {
+void writeFile(const std::string& path, const std::string& contents) {
+  std::FILE* pFile = std::fopen(path.c_str(), "wb");
+  REQUIRE(pFile);
+  std::fwrite(contents.data(), 1, contents.size(), pFile);
+  std::fclose(pFile);
+}
+
+std::string toString(const gsl::span<const std::byte>& bytes) {
+  return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+} // namespace
+
+TEST_CASE("MemoryMappedFile") {
+  std::remove("test.mapped");
+
+  SECTION("maps the contents of a file") {
+    writeFile("test.mapped", "abcdef");
+    std::shared_ptr<const MemoryMappedFile> pFile =
+        MemoryMappedFile::open("test.mapped");
+    REQUIRE(pFile);
+    CHECK(toString(pFile->getData()) == "abcdef");
+  }
+
+  SECTION("regions keep the file mapped") {
+    writeFile("test.mapped", "abcdef");
+    std::shared_ptr<const MemoryMappedFile> pFile =
+        MemoryMappedFile::open("test.mapped");
+    REQUIRE(pFile);
+
+    const SharedBytes region = pFile->getRegion(2, 3);
+    const std::weak_ptr<const MemoryMappedFile> pWeakFile = pFile;
+    pFile.reset();
+    CHECK(!pWeakFile.expired());
+    CHECK(toString(region.getBytes()) == "cde");
+    CHECK(toString(region.subrange(1, 2).getBytes()) == "de");
+  }
+
+  SECTION("regions outside the file are empty") {
+    writeFile("test.mapped", "abcdef");
+    std::shared_ptr<const MemoryMappedFile> pFile =
+        MemoryMappedFile::open("test.mapped");
+    REQUIRE(pFile);
+    CHECK(pFile->getRegion(4, 3).getBytes().empty());
+    CHECK(pFile->getRegion(7, 0).getBytes().empty());
+  }
+
+  SECTION("does not map missing or empty files") {
+    CHECK(!MemoryMappedFile::open("missing.mapped"));
+    writeFile("test.mapped", "");
+    CHECK(!MemoryMappedFile::open("test.mapped"));
+  }
+
+  std::remove("test.mapped");
+}
+
+TEST_CASE("SharedBytes") {
+  SECTION("keeps a vector alive") {
+    SharedBytes bytes =
+        SharedBytes::fromVector(std::vector<std::byte>{std::byte(1)});
+    CHECK(bytes.getOwner());
+    REQUIRE(bytes.getBytes().size() == 1);
+    CHECK(bytes.getBytes()[0] == std::byte(1));
+  }
+
+  SECTION("can refer to bytes it does not own") {
+    const std::vector<std::byte> data{std::byte(1), std::byte(2)};
+    const SharedBytes bytes(nullptr, data);
+    CHECK(!bytes.getOwner());
+    CHECK(bytes.getBytes().data() == data.data());
+  }
+}
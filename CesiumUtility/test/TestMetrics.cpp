@@ -0,0 +1,96 @@
+#include <CesiumUtility/Metrics.h>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace CesiumUtility;
+
+TEST_CASE("MetricHistogram") {
+  MetricHistogram histogram({1.0, 5.0});
+  histogram.observe(0.5);
+  histogram.observe(1.0);
+  histogram.observe(3.0);
+  histogram.observe(10.0);
+
+  CHECK(histogram.getBucketCounts() == std::vector<int64_t>{2, 1, 1});
+  CHECK(histogram.getCount() == 4);
+  CHECK(histogram.getSum() == 14.5);
+}
+
+TEST_CASE("MetricsRegistry") {
+  MetricsRegistry registry;
+
+  SECTION("returns the same metric for the same name and labels") {
+    MetricCounter& counter = registry.counter(
+        "requests_total",
+        "The requests.",
+        {{"result", "ok"}, {"host", "a.com"}});
+    counter.increment();
+    counter.increment(2);
+
+    MetricCounter& sameCounter = registry.counter(
+        "requests_total",
+        "The requests.",
+        {{"host", "a.com"}, {"result", "ok"}});
+    CHECK(&sameCounter == &counter);
+    CHECK(sameCounter.getValue() == 3);
+
+    MetricCounter& otherCounter = registry.counter(
+        "requests_total",
+        "The requests.",
+        {{"host", "a.com"}, {"result", "failed"}});
+    CHECK(&otherCounter != &counter);
+    CHECK(otherCounter.getValue() == 0);
+  }
+
+  SECTION("rejects a metric of another type with the same name") {
+    registry.gauge("in_progress", "The requests in progress.");
+    CHECK_THROWS_AS(
+        registry.counter("in_progress", "The requests in progress."),
+        std::invalid_argument);
+  }
+
+  SECTION("gets a snapshot sorted by name and labels") {
+    registry.gauge("b", "B.").set(5);
+    registry.counter("a", "A.", {{"x", "2"}}).increment();
+    registry.counter("a", "A.", {{"x", "1"}}).increment(4);
+    registry.histogram("c", "C.", {1.0}).observe(2.0);
+
+    std::vector<MetricSnapshot> snapshot = registry.getSnapshot();
+    REQUIRE(snapshot.size() == 4);
+    CHECK(snapshot[0].name == "a");
+    CHECK(snapshot[0].labels == MetricLabels{{"x", "1"}});
+    CHECK(snapshot[0].value == 4);
+    CHECK(snapshot[1].labels == MetricLabels{{"x", "2"}});
+    CHECK(snapshot[2].type == MetricType::Gauge);
+    CHECK(snapshot[2].value == 5);
+    CHECK(snapshot[3].type == MetricType::Histogram);
+    CHECK(snapshot[3].bucketCounts == std::vector<int64_t>{0, 1});
+    CHECK(snapshot[3].count == 1);
+  }
+
+  SECTION("formats the metrics as Prometheus text") {
+    registry.counter("loads_total", "The loads.", {{"result", "ok"}})
+        .increment(2);
+    registry.counter("loads_total", "The loads.", {{"result", "failed"}})
+        .increment();
+    registry.histogram("load_seconds", "The load \"time\".", {0.5, 1.0})
+        .observe(0.75);
+
+    const std::string expected = "# HELP load_seconds The load \"time\".\n"
+                                 "# TYPE load_seconds histogram\n"
+                                 "load_seconds_bucket{le=\"0.5\"} 0\n"
+                                 "load_seconds_bucket{le=\"1\"} 1\n"
+                                 "load_seconds_bucket{le=\"+Inf\"} 1\n"
+                                 "load_seconds_sum 0.75\n"
+                                 "load_seconds_count 1\n"
+                                 "# HELP loads_total The loads.\n"
+                                 "# TYPE loads_total counter\n"
+                                 "loads_total{result=\"failed\"} 1\n"
+                                 "loads_total{result=\"ok\"} 2\n";
+    CHECK(registry.toPrometheusText() == expected);
+  }
+}
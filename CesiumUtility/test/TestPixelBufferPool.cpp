@@ -0,0 +1,63 @@
+#include <CesiumUtility/PixelBufferPool.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <vector>
+
+using namespace CesiumUtility;
+
+TEST_CASE("PixelBufferPool") {
+  PixelBufferPool pool(8 * 1024 * 1024);
+
+  SECTION("reuses released buffers of the same size class") {
+    std::vector<std::byte> buffer = pool.acquire(256 * 256 * 4);
+    CHECK(buffer.size() == 256 * 256 * 4);
+    CHECK(buffer.capacity() == 256 * 256 * 4);
+    buffer[5] = std::byte(3);
+    const std::byte* pData = buffer.data();
+
+    pool.release(buffer);
+    CHECK(buffer.empty());
+    CHECK(buffer.capacity() == 0);
+    CHECK(pool.getPooledBytes() == 256 * 256 * 4);
+
+    std::vector<std::byte> reused = pool.acquire(200000);
+    CHECK(reused.data() == pData);
+    CHECK(reused.size() == 200000);
+    CHECK(reused[5] == std::byte(0));
+    CHECK(pool.getPooledBytes() == 0);
+  }
+
+  SECTION("does not pool buffers outside of the size classes") {
+    std::vector<std::byte> small = pool.acquire(100);
+    CHECK(small.size() == 100);
+    pool.release(small);
+
+    std::vector<std::byte> notAcquired(100000);
+    pool.release(notAcquired);
+    CHECK(notAcquired.empty());
+
+    std::vector<std::byte> large =
+        pool.acquire(PixelBufferPool::maximumPooledSize + 1);
+    pool.release(large);
+
+    CHECK(pool.getPooledBytes() == 0);
+  }
+
+  SECTION("keeps no more than the maximum pooled bytes") {
+    std::vector<std::byte> first = pool.acquire(4 * 1024 * 1024);
+    std::vector<std::byte> second = pool.acquire(4 * 1024 * 1024);
+    std::vector<std::byte> third = pool.acquire(1024 * 1024);
+    pool.release(first);
+    pool.release(third);
+    pool.release(second);
+    CHECK(pool.getPooledBytes() == 5 * 1024 * 1024);
+
+    pool.setMaximumPooledBytes(2 * 1024 * 1024);
+    CHECK(pool.getPooledBytes() == 1024 * 1024);
+
+    CHECK(pool.clear() == 1024 * 1024);
+    CHECK(pool.getPooledBytes() == 0);
+  }
+}
@@ -0,0 +1,72 @@
+#include "CesiumUtility/IntrusivePointer.h"
+#include "CesiumUtility/ReferenceCountedThreadSafe.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace CesiumUtility;
+
+namespace {
+class Counted : public ReferenceCountedThreadSafe<Counted> {
+public:
+  explicit Counted(std::atomic<int>& destroyed) noexcept
+      : _destroyed(destroyed) {}
+  ~Counted() noexcept { ++this->_destroyed; }
+
+private:
+  std::atomic<int>& _destroyed;
+};
+} // namespace
+
+TEST_CASE("ReferenceCountedThreadSafe") {
+  std::atomic<int> destroyed{0};
+
+  SECTION("is deleted when the last reference is released") {
+    IntrusivePointer<Counted> pCounted = new Counted(destroyed);
+    CHECK(pCounted->getReferenceCount() == 1);
+
+    IntrusivePointer<Counted> pCopy = pCounted;
+    CHECK(pCounted->getReferenceCount() == 2);
+
+    pCounted = nullptr;
+    CHECK(pCopy->getReferenceCount() == 1);
+    CHECK(destroyed.load() == 0);
+
+    pCopy = nullptr;
+    CHECK(destroyed.load() == 1);
+  }
+
+  SECTION("references may be added and released from many threads") {
+    IntrusivePointer<Counted> pCounted = new Counted(destroyed);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+      threads.emplace_back([pCounted]() {
+        for (int j = 0; j < 10000; ++j) {
+          IntrusivePointer<Counted> pCopy = pCounted;
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    CHECK(pCounted->getReferenceCount() == 1);
+    CHECK(destroyed.load() == 0);
+
+    pCounted = nullptr;
+    CHECK(destroyed.load() == 1);
+  }
+
+  SECTION("the last reference may be released in another thread") {
+    IntrusivePointer<Counted> pCounted = new Counted(destroyed);
+    std::thread([pCopy = std::move(pCounted)]() mutable {
+      pCopy = nullptr;
+    }).join();
+    CHECK(destroyed.load() == 1);
+  }
+}
@@ -352,15 +352,10 @@ function generate(options, schema, writers) {
         ` : ""}
 
         CesiumJsonReader::IJsonHandler* ${name}JsonHandler::readObjectKey${name}(const std::string& objectType, const std::string_view& str, ${namespace}::${name}& o) {
-          using namespace std::string_literals;
+          using namespace std::string_view_literals;
 
           ${properties.length > 0 ? `
-          ${indent(
-            properties
-              .map((property) => formatReaderPropertyImpl(property))
-              .join("\n"),
-            10
-          )}` : `(void)o;`}
+          ${indent(formatReaderPropertiesImpl(properties), 10)}` : `(void)o;`}
 
           return this->readObjectKey${NameFormatters.removeNamespace(base)}(objectType, str, *this->_pObject);
         }
@@ -574,7 +569,32 @@ function formatReaderProperty(property) {
 }
 
 function formatReaderPropertyImpl(property) {
-  return `if ("${property.name}"s == str) return property("${property.name}", this->_${property.cppSafeName}, o.${property.cppSafeName});`;
+  return `if ("${property.name}"sv == str) return property("${property.name}", this->_${property.cppSafeName}, o.${property.cppSafeName});`;
+}
+
+// Dispatches on the length of the key first, so that a key is only compared
+// with the few property names of the same length.
+function formatReaderPropertiesImpl(properties) {
+  const byLength = new Map();
+  for (const property of properties) {
+    const length = property.name.length;
+    if (!byLength.has(length)) {
+      byLength.set(length, []);
+    }
+    byLength.get(length).push(property);
+  }
+
+  const cases = Array.from(byLength.keys())
+    .sort((a, b) => a - b)
+    .map((length) => {
+      const comparisons = byLength
+        .get(length)
+        .map((property) => formatReaderPropertyImpl(property))
+        .join("\n");
+      return `case ${length}:\n${comparisons}\nbreak;`;
+    });
+
+  return `switch (str.size()) {\n${cases.join("\n")}\n}`;
 }
 
 function formatWriterPropertyImpl(property) {